@@ -0,0 +1,755 @@
+// =============================================================================
+// bench_main.cpp - luxdex microbenchmark suite
+// =============================================================================
+//
+// Each case builds its state untimed, then times every operation on its own
+// over a number of repetitions after a few warmup repetitions. Per-operation
+// latencies from all measured repetitions are pooled for the percentiles;
+// throughput is taken per repetition from the wall time of its whole loop.
+//
+//   luxdex_bench [--filter SUBSTR] [--reps N] [--warmup N] [--quick]
+//                [--json PATH] [--list]
+//
+// --quick shrinks the largest sizes (1M vault accounts, 1000-level books)
+// for a fast smoke run; --json writes the machine-readable report.
+
+#include <algorithm>
+#include <chrono>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <fstream>
+#include <functional>
+#include <iomanip>
+#include <iostream>
+#include <memory>
+#include <sstream>
+#include <string>
+#include <thread>
+#include <utility>
+#include <vector>
+
+#include "lux/engine.hpp"
+#include "lux/lx.hpp"
+#include "lux/oracle.hpp"
+#include "lux/orderbook.hpp"
+#include "lux/pool.hpp"
+#include "lux/vault.hpp"
+#include "report.hpp"
+
+using namespace lux;
+using namespace lux::bench;
+
+namespace {
+
+// =============================================================================
+// Harness
+// =============================================================================
+
+// One timed operation; `i` counts operations within the repetition
+using Op = std::function<void(size_t i)>;
+
+struct Case {
+    std::string name;                                   // "family/operation"
+    std::vector<std::pair<std::string, std::string>> params;
+    size_t ops;                 // Timed operations per repetition
+    size_t items_per_op;        // Units of work in one operation (orders in a batch, ...)
+    std::function<Op()> setup;  // Fresh or reset state for one repetition, untimed
+};
+
+struct CaseResult {
+    const Case* spec;
+    std::vector<uint64_t> latencies_ns;     // Every operation of every measured repetition
+    std::vector<double> ops_per_sec;        // Per repetition
+};
+
+struct Options {
+    std::string filter;
+    std::string json_path;
+    size_t reps = 10;
+    size_t warmup = 2;
+    bool quick = false;
+    bool list = false;
+};
+
+std::string full_name(const Case& c) {
+    std::string name = c.name;
+    for (const auto& [key, value] : c.params) {
+        name += "/" + key + "=" + value;
+    }
+    return name;
+}
+
+// Cost of the two clock reads around each operation, subtracted from
+// nothing but reported so small latencies can be read against it
+uint64_t clock_overhead_ns() {
+    std::vector<uint64_t> samples(100000);
+    for (auto& sample : samples) {
+        const auto t0 = Clock::now();
+        const auto t1 = Clock::now();
+        sample = elapsed_ns(t0, t1);
+    }
+    std::sort(samples.begin(), samples.end());
+    return percentile(samples, 0.5);
+}
+
+CaseResult run_case(const Case& c, const Options& options) {
+    CaseResult result{&c, {}, {}};
+    result.latencies_ns.reserve(c.ops * options.reps);
+
+    for (size_t rep = 0; rep < options.warmup + options.reps; ++rep) {
+        Op op = c.setup();
+        const bool measured = rep >= options.warmup;
+        const size_t first = result.latencies_ns.size();
+
+        const auto start = Clock::now();
+        for (size_t i = 0; i < c.ops; ++i) {
+            const auto t0 = Clock::now();
+            op(i);
+            const auto t1 = Clock::now();
+            if (measured) {
+                result.latencies_ns.push_back(elapsed_ns(t0, t1));
+            }
+        }
+        const auto end = Clock::now();
+
+        if (measured) {
+            const double seconds = std::chrono::duration<double>(end - start).count();
+            result.ops_per_sec.push_back(seconds > 0 ? static_cast<double>(c.ops) / seconds : 0.0);
+        } else {
+            result.latencies_ns.resize(first);
+        }
+    }
+
+    std::sort(result.latencies_ns.begin(), result.latencies_ns.end());
+    std::sort(result.ops_per_sec.begin(), result.ops_per_sec.end());
+    return result;
+}
+
+void print_result(const CaseResult& r) {
+    const auto& lat = r.latencies_ns;
+    const double median_ops = percentile(r.ops_per_sec, 0.5);
+    std::cout << std::left << std::setw(58) << full_name(*r.spec) << std::right
+              << " p50 " << std::setw(9) << format_ns(percentile(lat, 0.50))
+              << "  p90 " << std::setw(9) << format_ns(percentile(lat, 0.90))
+              << "  p99 " << std::setw(9) << format_ns(percentile(lat, 0.99))
+              << "  max " << std::setw(9) << format_ns(lat.empty() ? 0 : lat.back())
+              << "  " << std::fixed << std::setprecision(0) << median_ops << " ops/s";
+    if (r.spec->items_per_op > 1) {
+        std::cout << " (" << median_ops * static_cast<double>(r.spec->items_per_op) << " items/s)";
+    }
+    std::cout << "\n";
+}
+
+bool write_json(const std::string& path, const std::vector<CaseResult>& results,
+                const Options& options, uint64_t overhead_ns) {
+    std::ofstream out(path);
+    if (!out) {
+        return false;
+    }
+
+    write_json_preamble(out, "luxdex_bench");
+    out << "  \"clock_overhead_ns\": " << overhead_ns << ",\n";
+    out << "  \"warmup\": " << options.warmup << ",\n";
+    out << "  \"repetitions\": " << options.reps << ",\n";
+    out << "  \"quick\": " << (options.quick ? "true" : "false") << ",\n";
+    out << "  \"cases\": [";
+
+    for (size_t i = 0; i < results.size(); ++i) {
+        const CaseResult& r = results[i];
+        out << (i ? ",\n" : "\n") << "    {\n";
+        out << "      \"name\": \"" << json_escape(r.spec->name) << "\",\n";
+        out << "      \"id\": \"" << json_escape(full_name(*r.spec)) << "\",\n";
+        out << "      \"params\": {";
+        for (size_t p = 0; p < r.spec->params.size(); ++p) {
+            out << (p ? ", " : "") << "\"" << json_escape(r.spec->params[p].first) << "\": \""
+                << json_escape(r.spec->params[p].second) << "\"";
+        }
+        out << "},\n";
+        out << "      \"ops_per_rep\": " << r.spec->ops << ",\n";
+        out << "      \"items_per_op\": " << r.spec->items_per_op << ",\n";
+        out << "      \"latency_ns\": ";
+        write_latency_json(out, r.latencies_ns);
+        out << ",\n";
+        out << "      \"ops_per_sec\": {\"min\": " << (r.ops_per_sec.empty() ? 0 : r.ops_per_sec.front())
+            << ", \"median\": " << percentile(r.ops_per_sec, 0.5)
+            << ", \"max\": " << (r.ops_per_sec.empty() ? 0 : r.ops_per_sec.back()) << "},\n";
+        out << "      \"items_per_sec\": "
+            << percentile(r.ops_per_sec, 0.5) * static_cast<double>(r.spec->items_per_op) << "\n";
+        out << "    }";
+    }
+    out << "\n  ]\n}\n";
+    return static_cast<bool>(out);
+}
+
+// Setup that fails would time a rejected path; stop instead
+void require(bool ok, const char* what) {
+    if (!ok) {
+        std::cerr << "benchmark setup failed: " << what << "\n";
+        std::exit(1);
+    }
+}
+
+// Deterministic inputs, the same on every run
+struct Rng {
+    uint64_t state;
+    explicit Rng(uint64_t seed) : state(seed) {}
+    uint64_t next() {
+        state = state * 6364136223846793005ULL + 1442695040888963407ULL;
+        return state >> 17;
+    }
+    size_t below(size_t n) { return static_cast<size_t>(next() % n); }
+};
+
+// =============================================================================
+// Order Book
+// =============================================================================
+
+constexpr double MID = 100.0;
+constexpr double TICK = 0.01;
+
+Order limit_order(uint64_t id, uint64_t account, Side side, double price,
+                  double quantity = 1.0, uint64_t symbol = 1) {
+    return OrderBuilder()
+        .id(id)
+        .symbol(symbol)
+        .account(account)
+        .side(side)
+        .type(OrderType::Limit)
+        .price(price)
+        .quantity(quantity)
+        .tif(TimeInForce::GTC)
+        .build();
+}
+
+// Book with `depth` levels a side, `per_level` resting orders of 1.0 each,
+// makers on accounts 1..1000. Ids 1..2*depth*per_level are taken.
+struct BookState {
+    std::unique_ptr<OrderBook> book;
+    std::vector<Trade> trades;
+    std::vector<uint64_t> resting;      // Ids, in random order
+    uint64_t next_id = 1;
+    Rng rng{42};
+
+    BookState(size_t depth, size_t per_level) {
+        OrderBookConfig config;
+        config.initial_order_capacity = 2 * depth * per_level + 100000;
+        book = std::make_unique<OrderBook>(1, config);
+        for (size_t level = 0; level < depth; ++level) {
+            for (size_t k = 0; k < per_level; ++k) {
+                const uint64_t bid = next_id++;
+                const uint64_t ask = next_id++;
+                book->place_order(limit_order(bid, 1 + bid % 1000, Side::Buy, MID - (level + 1) * TICK), trades);
+                book->place_order(limit_order(ask, 1 + ask % 1000, Side::Sell, MID + (level + 1) * TICK), trades);
+                resting.push_back(bid);
+                resting.push_back(ask);
+            }
+        }
+        for (size_t i = resting.size(); i > 1; --i) {
+            std::swap(resting[i - 1], resting[rng.below(i)]);
+        }
+        trades.reserve(64);
+    }
+};
+
+void add_orderbook_cases(std::vector<Case>& cases, const Options& options) {
+    std::vector<size_t> depths = {10, 100, 1000};
+    if (options.quick) {
+        depths.pop_back();
+    }
+    const size_t ops = 10000;
+
+    for (size_t depth : depths) {
+        for (size_t per_level : {size_t{1}, size_t{10}}) {
+            const std::vector<std::pair<std::string, std::string>> params = {
+                {"depth", std::to_string(depth)}, {"per_level", std::to_string(per_level)}};
+
+            // New passive orders at random levels inside the book
+            cases.push_back({"orderbook/place_resting", params, ops, 1, [depth, per_level] {
+                auto state = std::make_shared<BookState>(depth, per_level);
+                return Op([state, depth](size_t) {
+                    const uint64_t id = state->next_id++;
+                    const bool buy = state->rng.next() & 1;
+                    const double offset = static_cast<double>(1 + state->rng.below(depth)) * TICK;
+                    state->trades.clear();
+                    state->book->place_order(
+                        limit_order(id, 5000 + id % 1000, buy ? Side::Buy : Side::Sell,
+                                    buy ? MID - offset : MID + offset),
+                        state->trades);
+                });
+            }});
+
+            // Aggressive orders taking one resting order at the touch,
+            // alternating sides; the book holds enough for every op
+            const size_t takes = std::min(ops, depth * per_level);
+            cases.push_back({"orderbook/place_crossing", params, takes, 1, [depth, per_level] {
+                auto state = std::make_shared<BookState>(depth, per_level);
+                return Op([state](size_t i) {
+                    const uint64_t id = state->next_id++;
+                    const bool buy = i % 2 == 0;
+                    state->trades.clear();
+                    state->book->place_order(
+                        limit_order(id, 5000 + id % 1000, buy ? Side::Buy : Side::Sell,
+                                    buy ? MID * 2 : MID / 2),
+                        state->trades);
+                });
+            }});
+
+            // Resting orders cancelled in random order
+            const size_t cancels = std::min(ops, 2 * depth * per_level);
+            cases.push_back({"orderbook/cancel_order", params, cancels, 1, [depth, per_level] {
+                auto state = std::make_shared<BookState>(depth, per_level);
+                return Op([state](size_t i) {
+                    state->book->cancel_order(state->resting[i]);
+                });
+            }});
+        }
+    }
+}
+
+// =============================================================================
+// Engine
+// =============================================================================
+
+// Batches of passive places, crossing places and cancels spread over
+// `symbols` books: 60% rest one to ten ticks off the mid, 25% cross it,
+// 15% cancel an order placed earlier
+std::vector<std::vector<BatchOrder>> make_batches(size_t count, size_t batch_size, size_t symbols) {
+    Rng rng(7);
+    std::vector<std::vector<BatchOrder>> batches(count);
+    std::vector<std::pair<uint64_t, uint64_t>> placed;    // (symbol, id)
+    uint64_t next_id = 1;
+
+    for (auto& batch : batches) {
+        batch.reserve(batch_size);
+        for (size_t i = 0; i < batch_size; ++i) {
+            BatchOrder action{};
+            const size_t roll = rng.below(100);
+            const uint64_t symbol = 1 + rng.below(symbols);
+            if (roll < 15 && !placed.empty()) {
+                const size_t pick = rng.below(placed.size());
+                action.action = BatchOrder::Action::Cancel;
+                action.order.symbol_id = placed[pick].first;
+                action.order_id = placed[pick].second;
+                placed[pick] = placed.back();
+                placed.pop_back();
+            } else {
+                const bool buy = rng.next() & 1;
+                const double offset = static_cast<double>(1 + rng.below(10)) * TICK;
+                const bool cross = roll >= 75;
+                const double price = buy == cross ? MID + offset : MID - offset;
+                const uint64_t id = next_id++;
+                action.action = BatchOrder::Action::Place;
+                action.order = limit_order(id, 1 + id % 1000, buy ? Side::Buy : Side::Sell,
+                                           price, 1.0, symbol);
+                placed.emplace_back(symbol, id);
+            }
+            batch.push_back(action);
+        }
+    }
+    return batches;
+}
+
+void add_engine_cases(std::vector<Case>& cases, const Options&) {
+    const size_t ops = 200;
+    for (size_t batch_size : {size_t{100}, size_t{1000}}) {
+        for (size_t symbols : {size_t{1}, size_t{16}}) {
+            auto batches = std::make_shared<std::vector<std::vector<BatchOrder>>>(
+                make_batches(ops, batch_size, symbols));
+            cases.push_back({"engine/process_batch",
+                             {{"batch", std::to_string(batch_size)}, {"symbols", std::to_string(symbols)}},
+                             ops, batch_size, [batches, symbols] {
+                auto engine = std::make_shared<Engine>();
+                for (uint64_t symbol = 1; symbol <= symbols; ++symbol) {
+                    engine->add_symbol(symbol);
+                }
+                return Op([engine, batches](size_t i) {
+                    engine->process_batch((*batches)[i]);
+                });
+            }});
+        }
+    }
+}
+
+// =============================================================================
+// Pool
+// =============================================================================
+
+// One-spacing-wide positions stacked on each side of the start price, so
+// every initialized tick boundary between them is crossed by a swap that
+// moves that far. Swaps alternate between limits `ticks` spacings apart
+// around the start and so cross `ticks` boundaries each.
+void add_pool_cases(std::vector<Case>& cases, const Options&) {
+    constexpr int32_t SPACING = 10;
+    constexpr int32_t POSITIONS = 1000;
+    const size_t ops = 2000;
+
+    for (int32_t ticks : {1, 10, 100}) {
+        cases.push_back({"pool/swap", {{"ticks_crossed", std::to_string(ticks)}}, ops, 1, [ticks] {
+            struct State {
+                LXPool pool;
+                PoolKey key{};
+                PoolHandle handle;
+                I128 lower_limit;
+                I128 upper_limit;
+            };
+            auto state = std::make_shared<State>();
+            state->key.currency0 = Currency(Address{1});
+            state->key.currency1 = Currency(Address{2});
+            state->key.fee = 3000;
+            state->key.tick_spacing = SPACING;
+            state->pool.initialize(state->key, tick_math::get_sqrt_ratio_at_tick(0));
+            for (int32_t p = -POSITIONS / 2; p < POSITIONS / 2; ++p) {
+                state->pool.modify_liquidity(state->key,
+                    {p * SPACING, (p + 1) * SPACING, x18::from_double(1000.0), 0});
+            }
+            state->handle = state->pool.find_pool(state->key);
+            require(static_cast<bool>(state->handle), "pool initialize");
+
+            // Limits half a spacing off the boundaries, `ticks` boundaries apart
+            const int32_t lower = -(ticks / 2) * SPACING - SPACING / 2;
+            state->lower_limit = tick_math::get_sqrt_ratio_at_tick(lower);
+            state->upper_limit = tick_math::get_sqrt_ratio_at_tick(lower + ticks * SPACING);
+            state->pool.swap(state->handle, {true, X18_ONE * 1000000000, state->lower_limit});
+
+            return Op([state](size_t i) {
+                const bool down = i % 2 == 1;
+                state->pool.swap(state->handle, {down, X18_ONE * 1000000000,
+                                                 down ? state->lower_limit : state->upper_limit});
+            });
+        }});
+    }
+}
+
+// =============================================================================
+// Vault
+// =============================================================================
+
+LXAccount bench_account(size_t i) {
+    LXAccount account{};
+    for (size_t b = 0; b < 8; ++b) {
+        account.main[19 - b] = static_cast<uint8_t>(i >> (8 * b));
+    }
+    account.main[0] = 0xbe;
+    return account;
+}
+
+LXSettlement bench_fill(size_t maker, size_t taker, bool taker_is_buy, double price) {
+    LXSettlement settlement{};
+    settlement.maker = bench_account(maker);
+    settlement.taker = bench_account(taker);
+    settlement.market_id = 1;
+    settlement.taker_is_buy = taker_is_buy;
+    settlement.size_x18 = X18_ONE;
+    settlement.price_x18 = x18::from_double(price);
+    return settlement;
+}
+
+// A vault where each of `accounts` accounts is funded and holds a position
+// of 1 in market 1 (even accounts long against the next odd one). Built
+// once per size and shared by the vault cases; they leave it equivalent.
+std::shared_ptr<LXVault> funded_vault(size_t accounts) {
+    static std::vector<std::pair<size_t, std::shared_ptr<LXVault>>> built;
+    for (const auto& [size, vault] : built) {
+        if (size == accounts) {
+            return vault;
+        }
+    }
+
+    auto vault = std::make_shared<LXVault>();
+    MarketConfig market{};
+    market.market_id = 1;
+    market.initial_margin_x18 = x18::from_double(0.1);
+    market.maintenance_margin_x18 = x18::from_double(0.05);
+    market.active = true;
+    require(vault->create_market(market) == errors::OK, "create_market");
+
+    for (size_t i = 0; i < accounts; ++i) {
+        require(vault->deposit(bench_account(i), Currency{}, x18::from_double(1000000.0)) == errors::OK,
+                "deposit");
+    }
+    std::vector<LXSettlement> fills;
+    fills.reserve(10000);
+    for (size_t i = 0; i + 1 < accounts; i += 2) {
+        fills.push_back(bench_fill(i + 1, i, true, MID));
+        if (fills.size() == fills.capacity()) {
+            require(vault->apply_fills(fills) == errors::OK, "apply_fills");
+            fills.clear();
+        }
+    }
+    require(vault->apply_fills(fills) == errors::OK, "apply_fills");
+
+    built.emplace_back(accounts, vault);
+    return vault;
+}
+
+void add_vault_cases(std::vector<Case>& cases, const Options& options) {
+    std::vector<size_t> sizes = {10000, 100000, 1000000};
+    if (options.quick) {
+        sizes.pop_back();
+    }
+
+    for (size_t accounts : sizes) {
+        const std::vector<std::pair<std::string, std::string>> params = {
+            {"accounts", std::to_string(accounts)}};
+
+        // Batches of 100 fills between random account pairs; each
+        // repetition undoes its own fills, so the vault returns to its
+        // starting positions
+        constexpr size_t FILLS = 100;
+        const size_t ops = 1000;
+        cases.push_back({"vault/apply_fills", params, ops, FILLS, [accounts, ops] {
+            auto vault = funded_vault(accounts);
+            auto batches = std::make_shared<std::vector<std::vector<LXSettlement>>>(ops);
+            Rng rng(11);
+            for (size_t b = 0; b < ops / 2; ++b) {
+                auto& open = (*batches)[b];
+                auto& close = (*batches)[ops - 1 - b];
+                for (size_t f = 0; f < FILLS; ++f) {
+                    const size_t maker = rng.below(accounts);
+                    const size_t taker = (maker + 1 + rng.below(accounts - 1)) % accounts;
+                    const double price = MID + static_cast<double>(rng.below(200)) * TICK - 1.0;
+                    open.push_back(bench_fill(maker, taker, true, price));
+                    close.push_back(bench_fill(maker, taker, false, price));
+                }
+            }
+            return Op([vault, batches](size_t i) {
+                vault->apply_fills((*batches)[i]);
+            });
+        }});
+
+        // One mark for the market, revaluing every open position
+        const size_t marks = accounts >= 1000000 ? 20 : 100;
+        cases.push_back({"vault/update_mark_prices", params, marks, accounts, [accounts] {
+            auto vault = funded_vault(accounts);
+            return Op([vault](size_t i) {
+                vault->update_mark_prices({{1, x18::from_double(MID + static_cast<double>(i % 20) * 0.05)}});
+            });
+        }});
+    }
+}
+
+// =============================================================================
+// Oracle
+// =============================================================================
+
+// One source update of one asset, which rebuilds that asset's aggregate,
+// then a read of the new aggregate. 1000 assets, updates round-robin.
+void add_oracle_cases(std::vector<Case>& cases, const Options&) {
+    constexpr uint64_t ASSETS = 1000;
+    const size_t ops = 20000;
+    const std::vector<std::pair<AggregationMethod, const char*>> methods = {
+        {AggregationMethod::MEDIAN, "median"},
+        {AggregationMethod::TRIMMED_MEAN, "trimmed_mean"},
+        {AggregationMethod::WEIGHTED_MEDIAN, "weighted_median"},
+    };
+
+    for (size_t sources : {size_t{3}, size_t{8}}) {
+        for (const auto& [method, method_name] : methods) {
+            cases.push_back({"oracle/update_aggregate",
+                             {{"sources", std::to_string(sources)}, {"method", method_name}},
+                             ops, 1, [sources, method = method] {
+                auto oracle = std::make_shared<LXOracle>();
+                for (uint64_t asset = 1; asset <= ASSETS; ++asset) {
+                    OracleConfig config{};
+                    config.asset_id = asset;
+                    config.max_staleness = 3600;
+                    config.max_deviation_x18 = x18::from_double(0.5);
+                    config.method = method;
+                    for (size_t s = 0; s < sources; ++s) {
+                        config.sources.push_back(static_cast<PriceSource>(s));
+                        config.weights_x18.push_back(X18_ONE * static_cast<int64_t>(s + 1));
+                    }
+                    require(oracle->register_asset(config) == errors::OK, "register_asset");
+                    for (size_t s = 0; s < sources; ++s) {
+                        oracle->update_price(asset, static_cast<PriceSource>(s),
+                                             x18::from_double(MID + static_cast<double>(s) * 0.1), X18_ONE);
+                    }
+                }
+                return Op([oracle, sources](size_t i) {
+                    const uint64_t asset = 1 + i % ASSETS;
+                    const auto source = static_cast<PriceSource>((i / ASSETS) % sources);
+                    oracle->update_price(asset, source,
+                                         x18::from_double(MID + static_cast<double>(i % 50) * 0.01), X18_ONE);
+                    volatile bool found = oracle->get_price(asset).has_value();
+                    (void)found;
+                });
+            }});
+        }
+    }
+}
+
+// =============================================================================
+// Precompile Router
+// =============================================================================
+
+std::vector<uint8_t> calldata(uint32_t selector, const std::vector<uint64_t>& words) {
+    std::vector<uint8_t> data(4 + words.size() * 32, 0);
+    data[0] = static_cast<uint8_t>(selector >> 24);
+    data[1] = static_cast<uint8_t>(selector >> 16);
+    data[2] = static_cast<uint8_t>(selector >> 8);
+    data[3] = static_cast<uint8_t>(selector);
+    for (size_t w = 0; w < words.size(); ++w) {
+        for (int i = 0; i < 8; ++i) {
+            data[4 + w * 32 + 31 - i] = static_cast<uint8_t>(words[w] >> (8 * i));
+        }
+    }
+    return data;
+}
+
+// Oracle getPrice (a view) and updatePrice through dispatch: selector
+// lookup, argument decoding and the call into LX, with the
+// allocation-free and the vector-returning entry points
+void add_router_cases(std::vector<Case>& cases, const Options&) {
+    constexpr uint32_t GET_PRICE = 0x99cff17c;       // getPrice(uint64)
+    constexpr uint32_t UPDATE_PRICE = 0x7d3e47c1;    // updatePrice(uint64,uint8,int128,int128)
+    constexpr uint64_t ASSETS = 64;
+    const size_t ops = 20000;
+
+    struct State {
+        LX lx;
+        PrecompileRouter router{lx};
+        std::vector<std::vector<uint8_t>> gets;
+        std::vector<std::vector<uint8_t>> updates;
+        uint8_t out[PrecompileRouter::MAX_OUTPUT];
+    };
+    auto make_state = [] {
+        auto state = std::make_shared<State>();
+        for (uint64_t asset = 1; asset <= ASSETS; ++asset) {
+            OracleConfig config{};
+            config.asset_id = asset;
+            config.max_staleness = 3600;
+            config.max_deviation_x18 = x18::from_double(0.5);
+            config.method = AggregationMethod::MEDIAN;
+            config.sources = {PriceSource::BINANCE};
+            require(state->lx.oracle().register_asset(config) == errors::OK, "register_asset");
+            const auto source = static_cast<uint64_t>(PriceSource::BINANCE);
+            require(state->router.call(addresses::LX_ORACLE,
+                                       calldata(UPDATE_PRICE, {asset, source, 50000, 1})).size() == 32,
+                    "updatePrice call");
+            state->gets.push_back(calldata(GET_PRICE, {asset}));
+            for (uint64_t px = 0; px < 16; ++px) {
+                state->updates.push_back(calldata(UPDATE_PRICE, {asset, source, 50000 + px, 1}));
+            }
+        }
+        return state;
+    };
+
+    cases.push_back({"router/call", {{"selector", "getPrice"}, {"output", "buffer"}}, ops, 1, [make_state] {
+        auto state = make_state();
+        return Op([state](size_t i) {
+            const auto& data = state->gets[i % state->gets.size()];
+            state->router.call(addresses::LX_ORACLE, data.data(), data.size(), state->out);
+        });
+    }});
+    cases.push_back({"router/call", {{"selector", "getPrice"}, {"output", "vector"}}, ops, 1, [make_state] {
+        auto state = make_state();
+        return Op([state](size_t i) {
+            volatile size_t size = state->router.call(addresses::LX_ORACLE,
+                                                      state->gets[i % state->gets.size()]).size();
+            (void)size;
+        });
+    }});
+    cases.push_back({"router/call", {{"selector", "updatePrice"}, {"output", "buffer"}}, ops, 1, [make_state] {
+        auto state = make_state();
+        return Op([state](size_t i) {
+            const auto& data = state->updates[i % state->updates.size()];
+            state->router.call(addresses::LX_ORACLE, data.data(), data.size(), state->out);
+        });
+    }});
+}
+
+// =============================================================================
+// Main
+// =============================================================================
+
+void usage(const char* argv0) {
+    std::cerr << "usage: " << argv0
+              << " [--filter SUBSTR] [--reps N] [--warmup N] [--quick] [--json PATH] [--list]\n";
+}
+
+bool parse_args(int argc, char** argv, Options& options) {
+    for (int i = 1; i < argc; ++i) {
+        const std::string arg = argv[i];
+        auto value = [&]() -> const char* {
+            return i + 1 < argc ? argv[++i] : nullptr;
+        };
+        if (arg == "--filter") {
+            const char* v = value();
+            if (!v) return false;
+            options.filter = v;
+        } else if (arg == "--json") {
+            const char* v = value();
+            if (!v) return false;
+            options.json_path = v;
+        } else if (arg == "--reps" || arg == "--warmup") {
+            const char* v = value();
+            if (!v) return false;
+            char* end = nullptr;
+            const unsigned long n = std::strtoul(v, &end, 10);
+            if (*end != '\0' || (arg == "--reps" && n == 0)) return false;
+            (arg == "--reps" ? options.reps : options.warmup) = n;
+        } else if (arg == "--quick") {
+            options.quick = true;
+        } else if (arg == "--list") {
+            options.list = true;
+        } else {
+            return false;
+        }
+    }
+    return true;
+}
+
+} // namespace
+
+int main(int argc, char** argv) {
+    Options options;
+    if (!parse_args(argc, argv, options)) {
+        usage(argv[0]);
+        return 2;
+    }
+
+    std::vector<Case> cases;
+    add_orderbook_cases(cases, options);
+    add_engine_cases(cases, options);
+    add_pool_cases(cases, options);
+    add_vault_cases(cases, options);
+    add_oracle_cases(cases, options);
+    add_router_cases(cases, options);
+
+    std::vector<const Case*> selected;
+    for (const Case& c : cases) {
+        if (full_name(c).find(options.filter) != std::string::npos) {
+            selected.push_back(&c);
+        }
+    }
+
+    if (options.list) {
+        for (const Case* c : selected) {
+            std::cout << full_name(*c) << "\n";
+        }
+        return 0;
+    }
+
+    const uint64_t overhead = clock_overhead_ns();
+    std::cout << "=== luxdex_bench: " << selected.size() << " cases, " << options.warmup
+              << " warmup + " << options.reps << " reps, clock overhead "
+              << overhead << " ns ===\n";
+    warn_if_assertions();
+
+    std::vector<CaseResult> results;
+    results.reserve(selected.size());
+    for (const Case* c : selected) {
+        results.push_back(run_case(*c, options));
+        print_result(results.back());
+    }
+
+    if (!options.json_path.empty()) {
+        if (!write_json(options.json_path, results, options, overhead)) {
+            std::cerr << "cannot write " << options.json_path << "\n";
+            return 1;
+        }
+        std::cout << "Report written to " << options.json_path << "\n";
+    }
+    return 0;
+}
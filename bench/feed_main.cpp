@@ -0,0 +1,524 @@
+// =============================================================================
+// feed_main.cpp - luxdex oracle / feed streaming benchmark
+// =============================================================================
+//
+// Streams synthetic multi-source index prices for thousands of assets into
+// LXOracle::update_prices and through LXFeed: each batch republishes the
+// touched markets' marks, checks their resting triggers, and every few
+// batches recomputes funding. Each asset's price is a random walk; every
+// source quotes it with a little noise of its own. Reports update throughput
+// and the latency distribution of each stage:
+//
+//   batch      update_prices call, including everything it drives
+//   mark       batch pushed -> the market's new mark reaches the listener
+//   trigger    batch pushed -> fired thresholds reach the trigger listener
+//   funding    calculate_funding_rates over a producer's markets
+//
+//   luxdex_feed_bench [--assets N] [--sources N] [--batch N] [--updates N]
+//                     [--rate N] [--threads N] [--triggers N] [--funding-every N]
+//                     [--seed N] [--quick] [--json PATH] [--thresholds PATH]
+//
+// --rate N paces the source updates at N per second across all producers
+// instead of pushing as fast as possible. Producers own disjoint slices of
+// the assets. --thresholds PATH checks the run against stored limits (see
+// feed_thresholds.txt) and exits 1 if any is passed, so a CI job can catch
+// a latency or throughput regression.
+
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <cmath>
+#include <cstdio>
+#include <cstdlib>
+#include <fstream>
+#include <iomanip>
+#include <iostream>
+#include <memory>
+#include <sstream>
+#include <string>
+#include <thread>
+#include <tuple>
+#include <vector>
+
+#include "lux/feed.hpp"
+#include "lux/fixed_point.hpp"
+#include "lux/oracle.hpp"
+#include "report.hpp"
+
+using namespace lux;
+using namespace lux::bench;
+
+namespace {
+
+struct Options {
+    size_t assets = 5000;
+    size_t sources = 3;                 // Price sources quoting every asset
+    size_t batch = 256;                 // Source updates per update_prices call
+    size_t updates = 2000000;           // Source updates in the run, all producers
+    double rate = 0;                    // Source updates per second; 0 = as fast as possible
+    size_t threads = 1;
+    size_t triggers = 4;                // Resting thresholds per market
+    size_t funding_every = 64;          // Batches between funding passes
+    uint64_t seed = 1;
+    std::string json_path;
+    std::string thresholds_path;
+};
+
+constexpr PriceSource SOURCES[] = {
+    PriceSource::BINANCE, PriceSource::COINBASE, PriceSource::OKX, PriceSource::BYBIT,
+    PriceSource::UNISWAP, PriceSource::LXPOOL, PriceSource::CHAINLINK, PriceSource::PYTH,
+};
+constexpr size_t MAX_SOURCES = sizeof(SOURCES) / sizeof(SOURCES[0]);
+
+// Thresholds sit this far either side of the index, in steps
+constexpr double TRIGGER_STEP = 0.002;
+
+// splitmix64
+struct Rng {
+    uint64_t state;
+
+    explicit Rng(uint64_t seed) : state(seed * 0x9E3779B97F4A7C15ULL + 1) {}
+
+    uint64_t next() {
+        uint64_t z = (state += 0x9E3779B97F4A7C15ULL);
+        z = (z ^ (z >> 30)) * 0xBF58476D1CE4E5B9ULL;
+        z = (z ^ (z >> 27)) * 0x94D049BB133111EBULL;
+        return z ^ (z >> 31);
+    }
+    uint64_t below(uint64_t n) { return next() % n; }
+    double uniform() { return static_cast<double>(next() >> 11) * 0x1.0p-53; }
+    double symmetric() { return 2.0 * uniform() - 1.0; }
+};
+
+enum StageId { BATCH, MARK, TRIGGER, FUNDING, STAGES };
+
+struct StageSet {
+    Stage stages[STAGES] = {{"batch", {}}, {"mark", {}}, {"trigger", {}}, {"funding", {}}};
+};
+
+// =============================================================================
+// Producers
+// =============================================================================
+
+// One producer's state; the feed's listeners run on the producer's thread
+// and find it through `current`
+struct Producer {
+    static thread_local Producer* current;
+
+    size_t first_asset = 0;             // Slice [first_asset, end_asset)
+    size_t end_asset = 0;
+    size_t updates = 0;                 // Source updates to push
+    Rng rng{1};
+    std::vector<double> mids;           // Walk per asset in the slice
+    std::vector<uint32_t> markets;
+    StageSet result;
+    Clock::time_point pushed;           // Start of the batch in flight
+    std::vector<LXFeed::FiredTrigger> fired;
+    uint64_t marks = 0;
+    uint64_t fired_count = 0;
+};
+
+thread_local Producer* Producer::current = nullptr;
+
+uint64_t asset_id(size_t index) { return index + 1; }
+
+double initial_mid(size_t index) {
+    return 10.0 + static_cast<double>(index % 997) * 3.0;
+}
+
+bool setup(LXOracle& oracle, LXFeed& feed, const Options& options) {
+    std::vector<PriceSource> sources(SOURCES, SOURCES + options.sources);
+    for (size_t a = 0; a < options.assets; ++a) {
+        OracleConfig config{};
+        config.asset_id = asset_id(a);
+        config.max_staleness = 3600;
+        config.max_deviation_x18 = x18::from_double(0.5);
+        config.method = AggregationMethod::MEDIAN;
+        config.sources = sources;
+        if (oracle.register_asset(config) != errors::OK) {
+            std::cerr << "cannot register asset " << config.asset_id << "\n";
+            return false;
+        }
+
+        const auto market_id = static_cast<uint32_t>(asset_id(a));
+        if (feed.register_market(market_id, config.asset_id) != errors::OK) {
+            std::cerr << "cannot register market " << market_id << "\n";
+            return false;
+        }
+        FundingParams funding{};
+        funding.funding_interval = 28800;
+        funding.max_funding_rate_x18 = x18::from_bps(100);
+        funding.interest_rate_x18 = x18::from_bps(1);
+        funding.premium_fraction_x18 = X18_ONE;
+        funding.use_twap_premium = true;
+        feed.set_funding_params(market_id, funding);
+
+        // Seed every source, so the first timed batch already has an index
+        const double mid = initial_mid(a);
+        for (PriceSource source : sources) {
+            oracle.update_price(config.asset_id, source, x18::from_double(mid), 0);
+        }
+        feed.record_premium(market_id, x18::from_double(mid * 0.0001));
+    }
+    return true;
+}
+
+// Thresholds k steps either side of the current mid, for k = 1..count/2
+void arm_triggers(LXFeed& feed, uint32_t market_id, double mid, size_t count) {
+    static constexpr TriggerType TYPES[] = {TriggerType::STOP_LOSS, TriggerType::TAKE_PROFIT,
+                                            TriggerType::LIQUIDATION};
+    for (size_t k = 0; k < count; ++k) {
+        const bool is_buy = k % 2 == 0;
+        const double offset = TRIGGER_STEP * static_cast<double>(k / 2 + 1);
+        const double price = is_buy ? mid * (1.0 - offset) : mid * (1.0 + offset);
+        feed.add_trigger(market_id, TYPES[k % 3], is_buy, x18::from_double(price));
+    }
+}
+
+void run_producer(LXOracle& oracle, LXFeed& feed, const Options& options, Producer& producer,
+                  double rate, std::atomic<bool>& go) {
+    Producer::current = &producer;
+    const size_t slice = producer.end_asset - producer.first_asset;
+    std::vector<std::tuple<uint64_t, PriceSource, I128, I128>> batch;
+    batch.reserve(options.batch);
+
+    while (!go.load(std::memory_order_acquire)) {
+    }
+    const auto start = Clock::now();
+    size_t pushed = 0;
+    size_t batches = 0;
+    while (pushed < producer.updates) {
+        const size_t n = std::min(options.batch, producer.updates - pushed);
+        if (rate > 0) {
+            const auto due = start + std::chrono::nanoseconds(static_cast<int64_t>(
+                static_cast<double>(pushed) * 1e9 / rate));
+            while (Clock::now() < due) {
+            }
+        }
+
+        // Random (asset, source) quotes; the asset's walk steps on each
+        batch.clear();
+        for (size_t i = 0; i < n; ++i) {
+            const size_t local = producer.rng.below(slice);
+            double& mid = producer.mids[local];
+            mid *= 1.0 + 0.0005 * producer.rng.symmetric();
+            const double quote = mid * (1.0 + 0.0002 * producer.rng.symmetric());
+            const PriceSource source = SOURCES[producer.rng.below(options.sources)];
+            batch.emplace_back(asset_id(producer.first_asset + local), source,
+                               x18::from_double(quote), x18::from_double(quote * 0.0001));
+        }
+
+        producer.pushed = Clock::now();
+        oracle.update_prices(batch);
+        producer.result.stages[BATCH].latencies_ns.push_back(elapsed_ns(producer.pushed, Clock::now()));
+        pushed += n;
+        ++batches;
+
+        // Re-arm what fired at the same distance from the new mid, untimed
+        for (const auto& f : producer.fired) {
+            const double mid = producer.mids[f.market_id - 1 - producer.first_asset];
+            const double offset = TRIGGER_STEP * (1.0 + static_cast<double>(producer.rng.below(2)));
+            const double price = f.is_buy ? mid * (1.0 - offset) : mid * (1.0 + offset);
+            feed.add_trigger(f.market_id, f.type, f.is_buy, x18::from_double(price));
+        }
+        producer.fired.clear();
+
+        if (options.funding_every > 0 && batches % options.funding_every == 0) {
+            const auto t0 = Clock::now();
+            feed.calculate_funding_rates(producer.markets);
+            producer.result.stages[FUNDING].latencies_ns.push_back(elapsed_ns(t0, Clock::now()));
+        }
+    }
+    Producer::current = nullptr;
+}
+
+struct RunResult {
+    StageSet stages;
+    uint64_t updates = 0;
+    uint64_t batches = 0;
+    uint64_t marks = 0;
+    uint64_t fired = 0;
+    double seconds = 0;
+
+    double updates_per_sec() const { return seconds > 0 ? static_cast<double>(updates) / seconds : 0; }
+    double marks_per_sec() const { return seconds > 0 ? static_cast<double>(marks) / seconds : 0; }
+};
+
+bool run(const Options& options, RunResult& result) {
+    LXOracle oracle;
+    LXFeed feed(oracle);
+    if (!setup(oracle, feed, options)) {
+        return false;
+    }
+
+    feed.set_price_listener([](uint32_t, PriceType type, I128) {
+        Producer* producer = Producer::current;
+        if (producer && type == PriceType::MARK) {
+            producer->result.stages[MARK].latencies_ns.push_back(elapsed_ns(producer->pushed, Clock::now()));
+            ++producer->marks;
+        }
+    });
+    feed.set_trigger_listener([](const std::vector<LXFeed::FiredTrigger>& fired) {
+        Producer* producer = Producer::current;
+        if (producer) {
+            producer->result.stages[TRIGGER].latencies_ns.push_back(elapsed_ns(producer->pushed, Clock::now()));
+            producer->fired.insert(producer->fired.end(), fired.begin(), fired.end());
+            producer->fired_count += fired.size();
+        }
+    });
+
+    const size_t threads = std::min(options.threads, options.assets);
+    std::vector<std::unique_ptr<Producer>> producers;
+    for (size_t t = 0; t < threads; ++t) {
+        auto producer = std::make_unique<Producer>();
+        producer->first_asset = options.assets * t / threads;
+        producer->end_asset = options.assets * (t + 1) / threads;
+        producer->updates = options.updates * (t + 1) / threads - options.updates * t / threads;
+        producer->rng = Rng(options.seed * 1000003 + t);
+        for (size_t a = producer->first_asset; a < producer->end_asset; ++a) {
+            const auto market_id = static_cast<uint32_t>(asset_id(a));
+            producer->mids.push_back(initial_mid(a));
+            producer->markets.push_back(market_id);
+            arm_triggers(feed, market_id, initial_mid(a), options.triggers);
+        }
+        const size_t batches = (producer->updates + options.batch - 1) / options.batch;
+        for (Stage& stage : producer->result.stages) {
+            stage.latencies_ns.reserve(&stage == &producer->result.stages[MARK] ? producer->updates : batches);
+        }
+        producers.push_back(std::move(producer));
+    }
+
+    std::atomic<bool> go{false};
+    std::vector<std::thread> workers;
+    const double rate = options.rate / static_cast<double>(threads);
+    for (auto& producer : producers) {
+        workers.emplace_back(run_producer, std::ref(oracle), std::ref(feed), std::cref(options),
+                             std::ref(*producer), rate, std::ref(go));
+    }
+    const auto start = Clock::now();
+    go.store(true, std::memory_order_release);
+    for (auto& worker : workers) {
+        worker.join();
+    }
+    result.seconds = std::chrono::duration<double>(Clock::now() - start).count();
+
+    for (auto& producer : producers) {
+        for (size_t s = 0; s < STAGES; ++s) {
+            auto& from = producer->result.stages[s].latencies_ns;
+            auto& to = result.stages.stages[s].latencies_ns;
+            to.insert(to.end(), from.begin(), from.end());
+        }
+        result.updates += producer->updates;
+        result.batches += producer->result.stages[BATCH].latencies_ns.size();
+        result.marks += producer->marks;
+        result.fired += producer->fired_count;
+    }
+    for (Stage& stage : result.stages.stages) {
+        std::sort(stage.latencies_ns.begin(), stage.latencies_ns.end());
+    }
+    return true;
+}
+
+// =============================================================================
+// Report
+// =============================================================================
+
+void print_report(const RunResult& r, const Options& options) {
+    std::cout << "pushed " << r.updates << " source updates (" << options.sources << " sources, "
+              << options.assets << " assets, " << r.batches << " batches of " << options.batch
+              << ", " << options.threads << " producer" << (options.threads == 1 ? "" : "s")
+              << ") in " << std::fixed << std::setprecision(3) << r.seconds << " s: "
+              << std::setprecision(0) << r.updates_per_sec() << " updates/s, " << r.marks_per_sec()
+              << " marks/s" << (options.rate > 0 ? " (paced)" : "") << "\n";
+    print_stage_header(10);
+    for (const Stage& stage : r.stages.stages) {
+        print_stage(stage, 10);
+    }
+    std::cout << "triggers fired " << r.fired << "\n";
+}
+
+bool write_json(const std::string& path, const RunResult& r, const Options& options) {
+    std::ofstream out(path);
+    if (!out) {
+        return false;
+    }
+    write_json_preamble(out, "luxdex_feed_bench");
+    out << "  \"config\": {\"assets\": " << options.assets << ", \"sources\": " << options.sources
+        << ", \"batch\": " << options.batch << ", \"updates\": " << options.updates
+        << ", \"rate\": " << options.rate << ", \"threads\": " << options.threads
+        << ", \"triggers\": " << options.triggers << ", \"funding_every\": " << options.funding_every
+        << ", \"seed\": " << options.seed << "},\n";
+    out << "  \"seconds\": " << std::setprecision(6) << r.seconds << std::setprecision(1) << ",\n";
+    out << "  \"updates_per_sec\": " << r.updates_per_sec() << ",\n";
+    out << "  \"marks_per_sec\": " << r.marks_per_sec() << ",\n";
+    out << "  \"triggers_fired\": " << r.fired << ",\n";
+    write_stages_json(out, r.stages.stages, STAGES);
+    return static_cast<bool>(out);
+}
+
+// =============================================================================
+// Thresholds
+// =============================================================================
+
+// Metric by name: "updates_per_sec", "marks_per_sec", or "<stage>.<p50|p90|
+// p99|p999|max>_ns"
+bool metric(const RunResult& r, const std::string& name, double& value) {
+    if (name == "updates_per_sec") {
+        value = r.updates_per_sec();
+        return true;
+    }
+    if (name == "marks_per_sec") {
+        value = r.marks_per_sec();
+        return true;
+    }
+    const size_t dot = name.find('.');
+    if (dot == std::string::npos) {
+        return false;
+    }
+    const std::string stage = name.substr(0, dot);
+    const std::string stat = name.substr(dot + 1);
+    for (const Stage& s : r.stages.stages) {
+        if (stage != s.name) {
+            continue;
+        }
+        const auto& lat = s.latencies_ns;
+        if (stat == "p50_ns") value = static_cast<double>(percentile(lat, 0.50));
+        else if (stat == "p90_ns") value = static_cast<double>(percentile(lat, 0.90));
+        else if (stat == "p99_ns") value = static_cast<double>(percentile(lat, 0.99));
+        else if (stat == "p999_ns") value = static_cast<double>(percentile(lat, 0.999));
+        else if (stat == "max_ns") value = static_cast<double>(lat.empty() ? 0 : lat.back());
+        else return false;
+        return true;
+    }
+    return false;
+}
+
+// One "<metric> <= <limit>" or "<metric> >= <limit>" per line; '#' starts
+// a comment. Prints each check; false if any fails or the file is bad.
+bool check_thresholds(const std::string& path, const RunResult& r) {
+    std::ifstream in(path);
+    if (!in) {
+        std::cerr << "cannot read " << path << "\n";
+        return false;
+    }
+
+    bool passed = true;
+    std::string line;
+    for (size_t number = 1; std::getline(in, line); ++number) {
+        line = line.substr(0, line.find('#'));
+        std::istringstream fields(line);
+        std::string name;
+        std::string op;
+        double limit = 0;
+        if (!(fields >> name)) {
+            continue;   // Blank or comment
+        }
+        double value = 0;
+        if (!(fields >> op >> limit) || (op != "<=" && op != ">=") || !metric(r, name, value)) {
+            std::cerr << path << ":" << number << ": bad threshold \"" << line << "\"\n";
+            passed = false;
+            continue;
+        }
+        const bool ok = op == "<=" ? value <= limit : value >= limit;
+        std::cout << (ok ? "pass  " : "FAIL  ") << std::left << std::setw(20) << name << std::right
+                  << std::fixed << std::setprecision(0) << std::setw(14) << value << " " << op << " "
+                  << limit << "\n";
+        passed &= ok;
+    }
+    return passed;
+}
+
+// =============================================================================
+// Main
+// =============================================================================
+
+void usage(const char* argv0) {
+    std::cerr << "usage: " << argv0 << " [--assets N] [--sources N] [--batch N] [--updates N]\n"
+              << "       [--rate N] [--threads N] [--triggers N] [--funding-every N] [--seed N]\n"
+              << "       [--quick] [--json PATH] [--thresholds PATH]\n";
+}
+
+bool parse_args(int argc, char** argv, Options& options) {
+    for (int i = 1; i < argc; ++i) {
+        const std::string arg = argv[i];
+        auto value = [&]() -> const char* {
+            return i + 1 < argc ? argv[++i] : nullptr;
+        };
+        auto number = [&](double& out) {
+            const char* v = value();
+            if (!v) return false;
+            char* end = nullptr;
+            out = std::strtod(v, &end);
+            return *end == '\0' && out >= 0;
+        };
+        auto count = [&](size_t& out) {
+            double n = 0;
+            if (!number(n)) return false;
+            out = static_cast<size_t>(n);
+            return true;
+        };
+        if (arg == "--json" || arg == "--thresholds") {
+            const char* v = value();
+            if (!v) return false;
+            (arg == "--json" ? options.json_path : options.thresholds_path) = v;
+        } else if (arg == "--assets") {
+            if (!count(options.assets) || options.assets == 0) return false;
+        } else if (arg == "--sources") {
+            if (!count(options.sources) || options.sources == 0 || options.sources > MAX_SOURCES) return false;
+        } else if (arg == "--batch") {
+            if (!count(options.batch) || options.batch == 0) return false;
+        } else if (arg == "--updates") {
+            if (!count(options.updates)) return false;
+        } else if (arg == "--rate") {
+            if (!number(options.rate)) return false;
+        } else if (arg == "--threads") {
+            if (!count(options.threads) || options.threads == 0) return false;
+        } else if (arg == "--triggers") {
+            if (!count(options.triggers)) return false;
+        } else if (arg == "--funding-every") {
+            if (!count(options.funding_every)) return false;
+        } else if (arg == "--seed") {
+            size_t seed = 0;
+            if (!count(seed)) return false;
+            options.seed = seed;
+        } else if (arg == "--quick") {
+            options.assets = 1000;
+            options.updates = 200000;
+        } else {
+            return false;
+        }
+    }
+    return true;
+}
+
+} // namespace
+
+int main(int argc, char** argv) {
+    Options options;
+    if (!parse_args(argc, argv, options)) {
+        usage(argv[0]);
+        return 2;
+    }
+    options.threads = std::min(options.threads, options.assets);
+
+    warn_if_assertions();
+    RunResult result;
+    if (!run(options, result)) {
+        return 1;
+    }
+    print_report(result, options);
+
+    if (!options.json_path.empty()) {
+        if (!write_json(options.json_path, result, options)) {
+            std::cerr << "cannot write " << options.json_path << "\n";
+            return 1;
+        }
+        std::cout << "Report written to " << options.json_path << "\n";
+    }
+
+    if (!options.thresholds_path.empty() && !check_thresholds(options.thresholds_path, result)) {
+        std::cerr << "thresholds in " << options.thresholds_path << " not met\n";
+        return 1;
+    }
+    return 0;
+}
@@ -0,0 +1,552 @@
+// =============================================================================
+// replay_main.cpp - luxdex order-flow replay benchmark
+// =============================================================================
+//
+// Generates a realistic order flow (see workload.hpp) into a journal, then
+// replays it through a full LX stack: orders and cancels into LXBook, fills
+// through the settlement pipeline into LXVault, index prices through
+// LXOracle/LXFeed, and a liquidation pass after every mark. Reports the
+// sustained record rate and the latency distribution of each stage:
+//
+//   book/place, book/sweep, book/cancel   LXBook call, on the replay thread
+//   settlement                            fill published -> settled by the vault
+//   feed                                  index update -> mark pushed to book and vault
+//   vault                                 LX::run_liquidations after the mark
+//
+//   luxdex_replay [--generate PATH] [--replay PATH] [workload options]
+//                 [--pace X] [--sync-settlement] [--max-leverage X] [--json PATH]
+//                 [--trace PATH]
+//
+// With neither --generate nor --replay the flow goes to a temporary journal
+// that is replayed and removed. --pace X replays at X times the recorded
+// arrival rate instead of as fast as possible; latencies then show the
+// stack under the flow's own bursts. --trace PATH turns on the library's
+// span tracing (lux/tracing.hpp) for the replay, prints its per-span
+// latencies and writes them to PATH: the binary dump when PATH ends in
+// .bin, Prometheus text otherwise.
+
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <cstdio>
+#include <cstdlib>
+#include <filesystem>
+#include <fstream>
+#include <iomanip>
+#include <iostream>
+#include <sstream>
+#include <string>
+#include <thread>
+#include <unordered_map>
+#include <unistd.h>
+#include <vector>
+
+#include "lux/journal.hpp"
+#include "lux/lx.hpp"
+#include "lux/tracing.hpp"
+#include "report.hpp"
+#include "workload.hpp"
+
+using namespace lux;
+using namespace lux::bench;
+
+namespace {
+
+struct Options {
+    WorkloadConfig workload;
+    std::string generate_path;
+    std::string replay_path;
+    std::string json_path;
+    std::string trace_path;
+    double pace = 0;                    // 0 = as fast as possible
+    bool async_settlement = true;
+    double max_leverage = 9.5;          // Highest trader funding leverage
+    double maker_collateral = 1e9;
+};
+
+enum StageId { BOOK_PLACE, BOOK_SWEEP, BOOK_CANCEL, SETTLEMENT, FEED, VAULT, STAGES };
+
+// =============================================================================
+// Stack Setup
+// =============================================================================
+
+LXAccount workload_account(uint64_t id) {
+    LXAccount account{};
+    for (size_t b = 0; b < 8; ++b) {
+        account.main[19 - b] = static_cast<uint8_t>(id >> (8 * b));
+    }
+    return account;
+}
+
+std::array<uint8_t, 16> workload_cloid(uint64_t id) {
+    std::array<uint8_t, 16> cloid{};
+    for (size_t b = 0; b < 8; ++b) {
+        cloid[b] = static_cast<uint8_t>(id >> (8 * b));
+    }
+    return cloid;
+}
+
+// Journal fixed point (1e8) to x18
+I128 to_x18(int64_t value) {
+    return static_cast<I128>(value) * 10000000000LL;
+}
+
+bool create_market(LX& lx, uint32_t market_id) {
+    OracleConfig oracle{};
+    oracle.asset_id = market_id;
+    oracle.max_staleness = 3600;
+    oracle.max_deviation_x18 = x18::from_double(0.5);
+    oracle.method = AggregationMethod::MEDIAN;
+    oracle.sources = {PriceSource::BINANCE};
+    if (lx.oracle().register_asset(oracle) != errors::OK) {
+        return false;
+    }
+
+    MarketConfig vault{};
+    vault.market_id = market_id;
+    vault.initial_margin_x18 = x18::from_double(0.1);
+    vault.maintenance_margin_x18 = x18::from_double(0.05);
+    vault.max_leverage_x18 = x18::from_int(10);
+    vault.max_position_size_x18 = x18::from_double(1e9);
+    vault.active = true;
+
+    BookMarketConfig book{};
+    book.market_id = market_id;
+    book.symbol_id = market_id;     // Settlement takes a fill's symbol as its vault market
+    book.max_order_size_x18 = x18::from_double(1e9);
+    book.status = 1;
+    return lx.create_perp_market(market_id, market_id, vault, book) == errors::OK;
+}
+
+// Markets and funded accounts for everything the flow touches, untimed.
+// Makers are funded without limit. Each trader gets the gross notional of
+// all its orders over a leverage of its own, spread evenly up to
+// max_leverage, so a shock finds a range of accounts near maintenance.
+bool prepare(LX& lx, const JournalReader& reader, const Options& options) {
+    std::unordered_map<uint64_t, double> gross;     // account -> order notional
+    for (const JournalRecord& record : reader) {
+        if (record.type == JournalRecordType::AddSymbol) {
+            if (!create_market(lx, static_cast<uint32_t>(record.symbol_id))) {
+                std::cerr << "cannot create market " << record.symbol_id << "\n";
+                return false;
+            }
+        } else if (record.type == JournalRecordType::Place && record.order.tif == TimeInForce::IOC) {
+            gross[record.order.account_id] += Order::from_price(record.order.price) *
+                                              Order::from_quantity(record.order.quantity);
+        } else if (record.type == JournalRecordType::Place) {
+            gross.try_emplace(record.order.account_id, 0.0);
+        }
+    }
+    for (const auto& [id, notional] : gross) {
+        double collateral = options.maker_collateral;
+        if (!(id & MAKER_ACCOUNT)) {
+            const double spread = static_cast<double>((id * 0x9E3779B97F4A7C15ULL) >> 11) * 0x1.0p-53;
+            collateral = std::max(notional / (1.0 + (options.max_leverage - 1.0) * spread), 1.0);
+        }
+        lx.vault().deposit(workload_account(id), Currency{}, x18::from_double(collateral));
+    }
+    return true;
+}
+
+// =============================================================================
+// Replay
+// =============================================================================
+
+struct ReplayResult {
+    Stage stages[STAGES] = {{"book/place", {}}, {"book/sweep", {}}, {"book/cancel", {}},
+                            {"settlement", {}}, {"feed", {}}, {"vault", {}}};
+    uint64_t records = 0;
+    double seconds = 0;
+    uint64_t place_rejects = 0;
+    uint64_t cancel_misses = 0;     // Quote or order already filled
+    uint64_t trades = 0;
+    SettlementPipeline::Stats settlement{};
+    LiquidationKeeper::Stats liquidation{};
+};
+
+// Settled watermark over time, sampled by a thread of its own
+class SettlementWatch {
+public:
+    explicit SettlementWatch(const SettlementPipeline& pipeline)
+        : pipeline_(pipeline), thread_([this] { run(); }) {}
+
+    // Stops once `sequence` is settled; returns (watermark, first seen) samples
+    std::vector<std::pair<uint64_t, Clock::time_point>> finish(uint64_t sequence) {
+        until_.store(sequence, std::memory_order_release);
+        stop_.store(true, std::memory_order_release);
+        thread_.join();
+        return std::move(samples_);
+    }
+
+private:
+    void run() {
+        uint64_t seen = 0;
+        for (;;) {
+            const uint64_t settled = pipeline_.settled_sequence();
+            if (settled > seen) {
+                seen = settled;
+                samples_.emplace_back(settled, Clock::now());
+            } else if (stop_.load(std::memory_order_acquire) &&
+                       seen >= until_.load(std::memory_order_acquire)) {
+                return;
+            } else {
+                std::this_thread::yield();
+            }
+        }
+    }
+
+    const SettlementPipeline& pipeline_;
+    std::atomic<uint64_t> until_{0};
+    std::atomic<bool> stop_{false};
+    std::vector<std::pair<uint64_t, Clock::time_point>> samples_;
+    std::thread thread_;
+};
+
+bool replay(const std::string& path, const Options& options, ReplayResult& result) {
+    auto reader = JournalReader::open(path);
+    if (!reader) {
+        std::cerr << "cannot open journal " << path << "\n";
+        return false;
+    }
+
+    LX lx;
+    LX::Config config{};
+    config.engine_config = EngineConfig{};
+    config.enable_hooks = false;
+    config.enable_flash_loans = false;
+    config.funding_interval = 28800;
+    config.default_maker_fee_x18 = x18::from_double(0.0002);
+    config.default_taker_fee_x18 = x18::from_double(0.0005);
+    config.async_settlement = options.async_settlement;
+    lx.initialize(config);
+    if (!prepare(lx, *reader, options)) {
+        return false;
+    }
+    lx.start();
+
+    SettlementPipeline* pipeline = lx.settlement();
+    std::unique_ptr<SettlementWatch> watch;
+    std::vector<std::pair<uint64_t, Clock::time_point>> published;  // (sequence, time)
+    if (pipeline) {
+        watch = std::make_unique<SettlementWatch>(*pipeline);
+        published.reserve(reader->size());
+    }
+    for (Stage& stage : result.stages) {
+        stage.latencies_ns.reserve(reader->size());
+    }
+
+    uint64_t last_published = 0;
+    const auto start = Clock::now();
+    for (const JournalRecord& record : *reader) {
+        if (options.pace > 0) {
+            const auto due = start + std::chrono::nanoseconds(static_cast<int64_t>(
+                static_cast<double>(record.order.timestamp.count()) / options.pace));
+            while (Clock::now() < due) {
+            }
+        }
+
+        const auto market_id = static_cast<uint32_t>(record.symbol_id);
+        const auto t0 = Clock::now();
+        switch (record.type) {
+            case JournalRecordType::Place: {
+                LXOrder order{};
+                order.market_id = market_id;
+                order.is_buy = record.order.side == Side::Buy;
+                order.kind = OrderKind::LIMIT;
+                order.size_x18 = to_x18(record.order.quantity);
+                order.limit_px_x18 = to_x18(record.order.price);
+                order.tif = record.order.tif == TimeInForce::IOC ? TIF::IOC : TIF::GTC;
+                order.cloid = workload_cloid(record.order.id);
+                const LXPlaceResult placed = lx.book().place_order(
+                    workload_account(record.order.account_id), order);
+                result.stages[order.tif == TIF::IOC ? BOOK_SWEEP : BOOK_PLACE].latencies_ns.push_back(
+                    elapsed_ns(t0, Clock::now()));
+                result.place_rejects += placed.status == static_cast<uint8_t>(BookOrderStatus::REJECTED);
+                break;
+            }
+            case JournalRecordType::Cancel: {
+                const int32_t status = lx.book().cancel_by_cloid(
+                    workload_account(record.order.account_id), market_id, workload_cloid(record.order_id));
+                result.stages[BOOK_CANCEL].latencies_ns.push_back(elapsed_ns(t0, Clock::now()));
+                result.cancel_misses += status != errors::OK;
+                break;
+            }
+            case JournalRecordType::Mark: {
+                lx.oracle().update_price(record.symbol_id, PriceSource::BINANCE,
+                                         to_x18(record.new_price), 0);
+                const auto t1 = Clock::now();
+                lx.run_liquidations(market_id);
+                result.stages[FEED].latencies_ns.push_back(elapsed_ns(t0, t1));
+                result.stages[VAULT].latencies_ns.push_back(elapsed_ns(t1, Clock::now()));
+                break;
+            }
+            default:
+                continue;       // Markets were created up front
+        }
+        ++result.records;
+
+        if (pipeline) {
+            const uint64_t sequence = pipeline->published_sequence();
+            if (sequence > last_published) {
+                last_published = sequence;
+                published.emplace_back(sequence, Clock::now());
+            }
+        }
+    }
+
+    // Sustained rate includes settling everything the flow produced
+    if (pipeline) {
+        pipeline->wait_settled(last_published);
+    }
+    result.seconds = std::chrono::duration<double>(Clock::now() - start).count();
+
+    if (watch) {
+        // A publish settles at the first watermark sample that covers it
+        const auto settled = watch->finish(last_published);
+        size_t s = 0;
+        for (const auto& [sequence, at] : published) {
+            while (s < settled.size() && settled[s].first < sequence) {
+                ++s;
+            }
+            if (s == settled.size()) {
+                break;
+            }
+            result.stages[SETTLEMENT].latencies_ns.push_back(
+                settled[s].second > at ? elapsed_ns(at, settled[s].second) : 0);
+        }
+        result.settlement = pipeline->get_stats();
+    }
+    result.trades = lx.book().get_stats().total_trades;
+    result.liquidation = lx.keeper().get_stats();
+    lx.stop();
+
+    for (Stage& stage : result.stages) {
+        std::sort(stage.latencies_ns.begin(), stage.latencies_ns.end());
+    }
+    return true;
+}
+
+// =============================================================================
+// Report
+// =============================================================================
+
+void print_report(const ReplayResult& r, const Options& options) {
+    std::cout << "replayed " << r.records << " records in " << std::fixed << std::setprecision(3)
+              << r.seconds << " s: " << std::setprecision(0)
+              << static_cast<double>(r.records) / r.seconds << " records/s"
+              << (options.pace > 0 ? " (paced)" : "")
+              << (options.async_settlement ? "" : ", settling on the matching thread") << "\n";
+    print_stage_header(14);
+    for (const Stage& stage : r.stages) {
+        if (&stage == &r.stages[SETTLEMENT] && !options.async_settlement) {
+            continue;   // Part of the book stages
+        }
+        print_stage(stage, 14);
+    }
+    std::cout << "trades " << r.trades;
+    if (options.async_settlement) {
+        std::cout << ", settlements applied " << r.settlement.settlements_applied
+                  << " rejected " << r.settlement.settlements_rejected;
+    }
+    std::cout << ", liquidations " << r.liquidation.candidates << " (" << r.liquidation.filled
+              << " closed in full, " << r.liquidation.adl_runs << " ADL runs)"
+              << ", place rejects " << r.place_rejects << ", cancel misses " << r.cancel_misses << "\n";
+}
+
+bool write_json(const std::string& path, const ReplayResult& r, const Options& options,
+                const WorkloadStats* workload) {
+    std::ofstream out(path);
+    if (!out) {
+        return false;
+    }
+    write_json_preamble(out, "luxdex_replay");
+    if (workload) {
+        const WorkloadConfig& w = options.workload;
+        out << "  \"workload\": {\"events\": " << w.events << ", \"markets\": " << w.markets
+            << ", \"accounts\": " << w.accounts << ", \"makers\": " << w.makers
+            << ", \"arrival\": \"" << arrival_name(w.arrival) << "\", \"rate\": " << w.rate
+            << ", \"seed\": " << w.seed << ", \"simulated_s\": " << workload->duration_s << "},\n";
+    }
+    out << "  \"pace\": " << options.pace << ",\n";
+    out << "  \"async_settlement\": " << (options.async_settlement ? "true" : "false") << ",\n";
+    out << "  \"records\": " << r.records << ",\n";
+    out << "  \"seconds\": " << std::setprecision(6) << r.seconds << std::setprecision(1) << ",\n";
+    out << "  \"records_per_sec\": " << static_cast<double>(r.records) / r.seconds << ",\n";
+    out << "  \"trades\": " << r.trades << ",\n";
+    out << "  \"settlements_applied\": " << r.settlement.settlements_applied << ",\n";
+    out << "  \"settlements_rejected\": " << r.settlement.settlements_rejected << ",\n";
+    out << "  \"liquidations\": " << r.liquidation.candidates << ",\n";
+    out << "  \"place_rejects\": " << r.place_rejects << ",\n";
+    out << "  \"cancel_misses\": " << r.cancel_misses << ",\n";
+    write_stages_json(out, r.stages, STAGES);
+    return static_cast<bool>(out);
+}
+
+void print_trace() {
+    std::cout << "\nTrace spans (ns)\n"
+              << std::left << std::setw(16) << "span" << std::right << std::setw(12) << "count"
+              << std::setw(10) << "mean" << std::setw(10) << "p50" << std::setw(10) << "p99"
+              << std::setw(10) << "p99.9" << std::setw(12) << "max" << "\n";
+    for (size_t p = 0; p < TRACE_POINTS; ++p) {
+        const TracePoint point = static_cast<TracePoint>(p);
+        const TraceSummary summary = Tracer::summary(point);
+        std::cout << std::left << std::setw(16) << trace_point_name(point) << std::right
+                  << std::setw(12) << summary.count << std::fixed << std::setprecision(0)
+                  << std::setw(10) << summary.mean_ns() << std::setw(10) << summary.quantile_ns(0.5)
+                  << std::setw(10) << summary.quantile_ns(0.99) << std::setw(10)
+                  << summary.quantile_ns(0.999) << std::setw(12)
+                  << static_cast<double>(summary.max_ticks) * Tracer::ns_per_tick() << "\n";
+    }
+}
+
+// =============================================================================
+// Main
+// =============================================================================
+
+void usage(const char* argv0) {
+    std::cerr << "usage: " << argv0 << " [--generate PATH] [--replay PATH]\n"
+              << "  workload: [--events N] [--markets N] [--accounts N] [--makers N] [--seed N]\n"
+              << "            [--arrival poisson|bursty|hawkes] [--rate N] [--shock-interval N]\n"
+              << "  replay:   [--pace X] [--sync-settlement] [--max-leverage X] [--json PATH]\n"
+              << "            [--trace PATH]\n";
+}
+
+bool parse_args(int argc, char** argv, Options& options) {
+    for (int i = 1; i < argc; ++i) {
+        const std::string arg = argv[i];
+        auto value = [&]() -> const char* {
+            return i + 1 < argc ? argv[++i] : nullptr;
+        };
+        auto number = [&](double& out) {
+            const char* v = value();
+            if (!v) return false;
+            char* end = nullptr;
+            out = std::strtod(v, &end);
+            return *end == '\0' && out >= 0;
+        };
+        auto count = [&](size_t& out) {
+            double n = 0;
+            if (!number(n)) return false;
+            out = static_cast<size_t>(n);
+            return true;
+        };
+        WorkloadConfig& w = options.workload;
+        if (arg == "--generate" || arg == "--replay" || arg == "--json" || arg == "--trace") {
+            const char* v = value();
+            if (!v) return false;
+            (arg == "--generate" ? options.generate_path
+             : arg == "--replay" ? options.replay_path
+             : arg == "--json"   ? options.json_path : options.trace_path) = v;
+        } else if (arg == "--arrival") {
+            const char* v = value();
+            if (!v || !parse_arrival(v, w.arrival)) return false;
+        } else if (arg == "--events") {
+            if (!count(w.events)) return false;
+        } else if (arg == "--markets") {
+            if (!count(w.markets) || w.markets == 0) return false;
+        } else if (arg == "--accounts") {
+            if (!count(w.accounts) || w.accounts == 0) return false;
+        } else if (arg == "--makers") {
+            if (!count(w.makers)) return false;
+        } else if (arg == "--shock-interval") {
+            if (!count(w.shock_interval)) return false;
+        } else if (arg == "--seed") {
+            size_t seed = 0;
+            if (!count(seed)) return false;
+            w.seed = seed;
+        } else if (arg == "--rate") {
+            if (!number(w.rate) || w.rate == 0) return false;
+        } else if (arg == "--pace") {
+            if (!number(options.pace)) return false;
+        } else if (arg == "--max-leverage") {
+            if (!number(options.max_leverage) || options.max_leverage < 1) return false;
+        } else if (arg == "--sync-settlement") {
+            options.async_settlement = false;
+        } else {
+            return false;
+        }
+    }
+    return true;
+}
+
+} // namespace
+
+int main(int argc, char** argv) {
+    Options options;
+    if (!parse_args(argc, argv, options) ||
+        (!options.generate_path.empty() && !options.replay_path.empty())) {
+        usage(argv[0]);
+        return 2;
+    }
+
+    const bool temporary = options.generate_path.empty() && options.replay_path.empty();
+    std::string path = options.replay_path;
+    WorkloadStats workload{};
+    const bool generated = options.replay_path.empty();
+    if (generated) {
+        path = temporary
+            ? (std::filesystem::temp_directory_path() /
+               ("luxdex_workload_" + std::to_string(::getpid()) + ".journal")).string()
+            : options.generate_path;
+        const auto start = Clock::now();
+        if (!generate_workload(options.workload, path, &workload)) {
+            std::cerr << "cannot write workload to " << path << "\n";
+            return 1;
+        }
+        const WorkloadConfig& w = options.workload;
+        std::cout << "generated " << workload.records << " records (" << workload.places << " places, "
+                  << workload.sweeps << " of them sweeps, " << workload.cancels << " cancels, "
+                  << workload.marks << " marks, " << workload.shocks << " shocks): " << w.events
+                  << " " << arrival_name(w.arrival) << " events over " << w.markets << " markets, "
+                  << w.accounts << " traders, " << w.makers << " makers, " << std::fixed
+                  << std::setprecision(3) << workload.duration_s << " s of flow, in "
+                  << std::chrono::duration<double>(Clock::now() - start).count() << " s\n";
+        if (!temporary) {
+            std::cout << "workload written to " << path << "\n";
+            return 0;
+        }
+    }
+
+    warn_if_assertions();
+    ReplayResult result;
+    if (!options.trace_path.empty()) {
+        Tracer::enable(Tracer::DEFAULT_EVENT_CAPACITY);
+    }
+    const bool ok = replay(path, options, result);
+    Tracer::disable();
+    if (temporary) {
+        std::remove(path.c_str());
+    }
+    if (!ok) {
+        return 1;
+    }
+    print_report(result, options);
+
+    if (!options.trace_path.empty()) {
+        print_trace();
+        const std::string& trace = options.trace_path;
+        const bool binary = trace.size() >= 4 && trace.compare(trace.size() - 4, 4, ".bin") == 0;
+        bool written = false;
+        if (binary) {
+            written = Tracer::write_binary(trace);
+        } else {
+            std::ofstream out(trace);
+            out << Tracer::prometheus();
+            written = static_cast<bool>(out);
+        }
+        if (!written) {
+            std::cerr << "cannot write " << trace << "\n";
+            return 1;
+        }
+        std::cout << "Trace written to " << trace << "\n";
+    }
+
+    if (!options.json_path.empty()) {
+        if (!write_json(options.json_path, result, options, generated ? &workload : nullptr)) {
+            std::cerr << "cannot write " << options.json_path << "\n";
+            return 1;
+        }
+        std::cout << "Report written to " << options.json_path << "\n";
+    }
+    return 0;
+}
@@ -0,0 +1,166 @@
+// =============================================================================
+// report.hpp - timing and reporting helpers shared by the luxdex benchmarks
+// =============================================================================
+//
+// Latency sampling, percentiles and the pieces of the text and JSON reports
+// that luxdex_bench, luxdex_replay and luxdex_feed_bench have in common.
+// Every JSON report opens with the same preamble (suite, version, build)
+// and writes latencies as the same {"min", "mean", "p50", ..., "max"}
+// object, so one tracker can read all three.
+
+#ifndef LUXDEX_BENCH_REPORT_HPP
+#define LUXDEX_BENCH_REPORT_HPP
+
+#include <algorithm>
+#include <chrono>
+#include <cstddef>
+#include <cstdint>
+#include <iomanip>
+#include <iostream>
+#include <ostream>
+#include <sstream>
+#include <string>
+#include <thread>
+#include <vector>
+
+namespace lux::bench {
+
+using Clock = std::chrono::steady_clock;
+
+inline uint64_t elapsed_ns(Clock::time_point from, Clock::time_point to) {
+    return static_cast<uint64_t>(std::chrono::duration_cast<std::chrono::nanoseconds>(to - from).count());
+}
+
+// Nearest-rank percentile of sorted values
+template<typename T>
+T percentile(const std::vector<T>& sorted, double q) {
+    if (sorted.empty()) {
+        return T{};
+    }
+    size_t rank = static_cast<size_t>(q * static_cast<double>(sorted.size()) + 0.5);
+    rank = std::clamp<size_t>(rank, 1, sorted.size());
+    return sorted[rank - 1];
+}
+
+inline std::string format_ns(uint64_t ns) {
+    std::ostringstream out;
+    out << std::fixed << std::setprecision(1);
+    if (ns >= 1000000000) {
+        out << static_cast<double>(ns) / 1e9 << " s";
+    } else if (ns >= 1000000) {
+        out << static_cast<double>(ns) / 1e6 << " ms";
+    } else if (ns >= 10000) {
+        out << static_cast<double>(ns) / 1e3 << " us";
+    } else {
+        out << std::setprecision(0) << static_cast<double>(ns) << " ns";
+    }
+    return out.str();
+}
+
+// Latencies of one pipeline stage; sorted before reporting
+struct Stage {
+    const char* name;
+    std::vector<uint64_t> latencies_ns;
+};
+
+// Benchmarks built with assertions measure the checks, not the engine
+inline void warn_if_assertions() {
+#ifndef NDEBUG
+    std::cout << "warning: assertions are enabled; build with CMAKE_BUILD_TYPE=Release\n";
+#endif
+}
+
+// =============================================================================
+// Text report
+// =============================================================================
+
+inline void print_stage_header(int name_width) {
+    std::cout << std::left << std::setw(name_width) << "stage" << std::right << std::setw(10) << "count"
+              << std::setw(10) << "p50" << std::setw(10) << "p90" << std::setw(10) << "p99"
+              << std::setw(10) << "p99.9" << std::setw(10) << "max" << "\n";
+}
+
+inline void print_stage(const Stage& stage, int name_width) {
+    const auto& lat = stage.latencies_ns;
+    std::cout << std::left << std::setw(name_width) << stage.name << std::right << std::setw(10) << lat.size()
+              << std::setw(10) << format_ns(percentile(lat, 0.50))
+              << std::setw(10) << format_ns(percentile(lat, 0.90))
+              << std::setw(10) << format_ns(percentile(lat, 0.99))
+              << std::setw(10) << format_ns(percentile(lat, 0.999))
+              << std::setw(10) << format_ns(lat.empty() ? 0 : lat.back()) << "\n";
+}
+
+// =============================================================================
+// JSON report
+// =============================================================================
+
+inline std::string json_escape(const std::string& s) {
+    std::string out;
+    for (char ch : s) {
+        if (ch == '"' || ch == '\\') {
+            out += '\\';
+        }
+        out += ch;
+    }
+    return out;
+}
+
+// Opens the report object and writes the fields every suite carries; the
+// caller adds its own fields and closes the object
+inline void write_json_preamble(std::ostream& out, const char* suite) {
+    const auto now = std::chrono::duration_cast<std::chrono::seconds>(
+        std::chrono::system_clock::now().time_since_epoch()).count();
+    out << std::fixed << std::setprecision(1);
+    out << "{\n";
+    out << "  \"suite\": \"" << suite << "\",\n";
+    out << "  \"version\": 1,\n";
+    out << "  \"timestamp\": " << now << ",\n";
+    out << "  \"compiler\": \"" << json_escape(
+#if defined(__clang__)
+        "clang " __clang_version__
+#elif defined(__GNUC__)
+        "gcc " __VERSION__
+#else
+        "unknown"
+#endif
+    ) << "\",\n";
+#ifdef NDEBUG
+    out << "  \"assertions\": false,\n";
+#else
+    out << "  \"assertions\": true,\n";
+#endif
+    out << "  \"hardware_threads\": " << std::thread::hardware_concurrency() << ",\n";
+}
+
+// {"min": ..., "mean": ..., "p50": ..., "p90": ..., "p99": ..., "p999": ..., "max": ...}
+inline void write_latency_json(std::ostream& out, const std::vector<uint64_t>& sorted) {
+    double mean = 0;
+    for (uint64_t ns : sorted) {
+        mean += static_cast<double>(ns);
+    }
+    mean = sorted.empty() ? 0 : mean / static_cast<double>(sorted.size());
+
+    out << "{\"min\": " << (sorted.empty() ? 0 : sorted.front())
+        << ", \"mean\": " << mean
+        << ", \"p50\": " << percentile(sorted, 0.50)
+        << ", \"p90\": " << percentile(sorted, 0.90)
+        << ", \"p99\": " << percentile(sorted, 0.99)
+        << ", \"p999\": " << percentile(sorted, 0.999)
+        << ", \"max\": " << (sorted.empty() ? 0 : sorted.back()) << "}";
+}
+
+// The "stages" array, last field of the report, and the closing brace
+inline void write_stages_json(std::ostream& out, const Stage* stages, size_t count) {
+    out << "  \"stages\": [";
+    for (size_t i = 0; i < count; ++i) {
+        out << (i ? ",\n" : "\n") << "    {\"name\": \"" << stages[i].name
+            << "\", \"count\": " << stages[i].latencies_ns.size() << ", \"latency_ns\": ";
+        write_latency_json(out, stages[i].latencies_ns);
+        out << "}";
+    }
+    out << "\n  ]\n}\n";
+}
+
+} // namespace lux::bench
+
+#endif // LUXDEX_BENCH_REPORT_HPP
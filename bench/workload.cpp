@@ -0,0 +1,369 @@
+// =============================================================================
+// workload.cpp - synthetic order flow generator
+// =============================================================================
+
+#include "workload.hpp"
+
+#include <algorithm>
+#include <cmath>
+#include <cstdio>
+#include <memory>
+#include <vector>
+
+#include "lux/journal.hpp"
+#include "lux/order.hpp"
+
+namespace lux::bench {
+
+namespace {
+
+// Deterministic on every platform, unlike the std distributions
+struct Rng {
+    uint64_t state;
+    explicit Rng(uint64_t seed) : state(seed * 0x9E3779B97F4A7C15ULL + 1) {}
+    uint64_t next() {
+        state = state * 6364136223846793005ULL + 1442695040888963407ULL;
+        uint64_t x = state;
+        x ^= x >> 33;
+        x *= 0xFF51AFD7ED558CCDULL;
+        x ^= x >> 33;
+        return x;
+    }
+    double uniform() { return static_cast<double>(next() >> 11) * 0x1.0p-53; }   // [0, 1)
+    size_t below(size_t n) { return static_cast<size_t>(next() % n); }
+    bool coin() { return (next() & 1) != 0; }
+    double exponential(double mean) { return -mean * std::log1p(-uniform()); }
+    // 0, 1, 2, ... with P(k) = (1 - p)^k p
+    size_t geometric(double p, size_t max) {
+        size_t k = 0;
+        while (k < max && uniform() >= p) ++k;
+        return k;
+    }
+};
+
+// Inter-arrival times of the configured process, in seconds
+class Arrivals {
+public:
+    explicit Arrivals(const WorkloadConfig& config) : config_(config) {
+        const double f = std::clamp(config.burst_fraction, 1e-6, 1.0 - 1e-6);
+        calm_rate_ = config.rate / ((1.0 - f) + f * config.burst_factor);
+        burst_rate_ = calm_rate_ * config.burst_factor;
+        burst_s_ = config.burst_ms / 1000.0;
+        calm_s_ = burst_s_ * (1.0 - f) / f;
+
+        const double n = std::clamp(config.branching, 0.0, 0.99);
+        beta_ = 1000.0 / config.decay_ms;
+        mu_ = config.rate * (1.0 - n);     // Stationary rate mu / (1 - n) = rate
+        alpha_ = n * beta_;                 // Each arrival adds n arrivals on average
+    }
+
+    double next(Rng& rng) {
+        switch (config_.arrival) {
+            case ArrivalProcess::Poisson:
+                now_ += rng.exponential(1.0 / config_.rate);
+                return now_;
+
+            case ArrivalProcess::Bursty:
+                for (;;) {
+                    if (regime_end_ == 0) {
+                        regime_end_ = rng.exponential(calm_s_);
+                    }
+                    // Memoryless: a draw that overruns the regime is redrawn in the next
+                    const double dt = rng.exponential(1.0 / (bursting_ ? burst_rate_ : calm_rate_));
+                    if (now_ + dt < regime_end_) {
+                        now_ += dt;
+                        return now_;
+                    }
+                    now_ = regime_end_;
+                    bursting_ = !bursting_;
+                    regime_end_ = now_ + rng.exponential(bursting_ ? burst_s_ : calm_s_);
+                }
+
+            case ArrivalProcess::Hawkes:
+                // Ogata thinning: the intensity only decays between arrivals,
+                // so its current value bounds it until the next one
+                for (;;) {
+                    const double bound = mu_ + excitation_;
+                    const double dt = rng.exponential(1.0 / bound);
+                    now_ += dt;
+                    excitation_ *= std::exp(-beta_ * dt);
+                    if (rng.uniform() * bound <= mu_ + excitation_) {
+                        excitation_ += alpha_;
+                        return now_;
+                    }
+                }
+        }
+        return now_;
+    }
+
+private:
+    const WorkloadConfig& config_;
+    double now_ = 0;
+
+    double calm_rate_, burst_rate_, calm_s_, burst_s_;
+    double regime_end_ = 0;
+    bool bursting_ = false;
+
+    double mu_, alpha_, beta_;
+    double excitation_ = 0;
+};
+
+struct Quote {
+    uint64_t cloid;
+    bool is_buy;
+    size_t level;
+};
+
+struct Resting {
+    uint64_t cloid;
+    uint64_t account;
+};
+
+struct Market {
+    uint64_t id;
+    int64_t mid;                            // Ticks
+    std::vector<std::vector<Quote>> quotes; // Per maker, every level of both sides
+    std::vector<Resting> resting;           // Trader orders believed open
+};
+
+constexpr size_t MAX_TRACKED_RESTING = 4096;
+
+class Generator {
+public:
+    Generator(const WorkloadConfig& config, Journal& journal)
+        : config_(config)
+        , journal_(journal)
+        , rng_(config.seed)
+        , arrivals_(config)
+        , tick_(Order::to_price(config.tick))
+        , lot_(Order::to_quantity(config.lot)) {}
+
+    bool run(WorkloadStats& stats) {
+        const int64_t start_mid = std::max<int64_t>(
+            static_cast<int64_t>(std::llround(config_.price / config_.tick)), min_mid());
+        for (size_t m = 0; m < config_.markets; ++m) {
+            Market market{m + 1, start_mid, {}, {}};
+            JournalRecord record{};
+            record.type = JournalRecordType::AddSymbol;
+            record.symbol_id = market.id;
+            ok_ &= journal_.append(record) != 0;
+            mark(market);
+
+            market.quotes.resize(config_.makers);
+            for (size_t maker = 0; maker < config_.makers; ++maker) {
+                for (size_t level = 0; level < config_.quote_levels; ++level) {
+                    for (bool is_buy : {true, false}) {
+                        Quote quote{0, is_buy, level};
+                        requote(market, maker, quote);
+                        market.quotes[maker].push_back(quote);
+                    }
+                }
+            }
+            markets_.push_back(std::move(market));
+        }
+
+        const double total = config_.churn_weight + config_.passive_weight +
+                             config_.cancel_weight + config_.sweep_weight;
+        for (size_t event = 1; event <= config_.events && ok_; ++event) {
+            now_ns_ = static_cast<int64_t>(arrivals_.next(rng_) * 1e9);
+            Market& market = markets_[rng_.below(markets_.size())];
+            if (rng_.uniform() < config_.move_probability) {
+                market.mid = std::max(market.mid + (rng_.coin() ? 1 : -1), min_mid());
+            }
+
+            double pick = rng_.uniform() * total;
+            if ((pick -= config_.churn_weight) < 0 && config_.makers > 0) {
+                churn(market);
+            } else if ((pick -= config_.passive_weight) < 0) {
+                passive(market);
+            } else if ((pick -= config_.cancel_weight) < 0) {
+                if (market.resting.empty()) {
+                    passive(market);    // Nothing to cancel yet
+                } else {
+                    cancel(market);
+                }
+            } else {
+                sweep(market);
+            }
+
+            if (config_.shock_interval && event % config_.shock_interval == 0) {
+                Market& shocked = markets_[rng_.below(markets_.size())];
+                const double move = 1.0 + (rng_.coin() ? config_.shock_size : -config_.shock_size);
+                shocked.mid = std::max(static_cast<int64_t>(static_cast<double>(shocked.mid) * move),
+                                       min_mid());
+                mark(shocked);
+                ++stats_.shocks;
+            }
+            if (config_.mark_interval && event % config_.mark_interval == 0) {
+                for (Market& each : markets_) {
+                    mark(each);
+                }
+            }
+        }
+
+        journal_.commit();
+        stats = stats_;
+        stats.records = journal_.last_sequence();
+        stats.duration_s = static_cast<double>(now_ns_) / 1e9;
+        return ok_;
+    }
+
+private:
+    int64_t min_mid() const { return static_cast<int64_t>(4 * config_.quote_levels + 4); }
+
+    Quantity size() {
+        const double lots = std::floor(std::pow(1.0 - rng_.uniform(), -1.0 / config_.size_alpha));
+        return lot_ * static_cast<Quantity>(std::clamp(lots, 1.0, static_cast<double>(config_.max_lots)));
+    }
+
+    uint64_t trader() { return 1 + rng_.below(std::max<size_t>(config_.accounts, 1)); }
+
+    void place(const Market& market, uint64_t cloid, uint64_t account, bool is_buy,
+               int64_t ticks, Quantity quantity, TimeInForce tif) {
+        JournalRecord record{};
+        record.type = JournalRecordType::Place;
+        record.symbol_id = market.id;
+        record.order.id = cloid;
+        record.order.symbol_id = market.id;
+        record.order.account_id = account;
+        record.order.price = ticks * tick_;
+        record.order.quantity = quantity;
+        record.order.side = is_buy ? Side::Buy : Side::Sell;
+        record.order.type = OrderType::Limit;
+        record.order.tif = tif;
+        record.order.status = OrderStatus::New;
+        record.order.timestamp = Timestamp(now_ns_);
+        ok_ &= journal_.append(record) != 0;
+        ++stats_.places;
+    }
+
+    void cancel_record(const Market& market, uint64_t cloid, uint64_t account) {
+        JournalRecord record{};
+        record.type = JournalRecordType::Cancel;
+        record.symbol_id = market.id;
+        record.order_id = cloid;
+        record.order.symbol_id = market.id;
+        record.order.account_id = account;
+        record.order.timestamp = Timestamp(now_ns_);
+        ok_ &= journal_.append(record) != 0;
+        ++stats_.cancels;
+    }
+
+    void mark(const Market& market) {
+        JournalRecord record{};
+        record.type = JournalRecordType::Mark;
+        record.symbol_id = market.id;
+        record.new_price = market.mid * tick_;
+        record.order.timestamp = Timestamp(now_ns_);
+        ok_ &= journal_.append(record) != 0;
+        ++stats_.marks;
+    }
+
+    // Quote `quote`'s level again at the current mid under a new client id
+    void requote(const Market& market, size_t maker, Quote& quote) {
+        quote.cloid = next_cloid_++;
+        const int64_t offset = static_cast<int64_t>(quote.level) + 1;
+        place(market, quote.cloid, MAKER_ACCOUNT | maker, quote.is_buy,
+              quote.is_buy ? market.mid - offset : market.mid + offset, size(), TimeInForce::GTC);
+    }
+
+    // The quote may have been filled since; replay then sees a failed cancel
+    void churn(Market& market) {
+        const size_t maker = rng_.below(config_.makers);
+        Quote& quote = market.quotes[maker][rng_.below(market.quotes[maker].size())];
+        cancel_record(market, quote.cloid, MAKER_ACCOUNT | maker);
+        requote(market, maker, quote);
+    }
+
+    void passive(Market& market) {
+        const bool is_buy = rng_.coin();
+        const int64_t offset = 1 + static_cast<int64_t>(rng_.geometric(0.3, 2 * config_.quote_levels));
+        const uint64_t cloid = next_cloid_++;
+        const uint64_t account = trader();
+        place(market, cloid, account, is_buy, is_buy ? market.mid - offset : market.mid + offset,
+              size(), TimeInForce::GTC);
+        // Orders past the cap stay on the book, just never cancelled
+        if (market.resting.size() < MAX_TRACKED_RESTING) {
+            market.resting.push_back({cloid, account});
+        } else {
+            market.resting[rng_.below(market.resting.size())] = {cloid, account};
+        }
+    }
+
+    void cancel(Market& market) {
+        const size_t i = rng_.below(market.resting.size());
+        cancel_record(market, market.resting[i].cloid, market.resting[i].account);
+        market.resting[i] = market.resting.back();
+        market.resting.pop_back();
+    }
+
+    // IOC through `depth` levels, sized to take about that many quotes.
+    // Traders lean one way (odd ids long, even short), so their positions
+    // build up instead of netting out.
+    void sweep(Market& market) {
+        const uint64_t account = trader();
+        const bool is_buy = (rng_.uniform() < config_.trader_bias) == ((account & 1) != 0);
+        const size_t depth = 1 + rng_.geometric(0.4, config_.quote_levels - 1);
+        const int64_t offset = static_cast<int64_t>(depth);
+        place(market, next_cloid_++, account, is_buy,
+              is_buy ? market.mid + offset : market.mid - offset,
+              size() * static_cast<Quantity>(depth), TimeInForce::IOC);
+        ++stats_.sweeps;
+    }
+
+    const WorkloadConfig& config_;
+    Journal& journal_;
+    Rng rng_;
+    Arrivals arrivals_;
+    const Price tick_;
+    const Quantity lot_;
+
+    std::vector<Market> markets_;
+    uint64_t next_cloid_ = 1;
+    int64_t now_ns_ = 0;
+    WorkloadStats stats_{};
+    bool ok_ = true;
+};
+
+} // namespace
+
+bool generate_workload(const WorkloadConfig& config, const std::string& path,
+                       WorkloadStats* stats) {
+    if (config.markets == 0 || config.quote_levels == 0 || config.rate <= 0) {
+        return false;
+    }
+    std::remove(path.c_str());
+    JournalConfig journal_config;
+    journal_config.growth_records = 1 << 18;
+    auto journal = Journal::open(path, journal_config);
+    if (!journal) {
+        return false;
+    }
+    WorkloadStats result{};
+    const bool ok = Generator(config, *journal).run(result);
+    if (stats) {
+        *stats = result;
+    }
+    return ok;
+}
+
+const char* arrival_name(ArrivalProcess arrival) {
+    switch (arrival) {
+        case ArrivalProcess::Poisson: return "poisson";
+        case ArrivalProcess::Bursty:  return "bursty";
+        case ArrivalProcess::Hawkes:  return "hawkes";
+    }
+    return "unknown";
+}
+
+bool parse_arrival(const std::string& name, ArrivalProcess& arrival) {
+    for (ArrivalProcess each : {ArrivalProcess::Poisson, ArrivalProcess::Bursty, ArrivalProcess::Hawkes}) {
+        if (name == arrival_name(each)) {
+            arrival = each;
+            return true;
+        }
+    }
+    return false;
+}
+
+} // namespace lux::bench
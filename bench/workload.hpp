@@ -0,0 +1,96 @@
+// =============================================================================
+// workload.hpp - synthetic order flow for the luxdex replay benchmark
+// =============================================================================
+//
+// Generates a deterministic stream of exchange inputs and records it in the
+// engine's journal format, so a flow can be generated once and replayed
+// through the full stack as often as needed. The stream has the shape of
+// real perp flow rather than uniform noise: event arrivals follow a Poisson,
+// bursty (Markov-modulated Poisson) or self-exciting (Hawkes) process, each
+// market's mid follows a random walk with occasional shocks, and order sizes
+// have a heavy tail. Market makers dominate the volume with quote churn
+// (cancel by client id, requote at the current mid); traders rest passive
+// orders, cancel them, and sweep the book with IOC orders, building the
+// leveraged positions that shocks then push into liquidation.
+//
+// Journal layout of a workload (everything else as for the engine):
+//   AddSymbol  symbol_id is the market id
+//   Place      order.id is the client order id, order.account_id the
+//              account (MAKER_ACCOUNT set for market makers), TimeInForce::IOC
+//              marks a sweep; order.timestamp is nanoseconds into the flow
+//   Cancel     order_id is the client order id, order.account_id its owner
+//   Mark       new_price is the market's new index price
+
+#ifndef LUXDEX_BENCH_WORKLOAD_HPP
+#define LUXDEX_BENCH_WORKLOAD_HPP
+
+#include <cstddef>
+#include <cstdint>
+#include <string>
+
+namespace lux::bench {
+
+// Set in order.account_id for market-maker accounts
+constexpr uint64_t MAKER_ACCOUNT = uint64_t{1} << 32;
+
+enum class ArrivalProcess : uint8_t {
+    Poisson,        // Independent arrivals at `rate`
+    Bursty,         // Alternates calm and burst regimes, same mean rate
+    Hawkes          // Each arrival raises the intensity, which decays back
+};
+
+struct WorkloadConfig {
+    uint64_t seed = 1;
+    size_t events = 200000;         // Order-flow events; one churn is one event
+    size_t markets = 4;
+    size_t accounts = 10000;        // Traders
+    size_t makers = 8;              // Market makers, quoting every market
+
+    ArrivalProcess arrival = ArrivalProcess::Poisson;
+    double rate = 100000.0;         // Mean events per second
+    double burst_factor = 10.0;     // Bursty: burst rate over calm rate
+    double burst_fraction = 0.1;    // Bursty: share of time spent bursting
+    double burst_ms = 5.0;          // Bursty: mean burst length
+    double branching = 0.7;         // Hawkes: arrivals each arrival triggers, < 1
+    double decay_ms = 1.0;          // Hawkes: excitation decay time constant
+
+    double price = 100.0;           // Starting mid of every market
+    double tick = 0.01;
+    double move_probability = 0.2;  // Chance an event moves its market's mid a tick
+    size_t quote_levels = 10;       // Levels each maker quotes per side
+    double lot = 0.01;
+    double size_alpha = 1.5;        // Pareto tail of order sizes, in lots
+    size_t max_lots = 1000;
+
+    // Event mix, relative weights
+    double churn_weight = 0.6;      // Maker cancels a quote and requotes it
+    double passive_weight = 0.15;   // Trader rests a limit order
+    double cancel_weight = 0.15;    // Trader cancels a resting order
+    double sweep_weight = 0.1;      // Trader sends an IOC through the book
+    double trader_bias = 0.75;      // Share of a trader's sweeps on its own side
+
+    size_t mark_interval = 1000;    // Events between index updates of every market
+    size_t shock_interval = 50000;  // Events between price shocks (0 = none)
+    double shock_size = 0.08;       // Relative mid move of a shock
+};
+
+struct WorkloadStats {
+    uint64_t records;
+    uint64_t places;
+    uint64_t sweeps;
+    uint64_t cancels;
+    uint64_t marks;
+    uint64_t shocks;
+    double duration_s;              // Simulated length of the flow
+};
+
+// Writes the flow to a fresh journal at `path`. False if it cannot be written.
+bool generate_workload(const WorkloadConfig& config, const std::string& path,
+                       WorkloadStats* stats = nullptr);
+
+const char* arrival_name(ArrivalProcess arrival);
+bool parse_arrival(const std::string& name, ArrivalProcess& arrival);
+
+} // namespace lux::bench
+
+#endif // LUXDEX_BENCH_WORKLOAD_HPP
@@ -1,7 +1,17 @@
 #include "luxdex_c.h"
 #include "lux/engine.hpp"
+#include <algorithm>
+#include <cstddef>
 #include <cstring>
 #include <new>
+#include <vector>
+
+// LuxEvent is read straight out of the engine's event ring
+static_assert(sizeof(LuxEvent) == sizeof(lux::EventRecord), "LuxEvent layout");
+static_assert(offsetof(LuxEvent, data) == offsetof(lux::EventRecord, trade), "LuxEvent layout");
+static_assert(sizeof(LuxTradeEvent) == sizeof(lux::TradeEvent), "LuxTradeEvent layout");
+static_assert(sizeof(LuxOrderEvent) == sizeof(lux::OrderEvent), "LuxOrderEvent layout");
+static_assert(sizeof(LuxDeltaEvent) == sizeof(lux::DeltaEvent), "LuxDeltaEvent layout");
 
 // Convert C order to C++ order
 static lux::Order to_cpp_order(const LuxOrder* order) {
@@ -53,6 +63,82 @@ static void to_c_trade(const lux::Trade& trade, LuxTrade* out) {
     out->timestamp_ns = trade.timestamp.count();
 }
 
+// Per-thread scratch for batch calls, reused so a batch call does not
+// allocate its input vector each time
+struct BatchScratch {
+    std::vector<lux::BatchOrder> batch;
+    std::vector<size_t> positions;  // Item index of each batch entry
+};
+
+static BatchScratch& batch_scratch() {
+    thread_local BatchScratch scratch;
+    scratch.batch.clear();
+    scratch.positions.clear();
+    return scratch;
+}
+
+static LuxBatchError batch_error(const std::string& error, lux::BatchOrder::Action action) {
+    if (error == "Unknown symbol") return LUX_BATCH_UNKNOWN_SYMBOL;
+    return action == lux::BatchOrder::Action::Place ? LUX_BATCH_REJECTED : LUX_BATCH_NOT_FOUND;
+}
+
+// Run one process_batch and write each entry's result to
+// results[positions[k]]; returns the number of trades produced
+static size_t run_batch(lux::Engine* engine, const BatchScratch& scratch,
+                        LuxBatchResult* results, LuxTrade* trades, size_t trade_capacity) {
+    const auto& batch = scratch.batch;
+    auto cpp_result = engine->process_batch(batch);
+
+    // process_batch answers in batch order: cancels in cancel_results,
+    // everything else in order_results. A sharded engine refuses the whole
+    // batch with one order result per entry.
+    const size_t cancels = static_cast<size_t>(std::count_if(batch.begin(), batch.end(),
+        [](const lux::BatchOrder& b) { return b.action == lux::BatchOrder::Action::Cancel; }));
+    const bool executed = cpp_result.cancel_results.size() == cancels &&
+                          cpp_result.order_results.size() == batch.size() - cancels;
+
+    size_t next_order = 0;
+    size_t next_cancel = 0;
+    size_t produced = 0;
+    for (size_t k = 0; k < batch.size(); ++k) {
+        const lux::BatchOrder& item = batch[k];
+        const bool is_cancel = item.action == lux::BatchOrder::Action::Cancel;
+
+        LuxBatchResult& result = results[scratch.positions[k]];
+        result = LuxBatchResult{};
+        result.order_id = item.action == lux::BatchOrder::Action::Place ? item.order.id : item.order_id;
+        result.trade_offset = std::min(produced, trade_capacity);
+
+        if (!executed) {
+            result.error = LUX_BATCH_REJECTED;
+            continue;
+        }
+
+        if (is_cancel) {
+            const auto& cancel = cpp_result.cancel_results[next_cancel++];
+            result.success = cancel.success;
+            result.error = cancel.success ? LUX_BATCH_OK : batch_error(cancel.error, item.action);
+            continue;
+        }
+
+        const auto& order = cpp_result.order_results[next_order++];
+        result.success = order.success;
+        result.error = order.success ? LUX_BATCH_OK : batch_error(order.error, item.action);
+        for (const auto& trade : order.trades) {
+            result.filled += trade.quantity;
+            if (produced < trade_capacity) {
+                to_c_trade(trade, &trades[produced]);
+                ++result.trade_count;
+            } else {
+                result.trades_truncated = true;
+            }
+            ++produced;
+        }
+    }
+
+    return produced;
+}
+
 extern "C" {
 
 // =============================================================================
@@ -76,6 +162,12 @@ LuxEngine lux_engine_create_with_config(const LuxEngineConfig* config) {
         cfg.max_batch_size = config->max_batch_size;
         cfg.enable_self_trade_prevention = config->enable_stp;
         cfg.async_mode = config->async_mode;
+        if (config->event_ring_path) {
+            cfg.event_ring_path = config->event_ring_path;
+            if (config->event_ring_capacity != 0) {
+                cfg.event_ring_capacity = config->event_ring_capacity;
+            }
+        }
         return new lux::Engine(cfg);
     } catch (...) {
         return nullptr;
@@ -281,6 +373,118 @@ LuxEngineStats lux_engine_get_stats(LuxEngine engine) {
     return result;
 }
 
+// =============================================================================
+// Batch API
+// =============================================================================
+
+size_t lux_engine_process_batch(LuxEngine engine, const LuxBatchItem* items, size_t count,
+                                LuxBatchResult* results, LuxTrade* trades, size_t trade_capacity) {
+    if (!engine || !items || !results || count == 0) return 0;
+    if (!trades) trade_capacity = 0;
+
+    BatchScratch& scratch = batch_scratch();
+    for (size_t i = 0; i < count; ++i) {
+        const LuxBatchItem& item = items[i];
+        lux::BatchOrder batch_order{};
+        switch (item.action) {
+            case LUX_BATCH_PLACE:
+                batch_order.action = lux::BatchOrder::Action::Place;
+                batch_order.order = to_cpp_order(&item.order);
+                break;
+            case LUX_BATCH_CANCEL:
+                batch_order.action = lux::BatchOrder::Action::Cancel;
+                batch_order.order.symbol_id = item.order.symbol_id;
+                batch_order.order_id = item.order_id;
+                break;
+            case LUX_BATCH_MODIFY:
+                batch_order.action = lux::BatchOrder::Action::Modify;
+                batch_order.order.symbol_id = item.order.symbol_id;
+                batch_order.order_id = item.order_id;
+                batch_order.new_price = item.new_price;
+                batch_order.new_quantity = item.new_quantity;
+                break;
+            default:
+                results[i] = LuxBatchResult{};
+                results[i].error = LUX_BATCH_INVALID_ACTION;
+                results[i].order_id = item.order_id;
+                continue;
+        }
+        scratch.batch.push_back(batch_order);
+        scratch.positions.push_back(i);
+    }
+
+    if (scratch.batch.empty()) return 0;
+    return run_batch(static_cast<lux::Engine*>(engine), scratch, results, trades, trade_capacity);
+}
+
+size_t lux_engine_place_orders(LuxEngine engine, const LuxOrder* orders, size_t count,
+                               LuxBatchResult* results, LuxTrade* trades, size_t trade_capacity) {
+    if (!engine || !orders || !results || count == 0) return 0;
+    if (!trades) trade_capacity = 0;
+
+    BatchScratch& scratch = batch_scratch();
+    for (size_t i = 0; i < count; ++i) {
+        lux::BatchOrder batch_order{};
+        batch_order.action = lux::BatchOrder::Action::Place;
+        batch_order.order = to_cpp_order(&orders[i]);
+        scratch.batch.push_back(batch_order);
+        scratch.positions.push_back(i);
+    }
+    return run_batch(static_cast<lux::Engine*>(engine), scratch, results, trades, trade_capacity);
+}
+
+void lux_engine_cancel_orders(LuxEngine engine, const uint64_t* symbol_ids,
+                              const uint64_t* order_ids, size_t count,
+                              LuxBatchResult* results) {
+    if (!engine || !symbol_ids || !order_ids || !results || count == 0) return;
+
+    BatchScratch& scratch = batch_scratch();
+    for (size_t i = 0; i < count; ++i) {
+        lux::BatchOrder batch_order{};
+        batch_order.action = lux::BatchOrder::Action::Cancel;
+        batch_order.order.symbol_id = symbol_ids[i];
+        batch_order.order_id = order_ids[i];
+        scratch.batch.push_back(batch_order);
+        scratch.positions.push_back(i);
+    }
+    run_batch(static_cast<lux::Engine*>(engine), scratch, results, nullptr, 0);
+}
+
+// =============================================================================
+// Event Ring API
+// =============================================================================
+
+uint64_t lux_engine_event_head(LuxEngine engine) {
+    if (!engine) return 0;
+    const lux::EventRing* ring = static_cast<lux::Engine*>(engine)->event_ring();
+    return ring ? ring->head() : 0;
+}
+
+LuxEventReader lux_event_reader_open(const char* path) {
+    if (!path) return nullptr;
+    try {
+        return lux::EventRingReader::open(path).release();
+    } catch (...) {
+        return nullptr;
+    }
+}
+
+void lux_event_reader_close(LuxEventReader reader) {
+    delete static_cast<lux::EventRingReader*>(reader);
+}
+
+uint64_t lux_event_reader_head(LuxEventReader reader) {
+    if (!reader) return 0;
+    return static_cast<lux::EventRingReader*>(reader)->head();
+}
+
+size_t lux_event_reader_poll(LuxEventReader reader, uint64_t* cursor,
+                             LuxEvent* events, size_t max, uint64_t* missed) {
+    if (!reader || !cursor || !events) return 0;
+    return static_cast<lux::EventRingReader*>(reader)->poll(
+        *cursor, reinterpret_cast<lux::EventRecord*>(events), max, missed);
+}
+
 // =============================================================================
 // OrderBook API
 // =============================================================================
@@ -301,26 +505,28 @@ LuxOrderResult lux_orderbook_place_order(LuxOrderBook book, const LuxOrder* orde
 
     lux::Order cpp_order = to_cpp_order(order);
 
-    try {
-        auto trades = static_cast<lux::OrderBook*>(book)->place_order(cpp_order);
-
-        result.success = true;
-        result.order_id = cpp_order.id;
-        result.trade_count = trades.size();
-
-        if (result.trade_count > 0) {
-            result.trades = new(std::nothrow) LuxTrade[result.trade_count];
-            if (result.trades) {
-                for (size_t i = 0; i < result.trade_count; ++i) {
-                    to_c_trade(trades[i], &result.trades[i]);
-                }
-            } else {
-                result.trade_count = 0;
+    std::vector<lux::Trade> trades;
+    const lux::PlaceOutcome placed =
+        static_cast<lux::OrderBook*>(book)->place_order(cpp_order, trades);
+    if (!placed) {
+        result.success = false;
+        std::strncpy(result.error, lux::place_error_message(placed.error), sizeof(result.error) - 1);
+        return result;
+    }
+
+    result.success = true;
+    result.order_id = cpp_order.id;
+    result.trade_count = trades.size();
+
+    if (result.trade_count > 0) {
+        result.trades = new(std::nothrow) LuxTrade[result.trade_count];
+        if (result.trades) {
+            for (size_t i = 0; i < result.trade_count; ++i) {
+                to_c_trade(trades[i], &result.trades[i]);
             }
+        } else {
+            result.trade_count = 0;
         }
-    } catch (const std::exception& e) {
-        result.success = false;
-        std::strncpy(result.error, e.what(), sizeof(result.error) - 1);
     }
 
     return result;
@@ -119,6 +119,44 @@ typedef struct {
     char error[256];
 } LuxCancelResult;
 
+// Batch action
+typedef enum {
+    LUX_BATCH_PLACE = 0,
+    LUX_BATCH_CANCEL = 1,
+    LUX_BATCH_MODIFY = 2
+} LuxBatchAction;
+
+// Batch item outcome
+typedef enum {
+    LUX_BATCH_OK = 0,
+    LUX_BATCH_UNKNOWN_SYMBOL = 1,
+    LUX_BATCH_NOT_FOUND = 2,       // Cancel/modify: no such resting order
+    LUX_BATCH_REJECTED = 3,        // Place refused by the book or engine
+    LUX_BATCH_INVALID_ACTION = 4
+} LuxBatchError;
+
+// One action in a batch
+typedef struct {
+    LuxBatchAction action;
+    LuxOrder order;             // Place: the order. Cancel/modify: symbol_id
+    uint64_t order_id;          // Cancel/modify
+    LuxPrice new_price;         // Modify
+    LuxQuantity new_quantity;   // Modify
+} LuxBatchItem;
+
+// Result of one batch action. Its trades are
+// trades[trade_offset .. trade_offset + trade_count) in the caller's
+// buffer; trades_truncated is set if the buffer ran out first.
+typedef struct {
+    bool success;
+    LuxBatchError error;
+    uint64_t order_id;
+    LuxQuantity filled;         // Sum of this action's fills
+    size_t trade_offset;
+    size_t trade_count;
+    bool trades_truncated;
+} LuxBatchResult;
+
 // Engine statistics
 typedef struct {
     uint64_t total_orders_placed;
@@ -133,8 +171,67 @@ typedef struct {
     size_t max_batch_size;
     bool enable_stp;
     bool async_mode;
+    const char* event_ring_path;    // Shared-memory event ring file (NULL = none)
+    size_t event_ring_capacity;     // Events held (0 = default, 65536)
 } LuxEngineConfig;
 
+// Event ring event type
+typedef enum {
+    LUX_EVENT_TRADE = 1,
+    LUX_EVENT_ORDER_FILLED = 2,
+    LUX_EVENT_ORDER_PARTIAL = 3,
+    LUX_EVENT_ORDER_CANCELLED = 4,
+    LUX_EVENT_BOOK_DELTA = 5
+} LuxEventType;
+
+// Event ring payloads
+typedef struct {
+    uint64_t trade_id;
+    uint64_t buy_order_id;
+    uint64_t sell_order_id;
+    uint64_t buyer_account_id;
+    uint64_t seller_account_id;
+    LuxPrice price;
+    LuxQuantity quantity;
+    int64_t timestamp_ns;
+} LuxTradeEvent;
+
+typedef struct {
+    uint64_t order_id;
+    uint64_t account_id;
+    LuxPrice price;
+    LuxQuantity quantity;
+    LuxQuantity filled;
+    LuxQuantity fill_quantity;      // LUX_EVENT_ORDER_PARTIAL: this fill
+    int64_t timestamp_ns;
+} LuxOrderEvent;
+
+typedef struct {
+    uint64_t book_sequence;         // Per-symbol delta sequence
+    LuxPrice price;
+    LuxQuantity quantity;           // 0 with order_count 0: level removed
+    uint32_t order_count;
+    uint32_t reserved;
+} LuxDeltaEvent;
+
+// One event ring entry (88 bytes, layout shared with the engine). `side`
+// is a LuxSide: the aggressor for trades, the order's side for order
+// events and the level's side for book deltas.
+typedef struct {
+    uint64_t sequence;
+    uint64_t symbol_id;
+    uint8_t type;                   // LuxEventType
+    uint8_t side;
+    uint8_t reserved[6];
+    union {
+        LuxTradeEvent trade;
+        LuxOrderEvent order;
+        LuxDeltaEvent delta;
+    } data;
+} LuxEvent;
+
+typedef void* LuxEventReader;
+
 // =============================================================================
 // Engine API
 // =============================================================================
@@ -190,6 +287,60 @@ bool lux_engine_best_ask(LuxEngine engine, uint64_t symbol_id, LuxPrice* price);
 // Get statistics
 LuxEngineStats lux_engine_get_stats(LuxEngine engine);
 
+// =============================================================================
+// Batch API
+//
+// Caller-owned arrays in and out; nothing is allocated for the caller and
+// nothing needs freeing. `results` must hold `count` entries. Trades are
+// written to `trades` (up to `trade_capacity`, which may be 0 with a NULL
+// buffer). Each call maps onto one Engine::process_batch: actions for one
+// symbol run in item order. Returns the total number of trades produced,
+// which exceeds `trade_capacity` if some were not written.
+// =============================================================================
+
+// Place, cancel or modify a mix of orders
+size_t lux_engine_process_batch(LuxEngine engine, const LuxBatchItem* items, size_t count,
+                                LuxBatchResult* results, LuxTrade* trades, size_t trade_capacity);
+
+// Place `count` orders
+size_t lux_engine_place_orders(LuxEngine engine, const LuxOrder* orders, size_t count,
+                               LuxBatchResult* results, LuxTrade* trades, size_t trade_capacity);
+
+// Cancel `count` orders; symbol_ids[i] and order_ids[i] name one order
+void lux_engine_cancel_orders(LuxEngine engine, const uint64_t* symbol_ids,
+                              const uint64_t* order_ids, size_t count,
+                              LuxBatchResult* results);
+
+// =============================================================================
+// Event Ring API
+//
+// An engine created with event_ring_path publishes every trade, order
+// fill/cancel and L2 delta to a shared-memory ring at that path (use a
+// file under /dev/shm to keep it off disk). Readers in any process open
+// the path and poll with their own cursor; polling takes no locks and no
+// syscalls. The ring holds the newest event_ring_capacity events, so a
+// reader that falls further behind loses the oldest and is told how many.
+// =============================================================================
+
+// Sequence of the newest event the engine published (0 if none or no ring)
+uint64_t lux_engine_event_head(LuxEngine engine);
+
+// Attach to a ring; NULL if `path` is not an event ring
+LuxEventReader lux_event_reader_open(const char* path);
+
+// Detach
+void lux_event_reader_close(LuxEventReader reader);
+
+// Sequence of the newest published event
+uint64_t lux_event_reader_head(LuxEventReader reader);
+
+// Copy up to `max` events after `*cursor` into `events`, oldest first, and
+// advance `*cursor`. Start with *cursor = 0 for everything still held, or
+// the head for new events only. Events overwritten before they were read
+// are added to `*missed` (may be NULL). Returns the number copied.
+size_t lux_event_reader_poll(LuxEventReader reader, uint64_t* cursor,
+                             LuxEvent* events, size_t max, uint64_t* missed);
+
 // =============================================================================
 // OrderBook API (direct access, use with caution)
 // =============================================================================
@@ -231,10 +382,11 @@ void lux_symbols_free(uint64_t* symbols);
 // Utility
 // =============================================================================
 
-// Generate unique order ID
+// Generate unique order ID. IDs increase per calling thread; threads draw
+// from separate blocks, so they are not ordered across threads.
 uint64_t lux_generate_order_id(void);
 
-// Reset order ID generator
+// Reset order ID generator (every thread restarts from start)
 void lux_reset_order_id_generator(uint64_t start);
 
 #ifdef __cplusplus
@@ -270,6 +270,39 @@ typedef struct {
     lx_i128_t last_trade_px_x18;
 } lx_l1_t;
 
+/* =============================================================================
+ * LXBook Depth Level
+ * ============================================================================= */
+
+typedef struct {
+    lx_i128_t px_x18;
+    lx_i128_t sz_x18;
+    uint32_t order_count;
+} lx_depth_level_t;
+
+/* =============================================================================
+ * LXBook Order State
+ * ============================================================================= */
+
+typedef struct {
+    uint64_t oid;
+    uint8_t cloid[16];
+    uint32_t market_id;
+    bool is_buy;
+    lx_order_kind_t kind;
+    lx_tif_t tif;
+    lx_i128_t original_size_x18;
+    lx_i128_t remaining_size_x18;
+    lx_i128_t filled_size_x18;
+    lx_i128_t limit_px_x18;
+    lx_i128_t trigger_px_x18;
+    lx_i128_t avg_fill_px_x18;
+    uint8_t status;            /* lx_order_status_t */
+    uint64_t created_at;
+    uint64_t updated_at;
+    uint8_t flags;
+} lx_order_state_t;
+
 /* =============================================================================
  * LXVault Market Configuration (LP-9030)
  * ============================================================================= */
@@ -576,6 +609,45 @@ lx_l1_t lxbook_get_l1(const lx_t* dex, uint32_t market_id);
 size_t lxbook_order_count(const lx_t* dex, const lx_account_t* account,
                           uint32_t market_id);
 
+/*
+ * Buffer queries: results are written to caller-owned arrays, so nothing
+ * is allocated for the caller and nothing needs freeing. List queries
+ * return the full count; if it exceeds `capacity` only the first
+ * `capacity` entries were written (pass NULL and 0 to size a buffer).
+ */
+
+/**
+ * Get up to `levels` depth levels per side, best first.
+ * @param bids,asks Buffers of `levels` entries each
+ * @param bid_count,ask_count Levels written per side
+ * @return LX_OK, or LX_ERR_MARKET_NOT_FOUND
+ */
+int32_t lxbook_get_depth(const lx_t* dex, uint32_t market_id, size_t levels,
+                         lx_depth_level_t* bids, size_t* bid_count,
+                         lx_depth_level_t* asks, size_t* ask_count);
+
+/**
+ * Get orders for account in market.
+ * @return Number of orders the account has in the market
+ */
+size_t lxbook_get_orders(const lx_t* dex, const lx_account_t* account,
+                         uint32_t market_id, lx_order_state_t* out, size_t capacity);
+
+/**
+ * Get orders for account across all markets.
+ * @return Number of orders the account has
+ */
+size_t lxbook_get_all_orders(const lx_t* dex, const lx_account_t* account,
+                             lx_order_state_t* out, size_t capacity);
+
+/**
+ * Get L1 for many markets in one call; out[i] is for market_ids[i]
+ * (zeroed if the market does not exist).
+ * @return Number of markets found
+ */
+size_t lxbook_get_l1_batch(const lx_t* dex, const uint32_t* market_ids, size_t count,
+                           lx_l1_t* out);
+
 /* =============================================================================
  * LXVault API (LP-9030) - Clearinghouse
  * ============================================================================= */
@@ -635,6 +707,20 @@ lx_margin_info_t lxvault_get_margin(const lx_t* dex, const lx_account_t* account
 bool lxvault_get_position(const lx_t* dex, const lx_account_t* account,
                           uint32_t market_id, lx_position_t* out);
 
+/**
+ * Get all positions for account into a caller buffer.
+ * @return Number of positions; only `capacity` are written if larger
+ */
+size_t lxvault_get_positions(const lx_t* dex, const lx_account_t* account,
+                             lx_position_t* out, size_t capacity);
+
+/**
+ * Get margin info for many accounts in one call; out[i] is for
+ * accounts[i] (zeroed for unknown accounts).
+ */
+void lxvault_get_margin_batch(const lx_t* dex, const lx_account_t* accounts, size_t count,
+                              lx_margin_info_t* out);
+
 /**
  * Set margin mode for market.
  */
@@ -4,9 +4,11 @@
 
 #include "lx_c.h"
 #include "lux/lx.hpp"
+#include <algorithm>
 #include <cstring>
 #include <chrono>
 #include <new>
+#include <vector>
 
 /* =============================================================================
  * 128-bit Integer Conversion Helpers
@@ -245,6 +247,66 @@ static inline lx_l1_t to_c_l1(const lux::LXL1& l1) {
     return r;
 }
 
+/* =============================================================================
+ * Depth and Order State Conversion
+ * ============================================================================= */
+
+static inline lx_depth_level_t to_c_depth_level(const lux::BookLevel& level) {
+    lx_depth_level_t d;
+    d.px_x18 = to_c_i128(static_cast<lux::I128>(level.price) * lux::X18_ONE / lux::PRICE_MULTIPLIER);
+    d.sz_x18 = to_c_i128(static_cast<lux::I128>(level.quantity) * lux::X18_ONE / lux::PRICE_MULTIPLIER);
+    d.order_count = level.order_count;
+    return d;
+}
+
+static inline lx_order_state_t to_c_order_state(const lux::BookOrderState& state) {
+    lx_order_state_t o;
+    o.oid = state.oid;
+    std::memcpy(o.cloid, state.cloid.data(), 16);
+    o.market_id = state.market_id;
+    o.is_buy = state.is_buy;
+    o.kind = static_cast<lx_order_kind_t>(state.kind);
+    o.tif = static_cast<lx_tif_t>(state.tif);
+    o.original_size_x18 = to_c_i128(state.original_size_x18);
+    o.remaining_size_x18 = to_c_i128(state.remaining_size_x18);
+    o.filled_size_x18 = to_c_i128(state.filled_size_x18);
+    o.limit_px_x18 = to_c_i128(state.limit_price_x18);
+    o.trigger_px_x18 = to_c_i128(state.trigger_price_x18);
+    o.avg_fill_px_x18 = to_c_i128(state.avg_fill_price_x18);
+    o.status = static_cast<uint8_t>(state.status);
+    o.created_at = state.created_at;
+    o.updated_at = state.updated_at;
+    o.flags = state.flags;
+    return o;
+}
+
+/* =============================================================================
+ * Query Scratch
+ * ============================================================================= */
+
+/* Per-thread buffers for the buffer queries, reused across calls so the
+ * C++ side does not allocate once they have grown to the working size */
+struct QueryScratch {
+    lux::L2Snapshot depth;
+    std::vector<lux::BookOrderState> orders;
+    std::vector<lux::LXPosition> positions;
+};
+
+static QueryScratch& query_scratch() {
+    thread_local QueryScratch scratch;
+    return scratch;
+}
+
+/* Convert `items` into out[0 .. capacity); returns items.size() */
+template<typename T, typename C, typename Convert>
+static size_t copy_out(const std::vector<T>& items, C* out, size_t capacity, Convert convert) {
+    const size_t n = out ? std::min(items.size(), capacity) : 0;
+    for (size_t i = 0; i < n; ++i) {
+        out[i] = convert(items[i]);
+    }
+    return items.size();
+}
+
 /* =============================================================================
  * Position Conversion
  * ============================================================================= */
@@ -639,13 +701,76 @@ size_t lxbook_order_count(const lx_t* dex, const lx_account_t* account,
     if (!dex || !account) return 0;
     try {
         auto acc = to_cpp_account(account);
-        auto orders = reinterpret_cast<const lux::LX*>(dex)->book().get_orders(acc, market_id);
-        return orders.size();
+        return reinterpret_cast<const lux::LX*>(dex)->book().get_orders(
+            acc, market_id, query_scratch().orders);
     } catch (...) {
         return 0;
     }
 }
 
+int32_t lxbook_get_depth(const lx_t* dex, uint32_t market_id, size_t levels,
+                         lx_depth_level_t* bids, size_t* bid_count,
+                         lx_depth_level_t* asks, size_t* ask_count) {
+    if (bid_count) *bid_count = 0;
+    if (ask_count) *ask_count = 0;
+    if (!dex) return LX_ERR_NULL_POINTER;
+    try {
+        lux::L2Snapshot& depth = query_scratch().depth;
+        if (!reinterpret_cast<const lux::LX*>(dex)->book().get_l2_snapshot(market_id, levels, depth)) {
+            return LX_ERR_MARKET_NOT_FOUND;
+        }
+        size_t n = copy_out(depth.bids, bids, levels, to_c_depth_level);
+        if (bid_count && bids) *bid_count = std::min(n, levels);
+        n = copy_out(depth.asks, asks, levels, to_c_depth_level);
+        if (ask_count && asks) *ask_count = std::min(n, levels);
+        return LX_OK;
+    } catch (...) {
+        return LX_ERR_INTERNAL;
+    }
+}
+
+size_t lxbook_get_orders(const lx_t* dex, const lx_account_t* account,
+                         uint32_t market_id, lx_order_state_t* out, size_t capacity) {
+    if (!dex || !account) return 0;
+    try {
+        auto& orders = query_scratch().orders;
+        reinterpret_cast<const lux::LX*>(dex)->book().get_orders(to_cpp_account(account), market_id, orders);
+        return copy_out(orders, out, capacity, to_c_order_state);
+    } catch (...) {
+        return 0;
+    }
+}
+
+size_t lxbook_get_all_orders(const lx_t* dex, const lx_account_t* account,
+                             lx_order_state_t* out, size_t capacity) {
+    if (!dex || !account) return 0;
+    try {
+        auto& orders = query_scratch().orders;
+        reinterpret_cast<const lux::LX*>(dex)->book().get_all_orders(to_cpp_account(account), orders);
+        return copy_out(orders, out, capacity, to_c_order_state);
+    } catch (...) {
+        return 0;
+    }
+}
+
+size_t lxbook_get_l1_batch(const lx_t* dex, const uint32_t* market_ids, size_t count,
+                           lx_l1_t* out) {
+    if (!dex || !market_ids || !out) return 0;
+    const lux::LXBook& book = reinterpret_cast<const lux::LX*>(dex)->book();
+    size_t found = 0;
+    for (size_t i = 0; i < count; ++i) {
+        out[i] = lx_l1_t{};
+        try {
+            if (book.market_exists(market_ids[i])) {
+                out[i] = to_c_l1(book.get_l1(market_ids[i]));
+                ++found;
+            }
+        } catch (...) {
+        }
+    }
+    return found;
+}
+
 /* =============================================================================
  * LXVault API (LP-9030)
  * ============================================================================= */
@@ -754,6 +879,31 @@ bool lxvault_get_position(const lx_t* dex, const lx_account_t* account,
     }
 }
 
+size_t lxvault_get_positions(const lx_t* dex, const lx_account_t* account,
+                             lx_position_t* out, size_t capacity) {
+    if (!dex || !account) return 0;
+    try {
+        auto& positions = query_scratch().positions;
+        reinterpret_cast<const lux::LX*>(dex)->vault().get_all_positions(to_cpp_account(account), positions);
+        return copy_out(positions, out, capacity, to_c_position);
+    } catch (...) {
+        return 0;
+    }
+}
+
+void lxvault_get_margin_batch(const lx_t* dex, const lx_account_t* accounts, size_t count,
+                              lx_margin_info_t* out) {
+    if (!dex || !accounts || !out) return;
+    const lux::LXVault& vault = reinterpret_cast<const lux::LX*>(dex)->vault();
+    for (size_t i = 0; i < count; ++i) {
+        out[i] = lx_margin_info_t{};
+        try {
+            out[i] = to_c_margin_info(vault.get_margin_info(to_cpp_account(&accounts[i])));
+        } catch (...) {
+        }
+    }
+}
+
 int32_t lxvault_set_margin_mode(lx_t* dex, const lx_account_t* account,
                                 uint32_t market_id, lx_margin_mode_t mode) {
     if (!dex || !account) return LX_ERR_NULL_POINTER;
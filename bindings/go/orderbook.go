@@ -235,6 +235,8 @@ type EngineConfig struct {
 	MaxBatchSize        int
 	EnableSelfTradePrev bool
 	AsyncMode           bool
+	EventRingPath       string // Shared-memory event ring file ("" = none; CGO engine only)
+	EventRingCapacity   int    // Events held (0 = default)
 }
 
 // DefaultEngineConfig returns a default engine configuration
@@ -333,6 +335,7 @@ var (
 	ErrOrderNotFound  = errors.New("order not found")
 	ErrInvalidOrder   = errors.New("invalid order")
 	ErrEngineNotReady = errors.New("engine not ready")
+	ErrNoEventRing    = errors.New("not an event ring")
 )
 
 // OrderBuilder helps construct orders
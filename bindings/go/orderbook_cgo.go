@@ -18,6 +18,7 @@ import (
 type CGOEngine struct {
 	handle   C.LuxEngine
 	listener TradeListener
+	tradeBuf []C.LuxTrade // Reused by batch calls
 }
 
 // Ensure CGOEngine implements Engine
@@ -43,6 +44,12 @@ func NewCGOEngineWithConfig(config EngineConfig) (*CGOEngine, error) {
 		enable_stp:     C.bool(config.EnableSelfTradePrev),
 		async_mode:     C.bool(config.AsyncMode),
 	}
+	if config.EventRingPath != "" {
+		cPath := C.CString(config.EventRingPath)
+		defer C.free(unsafe.Pointer(cPath))
+		cConfig.event_ring_path = cPath
+		cConfig.event_ring_capacity = C.size_t(config.EventRingCapacity)
+	}
 
 	handle := C.lux_engine_create_with_config(&cConfig)
 	if handle == nil {
@@ -157,6 +164,67 @@ func (e *CGOEngine) CancelOrder(symbolID, orderID uint64) CancelResult {
 	return result
 }
 
+// PlaceOrders places a batch of orders in one CGO call; results are in
+// input order. Trades go through a buffer reused across calls: if a batch
+// fills more than it holds, the extra trades are missing from that call's
+// results (Error is "trades truncated") and the buffer grows for the next.
+func (e *CGOEngine) PlaceOrders(orders []Order) []OrderResult {
+	if len(orders) == 0 {
+		return nil
+	}
+
+	cOrders := make([]C.LuxOrder, len(orders))
+	for i, o := range orders {
+		cOrders[i] = orderToC(o)
+	}
+	cResults := make([]C.LuxBatchResult, len(orders))
+	if len(e.tradeBuf) < 2*len(orders) {
+		e.tradeBuf = make([]C.LuxTrade, 2*len(orders))
+	}
+
+	produced := int(C.lux_engine_place_orders(e.handle, &cOrders[0], C.size_t(len(orders)),
+		&cResults[0], &e.tradeBuf[0], C.size_t(len(e.tradeBuf))))
+
+	results := make([]OrderResult, len(orders))
+	for i, cr := range cResults {
+		results[i] = batchResultFromC(cr, e.tradeBuf)
+		if e.listener != nil {
+			for _, trade := range results[i].Trades {
+				e.listener.OnTrade(trade)
+			}
+		}
+	}
+
+	if produced > len(e.tradeBuf) {
+		e.tradeBuf = make([]C.LuxTrade, produced)
+	}
+	return results
+}
+
+// CancelOrders cancels a batch of orders in one CGO call; symbolIDs[i]
+// and orderIDs[i] name one order. CancelledOrder is not filled in.
+func (e *CGOEngine) CancelOrders(symbolIDs, orderIDs []uint64) []CancelResult {
+	n := len(orderIDs)
+	if n == 0 || len(symbolIDs) != n {
+		return nil
+	}
+
+	cResults := make([]C.LuxBatchResult, n)
+	C.lux_engine_cancel_orders(e.handle,
+		(*C.uint64_t)(unsafe.Pointer(&symbolIDs[0])),
+		(*C.uint64_t)(unsafe.Pointer(&orderIDs[0])),
+		C.size_t(n), &cResults[0])
+
+	results := make([]CancelResult, n)
+	for i, cr := range cResults {
+		results[i] = CancelResult{
+			Success: bool(cr.success),
+			Error:   batchErrorString(cr.error),
+		}
+	}
+	return results
+}
+
 func (e *CGOEngine) GetOrder(symbolID, orderID uint64) (*Order, bool) {
 	var cOrder C.LuxOrder
 	if !C.lux_engine_get_order(e.handle, C.uint64_t(symbolID), C.uint64_t(orderID), &cOrder) {
@@ -336,6 +404,42 @@ func tradeFromC(c C.LuxTrade) Trade {
 	}
 }
 
+func batchResultFromC(c C.LuxBatchResult, trades []C.LuxTrade) OrderResult {
+	result := OrderResult{
+		Success: bool(c.success),
+		OrderID: uint64(c.order_id),
+		Error:   batchErrorString(c.error),
+	}
+	if c.trades_truncated {
+		result.Error = "trades truncated"
+	}
+
+	if c.trade_count > 0 {
+		offset := int(c.trade_offset)
+		written := trades[offset : offset+int(c.trade_count)]
+		result.Trades = make([]Trade, len(written))
+		for i, ct := range written {
+			result.Trades[i] = tradeFromC(ct)
+		}
+	}
+	return result
+}
+
+func batchErrorString(e C.LuxBatchError) string {
+	switch e {
+	case C.LUX_BATCH_OK:
+		return ""
+	case C.LUX_BATCH_UNKNOWN_SYMBOL:
+		return "Unknown symbol"
+	case C.LUX_BATCH_NOT_FOUND:
+		return "Order not found"
+	case C.LUX_BATCH_REJECTED:
+		return "Order rejected"
+	default:
+		return "Invalid action"
+	}
+}
+
 func depthFromC(c C.LuxMarketDepth) MarketDepth {
 	depth := MarketDepth{
 		Timestamp: time.Unix(0, int64(c.timestamp_ns)),
@@ -368,6 +472,156 @@ func depthFromC(c C.LuxMarketDepth) MarketDepth {
 	return depth
 }
 
+// EventType identifies an event ring entry
+type EventType uint8
+
+const (
+	EventTrade          EventType = C.LUX_EVENT_TRADE
+	EventOrderFilled    EventType = C.LUX_EVENT_ORDER_FILLED
+	EventOrderPartial   EventType = C.LUX_EVENT_ORDER_PARTIAL
+	EventOrderCancelled EventType = C.LUX_EVENT_ORDER_CANCELLED
+	EventBookDelta      EventType = C.LUX_EVENT_BOOK_DELTA
+)
+
+// BookDelta is the new state of one price level; Quantity and OrderCount
+// are zero when the level was removed
+type BookDelta struct {
+	Sequence   uint64 // Per-symbol delta sequence
+	Price      Price
+	Quantity   Quantity
+	OrderCount int
+}
+
+// Event is one entry of an engine's event ring. Trade is set for
+// EventTrade, Order and FillQuantity for the order events, and Delta for
+// EventBookDelta. Side is the aggressor, order or level side.
+type Event struct {
+	Sequence     uint64
+	Type         EventType
+	SymbolID     uint64
+	Side         Side
+	Trade        Trade
+	Order        Order
+	FillQuantity Quantity
+	Delta        BookDelta
+}
+
+// EventReader polls the shared-memory event ring of an engine created
+// with EngineConfig.EventRingPath, from this or any other process. Polling
+// takes no locks and no syscalls; each reader keeps its own cursor.
+type EventReader struct {
+	handle C.LuxEventReader
+	cursor C.uint64_t
+	buf    []C.LuxEvent
+}
+
+// OpenEventReader attaches to the ring at path, positioned at its oldest
+// retained event
+func OpenEventReader(path string) (*EventReader, error) {
+	cPath := C.CString(path)
+	defer C.free(unsafe.Pointer(cPath))
+
+	handle := C.lux_event_reader_open(cPath)
+	if handle == nil {
+		return nil, ErrNoEventRing
+	}
+	r := &EventReader{handle: handle}
+	runtime.SetFinalizer(r, (*EventReader).Close)
+	return r, nil
+}
+
+// Close detaches from the ring
+func (r *EventReader) Close() {
+	if r.handle != nil {
+		C.lux_event_reader_close(r.handle)
+		r.handle = nil
+	}
+	runtime.SetFinalizer(r, nil)
+}
+
+// Head is the sequence of the newest published event
+func (r *EventReader) Head() uint64 {
+	return uint64(C.lux_event_reader_head(r.handle))
+}
+
+// Cursor is the sequence of the last event returned
+func (r *EventReader) Cursor() uint64 {
+	return uint64(r.cursor)
+}
+
+// Seek makes the next Poll start after sequence seq; Seek(r.Head()) skips
+// to new events only
+func (r *EventReader) Seek(seq uint64) {
+	r.cursor = C.uint64_t(seq)
+}
+
+// Poll fills events with the next events, oldest first, and returns how
+// many it filled and how many were overwritten before they could be read
+func (r *EventReader) Poll(events []Event) (n int, missed uint64) {
+	if len(events) == 0 {
+		return 0, 0
+	}
+	if len(r.buf) < len(events) {
+		r.buf = make([]C.LuxEvent, len(events))
+	}
+
+	var cMissed C.uint64_t
+	n = int(C.lux_event_reader_poll(r.handle, &r.cursor, &r.buf[0], C.size_t(len(events)), &cMissed))
+	for i := 0; i < n; i++ {
+		events[i] = eventFromC(&r.buf[i])
+	}
+	return n, uint64(cMissed)
+}
+
+func eventFromC(c *C.LuxEvent) Event {
+	ev := Event{
+		Sequence: uint64(c.sequence),
+		Type:     EventType(c._type),
+		SymbolID: uint64(c.symbol_id),
+		Side:     Side(c.side),
+	}
+	data := unsafe.Pointer(&c.data[0])
+
+	switch ev.Type {
+	case EventTrade:
+		t := (*C.LuxTradeEvent)(data)
+		ev.Trade = Trade{
+			ID:              uint64(t.trade_id),
+			SymbolID:        ev.SymbolID,
+			BuyOrderID:      uint64(t.buy_order_id),
+			SellOrderID:     uint64(t.sell_order_id),
+			BuyerAccountID:  uint64(t.buyer_account_id),
+			SellerAccountID: uint64(t.seller_account_id),
+			Price:           Price(t.price),
+			Quantity:        Quantity(t.quantity),
+			AggressorSide:   ev.Side,
+			Timestamp:       time.Unix(0, int64(t.timestamp_ns)),
+		}
+	case EventOrderFilled, EventOrderPartial, EventOrderCancelled:
+		o := (*C.LuxOrderEvent)(data)
+		ev.Order = Order{
+			ID:        uint64(o.order_id),
+			SymbolID:  ev.SymbolID,
+			AccountID: uint64(o.account_id),
+			Price:     Price(o.price),
+			Quantity:  Quantity(o.quantity),
+			Filled:    Quantity(o.filled),
+			Side:      ev.Side,
+			Timestamp: time.Unix(0, int64(o.timestamp_ns)),
+		}
+		ev.FillQuantity = Quantity(o.fill_quantity)
+	case EventBookDelta:
+		d := (*C.LuxDeltaEvent)(data)
+		ev.Delta = BookDelta{
+			Sequence:   uint64(d.book_sequence),
+			Price:      Price(d.price),
+			Quantity:   Quantity(d.quantity),
+			OrderCount: int(d.order_count),
+		}
+	}
+	return ev
+}
+
 // GenerateOrderID generates a unique order ID using the C++ generator
 func GenerateOrderID() uint64 {
 	return uint64(C.lux_generate_order_id())
@@ -8,19 +8,28 @@
 #include <websocketpp/config/asio_no_tls_client.hpp>
 #include <websocketpp/client.hpp>
 #include <nlohmann/json.hpp>
+#include <lx/pipeline.hpp>
 
+#include <algorithm>
 #include <atomic>
 #include <chrono>
+#include <cmath>
 #include <condition_variable>
 #include <cstdlib>
+#include <deque>
+#include <functional>
 #include <iomanip>
 #include <iostream>
+#include <memory>
 #include <mutex>
+#include <optional>
 #include <queue>
+#include <random>
 #include <sstream>
 #include <string>
 #include <thread>
 #include <unordered_map>
+#include <vector>
 
 using json = nlohmann::json;
 using WsClient = websocketpp::client<websocketpp::config::asio_client>;
@@ -37,6 +46,9 @@ struct Config {
     std::string api_secret;
     bool verbose = false;
     bool interactive = true;
+    int coalesce_us = 0;            // Hold outbound frames this long to batch them
+    size_t send_queue_size = 4096;
+    size_t max_pending = 1024;      // Requests awaiting replies at once
     std::vector<std::string> command_args;
 };
 
@@ -52,6 +64,8 @@ public:
         , authenticated_(false)
         , request_counter_(0)
         , running_(false)
+        , send_queue_(config.send_queue_size)
+        , pending_(config.max_pending)
     {
         ws_.clear_access_channels(websocketpp::log::alevel::all);
         ws_.clear_error_channels(websocketpp::log::elevel::all);
@@ -249,6 +263,38 @@ public:
         return send_and_wait(msg);
     }
 
+    // Hand every incoming message to `handler` (on the I/O thread) instead
+    // of queueing it for send_and_wait; for callers that pipeline requests
+    void set_message_handler(std::function<void(const json&)> handler) {
+        std::lock_guard<std::mutex> lock(response_mutex_);
+        message_handler_ = std::move(handler);
+    }
+
+    // Queue a frame for the I/O thread; false if not connected or the
+    // queue is full. The first frame into an idle queue schedules a flush
+    // and everything queued before it runs goes out with it.
+    bool send(const json& msg) {
+        if (!is_connected()) return false;
+
+        if (config_.verbose) {
+            std::cout << ">> " << msg.dump(2) << "\n";
+        }
+        if (!send_queue_.push(msg.dump())) {
+            std::cerr << "Send error: queue full\n";
+            return false;
+        }
+
+        if (!flush_scheduled_.exchange(true, std::memory_order_acq_rel)) {
+            batch_start_ = std::chrono::steady_clock::now();
+            ws_.get_io_service().post([this]() { flush(); });
+        }
+        return true;
+    }
+
+    std::string next_request_id() {
+        return "req-" + std::to_string(++request_counter_);
+    }
+
 private:
     void on_message(MessagePtr msg) {
         try {
@@ -258,7 +304,20 @@ private:
                 std::cout << "<< " << j.dump(2) << "\n";
             }
 
+            // Replies go straight to the waiting caller's slot
+            uint64_t id;
+            auto rid = j.find("request_id");
+            if (rid != j.end() && rid->is_string() &&
+                lx::parse_request_id(rid->get_ref<const std::string&>(), id) &&
+                pending_.complete(id, j)) {
+                return;
+            }
+
             std::lock_guard<std::mutex> lock(response_mutex_);
+            if (message_handler_) {
+                message_handler_(j);
+                return;
+            }
             responses_.push(j);
             response_cv_.notify_all();
         } catch (const std::exception& e) {
@@ -266,22 +325,6 @@ private:
         }
     }
 
-    bool send(const json& msg) {
-        if (!is_connected()) return false;
-
-        try {
-            std::string payload = msg.dump();
-            if (config_.verbose) {
-                std::cout << ">> " << msg.dump(2) << "\n";
-            }
-            ws_.send(connection_, payload, websocketpp::frame::opcode::text);
-            return true;
-        } catch (const std::exception& e) {
-            std::cerr << "Send error: " << e.what() << "\n";
-            return false;
-        }
-    }
-
     std::optional<json> wait_response(const std::string& request_id,
                                        std::chrono::seconds timeout = std::chrono::seconds(5)) {
         std::unique_lock<std::mutex> lock(response_mutex_);
@@ -310,40 +353,62 @@ private:
         return std::nullopt;
     }
 
+    // I/O thread. Hands every queued frame to websocketpp back to back;
+    // frames queued behind an in-progress write leave in a single socket
+    // write. With a coalesce window the flush is re-posted, letting other
+    // I/O run, until the first frame has waited that long.
+    void flush() {
+        if (std::chrono::steady_clock::now() - batch_start_ <
+            std::chrono::microseconds(config_.coalesce_us)) {
+            ws_.get_io_service().post([this]() { flush(); });
+            return;
+        }
+
+        // Cleared before draining: a sender that still sees it set has
+        // already pushed, and this exchange makes that push visible here
+        flush_scheduled_.exchange(false, std::memory_order_acq_rel);
+
+        std::string payload;
+        while (send_queue_.pop(payload)) {
+            websocketpp::lib::error_code ec;
+            ws_.send(connection_, payload, websocketpp::frame::opcode::text, ec);
+            if (ec) {
+                std::cerr << "Send error: " << ec.message() << "\n";
+            }
+        }
+    }
+
     std::optional<json> send_and_wait(const json& msg,
                                        std::chrono::seconds timeout = std::chrono::seconds(5)) {
-        std::string req_id = msg["request_id"];
+        uint64_t id;
+        if (!lx::parse_request_id(msg["request_id"].get<std::string>(), id) || !pending_.open(id)) {
+            return std::nullopt;
+        }
         if (!send(msg)) {
+            pending_.cancel(id);
             return std::nullopt;
         }
 
-        auto deadline = std::chrono::steady_clock::now() + timeout;
-        while (std::chrono::steady_clock::now() < deadline) {
-            std::unique_lock<std::mutex> lock(response_mutex_);
-            if (!responses_.empty()) {
-                json resp = responses_.front();
-                responses_.pop();
-
-                if (resp.contains("request_id") && resp["request_id"] == req_id) {
-                    return resp;
-                }
+        json resp;
+        bool answered = pending_.wait(id, timeout, resp);
 
-                // Handle non-matching responses (subscriptions, etc)
-                if (resp.contains("type")) {
-                    std::string type = resp["type"];
-                    if (type != "connected" && type != "pong") {
-                        print_response(resp);
-                    }
+        // Print what arrived meanwhile (subscriptions, etc)
+        std::unique_lock<std::mutex> lock(response_mutex_);
+        while (!responses_.empty()) {
+            json other = std::move(responses_.front());
+            responses_.pop();
+            if (other.contains("type")) {
+                std::string type = other["type"];
+                if (type != "connected" && type != "pong") {
+                    print_response(other);
                 }
             }
-            response_cv_.wait_for(lock, std::chrono::milliseconds(100));
         }
 
-        return std::nullopt;
-    }
-
-    std::string next_request_id() {
-        return "req-" + std::to_string(++request_counter_);
+        if (!answered) {
+            return std::nullopt;
+        }
+        return resp;
     }
 
     void print_response(const json& resp) {
@@ -413,10 +478,463 @@ private:
     std::mutex response_mutex_;
     std::condition_variable response_cv_;
     std::queue<json> responses_;
+    std::function<void(const json&)> message_handler_;
+
+    // Outbound frames, drained by flush() on the I/O thread
+    lx::MpscQueue<std::string> send_queue_;
+    std::atomic<bool> flush_scheduled_{false};
+    std::chrono::steady_clock::time_point batch_start_;
+
+    // Replies awaited by request ID
+    lx::PendingTable<json> pending_;
 
     friend void print_message(Client& client, const json& msg);
 };
 
+//------------------------------------------------------------------------------
+// Latency Histogram
+//------------------------------------------------------------------------------
+
+// HDR-style log-linear histogram of nanosecond values: exact below 128,
+// then 64 sub-buckets per power of two, so any recorded value is reported
+// to within 1.6%. Fixed size, recording never allocates.
+class LatencyHistogram {
+public:
+    LatencyHistogram() : counts_(kBuckets, 0) {}
+
+    void record(uint64_t value) {
+        ++counts_[index_of(value)];
+        ++count_;
+        max_ = std::max(max_, value);
+    }
+
+    void merge(const LatencyHistogram& other) {
+        for (size_t i = 0; i < kBuckets; ++i) {
+            counts_[i] += other.counts_[i];
+        }
+        count_ += other.count_;
+        max_ = std::max(max_, other.max_);
+    }
+
+    uint64_t count() const { return count_; }
+    uint64_t max() const { return max_; }
+
+    // Smallest bucket bound at or above `percent` of recorded values
+    uint64_t percentile(double percent) const {
+        if (count_ == 0) return 0;
+        uint64_t target = static_cast<uint64_t>(std::ceil(percent / 100.0 * static_cast<double>(count_)));
+        target = std::max<uint64_t>(target, 1);
+
+        uint64_t seen = 0;
+        for (size_t i = 0; i < kBuckets; ++i) {
+            seen += counts_[i];
+            if (seen >= target) {
+                return std::min(highest_in(i), max_);
+            }
+        }
+        return max_;
+    }
+
+private:
+    static constexpr int kSubBits = 7;
+    static constexpr uint64_t kSubCount = uint64_t{1} << kSubBits;
+    static constexpr uint64_t kHalf = kSubCount / 2;
+    static constexpr size_t kBuckets = (64 - kSubBits + 2) * kHalf;
+
+    static size_t index_of(uint64_t value) {
+        if (value < kSubCount) return static_cast<size_t>(value);
+        const int msb = 63 - __builtin_clzll(value);
+        const int shift = msb - (kSubBits - 1);
+        return static_cast<size_t>(shift * kHalf + (value >> shift));
+    }
+
+    static uint64_t highest_in(size_t index) {
+        if (index < kSubCount) return index;
+        const uint64_t shift = index / kHalf - 1;
+        const uint64_t mantissa = index - shift * kHalf;
+        return ((mantissa + 1) << shift) - 1;
+    }
+
+    std::vector<uint64_t> counts_;
+    uint64_t count_ = 0;
+    uint64_t max_ = 0;
+};
+
+//------------------------------------------------------------------------------
+// Load Generation
+//------------------------------------------------------------------------------
+
+struct LoadConfig {
+    std::string symbol = "BTC-USD";
+    double rate = 1000.0;           // Messages per second, all connections
+    double duration = 10.0;         // Seconds
+    int connections = 1;
+    int place_weight = 60;          // Order flow mix
+    int cancel_weight = 30;
+    int amend_weight = 10;
+    double price = 50000.0;         // Reference price
+    double spread = 0.01;           // Orders rest this fraction away from it
+    double size = 0.01;
+    int timeout_ms = 5000;          // Unanswered this long after the run: timeout
+};
+
+enum LoadOp { kPlace = 0, kCancel = 1, kAmend = 2, kLoadOps = 3 };
+
+const char* load_op_name(int op) {
+    switch (op) {
+        case kPlace: return "place";
+        case kCancel: return "cancel";
+        case kAmend: return "amend";
+        default: return "all";
+    }
+}
+
+struct LoadStats {
+    LatencyHistogram latency[kLoadOps];
+    uint64_t sent[kLoadOps] = {};
+    uint64_t errors[kLoadOps] = {};
+    uint64_t send_failures = 0;
+    uint64_t timeouts = 0;
+
+    void merge(const LoadStats& other) {
+        for (int op = 0; op < kLoadOps; ++op) {
+            latency[op].merge(other.latency[op]);
+            sent[op] += other.sent[op];
+            errors[op] += other.errors[op];
+        }
+        send_failures += other.send_failures;
+        timeouts += other.timeouts;
+    }
+};
+
+// One connection's share of the load. Requests are sent on a fixed
+// schedule without waiting for replies, and latency is measured from the
+// scheduled send time, so a stalled server shows up in the tail rather
+// than silently lowering the offered rate (coordinated omission).
+class LoadWorker {
+public:
+    LoadWorker(const Config& config, const LoadConfig& load, int index)
+        : client_(config)
+        , load_(load)
+        , rng_(std::random_device{}() + static_cast<unsigned>(index))
+    {}
+
+    // Connect and authenticate; replies go to on_reply from then on
+    bool start() {
+        if (!client_.connect()) return false;
+        if (!client_.authenticate()) return false;
+        client_.set_message_handler([this](const json& msg) { on_reply(msg); });
+        return true;
+    }
+
+    void run(std::chrono::steady_clock::time_point begin,
+             std::chrono::steady_clock::time_point end) {
+        const auto interval = std::chrono::duration_cast<std::chrono::steady_clock::duration>(
+            std::chrono::duration<double>(load_.connections / load_.rate));
+        const int total_weight = load_.place_weight + load_.cancel_weight + load_.amend_weight;
+        std::uniform_int_distribution<int> pick(0, total_weight - 1);
+
+        for (auto scheduled = begin; scheduled < end; scheduled += interval) {
+            std::this_thread::sleep_until(scheduled);
+
+            int roll = pick(rng_);
+            int op = roll < load_.place_weight ? kPlace
+                   : roll < load_.place_weight + load_.cancel_weight ? kCancel
+                   : kAmend;
+            send_op(op, scheduled);
+        }
+    }
+
+    // Wait for outstanding replies; whatever is left counts as timed out
+    void drain(std::chrono::steady_clock::time_point deadline) {
+        std::unique_lock<std::mutex> lock(mutex_);
+        drained_cv_.wait_until(lock, deadline, [this]() { return pending_.empty(); });
+        stats_.timeouts += pending_.size();
+        pending_.clear();
+    }
+
+    void stop() {
+        client_.set_message_handler(nullptr);
+        client_.disconnect();
+    }
+
+    const LoadStats& stats() const { return stats_; }
+
+private:
+    struct Pending {
+        int op;
+        std::chrono::steady_clock::time_point scheduled;
+        bool buy;           // Place: side of the new order
+    };
+
+    void send_op(int op, std::chrono::steady_clock::time_point scheduled) {
+        std::string request_id = client_.next_request_id();
+        json msg;
+        bool buy = false;
+
+        {
+            std::lock_guard<std::mutex> lock(mutex_);
+            // Nothing resting yet to cancel or amend: place instead
+            if (op != kPlace && resting_.empty()) op = kPlace;
+
+            if (op == kPlace) {
+                buy = std::uniform_int_distribution<int>(0, 1)(rng_) == 0;
+                msg = {
+                    {"type", "place_order"},
+                    {"order", {
+                        {"symbol", load_.symbol},
+                        {"side", buy ? "buy" : "sell"},
+                        {"type", "limit"},
+                        {"price", resting_price(buy)},
+                        {"size", load_.size}
+                    }},
+                    {"request_id", request_id}
+                };
+            } else if (op == kCancel) {
+                uint64_t order_id = resting_.front().id;
+                resting_.pop_front();
+                msg = {
+                    {"type", "cancel_order"},
+                    {"orderID", order_id},
+                    {"request_id", request_id}
+                };
+            } else {
+                // Re-price the oldest order and move it to the back
+                Resting order = resting_.front();
+                resting_.pop_front();
+                resting_.push_back(order);
+                msg = {
+                    {"type", "modify_order"},
+                    {"orderID", order.id},
+                    {"newPrice", resting_price(order.buy)},
+                    {"request_id", request_id}
+                };
+            }
+
+            pending_.emplace(request_id, Pending{op, scheduled, buy});
+            ++stats_.sent[op];
+        }
+
+        if (!client_.send(msg)) {
+            std::lock_guard<std::mutex> lock(mutex_);
+            pending_.erase(request_id);
+            ++stats_.send_failures;
+        }
+    }
+
+    // A price `spread` away from the reference, jittered so orders spread
+    // over several levels without crossing
+    double resting_price(bool buy) {
+        const double offset = load_.spread * (1.0 + std::uniform_real_distribution<double>(0.0, 1.0)(rng_));
+        const double price = load_.price * (buy ? 1.0 - offset : 1.0 + offset);
+        return std::round(price * 100.0) / 100.0;
+    }
+
+    // Called on the client's I/O thread
+    void on_reply(const json& msg) {
+        const auto now = std::chrono::steady_clock::now();
+        auto rid = msg.find("request_id");
+        if (rid == msg.end() || !rid->is_string()) {
+            return; // Unsolicited update
+        }
+
+        std::lock_guard<std::mutex> lock(mutex_);
+        auto it = pending_.find(rid->get<std::string>());
+        if (it == pending_.end()) {
+            return;
+        }
+        const Pending pending = it->second;
+        pending_.erase(it);
+
+        const auto elapsed = std::chrono::duration_cast<std::chrono::nanoseconds>(now - pending.scheduled);
+        stats_.latency[pending.op].record(static_cast<uint64_t>(std::max<int64_t>(elapsed.count(), 0)));
+
+        auto error = msg.find("error");
+        if ((error != msg.end() && !error->is_null()) || msg.value("type", "") == "error") {
+            ++stats_.errors[pending.op];
+        } else if (pending.op == kPlace) {
+            if (auto order_id = order_id_of(msg)) {
+                resting_.push_back(Resting{*order_id, pending.buy});
+            }
+        }
+
+        if (pending_.empty()) {
+            drained_cv_.notify_all();
+        }
+    }
+
+    static std::optional<uint64_t> order_id_of(const json& msg) {
+        auto data = msg.find("data");
+        if (data == msg.end() || !data->is_object()) return std::nullopt;
+        if (data->contains("order") && (*data)["order"].contains("ID")) {
+            return (*data)["order"]["ID"].get<uint64_t>();
+        }
+        if (data->contains("orderId")) return (*data)["orderId"].get<uint64_t>();
+        if (data->contains("orderID")) return (*data)["orderID"].get<uint64_t>();
+        return std::nullopt;
+    }
+
+    struct Resting {
+        uint64_t id;
+        bool buy;
+    };
+
+    Client client_;
+    const LoadConfig& load_;
+    std::mt19937_64 rng_;
+
+    std::mutex mutex_;
+    std::condition_variable drained_cv_;
+    std::unordered_map<std::string, Pending> pending_;
+    std::deque<Resting> resting_;
+    LoadStats stats_;
+};
+
+bool parse_load_args(const std::vector<std::string>& args, LoadConfig& load) {
+    for (size_t i = 1; i < args.size(); ++i) {
+        const std::string& arg = args[i];
+        if (i + 1 >= args.size()) {
+            std::cerr << "Missing value for " << arg << "\n";
+            return false;
+        }
+        const std::string& value = args[++i];
+        try {
+            if (arg == "--symbol") {
+                load.symbol = value;
+            } else if (arg == "--rate") {
+                load.rate = std::stod(value);
+            } else if (arg == "--duration") {
+                load.duration = std::stod(value);
+            } else if (arg == "--connections") {
+                load.connections = std::stoi(value);
+            } else if (arg == "--mix") {
+                char sep1 = 0, sep2 = 0;
+                std::istringstream iss(value);
+                if (!(iss >> load.place_weight >> sep1 >> load.cancel_weight >> sep2 >> load.amend_weight) ||
+                    sep1 != ':' || sep2 != ':') {
+                    std::cerr << "Invalid mix: " << value << " (expected place:cancel:amend)\n";
+                    return false;
+                }
+            } else if (arg == "--price") {
+                load.price = std::stod(value);
+            } else if (arg == "--spread") {
+                load.spread = std::stod(value);
+            } else if (arg == "--size") {
+                load.size = std::stod(value);
+            } else if (arg == "--timeout") {
+                load.timeout_ms = std::stoi(value);
+            } else {
+                std::cerr << "Unknown load option: " << arg << "\n";
+                return false;
+            }
+        } catch (const std::exception&) {
+            std::cerr << "Invalid value for " << arg << ": " << value << "\n";
+            return false;
+        }
+    }
+
+    if (load.rate <= 0 || load.duration <= 0 || load.connections < 1 || load.price <= 0 ||
+        load.size <= 0 || load.place_weight < 0 || load.cancel_weight < 0 || load.amend_weight < 0 ||
+        load.place_weight + load.cancel_weight + load.amend_weight == 0) {
+        std::cerr << "Rate, duration, connections, price, size and mix must be positive\n";
+        return false;
+    }
+    return true;
+}
+
+void print_load_report(const LoadConfig& load, const LoadStats& stats, double elapsed) {
+    LatencyHistogram all;
+    uint64_t sent = 0;
+    uint64_t errors = 0;
+    for (int op = 0; op < kLoadOps; ++op) {
+        all.merge(stats.latency[op]);
+        sent += stats.sent[op];
+        errors += stats.errors[op];
+    }
+    auto percent = [sent](uint64_t n) {
+        return sent == 0 ? 0.0 : 100.0 * static_cast<double>(n) / static_cast<double>(sent);
+    };
+    auto us = [](uint64_t ns) { return static_cast<double>(ns) / 1000.0; };
+
+    std::cout << std::fixed << std::setprecision(1)
+              << "\nLoad: " << load.connections << " connection(s), target " << load.rate
+              << " msg/s for " << load.duration << " s, mix " << load.place_weight << ":"
+              << load.cancel_weight << ":" << load.amend_weight << " on " << load.symbol << "\n"
+              << "Sent:       " << sent << " (" << sent / elapsed << " msg/s)\n"
+              << "Answered:   " << all.count() << " (" << all.count() / elapsed << " msg/s)\n"
+              << std::setprecision(2)
+              << "Errors:     " << errors << " (" << percent(errors) << "%)\n"
+              << "Timeouts:   " << stats.timeouts << " (" << percent(stats.timeouts) << "%)\n"
+              << "Send fails: " << stats.send_failures << "\n\n";
+
+    std::cout << std::left << std::setw(8) << "op"
+              << std::right << std::setw(10) << "count"
+              << std::setw(10) << "errors"
+              << std::setw(12) << "p50 (us)"
+              << std::setw(12) << "p99 (us)"
+              << std::setw(12) << "p99.9 (us)"
+              << std::setw(12) << "max (us)" << "\n";
+    auto row = [&](const char* name, const LatencyHistogram& h, uint64_t errs) {
+        std::cout << std::left << std::setw(8) << name
+                  << std::right << std::setw(10) << h.count()
+                  << std::setw(10) << errs
+                  << std::setprecision(1)
+                  << std::setw(12) << us(h.percentile(50.0))
+                  << std::setw(12) << us(h.percentile(99.0))
+                  << std::setw(12) << us(h.percentile(99.9))
+                  << std::setw(12) << us(h.max()) << "\n";
+    };
+    for (int op = 0; op < kLoadOps; ++op) {
+        row(load_op_name(op), stats.latency[op], stats.errors[op]);
+    }
+    row(load_op_name(kLoadOps), all, errors);
+}
+
+int run_load(const Config& config, const std::vector<std::string>& args) {
+    LoadConfig load;
+    if (!parse_load_args(args, load)) {
+        return 1;
+    }
+
+    std::vector<std::unique_ptr<LoadWorker>> workers;
+    for (int i = 0; i < load.connections; ++i) {
+        workers.push_back(std::make_unique<LoadWorker>(config, load, i));
+        if (!workers.back()->start()) {
+            std::cerr << "Connection " << i + 1 << " to " << config.ws_url << " failed\n";
+            return 1;
+        }
+    }
+
+    // Stagger connections across one send interval so their requests
+    // interleave instead of arriving in bursts of N
+    const auto begin = std::chrono::steady_clock::now() + std::chrono::milliseconds(100);
+    const auto length = std::chrono::duration_cast<std::chrono::steady_clock::duration>(
+        std::chrono::duration<double>(load.duration));
+    const auto stagger = std::chrono::duration_cast<std::chrono::steady_clock::duration>(
+        std::chrono::duration<double>(1.0 / load.rate));
+
+    std::vector<std::thread> threads;
+    for (int i = 0; i < load.connections; ++i) {
+        threads.emplace_back([&, i]() {
+            workers[i]->run(begin + stagger * i, begin + length);
+        });
+    }
+    for (auto& t : threads) {
+        t.join();
+    }
+
+    const auto deadline = std::chrono::steady_clock::now() + std::chrono::milliseconds(load.timeout_ms);
+    LoadStats total;
+    for (auto& worker : workers) {
+        worker->drain(deadline);
+        worker->stop();
+        total.merge(worker->stats());
+    }
+
+    print_load_report(load, total, load.duration);
+    return 0;
+}
+
 //------------------------------------------------------------------------------
 // CLI Interface
 //------------------------------------------------------------------------------
@@ -710,6 +1228,7 @@ void print_usage(const char* prog) {
               << "  -s, --secret <secret> API secret for authentication\n"
               << "  -i, --interactive    Interactive mode (default if no command)\n"
               << "  -v, --verbose        Verbose output\n"
+              << "  -c, --coalesce <us>  Hold outbound frames up to <us> to batch them (default: 0)\n"
               << "  -h, --help           Show this help message\n\n"
               << "Commands:\n"
               << "  place_order <symbol> <side> <type> <price> <size>\n"
@@ -718,13 +1237,17 @@ void print_usage(const char* prog) {
               << "  get_positions\n"
               << "  get_orders\n"
               << "  get_balances\n"
-              << "  ping\n\n"
+              << "  ping\n"
+              << "  load [--symbol <s>] [--rate <msg/s>] [--duration <s>] [--connections <n>]\n"
+              << "       [--mix <place:cancel:amend>] [--price <p>] [--spread <f>] [--size <q>]\n"
+              << "       [--timeout <ms>]\n\n"
               << "Examples:\n"
               << "  " << prog << " -i                           # Interactive mode\n"
               << "  " << prog << " place_order BTC-USD buy limit 50000 0.1\n"
               << "  " << prog << " cancel_order 12345\n"
               << "  " << prog << " get_orderbook BTC-USD\n"
-              << "  " << prog << " -v ping                      # Ping with verbose output\n";
+              << "  " << prog << " -v ping                      # Ping with verbose output\n"
+              << "  " << prog << " load --rate 5000 --connections 4 --duration 30\n";
 }
 
 Config parse_args(int argc, char* argv[]) {
@@ -759,6 +1282,12 @@ Config parse_args(int argc, char* argv[]) {
             config.interactive = true;
         } else if (arg == "-v" || arg == "--verbose") {
             config.verbose = true;
+        } else if (arg == "-c" || arg == "--coalesce") {
+            if (i + 1 >= argc) {
+                std::cerr << "Missing coalesce window argument\n";
+                std::exit(1);
+            }
+            config.coalesce_us = std::atoi(argv[++i]);
         } else if (arg[0] != '-') {
             // Command and its arguments
             config.interactive = false;
@@ -784,6 +1313,11 @@ Config parse_args(int argc, char* argv[]) {
 int main(int argc, char* argv[]) {
     Config config = parse_args(argc, argv);
 
+    // Load mode opens its own connections
+    if (!config.interactive && config.command_args[0] == "load") {
+        return run_load(config, config.command_args);
+    }
+
     // Create and connect client
     Client client(config);
     if (!client.connect()) {
@@ -0,0 +1,329 @@
+#ifndef LUX_ASYNC_HPP
+#define LUX_ASYNC_HPP
+
+// =============================================================================
+// Coroutines (C++20, built with LUXDEX_COROUTINES)
+//
+// Task<T> is a lazily started coroutine: co_await on one runs it and
+// resumes the awaiting coroutine when it finishes. An EventLoop runs flows
+// on the thread that calls run(). spawn() starts a flow, and awaitables
+// park it until the loop resumes it, so thousands of flows share one
+// thread and none of them blocks it. Other threads hand work in through
+// post(); lock-free sources (trade rings) are read by pollers the loop
+// calls every turn.
+//
+// Everything here is single-threaded except post() and stop(). AsyncLX
+// (async_lx.hpp) adds place / cancel / subscribe / wait-for-fill against
+// an in-process LX.
+// =============================================================================
+
+#if !defined(__cpp_impl_coroutine)
+#error "lux/async.hpp needs C++20 coroutines (configure with -DLUXDEX_COROUTINES=ON)"
+#endif
+
+#include <atomic>
+#include <chrono>
+#include <condition_variable>
+#include <coroutine>
+#include <cstdint>
+#include <deque>
+#include <exception>
+#include <functional>
+#include <memory>
+#include <mutex>
+#include <optional>
+#include <queue>
+#include <unordered_set>
+#include <utility>
+#include <vector>
+
+namespace lux::async {
+
+template<typename T = void>
+class Task;
+class EventLoop;
+
+namespace detail {
+
+struct PromiseBase {
+    std::coroutine_handle<> continuation;
+    std::exception_ptr error;
+
+    // Hands control straight to the awaiting coroutine
+    struct FinalAwaiter {
+        bool await_ready() const noexcept { return false; }
+        template<typename Promise>
+        std::coroutine_handle<> await_suspend(std::coroutine_handle<Promise> done) noexcept {
+            std::coroutine_handle<> next = done.promise().continuation;
+            return next ? next : std::noop_coroutine();
+        }
+        void await_resume() const noexcept {}
+    };
+
+    std::suspend_always initial_suspend() const noexcept { return {}; }
+    FinalAwaiter final_suspend() const noexcept { return {}; }
+    void unhandled_exception() noexcept { error = std::current_exception(); }
+};
+
+template<typename T>
+struct Promise : PromiseBase {
+    std::optional<T> value;
+
+    Task<T> get_return_object() noexcept;
+    template<typename U>
+    void return_value(U&& result) { value.emplace(std::forward<U>(result)); }
+    T take() {
+        if (error) std::rethrow_exception(error);
+        return std::move(*value);
+    }
+};
+
+template<>
+struct Promise<void> : PromiseBase {
+    Task<void> get_return_object() noexcept;
+    void return_void() const noexcept {}
+    void take() const {
+        if (error) std::rethrow_exception(error);
+    }
+};
+
+} // namespace detail
+
+// A lazily started coroutine producing T; move-only, and the frame is
+// destroyed with the Task
+template<typename T>
+class [[nodiscard]] Task {
+public:
+    using promise_type = detail::Promise<T>;
+    using Handle = std::coroutine_handle<promise_type>;
+
+    Task() = default;
+    explicit Task(Handle handle) noexcept : handle_(handle) {}
+    Task(Task&& other) noexcept : handle_(std::exchange(other.handle_, {})) {}
+    Task& operator=(Task&& other) noexcept {
+        if (this != &other) {
+            if (handle_) handle_.destroy();
+            handle_ = std::exchange(other.handle_, {});
+        }
+        return *this;
+    }
+    Task(const Task&) = delete;
+    Task& operator=(const Task&) = delete;
+    ~Task() {
+        if (handle_) handle_.destroy();
+    }
+
+    bool done() const noexcept { return !handle_ || handle_.done(); }
+
+    // Awaiting starts the task and resumes the caller when it finishes;
+    // an exception thrown inside is rethrown here
+    bool await_ready() const noexcept { return done(); }
+    std::coroutine_handle<> await_suspend(std::coroutine_handle<> caller) noexcept {
+        handle_.promise().continuation = caller;
+        return handle_;
+    }
+    T await_resume() { return handle_.promise().take(); }
+
+private:
+    Handle handle_;
+};
+
+namespace detail {
+
+template<typename T>
+Task<T> Promise<T>::get_return_object() noexcept {
+    return Task<T>(std::coroutine_handle<Promise<T>>::from_promise(*this));
+}
+
+inline Task<void> Promise<void>::get_return_object() noexcept {
+    return Task<void>(std::coroutine_handle<Promise<void>>::from_promise(*this));
+}
+
+// Root coroutine of a spawned flow; frees itself when the flow finishes
+struct Detached {
+    struct promise_type {
+        EventLoop* loop = nullptr;
+
+        struct FinalAwaiter {
+            bool await_ready() const noexcept { return false; }
+            void await_suspend(std::coroutine_handle<promise_type> done) noexcept;
+            void await_resume() const noexcept {}
+        };
+
+        Detached get_return_object() noexcept {
+            return {std::coroutine_handle<promise_type>::from_promise(*this)};
+        }
+        std::suspend_always initial_suspend() const noexcept { return {}; }
+        FinalAwaiter final_suspend() const noexcept { return {}; }
+        void return_void() const noexcept {}
+        void unhandled_exception() const noexcept { std::terminate(); }
+    };
+    std::coroutine_handle<promise_type> handle;
+};
+
+} // namespace detail
+
+// =============================================================================
+// Event Loop
+// =============================================================================
+
+class EventLoop {
+public:
+    using Clock = std::chrono::steady_clock;
+
+    EventLoop() = default;
+    // Flows still suspended are destroyed; anything they registered with
+    // (AsyncLX waiters, subscriptions) must be gone first
+    ~EventLoop();
+
+    EventLoop(const EventLoop&) = delete;
+    EventLoop& operator=(const EventLoop&) = delete;
+
+    // The loop running on this thread; nullptr outside run() / run_once()
+    static EventLoop* current() noexcept { return current_; }
+
+    // Start a flow on the next turn; the loop owns it until it finishes.
+    // An exception escaping a flow stops the loop and is rethrown by run().
+    void spawn(Task<void> task);
+
+    // Resume `handle` on the next turn. Loop thread only.
+    void schedule(std::coroutine_handle<> handle) { ready_.push_back(handle); }
+
+    // Run `fn` on the loop thread at `deadline` / after `delay`. Loop
+    // thread only.
+    void call_at(Clock::time_point deadline, std::function<void()> fn);
+    void call_later(Clock::duration delay, std::function<void()> fn) {
+        call_at(Clock::now() + delay, std::move(fn));
+    }
+
+    // Any thread: run `fn` on the loop thread, waking an idle run()
+    void post(std::function<void()> fn);
+
+    // Called every turn; returns true if it found work. While any poller
+    // is installed an idle loop yields instead of sleeping.
+    size_t add_poller(std::function<bool()> poll);
+    void remove_poller(size_t id);
+
+    // Turns until every spawned flow has finished or stop() is called
+    void run();
+    // One turn: ready coroutines, posted work, due timers, pollers.
+    // Returns whether anything ran.
+    bool run_once();
+    // Any thread
+    void stop();
+
+    // Spawned flows not yet finished
+    size_t active() const noexcept { return flows_.size(); }
+
+private:
+    struct Timer {
+        Clock::time_point deadline;
+        uint64_t sequence;                  // FIFO among equal deadlines
+        std::function<void()> fn;
+        bool operator>(const Timer& other) const {
+            return deadline != other.deadline ? deadline > other.deadline
+                                              : sequence > other.sequence;
+        }
+    };
+
+    friend struct detail::Detached;
+    detail::Detached run_flow(Task<void> task);
+
+    static thread_local EventLoop* current_;
+
+    std::deque<std::coroutine_handle<>> ready_;
+    std::priority_queue<Timer, std::vector<Timer>, std::greater<Timer>> timers_;
+    uint64_t timer_sequence_{0};
+    std::vector<std::pair<size_t, std::function<bool()>>> pollers_;
+    size_t next_poller_{1};
+    std::unordered_set<void*> flows_;       // Root frames of live flows
+    std::exception_ptr error_;
+
+    std::atomic<bool> stopped_{false};
+    std::mutex posted_mutex_;
+    std::condition_variable posted_cv_;
+    std::vector<std::function<void()>> posted_;
+    std::vector<std::function<void()>> draining_;  // Keeps its capacity
+};
+
+// =============================================================================
+// Awaitables (inside a flow running on an EventLoop)
+// =============================================================================
+
+// co_await yield(): let the other ready flows run, resuming next turn
+struct Yield {
+    bool await_ready() const noexcept { return false; }
+    void await_suspend(std::coroutine_handle<> handle) const { EventLoop::current()->schedule(handle); }
+    void await_resume() const noexcept {}
+};
+inline Yield yield() { return {}; }
+
+// co_await sleep_for(d): resume once `d` has passed
+struct Sleep {
+    EventLoop::Clock::time_point deadline;
+
+    bool await_ready() const noexcept { return deadline <= EventLoop::Clock::now(); }
+    void await_suspend(std::coroutine_handle<> handle) const {
+        EventLoop::current()->call_at(deadline, [handle]() { handle.resume(); });
+    }
+    void await_resume() const noexcept {}
+};
+inline Sleep sleep_for(EventLoop::Clock::duration delay) {
+    return {EventLoop::Clock::now() + delay};
+}
+
+// A stream of values into one flow; loop thread only. push() wakes the
+// flow parked in next(), close() ends the stream once it is drained.
+template<typename T>
+class Channel {
+public:
+    explicit Channel(EventLoop& loop) : loop_(loop) {}
+
+    Channel(const Channel&) = delete;
+    Channel& operator=(const Channel&) = delete;
+
+    void push(T value) {
+        queue_.push_back(std::move(value));
+        wake();
+    }
+    void close() {
+        closed_ = true;
+        wake();
+    }
+    bool closed() const noexcept { return closed_; }
+    size_t size() const noexcept { return queue_.size(); }
+
+    // co_await next(): the next value, nullopt once closed and drained
+    auto next() {
+        struct Awaiter {
+            Channel& channel;
+            bool await_ready() const noexcept { return !channel.queue_.empty() || channel.closed_; }
+            void await_suspend(std::coroutine_handle<> handle) noexcept { channel.waiter_ = handle; }
+            std::optional<T> await_resume() {
+                if (channel.queue_.empty()) return std::nullopt;
+                std::optional<T> value(std::move(channel.queue_.front()));
+                channel.queue_.pop_front();
+                return value;
+            }
+        };
+        return Awaiter{*this};
+    }
+
+private:
+    void wake() {
+        if (waiter_) loop_.schedule(std::exchange(waiter_, {}));
+    }
+
+    EventLoop& loop_;
+    std::deque<T> queue_;
+    std::coroutine_handle<> waiter_;
+    bool closed_{false};
+};
+
+// Producers hold a weak_ptr and drop the channel once its reader lets go
+template<typename T>
+using Subscription = std::shared_ptr<Channel<T>>;
+
+} // namespace lux::async
+
+#endif // LUX_ASYNC_HPP
@@ -0,0 +1,107 @@
+#ifndef LUX_ASYNC_LX_HPP
+#define LUX_ASYNC_LX_HPP
+
+// =============================================================================
+// AsyncLX - Coroutine Awaitables over an In-Process LX
+//
+// Lets a flow on an EventLoop place, cancel, await its fills and follow a
+// market's trades without a thread of its own:
+//
+//     Task<void> flow(AsyncLX& dex, LXAccount me, LXOrder order, LXOrder hedge) {
+//         LXPlaceResult placed = co_await dex.place(me, order);
+//         auto state = co_await dex.wait_for_fill(order.market_id, placed.oid);
+//         if (state && state->status == BookOrderStatus::FILLED) {
+//             co_await dex.place(me, hedge);
+//         }
+//     }
+//
+// Matching in-process is synchronous, so place() and cancel() complete
+// without suspending; they are awaitables so flows read the same as
+// against a remote client. Fills and trades come from each market's trade
+// ring, read by a poller on the loop: no listener runs on the matching
+// thread, and the loop spins while an AsyncLX is attached.
+// =============================================================================
+
+#include "async.hpp"
+#include "lx.hpp"
+
+#include <chrono>
+#include <memory>
+#include <optional>
+#include <unordered_map>
+#include <vector>
+
+namespace lux::async {
+
+class AsyncLX {
+public:
+    // Destroy before the loop
+    AsyncLX(LX& lx, EventLoop& loop);
+    ~AsyncLX();
+
+    AsyncLX(const AsyncLX&) = delete;
+    AsyncLX& operator=(const AsyncLX&) = delete;
+
+    Task<LXPlaceResult> place(LXAccount sender, LXOrder order);
+    Task<int32_t> cancel(LXAccount sender, uint32_t market_id, uint64_t oid);
+
+    // Trades on a market from now on, oldest first. Trades the market's
+    // ring overwrote before the poller read them are skipped. nullptr if
+    // the market is unknown.
+    Subscription<Trade> subscribe_trades(uint32_t market_id);
+
+    // Resumes once the order has filled at least `min_filled_x18` (0: all
+    // of it) or is no longer open, or after `timeout` (0: none), and
+    // returns its state then; nullopt if the order is unknown. Fills are
+    // noticed from the trade ring and cancels made through cancel();
+    // other cancels only on the timeout.
+    Task<std::optional<BookOrderState>> wait_for_fill(uint32_t market_id, uint64_t oid,
+                                                      I128 min_filled_x18 = 0,
+                                                      std::chrono::nanoseconds timeout = {});
+
+    EventLoop& loop() noexcept { return loop_; }
+
+private:
+    struct Waiter {
+        AsyncLX* owner;                     // nullptr once the AsyncLX is gone
+        uint32_t market_id;
+        uint64_t oid;
+        I128 min_filled_x18;
+        I128 last_filled_x18;
+        std::coroutine_handle<> handle;
+        uint32_t hot_turns = 0;
+        bool woken = false;
+    };
+
+    // A trade reaches the ring before the order's state is updated, and
+    // the match may run on another thread, so a waiter whose oid traded
+    // is rechecked each turn until its filled size moves, for at most
+    // this many turns
+    static constexpr uint32_t HOT_TURNS = 256;
+
+    struct Market {
+        const TradeRing* ring;
+        uint64_t next;                      // Ring sequence read up to
+        std::vector<std::weak_ptr<Channel<Trade>>> subscribers;
+    };
+
+    // Reading starts at the ring's current end, so call before placing
+    Market* watch(uint32_t market_id);
+    bool poll();
+    static bool settled(const BookOrderState& state, I128 min_filled_x18);
+    void heat(uint64_t oid);                // Queue the oid's waiters for rechecks
+    void recheck(uint64_t oid);             // Wakes the oid's settled waiters now
+    bool check(Waiter& waiter);             // True once the waiter can wake
+    void wake(const std::shared_ptr<Waiter>& waiter);
+
+    LX& lx_;
+    EventLoop& loop_;
+    size_t poller_;
+    std::unordered_map<uint32_t, Market> markets_;
+    std::unordered_multimap<uint64_t, std::shared_ptr<Waiter>> waiters_;  // By oid
+    std::vector<std::shared_ptr<Waiter>> hot_;
+};
+
+} // namespace lux::async
+
+#endif // LUX_ASYNC_LX_HPP
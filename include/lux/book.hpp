@@ -4,12 +4,20 @@
 #include <memory>
 #include <unordered_map>
 #include <shared_mutex>
+#include <mutex>
+#include <atomic>
 #include <vector>
 #include <functional>
+#include <array>
+#include <unordered_set>
 
 #include "types.hpp"
 #include "orderbook.hpp"
 #include "engine.hpp"
+#include "memory.hpp"
+#include "striped_counter.hpp"
+#include "trade_ring.hpp"
+#include "trigger_book.hpp"
 
 // Hash specialization for CLOID (must be before lux namespace)
 namespace std {
@@ -45,6 +53,36 @@ struct BookMarketConfig {
     uint8_t status;              // 0=inactive, 1=active, 2=cancel-only
 };
 
+// An X18 amount in the engine's 1e8 fixed-point Price / Quantity units,
+// truncated: the units of a BookPolicy's tick and lot
+constexpr int64_t book_units(I128 value_x18) {
+    return static_cast<int64_t>(value_x18 / (X18_ONE / 100000000LL));
+}
+
+// =============================================================================
+// Market Handles
+// =============================================================================
+
+// A market resolved once, for sessions and batches that place many orders
+// on it: the config and the engine book, so placing skips the market map,
+// its lock and the engine's symbol lookup. Descriptors are never freed
+// while the LXBook lives. update_market_config() publishes a new version
+// and marks the old one superseded; placing through a superseded handle
+// uses the current version, and LXBook::refresh_market() moves it there.
+struct MarketDescriptor {
+    BookMarketConfig config;
+    uint64_t version;                    // 1 at creation, +1 per config update
+    Engine::SymbolHandle symbol;
+    TriggerBook* triggers;
+    std::atomic<bool> superseded{false};
+
+    // Inactive markets take nothing, cancel-only ones limit orders only
+    bool accepts(OrderKind kind) const {
+        return config.status != 0 && (config.status != 2 || kind == OrderKind::LIMIT);
+    }
+};
+using MarketHandle = const MarketDescriptor*;
+
 // =============================================================================
 // Order Status Enum (matches Solidity)
 // =============================================================================
@@ -92,13 +130,19 @@ struct ExecuteResult {
     std::vector<Trade> trades;
 };
 
+namespace packed {
+struct PackedPlaceResult;
+}
+
 // =============================================================================
 // LXBook - CLOB Matching Engine Wrapper (LP-9020)
 // =============================================================================
 
 class LXBook {
 public:
-    LXBook();
+    // The engine's config: its market data table, if any, also carries
+    // the feed prices passed to on_price()
+    explicit LXBook(EngineConfig config = {});
     ~LXBook() = default;
 
     // Non-copyable
@@ -110,11 +154,30 @@ public:
     // =========================================================================
 
     int32_t create_market(const BookMarketConfig& config);
+
+    // A market whose book is specialised for a BookPolicy (orderbook.hpp).
+    // INVALID_TICK_RANGE if the policy fixes a tick or lot other than the
+    // config's tick_size_x18 / lot_size_x18.
+    template<typename Policy>
+    int32_t create_market(const BookMarketConfig& config, Policy) {
+        if ((Policy::TICK != 0 && book_units(config.tick_size_x18) != Policy::TICK) ||
+            (Policy::LOT != 0 && book_units(config.lot_size_x18) != Policy::LOT)) {
+            return errors::INVALID_TICK_RANGE;
+        }
+        return create_market(config, &Engine::make_book<Policy>);
+    }
+
     int32_t update_market_config(const BookMarketConfig& config);
     std::optional<BookMarketConfig> get_market_config(uint32_t market_id) const;
     uint8_t get_market_status(uint32_t market_id) const;
     bool market_exists(uint32_t market_id) const;
 
+    // Current version of a market, nullptr if unknown. Lock-free.
+    MarketHandle resolve_market(uint32_t market_id) const;
+    // Moves a superseded handle to the current version; false if it was
+    // already current
+    bool refresh_market(MarketHandle& market) const;
+
     // =========================================================================
     // Execute Interface (Hyperliquid-style batch execution)
     // =========================================================================
@@ -130,9 +193,35 @@ public:
     // Order Operations
     // =========================================================================
 
-    // Place a new order
+    // Place a new order. STOP_* / TAKE_* kinds rest in the market's
+    // trigger book against the last trade price until it crosses
+    // trigger_px_x18.
     LXPlaceResult place_order(const LXAccount& sender, const LXOrder& order);
 
+    // Same, on a resolved market; rejected if order.market_id is not the
+    // handle's market
+    LXPlaceResult place_order(const LXAccount& sender, const LXOrder& order, MarketHandle market);
+
+    // Place `count` orders back to back, each from its own sender, writing
+    // one result per order. Consecutive orders on the same market share one
+    // resolved handle. Used by keepers that submit on behalf of many
+    // accounts at once.
+    void place_orders(const LXAccount* senders, const LXOrder* orders, size_t count,
+                      LXPlaceResult* results);
+
+    // Place a stop / take-profit order watching a specific reference price.
+    // It stays NEW until fired, then executes under the same oid as a
+    // market (IOC) or limit order.
+    LXPlaceResult place_trigger_order(const LXAccount& sender, const LXOrder& order,
+                                      PriceType price_type);
+
+    // Feed a reference price for a market; fires and executes every
+    // trigger order it crosses. Returns the number fired.
+    size_t on_price(uint32_t market_id, PriceType type, I128 price_x18);
+
+    // Trigger orders still waiting in a market
+    size_t pending_trigger_count(uint32_t market_id) const;
+
     // Cancel order by OID
     int32_t cancel_order(const LXAccount& sender, uint32_t market_id, uint64_t oid);
 
@@ -147,6 +236,15 @@ public:
     LXPlaceResult amend_order(const LXAccount& sender, uint32_t market_id,
                                uint64_t oid, I128 new_size_x18, I128 new_price_x18);
 
+    // Replace the sender's quote ladder on a market in one book pass.
+    // Levels are diffed against the sender's resting quotes from earlier
+    // mass quotes: an unchanged level is left alone, a smaller size keeps
+    // its queue position, anything else is cancelled and re-placed. Quotes
+    // rest as GTC limit orders. Callers serialise mass quotes per account
+    // and market.
+    LXMassQuoteResult mass_quote(const LXAccount& sender, uint32_t market_id,
+                                 const LXQuote* quotes, size_t count);
+
     // =========================================================================
     // Order Queries
     // =========================================================================
@@ -164,6 +262,17 @@ public:
     // Get all open orders for an account across all markets
     std::vector<BookOrderState> get_all_orders(const LXAccount& account) const;
 
+    // Same, into a caller-owned vector (cleared first) so repeated
+    // queries reuse its capacity; return the order count
+    size_t get_orders(const LXAccount& account, uint32_t market_id,
+                      std::vector<BookOrderState>& out) const;
+    size_t get_all_orders(const LXAccount& account, std::vector<BookOrderState>& out) const;
+
+    // Account behind an engine account id: trades carry LXAccount::hash()
+    // of their buyer and seller. nullopt for an account that has not placed
+    // an order since the book was created (snapshots do not carry them).
+    std::optional<LXAccount> get_account(uint64_t account_hash) const;
+
     // =========================================================================
     // Market Data
     // =========================================================================
@@ -174,24 +283,56 @@ public:
     // Get depth (multiple levels)
     MarketDepth get_depth(uint32_t market_id, size_t levels = 10) const;
 
+    // Fixed-point levels, best first, at most `levels` per side
+    L2Snapshot get_l2_snapshot(uint32_t market_id, size_t levels) const;
+    // Into a caller-owned snapshot; false if the market is unknown
+    bool get_l2_snapshot(uint32_t market_id, size_t levels, L2Snapshot& out) const;
+
     // Get last trade
     std::optional<Trade> get_last_trade(uint32_t market_id) const;
 
-    // Get recent trades
+    // Get recent trades (oldest first)
     std::vector<Trade> get_recent_trades(uint32_t market_id, size_t count = 100) const;
 
+    // Lock-free trade history of a market; iterate with read_since() to
+    // pick up every trade after a known sequence. nullptr if unknown.
+    // The ring lives as long as the LXBook.
+    const TradeRing* get_trade_ring(uint32_t market_id) const;
+
     // =========================================================================
     // HFT Interface (Packed ABI for low latency)
     // =========================================================================
 
     // Packed execute for colo participants
-    // Input: packed binary format for minimal parsing overhead
-    // Output: packed binary result
+    // Input: [action_type:1][action payload], the payload as execute() takes it
+    // Output: the action's packed result_data
     std::vector<uint8_t> execute_packed(const std::vector<uint8_t>& packed_data);
 
-    // Batch packed execute
+    // Batch packed execute; returns one PackedPlaceResult per action
     std::vector<uint8_t> execute_batch_packed(const std::vector<uint8_t>& packed_data);
 
+    // Zero-copy batch execute over a caller-owned buffer (e.g. an mmap'd
+    // region). Actions are decoded in place and one result per action is
+    // written to `out`; nothing is allocated per action on this path.
+    // Stops at the first truncated or unsupported action, or when `out` is
+    // full, and returns the number of actions executed.
+    size_t execute_batch_packed(const LXAccount& sender, const uint8_t* data, size_t size,
+                                packed::PackedPlaceResult* out, size_t out_capacity);
+
+    // Number of whole actions in a packed batch, for sizing `out`
+    static size_t count_packed_actions(const uint8_t* data, size_t size);
+
+    // =========================================================================
+    // Snapshots
+    // =========================================================================
+
+    // Engine books plus market configs and the account order index, in one
+    // file (see Engine::save_snapshot for consistency requirements).
+    // load_snapshot() requires a book with no orders. Markets created
+    // beforehand keep their books, so a BookPolicy market keeps its policy.
+    bool save_snapshot(const std::string& path) const;
+    bool load_snapshot(const std::string& path);
+
     // =========================================================================
     // Settlement Integration
     // =========================================================================
@@ -214,6 +355,18 @@ public:
     };
     Stats get_stats() const;
 
+    // Per-market breakdown (engine counters for the market's symbol)
+    struct MarketStats {
+        uint64_t orders_placed;
+        uint64_t orders_cancelled;
+        uint64_t total_trades;
+        I128 total_volume_x18;
+    };
+    std::optional<MarketStats> get_market_stats(uint32_t market_id) const;
+
+    // The engine's books plus the account order index
+    MemoryStats memory_usage() const;
+
     // =========================================================================
     // Direct Engine Access (for advanced use)
     // =========================================================================
@@ -222,6 +375,8 @@ public:
     const Engine* get_engine() const { return &engine_; }
 
 private:
+    int32_t create_market(const BookMarketConfig& config, Engine::BookFactory factory);
+
     // Core matching engine
     Engine engine_;
 
@@ -230,26 +385,67 @@ private:
     std::unordered_map<uint32_t, uint64_t> market_to_symbol_;  // market_id -> symbol_id
     mutable std::shared_mutex markets_mutex_;
 
-    // Order state tracking
+    // Every descriptor version ever published, so handles stay valid; the
+    // directory maps market_id to the current one for lock-free lookups
+    std::vector<std::unique_ptr<MarketDescriptor>> market_descriptors_;
+    SymbolDirectory<MarketDescriptor> market_directory_;
+    void publish_market(uint32_t market_id);  // Under markets_mutex_
+    // Order state tracking, sharded by account hash so fills for unrelated
+    // accounts take different locks. Each shard also maps the oids that
+    // hash to it back to their account, for lookups by oid alone.
+    struct MarketOrders {
+        std::vector<uint64_t> all;             // Every oid placed, in order
+        std::unordered_set<uint64_t> open;     // Not yet filled or cancelled
+    };
     struct AccountOrders {
         std::unordered_map<uint64_t, BookOrderState> orders;  // oid -> state
         std::unordered_map<std::array<uint8_t, 16>, uint64_t,
             std::hash<std::array<uint8_t, 16>>> cloid_to_oid;
+        std::unordered_map<uint32_t, MarketOrders> by_market;
+    };
+    // The top-level maps draw their nodes from the shard's pool, allocated
+    // under the shard's unique lock like every other write to them.
+    struct alignas(CACHE_LINE_SIZE) OrderIndexShard {
+        mutable std::shared_mutex mutex;
+        PoolArena arena;
+        std::pmr::unordered_map<uint64_t, AccountOrders> accounts{arena.resource()};   // account_hash -> orders
+        std::pmr::unordered_map<uint64_t, uint64_t> order_accounts{arena.resource()};  // oid -> account_hash
+        std::pmr::unordered_map<uint64_t, LXAccount> owners{arena.resource()};         // account_hash -> account
     };
-    std::unordered_map<uint64_t, AccountOrders> account_orders_;  // account_hash -> orders
-    mutable std::shared_mutex orders_mutex_;
+    static constexpr size_t ORDER_INDEX_SHARDS = 64;
+    std::array<OrderIndexShard, ORDER_INDEX_SHARDS> order_index_;
 
-    // Last trade per market
-    std::unordered_map<uint32_t, Trade> last_trades_;
-    std::unordered_map<uint32_t, std::vector<Trade>> recent_trades_;
-    mutable std::shared_mutex trades_mutex_;
+    static size_t index_shard(uint64_t key) {
+        return static_cast<size_t>((key * 0x9E3779B97F4A7C15ull) >> 58);  // Top 6 bits
+    }
+    OrderIndexShard& account_shard(uint64_t account_hash) {
+        return order_index_[index_shard(account_hash)];
+    }
+    const OrderIndexShard& account_shard(uint64_t account_hash) const {
+        return order_index_[index_shard(account_hash)];
+    }
+    std::optional<uint64_t> account_of(uint64_t oid) const;
+    void index_order(uint64_t account_hash, const BookOrderState& state);
+    void remember_account(const LXAccount& account);  // Before its order can trade
+
+    // Recent trades per engine symbol; rings are created with the market
+    // and never freed, so lookups need no lock
+    static constexpr size_t RECENT_TRADES = 1024;
+    std::vector<std::unique_ptr<TradeRing>> trade_rings_;
+    SymbolDirectory<TradeRing> trade_rings_by_symbol_;
+    void add_trade_ring(uint64_t symbol_id);  // Under markets_mutex_
+
+    // Resting stop / take-profit orders per market; created with the
+    // market and never freed
+    std::unordered_map<uint32_t, std::unique_ptr<TriggerBook>> trigger_books_;
+    TriggerBook* get_trigger_book(uint32_t market_id) const;
 
     // Settlement callback
     SettlementCallback settlement_callback_;
 
     // Statistics
-    std::atomic<uint64_t> total_orders_placed_{0};
-    std::atomic<uint64_t> total_orders_filled_{0};
+    StripedCounter<> total_orders_placed_;
+    StripedCounter<> total_orders_filled_;
 
     // Internal trade listener
     class BookTradeListener : public TradeListener {
@@ -257,6 +453,7 @@ private:
         explicit BookTradeListener(LXBook* book) : book_(book) {}
 
         void on_trade(const Trade& trade) override;
+        void on_trade_batch(const Trade* trades, size_t count) override;
         void on_order_filled(const Order& order) override;
         void on_order_partially_filled(const Order& order, Quantity fill_qty) override;
         void on_order_cancelled(const Order& order) override;
@@ -268,17 +465,26 @@ private:
 
     // Internal helpers
     uint64_t get_symbol_id(uint32_t market_id) const;
+    uint64_t check_market(const LXOrder& order) const;  // symbol_id, 0 = reject
     Order convert_to_internal(const LXOrder& order, uint64_t symbol_id,
-                               const LXAccount& sender) const;
-    void update_order_state(const LXAccount& account, uint64_t oid,
-                            const std::function<void(BookOrderState&)>& updater);
-    void record_trade(uint32_t market_id, const Trade& trade);
-
-    // Action handlers
-    ExecuteResult handle_place(const LXAccount& sender, const std::vector<uint8_t>& data);
-    ExecuteResult handle_cancel(const LXAccount& sender, const std::vector<uint8_t>& data);
-    ExecuteResult handle_cancel_by_cloid(const LXAccount& sender, const std::vector<uint8_t>& data);
-    ExecuteResult handle_modify(const LXAccount& sender, const std::vector<uint8_t>& data);
+                               const LXAccount& sender, uint64_t oid = 0) const;
+    // Runs an order on the engine; `triggered_oid` is the oid of a fired
+    // trigger order whose state already exists, 0 for a new order
+    LXPlaceResult execute_order(const LXAccount& sender, const LXOrder& order,
+                                const MarketDescriptor& market, uint64_t triggered_oid);
+    template<typename Updater>
+    bool update_order_state(uint64_t account_hash, uint64_t oid, Updater&& updater);
+    void record_trade(const Trade& trade);
+
+    // Action handlers; payloads are decoded in place
+    ExecuteResult execute_action(const LXAccount& sender, ActionType type,
+                                 const uint8_t* data, size_t size);
+    ExecuteResult handle_place(const LXAccount& sender, const uint8_t* data, size_t size);
+    ExecuteResult handle_cancel(const LXAccount& sender, const uint8_t* data, size_t size);
+    ExecuteResult handle_cancel_by_cloid(const LXAccount& sender, const uint8_t* data, size_t size);
+    ExecuteResult handle_modify(const LXAccount& sender, const uint8_t* data, size_t size);
+    ExecuteResult handle_mass_quote(const LXAccount& sender, const uint8_t* data, size_t size);
+    LXMassQuoteResult decode_mass_quote(const LXAccount& sender, const uint8_t* data, size_t size);
 };
 
 // =============================================================================
@@ -297,6 +503,31 @@ private:
 //   [0:4]   market_id (uint32)
 //   [4:12]  oid (uint64)
 //
+// CancelByCloid (20 bytes packed):
+//   [0:4]   market_id (uint32)
+//   [4:20]  cloid (16 bytes)
+//
+// ModifyOrder (28 bytes packed):
+//   [0:4]   market_id (uint32)
+//   [4:12]  oid (uint64)
+//   [12:20] new_size (int64, scaled by 1e8)
+//   [20:28] new_price (int64, scaled by 1e8)
+//
+// MassQuote (5 + 17 * count bytes packed):
+//   [0:4]   market_id (uint32)
+//   [4:5]   count (uint8)
+//   then count levels of:
+//   [0:1]   is_buy (uint8)
+//   [1:9]   price (int64, scaled by 1e8)
+//   [9:17]  size (int64, scaled by 1e8)
+// Executed alone it returns a PackedMassQuoteResult.
+//
+// Batch: back-to-back [action_type:1][payload] records, payload sized by
+// action type (NOOP has none). Each action yields one PackedPlaceResult;
+// cancels report the oid with status CANCELLED or REJECTED, mass quotes
+// report the number of levels quoted in oid, OPEN or REJECTED, and the
+// size filled on entry.
+//
 // =============================================================================
 
 namespace packed {
@@ -314,6 +545,29 @@ struct PackedCancelOrder {
     uint64_t oid;
 } __attribute__((packed));
 
+struct PackedCancelByCloid {
+    uint32_t market_id;
+    uint8_t cloid[16];
+} __attribute__((packed));
+
+struct PackedModifyOrder {
+    uint32_t market_id;
+    uint64_t oid;
+    int64_t new_size;
+    int64_t new_price;
+} __attribute__((packed));
+
+struct PackedMassQuoteHeader {
+    uint32_t market_id;
+    uint8_t count;
+} __attribute__((packed));
+
+struct PackedQuoteLevel {
+    uint8_t is_buy;
+    int64_t price;
+    int64_t size;
+} __attribute__((packed));
+
 struct PackedPlaceResult {
     uint64_t oid;
     uint8_t status;
@@ -321,6 +575,17 @@ struct PackedPlaceResult {
     int64_t avg_price;
 } __attribute__((packed));
 
+struct PackedMassQuoteResult {
+    int32_t error_code;
+    uint16_t kept;
+    uint16_t reduced;
+    uint16_t requeued;
+    uint16_t placed;
+    uint16_t cancelled;
+    uint16_t rejected;
+    int64_t filled_size;
+} __attribute__((packed));
+
 // Flag bit positions
 constexpr uint8_t FLAG_IS_BUY = 0x01;
 constexpr uint8_t FLAG_KIND_MASK = 0x0E;  // bits 1-3
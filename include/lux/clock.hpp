@@ -0,0 +1,130 @@
+#ifndef LUX_CLOCK_HPP
+#define LUX_CLOCK_HPP
+
+#include <atomic>
+#include <chrono>
+#include <cstdint>
+
+#include "order.hpp"
+
+#if defined(_MSC_VER) && (defined(_M_X64) || defined(_M_IX86))
+#include <intrin.h>
+#elif defined(__x86_64__) || defined(__i386__)
+#include <x86intrin.h>
+#endif
+
+namespace lux {
+
+// =============================================================================
+// Engine Clocks
+// =============================================================================
+//
+// Order books take every timestamp they assign (unstamped orders, trades,
+// modifies, depth snapshots) from an EngineClock, so the time source is a
+// deployment choice rather than a system call per order. The Engine stamps
+// each input with its clock before journaling it, and on replay it drives
+// its books from the journaled stamps, so a replayed journal reproduces the
+// original timestamps exactly whatever clock was used live.
+
+// CPU timestamp counter; steady_clock nanoseconds where there is none
+inline uint64_t cpu_ticks() {
+#if defined(_MSC_VER) && (defined(_M_X64) || defined(_M_IX86))
+    return __rdtsc();
+#elif defined(__x86_64__) || defined(__i386__)
+    return __rdtsc();
+#else
+    return static_cast<uint64_t>(std::chrono::duration_cast<std::chrono::nanoseconds>(
+        std::chrono::steady_clock::now().time_since_epoch()).count());
+#endif
+}
+
+// Nanoseconds per cpu_ticks() tick. The first call calibrates against
+// steady_clock for about 10 ms; later calls return the cached value.
+double cpu_tick_ns();
+
+class EngineClock {
+public:
+    virtual ~EngineClock() = default;
+
+    // Nanoseconds since the Unix epoch
+    virtual Timestamp now() const = 0;
+
+    // Called by the Engine once per batch, worker hand-off or single call
+    // before it stamps inputs; clocks that cache time refresh here
+    virtual void refresh() {}
+};
+
+// system_clock on every call: the books' behaviour without a clock
+class SystemClock final : public EngineClock {
+public:
+    Timestamp now() const override {
+        return std::chrono::duration_cast<Timestamp>(
+            std::chrono::system_clock::now().time_since_epoch());
+    }
+
+    // Shared default for books and engines given no clock
+    static SystemClock& instance();
+};
+
+// Calibrated TSC extrapolated from a system_clock anchor taken at
+// construction: monotonic and a few nanoseconds per read, at the price of
+// drifting from wall time by the calibration error (ppm) over long runs.
+// Construct a fresh one to re-anchor.
+class TscClock final : public EngineClock {
+public:
+    TscClock();
+
+    Timestamp now() const override {
+        const double elapsed = static_cast<double>(cpu_ticks() - anchor_ticks_);
+        return anchor_ + Timestamp(static_cast<int64_t>(elapsed * tick_ns_));
+    }
+
+private:
+    Timestamp anchor_;
+    uint64_t anchor_ticks_;
+    double tick_ns_;
+};
+
+// Time sampled once per Engine refresh(): every input of a batch shares one
+// timestamp and no order pays for a clock read
+class CoarseClock final : public EngineClock {
+public:
+    CoarseClock() { refresh(); }
+
+    Timestamp now() const override {
+        return Timestamp(nanos_.load(std::memory_order_relaxed));
+    }
+
+    void refresh() override {
+        nanos_.store(SystemClock::instance().now().count(), std::memory_order_relaxed);
+    }
+
+private:
+    std::atomic<int64_t> nanos_{0};
+};
+
+// Time that only moves when set: deterministic runs in tests and simulation,
+// and the clock the Engine replays journals on
+class ManualClock final : public EngineClock {
+public:
+    explicit ManualClock(Timestamp now = Timestamp(0)) : nanos_(now.count()) {}
+
+    Timestamp now() const override {
+        return Timestamp(nanos_.load(std::memory_order_relaxed));
+    }
+
+    void set(Timestamp now) {
+        nanos_.store(now.count(), std::memory_order_relaxed);
+    }
+
+    void advance(Timestamp by) {
+        nanos_.fetch_add(by.count(), std::memory_order_relaxed);
+    }
+
+private:
+    std::atomic<int64_t> nanos_;
+};
+
+} // namespace lux
+
+#endif // LUX_CLOCK_HPP
@@ -3,18 +3,26 @@
 
 #include <memory>
 #include <unordered_map>
-#include <shared_mutex>
+#include <mutex>
 #include <vector>
 #include <queue>
 #include <thread>
 #include <condition_variable>
 #include <atomic>
 #include <functional>
-#include <future>
+#include <string>
 
 #include "orderbook.hpp"
 #include "order.hpp"
 #include "trade.hpp"
+#include "spsc_ring.hpp"
+#include "task_pool.hpp"
+#include "symbol_directory.hpp"
+#include "journal.hpp"
+#include "snapshot.hpp"
+#include "event_ring.hpp"
+#include "market_data.hpp"
+#include "placement.hpp"
 
 namespace lux {
 
@@ -35,12 +43,12 @@ struct CancelResult {
 
 // Batch order for bulk processing
 struct BatchOrder {
-    enum class Action { Place, Cancel, Modify };
+    enum class Action { Place, Cancel, Modify, Reduce, Auction };
     Action action;
     Order order;  // For Place
-    uint64_t order_id;  // For Cancel/Modify
+    uint64_t order_id;  // For Cancel/Modify/Reduce
     Price new_price;  // For Modify
-    Quantity new_quantity;  // For Modify
+    Quantity new_quantity;  // For Modify/Reduce (in place, keeps priority)
 };
 
 struct BatchResult {
@@ -49,12 +57,74 @@ struct BatchResult {
     std::vector<Trade> all_trades;
 };
 
+// Completion record for an action accepted by Engine::submit().
+// Fixed-size so it can travel through completion rings without allocation;
+// individual fills are reported through the TradeListener.
+struct Completion {
+    uint64_t user_data;          // Echoed from submit()
+    uint64_t order_id;
+    BatchOrder::Action action;
+    bool success;
+    uint32_t trade_count;
+    Quantity filled_quantity;    // Sum of fills produced by this action
+};
+
 // Engine configuration
 struct EngineConfig {
     size_t worker_threads = 1;
     size_t max_batch_size = 1000;
     bool enable_self_trade_prevention = true;
     bool async_mode = false;
+    OrderBookConfig default_book;  // Used by add_symbol(symbol_id)
+
+    // Sharded mode: each symbol is owned by one worker thread fed through
+    // an SPSC ring; its book runs without internal locking.
+    bool sharded_mode = false;
+    size_t shard_count = 0;              // 0 = hardware concurrency
+    size_t shard_ring_capacity = 4096;   // Per-shard inbound ring slots
+    bool pin_shards = true;              // Pin shard i to CPU shard_cpus[i] or (i % cores)
+    std::vector<int> shard_cpus;         // Explicit CPU per shard, cycled (empty = i % cores)
+
+    // Placement of engine state (see placement.hpp). numa_local allocates
+    // each shard's books and rings on the NUMA node of its pinned CPU;
+    // huge_pages backs order pools and price ladders with 2 MB pages, for
+    // sharded and non-sharded books alike.
+    bool numa_local = false;
+    bool huge_pages = false;
+
+    // Pollable completion queue for submit(): one SPSC ring per worker/shard
+    bool completion_queue = false;
+    size_t completion_ring_capacity = 4096;
+
+    // Parallel process_batch: symbol groups run concurrently on a task
+    // pool. The trade listener is then invoked from several threads at
+    // once.
+    bool parallel_batch = false;
+    size_t batch_threads = 0;            // 0 = hardware concurrency
+
+    // Write-ahead journal of engine inputs (empty = disabled). In sharded
+    // mode shard i journals its own actions to "<journal_path>.<i>".
+    std::string journal_path;
+    JournalConfig journal;
+
+    // Shared-memory event ring (empty = disabled): every trade, order
+    // fill/cancel and L2 delta is published to this file for readers in
+    // other processes (see EventRingReader). The trade listener still
+    // gets its callbacks after each event is published.
+    std::string event_ring_path;
+    size_t event_ring_capacity = 1 << 16;
+
+    // Conflated market data table (empty = disabled): per-symbol L1/L2 and
+    // last trade, republished on change or at market_data.interval for
+    // subscribers in other processes (see MarketDataReader). Sits after
+    // the event ring and before the trade listener in the callback chain.
+    std::string market_data_path;
+    MarketDataConfig market_data;
+
+    // Time source for order, trade and input timestamps (null = SystemClock).
+    // The engine refreshes it once per call, batch or worker hand-off, and
+    // every 64 tasks of a busy shard.
+    std::shared_ptr<EngineClock> clock;
 };
 
 // Trading engine managing multiple orderbooks
@@ -71,25 +141,159 @@ public:
     void start();
     void stop();
     bool is_running() const { return running_.load(); }
+    const EngineConfig& config() const { return config_; }
 
     // Symbol management
     bool add_symbol(uint64_t symbol_id);
+    bool add_symbol(uint64_t symbol_id, const OrderBookConfig& book_config);
+
+    // A symbol whose book is specialised for a BookPolicy. Journals and
+    // snapshots record only the book config, so add such symbols with
+    // their policy before replaying or loading a snapshot; both keep
+    // existing books.
+    using BookFactory = std::unique_ptr<OrderBook> (*)(uint64_t symbol_id, const OrderBookConfig& config,
+                                                       std::pmr::memory_resource* memory);
+    template<typename Policy>
+    static std::unique_ptr<OrderBook> make_book(uint64_t symbol_id, const OrderBookConfig& config,
+                                                std::pmr::memory_resource* memory) {
+        return std::make_unique<OrderBook>(symbol_id, config, Policy{}, memory);
+    }
+    bool add_symbol(uint64_t symbol_id, const OrderBookConfig& book_config, BookFactory factory);
+    template<typename Policy>
+    bool add_symbol(uint64_t symbol_id, const OrderBookConfig& book_config, Policy) {
+        return add_symbol(symbol_id, book_config, &Engine::make_book<Policy>);
+    }
+
     bool remove_symbol(uint64_t symbol_id);
     bool has_symbol(uint64_t symbol_id) const;
     std::vector<uint64_t> symbols() const;
 
+private:
+    struct SymbolEntry;
+
+public:
+    // A symbol looked up once, for callers that place many orders on it
+    // (LXBook market handles). Stays valid until the symbol is removed;
+    // empty if the symbol was unknown.
+    class SymbolHandle {
+    public:
+        SymbolHandle() = default;
+        explicit operator bool() const { return entry_ != nullptr; }
+
+    private:
+        friend class Engine;
+        explicit SymbolHandle(SymbolEntry* entry) : entry_(entry) {}
+        SymbolEntry* entry_{nullptr};
+    };
+    SymbolHandle resolve_symbol(uint64_t symbol_id) const;
+
     // Order operations
     OrderResult place_order(Order order);
+    // Appends fills to `fills` instead of OrderResult::trades (left empty)
+    OrderResult place_order(Order order, std::vector<Trade>& fills);
+    // On a resolved symbol, skipping the lookup; the order's symbol_id is
+    // set from the handle
+    OrderResult place_order(SymbolHandle symbol, Order order, std::vector<Trade>& fills);
     CancelResult cancel_order(uint64_t symbol_id, uint64_t order_id);
     OrderResult modify_order(uint64_t symbol_id, uint64_t order_id,
                             Price new_price, Quantity new_quantity);
+    OrderResult reduce_order(uint64_t symbol_id, uint64_t order_id, Quantity new_quantity);
+
+    // Expire every resting GTD / DAY order due at `now` across all books
+    // (see OrderBook::expire_orders). Each one is journaled as a cancel,
+    // counted, and reported through TradeListener::on_order_cancelled
+    // with status Expired. Call it as time advances; books with nothing
+    // scheduled are skipped without locking. Returns the number expired,
+    // 0 while the engine is sharded.
+    size_t expire_orders(Timestamp now);
+    size_t expire_orders();  // At the current system time
+
+    // Run the uncross of every BatchAuction book whose interval slot has
+    // come up at `now` (see OrderBook::run_auction). Each auction that ran
+    // is journaled, so replay uncrosses at the same point in the order
+    // flow. Returns the number of trades, 0 while the engine is sharded.
+    size_t run_auctions(Timestamp now);
+    size_t run_auctions();  // At the current system time
+
+    // Replace an owner's quote ladder on one book in a single locked pass
+    // (see OrderBook::mass_quote). Quotes it cancels are counted and
+    // reported to the trade listener like ordinary cancels; the ladder is
+    // journaled as the cancels, reduces, modifies and places it resolved
+    // to. nullopt if the symbol is unknown or the engine is sharded.
+    std::optional<MassQuoteSummary> mass_quote(uint64_t symbol_id, const MassQuoteRequest& request,
+                                               QuoteOutcome* outcomes, std::vector<Trade>& fills);
+
+    // Journal. flush_journal() commits every pending group. replay_journal()
+    // re-applies a journal (and its shard files) to this engine's books
+    // without re-journaling; call it before start(). Returns records applied.
+    void flush_journal();
+    size_t replay_journal(const std::string& path);
+    uint64_t journal_sequence() const;      // Last record appended, 0 without a journal
+    // True once an append was dropped because the journal file could not
+    // grow. The input was still applied, so the journal no longer covers
+    // the book: stop taking inputs and snapshot before relying on replay.
+    bool journal_failed() const;
+
+    // Replication (see replication.hpp). apply_replicated() applies one
+    // record streamed from a primary's journal, on the journaled stamps,
+    // and appends it unchanged to this engine's own journal, if any, so a
+    // promoted replica continues the primary's sequence. Replicated books
+    // are thread-safe whatever the primary used, so queries can run while
+    // records are applied. end_replication() hands the books back to the
+    // engine clock. Non-sharded engines only; false otherwise.
+    bool apply_replicated(const JournalRecord& record);
+    void end_replication();
+
+    // Snapshots. Each book is captured under its own read lock; for a cut
+    // that lines up with the journal, take it while no inputs are in
+    // flight (between batches on the matching thread, or stopped when
+    // sharded). load_snapshot() creates the symbols the engine lacks and
+    // fills those it has if their books are empty, which is how a
+    // BookPolicy symbol keeps its policy: add it first. It remembers the
+    // journal positions the snapshot covers, so a
+    // following replay_journal() only applies the tail. It also moves
+    // OrderIdGenerator past every restored order ID.
+    bool save_snapshot(const std::string& path) const;
+    bool load_snapshot(const std::string& path);
 
-    // Batch operations
+    // Building blocks for components that extend the snapshot (LXBook)
+    void append_snapshot(SnapshotWriter& writer) const;
+    bool restore_snapshot(const SnapshotReader& reader);
+
+    // Batch operations. Actions are grouped by symbol and those for one
+    // symbol execute in batch order; order_results and cancel_results
+    // come back in the original batch order either way.
     BatchResult process_batch(const std::vector<BatchOrder>& batch);
 
-    // Query operations
+    // Asynchronous submission (async_mode or sharded_mode).
+    // In sharded mode the action goes to the owning shard's SPSC ring; each
+    // ring has a single producer, so submit() must not be called concurrently
+    // for the same shard. Returns false if the symbol is unknown, the ring is
+    // full, or neither async mode is enabled. Results are delivered to the
+    // completion handler on the executing thread and, with completion_queue
+    // enabled, as Completion records for poll_completions().
+    bool submit(const BatchOrder& order, uint64_t user_data = 0);
+    using CompletionHandler = std::function<void(const OrderResult&)>;
+    void set_completion_handler(CompletionHandler handler);
+
+    // Drain up to `max` completions; single consumer thread only
+    size_t poll_completions(Completion* out, size_t max);
+    uint64_t completions_dropped() const {
+        return completions_dropped_.load(std::memory_order_relaxed);
+    }
+    size_t shard_count() const { return shards_.size(); }
+    std::optional<size_t> shard_of(uint64_t symbol_id) const;
+
+    // Query operations. Sharded books are unlocked and owned by their shard
+    // thread, so while the engine is sharded and running get_order() returns
+    // nullopt, get_depth() an empty depth and get_l2_snapshot() false; read
+    // depth from market_data()
+    // or the event ring instead. best_bid()/best_ask() read the published
+    // L1 snapshot and are safe from any thread.
     std::optional<Order> get_order(uint64_t symbol_id, uint64_t order_id) const;
     MarketDepth get_depth(uint64_t symbol_id, size_t levels = 10) const;
+    // Fills `out` (see OrderBook::get_l2_snapshot); false on the same terms
+    bool get_l2_snapshot(uint64_t symbol_id, size_t levels, L2Snapshot& out) const;
     std::optional<Price> best_bid(uint64_t symbol_id) const;
     std::optional<Price> best_ask(uint64_t symbol_id) const;
 
@@ -102,10 +306,47 @@ public:
     };
     Stats get_stats() const;
 
+    // Per-symbol breakdown of the same counters
+    struct SymbolStats {
+        uint64_t orders_placed;
+        uint64_t orders_cancelled;
+        uint64_t trades;
+        uint64_t volume;
+    };
+    std::optional<SymbolStats> get_symbol_stats(uint64_t symbol_id) const;
+
+    // Order nodes and order indexes of the live books
+    MemoryStats memory_usage() const;
+
+    // Where each shard runs and what its memory holds; node memory stays
+    // zero unless numa_local or huge_pages is set. pinned turns true once
+    // the shard thread has pinned itself after start().
+    struct ShardPlacement {
+        int cpu;                    // -1: not pinned
+        int node;                   // NUMA node of cpu, -1 if unknown
+        bool pinned;
+        NodeMemoryStats memory;
+    };
+    struct PlacementStats {
+        std::vector<ShardPlacement> shards;
+        NodeMemoryStats shared;     // Non-sharded books (huge_pages only)
+    };
+    PlacementStats get_placement_stats() const;
+
     // Trade listener registration
     void set_trade_listener(TradeListener* listener);
 
-    // Direct orderbook access (use with caution)
+    // Event ring from EngineConfig::event_ring_path, or nullptr
+    const EventRing* event_ring() const { return event_ring_.get(); }
+
+    // Publisher from EngineConfig::market_data_path, or nullptr; feed
+    // prices go to its on_price()
+    MarketDataPublisher* market_data() const { return market_data_.get(); }
+
+    // Direct orderbook access (use with caution). A sharded book's locks
+    // are no-ops, so while the engine is sharded and running only
+    // top_of_book(), best_bid(), best_ask() and spread() may be called from
+    // outside its shard.
     OrderBook* get_orderbook(uint64_t symbol_id);
     const OrderBook* get_orderbook(uint64_t symbol_id) const;
 
@@ -113,54 +354,252 @@ private:
     EngineConfig config_;
     std::atomic<bool> running_{false};
 
-    // Orderbooks by symbol
-    std::unordered_map<uint64_t, std::unique_ptr<OrderBook>> orderbooks_;
-    mutable std::shared_mutex orderbooks_mutex_;
+    // Orderbooks by symbol. symbols_ owns the entries and is only touched
+    // by add/remove_symbol (under symbols_mutex_); every other path looks
+    // them up lock-free through directory_. Removed entries are retired
+    // rather than freed since a concurrent lookup may still hold them.
+    //
+    // Statistics live in the entry, on their own cache line: a symbol is
+    // normally driven by one thread (always, in sharded mode), so counters
+    // do not bounce between cores. get_stats() sums them on demand.
+    struct alignas(CACHE_LINE_SIZE) SymbolCounters {
+        std::atomic<uint64_t> orders_placed{0};
+        std::atomic<uint64_t> orders_cancelled{0};
+        std::atomic<uint64_t> trades{0};
+        std::atomic<uint64_t> volume{0};
 
-    // Statistics
-    std::atomic<uint64_t> total_orders_placed_{0};
-    std::atomic<uint64_t> total_orders_cancelled_{0};
-    std::atomic<uint64_t> total_trades_{0};
-    std::atomic<uint64_t> total_volume_{0};
+        void record_place(const Trade* fills, size_t count) {
+            orders_placed.fetch_add(1, std::memory_order_relaxed);
+            record_trades(fills, count);
+        }
+        void record_trades(const Trade* fills, size_t count) {
+            if (count == 0) {
+                return;
+            }
+            Quantity filled = 0;
+            for (size_t i = 0; i < count; ++i) {
+                filled += fills[i].quantity;
+            }
+            trades.fetch_add(count, std::memory_order_relaxed);
+            volume.fetch_add(filled, std::memory_order_relaxed);
+        }
+        void record_cancel() {
+            orders_cancelled.fetch_add(1, std::memory_order_relaxed);
+        }
+        SymbolStats snapshot() const {
+            return {orders_placed.load(std::memory_order_relaxed),
+                    orders_cancelled.load(std::memory_order_relaxed),
+                    trades.load(std::memory_order_relaxed),
+                    volume.load(std::memory_order_relaxed)};
+        }
+    };
+    struct SymbolEntry {
+        std::unique_ptr<OrderBook> book;
+        size_t shard = 0;
+        SymbolCounters counters;
+        std::mutex input_mutex;     // See order_inputs()
+    };
+    // Placed memory for shards and shared books; declared first so that
+    // books and rings drawing on it are destroyed before it
+    std::vector<std::unique_ptr<NodeMemory>> node_memory_;
+    NodeMemory* shared_memory_{nullptr};
+    std::pmr::memory_resource* book_memory(const SymbolEntry& entry) const;
+    std::unordered_map<uint64_t, std::unique_ptr<SymbolEntry>> symbols_;
+    std::vector<std::unique_ptr<SymbolEntry>> retired_symbols_;
+    SymbolDirectory<SymbolEntry> directory_;
+    mutable std::mutex symbols_mutex_;
+
+    OrderBook* find_book(uint64_t symbol_id) const {
+        SymbolEntry* entry = directory_.find(symbol_id);
+        return entry ? entry->book.get() : nullptr;
+    }
 
-    // Trade listener
+    // Trade listener; the event publisher when an event ring is open,
+    // which forwards to the registered listener
     TradeListener* trade_listener_{nullptr};
+    std::unique_ptr<EventRing> event_ring_;
+    std::unique_ptr<EventPublisher> event_publisher_;
+    std::unique_ptr<MarketDataPublisher> market_data_;
 
-    // Async processing (if enabled)
+    // Batch execution
+    std::unique_ptr<TaskPool> batch_pool_;
+    void execute_batch_item(SymbolEntry* entry, const BatchOrder& batch_order,
+                            BatchResult& out);
+    // Symbol groups run in sequence, or on batch_pool_ when configured
+    BatchResult process_batch_grouped(const std::vector<BatchOrder>& batch);
+
+    // Async processing (if enabled): submissions are handed to workers in
+    // batches, completions return through per-worker rings
     struct AsyncOrder {
         BatchOrder batch_order;
-        std::promise<OrderResult> promise;
+        uint64_t user_data;
+    };
+    struct Worker {
+        explicit Worker(size_t completion_capacity) : completions(completion_capacity) {}
+        SpscRing<Completion> completions;
+        std::thread thread;
     };
-    std::queue<AsyncOrder> order_queue_;
+    std::vector<AsyncOrder> pending_orders_;
     std::mutex queue_mutex_;
     std::condition_variable queue_cv_;
-    std::vector<std::thread> worker_threads_;
+    std::vector<std::unique_ptr<Worker>> workers_;
+    std::atomic<uint64_t> completions_dropped_{0};
+
+    void worker_loop(Worker& worker);
+    void complete(SpscRing<Completion>& ring, uint64_t user_data,
+                  const BatchOrder& batch_order, OrderResult& result,
+                  std::vector<Trade>& fills);
+
+    // Sharded execution
+    struct ShardTask {
+        BatchOrder batch_order;
+        SymbolEntry* entry;
+        uint64_t user_data;
+    };
+    struct Shard {
+        Shard(size_t ring_capacity, size_t completion_capacity, int cpu, NodeMemory* memory)
+            : inbound(ring_capacity, memory ? memory->resource() : std::pmr::get_default_resource()),
+              completions(completion_capacity,
+                          memory ? memory->resource() : std::pmr::get_default_resource()),
+              cpu(cpu), memory(memory) {}
+        SpscRing<ShardTask> inbound;
+        SpscRing<Completion> completions;
+        int cpu;                            // -1: unpinned
+        NodeMemory* memory;                 // In node_memory_, or null
+        std::atomic<bool> pinned{false};
+        std::unique_ptr<Journal> journal;   // Written only by the shard thread
+        std::thread thread;
+    };
+    std::vector<std::unique_ptr<Shard>> shards_;
+    size_t next_shard_{0};
+    CompletionHandler completion_handler_;
+
+    size_t completion_ring_capacity() const {
+        return config_.completion_queue ? config_.completion_ring_capacity : 2;
+    }
+    bool sharded_running() const {
+        return config_.sharded_mode && running_.load(std::memory_order_acquire);
+    }
+    void shard_loop(Shard& shard);
+    // Inputs are stamped with clock_ before they are journaled; replay runs
+    // the books on replay_clock_, set from each record's stamp
+    EngineClock* clock_;
+    ManualClock replay_clock_;
+    EngineClock* book_clock() { return replaying_ ? &replay_clock_ : clock_; }
+    void stamp(BatchOrder& input) const {
+        if (input.order.timestamp.count() == 0) {
+            input.order.timestamp = clock_->now();
+        }
+    }
 
-    void worker_loop();
-    OrderResult process_single_order(const BatchOrder& batch_order);
+    // Journaling
+    std::unique_ptr<Journal> journal_;      // Non-sharded inputs and symbol changes
+    mutable std::mutex journal_mutex_;
+    bool replaying_{false};
+    std::vector<uint64_t> replay_after_;    // Per file (main, then shards): skip up to here
+    void journal_input(const BatchOrder& batch_order);
+    // Appends, latching journal_failed_ if the record was dropped
+    void journal_append(Journal& journal, const JournalRecord& record);
+    std::atomic<bool> journal_failed_{false};
+    // Held from journaling a book's input until the book has applied it,
+    // so the journal lists each book's inputs in execution order and replay
+    // rebuilds the same book. Books do not contend with each other; only
+    // the record copy is under journal_mutex_. Not taken while journaling
+    // is off, when the book's own lock orders its inputs.
+    std::unique_lock<std::mutex> order_inputs(SymbolEntry& entry) {
+        if (!journal_ || replaying_) {
+            return {};
+        }
+        return std::unique_lock<std::mutex>(entry.input_mutex);
+    }
+    void journal_symbol(JournalRecordType type, uint64_t symbol_id,
+                        const OrderBookConfig& book_config);
+    size_t replay_file(const std::string& path, uint64_t after_sequence);
+    void replay_record(const JournalRecord& record, std::vector<Trade>& fills);
+
+    OrderResult execute_on_book(SymbolEntry& entry, const BatchOrder& batch_order,
+                                std::vector<Trade>& fills);
 };
 
 // Order ID generator
+//
+// IDs are leased in blocks: the shared counter moves once per BLOCK_SIZE
+// IDs and each thread draws its own block down without touching it, so
+// shards generating on different cores do not bounce one cache line.
+// IDs are unique process-wide and increase per thread (or per
+// OrderIdBlock), but threads interleave rather than count up together.
 class OrderIdGenerator {
 public:
+    static constexpr uint64_t BLOCK_SIZE = 4096;
+
     static OrderIdGenerator& instance() {
         static OrderIdGenerator gen;
         return gen;
     }
 
-    uint64_t next() {
-        return counter_.fetch_add(1, std::memory_order_relaxed);
+    // From the calling thread's block
+    uint64_t next();
+
+    // Leases [first, first + count) and returns first
+    uint64_t lease(uint64_t count) {
+        return counter_.fetch_add(count, std::memory_order_relaxed);
     }
 
+    // Outstanding blocks are dropped, so next() on any thread restarts here
     void reset(uint64_t start = 1) {
         counter_.store(start, std::memory_order_relaxed);
+        epoch_.fetch_add(1, std::memory_order_release);
+    }
+
+    // Never hands out `id` or anything below it again; call after restoring
+    // orders whose IDs came from an earlier process
+    void advance_past(uint64_t id) {
+        uint64_t current = counter_.load(std::memory_order_relaxed);
+        while (current <= id &&
+               !counter_.compare_exchange_weak(current, id + 1, std::memory_order_relaxed)) {
+        }
+        epoch_.fetch_add(1, std::memory_order_release);
+    }
+
+    // Bumped whenever outstanding blocks may overlap IDs in use
+    uint64_t epoch() const {
+        return epoch_.load(std::memory_order_acquire);
     }
 
 private:
     OrderIdGenerator() = default;
-    std::atomic<uint64_t> counter_{1};
+    alignas(CACHE_LINE_SIZE) std::atomic<uint64_t> counter_{1};
+    alignas(CACHE_LINE_SIZE) std::atomic<uint64_t> epoch_{0};  // Read per ID, written rarely
 };
 
+// A leased block of IDs for one shard or thread; not thread-safe
+class OrderIdBlock {
+public:
+    explicit OrderIdBlock(uint64_t block_size = OrderIdGenerator::BLOCK_SIZE)
+        : block_size_(block_size ? block_size : 1) {}
+
+    uint64_t next() {
+        OrderIdGenerator& gen = OrderIdGenerator::instance();
+        if (next_ == end_ || epoch_ != gen.epoch()) {
+            epoch_ = gen.epoch();
+            next_ = gen.lease(block_size_);
+            end_ = next_ + block_size_;
+        }
+        return next_++;
+    }
+
+private:
+    uint64_t block_size_;
+    uint64_t next_{0};
+    uint64_t end_{0};
+    uint64_t epoch_{0};
+};
+
+inline uint64_t OrderIdGenerator::next() {
+    thread_local OrderIdBlock block;
+    return block.next();
+}
+
 } // namespace lux
 
 #endif // LUX_ENGINE_HPP
@@ -0,0 +1,167 @@
+#ifndef LUX_EVENT_RING_HPP
+#define LUX_EVENT_RING_HPP
+
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <type_traits>
+
+#include "trade.hpp"
+#include "orderbook.hpp"
+
+namespace lux {
+
+// =============================================================================
+// Shared-Memory Event Ring
+// =============================================================================
+//
+// Fixed-capacity ring of engine output events (trades, order state changes
+// and L2 deltas) in a shared file mapping, e.g. under /dev/shm. One writer
+// publishes; any number of readers, in this process or another, map the
+// file and poll at their own pace by sequence number. Each slot is a
+// seqlock, so readers never block the writer and never take a syscall:
+// they either copy an event exactly as written or learn that the writer
+// has lapped them. The layout is plain fixed-width fields and is mirrored
+// by LuxEvent in the C bindings.
+
+enum class EventType : uint8_t {
+    Trade = 1,
+    OrderFilled = 2,
+    OrderPartiallyFilled = 3,
+    OrderCancelled = 4,
+    BookDelta = 5
+};
+
+struct TradeEvent {
+    uint64_t trade_id;
+    uint64_t buy_order_id;
+    uint64_t sell_order_id;
+    uint64_t buyer_account_id;
+    uint64_t seller_account_id;
+    int64_t price;
+    int64_t quantity;
+    int64_t timestamp_ns;
+};
+
+struct OrderEvent {
+    uint64_t order_id;
+    uint64_t account_id;
+    int64_t price;
+    int64_t quantity;
+    int64_t filled;
+    int64_t fill_quantity;      // OrderPartiallyFilled: this fill
+    int64_t timestamp_ns;
+};
+
+struct DeltaEvent {
+    uint64_t book_sequence;     // BookDelta::sequence of the symbol's book
+    int64_t price;
+    int64_t quantity;           // 0 with order_count 0: level removed
+    uint32_t order_count;
+    uint32_t reserved;
+};
+
+struct EventRecord {
+    uint64_t sequence;          // Ring sequence, from 1
+    uint64_t symbol_id;
+    EventType type;
+    uint8_t side;               // Trade: aggressor; order: order; delta: level (Side)
+    uint8_t reserved[6];
+    union {
+        TradeEvent trade;
+        OrderEvent order;
+        DeltaEvent delta;
+    };
+};
+static_assert(std::is_trivially_copyable_v<EventRecord>, "events are copied raw");
+static_assert(sizeof(EventRecord) == 88, "EventRecord layout is shared with C readers");
+
+// Single-writer ring; callers serialise publish()
+class EventRing {
+public:
+    // Creates `path` afresh, replacing any previous ring there (readers
+    // still attached to the old file keep it and see no new events).
+    // Capacity is rounded up to a power of two. Returns nullptr if the
+    // file cannot be created or mapped.
+    static std::unique_ptr<EventRing> create(const std::string& path, size_t capacity = 1 << 16);
+    ~EventRing();
+
+    EventRing(const EventRing&) = delete;
+    EventRing& operator=(const EventRing&) = delete;
+
+    // Assigns the next sequence to `record` and publishes it
+    uint64_t publish(EventRecord record);
+
+    // Sequence of the newest event (0 if none)
+    uint64_t head() const;
+    size_t capacity() const { return capacity_; }
+    const std::string& path() const { return path_; }
+
+private:
+    EventRing(std::string path, void* mapping, size_t bytes, size_t capacity);
+
+    std::string path_;
+    void* mapping_;
+    size_t mapped_bytes_;
+    size_t capacity_;
+    uint64_t head_{0};
+};
+
+// Read-only view of a ring created by another thread or process
+class EventRingReader {
+public:
+    static std::unique_ptr<EventRingReader> open(const std::string& path);
+    ~EventRingReader();
+
+    EventRingReader(const EventRingReader&) = delete;
+    EventRingReader& operator=(const EventRingReader&) = delete;
+
+    // Copies up to `max` events after sequence `cursor` into `out`, oldest
+    // first, and advances `cursor` past them. Events the writer overwrote
+    // before they were read are skipped and counted in `missed`. Returns
+    // the number copied; 0 when caught up.
+    size_t poll(uint64_t& cursor, EventRecord* out, size_t max, uint64_t* missed = nullptr) const;
+
+    uint64_t head() const;
+    size_t capacity() const { return capacity_; }
+
+private:
+    EventRingReader(void* mapping, size_t bytes, size_t capacity)
+        : mapping_(mapping), mapped_bytes_(bytes), capacity_(capacity) {}
+
+    void* mapping_;
+    size_t mapped_bytes_;
+    size_t capacity_;
+};
+
+// Feeds an EventRing from an engine's trade and book update callbacks.
+// Those can arrive from several threads at once (shards, parallel
+// batches), so publishing is serialised by a mutex here; readers never
+// take it. Callbacks are forwarded to `next` after publishing.
+class EventPublisher : public TradeListener, public BookUpdateListener {
+public:
+    explicit EventPublisher(EventRing& ring, TradeListener* next = nullptr)
+        : ring_(ring), next_(next) {}
+
+    void set_next(TradeListener* next) { next_ = next; }
+
+    void on_trade(const Trade& trade) override;
+    void on_trade_batch(const Trade* trades, size_t count) override;
+    void on_order_filled(const Order& order) override;
+    void on_order_partially_filled(const Order& order, Quantity fill_qty) override;
+    void on_order_cancelled(const Order& order) override;
+    void on_book_delta(uint64_t symbol_id, const BookDelta& delta) override;
+
+private:
+    void publish_order(EventType type, const Order& order, Quantity fill_qty);
+
+    EventRing& ring_;
+    TradeListener* next_;
+    std::mutex mutex_;
+};
+
+} // namespace lux
+
+#endif // LUX_EVENT_RING_HPP
@@ -1,15 +1,20 @@
 #ifndef LUX_FEED_HPP
 #define LUX_FEED_HPP
 
+#include <array>
 #include <map>
 #include <unordered_map>
 #include <shared_mutex>
+#include <mutex>
+#include <atomic>
 #include <optional>
 #include <vector>
 #include <cmath>
+#include <functional>
 
 #include "types.hpp"
 #include "oracle.hpp"
+#include "seqlock.hpp"
 
 namespace lux {
 
@@ -76,8 +81,9 @@ struct TriggerRule {
 
 class LXFeed {
 public:
+    // Subscribes to the oracle's price changes for the feed's lifetime
     explicit LXFeed(LXOracle& oracle);
-    ~LXFeed() = default;
+    ~LXFeed();
 
     // Non-copyable
     LXFeed(const LXFeed&) = delete;
@@ -145,10 +151,40 @@ public:
     };
     std::optional<AllPrices> get_all_prices(uint32_t market_id) const;
 
+    // Called with each reference price the feed moves: LAST from
+    // update_last_price, INDEX and MARK after record_premium or
+    // publish_prices, and after an oracle update for the markets on the
+    // updated asset only. Runs outside the feed's locks on the updating
+    // thread; set it before prices start flowing.
+    using PriceListener = std::function<void(uint32_t market_id, PriceType type, I128 price_x18)>;
+    void set_price_listener(PriceListener listener);
+
+    // Push the current index and mark to the listener
+    void publish_prices(uint32_t market_id);
+
     // Get prices for multiple markets
     std::vector<std::pair<uint32_t, AllPrices>>
     get_multiple_market_prices(const std::vector<uint32_t>& market_ids) const;
 
+    // =========================================================================
+    // Published Price Table
+    // =========================================================================
+
+    // Every registered market's prices in one contiguous array of seqlocked
+    // records, one dense slot per market. The feed rewrites a record
+    // whenever one of its inputs changes (oracle push, premium, last trade,
+    // BBO, mark config), so a bulk read is a lock-free copy pass. Records
+    // are as of their last input change; version counts rewrites.
+    struct PriceRecord {
+        uint32_t market_id;
+        bool active;                // False once unregistered
+        uint64_t version;
+        AllPrices prices;
+    };
+
+    // Copy out every active record; returns the number copied
+    size_t read_price_table(std::vector<PriceRecord>& out) const;
+
     // =========================================================================
     // Premium & Basis
     // =========================================================================
@@ -187,6 +223,10 @@ public:
     // Calculate and update funding rate
     void calculate_funding_rate(uint32_t market_id);
 
+    // Calculate and update several markets' rates in one pass under one
+    // lock of each kind; returns (market, rate) in input order
+    std::vector<std::pair<uint32_t, I128>> calculate_funding_rates(const std::vector<uint32_t>& market_ids);
+
     // =========================================================================
     // Trigger Price (for SL/TP, Liquidation)
     // =========================================================================
@@ -202,6 +242,45 @@ public:
     std::optional<I128> liquidation_price(uint32_t market_id, const LXPosition& position,
                                            I128 maintenance_margin_x18) const;
 
+    // =========================================================================
+    // Batch Trigger Evaluation
+    // =========================================================================
+
+    // One-shot price thresholds, kept per market and TriggerType in sorted
+    // contiguous arrays: buys fire once the price falls to their trigger,
+    // sells once it rises to it, as in check_trigger. A new price fires a
+    // suffix of the buys and a prefix of the sells, found by binary search,
+    // so evaluation is O(log n + k) for k fired. Equal triggers fire in
+    // arrival order.
+    struct FiredTrigger {
+        uint64_t id;
+        uint32_t market_id;
+        TriggerType type;
+        bool is_buy;
+        I128 trigger_price_x18;
+        I128 price_x18;             // Price that crossed it
+    };
+
+    // Returns the threshold's id, or 0 for FUNDING / ADL, which have no
+    // price trigger
+    uint64_t add_trigger(uint32_t market_id, TriggerType type, bool is_buy, I128 trigger_price_x18);
+    bool remove_trigger(uint64_t id);
+    size_t trigger_count() const { return trigger_count_.load(std::memory_order_relaxed); }
+
+    // Remove and append to `out` every threshold of (market, type) that
+    // `price_x18` crosses; returns the number fired
+    size_t evaluate_triggers(uint32_t market_id, TriggerType type, I128 price_x18,
+                             std::vector<FiredTrigger>& out);
+
+    // Evaluate every type of a market at the feed's current trigger prices
+    // (last, else mark, for SL/TP; mark for liquidation)
+    size_t evaluate_triggers(uint32_t market_id, std::vector<FiredTrigger>& out);
+
+    // Called with the thresholds fired by each last-trade, premium or
+    // oracle move, outside the feed's locks on the updating thread
+    using TriggerListener = std::function<void(const std::vector<FiredTrigger>& fired)>;
+    void set_trigger_listener(TriggerListener listener);
+
     // =========================================================================
     // Market Registration
     // =========================================================================
@@ -209,6 +288,8 @@ public:
     int32_t register_market(uint32_t market_id, uint64_t asset_id);
     void unregister_market(uint32_t market_id);
     bool market_exists(uint32_t market_id) const;
+    // Markets priced off `asset_id`: the ones an oracle update of it re-marks
+    std::vector<uint32_t> markets_for_asset(uint64_t asset_id) const;
 
     // =========================================================================
     // Statistics
@@ -224,10 +305,58 @@ public:
 private:
     LXOracle& oracle_;
 
-    // Market -> asset mapping
+    // Market -> asset mapping, and back
     std::unordered_map<uint32_t, uint64_t> market_assets_;
+    std::unordered_map<uint64_t, std::vector<uint32_t>> asset_markets_;
     mutable std::shared_mutex market_mutex_;
 
+    uint64_t oracle_subscription_;
+    void on_oracle_update(const LXOracle::PriceChangeEvent& event);
+
+    // Published price table. A full table is replaced by one twice the
+    // size and retired, not freed, since readers may still be copying it.
+    struct PriceTable {
+        explicit PriceTable(size_t capacity)
+            : slots(new SeqLock<PriceRecord>[capacity]), capacity(capacity) {}
+        std::unique_ptr<SeqLock<PriceRecord>[]> slots;
+        size_t capacity;
+    };
+    std::atomic<PriceTable*> price_table_{nullptr};
+    std::atomic<size_t> price_table_size_{0};       // Slots handed out
+    std::vector<std::unique_ptr<PriceTable>> price_tables_;  // Current is back()
+    std::unordered_map<uint32_t, size_t> price_slots_;       // market -> slot
+    std::vector<size_t> free_price_slots_;
+    std::mutex price_table_mutex_;                  // Writers only
+
+    // Recompute and publish a market's record; no-op if unregistered
+    void refresh_price_record(uint32_t market_id);
+
+    // Batch trigger thresholds; types STOP_LOSS, TAKE_PROFIT, LIQUIDATION
+    struct TriggerThreshold {
+        I128 price_x18;
+        uint64_t id;
+    };
+    struct TriggerLists {
+        std::vector<TriggerThreshold> buys;     // Ascending price
+        std::vector<TriggerThreshold> sells;    // Ascending price
+    };
+    static constexpr size_t PRICE_TRIGGER_TYPES = 3;
+    struct TriggerLocation {
+        uint32_t market_id;
+        TriggerType type;
+        bool is_buy;
+        I128 price_x18;
+    };
+    std::unordered_map<uint32_t, std::array<TriggerLists, PRICE_TRIGGER_TYPES>> trigger_lists_;
+    std::unordered_map<uint64_t, TriggerLocation> trigger_index_;
+    mutable std::mutex trigger_mutex_;
+    uint64_t next_trigger_id_ = 1;
+    std::atomic<size_t> trigger_count_{0};
+    TriggerListener trigger_listener_;
+
+    // Evaluate a market and hand what fired to the trigger listener
+    void fire_triggers(uint32_t market_id);
+
     // Configurations
     std::unordered_map<uint32_t, MarkPriceConfig> mark_configs_;
     std::unordered_map<uint32_t, FundingParams> funding_params_;
@@ -245,12 +374,19 @@ private:
         uint64_t last_funding_calc_time;
         uint64_t next_funding_time;
 
-        // Premium history for EWMA
-        std::vector<std::pair<uint64_t, I128>> premium_history;
+        // Time-decayed premium EWMA: weights decay by exp(-dt / tau) with
+        // tau = premium_ewma_window / 2, kept as a decayed sum and weight
+        // as of ewma_time so each sample is O(1)
+        double ewma_sum = 0.0;
+        double ewma_weight = 0.0;
+        uint64_t ewma_time = 0;
+        uint64_t ewma_window = 300;     // Cached MarkPriceConfig::premium_ewma_window
     };
     std::unordered_map<uint32_t, MarketPriceState> price_states_;
     mutable std::shared_mutex price_mutex_;
 
+    PriceListener price_listener_;
+
     // Statistics
     std::atomic<uint64_t> total_price_updates_{0};
     std::atomic<uint64_t> funding_calculations_{0};
@@ -259,9 +395,8 @@ private:
     MarketPriceState* get_price_state(uint32_t market_id);
     const MarketPriceState* get_price_state(uint32_t market_id) const;
 
-    // EWMA calculation
-    I128 calculate_ewma(const std::vector<std::pair<uint64_t, I128>>& history,
-                        uint64_t window_seconds, uint64_t current_time) const;
+    // New price state with the market's cached config; needs config_mutex_
+    MarketPriceState new_price_state(uint32_t market_id) const;
 
     // Funding rate calculation
     // funding_rate = clamp(premium_twap * fraction + interest_rate, -max, +max)
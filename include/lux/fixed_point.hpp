@@ -0,0 +1,122 @@
+#ifndef LUX_FIXED_POINT_HPP
+#define LUX_FIXED_POINT_HPP
+
+#include <cstddef>
+#include <cstdint>
+
+#include "full_math.hpp"
+#include "types.hpp"
+
+namespace lux {
+
+// =============================================================================
+// X18 Kernels
+// =============================================================================
+//
+// Companions to the basic x18 operations in types.hpp, which already divide
+// by X18_ONE through div_one():
+// - compile-time constants, so rates are not rebuilt through from_double on
+//   every fill;
+// - overflow-checked forms, for values that come from outside the engine;
+// - batch forms for columnar pricing loops.
+//
+// Batch forms take plain arrays and have no branches or cross-iteration
+// dependencies. There is no SIMD for 128-bit multiplies, but consecutive
+// elements' reciprocal multiplies overlap in the pipeline.
+namespace x18 {
+
+// Whole basis points (1 bp = 0.01%) and exact ratios, at compile time
+constexpr I128 from_bps(int64_t bps) {
+    return static_cast<I128>(bps) * (X18_ONE / 10000);
+}
+
+constexpr I128 from_ratio(int64_t num, int64_t den) {
+    return static_cast<I128>(num) * X18_ONE / den;
+}
+
+// -----------------------------------------------------------------------------
+// Overflow-checked. mul and div in types.hpp wrap once the 128-bit
+// intermediate overflows, which for two X18 values is a product above about
+// 170; these take the 256-bit path from full_math instead and return false,
+// leaving out untouched, only when the result itself does not fit (or b is
+// 0 for div). The native product is tried first, so in-range operands cost
+// one overflow check over the plain form.
+// -----------------------------------------------------------------------------
+
+// |a| * |b| / |d| into a signed result of the given sign, if it fits
+inline bool wide_mul_div(I128 a, I128 b, I128 d, I128& out) {
+    const U128 ua = full_math::abs_u128(a), ub = full_math::abs_u128(b), ud = full_math::abs_u128(d);
+    const full_math::U256 num = full_math::mul_wide(ua, ub);
+    if (num.hi >= ud) return false;
+    U128 rem;
+    const U128 q = full_math::div_wide(num, ud, rem);
+    const bool neg = (a < 0) ^ (b < 0) ^ (d < 0);
+    if (q > (U128(1) << 127) - (neg ? 0 : 1)) return false;
+    out = neg ? static_cast<I128>(-q) : static_cast<I128>(q);
+    return true;
+}
+
+inline bool checked_add(I128 a, I128 b, I128& out) {
+    I128 sum;
+    if (__builtin_add_overflow(a, b, &sum)) return false;
+    out = sum;
+    return true;
+}
+
+inline bool checked_sub(I128 a, I128 b, I128& out) {
+    I128 diff;
+    if (__builtin_sub_overflow(a, b, &diff)) return false;
+    out = diff;
+    return true;
+}
+
+inline bool checked_mul(I128 a, I128 b, I128& out) {
+    I128 product;
+    if (!__builtin_mul_overflow(a, b, &product)) {
+        out = div_one(product);
+        return true;
+    }
+    return wide_mul_div(a, b, X18_ONE, out);
+}
+
+inline bool checked_div(I128 a, I128 b, I128& out) {
+    if (b == 0) return false;
+    I128 scaled;
+    if (!__builtin_mul_overflow(a, X18_ONE, &scaled) &&
+        !(b == -1 && scaled == static_cast<I128>(U128(1) << 127))) {
+        out = scaled / b;
+        return true;
+    }
+    return wide_mul_div(a, X18_ONE, b, out);
+}
+
+// -----------------------------------------------------------------------------
+// Batch forms; out may alias an input
+// -----------------------------------------------------------------------------
+
+// out[i] = a[i] * b[i]
+inline void mul_batch(const I128* a, const I128* b, I128* out, size_t n) {
+    for (size_t i = 0; i < n; ++i) {
+        out[i] = mul(a[i], b[i]);
+    }
+}
+
+// out[i] = a[i] * s
+inline void mul_batch(const I128* a, I128 s, I128* out, size_t n) {
+    for (size_t i = 0; i < n; ++i) {
+        out[i] = mul(a[i], s);
+    }
+}
+
+// Mark-to-market PnL of a position column: out[i] = size[i] * (mark - entry[i])
+inline void pnl_batch(const I128* size, const I128* entry, I128 mark, I128* out, size_t n) {
+    for (size_t i = 0; i < n; ++i) {
+        out[i] = mul(size[i], mark - entry[i]);
+    }
+}
+
+} // namespace x18
+
+} // namespace lux
+
+#endif // LUX_FIXED_POINT_HPP
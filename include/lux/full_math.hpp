@@ -0,0 +1,164 @@
+#ifndef LUX_FULL_MATH_HPP
+#define LUX_FULL_MATH_HPP
+
+#include <cstdint>
+
+#include "types.hpp"
+
+namespace lux {
+
+// a * b / denom with a 256-bit intermediate, after Uniswap's FullMath, for
+// the pool's Q64.96 / Q128 arithmetic. When the product fits in 128 bits
+// (the common case for X18 amounts) it is one native division. Otherwise
+// the 256-by-128 division runs as two 3-by-2 digit steps in base 2^64
+// (Knuth D), each estimated with one hardware 128-by-64 divide, so no
+// path loops over bits. Quotients are assumed to fit in 128 bits.
+namespace full_math {
+
+struct U256 {
+    U128 lo = 0;
+    U128 hi = 0;
+};
+
+inline U256 mul_wide(U128 a, U128 b) {
+    const U128 a_lo = static_cast<uint64_t>(a), a_hi = a >> 64;
+    const U128 b_lo = static_cast<uint64_t>(b), b_hi = b >> 64;
+
+    const U128 p0 = a_lo * b_lo;
+    const U128 p1 = a_lo * b_hi;
+    const U128 p2 = a_hi * b_lo;
+    const U128 p3 = a_hi * b_hi;
+
+    const U128 mid = (p0 >> 64) + static_cast<uint64_t>(p1) + static_cast<uint64_t>(p2);
+    U256 r;
+    r.lo = (mid << 64) | static_cast<uint64_t>(p0);
+    r.hi = p3 + (p1 >> 64) + (p2 >> 64) + (mid >> 64);
+    return r;
+}
+
+// (hi:lo) / d for hi < d, one divq on x86-64
+inline uint64_t div_128_by_64(uint64_t hi, uint64_t lo, uint64_t d, uint64_t& rem) {
+#if defined(__x86_64__)
+    uint64_t q;
+    __asm__("divq %4" : "=a"(q), "=d"(rem) : "a"(lo), "d"(hi), "r"(d));
+    return q;
+#else
+    const U128 n = (static_cast<U128>(hi) << 64) | lo;
+    rem = static_cast<uint64_t>(n % d);
+    return static_cast<uint64_t>(n / d);
+#endif
+}
+
+// (u2:u1:u0) / v for normalized v (top bit set) and (u2:u1) < v. With a
+// two-digit divisor the v0 correction makes the estimate exact.
+inline uint64_t div_3_by_2(uint64_t u2, uint64_t u1, uint64_t u0, U128 v, U128& rem) {
+    const uint64_t v1 = static_cast<uint64_t>(v >> 64);
+    const uint64_t v0 = static_cast<uint64_t>(v);
+    constexpr U128 BASE = U128(1) << 64;
+
+    uint64_t q;
+    U128 r;
+    if (u2 >= v1) {
+        q = ~uint64_t{0};
+        r = static_cast<U128>(u1) + v1;     // (u2:u1) - q * v1 with u2 == v1
+    } else {
+        uint64_t r64;
+        q = div_128_by_64(u2, u1, v1, r64);
+        r = r64;
+    }
+    while (r < BASE && static_cast<U128>(q) * v0 > ((r << 64) | u0)) {
+        --q;
+        r += v1;
+    }
+    // The remainder is below v, so 128-bit wraparound is exact
+    rem = ((static_cast<U128>(u1) << 64) | u0) - static_cast<U128>(q) * v;
+    return q;
+}
+
+inline int clz128(U128 x) {
+    const uint64_t hi = static_cast<uint64_t>(x >> 64);
+    return hi != 0 ? __builtin_clzll(hi) : 64 + __builtin_clzll(static_cast<uint64_t>(x));
+}
+
+// num / d and num % d; d != 0
+inline U128 div_wide(U256 num, U128 d, U128& rem) {
+    if (num.hi >= d) {
+        num.hi %= d;    // Quotient overflows; keep its low 128 bits
+    }
+
+    if ((d >> 64) == 0) {
+        // One-digit divisor: one or two hardware divides
+        const uint64_t d64 = static_cast<uint64_t>(d);
+        const uint64_t n1 = static_cast<uint64_t>(num.lo >> 64);
+        uint64_t r = static_cast<uint64_t>(num.hi);
+        uint64_t q1 = 0;
+        if (r != 0 || n1 >= d64) {
+            q1 = div_128_by_64(r, n1, d64, r);
+        } else {
+            r = n1;
+        }
+        const uint64_t q0 = div_128_by_64(r, static_cast<uint64_t>(num.lo), d64, r);
+        rem = r;
+        return (static_cast<U128>(q1) << 64) | q0;
+    }
+
+    // Normalize so the divisor's top bit is set; num.hi < d keeps the
+    // shifted numerator within three digits plus one
+    const int s = clz128(d);
+    const U128 v = d << s;
+    const U128 hi = s == 0 ? num.hi : (num.hi << s) | (num.lo >> (128 - s));
+    const U128 lo = num.lo << s;
+
+    U128 r;
+    const uint64_t q1 = div_3_by_2(static_cast<uint64_t>(hi >> 64), static_cast<uint64_t>(hi),
+                                   static_cast<uint64_t>(lo >> 64), v, r);
+    const uint64_t q0 = div_3_by_2(static_cast<uint64_t>(r >> 64), static_cast<uint64_t>(r),
+                                   static_cast<uint64_t>(lo), v, r);
+    rem = r >> s;
+    return (static_cast<U128>(q1) << 64) | q0;
+}
+
+// |a| * |b| / |d| and whether the division left a remainder
+inline U128 mul_div_abs(U128 a, U128 b, U128 d, bool& inexact) {
+    U128 rem;
+    U128 q;
+    U128 product;
+    if (!__builtin_mul_overflow(a, b, &product)) {
+        q = div_wide(U256{product, 0}, d, rem);
+    } else {
+        q = div_wide(mul_wide(a, b), d, rem);
+    }
+    inexact = rem != 0;
+    return q;
+}
+
+inline U128 abs_u128(I128 x) {
+    return x < 0 ? -static_cast<U128>(x) : static_cast<U128>(x);
+}
+
+// a * b / denom, truncated toward zero; 0 if denom is 0
+inline I128 mul_div(I128 a, I128 b, I128 denom) {
+    if (denom == 0) return 0;
+    const bool neg = (a < 0) ^ (b < 0) ^ (denom < 0);
+    bool inexact;
+    const U128 q = mul_div_abs(abs_u128(a), abs_u128(b), abs_u128(denom), inexact);
+    return neg ? -static_cast<I128>(q) : static_cast<I128>(q);
+}
+
+// a * b / denom, positive results rounded up
+inline I128 mul_div_up(I128 a, I128 b, I128 denom) {
+    if (denom == 0) return 0;
+    const bool neg = (a < 0) ^ (b < 0) ^ (denom < 0);
+    bool inexact;
+    U128 q = mul_div_abs(abs_u128(a), abs_u128(b), abs_u128(denom), inexact);
+    if (!neg && inexact) {
+        q += 1;
+    }
+    return neg ? -static_cast<I128>(q) : static_cast<I128>(q);
+}
+
+} // namespace full_math
+
+} // namespace lux
+
+#endif // LUX_FULL_MATH_HPP
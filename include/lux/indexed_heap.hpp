@@ -0,0 +1,137 @@
+#ifndef LUX_INDEXED_HEAP_HPP
+#define LUX_INDEXED_HEAP_HPP
+
+#include <cstddef>
+#include <functional>
+#include <unordered_map>
+#include <utility>
+#include <vector>
+
+namespace lux {
+
+// Binary heap with a key -> slot index, so an entry's priority can be
+// changed or the entry removed in O(log n) without searching for it.
+// The top is the highest priority under Compare, as in
+// std::priority_queue. Not thread-safe.
+template<typename Key, typename Priority, typename Compare = std::less<Priority>>
+class IndexedHeap {
+public:
+    // Insert `key`, or move it to `priority` if already present
+    void set(const Key& key, Priority priority) {
+        auto [it, added] = index_.try_emplace(key, heap_.size());
+        if (added) {
+            heap_.push_back({key, priority});
+            sift_up(heap_.size() - 1);
+            return;
+        }
+        const size_t slot = it->second;
+        const bool raised = less_(heap_[slot].second, priority);
+        heap_[slot].second = priority;
+        if (raised) {
+            sift_up(slot);
+        } else {
+            sift_down(slot);
+        }
+    }
+
+    bool erase(const Key& key) {
+        auto it = index_.find(key);
+        if (it == index_.end()) {
+            return false;
+        }
+        const size_t slot = it->second;
+        index_.erase(it);
+        const size_t last = heap_.size() - 1;
+        if (slot != last) {
+            heap_[slot] = std::move(heap_[last]);
+            index_[heap_[slot].first] = slot;
+            heap_.pop_back();
+            sift_up(slot);
+            sift_down(slot);
+        } else {
+            heap_.pop_back();
+        }
+        return true;
+    }
+
+    bool contains(const Key& key) const { return index_.count(key) != 0; }
+    const Key& top_key() const { return heap_.front().first; }
+    const Priority& top_priority() const { return heap_.front().second; }
+    void pop() { erase(heap_.front().first); }
+
+    size_t size() const { return heap_.size(); }
+    bool empty() const { return heap_.empty(); }
+
+    // Call `fn(key, priority)` for every entry with `keep(priority)` true,
+    // where `keep` holds for a prefix of the priority order (e.g. "at or
+    // above a threshold"). Subtrees whose root fails are skipped, so this
+    // costs O(k) for k matches rather than O(n). Visit order is heap
+    // order, not sorted.
+    template<typename Keep, typename Fn>
+    void visit_while(Keep&& keep, Fn&& fn) const {
+        if (heap_.empty()) {
+            return;
+        }
+        stack_.clear();
+        stack_.push_back(0);
+        while (!stack_.empty()) {
+            const size_t slot = stack_.back();
+            stack_.pop_back();
+            if (!keep(heap_[slot].second)) {
+                continue;
+            }
+            fn(heap_[slot].first, heap_[slot].second);
+            for (size_t child = 2 * slot + 1; child <= 2 * slot + 2 && child < heap_.size(); ++child) {
+                stack_.push_back(child);
+            }
+        }
+    }
+
+private:
+    void place(size_t slot, std::pair<Key, Priority>&& entry) {
+        heap_[slot] = std::move(entry);
+        index_[heap_[slot].first] = slot;
+    }
+
+    void sift_up(size_t slot) {
+        std::pair<Key, Priority> entry = std::move(heap_[slot]);
+        while (slot > 0) {
+            const size_t parent = (slot - 1) / 2;
+            if (!less_(heap_[parent].second, entry.second)) {
+                break;
+            }
+            place(slot, std::move(heap_[parent]));
+            slot = parent;
+        }
+        place(slot, std::move(entry));
+    }
+
+    void sift_down(size_t slot) {
+        std::pair<Key, Priority> entry = std::move(heap_[slot]);
+        const size_t count = heap_.size();
+        while (true) {
+            size_t child = 2 * slot + 1;
+            if (child >= count) {
+                break;
+            }
+            if (child + 1 < count && less_(heap_[child].second, heap_[child + 1].second)) {
+                ++child;
+            }
+            if (!less_(entry.second, heap_[child].second)) {
+                break;
+            }
+            place(slot, std::move(heap_[child]));
+            slot = child;
+        }
+        place(slot, std::move(entry));
+    }
+
+    std::vector<std::pair<Key, Priority>> heap_;
+    std::unordered_map<Key, size_t> index_;  // key -> slot in heap_
+    Compare less_;
+    mutable std::vector<size_t> stack_;      // visit_while() scratch
+};
+
+} // namespace lux
+
+#endif // LUX_INDEXED_HEAP_HPP
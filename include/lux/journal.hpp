@@ -0,0 +1,120 @@
+#ifndef LUX_JOURNAL_HPP
+#define LUX_JOURNAL_HPP
+
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <string>
+#include <type_traits>
+
+#include "order.hpp"
+#include "orderbook.hpp"
+
+namespace lux {
+
+// =============================================================================
+// Write-Ahead Journal
+// =============================================================================
+//
+// Append-only file of fixed-size, sequenced engine inputs, written through
+// a shared memory mapping: append() is a copy into the mapping, with no
+// syscall. Records become durable in groups: commit() publishes the
+// committed count in the file header (and optionally schedules writeback
+// with msync), and readers only see committed records. A crash loses at
+// most the records appended since the last commit.
+
+enum class JournalRecordType : uint8_t {
+    AddSymbol = 1,
+    RemoveSymbol = 2,
+    Place = 3,
+    Cancel = 4,
+    Modify = 5,
+    Reduce = 6,
+    Auction = 7,
+    Mark = 8            // Index price from outside the book; engine replay skips it
+};
+
+struct JournalRecord {
+    uint64_t sequence;
+    JournalRecordType type;
+    uint64_t symbol_id;
+    Order order;                // Place
+    uint64_t order_id;          // Cancel/Modify/Reduce
+    Price new_price;            // Modify; Mark
+    Quantity new_quantity;      // Modify/Reduce
+    OrderBookConfig book;       // AddSymbol
+};
+static_assert(std::is_trivially_copyable_v<JournalRecord>, "journal records are copied raw");
+
+struct JournalConfig {
+    size_t growth_records = 1 << 16;  // File grows by this many records at a time
+    size_t commit_interval = 256;     // Auto-commit after this many appends (0 = manual)
+    bool msync_on_commit = false;     // Schedule writeback (MS_ASYNC) on each commit
+};
+
+// Single-writer journal; callers serialise append()/commit()
+class Journal {
+public:
+    // Opens or creates `path`; appends continue after the last committed
+    // record. Returns nullptr if the file cannot be opened or mapped.
+    static std::unique_ptr<Journal> open(const std::string& path, JournalConfig config = {});
+    ~Journal();
+
+    Journal(const Journal&) = delete;
+    Journal& operator=(const Journal&) = delete;
+
+    // Assigns the next sequence number to `record` and appends it.
+    // Returns the sequence, or 0 if the file could not grow.
+    uint64_t append(JournalRecord record);
+
+    // Make everything appended so far visible to readers
+    void commit();
+
+    uint64_t last_sequence() const { return count_; }
+    uint64_t committed_sequence() const;
+
+private:
+    Journal(int fd, JournalConfig config);
+    bool map(size_t capacity);
+
+    int fd_;
+    JournalConfig config_;
+    void* mapping_{nullptr};
+    size_t mapped_bytes_{0};
+    size_t capacity_{0};        // Records that fit in the mapping
+    uint64_t count_{0};         // Records appended (== last sequence)
+    size_t since_commit_{0};
+};
+
+// Zero-copy view of the committed records of a journal file. A reader
+// can tail a journal another process is writing: refresh() picks up
+// records committed since, remapping if the file has grown.
+class JournalReader {
+public:
+    static std::unique_ptr<JournalReader> open(const std::string& path);
+    ~JournalReader();
+
+    JournalReader(const JournalReader&) = delete;
+    JournalReader& operator=(const JournalReader&) = delete;
+
+    const JournalRecord* begin() const { return records_; }
+    const JournalRecord* end() const { return records_ + count_; }
+    size_t size() const { return count_; }
+
+    // Re-reads the committed count; invalidates pointers into the records
+    // when the file is remapped. Returns size().
+    size_t refresh();
+
+private:
+    JournalReader() = default;
+
+    int fd_{-1};
+    void* mapping_{nullptr};
+    size_t mapped_bytes_{0};
+    const JournalRecord* records_{nullptr};
+    size_t count_{0};
+};
+
+} // namespace lux
+
+#endif // LUX_JOURNAL_HPP
@@ -0,0 +1,77 @@
+#ifndef LUX_LATENCY_HISTOGRAM_HPP
+#define LUX_LATENCY_HISTOGRAM_HPP
+
+#include <array>
+#include <atomic>
+#include <cmath>
+#include <cstddef>
+#include <cstdint>
+
+namespace lux {
+
+// Log2-bucketed latency histogram. Bucket i counts samples in
+// [2^(i-1), 2^i) nanoseconds (bucket 0 holds 0), so 65 buckets cover any
+// uint64_t. record() is a couple of relaxed atomic adds and may be called
+// from any thread; readers see a consistent-enough view for reporting.
+class LatencyHistogram {
+public:
+    static constexpr size_t BUCKETS = 65;
+
+    void record(uint64_t nanos) {
+        buckets_[bucket_of(nanos)].fetch_add(1, std::memory_order_relaxed);
+        count_.fetch_add(1, std::memory_order_relaxed);
+        uint64_t seen = max_.load(std::memory_order_relaxed);
+        while (nanos > seen &&
+               !max_.compare_exchange_weak(seen, nanos, std::memory_order_relaxed)) {
+        }
+    }
+
+    uint64_t count() const { return count_.load(std::memory_order_relaxed); }
+    uint64_t max() const { return max_.load(std::memory_order_relaxed); }
+    uint64_t bucket(size_t i) const { return buckets_[i].load(std::memory_order_relaxed); }
+
+    // Exclusive upper bound of bucket i, in nanoseconds
+    static uint64_t bucket_limit(size_t i) {
+        return i >= 64 ? UINT64_MAX : uint64_t{1} << i;
+    }
+
+    // Upper bound of the bucket holding the q-th quantile (0 < q <= 1);
+    // 0 when empty
+    uint64_t quantile(double q) const {
+        const uint64_t total = count();
+        if (total == 0) {
+            return 0;
+        }
+        uint64_t rank = static_cast<uint64_t>(std::ceil(q * static_cast<double>(total)));
+        rank = rank == 0 ? 1 : rank;
+        uint64_t seen = 0;
+        for (size_t i = 0; i < BUCKETS; ++i) {
+            seen += bucket(i);
+            if (seen >= rank) {
+                return bucket_limit(i);
+            }
+        }
+        return max();
+    }
+
+    void reset() {
+        for (auto& bucket : buckets_) {
+            bucket.store(0, std::memory_order_relaxed);
+        }
+        count_.store(0, std::memory_order_relaxed);
+        max_.store(0, std::memory_order_relaxed);
+    }
+
+private:
+    static size_t bucket_of(uint64_t nanos) {
+        return nanos == 0 ? 0 : 64 - static_cast<size_t>(__builtin_clzll(nanos));
+    }
+
+    std::array<std::atomic<uint64_t>, BUCKETS> buckets_{};
+    std::atomic<uint64_t> count_{0};
+    std::atomic<uint64_t> max_{0};
+};
+
+} // namespace lux
+
+#endif // LUX_LATENCY_HISTOGRAM_HPP
@@ -0,0 +1,111 @@
+#ifndef LUX_LIQUIDATION_HPP
+#define LUX_LIQUIDATION_HPP
+
+// =============================================================================
+// Liquidation Keeper - parallel close-out of under-water accounts
+//
+// A run takes the vault's at-risk set for one market, re-checks every
+// candidate on a task pool (margin and position lookups only lock the
+// candidate's own account shard), and turns each confirmed one into a
+// reduce-only IOC close-out limited to the mark plus a slippage bound.
+// Close-outs go to the book in batches, worst account first; whatever the
+// book cannot fill is handed to auto-deleveraging. The time from the mark
+// update to each close-out reaching the book is recorded in a latency
+// histogram, and orders later than the configured budget are counted.
+// =============================================================================
+
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <mutex>
+#include <vector>
+
+#include "book.hpp"
+#include "latency_histogram.hpp"
+#include "task_pool.hpp"
+#include "vault.hpp"
+
+namespace lux {
+
+struct LiquidationConfig {
+    size_t threads = 0;                       // Pool helpers; 0 = hardware concurrency - 1
+    size_t max_batch = 256;                   // Close-outs per LXBook batch
+    double max_slippage = 0.05;               // IOC limit = mark * (1 +/- this)
+    uint64_t latency_budget_ns = 1000000;     // Mark update -> order bound (1ms)
+};
+
+// Outcome of one keeper run
+struct LiquidationRun {
+    size_t candidates = 0;      // Accounts the risk heaps reported
+    size_t orders = 0;          // Close-outs sent to the book
+    size_t filled = 0;          // Close-outs filled in full
+    size_t late = 0;            // Close-outs sent after the latency budget
+    I128 remainder_x18 = 0;     // Size the book left open, passed to ADL
+};
+
+class LiquidationKeeper {
+public:
+    LiquidationKeeper(LXVault& vault, LXBook& book, const LiquidationConfig& config = {});
+
+    // Non-copyable
+    LiquidationKeeper(const LiquidationKeeper&) = delete;
+    LiquidationKeeper& operator=(const LiquidationKeeper&) = delete;
+
+    // Close out every liquidatable position in `market_id`. The vault's
+    // marks must already reflect `mark_px_x18`; `mark_time_ns` is when
+    // that update happened, on the now_ns() clock. Runs are serialised.
+    LiquidationRun run(uint32_t market_id, I128 mark_px_x18, uint64_t mark_time_ns);
+
+    // Monotonic clock used for latency accounting
+    static uint64_t now_ns();
+
+    // Mark update -> close-out order latency, one sample per order
+    const LatencyHistogram& latency() const { return latency_; }
+
+    struct Stats {
+        uint64_t runs;
+        uint64_t candidates;
+        uint64_t orders;
+        uint64_t filled;
+        uint64_t late;
+        uint64_t adl_runs;      // Runs that left size for ADL
+    };
+    Stats get_stats() const;
+
+    const LiquidationConfig& config() const { return config_; }
+
+private:
+    // A confirmed candidate and its close-out order
+    struct CloseOut {
+        bool active;
+        LXAccount account;
+        LXOrder order;
+    };
+
+    void evaluate(size_t index, uint32_t market_id, I128 mark_px_x18);
+
+    LXVault& vault_;
+    LXBook& book_;
+    LiquidationConfig config_;
+    TaskPool pool_;
+    LatencyHistogram latency_;
+
+    // Run scratch, guarded by run_mutex_
+    std::mutex run_mutex_;
+    std::vector<LXAccount> candidates_;
+    std::vector<CloseOut> plans_;
+    std::vector<LXAccount> senders_;
+    std::vector<LXOrder> orders_;
+    std::vector<LXPlaceResult> results_;
+
+    std::atomic<uint64_t> runs_{0};
+    std::atomic<uint64_t> candidates_seen_{0};
+    std::atomic<uint64_t> orders_sent_{0};
+    std::atomic<uint64_t> filled_{0};
+    std::atomic<uint64_t> late_{0};
+    std::atomic<uint64_t> adl_runs_{0};
+};
+
+} // namespace lux
+
+#endif // LUX_LIQUIDATION_HPP
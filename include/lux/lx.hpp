@@ -28,6 +28,11 @@
 #include "vault.hpp"
 #include "oracle.hpp"
 #include "feed.hpp"
+#include "settlement.hpp"
+#include "liquidation.hpp"
+#include "router.hpp"
+#include "task_pool.hpp"
+#include "latency_histogram.hpp"
 
 namespace lux {
 
@@ -63,6 +68,16 @@ public:
     LXFeed& feed() { return *feed_; }
     const LXFeed& feed() const { return *feed_; }
 
+    LXRouter& router() { return *router_; }
+    const LXRouter& router() const { return *router_; }
+
+    // nullptr unless initialized with async_settlement
+    SettlementPipeline* settlement() { return settlement_.get(); }
+    const SettlementPipeline* settlement() const { return settlement_.get(); }
+
+    // Created on the first run_liquidations() call
+    LiquidationKeeper& keeper();
+
     // =========================================================================
     // Initialization
     // =========================================================================
@@ -78,6 +93,18 @@ public:
         uint64_t funding_interval;
         I128 default_maker_fee_x18;
         I128 default_taker_fee_x18;
+
+        // Settle book fills on a pipeline worker instead of the matching
+        // thread; watch settlement()->settled_sequence() for progress
+        bool async_settlement = false;
+        SettlementConfig settlement;
+
+        // Keeper pool size, close-out batching and latency budget
+        LiquidationConfig liquidation;
+
+        // Slices trade() divides an order into when splitting it between
+        // the book and a linked pool
+        size_t trade_split_parts = 20;
     };
     void initialize(const Config& config);
 
@@ -101,22 +128,34 @@ public:
                                 const MarketConfig& vault_config,
                                 const BookMarketConfig& book_config);
 
+    // Let trade() also fill `market_id` from an initialized pool. The
+    // market's base asset is the pool's currency0 if base_is_currency0,
+    // else currency1; prices are quote per base in both venues.
+    int32_t link_pool(uint32_t market_id, const PoolKey& key, bool base_is_currency0);
+
     // =========================================================================
     // Unified Trading Interface
     // =========================================================================
 
-    // Smart order routing: AMM vs CLOB based on best execution
+    // Exact-input swap routed across AMM pools, split over parallel
+    // multi-hop paths. Nothing is swapped unless the quoted output reaches
+    // min_amount_out_x18; the delta is signed as for a pool swap.
     BalanceDelta swap_smart(const LXAccount& sender, const Currency& token_in,
                             const Currency& token_out, I128 amount_in_x18,
                             I128 min_amount_out_x18);
 
-    // Execute on best venue
+    // Execute on best venue. With a linked pool the order is cut into
+    // slices and each goes to whichever venue is cheaper at the margin
+    // (book levels against the pool's quoted curve); both legs then
+    // execute, the book leg as an IOC limit at the worst level planned.
     struct TradeResult {
         BalanceDelta delta;
         std::vector<Trade> trades;
         bool used_amm;
         bool used_clob;
         I128 effective_price_x18;
+        I128 clob_size_x18;     // Base filled on each venue
+        I128 amm_size_x18;
     };
     TradeResult trade(const LXAccount& sender, uint32_t market_id,
                       bool is_buy, I128 size_x18, I128 limit_price_x18);
@@ -131,7 +170,18 @@ public:
     // Update mark price from feed and accrue funding
     int32_t update_funding(uint32_t market_id);
 
-    // Run liquidation check for all accounts
+    // Funding for every market whose interval has elapsed: the feed
+    // computes all their rates in one pass, then the vault accrues them
+    // with one lock per account shard, shards in parallel. Accrual only
+    // moves the lazy funding index, so the cost is independent of the
+    // position count. Cheap when nothing is due; call it every block.
+    // Returns the markets accrued.
+    size_t run_funding();
+
+    // Mark the market to the feed's mark price and hand every account the
+    // vault reports under water to the liquidation keeper, which sends
+    // IOC close-outs to the book and deleverages what they leave open.
+    // Cost follows the number of such accounts, not the account base.
     int32_t run_liquidations(uint32_t market_id);
 
     // =========================================================================
@@ -148,6 +198,14 @@ public:
     };
     GlobalStats get_stats() const;
 
+    // Allocator usage of the components with arena-backed state
+    struct MemoryReport {
+        MemoryStats book;       // Engine books and LXBook's order index
+        MemoryStats vault;      // LXVault account shards
+        MemoryStats total;
+    };
+    MemoryReport memory_usage() const;
+
     // =========================================================================
     // Version & Info
     // =========================================================================
@@ -180,56 +238,187 @@ private:
     std::unique_ptr<LXVault> vault_;
     std::unique_ptr<LXBook> book_;
     std::unique_ptr<LXFeed> feed_;
+    std::unique_ptr<LXRouter> router_;
+    std::unique_ptr<SettlementPipeline> settlement_;
+    std::unique_ptr<LiquidationKeeper> keeper_;
+    LiquidationConfig liquidation_config_;
+    std::once_flag keeper_once_;
+
+    // Workers for run_funding, started on first use
+    std::unique_ptr<TaskPool> funding_pool_;
+    std::once_flag funding_pool_once_;
+
+    // market_id -> pool trade() may split into
+    struct PoolLink {
+        PoolHandle pool;
+        bool base_is_currency0;
+    };
+    std::unordered_map<uint32_t, PoolLink> pool_links_;
+    mutable std::shared_mutex links_mutex_;
+    size_t trade_split_parts_{20};
 
     std::atomic<bool> running_{false};
     uint64_t start_time_{0};
 
     // Internal settlement callback
     int32_t on_book_trades(const std::vector<Trade>& trades);
+
+    // Base size each venue takes, and the book leg's limit
+    struct VenueSplit {
+        I128 clob_size_x18;
+        I128 clob_limit_x18;
+        I128 amm_size_x18;
+    };
+    VenueSplit plan_split(uint32_t market_id, const PoolLink& link, bool is_buy,
+                          I128 size_x18, I128 limit_price_x18) const;
+
+    // Pool swap for `size_x18` of base: exact output when buying, exact input when selling
+    static SwapParams amm_params(const PoolLink& link, bool is_buy, I128 size_x18,
+                                 I128 limit_price_x18);
 };
 
 // =============================================================================
 // Precompile Router
 // =============================================================================
 
+// One precompile call in a block
+struct BlockTx {
+    Address precompile;
+    std::vector<uint8_t> calldata;
+};
+
+// Measured cost of one (precompile, selector)
+struct SelectorStats {
+    uint16_t lp;
+    uint32_t selector;
+    bool view;
+    uint64_t calls;
+    uint64_t total_nanos;
+    uint64_t p50_nanos;         // Bucket upper bounds, see LatencyHistogram
+    uint64_t p99_nanos;
+    uint64_t max_nanos;
+    uint64_t output_bytes;
+    uint64_t gas;               // What gas_cost charges now
+};
+
+struct BlockResult {
+    std::vector<std::vector<uint8_t>> outputs;  // Per transaction, in block order
+    size_t groups = 0;      // Independent groups run in parallel
+    size_t barriers = 0;    // Transactions that ran alone
+};
+
 class PrecompileRouter {
 public:
+    // Largest result any handler writes
+    static constexpr size_t MAX_OUTPUT = 320;
+
     explicit PrecompileRouter(LX& dex);
 
     // Route call to appropriate precompile based on address
     std::vector<uint8_t> call(const Address& precompile,
                                const std::vector<uint8_t>& calldata);
 
-    // Static call (read-only)
+    // Allocation-free call: writes the result into `out`, which must hold
+    // MAX_OUTPUT bytes, and returns its length (0 = no result)
+    size_t call(const Address& precompile, const uint8_t* calldata, size_t len, uint8_t* out);
+
+    // Static call (read-only): only view handlers run, and they touch LX
+    // through const interfaces, so static calls may run concurrently with
+    // each other and with block execution. Other selectors return nothing.
     std::vector<uint8_t> static_call(const Address& precompile,
                                       const std::vector<uint8_t>& calldata) const;
+    size_t static_call(const Address& precompile, const uint8_t* calldata, size_t len,
+                       uint8_t* out) const;
+
+    // True if the selector is registered as a view
+    bool is_view(const Address& precompile, uint32_t selector) const;
+
+    // Execute a block of calls. Each call's read and write set is derived
+    // from its calldata (pool, market, account, oracle asset); calls whose
+    // sets conflict keep block order within one group, and independent
+    // groups run on a worker pool. Calls whose footprint is not known up
+    // front (book execute, liquidations, hooked pools) run alone between
+    // the groups. Outputs equal running the block sequentially.
+    BlockResult execute_block(const std::vector<BlockTx>& txs);
 
     // Check if address is a known precompile
     bool is_precompile(const Address& addr) const;
 
-    // Get precompile gas cost
+    // Get precompile gas cost: the calibrated figure for the selector if
+    // calibrate_gas set one, else the static table
     uint64_t gas_cost(const Address& precompile,
                        const std::vector<uint8_t>& calldata) const;
 
+    // Per-selector profiling. While enabled, every call and static call
+    // records its latency and output size; off, dispatch pays one relaxed
+    // load. Reads may run alongside calls.
+    void set_profiling(bool enabled) { profiling_.store(enabled, std::memory_order_relaxed); }
+    bool profiling() const { return profiling_.load(std::memory_order_relaxed); }
+    std::vector<SelectorStats> profile() const;
+    void reset_profile();
+
+    // Turn the profile into gas: a selector with at least min_calls
+    // samples costs max(min_gas, mean nanoseconds * gas_per_nano) from now
+    // on. Returns how many selectors were calibrated.
+    size_t calibrate_gas(double gas_per_nano, uint64_t min_gas, uint64_t min_calls = 100);
+
+    size_t handler_count() const { return entries_.size(); }
+
 private:
     LX& dex_;
 
-    // Method selector -> handler mapping for each precompile
-    using Handler = std::function<std::vector<uint8_t>(const std::vector<uint8_t>&)>;
-    std::unordered_map<uint64_t, std::unordered_map<uint32_t, Handler>> handlers_;
+    // Handlers decode the arguments after the selector and write their
+    // ABI-encoded result into the caller's buffer
+    using Handler = size_t (*)(LX& dex, const uint8_t* args, size_t len, uint8_t* out);
+    using ViewHandler = size_t (*)(const LX& dex, const uint8_t* args, size_t len, uint8_t* out);
+
+    // Exactly one of handler and view is set
+    struct DispatchEntry {
+        uint64_t key = 0;           // LP number << 32 | selector; 0 = empty
+        Handler handler = nullptr;
+        ViewHandler view = nullptr;
+        uint32_t index = 0;         // Into profiles_
+    };
+
+    struct SelectorProfile {
+        LatencyHistogram latency;
+        std::atomic<uint64_t> total_nanos{0};
+        std::atomic<uint64_t> output_bytes{0};
+        std::atomic<uint64_t> gas{0};   // Calibrated; 0 = static table
+    };
+
+    // (precompile, selector) -> handler, perfectly hashed at construction
+    std::vector<DispatchEntry> entries_;
+    std::vector<DispatchEntry> table_;
+    uint64_t hash_mul_ = 0;
+    unsigned hash_shift_ = 63;
+
+    std::unique_ptr<SelectorProfile[]> profiles_;   // Parallel to entries_
+    std::atomic<bool> profiling_{false};
+
+    size_t dispatch(const DispatchEntry& entry, const uint8_t* args, size_t len,
+                    uint8_t* out) const;
+    uint64_t static_gas_cost(uint16_t lp, uint32_t selector) const;
+
+    static uint64_t dispatch_key(uint64_t lp, uint32_t selector) {
+        return (lp << 32) | selector;
+    }
+
+    // Workers for execute_block, started on first use
+    std::unique_ptr<TaskPool> block_pool_;
+    std::once_flag block_pool_once_;
+
+    void add(uint64_t lp, uint32_t selector, Handler handler);
+    void add_view(uint64_t lp, uint32_t selector, ViewHandler view);
+    void build_dispatch();
+    const DispatchEntry* find(const Address& precompile, const uint8_t* calldata,
+                              size_t len) const;
 
     void register_pool_handlers();
     void register_book_handlers();
     void register_vault_handlers();
     void register_oracle_handlers();
     void register_feed_handlers();
-
-    // ABI encoding/decoding helpers
-    template<typename T>
-    static T decode(const std::vector<uint8_t>& data, size_t offset = 0);
-
-    template<typename... Args>
-    static std::vector<uint8_t> encode(const Args&... args);
 };
 
 // =============================================================================
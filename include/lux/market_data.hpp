@@ -0,0 +1,185 @@
+#ifndef LUX_MARKET_DATA_HPP
+#define LUX_MARKET_DATA_HPP
+
+#include <atomic>
+#include <chrono>
+#include <condition_variable>
+#include <cstddef>
+#include <cstdint>
+#include <functional>
+#include <map>
+#include <memory>
+#include <mutex>
+#include <optional>
+#include <string>
+#include <thread>
+#include <type_traits>
+#include <unordered_map>
+#include <vector>
+
+#include "feed.hpp"
+#include "orderbook.hpp"
+#include "trade.hpp"
+
+namespace lux {
+
+// =============================================================================
+// Conflated Market Data
+// =============================================================================
+//
+// One publisher, any number of subscribers, and the work done once. The
+// publisher folds book deltas, trades and feed prices into per-market
+// state (L1/L2 from the deltas, last trade and volume, index/mark/last
+// prices), then encodes each changed market once into its slot of a
+// shared file mapping, e.g. under /dev/shm. Subscribers, in this process
+// or others, map the file and read whichever markets they want whenever
+// they like.
+//
+// A slot only ever holds a market's latest state: a subscriber that reads
+// less often than the publisher writes sees conflated updates (the version
+// jumps), never a queue, so slow subscribers cost the publisher nothing.
+// Each slot is a seqlock like the event ring's, so readers never block the
+// publisher and never take a syscall. Where every event is needed, use
+// the event ring instead.
+//
+// Publication is on change (each callback republishes what it touched) or
+// on a cadence, where a publisher thread writes the markets changed since
+// its last pass, so a burst of deltas costs one encode per market.
+
+constexpr size_t MARKET_DATA_LEVELS = 10;
+
+struct MarketDataLevel {
+    int64_t price;
+    int64_t quantity;
+    uint32_t order_count;
+    uint32_t reserved;
+};
+
+// One market's state as published; plain fixed-width fields, copied raw
+struct MarketSnapshot {
+    uint64_t symbol_id;
+    uint64_t version;               // Publications of this market, from 1
+    uint64_t book_sequence;         // Last BookDelta folded in
+    int64_t publish_time_ns;
+    uint32_t bid_count;             // Levels set in bids/asks, best first
+    uint32_t ask_count;
+    MarketDataLevel bids[MARKET_DATA_LEVELS];
+    MarketDataLevel asks[MARKET_DATA_LEVELS];
+    int64_t last_trade_price;
+    int64_t last_trade_quantity;
+    int64_t volume;                 // Since the publisher started
+    uint64_t trade_count;
+    I128 index_x18;                 // Feed prices; 0 until first seen
+    I128 mark_x18;
+    I128 last_x18;
+    I128 oracle_x18;
+};
+static_assert(std::is_trivially_copyable_v<MarketSnapshot>, "snapshots are copied raw");
+
+struct MarketDataConfig {
+    size_t max_markets = 1024;              // Slots; markets beyond are tracked, not published
+    size_t levels = MARKET_DATA_LEVELS;     // Depth per side, at most MARKET_DATA_LEVELS
+    std::chrono::microseconds interval{0};  // Publisher cadence; 0 = on every change
+};
+
+// Feeds the conflated table from an engine's trade and book update
+// callbacks and from LXFeed prices (on_price). Callbacks may arrive from
+// several threads; state is guarded by a mutex the subscribers never
+// take. Trade callbacks are forwarded to `next` afterwards.
+class MarketDataPublisher : public TradeListener, public BookUpdateListener {
+public:
+    // Creates `path` afresh (see EventRing::create). Returns nullptr if the
+    // file cannot be created or mapped.
+    static std::unique_ptr<MarketDataPublisher> create(const std::string& path,
+                                                       MarketDataConfig config = {});
+    ~MarketDataPublisher() override;
+
+    MarketDataPublisher(const MarketDataPublisher&) = delete;
+    MarketDataPublisher& operator=(const MarketDataPublisher&) = delete;
+
+    void set_next(TradeListener* next) { next_ = next; }
+
+    void on_trade(const Trade& trade) override;
+    void on_trade_batch(const Trade* trades, size_t count) override;
+    void on_order_filled(const Order& order) override;
+    void on_order_partially_filled(const Order& order, Quantity fill_qty) override;
+    void on_order_cancelled(const Order& order) override;
+    void on_book_delta(uint64_t symbol_id, const BookDelta& delta) override;
+
+    // A feed price for a market (keyed like the book's symbol id)
+    void on_price(uint64_t symbol_id, PriceType type, I128 price_x18);
+
+    // Publishes every market changed since the last publication now
+    void flush();
+
+    struct Stats {
+        uint64_t updates;           // Deltas, trades and prices folded in
+        uint64_t publications;      // Snapshots encoded
+        uint64_t unpublished;       // Markets without a slot
+    };
+    Stats get_stats() const;
+    const std::string& path() const { return path_; }
+
+private:
+    struct Market {
+        MarketSnapshot snapshot{};          // Everything but the ladders
+        std::map<Price, MarketDataLevel, std::greater<Price>> bids;
+        std::map<Price, MarketDataLevel> asks;
+        size_t slot = SIZE_MAX;             // SIZE_MAX: table full
+        bool dirty = false;
+    };
+
+    MarketDataPublisher(std::string path, void* mapping, size_t bytes, MarketDataConfig config);
+    Market& market(uint64_t symbol_id);
+    void touch(Market& market);
+    void publish(Market& market);
+    void run();
+
+    std::string path_;
+    void* mapping_;
+    size_t mapped_bytes_;
+    MarketDataConfig config_;
+    TradeListener* next_{nullptr};
+
+    mutable std::mutex mutex_;
+    std::unordered_map<uint64_t, Market> markets_;
+    std::vector<Market*> dirty_;
+    size_t slots_used_{0};
+    Stats stats_{};
+
+    std::condition_variable cv_;
+    bool running_{true};
+    std::thread thread_;
+};
+
+// Read-only view of a table created by another thread or process
+class MarketDataReader {
+public:
+    static std::unique_ptr<MarketDataReader> open(const std::string& path);
+    ~MarketDataReader();
+
+    MarketDataReader(const MarketDataReader&) = delete;
+    MarketDataReader& operator=(const MarketDataReader&) = delete;
+
+    // Slot of a market, or nullopt if it has not been published yet.
+    // Slots never move, so look a market up once and read by slot.
+    std::optional<size_t> find(uint64_t symbol_id) const;
+    size_t markets() const;     // Slots in use
+
+    // Latest publication in a slot; false if the slot is unused or the
+    // publisher kept rewriting it while we tried
+    bool read(size_t slot, MarketSnapshot& out) const;
+    bool read_symbol(uint64_t symbol_id, MarketSnapshot& out) const;
+
+private:
+    MarketDataReader(void* mapping, size_t bytes, size_t capacity)
+        : mapping_(mapping), mapped_bytes_(bytes), capacity_(capacity) {}
+
+    void* mapping_;
+    size_t mapped_bytes_;
+    size_t capacity_;
+};
+
+} // namespace lux
+
+#endif // LUX_MARKET_DATA_HPP
@@ -0,0 +1,134 @@
+#ifndef LUX_MEMORY_HPP
+#define LUX_MEMORY_HPP
+
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <memory_resource>
+
+namespace lux {
+
+// =============================================================================
+// Arenas
+// =============================================================================
+//
+// Long-lived state (a book's order index, LXBook's account index, LXVault's
+// accounts) lives in std::pmr containers drawing on a PoolArena owned by the
+// component or, for sharded components, by each shard. A pool hands out
+// nodes from size-class free lists and only goes to the system for whole
+// chunks, so inserts and erases under one shard's lock never contend on the
+// global allocator with other shards, and freed nodes are reused in place
+// instead of fragmenting the heap. A PoolArena is unsynchronized: the owner
+// serializes allocations, as it already does for writes to its containers.
+//
+// Transient per-batch scratch goes to a BatchArena: bump allocation from a
+// reusable buffer, all released at once by reset().
+
+struct MemoryStats {
+    size_t bytes_in_use = 0;        // Held by live objects
+    size_t bytes_reserved = 0;      // Taken from the system, including pool slack
+    uint64_t allocations = 0;       // System allocations made
+
+    MemoryStats& operator+=(const MemoryStats& other) {
+        bytes_in_use += other.bytes_in_use;
+        bytes_reserved += other.bytes_reserved;
+        allocations += other.allocations;
+        return *this;
+    }
+};
+
+// Forwards to an upstream resource, counting what passes through. The
+// counters are relaxed atomics so another thread can report them while the
+// owner allocates.
+class CountingResource final : public std::pmr::memory_resource {
+public:
+    explicit CountingResource(std::pmr::memory_resource* upstream = std::pmr::new_delete_resource())
+        : upstream_(upstream) {}
+
+    size_t bytes() const { return bytes_.load(std::memory_order_relaxed); }
+    uint64_t allocations() const { return allocations_.load(std::memory_order_relaxed); }
+
+private:
+    void* do_allocate(size_t bytes, size_t alignment) override {
+        void* p = upstream_->allocate(bytes, alignment);
+        bytes_.store(this->bytes() + bytes, std::memory_order_relaxed);
+        allocations_.store(allocations() + 1, std::memory_order_relaxed);
+        return p;
+    }
+
+    void do_deallocate(void* p, size_t bytes, size_t alignment) override {
+        upstream_->deallocate(p, bytes, alignment);
+        bytes_.store(this->bytes() - bytes, std::memory_order_relaxed);
+    }
+
+    bool do_is_equal(const std::pmr::memory_resource& other) const noexcept override {
+        return this == &other;
+    }
+
+    std::pmr::memory_resource* upstream_;
+    std::atomic<size_t> bytes_{0};
+    std::atomic<uint64_t> allocations_{0};
+};
+
+// Pooled allocator for long-lived node-based state. Not copyable or
+// movable: containers keep a pointer to resource().
+class PoolArena {
+public:
+    explicit PoolArena(std::pmr::memory_resource* upstream = std::pmr::new_delete_resource())
+        : system_(upstream), pool_(pool_options(), &system_), front_(&pool_) {}
+    PoolArena(const PoolArena&) = delete;
+    PoolArena& operator=(const PoolArena&) = delete;
+
+    std::pmr::memory_resource* resource() { return &front_; }
+
+    MemoryStats stats() const {
+        return {front_.bytes(), system_.bytes(), system_.allocations()};
+    }
+
+private:
+    static std::pmr::pool_options pool_options() {
+        std::pmr::pool_options options;
+        options.max_blocks_per_chunk = 1024;
+        options.largest_required_pool_block = 512;   // Hash buckets above this go upstream
+        return options;
+    }
+
+    CountingResource system_;                       // What the pool takes from the heap
+    std::pmr::unsynchronized_pool_resource pool_;
+    CountingResource front_;                        // What containers hold
+};
+
+// Monotonic scratch for one batch. Allocations bump a pointer through an
+// initial buffer, then through chunks from the heap; reset() frees it all
+// and keeps the initial buffer for the next batch.
+class BatchArena {
+public:
+    static constexpr size_t DEFAULT_CAPACITY = 64 * 1024;
+
+    explicit BatchArena(size_t capacity = DEFAULT_CAPACITY)
+        : buffer_(std::make_unique<std::byte[]>(capacity)), capacity_(capacity),
+          arena_(buffer_.get(), capacity_, &system_), front_(&arena_) {}
+    BatchArena(const BatchArena&) = delete;
+    BatchArena& operator=(const BatchArena&) = delete;
+
+    std::pmr::memory_resource* resource() { return &front_; }
+
+    // Containers using the arena must be gone by now
+    void reset() { arena_.release(); }
+
+    MemoryStats stats() const {
+        return {front_.bytes(), capacity_ + system_.bytes(), system_.allocations()};
+    }
+
+private:
+    std::unique_ptr<std::byte[]> buffer_;
+    size_t capacity_;
+    CountingResource system_;                       // Chunks past the initial buffer
+    std::pmr::monotonic_buffer_resource arena_;
+    CountingResource front_;
+};
+
+} // namespace lux
+
+#endif // LUX_MEMORY_HPP
@@ -0,0 +1,126 @@
+#ifndef LUX_MPSC_RING_HPP
+#define LUX_MPSC_RING_HPP
+
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <utility>
+
+#include "spsc_ring.hpp"  // CACHE_LINE_SIZE
+
+namespace lux {
+
+// Bounded lock-free multi-producer/single-consumer ring.
+// Producers claim a position with a CAS on the tail; each slot carries a
+// sequence that tells the consumer when its value is published and tells
+// producers when the slot has been freed. Items are consumed in position
+// order. Capacity is rounded up to a power of two.
+template<typename T>
+class MpscRing {
+public:
+    explicit MpscRing(size_t capacity)
+        : capacity_(round_up_pow2(capacity)), mask_(capacity_ - 1),
+          slots_(new Slot[capacity_]) {
+        for (size_t i = 0; i < capacity_; ++i) {
+            slots_[i].sequence.store(i, std::memory_order_relaxed);
+        }
+    }
+
+    MpscRing(const MpscRing&) = delete;
+    MpscRing& operator=(const MpscRing&) = delete;
+
+    // Producer side, any thread; returns false if the ring is full.
+    // On success `position` (if given) receives the item's position.
+    template<typename U>
+    bool try_push(U&& value, uint64_t* position = nullptr) {
+        size_t pos = tail_.load(std::memory_order_relaxed);
+        Slot* slot;
+        while (true) {
+            slot = &slots_[pos & mask_];
+            const size_t seq = slot->sequence.load(std::memory_order_acquire);
+            const intptr_t diff = static_cast<intptr_t>(seq) - static_cast<intptr_t>(pos);
+            if (diff == 0) {
+                if (tail_.compare_exchange_weak(pos, pos + 1, std::memory_order_relaxed)) {
+                    break;
+                }
+            } else if (diff < 0) {
+                return false;  // Slot still holds an unconsumed item
+            } else {
+                pos = tail_.load(std::memory_order_relaxed);
+            }
+        }
+        slot->value = std::forward<U>(value);
+        slot->sequence.store(pos + 1, std::memory_order_release);
+        if (position) {
+            *position = pos;
+        }
+        return true;
+    }
+
+    // Consumer side; returns false if the next item is not yet published
+    bool try_pop(T& out) {
+        const size_t head = head_.load(std::memory_order_relaxed);
+        Slot& slot = slots_[head & mask_];
+        if (slot.sequence.load(std::memory_order_acquire) != head + 1) {
+            return false;
+        }
+        out = std::move(slot.value);
+        slot.sequence.store(head + capacity_, std::memory_order_release);
+        head_.store(head + 1, std::memory_order_release);
+        return true;
+    }
+
+    // Consumer side; pops up to `max` consecutive published items into
+    // `out`, returns the count
+    template<typename OutputIt>
+    size_t pop_bulk(OutputIt out, size_t max) {
+        const size_t head = head_.load(std::memory_order_relaxed);
+        size_t count = 0;
+        while (count < max) {
+            Slot& slot = slots_[(head + count) & mask_];
+            if (slot.sequence.load(std::memory_order_acquire) != head + count + 1) {
+                break;
+            }
+            *out++ = std::move(slot.value);
+            slot.sequence.store(head + count + capacity_, std::memory_order_release);
+            ++count;
+        }
+        head_.store(head + count, std::memory_order_release);
+        return count;
+    }
+
+    // Positions claimed by producers / consumed so far
+    uint64_t claimed() const { return tail_.load(std::memory_order_acquire); }
+    uint64_t consumed() const { return head_.load(std::memory_order_acquire); }
+
+    size_t size_approx() const { return claimed() - consumed(); }
+    bool empty_approx() const { return size_approx() == 0; }
+    size_t capacity() const { return capacity_; }
+
+private:
+    struct Slot {
+        std::atomic<size_t> sequence;
+        T value;
+    };
+
+    static size_t round_up_pow2(size_t n) {
+        size_t p = 2;
+        while (p < n) p <<= 1;
+        return p;
+    }
+
+    const size_t capacity_;
+    const size_t mask_;
+    std::unique_ptr<Slot[]> slots_;
+
+    // Consumer-owned line
+    alignas(CACHE_LINE_SIZE) std::atomic<size_t> head_{0};
+
+    // Producer-shared line
+    alignas(CACHE_LINE_SIZE) std::atomic<size_t> tail_{0};
+};
+
+} // namespace lux
+
+#endif // LUX_MPSC_RING_HPP
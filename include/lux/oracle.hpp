@@ -2,12 +2,16 @@
 #define LUX_ORACLE_HPP
 
 #include <map>
+#include <memory>
 #include <unordered_map>
 #include <shared_mutex>
+#include <mutex>
+#include <atomic>
 #include <optional>
 #include <vector>
 #include <algorithm>
 #include <cmath>
+#include <functional>
 
 #include "types.hpp"
 
@@ -101,6 +105,11 @@ public:
     // Batch update multiple prices
     int32_t update_prices(const std::vector<std::tuple<uint64_t, PriceSource, I128, I128>>& updates);
 
+    // Batch of full source records, as fetched by an IOracleSource; keeps
+    // each record's timestamp (0 = now). Invalid or non-positive prices
+    // are skipped.
+    int32_t update_prices(const std::vector<std::pair<uint64_t, SourcePriceData>>& updates);
+
     // =========================================================================
     // Price Queries
     // =========================================================================
@@ -108,7 +117,8 @@ public:
     // Get latest aggregated price
     std::optional<I128> get_price(uint64_t asset_id) const;
 
-    // Get price with full data
+    // Get price with full data. Aggregates are kept per asset and rebuilt
+    // when a source changes, so reads are a lookup.
     std::optional<AggregatedPriceData> get_price_data(uint64_t asset_id) const;
 
     // Get prices for multiple assets
@@ -120,6 +130,30 @@ public:
     // Get all source prices for an asset
     std::vector<SourcePriceData> get_all_source_prices(uint64_t asset_id) const;
 
+    // =========================================================================
+    // Change Subscriptions
+    // =========================================================================
+
+    // Emitted once per asset for every update or batch that touched it,
+    // after the new aggregates are published. version counts the asset's
+    // updates, so a subscriber can skip work it already did.
+    struct PriceChangeEvent {
+        uint64_t asset_id;
+        uint64_t version;
+        std::optional<I128> price_x18;      // Aggregated price, if configured
+        std::optional<I128> index_x18;      // Robust index price
+    };
+    using PriceChangeListener = std::function<void(const PriceChangeEvent&)>;
+
+    // Listeners run on the updating thread, outside the oracle's locks.
+    // The subscriber list is an immutable snapshot, so firing events takes
+    // no lock; unsubscribe() does not wait for a call already under way.
+    uint64_t subscribe(PriceChangeListener listener);
+    void unsubscribe(uint64_t subscription);
+
+    // Updates applied to an asset so far; 0 if it has none
+    uint64_t price_version(uint64_t asset_id) const;
+
     // =========================================================================
     // Index Price (Robust Construction)
     // =========================================================================
@@ -143,10 +177,12 @@ public:
     // TWAP Interface
     // =========================================================================
 
-    // Get TWAP over window
+    // Get TWAP over window: each recorded price holds until the next one.
+    // The window is clipped to the retained history; O(log n).
     std::optional<I128> get_twap(uint64_t asset_id, uint64_t window_seconds) const;
 
-    // Record price for TWAP calculation
+    // Record price for TWAP calculation; O(1). Timestamps earlier than the
+    // last recorded one count as that one. 24 hours are retained.
     void record_twap_price(uint64_t asset_id, I128 price_x18, uint64_t timestamp);
 
     // =========================================================================
@@ -174,12 +210,89 @@ private:
     std::unordered_map<uint64_t, RobustParams> robust_params_;
     mutable std::shared_mutex config_mutex_;
 
-    // Price data: asset_id -> source -> price_data
-    std::unordered_map<uint64_t, std::unordered_map<uint8_t, SourcePriceData>> prices_;
+    // Aggregates of one asset's sources, built when a source changes and
+    // reused until a source goes stale (or becomes current), a new price
+    // arrives, or the configuration changes
+    struct AggregateCache {
+        uint64_t version;           // AssetPrices::version it was built from
+        uint64_t config_generation;
+        uint64_t computed_at;
+        uint64_t expires_at;
+        std::optional<AggregatedPriceData> price;   // nullopt if unconfigured
+        std::optional<IndexPriceDetail> index;
+    };
+
+    // One asset's sources, at most one entry each, kept sorted by price.
+    // Writers of one asset serialize on its mutex; the aggregates are
+    // published RCU-style, so cached reads take no lock at all.
+    struct AssetPrices {
+        std::mutex mutex;
+        uint64_t version = 0;       // Bumped by every update
+        std::vector<SourcePriceData> by_price;
+        std::shared_ptr<const AggregateCache> cache;    // atomic_load / atomic_store
+    };
+
+    // What building the aggregates needs from the configuration
+    struct AggregateInputs {
+        bool configured = false;
+        uint64_t max_staleness = 60;
+        AggregationMethod method = AggregationMethod::MEDIAN;
+        std::vector<std::pair<PriceSource, I128>> weights;
+        RobustParams params;
+        uint64_t generation = 0;
+    };
+
+    // Price data: asset_id -> sources. Slots are never removed, so the map
+    // lock is only held to find one, or exclusively to add a new asset.
+    std::unordered_map<uint64_t, std::unique_ptr<AssetPrices>> prices_;
     mutable std::shared_mutex prices_mutex_;
+    std::atomic<uint64_t> config_generation_{0};   // Bumped by every config change
+
+    AggregateInputs aggregate_inputs(uint64_t asset_id) const;   // Takes config_mutex_
+    AssetPrices* find_asset(uint64_t asset_id) const;   // nullptr if no prices yet
+    AssetPrices& asset_slot(uint64_t asset_id);
+    std::shared_ptr<const AggregateCache> build_aggregates(const AssetPrices& asset,
+                                                           const AggregateInputs& inputs,
+                                                           uint64_t now) const;
+    // Cached aggregates, rebuilt first if out of date; nullptr if no prices
+    std::shared_ptr<const AggregateCache> aggregates(uint64_t asset_id) const;
+    static void set_source_price(AssetPrices& asset, const SourcePriceData& data);
+
+    // Subscribers, copied on write and published with atomic_store
+    using Subscribers = std::vector<std::pair<uint64_t, PriceChangeListener>>;
+    std::shared_ptr<const Subscribers> subscribers_;
+    std::mutex subscribe_mutex_;            // Serializes writers only
+    uint64_t next_subscription_ = 1;
+
+    void notify(uint64_t asset_id, const AggregateCache& cache) const;
+
+    // Price-time accumulator, after Uniswap's oracle observations: each
+    // entry carries the running sum of price * seconds up to its timestamp,
+    // so a TWAP is two binary searches and a subtraction. Sums wrap modulo
+    // 2^128; differences over the retained 24h stay exact.
+    struct TwapObservation {
+        uint64_t timestamp;
+        I128 price_x18;
+        U128 cumulative;        // Sum of price * seconds before timestamp
+    };
+    struct TwapRing {
+        std::vector<TwapObservation> buffer;  // Power-of-two size
+        size_t head = 0;        // Oldest
+        size_t count = 0;
+
+        const TwapObservation& at(size_t i) const { return buffer[(head + i) & (buffer.size() - 1)]; }
+        void push(uint64_t timestamp, I128 price_x18, uint64_t retain_seconds);
+        // Sum of price * seconds up to t; t must not precede the oldest entry
+        U128 cumulative_at(uint64_t t) const;
+    };
+
+    struct AssetTwap {
+        mutable std::shared_mutex mutex;
+        TwapRing ring;
+    };
 
-    // TWAP data: asset_id -> [(timestamp, price)]
-    std::unordered_map<uint64_t, std::vector<std::pair<uint64_t, I128>>> twap_data_;
+    // TWAP data: asset_id -> observations; the map lock guards lookup only
+    std::unordered_map<uint64_t, std::unique_ptr<AssetTwap>> twap_data_;
     mutable std::shared_mutex twap_mutex_;
 
     // Statistics
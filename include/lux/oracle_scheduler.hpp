@@ -0,0 +1,115 @@
+#ifndef LUX_ORACLE_SCHEDULER_HPP
+#define LUX_ORACLE_SCHEDULER_HPP
+
+// =============================================================================
+// OracleScheduler - concurrent polling of IOracleSource adapters
+//
+// Every source gets its own poller thread and cadence and fetches all of
+// its assets with one fetch_prices call, so a slow or hung source only
+// holds up itself. Results land in a shared pending batch; a collector
+// thread hands that batch to LXOracle::update_prices once per tick, so the
+// oracle sees one batch per tick however many sources reported. A fetch
+// that runs past its source's timeout is dropped as late, and the source
+// is not polled again until it returns.
+// =============================================================================
+
+#include <atomic>
+#include <chrono>
+#include <condition_variable>
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <mutex>
+#include <thread>
+#include <utility>
+#include <vector>
+
+#include "latency_histogram.hpp"
+#include "oracle.hpp"
+
+namespace lux {
+
+struct OracleSchedulerConfig {
+    uint64_t tick_ms = 100;     // Collector cadence: one update_prices per tick
+};
+
+struct SourceSchedule {
+    std::vector<uint64_t> asset_ids;
+    uint64_t interval_ms = 1000;    // Time between poll starts
+    uint64_t timeout_ms = 500;      // Results of slower fetches are dropped
+};
+
+class OracleScheduler {
+public:
+    explicit OracleScheduler(LXOracle& oracle, const OracleSchedulerConfig& config = {});
+    ~OracleScheduler();
+
+    // Non-copyable
+    OracleScheduler(const OracleScheduler&) = delete;
+    OracleScheduler& operator=(const OracleScheduler&) = delete;
+
+    // Register a source before start(); the source must outlive the
+    // scheduler. Returns its index in get_stats().
+    size_t add_source(IOracleSource& source, const SourceSchedule& schedule);
+
+    // Lifecycle; stop() waits for in-flight fetches and flushes what they
+    // delivered in time
+    void start();
+    void stop();
+    bool is_running() const { return running_.load(std::memory_order_acquire); }
+
+    // Hand everything fetched so far to the oracle as one batch; the
+    // collector calls this every tick. Returns the prices applied.
+    size_t flush();
+
+    struct SourceStats {
+        PriceSource source;
+        uint64_t polls;             // fetch_prices calls
+        uint64_t prices;            // Prices delivered in time
+        uint64_t timeouts;          // Fetches dropped as late
+        uint64_t failures;          // Unavailable or threw
+        uint64_t p50_nanos;         // Fetch latency
+        uint64_t p99_nanos;
+        uint64_t max_nanos;
+    };
+    std::vector<SourceStats> get_stats() const;
+
+    uint64_t batches() const { return batches_.load(std::memory_order_relaxed); }
+
+private:
+    struct Source {
+        IOracleSource* source;
+        SourceSchedule schedule;
+        std::thread thread;
+
+        LatencyHistogram latency;
+        std::atomic<uint64_t> polls{0};
+        std::atomic<uint64_t> prices{0};
+        std::atomic<uint64_t> timeouts{0};
+        std::atomic<uint64_t> failures{0};
+    };
+
+    void poll_loop(Source& source);
+    void poll(Source& source);
+    void collect_loop();
+    // Sleep until `deadline` or stop(); false once stopping
+    bool wait_until(std::chrono::steady_clock::time_point deadline);
+
+    LXOracle& oracle_;
+    OracleSchedulerConfig config_;
+    std::vector<std::unique_ptr<Source>> sources_;
+
+    std::thread collector_;
+    std::atomic<bool> running_{false};
+    std::mutex wait_mutex_;
+    std::condition_variable wait_cv_;
+
+    std::mutex pending_mutex_;
+    std::vector<std::pair<uint64_t, SourcePriceData>> pending_;
+
+    std::atomic<uint64_t> batches_{0};
+};
+
+} // namespace lux
+
+#endif // LUX_ORACLE_SCHEDULER_HPP
@@ -2,43 +2,221 @@
 #define LUX_ORDERBOOK_HPP
 
 #include <map>
-#include <list>
+#include <memory>
+#include <iterator>
+#include <type_traits>
+#include <algorithm>
 #include <unordered_map>
 #include <shared_mutex>
+#include <mutex>
 #include <optional>
 #include <vector>
 #include <atomic>
 #include <functional>
+#include <cstdint>
 
 #include "order.hpp"
 #include "trade.hpp"
+#include "clock.hpp"
+#include "memory.hpp"
+#include "seqlock.hpp"
+#include "timer_wheel.hpp"
 
 namespace lux {
 
+// Resting order node, linked intrusively into its price level's FIFO queue.
+// Nodes are owned by an OrderPool and recycled through its freelist.
+struct OrderNode {
+    Order order;
+    OrderNode* prev{nullptr};
+    OrderNode* next{nullptr};
+};
+
+// Block allocator for OrderNode with an intrusive freelist.
+// Memory is only requested from the heap when the pool grows by a block;
+// steady-state place/cancel cycles reuse released nodes.
+class OrderPool {
+public:
+    static constexpr size_t DEFAULT_BLOCK_SIZE = 4096;
+
+    explicit OrderPool(size_t block_size = DEFAULT_BLOCK_SIZE,
+                       std::pmr::memory_resource* memory = std::pmr::get_default_resource())
+        : block_size_(block_size > 0 ? block_size : DEFAULT_BLOCK_SIZE), memory_(memory) {}
+
+    // Non-copyable (nodes are referenced by raw pointer)
+    OrderPool(const OrderPool&) = delete;
+    OrderPool& operator=(const OrderPool&) = delete;
+
+    OrderNode* acquire(const Order& order) {
+        if (!free_list_) {
+            grow(block_size_);
+        }
+        OrderNode* node = free_list_;
+        free_list_ = node->next;
+        node->order = order;
+        node->prev = nullptr;
+        node->next = nullptr;
+        ++in_use_;
+        return node;
+    }
+
+    void release(OrderNode* node) {
+        node->prev = nullptr;
+        node->next = free_list_;
+        free_list_ = node;
+        --in_use_;
+    }
+
+    // Pre-allocate so that at least `count` nodes are available without growing
+    void reserve(size_t count) {
+        if (count > capacity_) {
+            grow(count - capacity_);
+        }
+    }
+
+    size_t capacity() const { return capacity_; }
+    size_t in_use() const { return in_use_; }
+    size_t blocks() const { return blocks_.size(); }
+
+private:
+    void grow(size_t count) {
+        blocks_.emplace_back(count, memory_);
+        OrderNode* block = blocks_.back().data();
+        for (size_t i = 0; i < count; ++i) {
+            block[i].next = free_list_;
+            free_list_ = &block[i];
+        }
+        capacity_ += count;
+    }
+
+    size_t block_size_;
+    std::pmr::memory_resource* memory_;
+    std::vector<std::pmr::vector<OrderNode>> blocks_;    // Never resized, so nodes stay put
+    OrderNode* free_list_{nullptr};
+    size_t capacity_{0};
+    size_t in_use_{0};
+};
+
+// Intrusive doubly-linked FIFO of OrderNodes. Does not own its nodes.
+class OrderQueue {
+public:
+    template<typename NodePtr, typename Ref>
+    class Iterator {
+    public:
+        using iterator_category = std::forward_iterator_tag;
+        using value_type = Order;
+        using difference_type = std::ptrdiff_t;
+        using pointer = std::remove_reference_t<Ref>*;
+        using reference = Ref;
+
+        explicit Iterator(NodePtr node = nullptr) : node_(node) {}
+        reference operator*() const { return node_->order; }
+        pointer operator->() const { return &node_->order; }
+        Iterator& operator++() { node_ = node_->next; return *this; }
+        Iterator operator++(int) { Iterator tmp = *this; node_ = node_->next; return tmp; }
+        bool operator==(const Iterator& other) const { return node_ == other.node_; }
+        bool operator!=(const Iterator& other) const { return node_ != other.node_; }
+        NodePtr node() const { return node_; }
+
+    private:
+        NodePtr node_;
+    };
+
+    using iterator = Iterator<OrderNode*, Order&>;
+    using const_iterator = Iterator<const OrderNode*, const Order&>;
+
+    OrderQueue() = default;
+    OrderQueue(const OrderQueue&) = delete;
+    OrderQueue& operator=(const OrderQueue&) = delete;
+
+    OrderQueue(OrderQueue&& other) noexcept
+        : head_(other.head_), tail_(other.tail_), size_(other.size_) {
+        other.head_ = other.tail_ = nullptr;
+        other.size_ = 0;
+    }
+
+    OrderQueue& operator=(OrderQueue&& other) noexcept {
+        if (this != &other) {
+            head_ = other.head_;
+            tail_ = other.tail_;
+            size_ = other.size_;
+            other.head_ = other.tail_ = nullptr;
+            other.size_ = 0;
+        }
+        return *this;
+    }
+
+    void push_back(OrderNode* node) {
+        node->prev = tail_;
+        node->next = nullptr;
+        if (tail_) {
+            tail_->next = node;
+        } else {
+            head_ = node;
+        }
+        tail_ = node;
+        ++size_;
+    }
+
+    // O(1) unlink; node must belong to this queue
+    void unlink(OrderNode* node) {
+        if (node->prev) node->prev->next = node->next; else head_ = node->next;
+        if (node->next) node->next->prev = node->prev; else tail_ = node->prev;
+        node->prev = node->next = nullptr;
+        --size_;
+    }
+
+    // Unlink every node matching `pred`, handing each to `dispose`
+    template<typename Pred, typename Dispose>
+    void remove_if(Pred pred, Dispose dispose) {
+        OrderNode* node = head_;
+        while (node) {
+            OrderNode* next = node->next;
+            if (pred(node->order)) {
+                unlink(node);
+                dispose(node);
+            }
+            node = next;
+        }
+    }
+
+    OrderNode* head() const { return head_; }
+    OrderNode* tail() const { return tail_; }
+    Order& front() { return head_->order; }
+    const Order& front() const { return head_->order; }
+
+    size_t size() const { return size_; }
+    bool empty() const { return size_ == 0; }
+
+    iterator begin() { return iterator(head_); }
+    iterator end() { return iterator(nullptr); }
+    const_iterator begin() const { return const_iterator(head_); }
+    const_iterator end() const { return const_iterator(nullptr); }
+
+private:
+    OrderNode* head_{nullptr};
+    OrderNode* tail_{nullptr};
+    size_t size_{0};
+};
+
 // Price level containing orders at a single price point
 // Orders are in FIFO queue for price-time priority
 struct PriceLevel {
     Price price;
-    std::list<Order> orders;
+    OrderQueue orders;
     Quantity total_quantity{0};
 
     size_t order_count() const { return orders.size(); }
 
-    void add_order(Order order) {
-        total_quantity += order.remaining();
-        orders.push_back(std::move(order));
+    void add_order(OrderNode* node) {
+        total_quantity += node->order.remaining();
+        orders.push_back(node);
     }
 
-    // Remove order by ID, returns true if found
-    bool remove_order(uint64_t order_id) {
-        for (auto it = orders.begin(); it != orders.end(); ++it) {
-            if (it->id == order_id) {
-                total_quantity -= it->remaining();
-                orders.erase(it);
-                return true;
-            }
-        }
-        return false;
+    // Unlink a resting order in O(1); the caller releases the node
+    void remove_order(OrderNode* node) {
+        total_quantity -= node->order.remaining();
+        orders.unlink(node);
     }
 
     // Get front order (best time priority at this price)
@@ -50,16 +228,243 @@ struct PriceLevel {
         return orders.empty() ? nullptr : &orders.front();
     }
 
-    void pop_front() {
-        if (!orders.empty()) {
-            total_quantity -= orders.front().remaining();
-            orders.pop_front();
+    OrderNode* front_node() const { return orders.head(); }
+
+    bool empty() const { return orders.empty(); }
+};
+
+// Storage strategy for one side of an OrderBook
+enum class BookBackend : uint8_t {
+    Map = 0,         // Sparse std::map of price levels
+    TickLadder = 1   // Contiguous tick-indexed window with sparse map fallback
+};
+
+// How a book turns crossing interest into trades
+enum class MatchingMode : uint8_t {
+    Continuous = 0,    // Orders match on arrival
+    BatchAuction = 1   // Orders rest until the next uncross (frequent batch auction)
+};
+
+// How an auction rations the marginal price level
+enum class AuctionAllocation : uint8_t {
+    Time = 0,     // FIFO within the level
+    ProRata = 1   // In proportion to remaining size, rounding remainder by FIFO
+};
+
+// Per-symbol OrderBook configuration
+struct OrderBookConfig {
+    BookBackend backend = BookBackend::Map;
+    Price tick_size = 1;                 // Ladder grid spacing (fixed-point price units)
+    size_t ladder_ticks = 4096;          // Levels in the flat window, per side
+    size_t initial_order_capacity = 0;   // Order nodes to pre-allocate
+    bool thread_safe = true;             // false: caller guarantees a single owning thread
+    MatchingMode matching = MatchingMode::Continuous;
+    AuctionAllocation allocation = AuctionAllocation::Time;
+    Timestamp auction_interval = std::chrono::milliseconds(100);  // BatchAuction uncross period
+};
+
+// One side of the book, iterated in priority order (best price first).
+// Compare is std::greater<Price> for bids and std::less<Price> for asks.
+//
+// In TickLadder mode prices on the tick grid inside a window of
+// `ladder_ticks` levels live in a flat array with an occupancy bitmap;
+// everything else (far-away or off-grid prices) falls back to the map.
+// A price inside the window is never stored in the map.
+template<typename Compare>
+class BookSide {
+public:
+    static constexpr bool ASCENDING = std::is_same_v<Compare, std::less<Price>>;
+    static constexpr size_t NPOS = static_cast<size_t>(-1);
+
+    explicit BookSide(std::pmr::memory_resource* memory = std::pmr::get_default_resource())
+        : levels_(memory) {}
+    BookSide(const BookSide&) = delete;
+    BookSide& operator=(const BookSide&) = delete;
+
+    void configure(const OrderBookConfig& config) {
+        if (config.backend != BookBackend::TickLadder || config.tick_size <= 0) {
+            return;
+        }
+        ladder_ = true;
+        tick_ = config.tick_size;
+        size_t words = (std::max<size_t>(config.ladder_ticks, 64) + 63) / 64;
+        levels_.resize(words * 64);
+        occupied_.assign(words, 0);
+    }
+
+    bool is_ladder() const { return ladder_; }
+
+    PriceLevel* find(Price price) {
+        size_t idx;
+        if (in_window(price, idx)) {
+            return is_occupied(idx) ? &levels_[idx] : nullptr;
         }
+        auto it = sparse_.find(price);
+        return it != sparse_.end() ? &it->second : nullptr;
     }
 
-    bool empty() const { return orders.empty(); }
+    const PriceLevel* find(Price price) const {
+        return const_cast<BookSide*>(this)->find(price);
+    }
+
+    PriceLevel& get_or_create(Price price) {
+        size_t idx;
+        if (ladder_ && flat_count_ == 0 && !in_window(price, idx)) {
+            recenter(price);
+        }
+        if (in_window(price, idx)) {
+            if (!is_occupied(idx)) {
+                levels_[idx].price = price;
+                levels_[idx].total_quantity = 0;
+                mark(idx);
+            }
+            return levels_[idx];
+        }
+        auto& level = sparse_[price];
+        level.price = price;
+        return level;
+    }
+
+    void erase(Price price) {
+        size_t idx;
+        if (in_window(price, idx)) {
+            if (is_occupied(idx)) {
+                levels_[idx].total_quantity = 0;
+                unmark(idx);
+            }
+            return;
+        }
+        sparse_.erase(price);
+    }
+
+    PriceLevel* best() {
+        PriceLevel* flat = best_idx_ != NPOS ? &levels_[best_idx_] : nullptr;
+        PriceLevel* sparse = sparse_.empty() ? nullptr : &sparse_.begin()->second;
+        if (!flat) return sparse;
+        if (!sparse) return flat;
+        return Compare{}(flat->price, sparse->price) ? flat : sparse;
+    }
+
+    const PriceLevel* best() const {
+        return const_cast<BookSide*>(this)->best();
+    }
+
+    // Visit levels best-first; `fn(const PriceLevel&)` returns false to stop
+    template<typename Fn>
+    void for_each(Fn&& fn) const {
+        size_t idx = best_idx_;
+        auto it = sparse_.begin();
+        while (idx != NPOS || it != sparse_.end()) {
+            bool take_flat = idx != NPOS &&
+                (it == sparse_.end() || Compare{}(levels_[idx].price, it->first));
+            if (take_flat) {
+                if (!fn(levels_[idx])) return;
+                idx = next_occupied_after(idx);
+            } else {
+                if (!fn(it->second)) return;
+                ++it;
+            }
+        }
+    }
+
+    size_t size() const { return flat_count_ + sparse_.size(); }
+    bool empty() const { return size() == 0; }
+
+private:
+    bool in_window(Price price, size_t& idx) const {
+        if (!ladder_ || !anchored_) return false;
+        Price offset = price - base_;
+        if (offset < 0 || offset % tick_ != 0) return false;
+        idx = static_cast<size_t>(offset / tick_);
+        return idx < levels_.size();
+    }
+
+    // Re-anchor the empty window around `price`, pulling in any map levels
+    // that now fall inside it
+    void recenter(Price price) {
+        Price half = static_cast<Price>(levels_.size() / 2);
+        base_ = (price / tick_ - half) * tick_;
+        anchored_ = true;
+
+        for (auto it = sparse_.begin(); it != sparse_.end();) {
+            size_t idx;
+            if (in_window(it->first, idx)) {
+                levels_[idx] = std::move(it->second);
+                mark(idx);
+                it = sparse_.erase(it);
+            } else {
+                ++it;
+            }
+        }
+    }
+
+    bool is_occupied(size_t idx) const {
+        return (occupied_[idx >> 6] >> (idx & 63)) & 1ULL;
+    }
+
+    // True if index a has better priority than index b
+    static bool better(size_t a, size_t b) { return ASCENDING ? a < b : a > b; }
+
+    void mark(size_t idx) {
+        occupied_[idx >> 6] |= (1ULL << (idx & 63));
+        ++flat_count_;
+        if (best_idx_ == NPOS || better(idx, best_idx_)) {
+            best_idx_ = idx;
+        }
+    }
+
+    void unmark(size_t idx) {
+        occupied_[idx >> 6] &= ~(1ULL << (idx & 63));
+        --flat_count_;
+        if (idx == best_idx_) {
+            best_idx_ = next_occupied_after(idx);
+        }
+    }
+
+    // Next occupied index strictly after idx in priority order
+    size_t next_occupied_after(size_t idx) const {
+        if (ASCENDING) {
+            size_t start = idx + 1;
+            if (start >= levels_.size()) return NPOS;
+            size_t w = start >> 6;
+            uint64_t word = occupied_[w] & (~0ULL << (start & 63));
+            while (word == 0) {
+                if (++w >= occupied_.size()) return NPOS;
+                word = occupied_[w];
+            }
+            return (w << 6) + static_cast<size_t>(__builtin_ctzll(word));
+        } else {
+            if (idx == 0) return NPOS;
+            size_t start = idx - 1;
+            size_t w = start >> 6;
+            size_t bit = start & 63;
+            uint64_t mask = bit == 63 ? ~0ULL : ((1ULL << (bit + 1)) - 1);
+            uint64_t word = occupied_[w] & mask;
+            while (word == 0) {
+                if (w == 0) return NPOS;
+                word = occupied_[--w];
+            }
+            return (w << 6) + 63 - static_cast<size_t>(__builtin_clzll(word));
+        }
+    }
+
+    // Flat ladder (TickLadder mode only)
+    bool ladder_{false};
+    bool anchored_{false};
+    Price tick_{1};
+    Price base_{0};
+    std::pmr::vector<PriceLevel> levels_;
+    std::vector<uint64_t> occupied_;
+    size_t flat_count_{0};
+    size_t best_idx_{NPOS};
+
+    // Sparse fallback (the whole side in Map mode)
+    std::map<Price, PriceLevel, Compare> sparse_;
 };
 
+using BidSide = BookSide<std::greater<Price>>;
+using AskSide = BookSide<std::less<Price>>;
+
 // Market depth snapshot for a single side
 struct DepthLevel {
     double price;
@@ -73,16 +478,238 @@ struct MarketDepth {
     Timestamp timestamp;
 };
 
+// Top-of-book snapshot, republished after every book mutation
+struct L1Snapshot {
+    Price bid_price;         // Valid if bid_orders > 0
+    Quantity bid_quantity;
+    Price ask_price;         // Valid if ask_orders > 0
+    Quantity ask_quantity;
+    uint32_t bid_orders;
+    uint32_t ask_orders;
+    uint64_t sequence;       // Book mutation sequence number
+
+    bool has_bid() const { return bid_orders > 0; }
+    bool has_ask() const { return ask_orders > 0; }
+};
+
+// Incremental L2 update: the new state of one price level.
+// quantity == 0 and order_count == 0 means the level was removed.
+struct BookDelta {
+    uint64_t sequence;       // Per-book, strictly increasing by one
+    Side side;
+    Price price;
+    Quantity quantity;
+    uint32_t order_count;
+};
+
+// Fixed-point level used in L2 snapshots
+struct BookLevel {
+    Price price;
+    Quantity quantity;
+    uint32_t order_count;
+};
+
+// Full or truncated book image; deltas with sequence > `sequence` apply on top
+struct L2Snapshot {
+    uint64_t symbol_id;
+    uint64_t sequence;
+    std::vector<BookLevel> bids;   // Best first
+    std::vector<BookLevel> asks;   // Best first
+};
+
+// Fixed-size description of a captured book; the resting orders follow
+// it as bid_orders bids then ask_orders asks, each in priority order.
+struct BookSnapshotHeader {
+    uint64_t symbol_id;
+    OrderBookConfig config;
+    uint64_t next_trade_id;
+    uint64_t delta_sequence;
+    uint64_t bid_orders;
+    uint64_t ask_orders;
+};
+
+// Callback interface for incremental book updates.
+// Invoked synchronously while the book's write lock is held.
+class BookUpdateListener {
+public:
+    virtual ~BookUpdateListener() = default;
+    virtual void on_book_delta(uint64_t symbol_id, const BookDelta& delta) = 0;
+};
+
+// One level of a mass-quote ladder
+struct QuoteLevel {
+    Side side;
+    Price price;
+    Quantity quantity;   // Desired resting size
+    uint64_t order_id;   // Id for the new order if the level has to be placed
+};
+
+// What a mass quote did with one ladder level
+enum class QuoteAction : uint8_t {
+    Kept = 0,       // A resting quote already showed this size
+    Reduced = 1,    // Resting quote shrunk in place; queue priority kept
+    Requeued = 2,   // Resting quote grown; moved to the back of its level
+    Placed = 3,     // New order, matched on entry like any limit order
+    Rejected = 4    // Non-positive price or size
+};
+
+struct QuoteOutcome {
+    uint64_t order_id;   // Order now quoting the level (0 if rejected)
+    QuoteAction action;
+    Quantity quantity;   // Order's total size after the call
+    Quantity filled;     // Order's cumulative fills after the call
+};
+
+struct MassQuoteRequest {
+    Order prototype;                 // Account, type, TIF and STP group of new quotes
+    const uint64_t* resting;         // The owner's current quotes on this book
+    size_t resting_count;
+    const QuoteLevel* levels;        // Desired ladder
+    size_t level_count;
+};
+
+struct MassQuoteSummary {
+    uint32_t kept;
+    uint32_t reduced;
+    uint32_t requeued;
+    uint32_t placed;
+    uint32_t rejected;
+    uint32_t cancelled;
+};
+
+// The order a mass quote places for a new ladder level
+inline Order make_quote_order(const Order& prototype, const QuoteLevel& level) {
+    Order order = prototype;
+    order.id = level.order_id;
+    order.side = level.side;
+    order.price = level.price;
+    order.quantity = level.quantity;
+    order.filled = 0;
+    order.type = OrderType::Limit;
+    return order;
+}
+
+// Why place_order() refused an order. Validation reports through this
+// code rather than an exception, so a flood of bad orders costs no more
+// than a branch each.
+enum class PlaceError : uint8_t {
+    None = 0,
+    InvalidQuantity = 1,    // Quantity not positive
+    InvalidPrice = 2,       // Limit order without a positive price
+    OffTick = 3,            // Limit price not a multiple of the policy's tick
+    OffLot = 4,             // Quantity not a multiple of the policy's lot
+    NotAllowed = 5          // Order type or time in force the policy excludes
+};
+
+// Short static message for a PlaceError
+const char* place_error_message(PlaceError error);
+
+struct PlaceOutcome {
+    PlaceError error;
+    size_t trades;          // Fills appended to the caller's buffer
+
+    explicit operator bool() const { return error == PlaceError::None; }
+};
+
+// =============================================================================
+// Book Policies
+// =============================================================================
+//
+// A BookPolicy fixes a market's rules at compile time: the tick and lot
+// sizes (in Price / Quantity units; 0 accepts any value), whether
+// self-trade prevention runs, and which order types and times in force are
+// accepted. A book constructed with a policy validates against constants
+// and matches with the excluded features' branches compiled out: a book
+// without STP never compares STP groups, one without FOK never sizes the
+// opposite side first, a limit-only book never tests for market orders.
+// Everything else (backends, auctions, expiry, snapshots) is shared.
+//
+// The default policy accepts everything and is what a book constructed
+// without one uses, so OrderBook remains the generic path. A policy for an
+// LXBook market follows its BookMarketConfig: tick_size_x18 / 1e10 and
+// lot_size_x18 / 1e10 in the engine's 1e8 units (see book_units()).
+
+constexpr uint8_t order_type_bit(OrderType type) {
+    return static_cast<uint8_t>(1u << static_cast<unsigned>(type));
+}
+
+constexpr uint8_t tif_bit(TimeInForce tif) {
+    return static_cast<uint8_t>(1u << static_cast<unsigned>(tif));
+}
+
+constexpr uint8_t ALL_ORDER_TYPES = 0x0F;       // Limit, Market, Stop, StopLimit
+constexpr uint8_t ALL_TIME_IN_FORCE = 0x1F;     // GTC, IOC, FOK, GTD, DAY
+
+template<Price Tick = 0, Quantity Lot = 0, bool SelfTradePrevention = true,
+         uint8_t OrderTypes = ALL_ORDER_TYPES, uint8_t TimesInForce = ALL_TIME_IN_FORCE>
+struct BookPolicy {
+    static_assert(Tick >= 0 && Lot >= 0, "tick and lot sizes cannot be negative");
+
+    static constexpr Price TICK = Tick;
+    static constexpr Quantity LOT = Lot;
+    static constexpr bool SELF_TRADE_PREVENTION = SelfTradePrevention;
+
+    static constexpr bool allows(OrderType type) {
+        return (OrderTypes & order_type_bit(type)) != 0;
+    }
+    static constexpr bool allows(TimeInForce tif) {
+        return (TimesInForce & tif_bit(tif)) != 0;
+    }
+
+    // Refusal reason for an order, or None; the checks for rules the
+    // policy does not impose fold away
+    static PlaceError validate(const Order& order) {
+        if (order.quantity <= 0) {
+            return PlaceError::InvalidQuantity;
+        }
+        if constexpr (OrderTypes != ALL_ORDER_TYPES) {
+            if (!allows(order.type)) return PlaceError::NotAllowed;
+        }
+        if constexpr (TimesInForce != ALL_TIME_IN_FORCE) {
+            if (!allows(order.tif)) return PlaceError::NotAllowed;
+        }
+        if (allows(OrderType::Limit) && order.type == OrderType::Limit) {
+            if (order.price <= 0) {
+                return PlaceError::InvalidPrice;
+            }
+            if constexpr (TICK > 1) {
+                if (order.price % TICK != 0) return PlaceError::OffTick;
+            }
+        }
+        if constexpr (LOT > 1) {
+            if (order.quantity % LOT != 0) return PlaceError::OffLot;
+        }
+        return PlaceError::None;
+    }
+};
+
+using GenericBookPolicy = BookPolicy<>;
+
 // Order location for O(1) cancel
 struct OrderLocation {
     uint64_t order_id;
     Price price;
     Side side;
+    OrderNode* node;  // Direct handle into the price level queue
 };
 
 class OrderBook {
 public:
-    explicit OrderBook(uint64_t symbol_id);
+    // `memory` backs the order pool, tick ladders and order index (null =
+    // the heap), e.g. a NodeMemory on the owning shard's node; it must
+    // outlive the book
+    explicit OrderBook(uint64_t symbol_id, const OrderBookConfig& config = {},
+                       std::pmr::memory_resource* memory = nullptr);
+
+    // A book specialised for Policy: place_order() and mass_quote()
+    // placements validate and match through Policy's instantiation
+    template<typename Policy, typename = decltype(&Policy::validate)>
+    OrderBook(uint64_t symbol_id, const OrderBookConfig& config, Policy,
+              std::pmr::memory_resource* memory = nullptr)
+        : OrderBook(symbol_id, config, memory) {
+        validate_ = &Policy::validate;
+        place_locked_ = &OrderBook::place_locked<Policy>;
+    }
     ~OrderBook() = default;
 
     // Non-copyable, non-movable (due to atomic members)
@@ -92,22 +719,100 @@ public:
     OrderBook& operator=(OrderBook&&) = delete;
 
     uint64_t symbol_id() const { return symbol_id_; }
+    BookBackend backend() const { return backend_; }
+    bool thread_safe() const { return thread_safe_; }
+
+    // Time source of every timestamp the book assigns; SystemClock unless
+    // set. The clock must outlive the book (or the next set_clock).
+    void set_clock(EngineClock* clock) { clock_ = clock ? clock : &SystemClock::instance(); }
+    EngineClock& clock() const { return *clock_; }
 
     // Core operations - all thread-safe
-    // Returns trades generated from matching
+    // Returns trades generated from matching; an invalid order is refused
+    // with no trades (the overload below says why)
     std::vector<Trade> place_order(Order order, TradeListener* listener = nullptr);
 
+    // Allocation-free variant: appends fills to a caller-owned buffer and
+    // reports how many were appended, or why the order was refused. Reuse
+    // the buffer across calls so its capacity amortises to zero
+    // allocations on the matching path.
+    PlaceOutcome place_order(Order order, std::vector<Trade>& trades, TradeListener* listener = nullptr);
+
     // Cancel order by ID, returns the cancelled order if found
     std::optional<Order> cancel_order(uint64_t order_id);
 
-    // Modify order (cancel + replace)
+    // Modify order (cancel + replace). Returns nullopt if the order is
+    // unknown or the book's policy refuses the replacement.
     std::optional<Order> modify_order(uint64_t order_id, Price new_price, Quantity new_quantity);
 
-    // Query operations - lock-free reads
+    // Shrink a resting order to `new_quantity` (total, including fills) in
+    // place, keeping its queue position. Returns nullopt if the order is
+    // unknown, this is not a reduction or the policy refuses the new size;
+    // a size at or below the filled amount cancels the order.
+    std::optional<Order> reduce_order(uint64_t order_id, Quantity new_quantity);
+
+    // Replace one owner's quote ladder under a single write lock. Each
+    // level is matched against a resting quote of the same side and
+    // price: equal size is kept, smaller size is reduced in place, larger
+    // size is requeued; unmatched levels are placed as new orders and
+    // resting quotes no level claims are cancelled (appended to
+    // `cancelled`). Cancels happen first, so new quotes never trade
+    // against the ones they replace. One outcome per level is written to
+    // `outcomes`; fills are appended to `trades` and L1/L2 subscribers
+    // see a single update. Requeued quotes, and new ones without a
+    // timestamp, take `now`. Returns per-action counts.
+    MassQuoteSummary mass_quote(const MassQuoteRequest& request, Timestamp now, QuoteOutcome* outcomes,
+                                std::vector<Order>& cancelled, std::vector<Trade>& trades,
+                                TradeListener* listener = nullptr);
+
+    // Expiry. Resting GTD orders expire at expire_time, DAY orders at
+    // expire_time or, if unset, at the end of the UTC day they were
+    // placed; GTD orders without an expire_time never expire. Expiries
+    // are kept in a timing wheel with EXPIRY_TICK resolution, so placing
+    // costs O(1) and nothing is scanned. expire_orders() removes every
+    // order due at `now`, appends it to `expired` with status Expired and
+    // returns the count; L1/L2 subscribers see one update.
+    static constexpr Timestamp EXPIRY_TICK = std::chrono::milliseconds(1);
+    static Timestamp expiry_of(const Order& order);
+    size_t expire_orders(Timestamp now, std::vector<Order>& expired);
+
+    // Expiries still scheduled; includes orders that have since filled or
+    // been cancelled until their time comes
+    size_t pending_expiries() const { return pending_expiries_.load(std::memory_order_relaxed); }
+
+    // Batch auctions (MatchingMode::BatchAuction). Limit GTC / GTD / DAY
+    // orders rest without matching, so the book may be crossed between
+    // auctions; other orders are rejected. uncross() clears the book in
+    // one pass. The clearing price maximises executable volume, then
+    // minimises the buy/sell imbalance, then is closest to the previous
+    // clearing price (the crossed mid before the first auction). Orders
+    // priced through it fill in full and the marginal level is rationed
+    // by config().allocation. Every fill trades at the clearing price;
+    // the listener gets the trades as one on_trade_batch() and then one
+    // fill notification per order. Self-trade prevention does not apply.
+    // Returns the number of trades appended. Works in either mode.
+    size_t uncross(std::vector<Trade>& trades, TradeListener* listener = nullptr);
+
+    // Auctions run on a fixed grid of auction_interval. run_auction()
+    // uncrosses if the grid slot `now` falls in has not been run yet and
+    // returns the trade count, or nullopt if no auction was due.
+    bool auction_due(Timestamp now) const {
+        return config_.matching == MatchingMode::BatchAuction &&
+               now.count() >= next_auction_.load(std::memory_order_relaxed);
+    }
+    std::optional<size_t> run_auction(Timestamp now, std::vector<Trade>& trades,
+                                      TradeListener* listener = nullptr);
+    std::optional<Price> last_auction_price() const;
+
+    // Query operations (shared lock). With thread_safe = false the lock is
+    // skipped: these, get_depth(), get_l2_snapshot() and the statistics
+    // below must then run on the owning thread. Only the L1 reads are safe
+    // from anywhere.
     std::optional<Order> get_order(uint64_t order_id) const;
     bool has_order(uint64_t order_id) const;
 
-    // Best bid/ask prices
+    // Top of book - lock-free reads from the published L1 snapshot
+    L1Snapshot top_of_book() const { return l1_.load(); }
     std::optional<Price> best_bid() const;
     std::optional<Price> best_ask() const;
     std::optional<Price> spread() const;
@@ -115,6 +820,14 @@ public:
     // Market depth
     MarketDepth get_depth(size_t levels = 10) const;
 
+    // Incremental L2 feed: one delta per changed level per mutation
+    void add_update_listener(BookUpdateListener* listener);
+    void remove_update_listener(BookUpdateListener* listener);
+    L2Snapshot get_l2_snapshot(size_t levels = SIZE_MAX) const;
+    // Fills a caller-owned snapshot, reusing its level vectors' capacity
+    void get_l2_snapshot(L2Snapshot& out, size_t levels) const;
+    uint64_t delta_sequence() const;
+
     // Statistics
     size_t bid_levels() const;
     size_t ask_levels() const;
@@ -122,32 +835,111 @@ public:
     Quantity total_bid_quantity() const;
     Quantity total_ask_quantity() const;
 
+    // Order node pool usage
+    size_t order_pool_capacity() const;
+    size_t order_pool_in_use() const;
+
+    // Order nodes plus the order index
+    MemoryStats memory_usage() const;
+
+    // Snapshots. capture() appends the resting orders to `orders` under the
+    // read lock (one copy pass) and describes them in the returned header.
+    // restore() bulk-loads such an image into an empty book, appending to
+    // levels directly instead of placing orders; false if not empty or if
+    // accepts_image() rejects it. valid_image() checks that the header's order
+    // counts match the `count` records, that each side holds its own
+    // orders and that `validate` accepts each one, so a corrupt image is
+    // refused before anything is loaded; accepts_image() validates with
+    // this book's policy.
+    const OrderBookConfig& config() const { return config_; }
+    BookSnapshotHeader capture(std::vector<Order>& orders) const;
+    bool restore(const BookSnapshotHeader& header, const Order* orders, size_t count);
+    static bool valid_image(const BookSnapshotHeader& header, const Order* orders, size_t count,
+                            PlaceError (*validate)(const Order&) = &GenericBookPolicy::validate);
+    bool accepts_image(const BookSnapshotHeader& header, const Order* orders, size_t count) const;
+
 private:
     uint64_t symbol_id_;
+    OrderBookConfig config_;
+    BookBackend backend_;
+    EngineClock* clock_ = &SystemClock::instance();
+
+    Timestamp now() const { return clock_->now(); }
 
     // Bid side: sorted descending (highest price first)
-    // Use std::greater for descending order
-    std::map<Price, PriceLevel, std::greater<Price>> bids_;
+    BidSide bids_;
 
     // Ask side: sorted ascending (lowest price first)
-    std::map<Price, PriceLevel> asks_;
+    AskSide asks_;
+
+    // Order ID -> location for O(1) lookup, its nodes pooled per book
+    PoolArena index_arena_;
+    std::pmr::unordered_map<uint64_t, OrderLocation> order_locations_{index_arena_.resource()};
 
-    // Order ID -> location for O(1) lookup
-    std::unordered_map<uint64_t, OrderLocation> order_locations_;
+    // Storage for resting orders
+    OrderPool order_pool_;
 
     // Trade ID generator
     std::atomic<uint64_t> next_trade_id_{1};
 
-    // Reader-writer lock for thread safety
+    // Order ids by expiry tick (written under the exclusive lock). Entries
+    // are not removed on cancel or fill; an expiry finding its order
+    // gone is skipped.
+    TimerWheel<uint64_t> expiries_;
+    std::atomic<size_t> pending_expiries_{0};
+    void schedule_expiry(const Order& order);
+
+    // Published top of book (written under the exclusive lock)
+    SeqLock<L1Snapshot> l1_;
+    uint64_t l1_sequence_{0};
+    void publish_l1();
+
+    // L2 delta subscribers and levels touched by the current mutation
+    std::vector<BookUpdateListener*> update_listeners_;
+    std::vector<std::pair<Side, Price>> touched_levels_;
+    uint64_t delta_sequence_{0};
+    void note_level_change(Side side, Price price);
+    void publish_deltas();
+
+    // Publish L1 and L2 updates at the end of a mutation
+    void publish_updates() {
+        publish_l1();
+        publish_deltas();
+    }
+
+    // Reader-writer lock for thread safety (skipped when !thread_safe_)
     mutable std::shared_mutex mutex_;
+    bool thread_safe_;
+
+    std::unique_lock<std::shared_mutex> write_lock() const {
+        return thread_safe_ ? std::unique_lock<std::shared_mutex>(mutex_)
+                            : std::unique_lock<std::shared_mutex>(mutex_, std::defer_lock);
+    }
+
+    std::shared_lock<std::shared_mutex> read_lock() const {
+        return thread_safe_ ? std::shared_lock<std::shared_mutex>(mutex_)
+                            : std::shared_lock<std::shared_mutex>(mutex_, std::defer_lock);
+    }
+
+    // The placement path of the book's policy, chosen at construction
+    using PlaceLockedFn = void (OrderBook::*)(Order&, std::vector<Trade>&, TradeListener*);
+    PlaceError (*validate_)(const Order&) = &GenericBookPolicy::validate;
+    PlaceLockedFn place_locked_ = &OrderBook::place_locked<GenericBookPolicy>;
+
+    // place_order() body for an order Policy validated; the caller holds
+    // the write lock and publishes
+    template<typename Policy>
+    void place_locked(Order& order, std::vector<Trade>& trades, TradeListener* listener);
 
     // Internal matching logic
-    std::vector<Trade> match_order(Order& order, TradeListener* listener);
+    template<typename Policy>
+    void match_order(Order& order, std::vector<Trade>& trades, TradeListener* listener);
 
-    template<typename BookSide>
-    std::vector<Trade> match_against_side(
+    template<typename Policy, typename BookSide>
+    void match_against_side(
         Order& aggressor,
         BookSide& book_side,
+        std::vector<Trade>& trades,
         TradeListener* listener
     );
 
@@ -164,14 +956,262 @@ private:
     // Add order to resting book
     void add_to_book(Order order);
 
-    // Remove order from book
-    void remove_from_book(uint64_t order_id, Price price, Side side);
+    // Unlink a resting order from its level (erasing the level if it empties).
+    // The node is not released; the caller decides whether to reuse it.
+    void unlink_from_book(const OrderLocation& loc);
+
+    // Link an already-acquired node into the resting book
+    void link_into_book(OrderNode* node);
+
+    // Lower a resting order's total size without moving it in its queue
+    void shrink_in_place(const OrderLocation& loc, Quantity new_quantity);
+
+    // mass_quote() scratch, reused under the write lock
+    struct RestingQuote {
+        static constexpr size_t NONE = static_cast<size_t>(-1);
+        OrderLocation loc;
+        bool claimed;
+    };
+    std::vector<RestingQuote> quote_resting_;
+    std::vector<size_t> quote_matches_;
+
+    // Batch auction state and uncross() scratch (under the write lock)
+    struct AuctionLevel {
+        Price price;
+        Quantity quantity;
+    };
+    struct AuctionFill {
+        OrderNode* node;
+        Quantity quantity;
+    };
+    std::atomic<int64_t> next_auction_{0};   // Timestamp count of the next grid slot
+    Price last_auction_price_{0};
+    std::vector<AuctionLevel> auction_bids_;
+    std::vector<AuctionLevel> auction_asks_;
+    std::vector<AuctionFill> auction_buys_;
+    std::vector<AuctionFill> auction_sells_;
+    size_t uncross_locked(std::vector<Trade>& trades, TradeListener* listener);
+
+    // Fill `volume` from the crossing levels of one side, best first,
+    // rationing the level where it runs out
+    template<typename BookSide>
+    void allocate_auction(BookSide& side, const std::vector<AuctionLevel>& levels, Price clearing,
+                          Quantity volume, std::vector<AuctionFill>& fills);
 
     // Generate trade record
     Trade create_trade(const Order& buy_order, const Order& sell_order,
                        Price price, Quantity quantity, Side aggressor);
 };
 
+// =============================================================================
+// Policy-Specialised Matching
+// =============================================================================
+//
+// Tests on Policy's constants are constant-folded, so each instantiation
+// keeps only the branches its policy can reach.
+
+template<typename Policy>
+void OrderBook::place_locked(Order& order, std::vector<Trade>& trades, TradeListener* listener) {
+    order.status = OrderStatus::New;
+    order.filled = 0;
+    order.symbol_id = symbol_id_;
+
+    // Set timestamp if not already set
+    if (order.timestamp.count() == 0) {
+        order.timestamp = now();
+    }
+
+    // Auction books only collect interest; it trades at the next uncross
+    if (config_.matching == MatchingMode::BatchAuction) {
+        if (order.type == OrderType::Limit &&
+            order.tif != TimeInForce::IOC && order.tif != TimeInForce::FOK) {
+            add_to_book(order);
+            schedule_expiry(order);
+        } else {
+            order.status = OrderStatus::Rejected;
+        }
+        return;
+    }
+
+    // Market orders and limit orders get matched
+    constexpr bool MARKET = Policy::allows(OrderType::Market);
+    if (order.type == OrderType::Limit || (MARKET && order.type == OrderType::Market)) {
+        match_order<Policy>(order, trades, listener);
+    }
+
+    if (order.remaining() == 0) {
+        // The matching loop already reported the final fill
+        order.status = OrderStatus::Filled;
+        return;
+    }
+
+    // Handle remaining quantity based on TimeInForce
+    if (Policy::allows(TimeInForce::IOC) && order.tif == TimeInForce::IOC) {
+        // Immediate or Cancel: cancel remaining
+        order.status = order.filled > 0 ?
+            OrderStatus::PartiallyFilled : OrderStatus::Cancelled;
+        if (listener) {
+            listener->on_order_cancelled(order);
+        }
+    } else if (Policy::allows(TimeInForce::FOK) && order.tif == TimeInForce::FOK) {
+        // Fill or Kill: should have been fully filled or rejected
+        // If we get here with remaining, the order was rejected
+        order.status = OrderStatus::Rejected;
+    } else if (order.type == OrderType::Limit) {
+        // GTC, GTD and DAY limit orders rest
+        add_to_book(order);
+        schedule_expiry(order);
+    } else {
+        // Market orders that couldn't be fully filled
+        order.status = order.filled > 0 ?
+            OrderStatus::PartiallyFilled : OrderStatus::Cancelled;
+    }
+}
+
+template<typename Policy>
+void OrderBook::match_order(Order& order, std::vector<Trade>& trades, TradeListener* listener) {
+    // FOK check: ensure we can fill the entire order
+    if (Policy::allows(TimeInForce::FOK) && order.tif == TimeInForce::FOK) {
+        const bool market = Policy::allows(OrderType::Market) && order.type == OrderType::Market;
+        Quantity available = 0;
+        if (order.is_buy()) {
+            asks_.for_each([&](const PriceLevel& level) {
+                if (!market && !prices_cross(order.price, level.price)) {
+                    return false;
+                }
+                available += level.total_quantity;
+                return available < order.quantity;
+            });
+        } else {
+            bids_.for_each([&](const PriceLevel& level) {
+                if (!market && !prices_cross(level.price, order.price)) {
+                    return false;
+                }
+                available += level.total_quantity;
+                return available < order.quantity;
+            });
+        }
+
+        if (available < order.quantity) {
+            order.status = OrderStatus::Rejected;
+            return;
+        }
+    }
+
+    // Match against opposite side
+    if (order.is_buy()) {
+        match_against_side<Policy>(order, asks_, trades, listener);
+    } else {
+        match_against_side<Policy>(order, bids_, trades, listener);
+    }
+}
+
+template<typename Policy, typename BookSide>
+void OrderBook::match_against_side(
+    Order& aggressor,
+    BookSide& book_side,
+    std::vector<Trade>& trades,
+    TradeListener* listener
+) {
+    const bool market = Policy::allows(OrderType::Market) && aggressor.type == OrderType::Market;
+    while (aggressor.remaining() > 0) {
+        PriceLevel* best = book_side.best();
+        if (!best) {
+            break;
+        }
+        PriceLevel& level = *best;
+        Price level_price = level.price;
+
+        // Check if prices cross
+        bool crosses;
+        if (market) {
+            crosses = true;
+        } else if (aggressor.is_buy()) {
+            crosses = prices_cross(aggressor.price, level_price);
+        } else {
+            crosses = prices_cross(level_price, aggressor.price);
+        }
+
+        if (!crosses) {
+            break;
+        }
+
+        note_level_change(aggressor.is_buy() ? Side::Sell : Side::Buy, level_price);
+
+        // Match against orders at this price level (FIFO)
+        while (!level.empty() && aggressor.remaining() > 0) {
+            OrderNode* node = level.front_node();
+            Order* resting = &node->order;
+
+            // Self-trade prevention
+            if constexpr (Policy::SELF_TRADE_PREVENTION) {
+                if (would_self_trade(aggressor, *resting)) {
+                    // Cancel the resting order
+                    Order cancelled = *resting;
+                    cancelled.status = OrderStatus::Cancelled;
+                    level.remove_order(node);
+                    order_locations_.erase(cancelled.id);
+                    order_pool_.release(node);
+                    if (listener) {
+                        listener->on_order_cancelled(cancelled);
+                    }
+                    continue;
+                }
+            }
+
+            // Calculate fill quantity
+            Quantity fill_qty = std::min(aggressor.remaining(), resting->remaining());
+
+            // Update orders
+            aggressor.filled += fill_qty;
+            resting->filled += fill_qty;
+            level.total_quantity -= fill_qty;
+
+            // Create trade
+            Trade trade = aggressor.is_buy() ?
+                create_trade(aggressor, *resting, level_price, fill_qty, aggressor.side) :
+                create_trade(*resting, aggressor, level_price, fill_qty, aggressor.side);
+
+            trades.push_back(trade);
+
+            if (listener) {
+                listener->on_trade(trade);
+
+                if (aggressor.is_filled()) {
+                    listener->on_order_filled(aggressor);
+                } else {
+                    listener->on_order_partially_filled(aggressor, fill_qty);
+                }
+
+                if (resting->is_filled()) {
+                    listener->on_order_filled(*resting);
+                } else {
+                    listener->on_order_partially_filled(*resting, fill_qty);
+                }
+            }
+
+            // Remove filled resting order
+            if (resting->is_filled()) {
+                order_locations_.erase(resting->id);
+                level.remove_order(node);
+                order_pool_.release(node);
+            }
+        }
+
+        // Remove empty price level; a non-empty level means the aggressor is done
+        if (!level.empty()) {
+            break;
+        }
+        book_side.erase(level_price);
+    }
+
+    // Update aggressor status
+    if (aggressor.filled > 0) {
+        aggressor.status = aggressor.is_filled() ?
+            OrderStatus::Filled : OrderStatus::PartiallyFilled;
+    }
+}
+
 } // namespace lux
 
 #endif // LUX_ORDERBOOK_HPP
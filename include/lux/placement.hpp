@@ -0,0 +1,100 @@
+#ifndef LUX_PLACEMENT_HPP
+#define LUX_PLACEMENT_HPP
+
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <memory_resource>
+
+namespace lux {
+
+// =============================================================================
+// Thread and Memory Placement
+// =============================================================================
+//
+// On multi-socket hosts a shard's thread and the memory it touches should
+// sit on the same NUMA node; otherwise every book or account lookup that
+// misses cache crosses the interconnect. NodeMemory hands out memory mapped
+// for one node: chunks are bound to it with mbind() (preferred, so a full
+// node spills over rather than failing) and, when asked, backed by 2 MB
+// pages - explicit hugetlb pages if the host reserved any, otherwise
+// transparent huge pages via madvise(). Small requests are pooled inside
+// the mapped chunks. Everything degrades to ordinary pages on hosts, or
+// non-Linux builds, without NUMA or huge-page support.
+//
+// Topology comes from sysfs; no libnuma is needed.
+
+constexpr size_t HUGE_PAGE_SIZE = size_t{2} << 20;
+
+// Online CPUs (at least 1)
+size_t cpu_count();
+
+// NUMA node of a CPU, or -1 if unknown (single node, or no sysfs)
+int numa_node_of_cpu(int cpu);
+
+// Pins the calling thread to one CPU; false if the OS refused
+bool pin_current_thread(int cpu);
+
+struct NodeMemoryStats {
+    int node = -1;                  // -1: not bound
+    size_t bytes_mapped = 0;        // Mapped from the OS, including pool slack
+    size_t huge_page_bytes = 0;     // Of which backed (or advised) as 2 MB pages
+    uint64_t mappings = 0;          // Live mappings
+    uint64_t bind_failures = 0;     // mbind() refusals; those pages float
+};
+
+// Thread-safe memory resource bound to a NUMA node. Not copyable or
+// movable: containers keep a pointer to resource(). Must outlive every
+// container and book drawing on it.
+class NodeMemory {
+public:
+    explicit NodeMemory(int node = -1, bool huge_pages = false);
+    NodeMemory(const NodeMemory&) = delete;
+    NodeMemory& operator=(const NodeMemory&) = delete;
+
+    std::pmr::memory_resource* resource() { return &pool_; }
+    int node() const { return mapper_.node(); }
+    bool huge_pages() const { return mapper_.huge_pages(); }
+    NodeMemoryStats stats() const { return mapper_.stats(); }
+
+private:
+    // Maps every request separately, rounded to whole pages (2 MB pages
+    // for requests of 1 MB or more when huge pages are on)
+    class PageMapper final : public std::pmr::memory_resource {
+    public:
+        PageMapper(int node, bool huge_pages) : node_(node), huge_pages_(huge_pages) {}
+
+        int node() const { return node_; }
+        bool huge_pages() const { return huge_pages_; }
+        NodeMemoryStats stats() const;
+
+    private:
+        void* do_allocate(size_t bytes, size_t alignment) override;
+        void do_deallocate(void* p, size_t bytes, size_t alignment) override;
+        bool do_is_equal(const std::pmr::memory_resource& other) const noexcept override {
+            return this == &other;
+        }
+
+        size_t mapping_size(size_t bytes) const;
+
+        int node_;
+        bool huge_pages_;
+        std::atomic<size_t> bytes_mapped_{0};
+        std::atomic<size_t> huge_page_bytes_{0};
+        std::atomic<uint64_t> mappings_{0};
+        std::atomic<uint64_t> bind_failures_{0};
+    };
+
+    static std::pmr::pool_options pool_options() {
+        std::pmr::pool_options options;
+        options.largest_required_pool_block = 64 * 1024;   // Larger tables map directly
+        return options;
+    }
+
+    PageMapper mapper_;
+    std::pmr::synchronized_pool_resource pool_;
+};
+
+} // namespace lux
+
+#endif // LUX_PLACEMENT_HPP
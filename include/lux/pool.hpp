@@ -2,14 +2,19 @@
 #define LUX_POOL_HPP
 
 #include <map>
+#include <memory>
 #include <unordered_map>
 #include <shared_mutex>
+#include <mutex>
+#include <atomic>
 #include <optional>
 #include <vector>
 #include <functional>
 #include <cmath>
 
 #include "types.hpp"
+#include "tick_bitmap.hpp"
+#include "symbol_directory.hpp"
 
 namespace lux {
 
@@ -49,6 +54,52 @@ struct PositionInfo {
     I128 tokens_owed1;
 };
 
+// =============================================================================
+// Swap Quote (read-only swap simulation)
+// =============================================================================
+
+struct SwapQuote {
+    BalanceDelta delta;          // What swap() would return for the same inputs
+    I128 sqrt_price_x96;         // Price after the swap
+    int32_t tick;                // Tick after the swap
+    uint32_t ticks_crossed;      // Initialized ticks crossed
+};
+
+// =============================================================================
+// Pool Depth (liquidity curve around the current price)
+// =============================================================================
+
+// One price step of a depth curve. Amounts are cumulative from the current
+// price to this step, before fees.
+struct PoolDepthLevel {
+    int32_t tick;                // Step boundary
+    I128 sqrt_price_x96;
+    I128 amount_in;              // Paid to the pool to move the price here
+    I128 amount_out;             // Taken from the pool on the way
+};
+
+struct PoolDepth {
+    int32_t tick;
+    I128 sqrt_price_x96;
+    I128 liquidity;                       // Active liquidity
+    std::vector<PoolDepthLevel> asks;     // Price rising: token1 in, token0 out
+    std::vector<PoolDepthLevel> bids;     // Price falling: token0 in, token1 out
+};
+
+// Liquidity between consecutive boundaries over a window of steps centred
+// on the step holding the current tick. It depends on positions only, so
+// it holds until liquidity is modified or the price leaves the centre step.
+struct DepthProfile {
+    int32_t step_ticks;
+    size_t levels;
+    int64_t anchor;                  // Step index of the centre step
+    uint64_t liquidity_version;      // PoolSlot::liquidity_version when built
+    std::vector<int32_t> ticks;      // Boundaries, ascending: steps and initialized ticks
+    std::vector<I128> sqrt_prices;   // At each boundary
+    std::vector<bool> steps;         // Whether the boundary is a step
+    std::vector<I128> liquidity;     // Between boundary i and i + 1
+};
+
 // =============================================================================
 // Pool State (single pool)
 // =============================================================================
@@ -60,16 +111,102 @@ struct PoolState {
     I128 protocol_fees0;
     I128 protocol_fees1;
     I128 liquidity;              // Current active liquidity
-    std::map<int32_t, TickInfo> ticks;
+    std::unordered_map<int32_t, TickInfo> ticks;  // Looked up by tick, never walked
+    TickBitmap tick_bitmap;      // Which ticks are initialized, for swap's next-tick search
     std::unordered_map<uint64_t, PositionInfo> positions;  // position_key -> info
 };
 
+// =============================================================================
+// Pool Slot and Handle (per-pool lock, stable reference)
+// =============================================================================
+
+class IHooks;
+
+// One pool and the lock that guards it. Operations on different pools run
+// in parallel; the manager-wide lock only covers creating pools. Slots are
+// never freed while the LXPool lives, so handles to them stay valid.
+struct PoolSlot {
+    PoolKey key;
+    uint64_t currency0_hash = 0; // Flash-accounting keys, hashed once at initialize
+    uint64_t currency1_hash = 0;
+    IHooks* hooks = nullptr;     // Resolved at initialize, fixed for the pool's life
+    uint16_t hook_flags = 0;     // hook_flags:: bits the pool calls; 0 = no hooks
+    mutable std::shared_mutex mutex;
+    PoolState state;
+    uint64_t liquidity_version = 0;  // Bumped by modify_liquidity
+
+    // Last depth profile served; taken after `mutex`
+    mutable std::mutex depth_mutex;
+    mutable std::shared_ptr<const DepthProfile> depth_profile;
+};
+
+// Resolved reference to an initialized pool, for hot paths that would
+// otherwise hash the PoolKey on every call. Empty if the pool was missing.
+class PoolHandle {
+public:
+    PoolHandle() = default;
+
+    explicit operator bool() const { return slot_ != nullptr; }
+    const PoolKey& key() const { return slot_->key; }
+
+private:
+    friend class LXPool;
+    explicit PoolHandle(PoolSlot* slot) : slot_(slot) {}
+
+    PoolSlot* slot_ = nullptr;
+};
+
 // =============================================================================
 // Flash Context (explicit accounting state for lock operations)
 // =============================================================================
 
+// Per-currency deltas of one lock(), keyed by currency hash. A lock almost
+// always touches a handful of currencies, so the first INLINE_CAPACITY
+// live in a flat array searched linearly and only further ones spill to
+// a map; typical lock() calls never allocate.
+class CurrencyDeltas {
+public:
+    static constexpr size_t INLINE_CAPACITY = 8;
+
+    // Delta for `currency`, created at zero
+    I128& operator[](uint64_t currency) {
+        for (size_t i = 0; i < count_; ++i) {
+            if (keys_[i] == currency) return values_[i];
+        }
+        if (count_ < INLINE_CAPACITY) {
+            keys_[count_] = currency;
+            values_[count_] = 0;
+            return values_[count_++];
+        }
+        return overflow_[currency];
+    }
+
+    bool all_zero() const {
+        for (size_t i = 0; i < count_; ++i) {
+            if (values_[i] != 0) return false;
+        }
+        for (const auto& [currency, delta] : overflow_) {
+            if (delta != 0) return false;
+        }
+        return true;
+    }
+
+    size_t size() const { return count_ + overflow_.size(); }
+
+    void clear() {
+        count_ = 0;
+        overflow_.clear();
+    }
+
+private:
+    uint64_t keys_[INLINE_CAPACITY];
+    I128 values_[INLINE_CAPACITY];
+    size_t count_ = 0;
+    std::unordered_map<uint64_t, I128> overflow_;
+};
+
 struct FlashContext {
-    std::unordered_map<uint64_t, I128> currency_deltas;
+    CurrencyDeltas currency_deltas;
     bool locked = false;
 
     void reset() {
@@ -103,6 +240,30 @@ public:
 // Null hooks (no-op)
 class NullHooks : public IHooks {};
 
+// Hook capability bits, as Uniswap v4 encodes them in the low bits of the
+// hook address. A pool only makes the calls whose bit is set, so pools
+// without hooks (or with NullHooks) skip the virtual dispatch entirely.
+// before/after_modify_liquidity run for adds or removes per the sign of
+// the liquidity delta.
+namespace hook_flags {
+constexpr uint16_t BEFORE_INITIALIZE       = 1 << 13;
+constexpr uint16_t AFTER_INITIALIZE        = 1 << 12;
+constexpr uint16_t BEFORE_ADD_LIQUIDITY    = 1 << 11;
+constexpr uint16_t AFTER_ADD_LIQUIDITY     = 1 << 10;
+constexpr uint16_t BEFORE_REMOVE_LIQUIDITY = 1 << 9;
+constexpr uint16_t AFTER_REMOVE_LIQUIDITY  = 1 << 8;
+constexpr uint16_t BEFORE_SWAP             = 1 << 7;
+constexpr uint16_t AFTER_SWAP              = 1 << 6;
+constexpr uint16_t BEFORE_DONATE           = 1 << 5;
+constexpr uint16_t AFTER_DONATE            = 1 << 4;
+constexpr uint16_t ALL                     = 0x3FF0;
+
+// Bits encoded in a hook address (its last two bytes)
+inline uint16_t from_address(const Address& addr) {
+    return static_cast<uint16_t>(((addr[18] << 8) | addr[19]) & ALL);
+}
+} // namespace hook_flags
+
 // =============================================================================
 // LXPool - Uniswap v4-style AMM Pool Manager
 // =============================================================================
@@ -138,12 +299,24 @@ public:
     BalanceDelta donate(const PoolKey& key, I128 amount0, I128 amount1,
                         const std::vector<uint8_t>& hook_data = {});
 
+    // Resolve a pool once; the handle overloads below skip the lookup
+    PoolHandle find_pool(const PoolKey& key) const;
+
+    BalanceDelta swap(PoolHandle pool, const SwapParams& params,
+                      const std::vector<uint8_t>& hook_data = {});
+    BalanceDelta modify_liquidity(PoolHandle pool, const ModifyLiquidityParams& params,
+                                  const std::vector<uint8_t>& hook_data = {});
+    BalanceDelta donate(PoolHandle pool, I128 amount0, I128 amount1,
+                        const std::vector<uint8_t>& hook_data = {});
+
     // =========================================================================
     // Flash Accounting (Uniswap v4 transient storage pattern)
     // =========================================================================
 
-    // Lock the pool manager for a flash operation
-    // Uses member variables for delta tracking (simpler than FlashContext parameter)
+    // Run a flash operation. Its currency deltas live in a FlashContext
+    // owned by this call and found through a thread-local, so concurrent
+    // lock() calls on other threads keep separate books. Operations in the
+    // callback record into it; all deltas must net to zero on return.
     using LockCallback = std::function<void()>;
     void lock(LockCallback callback);
 
@@ -180,6 +353,41 @@ public:
     // Check if pool exists
     bool pool_exists(const PoolKey& key) const;
 
+    std::optional<Slot0> get_slot0(PoolHandle pool) const;
+    std::optional<I128> get_liquidity(PoolHandle pool) const;
+
+    // Depth in `levels` steps of `step_ticks` each way from the current
+    // price, steps aligned to multiples of step_ticks. Served from a cached
+    // liquidity profile, so polling between liquidity changes and large
+    // price moves costs one pass over the steps. Empty if no pool.
+    std::optional<PoolDepth> get_depth(const PoolKey& key, int32_t step_ticks, size_t levels) const;
+    std::optional<PoolDepth> get_depth(PoolHandle pool, int32_t step_ticks, size_t levels) const;
+
+    // =========================================================================
+    // Quoting (read-only swap simulation, hooks not called)
+    // =========================================================================
+
+    // Quote a swap of each size in `amounts_specified` (signed as in
+    // SwapParams), returned in input order. Sizes share one walk of the
+    // tick range: each step is computed once for every size that passes
+    // through it, plus one final step per size. Empty if no pool.
+    std::vector<SwapQuote> quote_swaps(const PoolKey& key, bool zero_for_one,
+                                       const std::vector<I128>& amounts_specified,
+                                       I128 sqrt_price_limit = 0) const;
+    std::vector<SwapQuote> quote_swaps(PoolHandle pool, bool zero_for_one,
+                                       const std::vector<I128>& amounts_specified,
+                                       I128 sqrt_price_limit = 0) const;
+
+    // Quote the exact-input swap that moves the price to sqrt_price_target_x96
+    std::optional<SwapQuote> quote_to_price(const PoolKey& key, bool zero_for_one,
+                                            I128 sqrt_price_target_x96) const;
+
+    // Same walk on a pool state the caller holds, e.g. a copy
+    static std::vector<SwapQuote> quote_swaps(const PoolKey& key, const PoolState& pool,
+                                              bool zero_for_one,
+                                              const std::vector<I128>& amounts_specified,
+                                              I128 sqrt_price_limit = 0);
+
     // =========================================================================
     // Protocol Fee Management
     // =========================================================================
@@ -191,9 +399,21 @@ public:
     // Hook Registration
     // =========================================================================
 
+    // Pools bind their hooks when initialized: register before creating
+    // pools that name hook_addr, and keep the hooks alive while those pools
+    // exist. The capability bits come from the address unless declared.
+    // Unregistering only affects pools initialized afterwards.
     void register_hooks(const Address& hook_addr, IHooks* hooks);
+    void register_hooks(const Address& hook_addr, IHooks* hooks, uint16_t flags);
     void unregister_hooks(const Address& hook_addr);
 
+    // Called with a pool's active liquidity after it is initialized, after
+    // modify_liquidity, and after a swap that crossed liquidity. Runs
+    // outside the pool's lock on the updating thread; set it before pools
+    // are created.
+    using LiquidityListener = std::function<void(const PoolKey& key, I128 liquidity)>;
+    void set_liquidity_listener(LiquidityListener listener);
+
     // =========================================================================
     // Statistics
     // =========================================================================
@@ -208,26 +428,38 @@ public:
     Stats get_stats() const;
 
 private:
-    // Pool storage: pool_id -> state
-    std::unordered_map<uint64_t, PoolState> pools_;
+    // Pool storage: pool_id -> slot. pools_mutex_ serialises creation;
+    // lookups go through the lock-free directory and then the slot's lock.
+    std::unordered_map<uint64_t, std::unique_ptr<PoolSlot>> pools_;
+    SymbolDirectory<PoolSlot> directory_;
     mutable std::shared_mutex pools_mutex_;
 
     // Hook registry
-    std::unordered_map<uint64_t, IHooks*> hooks_;  // hash(address) -> hooks
+    struct RegisteredHooks {
+        IHooks* hooks;
+        uint16_t flags;
+    };
+    std::unordered_map<uint64_t, RegisteredHooks> hooks_;  // hash(address) -> hooks
     mutable std::shared_mutex hooks_mutex_;
 
-    // Flash accounting state
-    bool locked_{false};
-    std::unordered_map<uint64_t, I128> currency_deltas_;  // currency_hash -> delta
+    LiquidityListener liquidity_listener_;
 
     // Statistics
     std::atomic<uint64_t> total_swaps_{0};
     std::atomic<uint64_t> total_liquidity_ops_{0};
 
     // Internal helpers
-    PoolState* get_pool(const PoolKey& key);
-    const PoolState* get_pool(const PoolKey& key) const;
-    IHooks* get_hooks(const PoolKey& key);
+    PoolSlot* get_pool(const PoolKey& key) const;
+    RegisteredHooks get_hooks(const PoolKey& key) const;
+
+    // Flash context of the lock() running on this thread, if any
+    FlashContext* active_context() const;
+
+    // Operations on a resolved pool; deltas go to ctx when it is locked
+    BalanceDelta swap_in_pool(PoolSlot* slot, const SwapParams& params, FlashContext* ctx);
+    BalanceDelta modify_liquidity_in_pool(PoolSlot* slot, const ModifyLiquidityParams& params,
+                                          FlashContext* ctx);
+    BalanceDelta donate_to_pool(PoolSlot* slot, I128 amount0, I128 amount1, FlashContext* ctx);
 
     // Tick math
     static int32_t get_tick_at_sqrt_ratio(I128 sqrt_price_x96);
@@ -245,8 +477,30 @@ private:
         int32_t tick;
         I128 liquidity;
     };
-    SwapState compute_swap_step(SwapState state, I128 sqrt_price_target_x96,
-                                 uint32_t fee_pips, bool zero_for_one);
+    static SwapState compute_swap_step(SwapState state, I128 sqrt_price_target_x96,
+                                        uint32_t fee_pips, bool zero_for_one);
+
+    // Where the next swap step stops: the next initialized tick in the swap
+    // direction (snapped to the spacing), clamped to the price limit
+    struct StepTarget {
+        int32_t next_tick;
+        bool initialized;
+        I128 sqrt_price_next_x96;
+        I128 sqrt_price_target_x96;
+    };
+    static StepTarget next_step_target(const PoolKey& key, const PoolState& pool,
+                                       const SwapState& state, I128 sqrt_price_limit,
+                                       bool zero_for_one);
+
+    // Liquidity profile for get_depth around the pool's current tick
+    static std::shared_ptr<const DepthProfile> build_depth_profile(
+        const PoolState& pool, int32_t step_ticks, size_t levels, uint64_t version);
+
+    // Default and validate a swap's price limit; 0 if it is on the wrong side
+    static I128 resolve_price_limit(const Slot0& slot0, bool zero_for_one, I128 sqrt_price_limit);
+
+    // Balance delta of a finished swap
+    static BalanceDelta swap_delta(bool zero_for_one, I128 amount_specified, const SwapState& state);
 };
 
 // =============================================================================
@@ -260,44 +514,209 @@ constexpr int32_t MIN_TICK = -887272;
 constexpr int32_t MAX_TICK = 887272;
 
 // Minimum and maximum sqrt ratios (Q64.96)
-// These are: sqrt(1.0001^MIN_TICK) and sqrt(1.0001^MAX_TICK) * 2^96
-const I128 MIN_SQRT_RATIO = 4295128739LL;
-// MAX_SQRT_RATIO: sqrt(1.0001^887272) * 2^96
-// Computed dynamically to avoid literal overflow in C++
-inline I128 max_sqrt_ratio() {
-    // Value: 1461446703485210103287273052203988822378723970342
-    // Split into parts that fit in 64-bit: high * 2^128 would overflow
-    // Use smaller decomposition: compute from tick at runtime
-    double val = std::pow(1.0001, MAX_TICK / 2.0);
-    double scaled = val * static_cast<double>(1ULL << 48) * static_cast<double>(1ULL << 48);
-    return static_cast<I128>(scaled);
+// MIN_SQRT_RATIO is sqrt(1.0001^MIN_TICK) * 2^96. The true ratio at MAX_TICK
+// (~1.46e48) does not fit in I128, so prices saturate at the largest
+// representable Q64.96 value, reached around tick 429,700.
+constexpr I128 MIN_SQRT_RATIO = 4295128739LL;
+constexpr I128 MAX_SQRT_RATIO = static_cast<I128>(~U128{0} >> 1);
+
+inline I128 max_sqrt_ratio() { return MAX_SQRT_RATIO; }
+
+// Both conversions are exact integer code, so every node computes the same
+// ticks and prices. The ratio at a tick is a product of powers of
+// sqrt(1.0001), each a 128-bit mantissa and a binary exponent, looked up by
+// the low, middle and high bits of |tick| in tables built at compile time
+// from sqrt(1.0001)^(+-2^i). The tick at a ratio is Uniswap v3's bit-by-bit
+// log2 (14 fractional bits) scaled to log base sqrt(1.0001), with the
+// one-tick ambiguity resolved against get_sqrt_ratio_at_tick.
+namespace detail {
+
+struct Wide {
+    U128 hi;
+    U128 lo;
+};
+
+// Full 256-bit product of two 128-bit values
+constexpr Wide mul_wide(U128 a, U128 b) {
+    const uint64_t a0 = static_cast<uint64_t>(a), a1 = static_cast<uint64_t>(a >> 64);
+    const uint64_t b0 = static_cast<uint64_t>(b), b1 = static_cast<uint64_t>(b >> 64);
+    const U128 p00 = static_cast<U128>(a0) * b0, p01 = static_cast<U128>(a0) * b1;
+    const U128 p10 = static_cast<U128>(a1) * b0, p11 = static_cast<U128>(a1) * b1;
+    const U128 mid = (p00 >> 64) + static_cast<uint64_t>(p01) + static_cast<uint64_t>(p10);
+    return {p11 + (p01 >> 64) + (p10 >> 64) + (mid >> 64), (mid << 64) | static_cast<uint64_t>(p00)};
 }
-const I128 MAX_SQRT_RATIO = max_sqrt_ratio();
 
-// Get tick at sqrt ratio
-inline int32_t get_tick_at_sqrt_ratio(I128 sqrt_price_x96) {
-    // Simplified: log_1.0001(price) where price = (sqrt_price / 2^96)^2
-    // tick = log(price) / log(1.0001)
-    if (sqrt_price_x96 <= MIN_SQRT_RATIO) return MIN_TICK;
-    if (sqrt_price_x96 >= MAX_SQRT_RATIO) return MAX_TICK;
+constexpr U128 u128(uint64_t hi, uint64_t lo) {
+    return (static_cast<U128>(hi) << 64) | lo;
+}
+
+// value = mantissa * 2^(exponent - 127), mantissa in [2^127, 2^128); 1.0 by default
+struct Power {
+    U128 mantissa = U128{1} << 127;
+    int32_t exponent = 0;
+};
+
+// Product truncated to 128 bits; exact when either side is 1.0
+constexpr Power multiply(Power a, Power b) {
+    const Wide p = mul_wide(a.mantissa, b.mantissa);
+    const uint32_t carry = static_cast<uint32_t>(p.hi >> 127);  // Product in [2^254, 2^256)
+    Power out;
+    out.mantissa = carry ? p.hi : (p.hi << 1) | (p.lo >> 127);
+    out.exponent = a.exponent + b.exponent + static_cast<int32_t>(carry);
+    return out;
+}
+
+struct Factor {
+    uint64_t hi;
+    uint64_t lo;
+    int32_t exponent;
+};
+
+// sqrt(1.0001)^(2^i)
+constexpr Factor UP[20] = {
+    {0x8001a36b7f88b395ULL, 0x72ad6807ae1c2b2eULL, 0},
+    {0x800346dc5d638865ULL, 0x94af4f0d844d013bULL, 0},
+    {0x80068dce3455f2fbULL, 0xb5987dbac0dba7dcULL, 0},
+    {0x800d1bf2511a6584ULL, 0x1828b728ca2850a3ULL, 0},
+    {0x801a393c55874956ULL, 0xd12d5a300c93cfc8ULL, 0},
+    {0x803477d805292a40ULL, 0x52ebfee1667accc8ULL, 0},
+    {0x80690531da0b9c1cULL, 0xefced552b4221673ULL, 0},
+    {0x80d2608e3a16ebb9ULL, 0x4b9c6faf4b31cb78ULL, 0},
+    {0x81a61ae18fb267d3ULL, 0x6e06b6f21e8440eaULL, 0},
+    {0x8351a5bc64557fdfULL, 0xc0df6ad19587e73aULL, 0},
+    {0x86b953523666c5e7ULL, 0x4d73b8d8b14a53f5ULL, 0},
+    {0x8dcd12c731c942cbULL, 0x6e3abfd5198aa6fbULL, 0},
+    {0x9d1715ed027c1bcfULL, 0x9e68bdf2e1a1ea29ULL, 0},
+    {0xc0caa5f34f06d47fULL, 0x3bf955a1743e7a89ULL, 0},
+    {0x91309957461680a4ULL, 0x20094a1dc24187ddULL, 1},
+    {0xa4b02ddd73f26b63ULL, 0x8c2cef3d00fc4c96ULL, 2},
+    {0xd3e46805aa8b427fULL, 0xa698d703280dc0fdULL, 4},
+    {0xaf624f42cb7df25eULL, 0x21164319b378f463ULL, 9},
+    {0xf04f1c3c33c8919fULL, 0x172ba42a5b99e825ULL, 18},
+    {0xe1946d63515d4050ULL, 0x5bfab78c64e886deULL, 37},
+};
+
+// sqrt(1.0001)^(-2^i)
+constexpr Factor DOWN[20] = {
+    {0xfffcb933bd6fad37ULL, 0xaa2d162d1a594001ULL, -1},
+    {0xfff97272373d4132ULL, 0x59a46990580e213aULL, -1},
+    {0xfff2e50f5f656932ULL, 0xef12357cf3c7fdccULL, -1},
+    {0xffe5caca7e10e4e6ULL, 0x1c3624eaa0941cd0ULL, -1},
+    {0xffcb9843d60f6159ULL, 0xc9db58835c926644ULL, -1},
+    {0xff973b41fa98c081ULL, 0x472e6896dfb254c0ULL, -1},
+    {0xff2ea16466c96a38ULL, 0x43ec78b326b52861ULL, -1},
+    {0xfe5dee046a99a2a8ULL, 0x11c461f1969c3053ULL, -1},
+    {0xfcbe86c7900a88aeULL, 0xdcffc83b479aa3a4ULL, -1},
+    {0xf987a7253ac41317ULL, 0x6f2b074cf7815e54ULL, -1},
+    {0xf3392b0822b70005ULL, 0x940c7a398e4b70f3ULL, -1},
+    {0xe7159475a2c29b74ULL, 0x43b29c7fa6e889d9ULL, -1},
+    {0xd097f3bdfd2022b8ULL, 0x845ad8f792aa5825ULL, -1},
+    {0xa9f746462d870fdfULL, 0x8a65dc1f90e061e5ULL, -1},
+    {0xe1b0d342ada54371ULL, 0x21767bec575e65eeULL, -2},
+    {0xc6f84d7e5f423f66ULL, 0x048c541550bf3e96ULL, -3},
+    {0x9aa508b5b7a84e1cULL, 0x677de54f3e99bc90ULL, -5},
+    {0xbad5f1bdb70232cdULL, 0x33865244bdcc089cULL, -10},
+    {0x885b9613d7e87aa4ULL, 0x98106fb7fa5edd37ULL, -19},
+    {0x9142e0723efb8848ULL, 0x89d1f447715afacdULL, -38},
+};
+
+// Powers for |tick| bits 0-7, 8-15 and 16-19, each entry the product of the
+// factors for the set bits of its index
+struct PowerTable {
+    Power low[256];
+    Power mid[256];
+    Power high[16];
+};
+
+constexpr PowerTable make_power_table(const Factor (&factors)[20]) {
+    PowerTable table;
+    Power* levels[3] = {table.low, table.mid, table.high};
+    for (int level = 0; level < 3; ++level) {
+        const int size = level < 2 ? 256 : 16;
+        for (int k = 1; k < size; ++k) {
+            int bit = 0;
+            while (((k >> bit) & 1) == 0) ++bit;
+            const Factor& f = factors[level * 8 + bit];
+            Power factor;
+            factor.mantissa = u128(f.hi, f.lo);
+            factor.exponent = f.exponent;
+            levels[level][k] = multiply(levels[level][k & (k - 1)], factor);
+        }
+    }
+    return table;
+}
+
+inline constexpr PowerTable UP_POWERS = make_power_table(UP);
+inline constexpr PowerTable DOWN_POWERS = make_power_table(DOWN);
+
+// log2 scaled to log base sqrt(1.0001), Q128.128 per Q64.64 input
+constexpr U128 LOG_SQRT10001 = u128(0x3627ULL, 0xa301d71055774c85ULL);
+// Error bounds of the 14-bit log2 estimate, in Q128.128 ticks
+constexpr U128 TICK_LOW_ERROR = u128(0x028f6481ab7f045aULL, 0x5af012a19d003aaaULL);
+constexpr U128 TICK_HIGH_ERROR = u128(0xdb2df09e81959a81ULL, 0x455e260799a0632fULL);
 
-    // Convert to double for computation (production would use fixed-point)
-    double sqrt_price = static_cast<double>(sqrt_price_x96) / static_cast<double>(1ULL << 48);
-    sqrt_price /= static_cast<double>(1ULL << 48);  // Total: 2^96
-    double price = sqrt_price * sqrt_price;
-    double tick_d = std::log(price) / std::log(1.0001);
-    return static_cast<int32_t>(std::floor(tick_d));
+inline int clz128(U128 x) {
+    const uint64_t hi = static_cast<uint64_t>(x >> 64);
+    return hi != 0 ? __builtin_clzll(hi) : 64 + __builtin_clzll(static_cast<uint64_t>(x));
 }
 
+} // namespace detail
+
 // Get sqrt ratio at tick
 inline I128 get_sqrt_ratio_at_tick(int32_t tick) {
     if (tick < MIN_TICK || tick > MAX_TICK) return 0;
 
-    // sqrt_price = sqrt(1.0001^tick)
-    double sqrt_price = std::pow(1.0001, tick / 2.0);
-    // Convert to Q64.96
-    double scaled = sqrt_price * static_cast<double>(1ULL << 48) * static_cast<double>(1ULL << 48);
-    return static_cast<I128>(scaled);
+    const detail::PowerTable& powers = tick < 0 ? detail::DOWN_POWERS : detail::UP_POWERS;
+    const uint32_t abs_tick = tick < 0 ? static_cast<uint32_t>(-tick) : static_cast<uint32_t>(tick);
+    const detail::Power power = detail::multiply(
+        detail::multiply(powers.low[abs_tick & 0xFF], powers.mid[(abs_tick >> 8) & 0xFF]),
+        powers.high[abs_tick >> 16]);
+    const U128 m = power.mantissa;
+    const int32_t e = power.exponent;
+
+    // Q64.96 is m * 2^(e - 31), rounded up; MIN_TICK keeps the shift below 128
+    if (e >= 31) return MAX_SQRT_RATIO;
+    const int shift = 31 - e;
+    U128 ratio = m >> shift;
+    if ((m & ((U128{1} << shift) - 1)) != 0) ++ratio;
+    return ratio > static_cast<U128>(MAX_SQRT_RATIO) ? MAX_SQRT_RATIO : static_cast<I128>(ratio);
+}
+
+// Get tick at sqrt ratio: greatest tick whose ratio is <= sqrt_price_x96
+inline int32_t get_tick_at_sqrt_ratio(I128 sqrt_price_x96) {
+    if (sqrt_price_x96 <= MIN_SQRT_RATIO) return MIN_TICK;
+    if (sqrt_price_x96 >= MAX_SQRT_RATIO) return MAX_TICK;
+
+    // Integer part of log2 from the most significant bit, then square the
+    // mantissa, normalized to [2^63, 2^64), once per fraction bit. 64 bits
+    // of mantissa keep the estimate within the error bounds below.
+    const U128 x = static_cast<U128>(sqrt_price_x96);
+    const int msb = 127 - detail::clz128(x);
+    uint64_t r = static_cast<uint64_t>((x << (127 - msb)) >> 64);
+    I128 log_2 = static_cast<I128>(msb - 96) * (I128{1} << 64);  // Q64.64
+    for (int bit = 63; bit >= 50; --bit) {
+        const U128 sq = static_cast<U128>(r) * r;
+        const uint32_t f = static_cast<uint32_t>(sq >> 127);
+        r = static_cast<uint64_t>(sq >> (63 + f));
+        log_2 |= static_cast<I128>(f) << bit;
+    }
+
+    // Signed 256-bit log_2 * LOG_SQRT10001
+    const bool negative = log_2 < 0;
+    detail::Wide p = detail::mul_wide(negative ? static_cast<U128>(-log_2) : static_cast<U128>(log_2),
+                                      detail::LOG_SQRT10001);
+    if (negative) {
+        p.lo = ~p.lo + 1;
+        p.hi = ~p.hi + (p.lo == 0 ? 1 : 0);
+    }
+
+    // Only the high halves are needed: floor(x / 2^128) after the borrow or carry
+    const U128 low_hi = p.hi - (p.lo < detail::TICK_LOW_ERROR ? 1 : 0);
+    const U128 high_hi = p.hi + (p.lo + detail::TICK_HIGH_ERROR < p.lo ? 1 : 0);
+    const int32_t tick_low = static_cast<int32_t>(static_cast<I128>(low_hi));
+    const int32_t tick_high = static_cast<int32_t>(static_cast<I128>(high_hi));
+    if (tick_low == tick_high) return tick_low;
+    return get_sqrt_ratio_at_tick(tick_high) <= sqrt_price_x96 ? tick_high : tick_low;
 }
 
 } // namespace tick_math
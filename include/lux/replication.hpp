@@ -0,0 +1,144 @@
+#ifndef LUX_REPLICATION_HPP
+#define LUX_REPLICATION_HPP
+
+#include <atomic>
+#include <chrono>
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <thread>
+#include <vector>
+
+#include "journal.hpp"
+
+namespace lux {
+
+class Engine;
+
+// =============================================================================
+// Journal Replication
+// =============================================================================
+//
+// Read scaling and warm standbys from the write-ahead journal. A primary
+// serves its journal file over TCP: each connected replica gets its own
+// thread and its own read-only mapping of the file, and is streamed the
+// committed records past the sequence it asked for, so the matching thread
+// does nothing beyond the commits it already makes. A replica applies the
+// records in sequence to a local Engine (Engine::apply_replicated), whose
+// books then answer depth, top-of-book and order queries, and whose event
+// ring and trade listener, if configured, republish the market data.
+//
+// Lag is counted in sequence numbers: each frame carries the primary's
+// committed sequence, and replicas acknowledge what they have applied.
+// A replica that also journals writes the same records under the same
+// sequences, so on failover it is promoted (promote()) and serves as the
+// next primary from its own journal.
+//
+// Frames are raw JournalRecords, so both ends must run the same build; the
+// handshake checks the record size. Serves a non-sharded engine's journal
+// (shard journals are sequenced per file).
+
+struct ReplicationConfig {
+    size_t max_batch = 256;                                 // Records per frame
+    std::chrono::milliseconds poll_interval{1};             // Journal polling when caught up
+    std::chrono::milliseconds heartbeat_interval{100};      // Empty frames to idle replicas
+    std::chrono::milliseconds reconnect_interval{100};      // Replica retry after a drop
+};
+
+// Serves one journal file to any number of replicas
+class ReplicationPrimary {
+public:
+    // Listens on port (0 = pick one, see port()). Returns nullptr if the
+    // journal cannot be opened or the port cannot be bound.
+    static std::unique_ptr<ReplicationPrimary> start(const std::string& journal_path, uint16_t port,
+                                                     ReplicationConfig config = {});
+    ~ReplicationPrimary();
+
+    ReplicationPrimary(const ReplicationPrimary&) = delete;
+    ReplicationPrimary& operator=(const ReplicationPrimary&) = delete;
+
+    uint16_t port() const { return port_; }
+
+    // Disconnects every replica and stops listening
+    void stop();
+
+    struct ReplicaStatus {
+        uint64_t sent_sequence;     // Last record streamed
+        uint64_t acked_sequence;    // Last record the replica applied
+        bool connected;
+    };
+    std::vector<ReplicaStatus> replicas() const;     // Dropped replicas go on the next accept
+    uint64_t committed_sequence() const;
+
+private:
+    struct Session {
+        int fd;
+        std::thread thread;
+        std::atomic<uint64_t> sent{0};
+        std::atomic<uint64_t> acked{0};
+        std::atomic<bool> connected{true};
+    };
+
+    ReplicationPrimary(std::string journal_path, int listen_fd, uint16_t port,
+                       ReplicationConfig config);
+    void accept_loop();
+    void serve(Session& session);
+
+    std::string journal_path_;
+    int listen_fd_;
+    uint16_t port_;
+    ReplicationConfig config_;
+    std::unique_ptr<JournalReader> status_reader_;      // For committed_sequence(), under sessions_mutex_
+    std::atomic<bool> running_{true};
+    std::thread accept_thread_;
+    mutable std::mutex sessions_mutex_;
+    std::vector<std::unique_ptr<Session>> sessions_;
+};
+
+// Follows a primary into a local Engine. The engine must be non-sharded
+// and is driven only by the replica until promote(); query it freely.
+class EngineReplica {
+public:
+    // Streams records after after_sequence (e.g. the engine's own
+    // journal_sequence() when it restarts from a mirrored journal),
+    // reconnecting whenever the connection drops
+    EngineReplica(Engine& engine, std::string host, uint16_t port, uint64_t after_sequence = 0,
+                  ReplicationConfig config = {});
+    ~EngineReplica();
+
+    EngineReplica(const EngineReplica&) = delete;
+    EngineReplica& operator=(const EngineReplica&) = delete;
+
+    uint64_t applied_sequence() const { return applied_.load(std::memory_order_acquire); }
+    uint64_t primary_sequence() const { return primary_.load(std::memory_order_acquire); }
+    uint64_t lag() const {
+        const uint64_t primary = primary_sequence(), applied = applied_sequence();
+        return primary > applied ? primary - applied : 0;
+    }
+    bool connected() const { return connected_.load(std::memory_order_acquire); }
+
+    // Stops following and returns the books to the engine clock; the
+    // engine then takes inputs as a primary. Everything applied so far
+    // stays; records the old primary committed later are not fetched.
+    void promote();
+
+private:
+    void run();
+    void follow(int fd);
+
+    Engine& engine_;
+    std::string host_;
+    uint16_t port_;
+    ReplicationConfig config_;
+    std::atomic<uint64_t> applied_;
+    std::atomic<uint64_t> primary_{0};
+    std::atomic<bool> connected_{false};
+    std::atomic<bool> running_{true};
+    std::thread thread_;
+};
+
+} // namespace lux
+
+#endif // LUX_REPLICATION_HPP
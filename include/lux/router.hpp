@@ -0,0 +1,109 @@
+#ifndef LUX_ROUTER_HPP
+#define LUX_ROUTER_HPP
+
+// =============================================================================
+// LXRouter - multi-hop swap routing over LXPool (LP-9012)
+//
+// The router keeps a token graph of every initialized pool, all fee tiers,
+// fed by LXPool's liquidity listener so nothing is rebuilt per request. A
+// route request walks the graph for simple paths of up to max_hops pools,
+// quotes each candidate's depth curve with the read-only batched quoter
+// (one quote_swaps call per hop), and hands the input out in equal parts
+// to whichever pool-disjoint path gives the most for the next part, so a
+// large order spreads its price impact across venues. Pools with hooks
+// are left out: the quoter does not run hooks, so their quotes could not
+// be trusted.
+// =============================================================================
+
+#include <cstddef>
+#include <cstdint>
+#include <shared_mutex>
+#include <unordered_map>
+#include <vector>
+
+#include "pool.hpp"
+#include "types.hpp"
+
+namespace lux {
+
+struct RouterConfig {
+    size_t max_hops = 3;        // Pools per path
+    size_t max_paths = 8;       // Candidate paths quoted per request
+    size_t split_parts = 10;    // Input granularity for splitting; 1 = single path
+};
+
+struct RouteHop {
+    PoolHandle pool;
+    bool zero_for_one;
+};
+
+// One leg of a route: a path and the share of the input it takes
+struct RoutePath {
+    std::vector<RouteHop> hops;
+    I128 amount_in_x18 = 0;
+    I128 amount_out_x18 = 0;    // Quoted
+};
+
+struct Route {
+    std::vector<RoutePath> paths;   // Pool-disjoint
+    I128 amount_in_x18 = 0;
+    I128 amount_out_x18 = 0;        // Quoted total
+};
+
+class LXRouter {
+public:
+    explicit LXRouter(LXPool& pool, const RouterConfig& config = {});
+
+    // Non-copyable
+    LXRouter(const LXRouter&) = delete;
+    LXRouter& operator=(const LXRouter&) = delete;
+
+    // Add a pool to the graph or refresh its liquidity; LX wires this to
+    // the pool manager's liquidity listener
+    void on_pool_update(const PoolKey& key, I128 liquidity);
+
+    // Best quoted exact-input route; no paths if the tokens are not connected
+    Route find_route(const Currency& token_in, const Currency& token_out,
+                     I128 amount_in_x18) const;
+
+    // Swap each path hop by hop; returns the token_out actually received
+    I128 execute(const Route& route);
+
+    size_t pool_count() const;
+    size_t token_count() const;
+
+    const RouterConfig& config() const { return config_; }
+
+private:
+    // A pool seen from one of its tokens
+    struct Edge {
+        PoolHandle pool;
+        uint64_t pool_id;
+        uint64_t to;            // Token hash
+        bool zero_for_one;
+        I128 liquidity;
+    };
+
+    // Output after each of split_parts equal input parts, for one path
+    struct Candidate {
+        std::vector<RouteHop> hops;
+        std::vector<uint64_t> pool_ids;
+        std::vector<I128> curve;
+    };
+
+    LXPool& pool_;
+    RouterConfig config_;
+
+    // token hash -> edges out of it
+    std::unordered_map<uint64_t, std::vector<Edge>> graph_;
+    std::unordered_map<uint64_t, I128> pools_;   // pool id -> active liquidity
+    mutable std::shared_mutex graph_mutex_;
+
+    std::vector<Candidate> find_paths(uint64_t from, uint64_t to) const;
+    std::vector<I128> quote_path(const std::vector<RouteHop>& hops,
+                                 const std::vector<I128>& amounts_in) const;
+};
+
+} // namespace lux
+
+#endif // LUX_ROUTER_HPP
@@ -0,0 +1,123 @@
+#ifndef LUX_SETTLEMENT_HPP
+#define LUX_SETTLEMENT_HPP
+
+// =============================================================================
+// Settlement Pipeline - asynchronous LXBook -> LXVault fill settlement
+//
+// Matching threads publish trades into a bounded MPSC ring and return. A
+// settlement worker drains the ring in batches, nets fills between the same
+// account pair on the same market into one settlement, and hands the batch
+// to the vault. Every published trade gets a sequence number; the settled
+// watermark tells risk checks how far settlement has caught up.
+// =============================================================================
+
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <functional>
+#include <optional>
+#include <thread>
+#include <vector>
+
+#include "mpsc_ring.hpp"
+#include "trade.hpp"
+#include "vault.hpp"
+
+namespace lux {
+
+struct SettlementConfig {
+    size_t queue_capacity = 65536;  // Trades in flight before back-pressure
+    size_t max_batch = 1024;        // Trades drained per vault call
+    bool net_fills = true;          // Merge fills per (market, maker, taker, side)
+    bool net_accounts = false;      // Settle through LXVault::apply_fills_netted
+};
+
+// Vault account behind a trade's engine account id (buyer_account_id /
+// seller_account_id), e.g. LXBook::get_account
+using AccountResolver = std::function<std::optional<LXAccount>(uint64_t account_id)>;
+
+// Vault settlement for a single trade, with the default fee schedule. The
+// aggressor is the taker. Ids the resolver does not know (or every id,
+// without one) become subaccount (id & 0xFFFF) of the zero address.
+LXSettlement settlement_from_trade(const Trade& trade, const AccountResolver& resolver = {});
+
+class SettlementPipeline {
+public:
+    SettlementPipeline(LXVault& vault, const SettlementConfig& config = {});
+    ~SettlementPipeline();
+
+    // Non-copyable
+    SettlementPipeline(const SettlementPipeline&) = delete;
+    SettlementPipeline& operator=(const SettlementPipeline&) = delete;
+
+    // Maps trade account ids to vault accounts; set before start()
+    void set_account_resolver(AccountResolver resolver) { resolver_ = std::move(resolver); }
+
+    // Lifecycle; stop() settles everything already published
+    void start();
+    void stop();
+    bool is_running() const { return running_.load(std::memory_order_acquire); }
+
+    // Producer side, any thread. Returns the trade's settlement sequence
+    // (1-based), or 0 if it was dropped because the ring was full while
+    // no worker was running to make room. With a worker running a full
+    // ring blocks the caller until space frees up.
+    uint64_t publish(const Trade& trade);
+
+    // Highest sequence handed out / fully settled. Every trade with a
+    // sequence <= settled_sequence() has been applied (or rejected) by
+    // the vault.
+    uint64_t published_sequence() const { return ring_.claimed(); }
+    uint64_t settled_sequence() const { return settled_.load(std::memory_order_acquire); }
+
+    // Block until `sequence` is settled; requires a running worker
+    void wait_settled(uint64_t sequence) const;
+
+    // Settle what is queued on the calling thread. Only valid while the
+    // worker is not running (the ring has a single consumer). Returns the
+    // number of trades drained.
+    size_t drain();
+
+    struct Stats {
+        uint64_t trades_settled;        // Trades drained from the ring
+        uint64_t settlements_applied;   // Net settlements accepted by the vault
+        uint64_t settlements_rejected;  // Net settlements the vault refused
+        uint64_t batches;
+        uint64_t backpressure_waits;    // Publishes that found the ring full
+        uint64_t dropped;
+        int32_t last_error;
+    };
+    Stats get_stats() const;
+
+private:
+    void worker_loop();
+    size_t settle_batch();
+    void net(size_t count);
+    int32_t apply(const std::vector<LXSettlement>& settlements);
+
+    LXVault& vault_;
+    SettlementConfig config_;
+    AccountResolver resolver_;
+    MpscRing<Trade> ring_;
+
+    std::thread worker_;
+    std::atomic<bool> running_{false};
+    alignas(CACHE_LINE_SIZE) std::atomic<uint64_t> settled_{0};
+
+    // Consumer-owned scratch, reused across batches
+    std::vector<Trade> batch_;
+    std::vector<LXSettlement> settlements_;
+    std::vector<LXSettlement> single_;
+
+    std::atomic<uint64_t> trades_settled_{0};
+    std::atomic<uint64_t> settlements_applied_{0};
+    std::atomic<uint64_t> settlements_rejected_{0};
+    std::atomic<uint64_t> batches_{0};
+    std::atomic<uint64_t> backpressure_waits_{0};
+    std::atomic<uint64_t> dropped_{0};
+    std::atomic<int32_t> last_error_{0};
+};
+
+} // namespace lux
+
+#endif // LUX_SETTLEMENT_HPP
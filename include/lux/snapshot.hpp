@@ -0,0 +1,85 @@
+#ifndef LUX_SNAPSHOT_HPP
+#define LUX_SNAPSHOT_HPP
+
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <string>
+#include <vector>
+
+#include "order.hpp"
+#include "orderbook.hpp"
+
+namespace lux {
+
+// =============================================================================
+// Binary Snapshots
+// =============================================================================
+//
+// A snapshot file is a header followed by typed sections. Each section is
+// a fixed-size metadata block plus an array of fixed-size records, padded so
+// records stay 16-byte aligned, and a checksum of its meta block and records.
+// SnapshotReader maps the file, checks every section's bounds and checksum,
+// and hands out pointers straight into the mapping; nothing is parsed or
+// copied up front. Consumers still check meta_size and record_size against
+// the types they cast to.
+
+enum class SnapshotSectionKind : uint32_t {
+    EngineInfo = 1,     // meta: EngineSnapshotInfo, records: uint64_t shard journal sequences
+    Book = 2,           // meta: BookSnapshotHeader, records: Order (bids then asks, priority order)
+    BookMarkets = 3,    // records: BookMarketConfig
+    BookAccountOrders = 4, // records: AccountOrderRecord
+    BookTriggerOrders = 5  // records: TriggerOrder
+};
+
+struct EngineSnapshotInfo {
+    uint64_t journal_sequence;   // Last main-journal record covered by this snapshot
+};
+
+struct SnapshotSection {
+    SnapshotSectionKind kind;
+    const void* meta;
+    size_t meta_size;
+    const void* records;
+    size_t record_size;
+    size_t count;
+
+    template<typename T>
+    const T* records_as() const { return static_cast<const T*>(records); }
+};
+
+// Accumulates sections in memory and writes them with one sequential pass.
+// finish() writes to "<path>.tmp" and renames, so readers never see a torn file.
+class SnapshotWriter {
+public:
+    void add_section(SnapshotSectionKind kind, const void* meta, size_t meta_size,
+                     const void* records, size_t record_size, size_t count);
+    bool finish(const std::string& path);
+
+private:
+    std::vector<uint8_t> buffer_;
+    uint64_t section_count_{0};
+};
+
+class SnapshotReader {
+public:
+    // Returns nullptr if the file is missing, malformed or corrupt
+    static std::unique_ptr<SnapshotReader> open(const std::string& path);
+    ~SnapshotReader();
+
+    SnapshotReader(const SnapshotReader&) = delete;
+    SnapshotReader& operator=(const SnapshotReader&) = delete;
+
+    const std::vector<SnapshotSection>& sections() const { return sections_; }
+
+private:
+    SnapshotReader() = default;
+
+    void* mapping_{nullptr};
+    size_t mapped_bytes_{0};
+    std::vector<SnapshotSection> sections_;
+};
+
+} // namespace lux
+
+#endif // LUX_SNAPSHOT_HPP
@@ -0,0 +1,99 @@
+#ifndef LUX_SPSC_RING_HPP
+#define LUX_SPSC_RING_HPP
+
+#include <atomic>
+#include <cstddef>
+#include <memory_resource>
+#include <utility>
+#include <vector>
+
+namespace lux {
+
+constexpr size_t CACHE_LINE_SIZE = 64;
+
+// Bounded lock-free single-producer/single-consumer ring.
+// Exactly one thread may push and exactly one (other) thread may pop.
+// Capacity is rounded up to a power of two.
+// Slots come from `memory` (the default resource unless placed, see
+// placement.hpp).
+template<typename T>
+class SpscRing {
+public:
+    explicit SpscRing(size_t capacity,
+                      std::pmr::memory_resource* memory = std::pmr::get_default_resource())
+        : buffer_(round_up_pow2(capacity), memory), mask_(buffer_.size() - 1) {}
+
+    SpscRing(const SpscRing&) = delete;
+    SpscRing& operator=(const SpscRing&) = delete;
+
+    // Producer side; returns false if the ring is full
+    template<typename U>
+    bool try_push(U&& value) {
+        const size_t tail = tail_.load(std::memory_order_relaxed);
+        if (tail - cached_head_ == buffer_.size()) {
+            cached_head_ = head_.load(std::memory_order_acquire);
+            if (tail - cached_head_ == buffer_.size()) {
+                return false;
+            }
+        }
+        buffer_[tail & mask_] = std::forward<U>(value);
+        tail_.store(tail + 1, std::memory_order_release);
+        return true;
+    }
+
+    // Consumer side; returns false if the ring is empty
+    bool try_pop(T& out) {
+        const size_t head = head_.load(std::memory_order_relaxed);
+        if (head == cached_tail_) {
+            cached_tail_ = tail_.load(std::memory_order_acquire);
+            if (head == cached_tail_) {
+                return false;
+            }
+        }
+        out = std::move(buffer_[head & mask_]);
+        head_.store(head + 1, std::memory_order_release);
+        return true;
+    }
+
+    // Consumer side; pops up to `max` items into `out`, returns the count
+    template<typename OutputIt>
+    size_t pop_bulk(OutputIt out, size_t max) {
+        const size_t head = head_.load(std::memory_order_relaxed);
+        cached_tail_ = tail_.load(std::memory_order_acquire);
+        size_t available = cached_tail_ - head;
+        size_t count = available < max ? available : max;
+        for (size_t i = 0; i < count; ++i) {
+            *out++ = std::move(buffer_[(head + i) & mask_]);
+        }
+        head_.store(head + count, std::memory_order_release);
+        return count;
+    }
+
+    size_t size_approx() const {
+        return tail_.load(std::memory_order_acquire) - head_.load(std::memory_order_acquire);
+    }
+    bool empty_approx() const { return size_approx() == 0; }
+    size_t capacity() const { return buffer_.size(); }
+
+private:
+    static size_t round_up_pow2(size_t n) {
+        size_t p = 2;
+        while (p < n) p <<= 1;
+        return p;
+    }
+
+    std::pmr::vector<T> buffer_;
+    const size_t mask_;
+
+    // Consumer-owned line
+    alignas(CACHE_LINE_SIZE) std::atomic<size_t> head_{0};
+    size_t cached_tail_{0};
+
+    // Producer-owned line
+    alignas(CACHE_LINE_SIZE) std::atomic<size_t> tail_{0};
+    size_t cached_head_{0};
+};
+
+} // namespace lux
+
+#endif // LUX_SPSC_RING_HPP
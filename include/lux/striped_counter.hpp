@@ -0,0 +1,48 @@
+#ifndef LUX_STRIPED_COUNTER_HPP
+#define LUX_STRIPED_COUNTER_HPP
+
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+
+#include "spsc_ring.hpp"  // CACHE_LINE_SIZE
+
+namespace lux {
+
+// Monotonic counter split into cache-line-padded stripes. Each thread
+// increments the stripe it was assigned on first use, so concurrent
+// writers do not share a line; load() sums the stripes.
+template<size_t Stripes = 16>
+class StripedCounter {
+    static_assert((Stripes & (Stripes - 1)) == 0, "Stripes must be a power of two");
+
+public:
+    void add(uint64_t n = 1) {
+        stripes_[thread_stripe() & (Stripes - 1)].value.fetch_add(n, std::memory_order_relaxed);
+    }
+
+    uint64_t load() const {
+        uint64_t total = 0;
+        for (const Stripe& stripe : stripes_) {
+            total += stripe.value.load(std::memory_order_relaxed);
+        }
+        return total;
+    }
+
+private:
+    struct alignas(CACHE_LINE_SIZE) Stripe {
+        std::atomic<uint64_t> value{0};
+    };
+
+    static size_t thread_stripe() {
+        static std::atomic<size_t> next{0};
+        thread_local size_t stripe = next.fetch_add(1, std::memory_order_relaxed);
+        return stripe;
+    }
+
+    Stripe stripes_[Stripes];
+};
+
+} // namespace lux
+
+#endif // LUX_STRIPED_COUNTER_HPP
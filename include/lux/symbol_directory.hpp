@@ -0,0 +1,178 @@
+#ifndef LUX_SYMBOL_DIRECTORY_HPP
+#define LUX_SYMBOL_DIRECTORY_HPP
+
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <vector>
+
+namespace lux {
+
+// Read-mostly map from symbol id to a caller-owned value.
+// Lookups are lock-free and write nothing: one multiplicative hash, then
+// acquire loads from a flat open-addressed table, normally hitting on the
+// first slot. insert()/erase() must be serialised by the caller.
+//
+// When the table fills, a larger copy is built and published through a
+// single atomic pointer (RCU style). The old table is retired, not freed,
+// because readers may still hold it; retired tables live until the
+// directory is destroyed. Each one is at most half the size of its
+// successor, so the overhead stays bounded. Erased values are likewise
+// left to the caller to keep alive.
+template<typename T>
+class SymbolDirectory {
+public:
+    explicit SymbolDirectory(size_t initial_capacity = 64)
+        : table_(nullptr) {
+        auto table = std::make_unique<Table>(round_up_pow2(initial_capacity));
+        table_.store(table.get(), std::memory_order_release);
+        tables_.push_back(std::move(table));
+    }
+
+    SymbolDirectory(const SymbolDirectory&) = delete;
+    SymbolDirectory& operator=(const SymbolDirectory&) = delete;
+
+    // Reader side; nullptr if absent
+    T* find(uint64_t symbol_id) const {
+        const Table* table = table_.load(std::memory_order_acquire);
+        for (size_t i = table->home(symbol_id);; i = (i + 1) & table->mask) {
+            const Slot& slot = table->slots[i];
+            if (!slot.used.load(std::memory_order_acquire)) {
+                return nullptr;
+            }
+            if (slot.key == symbol_id) {
+                return slot.value.load(std::memory_order_acquire);
+            }
+        }
+    }
+
+    // Writer side; returns false if the id is already present
+    bool insert(uint64_t symbol_id, T* value) {
+        Table* table = table_.load(std::memory_order_relaxed);
+        Slot* slot = probe(*table, symbol_id);
+        if (slot->used.load(std::memory_order_relaxed)) {
+            if (slot->value.load(std::memory_order_relaxed)) {
+                return false;
+            }
+            slot->value.store(value, std::memory_order_release);  // Reuse tombstone
+            ++live_;
+            return true;
+        }
+
+        if ((used_ + 1) * 2 > table->slots.size()) {
+            table = grow();
+            slot = probe(*table, symbol_id);
+        }
+        slot->key = symbol_id;
+        slot->value.store(value, std::memory_order_relaxed);
+        slot->used.store(true, std::memory_order_release);
+        ++used_;
+        ++live_;
+        return true;
+    }
+
+    // Writer side; the slot keeps its key as a tombstone until the next grow
+    T* erase(uint64_t symbol_id) {
+        Table* table = table_.load(std::memory_order_relaxed);
+        Slot* slot = probe(*table, symbol_id);
+        if (!slot->used.load(std::memory_order_relaxed)) {
+            return nullptr;
+        }
+        T* value = slot->value.exchange(nullptr, std::memory_order_acq_rel);
+        if (value) {
+            --live_;
+        }
+        return value;
+    }
+
+    // Writer side; swaps the value of a present id in one store, so readers
+    // see the old value or the new one and never a gap. Returns the old
+    // value, or nullptr (storing nothing) if the id is absent.
+    T* replace(uint64_t symbol_id, T* value) {
+        Table* table = table_.load(std::memory_order_relaxed);
+        Slot* slot = probe(*table, symbol_id);
+        if (!slot->used.load(std::memory_order_relaxed) ||
+            !slot->value.load(std::memory_order_relaxed)) {
+            return nullptr;
+        }
+        return slot->value.exchange(value, std::memory_order_acq_rel);
+    }
+
+    size_t size() const { return live_; }
+
+private:
+    struct Slot {
+        std::atomic<bool> used{false};
+        uint64_t key{0};               // Immutable once used is published
+        std::atomic<T*> value{nullptr};
+    };
+
+    struct Table {
+        explicit Table(size_t capacity)
+            : slots(capacity), mask(capacity - 1), shift(64 - log2(capacity)) {}
+
+        size_t home(uint64_t symbol_id) const {
+            return static_cast<size_t>((symbol_id * 0x9E3779B97F4A7C15ull) >> shift) & mask;
+        }
+
+        static unsigned log2(size_t n) {
+            unsigned bits = 0;
+            while ((size_t{1} << bits) < n) ++bits;
+            return bits;
+        }
+
+        std::vector<Slot> slots;
+        size_t mask;
+        unsigned shift;
+    };
+
+    static Slot* probe(Table& table, uint64_t symbol_id) {
+        for (size_t i = table.home(symbol_id);; i = (i + 1) & table.mask) {
+            Slot& slot = table.slots[i];
+            if (!slot.used.load(std::memory_order_relaxed) || slot.key == symbol_id) {
+                return &slot;
+            }
+        }
+    }
+
+    Table* grow() {
+        const Table& old = *table_.load(std::memory_order_relaxed);
+        // Size from live entries only; tombstones are dropped
+        size_t capacity = round_up_pow2((live_ + 1) * 4);
+        if (capacity < old.slots.size()) {
+            capacity = old.slots.size();
+        }
+        auto table = std::make_unique<Table>(capacity);
+        used_ = 0;
+        for (const Slot& slot : old.slots) {
+            T* value = slot.value.load(std::memory_order_relaxed);
+            if (slot.used.load(std::memory_order_relaxed) && value) {
+                Slot* dest = probe(*table, slot.key);
+                dest->key = slot.key;
+                dest->value.store(value, std::memory_order_relaxed);
+                dest->used.store(true, std::memory_order_relaxed);
+                ++used_;
+            }
+        }
+        Table* published = table.get();
+        tables_.push_back(std::move(table));
+        table_.store(published, std::memory_order_release);
+        return published;
+    }
+
+    static size_t round_up_pow2(size_t n) {
+        size_t p = 16;
+        while (p < n) p <<= 1;
+        return p;
+    }
+
+    std::atomic<Table*> table_;
+    std::vector<std::unique_ptr<Table>> tables_;  // Current table is tables_.back()
+    size_t used_{0};   // Slots with a key, including tombstones
+    size_t live_{0};
+};
+
+} // namespace lux
+
+#endif // LUX_SYMBOL_DIRECTORY_HPP
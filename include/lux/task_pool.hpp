@@ -0,0 +1,56 @@
+#ifndef LUX_TASK_POOL_HPP
+#define LUX_TASK_POOL_HPP
+
+#include <atomic>
+#include <condition_variable>
+#include <cstddef>
+#include <cstdint>
+#include <functional>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+namespace lux {
+
+// Fixed pool of worker threads for fork-join loops.
+// parallel_for() hands out indices dynamically: whichever thread is free
+// claims the next index, so long-running items do not stall the rest.
+// The calling thread participates, and calls from different threads are
+// serialised.
+class TaskPool {
+public:
+    // threads == 0 uses hardware concurrency - 1 helpers (plus the caller)
+    explicit TaskPool(size_t threads = 0);
+    ~TaskPool();
+
+    TaskPool(const TaskPool&) = delete;
+    TaskPool& operator=(const TaskPool&) = delete;
+
+    // Run fn(i) for every i in [0, count); returns once all calls finished
+    void parallel_for(size_t count, const std::function<void(size_t)>& fn);
+
+    size_t thread_count() const { return threads_.size() + 1; }
+
+private:
+    void worker_loop();
+    void run_items();
+
+    std::vector<std::thread> threads_;
+    std::mutex submit_mutex_;             // One job at a time
+
+    std::mutex mutex_;
+    std::condition_variable work_cv_;
+    std::condition_variable done_cv_;
+    uint64_t generation_{0};
+    bool stopping_{false};
+    size_t active_workers_{0};
+
+    // Current job
+    const std::function<void(size_t)>* fn_{nullptr};
+    size_t count_{0};
+    std::atomic<size_t> next_{0};
+};
+
+} // namespace lux
+
+#endif // LUX_TASK_POOL_HPP
@@ -0,0 +1,132 @@
+#ifndef LUX_TICK_BITMAP_HPP
+#define LUX_TICK_BITMAP_HPP
+
+#include <cstddef>
+#include <cstdint>
+#include <optional>
+#include <vector>
+
+namespace lux {
+
+// Initialized-tick bitmap for one pool, after Uniswap v3's TickBitmap.
+// Ticks are compressed by the pool's tick spacing to one bit each, packed
+// in 64-bit words, with a summary bit per non-empty word above them. A
+// search masks the starting word and bit-scans it, then scans the summary
+// for the next non-empty word, so skipping empty tick ranges costs one
+// bit scan per 4096 compressed ticks rather than one step per tick. The
+// words are allocated on the first set(). Not thread-safe.
+class TickBitmap {
+public:
+    TickBitmap() : TickBitmap(1) {}
+    explicit TickBitmap(int32_t tick_spacing, int32_t min_tick = -887272, int32_t max_tick = 887272)
+        : spacing_(tick_spacing),
+          min_compressed_(ceil_div(min_tick, tick_spacing)),
+          max_compressed_(floor_div(max_tick, tick_spacing)) {}
+
+    // Mark `tick` (a multiple of the spacing, within range) initialized or not
+    void set(int32_t tick, bool initialized) {
+        if (words_.empty()) {
+            const size_t bits = static_cast<size_t>(max_compressed_ - min_compressed_) + 1;
+            words_.assign((bits + 63) >> 6, 0);
+            summary_.assign((words_.size() + 63) >> 6, 0);
+        }
+        const size_t pos = position(tick / spacing_);
+        const size_t w = pos >> 6;
+        if (initialized) {
+            words_[w] |= 1ULL << (pos & 63);
+            summary_[w >> 6] |= 1ULL << (w & 63);
+        } else {
+            words_[w] &= ~(1ULL << (pos & 63));
+            if (words_[w] == 0) {
+                summary_[w >> 6] &= ~(1ULL << (w & 63));
+            }
+        }
+    }
+
+    bool test(int32_t tick) const {
+        if (words_.empty() || tick % spacing_ != 0) return false;
+        const int64_t compressed = tick / spacing_;
+        if (compressed < min_compressed_ || compressed > max_compressed_) return false;
+        const size_t pos = position(compressed);
+        return (words_[pos >> 6] >> (pos & 63)) & 1ULL;
+    }
+
+    // Highest initialized tick strictly below `tick`
+    std::optional<int32_t> next_below(int32_t tick) const {
+        int64_t compressed = floor_div(static_cast<int64_t>(tick) - 1, spacing_);
+        if (words_.empty() || compressed < min_compressed_) return std::nullopt;
+        if (compressed > max_compressed_) compressed = max_compressed_;
+
+        const size_t pos = position(compressed);
+        size_t w = pos >> 6;
+        const size_t bit = pos & 63;
+        const uint64_t word = words_[w] & (bit == 63 ? ~0ULL : ((1ULL << (bit + 1)) - 1));
+        if (word != 0) {
+            return tick_at((w << 6) + 63 - static_cast<size_t>(__builtin_clzll(word)));
+        }
+        if (w == 0) return std::nullopt;
+
+        // Highest non-empty word before w, from the summary
+        const size_t start = w - 1;
+        size_t s = start >> 6;
+        const size_t sbit = start & 63;
+        uint64_t summary = summary_[s] & (sbit == 63 ? ~0ULL : ((1ULL << (sbit + 1)) - 1));
+        while (summary == 0) {
+            if (s == 0) return std::nullopt;
+            summary = summary_[--s];
+        }
+        w = (s << 6) + 63 - static_cast<size_t>(__builtin_clzll(summary));
+        return tick_at((w << 6) + 63 - static_cast<size_t>(__builtin_clzll(words_[w])));
+    }
+
+    // Lowest initialized tick strictly above `tick`
+    std::optional<int32_t> next_above(int32_t tick) const {
+        int64_t compressed = floor_div(tick, spacing_) + 1;
+        if (words_.empty() || compressed > max_compressed_) return std::nullopt;
+        if (compressed < min_compressed_) compressed = min_compressed_;
+
+        const size_t pos = position(compressed);
+        size_t w = pos >> 6;
+        const uint64_t word = words_[w] & (~0ULL << (pos & 63));
+        if (word != 0) {
+            return tick_at((w << 6) + static_cast<size_t>(__builtin_ctzll(word)));
+        }
+
+        // Lowest non-empty word after w, from the summary
+        const size_t start = w + 1;
+        if (start >= words_.size()) return std::nullopt;
+        size_t s = start >> 6;
+        uint64_t summary = summary_[s] & (~0ULL << (start & 63));
+        while (summary == 0) {
+            if (++s >= summary_.size()) return std::nullopt;
+            summary = summary_[s];
+        }
+        w = (s << 6) + static_cast<size_t>(__builtin_ctzll(summary));
+        return tick_at((w << 6) + static_cast<size_t>(__builtin_ctzll(words_[w])));
+    }
+
+private:
+    static int64_t floor_div(int64_t a, int64_t b) {
+        return a / b - ((a % b != 0) && ((a < 0) != (b < 0)));
+    }
+    static int64_t ceil_div(int64_t a, int64_t b) {
+        return -floor_div(-a, b);
+    }
+
+    size_t position(int64_t compressed) const {
+        return static_cast<size_t>(compressed - min_compressed_);
+    }
+    int32_t tick_at(size_t pos) const {
+        return static_cast<int32_t>((static_cast<int64_t>(pos) + min_compressed_) * spacing_);
+    }
+
+    int32_t spacing_;
+    int64_t min_compressed_;
+    int64_t max_compressed_;
+    std::vector<uint64_t> words_;    // Bit per compressed tick
+    std::vector<uint64_t> summary_;  // Bit per non-empty word
+};
+
+} // namespace lux
+
+#endif // LUX_TICK_BITMAP_HPP
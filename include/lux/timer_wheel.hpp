@@ -0,0 +1,143 @@
+#ifndef LUX_TIMER_WHEEL_HPP
+#define LUX_TIMER_WHEEL_HPP
+
+#include <array>
+#include <cstddef>
+#include <cstdint>
+#include <utility>
+#include <vector>
+
+namespace lux {
+
+// Hierarchical timing wheel over integer ticks.
+// Four levels of 256 slots cover 2^32 ticks ahead of the current tick;
+// anything further out waits in an overflow list that is redistributed each
+// time the top level wraps. schedule() is O(1); advancing is O(1) per
+// tick plus one re-insert per cascading entry, and runs of ticks with
+// nothing in the lower levels are jumped over, so advancing across a
+// long idle gap costs a handful of steps. Not thread-safe.
+template<typename T>
+class TimerWheel {
+public:
+    explicit TimerWheel(uint64_t start_tick = 0) : current_(start_tick) {}
+
+    // Run `value` once the wheel reaches `deadline`; deadlines at or
+    // before the current tick fire on the next advance
+    void schedule(uint64_t deadline, T value) {
+        insert(Entry{deadline > current_ ? deadline : current_ + 1, std::move(value)});
+        ++size_;
+    }
+
+    // Move to `tick`, calling `fn(value)` for every entry that comes due,
+    // in deadline order. Returns how many fired.
+    template<typename Fn>
+    size_t advance(uint64_t tick, Fn&& fn) {
+        if (size_ == 0) {
+            current_ = tick > current_ ? tick : current_;
+            return 0;
+        }
+        size_t fired = 0;
+        while (current_ < tick && size_ > 0) {
+            // Nothing can fire before the next boundary of the lowest
+            // occupied level; jump to just before it
+            if (level_size_[0] == 0) {
+                size_t level = 1;
+                while (level < LEVELS && level_size_[level] == 0) {
+                    ++level;
+                }
+                const uint64_t last = current_ | ((uint64_t{1} << (SLOT_BITS * level)) - 1);
+                if (last >= tick) {
+                    break;
+                }
+                current_ = last;
+            }
+
+            ++current_;
+            cascade();
+
+            std::vector<Entry>& slot = levels_[0][current_ & SLOT_MASK];
+            if (slot.empty()) {
+                continue;
+            }
+            due_.swap(slot);
+            level_size_[0] -= due_.size();
+            size_ -= due_.size();
+            for (Entry& entry : due_) {
+                ++fired;
+                fn(entry.value);
+            }
+            due_.clear();
+        }
+        if (current_ < tick) {
+            current_ = tick;
+        }
+        return fired;
+    }
+
+    uint64_t current_tick() const { return current_; }
+    size_t size() const { return size_; }
+    bool empty() const { return size_ == 0; }
+
+private:
+    static constexpr size_t LEVELS = 4;
+    static constexpr size_t SLOT_BITS = 8;
+    static constexpr size_t SLOTS = size_t{1} << SLOT_BITS;
+    static constexpr uint64_t SLOT_MASK = SLOTS - 1;
+
+    struct Entry {
+        uint64_t deadline;
+        T value;
+    };
+
+    // Place an entry (deadline > current_) in the lowest level whose
+    // span covers it
+    void insert(Entry&& entry) {
+        const uint64_t delta = entry.deadline - current_;
+        for (size_t level = 0; level < LEVELS; ++level) {
+            if (delta < (uint64_t{1} << (SLOT_BITS * (level + 1)))) {
+                const size_t slot = (entry.deadline >> (SLOT_BITS * level)) & SLOT_MASK;
+                levels_[level][slot].push_back(std::move(entry));
+                ++level_size_[level];
+                return;
+            }
+        }
+        overflow_.push_back(std::move(entry));
+    }
+
+    // On a level-0 wrap, pull the next block of each higher level that
+    // also wrapped down into the levels below it
+    void cascade() {
+        for (size_t level = 1; level <= LEVELS; ++level) {
+            if ((current_ >> (SLOT_BITS * (level - 1))) & SLOT_MASK) {
+                return;  // The level below has not wrapped
+            }
+            std::vector<Entry>& source = level < LEVELS ?
+                levels_[level][(current_ >> (SLOT_BITS * level)) & SLOT_MASK] : overflow_;
+            if (source.empty()) {
+                continue;
+            }
+            moving_.swap(source);
+            if (level < LEVELS) {
+                level_size_[level] -= moving_.size();
+            }
+            for (Entry& entry : moving_) {
+                insert(std::move(entry));
+            }
+            moving_.clear();
+        }
+    }
+
+    uint64_t current_;
+    size_t size_{0};
+    std::array<size_t, LEVELS> level_size_{};
+    std::array<std::array<std::vector<Entry>, SLOTS>, LEVELS> levels_;
+    std::vector<Entry> overflow_;
+
+    // Scratch reused across advances
+    std::vector<Entry> due_;
+    std::vector<Entry> moving_;
+};
+
+} // namespace lux
+
+#endif // LUX_TIMER_WHEEL_HPP
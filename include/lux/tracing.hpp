@@ -0,0 +1,224 @@
+#ifndef LUX_TRACING_HPP
+#define LUX_TRACING_HPP
+
+#include <array>
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <string>
+#include <vector>
+
+#include "clock.hpp"
+
+// Compile-time switch. Building with LUX_TRACING=0 (CMake -DLUXDEX_TRACING=OFF)
+// turns every TraceSpan into an empty object; the Tracer itself stays so
+// exporters keep linking and simply report nothing.
+#ifndef LUX_TRACING
+#define LUX_TRACING 1
+#endif
+
+namespace lux {
+
+// =============================================================================
+// Hot-Path Tracing
+// =============================================================================
+//
+// Spans time the stages an order passes through: ingress into LXBook, the
+// engine's matching call, settlement of the resulting fills, the vault
+// applying them and the feed pushing a price update. A span reads the TSC
+// when it opens and again when it closes and records the difference into a
+// log-linear (HDR) histogram owned by the calling thread, so recording never
+// shares a cache line with another thread and takes no lock. With the event
+// trace on, each span is also appended to the thread's ring of recent spans.
+//
+// Tracing is off until Tracer::enable(); an inactive span costs one relaxed
+// load. Histograms outlive their threads, so a run's numbers can be exported
+// after its workers have stopped.
+
+enum class TracePoint : uint8_t {
+    OrderIngress,       // LXBook order entry, matching and bookkeeping
+    Matching,           // Engine call into the symbol's order book
+    Settlement,         // Fills to vault settlements, sync or pipelined
+    VaultApply,         // LXVault applying a batch of settlements
+    FeedUpdate,         // LXFeed pushing index/mark to its listener
+    Count
+};
+
+constexpr size_t TRACE_POINTS = static_cast<size_t>(TracePoint::Count);
+
+// Snake-case name, used as the Prometheus label
+const char* trace_point_name(TracePoint point);
+
+// One span from the event trace
+struct TraceEvent {
+    uint64_t start_ticks;
+    uint64_t ticks;             // Duration
+    uint64_t id;                // Span-specific: order id, batch size, market id
+    uint32_t thread;            // Registration order of the recording thread
+    TracePoint point;
+    uint8_t reserved[3];
+};
+
+// Log-linear histogram of tick counts: 32 linear sub-buckets per power of
+// two, so a bucket's width is at most ~3% of its value. Values at or above
+// 2^48 ticks land in the last bucket. Each instance has a single writer;
+// the relaxed atomics only make concurrent reads well-defined.
+class HdrHistogram {
+public:
+    static constexpr unsigned SUB_BITS = 5;
+    static constexpr unsigned MAX_BITS = 48;
+    static constexpr size_t BUCKETS = size_t{MAX_BITS - SUB_BITS + 1} << SUB_BITS;
+
+    void record(uint64_t value) {
+        bump(buckets_[bucket_of(value)], 1);
+        bump(count_, 1);
+        bump(sum_, value);
+        if (value > max_.load(std::memory_order_relaxed)) {
+            max_.store(value, std::memory_order_relaxed);
+        }
+    }
+
+    uint64_t count() const { return count_.load(std::memory_order_relaxed); }
+    uint64_t sum() const { return sum_.load(std::memory_order_relaxed); }
+    uint64_t max() const { return max_.load(std::memory_order_relaxed); }
+    uint64_t bucket(size_t i) const { return buckets_[i].load(std::memory_order_relaxed); }
+
+    static size_t bucket_of(uint64_t value) {
+        if (value < (uint64_t{1} << SUB_BITS)) {
+            return static_cast<size_t>(value);
+        }
+        if (value >= (uint64_t{1} << MAX_BITS)) {
+            return BUCKETS - 1;
+        }
+        const unsigned msb = 63 - static_cast<unsigned>(__builtin_clzll(value));
+        const unsigned group = msb - SUB_BITS + 1;
+        const uint64_t sub = (value >> (group - 1)) - (uint64_t{1} << SUB_BITS);
+        return (size_t{group} << SUB_BITS) + static_cast<size_t>(sub);
+    }
+
+    // Smallest value of bucket i; bucket_lower(i + 1) bounds it above
+    static uint64_t bucket_lower(size_t i) {
+        const size_t group = i >> SUB_BITS;
+        const uint64_t sub = i & ((size_t{1} << SUB_BITS) - 1);
+        if (group == 0) {
+            return sub;
+        }
+        return ((uint64_t{1} << SUB_BITS) + sub) << (group - 1);
+    }
+
+    void reset() {
+        for (auto& bucket : buckets_) {
+            bucket.store(0, std::memory_order_relaxed);
+        }
+        count_.store(0, std::memory_order_relaxed);
+        sum_.store(0, std::memory_order_relaxed);
+        max_.store(0, std::memory_order_relaxed);
+    }
+
+private:
+    static void bump(std::atomic<uint64_t>& cell, uint64_t by) {
+        cell.store(cell.load(std::memory_order_relaxed) + by, std::memory_order_relaxed);
+    }
+
+    std::array<std::atomic<uint64_t>, BUCKETS> buckets_{};
+    std::atomic<uint64_t> count_{0};
+    std::atomic<uint64_t> sum_{0};
+    std::atomic<uint64_t> max_{0};
+};
+
+// One trace point merged across threads
+struct TraceSummary {
+    uint64_t count = 0;
+    uint64_t sum_ticks = 0;
+    uint64_t max_ticks = 0;
+    std::vector<uint64_t> buckets;      // HdrHistogram::BUCKETS counts
+
+    // Upper bound of the bucket holding the q-th quantile, in nanoseconds;
+    // 0 when empty
+    double quantile_ns(double q) const;
+    double mean_ns() const;
+};
+
+class Tracer {
+public:
+    static constexpr size_t DEFAULT_EVENT_CAPACITY = 4096;
+
+    // Starts recording. The first call calibrates the TSC (about 10 ms).
+    // event_capacity > 0 also keeps each thread's last event_capacity spans,
+    // rounded up to a power of two; a thread's ring is sized when it first
+    // records with the trace on.
+    static void enable(size_t event_capacity = 0);
+    static void disable();
+    static bool enabled() { return enabled_.load(std::memory_order_relaxed); }
+    static bool event_trace() { return event_capacity_.load(std::memory_order_relaxed) != 0; }
+
+    static uint64_t ticks() { return cpu_ticks(); }
+
+    // Nanoseconds per tick; 1 until calibrated or without a TSC
+    static double ns_per_tick();
+
+    static void record(TracePoint point, uint64_t start_ticks, uint64_t end_ticks, uint64_t id);
+
+    static TraceSummary summary(TracePoint point);
+
+    // Recent spans of every thread, oldest first. Exact only while no thread
+    // is recording; a span being written concurrently may read torn.
+    static std::vector<TraceEvent> events();
+
+    // Prometheus text exposition: one luxdex_trace_span_seconds histogram
+    // per trace point, with a bucket per power of two up to the maximum
+    static std::string prometheus();
+
+    // Dump of the histograms and event trace (see tracing.cpp for the
+    // layout). False if the file cannot be written.
+    static bool write_binary(const std::string& path);
+
+    // Zeroes every histogram and empties the event rings; like events(),
+    // meant for when no thread is recording
+    static void reset();
+
+private:
+    static inline std::atomic<bool> enabled_{false};
+    static inline std::atomic<size_t> event_capacity_{0};
+};
+
+#if LUX_TRACING
+
+// Times the enclosing scope when tracing is enabled as it opens
+class TraceSpan {
+public:
+    explicit TraceSpan(TracePoint point, uint64_t id = 0)
+        : start_(Tracer::enabled() ? Tracer::ticks() : 0), id_(id), point_(point) {}
+
+    ~TraceSpan() {
+        if (start_ != 0) {
+            Tracer::record(point_, start_, Tracer::ticks(), id_);
+        }
+    }
+
+    TraceSpan(const TraceSpan&) = delete;
+    TraceSpan& operator=(const TraceSpan&) = delete;
+
+    void set_id(uint64_t id) { id_ = id; }
+
+private:
+    uint64_t start_;        // 0 while inactive
+    uint64_t id_;
+    TracePoint point_;
+};
+
+#else
+
+class TraceSpan {
+public:
+    explicit TraceSpan(TracePoint, uint64_t = 0) {}
+    TraceSpan(const TraceSpan&) = delete;
+    TraceSpan& operator=(const TraceSpan&) = delete;
+    void set_id(uint64_t) {}
+};
+
+#endif // LUX_TRACING
+
+} // namespace lux
+
+#endif // LUX_TRACING_HPP
@@ -1,6 +1,7 @@
 #ifndef LUX_TRADE_HPP
 #define LUX_TRADE_HPP
 
+#include <cstddef>
 #include <cstdint>
 #include <chrono>
 #include "order.hpp"
@@ -33,6 +34,13 @@ class TradeListener {
 public:
     virtual ~TradeListener() = default;
     virtual void on_trade(const Trade& trade) = 0;
+    // Trades produced together, such as one auction uncross; defaults to
+    // on_trade() for each
+    virtual void on_trade_batch(const Trade* trades, size_t count) {
+        for (size_t i = 0; i < count; ++i) {
+            on_trade(trades[i]);
+        }
+    }
     virtual void on_order_filled(const Order& order) = 0;
     virtual void on_order_partially_filled(const Order& order, Quantity fill_qty) = 0;
     virtual void on_order_cancelled(const Order& order) = 0;
@@ -0,0 +1,101 @@
+#ifndef LUX_TRADE_RING_HPP
+#define LUX_TRADE_RING_HPP
+
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <optional>
+
+#include "trade.hpp"
+#include "seqlock.hpp"
+
+namespace lux {
+
+// Fixed-capacity history of the most recent trades of one market.
+// Trades are numbered from 0 as they are pushed; the ring keeps the last
+// capacity() of them. One writer at a time (the book's matching thread);
+// any number of lock-free readers, which either get a trade exactly as
+// written or learn that it has been overwritten.
+class TradeRing {
+public:
+    explicit TradeRing(size_t capacity = 1024)
+        : slots_(std::make_unique<Slot[]>(round_up_pow2(capacity))),
+          mask_(round_up_pow2(capacity) - 1) {}
+
+    TradeRing(const TradeRing&) = delete;
+    TradeRing& operator=(const TradeRing&) = delete;
+
+    // Writer side
+    void push(const Trade& trade) {
+        const uint64_t sequence = next_.load(std::memory_order_relaxed);
+        slots_[sequence & mask_].store(Entry{sequence, trade});
+        next_.store(sequence + 1, std::memory_order_release);
+    }
+
+    // Sequence the next pushed trade will get (== total trades pushed)
+    uint64_t next_sequence() const { return next_.load(std::memory_order_acquire); }
+
+    // Oldest sequence still retained
+    uint64_t first_sequence() const {
+        const uint64_t next = next_sequence();
+        return next > capacity() ? next - capacity() : 0;
+    }
+
+    size_t capacity() const { return mask_ + 1; }
+
+    // Visits retained trades with sequence >= `since`, oldest first, as
+    // fn(sequence, trade); fn returns false to stop. Trades overwritten
+    // while reading are skipped. Returns the sequence to resume from.
+    template<typename Fn>
+    uint64_t read_since(uint64_t since, Fn&& fn) const {
+        const uint64_t next = next_sequence();
+        if (since >= next) {
+            return since;
+        }
+        uint64_t sequence = since;
+        if (next - sequence > capacity()) {
+            sequence = next - capacity();  // Older trades are gone
+        }
+        for (; sequence < next; ++sequence) {
+            Entry entry = slots_[sequence & mask_].load();
+            if (entry.sequence != sequence) {
+                continue;  // Lapped by the writer
+            }
+            if (!fn(sequence, static_cast<const Trade&>(entry.trade))) {
+                return sequence + 1;
+            }
+        }
+        return sequence;
+    }
+
+    std::optional<Trade> last() const {
+        const uint64_t next = next_sequence();
+        if (next == 0) {
+            return std::nullopt;
+        }
+        Entry entry = slots_[(next - 1) & mask_].load();
+        return entry.trade;
+    }
+
+private:
+    struct Entry {
+        uint64_t sequence;
+        Trade trade;
+    };
+    using Slot = SeqLock<Entry>;
+
+    static size_t round_up_pow2(size_t n) {
+        size_t p = 2;
+        while (p < n) p <<= 1;
+        return p;
+    }
+
+    std::unique_ptr<Slot[]> slots_;
+    const size_t mask_;
+    std::atomic<uint64_t> next_{0};
+};
+
+} // namespace lux
+
+#endif // LUX_TRADE_RING_HPP
@@ -0,0 +1,103 @@
+#ifndef LUX_TRIGGER_BOOK_HPP
+#define LUX_TRIGGER_BOOK_HPP
+
+#include <array>
+#include <cstddef>
+#include <cstdint>
+#include <functional>
+#include <map>
+#include <mutex>
+#include <optional>
+#include <unordered_map>
+#include <vector>
+
+#include "types.hpp"
+#include "feed.hpp"
+
+namespace lux {
+
+// =============================================================================
+// Trigger Book - resting stop / take-profit orders of one market
+// =============================================================================
+//
+// Orders wait in price-ordered multimaps, one pair per reference price
+// (index / mark / last / ...). Orders that fire on a rising price sit in an
+// ascending map, orders that fire on a falling price in a descending one,
+// so the crossed orders for a new price are always a prefix: firing costs
+// O(log n + k) for k fired orders. Orders at the same trigger price fire
+// in arrival order.
+//
+// Direction follows the usual stop semantics:
+//   STOP_* buy,  TAKE_* sell -> fire when price >= trigger
+//   STOP_* sell, TAKE_* buy  -> fire when price <= trigger
+
+struct TriggerOrder {
+    uint64_t oid;
+    LXAccount account;
+    LXOrder order;           // As submitted: kind is STOP_* or TAKE_*
+    PriceType price_type;    // Reference price the trigger watches
+};
+
+class TriggerBook {
+public:
+    static bool is_trigger_kind(OrderKind kind) {
+        return kind == OrderKind::STOP_MARKET || kind == OrderKind::STOP_LIMIT ||
+               kind == OrderKind::TAKE_MARKET || kind == OrderKind::TAKE_LIMIT;
+    }
+    static bool fires_on_rise(const LXOrder& order) {
+        const bool stop = order.kind == OrderKind::STOP_MARKET || order.kind == OrderKind::STOP_LIMIT;
+        return stop == order.is_buy;
+    }
+
+    // The order as it should be sent to the engine once fired
+    static LXOrder fired_order(const LXOrder& order);
+
+    // Rests the order. Returns false, without resting it, if the last
+    // price seen for its reference already crosses the trigger; the caller
+    // then executes it immediately.
+    bool add(const TriggerOrder& order);
+
+    // Removes a resting order
+    std::optional<TriggerOrder> cancel(uint64_t oid);
+
+    // Records a new reference price and moves every order it crosses into
+    // `out` (appended in firing order). Returns the number fired.
+    size_t on_price(PriceType type, I128 price_x18, std::vector<TriggerOrder>& out);
+
+    std::optional<I128> last_price(PriceType type) const;
+    size_t size() const;
+
+    // Copies every resting order (for snapshots)
+    void collect(std::vector<TriggerOrder>& out) const;
+
+private:
+    static constexpr size_t PRICE_TYPES = 5;  // PriceType::INDEX .. ORACLE
+
+    using RisingMap = std::multimap<I128, TriggerOrder, std::less<I128>>;
+    using FallingMap = std::multimap<I128, TriggerOrder, std::greater<I128>>;
+
+    struct Reference {
+        RisingMap rising;
+        FallingMap falling;
+        std::optional<I128> last_price;
+    };
+
+    struct Location {
+        uint8_t price_type;
+        bool rising;
+        RisingMap::iterator rising_it;
+        FallingMap::iterator falling_it;
+    };
+
+    template<typename Map>
+    static size_t take_crossed(Map& map, I128 price_x18, std::vector<TriggerOrder>& out,
+                               std::unordered_map<uint64_t, Location>& index);
+
+    mutable std::mutex mutex_;
+    std::array<Reference, PRICE_TYPES> references_;
+    std::unordered_map<uint64_t, Location> index_;  // oid -> position
+};
+
+} // namespace lux
+
+#endif // LUX_TRIGGER_BOOK_HPP
@@ -82,8 +82,36 @@ constexpr I128 X18_HALF = 500000000000000000LL;  // 0.5e18
 // Safe X18 operations
 namespace x18 {
 
+// v / X18_ONE truncated toward zero, without a 128-bit division. 1e18 is
+// 2^18 * 5^18: the 2^18 shifts out, leaving at most 110 bits to divide by
+// 5^18. That division is a multiply by the reciprocal m = ceil(2^152 / 5^18),
+// 111 bits, keeping the product's bits from 152 up. m exceeds 2^152 / 5^18 by
+// less than 2^110 / 5^18 (Granlund-Montgomery), so the quotient is exact for
+// every input. The four partial products are independent and the code has no
+// branches, so batch loops pipeline.
+inline U128 div_one_abs(U128 n) {
+    constexpr uint64_t M1 = 0x49c97747490eULL;            // m >> 64
+    constexpr uint64_t M0 = 0xae839d7f99173122ULL;        // m & (2^64 - 1)
+    n >>= 18;
+    const uint64_t n1 = static_cast<uint64_t>(n >> 64);   // < 2^46
+    const uint64_t n0 = static_cast<uint64_t>(n);
+
+    const U128 mid = static_cast<U128>(n1) * M0 + static_cast<U128>(n0) * M1 +
+                     ((static_cast<U128>(n0) * M0) >> 64);  // < 2^112
+    const U128 top = static_cast<U128>(n1) * M1 + (mid >> 64);
+    return top >> 24;
+}
+
+inline I128 div_one(I128 v) {
+    const U128 sign = static_cast<U128>(v >> 127);          // All ones if negative
+    const U128 q = div_one_abs((static_cast<U128>(v) ^ sign) - sign);
+    return static_cast<I128>((q ^ sign) - sign);
+}
+
+// The product wraps like the plain (a * b) / X18_ONE it replaces; see
+// fixed_point.hpp for overflow-checked forms
 inline I128 mul(I128 a, I128 b) {
-    return (a * b) / X18_ONE;
+    return div_one(static_cast<I128>(static_cast<U128>(a) * static_cast<U128>(b)));
 }
 
 inline I128 div(I128 a, I128 b) {
@@ -103,7 +131,7 @@ inline I128 from_int(int64_t v) {
 }
 
 inline int64_t to_int(I128 v) {
-    return static_cast<int64_t>(v / X18_ONE);
+    return static_cast<int64_t>(div_one(v));
 }
 
 // Square root via Newton-Raphson
@@ -240,7 +268,7 @@ struct ModifyLiquidityParams {
 
 struct LXAccount {
     Address main;           // Main wallet address
-    uint16_t subaccount_id; // Subaccount number (0 = default)
+    uint16_t subaccount_id = 0; // Subaccount number (0 = default)
 
     bool operator==(const LXAccount& other) const {
         return main == other.main && subaccount_id == other.subaccount_id;
@@ -320,7 +348,8 @@ enum class ActionType : uint8_t {
     TWAP_CANCEL = 5,
     SCHEDULE_CANCEL = 6,
     NOOP = 7,
-    RESERVE_WEIGHT = 8
+    RESERVE_WEIGHT = 8,
+    MASS_QUOTE = 9
 };
 
 struct LXOrder {
@@ -351,6 +380,24 @@ struct LXPlaceResult {
     I128 avg_px_x18;
 };
 
+// One level of a mass quote
+struct LXQuote {
+    bool is_buy;
+    I128 px_x18;
+    I128 sz_x18;            // Desired resting size
+};
+
+struct LXMassQuoteResult {
+    int32_t error_code;
+    uint32_t kept;          // Levels already quoted at this size
+    uint32_t reduced;       // Sized down in place, queue priority kept
+    uint32_t requeued;      // Sized up, moved to the back of the level
+    uint32_t placed;        // New orders
+    uint32_t cancelled;     // Previous quotes no level asked for
+    uint32_t rejected;      // Non-positive price or size
+    I128 filled_size_x18;   // Traded on entry by placed levels
+};
+
 struct LXL1 {
     I128 best_bid_px_x18;
     I128 best_bid_sz_x18;
@@ -408,6 +455,7 @@ constexpr uint8_t REDUCE_ONLY = 1 << 2;
 constexpr uint8_t POST_ONLY = 1 << 3;
 constexpr uint8_t MAKER = 1 << 4;
 constexpr uint8_t TAKER = 1 << 5;
+constexpr uint8_t QUOTE = 1 << 6;    // Resting order is part of a mass-quote ladder
 }
 
 // =============================================================================
@@ -1,18 +1,30 @@
 #ifndef LUX_VAULT_HPP
 #define LUX_VAULT_HPP
 
+#include <array>
 #include <map>
+#include <memory>
 #include <unordered_map>
 #include <shared_mutex>
+#include <mutex>
 #include <optional>
+#include <utility>
 #include <vector>
 #include <atomic>
 #include <functional>
 
 #include "types.hpp"
+#include "indexed_heap.hpp"
+#include "memory.hpp"
+#include "placement.hpp"
+#include "seqlock.hpp"
+#include "spsc_ring.hpp"  // CACHE_LINE_SIZE
+#include "symbol_directory.hpp"
 
 namespace lux {
 
+class TaskPool;
+
 // =============================================================================
 // Market Configuration
 // =============================================================================
@@ -42,6 +54,47 @@ struct AccountState {
     std::map<uint32_t, LXPosition> positions;        // market_id -> position
     I128 total_pnl_x18;
     uint64_t last_update_time;
+
+    // Risk aggregates, kept current by every balance, fill, funding and
+    // mark update so margin checks never walk the positions. Funding
+    // accrued but not yet settled is not in them; readers subtract it.
+    LXAccount account{};
+    I128 collateral_x18 = 0;                             // Sum of balances
+    I128 unrealized_pnl_x18 = 0;                         // Sum over positions, kept by mark updates
+    I128 initial_margin_x18 = 0;                         // Sum over positions
+    I128 maintenance_margin_x18 = 0;                     // Sum over positions
+    std::unordered_map<uint32_t, uint32_t> mark_slots;  // market_id -> slot in the market's mark index
+
+    I128 equity_x18() const { return collateral_x18 + unrealized_pnl_x18; }
+};
+
+// =============================================================================
+// Account Snapshot
+// =============================================================================
+
+// Immutable copy of an account as of one write. Every write publishes a
+// new one, so readers get a consistent view without the shard lock.
+// Funding accrued since is not in it; it owes size * (the market's
+// cumulative funding - funding_entry) per position on top.
+struct AccountSnapshot {
+    uint64_t version;  // Writes published for the account, 1 = first
+    AccountState state;
+    std::vector<std::pair<uint32_t, I128>> funding_entry_x18;  // market_id -> index settled at
+};
+
+// Pre-trade figures of an account, published with each snapshot
+struct BuyingPower {
+    uint64_t version;        // AccountSnapshot::version they belong to
+    uint64_t funding_epoch;  // Funding accruals they include
+    bool funding_exposed;    // Held positions, so later accruals move them
+    I128 equity_x18;
+    I128 free_margin_x18;    // Equity less initial margin
+};
+
+// Per-market figures the pre-trade check needs, readable without locks
+struct MarketLimits {
+    I128 initial_margin_x18;
+    I128 max_position_size_x18;  // 0 = unlimited
 };
 
 // =============================================================================
@@ -81,6 +134,9 @@ struct LXLiquidationResult {
 class LXVault {
 public:
     LXVault();
+    // Account shards take their pool chunks from memory, e.g. a NodeMemory
+    // on the node of the threads that drive the vault, with huge pages
+    explicit LXVault(std::shared_ptr<NodeMemory> memory);
     ~LXVault() = default;
 
     // Non-copyable
@@ -124,6 +180,20 @@ public:
     // Get account state
     std::optional<AccountState> get_account_state(const LXAccount& account) const;
 
+    // Last published snapshot of the account, nullptr if it has none.
+    // Lock-free against settlement, like every read in this section and
+    // the position getters, which all answer from it.
+    std::shared_ptr<const AccountSnapshot> account_snapshot(const LXAccount& account) const;
+
+    // Free margin for the order-entry path: a seqlock read of the figures
+    // published with the last write, nullopt if the account has none.
+    // Only an account whose positions funding accrued on since that write
+    // pays for a snapshot walk.
+    std::optional<BuyingPower> buying_power(const LXAccount& account) const;
+
+    // Margin rate and position limit of a market, lock-free
+    std::optional<MarketLimits> market_limits(uint32_t market_id) const;
+
     // Get margin info
     LXMarginInfo get_margin_info(const LXAccount& account) const;
 
@@ -146,6 +216,8 @@ public:
 
     // Get all positions
     std::vector<LXPosition> get_all_positions(const LXAccount& account) const;
+    // Into a caller-owned vector (cleared first); returns the count
+    size_t get_all_positions(const LXAccount& account, std::vector<LXPosition>& out) const;
 
     // =========================================================================
     // Settlement (from CLOB matches)
@@ -157,6 +229,14 @@ public:
     // Apply fills (update positions after matching)
     int32_t apply_fills(const std::vector<LXSettlement>& settlements);
 
+    // Same result as apply_fills, but nets the batch per (account, market)
+    // first and then settles each touched account in one pass: one lookup,
+    // one position write-back and one risk refresh per account however
+    // many fills it takes part in. Each account's fees are checked against
+    // its balance as a total; on a shortfall the accounts already settled
+    // are rolled back from an undo log and nothing is applied.
+    int32_t apply_fills_netted(const std::vector<LXSettlement>& settlements);
+
     // =========================================================================
     // Liquidation
     // =========================================================================
@@ -164,20 +244,41 @@ public:
     // Check if account is liquidatable
     bool is_liquidatable(const LXAccount& account) const;
 
+    // Append every liquidatable account with an open position to `out`,
+    // worst margin ratio first, at most `max` of them. Reads the per-shard
+    // risk heaps, so the cost follows the number of accounts under water,
+    // not the number of accounts. Returns the number appended.
+    size_t liquidation_candidates(std::vector<LXAccount>& out, size_t max = SIZE_MAX) const;
+
     // Liquidate a position
     LXLiquidationResult liquidate(const LXAccount& liquidator, const LXAccount& account,
                                    uint32_t market_id, I128 size_x18);
 
-    // Auto-deleverage (socialized losses)
+    // Auto-deleverage (socialized losses): close every liquidatable
+    // account's position in the market at the mark against the opposing
+    // positions ranked first by PnL ratio times leverage, in one pass
+    // under every shard lock. The ranking is kept as positions and marks
+    // move, so the event itself only pops counterparties.
     int32_t run_adl(uint32_t market_id);
 
     // =========================================================================
     // Funding
     // =========================================================================
 
-    // Accrue funding for all positions in a market
+    // Accrue funding for all positions in a market. Each position settles
+    // its share when next touched, and balance / margin reads include
+    // what is still owed; accrual only re-keys the risk heaps.
     int32_t accrue_funding(uint32_t market_id);
 
+    // Set each market's rate and accrue every market whose interval has
+    // elapsed, taking each shard's lock once for all of them. Shards are
+    // spread over `pool` when given. Returns the markets accrued.
+    size_t accrue_funding(const std::vector<std::pair<uint32_t, I128>>& rates,
+                          TaskPool* pool = nullptr);
+
+    // Markets whose funding interval has elapsed
+    std::vector<uint32_t> funding_due() const;
+
     // Get current funding rate
     I128 funding_rate_x18(uint32_t market_id) const;
 
@@ -187,6 +288,9 @@ public:
     // Set funding rate (called by LXFeed)
     void set_funding_rate(uint32_t market_id, I128 rate_x18);
 
+    // Minimum seconds between accruals (default 8 hours)
+    void set_funding_interval(uint32_t market_id, uint64_t interval_seconds);
+
     // =========================================================================
     // Insurance Fund
     // =========================================================================
@@ -204,7 +308,9 @@ public:
     // Set callback to fetch mark prices
     void set_mark_price_callback(MarkPriceCallback callback);
 
-    // Update mark prices for all positions
+    // Update mark prices for all positions. Each (market, price) pair only
+    // touches the positions open in that market, and account shards are
+    // locked one at a time rather than across the whole update.
     int32_t update_mark_prices(const std::vector<std::pair<uint32_t, I128>>& prices);
 
     // Update mark price for single position
@@ -223,15 +329,112 @@ public:
     };
     Stats get_stats() const;
 
+    // Account, mark-index and snapshot-slot nodes across the shards
+    MemoryStats memory_usage() const;
+
+    // Mappings behind memory_usage(), when constructed on a NodeMemory
+    NodeMemoryStats placement_stats() const;
+
 private:
-    // Account storage: account_hash -> state
-    std::unordered_map<uint64_t, AccountState> accounts_;
-    mutable std::shared_mutex accounts_mutex_;
+    // Mark-to-market index: the positions open in each market, column by
+    // column, so a mark update walks contiguous arrays and never visits an
+    // account without a position in that market. Slots are swap-removed
+    // when a position closes; AccountState::mark_slots points back into
+    // them. Each account shard indexes its own accounts' positions.
+    //
+    // Funding is lazy: accrual only advances funding_index_x18, and a slot
+    // owes size * (index - funding_entry) until it settles, which happens
+    // whenever the position or its account is next written.
+    //
+    // Profitable positions are also ranked for ADL, per side, by PnL over
+    // entry notional times mark notional over account equity (unsettled
+    // funding aside). Every write to an account re-ranks its positions.
+    struct MarketMarks {
+        I128 mark_px_x18 = 0;               // Last mark applied, 0 = none yet
+        I128 funding_index_x18 = 0;         // Sum of every funding rate accrued
+        uint64_t funding_time = 0;          // When the index last moved
+        std::vector<I128> size_x18;         // Signed, negative for shorts
+        std::vector<I128> entry_px_x18;
+        std::vector<I128> funding_entry_x18;  // Index the slot last settled at
+        std::vector<I128> pnl_x18;
+        std::vector<I128> initial_x18;      // Margin the slot adds to its account
+        std::vector<I128> maintenance_x18;
+        std::vector<LXPosition*> positions;
+        std::vector<AccountState*> accounts;
+        IndexedHeap<uint64_t, double> adl_long;   // account_hash -> ADL score
+        IndexedHeap<uint64_t, double> adl_short;
+    };
+
+    // Where an account's snapshots are published. Slots are never erased,
+    // so the directory can hand out plain pointers to them; readers swap
+    // the shared_ptr out atomically and keep their version alive.
+    struct SnapshotSlot {
+        std::shared_ptr<const AccountSnapshot> current;  // std::atomic_load / atomic_store only
+        SeqLock<BuyingPower> buying_power;               // Version 0 until first published
+        uint64_t version = 0;                            // Writers only
+    };
+
+    // Account storage, sharded by account hash so operations on unrelated
+    // accounts take different locks. Shard locks are always taken before
+    // markets_mutex_, and several shards in ascending index order. The
+    // shard's maps draw their nodes from its pool, under its unique lock.
+    struct alignas(CACHE_LINE_SIZE) AccountShard {
+        explicit AccountShard(std::pmr::memory_resource* upstream) : arena(upstream) {}
+
+        mutable std::shared_mutex mutex;
+        PoolArena arena;
+        std::pmr::unordered_map<uint64_t, AccountState> accounts{arena.resource()};  // account_hash -> state
+        std::pmr::unordered_map<uint32_t, MarketMarks> marks{arena.resource()};       // market_id -> positions
+        IndexedHeap<uint64_t, double> risk;  // account_hash -> margin ratio, accounts with positions
+        std::pmr::unordered_map<uint64_t, SnapshotSlot> snapshot_slots{arena.resource()};  // account_hash -> slot
+        SymbolDirectory<SnapshotSlot> snapshots;  // Lock-free index over snapshot_slots
+    };
+    static constexpr size_t ACCOUNT_SHARDS = 64;  // One bit each in a shard mask
+    std::shared_ptr<NodeMemory> memory_;          // Outlives the shards' arenas
+    using Shards = std::array<AccountShard, ACCOUNT_SHARDS>;
+    Shards shards_;
+
+    // Every shard's arena is built on its final upstream: the pool takes
+    // its bookkeeping from there as soon as it is constructed
+    template<size_t... I>
+    static Shards make_shards(std::pmr::memory_resource* upstream, std::index_sequence<I...>);
+
+    static size_t shard_index(uint64_t account_hash) {
+        return static_cast<size_t>((account_hash * 0x9E3779B97F4A7C15ull) >> 58);  // Top 6 bits
+    }
+    static uint64_t shard_bit(const LXAccount& account) {
+        return uint64_t{1} << shard_index(account.hash());
+    }
+    AccountShard& shard_of(const LXAccount& account) {
+        return shards_[shard_index(account.hash())];
+    }
+    const AccountShard& shard_of(const LXAccount& account) const {
+        return shards_[shard_index(account.hash())];
+    }
+
+    // Holds the locks of every shard in `mask` (bit i = shard i), taken in
+    // ascending order so multi-account operations cannot deadlock
+    class ShardLocks {
+    public:
+        ShardLocks(const LXVault& vault, uint64_t mask, bool exclusive);
+        ~ShardLocks();
+        ShardLocks(const ShardLocks&) = delete;
+        ShardLocks& operator=(const ShardLocks&) = delete;
+
+    private:
+        const LXVault& vault_;
+        uint64_t mask_;
+        bool exclusive_;
+    };
 
     // Market configs
     std::unordered_map<uint32_t, MarketConfig> markets_;
     mutable std::shared_mutex markets_mutex_;
 
+    // Lock-free copies of the limits in markets_, written under its lock
+    std::unordered_map<uint32_t, SeqLock<MarketLimits>> market_limit_slots_;
+    SymbolDirectory<SeqLock<MarketLimits>> market_limits_;
+
     // Funding state per market
     struct FundingState {
         I128 current_rate_x18;
@@ -241,9 +444,11 @@ private:
     };
     std::unordered_map<uint32_t, FundingState> funding_;
     mutable std::shared_mutex funding_mutex_;
+    std::atomic<uint64_t> funding_epoch_{0};  // Accruals completed across every shard
 
     // Insurance fund
     std::atomic<I128> insurance_fund_{0};
+    void add_to_insurance(I128 amount_x18);
 
     // Statistics
     std::atomic<uint64_t> total_liquidations_{0};
@@ -251,7 +456,53 @@ private:
     // Mark price callback
     MarkPriceCallback mark_price_callback_;
 
-    // Internal helpers
+    // Re-read a position into its slot (adding one if needed) after its
+    // size or entry changed, and revalue it at the market's last mark.
+    // The caller also holds markets_mutex_ (shared) for the margin rates.
+    void index_position(AccountShard& shard, AccountState& state, LXPosition& position);
+    void unindex_position(AccountShard& shard, AccountState& state, uint32_t market_id);
+    static void set_slot_pnl(MarketMarks& marks, size_t slot, I128 pnl_x18);
+    void set_slot_margins(MarketMarks& marks, size_t slot, const MarketConfig* config) const;
+
+    // Lazy funding. Owed amounts are positive when the position pays;
+    // settling moves them into the position and the settlement balance.
+    static I128 slot_funding_owed(const MarketMarks& marks, size_t slot);
+    static I128 funding_owed(const AccountShard& shard, const AccountState& state);
+    static I128 funding_owed(const AccountShard& shard, const AccountState& state, uint32_t market_id);
+    static void settle_slot_funding(MarketMarks& marks, size_t slot);
+    static void settle_funding(AccountShard& shard, AccountState& state);
+
+    // Keep AccountState::collateral_x18 in step with the balance map
+    static void adjust_balance(AccountState& state, uint64_t currency_hash, I128 delta_x18);
+
+    // Re-key the account in its shard's risk heap and ADL rankings after
+    // its equity or margin moved, and publish its new snapshot. Every
+    // write ends here. Heap keys count unsettled funding against equity.
+    static double margin_ratio(const AccountShard& shard, const AccountState& state);
+    void refresh_risk(AccountShard& shard, const AccountState& state) const;
+    static void rank_adl(AccountShard& shard, const AccountState& state);
+
+    // After an accrual moved the market's funding index: heap keys only,
+    // so the owed funding alone can list an account for liquidation
+    static void rekey_funding(AccountShard& shard, const MarketMarks& marks);
+
+    // Risk heap keys at or above this may be liquidatable; the heap holds
+    // doubles, so the exact test is redone on the aggregates
+    static constexpr double LIQUIDATABLE_RATIO = 1.0 - 1e-9;
+
+    // Snapshot publication; the caller holds the shard lock exclusively
+    void publish(AccountShard& shard, const AccountState& state) const;
+    static void unpublish(AccountShard& shard, uint64_t account_hash);
+
+    // Unsettled funding of a snapshot against the markets' cumulative
+    // funding, which accrual moves before any shard's index
+    I128 funding_owed(const AccountSnapshot& snapshot) const;
+    I128 funding_owed(const AccountSnapshot& snapshot, uint32_t market_id) const;
+
+    // Fees and funding settle in this currency (simplified single quote)
+    static constexpr uint64_t SETTLEMENT_CURRENCY = 0;
+
+    // Internal helpers; the caller holds the account's shard lock
     AccountState* get_or_create_account(const LXAccount& account);
     const AccountState* get_account(const LXAccount& account) const;
 
@@ -260,10 +511,13 @@ private:
     I128 calculate_maintenance_margin(const LXPosition& pos, const MarketConfig& config) const;
     I128 calculate_unrealized_pnl(const LXPosition& pos, I128 mark_price_x18) const;
 
-    // Position updates
-    void update_position(AccountState& state, uint32_t market_id,
+    // Position updates. apply_fill folds one fill into a position value and
+    // returns the PnL it realizes; a position it takes to zero is left at
+    // size 0 for the caller to close.
+    I128 apply_fill(LXPosition& position, bool is_buy, I128 size_x18, I128 price_x18) const;
+    void update_position(AccountShard& shard, AccountState& state, uint32_t market_id,
                          bool is_buy, I128 size_x18, I128 price_x18);
-    void close_position(AccountState& state, uint32_t market_id);
+    void close_position(AccountShard& shard, AccountState& state, uint32_t market_id);
 
     // Fee calculation
     I128 calculate_fee(I128 notional_x18, I128 fee_rate_x18) const;
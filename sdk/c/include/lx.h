@@ -332,6 +332,9 @@ lx_error_t lx_orderbook_init(lx_orderbook_t *book, size_t initial_capacity);
 /* Free orderbook resources */
 void lx_orderbook_free(lx_orderbook_t *book);
 
+/* Ensure room for at least `bids` and `asks` levels, keeping current ones */
+lx_error_t lx_orderbook_reserve(lx_orderbook_t *book, size_t bids, size_t asks);
+
 /* Get best bid price */
 double lx_orderbook_best_bid(const lx_orderbook_t *book);
 
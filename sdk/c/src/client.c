@@ -4,6 +4,7 @@
  */
 
 #include "lx.h"
+#include "json.h"
 #include <libwebsockets.h>
 #include <stdlib.h>
 #include <string.h>
@@ -15,22 +16,6 @@
 /* Thread-local error message */
 static _Thread_local char tls_error[LX_MSG_LEN];
 
-/* External JSON functions (from json.c) */
-extern char *lx_json_auth(const char *api_key, const char *api_secret, const char *request_id);
-extern char *lx_json_place_order(const lx_order_t *order, const char *request_id);
-extern char *lx_json_cancel_order(uint64_t order_id, const char *request_id);
-extern char *lx_json_subscribe(const char *channel, const char *request_id);
-extern char *lx_json_unsubscribe(const char *channel, const char *request_id);
-extern char *lx_json_ping(const char *request_id);
-extern char *lx_json_get_balances(const char *request_id);
-extern char *lx_json_get_positions(const char *request_id);
-extern char *lx_json_get_orders(const char *request_id);
-extern const char *lx_json_parse_type(const char *json);
-extern lx_error_t lx_json_parse_order(const char *json, lx_order_t *order);
-extern lx_error_t lx_json_parse_trade(const char *json, lx_trade_t *trade);
-extern lx_error_t lx_json_parse_orderbook(const char *json, lx_orderbook_t *book);
-extern lx_error_t lx_json_parse_error(const char *json, char *msg_out, size_t msg_len);
-
 /* Send buffer entry */
 typedef struct send_buf {
     unsigned char *data;
@@ -68,6 +53,11 @@ struct lx_client {
     size_t recv_len;
     size_t recv_cap;
 
+    /* Tokens of the current message and the book handed to on_orderbook;
+     * both keep their storage between messages */
+    lx_json_doc_t doc;
+    lx_orderbook_t book;
+
     /* Callbacks */
     lx_callbacks_t callbacks;
 
@@ -149,31 +139,26 @@ static lx_error_t queue_send(lx_client_t *client, const char *msg) {
 static void process_message(lx_client_t *client, const char *msg, size_t len) {
     if (!client || !msg || len == 0) return;
 
-    /* Null-terminate for parsing */
-    char *json = malloc(len + 1);
-    if (!json) return;
-    memcpy(json, msg, len);
-    json[len] = '\0';
+    /* Tokenized in place in the receive buffer */
+    lx_json_doc_t *doc = &client->doc;
+    if (lx_json_doc_parse(doc, msg, len) != LX_OK) return;
 
-    const char *type = lx_json_parse_type(json);
-    if (!type) {
-        free(json);
-        return;
-    }
+    int type = lx_json_find(doc, 0, "type");
+    if (type < 0) return;
 
-    if (strcmp(type, "connected") == 0) {
+    if (lx_json_eq(doc, type, "connected")) {
         atomic_store(&client->state, LX_STATE_CONNECTED);
         if (client->callbacks.on_connect) {
             client->callbacks.on_connect(client, client->callbacks.user_data);
         }
     }
-    else if (strcmp(type, "auth_success") == 0) {
+    else if (lx_json_eq(doc, type, "auth_success")) {
         atomic_store(&client->state, LX_STATE_AUTHENTICATED);
         client->auth_pending = false;
     }
-    else if (strcmp(type, "error") == 0) {
+    else if (lx_json_eq(doc, type, "error")) {
         char err_msg[LX_MSG_LEN] = {0};
-        lx_json_parse_error(json, err_msg, sizeof(err_msg));
+        lx_json_read_error(doc, err_msg, sizeof(err_msg));
         if (client->auth_pending) {
             client->auth_pending = false;
             atomic_store(&client->state, LX_STATE_CONNECTED);
@@ -183,40 +168,36 @@ static void process_message(lx_client_t *client, const char *msg, size_t len) {
                 client->callbacks.user_data);
         }
     }
-    else if (strcmp(type, "order_update") == 0) {
+    else if (lx_json_eq(doc, type, "order_update")) {
         if (client->callbacks.on_order_update) {
             lx_order_t order;
-            if (lx_json_parse_order(json, &order) == LX_OK) {
+            if (lx_json_read_order(doc, &order) == LX_OK) {
                 client->callbacks.on_order_update(client, &order,
                     client->callbacks.user_data);
             }
         }
     }
-    else if (strcmp(type, "trade") == 0) {
+    else if (lx_json_eq(doc, type, "trade")) {
         if (client->callbacks.on_trade) {
             lx_trade_t trade;
-            if (lx_json_parse_trade(json, &trade) == LX_OK) {
+            if (lx_json_read_trade(doc, &trade) == LX_OK) {
                 client->callbacks.on_trade(client, &trade,
                     client->callbacks.user_data);
             }
         }
     }
-    else if (strcmp(type, "orderbook") == 0 || strcmp(type, "orderbook_update") == 0) {
+    else if (lx_json_eq(doc, type, "orderbook") || lx_json_eq(doc, type, "orderbook_update")) {
         if (client->callbacks.on_orderbook) {
-            lx_orderbook_t book;
-            memset(&book, 0, sizeof(book));
-            if (lx_json_parse_orderbook(json, &book) == LX_OK) {
-                client->callbacks.on_orderbook(client, &book,
+            /* Valid only during the callback; the next message reuses it */
+            if (lx_json_read_orderbook(doc, &client->book) == LX_OK) {
+                client->callbacks.on_orderbook(client, &client->book,
                     client->callbacks.user_data);
-                lx_orderbook_free(&book);
             }
         }
     }
-    else if (strcmp(type, "pong") == 0) {
+    else if (lx_json_eq(doc, type, "pong")) {
         /* Heartbeat response - no action needed */
     }
-
-    free(json);
 }
 
 /*
@@ -566,6 +547,8 @@ void lx_client_free(lx_client_t *client) {
     pthread_mutex_unlock(&client->send_mutex);
     pthread_mutex_destroy(&client->send_mutex);
 
+    lx_json_doc_free(&client->doc);
+    lx_orderbook_free(&client->book);
     free(client->recv_buf);
     free(client->ws_url);
     free(client->api_key);
@@ -1,347 +1,250 @@
 /*
  * LX C SDK - JSON parsing
- * Minimal JSON parser for protocol messages.
+ * In-place tokenizer for incoming protocol messages and builders for
+ * outgoing ones.
  */
 
-#include "lx.h"
+#include "json.h"
 #include <stdlib.h>
 #include <string.h>
 #include <stdio.h>
-#include <ctype.h>
 #include <math.h>
 
-/* Internal JSON types */
-typedef enum {
-    JSON_NULL,
-    JSON_BOOL,
-    JSON_NUMBER,
-    JSON_STRING,
-    JSON_ARRAY,
-    JSON_OBJECT
-} json_type_t;
-
-typedef struct json_value json_value_t;
-
-struct json_value {
-    json_type_t type;
-    union {
-        bool bool_val;
-        double num_val;
-        char *str_val;
-        struct {
-            json_value_t **items;
-            size_t count;
-            size_t capacity;
-        } array;
-        struct {
-            char **keys;
-            json_value_t **values;
-            size_t count;
-            size_t capacity;
-        } object;
-    } data;
-};
-
-/* Forward declarations */
-static json_value_t *json_parse_value(const char **p);
-static void json_free(json_value_t *val);
-
-/* Skip whitespace */
-static void skip_ws(const char **p) {
-    while (**p && isspace((unsigned char)**p)) {
-        (*p)++;
-    }
-}
-
-/* Parse string (after opening quote) */
-static char *json_parse_string_content(const char **p) {
-    size_t cap = 64;
-    size_t len = 0;
-    char *str = malloc(cap);
-    if (!str) return NULL;
-
-    while (**p && **p != '"') {
-        if (len + 8 >= cap) {
-            cap *= 2;
-            char *tmp = realloc(str, cap);
-            if (!tmp) { free(str); return NULL; }
-            str = tmp;
-        }
-
-        if (**p == '\\') {
-            (*p)++;
-            switch (**p) {
-                case '"': str[len++] = '"'; break;
-                case '\\': str[len++] = '\\'; break;
-                case '/': str[len++] = '/'; break;
-                case 'b': str[len++] = '\b'; break;
-                case 'f': str[len++] = '\f'; break;
-                case 'n': str[len++] = '\n'; break;
-                case 'r': str[len++] = '\r'; break;
-                case 't': str[len++] = '\t'; break;
-                case 'u': {
-                    /* Unicode escape - simplified, just skip */
-                    (*p)++;
-                    for (int i = 0; i < 4 && **p; i++) (*p)++;
-                    (*p)--;
-                    str[len++] = '?';
-                    break;
-                }
-                default:
-                    str[len++] = **p;
-            }
-        } else {
-            str[len++] = **p;
-        }
-        (*p)++;
-    }
+/*
+ * Tokenizer
+ */
 
-    if (**p == '"') (*p)++;
-    str[len] = '\0';
-    return str;
+static bool is_delimiter(char c) {
+    return c == ',' || c == ']' || c == '}' || c == ':' ||
+           c == ' ' || c == '\t' || c == '\r' || c == '\n';
 }
 
-/* Parse number */
-static double json_parse_number(const char **p) {
-    char *end;
-    double val = strtod(*p, &end);
-    *p = end;
-    return val;
-}
-
-/* Parse array */
-static json_value_t *json_parse_array(const char **p) {
-    json_value_t *arr = calloc(1, sizeof(*arr));
-    if (!arr) return NULL;
-
-    arr->type = JSON_ARRAY;
-    arr->data.array.capacity = 8;
-    arr->data.array.items = malloc(sizeof(json_value_t *) * arr->data.array.capacity);
-    if (!arr->data.array.items) { free(arr); return NULL; }
-
-    (*p)++; /* skip '[' */
-    skip_ws(p);
-
-    while (**p && **p != ']') {
-        json_value_t *item = json_parse_value(p);
-        if (!item) { json_free(arr); return NULL; }
-
-        if (arr->data.array.count >= arr->data.array.capacity) {
-            arr->data.array.capacity *= 2;
-            json_value_t **tmp = realloc(arr->data.array.items,
-                sizeof(json_value_t *) * arr->data.array.capacity);
-            if (!tmp) { json_free(item); json_free(arr); return NULL; }
-            arr->data.array.items = tmp;
-        }
-
-        arr->data.array.items[arr->data.array.count++] = item;
-
-        skip_ws(p);
-        if (**p == ',') {
-            (*p)++;
-            skip_ws(p);
-        }
-    }
+int lx_json_tokenize(const char *buf, size_t len, lx_json_tok_t *toks, size_t max) {
+    uint32_t stack[LX_JSON_MAX_DEPTH];
+    int depth = 0;
+    size_t count = 0;
+    size_t i = 0;
 
-    if (**p == ']') (*p)++;
-    return arr;
-}
+    if (len > UINT32_MAX) return LX_JSON_ERR_INVALID;
 
-/* Parse object */
-static json_value_t *json_parse_object(const char **p) {
-    json_value_t *obj = calloc(1, sizeof(*obj));
-    if (!obj) return NULL;
+    while (i < len) {
+        char c = buf[i];
+        lx_json_tok_t *tok;
 
-    obj->type = JSON_OBJECT;
-    obj->data.object.capacity = 8;
-    obj->data.object.keys = malloc(sizeof(char *) * obj->data.object.capacity);
-    obj->data.object.values = malloc(sizeof(json_value_t *) * obj->data.object.capacity);
-    if (!obj->data.object.keys || !obj->data.object.values) {
-        free(obj->data.object.keys);
-        free(obj->data.object.values);
-        free(obj);
-        return NULL;
-    }
+        switch (c) {
+            case ' ': case '\t': case '\r': case '\n': case ':': case ',':
+                i++;
+                continue;
 
-    (*p)++; /* skip '{' */
-    skip_ws(p);
-
-    while (**p && **p != '}') {
-        /* Parse key */
-        if (**p != '"') { json_free(obj); return NULL; }
-        (*p)++;
-        char *key = json_parse_string_content(p);
-        if (!key) { json_free(obj); return NULL; }
-
-        skip_ws(p);
-        if (**p != ':') { free(key); json_free(obj); return NULL; }
-        (*p)++;
-        skip_ws(p);
-
-        /* Parse value */
-        json_value_t *val = json_parse_value(p);
-        if (!val) { free(key); json_free(obj); return NULL; }
-
-        /* Expand if needed */
-        if (obj->data.object.count >= obj->data.object.capacity) {
-            obj->data.object.capacity *= 2;
-            char **tmp_k = realloc(obj->data.object.keys,
-                sizeof(char *) * obj->data.object.capacity);
-            json_value_t **tmp_v = realloc(obj->data.object.values,
-                sizeof(json_value_t *) * obj->data.object.capacity);
-            if (!tmp_k || !tmp_v) {
-                free(key);
-                json_free(val);
-                json_free(obj);
-                return NULL;
+            case '}': case ']': {
+                if (depth == 0) return LX_JSON_ERR_INVALID;
+                tok = &toks[stack[--depth]];
+                if (tok->type != (c == '}' ? LX_JSON_OBJECT : LX_JSON_ARRAY)) {
+                    return LX_JSON_ERR_INVALID;
+                }
+                if (tok->type == LX_JSON_OBJECT) {
+                    if (tok->size % 2 != 0) return LX_JSON_ERR_INVALID;
+                    tok->size /= 2; /* Counted keys and values */
+                }
+                tok->end = (uint32_t)(i + 1);
+                tok->next = (uint32_t)count;
+                i++;
+                continue;
             }
-            obj->data.object.keys = tmp_k;
-            obj->data.object.values = tmp_v;
-        }
 
-        obj->data.object.keys[obj->data.object.count] = key;
-        obj->data.object.values[obj->data.object.count] = val;
-        obj->data.object.count++;
+            default:
+                break;
+        }
 
-        skip_ws(p);
-        if (**p == ',') {
-            (*p)++;
-            skip_ws(p);
+        /* A new value (or object key) */
+        if (count >= max) return LX_JSON_ERR_NOMEM;
+        if (depth == 0 && count > 0) return LX_JSON_ERR_INVALID; /* Trailing data */
+        if (depth > 0) toks[stack[depth - 1]].size++;
+
+        tok = &toks[count];
+        tok->size = 0;
+
+        if (c == '{' || c == '[') {
+            if (depth == LX_JSON_MAX_DEPTH) return LX_JSON_ERR_INVALID;
+            tok->type = c == '{' ? LX_JSON_OBJECT : LX_JSON_ARRAY;
+            tok->start = (uint32_t)i;
+            stack[depth++] = (uint32_t)count;
+            count++;
+            i++;
+        } else if (c == '"') {
+            size_t j = i + 1;
+            while (j < len && buf[j] != '"') {
+                if (buf[j] == '\\') j++;
+                j++;
+            }
+            if (j >= len) return LX_JSON_ERR_INVALID;
+            tok->type = LX_JSON_STRING;
+            tok->start = (uint32_t)(i + 1);
+            tok->end = (uint32_t)j;
+            tok->next = (uint32_t)(++count);
+            i = j + 1;
+        } else if (c == '-' || (c >= '0' && c <= '9') || c == 't' || c == 'f' || c == 'n') {
+            size_t j = i;
+            while (j < len && !is_delimiter(buf[j])) j++;
+            tok->type = LX_JSON_PRIMITIVE;
+            tok->start = (uint32_t)i;
+            tok->end = (uint32_t)j;
+            tok->next = (uint32_t)(++count);
+            i = j;
+        } else {
+            return LX_JSON_ERR_INVALID;
         }
     }
 
-    if (**p == '}') (*p)++;
-    return obj;
+    if (depth != 0) return LX_JSON_ERR_INVALID;
+    return (int)count;
 }
 
-/* Parse any JSON value */
-static json_value_t *json_parse_value(const char **p) {
-    skip_ws(p);
-
-    if (**p == 'n' && strncmp(*p, "null", 4) == 0) {
-        *p += 4;
-        json_value_t *v = calloc(1, sizeof(*v));
-        if (v) v->type = JSON_NULL;
-        return v;
-    }
+lx_error_t lx_json_doc_parse(lx_json_doc_t *doc, const char *buf, size_t len) {
+    if (!doc || !buf) return LX_ERR_INVALID_ARG;
 
-    if (**p == 't' && strncmp(*p, "true", 4) == 0) {
-        *p += 4;
-        json_value_t *v = calloc(1, sizeof(*v));
-        if (v) { v->type = JSON_BOOL; v->data.bool_val = true; }
-        return v;
-    }
-
-    if (**p == 'f' && strncmp(*p, "false", 5) == 0) {
-        *p += 5;
-        json_value_t *v = calloc(1, sizeof(*v));
-        if (v) { v->type = JSON_BOOL; v->data.bool_val = false; }
-        return v;
-    }
-
-    if (**p == '"') {
-        (*p)++;
-        char *str = json_parse_string_content(p);
-        if (!str) return NULL;
-        json_value_t *v = calloc(1, sizeof(*v));
-        if (!v) { free(str); return NULL; }
-        v->type = JSON_STRING;
-        v->data.str_val = str;
-        return v;
+    if (!doc->toks) {
+        doc->cap = 256;
+        doc->toks = malloc(sizeof(lx_json_tok_t) * doc->cap);
+        if (!doc->toks) {
+            doc->cap = 0;
+            return LX_ERR_NO_MEMORY;
+        }
     }
 
-    if (**p == '[') {
-        return json_parse_array(p);
-    }
+    for (;;) {
+        int n = lx_json_tokenize(buf, len, doc->toks, doc->cap);
+        if (n > 0) {
+            doc->buf = buf;
+            doc->count = n;
+            return LX_OK;
+        }
+        if (n != LX_JSON_ERR_NOMEM) {
+            doc->count = 0;
+            return LX_ERR_PARSE;
+        }
 
-    if (**p == '{') {
-        return json_parse_object(p);
+        /* Only messages larger than any seen before get here */
+        size_t new_cap = doc->cap * 2;
+        lx_json_tok_t *tmp = realloc(doc->toks, sizeof(lx_json_tok_t) * new_cap);
+        if (!tmp) return LX_ERR_NO_MEMORY;
+        doc->toks = tmp;
+        doc->cap = new_cap;
     }
+}
 
-    if (**p == '-' || isdigit((unsigned char)**p)) {
-        json_value_t *v = calloc(1, sizeof(*v));
-        if (!v) return NULL;
-        v->type = JSON_NUMBER;
-        v->data.num_val = json_parse_number(p);
-        return v;
-    }
+void lx_json_doc_free(lx_json_doc_t *doc) {
+    if (!doc) return;
+    free(doc->toks);
+    memset(doc, 0, sizeof(*doc));
+}
 
-    return NULL;
+static bool tok_valid(const lx_json_doc_t *doc, int tok) {
+    return doc && tok >= 0 && tok < doc->count;
 }
 
-/* Free JSON value */
-static void json_free(json_value_t *val) {
-    if (!val) return;
+int lx_json_find(const lx_json_doc_t *doc, int obj, const char *key) {
+    if (!tok_valid(doc, obj) || doc->toks[obj].type != LX_JSON_OBJECT) return -1;
 
-    switch (val->type) {
-        case JSON_STRING:
-            free(val->data.str_val);
-            break;
-        case JSON_ARRAY:
-            for (size_t i = 0; i < val->data.array.count; i++) {
-                json_free(val->data.array.items[i]);
-            }
-            free(val->data.array.items);
-            break;
-        case JSON_OBJECT:
-            for (size_t i = 0; i < val->data.object.count; i++) {
-                free(val->data.object.keys[i]);
-                json_free(val->data.object.values[i]);
-            }
-            free(val->data.object.keys);
-            free(val->data.object.values);
-            break;
-        default:
-            break;
+    /* Members are key, value pairs; next skips a value's children */
+    int k = obj + 1;
+    for (uint32_t m = 0; m < doc->toks[obj].size; m++) {
+        if (lx_json_eq(doc, k, key)) return k + 1;
+        k = (int)doc->toks[k + 1].next;
     }
-    free(val);
+    return -1;
 }
 
-/* Get object field */
-static json_value_t *json_get(json_value_t *obj, const char *key) {
-    if (!obj || obj->type != JSON_OBJECT) return NULL;
+bool lx_json_eq(const lx_json_doc_t *doc, int tok, const char *s) {
+    if (!tok_valid(doc, tok) || doc->toks[tok].type != LX_JSON_STRING) return false;
+    const lx_json_tok_t *t = &doc->toks[tok];
+    size_t n = strlen(s);
+    return t->end - t->start == n && memcmp(doc->buf + t->start, s, n) == 0;
+}
 
-    for (size_t i = 0; i < obj->data.object.count; i++) {
-        if (strcmp(obj->data.object.keys[i], key) == 0) {
-            return obj->data.object.values[i];
-        }
-    }
-    return NULL;
+/* Copy a primitive into a terminated buffer for strtod/strtoull; the
+ * source buffer need not be terminated */
+static bool primitive_text(const lx_json_doc_t *doc, int tok, char *out, size_t out_len) {
+    if (!tok_valid(doc, tok) || doc->toks[tok].type != LX_JSON_PRIMITIVE) return false;
+    const lx_json_tok_t *t = &doc->toks[tok];
+    size_t n = t->end - t->start;
+    if (n == 0 || n >= out_len) return false;
+    memcpy(out, doc->buf + t->start, n);
+    out[n] = '\0';
+    return true;
 }
 
-/* Get string value */
-static const char *json_get_string(json_value_t *obj, const char *key) {
-    json_value_t *v = json_get(obj, key);
-    if (v && v->type == JSON_STRING) return v->data.str_val;
-    return NULL;
+double lx_json_number(const lx_json_doc_t *doc, int tok, double def) {
+    char text[64];
+    if (!primitive_text(doc, tok, text, sizeof(text))) return def;
+    char *end;
+    double val = strtod(text, &end);
+    return (end != text && *end == '\0') ? val : def;
 }
 
-/* Get number value */
-static double json_get_number(json_value_t *obj, const char *key, double def) {
-    json_value_t *v = json_get(obj, key);
-    if (v && v->type == JSON_NUMBER) return v->data.num_val;
+uint64_t lx_json_uint(const lx_json_doc_t *doc, int tok, uint64_t def) {
+    char text[64];
+    if (!primitive_text(doc, tok, text, sizeof(text))) return def;
+    if (text[0] == '-') return def;
+    char *end;
+    unsigned long long val = strtoull(text, &end, 10);
+    if (end != text && *end == '\0') return (uint64_t)val;
+    /* Exponent or fraction: go through double as before */
+    double d = lx_json_number(doc, tok, -1.0);
+    return d >= 0.0 ? (uint64_t)d : def;
+}
+
+bool lx_json_bool(const lx_json_doc_t *doc, int tok, bool def) {
+    if (!tok_valid(doc, tok) || doc->toks[tok].type != LX_JSON_PRIMITIVE) return def;
+    const lx_json_tok_t *t = &doc->toks[tok];
+    if (t->end - t->start == 4 && memcmp(doc->buf + t->start, "true", 4) == 0) return true;
+    if (t->end - t->start == 5 && memcmp(doc->buf + t->start, "false", 5) == 0) return false;
     return def;
 }
 
-/* Get bool value */
-static bool json_get_bool(json_value_t *obj, const char *key, bool def) {
-    json_value_t *v = json_get(obj, key);
-    if (v && v->type == JSON_BOOL) return v->data.bool_val;
-    return def;
+size_t lx_json_copy(const lx_json_doc_t *doc, int tok, char *out, size_t out_len) {
+    if (!out || out_len == 0) return 0;
+    out[0] = '\0';
+    if (!tok_valid(doc, tok) || doc->toks[tok].type != LX_JSON_STRING) return 0;
+
+    const lx_json_tok_t *t = &doc->toks[tok];
+    const char *p = doc->buf + t->start;
+    const char *end = doc->buf + t->end;
+    size_t len = 0;
+
+    while (p < end && len + 1 < out_len) {
+        char c = *p++;
+        if (c == '\\' && p < end) {
+            switch (*p++) {
+                case 'b': c = '\b'; break;
+                case 'f': c = '\f'; break;
+                case 'n': c = '\n'; break;
+                case 'r': c = '\r'; break;
+                case 't': c = '\t'; break;
+                case 'u':
+                    /* Unicode escape - simplified, just skip */
+                    p += (end - p < 4) ? end - p : 4;
+                    c = '?';
+                    break;
+                default: c = p[-1]; break;  /* \" \\ \/ */
+            }
+        }
+        out[len++] = c;
+    }
+    out[len] = '\0';
+    return len;
 }
 
-/* Get array */
-static json_value_t *json_get_array(json_value_t *obj, const char *key) {
-    json_value_t *v = json_get(obj, key);
-    if (v && v->type == JSON_ARRAY) return v;
-    return NULL;
+/* First of `a` and `b` present in obj, e.g. "price" then "Price" */
+static int find_either(const lx_json_doc_t *doc, int obj, const char *a, const char *b) {
+    int tok = lx_json_find(doc, obj, a);
+    return tok >= 0 ? tok : lx_json_find(doc, obj, b);
 }
 
-/* Get object */
-static json_value_t *json_get_object(json_value_t *obj, const char *key) {
-    json_value_t *v = json_get(obj, key);
-    if (v && v->type == JSON_OBJECT) return v;
-    return NULL;
+/* Member `key` of obj if it is an object, else -1 */
+static int find_object(const lx_json_doc_t *doc, int obj, const char *key) {
+    int tok = lx_json_find(doc, obj, key);
+    return (tok >= 0 && doc->toks[tok].type == LX_JSON_OBJECT) ? tok : -1;
 }
 
 /*
@@ -649,221 +552,146 @@ char *lx_json_get_orders(const char *request_id) {
 }
 
 /*
- * Parsing functions for incoming messages
+ * Readers for incoming messages
  */
 
-/* Parse message type */
-const char *lx_json_parse_type(const char *json) {
-    const char *p = json;
-    json_value_t *root = json_parse_value(&p);
-    if (!root) return NULL;
-
-    const char *type = json_get_string(root, "type");
-    /* Note: caller must use result immediately or copy it */
-    static char type_buf[64];
-    if (type) {
-        strncpy(type_buf, type, sizeof(type_buf) - 1);
-        type_buf[sizeof(type_buf) - 1] = '\0';
-    } else {
-        type_buf[0] = '\0';
-    }
-
-    json_free(root);
-    return type_buf[0] ? type_buf : NULL;
-}
-
-/* Parse order from JSON */
-lx_error_t lx_json_parse_order(const char *json, lx_order_t *order) {
-    if (!json || !order) return LX_ERR_INVALID_ARG;
-
-    const char *p = json;
-    json_value_t *root = json_parse_value(&p);
-    if (!root) return LX_ERR_PARSE;
+/* Read order from a message */
+lx_error_t lx_json_read_order(const lx_json_doc_t *doc, lx_order_t *order) {
+    if (!doc || doc->count == 0 || !order) return LX_ERR_INVALID_ARG;
 
     /* Get order data - could be at root or in "data.order" */
-    json_value_t *data = json_get_object(root, "data");
-    json_value_t *ord = data ? json_get_object(data, "order") : root;
-    if (!ord) ord = root;
+    int root = 0;
+    int data = find_object(doc, root, "data");
+    int ord = data >= 0 ? find_object(doc, data, "order") : root;
+    if (ord < 0) ord = root;
 
     memset(order, 0, sizeof(*order));
 
-    order->order_id = (uint64_t)json_get_number(ord, "orderId", 0);
+    order->order_id = lx_json_uint(doc, lx_json_find(doc, ord, "orderId"), 0);
     if (order->order_id == 0) {
-        order->order_id = (uint64_t)json_get_number(ord, "ID", 0);
+        order->order_id = lx_json_uint(doc, lx_json_find(doc, ord, "ID"), 0);
     }
 
-    const char *sym = json_get_string(ord, "symbol");
-    if (!sym) sym = json_get_string(ord, "Symbol");
-    if (sym) strncpy(order->symbol, sym, LX_SYMBOL_LEN - 1);
+    lx_json_copy(doc, find_either(doc, ord, "symbol", "Symbol"), order->symbol, LX_SYMBOL_LEN);
 
-    const char *side = json_get_string(ord, "side");
-    if (!side) side = json_get_string(ord, "Side");
-    if (side) {
-        order->side = (strcmp(side, "sell") == 0 || strcmp(side, "SELL") == 0)
+    int side = find_either(doc, ord, "side", "Side");
+    if (side >= 0) {
+        order->side = (lx_json_eq(doc, side, "sell") || lx_json_eq(doc, side, "SELL"))
             ? LX_SIDE_SELL : LX_SIDE_BUY;
     }
 
-    order->price = json_get_number(ord, "price", 0);
-    if (order->price == 0) order->price = json_get_number(ord, "Price", 0);
+    order->price = lx_json_number(doc, lx_json_find(doc, ord, "price"), 0);
+    if (order->price == 0) order->price = lx_json_number(doc, lx_json_find(doc, ord, "Price"), 0);
 
-    order->size = json_get_number(ord, "size", 0);
-    if (order->size == 0) order->size = json_get_number(ord, "Size", 0);
+    order->size = lx_json_number(doc, lx_json_find(doc, ord, "size"), 0);
+    if (order->size == 0) order->size = lx_json_number(doc, lx_json_find(doc, ord, "Size"), 0);
 
-    order->filled = json_get_number(ord, "filled", 0);
-    order->remaining = json_get_number(ord, "remaining", order->size - order->filled);
+    order->filled = lx_json_number(doc, lx_json_find(doc, ord, "filled"), 0);
+    order->remaining = lx_json_number(doc, lx_json_find(doc, ord, "remaining"),
+                                      order->size - order->filled);
 
-    const char *status = json_get_string(ord, "status");
-    if (status) {
-        if (strcmp(status, "open") == 0) order->status = LX_STATUS_OPEN;
-        else if (strcmp(status, "partial") == 0) order->status = LX_STATUS_PARTIAL;
-        else if (strcmp(status, "filled") == 0) order->status = LX_STATUS_FILLED;
-        else if (strcmp(status, "cancelled") == 0) order->status = LX_STATUS_CANCELLED;
-        else if (strcmp(status, "rejected") == 0) order->status = LX_STATUS_REJECTED;
-    }
+    int status = lx_json_find(doc, ord, "status");
+    if (lx_json_eq(doc, status, "open")) order->status = LX_STATUS_OPEN;
+    else if (lx_json_eq(doc, status, "partial")) order->status = LX_STATUS_PARTIAL;
+    else if (lx_json_eq(doc, status, "filled")) order->status = LX_STATUS_FILLED;
+    else if (lx_json_eq(doc, status, "cancelled")) order->status = LX_STATUS_CANCELLED;
+    else if (lx_json_eq(doc, status, "rejected")) order->status = LX_STATUS_REJECTED;
 
-    order->timestamp = (int64_t)json_get_number(ord, "timestamp", 0);
-    order->post_only = json_get_bool(ord, "postOnly", false);
-    order->reduce_only = json_get_bool(ord, "reduceOnly", false);
+    order->timestamp = (int64_t)lx_json_number(doc, lx_json_find(doc, ord, "timestamp"), 0);
+    order->post_only = lx_json_bool(doc, lx_json_find(doc, ord, "postOnly"), false);
+    order->reduce_only = lx_json_bool(doc, lx_json_find(doc, ord, "reduceOnly"), false);
 
-    json_free(root);
     return LX_OK;
 }
 
-/* Parse trade from JSON */
-lx_error_t lx_json_parse_trade(const char *json, lx_trade_t *trade) {
-    if (!json || !trade) return LX_ERR_INVALID_ARG;
-
-    const char *p = json;
-    json_value_t *root = json_parse_value(&p);
-    if (!root) return LX_ERR_PARSE;
+/* Read trade from a message */
+lx_error_t lx_json_read_trade(const lx_json_doc_t *doc, lx_trade_t *trade) {
+    if (!doc || doc->count == 0 || !trade) return LX_ERR_INVALID_ARG;
 
-    json_value_t *data = json_get_object(root, "data");
-    json_value_t *t = data ? data : root;
+    int data = find_object(doc, 0, "data");
+    int t = data >= 0 ? data : 0;
 
     memset(trade, 0, sizeof(*trade));
 
-    trade->trade_id = (uint64_t)json_get_number(t, "tradeId", 0);
+    trade->trade_id = lx_json_uint(doc, lx_json_find(doc, t, "tradeId"), 0);
+    lx_json_copy(doc, lx_json_find(doc, t, "symbol"), trade->symbol, LX_SYMBOL_LEN);
 
-    const char *sym = json_get_string(t, "symbol");
-    if (sym) strncpy(trade->symbol, sym, LX_SYMBOL_LEN - 1);
+    trade->price = lx_json_number(doc, lx_json_find(doc, t, "price"), 0);
+    trade->size = lx_json_number(doc, lx_json_find(doc, t, "size"), 0);
 
-    trade->price = json_get_number(t, "price", 0);
-    trade->size = json_get_number(t, "size", 0);
-
-    const char *side = json_get_string(t, "side");
-    if (side) {
-        trade->side = (strcmp(side, "sell") == 0) ? LX_SIDE_SELL : LX_SIDE_BUY;
+    int side = lx_json_find(doc, t, "side");
+    if (side >= 0) {
+        trade->side = lx_json_eq(doc, side, "sell") ? LX_SIDE_SELL : LX_SIDE_BUY;
     }
 
-    trade->buy_order_id = (uint64_t)json_get_number(t, "buyOrderId", 0);
-    trade->sell_order_id = (uint64_t)json_get_number(t, "sellOrderId", 0);
-
-    const char *buyer = json_get_string(t, "buyerId");
-    if (buyer) strncpy(trade->buyer_id, buyer, LX_USER_ID_LEN - 1);
+    trade->buy_order_id = lx_json_uint(doc, lx_json_find(doc, t, "buyOrderId"), 0);
+    trade->sell_order_id = lx_json_uint(doc, lx_json_find(doc, t, "sellOrderId"), 0);
 
-    const char *seller = json_get_string(t, "sellerId");
-    if (seller) strncpy(trade->seller_id, seller, LX_USER_ID_LEN - 1);
+    lx_json_copy(doc, lx_json_find(doc, t, "buyerId"), trade->buyer_id, LX_USER_ID_LEN);
+    lx_json_copy(doc, lx_json_find(doc, t, "sellerId"), trade->seller_id, LX_USER_ID_LEN);
 
-    trade->timestamp = (int64_t)json_get_number(t, "timestamp", 0);
+    trade->timestamp = (int64_t)lx_json_number(doc, lx_json_find(doc, t, "timestamp"), 0);
 
-    json_free(root);
     return LX_OK;
 }
 
-/* Parse orderbook from JSON */
-lx_error_t lx_json_parse_orderbook(const char *json, lx_orderbook_t *book) {
-    if (!json || !book) return LX_ERR_INVALID_ARG;
+/* Fill levels[0, count) from an array of {price, size, count} objects */
+static void read_levels(const lx_json_doc_t *doc, int arr, lx_price_level_t *levels) {
+    int level = arr + 1;
+    for (uint32_t i = 0; i < doc->toks[arr].size; i++) {
+        levels[i].price = lx_json_number(doc, lx_json_find(doc, level, "price"), 0);
+        if (levels[i].price == 0)
+            levels[i].price = lx_json_number(doc, lx_json_find(doc, level, "Price"), 0);
+        levels[i].size = lx_json_number(doc, lx_json_find(doc, level, "size"), 0);
+        if (levels[i].size == 0)
+            levels[i].size = lx_json_number(doc, lx_json_find(doc, level, "Size"), 0);
+        levels[i].count = (int32_t)lx_json_number(doc, lx_json_find(doc, level, "count"), 1);
+        level = (int)doc->toks[level].next;
+    }
+}
 
-    const char *p = json;
-    json_value_t *root = json_parse_value(&p);
-    if (!root) return LX_ERR_PARSE;
+/* Read orderbook from a message */
+lx_error_t lx_json_read_orderbook(const lx_json_doc_t *doc, lx_orderbook_t *book) {
+    if (!doc || doc->count == 0 || !book) return LX_ERR_INVALID_ARG;
 
-    json_value_t *data = json_get_object(root, "data");
-    json_value_t *b = data ? data : root;
+    int data = find_object(doc, 0, "data");
+    int b = data >= 0 ? data : 0;
 
-    const char *sym = json_get_string(b, "symbol");
-    if (!sym) sym = json_get_string(b, "Symbol");
-    if (sym) strncpy(book->symbol, sym, LX_SYMBOL_LEN - 1);
+    book->symbol[0] = '\0';
+    book->bids_count = 0;
+    book->asks_count = 0;
 
-    book->timestamp = (int64_t)json_get_number(b, "timestamp", 0);
-    if (book->timestamp == 0) book->timestamp = (int64_t)json_get_number(b, "Timestamp", 0);
+    lx_json_copy(doc, find_either(doc, b, "symbol", "Symbol"), book->symbol, LX_SYMBOL_LEN);
 
-    /* Parse bids */
-    json_value_t *bids = json_get_array(b, "bids");
-    if (!bids) bids = json_get_array(b, "Bids");
-    if (bids) {
-        size_t count = bids->data.array.count;
-        if (count > book->bids_capacity) {
-            lx_price_level_t *new_bids = realloc(book->bids,
-                sizeof(lx_price_level_t) * count);
-            if (!new_bids) {
-                json_free(root);
-                return LX_ERR_NO_MEMORY;
-            }
-            book->bids = new_bids;
-            book->bids_capacity = count;
-        }
+    book->timestamp = (int64_t)lx_json_number(doc, lx_json_find(doc, b, "timestamp"), 0);
+    if (book->timestamp == 0)
+        book->timestamp = (int64_t)lx_json_number(doc, lx_json_find(doc, b, "Timestamp"), 0);
 
-        book->bids_count = count;
-        for (size_t i = 0; i < count; i++) {
-            json_value_t *level = bids->data.array.items[i];
-            book->bids[i].price = json_get_number(level, "price", 0);
-            if (book->bids[i].price == 0)
-                book->bids[i].price = json_get_number(level, "Price", 0);
-            book->bids[i].size = json_get_number(level, "size", 0);
-            if (book->bids[i].size == 0)
-                book->bids[i].size = json_get_number(level, "Size", 0);
-            book->bids[i].count = (int32_t)json_get_number(level, "count", 1);
-        }
-    }
+    int bids = find_either(doc, b, "bids", "Bids");
+    int asks = find_either(doc, b, "asks", "Asks");
+    if (bids >= 0 && doc->toks[bids].type != LX_JSON_ARRAY) bids = -1;
+    if (asks >= 0 && doc->toks[asks].type != LX_JSON_ARRAY) asks = -1;
 
-    /* Parse asks */
-    json_value_t *asks = json_get_array(b, "asks");
-    if (!asks) asks = json_get_array(b, "Asks");
-    if (asks) {
-        size_t count = asks->data.array.count;
-        if (count > book->asks_capacity) {
-            lx_price_level_t *new_asks = realloc(book->asks,
-                sizeof(lx_price_level_t) * count);
-            if (!new_asks) {
-                json_free(root);
-                return LX_ERR_NO_MEMORY;
-            }
-            book->asks = new_asks;
-            book->asks_capacity = count;
-        }
+    size_t bid_count = bids >= 0 ? doc->toks[bids].size : 0;
+    size_t ask_count = asks >= 0 ? doc->toks[asks].size : 0;
+    lx_error_t err = lx_orderbook_reserve(book, bid_count, ask_count);
+    if (err != LX_OK) return err;
 
-        book->asks_count = count;
-        for (size_t i = 0; i < count; i++) {
-            json_value_t *level = asks->data.array.items[i];
-            book->asks[i].price = json_get_number(level, "price", 0);
-            if (book->asks[i].price == 0)
-                book->asks[i].price = json_get_number(level, "Price", 0);
-            book->asks[i].size = json_get_number(level, "size", 0);
-            if (book->asks[i].size == 0)
-                book->asks[i].size = json_get_number(level, "Size", 0);
-            book->asks[i].count = (int32_t)json_get_number(level, "count", 1);
-        }
-    }
+    if (bids >= 0) read_levels(doc, bids, book->bids);
+    if (asks >= 0) read_levels(doc, asks, book->asks);
+    book->bids_count = bid_count;
+    book->asks_count = ask_count;
 
-    json_free(root);
     return LX_OK;
 }
 
-/* Parse error from JSON */
-lx_error_t lx_json_parse_error(const char *json, char *msg_out, size_t msg_len) {
-    if (!json) return LX_ERR_INVALID_ARG;
+/* Read error text from a message */
+lx_error_t lx_json_read_error(const lx_json_doc_t *doc, char *msg_out, size_t msg_len) {
+    if (!doc || doc->count == 0) return LX_ERR_INVALID_ARG;
 
-    const char *p = json;
-    json_value_t *root = json_parse_value(&p);
-    if (!root) return LX_ERR_PARSE;
+    int err = lx_json_find(doc, 0, "error");
+    if (err < 0 || doc->toks[err].type != LX_JSON_STRING) return LX_ERR_PARSE;
 
-    const char *err = json_get_string(root, "error");
-    if (err && msg_out) {
-        strncpy(msg_out, err, msg_len - 1);
-        msg_out[msg_len - 1] = '\0';
-    }
-
-    json_free(root);
-    return err ? LX_OK : LX_ERR_PARSE;
+    lx_json_copy(doc, err, msg_out, msg_len);
+    return LX_OK;
 }
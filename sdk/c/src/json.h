@@ -0,0 +1,102 @@
+/*
+ * LX C SDK - JSON (internal)
+ * Protocol message builders and the in-place tokenizer used to read
+ * incoming messages. Not part of the public API.
+ */
+
+#ifndef LX_JSON_H
+#define LX_JSON_H
+
+#include "lx.h"
+
+/*
+ * Tokenizer
+ *
+ * Incoming messages are not copied or built into a tree. One pass over
+ * the received buffer records each value as a token holding its offsets,
+ * in document order, and readers pull fields out of the buffer through
+ * the tokens. Strings are left escaped until copied out. The token array
+ * is reused from message to message, so steady-state parsing does not
+ * allocate.
+ */
+
+typedef enum {
+    LX_JSON_OBJECT = 1,
+    LX_JSON_ARRAY,
+    LX_JSON_STRING,
+    LX_JSON_PRIMITIVE           /* number, true, false or null */
+} lx_json_type_t;
+
+typedef struct {
+    lx_json_type_t type;
+    uint32_t start;             /* First byte; strings exclude the quotes */
+    uint32_t end;               /* One past the last byte */
+    uint32_t size;              /* Object: members; array: elements */
+    uint32_t next;              /* Token after this value and its children */
+} lx_json_tok_t;
+
+/* lx_json_tokenize errors */
+#define LX_JSON_ERR_NOMEM   (-1)    /* More tokens than fit in the array */
+#define LX_JSON_ERR_INVALID (-2)    /* Malformed or nested too deeply */
+
+#define LX_JSON_MAX_DEPTH 32
+
+/* A tokenized message; toks is kept between messages */
+typedef struct {
+    const char *buf;
+    lx_json_tok_t *toks;
+    int count;
+    size_t cap;
+} lx_json_doc_t;
+
+/* Tokenize buf[0, len) into at most max tokens; the root is token 0.
+ * Returns the token count or an LX_JSON_ERR_* value. */
+int lx_json_tokenize(const char *buf, size_t len, lx_json_tok_t *toks, size_t max);
+
+/* Tokenize a message into doc, growing its token array if needed. The
+ * buffer must stay alive while doc is read. */
+lx_error_t lx_json_doc_parse(lx_json_doc_t *doc, const char *buf, size_t len);
+void lx_json_doc_free(lx_json_doc_t *doc);
+
+/* Token of the value of `key` in object token `obj`, or -1 */
+int lx_json_find(const lx_json_doc_t *doc, int obj, const char *key);
+
+/* Whether string token `tok` equals s */
+bool lx_json_eq(const lx_json_doc_t *doc, int tok, const char *s);
+
+/* Scalar values of a token; def if absent (-1) or of another type */
+double lx_json_number(const lx_json_doc_t *doc, int tok, double def);
+uint64_t lx_json_uint(const lx_json_doc_t *doc, int tok, uint64_t def);
+bool lx_json_bool(const lx_json_doc_t *doc, int tok, bool def);
+
+/* Unescape string token `tok` into out (always terminated, truncated to
+ * fit). Returns the length written, 0 if tok is not a string. */
+size_t lx_json_copy(const lx_json_doc_t *doc, int tok, char *out, size_t out_len);
+
+/*
+ * Message readers
+ */
+
+lx_error_t lx_json_read_order(const lx_json_doc_t *doc, lx_order_t *order);
+lx_error_t lx_json_read_trade(const lx_json_doc_t *doc, lx_trade_t *trade);
+
+/* Levels are written into book's existing storage, grown only when a
+ * message has more levels than it holds */
+lx_error_t lx_json_read_orderbook(const lx_json_doc_t *doc, lx_orderbook_t *book);
+lx_error_t lx_json_read_error(const lx_json_doc_t *doc, char *msg_out, size_t msg_len);
+
+/*
+ * Message builders (caller frees the result)
+ */
+
+char *lx_json_auth(const char *api_key, const char *api_secret, const char *request_id);
+char *lx_json_place_order(const lx_order_t *order, const char *request_id);
+char *lx_json_cancel_order(uint64_t order_id, const char *request_id);
+char *lx_json_subscribe(const char *channel, const char *request_id);
+char *lx_json_unsubscribe(const char *channel, const char *request_id);
+char *lx_json_ping(const char *request_id);
+char *lx_json_get_balances(const char *request_id);
+char *lx_json_get_positions(const char *request_id);
+char *lx_json_get_orders(const char *request_id);
+
+#endif /* LX_JSON_H */
@@ -88,6 +88,26 @@ void lx_orderbook_free(lx_orderbook_t *book) {
     book->asks_capacity = 0;
 }
 
+lx_error_t lx_orderbook_reserve(lx_orderbook_t *book, size_t bids, size_t asks) {
+    if (!book) return LX_ERR_INVALID_ARG;
+
+    if (bids > book->bids_capacity) {
+        lx_price_level_t *new_bids = realloc(book->bids, sizeof(lx_price_level_t) * bids);
+        if (!new_bids) return LX_ERR_NO_MEMORY;
+        book->bids = new_bids;
+        book->bids_capacity = bids;
+    }
+
+    if (asks > book->asks_capacity) {
+        lx_price_level_t *new_asks = realloc(book->asks, sizeof(lx_price_level_t) * asks);
+        if (!new_asks) return LX_ERR_NO_MEMORY;
+        book->asks = new_asks;
+        book->asks_capacity = asks;
+    }
+
+    return LX_OK;
+}
+
 double lx_orderbook_best_bid(const lx_orderbook_t *book) {
     if (!book || book->bids_count == 0) return 0.0;
     return book->bids[0].price;
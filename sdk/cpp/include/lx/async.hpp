@@ -0,0 +1,375 @@
+// LX C++ SDK - Coroutines
+// Copyright (c) 2025 Lux Partners Limited
+// SPDX-License-Identifier: MIT
+
+#ifndef LX_ASYNC_HPP
+#define LX_ASYNC_HPP
+
+// C++20 only; the SDK builds it with -DLX_COROUTINES=ON
+
+#if !defined(__cpp_impl_coroutine)
+#error "lx/async.hpp needs C++20 coroutines (configure with -DLX_COROUTINES=ON)"
+#endif
+
+#include "client.hpp"
+
+#include <chrono>
+#include <condition_variable>
+#include <coroutine>
+#include <deque>
+#include <exception>
+#include <functional>
+#include <memory>
+#include <mutex>
+#include <optional>
+#include <queue>
+#include <string>
+#include <unordered_map>
+#include <unordered_set>
+#include <utility>
+#include <vector>
+
+namespace lx::async {
+
+template<typename T = void>
+class Task;
+class EventLoop;
+
+namespace detail {
+
+struct PromiseBase {
+    std::coroutine_handle<> continuation;
+    std::exception_ptr error;
+
+    // Hands control straight to the awaiting coroutine
+    struct FinalAwaiter {
+        bool await_ready() const noexcept { return false; }
+        template<typename Promise>
+        std::coroutine_handle<> await_suspend(std::coroutine_handle<Promise> done) noexcept {
+            std::coroutine_handle<> next = done.promise().continuation;
+            return next ? next : std::noop_coroutine();
+        }
+        void await_resume() const noexcept {}
+    };
+
+    std::suspend_always initial_suspend() const noexcept { return {}; }
+    FinalAwaiter final_suspend() const noexcept { return {}; }
+    void unhandled_exception() noexcept { error = std::current_exception(); }
+};
+
+template<typename T>
+struct Promise : PromiseBase {
+    std::optional<T> value;
+
+    Task<T> get_return_object() noexcept;
+    template<typename U>
+    void return_value(U&& result) { value.emplace(std::forward<U>(result)); }
+    T take() {
+        if (error) std::rethrow_exception(error);
+        return std::move(*value);
+    }
+};
+
+template<>
+struct Promise<void> : PromiseBase {
+    Task<void> get_return_object() noexcept;
+    void return_void() const noexcept {}
+    void take() const {
+        if (error) std::rethrow_exception(error);
+    }
+};
+
+} // namespace detail
+
+/// Lazily started coroutine producing T. Awaiting it runs it and resumes
+/// the caller when it finishes, rethrowing anything it threw. Move-only;
+/// the frame is destroyed with the Task.
+template<typename T>
+class [[nodiscard]] Task {
+public:
+    using promise_type = detail::Promise<T>;
+    using Handle = std::coroutine_handle<promise_type>;
+
+    Task() = default;
+    explicit Task(Handle handle) noexcept : handle_(handle) {}
+    Task(Task&& other) noexcept : handle_(std::exchange(other.handle_, {})) {}
+    Task& operator=(Task&& other) noexcept {
+        if (this != &other) {
+            if (handle_) handle_.destroy();
+            handle_ = std::exchange(other.handle_, {});
+        }
+        return *this;
+    }
+    Task(const Task&) = delete;
+    Task& operator=(const Task&) = delete;
+    ~Task() {
+        if (handle_) handle_.destroy();
+    }
+
+    [[nodiscard]] bool done() const noexcept { return !handle_ || handle_.done(); }
+
+    bool await_ready() const noexcept { return done(); }
+    std::coroutine_handle<> await_suspend(std::coroutine_handle<> caller) noexcept {
+        handle_.promise().continuation = caller;
+        return handle_;
+    }
+    T await_resume() { return handle_.promise().take(); }
+
+private:
+    Handle handle_;
+};
+
+namespace detail {
+
+template<typename T>
+Task<T> Promise<T>::get_return_object() noexcept {
+    return Task<T>(std::coroutine_handle<Promise<T>>::from_promise(*this));
+}
+
+inline Task<void> Promise<void>::get_return_object() noexcept {
+    return Task<void>(std::coroutine_handle<Promise<void>>::from_promise(*this));
+}
+
+// Root coroutine of a spawned flow; frees itself when the flow finishes
+struct Detached {
+    struct promise_type {
+        EventLoop* loop = nullptr;
+
+        struct FinalAwaiter {
+            bool await_ready() const noexcept { return false; }
+            void await_suspend(std::coroutine_handle<promise_type> done) noexcept;
+            void await_resume() const noexcept {}
+        };
+
+        Detached get_return_object() noexcept {
+            return {std::coroutine_handle<promise_type>::from_promise(*this)};
+        }
+        std::suspend_always initial_suspend() const noexcept { return {}; }
+        FinalAwaiter final_suspend() const noexcept { return {}; }
+        void return_void() const noexcept {}
+        void unhandled_exception() const noexcept { std::terminate(); }
+    };
+    std::coroutine_handle<promise_type> handle;
+};
+
+} // namespace detail
+
+/// Runs coroutine flows on the thread that calls run(). Replies and
+/// updates arriving on the client's IO thread are handed in through
+/// post(), so a flow only ever runs on the loop's thread.
+class EventLoop {
+public:
+    using Clock = std::chrono::steady_clock;
+
+    EventLoop() = default;
+
+    /// Destroys flows still suspended
+    ~EventLoop();
+
+    EventLoop(const EventLoop&) = delete;
+    EventLoop& operator=(const EventLoop&) = delete;
+
+    /// Loop running on this thread; nullptr outside run() / run_once()
+    [[nodiscard]] static EventLoop* current() noexcept { return current_; }
+
+    /// Start a flow on the next turn. An exception escaping a flow stops
+    /// the loop and is rethrown by run().
+    void spawn(Task<void> task);
+
+    /// Resume `handle` on the next turn (loop thread only)
+    void schedule(std::coroutine_handle<> handle) { ready_.push_back(handle); }
+
+    /// Run `fn` on the loop thread at `deadline` / after `delay` (loop
+    /// thread only)
+    void call_at(Clock::time_point deadline, std::function<void()> fn);
+    void call_later(Clock::duration delay, std::function<void()> fn) {
+        call_at(Clock::now() + delay, std::move(fn));
+    }
+
+    /// Run `fn` on the loop thread, waking an idle run() (any thread)
+    void post(std::function<void()> fn);
+
+    /// Turn until every spawned flow has finished or stop() is called
+    void run();
+
+    /// One turn: posted work, due timers, then ready flows
+    /// @return Whether anything ran
+    bool run_once();
+
+    /// Make run() return (any thread)
+    void stop();
+
+    /// Spawned flows not yet finished
+    [[nodiscard]] size_t active() const noexcept { return flows_.size(); }
+
+private:
+    struct Timer {
+        Clock::time_point deadline;
+        uint64_t sequence;                  // FIFO among equal deadlines
+        std::function<void()> fn;
+        bool operator>(const Timer& other) const {
+            return deadline != other.deadline ? deadline > other.deadline
+                                              : sequence > other.sequence;
+        }
+    };
+
+    friend struct detail::Detached;
+    detail::Detached run_flow(Task<void> task);
+
+    static thread_local EventLoop* current_;
+
+    std::deque<std::coroutine_handle<>> ready_;
+    std::priority_queue<Timer, std::vector<Timer>, std::greater<Timer>> timers_;
+    uint64_t timer_sequence_ = 0;
+    std::unordered_set<void*> flows_;       // Root frames of live flows
+    std::exception_ptr error_;
+
+    bool stopped_ = false;                  // Guarded by posted_mutex_
+    std::mutex posted_mutex_;
+    std::condition_variable posted_cv_;
+    std::vector<std::function<void()>> posted_;
+    std::vector<std::function<void()>> draining_;
+};
+
+/// co_await yield(): let other ready flows run first
+struct Yield {
+    bool await_ready() const noexcept { return false; }
+    void await_suspend(std::coroutine_handle<> handle) const { EventLoop::current()->schedule(handle); }
+    void await_resume() const noexcept {}
+};
+inline Yield yield() { return {}; }
+
+/// co_await sleep_for(d): resume once `d` has passed
+struct Sleep {
+    EventLoop::Clock::time_point deadline;
+
+    bool await_ready() const noexcept { return deadline <= EventLoop::Clock::now(); }
+    void await_suspend(std::coroutine_handle<> handle) const {
+        EventLoop::current()->call_at(deadline, [handle]() { handle.resume(); });
+    }
+    void await_resume() const noexcept {}
+};
+inline Sleep sleep_for(EventLoop::Clock::duration delay) {
+    return {EventLoop::Clock::now() + delay};
+}
+
+/// Stream of values into one flow (loop thread only). push() wakes the
+/// flow parked in next(); close() ends the stream once it is drained.
+template<typename T>
+class Channel {
+public:
+    explicit Channel(EventLoop& loop) : loop_(loop) {}
+
+    Channel(const Channel&) = delete;
+    Channel& operator=(const Channel&) = delete;
+
+    void push(T value) {
+        queue_.push_back(std::move(value));
+        wake();
+    }
+    void close() {
+        closed_ = true;
+        wake();
+    }
+    [[nodiscard]] bool closed() const noexcept { return closed_; }
+    [[nodiscard]] size_t size() const noexcept { return queue_.size(); }
+
+    /// co_await next(): the next value, nullopt once closed and drained
+    auto next() {
+        struct Awaiter {
+            Channel& channel;
+            bool await_ready() const noexcept { return !channel.queue_.empty() || channel.closed_; }
+            void await_suspend(std::coroutine_handle<> handle) noexcept { channel.waiter_ = handle; }
+            std::optional<T> await_resume() {
+                if (channel.queue_.empty()) return std::nullopt;
+                std::optional<T> value(std::move(channel.queue_.front()));
+                channel.queue_.pop_front();
+                return value;
+            }
+        };
+        return Awaiter{*this};
+    }
+
+private:
+    void wake() {
+        if (waiter_) loop_.schedule(std::exchange(waiter_, {}));
+    }
+
+    EventLoop& loop_;
+    std::deque<T> queue_;
+    std::coroutine_handle<> waiter_;
+    bool closed_ = false;
+};
+
+/// Producers hold a weak_ptr and drop the channel once its reader lets go
+template<typename T>
+using Subscription = std::shared_ptr<Channel<T>>;
+
+//------------------------------------------------------------------------------
+// AsyncClient
+//------------------------------------------------------------------------------
+
+/// Awaitable trading over a connected Client: requests go out through the
+/// client's non-blocking calls and their replies resume the flow on the
+/// loop, so one thread can keep many orders in flight.
+///
+///     Task<void> quote(AsyncClient& lx, Order bid) {
+///         auto placed = co_await lx.place(bid);
+///         if (!placed) co_return;
+///         auto order = co_await lx.wait_for_fill(placed.value.order_id);
+///         ...
+///     }
+class AsyncClient {
+public:
+    /// Takes over the client's on_order and on_trade callbacks. Destroy
+    /// before the loop; the client must outlive both.
+    AsyncClient(Client& client, EventLoop& loop);
+    ~AsyncClient();
+
+    AsyncClient(const AsyncClient&) = delete;
+    AsyncClient& operator=(const AsyncClient&) = delete;
+
+    Task<Result<OrderResponse>> place(Order order);
+    Task<Error> cancel(uint64_t order_id);
+
+    /// Subscribe to trades on `symbol`; they arrive oldest first
+    Result<Subscription<Trade>> subscribe_trades(const std::string& symbol);
+
+    /// Resume once the order has filled at least `min_filled` (0: all of
+    /// it) or has closed, or after `timeout` (0: none)
+    /// @return The order as last reported, nullopt if none was reported
+    Task<std::optional<Order>> wait_for_fill(uint64_t order_id, double min_filled = 0.0,
+                                             std::chrono::nanoseconds timeout = {});
+
+    [[nodiscard]] Client& client() noexcept { return client_; }
+    [[nodiscard]] EventLoop& loop() noexcept { return loop_; }
+
+private:
+    struct Waiter {
+        uint64_t order_id;
+        double min_filled;
+        std::coroutine_handle<> handle;
+        bool woken = false;
+    };
+
+    // Resumes with a request's result, posted back from the IO thread
+    template<typename R>
+    struct Reply;
+
+    static bool settled(const Order& order, double min_filled) noexcept;
+    TradeCallback forward_trades();
+    void on_trade(const Trade& trade);
+    void on_order(const Order& order);
+    void wake(const std::shared_ptr<Waiter>& waiter);
+
+    Client& client_;
+    EventLoop& loop_;
+    // Checked by work posted from the IO thread before it touches `this`
+    std::shared_ptr<bool> alive_ = std::make_shared<bool>(true);
+    std::unordered_map<std::string, std::vector<std::weak_ptr<Channel<Trade>>>> subscribers_;
+    std::unordered_multimap<uint64_t, std::shared_ptr<Waiter>> waiters_;
+};
+
+} // namespace lx::async
+
+#endif // LX_ASYNC_HPP
@@ -7,6 +7,7 @@
 
 #include "types.hpp"
 #include "orderbook.hpp"
+#include "wire.hpp"
 #include <functional>
 #include <memory>
 #include <future>
@@ -37,9 +38,22 @@ struct ClientConfig {
     int max_reconnect_attempts = 5;
     bool auto_reconnect = true;
 
+    // Requested encoding; Binary is offered at connect and used for order
+    // entry and market data only if the server accepts it
+    WireEncoding encoding = WireEncoding::Json;
+
     // Performance settings
     size_t send_queue_size = 10000;
     size_t recv_queue_size = 10000;
+
+    // Frames are queued lock-free and written by the IO thread in batches.
+    // A non-zero window holds the first frame of a batch up to that long
+    // so more can join it, trading latency for fewer socket writes.
+    std::chrono::microseconds send_coalesce_window{0};
+
+    // Requests awaiting a reply at once; further requests fail until
+    // earlier ones complete or time out
+    size_t max_pending_requests = 1024;
 };
 
 /// Client metrics
@@ -80,6 +94,8 @@ using TradeCallback = std::function<void(const Trade&)>;
 using OrderBookCallback = std::function<void(const OrderBook&)>;
 using MessageCallback = std::function<void(const Message&)>;
 using ConnectionCallback = std::function<void(ConnectionState)>;
+using PlaceCallback = std::function<void(Result<OrderResponse>)>;
+using CancelCallback = std::function<void(Error)>;
 
 /// LX WebSocket Client
 /// Thread-safe, RAII-compliant client for trading operations
@@ -114,6 +130,9 @@ public:
     /// Get connection state
     [[nodiscard]] ConnectionState state() const noexcept;
 
+    /// Get the encoding negotiated for this connection
+    [[nodiscard]] WireEncoding encoding() const noexcept;
+
     /// Authenticate with API credentials
     /// @return Error if authentication fails
     Error authenticate();
@@ -135,6 +154,13 @@ public:
     /// @return Future with result
     std::future<Result<OrderResponse>> place_order_async(const Order& order);
 
+    /// Place an order without blocking any thread
+    /// @param order Order to place
+    /// @param done Called once with the result: on the IO thread when the
+    ///             reply arrives or the request times out, or before this
+    ///             returns if the request cannot be sent
+    void place_order(const Order& order, PlaceCallback done);
+
     /// Cancel an order
     /// @param order_id Order ID to cancel
     /// @return Error if cancellation fails
@@ -143,6 +169,10 @@ public:
     /// Cancel order asynchronously
     std::future<Error> cancel_order_async(uint64_t order_id);
 
+    /// Cancel an order without blocking any thread; `done` is called as
+    /// for place_order(order, done)
+    void cancel_order(uint64_t order_id, CancelCallback done);
+
     /// Modify an existing order
     /// @param order_id Order ID to modify
     /// @param new_price New price (0 to keep current)
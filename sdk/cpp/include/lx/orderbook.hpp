@@ -6,14 +6,25 @@
 #define LX_ORDERBOOK_HPP
 
 #include "types.hpp"
+#include "ring.hpp"
 #include <map>
 #include <unordered_map>
 #include <mutex>
 #include <functional>
 #include <atomic>
+#include <memory>
+#include <string_view>
 
 namespace lx {
 
+/// Single price level change; size 0 removes the level
+struct LevelUpdate {
+    Side side = Side::Buy;
+    double price = 0.0;
+    double size = 0.0;
+    int32_t count = 1;
+};
+
 /// Local orderbook for market data tracking
 /// Thread-safe implementation for real-time updates
 class LocalOrderBook {
@@ -36,6 +47,9 @@ public:
     /// Update single price level
     void update_level(Side side, double price, double size);
 
+    /// Apply a batch of level updates with a single update notification
+    void apply_updates(const std::vector<LevelUpdate>& updates);
+
     /// Remove price level
     void remove_level(Side side, double price);
 
@@ -82,9 +96,134 @@ private:
     mutable std::mutex mutex_;
     std::function<void(const OrderBook&)> update_callback_;
 
+    void set_level(Side side, double price, double size, int32_t count);
     void notify_update();
 };
 
+/// Changed levels from one batch applied to a TickOrderBook
+/// A level with size 0 was removed. Levels are best-first per side.
+struct BookDelta {
+    std::string symbol;
+    uint64_t sequence = 0;          // Increments once per applied batch
+    uint32_t checksum = 0;          // TickOrderBook::checksum() after the batch
+    int64_t timestamp = 0;
+    bool snapshot = false;          // Book was replaced; levels hold all of it
+    std::vector<PriceLevel> bids;
+    std::vector<PriceLevel> asks;
+};
+
+/// Integer-tick orderbook for high-rate feeds
+/// Prices are rounded to whole ticks of `tick_size` and each side is a
+/// flat array sorted with the best level last, so changes near the top
+/// of the book move few elements. Subscribers receive only the levels a
+/// batch changed plus a sequence and checksum; full snapshots are built
+/// only when asked for. Thread-safe; callbacks run under the book lock
+/// and must not call back into the book.
+class TickOrderBook {
+public:
+    /// Levels per side covered by checksum()
+    static constexpr size_t kChecksumDepth = 25;
+
+    TickOrderBook(std::string symbol, double tick_size);
+    ~TickOrderBook() = default;
+
+    // Non-copyable, non-movable (contains mutex)
+    TickOrderBook(const TickOrderBook&) = delete;
+    TickOrderBook& operator=(const TickOrderBook&) = delete;
+    TickOrderBook(TickOrderBook&&) = delete;
+    TickOrderBook& operator=(TickOrderBook&&) = delete;
+
+    /// Get symbol
+    [[nodiscard]] const std::string& symbol() const noexcept { return symbol_; }
+
+    /// Get tick size
+    [[nodiscard]] double tick_size() const noexcept { return tick_size_; }
+
+    /// Convert between prices and ticks
+    [[nodiscard]] int64_t to_ticks(double price) const noexcept;
+    [[nodiscard]] double to_price(int64_t ticks) const noexcept;
+
+    /// Replace the book; notifies one delta with snapshot set
+    void apply_snapshot(const OrderBook& snapshot);
+
+    /// Apply a batch of level updates; notifies one delta holding each
+    /// changed level once with its final size. Returns the new sequence.
+    uint64_t apply_updates(const std::vector<LevelUpdate>& updates, int64_t timestamp = 0);
+
+    /// Update single price level
+    void update_level(Side side, double price, double size);
+
+    /// Remove price level
+    void remove_level(Side side, double price);
+
+    /// Get current snapshot
+    [[nodiscard]] OrderBook get_snapshot(int32_t depth = 0) const;
+
+    /// Get best bid
+    [[nodiscard]] std::optional<PriceLevel> best_bid() const;
+
+    /// Get best ask
+    [[nodiscard]] std::optional<PriceLevel> best_ask() const;
+
+    /// Get mid price
+    [[nodiscard]] double mid_price() const;
+
+    /// Get spread
+    [[nodiscard]] double spread() const;
+
+    /// Get total bid depth
+    [[nodiscard]] double bid_depth() const;
+
+    /// Get total ask depth
+    [[nodiscard]] double ask_depth() const;
+
+    /// Get level counts
+    [[nodiscard]] size_t bid_levels() const;
+    [[nodiscard]] size_t ask_levels() const;
+
+    /// Clear all levels (sequence is kept)
+    void clear();
+
+    /// Get sequence of the last applied batch
+    [[nodiscard]] uint64_t sequence() const noexcept { return sequence_.load(); }
+
+    /// FNV-1a over the top kChecksumDepth levels of each side, bids then
+    /// asks, hashing each level's tick and its size in units of 1e-8
+    [[nodiscard]] uint32_t checksum() const;
+
+    /// Get last update timestamp
+    [[nodiscard]] int64_t last_update() const noexcept { return last_update_.load(); }
+
+    /// Set callback for book deltas
+    void on_delta(std::function<void(const BookDelta&)> callback);
+
+private:
+    struct Level {
+        int64_t ticks;
+        double size;
+        int32_t count;
+    };
+
+    // Sorted with the best price at the back
+    using Ladder = std::vector<Level>;
+
+    std::string symbol_;
+    double tick_size_;
+
+    Ladder bids_;   // Ascending ticks
+    Ladder asks_;   // Descending ticks
+
+    std::atomic<uint64_t> sequence_{0};
+    std::atomic<int64_t> last_update_{0};
+    mutable std::mutex mutex_;
+    std::function<void(const BookDelta&)> delta_callback_;
+
+    void set_level(Side side, int64_t ticks, double size, int32_t count);
+    [[nodiscard]] const Level* find_level(Side side, int64_t ticks) const;
+    [[nodiscard]] PriceLevel to_level(const Level& level) const;
+    [[nodiscard]] uint32_t checksum_locked() const;
+};
+
 /// Order tracker for managing local order state
 class OrderTracker {
 public:
@@ -154,6 +293,128 @@ private:
     std::function<void(const Trade&)> trade_callback_;
 };
 
+/// Fixed-size copy of a Trade for ring storage
+/// Symbols longer than kSymbolSize - 1 are truncated; buyer and seller
+/// IDs are not kept.
+struct TradeRecord {
+    static constexpr size_t kSymbolSize = 32;
+
+    uint64_t trade_id = 0;
+    char symbol[kSymbolSize] = {};
+    double price = 0.0;
+    double size = 0.0;
+    Side side = Side::Buy;
+    uint64_t buy_order_id = 0;
+    uint64_t sell_order_id = 0;
+    int64_t timestamp = 0;
+
+    [[nodiscard]] static TradeRecord from(const Trade& trade) noexcept;
+    [[nodiscard]] Trade to_trade() const;
+    [[nodiscard]] std::string_view symbol_view() const noexcept { return symbol; }
+};
+
+/// Fixed-size copy of an Order for ring storage
+/// Symbols and client IDs longer than kIdSize - 1 are truncated; the
+/// user ID is not kept.
+struct OrderRecord {
+    static constexpr size_t kIdSize = 32;
+
+    uint64_t order_id = 0;
+    char symbol[kIdSize] = {};
+    char client_id[kIdSize] = {};
+    OrderType type = OrderType::Limit;
+    Side side = Side::Buy;
+    double price = 0.0;
+    double size = 0.0;
+    double filled = 0.0;
+    double remaining = 0.0;
+    OrderStatus status = OrderStatus::Open;
+    TimeInForce time_in_force = TimeInForce::GTC;
+    int64_t timestamp = 0;
+    bool post_only = false;
+    bool reduce_only = false;
+
+    [[nodiscard]] static OrderRecord from(const Order& order) noexcept;
+    [[nodiscard]] Order to_order() const;
+    [[nodiscard]] std::string_view symbol_view() const noexcept { return symbol; }
+
+    [[nodiscard]] bool is_open() const noexcept {
+        return status == OrderStatus::Open || status == OrderStatus::Partial;
+    }
+};
+
+/// Constant-memory trade history
+/// Keeps the last `capacity` trades in a SeqRing: add() never allocates
+/// and must be called from a single thread (the message handler);
+/// readers on any thread iterate views without taking a lock.
+class TradeRing {
+public:
+    using View = SeqRing<TradeRecord>::View;
+
+    explicit TradeRing(size_t capacity = 65536);
+
+    /// Record a trade; writer thread only. Returns its sequence.
+    uint64_t add(const Trade& trade) noexcept;
+
+    /// The newest `limit` trades, oldest first
+    [[nodiscard]] View recent(size_t limit = SIZE_MAX) const noexcept { return ring_.view(limit); }
+
+    /// Trades recorded after sequence `after`
+    [[nodiscard]] View since(uint64_t after) const noexcept { return ring_.since(after); }
+
+    /// Copy out the newest `limit` trades for a symbol, most recent first
+    [[nodiscard]] std::vector<Trade> get_by_symbol(
+        std::string_view symbol,
+        size_t limit = 100
+    ) const;
+
+    /// Sequence of the newest trade (0 if none)
+    [[nodiscard]] uint64_t sequence() const noexcept { return ring_.head(); }
+
+    /// Trades currently held
+    [[nodiscard]] size_t count() const noexcept { return ring_.size(); }
+
+    [[nodiscard]] size_t capacity() const noexcept { return ring_.capacity(); }
+
+private:
+    SeqRing<TradeRecord> ring_;
+};
+
+/// Constant-memory log of order updates
+/// Every upsert() appends the order's new state to a SeqRing, so the
+/// newest record for an ID is its current state. Lookups scan back from
+/// the newest record and only see orders updated within the last
+/// `capacity` events. Single writer, lock-free readers, as TradeRing.
+class OrderRing {
+public:
+    using View = SeqRing<OrderRecord>::View;
+
+    explicit OrderRing(size_t capacity = 16384);
+
+    /// Record an order's state; writer thread only. Returns its sequence.
+    uint64_t upsert(const Order& order) noexcept;
+
+    /// Latest recorded state of an order
+    [[nodiscard]] std::optional<OrderRecord> get(uint64_t order_id) const noexcept;
+
+    /// Order updates, oldest first
+    [[nodiscard]] View history(size_t limit = SIZE_MAX) const noexcept { return ring_.view(limit); }
+
+    /// Order updates recorded after sequence `after`
+    [[nodiscard]] View since(uint64_t after) const noexcept { return ring_.since(after); }
+
+    /// Latest state of each order still open, optionally for one symbol
+    [[nodiscard]] std::vector<Order> get_open(std::string_view symbol = {}) const;
+
+    /// Sequence of the newest update (0 if none)
+    [[nodiscard]] uint64_t sequence() const noexcept { return ring_.head(); }
+
+    [[nodiscard]] size_t capacity() const noexcept { return ring_.capacity(); }
+
+private:
+    SeqRing<OrderRecord> ring_;
+};
+
 /// Multi-symbol orderbook manager
 class OrderBookManager {
 public:
@@ -0,0 +1,255 @@
+// LX C++ SDK - Outbound Queue and Pending Request Table
+// Copyright (c) 2025 Lux Partners Limited
+// SPDX-License-Identifier: MIT
+
+#ifndef LX_PIPELINE_HPP
+#define LX_PIPELINE_HPP
+
+#include <atomic>
+#include <chrono>
+#include <charconv>
+#include <condition_variable>
+#include <cstddef>
+#include <cstdint>
+#include <functional>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <utility>
+
+namespace lx {
+
+/// Bounded queue with any number of producers and one consumer. Each cell
+/// carries a sequence number, so producers claim a cell with one CAS on
+/// the tail and never take a lock; the consumer pops without any
+/// read-modify-write at all. Used for outbound frames: caller threads
+/// push, the IO thread drains.
+template<typename T>
+class MpscQueue {
+public:
+    /// Capacity is rounded up to a power of two
+    explicit MpscQueue(size_t capacity)
+        : capacity_(round_up(capacity))
+        , mask_(capacity_ - 1)
+        , cells_(new Cell[capacity_])
+    {
+        for (size_t i = 0; i < capacity_; ++i) {
+            cells_[i].seq.store(i, std::memory_order_relaxed);
+        }
+    }
+
+    MpscQueue(const MpscQueue&) = delete;
+    MpscQueue& operator=(const MpscQueue&) = delete;
+
+    /// Append a value; false if the queue is full. Any thread.
+    bool push(T&& value) {
+        size_t pos = tail_.load(std::memory_order_relaxed);
+        Cell* cell;
+        for (;;) {
+            cell = &cells_[pos & mask_];
+            const size_t seq = cell->seq.load(std::memory_order_acquire);
+            const auto diff = static_cast<std::ptrdiff_t>(seq) - static_cast<std::ptrdiff_t>(pos);
+            if (diff == 0) {
+                if (tail_.compare_exchange_weak(pos, pos + 1, std::memory_order_relaxed)) {
+                    break;
+                }
+            } else if (diff < 0) {
+                return false;
+            } else {
+                pos = tail_.load(std::memory_order_relaxed);
+            }
+        }
+        cell->value = std::move(value);
+        cell->seq.store(pos + 1, std::memory_order_release);
+        return true;
+    }
+
+    /// Take the oldest value; false if empty. Consumer thread only.
+    bool pop(T& out) {
+        const size_t pos = head_.load(std::memory_order_relaxed);
+        Cell& cell = cells_[pos & mask_];
+        if (cell.seq.load(std::memory_order_acquire) != pos + 1) {
+            return false;
+        }
+        out = std::move(cell.value);
+        cell.seq.store(pos + capacity_, std::memory_order_release);
+        head_.store(pos + 1, std::memory_order_relaxed);
+        return true;
+    }
+
+    [[nodiscard]] size_t capacity() const noexcept { return capacity_; }
+
+private:
+    struct Cell {
+        std::atomic<size_t> seq;
+        T value;
+    };
+
+    static size_t round_up(size_t n) noexcept {
+        size_t c = 2;
+        while (c < n) c <<= 1;
+        return c;
+    }
+
+    const size_t capacity_;
+    const size_t mask_;
+    std::unique_ptr<Cell[]> cells_;
+    alignas(64) std::atomic<size_t> tail_{0};
+    alignas(64) std::atomic<size_t> head_{0};
+};
+
+/// Replies awaited by request ID, held in a fixed table of slots indexed by
+/// the ID's low bits rather than in a map. Each slot has its own lock, so
+/// the IO thread completing one request never contends with callers
+/// opening or waiting on others, and nothing is allocated per request.
+/// IDs must be non-zero and increasing; a request whose slot is still held
+/// by one `slots` IDs older is refused. A request is either waited on or
+/// opened with a completion that runs on the thread delivering the reply.
+template<typename T>
+class PendingTable {
+public:
+    /// Called once with the reply, or nullptr when the request expires
+    using Completion = std::function<void(const T*)>;
+
+    /// Slot count is rounded up to a power of two
+    explicit PendingTable(size_t slots)
+        : mask_(round_up(slots) - 1)
+        , slots_(new Slot[mask_ + 1])
+    {}
+
+    PendingTable(const PendingTable&) = delete;
+    PendingTable& operator=(const PendingTable&) = delete;
+
+    /// Claim the slot for `id` before sending; false if it is taken
+    bool open(uint64_t id) {
+        Slot& slot = slots_[id & mask_];
+        std::lock_guard<std::mutex> lock(slot.mutex);
+        if (slot.id != 0) {
+            return false;
+        }
+        slot.id = id;
+        slot.done = false;
+        return true;
+    }
+
+    /// Claim the slot for `id` with a completion instead of a waiter;
+    /// false if it is taken
+    bool open(uint64_t id, Completion done) {
+        Slot& slot = slots_[id & mask_];
+        std::lock_guard<std::mutex> lock(slot.mutex);
+        if (slot.id != 0) {
+            return false;
+        }
+        slot.id = id;
+        slot.done = false;
+        slot.completion = std::move(done);
+        return true;
+    }
+
+    /// Deliver the reply to `id`; false if nobody is waiting for it
+    bool complete(uint64_t id, const T& value) {
+        Slot& slot = slots_[id & mask_];
+        Completion completion;
+        {
+            std::lock_guard<std::mutex> lock(slot.mutex);
+            if (slot.id != id || slot.done) {
+                return false;
+            }
+            if (slot.completion) {
+                // Released before the call, which may open another request
+                completion = std::exchange(slot.completion, nullptr);
+                slot.id = 0;
+            } else {
+                slot.value = value;
+                slot.done = true;
+            }
+        }
+        if (completion) {
+            completion(&value);
+        } else {
+            slot.cv.notify_one();
+        }
+        return true;
+    }
+
+    /// Fail a request opened with a completion that got no reply in time;
+    /// false if it already completed
+    bool expire(uint64_t id) {
+        Slot& slot = slots_[id & mask_];
+        Completion completion;
+        {
+            std::lock_guard<std::mutex> lock(slot.mutex);
+            if (slot.id != id || !slot.completion) {
+                return false;
+            }
+            completion = std::exchange(slot.completion, nullptr);
+            slot.id = 0;
+        }
+        completion(nullptr);
+        return true;
+    }
+
+    /// Wait for the reply to `id` and release its slot; false on timeout
+    template<typename Rep, typename Period>
+    bool wait(uint64_t id, std::chrono::duration<Rep, Period> timeout, T& out) {
+        Slot& slot = slots_[id & mask_];
+        std::unique_lock<std::mutex> lock(slot.mutex);
+        if (slot.id != id) {
+            return false;
+        }
+        const bool done = slot.cv.wait_for(lock, timeout, [&slot]() { return slot.done; });
+        if (done) {
+            out = std::move(slot.value);
+        }
+        slot.id = 0;
+        return done;
+    }
+
+    /// Release the slot for a request that was never sent
+    void cancel(uint64_t id) {
+        Slot& slot = slots_[id & mask_];
+        std::lock_guard<std::mutex> lock(slot.mutex);
+        if (slot.id == id) {
+            slot.id = 0;
+            slot.completion = nullptr;
+        }
+    }
+
+private:
+    struct Slot {
+        std::mutex mutex;
+        std::condition_variable cv;
+        uint64_t id = 0;        // 0 when free
+        bool done = false;
+        T value{};
+        Completion completion;  // Set instead of a waiter
+    };
+
+    static size_t round_up(size_t n) noexcept {
+        size_t c = 1;
+        while (c < n) c <<= 1;
+        return c;
+    }
+
+    const uint64_t mask_;
+    std::unique_ptr<Slot[]> slots_;
+};
+
+/// Numeric request ID from its JSON form, skipping any non-digit prefix
+/// ("42", "req-42"); false if there are no trailing digits
+inline bool parse_request_id(const std::string& text, uint64_t& id) noexcept {
+    size_t start = text.size();
+    while (start > 0 && text[start - 1] >= '0' && text[start - 1] <= '9') {
+        --start;
+    }
+    if (start == text.size()) {
+        return false;
+    }
+    const char* end = text.data() + text.size();
+    auto result = std::from_chars(text.data() + start, end, id);
+    return result.ec == std::errc() && result.ptr == end;
+}
+
+} // namespace lx
+
+#endif // LX_PIPELINE_HPP
@@ -0,0 +1,204 @@
+// LX C++ SDK - Single-Writer Ring Buffer
+// Copyright (c) 2025 Lux Partners Limited
+// SPDX-License-Identifier: MIT
+
+#ifndef LX_RING_HPP
+#define LX_RING_HPP
+
+#include <algorithm>
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+#include <iterator>
+#include <memory>
+#include <type_traits>
+
+namespace lx {
+
+/// Fixed-capacity ring with one writer and any number of lock-free readers
+/// Every push gets a sequence number starting at 1; a slot holds the last
+/// `capacity` of them. Each slot is a seqlock stored as atomic words, so
+/// a reader either copies out a whole element or sees that the writer
+/// has since overwritten it, and never blocks the writer. push() must
+/// only be called from one thread at a time.
+template<typename T>
+class SeqRing {
+    static_assert(std::is_trivially_copyable<T>::value,
+                  "SeqRing elements are copied word by word");
+
+public:
+    /// Capacity is rounded up to a power of two
+    explicit SeqRing(size_t capacity)
+        : capacity_(round_up(capacity))
+        , mask_(capacity_ - 1)
+        , slots_(new Slot[capacity_])
+    {}
+
+    SeqRing(const SeqRing&) = delete;
+    SeqRing& operator=(const SeqRing&) = delete;
+
+    /// Append an element; writer thread only. Returns its sequence.
+    uint64_t push(const T& value) noexcept {
+        const uint64_t seq = head_.load(std::memory_order_relaxed) + 1;
+        Slot& slot = slots_[seq & mask_];
+
+        uint64_t words[kWords] = {};
+        std::memcpy(words, &value, sizeof(T));
+
+        slot.seq.store(kWriting, std::memory_order_relaxed);
+        std::atomic_thread_fence(std::memory_order_release);
+        for (size_t i = 0; i < kWords; ++i) {
+            slot.words[i].store(words[i], std::memory_order_relaxed);
+        }
+        slot.seq.store(seq, std::memory_order_release);
+
+        head_.store(seq, std::memory_order_release);
+        return seq;
+    }
+
+    /// Copy out element `seq`; false if it was never written or has
+    /// been overwritten
+    bool read(uint64_t seq, T& out) const noexcept {
+        if (seq == 0) return false;
+        const Slot& slot = slots_[seq & mask_];
+
+        if (slot.seq.load(std::memory_order_acquire) != seq) return false;
+        uint64_t words[kWords];
+        for (size_t i = 0; i < kWords; ++i) {
+            words[i] = slot.words[i].load(std::memory_order_relaxed);
+        }
+        std::atomic_thread_fence(std::memory_order_acquire);
+        if (slot.seq.load(std::memory_order_relaxed) != seq) return false;
+
+        std::memcpy(&out, words, sizeof(T));
+        return true;
+    }
+
+    /// Sequence of the newest element (0 if empty)
+    [[nodiscard]] uint64_t head() const noexcept {
+        return head_.load(std::memory_order_acquire);
+    }
+
+    /// Sequence of the oldest element still held (head() + 1 if empty)
+    [[nodiscard]] uint64_t tail() const noexcept {
+        const uint64_t h = head();
+        return h >= capacity_ ? h - capacity_ + 1 : 1;
+    }
+
+    [[nodiscard]] size_t size() const noexcept {
+        return static_cast<size_t>(head() - tail() + 1);
+    }
+
+    [[nodiscard]] size_t capacity() const noexcept { return capacity_; }
+
+    /// Forward iteration over a range of sequences, oldest first. Elements
+    /// the writer overwrites during iteration are skipped.
+    class View {
+    public:
+        class iterator {
+        public:
+            using iterator_category = std::input_iterator_tag;
+            using value_type = T;
+            using difference_type = std::ptrdiff_t;
+            using pointer = const T*;
+            using reference = const T&;
+
+            iterator() = default;
+
+            reference operator*() const noexcept { return value_; }
+            pointer operator->() const noexcept { return &value_; }
+
+            /// Sequence of the current element
+            [[nodiscard]] uint64_t sequence() const noexcept { return seq_; }
+
+            iterator& operator++() noexcept {
+                ++seq_;
+                settle();
+                return *this;
+            }
+
+            bool operator==(const iterator& other) const noexcept { return seq_ == other.seq_; }
+            bool operator!=(const iterator& other) const noexcept { return seq_ != other.seq_; }
+
+        private:
+            friend class View;
+
+            iterator(const SeqRing* ring, uint64_t seq, uint64_t end) noexcept
+                : ring_(ring), seq_(seq), end_(end) {
+                settle();
+            }
+
+            // Advance to the next readable element, or to end
+            void settle() noexcept {
+                while (seq_ < end_ && !ring_->read(seq_, value_)) {
+                    // Lapped by the writer: skip to what is still held
+                    const uint64_t tail = ring_->tail();
+                    seq_ = seq_ < tail ? tail : seq_ + 1;
+                }
+                if (seq_ > end_) seq_ = end_;
+            }
+
+            const SeqRing* ring_ = nullptr;
+            uint64_t seq_ = 0;
+            uint64_t end_ = 0;
+            T value_{};
+        };
+
+        [[nodiscard]] iterator begin() const noexcept { return iterator(ring_, first_, end_); }
+        [[nodiscard]] iterator end() const noexcept { return iterator(ring_, end_, end_); }
+
+        /// Sequences covered: [first, last]
+        [[nodiscard]] uint64_t first() const noexcept { return first_; }
+        [[nodiscard]] uint64_t last() const noexcept { return end_ - 1; }
+
+    private:
+        friend class SeqRing;
+
+        View(const SeqRing* ring, uint64_t first, uint64_t end) noexcept
+            : ring_(ring), first_(first), end_(end) {}
+
+        const SeqRing* ring_;
+        uint64_t first_;
+        uint64_t end_;      // One past the last sequence
+    };
+
+    /// The newest `limit` elements as of now, oldest first
+    [[nodiscard]] View view(size_t limit = SIZE_MAX) const noexcept {
+        const uint64_t h = head();
+        uint64_t first = tail();
+        if (h + 1 - first > limit) first = h + 1 - limit;
+        return View(this, first, h + 1);
+    }
+
+    /// Elements after sequence `after`, as of now; for readers that poll
+    [[nodiscard]] View since(uint64_t after) const noexcept {
+        const uint64_t h = head();
+        const uint64_t first = std::max(after + 1, tail());
+        return View(this, std::min(first, h + 1), h + 1);
+    }
+
+private:
+    static constexpr size_t kWords = (sizeof(T) + sizeof(uint64_t) - 1) / sizeof(uint64_t);
+    static constexpr uint64_t kWriting = UINT64_MAX;
+
+    struct alignas(64) Slot {
+        std::atomic<uint64_t> seq{0};
+        std::atomic<uint64_t> words[kWords];
+    };
+
+    static size_t round_up(size_t n) noexcept {
+        size_t c = 1;
+        while (c < n) c <<= 1;
+        return c;
+    }
+
+    const size_t capacity_;
+    const uint64_t mask_;
+    std::unique_ptr<Slot[]> slots_;
+    alignas(64) std::atomic<uint64_t> head_{0};
+};
+
+} // namespace lx
+
+#endif // LX_RING_HPP
@@ -0,0 +1,293 @@
+// LX C++ SDK - Binary Wire Protocol
+// Copyright (c) 2025 Lux Partners Limited
+// SPDX-License-Identifier: MIT
+
+#ifndef LX_WIRE_HPP
+#define LX_WIRE_HPP
+
+#include "types.hpp"
+#include <cmath>
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+#include <vector>
+
+namespace lx {
+
+/// Encoding for order entry and market data frames
+enum class WireEncoding {
+    Json,       // Text frames (default)
+    Binary      // Compact binary frames, if the server agrees at connect
+};
+
+namespace wire {
+
+/// Binary frames are [FrameHeader][payload]. Request types reuse the
+/// engine's ActionType values and payload layouts (lux::packed in
+/// book.hpp), so a gateway can strip the request ID and hand
+/// [type][payload] to LXBook::execute_packed unchanged. Sizes and
+/// prices are fixed point with 8 decimals; integers are little-endian.
+enum class MessageType : uint8_t {
+    Place = 0,              // PackedPlaceOrder
+    Cancel = 1,             // PackedCancelOrder
+    Modify = 3,             // PackedModifyOrder
+    PlaceResult = 0x80,     // PackedPlaceResult, answers any request
+    BookLevels = 0x90,      // PackedBookHeader + count * PackedQuoteLevel
+    Trade = 0x91            // PackedTrade
+};
+
+/// Fixed-point scale for sizes and prices
+constexpr int64_t kScale = 100000000;
+
+#pragma pack(push, 1)
+
+struct FrameHeader {
+    uint8_t type;
+    uint32_t request_id;    // 0 for unsolicited market data
+};
+
+struct PackedPlaceOrder {
+    uint32_t market_id;
+    uint8_t flags;
+    int64_t size;
+    int64_t limit_price;
+    int64_t trigger_price;
+};
+
+struct PackedCancelOrder {
+    uint32_t market_id;
+    uint64_t oid;
+};
+
+struct PackedModifyOrder {
+    uint32_t market_id;
+    uint64_t oid;
+    int64_t new_size;
+    int64_t new_price;
+};
+
+struct PackedPlaceResult {
+    uint64_t oid;
+    uint8_t status;
+    int64_t filled_size;
+    int64_t avg_price;
+};
+
+struct PackedBookHeader {
+    uint32_t market_id;
+    uint64_t sequence;
+    uint16_t count;
+};
+
+struct PackedQuoteLevel {
+    uint8_t is_buy;
+    int64_t price;
+    int64_t size;           // 0 removes the level
+};
+
+struct PackedTrade {
+    uint32_t market_id;
+    uint64_t trade_id;
+    int64_t price;
+    int64_t size;
+    uint8_t is_buy;
+    int64_t timestamp;
+};
+
+#pragma pack(pop)
+
+// Flag bits of PackedPlaceOrder::flags (lux::packed::FLAG_*)
+constexpr uint8_t FLAG_IS_BUY = 0x01;
+constexpr uint8_t FLAG_KIND_MASK = 0x0E;  // bits 1-3
+constexpr uint8_t FLAG_KIND_SHIFT = 1;
+constexpr uint8_t FLAG_TIF_MASK = 0x30;   // bits 4-5
+constexpr uint8_t FLAG_TIF_SHIFT = 4;
+constexpr uint8_t FLAG_REDUCE_ONLY = 0x40;
+
+// Engine order kinds and time-in-force values used in the flags
+constexpr uint8_t KIND_LIMIT = 0;
+constexpr uint8_t KIND_MARKET = 1;
+constexpr uint8_t TIF_GTC = 0;
+constexpr uint8_t TIF_IOC = 1;
+constexpr uint8_t TIF_ALO = 2;
+
+// PackedPlaceResult::status values (lux::BookOrderStatus)
+constexpr uint8_t STATUS_NEW = 0;
+constexpr uint8_t STATUS_OPEN = 1;
+constexpr uint8_t STATUS_FILLED = 2;
+constexpr uint8_t STATUS_CANCELLED = 3;
+constexpr uint8_t STATUS_REJECTED = 4;
+constexpr uint8_t STATUS_EXPIRED = 5;
+constexpr uint8_t STATUS_TRIGGERED = 6;
+
+/// Convert to and from fixed point
+inline int64_t to_fixed(double value) noexcept {
+    return std::llround(value * static_cast<double>(kScale));
+}
+
+inline double from_fixed(int64_t value) noexcept {
+    return static_cast<double>(value) / static_cast<double>(kScale);
+}
+
+/// Status name as used by the JSON protocol
+inline const char* status_name(uint8_t status) noexcept {
+    switch (status) {
+        case STATUS_NEW: return "new";
+        case STATUS_OPEN: return "open";
+        case STATUS_FILLED: return "filled";
+        case STATUS_CANCELLED: return "cancelled";
+        case STATUS_REJECTED: return "rejected";
+        case STATUS_EXPIRED: return "expired";
+        case STATUS_TRIGGERED: return "triggered";
+        default: return "unknown";
+    }
+}
+
+/// Flags for an order, or false if it has no binary form (stop, iceberg
+/// and peg orders, FOK and DAY time in force); send those as JSON. The
+/// packed layout has no client ID, so callers also send orders that
+/// carry one as JSON.
+inline bool order_flags(const Order& order, uint8_t& flags) noexcept {
+    uint8_t kind;
+    switch (order.type) {
+        case OrderType::Limit: kind = KIND_LIMIT; break;
+        case OrderType::Market: kind = KIND_MARKET; break;
+        default: return false;
+    }
+
+    uint8_t tif;
+    if (order.post_only) {
+        tif = TIF_ALO;
+    } else if (order.time_in_force == TimeInForce::GTC) {
+        tif = TIF_GTC;
+    } else if (order.time_in_force == TimeInForce::IOC) {
+        tif = TIF_IOC;
+    } else {
+        return false;
+    }
+
+    flags = static_cast<uint8_t>(
+        (order.side == Side::Buy ? FLAG_IS_BUY : 0) |
+        ((kind << FLAG_KIND_SHIFT) & FLAG_KIND_MASK) |
+        ((tif << FLAG_TIF_SHIFT) & FLAG_TIF_MASK) |
+        (order.reduce_only ? FLAG_REDUCE_ONLY : 0));
+    return true;
+}
+
+//------------------------------------------------------------------------------
+// Encoding
+//------------------------------------------------------------------------------
+
+/// Builds one frame at a time into a buffer that is kept between frames,
+/// so steady-state encoding does not allocate
+class Encoder {
+public:
+    [[nodiscard]] const uint8_t* data() const noexcept { return buffer_.data(); }
+    [[nodiscard]] size_t size() const noexcept { return buffer_.size(); }
+
+    /// Encode a place request; false (and nothing encoded) if the order
+    /// has no binary form
+    bool place(uint32_t request_id, uint32_t market_id, const Order& order) {
+        PackedPlaceOrder packed{};
+        if (!order_flags(order, packed.flags)) {
+            return false;
+        }
+        packed.market_id = market_id;
+        packed.size = to_fixed(order.size);
+        packed.limit_price = order.type == OrderType::Market ? 0 : to_fixed(order.price);
+        packed.trigger_price = 0;
+        frame(MessageType::Place, request_id, packed);
+        return true;
+    }
+
+    void cancel(uint32_t request_id, uint32_t market_id, uint64_t order_id) {
+        frame(MessageType::Cancel, request_id, PackedCancelOrder{market_id, order_id});
+    }
+
+    /// Zero keeps the current price or size, as in the JSON request
+    void modify(uint32_t request_id, uint32_t market_id, uint64_t order_id,
+                double new_price, double new_size) {
+        PackedModifyOrder packed{};
+        packed.market_id = market_id;
+        packed.oid = order_id;
+        packed.new_size = new_size > 0 ? to_fixed(new_size) : 0;
+        packed.new_price = new_price > 0 ? to_fixed(new_price) : 0;
+        frame(MessageType::Modify, request_id, packed);
+    }
+
+private:
+    template<typename T>
+    void frame(MessageType type, uint32_t request_id, const T& payload) {
+        const FrameHeader header{static_cast<uint8_t>(type), request_id};
+        buffer_.resize(sizeof(header) + sizeof(payload));
+        std::memcpy(buffer_.data(), &header, sizeof(header));
+        std::memcpy(buffer_.data() + sizeof(header), &payload, sizeof(payload));
+    }
+
+    std::vector<uint8_t> buffer_;
+};
+
+//------------------------------------------------------------------------------
+// Decoding
+//------------------------------------------------------------------------------
+
+/// Copy a packed struct out of a frame; false if the frame is too short
+template<typename T>
+bool load(const uint8_t* data, size_t size, size_t offset, T& out) noexcept {
+    if (size < offset || size - offset < sizeof(T)) {
+        return false;
+    }
+    std::memcpy(&out, data + offset, sizeof(T));
+    return true;
+}
+
+/// Read the frame header; payload starts at sizeof(FrameHeader)
+inline bool decode_header(const uint8_t* data, size_t size, FrameHeader& header) noexcept {
+    return load(data, size, 0, header);
+}
+
+inline bool decode_place_result(const uint8_t* data, size_t size, PackedPlaceResult& result) noexcept {
+    return load(data, size, sizeof(FrameHeader), result);
+}
+
+inline bool decode_trade(const uint8_t* data, size_t size, PackedTrade& trade) noexcept {
+    return load(data, size, sizeof(FrameHeader), trade);
+}
+
+/// Book levels read in place from the received frame
+class BookLevelsView {
+public:
+    [[nodiscard]] uint32_t market_id() const noexcept { return header_.market_id; }
+    [[nodiscard]] uint64_t sequence() const noexcept { return header_.sequence; }
+    [[nodiscard]] size_t count() const noexcept { return header_.count; }
+
+    [[nodiscard]] PackedQuoteLevel level(size_t i) const noexcept {
+        PackedQuoteLevel level;
+        std::memcpy(&level, levels_ + i * sizeof(PackedQuoteLevel), sizeof(level));
+        return level;
+    }
+
+private:
+    friend bool decode_book(const uint8_t*, size_t, BookLevelsView&) noexcept;
+
+    PackedBookHeader header_{};
+    const uint8_t* levels_ = nullptr;
+};
+
+/// The view borrows `data`, which must outlive it
+inline bool decode_book(const uint8_t* data, size_t size, BookLevelsView& view) noexcept {
+    if (!load(data, size, sizeof(FrameHeader), view.header_)) {
+        return false;
+    }
+    const size_t offset = sizeof(FrameHeader) + sizeof(PackedBookHeader);
+    if ((size - offset) / sizeof(PackedQuoteLevel) < view.header_.count) {
+        return false;
+    }
+    view.levels_ = data + offset;
+    return true;
+}
+
+} // namespace wire
+} // namespace lx
+
+#endif // LX_WIRE_HPP
@@ -0,0 +1,284 @@
+// LX C++ SDK - Coroutines
+// Copyright (c) 2025 Lux Partners Limited
+// SPDX-License-Identifier: MIT
+
+#include "lx/async.hpp"
+
+namespace lx::async {
+
+//------------------------------------------------------------------------------
+// EventLoop
+//------------------------------------------------------------------------------
+
+thread_local EventLoop* EventLoop::current_ = nullptr;
+
+void detail::Detached::promise_type::FinalAwaiter::await_suspend(
+    std::coroutine_handle<promise_type> done) noexcept {
+    done.promise().loop->flows_.erase(done.address());
+    done.destroy();
+}
+
+EventLoop::~EventLoop() {
+    for (void* frame : flows_) {
+        std::coroutine_handle<>::from_address(frame).destroy();
+    }
+}
+
+detail::Detached EventLoop::run_flow(Task<void> task) {
+    try {
+        co_await task;
+    } catch (...) {
+        if (!error_) {
+            error_ = std::current_exception();
+        }
+        stop();
+    }
+}
+
+void EventLoop::spawn(Task<void> task) {
+    detail::Detached flow = run_flow(std::move(task));
+    flow.handle.promise().loop = this;
+    flows_.insert(flow.handle.address());
+    schedule(flow.handle);
+}
+
+void EventLoop::call_at(Clock::time_point deadline, std::function<void()> fn) {
+    timers_.push(Timer{deadline, timer_sequence_++, std::move(fn)});
+}
+
+void EventLoop::post(std::function<void()> fn) {
+    {
+        std::lock_guard<std::mutex> lock(posted_mutex_);
+        posted_.push_back(std::move(fn));
+    }
+    posted_cv_.notify_one();
+}
+
+bool EventLoop::run_once() {
+    EventLoop* const outer = current_;
+    current_ = this;
+    bool worked = false;
+
+    {
+        std::lock_guard<std::mutex> lock(posted_mutex_);
+        draining_.swap(posted_);
+    }
+    for (auto& fn : draining_) {
+        fn();
+    }
+    worked |= !draining_.empty();
+    draining_.clear();
+
+    const Clock::time_point now = Clock::now();
+    while (!timers_.empty() && timers_.top().deadline <= now) {
+        std::function<void()> fn = std::move(const_cast<Timer&>(timers_.top()).fn);
+        timers_.pop();
+        fn();
+        worked = true;
+    }
+
+    // Only what was ready on entry, so a flow that keeps yielding cannot
+    // starve replies or timers
+    for (size_t count = ready_.size(); count > 0 && !ready_.empty(); --count) {
+        std::coroutine_handle<> handle = ready_.front();
+        ready_.pop_front();
+        handle.resume();
+        worked = true;
+    }
+
+    current_ = outer;
+    return worked;
+}
+
+void EventLoop::run() {
+    {
+        std::lock_guard<std::mutex> lock(posted_mutex_);
+        stopped_ = false;
+    }
+    while (!flows_.empty()) {
+        if (run_once() || !ready_.empty()) {
+            std::lock_guard<std::mutex> lock(posted_mutex_);
+            if (stopped_) break;
+            continue;
+        }
+
+        // Idle: sleep until posted work, stop() or the next timer
+        std::unique_lock<std::mutex> lock(posted_mutex_);
+        auto woken = [this]() { return !posted_.empty() || stopped_; };
+        if (timers_.empty()) {
+            posted_cv_.wait(lock, woken);
+        } else {
+            posted_cv_.wait_until(lock, timers_.top().deadline, woken);
+        }
+        if (stopped_) break;
+    }
+
+    if (error_) {
+        std::rethrow_exception(std::exchange(error_, nullptr));
+    }
+}
+
+void EventLoop::stop() {
+    {
+        std::lock_guard<std::mutex> lock(posted_mutex_);
+        stopped_ = true;
+    }
+    posted_cv_.notify_all();
+}
+
+//------------------------------------------------------------------------------
+// AsyncClient
+//------------------------------------------------------------------------------
+
+template<typename R>
+struct AsyncClient::Reply {
+    EventLoop& loop;
+    std::function<void(std::function<void(R)>)> start;
+    std::shared_ptr<std::optional<R>> result = std::make_shared<std::optional<R>>();
+
+    bool await_ready() const noexcept { return false; }
+    void await_suspend(std::coroutine_handle<> handle) {
+        start([loop = &loop, result = result, handle](R value) {
+            loop->post([result, handle, value = std::move(value)]() mutable {
+                *result = std::move(value);
+                handle.resume();
+            });
+        });
+    }
+    R await_resume() { return std::move(**result); }
+};
+
+AsyncClient::AsyncClient(Client& client, EventLoop& loop) : client_(client), loop_(loop) {
+    client_.on_trade(forward_trades());
+    client_.on_order([this, alive = std::weak_ptr<bool>(alive_)](const Order& order) {
+        loop_.post([this, alive, order]() {
+            if (alive.lock()) {
+                on_order(order);
+            }
+        });
+    });
+}
+
+AsyncClient::~AsyncClient() {
+    client_.on_trade(nullptr);
+    client_.on_order(nullptr);
+}
+
+Task<Result<OrderResponse>> AsyncClient::place(Order order) {
+    co_return co_await Reply<Result<OrderResponse>>{loop_, [this, &order](PlaceCallback done) {
+        client_.place_order(order, std::move(done));
+    }};
+}
+
+Task<Error> AsyncClient::cancel(uint64_t order_id) {
+    co_return co_await Reply<Error>{loop_, [this, order_id](CancelCallback done) {
+        client_.cancel_order(order_id, std::move(done));
+    }};
+}
+
+Result<Subscription<Trade>> AsyncClient::subscribe_trades(const std::string& symbol) {
+    if (Error err = client_.subscribe_trades({symbol}, forward_trades())) {
+        return {nullptr, err};
+    }
+    auto channel = std::make_shared<Channel<Trade>>(loop_);
+    subscribers_[symbol].push_back(channel);
+    return {channel, {}};
+}
+
+Task<std::optional<Order>> AsyncClient::wait_for_fill(uint64_t order_id, double min_filled,
+                                                      std::chrono::nanoseconds timeout) {
+    // An update the tracker already holds has its on_order still queued
+    // behind this flow, so checking here and parking below loses nothing
+    std::optional<Order> order = client_.orders().get(order_id);
+    if (order && settled(*order, min_filled)) {
+        co_return order;
+    }
+
+    auto waiter = std::make_shared<Waiter>();
+    waiter->order_id = order_id;
+    waiter->min_filled = min_filled;
+
+    struct Park {
+        AsyncClient& self;
+        std::shared_ptr<Waiter> waiter;
+        std::chrono::nanoseconds timeout;
+
+        bool await_ready() const noexcept { return false; }
+        void await_suspend(std::coroutine_handle<> handle) const {
+            waiter->handle = handle;
+            self.waiters_.emplace(waiter->order_id, waiter);
+            if (timeout.count() > 0) {
+                self.loop_.call_later(timeout, [self = &self, alive = std::weak_ptr<bool>(self.alive_),
+                                                expired = std::weak_ptr<Waiter>(waiter)]() {
+                    auto live = expired.lock();
+                    if (alive.lock() && live) {
+                        self->wake(live);
+                    }
+                });
+            }
+        }
+        void await_resume() const noexcept {}
+    };
+    co_await Park{*this, waiter, timeout};
+    co_return client_.orders().get(order_id);
+}
+
+bool AsyncClient::settled(const Order& order, double min_filled) noexcept {
+    return order.is_closed() || (min_filled > 0.0 && order.filled >= min_filled);
+}
+
+TradeCallback AsyncClient::forward_trades() {
+    return [this, alive = std::weak_ptr<bool>(alive_)](const Trade& trade) {
+        loop_.post([this, alive, trade]() {
+            if (alive.lock()) {
+                on_trade(trade);
+            }
+        });
+    };
+}
+
+void AsyncClient::on_trade(const Trade& trade) {
+    auto it = subscribers_.find(trade.symbol);
+    if (it == subscribers_.end()) {
+        return;
+    }
+    auto& channels = it->second;
+    for (auto channel = channels.begin(); channel != channels.end();) {
+        if (auto live = channel->lock()) {
+            live->push(trade);
+            ++channel;
+        } else {
+            channel = channels.erase(channel);
+        }
+    }
+}
+
+void AsyncClient::on_order(const Order& order) {
+    std::vector<std::shared_ptr<Waiter>> ready;
+    auto [first, last] = waiters_.equal_range(order.order_id);
+    for (auto it = first; it != last; ++it) {
+        if (settled(order, it->second->min_filled)) {
+            ready.push_back(it->second);
+        }
+    }
+    for (const auto& waiter : ready) {
+        wake(waiter);
+    }
+}
+
+void AsyncClient::wake(const std::shared_ptr<Waiter>& waiter) {
+    if (waiter->woken) {
+        return;
+    }
+    waiter->woken = true;
+    auto [first, last] = waiters_.equal_range(waiter->order_id);
+    for (auto it = first; it != last; ++it) {
+        if (it->second == waiter) {
+            waiters_.erase(it);
+            break;
+        }
+    }
+    loop_.schedule(waiter->handle);
+}
+
+} // namespace lx::async
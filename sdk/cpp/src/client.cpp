@@ -3,9 +3,11 @@
 // SPDX-License-Identifier: MIT
 
 #include "lx/client.hpp"
+#include "lx/pipeline.hpp"
 
 #include <websocketpp/config/asio_no_tls_client.hpp>
 #include <websocketpp/client.hpp>
+#include <asio/steady_timer.hpp>
 
 #include <thread>
 #include <queue>
@@ -32,6 +34,9 @@ public:
         , authenticated_(false)
         , request_id_(0)
         , running_(false)
+        , send_queue_(config_.send_queue_size)
+        , pending_requests_(config_.max_pending_requests)
+        , pending_binary_(config_.max_pending_requests)
     {
         ws_client_.clear_access_channels(websocketpp::log::alevel::all);
         ws_client_.clear_error_channels(websocketpp::log::elevel::all);
@@ -74,6 +79,12 @@ public:
             return Error{-1, "Failed to create connection: " + ec.message()};
         }
 
+        // Frames left from a previous connection are dropped; their
+        // requests have failed or timed out
+        OutboundFrame stale;
+        while (send_queue_.pop(stale)) {}
+        flush_scheduled_ = false;
+
         connection_ = con->get_handle();
         ws_client_.connect(con);
 
@@ -105,6 +116,10 @@ public:
             return Error{-3, "Connection failed"};
         }
 
+        if (config_.encoding == WireEncoding::Binary) {
+            negotiate_encoding();
+        }
+
         // Notify callback
         if (connection_callback_) {
             connection_callback_(state_);
@@ -150,6 +165,10 @@ public:
         return state_;
     }
 
+    WireEncoding encoding() const noexcept {
+        return binary_ ? WireEncoding::Binary : WireEncoding::Json;
+    }
+
     Error authenticate() {
         if (!is_connected()) {
             return Error{-1, "Not connected"};
@@ -184,14 +203,104 @@ public:
     }
 
     Result<OrderResponse> place_order(const Order& order) {
-        if (!is_connected()) {
-            return {{}, Error{-1, "Not connected"}};
+        if (Error err = check_trading()) {
+            return {{}, err};
+        }
+
+        uint32_t market_id = 0;
+        if (binary_ && order.client_id.empty() && market_of(order.symbol, market_id)) {
+            auto& enc = encoder();
+            uint32_t req_id = next_binary_id();
+            if (enc.place(req_id, market_id, order)) {
+                return placed(send_and_wait_binary(req_id, enc, std::chrono::seconds(10)));
+            }
+        }
+
+        return placed(send_and_wait(place_message(order), std::chrono::seconds(10)));
+    }
+
+    void place_order(const Order& order, PlaceCallback done) {
+        if (Error err = check_trading()) {
+            done({{}, err});
+            return;
+        }
+
+        uint32_t market_id = 0;
+        if (binary_ && order.client_id.empty() && market_of(order.symbol, market_id)) {
+            auto& enc = encoder();
+            uint32_t req_id = next_binary_id();
+            if (enc.place(req_id, market_id, order)) {
+                send_then_binary(req_id, enc, std::chrono::seconds(10),
+                                 [this, done = std::move(done)](Result<wire::PackedPlaceResult> result) {
+                                     done(placed(std::move(result)));
+                                 });
+                return;
+            }
+        }
+
+        send_then(place_message(order), std::chrono::seconds(10),
+                  [this, done = std::move(done)](Result<nlohmann::json> result) {
+                      done(placed(std::move(result)));
+                  });
+    }
+
+    std::future<Result<OrderResponse>> place_order_async(const Order& order) {
+        return std::async(std::launch::async, [this, order]() {
+            return place_order(order);
+        });
+    }
+
+    Error cancel_order(uint64_t order_id) {
+        if (Error err = check_trading()) {
+            return err;
+        }
+
+        uint32_t market_id = 0;
+        if (binary_ && market_of_order(order_id, market_id)) {
+            auto& enc = encoder();
+            uint32_t req_id = next_binary_id();
+            enc.cancel(req_id, market_id, order_id);
+            return cancelled(send_and_wait_binary(req_id, enc, std::chrono::seconds(10)));
+        }
+
+        return send_and_wait(cancel_message(order_id), std::chrono::seconds(10)).error;
+    }
+
+    void cancel_order(uint64_t order_id, CancelCallback done) {
+        if (Error err = check_trading()) {
+            done(err);
+            return;
         }
 
+        uint32_t market_id = 0;
+        if (binary_ && market_of_order(order_id, market_id)) {
+            auto& enc = encoder();
+            uint32_t req_id = next_binary_id();
+            enc.cancel(req_id, market_id, order_id);
+            send_then_binary(req_id, enc, std::chrono::seconds(10),
+                             [done = std::move(done)](Result<wire::PackedPlaceResult> result) {
+                                 done(cancelled(std::move(result)));
+                             });
+            return;
+        }
+
+        send_then(cancel_message(order_id), std::chrono::seconds(10),
+                  [done = std::move(done)](Result<nlohmann::json> result) {
+                      done(result.error);
+                  });
+    }
+
+    Error check_trading() const {
+        if (!is_connected()) {
+            return Error{-1, "Not connected"};
+        }
         if (!is_authenticated()) {
-            return {{}, Error{-2, "Not authenticated"}};
+            return Error{-2, "Not authenticated"};
         }
+        return {};
+    }
 
+    nlohmann::json place_message(const Order& order) {
         nlohmann::json order_data = {
             {"symbol", order.symbol},
             {"type", order.type},
@@ -213,14 +322,35 @@ public:
             order_data["reduceOnly"] = true;
         }
 
-        std::string req_id = next_request_id();
-        nlohmann::json msg = {
+        return {
             {"type", "place_order"},
             {"order", order_data},
-            {"request_id", req_id}
+            {"request_id", next_request_id()}
         };
+    }
 
-        auto result = send_and_wait(msg, std::chrono::seconds(10));
+    nlohmann::json cancel_message(uint64_t order_id) {
+        return {
+            {"type", "cancel_order"},
+            {"orderID", order_id},
+            {"request_id", next_request_id()}
+        };
+    }
+
+    Result<OrderResponse> placed(Result<wire::PackedPlaceResult> result) {
+        if (!result.ok()) {
+            return {{}, result.error};
+        }
+
+        metrics_.orders_sent++;
+
+        OrderResponse resp;
+        resp.order_id = result.value.oid;
+        resp.status = wire::status_name(result.value.status);
+        return {resp, {}};
+    }
+
+    Result<OrderResponse> placed(Result<nlohmann::json> result) {
         if (!result.ok()) {
             return {{}, result.error};
         }
@@ -241,32 +371,13 @@ public:
         return {resp, {}};
     }
 
-    std::future<Result<OrderResponse>> place_order_async(const Order& order) {
-        return std::async(std::launch::async, [this, order]() {
-            return place_order(order);
-        });
-    }
-
-    Error cancel_order(uint64_t order_id) {
-        if (!is_connected()) {
-            return Error{-1, "Not connected"};
-        }
-
-        if (!is_authenticated()) {
-            return Error{-2, "Not authenticated"};
-        }
-
-        nlohmann::json msg = {
-            {"type", "cancel_order"},
-            {"orderID", order_id},
-            {"request_id", next_request_id()}
-        };
-
-        auto result = send_and_wait(msg, std::chrono::seconds(10));
+    static Error cancelled(const Result<wire::PackedPlaceResult>& result) {
         if (!result.ok()) {
             return result.error;
         }
-
+        if (result.value.status == wire::STATUS_REJECTED) {
+            return Error{-4, "Cancel rejected"};
+        }
         return {};
     }
 
@@ -285,6 +396,21 @@ public:
             return Error{-2, "Not authenticated"};
         }
 
+        uint32_t market_id = 0;
+        if (binary_ && market_of_order(order_id, market_id)) {
+            auto& enc = encoder();
+            uint32_t req_id = next_binary_id();
+            enc.modify(req_id, market_id, order_id, new_price, new_size);
+            auto result = send_and_wait_binary(req_id, enc, std::chrono::seconds(10));
+            if (!result.ok()) {
+                return result.error;
+            }
+            if (result.value.status == wire::STATUS_REJECTED) {
+                return Error{-4, "Modify rejected"};
+            }
+            return {};
+        }
+
         nlohmann::json msg = {
             {"type", "modify_order"},
             {"orderID", order_id},
@@ -613,6 +739,7 @@ private:
     void on_close(ConnectionHdl hdl) {
         state_ = ConnectionState::Disconnected;
         authenticated_ = false;
+        binary_ = false;
         connect_cv_.notify_all();
 
         if (connection_callback_) {
@@ -637,18 +764,19 @@ private:
     void on_message(ConnectionHdl hdl, MessagePtr msg) {
         metrics_.messages_received++;
 
+        if (msg->get_opcode() == websocketpp::frame::opcode::binary) {
+            handle_binary(msg->get_payload());
+            return;
+        }
+
         try {
             auto json = nlohmann::json::parse(msg->get_payload());
 
             // Handle request responses
-            if (json.contains("request_id")) {
-                std::string req_id = json["request_id"];
-                std::lock_guard<std::mutex> lock(pending_mutex_);
-                auto it = pending_requests_.find(req_id);
-                if (it != pending_requests_.end()) {
-                    it->second.set_value(json);
-                    pending_requests_.erase(it);
-                }
+            uint64_t req_id;
+            if (json.contains("request_id") && json["request_id"].is_string() &&
+                parse_request_id(json["request_id"].get_ref<const std::string&>(), req_id)) {
+                pending_requests_.complete(req_id, json);
             }
 
             // Handle specific message types
@@ -694,6 +822,20 @@ private:
             OrderBook snapshot = data["snapshot"].get<OrderBook>();
             snapshot.symbol = symbol;
             book.apply_snapshot(snapshot);
+        } else if (data.contains("bids") || data.contains("asks")) {
+            // Incremental levels are applied as one batch so the book
+            // notifies once per message, not once per level
+            std::vector<LevelUpdate> updates;
+            auto append = [&updates](const nlohmann::json& levels, Side side) {
+                for (const auto& l : levels) {
+                    PriceLevel level = l.get<PriceLevel>();
+                    updates.push_back({side, level.price, level.size,
+                                       level.count > 0 ? level.count : 1});
+                }
+            };
+            if (data.contains("bids")) append(data["bids"], Side::Buy);
+            if (data.contains("asks")) append(data["asks"], Side::Sell);
+            book.apply_updates(updates);
         }
 
         if (orderbook_callback_) {
@@ -701,6 +843,69 @@ private:
         }
     }
 
+    void handle_binary(const std::string& payload) {
+        const auto* data = reinterpret_cast<const uint8_t*>(payload.data());
+        const size_t size = payload.size();
+
+        wire::FrameHeader header;
+        if (!wire::decode_header(data, size, header)) {
+            metrics_.error_count++;
+            return;
+        }
+
+        switch (static_cast<wire::MessageType>(header.type)) {
+            case wire::MessageType::PlaceResult: {
+                wire::PackedPlaceResult result;
+                if (!wire::decode_place_result(data, size, result)) break;
+                pending_binary_.complete(header.request_id, result);
+                return;
+            }
+            case wire::MessageType::BookLevels: {
+                wire::BookLevelsView view;
+                std::string symbol;
+                if (!wire::decode_book(data, size, view) || !symbol_of(view.market_id(), symbol)) break;
+
+                // level_updates_ is only touched on the IO thread and
+                // keeps its capacity between frames
+                level_updates_.clear();
+                for (size_t i = 0; i < view.count(); ++i) {
+                    const wire::PackedQuoteLevel level = view.level(i);
+                    level_updates_.push_back({level.is_buy ? Side::Buy : Side::Sell,
+                                              wire::from_fixed(level.price),
+                                              wire::from_fixed(level.size), 1});
+                }
+                auto& book = orderbook_manager_.get_or_create(symbol);
+                book.apply_updates(level_updates_);
+
+                if (orderbook_callback_) {
+                    orderbook_callback_(book.get_snapshot());
+                }
+                return;
+            }
+            case wire::MessageType::Trade: {
+                wire::PackedTrade packed;
+                Trade trade;
+                if (!wire::decode_trade(data, size, packed) || !symbol_of(packed.market_id, trade.symbol)) break;
+                trade.trade_id = packed.trade_id;
+                trade.price = wire::from_fixed(packed.price);
+                trade.size = wire::from_fixed(packed.size);
+                trade.side = packed.is_buy ? Side::Buy : Side::Sell;
+                trade.timestamp = packed.timestamp;
+                trade_tracker_.add(trade);
+                metrics_.trades_received++;
+
+                if (trade_callback_) {
+                    trade_callback_(trade);
+                }
+                return;
+            }
+            default:
+                break;
+        }
+
+        metrics_.error_count++;
+    }
+
     void handle_trade_update(const nlohmann::json& data) {
         if (data.contains("trade")) {
             Trade trade = data["trade"].get<Trade>();
@@ -757,14 +962,51 @@ private:
         if (!is_connected()) {
             return Error{-1, "Not connected"};
         }
+        return enqueue(msg.dump(), websocketpp::frame::opcode::text);
+    }
 
-        try {
-            std::string payload = msg.dump();
-            ws_client_.send(connection_, payload, websocketpp::frame::opcode::text);
-            metrics_.messages_sent++;
-            return {};
-        } catch (const std::exception& e) {
-            return Error{-1, std::string("Send failed: ") + e.what()};
+    // Frames are written by the IO thread, not the caller. The first frame
+    // into an idle queue schedules a flush, and everything queued before
+    // that flush runs goes out with it.
+    Error enqueue(std::string payload, websocketpp::frame::opcode::value opcode) {
+        if (!send_queue_.push(OutboundFrame{std::move(payload), opcode})) {
+            return Error{-5, "Send queue full"};
+        }
+        metrics_.messages_sent++;
+
+        if (!flush_scheduled_.exchange(true, std::memory_order_acq_rel)) {
+            batch_start_.store(std::chrono::steady_clock::now().time_since_epoch().count(),
+                               std::memory_order_relaxed);
+            ws_client_.get_io_service().post([this]() { flush(); });
+        }
+        return {};
+    }
+
+    // IO thread. Hands every queued frame to websocketpp back to back; it
+    // gathers messages queued behind an in-progress write into a single
+    // socket write, so a burst costs a few syscalls rather than one per
+    // frame. With a coalesce window the flush is re-posted, letting other
+    // IO run, until the first frame has waited that long.
+    void flush() {
+        const auto waited = std::chrono::steady_clock::now().time_since_epoch().count() -
+                            batch_start_.load(std::memory_order_relaxed);
+        if (waited < std::chrono::duration_cast<std::chrono::steady_clock::duration>(
+                         config_.send_coalesce_window).count()) {
+            ws_client_.get_io_service().post([this]() { flush(); });
+            return;
+        }
+
+        // Cleared before draining: a producer that still sees it set has
+        // already pushed, and this exchange makes that push visible here
+        flush_scheduled_.exchange(false, std::memory_order_acq_rel);
+
+        OutboundFrame frame;
+        while (send_queue_.pop(frame)) {
+            websocketpp::lib::error_code ec;
+            ws_client_.send(connection_, frame.payload, frame.opcode, ec);
+            if (ec) {
+                metrics_.error_count++;
+            }
         }
     }
 
@@ -772,34 +1014,63 @@ private:
         const nlohmann::json& msg,
         std::chrono::seconds timeout
     ) {
-        std::string req_id = msg["request_id"];
-
-        std::promise<nlohmann::json> promise;
-        auto future = promise.get_future();
-
-        {
-            std::lock_guard<std::mutex> lock(pending_mutex_);
-            pending_requests_[req_id] = std::move(promise);
+        uint64_t req_id;
+        if (!parse_request_id(msg["request_id"].get<std::string>(), req_id)) {
+            return {{}, Error{-3, "Invalid request ID"}};
+        }
+        if (!pending_requests_.open(req_id)) {
+            return {{}, Error{-5, "Too many requests in flight"}};
         }
 
         auto send_err = send(msg);
         if (send_err) {
-            std::lock_guard<std::mutex> lock(pending_mutex_);
-            pending_requests_.erase(req_id);
+            pending_requests_.cancel(req_id);
             return {{}, send_err};
         }
 
-        auto status = future.wait_for(timeout);
-        if (status == std::future_status::timeout) {
-            std::lock_guard<std::mutex> lock(pending_mutex_);
-            pending_requests_.erase(req_id);
+        nlohmann::json reply;
+        if (!pending_requests_.wait(req_id, timeout, reply)) {
             return {{}, Error{-2, "Request timeout"}};
         }
+        return {std::move(reply), {}};
+    }
 
-        try {
-            return {future.get(), {}};
-        } catch (const std::exception& e) {
-            return {{}, Error{-3, std::string("Request failed: ") + e.what()}};
+    // Like send_and_wait, but `done` runs on the IO thread when the reply
+    // arrives or the timeout passes, and nothing blocks in between
+    void send_then(
+        const nlohmann::json& msg,
+        std::chrono::seconds timeout,
+        std::function<void(Result<nlohmann::json>)> done
+    ) {
+        uint64_t req_id;
+        if (!parse_request_id(msg["request_id"].get<std::string>(), req_id)) {
+            done({{}, Error{-3, "Invalid request ID"}});
+            return;
+        }
+
+        auto timer = std::make_shared<asio::steady_timer>(ws_client_.get_io_service(), timeout);
+        // Shared with the completion, which may be dropped unrun if the
+        // request never goes out
+        auto callback = std::make_shared<std::function<void(Result<nlohmann::json>)>>(std::move(done));
+        auto completion = [timer, callback](const nlohmann::json* reply) {
+            if (!reply) {
+                (*callback)({{}, Error{-2, "Request timeout"}});
+                return;
+            }
+            timer->cancel();
+            (*callback)({*reply, {}});
+        };
+        if (!pending_requests_.open(req_id, std::move(completion))) {
+            (*callback)({{}, Error{-5, "Too many requests in flight"}});
+            return;
+        }
+
+        arm_expiry(timer, [this, req_id]() { pending_requests_.expire(req_id); });
+
+        auto send_err = send(msg);
+        if (send_err) {
+            pending_requests_.cancel(req_id);
+            (*callback)({{}, send_err});
         }
     }
 
@@ -807,6 +1078,145 @@ private:
         return std::to_string(++request_id_);
     }
 
+    // Offer binary frames; a server that does not answer, or answers
+    // with anything but "binary", keeps the connection on JSON
+    void negotiate_encoding() {
+        nlohmann::json msg = {
+            {"type", "hello"},
+            {"encodings", nlohmann::json::array({"binary", "json"})},
+            {"request_id", next_request_id()}
+        };
+
+        auto result = send_and_wait(msg, std::chrono::seconds(5));
+        if (!result.ok() || !result.value.contains("data")) {
+            return;
+        }
+
+        const auto& data = result.value["data"];
+        if (data.value("encoding", std::string("json")) != "binary") {
+            return;
+        }
+
+        {
+            std::lock_guard<std::mutex> lock(markets_mutex_);
+            market_ids_.clear();
+            market_symbols_.clear();
+            if (data.contains("markets")) {
+                for (const auto& [symbol, id] : data["markets"].items()) {
+                    market_ids_[symbol] = id.get<uint32_t>();
+                    market_symbols_[id.get<uint32_t>()] = symbol;
+                }
+            }
+        }
+        binary_ = true;
+    }
+
+    bool market_of(const std::string& symbol, uint32_t& market_id) const {
+        std::lock_guard<std::mutex> lock(markets_mutex_);
+        auto it = market_ids_.find(symbol);
+        if (it == market_ids_.end()) return false;
+        market_id = it->second;
+        return true;
+    }
+
+    bool market_of_order(uint64_t order_id, uint32_t& market_id) const {
+        auto order = order_tracker_.get(order_id);
+        return order && market_of(order->symbol, market_id);
+    }
+
+    bool symbol_of(uint32_t market_id, std::string& symbol) const {
+        std::lock_guard<std::mutex> lock(markets_mutex_);
+        auto it = market_symbols_.find(market_id);
+        if (it == market_symbols_.end()) return false;
+        symbol = it->second;
+        return true;
+    }
+
+    // Binary request IDs share the JSON counter; 0 marks unsolicited frames
+    uint32_t next_binary_id() {
+        uint32_t id;
+        do {
+            id = static_cast<uint32_t>(++request_id_);
+        } while (id == 0);
+        return id;
+    }
+
+    // One encode buffer per calling thread, reused across requests
+    static wire::Encoder& encoder() {
+        thread_local wire::Encoder enc;
+        return enc;
+    }
+
+    Result<wire::PackedPlaceResult> send_and_wait_binary(
+        uint32_t req_id,
+        const wire::Encoder& frame,
+        std::chrono::seconds timeout
+    ) {
+        if (!pending_binary_.open(req_id)) {
+            return {{}, Error{-5, "Too many requests in flight"}};
+        }
+
+        auto send_err = enqueue(std::string(reinterpret_cast<const char*>(frame.data()), frame.size()),
+                                websocketpp::frame::opcode::binary);
+        if (send_err) {
+            pending_binary_.cancel(req_id);
+            return {{}, send_err};
+        }
+
+        wire::PackedPlaceResult result;
+        if (!pending_binary_.wait(req_id, timeout, result)) {
+            return {{}, Error{-2, "Request timeout"}};
+        }
+        return {result, {}};
+    }
+
+    void send_then_binary(
+        uint32_t req_id,
+        const wire::Encoder& frame,
+        std::chrono::seconds timeout,
+        std::function<void(Result<wire::PackedPlaceResult>)> done
+    ) {
+        auto timer = std::make_shared<asio::steady_timer>(ws_client_.get_io_service(), timeout);
+        // Shared with the completion, which may be dropped unrun if the
+        // request never goes out
+        auto callback = std::make_shared<std::function<void(Result<wire::PackedPlaceResult>)>>(std::move(done));
+        auto completion = [timer, callback](const wire::PackedPlaceResult* result) {
+            if (!result) {
+                (*callback)({{}, Error{-2, "Request timeout"}});
+                return;
+            }
+            timer->cancel();
+            (*callback)({*result, {}});
+        };
+        if (!pending_binary_.open(req_id, std::move(completion))) {
+            (*callback)({{}, Error{-5, "Too many requests in flight"}});
+            return;
+        }
+
+        arm_expiry(timer, [this, req_id]() { pending_binary_.expire(req_id); });
+
+        auto send_err = enqueue(std::string(reinterpret_cast<const char*>(frame.data()), frame.size()),
+                                websocketpp::frame::opcode::binary);
+        if (send_err) {
+            pending_binary_.cancel(req_id);
+            (*callback)({{}, send_err});
+        }
+    }
+
+    // Armed on the IO thread ahead of the flush that sends the request, so
+    // the reply cancelling the timer always finds it armed and the timer is
+    // only ever touched there
+    template<typename Expire>
+    void arm_expiry(const std::shared_ptr<asio::steady_timer>& timer, Expire expire) {
+        ws_client_.get_io_service().post([timer, expire]() {
+            timer->async_wait([timer, expire](const asio::error_code& ec) {
+                if (!ec) {
+                    expire();
+                }
+            });
+        });
+    }
+
     ClientConfig config_;
     WsClient ws_client_;
     ConnectionHdl connection_;
@@ -816,12 +1226,29 @@ private:
     std::atomic<bool> authenticated_;
     std::atomic<uint64_t> request_id_;
     std::atomic<bool> running_;
+    std::atomic<bool> binary_{false};
 
     std::mutex connect_mutex_;
     std::condition_variable connect_cv_;
 
-    std::mutex pending_mutex_;
-    std::unordered_map<std::string, std::promise<nlohmann::json>> pending_requests_;
+    // Outbound frames, drained by flush() on the IO thread
+    struct OutboundFrame {
+        std::string payload;
+        websocketpp::frame::opcode::value opcode = websocketpp::frame::opcode::text;
+    };
+    MpscQueue<OutboundFrame> send_queue_;
+    std::atomic<bool> flush_scheduled_{false};
+    std::atomic<std::chrono::steady_clock::rep> batch_start_{0};
+
+    // Replies awaited by numeric request ID
+    PendingTable<nlohmann::json> pending_requests_;
+    PendingTable<wire::PackedPlaceResult> pending_binary_;
+
+    // Market IDs announced by the server when binary frames are agreed
+    mutable std::mutex markets_mutex_;
+    std::unordered_map<std::string, uint32_t> market_ids_;
+    std::unordered_map<uint32_t, std::string> market_symbols_;
+    std::vector<LevelUpdate> level_updates_;
 
     // Callbacks
     ErrorCallback error_callback_;
@@ -866,6 +1293,10 @@ ConnectionState Client::state() const noexcept {
     return impl_->state();
 }
 
+WireEncoding Client::encoding() const noexcept {
+    return impl_->encoding();
+}
+
 Error Client::authenticate() {
     return impl_->authenticate();
 }
@@ -878,6 +1309,10 @@ Result<OrderResponse> Client::place_order(const Order& order) {
     return impl_->place_order(order);
 }
 
+void Client::place_order(const Order& order, PlaceCallback done) {
+    impl_->place_order(order, std::move(done));
+}
+
 std::future<Result<OrderResponse>> Client::place_order_async(const Order& order) {
     return impl_->place_order_async(order);
 }
@@ -886,6 +1321,10 @@ Error Client::cancel_order(uint64_t order_id) {
     return impl_->cancel_order(order_id);
 }
 
+void Client::cancel_order(uint64_t order_id, CancelCallback done) {
+    impl_->cancel_order(order_id, std::move(done));
+}
+
 std::future<Error> Client::cancel_order_async(uint64_t order_id) {
     return impl_->cancel_order_async(order_id);
 }
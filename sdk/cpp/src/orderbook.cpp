@@ -5,9 +5,30 @@
 #include "lx/orderbook.hpp"
 #include <algorithm>
 #include <chrono>
+#include <cmath>
+#include <cstring>
+#include <unordered_set>
 
 namespace lx {
 
+namespace {
+
+int64_t now_ms() {
+    return std::chrono::duration_cast<std::chrono::milliseconds>(
+        std::chrono::system_clock::now().time_since_epoch()
+    ).count();
+}
+
+// Copy into a fixed, NUL-terminated field, truncating if needed
+template<size_t N>
+void copy_field(char (&dst)[N], const std::string& src) noexcept {
+    const size_t n = std::min(src.size(), N - 1);
+    std::memcpy(dst, src.data(), n);
+    dst[n] = '\0';
+}
+
+} // namespace
+
 //------------------------------------------------------------------------------
 // LocalOrderBook
 //------------------------------------------------------------------------------
@@ -34,12 +55,7 @@ void LocalOrderBook::apply_snapshot(const OrderBook& snapshot) {
         }
     }
 
-    last_update_.store(snapshot.timestamp > 0
-        ? snapshot.timestamp
-        : std::chrono::duration_cast<std::chrono::milliseconds>(
-            std::chrono::system_clock::now().time_since_epoch()
-          ).count()
-    );
+    last_update_.store(snapshot.timestamp > 0 ? snapshot.timestamp : now_ms());
 
     notify_update();
 }
@@ -47,25 +63,39 @@ void LocalOrderBook::apply_snapshot(const OrderBook& snapshot) {
 void LocalOrderBook::update_level(Side side, double price, double size) {
     std::lock_guard<std::mutex> lock(mutex_);
 
+    set_level(side, price, size, 1);
+    last_update_.store(now_ms());
+
+    notify_update();
+}
+
+void LocalOrderBook::apply_updates(const std::vector<LevelUpdate>& updates) {
+    if (updates.empty()) return;
+
+    std::lock_guard<std::mutex> lock(mutex_);
+
+    for (const auto& update : updates) {
+        set_level(update.side, update.price, update.size, update.count);
+    }
+    last_update_.store(now_ms());
+
+    notify_update();
+}
+
+void LocalOrderBook::set_level(Side side, double price, double size, int32_t count) {
     if (side == Side::Buy) {
         if (size > 0) {
-            bids_[price] = PriceLevel{price, size, 1};
+            bids_[price] = PriceLevel{price, size, count};
         } else {
             bids_.erase(price);
         }
     } else {
         if (size > 0) {
-            asks_[price] = PriceLevel{price, size, 1};
+            asks_[price] = PriceLevel{price, size, count};
         } else {
             asks_.erase(price);
         }
     }
-
-    last_update_.store(std::chrono::duration_cast<std::chrono::milliseconds>(
-        std::chrono::system_clock::now().time_since_epoch()
-    ).count());
-
-    notify_update();
 }
 
 void LocalOrderBook::remove_level(Side side, double price) {
@@ -171,6 +201,268 @@ void LocalOrderBook::notify_update() {
     }
 }
 
+//------------------------------------------------------------------------------
+// TickOrderBook
+//------------------------------------------------------------------------------
+
+TickOrderBook::TickOrderBook(std::string symbol, double tick_size)
+    : symbol_(std::move(symbol))
+    , tick_size_(tick_size > 0 ? tick_size : 1e-8)
+{}
+
+int64_t TickOrderBook::to_ticks(double price) const noexcept {
+    return std::llround(price / tick_size_);
+}
+
+double TickOrderBook::to_price(int64_t ticks) const noexcept {
+    return static_cast<double>(ticks) * tick_size_;
+}
+
+void TickOrderBook::apply_snapshot(const OrderBook& snapshot) {
+    std::lock_guard<std::mutex> lock(mutex_);
+
+    // Sort once rather than inserting level by level; a later duplicate
+    // of a price wins, as it would applied in order
+    auto load = [this](const std::vector<PriceLevel>& levels, Ladder& ladder, bool ascending) {
+        ladder.clear();
+        ladder.reserve(levels.size());
+        for (const auto& level : levels) {
+            ladder.push_back(Level{to_ticks(level.price), level.size, level.count});
+        }
+        std::stable_sort(ladder.begin(), ladder.end(), [ascending](const Level& a, const Level& b) {
+            return ascending ? a.ticks < b.ticks : a.ticks > b.ticks;
+        });
+        auto out = ladder.begin();
+        for (auto it = ladder.begin(); it != ladder.end(); ++it) {
+            auto next = it + 1;
+            if (next != ladder.end() && next->ticks == it->ticks) continue;
+            if (it->size > 0) *out++ = *it;
+        }
+        ladder.erase(out, ladder.end());
+    };
+    load(snapshot.bids, bids_, true);
+    load(snapshot.asks, asks_, false);
+
+    last_update_.store(snapshot.timestamp > 0 ? snapshot.timestamp : now_ms());
+    const uint64_t seq = sequence_.fetch_add(1) + 1;
+
+    if (delta_callback_) {
+        BookDelta delta;
+        delta.symbol = symbol_;
+        delta.sequence = seq;
+        delta.checksum = checksum_locked();
+        delta.timestamp = last_update_.load();
+        delta.snapshot = true;
+        delta.bids.reserve(bids_.size());
+        for (auto it = bids_.rbegin(); it != bids_.rend(); ++it) {
+            delta.bids.push_back(to_level(*it));
+        }
+        delta.asks.reserve(asks_.size());
+        for (auto it = asks_.rbegin(); it != asks_.rend(); ++it) {
+            delta.asks.push_back(to_level(*it));
+        }
+        delta_callback_(delta);
+    }
+}
+
+uint64_t TickOrderBook::apply_updates(const std::vector<LevelUpdate>& updates, int64_t timestamp) {
+    std::lock_guard<std::mutex> lock(mutex_);
+
+    std::vector<int64_t> bid_ticks;
+    std::vector<int64_t> ask_ticks;
+    for (const auto& update : updates) {
+        const int64_t ticks = to_ticks(update.price);
+        set_level(update.side, ticks, update.size, update.count);
+        (update.side == Side::Buy ? bid_ticks : ask_ticks).push_back(ticks);
+    }
+
+    last_update_.store(timestamp > 0 ? timestamp : now_ms());
+    const uint64_t seq = sequence_.fetch_add(1) + 1;
+
+    if (delta_callback_) {
+        BookDelta delta;
+        delta.symbol = symbol_;
+        delta.sequence = seq;
+        delta.checksum = checksum_locked();
+        delta.timestamp = last_update_.load();
+
+        // Each changed level once, best first, with its final state
+        auto collect = [this](Side side, std::vector<int64_t>& ticks, std::vector<PriceLevel>& out) {
+            if (side == Side::Buy) {
+                std::sort(ticks.begin(), ticks.end(), std::greater<int64_t>());
+            } else {
+                std::sort(ticks.begin(), ticks.end());
+            }
+            ticks.erase(std::unique(ticks.begin(), ticks.end()), ticks.end());
+            out.reserve(ticks.size());
+            for (int64_t t : ticks) {
+                const Level* level = find_level(side, t);
+                out.push_back(level ? to_level(*level) : PriceLevel{to_price(t), 0.0, 0});
+            }
+        };
+        collect(Side::Buy, bid_ticks, delta.bids);
+        collect(Side::Sell, ask_ticks, delta.asks);
+
+        delta_callback_(delta);
+    }
+    return seq;
+}
+
+void TickOrderBook::update_level(Side side, double price, double size) {
+    apply_updates({LevelUpdate{side, price, size, 1}});
+}
+
+void TickOrderBook::remove_level(Side side, double price) {
+    update_level(side, price, 0);
+}
+
+void TickOrderBook::set_level(Side side, int64_t ticks, double size, int32_t count) {
+    Ladder& ladder = side == Side::Buy ? bids_ : asks_;
+    auto it = side == Side::Buy
+        ? std::lower_bound(ladder.begin(), ladder.end(), ticks,
+            [](const Level& l, int64_t t) { return l.ticks < t; })
+        : std::lower_bound(ladder.begin(), ladder.end(), ticks,
+            [](const Level& l, int64_t t) { return l.ticks > t; });
+
+    if (it != ladder.end() && it->ticks == ticks) {
+        if (size > 0) {
+            it->size = size;
+            it->count = count;
+        } else {
+            ladder.erase(it);
+        }
+    } else if (size > 0) {
+        ladder.insert(it, Level{ticks, size, count});
+    }
+}
+
+const TickOrderBook::Level* TickOrderBook::find_level(Side side, int64_t ticks) const {
+    const Ladder& ladder = side == Side::Buy ? bids_ : asks_;
+    auto it = side == Side::Buy
+        ? std::lower_bound(ladder.begin(), ladder.end(), ticks,
+            [](const Level& l, int64_t t) { return l.ticks < t; })
+        : std::lower_bound(ladder.begin(), ladder.end(), ticks,
+            [](const Level& l, int64_t t) { return l.ticks > t; });
+    return it != ladder.end() && it->ticks == ticks ? &*it : nullptr;
+}
+
+PriceLevel TickOrderBook::to_level(const Level& level) const {
+    return PriceLevel{to_price(level.ticks), level.size, level.count};
+}
+
+OrderBook TickOrderBook::get_snapshot(int32_t depth) const {
+    std::lock_guard<std::mutex> lock(mutex_);
+
+    OrderBook ob;
+    ob.symbol = symbol_;
+    ob.timestamp = last_update_.load();
+
+    size_t limit = depth > 0 ? static_cast<size_t>(depth) : SIZE_MAX;
+
+    ob.bids.reserve(std::min(bids_.size(), limit));
+    for (auto it = bids_.rbegin(); it != bids_.rend() && ob.bids.size() < limit; ++it) {
+        ob.bids.push_back(to_level(*it));
+    }
+
+    ob.asks.reserve(std::min(asks_.size(), limit));
+    for (auto it = asks_.rbegin(); it != asks_.rend() && ob.asks.size() < limit; ++it) {
+        ob.asks.push_back(to_level(*it));
+    }
+
+    return ob;
+}
+
+std::optional<PriceLevel> TickOrderBook::best_bid() const {
+    std::lock_guard<std::mutex> lock(mutex_);
+    if (bids_.empty()) return std::nullopt;
+    return to_level(bids_.back());
+}
+
+std::optional<PriceLevel> TickOrderBook::best_ask() const {
+    std::lock_guard<std::mutex> lock(mutex_);
+    if (asks_.empty()) return std::nullopt;
+    return to_level(asks_.back());
+}
+
+double TickOrderBook::mid_price() const {
+    std::lock_guard<std::mutex> lock(mutex_);
+    if (bids_.empty() || asks_.empty()) return 0.0;
+    return to_price(bids_.back().ticks + asks_.back().ticks) / 2.0;
+}
+
+double TickOrderBook::spread() const {
+    std::lock_guard<std::mutex> lock(mutex_);
+    if (bids_.empty() || asks_.empty()) return 0.0;
+    return to_price(asks_.back().ticks - bids_.back().ticks);
+}
+
+double TickOrderBook::bid_depth() const {
+    std::lock_guard<std::mutex> lock(mutex_);
+    double total = 0.0;
+    for (const auto& level : bids_) {
+        total += level.size;
+    }
+    return total;
+}
+
+double TickOrderBook::ask_depth() const {
+    std::lock_guard<std::mutex> lock(mutex_);
+    double total = 0.0;
+    for (const auto& level : asks_) {
+        total += level.size;
+    }
+    return total;
+}
+
+size_t TickOrderBook::bid_levels() const {
+    std::lock_guard<std::mutex> lock(mutex_);
+    return bids_.size();
+}
+
+size_t TickOrderBook::ask_levels() const {
+    std::lock_guard<std::mutex> lock(mutex_);
+    return asks_.size();
+}
+
+void TickOrderBook::clear() {
+    std::lock_guard<std::mutex> lock(mutex_);
+    bids_.clear();
+    asks_.clear();
+    last_update_.store(0);
+}
+
+uint32_t TickOrderBook::checksum() const {
+    std::lock_guard<std::mutex> lock(mutex_);
+    return checksum_locked();
+}
+
+uint32_t TickOrderBook::checksum_locked() const {
+    uint32_t hash = 2166136261u;
+    auto mix = [&hash](int64_t value) {
+        auto bits = static_cast<uint64_t>(value);
+        for (int i = 0; i < 8; ++i) {
+            hash ^= static_cast<uint32_t>(bits & 0xff);
+            hash *= 16777619u;
+            bits >>= 8;
+        }
+    };
+    auto hash_side = [&mix](const Ladder& ladder) {
+        size_t n = 0;
+        for (auto it = ladder.rbegin(); it != ladder.rend() && n < kChecksumDepth; ++it, ++n) {
+            mix(it->ticks);
+            mix(std::llround(it->size * 1e8));
+        }
+    };
+    hash_side(bids_);
+    hash_side(asks_);
+    return hash;
+}
+
+void TickOrderBook::on_delta(std::function<void(const BookDelta&)> callback) {
+    std::lock_guard<std::mutex> lock(mutex_);
+    delta_callback_ = std::move(callback);
+}
+
 //------------------------------------------------------------------------------
 // OrderTracker
 //------------------------------------------------------------------------------
@@ -308,6 +600,139 @@ void TradeTracker::on_trade(std::function<void(const Trade&)> callback) {
     trade_callback_ = std::move(callback);
 }
 
+//------------------------------------------------------------------------------
+// TradeRecord / OrderRecord
+//------------------------------------------------------------------------------
+
+TradeRecord TradeRecord::from(const Trade& trade) noexcept {
+    TradeRecord r;
+    r.trade_id = trade.trade_id;
+    copy_field(r.symbol, trade.symbol);
+    r.price = trade.price;
+    r.size = trade.size;
+    r.side = trade.side;
+    r.buy_order_id = trade.buy_order_id;
+    r.sell_order_id = trade.sell_order_id;
+    r.timestamp = trade.timestamp;
+    return r;
+}
+
+Trade TradeRecord::to_trade() const {
+    Trade t;
+    t.trade_id = trade_id;
+    t.symbol = symbol;
+    t.price = price;
+    t.size = size;
+    t.side = side;
+    t.buy_order_id = buy_order_id;
+    t.sell_order_id = sell_order_id;
+    t.timestamp = timestamp;
+    return t;
+}
+
+OrderRecord OrderRecord::from(const Order& order) noexcept {
+    OrderRecord r;
+    r.order_id = order.order_id;
+    copy_field(r.symbol, order.symbol);
+    copy_field(r.client_id, order.client_id);
+    r.type = order.type;
+    r.side = order.side;
+    r.price = order.price;
+    r.size = order.size;
+    r.filled = order.filled;
+    r.remaining = order.remaining;
+    r.status = order.status;
+    r.time_in_force = order.time_in_force;
+    r.timestamp = order.timestamp;
+    r.post_only = order.post_only;
+    r.reduce_only = order.reduce_only;
+    return r;
+}
+
+Order OrderRecord::to_order() const {
+    Order o;
+    o.order_id = order_id;
+    o.symbol = symbol;
+    o.client_id = client_id;
+    o.type = type;
+    o.side = side;
+    o.price = price;
+    o.size = size;
+    o.filled = filled;
+    o.remaining = remaining;
+    o.status = status;
+    o.time_in_force = time_in_force;
+    o.timestamp = timestamp;
+    o.post_only = post_only;
+    o.reduce_only = reduce_only;
+    return o;
+}
+
+//------------------------------------------------------------------------------
+// TradeRing
+//------------------------------------------------------------------------------
+
+TradeRing::TradeRing(size_t capacity)
+    : ring_(capacity)
+{}
+
+uint64_t TradeRing::add(const Trade& trade) noexcept {
+    return ring_.push(TradeRecord::from(trade));
+}
+
+std::vector<Trade> TradeRing::get_by_symbol(std::string_view symbol, size_t limit) const {
+    std::vector<Trade> result;
+    TradeRecord record;
+
+    // Walk back from the newest trade (most recent first)
+    const uint64_t tail = ring_.tail();
+    for (uint64_t seq = ring_.head(); seq >= tail && seq > 0 && result.size() < limit; --seq) {
+        if (ring_.read(seq, record) && record.symbol_view() == symbol) {
+            result.push_back(record.to_trade());
+        }
+    }
+    return result;
+}
+
+//------------------------------------------------------------------------------
+// OrderRing
+//------------------------------------------------------------------------------
+
+OrderRing::OrderRing(size_t capacity)
+    : ring_(capacity)
+{}
+
+uint64_t OrderRing::upsert(const Order& order) noexcept {
+    return ring_.push(OrderRecord::from(order));
+}
+
+std::optional<OrderRecord> OrderRing::get(uint64_t order_id) const noexcept {
+    OrderRecord record;
+    const uint64_t tail = ring_.tail();
+    for (uint64_t seq = ring_.head(); seq >= tail && seq > 0; --seq) {
+        if (ring_.read(seq, record) && record.order_id == order_id) {
+            return record;
+        }
+    }
+    return std::nullopt;
+}
+
+std::vector<Order> OrderRing::get_open(std::string_view symbol) const {
+    std::vector<Order> result;
+    std::unordered_set<uint64_t> seen;
+    OrderRecord record;
+
+    // Newest record per order decides whether it is still open
+    const uint64_t tail = ring_.tail();
+    for (uint64_t seq = ring_.head(); seq >= tail && seq > 0; --seq) {
+        if (!ring_.read(seq, record) || !seen.insert(record.order_id).second) continue;
+        if (record.is_open() && (symbol.empty() || record.symbol_view() == symbol)) {
+            result.push_back(record.to_order());
+        }
+    }
+    return result;
+}
+
 //------------------------------------------------------------------------------
 // OrderBookManager
 //------------------------------------------------------------------------------
@@ -224,7 +224,7 @@ double lx_cvar(const double* returns, size_t count, double confidence);
  * ============================================================================ */
 
 /**
- * Calculate returns from prices
+ * Calculate returns from prices (vectorized like the batch operations)
  * @param prices       Array of prices
  * @param price_count  Number of prices
  * @param returns      Output: array of returns (must have space for price_count - 1)
@@ -297,6 +297,83 @@ double lx_variance(const double* data, size_t count);
 double lx_std_dev(const double* data, size_t count);
 double lx_sum(const double* data, size_t count);
 
+/* ============================================================================
+ * Batch Operations
+ * ============================================================================
+ *
+ * Array-in/array-out forms of the functions above for revaluing many
+ * instruments per call. The kernels are picked once at runtime from the
+ * CPU's features: AVX2+FMA or SSE2 on x86-64, NEON on ARM64, when the
+ * library was built with LX_TRADING_C_USE_SIMD, otherwise the scalar
+ * functions in a loop. Vector exp/log differ from libm in the last few
+ * ulps, so batch Black-Scholes and Greeks can differ from the scalar
+ * results at that level. All arrays hold `count` elements.
+ */
+
+/* Instruction set the batch kernels run on: "avx2", "sse2", "neon" or "scalar" */
+const char* lx_simd_isa(void);
+
+/**
+ * Black-Scholes prices, same conventions as lx_black_scholes
+ * @param prices  Output: option prices
+ */
+void lx_black_scholes_batch(const double* S, const double* K, const double* T,
+                            const double* r, const double* sigma,
+                            double* prices, size_t count, bool is_call);
+
+/**
+ * Greeks, same conventions as lx_greeks
+ * @param out     Output: Greeks per option
+ */
+void lx_greeks_batch(const double* S, const double* K, const double* T,
+                     const double* r, const double* sigma,
+                     LxGreeks* out, size_t count, bool is_call);
+
+/**
+ * Constant product quotes, same conventions as lx_constant_product_price;
+ * each element is its own pool and trade
+ * @param output_amount   Output: amounts of output token
+ * @param effective_price Output: effective prices
+ */
+void lx_constant_product_price_batch(const double* reserve_x, const double* reserve_y,
+                                     const double* amount_in, const double* fee_rate,
+                                     bool is_x_to_y,
+                                     double* output_amount, double* effective_price,
+                                     size_t count);
+
+/**
+ * Concentrated liquidity quotes, same conventions as
+ * lx_concentrated_liquidity_price
+ * @param output_amount   Output: amounts of output token
+ * @param new_sqrt_price  Output: sqrt prices after each swap
+ * @param price_impact    Output: price impacts in percent
+ */
+void lx_concentrated_liquidity_price_batch(const double* liquidity,
+                                           const double* sqrt_price_current,
+                                           const double* sqrt_price_lower,
+                                           const double* sqrt_price_upper,
+                                           const double* amount_in,
+                                           const double* fee_rate,
+                                           bool is_token0_in,
+                                           double* output_amount,
+                                           double* new_sqrt_price,
+                                           double* price_impact,
+                                           size_t count);
+
+/**
+ * Historical volatility of several return series at once, as lx_volatility
+ * per series. Sums are vectorized, so results can differ from
+ * lx_volatility in the last bits.
+ * @param returns      Series stored one after another (series * count values)
+ * @param series       Number of series
+ * @param count        Returns per series
+ * @param annualize    Whether to annualize
+ * @param periods_per_year Periods per year
+ * @param out          Output: one volatility per series
+ */
+void lx_volatility_batch(const double* returns, size_t series, size_t count,
+                         bool annualize, int periods_per_year, double* out);
+
 #ifdef __cplusplus
 }
 #endif
@@ -17,7 +17,11 @@ extern "C" {
 /* ============================================================================
  * Orderbook
  * ============================================================================
- * Single-venue orderbook with thread-safe operations.
+ * Single-venue orderbook with thread-safe operations. Bids are kept
+ * highest first and asks lowest first: set_*, remove_* and apply_deltas
+ * binary-search and insert in place, so the best level is always at index
+ * 0. Only add_* appends; a level added out of order leaves that side
+ * unsorted (and searched linearly) until the next sort or apply_deltas.
  */
 
 typedef struct {
@@ -37,10 +41,22 @@ typedef struct {
     size_t ask_count;
     size_t ask_capacity;
 
+    /* False once add_* appends out of order */
+    bool bids_sorted;
+    bool asks_sorted;
+
     /* Thread safety */
     pthread_rwlock_t lock;
 } LxOrderbook;
 
+/* One level change for lx_orderbook_apply_deltas: a bid for LX_SIDE_BUY,
+ * an ask for LX_SIDE_SELL; zero quantity removes the level */
+typedef struct {
+    LxSide side;
+    LxDecimal price;
+    LxDecimal quantity;
+} LxBookDelta;
+
 /* ============================================================================
  * Orderbook Lifecycle
  * ============================================================================ */
@@ -68,11 +84,11 @@ uint64_t lx_orderbook_sequence(const LxOrderbook* book);
  * Orderbook Mutators (thread-safe writes)
  * ============================================================================ */
 
-/* Add a price level (appends to list) */
+/* Add a price level (appends to list; out of order leaves the side unsorted) */
 int lx_orderbook_add_bid(LxOrderbook* book, LxDecimal price, LxDecimal quantity);
 int lx_orderbook_add_ask(LxOrderbook* book, LxDecimal price, LxDecimal quantity);
 
-/* Set a price level (updates existing or adds new) */
+/* Set a price level (updates existing or inserts new in price order) */
 int lx_orderbook_set_bid(LxOrderbook* book, LxDecimal price, LxDecimal quantity);
 int lx_orderbook_set_ask(LxOrderbook* book, LxDecimal price, LxDecimal quantity);
 
@@ -83,7 +99,13 @@ void lx_orderbook_remove_ask(LxOrderbook* book, LxDecimal price);
 /* Clear all levels */
 void lx_orderbook_clear(LxOrderbook* book);
 
-/* Sort levels (bids descending, asks ascending) and update timestamp/sequence */
+/* Apply a batch of level changes under one lock, in order, and bump the
+ * sequence once. Sorts first if add_* left a side unsorted.
+ * Returns 0, or -1 if memory ran out (earlier deltas stay applied). */
+int lx_orderbook_apply_deltas(LxOrderbook* book, const LxBookDelta* deltas, size_t count);
+
+/* Sort levels (bids descending, asks ascending) and update timestamp/sequence;
+ * only needed after add_* */
 void lx_orderbook_sort(LxOrderbook* book);
 
 /* Set timestamp/sequence directly */
@@ -98,7 +120,7 @@ void lx_orderbook_set_sequence(LxOrderbook* book, uint64_t seq);
 LxPriceLevel* lx_orderbook_bids_copy(const LxOrderbook* book, size_t* count);
 LxPriceLevel* lx_orderbook_asks_copy(const LxOrderbook* book, size_t* count);
 
-/* Get best bid/ask (returns false if empty) */
+/* Get best bid/ask in O(1) (returns false if empty) */
 bool lx_orderbook_best_bid(const LxOrderbook* book, LxDecimal* price);
 bool lx_orderbook_best_ask(const LxOrderbook* book, LxDecimal* price);
 
@@ -3,10 +3,39 @@
  */
 
 #include "lx_trading/math.h"
+#include "math_simd.h"
 #include <math.h>
+#include <pthread.h>
 #include <stdlib.h>
 #include <string.h>
 
+/* ============================================================================
+ * Kernel Selection
+ * ============================================================================ */
+
+static const LxMathKernels* selected_kernels;
+static pthread_once_t kernels_once = PTHREAD_ONCE_INIT;
+
+static void select_kernels(void) {
+#if defined(LX_TRADING_C_HAVE_AVX2)
+    if (__builtin_cpu_supports("avx2") && __builtin_cpu_supports("fma")) {
+        selected_kernels = lx_math_avx2_kernels();
+        return;
+    }
+#endif
+#if defined(LX_TRADING_C_HAVE_SSE2)
+    selected_kernels = lx_math_sse2_kernels();
+#elif defined(LX_TRADING_C_HAVE_NEON)
+    selected_kernels = lx_math_neon_kernels();
+#endif
+}
+
+/* NULL when no vector kernel applies */
+static const LxMathKernels* kernels(void) {
+    pthread_once(&kernels_once, select_kernels);
+    return selected_kernels;
+}
+
 /* ============================================================================
  * Statistical Functions
  * ============================================================================ */
@@ -537,7 +566,10 @@ double lx_cvar(const double* returns, size_t count, double confidence) {
 size_t lx_calculate_returns(const double* prices, size_t price_count, double* returns) {
     if (!prices || !returns || price_count < 2) return 0;
 
-    for (size_t i = 1; i < price_count; i++) {
+    const LxMathKernels* k = kernels();
+    size_t done = k ? k->returns(prices, returns, price_count - 1) : 0;
+
+    for (size_t i = done + 1; i < price_count; i++) {
         if (prices[i - 1] != 0) {
             returns[i - 1] = (prices[i] - prices[i - 1]) / prices[i - 1];
         } else {
@@ -648,3 +680,122 @@ double lx_beta(const double* asset_returns, const double* market_returns, size_t
 
     return cov / var_market;
 }
+
+/* ============================================================================
+ * Batch Operations
+ * ============================================================================ */
+
+const char* lx_simd_isa(void) {
+    const LxMathKernels* k = kernels();
+    return k ? k->name : "scalar";
+}
+
+void lx_black_scholes_batch(const double* S, const double* K, const double* T,
+                            const double* r, const double* sigma,
+                            double* prices, size_t count, bool is_call) {
+    if (!S || !K || !T || !r || !sigma || !prices) return;
+
+    const LxMathKernels* k = kernels();
+    size_t i = k ? k->black_scholes(S, K, T, r, sigma, prices, count, is_call) : 0;
+
+    /* Remainder */
+    for (; i < count; i++) {
+        prices[i] = lx_black_scholes(S[i], K[i], T[i], r[i], sigma[i], is_call);
+    }
+}
+
+void lx_greeks_batch(const double* S, const double* K, const double* T,
+                     const double* r, const double* sigma,
+                     LxGreeks* out, size_t count, bool is_call) {
+    if (!S || !K || !T || !r || !sigma || !out) return;
+
+    const LxMathKernels* k = kernels();
+    size_t i = k ? k->greeks(S, K, T, r, sigma, out, count, is_call) : 0;
+
+    for (; i < count; i++) {
+        out[i] = lx_greeks(S[i], K[i], T[i], r[i], sigma[i], is_call);
+    }
+}
+
+void lx_constant_product_price_batch(const double* reserve_x, const double* reserve_y,
+                                     const double* amount_in, const double* fee_rate,
+                                     bool is_x_to_y,
+                                     double* output_amount, double* effective_price,
+                                     size_t count) {
+    if (!reserve_x || !reserve_y || !amount_in || !fee_rate) return;
+    if (!output_amount || !effective_price) return;
+
+    const double* input_reserve = is_x_to_y ? reserve_x : reserve_y;
+    const double* output_reserve = is_x_to_y ? reserve_y : reserve_x;
+
+    const LxMathKernels* k = kernels();
+    size_t i = k ? k->constant_product(input_reserve, output_reserve, amount_in, fee_rate,
+                                       output_amount, effective_price, count) : 0;
+
+    for (; i < count; i++) {
+        lx_constant_product_price(reserve_x[i], reserve_y[i], amount_in[i], fee_rate[i],
+                                  is_x_to_y, &output_amount[i], &effective_price[i]);
+    }
+}
+
+void lx_concentrated_liquidity_price_batch(const double* liquidity,
+                                           const double* sqrt_price_current,
+                                           const double* sqrt_price_lower,
+                                           const double* sqrt_price_upper,
+                                           const double* amount_in,
+                                           const double* fee_rate,
+                                           bool is_token0_in,
+                                           double* output_amount,
+                                           double* new_sqrt_price,
+                                           double* price_impact,
+                                           size_t count) {
+    if (!liquidity || !sqrt_price_current || !sqrt_price_lower || !sqrt_price_upper) return;
+    if (!amount_in || !fee_rate || !output_amount || !new_sqrt_price || !price_impact) return;
+
+    const LxMathKernels* k = kernels();
+    size_t i = k ? k->concentrated_liquidity(liquidity, sqrt_price_current,
+                                             sqrt_price_lower, sqrt_price_upper,
+                                             amount_in, fee_rate, is_token0_in,
+                                             output_amount, new_sqrt_price,
+                                             price_impact, count) : 0;
+
+    for (; i < count; i++) {
+        lx_concentrated_liquidity_price(liquidity[i], sqrt_price_current[i],
+                                        sqrt_price_lower[i], sqrt_price_upper[i],
+                                        amount_in[i], fee_rate[i], is_token0_in,
+                                        &output_amount[i], &new_sqrt_price[i],
+                                        &price_impact[i]);
+    }
+}
+
+void lx_volatility_batch(const double* returns, size_t series, size_t count,
+                         bool annualize, int periods_per_year, double* out) {
+    if (!returns || !out) return;
+
+    const LxMathKernels* k = kernels();
+    double scale = (annualize && periods_per_year > 0) ? sqrt((double)periods_per_year) : 1.0;
+
+    for (size_t s = 0; s < series; s++) {
+        if (count < 2) {
+            out[s] = 0;
+            continue;
+        }
+        const double* data = returns + s * count;
+
+        double sum = 0;
+        size_t i = k ? k->sum(data, count, &sum) : 0;
+        for (; i < count; i++) {
+            sum += data[i];
+        }
+        double mean = sum / (double)count;
+
+        double sum_sq = 0;
+        i = k ? k->sum_sq_dev(data, count, mean, &sum_sq) : 0;
+        for (; i < count; i++) {
+            double diff = data[i] - mean;
+            sum_sq += diff * diff;
+        }
+
+        out[s] = sqrt(sum_sq / (double)(count - 1)) * scale;
+    }
+}
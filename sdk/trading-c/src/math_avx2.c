@@ -0,0 +1,60 @@
+/**
+ * LX Trading SDK - AVX2 Math Kernels
+ * Built with -mavx2 -mfma and only reached through the runtime dispatch in
+ * math.c, after the CPU reports both features
+ */
+
+#include "math_simd.h"
+#include <immintrin.h>
+
+typedef __m256d lx_v;
+typedef __m256d lx_m;
+#define LX_SIMD_W 4
+#define LX_SIMD_NAME "avx2"
+
+static inline lx_v v_load(const double* p) { return _mm256_loadu_pd(p); }
+static inline void v_store(double* p, lx_v v) { _mm256_storeu_pd(p, v); }
+static inline lx_v v_set1(double x) { return _mm256_set1_pd(x); }
+
+static inline lx_v v_add(lx_v a, lx_v b) { return _mm256_add_pd(a, b); }
+static inline lx_v v_sub(lx_v a, lx_v b) { return _mm256_sub_pd(a, b); }
+static inline lx_v v_mul(lx_v a, lx_v b) { return _mm256_mul_pd(a, b); }
+static inline lx_v v_div(lx_v a, lx_v b) { return _mm256_div_pd(a, b); }
+static inline lx_v v_fma(lx_v a, lx_v b, lx_v c) { return _mm256_fmadd_pd(a, b, c); }
+static inline lx_v v_sqrt(lx_v a) { return _mm256_sqrt_pd(a); }
+static inline lx_v v_min(lx_v a, lx_v b) { return _mm256_min_pd(a, b); }
+static inline lx_v v_max(lx_v a, lx_v b) { return _mm256_max_pd(a, b); }
+static inline lx_v v_abs(lx_v a) { return _mm256_andnot_pd(_mm256_set1_pd(-0.0), a); }
+static inline lx_v v_round(lx_v a) {
+    return _mm256_round_pd(a, _MM_FROUND_TO_NEAREST_INT | _MM_FROUND_NO_EXC);
+}
+
+static inline lx_m v_lt(lx_v a, lx_v b) { return _mm256_cmp_pd(a, b, _CMP_LT_OQ); }
+static inline lx_m v_gt(lx_v a, lx_v b) { return _mm256_cmp_pd(a, b, _CMP_GT_OQ); }
+static inline lx_m v_eq(lx_v a, lx_v b) { return _mm256_cmp_pd(a, b, _CMP_EQ_OQ); }
+static inline lx_m m_and(lx_m a, lx_m b) { return _mm256_and_pd(a, b); }
+static inline lx_v v_select(lx_m m, lx_v a, lx_v b) { return _mm256_blendv_pd(b, a, m); }
+
+/* n + 1023 lands in the low mantissa bits after adding 2^52; shifting it
+ * into the exponent field gives 2^n */
+static inline lx_v v_pow2(lx_v n) {
+    __m256i bits = _mm256_castpd_si256(_mm256_add_pd(n, _mm256_set1_pd(4503599627371519.0)));
+    return _mm256_castsi256_pd(_mm256_slli_epi64(bits, 52));
+}
+
+static inline void v_split(lx_v x, lx_v* m, lx_v* e) {
+    __m256i bits = _mm256_castpd_si256(x);
+    __m256i biased = _mm256_or_si256(_mm256_srli_epi64(bits, 52),
+                                     _mm256_set1_epi64x(0x4330000000000000LL));
+    *e = _mm256_sub_pd(_mm256_castsi256_pd(biased), _mm256_set1_pd(4503599627371519.0));
+    __m256i mantissa = _mm256_or_si256(
+        _mm256_and_si256(bits, _mm256_set1_epi64x(0x000FFFFFFFFFFFFFLL)),
+        _mm256_set1_epi64x(0x3FF0000000000000LL));
+    *m = _mm256_castsi256_pd(mantissa);
+}
+
+#include "math_simd_impl.h"
+
+const LxMathKernels* lx_math_avx2_kernels(void) {
+    return &simd_kernels;
+}
@@ -0,0 +1,56 @@
+/**
+ * LX Trading SDK - NEON Math Kernels
+ * Advanced SIMD is part of the AArch64 baseline, so this file needs no
+ * extra flags and is used on every ARM64 host
+ */
+
+#include "math_simd.h"
+#include <arm_neon.h>
+
+typedef float64x2_t lx_v;
+typedef uint64x2_t lx_m;
+#define LX_SIMD_W 2
+#define LX_SIMD_NAME "neon"
+
+static inline lx_v v_load(const double* p) { return vld1q_f64(p); }
+static inline void v_store(double* p, lx_v v) { vst1q_f64(p, v); }
+static inline lx_v v_set1(double x) { return vdupq_n_f64(x); }
+
+static inline lx_v v_add(lx_v a, lx_v b) { return vaddq_f64(a, b); }
+static inline lx_v v_sub(lx_v a, lx_v b) { return vsubq_f64(a, b); }
+static inline lx_v v_mul(lx_v a, lx_v b) { return vmulq_f64(a, b); }
+static inline lx_v v_div(lx_v a, lx_v b) { return vdivq_f64(a, b); }
+static inline lx_v v_fma(lx_v a, lx_v b, lx_v c) { return vfmaq_f64(c, a, b); }
+static inline lx_v v_sqrt(lx_v a) { return vsqrtq_f64(a); }
+static inline lx_v v_min(lx_v a, lx_v b) { return vminq_f64(a, b); }
+static inline lx_v v_max(lx_v a, lx_v b) { return vmaxq_f64(a, b); }
+static inline lx_v v_abs(lx_v a) { return vabsq_f64(a); }
+static inline lx_v v_round(lx_v a) { return vrndnq_f64(a); }
+
+static inline lx_m v_lt(lx_v a, lx_v b) { return vcltq_f64(a, b); }
+static inline lx_m v_gt(lx_v a, lx_v b) { return vcgtq_f64(a, b); }
+static inline lx_m v_eq(lx_v a, lx_v b) { return vceqq_f64(a, b); }
+static inline lx_m m_and(lx_m a, lx_m b) { return vandq_u64(a, b); }
+static inline lx_v v_select(lx_m m, lx_v a, lx_v b) { return vbslq_f64(m, a, b); }
+
+/* n + 1023 lands in the low mantissa bits after adding 2^52; shifting it
+ * into the exponent field gives 2^n */
+static inline lx_v v_pow2(lx_v n) {
+    uint64x2_t bits = vreinterpretq_u64_f64(vaddq_f64(n, vdupq_n_f64(4503599627371519.0)));
+    return vreinterpretq_f64_u64(vshlq_n_u64(bits, 52));
+}
+
+static inline void v_split(lx_v x, lx_v* m, lx_v* e) {
+    uint64x2_t bits = vreinterpretq_u64_f64(x);
+    uint64x2_t biased = vorrq_u64(vshrq_n_u64(bits, 52), vdupq_n_u64(0x4330000000000000ULL));
+    *e = vsubq_f64(vreinterpretq_f64_u64(biased), vdupq_n_f64(4503599627371519.0));
+    uint64x2_t mantissa = vorrq_u64(vandq_u64(bits, vdupq_n_u64(0x000FFFFFFFFFFFFFULL)),
+                                    vdupq_n_u64(0x3FF0000000000000ULL));
+    *m = vreinterpretq_f64_u64(mantissa);
+}
+
+#include "math_simd_impl.h"
+
+const LxMathKernels* lx_math_neon_kernels(void) {
+    return &simd_kernels;
+}
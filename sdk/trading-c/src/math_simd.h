@@ -0,0 +1,54 @@
+/**
+ * LX Trading SDK - SIMD Math Kernels (private)
+ *
+ * The batch math is written once, in math_simd_impl.h, against a small set
+ * of vector operations, and compiled per instruction set in its own
+ * translation unit (math_sse2.c, math_avx2.c, math_neon.c) with the flags
+ * for that ISA. math.c picks a kernel table at runtime from the CPU's
+ * features, so one library runs on any x86-64 or ARM host.
+ *
+ * Each kernel processes whole vectors only and returns how many elements
+ * it did; math.c finishes the tail with the scalar functions.
+ */
+
+#ifndef LX_TRADING_MATH_SIMD_H
+#define LX_TRADING_MATH_SIMD_H
+
+#include "lx_trading/math.h"
+
+typedef struct {
+    const char* name;
+    size_t (*black_scholes)(const double* S, const double* K, const double* T,
+                            const double* r, const double* sigma,
+                            double* prices, size_t count, bool is_call);
+    size_t (*greeks)(const double* S, const double* K, const double* T,
+                     const double* r, const double* sigma,
+                     LxGreeks* out, size_t count, bool is_call);
+    /* Reserves already ordered input/output by the caller */
+    size_t (*constant_product)(const double* input_reserve, const double* output_reserve,
+                               const double* amount_in, const double* fee_rate,
+                               double* output_amount, double* effective_price,
+                               size_t count);
+    size_t (*concentrated_liquidity)(const double* liquidity,
+                                     const double* sqrt_price_current,
+                                     const double* sqrt_price_lower,
+                                     const double* sqrt_price_upper,
+                                     const double* amount_in,
+                                     const double* fee_rate,
+                                     bool is_token0_in,
+                                     double* output_amount,
+                                     double* new_sqrt_price,
+                                     double* price_impact,
+                                     size_t count);
+    /* count is the number of returns; prices holds count + 1 */
+    size_t (*returns)(const double* prices, double* returns, size_t count);
+    size_t (*sum)(const double* data, size_t count, double* total);
+    size_t (*sum_sq_dev)(const double* data, size_t count, double mean, double* total);
+} LxMathKernels;
+
+/* Defined only when the matching ISA file is built (see CMakeLists.txt) */
+const LxMathKernels* lx_math_sse2_kernels(void);
+const LxMathKernels* lx_math_avx2_kernels(void);
+const LxMathKernels* lx_math_neon_kernels(void);
+
+#endif /* LX_TRADING_MATH_SIMD_H */
@@ -0,0 +1,358 @@
+/**
+ * LX Trading SDK - SIMD Math Kernel Bodies (private)
+ *
+ * Included once by each ISA file after it defines, for a vector lx_v of
+ * LX_SIMD_W doubles and a lane mask lx_m:
+ *   v_load v_store v_set1 v_add v_sub v_mul v_div
+ *   v_fma(a, b, c) = a * b + c (fused where the ISA has it)
+ *   v_sqrt v_min v_max v_abs v_round (to nearest)
+ *   v_lt v_gt v_eq m_and  v_select(m, a, b) = m ? a : b
+ *   v_pow2(n)          2^n for integral n in [-1022, 1023]
+ *   v_split(x, m, e)   x = m * 2^e with m in [1, 2), for normal x > 0
+ * and LX_SIMD_NAME. Everything here is static, so code built with
+ * wide-ISA flags never has external linkage and leaks into baseline code.
+ *
+ * Vector exp/log differ from libm in the last few ulps, so Black-Scholes
+ * and Greeks can differ from the scalar functions at that level. The AMM
+ * quotes and returns follow the scalar operation order and differ at most
+ * by the compiler fusing a multiply-add.
+ */
+
+#ifndef LX_SIMD_W
+#error "math_simd_impl.h is included by an ISA file after its vector operations"
+#endif
+
+/* ============================================================================
+ * Elementary Functions
+ * ============================================================================ */
+
+/* e^x: x = n ln2 + r with |r| <= ln2 / 2, e^r by its degree-12 Taylor
+ * polynomial (error below 2e-16), scaled by 2^n */
+static inline lx_v simd_exp(lx_v x) {
+    x = v_min(v_max(x, v_set1(-708.0)), v_set1(708.0));
+
+    lx_v n = v_round(v_mul(x, v_set1(1.44269504088896340736)));
+    lx_v r = v_fma(n, v_set1(-6.93147180369123816490e-01), x);
+    r = v_fma(n, v_set1(-1.90821492927058770002e-10), r);
+
+    lx_v p = v_set1(1.0 / 479001600.0);
+    p = v_fma(p, r, v_set1(1.0 / 39916800.0));
+    p = v_fma(p, r, v_set1(1.0 / 3628800.0));
+    p = v_fma(p, r, v_set1(1.0 / 362880.0));
+    p = v_fma(p, r, v_set1(1.0 / 40320.0));
+    p = v_fma(p, r, v_set1(1.0 / 5040.0));
+    p = v_fma(p, r, v_set1(1.0 / 720.0));
+    p = v_fma(p, r, v_set1(1.0 / 120.0));
+    p = v_fma(p, r, v_set1(1.0 / 24.0));
+    p = v_fma(p, r, v_set1(1.0 / 6.0));
+    p = v_fma(p, r, v_set1(0.5));
+    p = v_fma(p, r, v_set1(1.0));
+    p = v_fma(p, r, v_set1(1.0));
+
+    return v_mul(p, v_pow2(n));
+}
+
+/* ln(x) for normal x > 0: x = m 2^e with m in [sqrt(1/2), sqrt(2)), then
+ * ln(m) = 2 atanh(s) with s = (m - 1) / (m + 1), |s| < 0.172, summed to s^21 */
+static inline lx_v simd_log(lx_v x) {
+    lx_v m, e;
+    v_split(x, &m, &e);
+
+    lx_m high = v_gt(m, v_set1(LX_MATH_SQRT_2));
+    m = v_select(high, v_mul(m, v_set1(0.5)), m);
+    e = v_select(high, v_add(e, v_set1(1.0)), e);
+
+    lx_v s = v_div(v_sub(m, v_set1(1.0)), v_add(m, v_set1(1.0)));
+    lx_v z = v_mul(s, s);
+
+    lx_v p = v_set1(1.0 / 21.0);
+    p = v_fma(p, z, v_set1(1.0 / 19.0));
+    p = v_fma(p, z, v_set1(1.0 / 17.0));
+    p = v_fma(p, z, v_set1(1.0 / 15.0));
+    p = v_fma(p, z, v_set1(1.0 / 13.0));
+    p = v_fma(p, z, v_set1(1.0 / 11.0));
+    p = v_fma(p, z, v_set1(1.0 / 9.0));
+    p = v_fma(p, z, v_set1(1.0 / 7.0));
+    p = v_fma(p, z, v_set1(1.0 / 5.0));
+    p = v_fma(p, z, v_set1(1.0 / 3.0));
+    p = v_fma(p, z, v_set1(1.0));
+
+    lx_v ln_m = v_mul(v_add(s, s), p);
+    return v_fma(e, v_set1(0.69314718055994530942), ln_m);
+}
+
+/* Same Abramowitz & Stegun approximation as lx_norm_cdf */
+static inline lx_v simd_norm_cdf(lx_v x) {
+    lx_v ax = v_mul(v_abs(x), v_set1(1.0 / LX_MATH_SQRT_2));
+    lx_v t = v_div(v_set1(1.0), v_fma(v_set1(0.3275911), ax, v_set1(1.0)));
+
+    lx_v p = v_set1(1.061405429);
+    p = v_fma(p, t, v_set1(-1.453152027));
+    p = v_fma(p, t, v_set1(1.421413741));
+    p = v_fma(p, t, v_set1(-0.284496736));
+    p = v_fma(p, t, v_set1(0.254829592));
+    p = v_mul(p, t);
+
+    lx_v y = v_sub(v_set1(1.0), v_mul(p, simd_exp(v_sub(v_set1(0.0), v_mul(ax, ax)))));
+    lx_v signed_y = v_select(v_lt(x, v_set1(0.0)), v_sub(v_set1(0.0), y), y);
+    return v_mul(v_set1(0.5), v_add(v_set1(1.0), signed_y));
+}
+
+static inline lx_v simd_norm_pdf(lx_v x) {
+    return v_mul(simd_exp(v_mul(v_set1(-0.5), v_mul(x, x))), v_set1(1.0 / LX_MATH_SQRT_2PI));
+}
+
+/* ============================================================================
+ * Black-Scholes
+ * ============================================================================ */
+
+/* d1, d2 and the discount factor for one vector of options. Lanes the
+ * scalar functions treat specially (T <= 0, or S, K or sigma <= 0) are
+ * computed with all inputs 1 to stay finite; callers mask them out. */
+typedef struct {
+    lx_m live;          /* T > 0 */
+    lx_m valid;         /* S, K and sigma > 0 */
+    lx_v S;
+    lx_v K;
+    lx_v T;
+    lx_v sigma;
+    lx_v sqrt_T;
+    lx_v d1;
+    lx_v d2;
+    lx_v discount;      /* e^(-rT) */
+} SimdTerms;
+
+static inline SimdTerms simd_terms(lx_v S, lx_v K, lx_v T, lx_v r, lx_v sigma) {
+    SimdTerms t;
+    lx_v zero = v_set1(0.0);
+    lx_v one = v_set1(1.0);
+    t.live = v_gt(T, zero);
+    t.valid = m_and(m_and(v_gt(S, zero), v_gt(K, zero)), v_gt(sigma, zero));
+
+    lx_m ok = m_and(t.live, t.valid);
+    t.S = v_select(ok, S, one);
+    t.K = v_select(ok, K, one);
+    t.T = v_select(ok, T, one);
+    t.sigma = v_select(ok, sigma, one);
+
+    t.sqrt_T = v_sqrt(t.T);
+    lx_v sig_sqrt_T = v_mul(t.sigma, t.sqrt_T);
+    lx_v drift = v_fma(v_mul(v_set1(0.5), t.sigma), t.sigma, r);
+    t.d1 = v_div(v_fma(drift, t.T, simd_log(v_div(t.S, t.K))), sig_sqrt_T);
+    t.d2 = v_sub(t.d1, sig_sqrt_T);
+    t.discount = simd_exp(v_sub(zero, v_mul(r, t.T)));
+    return t;
+}
+
+static size_t simd_black_scholes(const double* S, const double* K, const double* T,
+                                 const double* r, const double* sigma,
+                                 double* prices, size_t count, bool is_call) {
+    lx_v zero = v_set1(0.0);
+    size_t i = 0;
+
+    for (; i + LX_SIMD_W <= count; i += LX_SIMD_W) {
+        lx_v vS = v_load(S + i);
+        lx_v vK = v_load(K + i);
+        SimdTerms t = simd_terms(vS, vK, v_load(T + i), v_load(r + i), v_load(sigma + i));
+        lx_v K_disc = v_mul(t.K, t.discount);
+
+        lx_v value, intrinsic;
+        if (is_call) {
+            value = v_sub(v_mul(t.S, simd_norm_cdf(t.d1)), v_mul(K_disc, simd_norm_cdf(t.d2)));
+            intrinsic = v_max(v_sub(vS, vK), zero);
+        } else {
+            value = v_sub(v_mul(K_disc, simd_norm_cdf(v_sub(zero, t.d2))),
+                          v_mul(t.S, simd_norm_cdf(v_sub(zero, t.d1))));
+            intrinsic = v_max(v_sub(vK, vS), zero);
+        }
+        value = v_select(t.valid, value, zero);
+        v_store(prices + i, v_select(t.live, value, intrinsic));
+    }
+    return i;
+}
+
+/* Mirrors lx_greeks: theta per day, vega and rho per 1%, all zero at or
+ * past expiry or for non-positive inputs */
+static size_t simd_greeks(const double* S, const double* K, const double* T,
+                          const double* r, const double* sigma,
+                          LxGreeks* out, size_t count, bool is_call) {
+    lx_v zero = v_set1(0.0);
+    double delta[LX_SIMD_W], gamma[LX_SIMD_W], theta[LX_SIMD_W];
+    double vega[LX_SIMD_W], rho[LX_SIMD_W];
+    size_t i = 0;
+
+    for (; i + LX_SIMD_W <= count; i += LX_SIMD_W) {
+        lx_v vr = v_load(r + i);
+        SimdTerms t = simd_terms(v_load(S + i), v_load(K + i), v_load(T + i),
+                                 vr, v_load(sigma + i));
+        lx_m ok = m_and(t.live, t.valid);
+
+        lx_v pdf_d1 = simd_norm_pdf(t.d1);
+        lx_v K_disc = v_mul(t.K, t.discount);
+        /* -S pdf(d1) sigma / (2 sqrt(T)) */
+        lx_v decay = v_div(v_mul(v_mul(v_sub(zero, t.S), pdf_d1), t.sigma),
+                           v_add(t.sqrt_T, t.sqrt_T));
+
+        lx_v vdelta, vtheta, vrho;
+        if (is_call) {
+            lx_v cdf_d2 = simd_norm_cdf(t.d2);
+            vdelta = simd_norm_cdf(t.d1);
+            vtheta = v_sub(decay, v_mul(v_mul(vr, K_disc), cdf_d2));
+            vrho = v_mul(v_mul(v_mul(K_disc, t.T), cdf_d2), v_set1(0.01));
+        } else {
+            lx_v cdf_neg_d2 = simd_norm_cdf(v_sub(zero, t.d2));
+            vdelta = v_sub(simd_norm_cdf(t.d1), v_set1(1.0));
+            vtheta = v_fma(v_mul(vr, K_disc), cdf_neg_d2, decay);
+            vrho = v_mul(v_mul(v_mul(K_disc, t.T), cdf_neg_d2), v_set1(-0.01));
+        }
+        lx_v vgamma = v_div(pdf_d1, v_mul(v_mul(t.S, t.sigma), t.sqrt_T));
+        lx_v vvega = v_mul(v_mul(v_mul(t.S, pdf_d1), t.sqrt_T), v_set1(0.01));
+        vtheta = v_div(vtheta, v_set1(365.0));
+
+        v_store(delta, v_select(ok, vdelta, zero));
+        v_store(gamma, v_select(ok, vgamma, zero));
+        v_store(theta, v_select(ok, vtheta, zero));
+        v_store(vega, v_select(ok, vvega, zero));
+        v_store(rho, v_select(ok, vrho, zero));
+        for (size_t j = 0; j < LX_SIMD_W; j++) {
+            out[i + j].delta = delta[j];
+            out[i + j].gamma = gamma[j];
+            out[i + j].theta = theta[j];
+            out[i + j].vega = vega[j];
+            out[i + j].rho = rho[j];
+        }
+    }
+    return i;
+}
+
+/* ============================================================================
+ * AMM Pricing
+ * ============================================================================ */
+
+static size_t simd_constant_product(const double* input_reserve, const double* output_reserve,
+                                    const double* amount_in, const double* fee_rate,
+                                    double* output_amount, double* effective_price,
+                                    size_t count) {
+    lx_v zero = v_set1(0.0);
+    size_t i = 0;
+
+    for (; i + LX_SIMD_W <= count; i += LX_SIMD_W) {
+        lx_v in_res = v_load(input_reserve + i);
+        lx_v out_res = v_load(output_reserve + i);
+        lx_v amount = v_load(amount_in + i);
+        lx_m valid = m_and(m_and(v_gt(in_res, zero), v_gt(out_res, zero)), v_gt(amount, zero));
+
+        lx_v with_fee = v_mul(amount, v_sub(v_set1(1.0), v_load(fee_rate + i)));
+        lx_v k = v_mul(in_res, out_res);
+        lx_v out = v_sub(out_res, v_div(k, v_add(in_res, with_fee)));
+        lx_v price = v_select(v_gt(out, zero), v_div(out, amount), zero);
+
+        v_store(output_amount + i, v_select(valid, out, zero));
+        v_store(effective_price + i, v_select(valid, price, zero));
+    }
+    return i;
+}
+
+static size_t simd_concentrated_liquidity(const double* liquidity,
+                                          const double* sqrt_price_current,
+                                          const double* sqrt_price_lower,
+                                          const double* sqrt_price_upper,
+                                          const double* amount_in,
+                                          const double* fee_rate,
+                                          bool is_token0_in,
+                                          double* output_amount,
+                                          double* new_sqrt_price,
+                                          double* price_impact,
+                                          size_t count) {
+    lx_v zero = v_set1(0.0);
+    lx_v one = v_set1(1.0);
+    size_t i = 0;
+
+    for (; i + LX_SIMD_W <= count; i += LX_SIMD_W) {
+        lx_v L = v_load(liquidity + i);
+        lx_v sp = v_load(sqrt_price_current + i);
+        lx_v amount = v_load(amount_in + i);
+        lx_m valid = m_and(m_and(v_gt(L, zero), v_gt(amount, zero)), v_gt(sp, zero));
+
+        lx_v step = v_div(v_mul(amount, v_sub(one, v_load(fee_rate + i))), L);
+        lx_v new_sp, out;
+        if (is_token0_in) {
+            /* Price rises, capped at the upper bound */
+            new_sp = v_min(v_add(sp, step), v_load(sqrt_price_upper + i));
+            out = v_mul(L, v_sub(new_sp, sp));
+        } else {
+            /* Price falls, floored at the lower bound */
+            new_sp = v_max(v_sub(sp, v_div(step, sp)), v_load(sqrt_price_lower + i));
+            out = v_abs(v_mul(L, v_sub(v_div(one, new_sp), v_div(one, sp))));
+        }
+
+        lx_v initial = v_mul(sp, sp);
+        lx_v impact = v_mul(v_div(v_abs(v_sub(v_mul(new_sp, new_sp), initial)), initial),
+                            v_set1(100.0));
+        impact = v_select(v_gt(initial, zero), impact, zero);
+
+        v_store(output_amount + i, v_select(valid, out, zero));
+        v_store(new_sqrt_price + i, v_select(valid, new_sp, sp));
+        v_store(price_impact + i, v_select(valid, impact, zero));
+    }
+    return i;
+}
+
+/* ============================================================================
+ * Returns and Reductions
+ * ============================================================================ */
+
+static size_t simd_returns(const double* prices, double* returns, size_t count) {
+    lx_v zero = v_set1(0.0);
+    size_t i = 0;
+
+    for (; i + LX_SIMD_W <= count; i += LX_SIMD_W) {
+        lx_v prev = v_load(prices + i);
+        lx_v ret = v_div(v_sub(v_load(prices + i + 1), prev), prev);
+        v_store(returns + i, v_select(v_eq(prev, zero), zero, ret));
+    }
+    return i;
+}
+
+static inline double simd_horizontal_sum(lx_v v) {
+    double lanes[LX_SIMD_W];
+    v_store(lanes, v);
+    double total = 0;
+    for (size_t j = 0; j < LX_SIMD_W; j++) {
+        total += lanes[j];
+    }
+    return total;
+}
+
+static size_t simd_sum(const double* data, size_t count, double* total) {
+    lx_v acc = v_set1(0.0);
+    size_t i = 0;
+    for (; i + LX_SIMD_W <= count; i += LX_SIMD_W) {
+        acc = v_add(acc, v_load(data + i));
+    }
+    *total = simd_horizontal_sum(acc);
+    return i;
+}
+
+static size_t simd_sum_sq_dev(const double* data, size_t count, double mean, double* total) {
+    lx_v vmean = v_set1(mean);
+    lx_v acc = v_set1(0.0);
+    size_t i = 0;
+    for (; i + LX_SIMD_W <= count; i += LX_SIMD_W) {
+        lx_v diff = v_sub(v_load(data + i), vmean);
+        acc = v_fma(diff, diff, acc);
+    }
+    *total = simd_horizontal_sum(acc);
+    return i;
+}
+
+static const LxMathKernels simd_kernels = {
+    LX_SIMD_NAME,
+    simd_black_scholes,
+    simd_greeks,
+    simd_constant_product,
+    simd_concentrated_liquidity,
+    simd_returns,
+    simd_sum,
+    simd_sum_sq_dev,
+};
@@ -0,0 +1,66 @@
+/**
+ * LX Trading SDK - SSE2 Math Kernels
+ * SSE2 is part of the x86-64 baseline, so this file needs no extra flags
+ * and is the fallback on x86-64 CPUs without AVX2 and FMA. SSE2 has no
+ * fused multiply-add, blend or rounding instruction; they are emulated.
+ */
+
+#include "math_simd.h"
+#include <emmintrin.h>
+
+typedef __m128d lx_v;
+typedef __m128d lx_m;
+#define LX_SIMD_W 2
+#define LX_SIMD_NAME "sse2"
+
+static inline lx_v v_load(const double* p) { return _mm_loadu_pd(p); }
+static inline void v_store(double* p, lx_v v) { _mm_storeu_pd(p, v); }
+static inline lx_v v_set1(double x) { return _mm_set1_pd(x); }
+
+static inline lx_v v_add(lx_v a, lx_v b) { return _mm_add_pd(a, b); }
+static inline lx_v v_sub(lx_v a, lx_v b) { return _mm_sub_pd(a, b); }
+static inline lx_v v_mul(lx_v a, lx_v b) { return _mm_mul_pd(a, b); }
+static inline lx_v v_div(lx_v a, lx_v b) { return _mm_div_pd(a, b); }
+static inline lx_v v_fma(lx_v a, lx_v b, lx_v c) { return _mm_add_pd(_mm_mul_pd(a, b), c); }
+static inline lx_v v_sqrt(lx_v a) { return _mm_sqrt_pd(a); }
+static inline lx_v v_min(lx_v a, lx_v b) { return _mm_min_pd(a, b); }
+static inline lx_v v_max(lx_v a, lx_v b) { return _mm_max_pd(a, b); }
+static inline lx_v v_abs(lx_v a) { return _mm_andnot_pd(_mm_set1_pd(-0.0), a); }
+
+/* Adding and removing 1.5 * 2^52 rounds to nearest for |a| < 2^51; only
+ * used on exp's argument, which is clamped well inside that */
+static inline lx_v v_round(lx_v a) {
+    const __m128d shift = _mm_set1_pd(6755399441055744.0);
+    return _mm_sub_pd(_mm_add_pd(a, shift), shift);
+}
+
+static inline lx_m v_lt(lx_v a, lx_v b) { return _mm_cmplt_pd(a, b); }
+static inline lx_m v_gt(lx_v a, lx_v b) { return _mm_cmpgt_pd(a, b); }
+static inline lx_m v_eq(lx_v a, lx_v b) { return _mm_cmpeq_pd(a, b); }
+static inline lx_m m_and(lx_m a, lx_m b) { return _mm_and_pd(a, b); }
+static inline lx_v v_select(lx_m m, lx_v a, lx_v b) {
+    return _mm_or_pd(_mm_and_pd(m, a), _mm_andnot_pd(m, b));
+}
+
+/* n + 1023 lands in the low mantissa bits after adding 2^52; shifting it
+ * into the exponent field gives 2^n */
+static inline lx_v v_pow2(lx_v n) {
+    __m128i bits = _mm_castpd_si128(_mm_add_pd(n, _mm_set1_pd(4503599627371519.0)));
+    return _mm_castsi128_pd(_mm_slli_epi64(bits, 52));
+}
+
+static inline void v_split(lx_v x, lx_v* m, lx_v* e) {
+    __m128i bits = _mm_castpd_si128(x);
+    __m128i biased = _mm_or_si128(_mm_srli_epi64(bits, 52),
+                                  _mm_set1_epi64x(0x4330000000000000LL));
+    *e = _mm_sub_pd(_mm_castsi128_pd(biased), _mm_set1_pd(4503599627371519.0));
+    __m128i mantissa = _mm_or_si128(_mm_and_si128(bits, _mm_set1_epi64x(0x000FFFFFFFFFFFFFLL)),
+                                    _mm_set1_epi64x(0x3FF0000000000000LL));
+    *m = _mm_castsi128_pd(mantissa);
+}
+
+#include "math_simd_impl.h"
+
+const LxMathKernels* lx_math_sse2_kernels(void) {
+    return &simd_kernels;
+}
@@ -12,36 +12,131 @@
  * Helper Functions
  * ============================================================================ */
 
-static int ensure_bid_capacity(LxOrderbook* book, size_t required) {
-    if (book->bid_capacity >= required) return 0;
+static int ensure_capacity(LxPriceLevel** levels, size_t* capacity, size_t required) {
+    if (*capacity >= required) return 0;
 
-    size_t new_capacity = book->bid_capacity * 2;
+    size_t new_capacity = *capacity * 2;
     if (new_capacity < required) new_capacity = required;
     if (new_capacity < INITIAL_CAPACITY) new_capacity = INITIAL_CAPACITY;
 
-    LxPriceLevel* new_bids = realloc(book->bids, new_capacity * sizeof(LxPriceLevel));
-    if (!new_bids) return -1;
+    LxPriceLevel* new_levels = realloc(*levels, new_capacity * sizeof(LxPriceLevel));
+    if (!new_levels) return -1;
 
-    book->bids = new_bids;
-    book->bid_capacity = new_capacity;
+    *levels = new_levels;
+    *capacity = new_capacity;
     return 0;
 }
 
-static int ensure_ask_capacity(LxOrderbook* book, size_t required) {
-    if (book->ask_capacity >= required) return 0;
+/* One side of the book: bids keep best (highest) first, asks lowest first */
+typedef struct {
+    LxPriceLevel** levels;
+    size_t* count;
+    size_t* capacity;
+    bool* sorted;
+    bool descending;
+} BookSide;
+
+static BookSide bid_side(LxOrderbook* book) {
+    BookSide side = {&book->bids, &book->bid_count, &book->bid_capacity, &book->bids_sorted, true};
+    return side;
+}
 
-    size_t new_capacity = book->ask_capacity * 2;
-    if (new_capacity < required) new_capacity = required;
-    if (new_capacity < INITIAL_CAPACITY) new_capacity = INITIAL_CAPACITY;
+static BookSide ask_side(LxOrderbook* book) {
+    BookSide side = {&book->asks, &book->ask_count, &book->ask_capacity, &book->asks_sorted, false};
+    return side;
+}
 
-    LxPriceLevel* new_asks = realloc(book->asks, new_capacity * sizeof(LxPriceLevel));
-    if (!new_asks) return -1;
+/* Whether a level at `a` sorts before one at `b` */
+static inline bool sorts_before(const BookSide* side, LxDecimal a, LxDecimal b) {
+    return side->descending ? a.value > b.value : a.value < b.value;
+}
+
+/* Index of the level at `price`, or where it would be inserted, in a
+ * sorted side; sets *found when the level exists */
+static size_t side_search(const BookSide* side, LxDecimal price, bool* found) {
+    const LxPriceLevel* levels = *side->levels;
+    size_t lo = 0;
+    size_t hi = *side->count;
+    while (lo < hi) {
+        size_t mid = lo + (hi - lo) / 2;
+        if (sorts_before(side, levels[mid].price, price)) {
+            lo = mid + 1;
+        } else {
+            hi = mid;
+        }
+    }
+    *found = lo < *side->count && levels[lo].price.value == price.value;
+    return lo;
+}
+
+/* Index of the level at `price` in an unsorted side, or the count */
+static size_t side_scan(const BookSide* side, LxDecimal price) {
+    size_t i = 0;
+    while (i < *side->count && !lx_decimal_eq((*side->levels)[i].price, price)) {
+        i++;
+    }
+    return i;
+}
+
+static int side_append(BookSide* side, LxDecimal price, LxDecimal quantity) {
+    if (ensure_capacity(side->levels, side->capacity, *side->count + 1) != 0) {
+        return -1;
+    }
 
-    book->asks = new_asks;
-    book->ask_capacity = new_capacity;
+    size_t count = *side->count;
+    if (count > 0 && !sorts_before(side, (*side->levels)[count - 1].price, price)) {
+        *side->sorted = false;
+    }
+    (*side->levels)[count].price = price;
+    (*side->levels)[count].quantity = quantity;
+    *side->count = count + 1;
     return 0;
 }
 
+static int side_set(BookSide* side, LxDecimal price, LxDecimal quantity) {
+    if (!*side->sorted) {
+        size_t i = side_scan(side, price);
+        if (i < *side->count) {
+            (*side->levels)[i].quantity = quantity;
+            return 0;
+        }
+        return side_append(side, price, quantity);
+    }
+
+    bool found;
+    size_t i = side_search(side, price, &found);
+    if (found) {
+        (*side->levels)[i].quantity = quantity;
+        return 0;
+    }
+
+    if (ensure_capacity(side->levels, side->capacity, *side->count + 1) != 0) {
+        return -1;
+    }
+    LxPriceLevel* levels = *side->levels;
+    memmove(&levels[i + 1], &levels[i], (*side->count - i) * sizeof(LxPriceLevel));
+    levels[i].price = price;
+    levels[i].quantity = quantity;
+    (*side->count)++;
+    return 0;
+}
+
+static void side_remove(BookSide* side, LxDecimal price) {
+    size_t i;
+    if (*side->sorted) {
+        bool found;
+        i = side_search(side, price, &found);
+        if (!found) return;
+    } else {
+        i = side_scan(side, price);
+        if (i == *side->count) return;
+    }
+
+    memmove(&(*side->levels)[i], &(*side->levels)[i + 1],
+            (*side->count - i - 1) * sizeof(LxPriceLevel));
+    (*side->count)--;
+}
+
 static int compare_bids_desc(const void* a, const void* b) {
     const LxPriceLevel* la = (const LxPriceLevel*)a;
     const LxPriceLevel* lb = (const LxPriceLevel*)b;
@@ -58,6 +153,18 @@ static int compare_asks_asc(const void* a, const void* b) {
     return 0;
 }
 
+/* Sort whichever sides add_* left out of order (caller holds the write lock) */
+static void sort_sides(LxOrderbook* book) {
+    if (!book->bids_sorted && book->bid_count > 1) {
+        qsort(book->bids, book->bid_count, sizeof(LxPriceLevel), compare_bids_desc);
+    }
+    if (!book->asks_sorted && book->ask_count > 1) {
+        qsort(book->asks, book->ask_count, sizeof(LxPriceLevel), compare_asks_asc);
+    }
+    book->bids_sorted = true;
+    book->asks_sorted = true;
+}
+
 static LxDecimal calculate_vwap(const LxPriceLevel* levels, size_t count, LxDecimal amount) {
     LxDecimal remaining = amount;
     LxDecimal total_value = lx_decimal_zero();
@@ -96,6 +203,8 @@ int lx_orderbook_init(LxOrderbook* book, const char* symbol, const char* venue)
 
     atomic_store(&book->timestamp, lx_now_ms());
     atomic_store(&book->sequence, 0);
+    book->bids_sorted = true;
+    book->asks_sorted = true;
 
     if (pthread_rwlock_init(&book->lock, NULL) != 0) {
         return -1;
@@ -118,6 +227,8 @@ void lx_orderbook_cleanup(LxOrderbook* book) {
     book->ask_count = 0;
     book->bid_capacity = 0;
     book->ask_capacity = 0;
+    book->bids_sorted = true;
+    book->asks_sorted = true;
 }
 
 LxOrderbook* lx_orderbook_create(const char* symbol, const char* venue) {
@@ -166,109 +277,48 @@ int lx_orderbook_add_bid(LxOrderbook* book, LxDecimal price, LxDecimal quantity)
     if (!book) return -1;
 
     pthread_rwlock_wrlock(&book->lock);
-
-    if (ensure_bid_capacity(book, book->bid_count + 1) != 0) {
-        pthread_rwlock_unlock(&book->lock);
-        return -1;
-    }
-
-    book->bids[book->bid_count].price = price;
-    book->bids[book->bid_count].quantity = quantity;
-    book->bid_count++;
-
+    BookSide side = bid_side(book);
+    int result = side_append(&side, price, quantity);
     pthread_rwlock_unlock(&book->lock);
-    return 0;
+    return result;
 }
 
 int lx_orderbook_add_ask(LxOrderbook* book, LxDecimal price, LxDecimal quantity) {
     if (!book) return -1;
 
     pthread_rwlock_wrlock(&book->lock);
-
-    if (ensure_ask_capacity(book, book->ask_count + 1) != 0) {
-        pthread_rwlock_unlock(&book->lock);
-        return -1;
-    }
-
-    book->asks[book->ask_count].price = price;
-    book->asks[book->ask_count].quantity = quantity;
-    book->ask_count++;
-
+    BookSide side = ask_side(book);
+    int result = side_append(&side, price, quantity);
     pthread_rwlock_unlock(&book->lock);
-    return 0;
+    return result;
 }
 
 int lx_orderbook_set_bid(LxOrderbook* book, LxDecimal price, LxDecimal quantity) {
     if (!book) return -1;
 
     pthread_rwlock_wrlock(&book->lock);
-
-    /* Find existing level */
-    for (size_t i = 0; i < book->bid_count; i++) {
-        if (lx_decimal_eq(book->bids[i].price, price)) {
-            book->bids[i].quantity = quantity;
-            pthread_rwlock_unlock(&book->lock);
-            return 0;
-        }
-    }
-
-    /* Add new level */
-    if (ensure_bid_capacity(book, book->bid_count + 1) != 0) {
-        pthread_rwlock_unlock(&book->lock);
-        return -1;
-    }
-
-    book->bids[book->bid_count].price = price;
-    book->bids[book->bid_count].quantity = quantity;
-    book->bid_count++;
-
+    BookSide side = bid_side(book);
+    int result = side_set(&side, price, quantity);
     pthread_rwlock_unlock(&book->lock);
-    return 0;
+    return result;
 }
 
 int lx_orderbook_set_ask(LxOrderbook* book, LxDecimal price, LxDecimal quantity) {
     if (!book) return -1;
 
     pthread_rwlock_wrlock(&book->lock);
-
-    /* Find existing level */
-    for (size_t i = 0; i < book->ask_count; i++) {
-        if (lx_decimal_eq(book->asks[i].price, price)) {
-            book->asks[i].quantity = quantity;
-            pthread_rwlock_unlock(&book->lock);
-            return 0;
-        }
-    }
-
-    /* Add new level */
-    if (ensure_ask_capacity(book, book->ask_count + 1) != 0) {
-        pthread_rwlock_unlock(&book->lock);
-        return -1;
-    }
-
-    book->asks[book->ask_count].price = price;
-    book->asks[book->ask_count].quantity = quantity;
-    book->ask_count++;
-
+    BookSide side = ask_side(book);
+    int result = side_set(&side, price, quantity);
     pthread_rwlock_unlock(&book->lock);
-    return 0;
+    return result;
 }
 
 void lx_orderbook_remove_bid(LxOrderbook* book, LxDecimal price) {
     if (!book) return;
 
     pthread_rwlock_wrlock(&book->lock);
-
-    for (size_t i = 0; i < book->bid_count; i++) {
-        if (lx_decimal_eq(book->bids[i].price, price)) {
-            /* Shift remaining elements */
-            memmove(&book->bids[i], &book->bids[i + 1],
-                    (book->bid_count - i - 1) * sizeof(LxPriceLevel));
-            book->bid_count--;
-            break;
-        }
-    }
-
+    BookSide side = bid_side(book);
+    side_remove(&side, price);
     pthread_rwlock_unlock(&book->lock);
 }
 
@@ -276,17 +326,38 @@ void lx_orderbook_remove_ask(LxOrderbook* book, LxDecimal price) {
     if (!book) return;
 
     pthread_rwlock_wrlock(&book->lock);
+    BookSide side = ask_side(book);
+    side_remove(&side, price);
+    pthread_rwlock_unlock(&book->lock);
+}
 
-    for (size_t i = 0; i < book->ask_count; i++) {
-        if (lx_decimal_eq(book->asks[i].price, price)) {
-            memmove(&book->asks[i], &book->asks[i + 1],
-                    (book->ask_count - i - 1) * sizeof(LxPriceLevel));
-            book->ask_count--;
+int lx_orderbook_apply_deltas(LxOrderbook* book, const LxBookDelta* deltas, size_t count) {
+    if (!book || (!deltas && count > 0)) return -1;
+
+    pthread_rwlock_wrlock(&book->lock);
+
+    /* Levels appended out of order are sorted once, so every delta below
+     * is a binary search */
+    sort_sides(book);
+
+    BookSide bids = bid_side(book);
+    BookSide asks = ask_side(book);
+    int result = 0;
+    for (size_t i = 0; i < count; i++) {
+        BookSide* side = deltas[i].side == LX_SIDE_BUY ? &bids : &asks;
+        if (deltas[i].quantity.value <= 0) {
+            side_remove(side, deltas[i].price);
+        } else if (side_set(side, deltas[i].price, deltas[i].quantity) != 0) {
+            result = -1;
             break;
         }
     }
 
+    atomic_fetch_add(&book->sequence, 1);
+    atomic_store(&book->timestamp, lx_now_ms());
+
     pthread_rwlock_unlock(&book->lock);
+    return result;
 }
 
 void lx_orderbook_clear(LxOrderbook* book) {
@@ -295,6 +366,8 @@ void lx_orderbook_clear(LxOrderbook* book) {
     pthread_rwlock_wrlock(&book->lock);
     book->bid_count = 0;
     book->ask_count = 0;
+    book->bids_sorted = true;
+    book->asks_sorted = true;
     pthread_rwlock_unlock(&book->lock);
 }
 
@@ -303,12 +376,7 @@ void lx_orderbook_sort(LxOrderbook* book) {
 
     pthread_rwlock_wrlock(&book->lock);
 
-    if (book->bid_count > 1) {
-        qsort(book->bids, book->bid_count, sizeof(LxPriceLevel), compare_bids_desc);
-    }
-    if (book->ask_count > 1) {
-        qsort(book->asks, book->ask_count, sizeof(LxPriceLevel), compare_asks_asc);
-    }
+    sort_sides(book);
 
     atomic_fetch_add(&book->sequence, 1);
     atomic_store(&book->timestamp, lx_now_ms());
@@ -9,6 +9,7 @@
 #include <memory>
 #include <set>
 #include <string>
+#include <utility>
 #include <vector>
 
 namespace lx::trading {
@@ -122,6 +123,23 @@ public:
     virtual std::future<std::vector<Order>> cancel_all_orders(
         const std::optional<std::string>& symbol = std::nullopt) = 0;
 
+    // Batches: one future per item, in request order, each settling (or
+    // failing) on its own. The defaults issue the single calls back to
+    // back, which adapters on a pooled transport keep in flight together;
+    // adapters whose venue takes batches send up to
+    // capabilities().max_batch_size items per request.
+    using OrderRef = std::pair<std::string, std::string>;   // (order_id, symbol)
+
+    virtual std::vector<std::future<Order>> place_orders(
+        const std::vector<OrderRequest>& requests);
+    virtual std::vector<std::future<Order>> cancel_orders(
+        const std::vector<OrderRef>& orders);
+    virtual std::vector<std::future<Ticker>> get_tickers(
+        const std::vector<std::string>& symbols);
+    virtual std::vector<std::future<std::unique_ptr<Orderbook>>> get_orderbooks(
+        const std::vector<std::string>& symbols,
+        std::optional<int> depth = std::nullopt);
+
     // AMM operations (optional - throw AdapterError if not supported)
     virtual std::future<SwapQuote> get_swap_quote(
         const std::string& base_token,
@@ -8,11 +8,29 @@
 #include <nlohmann/json_fwd.hpp>
 #include <atomic>
 #include <memory>
+#include <mutex>
+#include <string>
 
 namespace lx::trading {
 
+// Pooled HTTP transport (implemented with cpr)
+class HttpClient;
+// WebSocket market data stream
+class MarketStream;
+
 // CCXT Adapter - connects to a CCXT REST service
-// This allows C++ to leverage CCXT's exchange coverage via a REST API
+// This allows C++ to leverage CCXT's exchange coverage via a REST API.
+// Requests go over persistent pooled connections to the service and run
+// on a fixed set of workers, so many can be in flight at once.
+//
+// With config.batch the service also takes batches, up to
+// config.max_batch_size items per request:
+//   POST /tickers      {exchange, symbols}              -> {symbol: ticker}
+//   POST /orderbooks   {exchange, symbols, limit?}      -> {symbol: book}
+//   POST /orders       {credentials, orders: [order]}   -> [order | {error}]
+//   POST /cancelOrders {credentials, orders: [{orderId, symbol}]}
+//                                                       -> [order | {error}]
+// Without it the batch calls send the single requests concurrently.
 class CcxtAdapter : public VenueAdapter {
 public:
     CcxtAdapter(std::string_view name, const CcxtConfig& config);
@@ -51,19 +69,53 @@ public:
     std::future<std::vector<Order>> cancel_all_orders(
         const std::optional<std::string>& symbol = std::nullopt) override;
 
-    // Set the CCXT service URL (default: http://localhost:3000)
+    std::vector<std::future<Order>> place_orders(
+        const std::vector<OrderRequest>& requests) override;
+    std::vector<std::future<Order>> cancel_orders(
+        const std::vector<OrderRef>& orders) override;
+    std::vector<std::future<Ticker>> get_tickers(
+        const std::vector<std::string>& symbols) override;
+    std::vector<std::future<std::unique_ptr<Orderbook>>> get_orderbooks(
+        const std::vector<std::string>& symbols,
+        std::optional<int> depth = std::nullopt) override;
+
+    // Streaming over config.ws_url, where the service relays ccxt.pro's
+    // watch* calls in the LX stream format; no-ops without WebSocket
+    // support or a ws_url. Each book update carries the whole book.
+    void subscribe_ticker(const std::string& symbol, TickerCallback cb) override;
+    void subscribe_trades(const std::string& symbol, TradeCallback cb) override;
+    void subscribe_orderbook(const std::string& symbol, OrderbookCallback cb) override;
+    void unsubscribe_all() override;
+
+    // Set the CCXT service URL (default: config.service_url). Call before
+    // connect(), with no requests in flight.
     void set_service_url(std::string_view url);
 
 private:
     Order convert_order(const nlohmann::json& json);
     void update_latency(int64_t start_ns);
+    // Exchange and credentials, as every private endpoint takes them
+    nlohmann::json credentials() const;
+    // Started stream, or nullptr when streaming is unavailable
+    MarketStream* stream();
+
+    // Sends items [0, count) in requests of at most max_batch_size:
+    // build(first, last) makes a request body and parse(reply, k, i)
+    // reads item i, the k-th of its request, from the reply
+    template <typename T, typename Build, typename Parse>
+    std::vector<std::future<T>> send_batches(const char* path, size_t count,
+                                             Build build, Parse parse);
 
     std::string name_;
     CcxtConfig config_;
-    std::string service_url_ = "http://localhost:3000";
     VenueCapabilities capabilities_;
     std::atomic<bool> connected_{false};
     std::atomic<int> latency_{0};
+
+    // Last, so in-flight replies and stream handlers finish first
+    std::unique_ptr<HttpClient> http_;
+    std::mutex stream_mutex_;
+    std::unique_ptr<MarketStream> stream_;
 };
 
 }  // namespace lx::trading
@@ -11,8 +11,15 @@
 
 namespace lx::trading {
 
+// Pooled HTTP transport (implemented with cpr)
+class HttpClient;
+
 // Hummingbot Gateway Adapter
-// Connects to Hummingbot Gateway REST API for DEX operations
+// Connects to Hummingbot Gateway REST API for DEX operations. Requests go
+// over persistent pooled connections to the Gateway and run on a fixed
+// set of workers, so the batch calls (get_tickers, place_orders) keep
+// their requests in flight together; the Gateway has no batch endpoints
+// for AMM connectors, nor a stream.
 class HummingbotAdapter : public VenueAdapter {
 public:
     HummingbotAdapter(std::string_view name, const HummingbotConfig& config);
@@ -85,6 +92,10 @@ public:
 
 private:
     nlohmann::json build_request_body();
+    nlohmann::json swap_body(const std::string& base_token, const std::string& quote_token,
+                             Decimal amount, bool is_buy, Decimal slippage);
+    Trade parse_swap(const nlohmann::json& data, const std::string& base_token,
+                     const std::string& quote_token, Decimal amount, bool is_buy);
     void update_latency(int64_t start_ns);
 
     std::string name_;
@@ -92,6 +103,9 @@ private:
     VenueCapabilities capabilities_;
     std::atomic<bool> connected_{false};
     std::atomic<int> latency_{0};
+
+    // Last, so in-flight replies finish first
+    std::unique_ptr<HttpClient> http_;
 };
 
 }  // namespace lx::trading
@@ -11,11 +11,14 @@
 #include <memory>
 #include <mutex>
 #include <string>
+#include <unordered_map>
 
 namespace lx::trading {
 
-// HTTP client abstraction (implemented with cpr)
+// Pooled HTTP transport (implemented with cpr)
 class HttpClient;
+// WebSocket market data stream
+class MarketStream;
 
 // LX DEX Adapter - Central Limit Order Book
 class LxDexAdapter : public VenueAdapter {
@@ -56,9 +59,22 @@ public:
     std::future<std::vector<Order>> cancel_all_orders(
         const std::optional<std::string>& symbol = std::nullopt) override;
 
+    // Streaming over config.ws_url; no-ops without WebSocket support or a
+    // ws_url. While a symbol's ticker or book is subscribed, get_ticker()
+    // and get_orderbook() answer from the stream instead of REST.
+    void subscribe_ticker(const std::string& symbol, TickerCallback cb) override;
+    void subscribe_trades(const std::string& symbol, TradeCallback cb) override;
+    void subscribe_orderbook(const std::string& symbol, OrderbookCallback cb) override;
+    void subscribe_orders(OrderCallback cb) override;
+    void unsubscribe_all() override;
+
 private:
     Order convert_order(const nlohmann::json& json);
     void update_latency(int64_t start_ns);
+    // Started stream, or nullptr when streaming is unavailable
+    MarketStream* stream();
+    void apply_book_update(const std::string& symbol, const nlohmann::json& data,
+                           const OrderbookCallback& cb);
 
     std::string name_;
     NativeVenueConfig config_;
@@ -66,6 +82,11 @@ private:
     std::unique_ptr<HttpClient> http_;
     std::atomic<bool> connected_{false};
     std::atomic<int> latency_{0};
+
+    std::mutex stream_mutex_;
+    std::unique_ptr<MarketStream> stream_;
+    std::unordered_map<std::string, Ticker> streamed_tickers_;
+    std::unordered_map<std::string, std::shared_ptr<Orderbook>> streamed_books_;
 };
 
 // LX AMM Adapter - Automated Market Maker
@@ -18,6 +18,7 @@
 #pragma once
 
 #include <lx/trading/arbitrage/types.hpp>
+#include <lx/trading/arbitrage/graph.hpp>
 #include <lx/trading/arbitrage/scanner.hpp>
 #include <lx/trading/arbitrage/lx_first.hpp>
 #include <lx/trading/arbitrage/unified.hpp>
@@ -0,0 +1,99 @@
+// LX Trading SDK - Multi-Leg Arbitrage Graph
+// Triangular and cross-chain cycles by incremental negative-cycle detection.
+//
+// Nodes are (chain, venue, asset). Each quote adds two trade edges on its
+// venue (quote -> base at the ask, base -> quote at the bid) and every
+// venue holding an asset is joined to the others holding it by transfer
+// edges (bridges, withdrawals). An edge's weight is -log of its effective
+// rate after fees and transfer costs, so a cycle whose weights sum below
+// zero returns more than it started with.
+//
+// Only a changed edge can close a new cycle, so update_price searches from
+// the edges it just changed: a hop-limited Bellman-Ford from the edge's
+// head looks for the cheapest way back to its tail in max_legs - 1 hops.
+// That touches the neighbourhood of the update instead of every pair.
+
+#pragma once
+
+#include <lx/trading/arbitrage/types.hpp>
+#include <cstdint>
+#include <functional>
+#include <string>
+#include <unordered_map>
+#include <utility>
+#include <vector>
+
+namespace lx::trading::arbitrage {
+
+/// (gas, bridge) cost in USD of moving funds from one chain to another
+using TransferCostFn = std::function<std::pair<Decimal, Decimal>(const std::string& source_chain,
+                                                                 const std::string& dest_chain)>;
+
+/// Weighted venue/asset graph; not thread-safe (Scanner guards its own)
+class ArbitrageGraph {
+public:
+    /// Without a cost function transfers are free
+    explicit ArbitrageGraph(CycleConfig config, TransferCostFn transfer_cost = {});
+
+    /// Applies a quote and returns the profitable cycles through the edges
+    /// it changed. Symbols are "BASE-QUOTE" / "BASE/QUOTE", or a bare base
+    /// quoted in config().quote_asset.
+    std::vector<ArbitrageOpportunity> update_price(const PriceSource& source);
+
+    /// Re-prices every transfer edge, e.g. after chains were added
+    void refresh_transfer_costs();
+
+    [[nodiscard]] size_t node_count() const noexcept { return nodes_.size(); }
+    [[nodiscard]] size_t edge_count() const noexcept { return edges_.size(); }
+    [[nodiscard]] const CycleConfig& config() const noexcept { return config_; }
+
+private:
+    enum class EdgeKind : uint8_t { Buy, Sell, Transfer };
+
+    struct Node {
+        std::string chain_id;
+        std::string venue;
+        std::string asset;
+        std::vector<uint32_t> out;          // Edge ids
+    };
+
+    struct Edge {
+        uint32_t from;
+        uint32_t to;
+        EdgeKind kind;
+        double weight;                      // -log(effective rate)
+        uint32_t source;                    // Trade edges: index into sources_
+        Decimal gas_cost;                   // Transfer edges
+        Decimal bridge_cost;
+    };
+
+    uint32_t node(const std::string& chain_id, const std::string& venue, const std::string& asset);
+    uint32_t edge(uint32_t from, uint32_t to, EdgeKind kind);
+    void price_transfer(Edge& edge);
+    bool usable(const Edge& edge, int64_t now) const;
+    void search(uint32_t edge, int64_t now, std::vector<ArbitrageOpportunity>& out);
+    bool build(const std::vector<uint32_t>& cycle, double weight, ArbitrageOpportunity& opp) const;
+    double usd_price(const std::string& asset) const;
+
+    CycleConfig config_;
+    TransferCostFn transfer_cost_;
+    double fee_rate_;
+    double threshold_;                      // Cycle weight must be below this
+
+    std::vector<Node> nodes_;
+    std::vector<Edge> edges_;
+    std::unordered_map<std::string, uint32_t> node_index_;      // "chain|venue|asset"
+    std::unordered_map<uint64_t, uint32_t> edge_index_;         // from << 32 | to
+    std::vector<PriceSource> sources_;
+    std::unordered_map<std::string, uint32_t> source_index_;    // "chain|venue|symbol"
+    std::unordered_map<std::string, std::vector<uint32_t>> asset_nodes_;
+    std::unordered_map<std::string, double> usd_prices_;        // Mid against quote_asset
+
+    // Search scratch: per hop count, best weight and last edge per node
+    std::vector<std::vector<double>> dist_;
+    std::vector<std::vector<uint32_t>> pred_;
+    std::vector<uint32_t> frontier_;
+    std::vector<uint32_t> next_frontier_;
+};
+
+}  // namespace lx::trading::arbitrage
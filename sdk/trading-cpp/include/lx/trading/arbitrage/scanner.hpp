@@ -4,13 +4,16 @@
 
 #pragma once
 
+#include <lx/trading/arbitrage/graph.hpp>
 #include <lx/trading/arbitrage/types.hpp>
 #include <atomic>
+#include <condition_variable>
 #include <memory>
 #include <mutex>
 #include <set>
 #include <thread>
 #include <unordered_map>
+#include <unordered_set>
 #include <vector>
 
 namespace lx::trading::arbitrage {
@@ -22,6 +25,14 @@ inline const std::set<std::string> CEX_VENUES = {
 };
 
 /// Arbitrage scanner for detecting cross-venue opportunities
+///
+/// By default a thread rescans every symbol each scan_interval_ms. With
+/// ScannerConfig::event_driven, update_price marks the symbol dirty and
+/// wakes the worker, which re-evaluates only the dirty symbols.
+///
+/// With ScannerConfig::cycles, every update_price also feeds an
+/// ArbitrageGraph and emits the multi-leg cycles it closes straight away,
+/// on the calling thread.
 class Scanner {
 public:
     explicit Scanner(ScannerConfig config);
@@ -34,7 +45,8 @@ public:
     /// Add a chain configuration
     void add_chain(const CrossChainInfo& info);
 
-    /// Update a price feed
+    /// Update a price feed; in event-driven mode this also schedules the
+    /// symbol for re-evaluation
     void update_price(const PriceSource& source);
 
     /// Subscribe to opportunity events
@@ -54,7 +66,12 @@ public:
 
 private:
     void scan_loop();
+    void event_loop();
     std::vector<ArbitrageOpportunity> scan();
+    std::vector<ArbitrageOpportunity> scan_symbol(
+        const std::string& symbol,
+        const std::vector<PriceSource>& sources) const;
+    void emit(const std::vector<ArbitrageOpportunity>& opportunities);
     std::vector<ArbitrageOpportunity> find_simple_arb(
         const std::string& symbol,
         const std::vector<PriceSource>& sources) const;
@@ -71,7 +88,13 @@ private:
     ScannerConfig config_;
     std::unordered_map<std::string, std::vector<PriceSource>> prices_;
     std::unordered_map<std::string, CrossChainInfo> chains_;
+    // (gas, bridge) per "source|dest" chain pair; cleared by add_chain
+    mutable std::unordered_map<std::string, std::pair<Decimal, Decimal>> cost_cache_;
+    std::unordered_set<std::string> dirty_;      // Guarded by prices_mutex_
+    std::condition_variable dirty_cv_;
     std::vector<OpportunityCallback> callbacks_;
+    std::unique_ptr<ArbitrageGraph> graph_;      // Guarded by graph_mutex_
+    std::mutex graph_mutex_;
     mutable std::mutex prices_mutex_;
     mutable std::mutex chains_mutex_;
     mutable std::mutex callbacks_mutex_;
@@ -12,6 +12,7 @@
 #include <functional>
 #include <map>
 #include <memory>
+#include <optional>
 #include <string>
 #include <vector>
 
@@ -277,6 +278,17 @@ struct LxFirstConfig {
     }
 };
 
+/// Configuration for multi-leg cycle detection (ArbitrageGraph)
+struct CycleConfig {
+    size_t max_legs{4};                                     // Trades and transfers per cycle
+    Decimal min_profit_bps{Decimal::from_double(10.0)};     // After fees and transfer costs
+    Decimal min_profit_usd{Decimal::from_double(10.0)};
+    Decimal fee_bps{Decimal::from_double(10.0)};            // Taker fee per trade leg
+    Decimal notional_usd{Decimal::from_double(10000.0)};    // Size fixed transfer costs are spread over
+    std::string quote_asset{"USDC"};                        // Quote of bare symbols ("BTC"); PnL unit
+    int64_t max_price_age_ms{5000};
+};
+
 /// Configuration for arbitrage scanner
 struct ScannerConfig {
     Decimal min_spread_bps{Decimal::from_double(10.0)};
@@ -286,6 +298,12 @@ struct ScannerConfig {
     std::vector<std::string> chain_ids{"lux", "ethereum", "bsc", "arbitrum", "polygon"};
     uint64_t scan_interval_ms{100};
     size_t max_concurrency{50};
+    // Re-evaluate a symbol as soon as update_price changes it, and only
+    // that symbol, instead of rescanning everything every scan_interval_ms
+    bool event_driven{false};
+    // Also look for triangular and cross-chain cycles of up to
+    // cycles->max_legs legs, on every update_price (see ArbitrageGraph)
+    std::optional<CycleConfig> cycles;
 
     static ScannerConfig defaults() {
         return ScannerConfig{};
@@ -0,0 +1,230 @@
+// LX Trading SDK - Backtesting
+// Recorded market data replayed through lux::OrderBook on a virtual clock
+
+#pragma once
+
+#include <lx/trading/types.hpp>
+#include <lux/order.hpp>
+#include <chrono>
+#include <cstddef>
+#include <cstdint>
+#include <functional>
+#include <memory>
+#include <optional>
+#include <string>
+#include <string_view>
+#include <unordered_map>
+#include <vector>
+
+namespace lx::trading {
+
+// =============================================================================
+// Market Data Tape
+// =============================================================================
+//
+// An immutable, time-ordered tape of recorded market events, built once and
+// shared read-only by every run (and every thread) replaying it. Two kinds
+// of recording are supported:
+//
+// - L2 and trades: absolute level sizes (0 removes the level) and trade
+//   prints, as captured from a venue's depth and trade streams
+// - an engine journal (lux::Journal): the order flow itself, replayed
+//   exactly, so the simulated books match the engine's
+//
+// Prices and quantities are fixed-point at Decimal::SCALE, which is also
+// lux's PRICE_MULTIPLIER, so they pass to the books unconverted.
+
+enum class MarketEventKind : uint8_t {
+    Level = 0,      // Absolute size at side/price
+    Trade = 1,      // Print; side is the aggressor
+    Place = 2,      // Journal order (see MarketData::order())
+    Cancel = 3,
+    Modify = 4,
+    Reduce = 5
+};
+
+struct MarketEvent {
+    int64_t timestamp;          // Unix ns
+    uint32_t symbol;            // Index into MarketData::symbols()
+    MarketEventKind kind;
+    Side side;
+    int64_t price;              // Level/Trade/Modify
+    int64_t quantity;           // Level/Trade/Modify/Reduce
+    uint64_t order_id;          // Journal events; Place indexes order()
+};
+
+class MarketData {
+public:
+    // Loads "timestamp_ns,symbol,L|T,buy|sell,price,quantity" lines (a
+    // header line and blank lines are skipped). Throws std::runtime_error
+    // naming the first malformed line.
+    static std::shared_ptr<const MarketData> load_csv(const std::string& path);
+
+    // Replays a lux::Journal file. Symbols are named by their engine id
+    // unless `names` maps them. Records without their own time (cancels,
+    // modifies) take the last order's. Returns nullptr if the journal
+    // cannot be opened.
+    static std::shared_ptr<const MarketData> load_journal(
+        const std::string& path,
+        const std::unordered_map<uint64_t, std::string>& names = {});
+
+    [[nodiscard]] const std::vector<std::string>& symbols() const { return symbols_; }
+    [[nodiscard]] std::optional<uint32_t> find_symbol(std::string_view symbol) const;
+    [[nodiscard]] const std::vector<MarketEvent>& events() const { return events_; }
+    [[nodiscard]] const lux::Order& order(const MarketEvent& place) const {
+        return orders_[place.order_id];
+    }
+
+    [[nodiscard]] int64_t start_time() const { return events_.empty() ? 0 : events_.front().timestamp; }
+    [[nodiscard]] int64_t end_time() const { return events_.empty() ? 0 : events_.back().timestamp; }
+
+private:
+    friend class MarketDataBuilder;
+
+    std::vector<std::string> symbols_;
+    std::vector<MarketEvent> events_;
+    std::vector<lux::Order> orders_;
+};
+
+// Assembles a tape in memory; events may be added out of order
+class MarketDataBuilder {
+public:
+    uint32_t add_symbol(std::string_view symbol);   // Existing index if known
+
+    MarketDataBuilder& level(int64_t timestamp, std::string_view symbol, Side side,
+                             Decimal price, Decimal quantity);
+    MarketDataBuilder& trade(int64_t timestamp, std::string_view symbol, Side aggressor,
+                             Decimal price, Decimal quantity);
+    MarketDataBuilder& journal_order(int64_t timestamp, uint32_t symbol, const lux::Order& order);
+    MarketDataBuilder& journal_event(MarketEvent event);
+
+    // Sorts by time (stable, so same-time events keep their order)
+    std::shared_ptr<const MarketData> build();
+
+private:
+    std::unique_ptr<MarketData> data_ = std::make_unique<MarketData>();
+};
+
+// =============================================================================
+// Strategies
+// =============================================================================
+
+class BacktestContext;
+
+// A strategy under test. Callbacks arrive in virtual-time order on the
+// thread running the backtest; everything the strategy learns is delayed
+// by BacktestConfig::feed_latency and everything it sends by order_latency.
+class Strategy {
+public:
+    virtual ~Strategy() = default;
+
+    virtual void on_start(BacktestContext& ctx) { (void)ctx; }
+    // Top of book changed (bid/ask/last; symbol is the tape's name)
+    virtual void on_book(BacktestContext& ctx, const Ticker& top) { (void)ctx; (void)top; }
+    // Market print, including the strategy's own fills
+    virtual void on_trade(BacktestContext& ctx, const Trade& print) { (void)ctx; (void)print; }
+    // Fill of one of the strategy's orders
+    virtual void on_fill(BacktestContext& ctx, const Trade& fill) { (void)ctx; (void)fill; }
+    // Order accepted, rejected, cancelled or done
+    virtual void on_order(BacktestContext& ctx, const Order& order) { (void)ctx; (void)order; }
+    virtual void on_timer(BacktestContext& ctx) { (void)ctx; }
+    virtual void on_finish(BacktestContext& ctx) { (void)ctx; }
+};
+
+// A strategy's handle on the simulation, valid during callbacks
+class BacktestContext {
+public:
+    virtual ~BacktestContext() = default;
+
+    [[nodiscard]] virtual int64_t now_ns() const = 0;
+
+    // Returns the order id; the order reaches the book order_latency later
+    virtual std::string place_order(const OrderRequest& request) = 0;
+    virtual void cancel_order(const std::string& order_id) = 0;
+    // Calls on_timer at (or right after) at_ns; one timer, re-armed by calling again
+    virtual void set_timer(int64_t at_ns) = 0;
+
+    // As the strategy knows them, i.e. after feed latency
+    [[nodiscard]] virtual Decimal position(std::string_view symbol) const = 0;
+    [[nodiscard]] virtual std::vector<Order> open_orders() const = 0;
+};
+
+// =============================================================================
+// Backtest
+// =============================================================================
+
+// How recorded size reductions at a level treat the strategy's place in
+// the queue. Recordings only give level totals, so which orders left is a
+// modelling choice.
+enum class QueueModel : uint8_t {
+    CancelsFromBack = 0,    // Newest liquidity leaves first (optimistic)
+    CancelsFromFront = 1    // Oldest leaves first: orders ahead of ours (pessimistic)
+};
+
+struct BacktestConfig {
+    std::chrono::nanoseconds order_latency{0};     // Strategy -> book (place, cancel)
+    std::chrono::nanoseconds feed_latency{0};      // Book -> strategy (books, prints, fills)
+    QueueModel queue_model = QueueModel::CancelsFromBack;
+    double maker_fee = 0.0;                         // Rates on notional
+    double taker_fee = 0.0;
+    int64_t start_time = 0;                         // Tape window, Unix ns; 0 = whole tape
+    int64_t end_time = 0;
+};
+
+struct SymbolResult {
+    std::string symbol;
+    Decimal position;
+    double cash = 0.0;              // Quote units, net of fees
+    double last_price = 0.0;        // Last print, else last mid; marks the position
+    double pnl = 0.0;               // cash + position * last_price
+};
+
+struct BacktestResult {
+    size_t run = 0;
+    double pnl = 0.0;               // Summed over symbols, quote units
+    double fees = 0.0;
+    double volume = 0.0;            // Notional filled
+    uint64_t orders = 0;
+    uint64_t cancels = 0;
+    uint64_t rejects = 0;
+    uint64_t fills = 0;
+    uint64_t maker_fills = 0;
+    uint64_t events = 0;            // Tape events replayed
+    double simulated_seconds = 0.0;
+    double wall_seconds = 0.0;
+    std::vector<SymbolResult> symbols;
+    std::string error;              // Strategy exception, if one ended the run
+
+    [[nodiscard]] double speedup() const {
+        return wall_seconds > 0.0 ? simulated_seconds / wall_seconds : 0.0;
+    }
+};
+
+using StrategyFactory = std::function<std::unique_ptr<Strategy>(size_t run)>;
+
+// Replays one tape against strategies. Each run gets private books (a
+// lux::OrderBook per symbol, single-threaded, on a lux::ManualClock set
+// from the tape) seeded with the recorded liquidity, so strategy orders
+// queue behind it and fill only when recorded trades or order flow reach
+// them. Runs share nothing but the tape, so run_parallel() scales across
+// cores.
+class Backtest {
+public:
+    explicit Backtest(std::shared_ptr<const MarketData> data, BacktestConfig config = {});
+
+    [[nodiscard]] BacktestResult run(Strategy& strategy, size_t run_index = 0) const;
+
+    // Runs factory(0) .. factory(runs - 1), e.g. one per parameter set, on
+    // `threads` workers (0 = one per core). Results are in run order.
+    [[nodiscard]] std::vector<BacktestResult> run_parallel(size_t runs, const StrategyFactory& factory,
+                                                           size_t threads = 0) const;
+
+    [[nodiscard]] const MarketData& data() const { return *data_; }
+    [[nodiscard]] const BacktestConfig& config() const { return config_; }
+
+private:
+    std::shared_ptr<const MarketData> data_;
+    BacktestConfig config_;
+};
+
+}  // namespace lx::trading
@@ -26,6 +26,7 @@ struct RiskConfig {
     Decimal max_order_size;
     Decimal max_daily_loss;
     int max_open_orders = 100;
+    Decimal max_pending_notional;   // Per symbol, orders awaiting acknowledgement; 0 = none
     bool kill_switch_enabled = false;
     std::unordered_map<std::string, Decimal> position_limits;
 };
@@ -42,7 +43,9 @@ public:
     std::optional<std::string> private_key;
     std::string network = "mainnet";
     int chain_id = 96369;
-    bool streaming = true;
+    bool streaming = true;              // Market data over ws_url when built with WebSocket support
+    int max_connections = 4;            // Persistent HTTP connections per request method
+    bool http2 = true;                  // Offer HTTP/2 on TLS connections
     std::optional<Decimal> maker_fee;
     std::optional<Decimal> taker_fee;
 
@@ -96,6 +99,12 @@ public:
     bool sandbox = false;
     bool rate_limit = true;
     std::unordered_map<std::string, std::string> options;
+    std::string service_url = "http://localhost:3000";   // CCXT REST sidecar
+    std::optional<std::string> ws_url;  // Sidecar stream relaying ccxt.pro watch* calls
+    bool batch = false;                 // Sidecar serves the batch endpoints (see CcxtAdapter)
+    int max_batch_size = 20;            // Items per batch request
+    int max_connections = 4;            // Persistent HTTP connections per request method
+    bool http2 = true;                  // Offer HTTP/2 on TLS connections
 
     CcxtConfig() = default;
 
@@ -125,6 +134,22 @@ public:
         options[std::string(key)] = std::string(value);
         return *this;
     }
+
+    CcxtConfig& with_service(std::string_view url) {
+        service_url = std::string(url);
+        return *this;
+    }
+
+    CcxtConfig& with_ws(std::string_view url) {
+        ws_url = std::string(url);
+        return *this;
+    }
+
+    CcxtConfig& enable_batch(int max_size = 20) {
+        batch = true;
+        max_batch_size = max_size;
+        return *this;
+    }
 };
 
 // Hummingbot Gateway config
@@ -137,6 +162,8 @@ public:
     std::string chain = "lux";
     std::string network = "mainnet";
     std::optional<std::string> wallet_address;
+    int max_connections = 4;            // Persistent HTTP connections per request method
+    bool http2 = true;                  // Offer HTTP/2 on TLS connections
 
     HummingbotConfig() = default;
 
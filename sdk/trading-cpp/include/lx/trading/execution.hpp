@@ -4,6 +4,7 @@
 #pragma once
 
 #include <lx/trading/types.hpp>
+#include <atomic>
 #include <chrono>
 #include <functional>
 #include <future>
@@ -14,8 +15,9 @@
 
 namespace lx::trading {
 
-// Forward declaration
+// Forward declarations
 class Client;
+class ExecutionScheduler;
 
 // Execution result
 struct ExecutionResult {
@@ -42,15 +44,64 @@ struct ExecutionResult {
 using ExecutionCallback = std::function<void(const Order&, Decimal remaining)>;
 
 // Base executor interface
+//
+// An algorithm is a sequence of steps: each step does one round of work
+// (place a slice, check the market) and says how long to wait before the
+// next. execute() drives the steps on a dedicated thread; execute(scheduler)
+// hands them to a shared ExecutionScheduler, which runs thousands of
+// executors on a few threads and wakes them early on pushed fills and
+// market data. The executor must outlive the returned future.
 class Executor {
 public:
     virtual ~Executor() = default;
-    virtual std::future<ExecutionResult> execute() = 0;
-    virtual void cancel() = 0;
+    virtual std::future<ExecutionResult> execute();
+    std::future<ExecutionResult> execute(ExecutionScheduler& scheduler);
+    virtual void cancel();
     virtual void set_callback(ExecutionCallback cb) { callback_ = std::move(cb); }
 
+    [[nodiscard]] virtual const std::string& symbol() const = 0;
+    [[nodiscard]] bool cancelled() const { return cancelled_.load(std::memory_order_acquire); }
+
 protected:
+    friend class ExecutionScheduler;
+
+    // Progress of one run, owned by whichever thread or scheduler drives it
+    struct RunState {
+        ExecutionResult result;
+        Decimal remaining;
+        Decimal total_value;            // Sum of filled quantity * price
+        int64_t deadline = 0;           // Unix ms; 0 = none
+        int iteration = 0;
+        std::optional<Ticker> ticker;   // Latest pushed market data
+        std::optional<Order> working;   // Child order awaiting fills
+    };
+
+    // Set up a run: total quantity, remaining, deadline
+    virtual RunState begin() = 0;
+    // One round of work; the delay before the next round, or nullopt when
+    // the run is over
+    virtual std::optional<std::chrono::milliseconds> step(RunState& state) = 0;
+    // Stamp the end time, completion and average price
+    virtual ExecutionResult finish(RunState& state);
+    [[nodiscard]] virtual bool is_complete(const RunState& state) const {
+        return state.result.error.empty() && state.remaining <= Decimal::zero();
+    }
+
+    // Pushed events (scheduler mode); return true to run the next step now
+    // instead of waiting for its timer
+    virtual bool on_ticker(RunState& state, const Ticker& ticker);
+    virtual bool on_fill(RunState& state, const Order& order);
+
+    // Fresh state for `total_quantity`; a non-zero duration sets the deadline
+    static RunState start_run(Decimal total_quantity, std::chrono::seconds duration = {});
+    // Account a placed child order against the run
+    void record_order(RunState& state, const Order& order);
+    // Pushed ticker when the scheduler has one, else a REST poll
+    static Ticker market(RunState& state, Client& client, const std::string& symbol);
+
     ExecutionCallback callback_;
+    std::atomic<bool> cancelled_{false};
+    std::function<void()> wake_;        // Set by the scheduler for cancel()
 };
 
 // TWAP - Time-Weighted Average Price
@@ -64,8 +115,13 @@ public:
         std::chrono::seconds duration,
         int num_slices);
 
-    std::future<ExecutionResult> execute() override;
-    void cancel() override;
+    [[nodiscard]] const std::string& symbol() const override { return symbol_; }
+
+protected:
+    RunState begin() override;
+    std::optional<std::chrono::milliseconds> step(RunState& state) override;
+    // Complete when every slice was sent, however much filled
+    [[nodiscard]] bool is_complete(const RunState& state) const override;
 
 private:
     Client& client_;
@@ -74,7 +130,6 @@ private:
     Decimal total_quantity_;
     std::chrono::seconds duration_;
     int num_slices_;
-    std::atomic<bool> cancelled_{false};
 };
 
 // VWAP - Volume-Weighted Average Price
@@ -88,8 +143,11 @@ public:
         Decimal participation_rate,  // e.g., 0.1 = 10% of volume
         std::chrono::seconds max_duration);
 
-    std::future<ExecutionResult> execute() override;
-    void cancel() override;
+    [[nodiscard]] const std::string& symbol() const override { return symbol_; }
+
+protected:
+    RunState begin() override;
+    std::optional<std::chrono::milliseconds> step(RunState& state) override;
 
 private:
     Client& client_;
@@ -98,7 +156,6 @@ private:
     Decimal total_quantity_;
     Decimal participation_rate_;
     std::chrono::seconds max_duration_;
-    std::atomic<bool> cancelled_{false};
 };
 
 // Iceberg - Hidden large order
@@ -113,8 +170,13 @@ public:
         Decimal price,
         std::optional<std::string> venue = std::nullopt);
 
-    std::future<ExecutionResult> execute() override;
-    void cancel() override;
+    [[nodiscard]] const std::string& symbol() const override { return symbol_; }
+
+protected:
+    RunState begin() override;
+    std::optional<std::chrono::milliseconds> step(RunState& state) override;
+    // A fill on the working slice releases the next one at once
+    bool on_fill(RunState& state, const Order& order) override;
 
 private:
     Client& client_;
@@ -124,7 +186,6 @@ private:
     Decimal visible_quantity_;
     Decimal price_;
     std::optional<std::string> venue_;
-    std::atomic<bool> cancelled_{false};
 };
 
 // Sniper - Wait for price target then execute
@@ -138,17 +199,24 @@ public:
         Decimal target_price,
         std::chrono::seconds timeout);
 
-    std::future<ExecutionResult> execute() override;
-    void cancel() override;
+    [[nodiscard]] const std::string& symbol() const override { return symbol_; }
+
+protected:
+    RunState begin() override;
+    std::optional<std::chrono::milliseconds> step(RunState& state) override;
+    // Fire as soon as a pushed quote crosses the target
+    bool on_ticker(RunState& state, const Ticker& ticker) override;
+    [[nodiscard]] bool is_complete(const RunState& state) const override;
 
 private:
+    [[nodiscard]] bool triggered(const Ticker& ticker) const;
+
     Client& client_;
     std::string symbol_;
     Side side_;
     Decimal quantity_;
     Decimal target_price_;
     std::chrono::seconds timeout_;
-    std::atomic<bool> cancelled_{false};
 };
 
 // POV - Percentage of Volume
@@ -163,8 +231,11 @@ public:
         std::chrono::seconds max_duration,
         std::optional<Decimal> price_limit = std::nullopt);
 
-    std::future<ExecutionResult> execute() override;
-    void cancel() override;
+    [[nodiscard]] const std::string& symbol() const override { return symbol_; }
+
+protected:
+    RunState begin() override;
+    std::optional<std::chrono::milliseconds> step(RunState& state) override;
 
 private:
     Client& client_;
@@ -174,7 +245,6 @@ private:
     Decimal target_participation_;
     std::chrono::seconds max_duration_;
     std::optional<Decimal> price_limit_;
-    std::atomic<bool> cancelled_{false};
 };
 
 // Factory functions for convenience
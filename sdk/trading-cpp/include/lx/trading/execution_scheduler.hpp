@@ -0,0 +1,108 @@
+// LX Trading SDK - Execution Scheduler
+// One timer wheel and a small worker pool driving many executors
+
+#pragma once
+
+#include <lx/trading/execution.hpp>
+#include <chrono>
+#include <condition_variable>
+#include <cstdint>
+#include <deque>
+#include <functional>
+#include <future>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <thread>
+#include <unordered_map>
+#include <vector>
+
+namespace lx::trading {
+
+struct ExecutionSchedulerConfig {
+    size_t worker_threads = 2;
+    std::chrono::milliseconds tick{1};      // Timer resolution
+    size_t wheel_slots = 1024;              // Delays past slots * tick take extra turns
+};
+
+// Drives executors as step functions: a hashed timer wheel schedules each
+// run's next step and a worker pool runs the steps, so idle algos cost a
+// wheel entry rather than a sleeping thread. Fills and market data pushed
+// through publish_fill()/publish_ticker() reach the runs on that symbol
+// at once and can pull their next step forward. Steps that call the
+// Client block a worker for the round trip; size worker_threads for the
+// number of order round trips expected in flight.
+class ExecutionScheduler {
+public:
+    explicit ExecutionScheduler(ExecutionSchedulerConfig config = {});
+    ~ExecutionScheduler();
+
+    ExecutionScheduler(const ExecutionScheduler&) = delete;
+    ExecutionScheduler& operator=(const ExecutionScheduler&) = delete;
+
+    // Start a run of `executor`; same result as executor.execute()
+    std::future<ExecutionResult> submit(Executor& executor);
+
+    // Push market data and order updates to the runs on that symbol
+    void publish_ticker(const Ticker& ticker);
+    void publish_fill(const Order& order);
+
+    // Generic timers on the same wheel; cancel returns false once fired
+    using TimerId = uint64_t;
+    TimerId schedule_after(std::chrono::milliseconds delay, std::function<void()> fn);
+    bool cancel_timer(TimerId id);
+    // Run `fn` on a worker as soon as one is free
+    void post(std::function<void()> fn);
+
+    // Finish every active run with error "Stopped" and join the threads;
+    // called by the destructor
+    void stop();
+
+    [[nodiscard]] size_t active_runs() const;
+    [[nodiscard]] size_t pending_timers() const;
+
+private:
+    struct Run;
+    struct Timer {
+        TimerId id;
+        uint64_t due_tick;
+        std::function<void()> fn;
+    };
+
+    void advance(const std::shared_ptr<Run>& run);    // Caller holds run->mutex
+    void step_now(const std::shared_ptr<Run>& run);
+    void wake(const std::shared_ptr<Run>& run);
+    void complete(const std::shared_ptr<Run>& run, ExecutionResult result);
+    template <typename Event, typename Handler>
+    void dispatch(const std::string& symbol, const Event& event, Handler handler);
+
+    void tick_loop();
+    void worker_loop();
+
+    ExecutionSchedulerConfig config_;
+    std::chrono::steady_clock::time_point epoch_;
+
+    // Timer wheel
+    mutable std::mutex wheel_mutex_;
+    std::condition_variable wheel_cv_;
+    std::vector<std::vector<Timer>> slots_;
+    std::unordered_map<TimerId, size_t> timer_slots_;
+    uint64_t current_tick_ = 0;
+    TimerId next_timer_ = 1;
+
+    // Ready tasks
+    std::mutex queue_mutex_;
+    std::condition_variable queue_cv_;
+    std::deque<std::function<void()>> queue_;
+
+    // Active runs by symbol
+    mutable std::mutex runs_mutex_;
+    std::unordered_map<std::string, std::vector<std::shared_ptr<Run>>> runs_;
+    size_t active_ = 0;
+
+    bool stopping_ = false;             // Guarded by queue_mutex_ and wheel_mutex_
+    std::thread tick_thread_;
+    std::vector<std::thread> workers_;
+};
+
+}  // namespace lx::trading
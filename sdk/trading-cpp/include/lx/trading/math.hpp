@@ -8,15 +8,6 @@
 #include <tuple>
 #include <vector>
 
-// SIMD support detection
-#if defined(__AVX2__)
-    #include <immintrin.h>
-    #define LX_SIMD_AVX2 1
-#elif defined(__SSE4_1__)
-    #include <smmintrin.h>
-    #define LX_SIMD_SSE4 1
-#endif
-
 namespace lx::trading::math {
 
 // =============================================================================
@@ -169,29 +160,46 @@ double cvar(
 // SIMD Optimized Operations
 // =============================================================================
 
-#ifdef LX_SIMD_AVX2
+// Batch kernels are picked once at runtime from the CPU's features:
+// AVX-512, AVX2+FMA or NEON when the library was built with them
+// (LX_TRADING_USE_SIMD), otherwise the scalar functions above. Vector
+// exp/log differ from libm in the last few ulps, so batch results can
+// differ from the scalar ones at that level.
+
+// Instruction set the batch kernels run on: "avx512", "avx2", "neon" or "scalar"
+const char* simd_isa() noexcept;
 
-// Batch Black-Scholes pricing (AVX2)
+// Batch Black-Scholes pricing
 void black_scholes_batch(
     const double* S, const double* K, const double* T,
     const double* r, const double* sigma,
     double* prices, size_t count, bool is_call = true) noexcept;
 
-// Batch norm_cdf (AVX2)
+// Batch norm_cdf
 void norm_cdf_batch(
     const double* x, double* result, size_t count) noexcept;
 
-// Vectorized sum (AVX2)
+// Batch Greeks, same conventions as greeks()
+void greeks_batch(
+    const double* S, const double* K, const double* T,
+    const double* r, const double* sigma,
+    Greeks* out, size_t count, bool is_call = true) noexcept;
+
+// Batch implied volatility: Newton-Raphson run across vector lanes with
+// the same start, stopping rules and bounds as implied_volatility();
+// options at or past expiry get the 0.2 starting guess
+void implied_volatility_batch(
+    const double* price, const double* S, const double* K,
+    const double* T, const double* r,
+    double* out, size_t count, bool is_call = true,
+    double tol = 1e-6, int max_iter = 100) noexcept;
+
+// Vectorized sum, mean and sample variance (names kept from the former
+// AVX2-only versions; they dispatch like the kernels above)
 double sum_avx2(const double* data, size_t count) noexcept;
-
-// Vectorized mean (AVX2)
 double mean_avx2(const double* data, size_t count) noexcept;
-
-// Vectorized variance (AVX2)
 double variance_avx2(const double* data, size_t count, double mean) noexcept;
 
-#endif  // LX_SIMD_AVX2
-
 // =============================================================================
 // Statistical Utilities
 // =============================================================================
@@ -223,4 +231,127 @@ double beta(
     const std::vector<double>& asset_returns,
     const std::vector<double>& market_returns) noexcept;
 
+// =============================================================================
+// Streaming Statistics
+// =============================================================================
+// Stateful counterparts of the vector functions above for live data: each
+// sample is O(1), windows live in a ring buffer sized at construction and
+// nothing allocates afterwards. The pointer overloads of update() catch up
+// on a backlog in one call.
+
+// Mean and sample variance of the last `window` samples (Welford, with the
+// oldest sample removed as each new one arrives once the window is full)
+class RollingStats {
+public:
+    explicit RollingStats(size_t window);
+
+    void update(double x) noexcept;
+    void update(const double* data, size_t count) noexcept;
+    void reset() noexcept;
+
+    [[nodiscard]] size_t window() const noexcept { return buffer_.size(); }
+    [[nodiscard]] size_t count() const noexcept { return count_; }
+    [[nodiscard]] bool full() const noexcept { return count_ == buffer_.size(); }
+    [[nodiscard]] double mean() const noexcept { return mean_; }
+    [[nodiscard]] double variance() const noexcept;
+    [[nodiscard]] double stddev() const noexcept { return std::sqrt(variance()); }
+
+private:
+    std::vector<double> buffer_;
+    size_t head_ = 0;       // Slot of the oldest sample once full
+    size_t count_ = 0;
+    double mean_ = 0.0;
+    double m2_ = 0.0;       // Sum of squared deviations from the mean
+};
+
+// Exponential moving average; the first sample seeds it, as in ema()
+class StreamingEma {
+public:
+    explicit StreamingEma(double alpha) noexcept : alpha_(alpha) {}
+
+    void update(double x) noexcept {
+        value_ = initialized_ ? alpha_ * x + (1.0 - alpha_) * value_ : x;
+        initialized_ = true;
+    }
+    void update(const double* data, size_t count) noexcept {
+        for (size_t i = 0; i < count; ++i) {
+            update(data[i]);
+        }
+    }
+    void reset() noexcept {
+        value_ = 0.0;
+        initialized_ = false;
+    }
+
+    [[nodiscard]] bool initialized() const noexcept { return initialized_; }
+    [[nodiscard]] double value() const noexcept { return value_; }
+
+private:
+    double alpha_;
+    double value_ = 0.0;
+    bool initialized_ = false;
+};
+
+// Sample covariance, correlation and beta of the last `window` (x, y)
+// pairs, e.g. asset (x) against market (y) returns
+class RollingCovariance {
+public:
+    explicit RollingCovariance(size_t window);
+
+    void update(double x, double y) noexcept;
+    void update(const double* x, const double* y, size_t count) noexcept;
+    void reset() noexcept;
+
+    [[nodiscard]] size_t window() const noexcept { return xs_.size(); }
+    [[nodiscard]] size_t count() const noexcept { return count_; }
+    [[nodiscard]] bool full() const noexcept { return count_ == xs_.size(); }
+    [[nodiscard]] double mean_x() const noexcept { return mean_x_; }
+    [[nodiscard]] double mean_y() const noexcept { return mean_y_; }
+    [[nodiscard]] double covariance() const noexcept;
+    [[nodiscard]] double variance_x() const noexcept;
+    [[nodiscard]] double variance_y() const noexcept;
+    [[nodiscard]] double correlation() const noexcept;
+    // Beta of x against y: cov(x, y) / var(y)
+    [[nodiscard]] double beta() const noexcept;
+
+private:
+    void add(double x, double y) noexcept;
+    void remove(double x, double y) noexcept;
+
+    std::vector<double> xs_;
+    std::vector<double> ys_;
+    size_t head_ = 0;
+    size_t count_ = 0;
+    double mean_x_ = 0.0;
+    double mean_y_ = 0.0;
+    double cxy_ = 0.0;      // Co-moment sum (x - mean_x)(y - mean_y)
+    double m2x_ = 0.0;
+    double m2y_ = 0.0;
+};
+
+// Running drawdown from the high-water mark, with the same definition and
+// indices as max_drawdown()
+class StreamingDrawdown {
+public:
+    void update(double price) noexcept;
+    void update(const double* prices, size_t count) noexcept;
+    void reset() noexcept { *this = StreamingDrawdown{}; }
+
+    [[nodiscard]] size_t count() const noexcept { return count_; }
+    [[nodiscard]] double peak() const noexcept { return peak_; }
+    [[nodiscard]] double current() const noexcept { return current_; }
+    [[nodiscard]] double max() const noexcept { return max_; }
+    [[nodiscard]] size_t max_peak_index() const noexcept { return max_peak_index_; }
+    [[nodiscard]] size_t max_trough_index() const noexcept { return max_trough_index_; }
+
+private:
+    size_t count_ = 0;
+    double peak_ = 0.0;
+    size_t peak_index_ = 0;
+    double current_ = 0.0;
+    double max_ = 0.0;
+    size_t max_peak_index_ = 0;
+    size_t max_trough_index_ = 0;
+};
+
 }  // namespace lx::trading::math
@@ -6,15 +6,65 @@
 #include <lx/trading/types.hpp>
 #include <algorithm>
 #include <atomic>
+#include <functional>
+#include <limits>
+#include <map>
 #include <memory>
+#include <mutex>
+#include <optional>
 #include <shared_mutex>
 #include <string>
+#include <tuple>
 #include <unordered_map>
 #include <vector>
 
 namespace lx::trading {
 
+// One L2 change from a venue message; a zero quantity deletes the level
+struct BookDelta {
+    Side side;          // Buy updates a bid, Sell an ask
+    Decimal price;
+    Decimal quantity;
+};
+
+namespace detail {
+
+// First level not better than `price`: the insertion point for it in a
+// side sorted best-first
+inline std::vector<PriceLevel>::iterator find_level(
+    std::vector<PriceLevel>& levels, Decimal price, bool descending) {
+    return std::lower_bound(levels.begin(), levels.end(), price,
+        [descending](const PriceLevel& level, Decimal p) {
+            return descending ? level.price > p : level.price < p;
+        });
+}
+
+inline void upsert_level(std::vector<PriceLevel>& levels, Decimal price, Decimal quantity,
+                         bool descending) {
+    auto it = find_level(levels, price, descending);
+    if (it != levels.end() && it->price == price) {
+        it->quantity = quantity;
+    } else {
+        levels.insert(it, {price, quantity});
+    }
+}
+
+inline void erase_level(std::vector<PriceLevel>& levels, Decimal price, bool descending) {
+    auto it = find_level(levels, price, descending);
+    if (it != levels.end() && it->price == price) {
+        levels.erase(it);
+    }
+}
+
+}  // namespace detail
+
 // Single venue orderbook with lock-free reads
+//
+// Both sides are flat arrays kept in price order (bids descending, asks
+// ascending), so updates are a binary search plus an in-place write or a
+// shift, and the top of book is element [0]. The best prices are also
+// mirrored into atomics after every write so best_bid()/best_ask() never
+// take the lock.
 class Orderbook {
 public:
     explicit Orderbook(std::string_view symbol, std::string_view venue = "")
@@ -31,63 +81,72 @@ public:
     [[nodiscard]] int64_t timestamp() const { return timestamp_.load(std::memory_order_acquire); }
     [[nodiscard]] uint64_t sequence() const { return sequence_.load(std::memory_order_acquire); }
 
-    // Mutators (thread-safe)
-    void add_bid(Decimal price, Decimal quantity) {
-        std::unique_lock lock(mutex_);
-        bids_.push_back({price, quantity});
-    }
-
-    void add_ask(Decimal price, Decimal quantity) {
-        std::unique_lock lock(mutex_);
-        asks_.push_back({price, quantity});
-    }
+    // Mutators (thread-safe); add_* and set_* both insert the level in
+    // price order or overwrite the quantity already at that price
+    void add_bid(Decimal price, Decimal quantity) { set_bid(price, quantity); }
+    void add_ask(Decimal price, Decimal quantity) { set_ask(price, quantity); }
 
     void set_bid(Decimal price, Decimal quantity) {
         std::unique_lock lock(mutex_);
-        for (auto& level : bids_) {
-            if (level.price == price) {
-                level.quantity = quantity;
-                return;
-            }
-        }
-        bids_.push_back({price, quantity});
+        detail::upsert_level(bids_, price, quantity, true);
+        publish_best();
     }
 
     void set_ask(Decimal price, Decimal quantity) {
         std::unique_lock lock(mutex_);
-        for (auto& level : asks_) {
-            if (level.price == price) {
-                level.quantity = quantity;
-                return;
-            }
-        }
-        asks_.push_back({price, quantity});
+        detail::upsert_level(asks_, price, quantity, false);
+        publish_best();
     }
 
     void remove_bid(Decimal price) {
         std::unique_lock lock(mutex_);
-        bids_.erase(std::remove_if(bids_.begin(), bids_.end(),
-            [price](const PriceLevel& l) { return l.price == price; }), bids_.end());
+        detail::erase_level(bids_, price, true);
+        publish_best();
     }
 
     void remove_ask(Decimal price) {
         std::unique_lock lock(mutex_);
-        asks_.erase(std::remove_if(asks_.begin(), asks_.end(),
-            [price](const PriceLevel& l) { return l.price == price; }), asks_.end());
+        detail::erase_level(asks_, price, false);
+        publish_best();
+    }
+
+    // Apply every level change of one venue message under a single lock,
+    // then stamp the book with the message's sequence and timestamp (or
+    // bump the sequence and use the current time)
+    void apply_deltas(const std::vector<BookDelta>& deltas,
+                      std::optional<uint64_t> sequence = std::nullopt,
+                      std::optional<int64_t> timestamp = std::nullopt) {
+        {
+            std::unique_lock lock(mutex_);
+            for (const auto& delta : deltas) {
+                const bool is_bid = delta.side == Side::Buy;
+                auto& levels = is_bid ? bids_ : asks_;
+                if (delta.quantity.is_zero()) {
+                    detail::erase_level(levels, delta.price, is_bid);
+                } else {
+                    detail::upsert_level(levels, delta.price, delta.quantity, is_bid);
+                }
+            }
+            publish_best();
+        }
+        if (sequence) {
+            sequence_.store(*sequence, std::memory_order_release);
+        } else {
+            sequence_.fetch_add(1, std::memory_order_release);
+        }
+        timestamp_.store(timestamp ? *timestamp : now_ms(), std::memory_order_release);
     }
 
     void clear() {
         std::unique_lock lock(mutex_);
         bids_.clear();
         asks_.clear();
+        publish_best();
     }
 
+    // Levels are always kept in order; this only marks the end of a batch
+    // of single-level updates by bumping the sequence and timestamp
     void sort() {
-        std::unique_lock lock(mutex_);
-        std::sort(bids_.begin(), bids_.end(),
-            [](const PriceLevel& a, const PriceLevel& b) { return a.price > b.price; });
-        std::sort(asks_.begin(), asks_.end(),
-            [](const PriceLevel& a, const PriceLevel& b) { return a.price < b.price; });
         sequence_.fetch_add(1, std::memory_order_release);
         timestamp_.store(now_ms(), std::memory_order_release);
     }
@@ -107,13 +166,11 @@ public:
     }
 
     [[nodiscard]] std::optional<Decimal> best_bid() const {
-        std::shared_lock lock(mutex_);
-        return bids_.empty() ? std::nullopt : std::optional<Decimal>(bids_[0].price);
+        return cached_price(best_bid_);
     }
 
     [[nodiscard]] std::optional<Decimal> best_ask() const {
-        std::shared_lock lock(mutex_);
-        return asks_.empty() ? std::nullopt : std::optional<Decimal>(asks_[0].price);
+        return cached_price(best_ask_);
     }
 
     [[nodiscard]] std::optional<Decimal> mid_price() const {
@@ -201,6 +258,22 @@ public:
     }
 
 private:
+    static constexpr int64_t NO_PRICE = std::numeric_limits<int64_t>::min();
+
+    // Mirror the top of book into the atomics; caller holds the unique lock
+    void publish_best() {
+        best_bid_.store(bids_.empty() ? NO_PRICE : bids_[0].price.scaled_value(),
+                        std::memory_order_release);
+        best_ask_.store(asks_.empty() ? NO_PRICE : asks_[0].price.scaled_value(),
+                        std::memory_order_release);
+    }
+
+    [[nodiscard]] static std::optional<Decimal> cached_price(const std::atomic<int64_t>& best) {
+        const int64_t scaled = best.load(std::memory_order_acquire);
+        if (scaled == NO_PRICE) return std::nullopt;
+        return Decimal(scaled);
+    }
+
     [[nodiscard]] static std::optional<Decimal> calculate_vwap(
         const std::vector<PriceLevel>& levels, Decimal amount) {
         Decimal remaining = amount;
@@ -227,6 +300,8 @@ private:
     mutable std::shared_mutex mutex_;
     std::vector<PriceLevel> bids_;
     std::vector<PriceLevel> asks_;
+    std::atomic<int64_t> best_bid_{NO_PRICE};
+    std::atomic<int64_t> best_ask_{NO_PRICE};
 };
 
 // Hash functor for Decimal
@@ -236,152 +311,284 @@ struct DecimalHash {
     }
 };
 
-// Type alias for price-level map
-using PriceLevelMap = std::unordered_map<Decimal, std::vector<std::pair<std::string, Decimal>>, DecimalHash>;
+// Best consolidated price on one side and the venue quoting it
+struct VenueQuote {
+    Decimal price;
+    std::string venue;
+    Decimal quantity;
+};
+
+// Consolidated top of book across venues
+struct ConsolidatedBbo {
+    std::optional<VenueQuote> bid;
+    std::optional<VenueQuote> ask;
+    int64_t timestamp = 0;
+    uint64_t version = 0;           // Bumped on every change of the BBO
+};
 
 // Aggregated orderbook from multiple venues
+//
+// The consolidated ladder is maintained incrementally: each venue's last
+// levels are kept, and a venue update touches only the consolidated
+// levels whose quantity for that venue changed. The consolidated BBO is
+// republished as an immutable snapshot whenever it changes, so best-price
+// and best-venue reads are one atomic load and never take the lock.
 class AggregatedOrderbook {
 public:
-    explicit AggregatedOrderbook(std::string_view symbol) : symbol_(symbol) {}
+    explicit AggregatedOrderbook(std::string_view symbol)
+        : symbol_(symbol), bbo_(std::make_shared<const ConsolidatedBbo>()) {}
+
+    AggregatedOrderbook(const AggregatedOrderbook&) = delete;
+    AggregatedOrderbook& operator=(const AggregatedOrderbook&) = delete;
+
+    AggregatedOrderbook(AggregatedOrderbook&& other) noexcept {
+        std::unique_lock lock(other.mutex_);
+        move_from(other);
+    }
+
+    AggregatedOrderbook& operator=(AggregatedOrderbook&& other) noexcept {
+        if (this != &other) {
+            std::scoped_lock lock(mutex_, other.mutex_);
+            move_from(other);
+        }
+        return *this;
+    }
 
     [[nodiscard]] const std::string& symbol() const { return symbol_; }
-    [[nodiscard]] int64_t timestamp() const { return timestamp_; }
+    [[nodiscard]] int64_t timestamp() const { return bbo()->timestamp; }
 
+    // Replace `book.venue()`'s contribution with the book's current levels
     void add_orderbook(const Orderbook& book) {
         auto bids = book.bids();
         auto asks = book.asks();
 
-        for (const auto& level : bids) {
-            bids_[level.price].emplace_back(book.venue(), level.quantity);
-        }
+        std::unique_lock lock(mutex_);
+        auto it = venues_.try_emplace(book.venue()).first;
+        VenueLevels& levels = it->second;
+        diff_side(bids_, it->first, levels.bids, bids, true);
+        diff_side(asks_, it->first, levels.asks, asks, false);
+        levels.bids = std::move(bids);
+        levels.asks = std::move(asks);
+        timestamp_ = std::max(timestamp_, book.timestamp());
+        publish_bbo();
+    }
 
-        for (const auto& level : asks) {
-            asks_[level.price].emplace_back(book.venue(), level.quantity);
+    // Apply one venue message's level changes (zero quantity deletes)
+    // without re-reading the venue's whole book
+    void apply_deltas(std::string_view venue, const std::vector<BookDelta>& deltas,
+                      std::optional<int64_t> timestamp = std::nullopt) {
+        std::unique_lock lock(mutex_);
+        auto it = venues_.try_emplace(std::string(venue)).first;
+        const std::string& name = it->first;
+        VenueLevels& levels = it->second;
+        for (const auto& delta : deltas) {
+            const bool is_bid = delta.side == Side::Buy;
+            auto& side = is_bid ? levels.bids : levels.asks;
+            if (delta.quantity.is_zero()) {
+                detail::erase_level(side, delta.price, is_bid);
+            } else {
+                detail::upsert_level(side, delta.price, delta.quantity, is_bid);
+            }
+            if (is_bid) {
+                set_venue_quantity(bids_, name, delta.price, delta.quantity);
+            } else {
+                set_venue_quantity(asks_, name, delta.price, delta.quantity);
+            }
         }
+        timestamp_ = std::max(timestamp_, timestamp ? *timestamp : now_ms());
+        publish_bbo();
+    }
 
-        timestamp_ = std::max(timestamp_, book.timestamp());
+    // Drop every level a venue contributed
+    void remove_venue(std::string_view venue) {
+        std::unique_lock lock(mutex_);
+        auto it = venues_.find(std::string(venue));
+        if (it == venues_.end()) return;
+        diff_side(bids_, it->first, it->second.bids, {}, true);
+        diff_side(asks_, it->first, it->second.asks, {}, false);
+        venues_.erase(it);
+        publish_bbo();
+    }
+
+    // Current consolidated BBO snapshot; never null
+    [[nodiscard]] std::shared_ptr<const ConsolidatedBbo> bbo() const {
+        return std::atomic_load_explicit(&bbo_, std::memory_order_acquire);
     }
 
     // Best bid across all venues: (price, venue, qty)
     [[nodiscard]] std::optional<std::tuple<Decimal, std::string, Decimal>> best_bid() const {
-        if (bids_.empty()) return std::nullopt;
-
-        auto it = std::max_element(bids_.begin(), bids_.end(),
-            [](const auto& a, const auto& b) { return a.first < b.first; });
-
-        if (it == bids_.end() || it->second.empty()) return std::nullopt;
-
-        const auto& [venue, qty] = it->second[0];
-        return std::make_tuple(it->first, venue, qty);
+        auto snapshot = bbo();
+        if (!snapshot->bid) return std::nullopt;
+        return std::make_tuple(snapshot->bid->price, snapshot->bid->venue, snapshot->bid->quantity);
     }
 
     // Best ask across all venues: (price, venue, qty)
     [[nodiscard]] std::optional<std::tuple<Decimal, std::string, Decimal>> best_ask() const {
-        if (asks_.empty()) return std::nullopt;
+        auto snapshot = bbo();
+        if (!snapshot->ask) return std::nullopt;
+        return std::make_tuple(snapshot->ask->price, snapshot->ask->venue, snapshot->ask->quantity);
+    }
+
+    // Get aggregated bid levels
+    [[nodiscard]] std::vector<PriceLevel> aggregated_bids() const {
+        std::shared_lock lock(mutex_);
+        return aggregate(bids_);
+    }
 
-        auto it = std::min_element(asks_.begin(), asks_.end(),
-            [](const auto& a, const auto& b) { return a.first < b.first; });
+    // Get aggregated ask levels
+    [[nodiscard]] std::vector<PriceLevel> aggregated_asks() const {
+        std::shared_lock lock(mutex_);
+        return aggregate(asks_);
+    }
 
-        if (it == asks_.end() || it->second.empty()) return std::nullopt;
+    // Find best venue for buying amount: (venue, price)
+    [[nodiscard]] std::optional<std::pair<std::string, Decimal>> best_venue_buy(Decimal amount) const {
+        auto snapshot = bbo();
+        if (!snapshot->ask) return std::nullopt;
+        return std::make_pair(snapshot->ask->venue, snapshot->ask->price);
+    }
 
-        const auto& [venue, qty] = it->second[0];
-        return std::make_tuple(it->first, venue, qty);
+    // Find best venue for selling amount: (venue, price)
+    [[nodiscard]] std::optional<std::pair<std::string, Decimal>> best_venue_sell(Decimal amount) const {
+        auto snapshot = bbo();
+        if (!snapshot->bid) return std::nullopt;
+        return std::make_pair(snapshot->bid->venue, snapshot->bid->price);
     }
 
-    // Get aggregated bid levels
-    [[nodiscard]] std::vector<PriceLevel> aggregated_bids() const {
-        std::vector<std::pair<Decimal, Decimal>> temp;
-        for (const auto& [price, venues] : bids_) {
-            Decimal total_qty;
-            for (const auto& [v, qty] : venues) {
-                total_qty = total_qty + qty;
+    void clear() {
+        std::unique_lock lock(mutex_);
+        venues_.clear();
+        bids_.clear();
+        asks_.clear();
+        timestamp_ = 0;
+        publish_bbo();
+    }
+
+private:
+    // price -> [(venue, qty), ...] in the order venues first quoted it
+    using VenueQuantities = std::vector<std::pair<std::string, Decimal>>;
+    using BidLadder = std::map<Decimal, VenueQuantities, std::greater<Decimal>>;
+    using AskLadder = std::map<Decimal, VenueQuantities, std::less<Decimal>>;
+
+    struct VenueLevels {
+        std::vector<PriceLevel> bids;
+        std::vector<PriceLevel> asks;
+    };
+
+    template <typename Ladder>
+    static void set_venue_quantity(Ladder& ladder, const std::string& venue,
+                                   Decimal price, Decimal quantity) {
+        if (quantity.is_zero()) {
+            auto level = ladder.find(price);
+            if (level == ladder.end()) return;
+            auto& venues = level->second;
+            venues.erase(std::remove_if(venues.begin(), venues.end(),
+                [&venue](const auto& v) { return v.first == venue; }), venues.end());
+            if (venues.empty()) {
+                ladder.erase(level);
             }
-            temp.emplace_back(price, total_qty);
+            return;
         }
-        std::sort(temp.begin(), temp.end(),
-            [](const auto& a, const auto& b) { return a.first > b.first; });
 
-        std::vector<PriceLevel> result;
-        result.reserve(temp.size());
-        for (const auto& [price, qty] : temp) {
-            result.push_back({price, qty});
+        auto& venues = ladder[price];
+        for (auto& v : venues) {
+            if (v.first == venue) {
+                v.second = quantity;
+                return;
+            }
+        }
+        venues.emplace_back(venue, quantity);
+    }
+
+    // Walk a venue's old and new levels (both sorted best-first) together
+    // and touch only the consolidated levels that changed
+    template <typename Ladder>
+    static void diff_side(Ladder& ladder, const std::string& venue,
+                          const std::vector<PriceLevel>& before,
+                          const std::vector<PriceLevel>& after, bool descending) {
+        auto better = [descending](Decimal a, Decimal b) { return descending ? a > b : a < b; };
+        size_t i = 0;
+        size_t j = 0;
+        while (i < before.size() || j < after.size()) {
+            if (j == after.size() ||
+                (i < before.size() && better(before[i].price, after[j].price))) {
+                set_venue_quantity(ladder, venue, before[i].price, Decimal::zero());
+                ++i;
+            } else if (i == before.size() || better(after[j].price, before[i].price)) {
+                set_venue_quantity(ladder, venue, after[j].price, after[j].quantity);
+                ++j;
+            } else {
+                if (before[i].quantity != after[j].quantity) {
+                    set_venue_quantity(ladder, venue, after[j].price, after[j].quantity);
+                }
+                ++i;
+                ++j;
+            }
         }
-        return result;
     }
 
-    // Get aggregated ask levels
-    [[nodiscard]] std::vector<PriceLevel> aggregated_asks() const {
-        std::vector<std::pair<Decimal, Decimal>> temp;
-        for (const auto& [price, venues] : asks_) {
+    template <typename Ladder>
+    static std::vector<PriceLevel> aggregate(const Ladder& ladder) {
+        std::vector<PriceLevel> result;
+        result.reserve(ladder.size());
+        for (const auto& [price, venues] : ladder) {
             Decimal total_qty;
             for (const auto& [v, qty] : venues) {
                 total_qty = total_qty + qty;
             }
-            temp.emplace_back(price, total_qty);
-        }
-        std::sort(temp.begin(), temp.end(),
-            [](const auto& a, const auto& b) { return a.first < b.first; });
-
-        std::vector<PriceLevel> result;
-        result.reserve(temp.size());
-        for (const auto& [price, qty] : temp) {
-            result.push_back({price, qty});
+            result.push_back({price, total_qty});
         }
         return result;
     }
 
-    // Find best venue for buying amount: (venue, price)
-    [[nodiscard]] std::optional<std::pair<std::string, Decimal>> best_venue_buy(Decimal amount) const {
-        if (asks_.empty()) return std::nullopt;
-
-        // Use the same direct iteration approach as aggregated_asks
-        // Find the lowest price ask level
-        std::optional<Decimal> best_price;
-        std::string best_venue;
-
-        for (const auto& [price, venues] : asks_) {
-            if ((!best_price || price < *best_price) && !venues.empty()) {
-                best_price = price;
-                best_venue = venues[0].first;
-            }
-        }
-
-        if (best_venue.empty() || !best_price) return std::nullopt;
-        return std::make_pair(best_venue, *best_price);
+    template <typename Ladder>
+    static std::optional<VenueQuote> top(const Ladder& ladder) {
+        if (ladder.empty()) return std::nullopt;
+        const auto& [price, venues] = *ladder.begin();
+        return VenueQuote{price, venues[0].first, venues[0].second};
     }
 
-    // Find best venue for selling amount: (venue, price)
-    [[nodiscard]] std::optional<std::pair<std::string, Decimal>> best_venue_sell(Decimal amount) const {
-        if (bids_.empty()) return std::nullopt;
-
-        // Find the highest price bid level
-        std::optional<Decimal> best_price;
-        std::string best_venue;
+    static bool same_quote(const std::optional<VenueQuote>& a, const std::optional<VenueQuote>& b) {
+        if (!a || !b) return !a && !b;
+        return a->price == b->price && a->quantity == b->quantity && a->venue == b->venue;
+    }
 
-        for (const auto& [price, venues] : bids_) {
-            if ((!best_price || price > *best_price) && !venues.empty()) {
-                best_price = price;
-                best_venue = venues[0].first;
-            }
+    // Republish the BBO if it changed; caller holds the unique lock
+    void publish_bbo() {
+        auto current = std::atomic_load_explicit(&bbo_, std::memory_order_relaxed);
+        auto bid = top(bids_);
+        auto ask = top(asks_);
+        if (same_quote(bid, current->bid) && same_quote(ask, current->ask) &&
+            timestamp_ == current->timestamp) {
+            return;
         }
-
-        if (best_venue.empty() || !best_price) return std::nullopt;
-        return std::make_pair(best_venue, *best_price);
+        auto next = std::make_shared<ConsolidatedBbo>();
+        next->bid = std::move(bid);
+        next->ask = std::move(ask);
+        next->timestamp = timestamp_;
+        next->version = current->version + 1;
+        std::atomic_store_explicit(&bbo_, std::shared_ptr<const ConsolidatedBbo>(std::move(next)),
+                                   std::memory_order_release);
     }
 
-    void clear() {
-        bids_.clear();
-        asks_.clear();
-        timestamp_ = 0;
+    // Caller holds other's lock (and ours when assigning)
+    void move_from(AggregatedOrderbook& other) {
+        symbol_ = std::move(other.symbol_);
+        timestamp_ = other.timestamp_;
+        venues_ = std::move(other.venues_);
+        bids_ = std::move(other.bids_);
+        asks_ = std::move(other.asks_);
+        std::atomic_store(&bbo_, std::atomic_load(&other.bbo_));
     }
 
-private:
     std::string symbol_;
     int64_t timestamp_ = 0;
 
-    // price -> [(venue, qty), ...]
-    PriceLevelMap bids_;
-    PriceLevelMap asks_;
+    mutable std::shared_mutex mutex_;
+    std::unordered_map<std::string, VenueLevels> venues_;
+    BidLadder bids_;
+    AskLadder asks_;
+    std::shared_ptr<const ConsolidatedBbo> bbo_;
 };
 
 }  // namespace lx::trading
@@ -6,11 +6,13 @@
 #include <lx/trading/config.hpp>
 #include <lx/trading/types.hpp>
 #include <atomic>
+#include <deque>
+#include <memory>
 #include <mutex>
-#include <shared_mutex>
 #include <stdexcept>
 #include <string>
 #include <unordered_map>
+#include <vector>
 
 namespace lx::trading {
 
@@ -20,10 +22,65 @@ public:
     explicit RiskError(const std::string& msg) : std::runtime_error(msg) {}
 };
 
+// Risk state of one asset (position) or symbol (orders); scaled Decimals
+// in atomics so checks never take a lock. Lives as long as its manager.
+struct RiskSlot {
+    std::atomic<int64_t> position{0};
+    std::atomic<int64_t> reserved_buy{0};       // Quantity awaiting acknowledgement
+    std::atomic<int64_t> reserved_sell{0};
+    std::atomic<int64_t> reserved_notional{0};
+    std::atomic<int> open_orders{0};
+    std::atomic<bool> has_position{false};      // Listed by positions()
+    int64_t position_limit = 0;                 // Tightest configured limit; 0 = none
+};
+
+class RiskManager;
+
+// Headroom reserved by RiskManager::reserve() for one order in flight.
+// acknowledge() once the venue accepts the order: its open-order slot
+// stays counted until order_closed(), the quantity and notional return
+// to the pool. reject(), or destruction without either, releases all.
+class RiskReservation {
+public:
+    RiskReservation() = default;
+    ~RiskReservation() { reject(); }
+
+    RiskReservation(RiskReservation&& other) noexcept { *this = std::move(other); }
+    RiskReservation& operator=(RiskReservation&& other) noexcept;
+    RiskReservation(const RiskReservation&) = delete;
+    RiskReservation& operator=(const RiskReservation&) = delete;
+
+    void acknowledge() noexcept;
+    void reject() noexcept;
+
+    [[nodiscard]] bool active() const noexcept { return symbol_ != nullptr; }
+
+private:
+    friend class RiskManager;
+
+    void release_exposure() noexcept;
+
+    RiskSlot* symbol_ = nullptr;
+    RiskSlot* asset_ = nullptr;
+    Side side_ = Side::Buy;
+    int64_t quantity_ = 0;
+    int64_t notional_ = 0;
+};
+
 // Thread-safe risk manager
+//
+// Positions, open orders, reservations and daily PnL live in atomics, one
+// RiskSlot per asset and per symbol. Slots are found through an immutable
+// map that is copied and republished when a new name first appears, so
+// the order path is a hash lookup, a few relaxed loads and one CAS per
+// limit; only the first order on a new name takes slots_mutex_.
 class RiskManager {
 public:
     explicit RiskManager(const RiskConfig& config);
+    ~RiskManager();
+
+    RiskManager(const RiskManager&) = delete;
+    RiskManager& operator=(const RiskManager&) = delete;
 
     // Configuration
     [[nodiscard]] bool is_enabled() const noexcept { return config_.enabled; }
@@ -37,6 +94,11 @@ public:
     // Order validation - throws RiskError if invalid
     void validate_order(const OrderRequest& request);
 
+    // Validate and reserve in one step: claims an open-order slot, the
+    // order's position headroom and its pending notional with CAS, so
+    // concurrent orders cannot jointly overshoot a limit. Throws RiskError.
+    [[nodiscard]] RiskReservation reserve(const OrderRequest& request);
+
     // Position tracking
     void update_position(const std::string& asset, Decimal quantity, Side side);
     [[nodiscard]] Decimal position(const std::string& asset) const;
@@ -59,17 +121,24 @@ public:
     [[nodiscard]] bool check_open_orders(const std::string& symbol) const noexcept;
 
 private:
-    RiskConfig config_;
-    std::atomic<bool> kill_switch_{false};
+    using SlotMap = std::unordered_map<std::string, RiskSlot*>;
 
-    mutable std::shared_mutex position_mutex_;
-    std::unordered_map<std::string, Decimal> positions_;
+    // Existing slot or nullptr; lock-free
+    [[nodiscard]] RiskSlot* find_slot(const std::string& name) const noexcept;
+    // Existing slot, or create and publish one
+    RiskSlot& slot(const std::string& name);
+    [[nodiscard]] int64_t position_limit(const std::string& asset) const noexcept;
+    // Kill switch, order size and daily loss
+    void check_stateless(const OrderRequest& request) const;
 
-    mutable std::shared_mutex pnl_mutex_;
-    Decimal daily_pnl_;
+    RiskConfig config_;
+    std::atomic<bool> kill_switch_{false};
+    std::atomic<int64_t> daily_pnl_{0};
 
-    mutable std::shared_mutex orders_mutex_;
-    std::unordered_map<std::string, int> open_orders_;
+    std::atomic<const SlotMap*> slot_map_;
+    std::mutex slots_mutex_;                        // Slot creation only
+    std::deque<RiskSlot> slots_;
+    std::vector<std::unique_ptr<const SlotMap>> slot_maps_;   // Every published map; readers may hold any
 };
 
 // RAII order tracker
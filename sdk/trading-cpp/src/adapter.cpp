@@ -1,10 +1,48 @@
 // LX Trading SDK - Adapter Base Implementation
 
 #include <lx/trading/adapter.hpp>
+#include <lx/trading/orderbook.hpp>
 
 namespace lx::trading {
 
-// Base adapter has no implementation - pure interface
-// This file exists for potential future common functionality
+std::vector<std::future<Order>> VenueAdapter::place_orders(
+    const std::vector<OrderRequest>& requests) {
+    std::vector<std::future<Order>> results;
+    results.reserve(requests.size());
+    for (const auto& request : requests) {
+        results.push_back(place_order(request));
+    }
+    return results;
+}
+
+std::vector<std::future<Order>> VenueAdapter::cancel_orders(
+    const std::vector<OrderRef>& orders) {
+    std::vector<std::future<Order>> results;
+    results.reserve(orders.size());
+    for (const auto& [order_id, symbol] : orders) {
+        results.push_back(cancel_order(order_id, symbol));
+    }
+    return results;
+}
+
+std::vector<std::future<Ticker>> VenueAdapter::get_tickers(
+    const std::vector<std::string>& symbols) {
+    std::vector<std::future<Ticker>> results;
+    results.reserve(symbols.size());
+    for (const auto& symbol : symbols) {
+        results.push_back(get_ticker(symbol));
+    }
+    return results;
+}
+
+std::vector<std::future<std::unique_ptr<Orderbook>>> VenueAdapter::get_orderbooks(
+    const std::vector<std::string>& symbols, std::optional<int> depth) {
+    std::vector<std::future<std::unique_ptr<Orderbook>>> results;
+    results.reserve(symbols.size());
+    for (const auto& symbol : symbols) {
+        results.push_back(get_orderbook(symbol, depth));
+    }
+    return results;
+}
 
 }  // namespace lx::trading
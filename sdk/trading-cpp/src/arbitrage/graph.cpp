@@ -0,0 +1,343 @@
+// LX Trading SDK - Multi-Leg Arbitrage Graph Implementation
+
+#include <lx/trading/arbitrage/graph.hpp>
+#include <algorithm>
+#include <cmath>
+#include <limits>
+
+namespace lx::trading::arbitrage {
+
+namespace {
+
+constexpr double INF = std::numeric_limits<double>::infinity();
+constexpr uint32_t NONE = std::numeric_limits<uint32_t>::max();
+
+std::pair<std::string, std::string> split_symbol(const std::string& symbol, const std::string& quote) {
+    const auto pos = symbol.find_first_of("-/");
+    if (pos == std::string::npos) {
+        return {symbol, quote};
+    }
+    return {symbol.substr(0, pos), symbol.substr(pos + 1)};
+}
+
+}  // namespace
+
+ArbitrageGraph::ArbitrageGraph(CycleConfig config, TransferCostFn transfer_cost)
+    : config_(std::move(config)),
+      transfer_cost_(std::move(transfer_cost)),
+      fee_rate_(config_.fee_bps.to_double() / 10000.0),
+      threshold_(-std::log1p(config_.min_profit_bps.to_double() / 10000.0)) {}
+
+std::vector<ArbitrageOpportunity> ArbitrageGraph::update_price(const PriceSource& source) {
+    std::vector<ArbitrageOpportunity> opportunities;
+    const auto [base, quote] = split_symbol(source.symbol, config_.quote_asset);
+    if (base.empty() || quote.empty() || base == quote) {
+        return opportunities;
+    }
+
+    // Latest quote per market, referenced by its trade edges. A market
+    // coming back from stale is as good as new.
+    const int64_t now = now_ms();
+    const std::string key = source.chain_id + "|" + source.venue + "|" + source.symbol;
+    auto [it, inserted] = source_index_.try_emplace(key, static_cast<uint32_t>(sources_.size()));
+    bool revived = false;
+    if (inserted) {
+        sources_.push_back(source);
+    } else {
+        revived = now - sources_[it->second].timestamp >= config_.max_price_age_ms;
+        sources_[it->second] = source;
+    }
+    const uint32_t source_id = it->second;
+
+    if (quote == config_.quote_asset && source.bid.is_positive() && source.ask.is_positive()) {
+        usd_prices_[base] = source.mid_price().to_double();
+    }
+
+    // New nodes come with transfer edges to every other holder of the asset
+    std::vector<uint32_t> changed;
+    const size_t first_new_edge = edges_.size();
+    const uint32_t quote_node = node(source.chain_id, source.venue, quote);
+    const uint32_t base_node = node(source.chain_id, source.venue, base);
+    for (size_t e = first_new_edge; e < edges_.size(); ++e) {
+        changed.push_back(static_cast<uint32_t>(e));
+    }
+
+    const double ask = source.ask.to_double();
+    const double bid = source.bid.to_double();
+    const std::pair<uint32_t, double> trades[] = {
+        {edge(quote_node, base_node, EdgeKind::Buy),
+         ask > 0.0 ? -std::log((1.0 - fee_rate_) / ask) : INF},
+        {edge(base_node, quote_node, EdgeKind::Sell),
+         bid > 0.0 ? -std::log(bid * (1.0 - fee_rate_)) : INF},
+    };
+    for (const auto& [id, weight] : trades) {
+        Edge& e = edges_[id];
+        const bool fresh = e.source == NONE;
+        const bool cheaper = weight < e.weight;
+        e.weight = weight;
+        e.source = source_id;
+        // A dearer edge cannot close a new cycle
+        if (fresh || cheaper || revived) {
+            changed.push_back(id);
+        }
+    }
+
+    for (const uint32_t id : changed) {
+        if (usable(edges_[id], now)) {
+            search(id, now, opportunities);
+        }
+    }
+
+    // The same cycle can close through more than one changed edge
+    std::sort(opportunities.begin(), opportunities.end(),
+              [](const auto& a, const auto& b) { return a.id < b.id; });
+    opportunities.erase(std::unique(opportunities.begin(), opportunities.end(),
+                                    [](const auto& a, const auto& b) { return a.id == b.id; }),
+                        opportunities.end());
+    return opportunities;
+}
+
+void ArbitrageGraph::refresh_transfer_costs() {
+    for (Edge& e : edges_) {
+        if (e.kind == EdgeKind::Transfer) {
+            price_transfer(e);
+        }
+    }
+}
+
+uint32_t ArbitrageGraph::node(const std::string& chain_id, const std::string& venue,
+                              const std::string& asset) {
+    const std::string key = chain_id + "|" + venue + "|" + asset;
+    auto [it, inserted] = node_index_.try_emplace(key, static_cast<uint32_t>(nodes_.size()));
+    if (!inserted) {
+        return it->second;
+    }
+
+    const uint32_t id = it->second;
+    nodes_.push_back(Node{chain_id, venue, asset, {}});
+    auto& holders = asset_nodes_[asset];
+    for (const uint32_t other : holders) {
+        price_transfer(edges_[edge(id, other, EdgeKind::Transfer)]);
+        price_transfer(edges_[edge(other, id, EdgeKind::Transfer)]);
+    }
+    holders.push_back(id);
+    return id;
+}
+
+uint32_t ArbitrageGraph::edge(uint32_t from, uint32_t to, EdgeKind kind) {
+    const uint64_t key = (static_cast<uint64_t>(from) << 32) | to;
+    auto [it, inserted] = edge_index_.try_emplace(key, static_cast<uint32_t>(edges_.size()));
+    if (inserted) {
+        edges_.push_back(Edge{from, to, kind, INF, NONE, Decimal::zero(), Decimal::zero()});
+        nodes_[from].out.push_back(it->second);
+    }
+    return it->second;
+}
+
+void ArbitrageGraph::price_transfer(Edge& e) {
+    const Node& from = nodes_[e.from];
+    const Node& to = nodes_[e.to];
+    if (transfer_cost_) {
+        std::tie(e.gas_cost, e.bridge_cost) = transfer_cost_(from.chain_id, to.chain_id);
+    }
+    // Fixed costs as a share of the notional they are spread over
+    const double notional = config_.notional_usd.to_double();
+    const double share = notional > 0.0
+        ? (e.gas_cost.to_double() + e.bridge_cost.to_double()) / notional
+        : 0.0;
+    e.weight = share < 1.0 ? -std::log1p(-share) : INF;
+}
+
+bool ArbitrageGraph::usable(const Edge& e, int64_t now) const {
+    if (!std::isfinite(e.weight)) {
+        return false;
+    }
+    if (e.kind == EdgeKind::Transfer) {
+        return true;
+    }
+    return e.source != NONE && now - sources_[e.source].timestamp < config_.max_price_age_ms;
+}
+
+void ArbitrageGraph::search(uint32_t changed, int64_t now, std::vector<ArbitrageOpportunity>& out) {
+    if (config_.max_legs < 2) {
+        return;
+    }
+    const Edge& closing = edges_[changed];
+    const uint32_t start = closing.to;
+    const uint32_t target = closing.from;
+    const size_t hops = config_.max_legs - 1;
+    const size_t n = nodes_.size();
+
+    // dist_[h][x]: cheapest walk start -> x of at most h edges, its last
+    // edge in pred_[h][x] (NONE: same walk as at h - 1)
+    dist_.resize(hops + 1);
+    pred_.resize(hops + 1);
+    dist_[0].assign(n, INF);
+    pred_[0].assign(n, NONE);
+    dist_[0][start] = 0.0;
+    frontier_.assign(1, start);
+
+    size_t top = 0;     // Deepest level computed; later ones would repeat it
+    for (size_t h = 1; h <= hops && !frontier_.empty(); ++h) {
+        top = h;
+        dist_[h] = dist_[h - 1];
+        pred_[h].assign(n, NONE);
+        next_frontier_.clear();
+        for (const uint32_t x : frontier_) {
+            for (const uint32_t id : nodes_[x].out) {
+                const Edge& e = edges_[id];
+                if (id == changed || !usable(e, now)) continue;
+                const double weight = dist_[h - 1][x] + e.weight;
+                if (weight < dist_[h][e.to]) {
+                    if (pred_[h][e.to] == NONE) {
+                        next_frontier_.push_back(e.to);
+                    }
+                    dist_[h][e.to] = weight;
+                    pred_[h][e.to] = id;
+                }
+            }
+        }
+        frontier_.swap(next_frontier_);
+    }
+
+    const double weight = dist_[top][target] + closing.weight;
+    if (!(weight < threshold_)) {
+        return;
+    }
+
+    // Walk back from the target; a walk that revisits a node contains a
+    // shorter cycle, found from its own edges
+    std::vector<uint32_t> path;
+    uint32_t x = target;
+    for (size_t h = top; h > 0; --h) {
+        const uint32_t id = pred_[h][x];
+        if (id == NONE) continue;
+        path.push_back(id);
+        x = edges_[id].from;
+    }
+    if (x != start) {
+        return;
+    }
+    std::vector<uint32_t> cycle{changed};
+    cycle.insert(cycle.end(), path.rbegin(), path.rend());
+
+    std::vector<uint32_t> visited;
+    for (const uint32_t id : cycle) {
+        visited.push_back(edges_[id].from);
+    }
+    std::sort(visited.begin(), visited.end());
+    if (std::adjacent_find(visited.begin(), visited.end()) != visited.end()) {
+        return;
+    }
+
+    ArbitrageOpportunity opp;
+    if (build(cycle, weight, opp)) {
+        out.push_back(std::move(opp));
+    }
+}
+
+bool ArbitrageGraph::build(const std::vector<uint32_t>& edges, double weight,
+                           ArbitrageOpportunity& opp) const {
+    // Start (and account) in the quote asset when the cycle passes through it
+    std::vector<uint32_t> cycle = edges;
+    auto first = std::find_if(cycle.begin(), cycle.end(), [this](uint32_t id) {
+        return nodes_[edges_[id].from].asset == config_.quote_asset;
+    });
+    if (first == cycle.end()) {
+        first = std::min_element(cycle.begin(), cycle.end());
+    }
+    std::rotate(cycle.begin(), first, cycle.end());
+
+    const std::string& start_asset = nodes_[edges_[cycle.front()].from].asset;
+    const double usd = usd_price(start_asset);
+    if (usd <= 0.0) {
+        return false;       // Cannot size or value it
+    }
+
+    const int64_t now = now_ms();
+    const double start_amount = config_.notional_usd.to_double() / usd;
+    double amount = start_amount;
+    double scale = 1.0;
+    double freshness = 0.0;
+    size_t trades = 0;
+    Decimal gas_cost, bridge_cost;
+    std::vector<std::pair<double, double>> legs;        // (in, out) unscaled
+    const PriceSource* first_trade = nullptr;
+    const PriceSource* last_trade = nullptr;
+
+    for (const uint32_t id : cycle) {
+        const Edge& e = edges_[id];
+        double out = amount;
+        if (e.kind == EdgeKind::Transfer) {
+            gas_cost = gas_cost + e.gas_cost;
+            bridge_cost = bridge_cost + e.bridge_cost;
+        } else {
+            const PriceSource& src = sources_[e.source];
+            const double base = e.kind == EdgeKind::Buy ? amount / src.ask.to_double() : amount;
+            out = e.kind == EdgeKind::Buy ? base * (1.0 - fee_rate_)
+                                          : amount * src.bid.to_double() * (1.0 - fee_rate_);
+            scale = std::min(scale, src.liquidity.to_double() / base);
+            const double age = static_cast<double>(now - src.timestamp);
+            freshness += std::max(0.0, 1.0 - age / static_cast<double>(config_.max_price_age_ms));
+            ++trades;
+            if (!first_trade) first_trade = &src;
+            last_trade = &src;
+        }
+        legs.emplace_back(amount, out);
+        amount = out;
+    }
+    if (scale <= 0.0) {
+        return false;
+    }
+
+    const double gross = (amount - start_amount) * scale * usd;
+    const Decimal net = Decimal::from_double(gross) - gas_cost - bridge_cost;
+    if (net < config_.min_profit_usd) {
+        return false;
+    }
+
+    bool one_venue = true;
+    std::string id = "cycle";
+    for (size_t i = 0; i < cycle.size(); ++i) {
+        const Edge& e = edges_[cycle[i]];
+        const Node& from = nodes_[e.from];
+        const Node& to = nodes_[e.to];
+        one_venue = one_venue && e.kind != EdgeKind::Transfer;
+        id += "-" + to.venue + ":" + to.asset;
+
+        Route route;
+        route.chain_id = to.chain_id;
+        route.venue = to.venue;
+        route.action = e.kind == EdgeKind::Buy ? "buy" : e.kind == EdgeKind::Sell ? "sell" : "transfer";
+        route.token_in = from.asset;
+        route.token_out = to.asset;
+        route.amount_in = Decimal::from_double(legs[i].first * scale);
+        route.expected_out = Decimal::from_double(legs[i].second * scale);
+        route.min_amount_out = Decimal::from_double(legs[i].second * scale * 0.99);
+        opp.routes.push_back(std::move(route));
+    }
+
+    opp.id = id + "-" + std::to_string(now);
+    opp.arb_type = one_venue && cycle.size() == 3 ? ArbType::Triangular : ArbType::MultiHop;
+    if (first_trade) opp.buy_source = *first_trade;
+    if (last_trade) opp.sell_source = *last_trade;
+    opp.spread_bps = Decimal::from_double(std::expm1(-weight) * 10000.0);
+    opp.estimated_pnl = Decimal::from_double(gross);
+    opp.max_size = Decimal::from_double(start_amount * scale);
+    opp.gas_cost_usd = gas_cost;
+    opp.bridge_cost_usd = bridge_cost;
+    opp.net_pnl = net;
+    opp.confidence = trades ? freshness / static_cast<double>(trades) : 0.0;
+    opp.expires_at = now + 3000;
+    return true;
+}
+
+double ArbitrageGraph::usd_price(const std::string& asset) const {
+    if (asset == config_.quote_asset) {
+        return 1.0;
+    }
+    auto it = usd_prices_.find(asset);
+    return it != usd_prices_.end() ? it->second : 0.0;
+}
+
+}  // namespace lx::trading::arbitrage
@@ -3,37 +3,72 @@
 #include <lx/trading/arbitrage/scanner.hpp>
 #include <algorithm>
 #include <chrono>
+#include <iterator>
 
 namespace lx::trading::arbitrage {
 
 Scanner::Scanner(ScannerConfig config)
-    : config_(std::move(config)) {}
+    : config_(std::move(config)) {
+    if (config_.cycles) {
+        graph_ = std::make_unique<ArbitrageGraph>(
+            *config_.cycles,
+            [this](const std::string& source, const std::string& dest) {
+                return calculate_costs(source, dest);
+            });
+    }
+}
 
 Scanner::~Scanner() {
     stop();
 }
 
 void Scanner::add_chain(const CrossChainInfo& info) {
-    std::lock_guard<std::mutex> lock(chains_mutex_);
-    chains_[info.chain_id] = info;
+    {
+        std::lock_guard<std::mutex> lock(chains_mutex_);
+        chains_[info.chain_id] = info;
+        cost_cache_.clear();
+    }
+
+    if (graph_) {
+        std::lock_guard<std::mutex> lock(graph_mutex_);
+        graph_->refresh_transfer_costs();
+    }
 }
 
 void Scanner::update_price(const PriceSource& source) {
-    std::lock_guard<std::mutex> lock(prices_mutex_);
-    auto& sources = prices_[source.symbol];
-
-    // Update existing or append new
-    bool found = false;
-    for (auto& s : sources) {
-        if (s.chain_id == source.chain_id && s.venue == source.venue) {
-            s = source;
-            found = true;
-            break;
+    {
+        std::unique_lock<std::mutex> lock(prices_mutex_);
+        auto& sources = prices_[source.symbol];
+
+        // Update existing or append new
+        bool found = false;
+        for (auto& s : sources) {
+            if (s.chain_id == source.chain_id && s.venue == source.venue) {
+                s = source;
+                found = true;
+                break;
+            }
+        }
+
+        if (!found) {
+            sources.push_back(source);
+        }
+
+        if (config_.event_driven) {
+            dirty_.insert(source.symbol);
+            lock.unlock();
+            dirty_cv_.notify_one();
         }
     }
 
-    if (!found) {
-        sources.push_back(source);
+    // Only cycles through the edges this quote changed
+    if (graph_) {
+        std::vector<ArbitrageOpportunity> cycles;
+        {
+            std::lock_guard<std::mutex> lock(graph_mutex_);
+            cycles = graph_->update_price(source);
+        }
+        emit(cycles);
     }
 }
 
@@ -47,11 +82,20 @@ void Scanner::start() {
         return;  // Already running
     }
 
-    scan_thread_ = std::make_unique<std::thread>(&Scanner::scan_loop, this);
+    if (config_.event_driven) {
+        scan_thread_ = std::make_unique<std::thread>(&Scanner::event_loop, this);
+    } else {
+        scan_thread_ = std::make_unique<std::thread>(&Scanner::scan_loop, this);
+    }
 }
 
 void Scanner::stop() {
-    running_.store(false);
+    {
+        // Under the lock so the event worker cannot miss the wakeup
+        std::lock_guard<std::mutex> lock(prices_mutex_);
+        running_.store(false);
+    }
+    dirty_cv_.notify_all();
 
     if (scan_thread_ && scan_thread_->joinable()) {
         scan_thread_->join();
@@ -61,19 +105,58 @@ void Scanner::stop() {
 
 void Scanner::scan_loop() {
     while (running_.load()) {
-        auto opportunities = scan();
+        emit(scan());
 
-        // Emit opportunities
+        std::this_thread::sleep_for(std::chrono::milliseconds(config_.scan_interval_ms));
+    }
+}
+
+void Scanner::event_loop() {
+    std::unordered_set<std::string> dirty;
+    std::vector<std::pair<std::string, std::vector<PriceSource>>> work;
+
+    while (true) {
         {
-            std::lock_guard<std::mutex> lock(callbacks_mutex_);
-            for (const auto& opp : opportunities) {
-                for (const auto& callback : callbacks_) {
-                    callback(opp);
+            std::unique_lock<std::mutex> lock(prices_mutex_);
+            dirty_cv_.wait(lock, [this] { return !dirty_.empty() || !running_.load(); });
+            if (!running_.load()) {
+                return;
+            }
+
+            // Take the dirty set and copy those symbols' sources so the
+            // evaluation runs without blocking update_price
+            dirty.swap(dirty_);
+            work.clear();
+            for (const auto& symbol : dirty) {
+                auto it = prices_.find(symbol);
+                if (it != prices_.end() && it->second.size() >= 2) {
+                    work.emplace_back(symbol, it->second);
                 }
             }
+            dirty.clear();
         }
 
-        std::this_thread::sleep_for(std::chrono::milliseconds(config_.scan_interval_ms));
+        std::vector<ArbitrageOpportunity> opportunities;
+        for (const auto& [symbol, sources] : work) {
+            auto opps = scan_symbol(symbol, sources);
+            opportunities.insert(opportunities.end(),
+                                 std::make_move_iterator(opps.begin()),
+                                 std::make_move_iterator(opps.end()));
+        }
+        emit(opportunities);
+    }
+}
+
+void Scanner::emit(const std::vector<ArbitrageOpportunity>& opportunities) {
+    if (opportunities.empty()) {
+        return;
+    }
+
+    std::lock_guard<std::mutex> lock(callbacks_mutex_);
+    for (const auto& opp : opportunities) {
+        for (const auto& callback : callbacks_) {
+            callback(opp);
+        }
     }
 }
 
@@ -83,33 +166,46 @@ std::vector<ArbitrageOpportunity> Scanner::scan() {
     std::lock_guard<std::mutex> lock(prices_mutex_);
 
     for (const auto& [symbol, sources] : prices_) {
-        if (sources.size() < 2) {
-            continue;
-        }
+        auto opps = scan_symbol(symbol, sources);
+        opportunities.insert(opportunities.end(),
+                             std::make_move_iterator(opps.begin()),
+                             std::make_move_iterator(opps.end()));
+    }
 
-        int64_t now = now_ms();
+    return opportunities;
+}
 
-        // Filter stale prices
-        std::vector<PriceSource> valid_sources;
-        for (const auto& s : sources) {
-            if (now - s.timestamp < config_.max_price_age_ms) {
-                valid_sources.push_back(s);
-            }
-        }
+std::vector<ArbitrageOpportunity> Scanner::scan_symbol(
+    const std::string& symbol,
+    const std::vector<PriceSource>& sources) const {
 
-        if (valid_sources.size() < 2) {
-            continue;
-        }
+    if (sources.size() < 2) {
+        return {};
+    }
 
-        // Simple arbitrage
-        auto simple_opps = find_simple_arb(symbol, valid_sources);
-        opportunities.insert(opportunities.end(), simple_opps.begin(), simple_opps.end());
+    int64_t now = now_ms();
 
-        // CEX-DEX arbitrage
-        auto cex_dex_opps = find_cex_dex_arb(symbol, valid_sources);
-        opportunities.insert(opportunities.end(), cex_dex_opps.begin(), cex_dex_opps.end());
+    // Filter stale prices
+    std::vector<PriceSource> valid_sources;
+    for (const auto& s : sources) {
+        if (now - s.timestamp < config_.max_price_age_ms) {
+            valid_sources.push_back(s);
+        }
     }
 
+    if (valid_sources.size() < 2) {
+        return {};
+    }
+
+    // Simple arbitrage
+    auto opportunities = find_simple_arb(symbol, valid_sources);
+
+    // CEX-DEX arbitrage
+    auto cex_dex_opps = find_cex_dex_arb(symbol, valid_sources);
+    opportunities.insert(opportunities.end(),
+                         std::make_move_iterator(cex_dex_opps.begin()),
+                         std::make_move_iterator(cex_dex_opps.end()));
+
     return opportunities;
 }
 
@@ -306,6 +402,12 @@ std::pair<Decimal, Decimal> Scanner::calculate_costs(
 
     std::lock_guard<std::mutex> lock(chains_mutex_);
 
+    std::string key = source_chain + "|" + dest_chain;
+    auto cached = cost_cache_.find(key);
+    if (cached != cost_cache_.end()) {
+        return cached->second;
+    }
+
     auto src_it = chains_.find(source_chain);
     auto dst_it = chains_.find(dest_chain);
 
@@ -329,6 +431,7 @@ std::pair<Decimal, Decimal> Scanner::calculate_costs(
         }
     }
 
+    cost_cache_.emplace(std::move(key), std::make_pair(gas_cost, bridge_cost));
     return {gas_cost, bridge_cost};
 }
 
@@ -0,0 +1,839 @@
+// LX Trading SDK - Backtesting Implementation
+
+#include <lx/trading/backtest.hpp>
+#include <lux/clock.hpp>
+#include <lux/journal.hpp>
+#include <lux/orderbook.hpp>
+#include <algorithm>
+#include <atomic>
+#include <deque>
+#include <fstream>
+#include <map>
+#include <queue>
+#include <sstream>
+#include <stdexcept>
+#include <thread>
+#include <variant>
+
+namespace lx::trading {
+
+static_assert(Decimal::SCALE == lux::PRICE_MULTIPLIER, "tape values pass to the books unconverted");
+
+namespace {
+
+// Book order ids: journal orders keep theirs, recorded liquidity and tape
+// takers use BACKGROUND_ID_BASE + n, strategy orders STRATEGY_ID_BASE + n
+constexpr uint64_t BACKGROUND_ID_BASE = 1ull << 61;
+constexpr uint64_t STRATEGY_ID_BASE = 1ull << 62;
+
+lux::Side to_lux(Side side) {
+    return side == Side::Buy ? lux::Side::Buy : lux::Side::Sell;
+}
+
+Side from_lux(lux::Side side) {
+    return side == lux::Side::Buy ? Side::Buy : Side::Sell;
+}
+
+double to_double(int64_t fixed) {
+    return static_cast<double>(fixed) / Decimal::SCALE;
+}
+
+int64_t to_ms(int64_t ns) {
+    return ns / 1000000;
+}
+
+std::string trim(std::string s) {
+    const auto first = s.find_first_not_of(" \t\r");
+    const auto last = s.find_last_not_of(" \t\r");
+    return first == std::string::npos ? std::string() : s.substr(first, last - first + 1);
+}
+
+}  // namespace
+
+// =============================================================================
+// MarketData
+// =============================================================================
+
+std::optional<uint32_t> MarketData::find_symbol(std::string_view symbol) const {
+    auto it = std::find(symbols_.begin(), symbols_.end(), symbol);
+    if (it == symbols_.end()) return std::nullopt;
+    return static_cast<uint32_t>(it - symbols_.begin());
+}
+
+std::shared_ptr<const MarketData> MarketData::load_csv(const std::string& path) {
+    std::ifstream in(path);
+    if (!in) {
+        throw std::runtime_error("cannot open " + path);
+    }
+
+    MarketDataBuilder builder;
+    std::string line;
+    size_t line_no = 0;
+    while (std::getline(in, line)) {
+        ++line_no;
+        line = trim(line);
+        if (line.empty()) continue;
+
+        std::vector<std::string> fields;
+        std::stringstream ss(line);
+        std::string field;
+        while (std::getline(ss, field, ',')) {
+            fields.push_back(trim(field));
+        }
+
+        const auto bad = [&] {
+            return std::runtime_error(path + ":" + std::to_string(line_no) + ": malformed: " + line);
+        };
+        if (fields.size() != 6) throw bad();
+
+        int64_t timestamp = 0;
+        try {
+            timestamp = std::stoll(fields[0]);
+        } catch (const std::exception&) {
+            if (line_no == 1) continue;     // Header
+            throw bad();
+        }
+
+        Side side;
+        if (fields[3] == "buy" || fields[3] == "bid" || fields[3] == "b") {
+            side = Side::Buy;
+        } else if (fields[3] == "sell" || fields[3] == "ask" || fields[3] == "s") {
+            side = Side::Sell;
+        } else {
+            throw bad();
+        }
+
+        Decimal price, quantity;
+        try {
+            price = Decimal::from_string(fields[4]);
+            quantity = Decimal::from_string(fields[5]);
+        } catch (const std::exception&) {
+            throw bad();
+        }
+
+        if (fields[2] == "L") {
+            builder.level(timestamp, fields[1], side, price, quantity);
+        } else if (fields[2] == "T") {
+            builder.trade(timestamp, fields[1], side, price, quantity);
+        } else {
+            throw bad();
+        }
+    }
+    return builder.build();
+}
+
+std::shared_ptr<const MarketData> MarketData::load_journal(
+    const std::string& path, const std::unordered_map<uint64_t, std::string>& names) {
+    auto reader = lux::JournalReader::open(path);
+    if (!reader) {
+        return nullptr;
+    }
+
+    MarketDataBuilder builder;
+    std::unordered_map<uint64_t, uint32_t> symbols;     // Engine id -> tape index
+    const auto symbol_of = [&](uint64_t id) {
+        auto it = symbols.find(id);
+        if (it != symbols.end()) return it->second;
+        auto name = names.find(id);
+        const uint32_t index = builder.add_symbol(name != names.end() ? name->second : std::to_string(id));
+        symbols.emplace(id, index);
+        return index;
+    };
+
+    int64_t last_time = 0;
+    for (const lux::JournalRecord& record : *reader) {
+        MarketEvent event{};
+        event.timestamp = last_time;
+        event.order_id = record.order_id;
+        switch (record.type) {
+            case lux::JournalRecordType::AddSymbol:
+                symbol_of(record.symbol_id);
+                continue;
+            case lux::JournalRecordType::Place:
+                last_time = std::max(last_time, static_cast<int64_t>(record.order.timestamp.count()));
+                builder.journal_order(last_time, symbol_of(record.order.symbol_id), record.order);
+                continue;
+            case lux::JournalRecordType::Cancel:
+                event.kind = MarketEventKind::Cancel;
+                break;
+            case lux::JournalRecordType::Modify:
+                event.kind = MarketEventKind::Modify;
+                event.price = record.new_price;
+                event.quantity = record.new_quantity;
+                break;
+            case lux::JournalRecordType::Reduce:
+                event.kind = MarketEventKind::Reduce;
+                event.quantity = record.new_quantity;
+                break;
+            default:
+                continue;       // Removals, auctions and marks carry no flow
+        }
+        event.symbol = symbol_of(record.symbol_id);
+        builder.journal_event(event);
+    }
+    return builder.build();
+}
+
+// =============================================================================
+// MarketDataBuilder
+// =============================================================================
+
+uint32_t MarketDataBuilder::add_symbol(std::string_view symbol) {
+    if (auto index = data_->find_symbol(symbol)) {
+        return *index;
+    }
+    data_->symbols_.emplace_back(symbol);
+    return static_cast<uint32_t>(data_->symbols_.size() - 1);
+}
+
+MarketDataBuilder& MarketDataBuilder::level(int64_t timestamp, std::string_view symbol, Side side,
+                                            Decimal price, Decimal quantity) {
+    data_->events_.push_back({timestamp, add_symbol(symbol), MarketEventKind::Level, side,
+                              price.scaled_value(), quantity.scaled_value(), 0});
+    return *this;
+}
+
+MarketDataBuilder& MarketDataBuilder::trade(int64_t timestamp, std::string_view symbol, Side aggressor,
+                                            Decimal price, Decimal quantity) {
+    data_->events_.push_back({timestamp, add_symbol(symbol), MarketEventKind::Trade, aggressor,
+                              price.scaled_value(), quantity.scaled_value(), 0});
+    return *this;
+}
+
+MarketDataBuilder& MarketDataBuilder::journal_order(int64_t timestamp, uint32_t symbol,
+                                                    const lux::Order& order) {
+    data_->events_.push_back({timestamp, symbol, MarketEventKind::Place, from_lux(order.side),
+                              order.price, order.quantity, data_->orders_.size()});
+    data_->orders_.push_back(order);
+    return *this;
+}
+
+MarketDataBuilder& MarketDataBuilder::journal_event(MarketEvent event) {
+    data_->events_.push_back(event);
+    return *this;
+}
+
+std::shared_ptr<const MarketData> MarketDataBuilder::build() {
+    std::stable_sort(data_->events_.begin(), data_->events_.end(),
+                     [](const MarketEvent& a, const MarketEvent& b) { return a.timestamp < b.timestamp; });
+    std::shared_ptr<const MarketData> data(std::move(data_));
+    data_ = std::make_unique<MarketData>();
+    return data;
+}
+
+// =============================================================================
+// Simulation
+// =============================================================================
+
+namespace {
+
+// One run: private books and accounts over the shared tape. Everything the
+// venue does happens at once; what the strategy sends or learns goes
+// through the pending queue with the configured latency.
+class Simulation final : public BacktestContext {
+public:
+    Simulation(const MarketData& data, const BacktestConfig& config, Strategy& strategy,
+               BacktestResult& result)
+        : data_(data), config_(config), strategy_(strategy), result_(result),
+          books_(data.symbols().size()), accounts_(data.symbols().size()),
+          known_positions_(data.symbols().size()) {
+        lux::OrderBookConfig book_config;
+        book_config.thread_safe = false;        // One run, one thread
+        for (size_t i = 0; i < books_.size(); ++i) {
+            books_[i].book = std::make_unique<lux::OrderBook>(i + 1, book_config);
+            books_[i].book->set_clock(&clock_);
+        }
+    }
+
+    void run() {
+        const auto& events = data_.events();
+        auto first = events.begin();
+        auto last = events.end();
+        if (config_.start_time > 0) {
+            first = std::lower_bound(first, last, config_.start_time,
+                [](const MarketEvent& e, int64_t t) { return e.timestamp < t; });
+        }
+        if (config_.end_time > 0) {
+            last = std::upper_bound(first, last, config_.end_time,
+                [](int64_t t, const MarketEvent& e) { return t < e.timestamp; });
+        }
+        if (first == last) {
+            strategy_.on_start(*this);
+            strategy_.on_finish(*this);
+            return;
+        }
+
+        clock_.set(lux::Timestamp(first->timestamp));
+        strategy_.on_start(*this);
+        for (auto it = first; it != last; ++it) {
+            drain(it->timestamp);
+            clock_.set(lux::Timestamp(std::max(it->timestamp, now_ns())));
+            apply(*it);
+            ++result_.events;
+        }
+        const int64_t end = config_.end_time > 0 ? config_.end_time : (last - 1)->timestamp;
+        drain(end);
+        strategy_.on_finish(*this);
+
+        result_.simulated_seconds = static_cast<double>((last - 1)->timestamp - first->timestamp) / 1e9;
+    }
+
+    void finish() {
+        for (size_t i = 0; i < books_.size(); ++i) {
+            const Account& account = accounts_[i];
+            const Book& book = books_[i];
+            SymbolResult symbol;
+            symbol.symbol = data_.symbols()[i];
+            symbol.position = Decimal(account.position);
+            symbol.cash = account.cash;
+            if (book.last_price > 0) {
+                symbol.last_price = to_double(book.last_price);
+            } else {
+                const lux::L1Snapshot top = book.book->top_of_book();
+                if (top.has_bid() && top.has_ask()) {
+                    symbol.last_price = (to_double(top.bid_price) + to_double(top.ask_price)) / 2.0;
+                }
+            }
+            symbol.pnl = symbol.cash + to_double(account.position) * symbol.last_price;
+            result_.pnl += symbol.pnl;
+            result_.symbols.push_back(std::move(symbol));
+        }
+    }
+
+    // -- BacktestContext ------------------------------------------------------
+
+    int64_t now_ns() const override { return clock_.now().count(); }
+
+    std::string place_order(const OrderRequest& request) override {
+        const uint64_t n = next_strategy_id_++;
+        Working working;
+        working.request = request;
+        working.order.order_id = std::to_string(n);
+        working.order.client_order_id = request.client_order_id;
+        working.order.symbol = request.symbol;
+        working.order.venue = "backtest";
+        working.order.side = request.side;
+        working.order.order_type = request.order_type;
+        working.order.quantity = request.quantity;
+        working.order.remaining_quantity = request.quantity;
+        working.order.price = request.price;
+        working.order.created_at = to_ms(now_ns());
+        working.order.updated_at = working.order.created_at;
+        known_orders_[n] = working.order;
+        working_.emplace(n, std::move(working));
+        ++result_.orders;
+        schedule(now_ns() + config_.order_latency.count(), Arrival{n});
+        return std::to_string(n);
+    }
+
+    void cancel_order(const std::string& order_id) override {
+        uint64_t n = 0;
+        try {
+            n = std::stoull(order_id);
+        } catch (const std::exception&) {
+            return;
+        }
+        schedule(now_ns() + config_.order_latency.count(), CancelArrival{n});
+    }
+
+    void set_timer(int64_t at_ns) override {
+        schedule(std::max(at_ns, now_ns()), TimerFired{++timer_generation_});
+    }
+
+    Decimal position(std::string_view symbol) const override {
+        auto index = data_.find_symbol(symbol);
+        return index ? Decimal(known_positions_[*index]) : Decimal::zero();
+    }
+
+    std::vector<Order> open_orders() const override {
+        std::vector<Order> out;
+        for (const auto& [id, order] : known_orders_) {
+            if (order.is_open()) out.push_back(order);
+        }
+        return out;
+    }
+
+private:
+    // Recorded liquidity resting at one price, in arrival order
+    struct Level {
+        int64_t quantity = 0;
+        std::deque<uint64_t> ids;
+    };
+
+    struct Book {
+        std::unique_ptr<lux::OrderBook> book;
+        std::unordered_map<lux::Price, Level> bids;
+        std::unordered_map<lux::Price, Level> asks;
+        lux::L1Snapshot notified{};         // Last top sent to the strategy
+        int64_t last_price = 0;
+    };
+
+    struct Background {
+        uint32_t symbol;
+        lux::Side side;
+        lux::Price price;
+    };
+
+    struct Account {
+        int64_t position = 0;
+        double cash = 0.0;
+    };
+
+    struct Working {
+        OrderRequest request;
+        Order order;
+        double filled_value = 0.0;              // Sum of price * quantity, for the average
+    };
+
+    // Pending work, in (time, sequence) order
+    struct Arrival { uint64_t id; };
+    struct CancelArrival { uint64_t id; };
+    struct TimerFired { uint64_t generation; };
+    struct BookNotice { Ticker ticker; };
+    struct PrintNotice { Trade trade; };
+    struct FillNotice { Trade trade; uint32_t symbol; int64_t signed_quantity; };
+    struct OrderNotice { Order order; };
+    using Action = std::variant<Arrival, CancelArrival, TimerFired, BookNotice, PrintNotice,
+                                FillNotice, OrderNotice>;
+
+    struct Pending {
+        int64_t time;
+        uint64_t sequence;
+        Action action;
+
+        bool operator>(const Pending& other) const {
+            return time != other.time ? time > other.time : sequence > other.sequence;
+        }
+    };
+
+    void schedule(int64_t time, Action action) {
+        pending_.push({time, next_sequence_++, std::move(action)});
+    }
+
+    void notify(Action action) {
+        schedule(now_ns() + config_.feed_latency.count(), std::move(action));
+    }
+
+    void drain(int64_t until) {
+        while (!pending_.empty() && pending_.top().time <= until) {
+            Pending next = pending_.top();
+            pending_.pop();
+            clock_.set(lux::Timestamp(std::max(next.time, now_ns())));
+            std::visit([this](auto& action) { dispatch(action); }, next.action);
+        }
+    }
+
+    // -- Tape -------------------------------------------------------------
+
+    void apply(const MarketEvent& event) {
+        Book& book = books_[event.symbol];
+        trades_.clear();
+        switch (event.kind) {
+            case MarketEventKind::Level:
+                set_level(event.symbol, to_lux(event.side), event.price, event.quantity);
+                break;
+            case MarketEventKind::Trade: {
+                // The print's aggressor takes what is in the book up to its
+                // price: recorded liquidity ahead of ours first
+                lux::Order taker = make_order(next_background_id_++, event.symbol, to_lux(event.side),
+                                              event.price, event.quantity);
+                taker.tif = lux::TimeInForce::IOC;
+                book.book->place_order(taker, trades_);
+                settle(event.symbol, 0);
+
+                Trade print;
+                print.trade_id = "tape-" + std::to_string(result_.events);
+                print.symbol = data_.symbols()[event.symbol];
+                print.venue = "backtest";
+                print.side = event.side;
+                print.price = Decimal(event.price);
+                print.quantity = Decimal(event.quantity);
+                print.timestamp = to_ms(event.timestamp);
+                book.last_price = event.price;
+                notify(PrintNotice{std::move(print)});
+                break;
+            }
+            case MarketEventKind::Place: {
+                lux::Order order = data_.order(event);
+                order.symbol_id = event.symbol + 1;
+                book.book->place_order(order, trades_);
+                settle(event.symbol, 0);
+                print_trades(event.symbol);
+                break;
+            }
+            case MarketEventKind::Cancel:
+                book.book->cancel_order(event.order_id);
+                break;
+            case MarketEventKind::Modify:
+                book.book->modify_order(event.order_id, event.price, event.quantity);
+                break;
+            case MarketEventKind::Reduce:
+                book.book->reduce_order(event.order_id, event.quantity);
+                break;
+        }
+        publish_top(event.symbol);
+    }
+
+    lux::Order make_order(uint64_t id, uint32_t symbol, lux::Side side, lux::Price price,
+                          lux::Quantity quantity) const {
+        lux::Order order{};
+        order.id = id;
+        order.symbol_id = symbol + 1;
+        order.price = price;
+        order.quantity = quantity;
+        order.side = side;
+        order.type = lux::OrderType::Limit;
+        order.tif = lux::TimeInForce::GTC;
+        order.status = lux::OrderStatus::New;
+        order.timestamp = clock_.now();
+        return order;
+    }
+
+    // Brings the recorded size at a level to `target`. Growth joins the
+    // back of the queue; shrinkage leaves per the queue model.
+    void set_level(uint32_t symbol, lux::Side side, lux::Price price, lux::Quantity target) {
+        Book& book = books_[symbol];
+        auto& levels = side == lux::Side::Buy ? book.bids : book.asks;
+        Level& level = levels[price];
+
+        if (target > level.quantity) {
+            const uint64_t id = next_background_id_++;
+            const lux::Quantity add = target - level.quantity;
+            level.quantity += add;
+            level.ids.push_back(id);
+            background_.emplace(id, Background{symbol, side, price});
+            // A level crossing our resting orders trades with them
+            book.book->place_order(make_order(id, symbol, side, price, add), trades_);
+            settle(symbol, 0);
+        } else {
+            lux::Quantity remove = level.quantity - target;
+            const bool from_back = config_.queue_model == QueueModel::CancelsFromBack;
+            while (remove > 0 && !level.ids.empty()) {
+                const uint64_t id = from_back ? level.ids.back() : level.ids.front();
+                auto order = book.book->get_order(id);
+                if (order && order->remaining() > remove) {
+                    book.book->reduce_order(id, order->quantity - remove);
+                    level.quantity -= remove;
+                    break;
+                }
+                if (order) {
+                    book.book->cancel_order(id);
+                    level.quantity -= order->remaining();
+                    remove -= order->remaining();
+                }
+                background_.erase(id);
+                from_back ? level.ids.pop_back() : level.ids.pop_front();
+            }
+        }
+
+        auto it = levels.find(price);
+        if (it != levels.end() && it->second.ids.empty()) {
+            levels.erase(it);
+        }
+    }
+
+    // Accounts for trades_ just produced in a symbol's book: recorded
+    // liquidity consumed, strategy orders filled. `taker` is the strategy
+    // order that aggressed, if any.
+    void settle(uint32_t symbol, uint64_t taker) {
+        Book& book = books_[symbol];
+        for (const lux::Trade& trade : trades_) {
+            book.last_price = trade.price;
+            for (const uint64_t id : {trade.buy_order_id, trade.sell_order_id}) {
+                if (id >= STRATEGY_ID_BASE) {
+                    fill(symbol, id - STRATEGY_ID_BASE, trade, id != taker);
+                    continue;
+                }
+                auto it = background_.find(id);
+                if (it == background_.end()) continue;
+                auto& levels = it->second.side == lux::Side::Buy ? book.bids : book.asks;
+                auto level = levels.find(it->second.price);
+                if (level == levels.end()) continue;
+                level->second.quantity -= trade.quantity;
+                // Fills take the queue from the front
+                auto& ids = level->second.ids;
+                while (!ids.empty() && !book.book->has_order(ids.front())) {
+                    background_.erase(ids.front());
+                    ids.pop_front();
+                }
+                if (ids.empty()) {
+                    levels.erase(level);
+                }
+            }
+        }
+    }
+
+    void print_trades(uint32_t symbol) {
+        for (const lux::Trade& trade : trades_) {
+            Trade print;
+            print.trade_id = std::to_string(trade.id);
+            print.symbol = data_.symbols()[symbol];
+            print.venue = "backtest";
+            print.side = from_lux(trade.aggressor_side);
+            print.price = Decimal(trade.price);
+            print.quantity = Decimal(trade.quantity);
+            print.timestamp = to_ms(trade.timestamp.count());
+            notify(PrintNotice{std::move(print)});
+        }
+    }
+
+    void publish_top(uint32_t symbol) {
+        Book& book = books_[symbol];
+        const lux::L1Snapshot top = book.book->top_of_book();
+        const lux::L1Snapshot& last = book.notified;
+        if (top.bid_orders == last.bid_orders && top.ask_orders == last.ask_orders &&
+            top.bid_price == last.bid_price && top.ask_price == last.ask_price &&
+            top.bid_quantity == last.bid_quantity && top.ask_quantity == last.ask_quantity) {
+            return;
+        }
+        book.notified = top;
+
+        Ticker ticker;
+        ticker.symbol = data_.symbols()[symbol];
+        ticker.venue = "backtest";
+        if (top.has_bid()) ticker.bid = Decimal(top.bid_price);
+        if (top.has_ask()) ticker.ask = Decimal(top.ask_price);
+        if (book.last_price > 0) ticker.last = Decimal(book.last_price);
+        ticker.timestamp = to_ms(now_ns());
+        notify(BookNotice{std::move(ticker)});
+    }
+
+    // -- Strategy orders ----------------------------------------------------
+
+    void fill(uint32_t symbol, uint64_t n, const lux::Trade& trade, bool maker) {
+        auto it = working_.find(n);
+        if (it == working_.end()) return;
+        Order& order = it->second.order;
+        const Decimal quantity(trade.quantity);
+        const Decimal price(trade.price);
+
+        order.filled_quantity = order.filled_quantity + quantity;
+        order.remaining_quantity = order.quantity - order.filled_quantity;
+        const double notional = to_double(trade.price) * to_double(trade.quantity);
+        it->second.filled_value += notional;
+        order.average_price = Decimal::from_double(it->second.filled_value / order.filled_quantity.to_double());
+        order.status = order.remaining_quantity.is_positive() ? OrderStatus::PartiallyFilled
+                                                              : OrderStatus::Filled;
+        order.updated_at = to_ms(now_ns());
+
+        const double fee = notional * (maker ? config_.maker_fee : config_.taker_fee);
+        const int64_t signed_quantity = order.side == Side::Buy ? trade.quantity : -trade.quantity;
+        Account& account = accounts_[symbol];
+        account.position += signed_quantity;
+        account.cash += (order.side == Side::Buy ? -notional : notional) - fee;
+        result_.fees += fee;
+        result_.volume += notional;
+        ++result_.fills;
+        if (maker) ++result_.maker_fills;
+
+        Trade fill;
+        fill.trade_id = std::to_string(trade.id);
+        fill.order_id = order.order_id;
+        fill.symbol = order.symbol;
+        fill.venue = "backtest";
+        fill.side = order.side;
+        fill.price = price;
+        fill.quantity = quantity;
+        fill.fee = Fee{"", Decimal::from_double(fee), Decimal::from_double(maker ? config_.maker_fee
+                                                                                 : config_.taker_fee)};
+        fill.timestamp = to_ms(now_ns());
+        fill.is_maker = maker;
+        notify(FillNotice{std::move(fill), symbol, signed_quantity});
+
+        if (order.status == OrderStatus::Filled) {
+            notify(OrderNotice{order});
+            working_.erase(it);
+        }
+    }
+
+    void finish_order(std::unordered_map<uint64_t, Working>::iterator it, OrderStatus status) {
+        it->second.order.status = status;
+        it->second.order.updated_at = to_ms(now_ns());
+        notify(OrderNotice{it->second.order});
+        working_.erase(it);
+    }
+
+    void dispatch(Arrival& arrival) {
+        auto it = working_.find(arrival.id);
+        if (it == working_.end()) return;
+        const OrderRequest& request = it->second.request;
+        auto symbol = data_.find_symbol(request.symbol);
+
+        const bool market = request.order_type == OrderType::Market;
+        const bool limit = request.order_type == OrderType::Limit ||
+                           request.order_type == OrderType::LimitMaker;
+        if (!symbol || !(market || limit) || (limit && !request.price)) {
+            ++result_.rejects;
+            finish_order(it, OrderStatus::Rejected);
+            return;
+        }
+
+        lux::OrderBook& book = *books_[*symbol].book;
+        const lux::Side side = to_lux(request.side);
+        lux::Order order = make_order(STRATEGY_ID_BASE + arrival.id, *symbol, side,
+                                      request.price ? request.price->scaled_value() : 0,
+                                      request.quantity.scaled_value());
+        if (market) {
+            order.type = lux::OrderType::Market;
+            order.tif = lux::TimeInForce::IOC;
+        } else if (request.time_in_force == TimeInForce::IOC) {
+            order.tif = lux::TimeInForce::IOC;
+        } else if (request.time_in_force == TimeInForce::FOK) {
+            order.tif = lux::TimeInForce::FOK;
+        }
+
+        // Post-only: refused if it would take
+        if (request.post_only || request.time_in_force == TimeInForce::PostOnly ||
+            request.order_type == OrderType::LimitMaker) {
+            const auto opposite = side == lux::Side::Buy ? book.best_ask() : book.best_bid();
+            if (opposite && (side == lux::Side::Buy ? order.price >= *opposite : order.price <= *opposite)) {
+                ++result_.rejects;
+                finish_order(it, OrderStatus::Rejected);
+                return;
+            }
+        }
+
+        trades_.clear();
+        if (!book.place_order(order, trades_)) {
+            ++result_.rejects;
+            finish_order(it, OrderStatus::Rejected);
+            return;
+        }
+        settle(*symbol, order.id);
+        print_trades(*symbol);
+        publish_top(*symbol);
+
+        it = working_.find(arrival.id);
+        if (it == working_.end()) return;      // Filled on arrival (already notified)
+        if (!book.has_order(order.id)) {
+            finish_order(it, OrderStatus::Cancelled);      // IOC / FOK remainder
+            return;
+        }
+        if (it->second.order.status == OrderStatus::Pending) {
+            it->second.order.status = OrderStatus::Open;
+        }
+        it->second.order.updated_at = to_ms(now_ns());
+        notify(OrderNotice{it->second.order});
+    }
+
+    void dispatch(CancelArrival& cancel) {
+        auto it = working_.find(cancel.id);
+        if (it == working_.end()) return;       // Done or never placed
+        auto symbol = data_.find_symbol(it->second.request.symbol);
+        if (!symbol || !books_[*symbol].book->cancel_order(STRATEGY_ID_BASE + cancel.id)) {
+            return;     // Still in flight: the cancel raced its order
+        }
+        ++result_.cancels;
+        finish_order(it, OrderStatus::Cancelled);
+        publish_top(*symbol);
+    }
+
+    void dispatch(TimerFired& timer) {
+        if (timer.generation == timer_generation_) {
+            strategy_.on_timer(*this);
+        }
+    }
+
+    void dispatch(BookNotice& notice) { strategy_.on_book(*this, notice.ticker); }
+
+    void dispatch(PrintNotice& notice) { strategy_.on_trade(*this, notice.trade); }
+
+    void dispatch(FillNotice& notice) {
+        known_positions_[notice.symbol] += notice.signed_quantity;
+        strategy_.on_fill(*this, notice.trade);
+    }
+
+    void dispatch(OrderNotice& notice) {
+        const uint64_t n = std::stoull(notice.order.order_id);
+        if (notice.order.is_done()) {
+            known_orders_.erase(n);
+        } else {
+            known_orders_[n] = notice.order;
+        }
+        strategy_.on_order(*this, notice.order);
+    }
+
+    const MarketData& data_;
+    const BacktestConfig& config_;
+    Strategy& strategy_;
+    BacktestResult& result_;
+
+    lux::ManualClock clock_;
+    std::vector<Book> books_;
+    std::vector<Account> accounts_;
+    std::unordered_map<uint64_t, Background> background_;
+    std::unordered_map<uint64_t, Working> working_;         // Live at the venue
+    std::vector<lux::Trade> trades_;                        // Scratch per book call
+    uint64_t next_background_id_ = BACKGROUND_ID_BASE;
+    uint64_t next_strategy_id_ = 1;
+
+    std::priority_queue<Pending, std::vector<Pending>, std::greater<Pending>> pending_;
+    uint64_t next_sequence_ = 0;
+    uint64_t timer_generation_ = 0;
+
+    // The strategy's view, as of the notices it has received
+    std::map<uint64_t, Order> known_orders_;            // By id, i.e. in placement order
+    std::vector<int64_t> known_positions_;
+};
+
+}  // namespace
+
+// =============================================================================
+// Backtest
+// =============================================================================
+
+Backtest::Backtest(std::shared_ptr<const MarketData> data, BacktestConfig config)
+    : data_(std::move(data)), config_(config) {}
+
+BacktestResult Backtest::run(Strategy& strategy, size_t run_index) const {
+    BacktestResult result;
+    result.run = run_index;
+    const auto started = std::chrono::steady_clock::now();
+    {
+        Simulation simulation(*data_, config_, strategy, result);
+        try {
+            simulation.run();
+        } catch (const std::exception& e) {
+            result.error = e.what();
+        }
+        simulation.finish();
+    }
+    result.wall_seconds = std::chrono::duration<double>(std::chrono::steady_clock::now() - started).count();
+    return result;
+}
+
+std::vector<BacktestResult> Backtest::run_parallel(size_t runs, const StrategyFactory& factory,
+                                                   size_t threads) const {
+    std::vector<BacktestResult> results(runs);
+    if (threads == 0) {
+        threads = std::max(1u, std::thread::hardware_concurrency());
+    }
+    threads = std::min(threads, runs);
+
+    std::atomic<size_t> next{0};
+    const auto worker = [&] {
+        while (true) {
+            const size_t i = next.fetch_add(1, std::memory_order_relaxed);
+            if (i >= runs) break;
+            try {
+                auto strategy = factory(i);
+                results[i] = run(*strategy, i);
+            } catch (const std::exception& e) {
+                results[i].run = i;
+                results[i].error = e.what();
+            }
+        }
+    };
+
+    std::vector<std::thread> pool;
+    for (size_t t = 1; t < threads; ++t) {
+        pool.emplace_back(worker);
+    }
+    worker();
+    for (auto& thread : pool) {
+        thread.join();
+    }
+    return results;
+}
+
+}  // namespace lx::trading
@@ -2,22 +2,141 @@
 
 #include <lx/trading/adapters/ccxt.hpp>
 #include <lx/trading/orderbook.hpp>
-#include <cpr/cpr.h>
+#include "http_client.hpp"
+#include "native_stream.hpp"
 #include <nlohmann/json.hpp>
+#include <algorithm>
 
 namespace lx::trading {
 
 using json = nlohmann::json;
 
+namespace {
+
+HttpClientOptions http_options(const CcxtConfig& config) {
+    HttpClientOptions options;
+    options.max_connections = static_cast<size_t>(std::max(config.max_connections, 1));
+    options.http2 = config.http2;
+    return options;
+}
+
+std::optional<Decimal> optional_decimal(const json& data, const char* key) {
+    if (data.contains(key) && !data[key].is_null())
+        return Decimal::from_double(data[key].get<double>());
+    return std::nullopt;
+}
+
+Ticker parse_ticker(const json& data, const std::string& symbol, const std::string& venue) {
+    Ticker ticker;
+    ticker.symbol = data.value("symbol", symbol);
+    ticker.venue = venue;
+    ticker.bid = optional_decimal(data, "bid");
+    ticker.ask = optional_decimal(data, "ask");
+    ticker.last = optional_decimal(data, "last");
+    ticker.volume_24h = optional_decimal(data, "baseVolume");
+    ticker.high_24h = optional_decimal(data, "high");
+    ticker.low_24h = optional_decimal(data, "low");
+    ticker.change_24h = optional_decimal(data, "percentage");
+    ticker.timestamp = data.value("timestamp", now_ms());
+    return ticker;
+}
+
+std::unique_ptr<Orderbook> parse_orderbook(const json& data, const std::string& symbol,
+                                           const std::string& venue) {
+    auto book = std::make_unique<Orderbook>(symbol, venue);
+
+    for (const auto& bid : data["bids"]) {
+        book->add_bid(
+            Decimal::from_double(bid[0].get<double>()),
+            Decimal::from_double(bid[1].get<double>()));
+    }
+
+    for (const auto& ask : data["asks"]) {
+        book->add_ask(
+            Decimal::from_double(ask[0].get<double>()),
+            Decimal::from_double(ask[1].get<double>()));
+    }
+
+    book->sort();
+    return book;
+}
+
+Trade parse_trade(const json& t, const std::string& symbol, const std::string& venue) {
+    Trade trade;
+    trade.trade_id = t.value("id", "");
+    trade.order_id = t.value("order", "");
+    trade.symbol = t.value("symbol", symbol);
+    trade.venue = venue;
+    trade.side = (t.value("side", "buy") == "buy") ? Side::Buy : Side::Sell;
+    trade.price = Decimal::from_double(t.value("price", 0.0));
+    trade.quantity = Decimal::from_double(t.value("amount", 0.0));
+
+    auto fee = t.value("fee", json{});
+    trade.fee.asset = fee.value("currency", "");
+    trade.fee.amount = Decimal::from_double(fee.value("cost", 0.0));
+
+    trade.timestamp = t.value("timestamp", int64_t(0));
+    trade.is_maker = (t.value("takerOrMaker", "taker") == "maker");
+    return trade;
+}
+
+json order_body(const OrderRequest& request) {
+    json order = {
+        {"symbol", request.symbol},
+        {"side", request.side == Side::Buy ? "buy" : "sell"},
+        {"type", request.order_type == OrderType::Market ? "market" : "limit"},
+        {"amount", request.quantity.to_double()}
+    };
+
+    if (request.price) {
+        order["price"] = request.price->to_double();
+    }
+
+    if (!request.client_order_id.empty()) {
+        order["clientOrderId"] = request.client_order_id;
+    }
+
+    return order;
+}
+
+// The k-th entry of a batch reply; the service reports a failed item as
+// {"error": ...} in its place
+const json& batch_item(const json& reply, size_t k, const char* what) {
+    if (!reply.is_array() || k >= reply.size()) {
+        throw AdapterError(std::string(what) + ": missing from batch reply");
+    }
+    const json& item = reply[k];
+    if (item.contains("error")) {
+        const json& error = item["error"];
+        throw AdapterError(std::string(what) + ": " +
+                           (error.is_string() ? error.get<std::string>() : error.dump()));
+    }
+    return item;
+}
+
+const json& keyed_item(const json& reply, const std::string& symbol, const char* what) {
+    if (!reply.contains(symbol) || reply[symbol].is_null()) {
+        throw AdapterError(std::string(what) + ": no data for " + symbol);
+    }
+    return reply[symbol];
+}
+
+}  // namespace
+
 CcxtAdapter::CcxtAdapter(std::string_view name, const CcxtConfig& config)
     : name_(name), config_(config), capabilities_(VenueCapabilities::clob()) {
-    capabilities_.batch_orders = false;  // CCXT REST doesn't have unified batch
+    // CCXT has no unified batch; the service batches when it says so
+    capabilities_.batch_orders = config.batch;
+    capabilities_.max_batch_size = config.batch ? std::max(config.max_batch_size, 1) : 1;
+    capabilities_.streaming = config.ws_url.has_value() && MarketStream::supported();
+    http_ = std::make_unique<HttpClient>(config_.service_url, http_options(config_));
 }
 
 CcxtAdapter::~CcxtAdapter() = default;
 
 void CcxtAdapter::set_service_url(std::string_view url) {
-    service_url_ = std::string(url);
+    config_.service_url = std::string(url);
+    http_ = std::make_unique<HttpClient>(config_.service_url, http_options(config_));
 }
 
 void CcxtAdapter::update_latency(int64_t start_ns) {
@@ -25,28 +144,29 @@ void CcxtAdapter::update_latency(int64_t start_ns) {
     latency_.store(static_cast<int>(elapsed / 1000000), std::memory_order_release);
 }
 
+json CcxtAdapter::credentials() const {
+    return {
+        {"exchange", config_.exchange_id},
+        {"apiKey", config_.api_key.value_or("")},
+        {"secret", config_.api_secret.value_or("")}
+    };
+}
+
 std::future<void> CcxtAdapter::connect() {
     return std::async(std::launch::async, [this]() {
         auto start = now_ns();
 
-        json body = {
-            {"exchange", config_.exchange_id},
-            {"apiKey", config_.api_key.value_or("")},
-            {"secret", config_.api_secret.value_or("")},
-            {"sandbox", config_.sandbox}
-        };
+        json body = credentials();
+        body["sandbox"] = config_.sandbox;
 
         if (config_.password) {
             body["password"] = *config_.password;
         }
 
-        auto response = cpr::Post(
-            cpr::Url{service_url_ + "/connect"},
-            cpr::Header{{"Content-Type", "application/json"}},
-            cpr::Body{body.dump()});
-
-        if (response.status_code != 200) {
-            throw AdapterError("CCXT connect failed: " + response.text);
+        try {
+            http_->post("/connect", body);
+        } catch (const AdapterError& e) {
+            throw AdapterError(std::string("CCXT connect failed: ") + e.what());
         }
 
         update_latency(start);
@@ -56,24 +176,22 @@ std::future<void> CcxtAdapter::connect() {
 
 std::future<void> CcxtAdapter::disconnect() {
     return std::async(std::launch::async, [this]() {
+        std::unique_ptr<MarketStream> stream;
+        {
+            std::lock_guard lock(stream_mutex_);
+            stream = std::move(stream_);
+        }
+        stream.reset();
         connected_.store(false, std::memory_order_release);
     });
 }
 
 std::future<std::vector<MarketInfo>> CcxtAdapter::get_markets() {
-    return std::async(std::launch::async, [this]() {
-        auto start = now_ns();
-
-        auto response = cpr::Get(
-            cpr::Url{service_url_ + "/markets/" + config_.exchange_id});
-
+    auto start = now_ns();
+    return http_->request(HttpClient::Method::Get, "/markets/" + config_.exchange_id, json(),
+        std::nullopt, [this, start](const json& data) {
         update_latency(start);
 
-        if (response.status_code != 200) {
-            throw AdapterError("Failed to get markets: " + response.text);
-        }
-
-        auto data = json::parse(response.text);
         std::vector<MarketInfo> markets;
 
         for (const auto& m : data) {
@@ -103,143 +221,54 @@ std::future<std::vector<MarketInfo>> CcxtAdapter::get_markets() {
 }
 
 std::future<Ticker> CcxtAdapter::get_ticker(const std::string& symbol) {
-    return std::async(std::launch::async, [this, symbol]() {
-        auto start = now_ns();
-
-        auto response = cpr::Get(
-            cpr::Url{service_url_ + "/ticker/" + config_.exchange_id + "/" + symbol});
-
-        update_latency(start);
-
-        if (response.status_code != 200) {
-            throw AdapterError("Failed to get ticker: " + response.text);
-        }
-
-        auto data = json::parse(response.text);
-
-        Ticker ticker;
-        ticker.symbol = data.value("symbol", symbol);
-        ticker.venue = name_;
-
-        if (data.contains("bid") && !data["bid"].is_null())
-            ticker.bid = Decimal::from_double(data["bid"].get<double>());
-        if (data.contains("ask") && !data["ask"].is_null())
-            ticker.ask = Decimal::from_double(data["ask"].get<double>());
-        if (data.contains("last") && !data["last"].is_null())
-            ticker.last = Decimal::from_double(data["last"].get<double>());
-        if (data.contains("baseVolume") && !data["baseVolume"].is_null())
-            ticker.volume_24h = Decimal::from_double(data["baseVolume"].get<double>());
-        if (data.contains("high") && !data["high"].is_null())
-            ticker.high_24h = Decimal::from_double(data["high"].get<double>());
-        if (data.contains("low") && !data["low"].is_null())
-            ticker.low_24h = Decimal::from_double(data["low"].get<double>());
-        if (data.contains("percentage") && !data["percentage"].is_null())
-            ticker.change_24h = Decimal::from_double(data["percentage"].get<double>());
-
-        ticker.timestamp = data.value("timestamp", now_ms());
-
-        return ticker;
-    });
+    auto start = now_ns();
+    return http_->request(HttpClient::Method::Get,
+        "/ticker/" + config_.exchange_id + "/" + symbol, json(), std::nullopt,
+        [this, symbol, start](const json& data) {
+            update_latency(start);
+            return parse_ticker(data, symbol, name_);
+        });
 }
 
 std::future<std::unique_ptr<Orderbook>> CcxtAdapter::get_orderbook(
     const std::string& symbol, std::optional<int> depth) {
-    return std::async(std::launch::async, [this, symbol, depth]() {
-        auto start = now_ns();
-
-        std::string url = service_url_ + "/orderbook/" + config_.exchange_id + "/" + symbol;
-        if (depth) url += "?limit=" + std::to_string(*depth);
-
-        auto response = cpr::Get(cpr::Url{url});
-        update_latency(start);
-
-        if (response.status_code != 200) {
-            throw AdapterError("Failed to get orderbook: " + response.text);
-        }
-
-        auto data = json::parse(response.text);
-        auto book = std::make_unique<Orderbook>(symbol, name_);
+    auto start = now_ns();
 
-        for (const auto& bid : data["bids"]) {
-            book->add_bid(
-                Decimal::from_double(bid[0].get<double>()),
-                Decimal::from_double(bid[1].get<double>()));
-        }
-
-        for (const auto& ask : data["asks"]) {
-            book->add_ask(
-                Decimal::from_double(ask[0].get<double>()),
-                Decimal::from_double(ask[1].get<double>()));
-        }
+    std::string path = "/orderbook/" + config_.exchange_id + "/" + symbol;
+    if (depth) path += "?limit=" + std::to_string(*depth);
 
-        book->sort();
-        return book;
-    });
+    return http_->request(HttpClient::Method::Get, std::move(path), json(), std::nullopt,
+        [this, symbol, start](const json& data) {
+            update_latency(start);
+            return parse_orderbook(data, symbol, name_);
+        });
 }
 
 std::future<std::vector<Trade>> CcxtAdapter::get_trades(
     const std::string& symbol, std::optional<int> limit) {
-    return std::async(std::launch::async, [this, symbol, limit]() {
-        auto start = now_ns();
+    auto start = now_ns();
 
-        std::string url = service_url_ + "/trades/" + config_.exchange_id + "/" + symbol;
-        if (limit) url += "?limit=" + std::to_string(*limit);
+    std::string path = "/trades/" + config_.exchange_id + "/" + symbol;
+    if (limit) path += "?limit=" + std::to_string(*limit);
 
-        auto response = cpr::Get(cpr::Url{url});
-        update_latency(start);
-
-        if (response.status_code != 200) {
-            throw AdapterError("Failed to get trades: " + response.text);
-        }
+    return http_->request(HttpClient::Method::Get, std::move(path), json(), std::nullopt,
+        [this, symbol, start](const json& data) {
+            update_latency(start);
 
-        auto data = json::parse(response.text);
-        std::vector<Trade> trades;
-
-        for (const auto& t : data) {
-            Trade trade;
-            trade.trade_id = t.value("id", "");
-            trade.order_id = t.value("order", "");
-            trade.symbol = t.value("symbol", symbol);
-            trade.venue = name_;
-            trade.side = (t.value("side", "buy") == "buy") ? Side::Buy : Side::Sell;
-            trade.price = Decimal::from_double(t.value("price", 0.0));
-            trade.quantity = Decimal::from_double(t.value("amount", 0.0));
-
-            auto fee = t.value("fee", json{});
-            trade.fee.asset = fee.value("currency", "");
-            trade.fee.amount = Decimal::from_double(fee.value("cost", 0.0));
-
-            trade.timestamp = t.value("timestamp", int64_t(0));
-            trade.is_maker = (t.value("takerOrMaker", "taker") == "maker");
-            trades.push_back(std::move(trade));
-        }
-
-        return trades;
-    });
+            std::vector<Trade> trades;
+            for (const auto& t : data) {
+                trades.push_back(parse_trade(t, symbol, name_));
+            }
+            return trades;
+        });
 }
 
 std::future<std::vector<Balance>> CcxtAdapter::get_balances() {
-    return std::async(std::launch::async, [this]() {
-        auto start = now_ns();
-
-        json body = {
-            {"exchange", config_.exchange_id},
-            {"apiKey", config_.api_key.value_or("")},
-            {"secret", config_.api_secret.value_or("")}
-        };
-
-        auto response = cpr::Post(
-            cpr::Url{service_url_ + "/balance"},
-            cpr::Header{{"Content-Type", "application/json"}},
-            cpr::Body{body.dump()});
-
+    auto start = now_ns();
+    return http_->request(HttpClient::Method::Post, "/balance", credentials(), std::nullopt,
+        [this, start](const json& data) {
         update_latency(start);
 
-        if (response.status_code != 200) {
-            throw AdapterError("Failed to get balances: " + response.text);
-        }
-
-        auto data = json::parse(response.text);
         std::vector<Balance> balances;
 
         auto total = data.value("total", json{});
@@ -273,36 +302,21 @@ std::future<Balance> CcxtAdapter::get_balance(const std::string& asset) {
 
 std::future<std::vector<Order>> CcxtAdapter::get_open_orders(
     const std::optional<std::string>& symbol) {
-    return std::async(std::launch::async, [this, symbol]() {
-        auto start = now_ns();
-
-        json body = {
-            {"exchange", config_.exchange_id},
-            {"apiKey", config_.api_key.value_or("")},
-            {"secret", config_.api_secret.value_or("")}
-        };
-        if (symbol) body["symbol"] = *symbol;
+    auto start = now_ns();
 
-        auto response = cpr::Post(
-            cpr::Url{service_url_ + "/openOrders"},
-            cpr::Header{{"Content-Type", "application/json"}},
-            cpr::Body{body.dump()});
-
-        update_latency(start);
-
-        if (response.status_code != 200) {
-            throw AdapterError("Failed to get open orders: " + response.text);
-        }
+    json body = credentials();
+    if (symbol) body["symbol"] = *symbol;
 
-        auto data = json::parse(response.text);
-        std::vector<Order> orders;
+    return http_->request(HttpClient::Method::Post, "/openOrders", std::move(body), std::nullopt,
+        [this, start](const json& data) {
+            update_latency(start);
 
-        for (const auto& o : data) {
-            orders.push_back(convert_order(o));
-        }
-
-        return orders;
-    });
+            std::vector<Order> orders;
+            for (const auto& o : data) {
+                orders.push_back(convert_order(o));
+            }
+            return orders;
+        });
 }
 
 Order CcxtAdapter::convert_order(const json& o) {
@@ -343,83 +357,49 @@ Order CcxtAdapter::convert_order(const json& o) {
 }
 
 std::future<Order> CcxtAdapter::place_order(const OrderRequest& request) {
-    return std::async(std::launch::async, [this, request]() -> Order {
-        auto start = now_ns();
-
-        json body = {
-            {"exchange", config_.exchange_id},
-            {"apiKey", config_.api_key.value_or("")},
-            {"secret", config_.api_secret.value_or("")},
-            {"symbol", request.symbol},
-            {"side", request.side == Side::Buy ? "buy" : "sell"},
-            {"type", request.order_type == OrderType::Market ? "market" : "limit"},
-            {"amount", request.quantity.to_double()}
-        };
-
-        if (request.price) {
-            body["price"] = request.price->to_double();
-        }
-
-        if (!request.client_order_id.empty()) {
-            body["clientOrderId"] = request.client_order_id;
-        }
-
-        auto response = cpr::Post(
-            cpr::Url{service_url_ + "/order"},
-            cpr::Header{{"Content-Type", "application/json"}},
-            cpr::Body{body.dump()});
+    auto start = now_ns();
 
-        update_latency(start);
-
-        if (response.status_code != 200 && response.status_code != 201) {
-            throw AdapterError("Failed to place order: " + response.text);
-        }
+    json body = credentials();
+    body.update(order_body(request));
 
-        auto data = json::parse(response.text);
-        return convert_order(data);
-    });
+    return http_->request(HttpClient::Method::Post, "/order", std::move(body), std::nullopt,
+        [this, start](const json& data) {
+            update_latency(start);
+            return convert_order(data);
+        });
 }
 
 std::future<Order> CcxtAdapter::cancel_order(
     const std::string& order_id, const std::string& symbol) {
-    return std::async(std::launch::async, [this, order_id, symbol]() -> Order {
-        auto start = now_ns();
+    auto start = now_ns();
 
-        json body = {
-            {"exchange", config_.exchange_id},
-            {"apiKey", config_.api_key.value_or("")},
-            {"secret", config_.api_secret.value_or("")},
-            {"orderId", order_id},
-            {"symbol", symbol}
-        };
+    json body = credentials();
+    body["orderId"] = order_id;
+    body["symbol"] = symbol;
 
-        auto response = cpr::Post(
-            cpr::Url{service_url_ + "/cancelOrder"},
-            cpr::Header{{"Content-Type", "application/json"}},
-            cpr::Body{body.dump()});
-
-        update_latency(start);
-
-        if (response.status_code != 200) {
-            throw AdapterError("Failed to cancel order: " + response.text);
-        }
-
-        auto data = json::parse(response.text);
-        return convert_order(data);
-    });
+    return http_->request(HttpClient::Method::Post, "/cancelOrder", std::move(body), std::nullopt,
+        [this, start](const json& data) {
+            update_latency(start);
+            return convert_order(data);
+        });
 }
 
 std::future<std::vector<Order>> CcxtAdapter::cancel_all_orders(
     const std::optional<std::string>& symbol) {
     return std::async(std::launch::async, [this, symbol]() {
-        // Get open orders then cancel each
+        // Get open orders then cancel them all at once
         auto open = get_open_orders(symbol).get();
-        std::vector<Order> cancelled;
 
+        std::vector<OrderRef> refs;
+        refs.reserve(open.size());
         for (const auto& order : open) {
+            refs.emplace_back(order.order_id, order.symbol);
+        }
+
+        std::vector<Order> cancelled;
+        for (auto& result : cancel_orders(refs)) {
             try {
-                auto result = cancel_order(order.order_id, order.symbol).get();
-                cancelled.push_back(std::move(result));
+                cancelled.push_back(result.get());
             } catch (...) {
                 // Continue with other orders
             }
@@ -429,4 +409,173 @@ std::future<std::vector<Order>> CcxtAdapter::cancel_all_orders(
     });
 }
 
+// =============================================================================
+// Batches
+// =============================================================================
+
+template <typename T, typename Build, typename Parse>
+std::vector<std::future<T>> CcxtAdapter::send_batches(const char* path, size_t count,
+                                                      Build build, Parse parse) {
+    const size_t max_batch = static_cast<size_t>(capabilities_.max_batch_size);
+
+    std::vector<std::future<T>> results;
+    results.reserve(count);
+    for (size_t first = 0; first < count; first += max_batch) {
+        const size_t last = std::min(count, first + max_batch);
+        auto promises = std::make_shared<std::vector<std::promise<T>>>(last - first);
+        for (auto& promise : *promises) {
+            results.push_back(promise.get_future());
+        }
+
+        auto start = now_ns();
+        http_->send(HttpClient::Method::Post, path, build(first, last), std::nullopt,
+            [this, promises, first, start, parse](const json* reply, std::exception_ptr error) {
+                if (reply) update_latency(start);
+                for (size_t k = 0; k < promises->size(); ++k) {
+                    auto& promise = (*promises)[k];
+                    if (!reply) {
+                        promise.set_exception(error);
+                        continue;
+                    }
+                    try {
+                        promise.set_value(parse(*reply, k, first + k));
+                    } catch (...) {
+                        promise.set_exception(std::current_exception());
+                    }
+                }
+            });
+    }
+    return results;
+}
+
+std::vector<std::future<Order>> CcxtAdapter::place_orders(
+    const std::vector<OrderRequest>& requests) {
+    if (!config_.batch) return VenueAdapter::place_orders(requests);
+
+    return send_batches<Order>("/orders", requests.size(),
+        [this, &requests](size_t first, size_t last) {
+            json body = credentials();
+            json orders = json::array();
+            for (size_t i = first; i < last; ++i) {
+                orders.push_back(order_body(requests[i]));
+            }
+            body["orders"] = std::move(orders);
+            return body;
+        },
+        [this](const json& reply, size_t k, size_t) {
+            return convert_order(batch_item(reply, k, "Failed to place order"));
+        });
+}
+
+std::vector<std::future<Order>> CcxtAdapter::cancel_orders(
+    const std::vector<OrderRef>& orders) {
+    if (!config_.batch) return VenueAdapter::cancel_orders(orders);
+
+    return send_batches<Order>("/cancelOrders", orders.size(),
+        [this, &orders](size_t first, size_t last) {
+            json body = credentials();
+            json refs = json::array();
+            for (size_t i = first; i < last; ++i) {
+                refs.push_back({{"orderId", orders[i].first}, {"symbol", orders[i].second}});
+            }
+            body["orders"] = std::move(refs);
+            return body;
+        },
+        [this](const json& reply, size_t k, size_t) {
+            return convert_order(batch_item(reply, k, "Failed to cancel order"));
+        });
+}
+
+std::vector<std::future<Ticker>> CcxtAdapter::get_tickers(
+    const std::vector<std::string>& symbols) {
+    if (!config_.batch) return VenueAdapter::get_tickers(symbols);
+
+    auto names = std::make_shared<const std::vector<std::string>>(symbols);
+    return send_batches<Ticker>("/tickers", symbols.size(),
+        [this, &symbols](size_t first, size_t last) {
+            return json{
+                {"exchange", config_.exchange_id},
+                {"symbols", std::vector<std::string>(symbols.begin() + first,
+                                                     symbols.begin() + last)}
+            };
+        },
+        [this, names](const json& reply, size_t, size_t i) {
+            const std::string& symbol = (*names)[i];
+            return parse_ticker(keyed_item(reply, symbol, "Failed to get ticker"), symbol, name_);
+        });
+}
+
+std::vector<std::future<std::unique_ptr<Orderbook>>> CcxtAdapter::get_orderbooks(
+    const std::vector<std::string>& symbols, std::optional<int> depth) {
+    if (!config_.batch) return VenueAdapter::get_orderbooks(symbols, depth);
+
+    auto names = std::make_shared<const std::vector<std::string>>(symbols);
+    return send_batches<std::unique_ptr<Orderbook>>("/orderbooks", symbols.size(),
+        [this, &symbols, depth](size_t first, size_t last) {
+            json body = {
+                {"exchange", config_.exchange_id},
+                {"symbols", std::vector<std::string>(symbols.begin() + first,
+                                                     symbols.begin() + last)}
+            };
+            if (depth) body["limit"] = *depth;
+            return body;
+        },
+        [this, names](const json& reply, size_t, size_t i) {
+            const std::string& symbol = (*names)[i];
+            return parse_orderbook(keyed_item(reply, symbol, "Failed to get orderbook"),
+                                   symbol, name_);
+        });
+}
+
+// =============================================================================
+// Streaming
+// =============================================================================
+
+MarketStream* CcxtAdapter::stream() {
+    std::lock_guard lock(stream_mutex_);
+    if (!stream_ && config_.ws_url && MarketStream::supported()) {
+        stream_ = std::make_unique<MarketStream>(*config_.ws_url);
+        stream_->start();
+    }
+    return stream_.get();
+}
+
+void CcxtAdapter::subscribe_ticker(const std::string& symbol, TickerCallback cb) {
+    MarketStream* s = stream();
+    if (!s || !cb) return;
+
+    s->subscribe("ticker:" + symbol, [this, symbol, cb = std::move(cb)](const json& data) {
+        cb(parse_ticker(data, symbol, name_));
+    });
+}
+
+void CcxtAdapter::subscribe_trades(const std::string& symbol, TradeCallback cb) {
+    MarketStream* s = stream();
+    if (!s || !cb) return;
+
+    s->subscribe("trades:" + symbol, [this, symbol, cb = std::move(cb)](const json& data) {
+        if (data.is_array()) {
+            for (const auto& t : data) cb(parse_trade(t, symbol, name_));
+        } else {
+            cb(parse_trade(data, symbol, name_));
+        }
+    });
+}
+
+void CcxtAdapter::subscribe_orderbook(const std::string& symbol, OrderbookCallback cb) {
+    MarketStream* s = stream();
+    if (!s || !cb) return;
+
+    s->subscribe("orderbook:" + symbol, [this, symbol, cb = std::move(cb)](const json& data) {
+        cb(*parse_orderbook(data, symbol, name_));
+    });
+}
+
+void CcxtAdapter::unsubscribe_all() {
+    std::lock_guard lock(stream_mutex_);
+    if (stream_) {
+        stream_->unsubscribe_all();
+    }
+}
+
 }  // namespace lx::trading
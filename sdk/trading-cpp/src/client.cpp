@@ -219,25 +219,27 @@ std::future<Order> Client::limit_sell(
 
 std::future<Order> Client::place_order(const OrderRequest& request) {
     return std::async(std::launch::async, [this, request]() {
-        // Validate with risk manager
-        risk_manager_->validate_order(request);
+        // Reserve limits with risk manager; released if placement throws
+        auto reservation = risk_manager_->reserve(request);
 
         // Route order
+        Order order;
         if (request.venue) {
             auto adapter = get_venue(request.venue);
-            auto order = adapter->place_order(request).get();
-            risk_manager_->order_opened(request.symbol);
-            return order;
+            order = adapter->place_order(request).get();
+        } else if (config_.general.smart_routing &&
+                   request.order_type == OrderType::Market) {
+            order = smart_route(request);
+        } else {
+            auto adapter = get_venue(std::nullopt);
+            order = adapter->place_order(request).get();
         }
 
-        if (config_.general.smart_routing &&
-            request.order_type == OrderType::Market) {
-            return smart_route(request);
+        if (order.status == OrderStatus::Rejected) {
+            reservation.reject();
+        } else {
+            reservation.acknowledge();
         }
-
-        auto adapter = get_venue(std::nullopt);
-        auto order = adapter->place_order(request).get();
-        risk_manager_->order_opened(request.symbol);
         return order;
     });
 }
@@ -256,16 +258,12 @@ Order Client::smart_route(const OrderRequest& request) {
         OrderRequest routed = request;
         routed.venue = best->first;
         auto adapter = get_venue(routed.venue);
-        auto order = adapter->place_order(routed).get();
-        risk_manager_->order_opened(request.symbol);
-        return order;
+        return adapter->place_order(routed).get();
     }
 
     // Fallback to default
     auto adapter = get_venue(std::nullopt);
-    auto order = adapter->place_order(request).get();
-    risk_manager_->order_opened(request.symbol);
-    return order;
+    return adapter->place_order(request).get();
 }
 
 std::future<Order> Client::cancel_order(
@@ -92,6 +92,7 @@ Config Config::from_toml(std::string_view content) {
                 else if (key == "max_order_size") config.risk.max_order_size = Decimal::from_string(value);
                 else if (key == "max_daily_loss") config.risk.max_daily_loss = Decimal::from_string(value);
                 else if (key == "max_open_orders") config.risk.max_open_orders = std::stoi(value);
+                else if (key == "max_pending_notional") config.risk.max_pending_notional = Decimal::from_string(value);
                 else if (key == "kill_switch_enabled") config.risk.kill_switch_enabled = (value == "true");
             }
             else if (current_section == "native" && !current_subsection.empty()) {
@@ -99,6 +100,9 @@ Config Config::from_toml(std::string_view content) {
                 if (key == "venue_type") native_cfg.venue_type = value;
                 else if (key == "api_url") native_cfg.api_url = value;
                 else if (key == "ws_url") native_cfg.ws_url = value;
+                else if (key == "streaming") native_cfg.streaming = (value == "true");
+                else if (key == "max_connections") native_cfg.max_connections = std::stoi(value);
+                else if (key == "http2") native_cfg.http2 = (value == "true");
                 else if (key == "api_key") native_cfg.api_key = value;
                 else if (key == "api_secret") native_cfg.api_secret = value;
                 else if (key == "wallet_address") native_cfg.wallet_address = value;
@@ -115,6 +119,12 @@ Config Config::from_toml(std::string_view content) {
                 else if (key == "password") ccxt_cfg.password = value;
                 else if (key == "sandbox") ccxt_cfg.sandbox = (value == "true");
                 else if (key == "rate_limit") ccxt_cfg.rate_limit = (value == "true");
+                else if (key == "service_url") ccxt_cfg.service_url = value;
+                else if (key == "ws_url") ccxt_cfg.ws_url = value;
+                else if (key == "batch") ccxt_cfg.batch = (value == "true");
+                else if (key == "max_batch_size") ccxt_cfg.max_batch_size = std::stoi(value);
+                else if (key == "max_connections") ccxt_cfg.max_connections = std::stoi(value);
+                else if (key == "http2") ccxt_cfg.http2 = (value == "true");
             }
             else if (current_section == "hummingbot" && !current_subsection.empty()) {
                 auto& hb_cfg = config.hummingbot[current_subsection];
@@ -125,6 +135,8 @@ Config Config::from_toml(std::string_view content) {
                 else if (key == "chain") hb_cfg.chain = value;
                 else if (key == "network") hb_cfg.network = value;
                 else if (key == "wallet_address") hb_cfg.wallet_address = value;
+                else if (key == "max_connections") hb_cfg.max_connections = std::stoi(value);
+                else if (key == "http2") hb_cfg.http2 = (value == "true");
             }
         }
     }
@@ -1,11 +1,100 @@
 // LX Trading SDK - Execution Algorithms Implementation
 
 #include <lx/trading/execution.hpp>
+#include <lx/trading/execution_scheduler.hpp>
 #include <lx/trading/client.hpp>
+#include <algorithm>
 #include <thread>
 
 namespace lx::trading {
 
+// =============================================================================
+// Executor
+// =============================================================================
+
+std::future<ExecutionResult> Executor::execute() {
+    return std::async(std::launch::async, [this]() {
+        RunState state = begin();
+        while (auto delay = step(state)) {
+            std::this_thread::sleep_for(*delay);
+        }
+        return finish(state);
+    });
+}
+
+std::future<ExecutionResult> Executor::execute(ExecutionScheduler& scheduler) {
+    return scheduler.submit(*this);
+}
+
+void Executor::cancel() {
+    cancelled_.store(true, std::memory_order_release);
+    if (wake_) {
+        wake_();
+    }
+}
+
+ExecutionResult Executor::finish(RunState& state) {
+    ExecutionResult& result = state.result;
+    result.end_time = now_ms();
+    result.completed = is_complete(state);
+
+    if (result.total_filled.is_positive()) {
+        result.average_price = state.total_value / result.total_filled;
+    }
+
+    return std::move(result);
+}
+
+bool Executor::on_ticker(RunState& state, const Ticker& ticker) {
+    state.ticker = ticker;
+    return false;
+}
+
+bool Executor::on_fill(RunState&, const Order&) {
+    return false;
+}
+
+void Executor::record_order(RunState& state, const Order& order) {
+    state.result.orders.push_back(order);
+    state.result.total_filled = state.result.total_filled + order.filled_quantity;
+    state.remaining = state.remaining - order.filled_quantity;
+
+    if (order.average_price) {
+        state.total_value = state.total_value +
+            (order.filled_quantity * *order.average_price);
+    }
+}
+
+Ticker Executor::market(RunState& state, Client& client, const std::string& symbol) {
+    if (state.ticker) {
+        return *state.ticker;
+    }
+    return client.ticker(symbol).get();
+}
+
+Executor::RunState Executor::start_run(Decimal total_quantity, std::chrono::seconds duration) {
+    RunState state;
+    state.result.start_time = now_ms();
+    state.result.total_quantity = total_quantity;
+    state.result.completed = false;
+    state.remaining = total_quantity;
+    if (duration.count() > 0) {
+        state.deadline = state.result.start_time + duration.count() * 1000;
+    }
+    return state;
+}
+
+namespace {
+
+Order market_order(Client& client, const std::string& symbol, Side side, Decimal qty) {
+    if (side == Side::Buy) {
+        return client.buy(symbol, qty).get();
+    }
+    return client.sell(symbol, qty).get();
+}
+
+}  // namespace
+
 // =============================================================================
 // TWAP Executor
 // =============================================================================
@@ -24,72 +113,41 @@ TwapExecutor::TwapExecutor(
       duration_(duration),
       num_slices_(num_slices) {}
 
-std::future<ExecutionResult> TwapExecutor::execute() {
-    return std::async(std::launch::async, [this]() {
-        ExecutionResult result;
-        result.start_time = now_ms();
-        result.total_quantity = total_quantity_;
-        result.completed = false;
-
-        Decimal slice_qty = total_quantity_ / Decimal::from_double(num_slices_);
-        auto interval = std::chrono::milliseconds(
-            duration_.count() * 1000 / num_slices_);
-
-        Decimal total_value;
+Executor::RunState TwapExecutor::begin() {
+    return start_run(total_quantity_);
+}
 
-        for (int i = 0; i < num_slices_; ++i) {
-            if (cancelled_.load(std::memory_order_acquire)) {
-                result.error = "Cancelled";
-                break;
-            }
+std::optional<std::chrono::milliseconds> TwapExecutor::step(RunState& state) {
+    if (cancelled()) {
+        state.result.error = "Cancelled";
+        return std::nullopt;
+    }
 
-            Decimal remaining = total_quantity_ - (slice_qty * Decimal::from_double(i));
-            Decimal qty = (remaining < slice_qty) ? remaining : slice_qty;
-
-            if (qty <= Decimal::zero()) break;
-
-            try {
-                Order order;
-                if (side_ == Side::Buy) {
-                    order = client_.buy(symbol_, qty).get();
-                } else {
-                    order = client_.sell(symbol_, qty).get();
-                }
-
-                result.orders.push_back(order);
-                result.total_filled = result.total_filled + order.filled_quantity;
-
-                if (order.average_price) {
-                    total_value = total_value +
-                        (order.filled_quantity * *order.average_price);
-                }
-
-                if (callback_) {
-                    callback_(order, remaining - qty);
-                }
-            } catch (const std::exception& e) {
-                result.error = e.what();
-                break;
-            }
+    const int i = state.iteration;
+    Decimal slice_qty = total_quantity_ / Decimal::from_double(num_slices_);
+    Decimal remaining = total_quantity_ - (slice_qty * Decimal::from_double(i));
+    Decimal qty = (remaining < slice_qty) ? remaining : slice_qty;
 
-            if (i < num_slices_ - 1) {
-                std::this_thread::sleep_for(interval);
-            }
-        }
+    if (i >= num_slices_ || qty <= Decimal::zero()) return std::nullopt;
 
-        result.end_time = now_ms();
-        result.completed = result.error.empty();
+    try {
+        Order order = market_order(client_, symbol_, side_, qty);
+        record_order(state, order);
 
-        if (result.total_filled.is_positive()) {
-            result.average_price = total_value / result.total_filled;
+        if (callback_) {
+            callback_(order, remaining - qty);
         }
+    } catch (const std::exception& e) {
+        state.result.error = e.what();
+        return std::nullopt;
+    }
 
-        return result;
-    });
+    if (++state.iteration >= num_slices_) return std::nullopt;
+    return std::chrono::milliseconds(duration_.count() * 1000 / num_slices_);
 }
 
-void TwapExecutor::cancel() {
-    cancelled_.store(true, std::memory_order_release);
+bool TwapExecutor::is_complete(const RunState& state) const {
+    return state.result.error.empty();
 }
 
 // =============================================================================
@@ -110,77 +168,44 @@ VwapExecutor::VwapExecutor(
       participation_rate_(participation_rate),
       max_duration_(max_duration) {}
 
-std::future<ExecutionResult> VwapExecutor::execute() {
-    return std::async(std::launch::async, [this]() {
-        ExecutionResult result;
-        result.start_time = now_ms();
-        result.total_quantity = total_quantity_;
-        result.completed = false;
-
-        Decimal remaining = total_quantity_;
-        const int check_interval_ms = 5000;
-        int elapsed_ms = 0;
-        Decimal total_value;
-
-        while (remaining > Decimal::zero() &&
-               elapsed_ms < max_duration_.count() * 1000) {
-            if (cancelled_.load(std::memory_order_acquire)) {
-                result.error = "Cancelled";
-                break;
-            }
+Executor::RunState VwapExecutor::begin() {
+    return start_run(total_quantity_, max_duration_);
+}
 
-            try {
-                auto ticker = client_.ticker(symbol_).get();
-                Decimal volume = ticker.volume_24h.value_or(Decimal::from_double(1000));
-
-                // Calculate slice based on participation
-                Decimal hourly_volume = volume / Decimal::from_double(24);
-                Decimal slice_volume = hourly_volume * participation_rate_ /
-                    Decimal::from_double(3600000.0 / check_interval_ms);
-                Decimal qty = (remaining < slice_volume) ? remaining : slice_volume;
-
-                if (qty > Decimal::zero()) {
-                    Order order;
-                    if (side_ == Side::Buy) {
-                        order = client_.buy(symbol_, qty).get();
-                    } else {
-                        order = client_.sell(symbol_, qty).get();
-                    }
-
-                    result.orders.push_back(order);
-                    result.total_filled = result.total_filled + order.filled_quantity;
-                    remaining = remaining - order.filled_quantity;
-
-                    if (order.average_price) {
-                        total_value = total_value +
-                            (order.filled_quantity * *order.average_price);
-                    }
-
-                    if (callback_) {
-                        callback_(order, remaining);
-                    }
-                }
-            } catch (const std::exception& e) {
-                // Log but continue
+std::optional<std::chrono::milliseconds> VwapExecutor::step(RunState& state) {
+    constexpr int check_interval_ms = 5000;
+
+    if (cancelled()) {
+        state.result.error = "Cancelled";
+        return std::nullopt;
+    }
+    if (state.remaining <= Decimal::zero() || now_ms() >= state.deadline) {
+        return std::nullopt;
+    }
+
+    try {
+        auto ticker = market(state, client_, symbol_);
+        Decimal volume = ticker.volume_24h.value_or(Decimal::from_double(1000));
+
+        // Calculate slice based on participation
+        Decimal hourly_volume = volume / Decimal::from_double(24);
+        Decimal slice_volume = hourly_volume * participation_rate_ /
+            Decimal::from_double(3600000.0 / check_interval_ms);
+        Decimal qty = (state.remaining < slice_volume) ? state.remaining : slice_volume;
+
+        if (qty > Decimal::zero()) {
+            Order order = market_order(client_, symbol_, side_, qty);
+            record_order(state, order);
+
+            if (callback_) {
+                callback_(order, state.remaining);
             }
-
-            std::this_thread::sleep_for(std::chrono::milliseconds(check_interval_ms));
-            elapsed_ms += check_interval_ms;
         }
+    } catch (const std::exception&) {
+        // Log but continue
+    }
 
-        result.end_time = now_ms();
-        result.completed = result.error.empty() && remaining <= Decimal::zero();
-
-        if (result.total_filled.is_positive()) {
-            result.average_price = total_value / result.total_filled;
-        }
-
-        return result;
-    });
-}
-
-void VwapExecutor::cancel() {
-    cancelled_.store(true, std::memory_order_release);
+    return std::chrono::milliseconds(check_interval_ms);
 }
 
 // =============================================================================
@@ -203,72 +228,71 @@ IcebergExecutor::IcebergExecutor(
       price_(price),
       venue_(std::move(venue)) {}
 
-std::future<ExecutionResult> IcebergExecutor::execute() {
-    return std::async(std::launch::async, [this]() {
-        ExecutionResult result;
-        result.start_time = now_ms();
-        result.total_quantity = total_quantity_;
-        result.completed = false;
-
-        Decimal remaining = total_quantity_;
-        Decimal total_value;
-
-        while (remaining > Decimal::zero()) {
-            if (cancelled_.load(std::memory_order_acquire)) {
-                result.error = "Cancelled";
-                break;
-            }
+Executor::RunState IcebergExecutor::begin() {
+    return start_run(total_quantity_);
+}
 
-            Decimal qty = (remaining < visible_quantity_) ? remaining : visible_quantity_;
-
-            try {
-                Order order;
-                if (side_ == Side::Buy) {
-                    order = client_.limit_buy(
-                        symbol_, qty, price_,
-                        venue_ ? std::optional<std::string_view>(*venue_)
-                               : std::nullopt).get();
-                } else {
-                    order = client_.limit_sell(
-                        symbol_, qty, price_,
-                        venue_ ? std::optional<std::string_view>(*venue_)
-                               : std::nullopt).get();
-                }
-
-                // Wait for fill (simplified - in production would poll/stream)
-                std::this_thread::sleep_for(std::chrono::milliseconds(500));
-
-                result.orders.push_back(order);
-                result.total_filled = result.total_filled + order.filled_quantity;
-                remaining = remaining - order.filled_quantity;
-
-                if (order.average_price) {
-                    total_value = total_value +
-                        (order.filled_quantity * *order.average_price);
-                }
-
-                if (callback_) {
-                    callback_(order, remaining);
-                }
-            } catch (const std::exception& e) {
-                result.error = e.what();
-                break;
-            }
+std::optional<std::chrono::milliseconds> IcebergExecutor::step(RunState& state) {
+    if (cancelled()) {
+        state.result.error = "Cancelled";
+        return std::nullopt;
+    }
+    if (state.remaining <= Decimal::zero()) return std::nullopt;
+
+    Decimal qty = (state.remaining < visible_quantity_) ? state.remaining : visible_quantity_;
+
+    try {
+        Order order;
+        if (side_ == Side::Buy) {
+            order = client_.limit_buy(
+                symbol_, qty, price_,
+                venue_ ? std::optional<std::string_view>(*venue_)
+                       : std::nullopt).get();
+        } else {
+            order = client_.limit_sell(
+                symbol_, qty, price_,
+                venue_ ? std::optional<std::string_view>(*venue_)
+                       : std::nullopt).get();
         }
 
-        result.end_time = now_ms();
-        result.completed = result.error.empty() && remaining <= Decimal::zero();
+        record_order(state, order);
+        state.working = order;
 
-        if (result.total_filled.is_positive()) {
-            result.average_price = total_value / result.total_filled;
+        if (callback_) {
+            callback_(order, state.remaining);
         }
+    } catch (const std::exception& e) {
+        state.result.error = e.what();
+        return std::nullopt;
+    }
 
-        return result;
-    });
+    // Wait for fill; pushed fills end the wait early
+    return std::chrono::milliseconds(500);
 }
 
-void IcebergExecutor::cancel() {
-    cancelled_.store(true, std::memory_order_release);
+bool IcebergExecutor::on_fill(RunState& state, const Order& order) {
+    if (!state.working || order.order_id != state.working->order_id) return false;
+
+    Decimal filled = order.filled_quantity - state.working->filled_quantity;
+    if (filled > Decimal::zero()) {
+        state.result.total_filled = state.result.total_filled + filled;
+        state.remaining = state.remaining - filled;
+        if (order.average_price) {
+            state.total_value = state.total_value + (filled * *order.average_price);
+        }
+    }
+
+    auto it = std::find_if(state.result.orders.rbegin(), state.result.orders.rend(),
+        [&](const Order& o) { return o.order_id == order.order_id; });
+    if (it != state.result.orders.rend()) {
+        *it = order;
+    }
+    state.working = order;
+
+    if (filled > Decimal::zero() && callback_) {
+        callback_(order, state.remaining);
+    }
+    return order.is_done();
 }
 
 // =============================================================================
@@ -289,75 +313,54 @@ SniperExecutor::SniperExecutor(
       target_price_(target_price),
       timeout_(timeout) {}
 
-std::future<ExecutionResult> SniperExecutor::execute() {
-    return std::async(std::launch::async, [this]() {
-        ExecutionResult result;
-        result.start_time = now_ms();
-        result.total_quantity = quantity_;
-        result.completed = false;
-
-        const int check_interval_ms = 100;
-        int elapsed_ms = 0;
-
-        while (elapsed_ms < timeout_.count() * 1000) {
-            if (cancelled_.load(std::memory_order_acquire)) {
-                result.error = "Cancelled";
-                break;
-            }
+Executor::RunState SniperExecutor::begin() {
+    return start_run(quantity_, timeout_);
+}
 
-            try {
-                auto ticker = client_.ticker(symbol_).get();
-
-                bool should_execute = false;
-                if (side_ == Side::Buy) {
-                    if (ticker.ask && *ticker.ask <= target_price_) {
-                        should_execute = true;
-                    }
-                } else {
-                    if (ticker.bid && *ticker.bid >= target_price_) {
-                        should_execute = true;
-                    }
-                }
-
-                if (should_execute) {
-                    Order order;
-                    if (side_ == Side::Buy) {
-                        order = client_.buy(symbol_, quantity_).get();
-                    } else {
-                        order = client_.sell(symbol_, quantity_).get();
-                    }
-
-                    result.orders.push_back(order);
-                    result.total_filled = order.filled_quantity;
-                    result.average_price = order.average_price;
-                    result.completed = true;
-                    result.end_time = now_ms();
-
-                    if (callback_) {
-                        callback_(order, Decimal::zero());
-                    }
-
-                    return result;
-                }
-            } catch (const std::exception&) {
-                // Continue waiting
+std::optional<std::chrono::milliseconds> SniperExecutor::step(RunState& state) {
+    if (cancelled()) {
+        state.result.error = "Cancelled";
+        return std::nullopt;
+    }
+    if (now_ms() >= state.deadline) {
+        state.result.error = "Timeout";
+        return std::nullopt;
+    }
+
+    try {
+        auto ticker = market(state, client_, symbol_);
+
+        if (triggered(ticker)) {
+            Order order = market_order(client_, symbol_, side_, quantity_);
+            record_order(state, order);
+
+            if (callback_) {
+                callback_(order, Decimal::zero());
             }
 
-            std::this_thread::sleep_for(std::chrono::milliseconds(check_interval_ms));
-            elapsed_ms += check_interval_ms;
+            return std::nullopt;
         }
+    } catch (const std::exception&) {
+        // Continue waiting
+    }
 
-        result.end_time = now_ms();
-        if (result.error.empty() && !result.completed) {
-            result.error = "Timeout";
-        }
+    return std::chrono::milliseconds(100);
+}
 
-        return result;
-    });
+bool SniperExecutor::on_ticker(RunState& state, const Ticker& ticker) {
+    state.ticker = ticker;
+    return triggered(ticker);
 }
 
-void SniperExecutor::cancel() {
-    cancelled_.store(true, std::memory_order_release);
+bool SniperExecutor::is_complete(const RunState& state) const {
+    return state.result.error.empty() && !state.result.orders.empty();
+}
+
+bool SniperExecutor::triggered(const Ticker& ticker) const {
+    if (side_ == Side::Buy) {
+        return ticker.ask && *ticker.ask <= target_price_;
+    }
+    return ticker.bid && *ticker.bid >= target_price_;
 }
 
 // =============================================================================
@@ -380,90 +383,54 @@ PovExecutor::PovExecutor(
       max_duration_(max_duration),
       price_limit_(price_limit) {}
 
-std::future<ExecutionResult> PovExecutor::execute() {
-    return std::async(std::launch::async, [this]() {
-        ExecutionResult result;
-        result.start_time = now_ms();
-        result.total_quantity = total_quantity_;
-        result.completed = false;
-
-        // Similar to VWAP but with stricter participation targeting
-        Decimal remaining = total_quantity_;
-        const int check_interval_ms = 5000;
-        int elapsed_ms = 0;
-        Decimal total_value;
-
-        while (remaining > Decimal::zero() &&
-               elapsed_ms < max_duration_.count() * 1000) {
-            if (cancelled_.load(std::memory_order_acquire)) {
-                result.error = "Cancelled";
-                break;
-            }
+Executor::RunState PovExecutor::begin() {
+    return start_run(total_quantity_, max_duration_);
+}
 
-            try {
-                auto ticker = client_.ticker(symbol_).get();
-
-                // Check price limit
-                if (price_limit_) {
-                    if (side_ == Side::Buy && ticker.ask && *ticker.ask > *price_limit_) {
-                        std::this_thread::sleep_for(std::chrono::milliseconds(check_interval_ms));
-                        elapsed_ms += check_interval_ms;
-                        continue;
-                    }
-                    if (side_ == Side::Sell && ticker.bid && *ticker.bid < *price_limit_) {
-                        std::this_thread::sleep_for(std::chrono::milliseconds(check_interval_ms));
-                        elapsed_ms += check_interval_ms;
-                        continue;
-                    }
-                }
-
-                Decimal volume = ticker.volume_24h.value_or(Decimal::from_double(1000));
-                Decimal interval_volume = volume / Decimal::from_double(24 * 3600000.0 / check_interval_ms);
-                Decimal target_qty = interval_volume * target_participation_;
-                Decimal qty = (remaining < target_qty) ? remaining : target_qty;
-
-                if (qty > Decimal::zero()) {
-                    Order order;
-                    if (side_ == Side::Buy) {
-                        order = client_.buy(symbol_, qty).get();
-                    } else {
-                        order = client_.sell(symbol_, qty).get();
-                    }
-
-                    result.orders.push_back(order);
-                    result.total_filled = result.total_filled + order.filled_quantity;
-                    remaining = remaining - order.filled_quantity;
-
-                    if (order.average_price) {
-                        total_value = total_value +
-                            (order.filled_quantity * *order.average_price);
-                    }
-
-                    if (callback_) {
-                        callback_(order, remaining);
-                    }
-                }
-            } catch (const std::exception&) {
-                // Continue
+std::optional<std::chrono::milliseconds> PovExecutor::step(RunState& state) {
+    // Similar to VWAP but with stricter participation targeting
+    constexpr int check_interval_ms = 5000;
+    const auto interval = std::chrono::milliseconds(check_interval_ms);
+
+    if (cancelled()) {
+        state.result.error = "Cancelled";
+        return std::nullopt;
+    }
+    if (state.remaining <= Decimal::zero() || now_ms() >= state.deadline) {
+        return std::nullopt;
+    }
+
+    try {
+        auto ticker = market(state, client_, symbol_);
+
+        // Check price limit
+        if (price_limit_) {
+            if (side_ == Side::Buy && ticker.ask && *ticker.ask > *price_limit_) {
+                return interval;
+            }
+            if (side_ == Side::Sell && ticker.bid && *ticker.bid < *price_limit_) {
+                return interval;
             }
-
-            std::this_thread::sleep_for(std::chrono::milliseconds(check_interval_ms));
-            elapsed_ms += check_interval_ms;
         }
 
-        result.end_time = now_ms();
-        result.completed = result.error.empty() && remaining <= Decimal::zero();
+        Decimal volume = ticker.volume_24h.value_or(Decimal::from_double(1000));
+        Decimal interval_volume = volume / Decimal::from_double(24 * 3600000.0 / check_interval_ms);
+        Decimal target_qty = interval_volume * target_participation_;
+        Decimal qty = (state.remaining < target_qty) ? state.remaining : target_qty;
 
-        if (result.total_filled.is_positive()) {
-            result.average_price = total_value / result.total_filled;
-        }
+        if (qty > Decimal::zero()) {
+            Order order = market_order(client_, symbol_, side_, qty);
+            record_order(state, order);
 
-        return result;
-    });
-}
+            if (callback_) {
+                callback_(order, state.remaining);
+            }
+        }
+    } catch (const std::exception&) {
+        // Continue
+    }
 
-void PovExecutor::cancel() {
-    cancelled_.store(true, std::memory_order_release);
+    return interval;
 }
 
 }  // namespace lx::trading
@@ -0,0 +1,356 @@
+// LX Trading SDK - Execution Scheduler Implementation
+
+#include <lx/trading/execution_scheduler.hpp>
+#include <algorithm>
+#include <exception>
+
+namespace lx::trading {
+
+struct ExecutionScheduler::Run {
+    ExecutionScheduler* scheduler = nullptr;
+    Executor* executor = nullptr;
+    Executor::RunState state;
+    std::promise<ExecutionResult> promise;
+    std::mutex mutex;
+    TimerId timer = 0;
+    uint64_t generation = 0;    // Bumped per step; stale timer firings are ignored
+    bool done = false;
+};
+
+ExecutionScheduler::ExecutionScheduler(ExecutionSchedulerConfig config)
+    : config_(config), epoch_(std::chrono::steady_clock::now()) {
+    config_.tick = std::max(config_.tick, std::chrono::milliseconds(1));
+    config_.wheel_slots = std::max<size_t>(config_.wheel_slots, 1);
+    config_.worker_threads = std::max<size_t>(config_.worker_threads, 1);
+    slots_.resize(config_.wheel_slots);
+
+    tick_thread_ = std::thread(&ExecutionScheduler::tick_loop, this);
+    workers_.reserve(config_.worker_threads);
+    for (size_t i = 0; i < config_.worker_threads; ++i) {
+        workers_.emplace_back(&ExecutionScheduler::worker_loop, this);
+    }
+}
+
+ExecutionScheduler::~ExecutionScheduler() {
+    stop();
+}
+
+void ExecutionScheduler::stop() {
+    {
+        std::scoped_lock lock(wheel_mutex_, queue_mutex_);
+        if (stopping_) {
+            return;
+        }
+        stopping_ = true;
+    }
+    wheel_cv_.notify_all();
+    queue_cv_.notify_all();
+
+    if (tick_thread_.joinable()) {
+        tick_thread_.join();
+    }
+    for (auto& worker : workers_) {
+        if (worker.joinable()) {
+            worker.join();
+        }
+    }
+
+    std::vector<std::shared_ptr<Run>> left;
+    {
+        std::lock_guard lock(runs_mutex_);
+        for (auto& [symbol, runs] : runs_) {
+            left.insert(left.end(), runs.begin(), runs.end());
+        }
+        runs_.clear();
+        active_ = 0;
+    }
+    for (const auto& run : left) {
+        std::lock_guard lock(run->mutex);
+        if (!run->done) {
+            run->done = true;
+            run->state.result.error = "Stopped";
+            run->promise.set_value(run->executor->finish(run->state));
+        }
+    }
+
+    std::scoped_lock lock(wheel_mutex_, queue_mutex_);
+    for (auto& slot : slots_) {
+        slot.clear();
+    }
+    timer_slots_.clear();
+    queue_.clear();
+}
+
+// =============================================================================
+// Runs
+// =============================================================================
+
+std::future<ExecutionResult> ExecutionScheduler::submit(Executor& executor) {
+    auto run = std::make_shared<Run>();
+    run->scheduler = this;
+    run->executor = &executor;
+    auto future = run->promise.get_future();
+
+    {
+        std::lock_guard lock(queue_mutex_);
+        if (stopping_) {
+            ExecutionResult result{};
+            result.error = "Stopped";
+            run->promise.set_value(std::move(result));
+            return future;
+        }
+    }
+
+    executor.wake_ = [weak = std::weak_ptr<Run>(run)]() {
+        if (auto r = weak.lock()) {
+            r->scheduler->wake(r);
+        }
+    };
+
+    {
+        std::lock_guard lock(runs_mutex_);
+        runs_[executor.symbol()].push_back(run);
+        ++active_;
+    }
+
+    post([this, run]() {
+        std::lock_guard lock(run->mutex);
+        if (run->done) return;
+        run->state = run->executor->begin();
+        advance(run);
+    });
+    return future;
+}
+
+void ExecutionScheduler::advance(const std::shared_ptr<Run>& run) {
+    if (run->done) return;
+
+    run->timer = 0;
+    const uint64_t generation = ++run->generation;
+
+    std::optional<std::chrono::milliseconds> delay;
+    try {
+        delay = run->executor->step(run->state);
+    } catch (const std::exception& e) {
+        run->state.result.error = e.what();
+    }
+
+    if (!delay) {
+        complete(run, run->executor->finish(run->state));
+        return;
+    }
+
+    std::weak_ptr<Run> weak = run;
+    run->timer = schedule_after(*delay, [weak, generation]() {
+        auto r = weak.lock();
+        if (!r) return;
+        std::lock_guard lock(r->mutex);
+        if (r->generation == generation) {
+            r->scheduler->advance(r);
+        }
+    });
+}
+
+void ExecutionScheduler::step_now(const std::shared_ptr<Run>& run) {
+    if (run->timer != 0) {
+        cancel_timer(run->timer);
+    }
+    advance(run);
+}
+
+void ExecutionScheduler::wake(const std::shared_ptr<Run>& run) {
+    post([this, run]() {
+        std::lock_guard lock(run->mutex);
+        step_now(run);
+    });
+}
+
+void ExecutionScheduler::complete(const std::shared_ptr<Run>& run, ExecutionResult result) {
+    run->done = true;
+    {
+        std::lock_guard lock(runs_mutex_);
+        auto it = runs_.find(run->executor->symbol());
+        if (it != runs_.end()) {
+            auto& runs = it->second;
+            auto pos = std::find(runs.begin(), runs.end(), run);
+            if (pos != runs.end()) {
+                runs.erase(pos);
+                --active_;
+            }
+            if (runs.empty()) {
+                runs_.erase(it);
+            }
+        }
+    }
+    // Unregistered first, so the caller sees active_runs() drop with the result
+    run->promise.set_value(std::move(result));
+}
+
+template <typename Event, typename Handler>
+void ExecutionScheduler::dispatch(const std::string& symbol, const Event& event, Handler handler) {
+    std::vector<std::shared_ptr<Run>> targets;
+    {
+        std::lock_guard lock(runs_mutex_);
+        auto it = runs_.find(symbol);
+        if (it == runs_.end()) return;
+        targets = it->second;
+    }
+
+    for (auto& run : targets) {
+        post([this, run, event, handler]() {
+            std::lock_guard lock(run->mutex);
+            if (run->done) return;
+            if (handler(*run, event)) {
+                step_now(run);
+            }
+        });
+    }
+}
+
+void ExecutionScheduler::publish_ticker(const Ticker& ticker) {
+    dispatch(ticker.symbol, ticker, [](Run& run, const Ticker& t) {
+        return run.executor->on_ticker(run.state, t);
+    });
+}
+
+void ExecutionScheduler::publish_fill(const Order& order) {
+    dispatch(order.symbol, order, [](Run& run, const Order& o) {
+        return run.executor->on_fill(run.state, o);
+    });
+}
+
+size_t ExecutionScheduler::active_runs() const {
+    std::lock_guard lock(runs_mutex_);
+    return active_;
+}
+
+// =============================================================================
+// Timer Wheel
+// =============================================================================
+
+ExecutionScheduler::TimerId ExecutionScheduler::schedule_after(
+    std::chrono::milliseconds delay, std::function<void()> fn) {
+    std::lock_guard lock(wheel_mutex_);
+    if (stopping_) return 0;
+
+    const uint64_t now_tick = static_cast<uint64_t>(
+        (std::chrono::steady_clock::now() - epoch_) / config_.tick);
+    if (timer_slots_.empty()) {
+        // The tick thread skips ahead while idle; no slot can be missed
+        current_tick_ = std::max(current_tick_, now_tick);
+    }
+
+    const uint64_t ticks = std::max<uint64_t>(
+        1, static_cast<uint64_t>((delay + config_.tick - std::chrono::milliseconds(1)) / config_.tick));
+    const uint64_t due = std::max(now_tick, current_tick_) + ticks;
+    const size_t slot = due % slots_.size();
+
+    const TimerId id = next_timer_++;
+    slots_[slot].push_back(Timer{id, due, std::move(fn)});
+    timer_slots_.emplace(id, slot);
+    wheel_cv_.notify_one();
+    return id;
+}
+
+bool ExecutionScheduler::cancel_timer(TimerId id) {
+    std::lock_guard lock(wheel_mutex_);
+    auto it = timer_slots_.find(id);
+    if (it == timer_slots_.end()) return false;
+
+    auto& slot = slots_[it->second];
+    for (auto& timer : slot) {
+        if (timer.id == id) {
+            timer = std::move(slot.back());
+            slot.pop_back();
+            break;
+        }
+    }
+    timer_slots_.erase(it);
+    return true;
+}
+
+size_t ExecutionScheduler::pending_timers() const {
+    std::lock_guard lock(wheel_mutex_);
+    return timer_slots_.size();
+}
+
+void ExecutionScheduler::tick_loop() {
+    std::unique_lock lock(wheel_mutex_);
+    std::vector<std::function<void()>> due;
+
+    while (!stopping_) {
+        if (timer_slots_.empty()) {
+            wheel_cv_.wait(lock, [this] { return stopping_ || !timer_slots_.empty(); });
+            continue;
+        }
+
+        const auto next = epoch_ + config_.tick * (current_tick_ + 1);
+        if (wheel_cv_.wait_until(lock, next, [this] { return stopping_; })) {
+            break;
+        }
+
+        const uint64_t now_tick = static_cast<uint64_t>(
+            (std::chrono::steady_clock::now() - epoch_) / config_.tick);
+        while (current_tick_ < now_tick) {
+            ++current_tick_;
+            auto& slot = slots_[current_tick_ % slots_.size()];
+            for (size_t i = 0; i < slot.size();) {
+                if (slot[i].due_tick <= current_tick_) {
+                    timer_slots_.erase(slot[i].id);
+                    due.push_back(std::move(slot[i].fn));
+                    slot[i] = std::move(slot.back());
+                    slot.pop_back();
+                } else {
+                    ++i;    // Later turn of the wheel
+                }
+            }
+        }
+
+        if (!due.empty()) {
+            lock.unlock();
+            {
+                std::lock_guard queue_lock(queue_mutex_);
+                for (auto& fn : due) {
+                    queue_.push_back(std::move(fn));
+                }
+            }
+            queue_cv_.notify_all();
+            due.clear();
+            lock.lock();
+        }
+    }
+}
+
+// =============================================================================
+// Workers
+// =============================================================================
+
+void ExecutionScheduler::post(std::function<void()> fn) {
+    {
+        std::lock_guard lock(queue_mutex_);
+        if (stopping_) return;
+        queue_.push_back(std::move(fn));
+    }
+    queue_cv_.notify_one();
+}
+
+void ExecutionScheduler::worker_loop() {
+    while (true) {
+        std::function<void()> task;
+        {
+            std::unique_lock lock(queue_mutex_);
+            queue_cv_.wait(lock, [this] { return stopping_ || !queue_.empty(); });
+            if (stopping_) return;
+            task = std::move(queue_.front());
+            queue_.pop_front();
+        }
+
+        try {
+            task();
+        } catch (...) {
+            // Keep the worker alive; executor errors surface in their results
+        }
+    }
+}
+
+}  // namespace lx::trading
@@ -0,0 +1,169 @@
+// LX Trading SDK - HTTP Transport Implementation
+
+#include "http_client.hpp"
+#include <lx/trading/adapter.hpp>
+#include <cpr/cpr.h>
+#include <algorithm>
+
+namespace lx::trading {
+
+using json = nlohmann::json;
+
+HttpClient::HttpClient(std::string base_url, HttpClientOptions options)
+    : base_url_(std::move(base_url)), options_(options) {
+    options_.max_connections = std::max<size_t>(options_.max_connections, 1);
+}
+
+HttpClient::~HttpClient() {
+    {
+        std::lock_guard lock(queue_mutex_);
+        stopping_ = true;
+    }
+    queue_cv_.notify_all();
+    for (auto& worker : workers_) {
+        if (worker.joinable()) {
+            worker.join();
+        }
+    }
+}
+
+json HttpClient::get(const std::string& path, const std::optional<std::string>& api_key) {
+    return perform(Method::Get, path, json(), api_key);
+}
+
+json HttpClient::post(const std::string& path, const json& body,
+                      const std::optional<std::string>& api_key) {
+    return perform(Method::Post, path, body, api_key);
+}
+
+json HttpClient::del(const std::string& path, const json& body,
+                     const std::optional<std::string>& api_key) {
+    return perform(Method::Delete, path, body, api_key);
+}
+
+void HttpClient::send(Method method, std::string path, json body,
+                      std::optional<std::string> api_key, Completion done) {
+    post_task([this, method, path = std::move(path), body = std::move(body),
+               api_key = std::move(api_key), done = std::move(done)]() {
+        json response;
+        try {
+            response = perform(method, path, body, api_key);
+        } catch (...) {
+            done(nullptr, std::current_exception());
+            return;
+        }
+        done(&response, nullptr);
+    });
+}
+
+// =============================================================================
+// Connection Pool
+// =============================================================================
+
+std::unique_ptr<cpr::Session> HttpClient::acquire(Method method) {
+    {
+        std::lock_guard lock(pool_mutex_);
+        auto& idle = idle_[static_cast<int>(method)];
+        if (!idle.empty()) {
+            auto session = std::move(idle.back());
+            idle.pop_back();
+            return session;
+        }
+    }
+
+    auto session = std::make_unique<cpr::Session>();
+    session->SetTimeout(cpr::Timeout{options_.timeout});
+    if (options_.http2) {
+        session->SetHttpVersion(cpr::HttpVersion{cpr::HttpVersionCode::VERSION_2_0_TLS});
+    }
+    return session;
+}
+
+void HttpClient::release(Method method, std::unique_ptr<cpr::Session> session) {
+    std::lock_guard lock(pool_mutex_);
+    auto& idle = idle_[static_cast<int>(method)];
+    if (idle.size() < options_.max_connections) {
+        idle.push_back(std::move(session));
+    }
+    // Else dropped, closing its connection
+}
+
+json HttpClient::perform(Method method, const std::string& path, const json& body,
+                         const std::optional<std::string>& api_key) {
+    auto session = acquire(method);
+
+    cpr::Header headers;
+    if (method != Method::Get) {
+        headers["Content-Type"] = "application/json";
+    }
+    if (api_key) {
+        headers["X-API-KEY"] = *api_key;
+        headers["X-TIMESTAMP"] = std::to_string(now_ms());
+    }
+    session->SetUrl(cpr::Url{base_url_ + path});
+    session->SetHeader(headers);
+
+    cpr::Response response;
+    switch (method) {
+        case Method::Get:
+            response = session->Get();
+            break;
+        case Method::Post:
+            session->SetBody(cpr::Body{body.dump()});
+            response = session->Post();
+            break;
+        case Method::Delete:
+            session->SetBody(cpr::Body{body.dump()});
+            response = session->Delete();
+            break;
+    }
+
+    // A transport error leaves the connection in an unknown state; let the
+    // session go and open a fresh one next time
+    if (response.error.code == cpr::ErrorCode::OK) {
+        release(method, std::move(session));
+    }
+
+    const bool ok = response.status_code == 200 ||
+                    (method == Method::Post && response.status_code == 201);
+    if (!ok) {
+        throw AdapterError("HTTP " + std::to_string(response.status_code) +
+                          ": " + response.text);
+    }
+
+    return json::parse(response.text);
+}
+
+// =============================================================================
+// Workers
+// =============================================================================
+
+void HttpClient::post_task(std::function<void()> task) {
+    {
+        std::lock_guard lock(queue_mutex_);
+        if (workers_.empty()) {
+            workers_.reserve(options_.max_connections);
+            for (size_t i = 0; i < options_.max_connections; ++i) {
+                workers_.emplace_back(&HttpClient::worker_loop, this);
+            }
+        }
+        queue_.push_back(std::move(task));
+    }
+    queue_cv_.notify_one();
+}
+
+void HttpClient::worker_loop() {
+    while (true) {
+        std::function<void()> task;
+        {
+            std::unique_lock lock(queue_mutex_);
+            queue_cv_.wait(lock, [this] { return stopping_ || !queue_.empty(); });
+            if (queue_.empty()) return;     // Stopping and drained
+            task = std::move(queue_.front());
+            queue_.pop_front();
+        }
+        task();     // packaged_task stores any exception in its future
+    }
+}
+
+}  // namespace lx::trading
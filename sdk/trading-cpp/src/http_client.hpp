@@ -0,0 +1,108 @@
+// LX Trading SDK - HTTP Transport
+// Persistent pooled connections and asynchronous requests over cpr
+
+#pragma once
+
+#include <lx/trading/types.hpp>
+#include <nlohmann/json.hpp>
+#include <chrono>
+#include <condition_variable>
+#include <deque>
+#include <exception>
+#include <functional>
+#include <future>
+#include <memory>
+#include <mutex>
+#include <optional>
+#include <string>
+#include <thread>
+#include <type_traits>
+#include <vector>
+
+namespace cpr {
+class Session;
+}
+
+namespace lx::trading {
+
+struct HttpClientOptions {
+    size_t max_connections = 4;                 // Idle sessions kept per method; async workers
+    bool http2 = true;                          // Offer HTTP/2 on TLS, else HTTP/1.1 keep-alive
+    std::chrono::milliseconds timeout{10000};
+};
+
+// REST client over a pool of cpr sessions. A session keeps its connection
+// (and TLS session) open between requests, so only a session's first
+// request pays the TCP/TLS handshake. Sessions are pooled per method
+// because cpr carries a POST body over to later requests on the same
+// handle. get()/post()/del() block the calling thread; request() runs on
+// a fixed set of workers, one per connection, so a burst of orders does
+// not spawn a thread per call.
+class HttpClient {
+public:
+    enum class Method { Get, Post, Delete };
+
+    explicit HttpClient(std::string base_url, HttpClientOptions options = {});
+    ~HttpClient();
+
+    HttpClient(const HttpClient&) = delete;
+    HttpClient& operator=(const HttpClient&) = delete;
+
+    nlohmann::json get(const std::string& path,
+                       const std::optional<std::string>& api_key = std::nullopt);
+    nlohmann::json post(const std::string& path,
+                        const nlohmann::json& body,
+                        const std::optional<std::string>& api_key = std::nullopt);
+    nlohmann::json del(const std::string& path,
+                       const nlohmann::json& body = {},
+                       const std::optional<std::string>& api_key = std::nullopt);
+
+    // Send on a worker and hand the response to `parse` there; errors,
+    // including AdapterError for a bad status, surface through the future
+    template <typename F>
+    auto request(Method method, std::string path, nlohmann::json body,
+                 std::optional<std::string> api_key, F parse)
+        -> std::future<std::invoke_result_t<F, nlohmann::json>> {
+        using Result = std::invoke_result_t<F, nlohmann::json>;
+        auto task = std::make_shared<std::packaged_task<Result()>>(
+            [this, method, path = std::move(path), body = std::move(body),
+             api_key = std::move(api_key), parse = std::move(parse)]() mutable {
+                return parse(perform(method, path, body, api_key));
+            });
+        auto future = task->get_future();
+        post_task([task]() { (*task)(); });
+        return future;
+    }
+
+    // Send on a worker and call `done` there with the response, or with
+    // nullptr and the error; for replies that settle several futures.
+    // `done` must not throw.
+    using Completion = std::function<void(const nlohmann::json* response, std::exception_ptr error)>;
+    void send(Method method, std::string path, nlohmann::json body,
+              std::optional<std::string> api_key, Completion done);
+
+private:
+    nlohmann::json perform(Method method,
+                           const std::string& path,
+                           const nlohmann::json& body,
+                           const std::optional<std::string>& api_key);
+    std::unique_ptr<cpr::Session> acquire(Method method);
+    void release(Method method, std::unique_ptr<cpr::Session> session);
+
+    void post_task(std::function<void()> task);
+    void worker_loop();
+
+    std::string base_url_;
+    HttpClientOptions options_;
+
+    std::mutex pool_mutex_;
+    std::vector<std::unique_ptr<cpr::Session>> idle_[3];   // By Method
+
+    std::mutex queue_mutex_;
+    std::condition_variable queue_cv_;
+    std::deque<std::function<void()>> queue_;
+    std::vector<std::thread> workers_;          // Started by the first request()
+    bool stopping_ = false;
+};
+
+}  // namespace lx::trading
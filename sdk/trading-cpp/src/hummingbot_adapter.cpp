@@ -2,15 +2,29 @@
 
 #include <lx/trading/adapters/hummingbot.hpp>
 #include <lx/trading/orderbook.hpp>
-#include <cpr/cpr.h>
+#include "http_client.hpp"
 #include <nlohmann/json.hpp>
+#include <algorithm>
 
 namespace lx::trading {
 
 using json = nlohmann::json;
 
+namespace {
+
+HttpClientOptions http_options(const HummingbotConfig& config) {
+    HttpClientOptions options;
+    options.max_connections = static_cast<size_t>(std::max(config.max_connections, 1));
+    options.http2 = config.http2;
+    return options;
+}
+
+}  // namespace
+
 HummingbotAdapter::HummingbotAdapter(std::string_view name, const HummingbotConfig& config)
-    : name_(name), config_(config), capabilities_(VenueCapabilities::amm()) {}
+    : name_(name), config_(config), capabilities_(VenueCapabilities::amm()) {
+    http_ = std::make_unique<HttpClient>(config.base_url(), http_options(config));
+}
 
 HummingbotAdapter::~HummingbotAdapter() = default;
 
@@ -33,17 +47,46 @@ json HummingbotAdapter::build_request_body() {
     return body;
 }
 
+json HummingbotAdapter::swap_body(const std::string& base_token, const std::string& quote_token,
+                                  Decimal amount, bool is_buy, Decimal slippage) {
+    json body = build_request_body();
+    body["base"] = base_token;
+    body["quote"] = quote_token;
+    body["amount"] = amount.to_string();
+    body["side"] = is_buy ? "BUY" : "SELL";
+    body["limitPrice"] = "";
+    body["allowedSlippage"] = slippage.to_string() + "/100";
+    return body;
+}
+
+Trade HummingbotAdapter::parse_swap(const json& data, const std::string& base_token,
+                                    const std::string& quote_token, Decimal amount, bool is_buy) {
+    Trade trade;
+    trade.trade_id = data.value("txHash", "");
+    trade.order_id = trade.trade_id;
+    trade.symbol = base_token + "-" + quote_token;
+    trade.venue = name_;
+    trade.side = is_buy ? Side::Buy : Side::Sell;
+    trade.price = Decimal::from_string(data.value("price", "0"));
+    trade.quantity = amount;
+    trade.fee.asset = "GAS";
+    trade.fee.amount = Decimal::from_string(data.value("gasPrice", "0"));
+    trade.timestamp = now_ms();
+    trade.is_maker = false;
+    return trade;
+}
+
 std::future<void> HummingbotAdapter::connect() {
     return std::async(std::launch::async, [this]() {
         auto start = now_ns();
 
-        auto response = cpr::Get(cpr::Url{config_.base_url()});
-
-        if (response.status_code != 200) {
-            throw AdapterError("Gateway not ready: " + response.text);
+        json data;
+        try {
+            data = http_->get("");
+        } catch (const AdapterError& e) {
+            throw AdapterError(std::string("Gateway not ready: ") + e.what());
         }
 
-        auto data = json::parse(response.text);
         if (data.value("status", "") != "ok") {
             throw AdapterError("Gateway not ready");
         }
@@ -60,21 +103,11 @@ std::future<void> HummingbotAdapter::disconnect() {
 }
 
 std::future<std::vector<MarketInfo>> HummingbotAdapter::get_markets() {
-    return std::async(std::launch::async, [this]() {
-        auto start = now_ns();
-
-        auto response = cpr::Post(
-            cpr::Url{config_.base_url() + "/amm/tokens"},
-            cpr::Header{{"Content-Type", "application/json"}},
-            cpr::Body{build_request_body().dump()});
-
+    auto start = now_ns();
+    return http_->request(HttpClient::Method::Post, "/amm/tokens", build_request_body(),
+        std::nullopt, [this, start](const json& data) {
         update_latency(start);
 
-        if (response.status_code != 200) {
-            throw AdapterError("Failed to get markets: " + response.text);
-        }
-
-        auto data = json::parse(response.text);
         std::vector<MarketInfo> markets;
 
         auto tokens = data.value("tokens", json::array());
@@ -101,34 +134,25 @@ std::future<std::vector<MarketInfo>> HummingbotAdapter::get_markets() {
 }
 
 std::future<Ticker> HummingbotAdapter::get_ticker(const std::string& symbol) {
-    return std::async(std::launch::async, [this, symbol]() {
-        auto pair = TradingPair::from_symbol(symbol);
-        if (!pair) throw AdapterError("Invalid symbol: " + symbol);
-
-        std::string base(pair->base.data());
-        std::string quote(pair->quote.data());
-
-        auto start = now_ns();
+    auto pair = TradingPair::from_symbol(symbol);
+    if (!pair) {
+        return std::async(std::launch::deferred, [symbol]() -> Ticker {
+            throw AdapterError("Invalid symbol: " + symbol);
+        });
+    }
 
-        json body = build_request_body();
-        body["base"] = base;
-        body["quote"] = quote;
-        body["amount"] = "1";
-        body["side"] = "BUY";
+    auto start = now_ns();
 
-        auto response = cpr::Post(
-            cpr::Url{config_.base_url() + "/amm/price"},
-            cpr::Header{{"Content-Type", "application/json"}},
-            cpr::Body{body.dump()});
+    json body = build_request_body();
+    body["base"] = std::string(pair->base.data());
+    body["quote"] = std::string(pair->quote.data());
+    body["amount"] = "1";
+    body["side"] = "BUY";
 
+    return http_->request(HttpClient::Method::Post, "/amm/price", std::move(body), std::nullopt,
+        [this, symbol, start](const json& data) {
         update_latency(start);
 
-        if (response.status_code != 200) {
-            throw AdapterError("Failed to get ticker: " + response.text);
-        }
-
-        auto data = json::parse(response.text);
-
         Ticker ticker;
         ticker.symbol = symbol;
         ticker.venue = name_;
@@ -162,21 +186,11 @@ std::future<std::vector<Trade>> HummingbotAdapter::get_trades(
 }
 
 std::future<std::vector<Balance>> HummingbotAdapter::get_balances() {
-    return std::async(std::launch::async, [this]() {
-        auto start = now_ns();
-
-        auto response = cpr::Post(
-            cpr::Url{config_.base_url() + "/chain/balances"},
-            cpr::Header{{"Content-Type", "application/json"}},
-            cpr::Body{build_request_body().dump()});
-
+    auto start = now_ns();
+    return http_->request(HttpClient::Method::Post, "/chain/balances", build_request_body(),
+        std::nullopt, [this, start](const json& data) {
         update_latency(start);
 
-        if (response.status_code != 200) {
-            throw AdapterError("Failed to get balances: " + response.text);
-        }
-
-        auto data = json::parse(response.text);
         std::vector<Balance> balances;
 
         auto bals = data.value("balances", json::object());
@@ -212,17 +226,28 @@ std::future<std::vector<Order>> HummingbotAdapter::get_open_orders(
 }
 
 std::future<Order> HummingbotAdapter::place_order(const OrderRequest& request) {
-    return std::async(std::launch::async, [this, request]() {
-        auto pair = TradingPair::from_symbol(request.symbol);
-        if (!pair) throw AdapterError("Invalid symbol: " + request.symbol);
+    auto pair = TradingPair::from_symbol(request.symbol);
+    if (!pair) {
+        return std::async(std::launch::deferred, [symbol = request.symbol]() -> Order {
+            throw AdapterError("Invalid symbol: " + symbol);
+        });
+    }
+
+    std::string base(pair->base.data());
+    std::string quote(pair->quote.data());
+    const bool is_buy = request.side == Side::Buy;
+
+    auto start = now_ns();
 
-        std::string base(pair->base.data());
-        std::string quote(pair->quote.data());
+    // Sent as the swap itself rather than through execute_swap(), so the
+    // order does not hold a worker waiting on another
+    json body = swap_body(base, quote, request.quantity, is_buy, Decimal::from_double(0.01));
 
-        auto trade = execute_swap(
-            base, quote, request.quantity,
-            request.side == Side::Buy,
-            Decimal::from_double(0.01)).get();
+    return http_->request(HttpClient::Method::Post, "/amm/trade", std::move(body), std::nullopt,
+        [this, request, base, quote, is_buy, start](const json& data) {
+        update_latency(start);
+
+        Trade trade = parse_swap(data, base, quote, request.quantity, is_buy);
 
         Order order;
         order.order_id = trade.trade_id;
@@ -265,29 +290,18 @@ std::future<SwapQuote> HummingbotAdapter::get_swap_quote(
     const std::string& quote_token,
     Decimal amount,
     bool is_buy) {
-    return std::async(std::launch::async,
-        [this, base_token, quote_token, amount, is_buy]() {
-        auto start = now_ns();
+    auto start = now_ns();
 
-        json body = build_request_body();
-        body["base"] = base_token;
-        body["quote"] = quote_token;
-        body["amount"] = amount.to_string();
-        body["side"] = is_buy ? "BUY" : "SELL";
-
-        auto response = cpr::Post(
-            cpr::Url{config_.base_url() + "/amm/price"},
-            cpr::Header{{"Content-Type", "application/json"}},
-            cpr::Body{body.dump()});
+    json body = build_request_body();
+    body["base"] = base_token;
+    body["quote"] = quote_token;
+    body["amount"] = amount.to_string();
+    body["side"] = is_buy ? "BUY" : "SELL";
 
+    return http_->request(HttpClient::Method::Post, "/amm/price", std::move(body), std::nullopt,
+        [this, base_token, quote_token, amount, start](const json& data) {
         update_latency(start);
 
-        if (response.status_code != 200) {
-            throw AdapterError("Failed to get quote: " + response.text);
-        }
-
-        auto data = json::parse(response.text);
-
         SwapQuote quote;
         quote.base_token = base_token;
         quote.quote_token = quote_token;
@@ -307,70 +321,30 @@ std::future<Trade> HummingbotAdapter::execute_swap(
     Decimal amount,
     bool is_buy,
     Decimal slippage) {
-    return std::async(std::launch::async,
-        [this, base_token, quote_token, amount, is_buy, slippage]() {
-        auto start = now_ns();
-
-        json body = build_request_body();
-        body["base"] = base_token;
-        body["quote"] = quote_token;
-        body["amount"] = amount.to_string();
-        body["side"] = is_buy ? "BUY" : "SELL";
-        body["limitPrice"] = "";
-        body["allowedSlippage"] = slippage.to_string() + "/100";
+    auto start = now_ns();
 
-        auto response = cpr::Post(
-            cpr::Url{config_.base_url() + "/amm/trade"},
-            cpr::Header{{"Content-Type", "application/json"}},
-            cpr::Body{body.dump()});
+    json body = swap_body(base_token, quote_token, amount, is_buy, slippage);
 
+    return http_->request(HttpClient::Method::Post, "/amm/trade", std::move(body), std::nullopt,
+        [this, base_token, quote_token, amount, is_buy, start](const json& data) {
         update_latency(start);
-
-        if (response.status_code != 200) {
-            throw AdapterError("Failed to execute swap: " + response.text);
-        }
-
-        auto data = json::parse(response.text);
-
-        Trade trade;
-        trade.trade_id = data.value("txHash", "");
-        trade.order_id = trade.trade_id;
-        trade.symbol = base_token + "-" + quote_token;
-        trade.venue = name_;
-        trade.side = is_buy ? Side::Buy : Side::Sell;
-        trade.price = Decimal::from_string(data.value("price", "0"));
-        trade.quantity = amount;
-        trade.fee.asset = "GAS";
-        trade.fee.amount = Decimal::from_string(data.value("gasPrice", "0"));
-        trade.timestamp = now_ms();
-        trade.is_maker = false;
-        return trade;
+        return parse_swap(data, base_token, quote_token, amount, is_buy);
     });
 }
 
 std::future<PoolInfo> HummingbotAdapter::get_pool_info(
     const std::string& base_token,
     const std::string& quote_token) {
-    return std::async(std::launch::async, [this, base_token, quote_token]() {
-        auto start = now_ns();
+    auto start = now_ns();
 
-        json body = build_request_body();
-        body["token0"] = base_token;
-        body["token1"] = quote_token;
-
-        auto response = cpr::Post(
-            cpr::Url{config_.base_url() + "/amm/poolPrice"},
-            cpr::Header{{"Content-Type", "application/json"}},
-            cpr::Body{body.dump()});
+    json body = build_request_body();
+    body["token0"] = base_token;
+    body["token1"] = quote_token;
 
+    return http_->request(HttpClient::Method::Post, "/amm/poolPrice", std::move(body), std::nullopt,
+        [this, base_token, quote_token, start](const json& data) {
         update_latency(start);
 
-        if (response.status_code != 200) {
-            throw AdapterError("Failed to get pool info: " + response.text);
-        }
-
-        auto data = json::parse(response.text);
-
         PoolInfo info;
         info.address = data.value("token0Address", "");
         info.base_token = base_token;
@@ -389,30 +363,19 @@ std::future<LiquidityResult> HummingbotAdapter::add_liquidity(
     Decimal base_amount,
     Decimal quote_amount,
     Decimal slippage) {
-    return std::async(std::launch::async,
-        [this, base_token, quote_token, base_amount, quote_amount, slippage]() {
-        auto start = now_ns();
-
-        json body = build_request_body();
-        body["token0"] = base_token;
-        body["token1"] = quote_token;
-        body["amount0"] = base_amount.to_string();
-        body["amount1"] = quote_amount.to_string();
-        body["allowedSlippage"] = slippage.to_string() + "/100";
+    auto start = now_ns();
 
-        auto response = cpr::Post(
-            cpr::Url{config_.base_url() + "/amm/liquidity/add"},
-            cpr::Header{{"Content-Type", "application/json"}},
-            cpr::Body{body.dump()});
+    json body = build_request_body();
+    body["token0"] = base_token;
+    body["token1"] = quote_token;
+    body["amount0"] = base_amount.to_string();
+    body["amount1"] = quote_amount.to_string();
+    body["allowedSlippage"] = slippage.to_string() + "/100";
 
+    return http_->request(HttpClient::Method::Post, "/amm/liquidity/add", std::move(body),
+        std::nullopt, [this, base_amount, quote_amount, start](const json& data) {
         update_latency(start);
 
-        if (response.status_code != 200) {
-            throw AdapterError("Failed to add liquidity: " + response.text);
-        }
-
-        auto data = json::parse(response.text);
-
         LiquidityResult result;
         result.tx_hash = data.value("txHash", "");
         result.pool_address = data.value("poolAddress", "");
@@ -428,28 +391,17 @@ std::future<LiquidityResult> HummingbotAdapter::remove_liquidity(
     const std::string& pool_address,
     Decimal liquidity_amount,
     Decimal slippage) {
-    return std::async(std::launch::async,
-        [this, pool_address, liquidity_amount, slippage]() {
-        auto start = now_ns();
+    auto start = now_ns();
 
-        json body = build_request_body();
-        body["tokenId"] = pool_address;
-        body["decreasePercent"] = "100";
-        body["allowedSlippage"] = slippage.to_string() + "/100";
-
-        auto response = cpr::Post(
-            cpr::Url{config_.base_url() + "/amm/liquidity/remove"},
-            cpr::Header{{"Content-Type", "application/json"}},
-            cpr::Body{body.dump()});
+    json body = build_request_body();
+    body["tokenId"] = pool_address;
+    body["decreasePercent"] = "100";
+    body["allowedSlippage"] = slippage.to_string() + "/100";
 
+    return http_->request(HttpClient::Method::Post, "/amm/liquidity/remove", std::move(body),
+        std::nullopt, [this, pool_address, liquidity_amount, start](const json& data) {
         update_latency(start);
 
-        if (response.status_code != 200) {
-            throw AdapterError("Failed to remove liquidity: " + response.text);
-        }
-
-        auto data = json::parse(response.text);
-
         LiquidityResult result;
         result.tx_hash = data.value("txHash", "");
         result.pool_address = pool_address;
@@ -462,21 +414,11 @@ std::future<LiquidityResult> HummingbotAdapter::remove_liquidity(
 }
 
 std::future<std::vector<LpPosition>> HummingbotAdapter::get_lp_positions() {
-    return std::async(std::launch::async, [this]() {
-        auto start = now_ns();
-
-        auto response = cpr::Post(
-            cpr::Url{config_.base_url() + "/amm/position"},
-            cpr::Header{{"Content-Type", "application/json"}},
-            cpr::Body{build_request_body().dump()});
-
+    auto start = now_ns();
+    return http_->request(HttpClient::Method::Post, "/amm/position", build_request_body(),
+        std::nullopt, [this, start](const json& data) {
         update_latency(start);
 
-        if (response.status_code != 200) {
-            throw AdapterError("Failed to get LP positions: " + response.text);
-        }
-
-        auto data = json::parse(response.text);
         std::vector<LpPosition> positions;
 
         if (data.is_array()) {
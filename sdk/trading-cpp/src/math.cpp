@@ -2,6 +2,7 @@
 // SIMD-optimized where beneficial
 
 #include <lx/trading/math.hpp>
+#include "math_simd.hpp"
 #include <algorithm>
 #include <numeric>
 
@@ -318,57 +319,95 @@ double cvar(
 }
 
 // =============================================================================
-// SIMD Operations (AVX2)
+// SIMD Operations
 // =============================================================================
 
-#ifdef LX_SIMD_AVX2
+namespace {
+
+const simd::KernelTable* select_kernels() noexcept {
+#if defined(LX_TRADING_HAVE_AVX512)
+    if (__builtin_cpu_supports("avx512f")) {
+        return &simd::avx512_kernels();
+    }
+#endif
+#if defined(LX_TRADING_HAVE_AVX2)
+    if (__builtin_cpu_supports("avx2") && __builtin_cpu_supports("fma")) {
+        return &simd::avx2_kernels();
+    }
+#endif
+#if defined(LX_TRADING_HAVE_NEON)
+    return &simd::neon_kernels();
+#else
+    return nullptr;
+#endif
+}
+
+// nullptr when no vector kernel applies
+const simd::KernelTable* kernels() noexcept {
+    static const simd::KernelTable* table = select_kernels();
+    return table;
+}
+
+}  // namespace
+
+const char* simd_isa() noexcept {
+    const auto* k = kernels();
+    return k ? k->name : "scalar";
+}
 
 void black_scholes_batch(
     const double* S, const double* K, const double* T,
     const double* r, const double* sigma,
     double* prices, size_t count, bool is_call) noexcept {
-    // Process 4 at a time with AVX2
-    size_t i = 0;
-
-    for (; i + 4 <= count; i += 4) {
-        __m256d vS = _mm256_loadu_pd(&S[i]);
-        __m256d vK = _mm256_loadu_pd(&K[i]);
-        __m256d vT = _mm256_loadu_pd(&T[i]);
-        __m256d vr = _mm256_loadu_pd(&r[i]);
-        __m256d vsigma = _mm256_loadu_pd(&sigma[i]);
-
-        // sqrt(T)
-        __m256d sqrt_T = _mm256_sqrt_pd(vT);
-
-        // d1 = (log(S/K) + (r + 0.5*sigma^2)*T) / (sigma*sqrt(T))
-        __m256d log_SK = _mm256_div_pd(vS, vK);
-        // Note: Would need log intrinsics or loop here
-
-        // Simplified: fall back to scalar for now
-        for (size_t j = 0; j < 4; ++j) {
-            prices[i + j] = black_scholes(S[i+j], K[i+j], T[i+j], r[i+j], sigma[i+j], is_call);
-        }
-    }
+    const auto* k = kernels();
+    size_t i = k ? k->black_scholes(S, K, T, r, sigma, prices, count, is_call) : 0;
 
-    // Handle remainder
+    // Remainder
     for (; i < count; ++i) {
         prices[i] = black_scholes(S[i], K[i], T[i], r[i], sigma[i], is_call);
     }
 }
 
-double sum_avx2(const double* data, size_t count) noexcept {
-    __m256d sum = _mm256_setzero_pd();
-    size_t i = 0;
+void norm_cdf_batch(const double* x, double* result, size_t count) noexcept {
+    const auto* k = kernels();
+    size_t i = k ? k->norm_cdf(x, result, count) : 0;
 
-    for (; i + 4 <= count; i += 4) {
-        __m256d v = _mm256_loadu_pd(&data[i]);
-        sum = _mm256_add_pd(sum, v);
+    for (; i < count; ++i) {
+        result[i] = norm_cdf(x[i]);
     }
+}
+
+void greeks_batch(
+    const double* S, const double* K, const double* T,
+    const double* r, const double* sigma,
+    Greeks* out, size_t count, bool is_call) noexcept {
+    const auto* k = kernels();
+    size_t i = k ? k->greeks(S, K, T, r, sigma, out, count, is_call) : 0;
 
-    // Horizontal sum
-    double result[4];
-    _mm256_storeu_pd(result, sum);
-    double total = result[0] + result[1] + result[2] + result[3];
+    for (; i < count; ++i) {
+        out[i] = greeks(S[i], K[i], T[i], r[i], sigma[i], is_call);
+    }
+}
+
+void implied_volatility_batch(
+    const double* price, const double* S, const double* K,
+    const double* T, const double* r,
+    double* out, size_t count, bool is_call,
+    double tol, int max_iter) noexcept {
+    const auto* k = kernels();
+    size_t i = k ? k->implied_volatility(price, S, K, T, r, out, count, is_call, tol, max_iter) : 0;
+
+    for (; i < count; ++i) {
+        out[i] = (T[i] > 0)
+            ? implied_volatility(price[i], S[i], K[i], T[i], r[i], is_call, tol, max_iter)
+            : 0.2;
+    }
+}
+
+double sum_avx2(const double* data, size_t count) noexcept {
+    const auto* k = kernels();
+    double total = 0.0;
+    size_t i = k ? k->sum(data, count, total) : 0;
 
     // Remainder
     for (; i < count; ++i) {
@@ -386,19 +425,9 @@ double mean_avx2(const double* data, size_t count) noexcept {
 double variance_avx2(const double* data, size_t count, double mean) noexcept {
     if (count < 2) return 0.0;
 
-    __m256d vmean = _mm256_set1_pd(mean);
-    __m256d sum_sq = _mm256_setzero_pd();
-    size_t i = 0;
-
-    for (; i + 4 <= count; i += 4) {
-        __m256d v = _mm256_loadu_pd(&data[i]);
-        __m256d diff = _mm256_sub_pd(v, vmean);
-        sum_sq = _mm256_fmadd_pd(diff, diff, sum_sq);
-    }
-
-    double result[4];
-    _mm256_storeu_pd(result, sum_sq);
-    double total = result[0] + result[1] + result[2] + result[3];
+    const auto* k = kernels();
+    double total = 0.0;
+    size_t i = k ? k->sum_sq_dev(data, count, mean, total) : 0;
 
     // Remainder
     for (; i < count; ++i) {
@@ -409,8 +438,6 @@ double variance_avx2(const double* data, size_t count, double mean) noexcept {
     return total / (count - 1);
 }
 
-#endif  // LX_SIMD_AVX2
-
 // =============================================================================
 // Statistical Utilities
 // =============================================================================
@@ -543,4 +570,151 @@ double beta(
     return (var_m > 0) ? cov / var_m : 0.0;
 }
 
+// =============================================================================
+// Streaming Statistics
+// =============================================================================
+
+RollingStats::RollingStats(size_t window) : buffer_(std::max<size_t>(window, 1)) {}
+
+void RollingStats::update(double x) noexcept {
+    const size_t window = buffer_.size();
+    if (count_ < window) {
+        buffer_[count_++] = x;
+        double delta = x - mean_;
+        mean_ += delta / count_;
+        m2_ += delta * (x - mean_);
+        return;
+    }
+
+    // Replace the oldest sample in one step
+    double old = buffer_[head_];
+    buffer_[head_] = x;
+    head_ = (head_ + 1) % window;
+
+    double old_mean = mean_;
+    mean_ += (x - old) / window;
+    m2_ += (x - old) * (x - mean_ + old - old_mean);
+    m2_ = std::max(m2_, 0.0);
+}
+
+void RollingStats::update(const double* data, size_t count) noexcept {
+    for (size_t i = 0; i < count; ++i) {
+        update(data[i]);
+    }
+}
+
+void RollingStats::reset() noexcept {
+    head_ = 0;
+    count_ = 0;
+    mean_ = 0.0;
+    m2_ = 0.0;
+}
+
+double RollingStats::variance() const noexcept {
+    return (count_ < 2) ? 0.0 : m2_ / (count_ - 1);
+}
+
+RollingCovariance::RollingCovariance(size_t window)
+    : xs_(std::max<size_t>(window, 1)), ys_(std::max<size_t>(window, 1)) {}
+
+void RollingCovariance::add(double x, double y) noexcept {
+    ++count_;
+    double dx = x - mean_x_;
+    double dy = y - mean_y_;
+    mean_x_ += dx / count_;
+    mean_y_ += dy / count_;
+    cxy_ += dx * (y - mean_y_);
+    m2x_ += dx * (x - mean_x_);
+    m2y_ += dy * (y - mean_y_);
+}
+
+void RollingCovariance::remove(double x, double y) noexcept {
+    if (count_ <= 1) {
+        count_ = 0;
+        mean_x_ = mean_y_ = cxy_ = m2x_ = m2y_ = 0.0;
+        return;
+    }
+    // Inverse of add(): recover the means without (x, y) first
+    --count_;
+    double prev_x = mean_x_ - (x - mean_x_) / count_;
+    double prev_y = mean_y_ - (y - mean_y_) / count_;
+    cxy_ -= (x - prev_x) * (y - mean_y_);
+    m2x_ = std::max(m2x_ - (x - prev_x) * (x - mean_x_), 0.0);
+    m2y_ = std::max(m2y_ - (y - prev_y) * (y - mean_y_), 0.0);
+    mean_x_ = prev_x;
+    mean_y_ = prev_y;
+}
+
+void RollingCovariance::update(double x, double y) noexcept {
+    const size_t window = xs_.size();
+    if (count_ < window) {
+        xs_[count_] = x;
+        ys_[count_] = y;
+        add(x, y);
+        return;
+    }
+
+    remove(xs_[head_], ys_[head_]);
+    xs_[head_] = x;
+    ys_[head_] = y;
+    head_ = (head_ + 1) % window;
+    add(x, y);
+}
+
+void RollingCovariance::update(const double* x, const double* y, size_t count) noexcept {
+    for (size_t i = 0; i < count; ++i) {
+        update(x[i], y[i]);
+    }
+}
+
+void RollingCovariance::reset() noexcept {
+    head_ = 0;
+    count_ = 0;
+    mean_x_ = mean_y_ = cxy_ = m2x_ = m2y_ = 0.0;
+}
+
+double RollingCovariance::covariance() const noexcept {
+    return (count_ < 2) ? 0.0 : cxy_ / (count_ - 1);
+}
+
+double RollingCovariance::variance_x() const noexcept {
+    return (count_ < 2) ? 0.0 : m2x_ / (count_ - 1);
+}
+
+double RollingCovariance::variance_y() const noexcept {
+    return (count_ < 2) ? 0.0 : m2y_ / (count_ - 1);
+}
+
+double RollingCovariance::correlation() const noexcept {
+    double denom = std::sqrt(m2x_ * m2y_);
+    return (count_ >= 2 && denom > 0) ? cxy_ / denom : 0.0;
+}
+
+double RollingCovariance::beta() const noexcept {
+    double var_y = variance_y();
+    return (var_y > 0) ? covariance() / var_y : 0.0;
+}
+
+void StreamingDrawdown::update(double price) noexcept {
+    size_t i = count_++;
+    if (i == 0 || price > peak_) {
+        peak_ = price;
+        peak_index_ = i;
+    }
+
+    current_ = (peak_ > 0) ? (peak_ - price) / peak_ : 0.0;
+
+    if (current_ > max_) {
+        max_ = current_;
+        max_peak_index_ = peak_index_;
+        max_trough_index_ = i;
+    }
+}
+
+void StreamingDrawdown::update(const double* prices, size_t count) noexcept {
+    for (size_t i = 0; i < count; ++i) {
+        update(prices[i]);
+    }
+}
+
 }  // namespace lx::trading::math
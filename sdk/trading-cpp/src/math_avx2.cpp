@@ -0,0 +1,68 @@
+// LX Trading SDK - AVX2 Math Kernels
+// Built with -mavx2 -mfma and only reached through the runtime dispatch in
+// math.cpp, after the CPU reports both features
+
+#include "math_simd.hpp"
+#include <immintrin.h>
+
+namespace lx::trading::math::simd {
+
+namespace {
+
+struct Avx2 {
+    using V = __m256d;
+    using M = __m256d;
+    static constexpr size_t W = 4;
+
+    static V load(const double* p) { return _mm256_loadu_pd(p); }
+    static void store(double* p, V v) { _mm256_storeu_pd(p, v); }
+    static V set1(double x) { return _mm256_set1_pd(x); }
+
+    static V add(V a, V b) { return _mm256_add_pd(a, b); }
+    static V sub(V a, V b) { return _mm256_sub_pd(a, b); }
+    static V mul(V a, V b) { return _mm256_mul_pd(a, b); }
+    static V div(V a, V b) { return _mm256_div_pd(a, b); }
+    static V fma(V a, V b, V c) { return _mm256_fmadd_pd(a, b, c); }
+    static V sqrt(V a) { return _mm256_sqrt_pd(a); }
+    static V min(V a, V b) { return _mm256_min_pd(a, b); }
+    static V max(V a, V b) { return _mm256_max_pd(a, b); }
+    static V abs(V a) { return _mm256_andnot_pd(_mm256_set1_pd(-0.0), a); }
+    static V round(V a) { return _mm256_round_pd(a, _MM_FROUND_TO_NEAREST_INT | _MM_FROUND_NO_EXC); }
+
+    static M lt(V a, V b) { return _mm256_cmp_pd(a, b, _CMP_LT_OQ); }
+    static M le(V a, V b) { return _mm256_cmp_pd(a, b, _CMP_LE_OQ); }
+    static M gt(V a, V b) { return _mm256_cmp_pd(a, b, _CMP_GT_OQ); }
+    static M mask_and(M a, M b) { return _mm256_and_pd(a, b); }
+    static M mask_or(M a, M b) { return _mm256_or_pd(a, b); }
+    static M mask_andnot(M a, M b) { return _mm256_andnot_pd(b, a); }
+    static V select(M m, V a, V b) { return _mm256_blendv_pd(b, a, m); }
+    static bool any(M m) { return _mm256_movemask_pd(m) != 0; }
+    static bool all(M m) { return _mm256_movemask_pd(m) == 0xF; }
+
+    // n + 1023 lands in the low mantissa bits after adding 2^52; shifting
+    // it into the exponent field gives 2^n
+    static V pow2(V n) {
+        const __m256i bits = _mm256_castpd_si256(_mm256_add_pd(n, _mm256_set1_pd(4503599627371519.0)));
+        return _mm256_castsi256_pd(_mm256_slli_epi64(bits, 52));
+    }
+
+    static void split(V x, V& m, V& e) {
+        const __m256i bits = _mm256_castpd_si256(x);
+        const __m256i biased = _mm256_or_si256(_mm256_srli_epi64(bits, 52),
+                                               _mm256_set1_epi64x(0x4330000000000000LL));
+        e = _mm256_sub_pd(_mm256_castsi256_pd(biased), _mm256_set1_pd(4503599627371519.0));
+        const __m256i mantissa = _mm256_or_si256(
+            _mm256_and_si256(bits, _mm256_set1_epi64x(0x000FFFFFFFFFFFFFLL)),
+            _mm256_set1_epi64x(0x3FF0000000000000LL));
+        m = _mm256_castsi256_pd(mantissa);
+    }
+};
+
+}  // namespace
+
+const KernelTable& avx2_kernels() noexcept {
+    static const KernelTable table = make_table<Avx2>("avx2");
+    return table;
+}
+
+}  // namespace lx::trading::math::simd
@@ -0,0 +1,64 @@
+// LX Trading SDK - AVX-512 Math Kernels
+// Built with -mavx512f and only reached through the runtime dispatch in
+// math.cpp, after the CPU reports AVX-512F
+
+#include "math_simd.hpp"
+#include <immintrin.h>
+
+// GCC 12 flags the _mm512_undefined_pd() pass-through operand inside
+// several unmasked AVX-512 intrinsics as uninitialized
+#if defined(__GNUC__) && !defined(__clang__)
+#pragma GCC diagnostic ignored "-Wuninitialized"
+#pragma GCC diagnostic ignored "-Wmaybe-uninitialized"
+#endif
+
+namespace lx::trading::math::simd {
+
+namespace {
+
+struct Avx512 {
+    using V = __m512d;
+    using M = __mmask8;
+    static constexpr size_t W = 8;
+
+    static V load(const double* p) { return _mm512_loadu_pd(p); }
+    static void store(double* p, V v) { _mm512_storeu_pd(p, v); }
+    static V set1(double x) { return _mm512_set1_pd(x); }
+
+    static V add(V a, V b) { return _mm512_add_pd(a, b); }
+    static V sub(V a, V b) { return _mm512_sub_pd(a, b); }
+    static V mul(V a, V b) { return _mm512_mul_pd(a, b); }
+    static V div(V a, V b) { return _mm512_div_pd(a, b); }
+    static V fma(V a, V b, V c) { return _mm512_fmadd_pd(a, b, c); }
+    static V sqrt(V a) { return _mm512_sqrt_pd(a); }
+    static V min(V a, V b) { return _mm512_min_pd(a, b); }
+    static V max(V a, V b) { return _mm512_max_pd(a, b); }
+    static V abs(V a) { return _mm512_abs_pd(a); }
+    static V round(V a) { return _mm512_roundscale_pd(a, _MM_FROUND_TO_NEAREST_INT | _MM_FROUND_NO_EXC); }
+
+    static M lt(V a, V b) { return _mm512_cmp_pd_mask(a, b, _CMP_LT_OQ); }
+    static M le(V a, V b) { return _mm512_cmp_pd_mask(a, b, _CMP_LE_OQ); }
+    static M gt(V a, V b) { return _mm512_cmp_pd_mask(a, b, _CMP_GT_OQ); }
+    static M mask_and(M a, M b) { return static_cast<M>(a & b); }
+    static M mask_or(M a, M b) { return static_cast<M>(a | b); }
+    static M mask_andnot(M a, M b) { return static_cast<M>(a & ~b); }
+    static V select(M m, V a, V b) { return _mm512_mask_blend_pd(m, b, a); }
+    static bool any(M m) { return m != 0; }
+    static bool all(M m) { return m == 0xFF; }
+
+    static V pow2(V n) { return _mm512_scalef_pd(_mm512_set1_pd(1.0), n); }
+
+    static void split(V x, V& m, V& e) {
+        m = _mm512_getmant_pd(x, _MM_MANT_NORM_1_2, _MM_MANT_SIGN_zero);
+        e = _mm512_getexp_pd(x);
+    }
+};
+
+}  // namespace
+
+const KernelTable& avx512_kernels() noexcept {
+    static const KernelTable table = make_table<Avx512>("avx512");
+    return table;
+}
+
+}  // namespace lx::trading::math::simd
@@ -0,0 +1,65 @@
+// LX Trading SDK - NEON Math Kernels
+// NEON (Advanced SIMD) is part of the AArch64 baseline, so this file needs
+// no extra flags and math.cpp selects it unconditionally on ARM64
+
+#include "math_simd.hpp"
+#include <arm_neon.h>
+
+namespace lx::trading::math::simd {
+
+namespace {
+
+struct Neon {
+    using V = float64x2_t;
+    using M = uint64x2_t;
+    static constexpr size_t W = 2;
+
+    static V load(const double* p) { return vld1q_f64(p); }
+    static void store(double* p, V v) { vst1q_f64(p, v); }
+    static V set1(double x) { return vdupq_n_f64(x); }
+
+    static V add(V a, V b) { return vaddq_f64(a, b); }
+    static V sub(V a, V b) { return vsubq_f64(a, b); }
+    static V mul(V a, V b) { return vmulq_f64(a, b); }
+    static V div(V a, V b) { return vdivq_f64(a, b); }
+    static V fma(V a, V b, V c) { return vfmaq_f64(c, a, b); }
+    static V sqrt(V a) { return vsqrtq_f64(a); }
+    static V min(V a, V b) { return vminq_f64(a, b); }
+    static V max(V a, V b) { return vmaxq_f64(a, b); }
+    static V abs(V a) { return vabsq_f64(a); }
+    static V round(V a) { return vrndnq_f64(a); }
+
+    static M lt(V a, V b) { return vcltq_f64(a, b); }
+    static M le(V a, V b) { return vcleq_f64(a, b); }
+    static M gt(V a, V b) { return vcgtq_f64(a, b); }
+    static M mask_and(M a, M b) { return vandq_u64(a, b); }
+    static M mask_or(M a, M b) { return vorrq_u64(a, b); }
+    static M mask_andnot(M a, M b) { return vbicq_u64(a, b); }
+    static V select(M m, V a, V b) { return vbslq_f64(m, a, b); }
+    static bool any(M m) { return (vgetq_lane_u64(m, 0) | vgetq_lane_u64(m, 1)) != 0; }
+    static bool all(M m) { return (vgetq_lane_u64(m, 0) & vgetq_lane_u64(m, 1)) != 0; }
+
+    // n + 1023 lands in the low mantissa bits after adding 2^52; shifting
+    // it into the exponent field gives 2^n
+    static V pow2(V n) {
+        const uint64x2_t bits = vreinterpretq_u64_f64(vaddq_f64(n, vdupq_n_f64(4503599627371519.0)));
+        return vreinterpretq_f64_u64(vshlq_n_u64(bits, 52));
+    }
+
+    static void split(V x, V& m, V& e) {
+        const uint64x2_t bits = vreinterpretq_u64_f64(x);
+        e = vsubq_f64(vcvtq_f64_u64(vshrq_n_u64(bits, 52)), vdupq_n_f64(1023.0));
+        m = vreinterpretq_f64_u64(vorrq_u64(
+            vandq_u64(bits, vdupq_n_u64(0x000FFFFFFFFFFFFFULL)),
+            vdupq_n_u64(0x3FF0000000000000ULL)));
+    }
+};
+
+}  // namespace
+
+const KernelTable& neon_kernels() noexcept {
+    static const KernelTable table = make_table<Neon>("neon");
+    return table;
+}
+
+}  // namespace lx::trading::math::simd
@@ -0,0 +1,351 @@
+// LX Trading SDK - SIMD Math Kernels (private)
+//
+// The batch math is written once against a small vector-ops interface and
+// instantiated per instruction set in its own translation unit
+// (math_avx2.cpp, math_avx512.cpp, math_neon.cpp), each compiled with the
+// flags for that ISA. math.cpp picks a kernel table at runtime from the
+// CPU's features, so one binary runs on any x86-64 or ARM host.
+//
+// An Ops type provides, for a vector V of W doubles and a lane mask M:
+//   load store set1 add sub mul div fma(a, b, c) = a * b + c
+//   sqrt min max abs round (to nearest)
+//   lt le gt mask_and mask_or mask_andnot(a, b) = a & ~b
+//   select(m, a, b) = m ? a : b   any all
+//   pow2(n)             2^n for integral n in [-1022, 1023]
+//   split(x, m, e)      x = m * 2^e with m in [1, 2), for normal x > 0
+//
+// Every Ops type is declared in an anonymous namespace, so nothing built
+// here with wide-ISA flags has external linkage and leaks into baseline
+// code. For the same reason kernels never call the inline scalar helpers
+// in math.hpp: each kernel processes whole vectors only and returns how
+// many elements it did, and math.cpp finishes the tail with scalar code.
+
+#pragma once
+
+#include <lx/trading/math.hpp>
+#include <cstddef>
+
+namespace lx::trading::math::simd {
+
+struct KernelTable {
+    const char* name;
+    size_t (*black_scholes)(const double* S, const double* K, const double* T,
+                            const double* r, const double* sigma,
+                            double* prices, size_t count, bool is_call);
+    size_t (*norm_cdf)(const double* x, double* result, size_t count);
+    size_t (*greeks)(const double* S, const double* K, const double* T,
+                     const double* r, const double* sigma,
+                     Greeks* out, size_t count, bool is_call);
+    size_t (*implied_volatility)(const double* price, const double* S, const double* K,
+                                 const double* T, const double* r, double* out,
+                                 size_t count, bool is_call, double tol, int max_iter);
+    size_t (*sum)(const double* data, size_t count, double& total);
+    size_t (*sum_sq_dev)(const double* data, size_t count, double mean, double& total);
+};
+
+// Defined only when the matching ISA file is built (see CMakeLists.txt)
+const KernelTable& avx2_kernels() noexcept;
+const KernelTable& avx512_kernels() noexcept;
+const KernelTable& neon_kernels() noexcept;
+
+// =============================================================================
+// Elementary functions
+// =============================================================================
+
+// e^x: x = n ln2 + r with |r| <= ln2 / 2, e^r by its degree-12 Taylor
+// polynomial (error below 2e-16), scaled by 2^n
+template <typename O>
+typename O::V exp(typename O::V x) {
+    using V = typename O::V;
+    x = O::min(O::max(x, O::set1(-708.0)), O::set1(708.0));
+
+    const V n = O::round(O::mul(x, O::set1(1.44269504088896340736)));
+    V r = O::fma(n, O::set1(-6.93147180369123816490e-01), x);
+    r = O::fma(n, O::set1(-1.90821492927058770002e-10), r);
+
+    V p = O::set1(1.0 / 479001600.0);
+    p = O::fma(p, r, O::set1(1.0 / 39916800.0));
+    p = O::fma(p, r, O::set1(1.0 / 3628800.0));
+    p = O::fma(p, r, O::set1(1.0 / 362880.0));
+    p = O::fma(p, r, O::set1(1.0 / 40320.0));
+    p = O::fma(p, r, O::set1(1.0 / 5040.0));
+    p = O::fma(p, r, O::set1(1.0 / 720.0));
+    p = O::fma(p, r, O::set1(1.0 / 120.0));
+    p = O::fma(p, r, O::set1(1.0 / 24.0));
+    p = O::fma(p, r, O::set1(1.0 / 6.0));
+    p = O::fma(p, r, O::set1(0.5));
+    p = O::fma(p, r, O::set1(1.0));
+    p = O::fma(p, r, O::set1(1.0));
+
+    return O::mul(p, O::pow2(n));
+}
+
+// ln(x) for normal x > 0: x = m 2^e with m in [sqrt(1/2), sqrt(2)), then
+// ln(m) = 2 atanh(s) with s = (m - 1) / (m + 1), |s| < 0.172, summed to s^21
+template <typename O>
+typename O::V log(typename O::V x) {
+    using V = typename O::V;
+    V m;
+    V e;
+    O::split(x, m, e);
+
+    const auto high = O::gt(m, O::set1(1.41421356237309504880));
+    m = O::select(high, O::mul(m, O::set1(0.5)), m);
+    e = O::select(high, O::add(e, O::set1(1.0)), e);
+
+    const V s = O::div(O::sub(m, O::set1(1.0)), O::add(m, O::set1(1.0)));
+    const V z = O::mul(s, s);
+
+    V p = O::set1(1.0 / 21.0);
+    p = O::fma(p, z, O::set1(1.0 / 19.0));
+    p = O::fma(p, z, O::set1(1.0 / 17.0));
+    p = O::fma(p, z, O::set1(1.0 / 15.0));
+    p = O::fma(p, z, O::set1(1.0 / 13.0));
+    p = O::fma(p, z, O::set1(1.0 / 11.0));
+    p = O::fma(p, z, O::set1(1.0 / 9.0));
+    p = O::fma(p, z, O::set1(1.0 / 7.0));
+    p = O::fma(p, z, O::set1(1.0 / 5.0));
+    p = O::fma(p, z, O::set1(1.0 / 3.0));
+    p = O::fma(p, z, O::set1(1.0));
+
+    const V ln_m = O::mul(O::add(s, s), p);
+    return O::fma(e, O::set1(0.69314718055994530942), ln_m);
+}
+
+// Same Abramowitz & Stegun approximation as the scalar norm_cdf
+template <typename O>
+typename O::V norm_cdf(typename O::V x) {
+    using V = typename O::V;
+    const V ax = O::mul(O::abs(x), O::set1(1.0 / SQRT_2));
+    const V t = O::div(O::set1(1.0), O::fma(O::set1(0.3275911), ax, O::set1(1.0)));
+
+    V p = O::set1(1.061405429);
+    p = O::fma(p, t, O::set1(-1.453152027));
+    p = O::fma(p, t, O::set1(1.421413741));
+    p = O::fma(p, t, O::set1(-0.284496736));
+    p = O::fma(p, t, O::set1(0.254829592));
+    p = O::mul(p, t);
+
+    const V e = exp<O>(O::sub(O::set1(0.0), O::mul(ax, ax)));
+    const V y = O::sub(O::set1(1.0), O::mul(p, e));
+    const V signed_y = O::select(O::lt(x, O::set1(0.0)), O::sub(O::set1(0.0), y), y);
+    return O::mul(O::set1(0.5), O::add(O::set1(1.0), signed_y));
+}
+
+template <typename O>
+typename O::V norm_pdf(typename O::V x) {
+    return O::mul(exp<O>(O::mul(O::set1(-0.5), O::mul(x, x))), O::set1(1.0 / SQRT_2PI));
+}
+
+// =============================================================================
+// Black-Scholes
+// =============================================================================
+
+// d1, d2 and the discount factor for one vector of options. Lanes with
+// T <= 0 are computed with T = 1 to stay finite; callers mask them out.
+template <typename O>
+struct Terms {
+    using V = typename O::V;
+    typename O::M live;     // T > 0
+    V T;
+    V sqrt_T;
+    V d1;
+    V d2;
+    V discount;             // e^(-rT)
+
+    Terms(V S, V K, V T_in, V r, V sigma) {
+        live = O::gt(T_in, O::set1(0.0));
+        T = O::select(live, T_in, O::set1(1.0));
+        sqrt_T = O::sqrt(T);
+        const V sig_sqrt_T = O::mul(sigma, sqrt_T);
+        const V drift = O::fma(O::mul(O::set1(0.5), sigma), sigma, r);
+        d1 = O::div(O::fma(drift, T, log<O>(O::div(S, K))), sig_sqrt_T);
+        d2 = O::sub(d1, sig_sqrt_T);
+        discount = exp<O>(O::sub(O::set1(0.0), O::mul(r, T)));
+    }
+};
+
+template <typename O>
+typename O::V price(typename O::V S, typename O::V K, const Terms<O>& t, bool is_call) {
+    using V = typename O::V;
+    const V zero = O::set1(0.0);
+    const V K_disc = O::mul(K, t.discount);
+    if (is_call) {
+        const V value = O::sub(O::mul(S, norm_cdf<O>(t.d1)), O::mul(K_disc, norm_cdf<O>(t.d2)));
+        return O::select(t.live, value, O::max(O::sub(S, K), zero));
+    }
+    const V value = O::sub(O::mul(K_disc, norm_cdf<O>(O::sub(zero, t.d2))),
+                           O::mul(S, norm_cdf<O>(O::sub(zero, t.d1))));
+    return O::select(t.live, value, O::max(O::sub(K, S), zero));
+}
+
+template <typename O>
+size_t black_scholes(const double* S, const double* K, const double* T,
+                     const double* r, const double* sigma,
+                     double* prices, size_t count, bool is_call) {
+    size_t i = 0;
+    for (; i + O::W <= count; i += O::W) {
+        const auto vS = O::load(S + i);
+        const auto vK = O::load(K + i);
+        const Terms<O> t(vS, vK, O::load(T + i), O::load(r + i), O::load(sigma + i));
+        O::store(prices + i, price<O>(vS, vK, t, is_call));
+    }
+    return i;
+}
+
+template <typename O>
+size_t norm_cdf_batch(const double* x, double* result, size_t count) {
+    size_t i = 0;
+    for (; i + O::W <= count; i += O::W) {
+        O::store(result + i, norm_cdf<O>(O::load(x + i)));
+    }
+    return i;
+}
+
+// Mirrors the scalar greeks(): theta per day, vega per 1% vol, all zero
+// at or past expiry
+template <typename O>
+size_t greeks(const double* S, const double* K, const double* T,
+              const double* r, const double* sigma,
+              Greeks* out, size_t count, bool is_call) {
+    using V = typename O::V;
+    const V zero = O::set1(0.0);
+    double delta[O::W], gamma[O::W], theta[O::W], vega[O::W], rho[O::W];
+
+    size_t i = 0;
+    for (; i + O::W <= count; i += O::W) {
+        const V vS = O::load(S + i);
+        const V vK = O::load(K + i);
+        const V vr = O::load(r + i);
+        const V vsigma = O::load(sigma + i);
+        const Terms<O> t(vS, vK, O::load(T + i), vr, vsigma);
+
+        const V pdf_d1 = norm_pdf<O>(t.d1);
+        const V K_disc = O::mul(vK, t.discount);
+        // -S pdf(d1) sigma / (2 sqrt(T))
+        const V decay = O::div(O::mul(O::mul(O::sub(zero, vS), pdf_d1), vsigma),
+                               O::add(t.sqrt_T, t.sqrt_T));
+
+        V vdelta;
+        V vtheta;
+        V vrho;
+        if (is_call) {
+            const V cdf_d2 = norm_cdf<O>(t.d2);
+            vdelta = norm_cdf<O>(t.d1);
+            vtheta = O::sub(decay, O::mul(O::mul(vr, K_disc), cdf_d2));
+            vrho = O::mul(O::mul(K_disc, t.T), cdf_d2);
+        } else {
+            const V cdf_neg_d2 = norm_cdf<O>(O::sub(zero, t.d2));
+            vdelta = O::sub(norm_cdf<O>(t.d1), O::set1(1.0));
+            vtheta = O::fma(O::mul(vr, K_disc), cdf_neg_d2, decay);
+            vrho = O::sub(zero, O::mul(O::mul(K_disc, t.T), cdf_neg_d2));
+        }
+        const V vgamma = O::div(pdf_d1, O::mul(O::mul(vS, vsigma), t.sqrt_T));
+        const V vvega = O::mul(O::mul(O::mul(vS, pdf_d1), t.sqrt_T), O::set1(0.01));
+        vtheta = O::div(vtheta, O::set1(365.0));
+
+        O::store(delta, O::select(t.live, vdelta, zero));
+        O::store(gamma, O::select(t.live, vgamma, zero));
+        O::store(theta, O::select(t.live, vtheta, zero));
+        O::store(vega, O::select(t.live, vvega, zero));
+        O::store(rho, O::select(t.live, vrho, zero));
+        for (size_t j = 0; j < O::W; ++j) {
+            out[i + j] = Greeks{delta[j], gamma[j], theta[j], vega[j], rho[j]};
+        }
+    }
+    return i;
+}
+
+// Newton-Raphson across lanes with the scalar implied_volatility's start
+// (0.2), stopping rules and clamp. A lane stops when its price is within
+// tol or its vega vanishes; the vector stops when no lane is left or after
+// max_iter steps. Lanes at or past expiry keep the starting guess.
+template <typename O>
+size_t implied_volatility(const double* price_in, const double* S, const double* K,
+                          const double* T, const double* r, double* out,
+                          size_t count, bool is_call, double tol, int max_iter) {
+    using V = typename O::V;
+    const V tol_v = O::set1(tol);
+    const V min_vega = O::set1(1e-10);
+    const V lo = O::set1(0.001);
+    const V hi = O::set1(5.0);
+
+    size_t i = 0;
+    for (; i + O::W <= count; i += O::W) {
+        const V target = O::load(price_in + i);
+        const V vS = O::load(S + i);
+        const V vK = O::load(K + i);
+        const V vT = O::load(T + i);
+        const V vr = O::load(r + i);
+
+        V sigma = O::set1(0.2);
+        auto active = O::gt(vT, O::set1(0.0));
+        for (int iter = 0; iter < max_iter && O::any(active); ++iter) {
+            const Terms<O> t(vS, vK, vT, vr, sigma);
+            const V vega = O::mul(O::mul(vS, norm_pdf<O>(t.d1)), t.sqrt_T);
+            active = O::mask_andnot(active, O::lt(O::abs(vega), min_vega));
+
+            const V diff = O::sub(price<O>(vS, vK, t, is_call), target);
+            active = O::mask_andnot(active, O::lt(O::abs(diff), tol_v));
+
+            const V next = O::min(O::max(O::sub(sigma, O::div(diff, vega)), lo), hi);
+            sigma = O::select(active, next, sigma);
+        }
+        O::store(out + i, sigma);
+    }
+    return i;
+}
+
+// =============================================================================
+// Reductions
+// =============================================================================
+
+template <typename O>
+double horizontal_sum(typename O::V v) {
+    double lanes[O::W];
+    O::store(lanes, v);
+    double total = 0.0;
+    for (size_t j = 0; j < O::W; ++j) {
+        total += lanes[j];
+    }
+    return total;
+}
+
+template <typename O>
+size_t sum(const double* data, size_t count, double& total) {
+    auto acc = O::set1(0.0);
+    size_t i = 0;
+    for (; i + O::W <= count; i += O::W) {
+        acc = O::add(acc, O::load(data + i));
+    }
+    total = horizontal_sum<O>(acc);
+    return i;
+}
+
+template <typename O>
+size_t sum_sq_dev(const double* data, size_t count, double mean, double& total) {
+    const auto vmean = O::set1(mean);
+    auto acc = O::set1(0.0);
+    size_t i = 0;
+    for (; i + O::W <= count; i += O::W) {
+        const auto diff = O::sub(O::load(data + i), vmean);
+        acc = O::fma(diff, diff, acc);
+    }
+    total = horizontal_sum<O>(acc);
+    return i;
+}
+
+template <typename O>
+KernelTable make_table(const char* name) {
+    return KernelTable{
+        name,
+        &black_scholes<O>,
+        &norm_cdf_batch<O>,
+        &greeks<O>,
+        &implied_volatility<O>,
+        &sum<O>,
+        &sum_sq_dev<O>,
+    };
+}
+
+}  // namespace lx::trading::math::simd
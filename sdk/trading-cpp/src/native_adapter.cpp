@@ -2,85 +2,83 @@
 
 #include <lx/trading/adapters/native.hpp>
 #include <lx/trading/orderbook.hpp>
-#include <cpr/cpr.h>
+#include "http_client.hpp"
+#include "native_stream.hpp"
 #include <nlohmann/json.hpp>
+#include <algorithm>
 
 namespace lx::trading {
 
 using json = nlohmann::json;
 
-// HTTP client wrapper
-class HttpClient {
-public:
-    explicit HttpClient(const std::string& base_url) : base_url_(base_url) {}
-
-    json get(const std::string& path,
-             const std::optional<std::string>& api_key = std::nullopt) {
-        cpr::Header headers;
-        if (api_key) {
-            headers["X-API-KEY"] = *api_key;
-            headers["X-TIMESTAMP"] = std::to_string(now_ms());
+namespace {
+
+HttpClientOptions http_options(const NativeVenueConfig& config) {
+    HttpClientOptions options;
+    options.max_connections = static_cast<size_t>(std::max(config.max_connections, 1));
+    options.http2 = config.http2;
+    return options;
+}
+
+template <typename T>
+std::future<T> ready(T value) {
+    std::promise<T> promise;
+    promise.set_value(std::move(value));
+    return promise.get_future();
+}
+
+// REST sends decimals as strings; the node's stream may send numbers
+Decimal decimal_of(const json& v) {
+    return v.is_string() ? Decimal::from_string(v.get<std::string>())
+                         : Decimal::from_double(v.get<double>());
+}
+
+std::optional<Decimal> optional_decimal(const json& data, const char* key) {
+    if (data.contains(key) && !data[key].is_null()) return decimal_of(data[key]);
+    return std::nullopt;
+}
+
+Ticker parse_ticker(const json& data, const std::string& symbol, const std::string& venue) {
+    Ticker ticker;
+    ticker.symbol = data.value("symbol", symbol);
+    ticker.venue = venue;
+    ticker.bid = optional_decimal(data, "bid");
+    ticker.ask = optional_decimal(data, "ask");
+    ticker.last = optional_decimal(data, "last");
+    ticker.volume_24h = optional_decimal(data, "volume24h");
+    ticker.timestamp = data.value("timestamp", now_ms());
+    return ticker;
+}
+
+Trade parse_trade(const json& t, const std::string& symbol, const std::string& venue) {
+    Trade trade;
+    trade.trade_id = t["id"];
+    trade.order_id = t.value("orderId", "");
+    trade.symbol = symbol;
+    trade.venue = venue;
+    trade.side = (t["side"] == "buy") ? Side::Buy : Side::Sell;
+    trade.price = Decimal::from_string(t["price"].get<std::string>());
+    trade.quantity = Decimal::from_string(t["quantity"].get<std::string>());
+    trade.fee.asset = t.value("feeAsset", "");
+    trade.fee.amount = Decimal::from_string(t.value("feeAmount", "0"));
+    trade.timestamp = t["timestamp"];
+    trade.is_maker = t.value("isMaker", false);
+    return trade;
+}
+
+// [price, quantity] pairs or {"price", "size"} objects
+void append_levels(const json& levels, Side side, std::vector<BookDelta>& out) {
+    for (const auto& level : levels) {
+        if (level.is_array()) {
+            out.push_back({side, decimal_of(level[0]), decimal_of(level[1])});
+        } else {
+            out.push_back({side, decimal_of(level["price"]),
+                           decimal_of(level.contains("size") ? level["size"] : level["quantity"])});
         }
-
-        auto response = cpr::Get(
-            cpr::Url{base_url_ + path},
-            headers);
-
-        if (response.status_code != 200) {
-            throw AdapterError("HTTP " + std::to_string(response.status_code) +
-                              ": " + response.text);
-        }
-
-        return json::parse(response.text);
-    }
-
-    json post(const std::string& path,
-              const json& body,
-              const std::optional<std::string>& api_key = std::nullopt) {
-        cpr::Header headers{{"Content-Type", "application/json"}};
-        if (api_key) {
-            headers["X-API-KEY"] = *api_key;
-            headers["X-TIMESTAMP"] = std::to_string(now_ms());
-        }
-
-        auto response = cpr::Post(
-            cpr::Url{base_url_ + path},
-            headers,
-            cpr::Body{body.dump()});
-
-        if (response.status_code != 200 && response.status_code != 201) {
-            throw AdapterError("HTTP " + std::to_string(response.status_code) +
-                              ": " + response.text);
-        }
-
-        return json::parse(response.text);
-    }
-
-    json del(const std::string& path,
-             const json& body = {},
-             const std::optional<std::string>& api_key = std::nullopt) {
-        cpr::Header headers{{"Content-Type", "application/json"}};
-        if (api_key) {
-            headers["X-API-KEY"] = *api_key;
-            headers["X-TIMESTAMP"] = std::to_string(now_ms());
-        }
-
-        auto response = cpr::Delete(
-            cpr::Url{base_url_ + path},
-            headers,
-            cpr::Body{body.dump()});
-
-        if (response.status_code != 200) {
-            throw AdapterError("HTTP " + std::to_string(response.status_code) +
-                              ": " + response.text);
-        }
-
-        return json::parse(response.text);
     }
+}
 
-private:
-    std::string base_url_;
-};
+}  // namespace
 
 // =============================================================================
 // LxDexAdapter Implementation
@@ -88,10 +86,17 @@ private:
 
 LxDexAdapter::LxDexAdapter(std::string_view name, const NativeVenueConfig& config)
     : name_(name), config_(config), capabilities_(VenueCapabilities::clob()) {
-    http_ = std::make_unique<HttpClient>(config.api_url);
+    http_ = std::make_unique<HttpClient>(config.api_url, http_options(config));
 }
 
-LxDexAdapter::~LxDexAdapter() = default;
+LxDexAdapter::~LxDexAdapter() {
+    std::unique_ptr<MarketStream> stream;
+    {
+        std::lock_guard lock(stream_mutex_);
+        stream = std::move(stream_);
+    }
+    // Stopped outside the lock: stream handlers take it
+}
 
 void LxDexAdapter::update_latency(int64_t start_ns) {
     int64_t elapsed = now_ns() - start_ns;
@@ -109,6 +114,14 @@ std::future<void> LxDexAdapter::connect() {
 
 std::future<void> LxDexAdapter::disconnect() {
     return std::async(std::launch::async, [this]() {
+        std::unique_ptr<MarketStream> stream;
+        {
+            std::lock_guard lock(stream_mutex_);
+            stream = std::move(stream_);
+            streamed_tickers_.clear();
+            streamed_books_.clear();
+        }
+        stream.reset();
         connected_.store(false, std::memory_order_release);
     });
 }
@@ -143,54 +156,66 @@ std::future<std::vector<MarketInfo>> LxDexAdapter::get_markets() {
 }
 
 std::future<Ticker> LxDexAdapter::get_ticker(const std::string& symbol) {
-    return std::async(std::launch::async, [this, symbol]() {
-        auto start = now_ns();
-        auto data = http_->get("/api/v1/ticker/" + symbol, config_.api_key);
-        update_latency(start);
+    {
+        std::lock_guard lock(stream_mutex_);
+        auto it = streamed_tickers_.find(symbol);
+        if (it != streamed_tickers_.end() && stream_ && stream_->is_connected()) {
+            return ready(it->second);
+        }
+    }
 
-        Ticker ticker;
-        ticker.symbol = data.value("symbol", symbol);
-        ticker.venue = name_;
-        if (data.contains("bid") && !data["bid"].is_null())
-            ticker.bid = Decimal::from_string(data["bid"].get<std::string>());
-        if (data.contains("ask") && !data["ask"].is_null())
-            ticker.ask = Decimal::from_string(data["ask"].get<std::string>());
-        if (data.contains("last") && !data["last"].is_null())
-            ticker.last = Decimal::from_string(data["last"].get<std::string>());
-        if (data.contains("volume24h") && !data["volume24h"].is_null())
-            ticker.volume_24h = Decimal::from_string(data["volume24h"].get<std::string>());
-        ticker.timestamp = data.value("timestamp", now_ms());
-        return ticker;
-    });
+    auto start = now_ns();
+    return http_->request(HttpClient::Method::Get, "/api/v1/ticker/" + symbol, json(), config_.api_key,
+        [this, symbol, start](const json& data) {
+            update_latency(start);
+            return parse_ticker(data, symbol, name_);
+        });
 }
 
 std::future<std::unique_ptr<Orderbook>> LxDexAdapter::get_orderbook(
     const std::string& symbol, std::optional<int> depth) {
-    return std::async(std::launch::async, [this, symbol, depth]() {
-        auto start = now_ns();
-        std::string path = "/api/v1/orderbook/" + symbol;
-        if (depth) path += "?depth=" + std::to_string(*depth);
+    std::shared_ptr<Orderbook> streamed;
+    {
+        std::lock_guard lock(stream_mutex_);
+        auto it = streamed_books_.find(symbol);
+        if (it != streamed_books_.end() && stream_ && stream_->is_connected()) {
+            streamed = it->second;
+        }
+    }
+    if (streamed) {
+        auto bids = streamed->bids();
+        auto asks = streamed->asks();
+        if (depth) {
+            bids.resize(std::min(bids.size(), static_cast<size_t>(*depth)));
+            asks.resize(std::min(asks.size(), static_cast<size_t>(*depth)));
+        }
 
-        auto data = http_->get(path, config_.api_key);
-        update_latency(start);
+        std::vector<BookDelta> levels;
+        levels.reserve(bids.size() + asks.size());
+        for (const auto& level : bids) levels.push_back({Side::Buy, level.price, level.quantity});
+        for (const auto& level : asks) levels.push_back({Side::Sell, level.price, level.quantity});
 
         auto book = std::make_unique<Orderbook>(symbol, name_);
+        book->apply_deltas(levels, streamed->sequence(), streamed->timestamp());
+        return ready(std::move(book));
+    }
 
-        for (const auto& bid : data["bids"]) {
-            book->add_bid(
-                Decimal::from_string(bid[0].get<std::string>()),
-                Decimal::from_string(bid[1].get<std::string>()));
-        }
+    auto start = now_ns();
+    std::string path = "/api/v1/orderbook/" + symbol;
+    if (depth) path += "?depth=" + std::to_string(*depth);
 
-        for (const auto& ask : data["asks"]) {
-            book->add_ask(
-                Decimal::from_string(ask[0].get<std::string>()),
-                Decimal::from_string(ask[1].get<std::string>()));
-        }
+    return http_->request(HttpClient::Method::Get, std::move(path), json(), config_.api_key,
+        [this, symbol, start](const json& data) {
+            update_latency(start);
 
-        book->sort();
-        return book;
-    });
+            std::vector<BookDelta> levels;
+            append_levels(data["bids"], Side::Buy, levels);
+            append_levels(data["asks"], Side::Sell, levels);
+
+            auto book = std::make_unique<Orderbook>(symbol, name_);
+            book->apply_deltas(levels);
+            return book;
+        });
 }
 
 std::future<std::vector<Trade>> LxDexAdapter::get_trades(
@@ -205,19 +230,7 @@ std::future<std::vector<Trade>> LxDexAdapter::get_trades(
 
         std::vector<Trade> trades;
         for (const auto& t : data) {
-            Trade trade;
-            trade.trade_id = t["id"];
-            trade.order_id = t.value("orderId", "");
-            trade.symbol = symbol;
-            trade.venue = name_;
-            trade.side = (t["side"] == "buy") ? Side::Buy : Side::Sell;
-            trade.price = Decimal::from_string(t["price"].get<std::string>());
-            trade.quantity = Decimal::from_string(t["quantity"].get<std::string>());
-            trade.fee.asset = t.value("feeAsset", "");
-            trade.fee.amount = Decimal::from_string(t.value("feeAmount", "0"));
-            trade.timestamp = t["timestamp"];
-            trade.is_maker = t.value("isMaker", false);
-            trades.push_back(std::move(trade));
+            trades.push_back(parse_trade(t, symbol, name_));
         }
         return trades;
     });
@@ -314,65 +327,165 @@ Order LxDexAdapter::convert_order(const json& o) {
 }
 
 std::future<Order> LxDexAdapter::place_order(const OrderRequest& request) {
-    return std::async(std::launch::async, [this, request]() -> Order {
-        auto start = now_ns();
+    auto start = now_ns();
+
+    json body = {
+        {"clientOrderId", request.client_order_id},
+        {"symbol", request.symbol},
+        {"side", to_string(request.side)},
+        {"type", to_string(request.order_type)},
+        {"quantity", request.quantity.to_string()},
+        {"timeInForce", to_string(request.time_in_force)}
+    };
+
+    if (request.price) {
+        body["price"] = request.price->to_string();
+    }
+    return http_->request(HttpClient::Method::Post, "/api/v1/orders", std::move(body), config_.api_key,
+        [this, start](const json& data) {
+            update_latency(start);
+            return convert_order(data);
+        });
+}
 
-        json body = {
-            {"clientOrderId", request.client_order_id},
-            {"symbol", request.symbol},
-            {"side", to_string(request.side)},
-            {"type", to_string(request.order_type)},
-            {"quantity", request.quantity.to_string()},
-            {"timeInForce", to_string(request.time_in_force)}
-        };
+std::future<Order> LxDexAdapter::cancel_order(
+    const std::string& order_id, const std::string& symbol) {
+    auto start = now_ns();
+    json body = {{"symbol", symbol}};
+    return http_->request(HttpClient::Method::Delete, "/api/v1/orders/" + order_id, std::move(body),
+        config_.api_key, [this, start](const json& data) {
+            update_latency(start);
+            return convert_order(data);
+        });
+}
 
-        if (request.price) {
-            body["price"] = request.price->to_string();
-        }
+std::future<std::vector<Order>> LxDexAdapter::cancel_all_orders(
+    const std::optional<std::string>& symbol) {
+    auto start = now_ns();
+    json body = {};
+    if (symbol) body["symbol"] = *symbol;
 
-        auto data = http_->post("/api/v1/orders", body, config_.api_key);
-        update_latency(start);
+    return http_->request(HttpClient::Method::Delete, "/api/v1/orders/all", std::move(body),
+        config_.api_key, [this, start](const json& data) {
+            update_latency(start);
 
-        return convert_order(data);
+            std::vector<Order> orders;
+            for (const auto& o : data) {
+                orders.push_back(convert_order(o));
+            }
+            return orders;
+        });
+}
+
+// =============================================================================
+// LxDexAdapter Streaming
+// =============================================================================
+
+MarketStream* LxDexAdapter::stream() {
+    std::lock_guard lock(stream_mutex_);
+    if (!stream_ && config_.streaming && config_.ws_url && MarketStream::supported()) {
+        stream_ = std::make_unique<MarketStream>(*config_.ws_url);
+        stream_->start();
+    }
+    return stream_.get();
+}
+
+void LxDexAdapter::subscribe_ticker(const std::string& symbol, TickerCallback cb) {
+    MarketStream* s = stream();
+    if (!s) return;
+
+    s->subscribe("ticker:" + symbol, [this, symbol, cb = std::move(cb)](const json& data) {
+        Ticker ticker = parse_ticker(data, symbol, name_);
+        {
+            std::lock_guard lock(stream_mutex_);
+            streamed_tickers_[symbol] = ticker;
+        }
+        if (cb) cb(ticker);
     });
 }
 
-std::future<Order> LxDexAdapter::cancel_order(
-    const std::string& order_id, const std::string& symbol) {
-    return std::async(std::launch::async, [this, order_id, symbol]() -> Order {
-        auto start = now_ns();
-        json body = {{"symbol", symbol}};
-        auto data = http_->del("/api/v1/orders/" + order_id, body, config_.api_key);
-        update_latency(start);
-        return convert_order(data);
+void LxDexAdapter::subscribe_trades(const std::string& symbol, TradeCallback cb) {
+    MarketStream* s = stream();
+    if (!s || !cb) return;
+
+    s->subscribe("trades:" + symbol, [this, symbol, cb = std::move(cb)](const json& data) {
+        if (data.is_array()) {
+            for (const auto& t : data) cb(parse_trade(t, symbol, name_));
+        } else {
+            cb(parse_trade(data, symbol, name_));
+        }
     });
 }
 
-std::future<std::vector<Order>> LxDexAdapter::cancel_all_orders(
-    const std::optional<std::string>& symbol) {
-    return std::async(std::launch::async, [this, symbol]() {
-        auto start = now_ns();
-        json body = {};
-        if (symbol) body["symbol"] = *symbol;
+void LxDexAdapter::subscribe_orderbook(const std::string& symbol, OrderbookCallback cb) {
+    MarketStream* s = stream();
+    if (!s) return;
 
-        auto data = http_->del("/api/v1/orders/all", body, config_.api_key);
-        update_latency(start);
+    s->subscribe("orderbook:" + symbol, [this, symbol, cb = std::move(cb)](const json& data) {
+        apply_book_update(symbol, data, cb);
+    });
+}
 
-        std::vector<Order> orders;
-        for (const auto& o : data) {
-            orders.push_back(convert_order(o));
+void LxDexAdapter::apply_book_update(const std::string& symbol, const json& data,
+                                     const OrderbookCallback& cb) {
+    // A snapshot replaces the book; otherwise levels are deltas and a
+    // zero quantity removes the level
+    const bool snapshot = data.contains("snapshot");
+    const json& levels = snapshot ? data["snapshot"] : data;
+
+    std::vector<BookDelta> deltas;
+    if (levels.contains("bids")) append_levels(levels["bids"], Side::Buy, deltas);
+    if (levels.contains("asks")) append_levels(levels["asks"], Side::Sell, deltas);
+
+    std::optional<uint64_t> sequence;
+    if (data.contains("sequence")) sequence = data["sequence"].get<uint64_t>();
+    const int64_t timestamp = data.value("timestamp", now_ms());
+
+    std::shared_ptr<Orderbook> book;
+    if (snapshot) {
+        // Built aside and swapped in, so readers never see it half filled
+        book = std::make_shared<Orderbook>(symbol, name_);
+        book->apply_deltas(deltas, sequence, timestamp);
+        std::lock_guard lock(stream_mutex_);
+        streamed_books_[symbol] = book;
+    } else {
+        {
+            std::lock_guard lock(stream_mutex_);
+            auto& slot = streamed_books_[symbol];
+            if (!slot) slot = std::make_shared<Orderbook>(symbol, name_);
+            book = slot;
         }
-        return orders;
+        book->apply_deltas(deltas, sequence, timestamp);
+    }
+
+    if (cb) cb(*book);
+}
+
+void LxDexAdapter::subscribe_orders(OrderCallback cb) {
+    MarketStream* s = stream();
+    if (!s || !cb) return;
+
+    s->subscribe("orders", [this, cb = std::move(cb)](const json& data) {
+        cb(convert_order(data.contains("order") ? data["order"] : data));
     });
 }
 
+void LxDexAdapter::unsubscribe_all() {
+    std::lock_guard lock(stream_mutex_);
+    if (stream_) {
+        stream_->unsubscribe_all();
+    }
+    streamed_tickers_.clear();
+    streamed_books_.clear();
+}
+
 // =============================================================================
 // LxAmmAdapter Implementation
 // =============================================================================
 
 LxAmmAdapter::LxAmmAdapter(std::string_view name, const NativeVenueConfig& config)
     : name_(name), config_(config), capabilities_(VenueCapabilities::amm()) {
-    http_ = std::make_unique<HttpClient>(config.api_url);
+    http_ = std::make_unique<HttpClient>(config.api_url, http_options(config));
 }
 
 LxAmmAdapter::~LxAmmAdapter() = default;
@@ -0,0 +1,209 @@
+// LX Trading SDK - Native Market Data Stream Implementation
+
+#include "native_stream.hpp"
+#include <nlohmann/json.hpp>
+
+#ifdef LX_TRADING_HAVE_WEBSOCKET
+#include <websocketpp/config/asio_no_tls_client.hpp>
+#include <websocketpp/client.hpp>
+#include <atomic>
+#include <mutex>
+#include <thread>
+#include <unordered_map>
+#endif
+
+namespace lx::trading {
+
+#ifdef LX_TRADING_HAVE_WEBSOCKET
+
+using json = nlohmann::json;
+using WsClient = websocketpp::client<websocketpp::config::asio_client>;
+using MessagePtr = websocketpp::config::asio_client::message_type::ptr;
+
+namespace {
+
+constexpr long RECONNECT_DELAY_MS = 1000;
+
+json channel_message(const char* type, const std::string& channel) {
+    return json{{"type", type}, {"channel", channel}};
+}
+
+// Channel of an incoming update: explicit, or derived from its type
+std::string channel_of(const json& msg) {
+    if (msg.contains("channel") && msg["channel"].is_string()) {
+        return msg["channel"].get<std::string>();
+    }
+
+    const std::string type = msg.value("type", "");
+    const json& data = msg.contains("data") ? msg["data"] : msg;
+    const std::string symbol = data.is_object() ? data.value("symbol", "") : "";
+
+    if (type == "ticker_update") return "ticker:" + symbol;
+    if (type == "orderbook_update") return "orderbook:" + symbol;
+    if (type == "trade_update") return "trades:" + symbol;
+    if (type == "order_update") return "orders";
+    return {};
+}
+
+}  // namespace
+
+struct MarketStream::Impl {
+    std::string url;
+    WsClient client;
+    std::thread io_thread;
+    std::atomic<bool> running{false};
+    std::atomic<bool> connected{false};
+
+    mutable std::mutex mutex;                   // Guards handlers and hdl
+    std::unordered_map<std::string, Handler> handlers;
+    websocketpp::connection_hdl hdl;
+
+    explicit Impl(std::string u) : url(std::move(u)) {
+        client.clear_access_channels(websocketpp::log::alevel::all);
+        client.clear_error_channels(websocketpp::log::elevel::all);
+        client.init_asio();
+
+        client.set_open_handler([this](websocketpp::connection_hdl h) { on_open(h); });
+        client.set_close_handler([this](websocketpp::connection_hdl) { on_drop(); });
+        client.set_fail_handler([this](websocketpp::connection_hdl) { on_drop(); });
+        client.set_message_handler([this](websocketpp::connection_hdl, MessagePtr msg) {
+            on_message(msg->get_payload());
+        });
+    }
+
+    void connect() {
+        websocketpp::lib::error_code ec;
+        auto con = client.get_connection(url, ec);
+        if (ec) {
+            retry();
+            return;
+        }
+        {
+            std::lock_guard lock(mutex);
+            hdl = con->get_handle();
+        }
+        client.connect(con);
+    }
+
+    void retry() {
+        if (!running.load(std::memory_order_acquire)) return;
+        client.set_timer(RECONNECT_DELAY_MS, [this](const websocketpp::lib::error_code&) {
+            if (running.load(std::memory_order_acquire)) connect();
+        });
+    }
+
+    void send(const json& msg) {
+        websocketpp::lib::error_code ec;
+        client.send(hdl, msg.dump(), websocketpp::frame::opcode::text, ec);
+    }
+
+    void on_open(websocketpp::connection_hdl h) {
+        std::lock_guard lock(mutex);
+        hdl = h;
+        connected.store(true, std::memory_order_release);
+        for (const auto& [channel, handler] : handlers) {
+            send(channel_message("subscribe", channel));
+        }
+    }
+
+    void on_drop() {
+        connected.store(false, std::memory_order_release);
+        retry();
+    }
+
+    void on_message(const std::string& payload) {
+        json msg = json::parse(payload, nullptr, false);
+        if (msg.is_discarded() || !msg.is_object()) return;
+
+        Handler handler;
+        {
+            std::lock_guard lock(mutex);
+            auto it = handlers.find(channel_of(msg));
+            if (it == handlers.end()) return;
+            handler = it->second;
+        }
+        try {
+            handler(msg.contains("data") ? msg["data"] : msg);
+        } catch (const std::exception&) {
+            // A malformed update must not take down the IO thread
+        }
+    }
+};
+
+MarketStream::MarketStream(std::string url) : impl_(std::make_unique<Impl>(std::move(url))) {}
+
+MarketStream::~MarketStream() {
+    stop();
+}
+
+void MarketStream::start() {
+    if (impl_->running.exchange(true)) return;
+    impl_->client.start_perpetual();
+    impl_->connect();
+    impl_->io_thread = std::thread([this]() { impl_->client.run(); });
+}
+
+void MarketStream::stop() {
+    if (!impl_->running.exchange(false)) return;
+
+    impl_->client.stop_perpetual();
+    if (impl_->connected.exchange(false)) {
+        std::lock_guard lock(impl_->mutex);
+        websocketpp::lib::error_code ec;
+        impl_->client.close(impl_->hdl, websocketpp::close::status::normal, "", ec);
+    }
+    if (impl_->io_thread.joinable()) {
+        impl_->io_thread.join();
+    }
+    impl_->client.reset();      // Ready for another start()
+}
+
+void MarketStream::subscribe(const std::string& channel, Handler handler) {
+    std::lock_guard lock(impl_->mutex);
+    impl_->handlers[channel] = std::move(handler);
+    if (impl_->connected.load(std::memory_order_acquire)) {
+        impl_->send(channel_message("subscribe", channel));
+    }
+}
+
+void MarketStream::unsubscribe_all() {
+    std::lock_guard lock(impl_->mutex);
+    if (impl_->connected.load(std::memory_order_acquire)) {
+        for (const auto& [channel, handler] : impl_->handlers) {
+            impl_->send(channel_message("unsubscribe", channel));
+        }
+    }
+    impl_->handlers.clear();
+}
+
+bool MarketStream::is_connected() const {
+    return impl_->connected.load(std::memory_order_acquire);
+}
+
+bool MarketStream::supported() {
+    return true;
+}
+
+#else  // !LX_TRADING_HAVE_WEBSOCKET
+
+struct MarketStream::Impl {};
+
+MarketStream::MarketStream(std::string) : impl_(std::make_unique<Impl>()) {}
+MarketStream::~MarketStream() = default;
+
+void MarketStream::start() {}
+void MarketStream::stop() {}
+void MarketStream::subscribe(const std::string&, Handler) {}
+void MarketStream::unsubscribe_all() {}
+
+bool MarketStream::is_connected() const {
+    return false;
+}
+
+bool MarketStream::supported() {
+    return false;
+}
+
+#endif
+
+}  // namespace lx::trading
@@ -0,0 +1,47 @@
+// LX Trading SDK - Native Market Data Stream
+// WebSocket subscriptions for the LX venues
+
+#pragma once
+
+#include <nlohmann/json_fwd.hpp>
+#include <functional>
+#include <memory>
+#include <string>
+
+namespace lx::trading {
+
+// One WebSocket connection carrying channel subscriptions in the LX wire
+// format shared with the C and C++ node SDKs: {"type":"subscribe",
+// "channel":"orderbook:BTC-USDC"} out, {"type":"orderbook_update",
+// "data":{...}} in. Subscriptions are replayed after a reconnect.
+// Handlers run on the stream's IO thread and must not block.
+class MarketStream {
+public:
+    using Handler = std::function<void(const nlohmann::json& data)>;
+
+    explicit MarketStream(std::string url);
+    ~MarketStream();
+
+    MarketStream(const MarketStream&) = delete;
+    MarketStream& operator=(const MarketStream&) = delete;
+
+    // Connect in the background; reconnects until stop()
+    void start();
+    void stop();
+
+    // Channels: "ticker:<symbol>", "orderbook:<symbol>", "trades:<symbol>", "orders"
+    void subscribe(const std::string& channel, Handler handler);
+    void unsubscribe_all();
+
+    [[nodiscard]] bool is_connected() const;
+
+    // False unless built with LX_TRADING_WEBSOCKET; the stream then never
+    // connects
+    [[nodiscard]] static bool supported();
+
+private:
+    struct Impl;
+    std::unique_ptr<Impl> impl_;
+};
+
+}  // namespace lx::trading
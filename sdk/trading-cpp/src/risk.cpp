@@ -1,14 +1,128 @@
 // LX Trading SDK - Risk Manager Implementation
 
 #include <lx/trading/risk.hpp>
+#include <algorithm>
+#include <utility>
 
 namespace lx::trading {
 
-RiskManager::RiskManager(const RiskConfig& config) : config_(config) {}
+namespace {
 
-void RiskManager::validate_order(const OrderRequest& request) {
-    if (!config_.enabled) return;
+constexpr auto relaxed = std::memory_order_relaxed;
+
+int64_t abs64(int64_t v) noexcept { return v < 0 ? -v : v; }
+
+// Base asset of a symbol ("BTC" for "BTC-USDC"); empty if unparseable
+std::string base_asset(const std::string& symbol) {
+    auto pair = TradingPair::from_symbol(symbol);
+    return pair ? std::string(pair->base.data()) : std::string();
+}
+
+// Add `amount` to `counter` unless the result would pass `limit`
+bool reserve_up_to(std::atomic<int64_t>& counter, int64_t amount, int64_t limit) noexcept {
+    int64_t current = counter.load(relaxed);
+    do {
+        if (current + amount > limit) return false;
+    } while (!counter.compare_exchange_weak(current, current + amount, std::memory_order_acq_rel, relaxed));
+    return true;
+}
+
+}  // namespace
+
+// =============================================================================
+// RiskReservation
+// =============================================================================
+
+RiskReservation& RiskReservation::operator=(RiskReservation&& other) noexcept {
+    if (this != &other) {
+        reject();
+        symbol_ = std::exchange(other.symbol_, nullptr);
+        asset_ = std::exchange(other.asset_, nullptr);
+        side_ = other.side_;
+        quantity_ = std::exchange(other.quantity_, 0);
+        notional_ = std::exchange(other.notional_, 0);
+    }
+    return *this;
+}
+
+void RiskReservation::release_exposure() noexcept {
+    if (asset_) {
+        auto& reserved = (side_ == Side::Buy) ? asset_->reserved_buy : asset_->reserved_sell;
+        reserved.fetch_sub(quantity_, std::memory_order_release);
+    }
+    if (notional_ != 0) {
+        symbol_->reserved_notional.fetch_sub(notional_, std::memory_order_release);
+    }
+}
+
+void RiskReservation::acknowledge() noexcept {
+    if (!symbol_) return;
+    release_exposure();     // Open-order slot stays until order_closed()
+    symbol_ = nullptr;
+    asset_ = nullptr;
+}
+
+void RiskReservation::reject() noexcept {
+    if (!symbol_) return;
+    release_exposure();
+    symbol_->open_orders.fetch_sub(1, std::memory_order_release);
+    symbol_ = nullptr;
+    asset_ = nullptr;
+}
+
+// =============================================================================
+// RiskManager
+// =============================================================================
+
+RiskManager::RiskManager(const RiskConfig& config) : config_(config) {
+    slot_maps_.push_back(std::make_unique<const SlotMap>());
+    slot_map_.store(slot_maps_.back().get(), std::memory_order_release);
+}
+
+RiskManager::~RiskManager() = default;
+
+RiskSlot* RiskManager::find_slot(const std::string& name) const noexcept {
+    const SlotMap& map = *slot_map_.load(std::memory_order_acquire);
+    auto it = map.find(name);
+    return (it != map.end()) ? it->second : nullptr;
+}
+
+RiskSlot& RiskManager::slot(const std::string& name) {
+    if (RiskSlot* existing = find_slot(name)) {
+        return *existing;
+    }
+
+    std::lock_guard lock(slots_mutex_);
+    if (RiskSlot* existing = find_slot(name)) {
+        return *existing;
+    }
+
+    RiskSlot& created = slots_.emplace_back();
+    created.position_limit = position_limit(name);
+
+    // Copy-on-write: readers keep using the map they loaded, so old maps
+    // are retired only with the manager
+    auto next = std::make_unique<SlotMap>(*slot_map_.load(relaxed));
+    next->emplace(name, &created);
+    slot_maps_.push_back(std::move(next));
+    slot_map_.store(slot_maps_.back().get(), std::memory_order_release);
+    return created;
+}
 
+int64_t RiskManager::position_limit(const std::string& asset) const noexcept {
+    int64_t limit = 0;
+    auto it = config_.position_limits.find(asset);
+    if (it != config_.position_limits.end()) {
+        limit = it->second.scaled_value();
+    }
+    if (config_.max_position_size.is_positive()) {
+        const int64_t global = config_.max_position_size.scaled_value();
+        limit = (limit > 0) ? std::min(limit, global) : global;
+    }
+    return limit;
+}
+
+void RiskManager::check_stateless(const OrderRequest& request) const {
     if (kill_switch_.load(std::memory_order_acquire)) {
         throw RiskError("Kill switch is active");
     }
@@ -21,24 +135,34 @@ void RiskManager::validate_order(const OrderRequest& request) {
             " exceeds max " + config_.max_order_size.to_string());
     }
 
-    // Check position limit
-    auto pair = TradingPair::from_symbol(request.symbol);
-    if (pair) {
-        std::string base(pair->base.data());
+    // Check daily loss
+    if (!check_daily_loss()) {
+        throw RiskError(
+            "Daily loss limit exceeded: " +
+            daily_pnl().abs().to_string() + " > " +
+            config_.max_daily_loss.to_string());
+    }
+}
+
+void RiskManager::validate_order(const OrderRequest& request) {
+    if (!config_.enabled) return;
+
+    check_stateless(request);
 
+    // Check position limit, counting orders still awaiting acknowledgement
+    std::string base = base_asset(request.symbol);
+    if (!base.empty()) {
         Decimal current;
-        {
-            std::shared_lock lock(position_mutex_);
-            auto it = positions_.find(base);
-            if (it != positions_.end()) {
-                current = it->second;
-            }
+        Decimal new_position;
+        if (const RiskSlot* s = find_slot(base)) {
+            current = Decimal(s->position.load(relaxed));
+            new_position = (request.side == Side::Buy)
+                ? current + Decimal(s->reserved_buy.load(relaxed)) + request.quantity
+                : current - Decimal(s->reserved_sell.load(relaxed)) - request.quantity;
+        } else {
+            new_position = (request.side == Side::Buy) ? request.quantity : Decimal::zero() - request.quantity;
         }
 
-        Decimal new_position = (request.side == Side::Buy)
-            ? current + request.quantity
-            : current - request.quantity;
-
         // Asset-specific limit
         auto limit_it = config_.position_limits.find(base);
         if (limit_it != config_.position_limits.end()) {
@@ -61,87 +185,139 @@ void RiskManager::validate_order(const OrderRequest& request) {
     }
 
     // Check open orders count
-    {
-        std::shared_lock lock(orders_mutex_);
-        auto it = open_orders_.find(request.symbol);
-        int count = (it != open_orders_.end()) ? it->second : 0;
+    if (!check_open_orders(request.symbol)) {
+        throw RiskError(
+            "Max open orders (" + std::to_string(config_.max_open_orders) +
+            ") reached for " + request.symbol);
+    }
+}
+
+RiskReservation RiskManager::reserve(const OrderRequest& request) {
+    RiskReservation reservation;
+    RiskSlot& symbol = slot(request.symbol);
+
+    if (!config_.enabled) {
+        symbol.open_orders.fetch_add(1, std::memory_order_acq_rel);
+        reservation.symbol_ = &symbol;
+        return reservation;
+    }
+
+    check_stateless(request);
+
+    // Open-order slot
+    int count = symbol.open_orders.load(relaxed);
+    do {
         if (count >= config_.max_open_orders) {
             throw RiskError(
                 "Max open orders (" + std::to_string(config_.max_open_orders) +
                 ") reached for " + request.symbol);
         }
-    }
+    } while (!symbol.open_orders.compare_exchange_weak(count, count + 1, std::memory_order_acq_rel, relaxed));
+    reservation.symbol_ = &symbol;
+    reservation.side_ = request.side;
 
-    // Check daily loss
-    if (config_.max_daily_loss.is_positive()) {
-        std::shared_lock lock(pnl_mutex_);
-        if (daily_pnl_.is_negative() &&
-            daily_pnl_.abs() > config_.max_daily_loss) {
+    // Pending notional; market orders carry no price and are not counted
+    if (config_.max_pending_notional.is_positive() && request.price) {
+        const int64_t notional = (request.quantity * *request.price).scaled_value();
+        if (!reserve_up_to(symbol.reserved_notional, notional,
+                           config_.max_pending_notional.scaled_value())) {
             throw RiskError(
-                "Daily loss limit exceeded: " +
-                daily_pnl_.abs().to_string() + " > " +
-                config_.max_daily_loss.to_string());
+                "Pending notional limit (" + config_.max_pending_notional.to_string() +
+                ") reached for " + request.symbol);     // Reservation destructor releases the slot
+        }
+        reservation.notional_ = notional;
+    }
+
+    // Position headroom: worst case if every pending order on this side fills
+    std::string base = base_asset(request.symbol);
+    if (!base.empty()) {
+        RiskSlot& asset = slot(base);
+        const int64_t qty = request.quantity.scaled_value();
+        if (asset.position_limit > 0) {
+            const int64_t position = asset.position.load(relaxed);
+            auto& reserved = (request.side == Side::Buy) ? asset.reserved_buy : asset.reserved_sell;
+            int64_t current = reserved.load(relaxed);
+            do {
+                const int64_t worst = (request.side == Side::Buy)
+                    ? position + current + qty
+                    : position - current - qty;
+                if (abs64(worst) > asset.position_limit) {
+                    throw RiskError(
+                        "Position limit exceeded for " + base + ": " +
+                        Decimal(position).to_string() + " + " + request.quantity.to_string() +
+                        " > " + Decimal(asset.position_limit).to_string());
+                }
+            } while (!reserved.compare_exchange_weak(current, current + qty, std::memory_order_acq_rel, relaxed));
+        } else {
+            auto& reserved = (request.side == Side::Buy) ? asset.reserved_buy : asset.reserved_sell;
+            reserved.fetch_add(qty, std::memory_order_acq_rel);
         }
+        reservation.asset_ = &asset;
+        reservation.quantity_ = qty;
     }
+
+    return reservation;
 }
 
 void RiskManager::update_position(const std::string& asset, Decimal quantity, Side side) {
-    std::unique_lock lock(position_mutex_);
-    auto& pos = positions_[asset];
-    pos = (side == Side::Buy) ? pos + quantity : pos - quantity;
+    RiskSlot& s = slot(asset);
+    const int64_t delta = quantity.scaled_value();
+    s.position.fetch_add((side == Side::Buy) ? delta : -delta, std::memory_order_acq_rel);
+    s.has_position.store(true, std::memory_order_release);
 }
 
 Decimal RiskManager::position(const std::string& asset) const {
-    std::shared_lock lock(position_mutex_);
-    auto it = positions_.find(asset);
-    return (it != positions_.end()) ? it->second : Decimal::zero();
+    const RiskSlot* s = find_slot(asset);
+    return s ? Decimal(s->position.load(std::memory_order_acquire)) : Decimal::zero();
 }
 
 std::unordered_map<std::string, Decimal> RiskManager::positions() const {
-    std::shared_lock lock(position_mutex_);
-    return positions_;
+    std::unordered_map<std::string, Decimal> result;
+    for (const auto& [name, s] : *slot_map_.load(std::memory_order_acquire)) {
+        if (s->has_position.load(std::memory_order_acquire)) {
+            result.emplace(name, Decimal(s->position.load(std::memory_order_acquire)));
+        }
+    }
+    return result;
 }
 
 void RiskManager::update_pnl(Decimal pnl) {
-    std::unique_lock lock(pnl_mutex_);
-    daily_pnl_ = daily_pnl_ + pnl;
+    const int64_t total = daily_pnl_.fetch_add(pnl.scaled_value(), std::memory_order_acq_rel) +
+                          pnl.scaled_value();
 
     // Auto kill switch
     if (config_.kill_switch_enabled &&
         config_.max_daily_loss.is_positive() &&
-        daily_pnl_.is_negative() &&
-        daily_pnl_.abs() > config_.max_daily_loss) {
+        total < 0 && -total > config_.max_daily_loss.scaled_value()) {
         kill_switch_.store(true, std::memory_order_release);
     }
 }
 
 Decimal RiskManager::daily_pnl() const {
-    std::shared_lock lock(pnl_mutex_);
-    return daily_pnl_;
+    return Decimal(daily_pnl_.load(std::memory_order_acquire));
 }
 
 void RiskManager::reset_daily_pnl() {
-    std::unique_lock lock(pnl_mutex_);
-    daily_pnl_ = Decimal::zero();
+    daily_pnl_.store(0, std::memory_order_release);
 }
 
 void RiskManager::order_opened(const std::string& symbol) {
-    std::unique_lock lock(orders_mutex_);
-    open_orders_[symbol]++;
+    slot(symbol).open_orders.fetch_add(1, std::memory_order_acq_rel);
 }
 
 void RiskManager::order_closed(const std::string& symbol) {
-    std::unique_lock lock(orders_mutex_);
-    auto it = open_orders_.find(symbol);
-    if (it != open_orders_.end() && it->second > 0) {
-        it->second--;
+    RiskSlot* s = find_slot(symbol);
+    if (!s) return;
+
+    int count = s->open_orders.load(relaxed);
+    while (count > 0 &&
+           !s->open_orders.compare_exchange_weak(count, count - 1, std::memory_order_acq_rel, relaxed)) {
     }
 }
 
 int RiskManager::open_orders(const std::string& symbol) const {
-    std::shared_lock lock(orders_mutex_);
-    auto it = open_orders_.find(symbol);
-    return (it != open_orders_.end()) ? it->second : 0;
+    const RiskSlot* s = find_slot(symbol);
+    return s ? s->open_orders.load(std::memory_order_acquire) : 0;
 }
 
 bool RiskManager::check_order_size(Decimal quantity) const noexcept {
@@ -166,15 +342,13 @@ bool RiskManager::check_position_limit(
 bool RiskManager::check_daily_loss() const noexcept {
     if (!config_.max_daily_loss.is_positive()) return true;
 
-    std::shared_lock lock(pnl_mutex_);
-    return !daily_pnl_.is_negative() ||
-           daily_pnl_.abs() <= config_.max_daily_loss;
+    const int64_t pnl = daily_pnl_.load(relaxed);
+    return pnl >= 0 || -pnl <= config_.max_daily_loss.scaled_value();
 }
 
 bool RiskManager::check_open_orders(const std::string& symbol) const noexcept {
-    std::shared_lock lock(orders_mutex_);
-    auto it = open_orders_.find(symbol);
-    int count = (it != open_orders_.end()) ? it->second : 0;
+    const RiskSlot* s = find_slot(symbol);
+    const int count = s ? s->open_orders.load(relaxed) : 0;
     return count < config_.max_open_orders;
 }
 
@@ -0,0 +1,112 @@
+// LX Trading SDK - Arbitrage Graph Tests
+
+#include <catch2/catch_test_macros.hpp>
+#include <catch2/catch_approx.hpp>
+#include <lx/trading/arbitrage/graph.hpp>
+#include <lx/trading/arbitrage/scanner.hpp>
+
+using namespace lx::trading;
+using namespace lx::trading::arbitrage;
+using Catch::Approx;
+
+namespace {
+
+PriceSource quote(const std::string& chain, const std::string& venue, const std::string& symbol,
+                  double bid, double ask, double liquidity, int64_t timestamp = now_ms()) {
+    PriceSource source;
+    source.chain_id = chain;
+    source.venue = venue;
+    source.symbol = symbol;
+    source.bid = Decimal::from_double(bid);
+    source.ask = Decimal::from_double(ask);
+    source.liquidity = Decimal::from_double(liquidity);
+    source.timestamp = timestamp;
+    return source;
+}
+
+}  // namespace
+
+TEST_CASE("Arbitrage graph cycles", "[arbitrage]") {
+    SECTION("Triangular cycle closes on the quote that completes it") {
+        ArbitrageGraph graph(CycleConfig{});
+        REQUIRE(graph.update_price(quote("lux", "lx_dex", "BTC-USDC", 49990, 50000, 10)).empty());
+        REQUIRE(graph.update_price(quote("lux", "lx_dex", "ETH-USDC", 2499, 2500, 100)).empty());
+
+        // 1 ETH sells for 0.052 BTC, worth 2599 USDC, but costs 2500
+        auto cycles = graph.update_price(quote("lux", "lx_dex", "ETH-BTC", 0.052, 0.0521, 100));
+        REQUIRE(cycles.size() == 1);
+        const auto& opp = cycles[0];
+        REQUIRE(opp.arb_type == ArbType::Triangular);
+        REQUIRE(opp.routes.size() == 3);
+        REQUIRE(opp.routes[0].token_in == "USDC");
+        REQUIRE(opp.routes[0].action == "buy");
+        REQUIRE(opp.routes[0].token_out == "ETH");
+        REQUIRE(opp.routes[1].action == "sell");
+        REQUIRE(opp.routes[1].token_out == "BTC");
+        REQUIRE(opp.routes[2].token_out == "USDC");
+        REQUIRE(opp.routes[0].amount_in.to_double() == Approx(10000.0));
+        // 3.98% gross, 3.67% after three 10 bps fees
+        REQUIRE(opp.spread_bps.to_double() == Approx(366.8).margin(0.5));
+        REQUIRE(opp.net_pnl.to_double() == Approx(366.8).margin(0.5));
+        REQUIRE(graph.node_count() == 3);
+    }
+
+    SECTION("Cross-chain cycle pays its transfers") {
+        ArbitrageGraph graph(CycleConfig{}, [](const std::string& a, const std::string& b) {
+            return std::make_pair(Decimal::from_double(0.05),
+                                  Decimal::from_double(a == b ? 0.0 : 1.0));
+        });
+        REQUIRE(graph.update_price(quote("lux", "lx_dex", "BTC-USDC", 48990, 49000, 0.1)).empty());
+
+        auto cycles = graph.update_price(quote("ethereum", "uniswap", "BTC-USDC", 50000, 50010, 1));
+        REQUIRE(cycles.size() == 1);
+        const auto& opp = cycles[0];
+        REQUIRE(opp.arb_type == ArbType::MultiHop);
+        REQUIRE(opp.routes.size() == 4);
+        REQUIRE(opp.bridge_cost_usd.to_double() == Approx(2.0));
+        REQUIRE(opp.gas_cost_usd.to_double() == Approx(0.1));
+        // Sized by the 0.1 BTC on offer, not the 10k notional
+        REQUIRE(opp.max_size.to_double() == Approx(4900.0).margin(1.0));
+        REQUIRE(opp.net_pnl.to_double() == Approx(87.9).margin(0.5));
+        REQUIRE(opp.buy_source.venue == "lx_dex");
+        REQUIRE(opp.sell_source.venue == "uniswap");
+    }
+
+    SECTION("Stale and dearer quotes close nothing") {
+        CycleConfig config;
+        config.max_price_age_ms = 1000;
+        ArbitrageGraph graph(config);
+        graph.update_price(quote("lux", "lx_dex", "BTC-USDC", 49990, 50000, 10, now_ms() - 5000));
+        graph.update_price(quote("lux", "lx_dex", "ETH-USDC", 2499, 2500, 100));
+        REQUIRE(graph.update_price(quote("lux", "lx_dex", "ETH-BTC", 0.052, 0.0521, 100)).empty());
+
+        // Fresh BTC quote reopens it; a fair ETH-BTC price closes it again
+        REQUIRE(graph.update_price(quote("lux", "lx_dex", "BTC-USDC", 49990, 50000, 10)).size() == 1);
+        REQUIRE(graph.update_price(quote("lux", "lx_dex", "ETH-BTC", 0.0499, 0.05, 100)).empty());
+    }
+
+    SECTION("Hop limit") {
+        CycleConfig config;
+        config.max_legs = 2;
+        ArbitrageGraph graph(config);
+        graph.update_price(quote("lux", "lx_dex", "BTC-USDC", 49990, 50000, 10));
+        graph.update_price(quote("lux", "lx_dex", "ETH-USDC", 2499, 2500, 100));
+        REQUIRE(graph.update_price(quote("lux", "lx_dex", "ETH-BTC", 0.052, 0.0521, 100)).empty());
+    }
+}
+
+TEST_CASE("Scanner emits multi-leg cycles", "[arbitrage]") {
+    ScannerConfig config;
+    config.cycles = CycleConfig{};
+    Scanner scanner(config);
+
+    std::vector<ArbitrageOpportunity> seen;
+    scanner.on_opportunity([&](const ArbitrageOpportunity& opp) { seen.push_back(opp); });
+
+    scanner.update_price(quote("lux", "lx_dex", "BTC-USDC", 49990, 50000, 10));
+    scanner.update_price(quote("lux", "lx_dex", "ETH-USDC", 2499, 2500, 100));
+    REQUIRE(seen.empty());
+    scanner.update_price(quote("lux", "lx_dex", "ETH-BTC", 0.052, 0.0521, 100));
+    REQUIRE(seen.size() == 1);
+    REQUIRE(seen[0].arb_type == ArbType::Triangular);
+}
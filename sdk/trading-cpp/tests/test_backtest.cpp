@@ -0,0 +1,233 @@
+// LX Trading SDK - Backtest Tests
+
+#include <catch2/catch_test_macros.hpp>
+#include <catch2/catch_approx.hpp>
+#include <lx/trading/backtest.hpp>
+#include <lux/journal.hpp>
+#include <cstdio>
+#include <filesystem>
+#include <fstream>
+#include <unistd.h>
+
+using namespace lx::trading;
+using namespace std::chrono_literals;
+using Catch::Approx;
+
+namespace {
+
+Decimal dec(double v) { return Decimal::from_double(v); }
+
+std::string temp_path(const std::string& name) {
+    return (std::filesystem::temp_directory_path() /
+            ("lx_trading_test_" + name + "_" + std::to_string(::getpid()))).string();
+}
+
+// 5 bid @ 100 and 5 ask @ 101, then sells printing at 100
+std::shared_ptr<const MarketData> two_sided_tape() {
+    MarketDataBuilder builder;
+    builder.level(0, "BTC-USD", Side::Buy, dec(100), dec(5))
+           .level(0, "BTC-USD", Side::Sell, dec(101), dec(5))
+           .trade(1000000, "BTC-USD", Side::Sell, dec(100), dec(3))
+           .trade(2000000, "BTC-USD", Side::Sell, dec(100), dec(3));
+    return builder.build();
+}
+
+// Joins the bid with one unit on the first book it sees
+class JoinBid : public Strategy {
+public:
+    void on_book(BacktestContext& ctx, const Ticker& top) override {
+        if (placed || !top.bid) return;
+        placed = true;
+        ctx.place_order(OrderRequest::limit(top.symbol, Side::Buy, dec(1), *top.bid));
+    }
+
+    void on_fill(BacktestContext& ctx, const Trade& fill) override {
+        fill_time = ctx.now_ns();
+        maker = fill.is_maker;
+    }
+
+    bool placed = false;
+    int64_t fill_time = -1;
+    bool maker = false;
+};
+
+// Buys `quantity` at market on the first book it sees
+class BuyAtMarket : public Strategy {
+public:
+    explicit BuyAtMarket(double quantity) : quantity(quantity) {}
+
+    void on_book(BacktestContext& ctx, const Ticker& top) override {
+        if (placed) return;
+        placed = true;
+        ctx.place_order(OrderRequest::market(top.symbol, Side::Buy, dec(quantity)));
+    }
+
+    void on_fill(BacktestContext& ctx, const Trade& fill) override {
+        (void)ctx;
+        price = fill.price.to_double();
+    }
+
+    double quantity;
+    bool placed = false;
+    double price = 0.0;
+};
+
+}  // namespace
+
+TEST_CASE("Backtest queue position", "[backtest]") {
+    SECTION("Resting orders queue behind recorded liquidity") {
+        Backtest backtest(two_sided_tape());
+        JoinBid strategy;
+        auto result = backtest.run(strategy);
+
+        REQUIRE(result.error.empty());
+        REQUIRE(result.events == 4);
+        REQUIRE(result.fills == 1);
+        REQUIRE(result.maker_fills == 1);
+        REQUIRE(strategy.maker);
+        // The first print only reaches the 5 ahead of us
+        REQUIRE(strategy.fill_time == 2000000);
+        REQUIRE(result.symbols[0].position == dec(1));
+        REQUIRE(result.symbols[0].cash == Approx(-100.0));
+    }
+
+    SECTION("Cancels ahead of us move us up under the pessimistic model") {
+        MarketDataBuilder builder;
+        // 3 join behind us, then 3 leave
+        builder.level(0, "BTC-USD", Side::Buy, dec(100), dec(5))
+               .level(200000, "BTC-USD", Side::Buy, dec(100), dec(8))
+               .level(500000, "BTC-USD", Side::Buy, dec(100), dec(5))
+               .trade(1000000, "BTC-USD", Side::Sell, dec(100), dec(3));
+        auto data = builder.build();
+
+        BacktestConfig config;
+        JoinBid optimistic;
+        REQUIRE(Backtest(data, config).run(optimistic).fills == 0);
+        REQUIRE(optimistic.fill_time == -1);
+
+        config.queue_model = QueueModel::CancelsFromFront;
+        JoinBid pessimistic;
+        REQUIRE(Backtest(data, config).run(pessimistic).fills == 1);
+        REQUIRE(pessimistic.fill_time == 1000000);
+    }
+}
+
+TEST_CASE("Backtest latency", "[backtest]") {
+    // The ask steps from 101 to 102 half a millisecond in
+    MarketDataBuilder builder;
+    builder.level(0, "ETH-USD", Side::Sell, dec(101), dec(1))
+           .level(500000, "ETH-USD", Side::Sell, dec(102), dec(1))
+           .level(500000, "ETH-USD", Side::Sell, dec(101), dec(0))
+           .trade(2000000, "ETH-USD", Side::Buy, dec(102), dec(0.5));
+    auto data = builder.build();
+
+    BacktestConfig config;
+    config.taker_fee = 0.001;
+
+    BuyAtMarket fast(1.0);
+    auto result = Backtest(data, config).run(fast);
+    REQUIRE(fast.price == Approx(101.0));
+    REQUIRE(result.fees == Approx(0.101));
+    REQUIRE(result.maker_fills == 0);
+
+    config.order_latency = 1ms;
+    BuyAtMarket slow(1.0);
+    REQUIRE(Backtest(data, config).run(slow).fills == 1);
+    REQUIRE(slow.price == Approx(102.0));
+}
+
+TEST_CASE("Backtest parameter sweep", "[backtest]") {
+    MarketDataBuilder builder;
+    for (int i = 0; i < 100; ++i) {
+        builder.level(i * 1000, "SOL-USD", Side::Sell, dec(50 + i), dec(10));
+    }
+    Backtest backtest(builder.build());
+
+    auto results = backtest.run_parallel(8, [](size_t run) {
+        return std::make_unique<BuyAtMarket>(static_cast<double>(run + 1));
+    }, 4);
+
+    REQUIRE(results.size() == 8);
+    for (size_t i = 0; i < results.size(); ++i) {
+        REQUIRE(results[i].run == i);
+        REQUIRE(results[i].error.empty());
+        REQUIRE(results[i].symbols[0].position == dec(static_cast<double>(i + 1)));
+        // No bid, so marked at its own fill price
+        REQUIRE(results[i].pnl == Approx(0.0));
+    }
+}
+
+TEST_CASE("Backtest data loading", "[backtest]") {
+    SECTION("CSV") {
+        const std::string path = temp_path("tape.csv");
+        {
+            std::ofstream out(path);
+            out << "timestamp_ns,symbol,type,side,price,quantity\n"
+                << "2000,BTC-USD,T,sell,100.5,0.25\n"
+                << "1000,BTC-USD,L,bid,100.5,2\n"
+                << "\n"
+                << "1000,ETH-USD,L,ask,3000,1\n";
+        }
+        auto data = MarketData::load_csv(path);
+        std::remove(path.c_str());
+
+        REQUIRE(data->symbols().size() == 2);
+        REQUIRE(data->events().size() == 3);
+        REQUIRE(data->events()[0].kind == MarketEventKind::Level);
+        REQUIRE(data->events()[2].kind == MarketEventKind::Trade);
+        REQUIRE(data->events()[2].price == dec(100.5).scaled_value());
+        REQUIRE(data->start_time() == 1000);
+        REQUIRE(data->end_time() == 2000);
+        REQUIRE_THROWS(MarketData::load_csv(path));
+    }
+
+    SECTION("Engine journal") {
+        const std::string path = temp_path("journal");
+        std::remove(path.c_str());
+        {
+            auto journal = lux::Journal::open(path);
+            REQUIRE(journal);
+            lux::JournalRecord add{};
+            add.type = lux::JournalRecordType::AddSymbol;
+            add.symbol_id = 7;
+            journal->append(add);
+
+            lux::JournalRecord place{};
+            place.type = lux::JournalRecordType::Place;
+            place.symbol_id = 7;
+            place.order = lux::OrderBuilder().id(1).symbol(7).side(lux::Side::Sell)
+                              .price(100).quantity(2).build();
+            journal->append(place);
+            place.order = lux::OrderBuilder().id(2).symbol(7).side(lux::Side::Buy)
+                              .price(100).quantity(1).build();
+            journal->append(place);
+
+            lux::JournalRecord cancel{};
+            cancel.type = lux::JournalRecordType::Cancel;
+            cancel.symbol_id = 7;
+            cancel.order_id = 1;
+            journal->append(cancel);
+            journal->commit();
+        }
+        auto data = MarketData::load_journal(path, {{7, "BTC-USD"}});
+        std::remove(path.c_str());
+        REQUIRE(data);
+        REQUIRE(data->symbols() == std::vector<std::string>{"BTC-USD"});
+        REQUIRE(data->events().size() == 3);
+
+        struct Prints : Strategy {
+            void on_trade(BacktestContext&, const Trade& print) override { prints.push_back(print); }
+            void on_book(BacktestContext&, const Ticker& top) override { last = top; }
+            std::vector<Trade> prints;
+            Ticker last;
+        } strategy;
+        auto result = Backtest(data).run(strategy);
+        REQUIRE(result.events == 3);
+        REQUIRE(strategy.prints.size() == 1);
+        REQUIRE(strategy.prints[0].price == dec(100));
+        REQUIRE(strategy.prints[0].quantity == dec(1));
+        REQUIRE(strategy.prints[0].side == Side::Buy);
+        // The resting remainder was cancelled
+        REQUIRE_FALSE(strategy.last.ask);
+    }
+}
@@ -0,0 +1,139 @@
+// LX Trading SDK - Execution Scheduler Tests
+
+#include <catch2/catch_test_macros.hpp>
+#include <catch2/catch_approx.hpp>
+#include <lx/trading/execution_scheduler.hpp>
+
+using namespace lx::trading;
+using namespace std::chrono_literals;
+using Catch::Approx;
+
+namespace {
+
+// Fills one unit per step at 100 + step; no Client needed
+class CountingExecutor : public Executor {
+public:
+    CountingExecutor(std::string symbol, int steps, std::chrono::milliseconds interval)
+        : symbol_(std::move(symbol)), steps_(steps), interval_(interval) {}
+
+    [[nodiscard]] const std::string& symbol() const override { return symbol_; }
+
+protected:
+    RunState begin() override {
+        return start_run(Decimal::from_double(steps_));
+    }
+
+    std::optional<std::chrono::milliseconds> step(RunState& state) override {
+        if (cancelled()) {
+            state.result.error = "Cancelled";
+            return std::nullopt;
+        }
+
+        Order order;
+        order.symbol = symbol_;
+        order.filled_quantity = Decimal::from_double(1.0);
+        order.average_price = Decimal::from_double(100.0 + state.iteration);
+        record_order(state, order);
+
+        if (++state.iteration >= steps_) return std::nullopt;
+        return interval_;
+    }
+
+    bool on_fill(RunState&, const Order&) override { return true; }
+
+private:
+    std::string symbol_;
+    int steps_;
+    std::chrono::milliseconds interval_;
+};
+
+}  // namespace
+
+TEST_CASE("ExecutionScheduler runs executors", "[execution]") {
+    ExecutionScheduler scheduler;
+
+    SECTION("Same result as the threaded run") {
+        CountingExecutor threaded("BTC-USDC", 3, 5ms);
+        CountingExecutor scheduled("BTC-USDC", 3, 5ms);
+
+        auto a = threaded.execute().get();
+        auto b = scheduled.execute(scheduler).get();
+
+        REQUIRE(a.completed);
+        REQUIRE(b.completed);
+        REQUIRE(b.orders.size() == 3);
+        REQUIRE(b.total_filled.to_double() == Approx(3.0));
+        REQUIRE(b.average_price->to_double() == Approx(a.average_price->to_double()));
+        REQUIRE(b.average_price->to_double() == Approx(101.0));
+    }
+
+    SECTION("Many concurrent runs") {
+        std::vector<std::unique_ptr<CountingExecutor>> executors;
+        std::vector<std::future<ExecutionResult>> results;
+        for (int i = 0; i < 500; ++i) {
+            executors.push_back(std::make_unique<CountingExecutor>(
+                "SYM" + std::to_string(i % 7), 4, 10ms));
+            results.push_back(executors.back()->execute(scheduler));
+        }
+        for (auto& result : results) {
+            auto r = result.get();
+            REQUIRE(r.completed);
+            REQUIRE(r.orders.size() == 4);
+        }
+        REQUIRE(scheduler.active_runs() == 0);
+        REQUIRE(scheduler.pending_timers() == 0);
+    }
+
+    SECTION("Pushed fills pull the next step forward") {
+        CountingExecutor executor("ETH-USDC", 2, 60s);
+        auto result = executor.execute(scheduler);
+
+        Order fill;
+        fill.symbol = "ETH-USDC";
+        for (int i = 0; i < 50 && result.wait_for(10ms) != std::future_status::ready; ++i) {
+            scheduler.publish_fill(fill);
+        }
+
+        REQUIRE(result.wait_for(1s) == std::future_status::ready);
+        REQUIRE(result.get().orders.size() == 2);
+    }
+
+    SECTION("Cancel wakes a sleeping run") {
+        CountingExecutor executor("ETH-USDC", 5, 60s);
+        auto result = executor.execute(scheduler);
+        std::this_thread::sleep_for(20ms);
+        executor.cancel();
+
+        REQUIRE(result.wait_for(1s) == std::future_status::ready);
+        auto r = result.get();
+        REQUIRE_FALSE(r.completed);
+        REQUIRE(r.error == "Cancelled");
+    }
+
+    SECTION("Stop finishes active runs") {
+        CountingExecutor executor("SOL-USDC", 5, 60s);
+        auto result = executor.execute(scheduler);
+        std::this_thread::sleep_for(20ms);
+        scheduler.stop();
+
+        auto r = result.get();
+        REQUIRE(r.error == "Stopped");
+        REQUIRE(r.orders.size() == 1);
+    }
+}
+
+TEST_CASE("ExecutionScheduler timers", "[execution]") {
+    ExecutionScheduler scheduler({1, 1ms, 8});    // Tiny wheel: delays wrap
+
+    std::atomic<int> fired{0};
+    auto cancelled = scheduler.schedule_after(5s, [&] { fired += 100; });
+    scheduler.schedule_after(30ms, [&] { fired += 1; });
+    REQUIRE(scheduler.cancel_timer(cancelled));
+    REQUIRE_FALSE(scheduler.cancel_timer(cancelled));
+
+    for (int i = 0; i < 200 && fired.load() == 0; ++i) {
+        std::this_thread::sleep_for(5ms);
+    }
+    REQUIRE(fired.load() == 1);
+    REQUIRE(scheduler.pending_timers() == 0);
+}
@@ -60,6 +60,72 @@ TEST_CASE("Implied volatility", "[math]") {
     REQUIRE(iv == Approx(true_vol).margin(0.01));
 }
 
+TEST_CASE("Batch option kernels", "[math]") {
+    // Odd count so the vector kernels leave a scalar remainder
+    constexpr size_t n = 37;
+    std::vector<double> S(n, 100.0), K(n), T(n), r(n, 0.05), sigma(n);
+    for (size_t i = 0; i < n; ++i) {
+        K[i] = 80.0 + i;
+        T[i] = (i == 5) ? 0.0 : 0.1 + 0.05 * i;
+        sigma[i] = 0.15 + 0.01 * (i % 10);
+    }
+    INFO("SIMD: " << simd_isa());
+
+    SECTION("Black-Scholes matches scalar") {
+        for (bool is_call : {true, false}) {
+            std::vector<double> prices(n);
+            black_scholes_batch(S.data(), K.data(), T.data(), r.data(), sigma.data(),
+                                prices.data(), n, is_call);
+            for (size_t i = 0; i < n; ++i) {
+                REQUIRE(prices[i] == Approx(black_scholes(S[i], K[i], T[i], r[i], sigma[i], is_call))
+                                         .margin(1e-10));
+            }
+        }
+    }
+
+    SECTION("Greeks match scalar") {
+        std::vector<Greeks> batch(n);
+        greeks_batch(S.data(), K.data(), T.data(), r.data(), sigma.data(), batch.data(), n, false);
+        for (size_t i = 0; i < n; ++i) {
+            Greeks g = greeks(S[i], K[i], T[i], r[i], sigma[i], false);
+            REQUIRE(batch[i].delta == Approx(g.delta).margin(1e-10));
+            REQUIRE(batch[i].gamma == Approx(g.gamma).margin(1e-10));
+            REQUIRE(batch[i].theta == Approx(g.theta).margin(1e-10));
+            REQUIRE(batch[i].vega == Approx(g.vega).margin(1e-10));
+            REQUIRE(batch[i].rho == Approx(g.rho).margin(1e-10));
+        }
+    }
+
+    SECTION("Implied volatility round trip") {
+        std::vector<double> prices(n);
+        std::vector<double> iv(n);
+        black_scholes_batch(S.data(), K.data(), T.data(), r.data(), sigma.data(),
+                            prices.data(), n, true);
+        implied_volatility_batch(prices.data(), S.data(), K.data(), T.data(), r.data(),
+                                 iv.data(), n, true);
+        for (size_t i = 0; i < n; ++i) {
+            if (T[i] <= 0) {
+                REQUIRE(iv[i] == Approx(0.2));
+                continue;
+            }
+            REQUIRE(iv[i] == Approx(implied_volatility(prices[i], S[i], K[i], T[i], r[i], true))
+                                 .margin(1e-8));
+        }
+    }
+
+    SECTION("norm_cdf matches scalar") {
+        std::vector<double> x(n);
+        std::vector<double> cdf(n);
+        for (size_t i = 0; i < n; ++i) {
+            x[i] = -4.0 + 0.25 * i;
+        }
+        norm_cdf_batch(x.data(), cdf.data(), n);
+        for (size_t i = 0; i < n; ++i) {
+            REQUIRE(cdf[i] == Approx(norm_cdf(x[i])).margin(1e-12));
+        }
+    }
+}
+
 TEST_CASE("Constant product AMM", "[math]") {
     SECTION("Basic swap") {
         auto [out, price] = constant_product_price(1000, 1000, 10, 0.003, true);
@@ -218,6 +284,64 @@ TEST_CASE("Statistical utilities", "[math]") {
     }
 }
 
+TEST_CASE("Streaming statistics", "[math]") {
+    std::vector<double> market, asset, prices;
+    double price = 100.0;
+    for (int i = 0; i < 60; ++i) {
+        double m = 0.01 * std::sin(i * 0.7);
+        double a = 1.5 * m + 0.002 * std::cos(i * 1.3);
+        market.push_back(m);
+        asset.push_back(a);
+        price *= 1.0 + a * 5.0;
+        prices.push_back(price);
+    }
+
+    SECTION("Rolling mean and std match the vector versions") {
+        constexpr size_t window = 10;
+        auto means = rolling_mean(asset, window);
+        auto stds = rolling_std(asset, window);
+
+        RollingStats stats(window);
+        for (size_t i = 0; i < asset.size(); ++i) {
+            stats.update(asset[i]);
+            if (i + 1 >= window) {
+                REQUIRE(stats.full());
+                REQUIRE(stats.mean() == Approx(means[i + 1 - window]).margin(1e-12));
+                REQUIRE(stats.stddev() == Approx(stds[i + 1 - window]).margin(1e-12));
+            }
+        }
+    }
+
+    SECTION("EMA matches the vector version") {
+        StreamingEma streaming(0.2);
+        streaming.update(asset.data(), asset.size());
+        REQUIRE(streaming.value() == Approx(ema(asset, 0.2).back()));
+    }
+
+    SECTION("Rolling covariance and beta over the last window") {
+        constexpr size_t window = 20;
+        RollingCovariance cov(window);
+        cov.update(asset.data(), market.data(), asset.size());
+
+        std::vector<double> x(asset.end() - window, asset.end());
+        std::vector<double> y(market.end() - window, market.end());
+        REQUIRE(cov.count() == window);
+        REQUIRE(cov.covariance() == Approx(covariance(x, y)).margin(1e-12));
+        REQUIRE(cov.correlation() == Approx(correlation(x, y)).margin(1e-9));
+        REQUIRE(cov.beta() == Approx(beta(x, y)).margin(1e-9));
+    }
+
+    SECTION("Drawdown matches max_drawdown") {
+        StreamingDrawdown dd;
+        dd.update(prices.data(), prices.size());
+
+        auto [max_dd, peak, trough] = max_drawdown(prices);
+        REQUIRE(dd.max() == Approx(max_dd));
+        REQUIRE(dd.max_peak_index() == peak);
+        REQUIRE(dd.max_trough_index() == trough);
+    }
+}
+
 TEST_CASE("Price conversions", "[math]") {
     SECTION("Price to sqrt price") {
         double sqrt_p = price_to_sqrt_price(100);
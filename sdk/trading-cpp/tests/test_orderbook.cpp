@@ -111,6 +111,65 @@ TEST_CASE("Orderbook liquidity", "[orderbook]") {
     }
 }
 
+TEST_CASE("Orderbook sorted updates", "[orderbook]") {
+    Orderbook book("BTC-USDC", "test_venue");
+
+    SECTION("Levels stay sorted without sort()") {
+        book.set_bid(Decimal::from_double(99.0), Decimal::from_double(1.0));
+        book.set_bid(Decimal::from_double(101.0), Decimal::from_double(1.0));
+        book.set_bid(Decimal::from_double(100.0), Decimal::from_double(1.0));
+        book.set_ask(Decimal::from_double(104.0), Decimal::from_double(1.0));
+        book.set_ask(Decimal::from_double(102.0), Decimal::from_double(1.0));
+
+        auto bids = book.bids();
+        REQUIRE(bids.size() == 3);
+        REQUIRE(bids[0].price.to_double() == Approx(101.0));
+        REQUIRE(bids[2].price.to_double() == Approx(99.0));
+        REQUIRE(book.best_bid().value().to_double() == Approx(101.0));
+        REQUIRE(book.best_ask().value().to_double() == Approx(102.0));
+    }
+
+    SECTION("Upsert overwrites and remove updates the cached best") {
+        book.set_bid(Decimal::from_double(100.0), Decimal::from_double(1.0));
+        book.set_bid(Decimal::from_double(100.0), Decimal::from_double(3.0));
+        REQUIRE(book.bids().size() == 1);
+        REQUIRE(book.bids()[0].quantity.to_double() == Approx(3.0));
+
+        book.set_bid(Decimal::from_double(99.0), Decimal::from_double(1.0));
+        book.remove_bid(Decimal::from_double(100.0));
+        REQUIRE(book.best_bid().value().to_double() == Approx(99.0));
+
+        book.remove_bid(Decimal::from_double(99.0));
+        REQUIRE_FALSE(book.best_bid().has_value());
+    }
+
+    SECTION("Batch deltas") {
+        book.apply_deltas({
+            {Side::Buy, Decimal::from_double(100.0), Decimal::from_double(1.0)},
+            {Side::Buy, Decimal::from_double(99.0), Decimal::from_double(2.0)},
+            {Side::Sell, Decimal::from_double(101.0), Decimal::from_double(1.5)},
+            {Side::Sell, Decimal::from_double(102.0), Decimal::from_double(2.5)},
+        }, 7, 1000);
+
+        REQUIRE(book.sequence() == 7);
+        REQUIRE(book.timestamp() == 1000);
+        REQUIRE(book.best_bid().value().to_double() == Approx(100.0));
+        REQUIRE(book.best_ask().value().to_double() == Approx(101.0));
+
+        // Zero quantity deletes the level
+        book.apply_deltas({
+            {Side::Sell, Decimal::from_double(101.0), Decimal::zero()},
+            {Side::Buy, Decimal::from_double(100.5), Decimal::from_double(0.5)},
+        });
+
+        REQUIRE(book.sequence() == 8);
+        REQUIRE(book.asks().size() == 1);
+        REQUIRE(book.best_ask().value().to_double() == Approx(102.0));
+        REQUIRE(book.best_bid().value().to_double() == Approx(100.5));
+        REQUIRE(book.bids().size() == 3);
+    }
+}
+
 TEST_CASE("AggregatedOrderbook", "[orderbook]") {
     AggregatedOrderbook agg("BTC-USDC");
 
@@ -169,3 +228,59 @@ TEST_CASE("AggregatedOrderbook", "[orderbook]") {
         REQUIRE(price.to_double() == Approx(100.0));
     }
 }
+
+TEST_CASE("AggregatedOrderbook incremental updates", "[orderbook]") {
+    AggregatedOrderbook agg("BTC-USDC");
+
+    Orderbook book1("BTC-USDC", "venue1");
+    book1.add_bid(Decimal::from_double(100.0), Decimal::from_double(1.0));
+    book1.add_ask(Decimal::from_double(102.0), Decimal::from_double(1.0));
+
+    Orderbook book2("BTC-USDC", "venue2");
+    book2.add_bid(Decimal::from_double(99.0), Decimal::from_double(2.0));
+    book2.add_ask(Decimal::from_double(101.0), Decimal::from_double(1.5));
+
+    agg.add_orderbook(book1);
+    agg.add_orderbook(book2);
+
+    SECTION("Re-adding a venue replaces its levels") {
+        const uint64_t version = agg.bbo()->version;
+        agg.add_orderbook(book1);
+        REQUIRE(agg.bbo()->version == version);
+        REQUIRE(agg.aggregated_bids()[0].quantity.to_double() == Approx(1.0));
+
+        book1.remove_bid(Decimal::from_double(100.0));
+        book1.add_bid(Decimal::from_double(98.0), Decimal::from_double(3.0));
+        agg.add_orderbook(book1);
+
+        auto bbo = agg.bbo();
+        REQUIRE(bbo->version > version);
+        REQUIRE(bbo->bid->price.to_double() == Approx(99.0));
+        REQUIRE(bbo->bid->venue == "venue2");
+        REQUIRE(agg.aggregated_bids().size() == 2);
+    }
+
+    SECTION("Venue deltas touch only their levels") {
+        agg.apply_deltas("venue2", {
+            {Side::Sell, Decimal::from_double(101.0), Decimal::zero()},
+            {Side::Sell, Decimal::from_double(102.0), Decimal::from_double(4.0)},
+        });
+
+        auto asks = agg.aggregated_asks();
+        REQUIRE(asks.size() == 1);
+        REQUIRE(asks[0].quantity.to_double() == Approx(5.0));
+
+        auto best = agg.best_ask();
+        REQUIRE(best.has_value());
+        REQUIRE(std::get<0>(*best).to_double() == Approx(102.0));
+    }
+
+    SECTION("Removing a venue") {
+        agg.remove_venue("venue1");
+
+        auto [venue, price] = *agg.best_venue_sell(Decimal::from_double(1.0));
+        REQUIRE(venue == "venue2");
+        REQUIRE(price.to_double() == Approx(99.0));
+        REQUIRE(agg.aggregated_asks().size() == 1);
+    }
+}
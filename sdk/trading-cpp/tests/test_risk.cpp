@@ -3,6 +3,8 @@
 #include <catch2/catch_test_macros.hpp>
 #include <catch2/catch_approx.hpp>
 #include <lx/trading/risk.hpp>
+#include <thread>
+#include <vector>
 
 using namespace lx::trading;
 using Catch::Approx;
@@ -225,3 +227,81 @@ TEST_CASE("OrderTracker RAII", "[risk]") {
         REQUIRE(rm.open_orders("BTC-USDC") == 1);
     }
 }
+
+TEST_CASE("RiskManager reservations", "[risk]") {
+    RiskConfig config;
+    config.enabled = true;
+    config.max_open_orders = 3;
+    config.position_limits["BTC"] = Decimal::from_double(10.0);
+    config.max_pending_notional = Decimal::from_double(1000.0);
+
+    RiskManager rm(config);
+
+    SECTION("Acknowledge keeps the open order, releases headroom") {
+        auto r = rm.reserve(OrderRequest::market("BTC-USDC", Side::Buy,
+            Decimal::from_double(8.0)));
+        REQUIRE(r.active());
+        REQUIRE(rm.open_orders("BTC-USDC") == 1);
+
+        // Pending buy counts against the position limit
+        REQUIRE_THROWS_AS(rm.reserve(OrderRequest::market("BTC-USDC", Side::Buy,
+            Decimal::from_double(5.0))), RiskError);
+
+        r.acknowledge();
+        REQUIRE_FALSE(r.active());
+        REQUIRE(rm.open_orders("BTC-USDC") == 1);
+        REQUIRE_NOTHROW(rm.reserve(OrderRequest::market("BTC-USDC", Side::Buy,
+            Decimal::from_double(5.0))).acknowledge());
+    }
+
+    SECTION("Reject and destruction release everything") {
+        {
+            auto r = rm.reserve(OrderRequest::market("BTC-USDC", Side::Sell,
+                Decimal::from_double(9.0)));
+            REQUIRE(rm.open_orders("BTC-USDC") == 1);
+        }
+        REQUIRE(rm.open_orders("BTC-USDC") == 0);
+
+        auto r = rm.reserve(OrderRequest::market("BTC-USDC", Side::Sell,
+            Decimal::from_double(9.0)));
+        r.reject();
+        REQUIRE(rm.open_orders("BTC-USDC") == 0);
+    }
+
+    SECTION("Pending notional limit") {
+        auto a = rm.reserve(OrderRequest::limit("ETH-USDC", Side::Buy,
+            Decimal::from_double(0.3), Decimal::from_double(2000.0)));
+        REQUIRE_THROWS_AS(rm.reserve(OrderRequest::limit("ETH-USDC", Side::Buy,
+            Decimal::from_double(0.3), Decimal::from_double(2000.0))), RiskError);
+        REQUIRE(rm.open_orders("ETH-USDC") == 1);
+
+        a.acknowledge();
+        REQUIRE_NOTHROW(rm.reserve(OrderRequest::limit("ETH-USDC", Side::Buy,
+            Decimal::from_double(0.3), Decimal::from_double(2000.0))));
+    }
+
+    SECTION("Concurrent reservations never overshoot") {
+        config.max_open_orders = 1000;
+        RiskManager shared(config);
+
+        std::atomic<int> accepted{0};
+        std::vector<std::thread> threads;
+        std::vector<RiskReservation> held[4];
+        for (int t = 0; t < 4; ++t) {
+            threads.emplace_back([&, t] {
+                for (int i = 0; i < 50; ++i) {
+                    try {
+                        held[t].push_back(shared.reserve(OrderRequest::market(
+                            "BTC-USDC", Side::Buy, Decimal::from_double(0.5))));
+                        accepted.fetch_add(1);
+                    } catch (const RiskError&) {
+                    }
+                }
+            });
+        }
+        for (auto& thread : threads) thread.join();
+
+        REQUIRE(accepted.load() == 20);     // 10 BTC / 0.5
+        REQUIRE(shared.open_orders("BTC-USDC") == 20);
+    }
+}
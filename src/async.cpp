@@ -0,0 +1,145 @@
+// =============================================================================
+// async.cpp - Coroutine Event Loop
+// =============================================================================
+
+#include "lux/async.hpp"
+
+#include <thread>
+
+namespace lux::async {
+
+thread_local EventLoop* EventLoop::current_ = nullptr;
+
+void detail::Detached::promise_type::FinalAwaiter::await_suspend(
+    std::coroutine_handle<promise_type> done) noexcept {
+    done.promise().loop->flows_.erase(done.address());
+    done.destroy();
+}
+
+EventLoop::~EventLoop() {
+    for (void* frame : flows_) {
+        std::coroutine_handle<>::from_address(frame).destroy();
+    }
+}
+
+detail::Detached EventLoop::run_flow(Task<void> task) {
+    try {
+        co_await task;
+    } catch (...) {
+        if (!error_) {
+            error_ = std::current_exception();
+        }
+        stop();
+    }
+}
+
+void EventLoop::spawn(Task<void> task) {
+    detail::Detached flow = run_flow(std::move(task));
+    flow.handle.promise().loop = this;
+    flows_.insert(flow.handle.address());
+    schedule(flow.handle);
+}
+
+void EventLoop::call_at(Clock::time_point deadline, std::function<void()> fn) {
+    timers_.push(Timer{deadline, timer_sequence_++, std::move(fn)});
+}
+
+void EventLoop::post(std::function<void()> fn) {
+    {
+        std::lock_guard lock(posted_mutex_);
+        posted_.push_back(std::move(fn));
+    }
+    posted_cv_.notify_one();
+}
+
+size_t EventLoop::add_poller(std::function<bool()> poll) {
+    pollers_.emplace_back(next_poller_, std::move(poll));
+    return next_poller_++;
+}
+
+void EventLoop::remove_poller(size_t id) {
+    for (auto it = pollers_.begin(); it != pollers_.end(); ++it) {
+        if (it->first == id) {
+            pollers_.erase(it);
+            return;
+        }
+    }
+}
+
+bool EventLoop::run_once() {
+    EventLoop* const outer = current_;
+    current_ = this;
+    bool worked = false;
+
+    {
+        std::lock_guard lock(posted_mutex_);
+        draining_.swap(posted_);
+    }
+    for (auto& fn : draining_) {
+        fn();
+    }
+    worked |= !draining_.empty();
+    draining_.clear();
+
+    const Clock::time_point now = Clock::now();
+    while (!timers_.empty() && timers_.top().deadline <= now) {
+        std::function<void()> fn = std::move(const_cast<Timer&>(timers_.top()).fn);
+        timers_.pop();
+        fn();
+        worked = true;
+    }
+
+    for (size_t i = 0; i < pollers_.size(); ++i) {
+        worked |= pollers_[i].second();
+    }
+
+    // Only what was ready on entry, so a flow that keeps yielding cannot
+    // starve posted work, timers or pollers
+    for (size_t count = ready_.size(); count > 0 && !ready_.empty(); --count) {
+        std::coroutine_handle<> handle = ready_.front();
+        ready_.pop_front();
+        handle.resume();
+        worked = true;
+    }
+
+    current_ = outer;
+    return worked;
+}
+
+void EventLoop::run() {
+    stopped_.store(false, std::memory_order_relaxed);
+    while (!flows_.empty() && !stopped_.load(std::memory_order_acquire)) {
+        if (run_once() || !ready_.empty()) {
+            continue;
+        }
+        if (!pollers_.empty()) {
+            std::this_thread::yield();
+            continue;
+        }
+
+        // Idle: sleep until posted work, stop() or the next timer
+        std::unique_lock lock(posted_mutex_);
+        auto woken = [this]() {
+            return !posted_.empty() || stopped_.load(std::memory_order_acquire);
+        };
+        if (timers_.empty()) {
+            posted_cv_.wait(lock, woken);
+        } else {
+            posted_cv_.wait_until(lock, timers_.top().deadline, woken);
+        }
+    }
+
+    if (error_) {
+        std::rethrow_exception(std::exchange(error_, nullptr));
+    }
+}
+
+void EventLoop::stop() {
+    {
+        std::lock_guard lock(posted_mutex_);
+        stopped_.store(true, std::memory_order_release);
+    }
+    posted_cv_.notify_all();
+}
+
+} // namespace lux::async
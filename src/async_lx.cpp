@@ -0,0 +1,201 @@
+// =============================================================================
+// async_lx.cpp - Coroutine Awaitables over an In-Process LX
+// =============================================================================
+
+#include "lux/async_lx.hpp"
+
+namespace lux::async {
+
+AsyncLX::AsyncLX(LX& lx, EventLoop& loop) : lx_(lx), loop_(loop) {
+    poller_ = loop_.add_poller([this]() { return poll(); });
+}
+
+AsyncLX::~AsyncLX() {
+    loop_.remove_poller(poller_);
+    for (auto& [oid, waiter] : waiters_) {
+        waiter->owner = nullptr;
+    }
+}
+
+Task<LXPlaceResult> AsyncLX::place(LXAccount sender, LXOrder order) {
+    watch(order.market_id);
+    co_return lx_.book().place_order(sender, order);
+}
+
+Task<int32_t> AsyncLX::cancel(LXAccount sender, uint32_t market_id, uint64_t oid) {
+    const int32_t result = lx_.book().cancel_order(sender, market_id, oid);
+    recheck(oid);
+    co_return result;
+}
+
+Subscription<Trade> AsyncLX::subscribe_trades(uint32_t market_id) {
+    Market* market = watch(market_id);
+    if (!market) {
+        return nullptr;
+    }
+    auto channel = std::make_shared<Channel<Trade>>(loop_);
+    market->subscribers.push_back(channel);
+    return channel;
+}
+
+Task<std::optional<BookOrderState>> AsyncLX::wait_for_fill(uint32_t market_id, uint64_t oid,
+                                                           I128 min_filled_x18,
+                                                           std::chrono::nanoseconds timeout) {
+    watch(market_id);
+    std::optional<BookOrderState> state = lx_.book().get_order(market_id, oid);
+    if (!state || settled(*state, min_filled_x18)) {
+        co_return state;
+    }
+
+    auto waiter = std::make_shared<Waiter>();
+    waiter->owner = this;
+    waiter->market_id = market_id;
+    waiter->oid = oid;
+    waiter->min_filled_x18 = min_filled_x18;
+    waiter->last_filled_x18 = state->filled_size_x18;
+
+    struct Park {
+        std::shared_ptr<Waiter> waiter;
+        std::chrono::nanoseconds timeout;
+
+        bool await_ready() const noexcept { return false; }
+        void await_suspend(std::coroutine_handle<> handle) const {
+            AsyncLX& self = *waiter->owner;
+            waiter->handle = handle;
+            self.waiters_.emplace(waiter->oid, waiter);
+            if (timeout.count() > 0) {
+                self.loop_.call_later(timeout, [weak = std::weak_ptr<Waiter>(waiter)]() {
+                    auto expired = weak.lock();
+                    if (expired && expired->owner) {
+                        expired->owner->wake(expired);
+                    }
+                });
+            }
+        }
+        void await_resume() const noexcept {}
+    };
+    co_await Park{waiter, timeout};
+    co_return lx_.book().get_order(market_id, oid);
+}
+
+AsyncLX::Market* AsyncLX::watch(uint32_t market_id) {
+    auto it = markets_.find(market_id);
+    if (it != markets_.end()) {
+        return &it->second;
+    }
+    const TradeRing* ring = lx_.book().get_trade_ring(market_id);
+    if (!ring) {
+        return nullptr;
+    }
+    return &markets_.emplace(market_id, Market{ring, ring->next_sequence(), {}}).first->second;
+}
+
+bool AsyncLX::poll() {
+    bool found = false;
+    for (auto& [market_id, market] : markets_) {
+        if (market.ring->first_sequence() > market.next) {
+            // Trades were lost; any waiter on the market may have filled
+            for (auto& [oid, waiter] : waiters_) {
+                if (waiter->market_id == market_id) {
+                    heat(oid);
+                }
+            }
+        }
+        market.next = market.ring->read_since(market.next, [&](uint64_t, const Trade& trade) {
+            found = true;
+            auto& subscribers = market.subscribers;
+            for (auto it = subscribers.begin(); it != subscribers.end();) {
+                if (auto channel = it->lock()) {
+                    channel->push(trade);
+                    ++it;
+                } else {
+                    it = subscribers.erase(it);
+                }
+            }
+            if (!waiters_.empty()) {
+                heat(trade.buy_order_id);
+                heat(trade.sell_order_id);
+            }
+            return true;
+        });
+    }
+
+    size_t kept = 0;
+    for (size_t i = 0; i < hot_.size(); ++i) {
+        std::shared_ptr<Waiter>& waiter = hot_[i];
+        if (waiter->woken) {
+            waiter->hot_turns = 0;
+        } else if (check(*waiter)) {
+            wake(waiter);
+            waiter->hot_turns = 0;
+        } else if (waiter->hot_turns > 0 && --waiter->hot_turns > 0) {
+            if (kept != i) {
+                hot_[kept] = std::move(waiter);
+            }
+            ++kept;
+        }
+    }
+    hot_.resize(kept);
+    return found;
+}
+
+bool AsyncLX::settled(const BookOrderState& state, I128 min_filled_x18) {
+    if (state.status != BookOrderStatus::NEW && state.status != BookOrderStatus::OPEN &&
+        state.status != BookOrderStatus::TRIGGERED) {
+        return true;
+    }
+    return min_filled_x18 > 0 ? state.filled_size_x18 >= min_filled_x18
+                              : state.remaining_size_x18 <= 0;
+}
+
+void AsyncLX::heat(uint64_t oid) {
+    auto [first, last] = waiters_.equal_range(oid);
+    for (auto it = first; it != last; ++it) {
+        if (it->second->hot_turns == 0) {
+            hot_.push_back(it->second);
+        }
+        it->second->hot_turns = HOT_TURNS;
+    }
+}
+
+void AsyncLX::recheck(uint64_t oid) {
+    auto [first, last] = waiters_.equal_range(oid);
+    std::vector<std::shared_ptr<Waiter>> ready;
+    for (auto it = first; it != last; ++it) {
+        if (check(*it->second)) {
+            ready.push_back(it->second);
+        }
+    }
+    for (const auto& waiter : ready) {
+        wake(waiter);
+    }
+}
+
+bool AsyncLX::check(Waiter& waiter) {
+    std::optional<BookOrderState> state = lx_.book().get_order(waiter.market_id, waiter.oid);
+    if (!state || settled(*state, waiter.min_filled_x18)) {
+        return true;
+    }
+    if (state->filled_size_x18 != waiter.last_filled_x18) {
+        waiter.last_filled_x18 = state->filled_size_x18;
+        waiter.hot_turns = 0;  // The update landed; cools unless it trades again
+    }
+    return false;
+}
+
+void AsyncLX::wake(const std::shared_ptr<Waiter>& waiter) {
+    if (waiter->woken) {
+        return;
+    }
+    waiter->woken = true;
+    auto [first, last] = waiters_.equal_range(waiter->oid);
+    for (auto it = first; it != last; ++it) {
+        if (it->second == waiter) {
+            waiters_.erase(it);
+            break;
+        }
+    }
+    loop_.schedule(waiter->handle);
+}
+
+} // namespace lux::async
@@ -3,9 +3,13 @@
 // =============================================================================
 
 #include "lux/book.hpp"
+#include "lux/tracing.hpp"
 #include <chrono>
 #include <algorithm>
+#include <cstddef>
+#include <cstdint>
 #include <cstring>
+#include <type_traits>
 
 namespace lux {
 
@@ -14,7 +18,7 @@ namespace lux {
 // =============================================================================
 
 void LXBook::BookTradeListener::on_trade(const Trade& trade) {
-    book_->record_trade(static_cast<uint32_t>(trade.symbol_id), trade);
+    book_->record_trade(trade);
 
     // Call settlement callback if set
     if (book_->settlement_callback_) {
@@ -23,45 +27,76 @@ void LXBook::BookTradeListener::on_trade(const Trade& trade) {
     }
 }
 
-void LXBook::BookTradeListener::on_order_filled(const Order& order) {
-    book_->update_order_state(
-        LXAccount{{}, 0}, // Would need proper account tracking
-        order.id,
-        [](BookOrderState& state) {
-            state.status = BookOrderStatus::FILLED;
-            state.remaining_size_x18 = 0;
+// An auction uncross settles as one batch
+void LXBook::BookTradeListener::on_trade_batch(const Trade* trades, size_t count) {
+    for (size_t i = 0; i < count; ++i) {
+        book_->record_trade(trades[i]);
+    }
+    if (book_->settlement_callback_ && count > 0) {
+        std::vector<Trade> batch(trades, trades + count);
+        book_->settlement_callback_(batch);
+    }
+}
+
+// Engine orders carry the placing account's hash, so fills go straight to
+// that account's shard
+template<typename Updater>
+bool LXBook::update_order_state(uint64_t account_hash, uint64_t oid, Updater&& updater) {
+    OrderIndexShard& shard = account_shard(account_hash);
+    std::unique_lock lock(shard.mutex);
+
+    auto account_it = shard.accounts.find(account_hash);
+    if (account_it == shard.accounts.end()) {
+        return false;
+    }
+    AccountOrders& account = account_it->second;
+    auto order_it = account.orders.find(oid);
+    if (order_it == account.orders.end()) {
+        return false;
+    }
+
+    BookOrderState& state = order_it->second;
+    updater(state);
+    if (state.status == BookOrderStatus::FILLED ||
+        state.status == BookOrderStatus::CANCELLED ||
+        state.status == BookOrderStatus::REJECTED) {
+        auto market_it = account.by_market.find(state.market_id);
+        if (market_it != account.by_market.end()) {
+            market_it->second.open.erase(oid);
         }
-    );
+    }
+    return true;
+}
+
+void LXBook::BookTradeListener::on_order_filled(const Order& order) {
+    book_->total_orders_filled_.add();
+    book_->update_order_state(order.account_id, order.id, [](BookOrderState& state) {
+        state.status = BookOrderStatus::FILLED;
+        state.filled_size_x18 += state.remaining_size_x18;  // The closing fill
+        state.remaining_size_x18 = 0;
+    });
 }
 
 void LXBook::BookTradeListener::on_order_partially_filled(const Order& order, Quantity fill_qty) {
-    book_->update_order_state(
-        LXAccount{{}, 0},
-        order.id,
-        [fill_qty](BookOrderState& state) {
-            // Convert fill_qty to X18
-            I128 fill_x18 = static_cast<I128>(fill_qty) * X18_ONE / 100000000LL; // From 1e8 to 1e18
-            state.filled_size_x18 += fill_x18;
-            state.remaining_size_x18 -= fill_x18;
-        }
-    );
+    book_->update_order_state(order.account_id, order.id, [fill_qty](BookOrderState& state) {
+        // Convert fill_qty to X18
+        I128 fill_x18 = static_cast<I128>(fill_qty) * X18_ONE / 100000000LL; // From 1e8 to 1e18
+        state.filled_size_x18 += fill_x18;
+        state.remaining_size_x18 -= fill_x18;
+    });
 }
 
 void LXBook::BookTradeListener::on_order_cancelled(const Order& order) {
-    book_->update_order_state(
-        LXAccount{{}, 0},
-        order.id,
-        [](BookOrderState& state) {
-            state.status = BookOrderStatus::CANCELLED;
-        }
-    );
+    book_->update_order_state(order.account_id, order.id, [](BookOrderState& state) {
+        state.status = BookOrderStatus::CANCELLED;
+    });
 }
 
 // =============================================================================
 // Constructor
 // =============================================================================
 
-LXBook::LXBook() : engine_(EngineConfig{}) {
+LXBook::LXBook(EngineConfig config) : engine_(std::move(config)) {
     trade_listener_ = std::make_unique<BookTradeListener>(this);
     engine_.set_trade_listener(trade_listener_.get());
 }
@@ -71,6 +106,10 @@ LXBook::LXBook() : engine_(EngineConfig{}) {
 // =============================================================================
 
 int32_t LXBook::create_market(const BookMarketConfig& config) {
+    return create_market(config, &Engine::make_book<GenericBookPolicy>);
+}
+
+int32_t LXBook::create_market(const BookMarketConfig& config, Engine::BookFactory factory) {
     std::unique_lock lock(markets_mutex_);
 
     if (markets_.find(config.market_id) != markets_.end()) {
@@ -78,12 +117,15 @@ int32_t LXBook::create_market(const BookMarketConfig& config) {
     }
 
     // Add symbol to engine
-    if (!engine_.add_symbol(config.symbol_id)) {
+    if (!engine_.add_symbol(config.symbol_id, engine_.config().default_book, factory)) {
         return errors::POOL_ALREADY_INITIALIZED;
     }
 
     markets_[config.market_id] = config;
     market_to_symbol_[config.market_id] = config.symbol_id;
+    add_trade_ring(config.symbol_id);
+    trigger_books_[config.market_id] = std::make_unique<TriggerBook>();
+    publish_market(config.market_id);
 
     return errors::OK;
 }
@@ -97,6 +139,7 @@ int32_t LXBook::update_market_config(const BookMarketConfig& config) {
     }
 
     it->second = config;
+    publish_market(config.market_id);
     return errors::OK;
 }
 
@@ -119,34 +162,43 @@ bool LXBook::market_exists(uint32_t market_id) const {
     return markets_.find(market_id) != markets_.end();
 }
 
+MarketHandle LXBook::resolve_market(uint32_t market_id) const {
+    return market_directory_.find(market_id);
+}
+
+bool LXBook::refresh_market(MarketHandle& market) const {
+    if (!market || !market->superseded.load(std::memory_order_acquire)) {
+        return false;
+    }
+    market = resolve_market(market->config.market_id);
+    return true;
+}
+
+void LXBook::publish_market(uint32_t market_id) {
+    auto descriptor = std::make_unique<MarketDescriptor>();
+    descriptor->config = markets_.at(market_id);
+    // Routing stays on the symbol the market was created with
+    descriptor->config.symbol_id = market_to_symbol_.at(market_id);
+    descriptor->symbol = engine_.resolve_symbol(descriptor->config.symbol_id);
+    descriptor->triggers = trigger_books_.at(market_id).get();
+
+    MarketDescriptor* current = market_directory_.find(market_id);
+    descriptor->version = current ? current->version + 1 : 1;
+    if (current) {
+        market_directory_.replace(market_id, descriptor.get());
+        current->superseded.store(true, std::memory_order_release);
+    } else {
+        market_directory_.insert(market_id, descriptor.get());
+    }
+    market_descriptors_.push_back(std::move(descriptor));
+}
+
 // =============================================================================
 // Execute Interface
 // =============================================================================
 
 ExecuteResult LXBook::execute(const LXAccount& sender, const LXAction& action) {
-    ExecuteResult result;
-    result.error_code = errors::OK;
-
-    switch (action.action_type) {
-        case ActionType::PLACE:
-            result = handle_place(sender, action.data);
-            break;
-        case ActionType::CANCEL:
-            result = handle_cancel(sender, action.data);
-            break;
-        case ActionType::CANCEL_BY_CLOID:
-            result = handle_cancel_by_cloid(sender, action.data);
-            break;
-        case ActionType::MODIFY:
-            result = handle_modify(sender, action.data);
-            break;
-        case ActionType::NOOP:
-            break;
-        default:
-            result.error_code = errors::UNAUTHORIZED;
-    }
-
-    return result;
+    return execute_action(sender, action.action_type, action.data.data(), action.data.size());
 }
 
 std::vector<ExecuteResult> LXBook::execute_batch(const LXAccount& sender,
@@ -166,40 +218,144 @@ std::vector<ExecuteResult> LXBook::execute_batch(const LXAccount& sender,
 // =============================================================================
 
 LXPlaceResult LXBook::place_order(const LXAccount& sender, const LXOrder& order) {
-    LXPlaceResult result{};
+    if (TriggerBook::is_trigger_kind(order.kind)) {
+        return place_trigger_order(sender, order, PriceType::LAST);
+    }
+    return place_order(sender, order, resolve_market(order.market_id));
+}
 
-    uint64_t symbol_id = get_symbol_id(order.market_id);
-    if (symbol_id == 0) {
-        result.status = static_cast<uint8_t>(BookOrderStatus::REJECTED);
-        return result;
+LXPlaceResult LXBook::place_order(const LXAccount& sender, const LXOrder& order,
+                                  MarketHandle market) {
+    if (TriggerBook::is_trigger_kind(order.kind)) {
+        return place_trigger_order(sender, order, PriceType::LAST);
     }
 
-    // Check market status
-    std::shared_lock lock(markets_mutex_);
-    auto market_it = markets_.find(order.market_id);
-    if (market_it == markets_.end()) {
+    refresh_market(market);
+    if (!market || market->config.market_id != order.market_id || !market->accepts(order.kind)) {
+        LXPlaceResult result{};
         result.status = static_cast<uint8_t>(BookOrderStatus::REJECTED);
         return result;
     }
 
-    const BookMarketConfig& config = market_it->second;
-    if (config.status == 0) { // Inactive
-        result.status = static_cast<uint8_t>(BookOrderStatus::REJECTED);
-        return result;
+    return execute_order(sender, order, *market, 0);
+}
+
+void LXBook::place_orders(const LXAccount* senders, const LXOrder* orders, size_t count,
+                          LXPlaceResult* results) {
+    MarketHandle market = nullptr;
+    for (size_t i = 0; i < count; ++i) {
+        const LXOrder& order = orders[i];
+        if (!market || order.market_id != market->config.market_id) {
+            market = resolve_market(order.market_id);
+        }
+        results[i] = place_order(senders[i], order, market);
     }
-    if (config.status == 2 && order.kind != OrderKind::LIMIT) { // Cancel-only
+}
+
+LXPlaceResult LXBook::place_trigger_order(const LXAccount& sender, const LXOrder& order,
+                                          PriceType price_type) {
+    LXPlaceResult result{};
+
+    MarketHandle market = resolve_market(order.market_id);
+    if (!market || !market->accepts(order.kind) || !TriggerBook::is_trigger_kind(order.kind)) {
         result.status = static_cast<uint8_t>(BookOrderStatus::REJECTED);
         return result;
     }
-    lock.unlock();
+
+    result.oid = OrderIdGenerator::instance().next();
+    result.status = static_cast<uint8_t>(BookOrderStatus::NEW);
+
+    BookOrderState state{};
+    state.oid = result.oid;
+    state.cloid = order.cloid;
+    state.market_id = order.market_id;
+    state.is_buy = order.is_buy;
+    state.kind = order.kind;
+    state.tif = order.tif;
+    state.original_size_x18 = order.size_x18;
+    state.remaining_size_x18 = order.size_x18;
+    state.limit_price_x18 = order.limit_px_x18;
+    state.trigger_price_x18 = order.trigger_px_x18;
+    state.status = BookOrderStatus::NEW;
+    state.created_at = static_cast<uint64_t>(
+        std::chrono::duration_cast<std::chrono::nanoseconds>(
+            std::chrono::system_clock::now().time_since_epoch()
+        ).count()
+    );
+    state.updated_at = state.created_at;
+    state.flags = order.reduce_only ? fill_flags::REDUCE_ONLY : 0;
+    index_order(sender.hash(), state);
+    total_orders_placed_.add();
+
+    // Already through the trigger: execute now rather than rest
+    if (!market->triggers->add(TriggerOrder{result.oid, sender, order, price_type})) {
+        update_order_state(sender.hash(), result.oid, [](BookOrderState& s) {
+            s.status = BookOrderStatus::TRIGGERED;
+        });
+        return execute_order(sender, TriggerBook::fired_order(order), *market, result.oid);
+    }
+
+    return result;
+}
+
+size_t LXBook::on_price(uint32_t market_id, PriceType type, I128 price_x18) {
+    TriggerBook* triggers = get_trigger_book(market_id);
+    if (!triggers) {
+        return 0;
+    }
+    if (MarketDataPublisher* market_data = engine_.market_data()) {
+        market_data->on_price(get_symbol_id(market_id), type, price_x18);
+    }
+
+    // Fired orders can trade and feed prices back in; nested calls append
+    // after this call's range and trim back to their own start
+    thread_local std::vector<TriggerOrder> fired;
+    const size_t first = fired.size();
+    const size_t count = triggers->on_price(type, price_x18, fired);
+    if (count == 0) {
+        return 0;
+    }
+
+    MarketHandle market = resolve_market(market_id);
+    for (size_t i = first; i < first + count; ++i) {
+        const TriggerOrder trigger = fired[i];
+        update_order_state(trigger.account.hash(), trigger.oid, [](BookOrderState& state) {
+            state.status = BookOrderStatus::TRIGGERED;
+        });
+        refresh_market(market);
+        execute_order(trigger.account, TriggerBook::fired_order(trigger.order),
+                      *market, trigger.oid);
+    }
+    fired.resize(first);
+
+    return count;
+}
+
+size_t LXBook::pending_trigger_count(uint32_t market_id) const {
+    const TriggerBook* triggers = get_trigger_book(market_id);
+    return triggers ? triggers->size() : 0;
+}
+
+LXPlaceResult LXBook::execute_order(const LXAccount& sender, const LXOrder& order,
+                                    const MarketDescriptor& market, uint64_t triggered_oid) {
+    TraceSpan span(TracePoint::OrderIngress);
+    LXPlaceResult result{};
+
+    // Settlement resolves the fills' account ids while matching runs
+    remember_account(sender);
 
     // Convert to internal order format
-    Order internal_order = convert_to_internal(order, symbol_id, sender);
+    Order internal_order = convert_to_internal(order, market.config.symbol_id, sender, triggered_oid);
 
-    // Place order on engine
-    OrderResult engine_result = engine_.place_order(internal_order);
+    // Place order on engine, collecting fills in a reused per-thread buffer.
+    // Only [first_fill, end) belongs to this call; nested calls from listener
+    // callbacks append after it and trim back to their own start.
+    thread_local std::vector<Trade> fills;
+    const size_t first_fill = fills.size();
+    OrderResult engine_result = engine_.place_order(market.symbol, internal_order, fills);
 
     result.oid = engine_result.order_id;
+    span.set_id(result.oid);
     result.status = engine_result.success ?
         static_cast<uint8_t>(BookOrderStatus::NEW) :
         static_cast<uint8_t>(BookOrderStatus::REJECTED);
@@ -207,23 +363,48 @@ LXPlaceResult LXBook::place_order(const LXAccount& sender, const LXOrder& order)
     // Calculate fills
     I128 total_fill_size = 0;
     I128 total_fill_value = 0;
-    for (const auto& trade : engine_result.trades) {
-        I128 trade_size = static_cast<I128>(trade.quantity) * X18_ONE / 100000000LL;
-        I128 trade_price = static_cast<I128>(trade.price) * X18_ONE / 100000000LL;
+    for (size_t i = first_fill; i < fills.size(); ++i) {
+        I128 trade_size = static_cast<I128>(fills[i].quantity) * X18_ONE / 100000000LL;
+        I128 trade_price = static_cast<I128>(fills[i].price) * X18_ONE / 100000000LL;
         total_fill_size += trade_size;
         total_fill_value += x18::mul(trade_size, trade_price);
     }
+    fills.resize(first_fill);
 
     result.filled_size_x18 = total_fill_size;
     if (total_fill_size > 0) {
         result.avg_px_x18 = x18::div(total_fill_value, total_fill_size);
     }
 
+    // A fired trigger order already has its state; bring it up to date.
+    // Listener callbacks may have touched it during matching, so sizes are
+    // assigned from this call's fills and a cancel (IOC) is kept.
+    if (triggered_oid != 0) {
+        const I128 filled = result.filled_size_x18;
+        const I128 avg_px = result.avg_px_x18;
+        const bool success = engine_result.success;
+        update_order_state(sender.hash(), triggered_oid, [&](BookOrderState& state) {
+            state.filled_size_x18 = filled;
+            state.remaining_size_x18 = state.original_size_x18 - filled;
+            state.avg_fill_price_x18 = avg_px;
+            if (!success) {
+                state.status = BookOrderStatus::REJECTED;
+            } else if (state.remaining_size_x18 == 0) {
+                state.status = BookOrderStatus::FILLED;
+            } else if (state.status != BookOrderStatus::CANCELLED) {
+                state.status = BookOrderStatus::OPEN;
+            }
+            state.updated_at = static_cast<uint64_t>(
+                std::chrono::duration_cast<std::chrono::nanoseconds>(
+                    std::chrono::system_clock::now().time_since_epoch()
+                ).count()
+            );
+        });
+        return result;
+    }
+
     // Track order state
     if (engine_result.success) {
-        std::unique_lock orders_lock(orders_mutex_);
-        auto& account_orders = account_orders_[sender.hash()];
-
         BookOrderState state;
         state.oid = result.oid;
         state.cloid = order.cloid;
@@ -247,11 +428,10 @@ LXPlaceResult LXBook::place_order(const LXAccount& sender, const LXOrder& order)
         state.updated_at = state.created_at;
         state.flags = order.reduce_only ? fill_flags::REDUCE_ONLY : 0;
 
-        account_orders.orders[result.oid] = state;
-        account_orders.cloid_to_oid[order.cloid] = result.oid;
+        index_order(sender.hash(), state);
     }
 
-    total_orders_placed_.fetch_add(1, std::memory_order_relaxed);
+    total_orders_placed_.add();
 
     return result;
 }
@@ -262,13 +442,23 @@ int32_t LXBook::cancel_order(const LXAccount& sender, uint32_t market_id, uint64
         return errors::MARKET_NOT_FOUND;
     }
 
+    // Not yet fired: it only lives in the trigger book
+    if (TriggerBook* triggers = get_trigger_book(market_id)) {
+        if (auto trigger = triggers->cancel(oid)) {
+            update_order_state(trigger->account.hash(), oid, [](BookOrderState& state) {
+                state.status = BookOrderStatus::CANCELLED;
+            });
+            return errors::OK;
+        }
+    }
+
     CancelResult result = engine_.cancel_order(symbol_id, oid);
     if (!result.success) {
         return errors::ORDER_NOT_FOUND;
     }
 
     // Update order state
-    update_order_state(sender, oid, [](BookOrderState& state) {
+    update_order_state(sender.hash(), oid, [](BookOrderState& state) {
         state.status = BookOrderStatus::CANCELLED;
     });
 
@@ -277,9 +467,10 @@ int32_t LXBook::cancel_order(const LXAccount& sender, uint32_t market_id, uint64
 
 int32_t LXBook::cancel_by_cloid(const LXAccount& sender, uint32_t market_id,
                                  const std::array<uint8_t, 16>& cloid) {
-    std::shared_lock lock(orders_mutex_);
-    auto account_it = account_orders_.find(sender.hash());
-    if (account_it == account_orders_.end()) {
+    const OrderIndexShard& shard = account_shard(sender.hash());
+    std::shared_lock lock(shard.mutex);
+    auto account_it = shard.accounts.find(sender.hash());
+    if (account_it == shard.accounts.end()) {
         return errors::ORDER_NOT_FOUND;
     }
 
@@ -295,19 +486,19 @@ int32_t LXBook::cancel_by_cloid(const LXAccount& sender, uint32_t market_id,
 }
 
 int32_t LXBook::cancel_all(const LXAccount& sender, uint32_t market_id) {
-    std::shared_lock lock(orders_mutex_);
-    auto account_it = account_orders_.find(sender.hash());
-    if (account_it == account_orders_.end()) {
+    const OrderIndexShard& shard = account_shard(sender.hash());
+    std::shared_lock lock(shard.mutex);
+    auto account_it = shard.accounts.find(sender.hash());
+    if (account_it == shard.accounts.end()) {
         return errors::OK; // No orders to cancel
     }
-
-    std::vector<uint64_t> oids_to_cancel;
-    for (const auto& [oid, state] : account_it->second.orders) {
-        if (state.market_id == market_id &&
-            (state.status == BookOrderStatus::OPEN || state.status == BookOrderStatus::NEW)) {
-            oids_to_cancel.push_back(oid);
-        }
+    auto market_it = account_it->second.by_market.find(market_id);
+    if (market_it == account_it->second.by_market.end()) {
+        return errors::OK;
     }
+
+    std::vector<uint64_t> oids_to_cancel(market_it->second.open.begin(),
+                                         market_it->second.open.end());
     lock.unlock();
 
     for (uint64_t oid : oids_to_cancel) {
@@ -342,7 +533,7 @@ LXPlaceResult LXBook::amend_order(const LXAccount& sender, uint32_t market_id,
     result.status = static_cast<uint8_t>(BookOrderStatus::OPEN);
 
     // Update order state
-    update_order_state(sender, oid, [new_size_x18, new_price_x18](BookOrderState& state) {
+    update_order_state(sender.hash(), oid, [new_size_x18, new_price_x18](BookOrderState& state) {
         state.remaining_size_x18 = new_size_x18;
         state.limit_price_x18 = new_price_x18;
         state.updated_at = static_cast<uint64_t>(
@@ -355,18 +546,149 @@ LXPlaceResult LXBook::amend_order(const LXAccount& sender, uint32_t market_id,
     return result;
 }
 
+LXMassQuoteResult LXBook::mass_quote(const LXAccount& sender, uint32_t market_id,
+                                     const LXQuote* quotes, size_t count) {
+    LXMassQuoteResult result{};
+
+    LXOrder limit{};
+    limit.market_id = market_id;
+    limit.kind = OrderKind::LIMIT;
+    const uint64_t symbol_id = check_market(limit);
+    if (symbol_id == 0) {
+        result.error_code = errors::MARKET_NOT_FOUND;
+        return result;
+    }
+
+    const uint64_t account_hash = sender.hash();
+    remember_account(sender);
+    const uint64_t now = static_cast<uint64_t>(
+        std::chrono::duration_cast<std::chrono::nanoseconds>(
+            std::chrono::system_clock::now().time_since_epoch()
+        ).count()
+    );
+
+    // The ladder being replaced: open orders placed by earlier mass quotes
+    thread_local std::vector<uint64_t> resting;
+    resting.clear();
+    {
+        const OrderIndexShard& shard = account_shard(account_hash);
+        std::shared_lock lock(shard.mutex);
+        auto account_it = shard.accounts.find(account_hash);
+        if (account_it != shard.accounts.end()) {
+            const AccountOrders& account = account_it->second;
+            auto market_it = account.by_market.find(market_id);
+            if (market_it != account.by_market.end()) {
+                for (uint64_t oid : market_it->second.open) {
+                    auto order_it = account.orders.find(oid);
+                    if (order_it != account.orders.end() &&
+                        (order_it->second.flags & fill_flags::QUOTE)) {
+                        resting.push_back(oid);
+                    }
+                }
+            }
+        }
+    }
+
+    // Levels get an oid up front; it is only used if the level is placed
+    thread_local std::vector<QuoteLevel> levels;
+    levels.resize(count);
+    for (size_t i = 0; i < count; ++i) {
+        levels[i].side = quotes[i].is_buy ? Side::Buy : Side::Sell;
+        levels[i].price = static_cast<Price>(x18::to_double(quotes[i].px_x18) * 100000000.0);
+        levels[i].quantity = static_cast<Quantity>(x18::to_double(quotes[i].sz_x18) * 100000000.0);
+        levels[i].order_id = OrderIdGenerator::instance().next();
+    }
+
+    MassQuoteRequest request{};
+    request.prototype.symbol_id = symbol_id;
+    request.prototype.account_id = account_hash;
+    request.prototype.type = OrderType::Limit;
+    request.prototype.tif = TimeInForce::GTC;
+    request.prototype.status = OrderStatus::New;
+    request.prototype.stp_group = 0;
+    request.prototype.timestamp = std::chrono::duration_cast<Timestamp>(
+        std::chrono::system_clock::now().time_since_epoch()
+    );
+    request.resting = resting.data();
+    request.resting_count = resting.size();
+    request.levels = levels.data();
+    request.level_count = count;
+
+    thread_local std::vector<QuoteOutcome> outcomes;
+    thread_local std::vector<Trade> fills;
+    outcomes.resize(count);
+    fills.clear();
+    auto summary = engine_.mass_quote(symbol_id, request, outcomes.data(), fills);
+    if (!summary) {
+        result.error_code = errors::MARKET_NOT_FOUND;
+        return result;
+    }
+
+    result.kept = summary->kept;
+    result.reduced = summary->reduced;
+    result.requeued = summary->requeued;
+    result.placed = summary->placed;
+    result.cancelled = summary->cancelled;
+    result.rejected = summary->rejected;
+    for (const Trade& fill : fills) {
+        result.filled_size_x18 += static_cast<I128>(fill.quantity) * X18_ONE / 100000000LL;
+    }
+
+    // Cancelled quotes were updated through the trade listener; bring the
+    // resized ones up to date and index the new ones
+    for (size_t i = 0; i < count; ++i) {
+        const QuoteOutcome& outcome = outcomes[i];
+        const I128 size_x18 = quotes[i].sz_x18;
+        if (outcome.action == QuoteAction::Reduced || outcome.action == QuoteAction::Requeued) {
+            update_order_state(account_hash, outcome.order_id, [size_x18, now](BookOrderState& state) {
+                state.remaining_size_x18 = size_x18;
+                state.original_size_x18 = state.filled_size_x18 + size_x18;
+                state.updated_at = now;
+            });
+        } else if (outcome.action == QuoteAction::Placed) {
+            BookOrderState state{};
+            state.oid = outcome.order_id;
+            state.market_id = market_id;
+            state.is_buy = quotes[i].is_buy;
+            state.kind = OrderKind::LIMIT;
+            state.tif = TIF::GTC;
+            state.original_size_x18 = size_x18;
+            state.filled_size_x18 = static_cast<I128>(outcome.filled) * X18_ONE / 100000000LL;
+            state.remaining_size_x18 = outcome.filled < outcome.quantity ?
+                size_x18 - state.filled_size_x18 : 0;
+            state.limit_price_x18 = quotes[i].px_x18;
+            state.status = state.remaining_size_x18 == 0 ?
+                BookOrderStatus::FILLED : BookOrderStatus::OPEN;
+            state.created_at = now;
+            state.updated_at = now;
+            state.flags = fill_flags::QUOTE;
+            index_order(account_hash, state);
+            total_orders_placed_.add();
+        }
+    }
+
+    return result;
+}
+
 // =============================================================================
 // Order Queries
 // =============================================================================
 
 std::optional<BookOrderState> LXBook::get_order(uint32_t market_id, uint64_t oid) const {
-    std::shared_lock lock(orders_mutex_);
+    auto account_hash = account_of(oid);
+    if (!account_hash) {
+        return std::nullopt;
+    }
 
-    for (const auto& [account_hash, account_orders] : account_orders_) {
-        auto it = account_orders.orders.find(oid);
-        if (it != account_orders.orders.end() && it->second.market_id == market_id) {
-            return it->second;
-        }
+    const OrderIndexShard& shard = account_shard(*account_hash);
+    std::shared_lock lock(shard.mutex);
+    auto account_it = shard.accounts.find(*account_hash);
+    if (account_it == shard.accounts.end()) {
+        return std::nullopt;
+    }
+    auto it = account_it->second.orders.find(oid);
+    if (it != account_it->second.orders.end() && it->second.market_id == market_id) {
+        return it->second;
     }
 
     return std::nullopt;
@@ -374,15 +696,17 @@ std::optional<BookOrderState> LXBook::get_order(uint32_t market_id, uint64_t oid
 
 std::optional<BookOrderState> LXBook::get_order_by_cloid(uint32_t market_id,
                                                           const std::array<uint8_t, 16>& cloid) const {
-    std::shared_lock lock(orders_mutex_);
-
-    for (const auto& [account_hash, account_orders] : account_orders_) {
-        auto cloid_it = account_orders.cloid_to_oid.find(cloid);
-        if (cloid_it != account_orders.cloid_to_oid.end()) {
-            auto order_it = account_orders.orders.find(cloid_it->second);
-            if (order_it != account_orders.orders.end() &&
-                order_it->second.market_id == market_id) {
-                return order_it->second;
+    // Cloids are only unique per account, so every shard has to be asked
+    for (const OrderIndexShard& shard : order_index_) {
+        std::shared_lock lock(shard.mutex);
+        for (const auto& [account_hash, account_orders] : shard.accounts) {
+            auto cloid_it = account_orders.cloid_to_oid.find(cloid);
+            if (cloid_it != account_orders.cloid_to_oid.end()) {
+                auto order_it = account_orders.orders.find(cloid_it->second);
+                if (order_it != account_orders.orders.end() &&
+                    order_it->second.market_id == market_id) {
+                    return order_it->second;
+                }
             }
         }
     }
@@ -392,36 +716,66 @@ std::optional<BookOrderState> LXBook::get_order_by_cloid(uint32_t market_id,
 
 std::vector<BookOrderState> LXBook::get_orders(const LXAccount& account, uint32_t market_id) const {
     std::vector<BookOrderState> orders;
+    get_orders(account, market_id, orders);
+    return orders;
+}
+
+std::vector<BookOrderState> LXBook::get_all_orders(const LXAccount& account) const {
+    std::vector<BookOrderState> orders;
+    get_all_orders(account, orders);
+    return orders;
+}
 
-    std::shared_lock lock(orders_mutex_);
-    auto account_it = account_orders_.find(account.hash());
-    if (account_it == account_orders_.end()) {
-        return orders;
+size_t LXBook::get_orders(const LXAccount& account, uint32_t market_id,
+                          std::vector<BookOrderState>& out) const {
+    out.clear();
+
+    const OrderIndexShard& shard = account_shard(account.hash());
+    std::shared_lock lock(shard.mutex);
+    auto account_it = shard.accounts.find(account.hash());
+    if (account_it == shard.accounts.end()) {
+        return 0;
+    }
+    auto market_it = account_it->second.by_market.find(market_id);
+    if (market_it == account_it->second.by_market.end()) {
+        return 0;
     }
 
-    for (const auto& [oid, state] : account_it->second.orders) {
-        if (state.market_id == market_id) {
-            orders.push_back(state);
+    out.reserve(market_it->second.all.size());
+    for (uint64_t oid : market_it->second.all) {
+        auto it = account_it->second.orders.find(oid);
+        if (it != account_it->second.orders.end()) {
+            out.push_back(it->second);
         }
     }
 
-    return orders;
+    return out.size();
 }
 
-std::vector<BookOrderState> LXBook::get_all_orders(const LXAccount& account) const {
-    std::vector<BookOrderState> orders;
+size_t LXBook::get_all_orders(const LXAccount& account, std::vector<BookOrderState>& out) const {
+    out.clear();
 
-    std::shared_lock lock(orders_mutex_);
-    auto account_it = account_orders_.find(account.hash());
-    if (account_it == account_orders_.end()) {
-        return orders;
+    const OrderIndexShard& shard = account_shard(account.hash());
+    std::shared_lock lock(shard.mutex);
+    auto account_it = shard.accounts.find(account.hash());
+    if (account_it == shard.accounts.end()) {
+        return 0;
     }
 
+    out.reserve(account_it->second.orders.size());
     for (const auto& [oid, state] : account_it->second.orders) {
-        orders.push_back(state);
+        out.push_back(state);
     }
 
-    return orders;
+    return out.size();
+}
+
+std::optional<LXAccount> LXBook::get_account(uint64_t account_hash) const {
+    const OrderIndexShard& shard = account_shard(account_hash);
+    std::shared_lock lock(shard.mutex);
+    auto it = shard.owners.find(account_hash);
+    if (it == shard.owners.end()) return std::nullopt;
+    return it->second;
 }
 
 // =============================================================================
@@ -434,21 +788,22 @@ LXL1 LXBook::get_l1(uint32_t market_id) const {
     uint64_t symbol_id = get_symbol_id(market_id);
     if (symbol_id == 0) return l1;
 
-    auto best_bid = engine_.best_bid(symbol_id);
-    auto best_ask = engine_.best_ask(symbol_id);
-
-    if (best_bid) {
-        l1.best_bid_px_x18 = static_cast<I128>(*best_bid) * X18_ONE / 100000000LL;
-    }
-    if (best_ask) {
-        l1.best_ask_px_x18 = static_cast<I128>(*best_ask) * X18_ONE / 100000000LL;
+    // Lock-free top of book
+    if (const OrderBook* book = engine_.get_orderbook(symbol_id)) {
+        L1Snapshot top = book->top_of_book();
+        if (top.has_bid()) {
+            l1.best_bid_px_x18 = static_cast<I128>(top.bid_price) * X18_ONE / 100000000LL;
+            l1.best_bid_sz_x18 = static_cast<I128>(top.bid_quantity) * X18_ONE / 100000000LL;
+        }
+        if (top.has_ask()) {
+            l1.best_ask_px_x18 = static_cast<I128>(top.ask_price) * X18_ONE / 100000000LL;
+            l1.best_ask_sz_x18 = static_cast<I128>(top.ask_quantity) * X18_ONE / 100000000LL;
+        }
     }
 
     // Get last trade
-    std::shared_lock lock(trades_mutex_);
-    auto last_it = last_trades_.find(market_id);
-    if (last_it != last_trades_.end()) {
-        l1.last_trade_px_x18 = static_cast<I128>(last_it->second.price) * X18_ONE / 100000000LL;
+    if (auto last = get_last_trade(market_id)) {
+        l1.last_trade_px_x18 = static_cast<I128>(last->price) * X18_ONE / 100000000LL;
     }
 
     return l1;
@@ -461,41 +816,73 @@ MarketDepth LXBook::get_depth(uint32_t market_id, size_t levels) const {
     return engine_.get_depth(symbol_id, levels);
 }
 
+L2Snapshot LXBook::get_l2_snapshot(uint32_t market_id, size_t levels) const {
+    L2Snapshot snapshot;
+    get_l2_snapshot(market_id, levels, snapshot);
+    return snapshot;
+}
+
+bool LXBook::get_l2_snapshot(uint32_t market_id, size_t levels, L2Snapshot& out) const {
+    return engine_.get_l2_snapshot(get_symbol_id(market_id), levels, out);
+}
+
 std::optional<Trade> LXBook::get_last_trade(uint32_t market_id) const {
-    std::shared_lock lock(trades_mutex_);
-    auto it = last_trades_.find(market_id);
-    if (it == last_trades_.end()) return std::nullopt;
-    return it->second;
+    const TradeRing* ring = get_trade_ring(market_id);
+    if (!ring) return std::nullopt;
+    return ring->last();
 }
 
 std::vector<Trade> LXBook::get_recent_trades(uint32_t market_id, size_t count) const {
-    std::shared_lock lock(trades_mutex_);
-    auto it = recent_trades_.find(market_id);
-    if (it == recent_trades_.end()) return {};
+    const TradeRing* ring = get_trade_ring(market_id);
+    if (!ring || count == 0) return {};
 
-    const auto& trades = it->second;
-    if (trades.size() <= count) {
-        return trades;
-    }
+    const uint64_t next = ring->next_sequence();
+    const uint64_t since = next > count ? next - count : 0;
 
-    return std::vector<Trade>(trades.end() - count, trades.end());
+    std::vector<Trade> trades;
+    trades.reserve(std::min<uint64_t>(next - since, ring->capacity()));
+    ring->read_since(since, [&trades](uint64_t, const Trade& trade) {
+        trades.push_back(trade);
+        return true;
+    });
+    return trades;
+}
+
+const TradeRing* LXBook::get_trade_ring(uint32_t market_id) const {
+    uint64_t symbol_id = get_symbol_id(market_id);
+    if (symbol_id == 0) return nullptr;
+    return trade_rings_by_symbol_.find(symbol_id);
 }
 
 // =============================================================================
 // HFT Interface
 // =============================================================================
 
-std::vector<uint8_t> LXBook::execute_packed(const std::vector<uint8_t>& packed_data) {
-    if (packed_data.size() < sizeof(packed::PackedPlaceOrder)) {
-        return {};
-    }
+namespace {
 
-    // Determine action type from first byte pattern
-    // For now, assume PlaceOrder
-    packed::PackedPlaceOrder packed;
-    std::memcpy(&packed, packed_data.data(), sizeof(packed));
+// Payload bytes following the action type byte, or SIZE_MAX if the action
+// has no packed form. Variable-length payloads are sized from their
+// header, which must lie within the `available` bytes at `payload`.
+size_t packed_payload_size(ActionType type, const uint8_t* payload, size_t available) {
+    switch (type) {
+        case ActionType::MASS_QUOTE: {
+            if (available < sizeof(packed::PackedMassQuoteHeader)) {
+                return SIZE_MAX;
+            }
+            const uint8_t count = payload[offsetof(packed::PackedMassQuoteHeader, count)];
+            return sizeof(packed::PackedMassQuoteHeader) + count * sizeof(packed::PackedQuoteLevel);
+        }
+        case ActionType::PLACE:           return sizeof(packed::PackedPlaceOrder);
+        case ActionType::CANCEL:          return sizeof(packed::PackedCancelOrder);
+        case ActionType::CANCEL_BY_CLOID: return sizeof(packed::PackedCancelByCloid);
+        case ActionType::MODIFY:          return sizeof(packed::PackedModifyOrder);
+        case ActionType::NOOP:            return 0;
+        default:                          return SIZE_MAX;
+    }
+}
 
-    LXOrder order;
+LXOrder decode_place(const packed::PackedPlaceOrder& packed) {
+    LXOrder order{};
     order.market_id = packed.market_id;
     order.is_buy = packed.flags & packed::FLAG_IS_BUY;
     order.kind = static_cast<OrderKind>((packed.flags & packed::FLAG_KIND_MASK) >> packed::FLAG_KIND_SHIFT);
@@ -504,27 +891,137 @@ std::vector<uint8_t> LXBook::execute_packed(const std::vector<uint8_t>& packed_d
     order.size_x18 = static_cast<I128>(packed.size) * X18_ONE / 100000000LL;
     order.limit_px_x18 = static_cast<I128>(packed.limit_price) * X18_ONE / 100000000LL;
     order.trigger_px_x18 = static_cast<I128>(packed.trigger_price) * X18_ONE / 100000000LL;
+    return order;
+}
 
-    LXAccount sender{}; // Would come from authenticated context
-    LXPlaceResult result = place_order(sender, order);
-
-    // Pack result
+packed::PackedPlaceResult encode_result(const LXPlaceResult& result) {
     packed::PackedPlaceResult packed_result;
     packed_result.oid = result.oid;
     packed_result.status = result.status;
     packed_result.filled_size = static_cast<int64_t>(result.filled_size_x18 * 100000000LL / X18_ONE);
     packed_result.avg_price = static_cast<int64_t>(result.avg_px_x18 * 100000000LL / X18_ONE);
+    return packed_result;
+}
+
+packed::PackedPlaceResult encode_cancel(uint64_t oid, int32_t error_code) {
+    LXPlaceResult result{};
+    result.oid = oid;
+    result.status = static_cast<uint8_t>(error_code == errors::OK ?
+        BookOrderStatus::CANCELLED : BookOrderStatus::REJECTED);
+    return encode_result(result);
+}
 
-    std::vector<uint8_t> response(sizeof(packed_result));
-    std::memcpy(response.data(), &packed_result, sizeof(packed_result));
+template<typename T>
+T load_packed(const uint8_t* data) {
+    T value;
+    std::memcpy(&value, data, sizeof(value));
+    return value;
+}
+
+} // namespace
+
+std::vector<uint8_t> LXBook::execute_packed(const std::vector<uint8_t>& packed_data) {
+    if (packed_data.empty()) {
+        return {};
+    }
 
-    return response;
+    // Wire format: [action_type:1][action payload]
+    LXAccount sender{}; // Would come from authenticated context
+    return execute_action(sender, static_cast<ActionType>(packed_data[0]),
+                          packed_data.data() + 1, packed_data.size() - 1).result_data;
 }
 
 std::vector<uint8_t> LXBook::execute_batch_packed(const std::vector<uint8_t>& packed_data) {
-    // Parse batch header and execute each order
-    // Simplified: just forward to single execute
-    return execute_packed(packed_data);
+    const size_t actions = count_packed_actions(packed_data.data(), packed_data.size());
+    std::vector<uint8_t> out(actions * sizeof(packed::PackedPlaceResult));
+
+    // The byte buffer gives no alignment guarantee; results are written
+    // through a packed (align 1) type so this is fine
+    LXAccount sender{}; // Would come from authenticated context
+    size_t executed = execute_batch_packed(
+        sender, packed_data.data(), packed_data.size(),
+        reinterpret_cast<packed::PackedPlaceResult*>(out.data()), actions);
+    out.resize(executed * sizeof(packed::PackedPlaceResult));
+    return out;
+}
+
+size_t LXBook::execute_batch_packed(const LXAccount& sender, const uint8_t* data, size_t size,
+                                    packed::PackedPlaceResult* out, size_t out_capacity) {
+    size_t offset = 0;
+    size_t count = 0;
+
+    while (offset < size && count < out_capacity) {
+        const ActionType type = static_cast<ActionType>(data[offset]);
+        const size_t payload_size = packed_payload_size(type, data + offset + 1, size - offset - 1);
+        if (payload_size == SIZE_MAX || size - offset - 1 < payload_size) {
+            break;
+        }
+        const uint8_t* payload = data + offset + 1;
+
+        switch (type) {
+            case ActionType::PLACE: {
+                auto order = load_packed<packed::PackedPlaceOrder>(payload);
+                out[count] = encode_result(place_order(sender, decode_place(order)));
+                break;
+            }
+            case ActionType::CANCEL: {
+                auto cancel = load_packed<packed::PackedCancelOrder>(payload);
+                out[count] = encode_cancel(cancel.oid, cancel_order(sender, cancel.market_id, cancel.oid));
+                break;
+            }
+            case ActionType::CANCEL_BY_CLOID: {
+                auto cancel = load_packed<packed::PackedCancelByCloid>(payload);
+                std::array<uint8_t, 16> cloid;
+                std::memcpy(cloid.data(), cancel.cloid, cloid.size());
+                out[count] = encode_cancel(0, cancel_by_cloid(sender, cancel.market_id, cloid));
+                break;
+            }
+            case ActionType::MODIFY: {
+                auto modify = load_packed<packed::PackedModifyOrder>(payload);
+                LXPlaceResult result = amend_order(
+                    sender, modify.market_id, modify.oid,
+                    static_cast<I128>(modify.new_size) * X18_ONE / 100000000LL,
+                    static_cast<I128>(modify.new_price) * X18_ONE / 100000000LL);
+                result.filled_size_x18 = 0;
+                result.avg_px_x18 = 0;
+                out[count] = encode_result(result);
+                break;
+            }
+            case ActionType::MASS_QUOTE: {
+                LXMassQuoteResult quote = decode_mass_quote(sender, payload, payload_size);
+                LXPlaceResult result{};
+                result.oid = quote.kept + quote.reduced + quote.requeued + quote.placed;
+                result.status = static_cast<uint8_t>(quote.error_code == errors::OK ?
+                    BookOrderStatus::OPEN : BookOrderStatus::REJECTED);
+                result.filled_size_x18 = quote.filled_size_x18;
+                out[count] = encode_result(result);
+                break;
+            }
+            default:  // NOOP
+                out[count] = encode_result(LXPlaceResult{});
+                break;
+        }
+
+        offset += 1 + payload_size;
+        ++count;
+    }
+
+    return count;
+}
+
+size_t LXBook::count_packed_actions(const uint8_t* data, size_t size) {
+    size_t offset = 0;
+    size_t count = 0;
+    while (offset < size) {
+        const size_t payload_size = packed_payload_size(static_cast<ActionType>(data[offset]),
+                                                        data + offset + 1, size - offset - 1);
+        if (payload_size == SIZE_MAX || size - offset - 1 < payload_size) {
+            break;
+        }
+        offset += 1 + payload_size;
+        ++count;
+    }
+    return count;
 }
 
 // =============================================================================
@@ -535,6 +1032,140 @@ void LXBook::set_settlement_callback(SettlementCallback callback) {
     settlement_callback_ = std::move(callback);
 }
 
+// =============================================================================
+// Snapshots
+// =============================================================================
+
+namespace {
+
+struct AccountOrderRecord {
+    uint64_t account_hash;
+    BookOrderState state;
+};
+
+static_assert(std::is_trivially_copyable_v<TriggerOrder>, "trigger orders are snapshotted raw");
+
+} // namespace
+
+bool LXBook::save_snapshot(const std::string& path) const {
+    SnapshotWriter writer;
+    engine_.append_snapshot(writer);
+
+    std::vector<BookMarketConfig> markets;
+    {
+        std::shared_lock lock(markets_mutex_);
+        markets.reserve(markets_.size());
+        for (const auto& [_, config] : markets_) {
+            markets.push_back(config);
+        }
+    }
+    writer.add_section(SnapshotSectionKind::BookMarkets, nullptr, 0,
+                       markets.data(), sizeof(BookMarketConfig), markets.size());
+
+    std::vector<AccountOrderRecord> orders;
+    for (const OrderIndexShard& shard : order_index_) {
+        std::shared_lock lock(shard.mutex);
+        for (const auto& [account_hash, account] : shard.accounts) {
+            for (const auto& [_, state] : account.orders) {
+                orders.push_back({account_hash, state});
+            }
+        }
+    }
+    writer.add_section(SnapshotSectionKind::BookAccountOrders, nullptr, 0,
+                       orders.data(), sizeof(AccountOrderRecord), orders.size());
+
+    std::vector<TriggerOrder> triggers;
+    {
+        std::shared_lock lock(markets_mutex_);
+        for (const auto& [_, book] : trigger_books_) {
+            book->collect(triggers);
+        }
+    }
+    writer.add_section(SnapshotSectionKind::BookTriggerOrders, nullptr, 0,
+                       triggers.data(), sizeof(TriggerOrder), triggers.size());
+
+    return writer.finish(path);
+}
+
+bool LXBook::load_snapshot(const std::string& path) {
+    auto reader = SnapshotReader::open(path);
+    if (!reader) {
+        return false;
+    }
+
+    // Markets created beforehand, e.g. with their BookPolicy, keep their
+    // books and take the snapshot's orders; nothing may rest on them yet
+    std::unique_lock markets_lock(markets_mutex_);
+    for (const auto& [_, triggers] : trigger_books_) {
+        if (triggers->size() != 0) {
+            return false;
+        }
+    }
+    for (const OrderIndexShard& shard : order_index_) {
+        std::shared_lock lock(shard.mutex);
+        if (!shard.accounts.empty()) {
+            return false;
+        }
+    }
+    if (!engine_.restore_snapshot(*reader)) {
+        return false;
+    }
+
+    uint64_t max_oid = 0;
+    for (const SnapshotSection& section : reader->sections()) {
+        if (section.kind == SnapshotSectionKind::BookMarkets &&
+            section.record_size == sizeof(BookMarketConfig)) {
+            markets_.reserve(section.count);
+            market_to_symbol_.reserve(section.count);
+            for (size_t i = 0; i < section.count; ++i) {
+                BookMarketConfig config;
+                std::memcpy(&config, section.records_as<uint8_t>() + i * sizeof(config), sizeof(config));
+                markets_[config.market_id] = config;
+                market_to_symbol_[config.market_id] = config.symbol_id;
+                add_trade_ring(config.symbol_id);
+                auto& triggers = trigger_books_[config.market_id];
+                if (!triggers) {
+                    triggers = std::make_unique<TriggerBook>();
+                }
+                publish_market(config.market_id);
+            }
+        } else if (section.kind == SnapshotSectionKind::BookAccountOrders &&
+                   section.record_size == sizeof(AccountOrderRecord)) {
+            // Index in placement order so per-market lists and reused
+            // cloids come out as they were before the snapshot. Oids only
+            // rise per generating thread, so creation time orders first.
+            std::vector<AccountOrderRecord> records(section.count);
+            std::memcpy(records.data(), section.records, section.count * sizeof(AccountOrderRecord));
+            std::sort(records.begin(), records.end(),
+                      [](const AccountOrderRecord& a, const AccountOrderRecord& b) {
+                          return a.state.created_at != b.state.created_at
+                                     ? a.state.created_at < b.state.created_at
+                                     : a.state.oid < b.state.oid;
+                      });
+            for (const AccountOrderRecord& record : records) {
+                index_order(record.account_hash, record.state);
+                max_oid = std::max(max_oid, record.state.oid);
+            }
+        } else if (section.kind == SnapshotSectionKind::BookTriggerOrders &&
+                   section.record_size == sizeof(TriggerOrder)) {
+            // No reference price is known yet, so every order rests
+            for (size_t i = 0; i < section.count; ++i) {
+                TriggerOrder trigger;
+                std::memcpy(&trigger, section.records_as<uint8_t>() + i * sizeof(trigger), sizeof(trigger));
+                max_oid = std::max(max_oid, trigger.oid);
+                auto it = trigger_books_.find(trigger.order.market_id);
+                if (it != trigger_books_.end()) {
+                    it->second->add(trigger);
+                }
+            }
+        }
+    }
+
+    // Oids generated from here on must not collide with restored ones
+    OrderIdGenerator::instance().advance_past(max_oid);
+    return true;
+}
+
 // =============================================================================
 // Statistics
 // =============================================================================
@@ -546,28 +1177,64 @@ LXBook::Stats LXBook::get_stats() const {
 
     return Stats{
         markets_.size(),
-        total_orders_placed_.load(std::memory_order_relaxed),
+        total_orders_placed_.load(),
         engine_stats.total_orders_cancelled,
-        total_orders_filled_.load(std::memory_order_relaxed),
+        total_orders_filled_.load(),
         engine_stats.total_trades,
         static_cast<I128>(engine_stats.total_volume) * X18_ONE / 100000000LL
     };
 }
 
+MemoryStats LXBook::memory_usage() const {
+    MemoryStats stats = engine_.memory_usage();
+    for (const OrderIndexShard& shard : order_index_) {
+        stats += shard.arena.stats();
+    }
+    return stats;
+}
+
+std::optional<LXBook::MarketStats> LXBook::get_market_stats(uint32_t market_id) const {
+    uint64_t symbol_id = get_symbol_id(market_id);
+    if (symbol_id == 0) {
+        return std::nullopt;
+    }
+
+    auto symbol_stats = engine_.get_symbol_stats(symbol_id);
+    if (!symbol_stats) {
+        return std::nullopt;
+    }
+
+    return MarketStats{
+        symbol_stats->orders_placed,
+        symbol_stats->orders_cancelled,
+        symbol_stats->trades,
+        static_cast<I128>(symbol_stats->volume) * X18_ONE / 100000000LL
+    };
+}
+
 // =============================================================================
 // Internal Helpers
 // =============================================================================
 
 uint64_t LXBook::get_symbol_id(uint32_t market_id) const {
-    std::shared_lock lock(markets_mutex_);
-    auto it = market_to_symbol_.find(market_id);
-    return (it != market_to_symbol_.end()) ? it->second : 0;
+    MarketHandle market = resolve_market(market_id);
+    return market ? market->config.symbol_id : 0;
+}
+
+uint64_t LXBook::check_market(const LXOrder& order) const {
+    MarketHandle market = resolve_market(order.market_id);
+    return (market && market->accepts(order.kind)) ? market->config.symbol_id : 0;
+}
+
+TriggerBook* LXBook::get_trigger_book(uint32_t market_id) const {
+    MarketHandle market = resolve_market(market_id);
+    return market ? market->triggers : nullptr;
 }
 
 Order LXBook::convert_to_internal(const LXOrder& order, uint64_t symbol_id,
-                                   const LXAccount& sender) const {
+                                   const LXAccount& sender, uint64_t oid) const {
     Order internal;
-    internal.id = OrderIdGenerator::instance().next();
+    internal.id = oid != 0 ? oid : OrderIdGenerator::instance().next();
     internal.symbol_id = symbol_id;
     internal.account_id = sender.hash();
     internal.side = order.is_buy ? Side::Buy : Side::Sell;
@@ -618,80 +1285,109 @@ Order LXBook::convert_to_internal(const LXOrder& order, uint64_t symbol_id,
     return internal;
 }
 
-void LXBook::update_order_state(const LXAccount& account, uint64_t oid,
-                                 const std::function<void(BookOrderState&)>& updater) {
-    std::unique_lock lock(orders_mutex_);
-
-    // Try to find by account first
-    auto account_it = account_orders_.find(account.hash());
-    if (account_it != account_orders_.end()) {
-        auto order_it = account_it->second.orders.find(oid);
-        if (order_it != account_it->second.orders.end()) {
-            updater(order_it->second);
-            return;
+void LXBook::index_order(uint64_t account_hash, const BookOrderState& state) {
+    {
+        OrderIndexShard& shard = account_shard(account_hash);
+        std::unique_lock lock(shard.mutex);
+        AccountOrders& account = shard.accounts[account_hash];
+        account.orders[state.oid] = state;
+        account.cloid_to_oid[state.cloid] = state.oid;
+
+        MarketOrders& market = account.by_market[state.market_id];
+        market.all.push_back(state.oid);
+        if (state.status == BookOrderStatus::NEW || state.status == BookOrderStatus::OPEN) {
+            market.open.insert(state.oid);
         }
     }
 
-    // Search all accounts if not found
-    for (auto& [acc_hash, acc_orders] : account_orders_) {
-        auto order_it = acc_orders.orders.find(oid);
-        if (order_it != acc_orders.orders.end()) {
-            updater(order_it->second);
+    // Taken separately so no thread ever holds two shard locks
+    OrderIndexShard& oid_shard = order_index_[index_shard(state.oid)];
+    std::unique_lock lock(oid_shard.mutex);
+    oid_shard.order_accounts[state.oid] = account_hash;
+}
+
+void LXBook::remember_account(const LXAccount& account) {
+    const uint64_t account_hash = account.hash();
+    OrderIndexShard& shard = account_shard(account_hash);
+    {
+        std::shared_lock lock(shard.mutex);
+        if (shard.owners.count(account_hash)) {
             return;
         }
     }
+    std::unique_lock lock(shard.mutex);
+    shard.owners.emplace(account_hash, account);
 }
 
-void LXBook::record_trade(uint32_t market_id, const Trade& trade) {
-    std::unique_lock lock(trades_mutex_);
-
-    last_trades_[market_id] = trade;
+std::optional<uint64_t> LXBook::account_of(uint64_t oid) const {
+    const OrderIndexShard& shard = order_index_[index_shard(oid)];
+    std::shared_lock lock(shard.mutex);
+    auto it = shard.order_accounts.find(oid);
+    if (it == shard.order_accounts.end()) return std::nullopt;
+    return it->second;
+}
 
-    auto& trades = recent_trades_[market_id];
-    trades.push_back(trade);
+void LXBook::record_trade(const Trade& trade) {
+    // Called from the book's matching path, which serialises writers
+    if (TradeRing* ring = trade_rings_by_symbol_.find(trade.symbol_id)) {
+        ring->push(trade);
+    }
+}
 
-    // Keep only last 1000 trades
-    if (trades.size() > 1000) {
-        trades.erase(trades.begin(), trades.begin() + (trades.size() - 1000));
+void LXBook::add_trade_ring(uint64_t symbol_id) {
+    if (trade_rings_by_symbol_.find(symbol_id)) {
+        return;
     }
+    trade_rings_.push_back(std::make_unique<TradeRing>(RECENT_TRADES));
+    trade_rings_by_symbol_.insert(symbol_id, trade_rings_.back().get());
 }
 
 // =============================================================================
 // Action Handlers
 // =============================================================================
 
-ExecuteResult LXBook::handle_place(const LXAccount& sender, const std::vector<uint8_t>& data) {
+ExecuteResult LXBook::execute_action(const LXAccount& sender, ActionType type,
+                                     const uint8_t* data, size_t size) {
     ExecuteResult result;
     result.error_code = errors::OK;
 
-    // Parse order from data
-    // Simplified: expect packed format
-    if (data.size() < sizeof(packed::PackedPlaceOrder)) {
-        result.error_code = errors::INVALID_PRICE;
-        return result;
+    switch (type) {
+        case ActionType::PLACE:
+            result = handle_place(sender, data, size);
+            break;
+        case ActionType::CANCEL:
+            result = handle_cancel(sender, data, size);
+            break;
+        case ActionType::CANCEL_BY_CLOID:
+            result = handle_cancel_by_cloid(sender, data, size);
+            break;
+        case ActionType::MODIFY:
+            result = handle_modify(sender, data, size);
+            break;
+        case ActionType::MASS_QUOTE:
+            result = handle_mass_quote(sender, data, size);
+            break;
+        case ActionType::NOOP:
+            break;
+        default:
+            result.error_code = errors::UNAUTHORIZED;
     }
 
-    packed::PackedPlaceOrder packed;
-    std::memcpy(&packed, data.data(), sizeof(packed));
+    return result;
+}
 
-    LXOrder order;
-    order.market_id = packed.market_id;
-    order.is_buy = packed.flags & packed::FLAG_IS_BUY;
-    order.kind = static_cast<OrderKind>((packed.flags & packed::FLAG_KIND_MASK) >> packed::FLAG_KIND_SHIFT);
-    order.tif = static_cast<TIF>((packed.flags & packed::FLAG_TIF_MASK) >> packed::FLAG_TIF_SHIFT);
-    order.reduce_only = packed.flags & packed::FLAG_REDUCE_ONLY;
-    order.size_x18 = static_cast<I128>(packed.size) * X18_ONE / 100000000LL;
-    order.limit_px_x18 = static_cast<I128>(packed.limit_price) * X18_ONE / 100000000LL;
-    order.trigger_px_x18 = static_cast<I128>(packed.trigger_price) * X18_ONE / 100000000LL;
+ExecuteResult LXBook::handle_place(const LXAccount& sender, const uint8_t* data, size_t size) {
+    ExecuteResult result;
+    result.error_code = errors::OK;
 
-    LXPlaceResult place_result = place_order(sender, order);
+    if (size < sizeof(packed::PackedPlaceOrder)) {
+        result.error_code = errors::INVALID_PRICE;
+        return result;
+    }
 
-    // Pack result
-    packed::PackedPlaceResult packed_result;
-    packed_result.oid = place_result.oid;
-    packed_result.status = place_result.status;
-    packed_result.filled_size = static_cast<int64_t>(place_result.filled_size_x18 * 100000000LL / X18_ONE);
-    packed_result.avg_price = static_cast<int64_t>(place_result.avg_px_x18 * 100000000LL / X18_ONE);
+    auto packed_order = load_packed<packed::PackedPlaceOrder>(data);
+    packed::PackedPlaceResult packed_result =
+        encode_result(place_order(sender, decode_place(packed_order)));
 
     result.result_data.resize(sizeof(packed_result));
     std::memcpy(result.result_data.data(), &packed_result, sizeof(packed_result));
@@ -699,69 +1395,51 @@ ExecuteResult LXBook::handle_place(const LXAccount& sender, const std::vector<ui
     return result;
 }
 
-ExecuteResult LXBook::handle_cancel(const LXAccount& sender, const std::vector<uint8_t>& data) {
+ExecuteResult LXBook::handle_cancel(const LXAccount& sender, const uint8_t* data, size_t size) {
     ExecuteResult result;
 
-    if (data.size() < sizeof(packed::PackedCancelOrder)) {
+    if (size < sizeof(packed::PackedCancelOrder)) {
         result.error_code = errors::INVALID_PRICE;
         return result;
     }
 
-    packed::PackedCancelOrder packed;
-    std::memcpy(&packed, data.data(), sizeof(packed));
-
-    result.error_code = cancel_order(sender, packed.market_id, packed.oid);
+    auto cancel = load_packed<packed::PackedCancelOrder>(data);
+    result.error_code = cancel_order(sender, cancel.market_id, cancel.oid);
 
     return result;
 }
 
-ExecuteResult LXBook::handle_cancel_by_cloid(const LXAccount& sender, const std::vector<uint8_t>& data) {
+ExecuteResult LXBook::handle_cancel_by_cloid(const LXAccount& sender, const uint8_t* data, size_t size) {
     ExecuteResult result;
 
-    if (data.size() < sizeof(uint32_t) + 16) {
+    if (size < sizeof(packed::PackedCancelByCloid)) {
         result.error_code = errors::INVALID_PRICE;
         return result;
     }
 
-    uint32_t market_id;
+    auto cancel = load_packed<packed::PackedCancelByCloid>(data);
     std::array<uint8_t, 16> cloid;
+    std::memcpy(cloid.data(), cancel.cloid, cloid.size());
 
-    std::memcpy(&market_id, data.data(), sizeof(market_id));
-    std::memcpy(cloid.data(), data.data() + sizeof(market_id), 16);
-
-    result.error_code = cancel_by_cloid(sender, market_id, cloid);
+    result.error_code = cancel_by_cloid(sender, cancel.market_id, cloid);
 
     return result;
 }
 
-ExecuteResult LXBook::handle_modify(const LXAccount& sender, const std::vector<uint8_t>& data) {
+ExecuteResult LXBook::handle_modify(const LXAccount& sender, const uint8_t* data, size_t size) {
     ExecuteResult result;
     result.error_code = errors::OK;
 
-    // Parse modify request
-    if (data.size() < sizeof(uint32_t) + sizeof(uint64_t) + 2 * sizeof(int64_t)) {
+    if (size < sizeof(packed::PackedModifyOrder)) {
         result.error_code = errors::INVALID_PRICE;
         return result;
     }
 
-    size_t offset = 0;
-    uint32_t market_id;
-    uint64_t oid;
-    int64_t new_size;
-    int64_t new_price;
-
-    std::memcpy(&market_id, data.data() + offset, sizeof(market_id));
-    offset += sizeof(market_id);
-    std::memcpy(&oid, data.data() + offset, sizeof(oid));
-    offset += sizeof(oid);
-    std::memcpy(&new_size, data.data() + offset, sizeof(new_size));
-    offset += sizeof(new_size);
-    std::memcpy(&new_price, data.data() + offset, sizeof(new_price));
-
-    I128 size_x18 = static_cast<I128>(new_size) * X18_ONE / 100000000LL;
-    I128 price_x18 = static_cast<I128>(new_price) * X18_ONE / 100000000LL;
+    auto modify = load_packed<packed::PackedModifyOrder>(data);
+    I128 size_x18 = static_cast<I128>(modify.new_size) * X18_ONE / 100000000LL;
+    I128 price_x18 = static_cast<I128>(modify.new_price) * X18_ONE / 100000000LL;
 
-    LXPlaceResult amend_result = amend_order(sender, market_id, oid, size_x18, price_x18);
+    LXPlaceResult amend_result = amend_order(sender, modify.market_id, modify.oid, size_x18, price_x18);
 
     // Pack result
     packed::PackedPlaceResult packed_result;
@@ -776,4 +1454,47 @@ ExecuteResult LXBook::handle_modify(const LXAccount& sender, const std::vector<u
     return result;
 }
 
+LXMassQuoteResult LXBook::decode_mass_quote(const LXAccount& sender, const uint8_t* data, size_t size) {
+    if (packed_payload_size(ActionType::MASS_QUOTE, data, size) > size) {
+        LXMassQuoteResult result{};
+        result.error_code = errors::INVALID_PRICE;
+        return result;
+    }
+
+    auto header = load_packed<packed::PackedMassQuoteHeader>(data);
+    thread_local std::vector<LXQuote> quotes;
+    quotes.resize(header.count);
+    const uint8_t* level_data = data + sizeof(header);
+    for (size_t i = 0; i < header.count; ++i) {
+        auto level = load_packed<packed::PackedQuoteLevel>(level_data + i * sizeof(packed::PackedQuoteLevel));
+        quotes[i].is_buy = level.is_buy != 0;
+        quotes[i].px_x18 = static_cast<I128>(level.price) * X18_ONE / 100000000LL;
+        quotes[i].sz_x18 = static_cast<I128>(level.size) * X18_ONE / 100000000LL;
+    }
+
+    return mass_quote(sender, header.market_id, quotes.data(), quotes.size());
+}
+
+ExecuteResult LXBook::handle_mass_quote(const LXAccount& sender, const uint8_t* data, size_t size) {
+    ExecuteResult result;
+
+    LXMassQuoteResult quote = decode_mass_quote(sender, data, size);
+    result.error_code = quote.error_code;
+
+    packed::PackedMassQuoteResult packed_result;
+    packed_result.error_code = quote.error_code;
+    packed_result.kept = static_cast<uint16_t>(quote.kept);
+    packed_result.reduced = static_cast<uint16_t>(quote.reduced);
+    packed_result.requeued = static_cast<uint16_t>(quote.requeued);
+    packed_result.placed = static_cast<uint16_t>(quote.placed);
+    packed_result.cancelled = static_cast<uint16_t>(quote.cancelled);
+    packed_result.rejected = static_cast<uint16_t>(quote.rejected);
+    packed_result.filled_size = static_cast<int64_t>(quote.filled_size_x18 * 100000000LL / X18_ONE);
+
+    result.result_data.resize(sizeof(packed_result));
+    std::memcpy(result.result_data.data(), &packed_result, sizeof(packed_result));
+
+    return result;
+}
+
 } // namespace lux
@@ -0,0 +1,46 @@
+// =============================================================================
+// clock.cpp - Engine clock sources and TSC calibration
+// =============================================================================
+
+#include "lux/clock.hpp"
+
+namespace lux {
+
+namespace {
+
+double calibrate_ticks() {
+#if defined(__x86_64__) || defined(__i386__) || \
+    (defined(_MSC_VER) && (defined(_M_X64) || defined(_M_IX86)))
+    using clock = std::chrono::steady_clock;
+    const auto wall_start = clock::now();
+    const uint64_t tick_start = cpu_ticks();
+    while (clock::now() - wall_start < std::chrono::milliseconds(10)) {
+    }
+    const uint64_t tick_end = cpu_ticks();
+    const auto wall_end = clock::now();
+    const double nanos = static_cast<double>(
+        std::chrono::duration_cast<std::chrono::nanoseconds>(wall_end - wall_start).count());
+    return tick_end > tick_start ? nanos / static_cast<double>(tick_end - tick_start) : 1.0;
+#else
+    return 1.0;     // cpu_ticks() is steady_clock nanoseconds
+#endif
+}
+
+} // namespace
+
+double cpu_tick_ns() {
+    static const double tick_ns = calibrate_ticks();
+    return tick_ns;
+}
+
+SystemClock& SystemClock::instance() {
+    static SystemClock clock;
+    return clock;
+}
+
+TscClock::TscClock() : tick_ns_(cpu_tick_ns()) {
+    anchor_ticks_ = cpu_ticks();
+    anchor_ = SystemClock::instance().now();
+}
+
+} // namespace lux
@@ -1,11 +1,97 @@
 #include "lux/engine.hpp"
+#include "lux/tracing.hpp"
 #include <stdexcept>
 #include <algorithm>
+#include <unordered_set>
 
 namespace lux {
 
+namespace {
+
+JournalRecord input_record(const BatchOrder& batch_order) {
+    JournalRecord record{};
+    switch (batch_order.action) {
+        case BatchOrder::Action::Place:  record.type = JournalRecordType::Place; break;
+        case BatchOrder::Action::Cancel: record.type = JournalRecordType::Cancel; break;
+        case BatchOrder::Action::Modify: record.type = JournalRecordType::Modify; break;
+        case BatchOrder::Action::Reduce: record.type = JournalRecordType::Reduce; break;
+        case BatchOrder::Action::Auction: record.type = JournalRecordType::Auction; break;
+    }
+    record.symbol_id = batch_order.order.symbol_id;
+    record.order = batch_order.order;
+    record.order_id = batch_order.order_id;
+    record.new_price = batch_order.new_price;
+    record.new_quantity = batch_order.new_quantity;
+    return record;
+}
+
+} // namespace
+
 Engine::Engine(EngineConfig config)
-    : config_(std::move(config)) {}
+    : config_(std::move(config)),
+      clock_(config_.clock ? config_.clock.get() : &SystemClock::instance()) {
+    if (config_.sharded_mode) {
+        size_t count = config_.shard_count;
+        if (count == 0) {
+            count = std::max(1u, std::thread::hardware_concurrency());
+        }
+        for (size_t i = 0; i < count; ++i) {
+            int cpu = -1;
+            if (config_.pin_shards) {
+                cpu = config_.shard_cpus.empty()
+                    ? static_cast<int>(i % cpu_count())
+                    : config_.shard_cpus[i % config_.shard_cpus.size()];
+            }
+            NodeMemory* memory = nullptr;
+            if (config_.numa_local || config_.huge_pages) {
+                const int node = config_.numa_local && cpu >= 0 ? numa_node_of_cpu(cpu) : -1;
+                node_memory_.push_back(std::make_unique<NodeMemory>(node, config_.huge_pages));
+                memory = node_memory_.back().get();
+            }
+            shards_.push_back(std::make_unique<Shard>(config_.shard_ring_capacity,
+                                                      completion_ring_capacity(), cpu, memory));
+        }
+    } else if (config_.huge_pages) {
+        node_memory_.push_back(std::make_unique<NodeMemory>(-1, true));
+        shared_memory_ = node_memory_.back().get();
+    }
+    if (!config_.journal_path.empty()) {
+        journal_ = Journal::open(config_.journal_path, config_.journal);
+        if (!journal_) {
+            throw std::runtime_error("Cannot open journal " + config_.journal_path);
+        }
+        for (size_t i = 0; i < shards_.size(); ++i) {
+            std::string shard_path = config_.journal_path + "." + std::to_string(i);
+            shards_[i]->journal = Journal::open(shard_path, config_.journal);
+            if (!shards_[i]->journal) {
+                throw std::runtime_error("Cannot open journal " + shard_path);
+            }
+        }
+    }
+    if (!config_.event_ring_path.empty()) {
+        event_ring_ = EventRing::create(config_.event_ring_path, config_.event_ring_capacity);
+        if (!event_ring_) {
+            throw std::runtime_error("Cannot create event ring " + config_.event_ring_path);
+        }
+        event_publisher_ = std::make_unique<EventPublisher>(*event_ring_);
+        trade_listener_ = event_publisher_.get();
+    }
+    if (!config_.market_data_path.empty()) {
+        market_data_ = MarketDataPublisher::create(config_.market_data_path, config_.market_data);
+        if (!market_data_) {
+            throw std::runtime_error("Cannot create market data table " + config_.market_data_path);
+        }
+        if (event_publisher_) {
+            event_publisher_->set_next(market_data_.get());
+        } else {
+            trade_listener_ = market_data_.get();
+        }
+    }
+    if (config_.parallel_batch) {
+        size_t threads = config_.batch_threads;
+        batch_pool_ = std::make_unique<TaskPool>(threads == 0 ? 0 : threads - 1);
+    }
+}
 
 Engine::~Engine() {
     stop();
@@ -17,11 +103,18 @@ void Engine::start() {
         return;  // Already running
     }
 
-    if (config_.async_mode && config_.worker_threads > 0) {
+    if (config_.async_mode && !config_.sharded_mode && config_.worker_threads > 0) {
         for (size_t i = 0; i < config_.worker_threads; ++i) {
-            worker_threads_.emplace_back(&Engine::worker_loop, this);
+            workers_.push_back(std::make_unique<Worker>(completion_ring_capacity()));
+            Worker& worker = *workers_.back();
+            worker.thread = std::thread([this, &worker] { worker_loop(worker); });
         }
     }
+
+    for (size_t i = 0; i < shards_.size(); ++i) {
+        Shard& shard = *shards_[i];
+        shard.thread = std::thread([this, &shard] { shard_loop(shard); });
+    }
 }
 
 void Engine::stop() {
@@ -33,148 +126,392 @@ void Engine::stop() {
     // Wake up all workers
     queue_cv_.notify_all();
 
-    // Join worker threads
-    for (auto& thread : worker_threads_) {
-        if (thread.joinable()) {
-            thread.join();
+    // Join worker threads; they drain pending submissions first
+    for (auto& worker : workers_) {
+        if (worker->thread.joinable()) {
+            worker->thread.join();
         }
     }
-    worker_threads_.clear();
-}
 
-void Engine::worker_loop() {
-    while (running_.load()) {
-        AsyncOrder async_order;
-        bool has_order = false;
+    // Shards drain their rings before exiting
+    for (auto& shard : shards_) {
+        if (shard->thread.joinable()) {
+            shard->thread.join();
+        }
+    }
 
-        {
-            std::unique_lock lock(queue_mutex_);
-            queue_cv_.wait(lock, [this] {
-                return !order_queue_.empty() || !running_.load();
-            });
+    flush_journal();
+}
+
+void Engine::shard_loop(Shard& shard) {
+    if (shard.cpu >= 0) {
+        shard.pinned.store(pin_current_thread(shard.cpu), std::memory_order_relaxed);
+    }
 
-            if (!running_.load() && order_queue_.empty()) {
+    std::vector<Trade> fills;
+    fills.reserve(64);
+
+    ShardTask task;
+    size_t idle_spins = 0;
+    size_t since_refresh = 0;
+    while (true) {
+        if (!shard.inbound.try_pop(task)) {
+            if (!running_.load(std::memory_order_acquire) && shard.inbound.empty_approx()) {
+                if (shard.journal) {
+                    shard.journal->commit();
+                }
                 return;
             }
-
-            if (!order_queue_.empty()) {
-                async_order = std::move(order_queue_.front());
-                order_queue_.pop();
-                has_order = true;
+            // Going idle closes the current journal group
+            if (idle_spins == 0 && shard.journal) {
+                shard.journal->commit();
+            }
+            if (++idle_spins > 64) {
+                std::this_thread::yield();
             }
+            continue;
+        }
+        // A burst starts with a fresh clock; a long one refreshes it periodically
+        if (idle_spins != 0 || ++since_refresh == 64) {
+            clock_->refresh();
+            since_refresh = 0;
+        }
+        idle_spins = 0;
+
+        stamp(task.batch_order);
+        if (shard.journal) {
+            journal_append(*shard.journal, input_record(task.batch_order));
+        }
+
+        fills.clear();
+        OrderResult result = execute_on_book(*task.entry, task.batch_order, fills);
+        complete(shard.completions, task.user_data, task.batch_order, result, fills);
+    }
+}
+
+void Engine::complete(SpscRing<Completion>& ring, uint64_t user_data,
+                      const BatchOrder& batch_order, OrderResult& result,
+                      std::vector<Trade>& fills) {
+    if (config_.completion_queue) {
+        Completion completion{};
+        completion.user_data = user_data;
+        completion.order_id = result.order_id;
+        completion.action = batch_order.action;
+        completion.success = result.success;
+        completion.trade_count = static_cast<uint32_t>(fills.size());
+        for (const Trade& fill : fills) {
+            completion.filled_quantity += fill.quantity;
         }
 
-        if (has_order) {
-            OrderResult result = process_single_order(async_order.batch_order);
-            async_order.promise.set_value(std::move(result));
+        // Back-pressure on a full ring while running; drop once stopping
+        while (!ring.try_push(completion)) {
+            if (!running_.load(std::memory_order_acquire)) {
+                completions_dropped_.fetch_add(1, std::memory_order_relaxed);
+                break;
+            }
+            std::this_thread::yield();
         }
     }
+
+    if (completion_handler_) {
+        // Lend the fill buffer to the result and take it back afterwards
+        result.trades.swap(fills);
+        completion_handler_(result);
+        fills.swap(result.trades);
+    }
 }
 
-OrderResult Engine::process_single_order(const BatchOrder& batch_order) {
+size_t Engine::poll_completions(Completion* out, size_t max) {
+    size_t count = 0;
+    for (auto& shard : shards_) {
+        if (count == max) break;
+        count += shard->completions.pop_bulk(out + count, max - count);
+    }
+    for (auto& worker : workers_) {
+        if (count == max) break;
+        count += worker->completions.pop_bulk(out + count, max - count);
+    }
+    return count;
+}
+
+OrderResult Engine::execute_on_book(SymbolEntry& entry, const BatchOrder& batch_order,
+                                    std::vector<Trade>& fills) {
+    OrderResult result{};
+    OrderBook& book = *entry.book;
+
     switch (batch_order.action) {
-        case BatchOrder::Action::Place:
-            return place_order(batch_order.order);
+        case BatchOrder::Action::Place: {
+            result.order_id = batch_order.order.id;
+            TraceSpan span(TracePoint::Matching, batch_order.order.id);
+            const size_t first = fills.size();
+            const PlaceOutcome placed = book.place_order(batch_order.order, fills, trade_listener_);
+            result.success = static_cast<bool>(placed);
+            if (result.success) {
+                entry.counters.record_place(fills.data() + first, placed.trades);
+            } else {
+                result.error = place_error_message(placed.error);
+            }
+            break;
+        }
 
         case BatchOrder::Action::Cancel: {
-            auto cancel_result = cancel_order(
-                batch_order.order.symbol_id,
-                batch_order.order_id
-            );
-            OrderResult result;
-            result.success = cancel_result.success;
             result.order_id = batch_order.order_id;
-            result.error = cancel_result.error;
-            return result;
+            auto cancelled = book.cancel_order(batch_order.order_id);
+            result.success = cancelled.has_value();
+            if (!result.success) {
+                result.error = "Order not found";
+            } else {
+                entry.counters.record_cancel();
+                if (trade_listener_) {
+                    trade_listener_->on_order_cancelled(*cancelled);
+                }
+            }
+            break;
         }
 
-        case BatchOrder::Action::Modify:
-            return modify_order(
-                batch_order.order.symbol_id,
-                batch_order.order_id,
-                batch_order.new_price,
-                batch_order.new_quantity
-            );
+        case BatchOrder::Action::Modify: {
+            result.order_id = batch_order.order_id;
+            auto modified = book.modify_order(batch_order.order_id,
+                                              batch_order.new_price,
+                                              batch_order.new_quantity);
+            result.success = modified.has_value();
+            if (!result.success) {
+                result.error = "Order not found";
+            }
+            break;
+        }
+
+        case BatchOrder::Action::Reduce: {
+            result.order_id = batch_order.order_id;
+            auto reduced = book.reduce_order(batch_order.order_id, batch_order.new_quantity);
+            result.success = reduced.has_value();
+            if (!result.success) {
+                result.error = "Order not found or not a reduction";
+            }
+            break;
+        }
 
-        default:
-            return {false, 0, "Unknown action", {}};
+        case BatchOrder::Action::Auction: {
+            size_t first = fills.size();
+            book.uncross(fills, trade_listener_);
+            result.success = true;
+            entry.counters.record_trades(fills.data() + first, fills.size() - first);
+            break;
+        }
+    }
+
+    return result;
+}
+
+bool Engine::submit(const BatchOrder& order, uint64_t user_data) {
+    if (!config_.sharded_mode) {
+        if (!config_.async_mode) {
+            return false;
+        }
+        {
+            std::lock_guard lock(queue_mutex_);
+            pending_orders_.push_back(AsyncOrder{order, user_data});
+        }
+        queue_cv_.notify_one();
+        return true;
+    }
+
+    SymbolEntry* entry = directory_.find(order.order.symbol_id);
+    if (!entry) {
+        return false;
+    }
+
+    return shards_[entry->shard]->inbound.try_push(
+        ShardTask{order, entry, user_data});
+}
+
+void Engine::set_completion_handler(CompletionHandler handler) {
+    completion_handler_ = std::move(handler);
+}
+
+std::optional<size_t> Engine::shard_of(uint64_t symbol_id) const {
+    SymbolEntry* entry = directory_.find(symbol_id);
+    if (!entry || shards_.empty()) {
+        return std::nullopt;
+    }
+    return entry->shard;
+}
+
+void Engine::worker_loop(Worker& worker) {
+    std::vector<AsyncOrder> batch;
+    std::vector<Trade> fills;
+    fills.reserve(64);
+
+    while (true) {
+        {
+            std::unique_lock lock(queue_mutex_);
+            queue_cv_.wait(lock, [this] {
+                return !pending_orders_.empty() || !running_.load();
+            });
+
+            if (pending_orders_.empty()) {
+                return;  // Stopped and drained
+            }
+
+            // Take everything queued so far in one hand-off
+            batch.swap(pending_orders_);
+        }
+
+        clock_->refresh();
+        for (AsyncOrder& async_order : batch) {
+            BatchOrder& batch_order = async_order.batch_order;
+            stamp(batch_order);
+
+            SymbolEntry* entry = directory_.find(batch_order.order.symbol_id);
+
+            fills.clear();
+            OrderResult result;
+            if (entry) {
+                auto ordered = order_inputs(*entry);
+                journal_input(batch_order);
+                result = execute_on_book(*entry, batch_order, fills);
+            } else {
+                result = {false, batch_order.action == BatchOrder::Action::Place ?
+                                     batch_order.order.id : batch_order.order_id,
+                          "Unknown symbol", {}};
+            }
+            complete(worker.completions, async_order.user_data, batch_order, result, fills);
+        }
+        batch.clear();
+        flush_journal();  // One journal group per hand-off
     }
 }
 
 bool Engine::add_symbol(uint64_t symbol_id) {
-    std::unique_lock lock(orderbooks_mutex_);
+    return add_symbol(symbol_id, config_.default_book);
+}
+
+bool Engine::add_symbol(uint64_t symbol_id, const OrderBookConfig& book_config) {
+    return add_symbol(symbol_id, book_config, &Engine::make_book<GenericBookPolicy>);
+}
 
-    if (orderbooks_.find(symbol_id) != orderbooks_.end()) {
+bool Engine::add_symbol(uint64_t symbol_id, const OrderBookConfig& book_config, BookFactory factory) {
+    std::lock_guard lock(symbols_mutex_);
+
+    if (symbols_.find(symbol_id) != symbols_.end()) {
         return false;  // Symbol already exists
     }
 
-    orderbooks_[symbol_id] = std::make_unique<OrderBook>(symbol_id);
+    auto entry = std::make_unique<SymbolEntry>();
+    if (config_.sharded_mode) {
+        // The owning shard is the only thread touching this book
+        OrderBookConfig sharded_config = book_config;
+        sharded_config.thread_safe = false;
+        entry->shard = next_shard_++ % shards_.size();
+        entry->book = factory(symbol_id, sharded_config, book_memory(*entry));
+    } else {
+        entry->book = factory(symbol_id, book_config, book_memory(*entry));
+    }
+    entry->book->set_clock(book_clock());
+    if (event_publisher_) {
+        entry->book->add_update_listener(event_publisher_.get());
+    }
+    if (market_data_) {
+        entry->book->add_update_listener(market_data_.get());
+    }
+
+    journal_symbol(JournalRecordType::AddSymbol, symbol_id, book_config);
+
+    // Fully built before it becomes visible to lookups
+    directory_.insert(symbol_id, entry.get());
+    symbols_.emplace(symbol_id, std::move(entry));
     return true;
 }
 
 bool Engine::remove_symbol(uint64_t symbol_id) {
-    std::unique_lock lock(orderbooks_mutex_);
+    std::lock_guard lock(symbols_mutex_);
+
+    auto it = symbols_.find(symbol_id);
+    if (it == symbols_.end()) {
+        return false;
+    }
 
-    auto it = orderbooks_.find(symbol_id);
-    if (it == orderbooks_.end()) {
+    // Shards may still hold tasks referencing the book
+    if (sharded_running()) {
         return false;
     }
 
     // Only remove if orderbook is empty
-    if (it->second->total_orders() > 0) {
+    if (it->second->book->total_orders() > 0) {
         return false;
     }
 
-    orderbooks_.erase(it);
+    journal_symbol(JournalRecordType::RemoveSymbol, symbol_id, {});
+    directory_.erase(symbol_id);
+    retired_symbols_.push_back(std::move(it->second));
+    symbols_.erase(it);
     return true;
 }
 
 bool Engine::has_symbol(uint64_t symbol_id) const {
-    std::shared_lock lock(orderbooks_mutex_);
-    return orderbooks_.find(symbol_id) != orderbooks_.end();
+    return directory_.find(symbol_id) != nullptr;
 }
 
 std::vector<uint64_t> Engine::symbols() const {
-    std::shared_lock lock(orderbooks_mutex_);
+    std::lock_guard lock(symbols_mutex_);
     std::vector<uint64_t> result;
-    result.reserve(orderbooks_.size());
-    for (const auto& [id, _] : orderbooks_) {
+    result.reserve(symbols_.size());
+    for (const auto& [id, _] : symbols_) {
         result.push_back(id);
     }
     return result;
 }
 
 OrderResult Engine::place_order(Order order) {
-    OrderResult result;
-    result.order_id = order.id;
+    std::vector<Trade> trades;
+    OrderResult result = place_order(std::move(order), trades);
+    result.trades = std::move(trades);
+    return result;
+}
 
-    OrderBook* book = nullptr;
-    {
-        std::shared_lock lock(orderbooks_mutex_);
-        auto it = orderbooks_.find(order.symbol_id);
-        if (it == orderbooks_.end()) {
-            result.success = false;
-            result.error = "Unknown symbol";
-            return result;
-        }
-        book = it->second.get();
-    }
+OrderResult Engine::place_order(Order order, std::vector<Trade>& fills) {
+    const SymbolHandle symbol = resolve_symbol(order.symbol_id);
+    return place_order(symbol, std::move(order), fills);
+}
 
-    try {
-        result.trades = book->place_order(std::move(order), trade_listener_);
-        result.success = true;
+Engine::SymbolHandle Engine::resolve_symbol(uint64_t symbol_id) const {
+    return SymbolHandle(directory_.find(symbol_id));
+}
 
-        // Update statistics
-        total_orders_placed_.fetch_add(1, std::memory_order_relaxed);
-        total_trades_.fetch_add(result.trades.size(), std::memory_order_relaxed);
+OrderResult Engine::place_order(SymbolHandle symbol, Order order, std::vector<Trade>& fills) {
+    OrderResult result;
+    result.order_id = order.id;
 
-        for (const auto& trade : result.trades) {
-            total_volume_.fetch_add(trade.quantity, std::memory_order_relaxed);
-        }
+    if (sharded_running()) {
+        result.success = false;
+        result.error = "Engine is sharded; use submit()";
+        return result;
+    }
 
-    } catch (const std::exception& e) {
+    SymbolEntry* entry = symbol.entry_;
+    if (!entry) {
         result.success = false;
-        result.error = e.what();
+        result.error = "Unknown symbol";
+        return result;
+    }
+    order.symbol_id = entry->book->symbol_id();
+
+    clock_->refresh();
+    if (order.timestamp.count() == 0) {
+        order.timestamp = clock_->now();
+    }
+    auto ordered = order_inputs(*entry);
+    journal_input(BatchOrder{BatchOrder::Action::Place, order, 0, 0, 0});
+
+    TraceSpan span(TracePoint::Matching, order.id);
+    const size_t first = fills.size();
+    const PlaceOutcome placed = entry->book->place_order(std::move(order), fills, trade_listener_);
+    ordered = {};
+    result.success = static_cast<bool>(placed);
+    if (result.success) {
+        entry->counters.record_place(fills.data() + first, placed.trades);
+    } else {
+        result.error = place_error_message(placed.error);
     }
 
     return result;
@@ -183,25 +520,34 @@ OrderResult Engine::place_order(Order order) {
 CancelResult Engine::cancel_order(uint64_t symbol_id, uint64_t order_id) {
     CancelResult result;
 
-    OrderBook* book = nullptr;
-    {
-        std::shared_lock lock(orderbooks_mutex_);
-        auto it = orderbooks_.find(symbol_id);
-        if (it == orderbooks_.end()) {
-            result.success = false;
-            result.error = "Unknown symbol";
-            return result;
-        }
-        book = it->second.get();
+    if (sharded_running()) {
+        result.success = false;
+        result.error = "Engine is sharded; use submit()";
+        return result;
+    }
+
+    SymbolEntry* entry = directory_.find(symbol_id);
+    if (!entry) {
+        result.success = false;
+        result.error = "Unknown symbol";
+        return result;
     }
 
-    result.cancelled_order = book->cancel_order(order_id);
+    BatchOrder input{BatchOrder::Action::Cancel, {}, order_id, 0, 0};
+    input.order.symbol_id = symbol_id;
+    clock_->refresh();
+    stamp(input);
+    {
+        auto ordered = order_inputs(*entry);
+        journal_input(input);
+        result.cancelled_order = entry->book->cancel_order(order_id);
+    }
     result.success = result.cancelled_order.has_value();
 
     if (!result.success) {
         result.error = "Order not found";
     } else {
-        total_orders_cancelled_.fetch_add(1, std::memory_order_relaxed);
+        entry->counters.record_cancel();
 
         if (trade_listener_) {
             trade_listener_->on_order_cancelled(*result.cancelled_order);
@@ -216,19 +562,27 @@ OrderResult Engine::modify_order(uint64_t symbol_id, uint64_t order_id,
     OrderResult result;
     result.order_id = order_id;
 
-    OrderBook* book = nullptr;
-    {
-        std::shared_lock lock(orderbooks_mutex_);
-        auto it = orderbooks_.find(symbol_id);
-        if (it == orderbooks_.end()) {
-            result.success = false;
-            result.error = "Unknown symbol";
-            return result;
-        }
-        book = it->second.get();
+    if (sharded_running()) {
+        result.success = false;
+        result.error = "Engine is sharded; use submit()";
+        return result;
+    }
+
+    SymbolEntry* entry = directory_.find(symbol_id);
+    if (!entry) {
+        result.success = false;
+        result.error = "Unknown symbol";
+        return result;
     }
 
-    auto modified = book->modify_order(order_id, new_price, new_quantity);
+    BatchOrder input{BatchOrder::Action::Modify, {}, order_id, new_price, new_quantity};
+    input.order.symbol_id = symbol_id;
+    clock_->refresh();
+    stamp(input);
+    auto ordered = order_inputs(*entry);
+    journal_input(input);
+    auto modified = entry->book->modify_order(order_id, new_price, new_quantity);
+    ordered = {};
     result.success = modified.has_value();
 
     if (!result.success) {
@@ -238,166 +592,813 @@ OrderResult Engine::modify_order(uint64_t symbol_id, uint64_t order_id,
     return result;
 }
 
-BatchResult Engine::process_batch(const std::vector<BatchOrder>& batch) {
-    BatchResult result;
+OrderResult Engine::reduce_order(uint64_t symbol_id, uint64_t order_id, Quantity new_quantity) {
+    OrderResult result;
+    result.order_id = order_id;
+
+    if (sharded_running()) {
+        result.success = false;
+        result.error = "Engine is sharded; use submit()";
+        return result;
+    }
+
+    SymbolEntry* entry = directory_.find(symbol_id);
+    if (!entry) {
+        result.success = false;
+        result.error = "Unknown symbol";
+        return result;
+    }
+
+    BatchOrder input{BatchOrder::Action::Reduce, {}, order_id, 0, new_quantity};
+    input.order.symbol_id = symbol_id;
+    clock_->refresh();
+    stamp(input);
+    auto ordered = order_inputs(*entry);
+    journal_input(input);
+    auto reduced = entry->book->reduce_order(order_id, new_quantity);
+    ordered = {};
+    result.success = reduced.has_value();
+
+    if (!result.success) {
+        result.error = "Order not found or not a reduction";
+    }
+
+    return result;
+}
+
+size_t Engine::expire_orders() {
+    clock_->refresh();
+    return expire_orders(clock_->now());
+}
 
-    // Group orders by symbol for locality
-    std::unordered_map<uint64_t, std::vector<const BatchOrder*>> by_symbol;
+size_t Engine::expire_orders(Timestamp now) {
+    if (sharded_running()) {
+        return 0;
+    }
 
-    for (const auto& order : batch) {
-        uint64_t symbol = order.action == BatchOrder::Action::Place ?
-            order.order.symbol_id : order.order.symbol_id;
-        by_symbol[symbol].push_back(&order);
+    // Entries are never freed while the engine lives, so the books can be
+    // worked on outside symbols_mutex_
+    std::vector<SymbolEntry*> entries;
+    {
+        std::lock_guard lock(symbols_mutex_);
+        entries.reserve(symbols_.size());
+        for (const auto& [_, entry] : symbols_) {
+            entries.push_back(entry.get());
+        }
     }
 
-    // Process each symbol's orders
-    for (const auto& [symbol_id, orders] : by_symbol) {
-        OrderBook* book = nullptr;
+    std::vector<Order> expired;
+    size_t total = 0;
+    for (SymbolEntry* entry : entries) {
+        expired.clear();
         {
-            std::shared_lock lock(orderbooks_mutex_);
-            auto it = orderbooks_.find(symbol_id);
-            if (it != orderbooks_.end()) {
-                book = it->second.get();
+            auto ordered = order_inputs(*entry);
+            if (entry->book->expire_orders(now, expired) == 0) {
+                continue;
+            }
+            for (const Order& order : expired) {
+                BatchOrder input{BatchOrder::Action::Cancel, {}, order.id, 0, 0};
+                input.order.symbol_id = order.symbol_id;
+                input.order.timestamp = now;
+                journal_input(input);
             }
         }
+        total += expired.size();
 
-        if (!book) {
-            // All orders for unknown symbol fail
-            for (const auto* batch_order : orders) {
-                if (batch_order->action == BatchOrder::Action::Place) {
-                    result.order_results.push_back({
-                        false, batch_order->order.id, "Unknown symbol", {}
-                    });
-                } else {
-                    result.cancel_results.push_back({
-                        false, std::nullopt, "Unknown symbol"
-                    });
-                }
+        for (const Order& order : expired) {
+            entry->counters.record_cancel();
+            if (trade_listener_) {
+                trade_listener_->on_order_cancelled(order);
             }
-            continue;
         }
+    }
+    return total;
+}
 
-        for (const auto* batch_order : orders) {
-            switch (batch_order->action) {
-                case BatchOrder::Action::Place: {
-                    try {
-                        auto trades = book->place_order(batch_order->order, trade_listener_);
-                        result.order_results.push_back({
-                            true, batch_order->order.id, "", std::move(trades)
-                        });
+size_t Engine::run_auctions() {
+    clock_->refresh();
+    return run_auctions(clock_->now());
+}
 
-                        for (const auto& trade : result.order_results.back().trades) {
-                            result.all_trades.push_back(trade);
-                        }
+size_t Engine::run_auctions(Timestamp now) {
+    if (sharded_running()) {
+        return 0;
+    }
 
-                        total_orders_placed_.fetch_add(1, std::memory_order_relaxed);
+    std::vector<SymbolEntry*> entries;
+    {
+        std::lock_guard lock(symbols_mutex_);
+        entries.reserve(symbols_.size());
+        for (const auto& [_, entry] : symbols_) {
+            entries.push_back(entry.get());
+        }
+    }
 
-                    } catch (const std::exception& e) {
-                        result.order_results.push_back({
-                            false, batch_order->order.id, e.what(), {}
-                        });
-                    }
-                    break;
-                }
+    std::vector<Trade> fills;
+    size_t total = 0;
+    for (SymbolEntry* entry : entries) {
+        fills.clear();
+        {
+            auto ordered = order_inputs(*entry);
+            if (!entry->book->run_auction(now, fills, trade_listener_)) {
+                continue;
+            }
+            BatchOrder input{BatchOrder::Action::Auction, {}, 0, 0, 0};
+            input.order.symbol_id = entry->book->symbol_id();
+            input.order.timestamp = now;
+            journal_input(input);
+        }
 
-                case BatchOrder::Action::Cancel: {
-                    auto cancelled = book->cancel_order(batch_order->order_id);
-                    result.cancel_results.push_back({
-                        cancelled.has_value(), cancelled, ""
-                    });
+        entry->counters.record_trades(fills.data(), fills.size());
+        total += fills.size();
+    }
+    return total;
+}
 
-                    if (cancelled) {
-                        total_orders_cancelled_.fetch_add(1, std::memory_order_relaxed);
-                    }
-                    break;
-                }
+std::optional<MassQuoteSummary> Engine::mass_quote(uint64_t symbol_id, const MassQuoteRequest& request,
+                                                   QuoteOutcome* outcomes, std::vector<Trade>& fills) {
+    if (sharded_running()) {
+        return std::nullopt;
+    }
 
-                case BatchOrder::Action::Modify: {
-                    auto modified = book->modify_order(
-                        batch_order->order_id,
-                        batch_order->new_price,
-                        batch_order->new_quantity
-                    );
-
-                    result.order_results.push_back({
-                        modified.has_value(),
-                        batch_order->order_id,
-                        modified ? "" : "Order not found",
-                        {}
-                    });
-                    break;
+    SymbolEntry* entry = directory_.find(symbol_id);
+    if (!entry) {
+        return std::nullopt;
+    }
+
+    thread_local std::vector<Order> cancelled;
+    cancelled.clear();
+    const size_t first = fills.size();
+    clock_->refresh();
+    const Timestamp now = clock_->now();
+    auto ordered = order_inputs(*entry);
+    MassQuoteSummary summary = entry->book->mass_quote(request, now, outcomes, cancelled, fills,
+                                                       trade_listener_);
+
+    // The diff is only known once the book has run it; journal the
+    // resulting steps in the order the book applied them, each stamped
+    // with the time the book used so replay requeues and places alike
+    if (journal_ && !replaying_) {
+        std::lock_guard lock(journal_mutex_);
+        BatchOrder input{BatchOrder::Action::Cancel, {}, 0, 0, 0};
+        input.order.symbol_id = symbol_id;
+        input.order.timestamp = now;
+        for (const Order& order : cancelled) {
+            input.order_id = order.id;
+            journal_append(*journal_, input_record(input));
+        }
+        for (size_t i = 0; i < request.level_count; ++i) {
+            const QuoteOutcome& outcome = outcomes[i];
+            const QuoteLevel& level = request.levels[i];
+            if (outcome.action == QuoteAction::Reduced) {
+                input = BatchOrder{BatchOrder::Action::Reduce, {}, outcome.order_id, 0, outcome.quantity};
+            } else if (outcome.action == QuoteAction::Requeued) {
+                input = BatchOrder{BatchOrder::Action::Modify, {}, outcome.order_id,
+                                   level.price, outcome.quantity};
+            } else {
+                continue;
+            }
+            input.order.symbol_id = symbol_id;
+            input.order.timestamp = now;
+            journal_append(*journal_, input_record(input));
+        }
+        for (size_t i = 0; i < request.level_count; ++i) {
+            if (outcomes[i].action == QuoteAction::Placed) {
+                Order order = make_quote_order(request.prototype, request.levels[i]);
+                order.symbol_id = symbol_id;
+                if (order.timestamp.count() == 0) {
+                    order.timestamp = now;
                 }
+                journal_append(*journal_, input_record(BatchOrder{BatchOrder::Action::Place, order, 0, 0, 0}));
             }
         }
     }
+    ordered = {};
+
+    // Fills only come from placed levels; book them with the first one
+    for (uint32_t i = 0; i < summary.placed; ++i) {
+        if (i == 0) {
+            entry->counters.record_place(fills.data() + first, fills.size() - first);
+        } else {
+            entry->counters.record_place(nullptr, 0);
+        }
+    }
+    for (const Order& order : cancelled) {
+        entry->counters.record_cancel();
+        if (trade_listener_) {
+            trade_listener_->on_order_cancelled(order);
+        }
+    }
 
-    total_trades_.fetch_add(result.all_trades.size(), std::memory_order_relaxed);
-    for (const auto& trade : result.all_trades) {
-        total_volume_.fetch_add(trade.quantity, std::memory_order_relaxed);
+    return summary;
+}
+
+BatchResult Engine::process_batch(const std::vector<BatchOrder>& batch) {
+    BatchResult result;
+
+    if (sharded_running()) {
+        for (const auto& batch_order : batch) {
+            result.order_results.push_back({
+                false, batch_order.order.id, "Engine is sharded; use submit()", {}
+            });
+        }
+        return result;
+    }
+
+    clock_->refresh();
+    return process_batch_grouped(batch);
+}
+
+BatchResult Engine::process_batch_grouped(const std::vector<BatchOrder>& batch) {
+    // Grouping scratch comes from the calling thread's batch arena and is
+    // dropped in one go when the outermost batch on the thread returns; a
+    // trade listener that submits a batch of its own just bumps further.
+    // Workers only touch the groups' results, which outlive the arena.
+    thread_local BatchArena arena;
+    thread_local unsigned depth = 0;
+    struct ArenaScope {
+        ArenaScope() { ++depth; }
+        ~ArenaScope() {
+            if (--depth == 0) {
+                arena.reset();
+            }
+        }
+    } scope;
+    std::pmr::memory_resource* scratch = arena.resource();
+
+    // Partition by symbol for locality, keeping batch order within each group
+    struct Group {
+        SymbolEntry* entry = nullptr;
+        std::pmr::vector<size_t> items;
+        BatchResult result;
+    };
+    std::pmr::vector<Group> groups(scratch);
+    std::pmr::vector<size_t> group_of(batch.size(), scratch);
+    {
+        std::pmr::unordered_map<uint64_t, size_t> index(scratch);
+        for (size_t i = 0; i < batch.size(); ++i) {
+            uint64_t symbol_id = batch[i].order.symbol_id;
+            auto [it, inserted] = index.try_emplace(symbol_id, groups.size());
+            if (inserted) {
+                groups.emplace_back(Group{nullptr, std::pmr::vector<size_t>(scratch), {}});
+                groups.back().entry = directory_.find(symbol_id);
+            }
+            group_of[i] = it->second;
+            groups[it->second].items.push_back(i);
+        }
+    }
+
+    // Largest groups first so the tail of the batch stays balanced
+    std::pmr::vector<size_t> schedule(groups.size(), scratch);
+    for (size_t g = 0; g < schedule.size(); ++g) {
+        schedule[g] = g;
+    }
+    std::sort(schedule.begin(), schedule.end(), [&](size_t a, size_t b) {
+        return groups[a].items.size() > groups[b].items.size();
+    });
+
+    auto run_group = [&](size_t n) {
+        Group& group = groups[schedule[n]];
+        for (size_t i : group.items) {
+            execute_batch_item(group.entry, batch[i], group.result);
+        }
+    };
+    if (batch_pool_) {
+        batch_pool_->parallel_for(schedule.size(), run_group);
+    } else {
+        for (size_t n = 0; n < schedule.size(); ++n) {
+            run_group(n);
+        }
+    }
+
+    // Merge back in batch order: each group's results are in item order
+    BatchResult result;
+    result.order_results.reserve(batch.size());
+    std::pmr::vector<size_t> order_cursor(groups.size(), 0, scratch);
+    std::pmr::vector<size_t> cancel_cursor(groups.size(), 0, scratch);
+    for (size_t i = 0; i < batch.size(); ++i) {
+        size_t g = group_of[i];
+        if (batch[i].action == BatchOrder::Action::Cancel) {
+            result.cancel_results.push_back(
+                std::move(groups[g].result.cancel_results[cancel_cursor[g]++]));
+        } else {
+            result.order_results.push_back(
+                std::move(groups[g].result.order_results[order_cursor[g]++]));
+            const auto& trades = result.order_results.back().trades;
+            result.all_trades.insert(result.all_trades.end(), trades.begin(), trades.end());
+        }
     }
 
     return result;
 }
 
+void Engine::execute_batch_item(SymbolEntry* entry, const BatchOrder& input,
+                                BatchResult& out) {
+    BatchOrder batch_order = input;
+    stamp(batch_order);
+    if (!entry) {
+        if (batch_order.action == BatchOrder::Action::Cancel) {
+            out.cancel_results.push_back({false, std::nullopt, "Unknown symbol"});
+        } else {
+            out.order_results.push_back({false, batch_order.order.id, "Unknown symbol", {}});
+        }
+        return;
+    }
+
+    auto ordered = order_inputs(*entry);
+    journal_input(batch_order);
+
+    OrderBook* book = entry->book.get();
+    switch (batch_order.action) {
+        case BatchOrder::Action::Place: {
+            std::vector<Trade> trades;
+            const PlaceOutcome placed = book->place_order(batch_order.order, trades, trade_listener_);
+            if (!placed) {
+                out.order_results.push_back({
+                    false, batch_order.order.id, place_error_message(placed.error), {}
+                });
+                break;
+            }
+            out.order_results.push_back({
+                true, batch_order.order.id, "", std::move(trades)
+            });
+
+            const auto& fills = out.order_results.back().trades;
+            out.all_trades.insert(out.all_trades.end(), fills.begin(), fills.end());
+            entry->counters.record_place(fills.data(), fills.size());
+            break;
+        }
+
+        case BatchOrder::Action::Cancel: {
+            auto cancelled = book->cancel_order(batch_order.order_id);
+            out.cancel_results.push_back({
+                cancelled.has_value(), cancelled, ""
+            });
+
+            if (cancelled) {
+                entry->counters.record_cancel();
+            }
+            break;
+        }
+
+        case BatchOrder::Action::Modify: {
+            auto modified = book->modify_order(
+                batch_order.order_id,
+                batch_order.new_price,
+                batch_order.new_quantity
+            );
+
+            out.order_results.push_back({
+                modified.has_value(),
+                batch_order.order_id,
+                modified ? "" : "Order not found",
+                {}
+            });
+            break;
+        }
+
+        case BatchOrder::Action::Reduce: {
+            auto reduced = book->reduce_order(batch_order.order_id, batch_order.new_quantity);
+            out.order_results.push_back({
+                reduced.has_value(),
+                batch_order.order_id,
+                reduced ? "" : "Order not found or not a reduction",
+                {}
+            });
+            break;
+        }
+
+        case BatchOrder::Action::Auction: {
+            std::vector<Trade> trades;
+            book->uncross(trades, trade_listener_);
+            entry->counters.record_trades(trades.data(), trades.size());
+            out.all_trades.insert(out.all_trades.end(), trades.begin(), trades.end());
+            out.order_results.push_back({true, 0, "", std::move(trades)});
+            break;
+        }
+    }
+}
+
+// =============================================================================
+// Journal
+// =============================================================================
+
+void Engine::journal_input(const BatchOrder& batch_order) {
+    if (!journal_ || replaying_) {
+        return;
+    }
+    std::lock_guard lock(journal_mutex_);
+    journal_append(*journal_, input_record(batch_order));
+}
+
+void Engine::journal_symbol(JournalRecordType type, uint64_t symbol_id,
+                            const OrderBookConfig& book_config) {
+    if (!journal_ || replaying_) {
+        return;
+    }
+    JournalRecord record{};
+    record.type = type;
+    record.symbol_id = symbol_id;
+    record.book = book_config;
+
+    // Symbol changes are rare; commit them straight away
+    std::lock_guard lock(journal_mutex_);
+    journal_append(*journal_, record);
+    journal_->commit();
+}
+
+void Engine::flush_journal() {
+    if (!journal_) {
+        return;
+    }
+    std::lock_guard lock(journal_mutex_);
+    journal_->commit();
+}
+
+size_t Engine::replay_journal(const std::string& path) {
+    if (running_.load()) {
+        return 0;
+    }
+
+    auto after = [this](size_t file) {
+        return file < replay_after_.size() ? replay_after_[file] : 0;
+    };
+
+    // Books, including any the journal adds, run on the journaled stamps
+    auto set_book_clocks = [this](EngineClock* clock) {
+        std::lock_guard lock(symbols_mutex_);
+        for (auto& [_, entry] : symbols_) {
+            entry->book->set_clock(clock);
+        }
+    };
+    replaying_ = true;
+    set_book_clocks(&replay_clock_);
+    size_t applied = replay_file(path, after(0));
+    if (applied != SIZE_MAX) {
+        // Shard journals only hold order actions; their books exist by now
+        for (size_t i = 0;; ++i) {
+            size_t shard_applied = replay_file(path + "." + std::to_string(i), after(i + 1));
+            if (shard_applied == SIZE_MAX) {
+                break;
+            }
+            applied += shard_applied;
+        }
+    }
+    replaying_ = false;
+    set_book_clocks(clock_);
+
+    return applied == SIZE_MAX ? 0 : applied;
+}
+
+size_t Engine::replay_file(const std::string& path, uint64_t after_sequence) {
+    auto reader = JournalReader::open(path);
+    if (!reader) {
+        return SIZE_MAX;
+    }
+
+    std::vector<Trade> fills;
+    size_t applied = 0;
+    for (const JournalRecord& record : *reader) {
+        if (record.sequence <= after_sequence || record.type == JournalRecordType::Mark) {
+            continue;
+        }
+        ++applied;
+        replay_record(record, fills);
+    }
+    return applied;
+}
+
+void Engine::replay_record(const JournalRecord& record, std::vector<Trade>& fills) {
+    if (record.type == JournalRecordType::Mark) {
+        return;
+    }
+    if (record.type == JournalRecordType::AddSymbol) {
+        add_symbol(record.symbol_id, record.book);
+        return;
+    }
+    if (record.type == JournalRecordType::RemoveSymbol) {
+        remove_symbol(record.symbol_id);
+        return;
+    }
+
+    SymbolEntry* entry = directory_.find(record.symbol_id);
+    if (!entry) {
+        return;
+    }
+
+    BatchOrder batch_order{};
+    switch (record.type) {
+        case JournalRecordType::Place:  batch_order.action = BatchOrder::Action::Place; break;
+        case JournalRecordType::Cancel: batch_order.action = BatchOrder::Action::Cancel; break;
+        case JournalRecordType::Reduce: batch_order.action = BatchOrder::Action::Reduce; break;
+        case JournalRecordType::Auction: batch_order.action = BatchOrder::Action::Auction; break;
+        default:                        batch_order.action = BatchOrder::Action::Modify; break;
+    }
+    batch_order.order = record.order;
+    batch_order.order_id = record.order_id;
+    batch_order.new_price = record.new_price;
+    batch_order.new_quantity = record.new_quantity;
+    if (record.order.timestamp.count() != 0) {
+        replay_clock_.set(record.order.timestamp);
+    }
+
+    fills.clear();
+    execute_on_book(*entry, batch_order, fills);
+}
+
+void Engine::journal_append(Journal& journal, const JournalRecord& record) {
+    if (journal.append(record) == 0) {
+        journal_failed_.store(true, std::memory_order_relaxed);
+    }
+}
+
+bool Engine::journal_failed() const {
+    return journal_failed_.load(std::memory_order_relaxed);
+}
+
+uint64_t Engine::journal_sequence() const {
+    std::lock_guard lock(journal_mutex_);
+    return journal_ ? journal_->last_sequence() : 0;
+}
+
+bool Engine::apply_replicated(const JournalRecord& record) {
+    if (config_.sharded_mode) {
+        return false;
+    }
+
+    JournalRecord local = record;
+    if (local.type == JournalRecordType::AddSymbol) {
+        local.book.thread_safe = true;
+    }
+    std::vector<Trade> fills;
+    replaying_ = true;
+    replay_record(local, fills);
+    replaying_ = false;
+
+    // The original record, so the mirror matches the primary's journal
+    if (journal_) {
+        std::lock_guard lock(journal_mutex_);
+        journal_append(*journal_, record);
+    }
+    return true;
+}
+
+void Engine::end_replication() {
+    std::lock_guard lock(symbols_mutex_);
+    for (auto& [_, entry] : symbols_) {
+        entry->book->set_clock(clock_);
+    }
+}
+
+// =============================================================================
+// Snapshots
+// =============================================================================
+
+bool Engine::save_snapshot(const std::string& path) const {
+    if (sharded_running()) {
+        return false;
+    }
+    SnapshotWriter writer;
+    append_snapshot(writer);
+    return writer.finish(path);
+}
+
+void Engine::append_snapshot(SnapshotWriter& writer) const {
+    // Journal positions first: everything up to them is in the books below
+    EngineSnapshotInfo info{};
+    std::vector<uint64_t> shard_sequences;
+    {
+        std::lock_guard lock(journal_mutex_);
+        info.journal_sequence = journal_ ? journal_->last_sequence() : 0;
+    }
+    for (const auto& shard : shards_) {
+        shard_sequences.push_back(shard->journal ? shard->journal->last_sequence() : 0);
+    }
+    writer.add_section(SnapshotSectionKind::EngineInfo, &info, sizeof(info),
+                       shard_sequences.data(), sizeof(uint64_t), shard_sequences.size());
+
+    std::lock_guard lock(symbols_mutex_);
+    std::vector<Order> orders;
+    for (const auto& [symbol_id, entry] : symbols_) {
+        orders.clear();
+        BookSnapshotHeader header = entry->book->capture(orders);
+        header.config.thread_safe = true;  // Sharded engines override this themselves
+        writer.add_section(SnapshotSectionKind::Book, &header, sizeof(header),
+                           orders.data(), sizeof(Order), orders.size());
+    }
+}
+
+bool Engine::load_snapshot(const std::string& path) {
+    auto reader = SnapshotReader::open(path);
+    return reader && restore_snapshot(*reader);
+}
+
+bool Engine::restore_snapshot(const SnapshotReader& reader) {
+    if (running_.load()) {
+        return false;
+    }
+
+    // Validate every section before touching state, so a corrupt file
+    // leaves the engine as it was
+    std::lock_guard lock(symbols_mutex_);
+    std::unordered_set<uint64_t> restored;
+    for (const SnapshotSection& section : reader.sections()) {
+        if (section.kind == SnapshotSectionKind::EngineInfo) {
+            if (section.meta_size < sizeof(EngineSnapshotInfo) ||
+                (section.count > 0 && section.record_size != sizeof(uint64_t))) {
+                return false;
+            }
+        } else if (section.kind == SnapshotSectionKind::Book) {
+            if (section.meta_size < sizeof(BookSnapshotHeader) || section.record_size != sizeof(Order)) {
+                return false;
+            }
+            const auto* header = static_cast<const BookSnapshotHeader*>(section.meta);
+            if (!restored.insert(header->symbol_id).second) {
+                return false;
+            }
+            // A symbol added before the restore, e.g. with its BookPolicy,
+            // takes the image if its book is still empty
+            auto existing = symbols_.find(header->symbol_id);
+            const bool accepted = existing != symbols_.end()
+                ? existing->second->book->total_orders() == 0 &&
+                  existing->second->book->accepts_image(*header, section.records_as<Order>(), section.count)
+                : OrderBook::valid_image(*header, section.records_as<Order>(), section.count);
+            if (!accepted) {
+                return false;
+            }
+        }
+    }
+
+    uint64_t max_order_id = 0;
+    for (const SnapshotSection& section : reader.sections()) {
+        if (section.kind == SnapshotSectionKind::EngineInfo) {
+            const auto* info = static_cast<const EngineSnapshotInfo*>(section.meta);
+            replay_after_.assign(1, info->journal_sequence);
+            const auto* shard_sequences = section.records_as<uint64_t>();
+            replay_after_.insert(replay_after_.end(), shard_sequences,
+                                 shard_sequences + section.count);
+            continue;
+        }
+        if (section.kind != SnapshotSectionKind::Book) {
+            continue;
+        }
+
+        const auto* header = static_cast<const BookSnapshotHeader*>(section.meta);
+        for (size_t i = 0; i < section.count; ++i) {
+            max_order_id = std::max(max_order_id, section.records_as<Order>()[i].id);
+        }
+        auto existing = symbols_.find(header->symbol_id);
+        if (existing != symbols_.end()) {
+            existing->second->book->restore(*header, section.records_as<Order>(), section.count);
+            continue;
+        }
+
+        OrderBookConfig book_config = header->config;
+        auto entry = std::make_unique<SymbolEntry>();
+        if (config_.sharded_mode) {
+            book_config.thread_safe = false;
+            entry->shard = next_shard_++ % shards_.size();
+        }
+        entry->book = std::make_unique<OrderBook>(header->symbol_id, book_config,
+                                                  book_memory(*entry));
+        entry->book->set_clock(book_clock());
+        entry->book->restore(*header, section.records_as<Order>(), section.count);
+        if (event_publisher_) {
+            entry->book->add_update_listener(event_publisher_.get());
+        }
+        if (market_data_) {
+            entry->book->add_update_listener(market_data_.get());
+        }
+
+        directory_.insert(header->symbol_id, entry.get());
+        symbols_.emplace(header->symbol_id, std::move(entry));
+    }
+
+    // Generated IDs must not collide with restored ones
+    OrderIdGenerator::instance().advance_past(max_order_id);
+    return true;
+}
+
 std::optional<Order> Engine::get_order(uint64_t symbol_id, uint64_t order_id) const {
-    std::shared_lock lock(orderbooks_mutex_);
-    auto it = orderbooks_.find(symbol_id);
-    if (it == orderbooks_.end()) {
+    // Sharded books have no lock; only their shard may walk them
+    const OrderBook* book = sharded_running() ? nullptr : find_book(symbol_id);
+    if (!book) {
         return std::nullopt;
     }
-    return it->second->get_order(order_id);
+    return book->get_order(order_id);
 }
 
 MarketDepth Engine::get_depth(uint64_t symbol_id, size_t levels) const {
-    std::shared_lock lock(orderbooks_mutex_);
-    auto it = orderbooks_.find(symbol_id);
-    if (it == orderbooks_.end()) {
+    const OrderBook* book = sharded_running() ? nullptr : find_book(symbol_id);
+    if (!book) {
         return {};
     }
-    return it->second->get_depth(levels);
+    return book->get_depth(levels);
+}
+
+bool Engine::get_l2_snapshot(uint64_t symbol_id, size_t levels, L2Snapshot& out) const {
+    const OrderBook* book = sharded_running() ? nullptr : find_book(symbol_id);
+    if (!book) {
+        return false;
+    }
+    book->get_l2_snapshot(out, levels);
+    return true;
 }
 
 std::optional<Price> Engine::best_bid(uint64_t symbol_id) const {
-    std::shared_lock lock(orderbooks_mutex_);
-    auto it = orderbooks_.find(symbol_id);
-    if (it == orderbooks_.end()) {
+    const OrderBook* book = find_book(symbol_id);
+    if (!book) {
         return std::nullopt;
     }
-    return it->second->best_bid();
+    return book->best_bid();
 }
 
 std::optional<Price> Engine::best_ask(uint64_t symbol_id) const {
-    std::shared_lock lock(orderbooks_mutex_);
-    auto it = orderbooks_.find(symbol_id);
-    if (it == orderbooks_.end()) {
+    const OrderBook* book = find_book(symbol_id);
+    if (!book) {
         return std::nullopt;
     }
-    return it->second->best_ask();
+    return book->best_ask();
 }
 
 Engine::Stats Engine::get_stats() const {
-    return {
-        total_orders_placed_.load(std::memory_order_relaxed),
-        total_orders_cancelled_.load(std::memory_order_relaxed),
-        total_trades_.load(std::memory_order_relaxed),
-        total_volume_.load(std::memory_order_relaxed)
+    // Summed on demand; removed symbols keep contributing their history
+    Stats stats{};
+    auto accumulate = [&stats](const SymbolEntry& entry) {
+        SymbolStats symbol = entry.counters.snapshot();
+        stats.total_orders_placed += symbol.orders_placed;
+        stats.total_orders_cancelled += symbol.orders_cancelled;
+        stats.total_trades += symbol.trades;
+        stats.total_volume += symbol.volume;
     };
+
+    std::lock_guard lock(symbols_mutex_);
+    for (const auto& [_, entry] : symbols_) {
+        accumulate(*entry);
+    }
+    for (const auto& entry : retired_symbols_) {
+        accumulate(*entry);
+    }
+    return stats;
+}
+
+MemoryStats Engine::memory_usage() const {
+    MemoryStats stats;
+    std::lock_guard lock(symbols_mutex_);
+    for (const auto& [_, entry] : symbols_) {
+        stats += entry->book->memory_usage();
+    }
+    return stats;
+}
+
+std::pmr::memory_resource* Engine::book_memory(const SymbolEntry& entry) const {
+    if (config_.sharded_mode) {
+        NodeMemory* memory = shards_[entry.shard]->memory;
+        return memory ? memory->resource() : nullptr;
+    }
+    return shared_memory_ ? shared_memory_->resource() : nullptr;
+}
+
+Engine::PlacementStats Engine::get_placement_stats() const {
+    PlacementStats stats;
+    for (const auto& shard : shards_) {
+        ShardPlacement placement;
+        placement.cpu = shard->cpu;
+        placement.node = shard->cpu >= 0 ? numa_node_of_cpu(shard->cpu) : -1;
+        placement.pinned = shard->pinned.load(std::memory_order_relaxed);
+        placement.memory = shard->memory ? shard->memory->stats() : NodeMemoryStats{};
+        stats.shards.push_back(placement);
+    }
+    if (shared_memory_) {
+        stats.shared = shared_memory_->stats();
+    }
+    return stats;
+}
+
+std::optional<Engine::SymbolStats> Engine::get_symbol_stats(uint64_t symbol_id) const {
+    const SymbolEntry* entry = directory_.find(symbol_id);
+    if (!entry) {
+        return std::nullopt;
+    }
+    return entry->counters.snapshot();
 }
 
 void Engine::set_trade_listener(TradeListener* listener) {
-    trade_listener_ = listener;
+    if (market_data_) {
+        market_data_->set_next(listener);
+    } else if (event_publisher_) {
+        event_publisher_->set_next(listener);
+    } else {
+        trade_listener_ = listener;
+    }
 }
 
 OrderBook* Engine::get_orderbook(uint64_t symbol_id) {
-    std::shared_lock lock(orderbooks_mutex_);
-    auto it = orderbooks_.find(symbol_id);
-    return it != orderbooks_.end() ? it->second.get() : nullptr;
+    return find_book(symbol_id);
 }
 
 const OrderBook* Engine::get_orderbook(uint64_t symbol_id) const {
-    std::shared_lock lock(orderbooks_mutex_);
-    auto it = orderbooks_.find(symbol_id);
-    return it != orderbooks_.end() ? it->second.get() : nullptr;
+    return find_book(symbol_id);
 }
 
 } // namespace lux
@@ -0,0 +1,301 @@
+// =============================================================================
+// event_ring.cpp - Shared-memory ring of engine output events
+// =============================================================================
+
+#include "lux/event_ring.hpp"
+#include <atomic>
+#include <cstring>
+
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+
+namespace lux {
+
+namespace {
+
+constexpr uint64_t EVENT_RING_MAGIC = 0x4c55584556454e54ull;  // "LUXEVENT"
+constexpr uint32_t EVENT_RING_VERSION = 1;
+
+// First page of the file; slots start at HEADER_BYTES. magic is stored
+// last, so a reader that sees it sees the rest of the header.
+struct EventRingHeader {
+    std::atomic<uint64_t> magic;
+    uint32_t version;
+    uint32_t record_size;
+    uint64_t capacity;
+    alignas(64) std::atomic<uint64_t> head;
+};
+constexpr size_t HEADER_BYTES = 4096;
+static_assert(sizeof(EventRingHeader) <= HEADER_BYTES, "header must fit its page");
+static_assert(std::atomic<uint64_t>::is_always_lock_free, "slots are shared across processes");
+
+// One cache-line pair per slot: the slot's sequence (WRITING while being
+// rewritten) followed by the record as words
+constexpr size_t RECORD_WORDS = sizeof(EventRecord) / sizeof(uint64_t);
+constexpr uint64_t WRITING = UINT64_MAX;
+struct Slot {
+    std::atomic<uint64_t> seq;
+    std::atomic<uint64_t> words[RECORD_WORDS];
+    uint64_t padding[16 - 1 - RECORD_WORDS];
+};
+static_assert(sizeof(EventRecord) % sizeof(uint64_t) == 0, "records are whole words");
+static_assert(sizeof(Slot) == 128, "slots are two cache lines");
+
+EventRingHeader* header_of(void* mapping) {
+    return static_cast<EventRingHeader*>(mapping);
+}
+
+Slot* slots_of(void* mapping) {
+    return reinterpret_cast<Slot*>(static_cast<char*>(mapping) + HEADER_BYTES);
+}
+
+size_t round_up_pow2(size_t n) {
+    size_t p = 2;
+    while (p < n) p <<= 1;
+    return p;
+}
+
+// Copy out event `sequence`; false if the slot no longer holds it
+bool read_slot(const Slot& slot, uint64_t sequence, EventRecord& out) {
+    if (slot.seq.load(std::memory_order_acquire) != sequence) {
+        return false;
+    }
+    uint64_t words[RECORD_WORDS];
+    for (size_t i = 0; i < RECORD_WORDS; ++i) {
+        words[i] = slot.words[i].load(std::memory_order_relaxed);
+    }
+    std::atomic_thread_fence(std::memory_order_acquire);
+    if (slot.seq.load(std::memory_order_relaxed) != sequence) {
+        return false;
+    }
+    std::memcpy(&out, words, sizeof(EventRecord));
+    return true;
+}
+
+} // namespace
+
+// =============================================================================
+// EventRing
+// =============================================================================
+
+std::unique_ptr<EventRing> EventRing::create(const std::string& path, size_t capacity) {
+    capacity = round_up_pow2(capacity);
+    const size_t bytes = HEADER_BYTES + capacity * sizeof(Slot);
+
+    // A new inode, so readers of a previous ring are never truncated under
+    ::unlink(path.c_str());
+    int fd = ::open(path.c_str(), O_RDWR | O_CREAT | O_EXCL, 0644);
+    if (fd < 0) {
+        return nullptr;
+    }
+    if (::ftruncate(fd, static_cast<off_t>(bytes)) != 0) {
+        ::close(fd);
+        return nullptr;
+    }
+    void* mapping = ::mmap(nullptr, bytes, PROT_READ | PROT_WRITE, MAP_SHARED, fd, 0);
+    ::close(fd);
+    if (mapping == MAP_FAILED) {
+        return nullptr;
+    }
+
+    // The file is zero-filled: every slot starts at sequence 0, head at 0
+    EventRingHeader* header = header_of(mapping);
+    header->version = EVENT_RING_VERSION;
+    header->record_size = sizeof(EventRecord);
+    header->capacity = capacity;
+    header->magic.store(EVENT_RING_MAGIC, std::memory_order_release);
+
+    return std::unique_ptr<EventRing>(new EventRing(path, mapping, bytes, capacity));
+}
+
+EventRing::EventRing(std::string path, void* mapping, size_t bytes, size_t capacity)
+    : path_(std::move(path)), mapping_(mapping), mapped_bytes_(bytes), capacity_(capacity) {}
+
+EventRing::~EventRing() {
+    // The file stays so readers can drain what was published
+    ::munmap(mapping_, mapped_bytes_);
+}
+
+uint64_t EventRing::publish(EventRecord record) {
+    record.sequence = ++head_;
+    uint64_t words[RECORD_WORDS];
+    std::memcpy(words, &record, sizeof(EventRecord));
+
+    Slot& slot = slots_of(mapping_)[record.sequence & (capacity_ - 1)];
+    slot.seq.store(WRITING, std::memory_order_relaxed);
+    std::atomic_thread_fence(std::memory_order_release);
+    for (size_t i = 0; i < RECORD_WORDS; ++i) {
+        slot.words[i].store(words[i], std::memory_order_relaxed);
+    }
+    slot.seq.store(record.sequence, std::memory_order_release);
+
+    header_of(mapping_)->head.store(record.sequence, std::memory_order_release);
+    return record.sequence;
+}
+
+uint64_t EventRing::head() const {
+    return header_of(mapping_)->head.load(std::memory_order_acquire);
+}
+
+// =============================================================================
+// EventRingReader
+// =============================================================================
+
+std::unique_ptr<EventRingReader> EventRingReader::open(const std::string& path) {
+    int fd = ::open(path.c_str(), O_RDONLY);
+    if (fd < 0) {
+        return nullptr;
+    }
+
+    struct stat st{};
+    if (::fstat(fd, &st) != 0 || static_cast<size_t>(st.st_size) < HEADER_BYTES) {
+        ::close(fd);
+        return nullptr;
+    }
+
+    const size_t bytes = static_cast<size_t>(st.st_size);
+    void* mapping = ::mmap(nullptr, bytes, PROT_READ, MAP_SHARED, fd, 0);
+    ::close(fd);
+    if (mapping == MAP_FAILED) {
+        return nullptr;
+    }
+
+    const EventRingHeader* header = header_of(mapping);
+    const size_t capacity = header->capacity;
+    if (header->magic.load(std::memory_order_acquire) != EVENT_RING_MAGIC ||
+        header->version != EVENT_RING_VERSION ||
+        header->record_size != sizeof(EventRecord) ||
+        capacity == 0 || (capacity & (capacity - 1)) != 0 ||
+        (bytes - HEADER_BYTES) / sizeof(Slot) < capacity) {
+        ::munmap(mapping, bytes);
+        return nullptr;
+    }
+
+    return std::unique_ptr<EventRingReader>(new EventRingReader(mapping, bytes, capacity));
+}
+
+EventRingReader::~EventRingReader() {
+    ::munmap(mapping_, mapped_bytes_);
+}
+
+uint64_t EventRingReader::head() const {
+    return header_of(mapping_)->head.load(std::memory_order_acquire);
+}
+
+size_t EventRingReader::poll(uint64_t& cursor, EventRecord* out, size_t max,
+                             uint64_t* missed) const {
+    const Slot* slots = slots_of(mapping_);
+    const uint64_t head = this->head();
+    uint64_t lost = 0;
+    uint64_t next = cursor + 1;
+    size_t count = 0;
+
+    while (count < max && next <= head) {
+        if (read_slot(slots[next & (capacity_ - 1)], next, out[count])) {
+            ++count;
+            ++next;
+            continue;
+        }
+        // Lapped by the writer: resume at the oldest event still held
+        const uint64_t now = this->head();
+        const uint64_t oldest = now >= capacity_ ? now - capacity_ + 1 : 1;
+        const uint64_t resume = next < oldest ? oldest : next + 1;
+        lost += resume - next;
+        next = resume;
+    }
+
+    cursor = next - 1;
+    if (missed) {
+        *missed += lost;
+    }
+    return count;
+}
+
+// =============================================================================
+// EventPublisher
+// =============================================================================
+
+void EventPublisher::on_trade(const Trade& trade) {
+    on_trade_batch(&trade, 1);
+}
+
+void EventPublisher::on_trade_batch(const Trade* trades, size_t count) {
+    {
+        std::lock_guard lock(mutex_);
+        for (size_t i = 0; i < count; ++i) {
+            const Trade& trade = trades[i];
+            EventRecord record{};
+            record.symbol_id = trade.symbol_id;
+            record.type = EventType::Trade;
+            record.side = static_cast<uint8_t>(trade.aggressor_side);
+            record.trade.trade_id = trade.id;
+            record.trade.buy_order_id = trade.buy_order_id;
+            record.trade.sell_order_id = trade.sell_order_id;
+            record.trade.buyer_account_id = trade.buyer_account_id;
+            record.trade.seller_account_id = trade.seller_account_id;
+            record.trade.price = trade.price;
+            record.trade.quantity = trade.quantity;
+            record.trade.timestamp_ns = trade.timestamp.count();
+            ring_.publish(record);
+        }
+    }
+    if (next_) {
+        next_->on_trade_batch(trades, count);
+    }
+}
+
+void EventPublisher::on_order_filled(const Order& order) {
+    publish_order(EventType::OrderFilled, order, 0);
+    if (next_) {
+        next_->on_order_filled(order);
+    }
+}
+
+void EventPublisher::on_order_partially_filled(const Order& order, Quantity fill_qty) {
+    publish_order(EventType::OrderPartiallyFilled, order, fill_qty);
+    if (next_) {
+        next_->on_order_partially_filled(order, fill_qty);
+    }
+}
+
+void EventPublisher::on_order_cancelled(const Order& order) {
+    publish_order(EventType::OrderCancelled, order, 0);
+    if (next_) {
+        next_->on_order_cancelled(order);
+    }
+}
+
+void EventPublisher::on_book_delta(uint64_t symbol_id, const BookDelta& delta) {
+    EventRecord record{};
+    record.symbol_id = symbol_id;
+    record.type = EventType::BookDelta;
+    record.side = static_cast<uint8_t>(delta.side);
+    record.delta.book_sequence = delta.sequence;
+    record.delta.price = delta.price;
+    record.delta.quantity = delta.quantity;
+    record.delta.order_count = delta.order_count;
+
+    std::lock_guard lock(mutex_);
+    ring_.publish(record);
+}
+
+void EventPublisher::publish_order(EventType type, const Order& order, Quantity fill_qty) {
+    EventRecord record{};
+    record.symbol_id = order.symbol_id;
+    record.type = type;
+    record.side = static_cast<uint8_t>(order.side);
+    record.order.order_id = order.id;
+    record.order.account_id = order.account_id;
+    record.order.price = order.price;
+    record.order.quantity = order.quantity;
+    record.order.filled = order.filled;
+    record.order.fill_quantity = fill_qty;
+    record.order.timestamp_ns = order.timestamp.count();
+
+    std::lock_guard lock(mutex_);
+    ring_.publish(record);
+}
+
+} // namespace lux
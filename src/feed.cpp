@@ -3,6 +3,8 @@
 // =============================================================================
 
 #include "lux/feed.hpp"
+#include "lux/fixed_point.hpp"
+#include "lux/tracing.hpp"
 #include <chrono>
 #include <algorithm>
 #include <cmath>
@@ -13,15 +15,35 @@ namespace lux {
 // Constructor
 // =============================================================================
 
-LXFeed::LXFeed(LXOracle& oracle) : oracle_(oracle) {}
+LXFeed::LXFeed(LXOracle& oracle) : oracle_(oracle) {
+    price_tables_.push_back(std::make_unique<PriceTable>(64));
+    price_table_.store(price_tables_.back().get(), std::memory_order_release);
+    oracle_subscription_ = oracle_.subscribe([this](const LXOracle::PriceChangeEvent& event) {
+        on_oracle_update(event);
+    });
+}
+
+LXFeed::~LXFeed() {
+    oracle_.unsubscribe(oracle_subscription_);
+}
 
 // =============================================================================
 // Configuration
 // =============================================================================
 
 void LXFeed::set_mark_price_config(uint32_t market_id, const MarkPriceConfig& config) {
-    std::unique_lock lock(config_mutex_);
-    mark_configs_[market_id] = config;
+    {
+        std::unique_lock lock(config_mutex_);
+        mark_configs_[market_id] = config;
+    }
+
+    {
+        std::unique_lock lock(price_mutex_);
+        if (MarketPriceState* state = get_price_state(market_id)) {
+            state->ewma_window = config.premium_ewma_window;
+        }
+    }
+    refresh_price_record(market_id);
 }
 
 std::optional<MarkPriceConfig> LXFeed::get_mark_price_config(uint32_t market_id) const {
@@ -132,14 +154,21 @@ void LXFeed::update_last_price(uint32_t market_id, I128 price_x18, uint64_t time
     std::unique_lock lock(price_mutex_);
     MarketPriceState* state = get_price_state(market_id);
     if (!state) {
-        price_states_[market_id] = MarketPriceState{};
+        price_states_[market_id] = new_price_state(market_id);
         state = &price_states_[market_id];
     }
 
     state->last_price_x18 = price_x18;
     state->last_price_time = timestamp;
+    lock.unlock();
 
     total_price_updates_.fetch_add(1, std::memory_order_relaxed);
+    refresh_price_record(market_id);
+
+    if (price_listener_) {
+        price_listener_(market_id, PriceType::LAST, price_x18);
+    }
+    fire_triggers(market_id);
 }
 
 // =============================================================================
@@ -162,12 +191,15 @@ void LXFeed::update_bbo(uint32_t market_id, I128 best_bid_x18, I128 best_ask_x18
     std::unique_lock lock(price_mutex_);
     MarketPriceState* state = get_price_state(market_id);
     if (!state) {
-        price_states_[market_id] = MarketPriceState{};
+        price_states_[market_id] = new_price_state(market_id);
         state = &price_states_[market_id];
     }
 
     state->best_bid_x18 = best_bid_x18;
     state->best_ask_x18 = best_ask_x18;
+    lock.unlock();
+
+    refresh_price_record(market_id);
 }
 
 // =============================================================================
@@ -216,6 +248,75 @@ std::optional<LXFeed::AllPrices> LXFeed::get_all_prices(uint32_t market_id) cons
     return prices;
 }
 
+void LXFeed::set_price_listener(PriceListener listener) {
+    price_listener_ = std::move(listener);
+}
+
+void LXFeed::on_oracle_update(const LXOracle::PriceChangeEvent& event) {
+    std::vector<uint32_t> markets;
+    {
+        std::shared_lock lock(market_mutex_);
+        auto it = asset_markets_.find(event.asset_id);
+        if (it == asset_markets_.end()) return;
+        markets = it->second;
+    }
+    for (uint32_t market_id : markets) {
+        refresh_price_record(market_id);
+        publish_prices(market_id);
+        fire_triggers(market_id);
+    }
+}
+
+// =============================================================================
+// Published Price Table
+// =============================================================================
+
+size_t LXFeed::read_price_table(std::vector<PriceRecord>& out) const {
+    out.clear();
+    // Size first: a slot below the size is live in any table published after
+    const size_t size = price_table_size_.load(std::memory_order_acquire);
+    const PriceTable* table = price_table_.load(std::memory_order_acquire);
+    out.reserve(size);
+    for (size_t i = 0; i < size && i < table->capacity; ++i) {
+        PriceRecord record = table->slots[i].load();
+        if (record.active) {
+            out.push_back(record);
+        }
+    }
+    return out.size();
+}
+
+void LXFeed::refresh_price_record(uint32_t market_id) {
+    std::lock_guard lock(price_table_mutex_);
+    auto slot_it = price_slots_.find(market_id);
+    if (slot_it == price_slots_.end()) {
+        return;
+    }
+
+    // Computed under the table lock so records are stored in input order
+    PriceRecord record{};
+    SeqLock<PriceRecord>& slot = price_table_.load(std::memory_order_relaxed)->slots[slot_it->second];
+    record.market_id = market_id;
+    record.active = true;
+    record.version = slot.load().version + 1;
+    record.prices = get_all_prices(market_id).value_or(AllPrices{});
+    slot.store(record);
+}
+
+
+void LXFeed::publish_prices(uint32_t market_id) {
+    if (!price_listener_) {
+        return;
+    }
+    auto mark = get_mark_price(market_id);
+    if (!mark) {
+        return;
+    }
+    TraceSpan span(TracePoint::FeedUpdate, market_id);
+    price_listener_(market_id, PriceType::INDEX, mark->index_px_x18);
+    price_listener_(market_id, PriceType::MARK, mark->mark_px_x18);
+}
+
 std::vector<std::pair<uint32_t, LXFeed::AllPrices>>
 LXFeed::get_multiple_market_prices(const std::vector<uint32_t>& market_ids) const {
     std::vector<std::pair<uint32_t, AllPrices>> results;
@@ -268,34 +369,30 @@ void LXFeed::record_premium(uint32_t market_id, I128 premium_x18, uint64_t times
     std::unique_lock lock(price_mutex_);
     MarketPriceState* state = get_price_state(market_id);
     if (!state) {
-        price_states_[market_id] = MarketPriceState{};
-        state = &price_states_[market_id];
+        state = &price_states_.emplace(market_id, new_price_state(market_id)).first->second;
     }
 
-    state->premium_history.emplace_back(timestamp, premium_x18);
-
-    // Keep only last hour of premium data
-    constexpr uint64_t MAX_HISTORY = 3600;
-    uint64_t cutoff = timestamp > MAX_HISTORY ? timestamp - MAX_HISTORY : 0;
-
-    auto new_begin = std::lower_bound(state->premium_history.begin(),
-                                       state->premium_history.end(), cutoff,
-        [](const auto& p, uint64_t t) { return p.first < t; });
-
-    if (new_begin != state->premium_history.begin()) {
-        state->premium_history.erase(state->premium_history.begin(), new_begin);
+    // Age the running sums to the newer of the two times; a late sample
+    // joins with the weight its age gives it
+    const double tau = std::max(1.0, static_cast<double>(state->ewma_window) / 2.0);
+    const double value = x18::to_double(premium_x18);
+    if (timestamp >= state->ewma_time) {
+        const double decay = std::exp(-static_cast<double>(timestamp - state->ewma_time) / tau);
+        state->ewma_sum = state->ewma_sum * decay + value;
+        state->ewma_weight = state->ewma_weight * decay + 1.0;
+        state->ewma_time = timestamp;
+    } else {
+        const double weight = std::exp(-static_cast<double>(state->ewma_time - timestamp) / tau);
+        state->ewma_sum += weight * value;
+        state->ewma_weight += weight;
     }
-
-    // Update EWMA
+    state->premium_ewma_x18 = x18::from_double(state->ewma_sum / state->ewma_weight);
     lock.unlock();
-    std::shared_lock config_lock(config_mutex_);
-    auto config_it = mark_configs_.find(market_id);
-    uint64_t window = (config_it != mark_configs_.end()) ?
-        config_it->second.premium_ewma_window : 300; // Default 5 minutes
-    config_lock.unlock();
 
-    lock.lock();
-    state->premium_ewma_x18 = calculate_ewma(state->premium_history, window, timestamp);
+    // The new EWMA moves the mark
+    refresh_price_record(market_id);
+    publish_prices(market_id);
+    fire_triggers(market_id);
 }
 
 // =============================================================================
@@ -331,7 +428,7 @@ uint64_t LXFeed::funding_interval(uint32_t market_id) const {
 I128 LXFeed::max_funding_rate(uint32_t market_id) const {
     std::shared_lock lock(config_mutex_);
     auto it = funding_params_.find(market_id);
-    if (it == funding_params_.end()) return x18::from_double(0.01); // Default 1%
+    if (it == funding_params_.end()) return x18::from_bps(100); // Default 1%
     return it->second.max_funding_rate_x18;
 }
 
@@ -348,8 +445,8 @@ std::optional<I128> LXFeed::predicted_funding_rate(uint32_t market_id) const {
         params = params_it->second;
     } else {
         params.funding_interval = 28800;
-        params.max_funding_rate_x18 = x18::from_double(0.01);
-        params.interest_rate_x18 = x18::from_double(0.0001); // 0.01%
+        params.max_funding_rate_x18 = x18::from_bps(100);
+        params.interest_rate_x18 = x18::from_bps(1); // 0.01%
         params.premium_fraction_x18 = X18_ONE;
         params.use_twap_premium = true;
     }
@@ -359,32 +456,47 @@ std::optional<I128> LXFeed::predicted_funding_rate(uint32_t market_id) const {
 }
 
 void LXFeed::calculate_funding_rate(uint32_t market_id) {
-    std::unique_lock lock(price_mutex_);
-    MarketPriceState* state = get_price_state(market_id);
-    if (!state) {
-        price_states_[market_id] = MarketPriceState{};
-        state = &price_states_[market_id];
-    }
+    calculate_funding_rates({market_id});
+}
 
+std::vector<std::pair<uint32_t, I128>> LXFeed::calculate_funding_rates(const std::vector<uint32_t>& market_ids) {
+    std::vector<std::pair<uint32_t, I128>> rates;
+    rates.reserve(market_ids.size());
+    const uint64_t now = current_timestamp();
+
+    std::unique_lock lock(price_mutex_);
     std::shared_lock config_lock(config_mutex_);
-    auto params_it = funding_params_.find(market_id);
-    FundingParams params;
-    if (params_it != funding_params_.end()) {
-        params = params_it->second;
-    } else {
-        params.funding_interval = 28800;
-        params.max_funding_rate_x18 = x18::from_double(0.01);
-        params.interest_rate_x18 = x18::from_double(0.0001);
-        params.premium_fraction_x18 = X18_ONE;
-        params.use_twap_premium = true;
-    }
-    config_lock.unlock();
+    for (uint32_t market_id : market_ids) {
+        MarketPriceState* state = get_price_state(market_id);
+        if (!state) {
+            MarketPriceState fresh{};
+            auto mark_it = mark_configs_.find(market_id);
+            if (mark_it != mark_configs_.end()) {
+                fresh.ewma_window = mark_it->second.premium_ewma_window;
+            }
+            state = &price_states_.emplace(market_id, fresh).first->second;
+        }
+
+        auto params_it = funding_params_.find(market_id);
+        FundingParams params;
+        if (params_it != funding_params_.end()) {
+            params = params_it->second;
+        } else {
+            params.funding_interval = 28800;
+            params.max_funding_rate_x18 = x18::from_bps(100);
+            params.interest_rate_x18 = x18::from_bps(1);
+            params.premium_fraction_x18 = X18_ONE;
+            params.use_twap_premium = true;
+        }
 
-    state->current_funding_rate_x18 = compute_funding_rate(*state, params);
-    state->last_funding_calc_time = current_timestamp();
-    state->next_funding_time = state->last_funding_calc_time + params.funding_interval;
+        state->current_funding_rate_x18 = compute_funding_rate(*state, params);
+        state->last_funding_calc_time = now;
+        state->next_funding_time = now + params.funding_interval;
+        rates.emplace_back(market_id, state->current_funding_rate_x18);
+    }
 
-    funding_calculations_.fetch_add(1, std::memory_order_relaxed);
+    funding_calculations_.fetch_add(market_ids.size(), std::memory_order_relaxed);
+    return rates;
 }
 
 // =============================================================================
@@ -433,6 +545,119 @@ bool LXFeed::check_trigger(uint32_t market_id, TriggerType type,
     }
 }
 
+// =============================================================================
+// Batch Trigger Evaluation
+// =============================================================================
+
+uint64_t LXFeed::add_trigger(uint32_t market_id, TriggerType type, bool is_buy, I128 trigger_price_x18) {
+    const size_t t = static_cast<size_t>(type);
+    if (t >= PRICE_TRIGGER_TYPES) {
+        return 0;
+    }
+
+    std::lock_guard lock(trigger_mutex_);
+    TriggerLists& lists = trigger_lists_[market_id][t];
+    auto& side = is_buy ? lists.buys : lists.sells;
+    const uint64_t id = next_trigger_id_++;
+    auto pos = std::upper_bound(side.begin(), side.end(), trigger_price_x18,
+        [](I128 price, const TriggerThreshold& th) { return price < th.price_x18; });
+    side.insert(pos, TriggerThreshold{trigger_price_x18, id});
+    trigger_index_.emplace(id, TriggerLocation{market_id, type, is_buy, trigger_price_x18});
+    trigger_count_.fetch_add(1, std::memory_order_relaxed);
+    return id;
+}
+
+bool LXFeed::remove_trigger(uint64_t id) {
+    std::lock_guard lock(trigger_mutex_);
+    auto it = trigger_index_.find(id);
+    if (it == trigger_index_.end()) {
+        return false;
+    }
+    const TriggerLocation& loc = it->second;
+    TriggerLists& lists = trigger_lists_[loc.market_id][static_cast<size_t>(loc.type)];
+    auto& side = loc.is_buy ? lists.buys : lists.sells;
+    auto pos = std::lower_bound(side.begin(), side.end(), loc.price_x18,
+        [](const TriggerThreshold& th, I128 price) { return th.price_x18 < price; });
+    while (pos->id != id) {
+        ++pos;
+    }
+    side.erase(pos);
+    trigger_index_.erase(it);
+    trigger_count_.fetch_sub(1, std::memory_order_relaxed);
+    return true;
+}
+
+size_t LXFeed::evaluate_triggers(uint32_t market_id, TriggerType type, I128 price_x18,
+                                 std::vector<FiredTrigger>& out) {
+    const size_t t = static_cast<size_t>(type);
+    if (t >= PRICE_TRIGGER_TYPES) {
+        return 0;
+    }
+
+    std::lock_guard lock(trigger_mutex_);
+    auto market_it = trigger_lists_.find(market_id);
+    if (market_it == trigger_lists_.end()) {
+        return 0;
+    }
+    TriggerLists& lists = market_it->second[t];
+    const size_t before = out.size();
+
+    // Buys with trigger >= price: a suffix
+    auto buys = std::lower_bound(lists.buys.begin(), lists.buys.end(), price_x18,
+        [](const TriggerThreshold& th, I128 price) { return th.price_x18 < price; });
+    for (auto it = buys; it != lists.buys.end(); ++it) {
+        out.push_back({it->id, market_id, type, true, it->price_x18, price_x18});
+        trigger_index_.erase(it->id);
+    }
+    lists.buys.erase(buys, lists.buys.end());
+
+    // Sells with trigger <= price: a prefix
+    auto sells = std::upper_bound(lists.sells.begin(), lists.sells.end(), price_x18,
+        [](I128 price, const TriggerThreshold& th) { return price < th.price_x18; });
+    for (auto it = lists.sells.begin(); it != sells; ++it) {
+        out.push_back({it->id, market_id, type, false, it->price_x18, price_x18});
+        trigger_index_.erase(it->id);
+    }
+    lists.sells.erase(lists.sells.begin(), sells);
+
+    const size_t fired = out.size() - before;
+    trigger_count_.fetch_sub(fired, std::memory_order_relaxed);
+    return fired;
+}
+
+size_t LXFeed::evaluate_triggers(uint32_t market_id, std::vector<FiredTrigger>& out) {
+    if (trigger_count() == 0) {
+        return 0;
+    }
+    const auto mark = mark_price(market_id);
+    auto last = last_price(market_id);
+    if (!last) last = mark;
+
+    size_t fired = 0;
+    if (last) {
+        fired += evaluate_triggers(market_id, TriggerType::STOP_LOSS, *last, out);
+        fired += evaluate_triggers(market_id, TriggerType::TAKE_PROFIT, *last, out);
+    }
+    if (mark) {
+        fired += evaluate_triggers(market_id, TriggerType::LIQUIDATION, *mark, out);
+    }
+    return fired;
+}
+
+void LXFeed::set_trigger_listener(TriggerListener listener) {
+    trigger_listener_ = std::move(listener);
+}
+
+void LXFeed::fire_triggers(uint32_t market_id) {
+    if (!trigger_listener_ || trigger_count() == 0) {
+        return;
+    }
+    std::vector<FiredTrigger> fired;
+    if (evaluate_triggers(market_id, fired) > 0) {
+        trigger_listener_(fired);
+    }
+}
+
 std::optional<I128> LXFeed::liquidation_price(uint32_t market_id, const LXPosition& position,
                                                I128 maintenance_margin_x18) const {
     if (position.size_x18 == 0) return std::nullopt;
@@ -464,17 +689,52 @@ int32_t LXFeed::register_market(uint32_t market_id, uint64_t asset_id) {
     }
 
     market_assets_[market_id] = asset_id;
+    asset_markets_[asset_id].push_back(market_id);
 
     // Initialize price state
     std::unique_lock price_lock(price_mutex_);
-    price_states_[market_id] = MarketPriceState{};
+    price_states_[market_id] = new_price_state(market_id);
+    price_lock.unlock();
+    lock.unlock();
+
+    // Give the market a slot in the price table, growing it when full
+    {
+        std::lock_guard table_lock(price_table_mutex_);
+        size_t slot;
+        if (!free_price_slots_.empty()) {
+            slot = free_price_slots_.back();
+            free_price_slots_.pop_back();
+        } else {
+            slot = price_table_size_.load(std::memory_order_relaxed);
+            PriceTable* table = price_table_.load(std::memory_order_relaxed);
+            if (slot == table->capacity) {
+                auto grown = std::make_unique<PriceTable>(table->capacity * 2);
+                for (size_t i = 0; i < slot; ++i) {
+                    grown->slots[i].store(table->slots[i].load());
+                }
+                price_tables_.push_back(std::move(grown));
+                price_table_.store(price_tables_.back().get(), std::memory_order_release);
+            }
+            price_table_size_.store(slot + 1, std::memory_order_release);
+        }
+        price_slots_[market_id] = slot;
+    }
+    refresh_price_record(market_id);
 
     return errors::OK;
 }
 
 void LXFeed::unregister_market(uint32_t market_id) {
     std::unique_lock lock(market_mutex_);
-    market_assets_.erase(market_id);
+    auto it = market_assets_.find(market_id);
+    if (it != market_assets_.end()) {
+        auto& markets = asset_markets_[it->second];
+        markets.erase(std::remove(markets.begin(), markets.end(), market_id), markets.end());
+        if (markets.empty()) {
+            asset_markets_.erase(it->second);
+        }
+        market_assets_.erase(it);
+    }
 
     std::unique_lock price_lock(price_mutex_);
     price_states_.erase(market_id);
@@ -483,6 +743,37 @@ void LXFeed::unregister_market(uint32_t market_id) {
     mark_configs_.erase(market_id);
     funding_params_.erase(market_id);
     trigger_rules_.erase(market_id);
+    config_lock.unlock();
+
+    {
+        std::lock_guard trigger_lock(trigger_mutex_);
+        auto triggers = trigger_lists_.find(market_id);
+        if (triggers != trigger_lists_.end()) {
+            for (const TriggerLists& lists : triggers->second) {
+                for (const auto* side : {&lists.buys, &lists.sells}) {
+                    for (const TriggerThreshold& th : *side) {
+                        trigger_index_.erase(th.id);
+                    }
+                    trigger_count_.fetch_sub(side->size(), std::memory_order_relaxed);
+                }
+            }
+            trigger_lists_.erase(triggers);
+        }
+    }
+    price_lock.unlock();
+    lock.unlock();
+
+    std::lock_guard table_lock(price_table_mutex_);
+    auto slot_it = price_slots_.find(market_id);
+    if (slot_it != price_slots_.end()) {
+        SeqLock<PriceRecord>& slot = price_table_.load(std::memory_order_relaxed)->slots[slot_it->second];
+        PriceRecord record = slot.load();
+        record.active = false;
+        ++record.version;
+        slot.store(record);
+        free_price_slots_.push_back(slot_it->second);
+        price_slots_.erase(slot_it);
+    }
 }
 
 bool LXFeed::market_exists(uint32_t market_id) const {
@@ -490,6 +781,12 @@ bool LXFeed::market_exists(uint32_t market_id) const {
     return market_assets_.find(market_id) != market_assets_.end();
 }
 
+std::vector<uint32_t> LXFeed::markets_for_asset(uint64_t asset_id) const {
+    std::shared_lock lock(market_mutex_);
+    auto it = asset_markets_.find(asset_id);
+    return it != asset_markets_.end() ? it->second : std::vector<uint32_t>{};
+}
+
 // =============================================================================
 // Statistics
 // =============================================================================
@@ -517,29 +814,14 @@ const LXFeed::MarketPriceState* LXFeed::get_price_state(uint32_t market_id) cons
     return (it != price_states_.end()) ? &it->second : nullptr;
 }
 
-I128 LXFeed::calculate_ewma(const std::vector<std::pair<uint64_t, I128>>& history,
-                             uint64_t window_seconds, uint64_t current_time) const {
-    if (history.empty()) return 0;
-
-    // EWMA with decay factor based on time
-    double decay = 2.0 / (static_cast<double>(window_seconds) + 1.0);
-    double ewma = 0.0;
-    double weight_sum = 0.0;
-    uint64_t prev_time = current_time - window_seconds;
-
-    for (const auto& [timestamp, value] : history) {
-        if (timestamp < current_time - window_seconds) continue;
-
-        double age = static_cast<double>(current_time - timestamp);
-        double weight = std::exp(-decay * age / static_cast<double>(window_seconds));
-
-        ewma += weight * x18::to_double(value);
-        weight_sum += weight;
+LXFeed::MarketPriceState LXFeed::new_price_state(uint32_t market_id) const {
+    MarketPriceState state{};
+    std::shared_lock lock(config_mutex_);
+    auto it = mark_configs_.find(market_id);
+    if (it != mark_configs_.end()) {
+        state.ewma_window = it->second.premium_ewma_window;
     }
-
-    if (weight_sum == 0) return 0;
-
-    return x18::from_double(ewma / weight_sum);
+    return state;
 }
 
 I128 LXFeed::compute_funding_rate(const MarketPriceState& state,
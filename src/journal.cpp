@@ -0,0 +1,222 @@
+// =============================================================================
+// journal.cpp - Memory-mapped write-ahead journal
+// =============================================================================
+
+#include "lux/journal.hpp"
+#include <atomic>
+#include <cstring>
+
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+
+namespace lux {
+
+namespace {
+
+constexpr uint64_t JOURNAL_MAGIC = 0x4c55584a524e4c31ull;  // "LUXJRNL1"
+constexpr uint32_t JOURNAL_VERSION = 1;
+
+// First page of the file; records start at HEADER_BYTES
+struct JournalHeader {
+    uint64_t magic;
+    uint32_t version;
+    uint32_t record_size;
+    std::atomic<uint64_t> committed;
+};
+constexpr size_t HEADER_BYTES = 4096;
+static_assert(sizeof(JournalHeader) <= HEADER_BYTES, "header must fit its page");
+
+JournalHeader* header_of(void* mapping) {
+    return static_cast<JournalHeader*>(mapping);
+}
+
+JournalRecord* records_of(void* mapping) {
+    return reinterpret_cast<JournalRecord*>(static_cast<char*>(mapping) + HEADER_BYTES);
+}
+
+} // namespace
+
+// =============================================================================
+// Journal
+// =============================================================================
+
+std::unique_ptr<Journal> Journal::open(const std::string& path, JournalConfig config) {
+    int fd = ::open(path.c_str(), O_RDWR | O_CREAT, 0644);
+    if (fd < 0) {
+        return nullptr;
+    }
+
+    struct stat st{};
+    if (::fstat(fd, &st) != 0) {
+        ::close(fd);
+        return nullptr;
+    }
+
+    std::unique_ptr<Journal> journal(new Journal(fd, config));
+    const bool fresh = static_cast<size_t>(st.st_size) < HEADER_BYTES;
+    size_t capacity = fresh ? config.growth_records
+                            : (static_cast<size_t>(st.st_size) - HEADER_BYTES) / sizeof(JournalRecord);
+    if (capacity == 0) {
+        capacity = config.growth_records;
+    }
+    if (!journal->map(capacity)) {
+        return nullptr;
+    }
+
+    JournalHeader* header = header_of(journal->mapping_);
+    if (fresh) {
+        header->magic = JOURNAL_MAGIC;
+        header->version = JOURNAL_VERSION;
+        header->record_size = sizeof(JournalRecord);
+        header->committed.store(0, std::memory_order_release);
+    } else if (header->magic != JOURNAL_MAGIC || header->version != JOURNAL_VERSION ||
+               header->record_size != sizeof(JournalRecord)) {
+        // Not ours: unmap without committing over it
+        ::munmap(journal->mapping_, journal->mapped_bytes_);
+        journal->mapping_ = nullptr;
+        return nullptr;
+    }
+
+    // Anything past the committed mark is an incomplete group; overwrite it
+    journal->count_ = header->committed.load(std::memory_order_acquire);
+    return journal;
+}
+
+Journal::Journal(int fd, JournalConfig config)
+    : fd_(fd), config_(config) {
+    if (config_.growth_records == 0) {
+        config_.growth_records = 1;
+    }
+}
+
+Journal::~Journal() {
+    if (mapping_) {
+        commit();
+        ::msync(mapping_, mapped_bytes_, MS_SYNC);
+        ::munmap(mapping_, mapped_bytes_);
+    }
+    ::close(fd_);
+}
+
+bool Journal::map(size_t capacity) {
+    const size_t bytes = HEADER_BYTES + capacity * sizeof(JournalRecord);
+    if (::ftruncate(fd_, static_cast<off_t>(bytes)) != 0) {
+        return false;
+    }
+    void* mapping = ::mmap(nullptr, bytes, PROT_READ | PROT_WRITE, MAP_SHARED, fd_, 0);
+    if (mapping == MAP_FAILED) {
+        return false;
+    }
+    if (mapping_) {
+        ::munmap(mapping_, mapped_bytes_);
+    }
+    mapping_ = mapping;
+    mapped_bytes_ = bytes;
+    capacity_ = capacity;
+    return true;
+}
+
+uint64_t Journal::append(JournalRecord record) {
+    if (count_ == capacity_) {
+        // Growth is the only syscall on the append path, once per segment
+        commit();
+        if (!map(capacity_ + config_.growth_records)) {
+            return 0;
+        }
+    }
+
+    record.sequence = count_ + 1;
+    std::memcpy(&records_of(mapping_)[count_], &record, sizeof(JournalRecord));
+    ++count_;
+
+    if (config_.commit_interval != 0 && ++since_commit_ >= config_.commit_interval) {
+        commit();
+    }
+    return record.sequence;
+}
+
+void Journal::commit() {
+    since_commit_ = 0;
+    header_of(mapping_)->committed.store(count_, std::memory_order_release);
+    if (config_.msync_on_commit) {
+        ::msync(mapping_, mapped_bytes_, MS_ASYNC);
+    }
+}
+
+uint64_t Journal::committed_sequence() const {
+    return header_of(mapping_)->committed.load(std::memory_order_acquire);
+}
+
+// =============================================================================
+// JournalReader
+// =============================================================================
+
+std::unique_ptr<JournalReader> JournalReader::open(const std::string& path) {
+    int fd = ::open(path.c_str(), O_RDONLY);
+    if (fd < 0) {
+        return nullptr;
+    }
+
+    struct stat st{};
+    if (::fstat(fd, &st) != 0 || static_cast<size_t>(st.st_size) < HEADER_BYTES) {
+        ::close(fd);
+        return nullptr;
+    }
+
+    const size_t bytes = static_cast<size_t>(st.st_size);
+    void* mapping = ::mmap(nullptr, bytes, PROT_READ, MAP_SHARED, fd, 0);
+    if (mapping == MAP_FAILED) {
+        ::close(fd);
+        return nullptr;
+    }
+
+    std::unique_ptr<JournalReader> reader(new JournalReader());
+    reader->fd_ = fd;
+    reader->mapping_ = mapping;
+    reader->mapped_bytes_ = bytes;
+
+    const JournalHeader* header = header_of(mapping);
+    if (header->magic != JOURNAL_MAGIC || header->version != JOURNAL_VERSION ||
+        header->record_size != sizeof(JournalRecord)) {
+        return nullptr;
+    }
+
+    const size_t capacity = (bytes - HEADER_BYTES) / sizeof(JournalRecord);
+    const uint64_t committed = header->committed.load(std::memory_order_acquire);
+    reader->records_ = records_of(mapping);
+    reader->count_ = committed < capacity ? committed : capacity;
+    return reader;
+}
+
+JournalReader::~JournalReader() {
+    if (mapping_) {
+        ::munmap(mapping_, mapped_bytes_);
+    }
+    if (fd_ >= 0) {
+        ::close(fd_);
+    }
+}
+
+size_t JournalReader::refresh() {
+    const uint64_t committed = header_of(mapping_)->committed.load(std::memory_order_acquire);
+    size_t capacity = (mapped_bytes_ - HEADER_BYTES) / sizeof(JournalRecord);
+    struct stat st{};
+    if (committed > capacity && ::fstat(fd_, &st) == 0 &&
+        static_cast<size_t>(st.st_size) > mapped_bytes_) {
+        const size_t bytes = static_cast<size_t>(st.st_size);
+        void* mapping = ::mmap(nullptr, bytes, PROT_READ, MAP_SHARED, fd_, 0);
+        if (mapping != MAP_FAILED) {
+            ::munmap(mapping_, mapped_bytes_);
+            mapping_ = mapping;
+            mapped_bytes_ = bytes;
+            records_ = records_of(mapping);
+            capacity = (bytes - HEADER_BYTES) / sizeof(JournalRecord);
+        }
+    }
+    count_ = committed < capacity ? committed : capacity;
+    return count_;
+}
+
+} // namespace lux
@@ -0,0 +1,141 @@
+// =============================================================================
+// liquidation.cpp - Parallel Liquidation Keeper
+// =============================================================================
+
+#include "lux/liquidation.hpp"
+#include <algorithm>
+#include <chrono>
+
+namespace lux {
+
+// =============================================================================
+// Lifecycle
+// =============================================================================
+
+LiquidationKeeper::LiquidationKeeper(LXVault& vault, LXBook& book, const LiquidationConfig& config)
+    : vault_(vault), book_(book), config_(config), pool_(config.threads) {
+    config_.max_batch = std::max<size_t>(1, config_.max_batch);
+    config_.max_slippage = std::max(0.0, config_.max_slippage);
+}
+
+uint64_t LiquidationKeeper::now_ns() {
+    return static_cast<uint64_t>(std::chrono::duration_cast<std::chrono::nanoseconds>(
+        std::chrono::steady_clock::now().time_since_epoch()).count());
+}
+
+// =============================================================================
+// Keeper Run
+// =============================================================================
+
+void LiquidationKeeper::evaluate(size_t index, uint32_t market_id, I128 mark_px_x18) {
+    CloseOut& plan = plans_[index];
+    plan.active = false;
+    plan.account = candidates_[index];
+
+    // The candidate list is a snapshot; margin may have been posted since
+    if (!vault_.is_liquidatable(plan.account)) {
+        return;
+    }
+    auto position = vault_.get_position(plan.account, market_id);
+    if (!position || position->size_x18 == 0) {
+        return;
+    }
+
+    // Close longs by selling, shorts by buying, no worse than the slippage
+    // bound around the mark
+    const bool is_buy = position->size_x18 < 0;
+    const I128 slippage = x18::mul(mark_px_x18, x18::from_double(config_.max_slippage));
+
+    LXOrder& order = plan.order;
+    order = LXOrder{};
+    order.market_id = market_id;
+    order.is_buy = is_buy;
+    order.kind = OrderKind::LIMIT;
+    order.size_x18 = is_buy ? -position->size_x18 : position->size_x18;
+    order.limit_px_x18 = is_buy ? mark_px_x18 + slippage : mark_px_x18 - slippage;
+    order.reduce_only = true;
+    order.tif = TIF::IOC;
+    plan.active = true;
+}
+
+LiquidationRun LiquidationKeeper::run(uint32_t market_id, I128 mark_px_x18, uint64_t mark_time_ns) {
+    std::lock_guard lock(run_mutex_);
+    LiquidationRun result;
+
+    // Worst margin ratio first, so a budget overrun hits the safest accounts
+    candidates_.clear();
+    result.candidates = vault_.liquidation_candidates(candidates_);
+    runs_.fetch_add(1, std::memory_order_relaxed);
+    candidates_seen_.fetch_add(result.candidates, std::memory_order_relaxed);
+    if (result.candidates == 0) {
+        return result;
+    }
+
+    plans_.resize(result.candidates);
+    pool_.parallel_for(result.candidates, [&](size_t i) { evaluate(i, market_id, mark_px_x18); });
+
+    // Submit in batches; the matching engine is single-writer per market,
+    // so batching saves per-order lookups rather than adding parallelism
+    size_t next = 0;
+    while (next < plans_.size()) {
+        senders_.clear();
+        orders_.clear();
+        for (; next < plans_.size() && orders_.size() < config_.max_batch; ++next) {
+            if (plans_[next].active) {
+                senders_.push_back(plans_[next].account);
+                orders_.push_back(plans_[next].order);
+            }
+        }
+        if (orders_.empty()) {
+            continue;
+        }
+
+        const uint64_t sent = now_ns();
+        const uint64_t waited = sent > mark_time_ns ? sent - mark_time_ns : 0;
+        results_.resize(orders_.size());
+        book_.place_orders(senders_.data(), orders_.data(), orders_.size(), results_.data());
+
+        for (size_t i = 0; i < orders_.size(); ++i) {
+            latency_.record(waited);
+            const I128 left = orders_[i].size_x18 - results_[i].filled_size_x18;
+            if (left <= 0) {
+                ++result.filled;
+            } else {
+                result.remainder_x18 += left;
+            }
+        }
+        result.orders += orders_.size();
+        if (waited > config_.latency_budget_ns) {
+            result.late += orders_.size();
+        }
+    }
+
+    // The book could not absorb everything; deleverage the rest against
+    // profitable positions
+    if (result.remainder_x18 > 0) {
+        vault_.run_adl(market_id);
+        adl_runs_.fetch_add(1, std::memory_order_relaxed);
+    }
+
+    orders_sent_.fetch_add(result.orders, std::memory_order_relaxed);
+    filled_.fetch_add(result.filled, std::memory_order_relaxed);
+    late_.fetch_add(result.late, std::memory_order_relaxed);
+    return result;
+}
+
+// =============================================================================
+// Statistics
+// =============================================================================
+
+LiquidationKeeper::Stats LiquidationKeeper::get_stats() const {
+    return Stats{
+        runs_.load(std::memory_order_relaxed),
+        candidates_seen_.load(std::memory_order_relaxed),
+        orders_sent_.load(std::memory_order_relaxed),
+        filled_.load(std::memory_order_relaxed),
+        late_.load(std::memory_order_relaxed),
+        adl_runs_.load(std::memory_order_relaxed)
+    };
+}
+
+} // namespace lux
@@ -3,9 +3,14 @@
 // =============================================================================
 
 #include "lux/lx.hpp"
+#include "lux/fixed_point.hpp"
+#include "lux/tracing.hpp"
 #include <chrono>
 #include <cstring>
 #include <algorithm>
+#include <unordered_map>
+#include <cmath>
+#include <stdexcept>
 
 namespace lux {
 
@@ -75,31 +80,22 @@ inline void encode_int128(uint8_t* out, I128 value) {
     }
 }
 
-// Encode I128 as 32-byte vector
-inline std::vector<uint8_t> encode_int128_vec(I128 value) {
-    std::vector<uint8_t> result(32, (value < 0) ? 0xFF : 0);
-    for (int i = 31; i >= 16; --i) {
-        result[i] = static_cast<uint8_t>(value & 0xFF);
-        value >>= 8;
-    }
-    return result;
+// Encode I128 as a one-word result
+inline size_t encode_int128_word(uint8_t* out, I128 value) {
+    encode_int128(out, value);
+    return 32;
 }
 
 // Encode success (1) or failure (0)
-inline std::vector<uint8_t> encode_bool(bool value) {
-    std::vector<uint8_t> result(32, 0);
-    result[31] = value ? 1 : 0;
-    return result;
+inline size_t encode_bool(uint8_t* out, bool value) {
+    std::memset(out, 0, 32);
+    out[31] = value ? 1 : 0;
+    return 32;
 }
 
 // Encode int32 error code
-inline std::vector<uint8_t> encode_int32(int32_t value) {
-    std::vector<uint8_t> result(32, (value < 0) ? 0xFF : 0);
-    result[28] = static_cast<uint8_t>((value >> 24) & 0xFF);
-    result[29] = static_cast<uint8_t>((value >> 16) & 0xFF);
-    result[30] = static_cast<uint8_t>((value >> 8) & 0xFF);
-    result[31] = static_cast<uint8_t>(value & 0xFF);
-    return result;
+inline size_t encode_int32(uint8_t* out, int32_t value) {
+    return encode_int128_word(out, value);
 }
 
 } // namespace abi
@@ -114,6 +110,7 @@ LX::LX()
     , vault_(std::make_unique<LXVault>())
     , book_(std::make_unique<LXBook>())
     , feed_(std::make_unique<LXFeed>(*oracle_))
+    , router_(std::make_unique<LXRouter>(*pool_))
     , running_(false)
     , start_time_(0) {
 
@@ -121,6 +118,26 @@ LX::LX()
     book_->set_settlement_callback([this](const std::vector<Trade>& trades) {
         return on_book_trades(trades);
     });
+
+    // Feed price moves fire resting stop / take-profit orders, and a new
+    // mark (pushed when the oracle updates the market's asset) marks that
+    // market's positions to market
+    feed_->set_price_listener([this](uint32_t market_id, PriceType type, I128 price_x18) {
+        book_->on_price(market_id, type, price_x18);
+        if (type == PriceType::MARK) {
+            vault_->update_mark_prices({{market_id, price_x18}});
+        }
+    });
+
+    // Liquidations close out at the feed's mark price
+    vault_->set_mark_price_callback([this](uint32_t market_id) {
+        return feed_->mark_price(market_id).value_or(0);
+    });
+
+    // Keep the router's pool graph current
+    pool_->set_liquidity_listener([this](const PoolKey& key, I128 liquidity) {
+        router_->on_pool_update(key, liquidity);
+    });
 }
 
 LX::~LX() {
@@ -137,8 +154,8 @@ void LX::initialize() {
     default_config.enable_hooks = true;
     default_config.enable_flash_loans = true;
     default_config.funding_interval = 28800; // 8 hours
-    default_config.default_maker_fee_x18 = x18::from_double(0.0002); // 0.02%
-    default_config.default_taker_fee_x18 = x18::from_double(0.0005); // 0.05%
+    default_config.default_maker_fee_x18 = x18::from_bps(2);   // 0.02%
+    default_config.default_taker_fee_x18 = x18::from_bps(5);   // 0.05%
 
     initialize(default_config);
 }
@@ -150,20 +167,43 @@ void LX::initialize(const Config& config) {
     // Set default funding params for feed
     FundingParams funding;
     funding.funding_interval = config.funding_interval;
-    funding.max_funding_rate_x18 = x18::from_double(0.01); // 1%
-    funding.interest_rate_x18 = x18::from_double(0.0001);  // 0.01%
+    funding.max_funding_rate_x18 = x18::from_bps(100); // 1%
+    funding.interest_rate_x18 = x18::from_bps(1);    // 0.01%
     funding.premium_fraction_x18 = X18_ONE;
     funding.use_twap_premium = true;
 
     // Configure mark price defaults
     MarkPriceConfig mark_config;
     mark_config.premium_ewma_window = 300; // 5 minutes
-    mark_config.impact_notional_x18 = x18::from_double(10000); // $10k
-    mark_config.max_premium_x18 = x18::from_double(0.05);  // 5%
-    mark_config.min_premium_x18 = x18::from_double(-0.05); // -5%
+    mark_config.impact_notional_x18 = x18::from_int(10000); // $10k
+    mark_config.max_premium_x18 = x18::from_bps(500);  // 5%
+    mark_config.min_premium_x18 = x18::from_bps(-500); // -5%
     mark_config.use_mid_price = true;
     mark_config.cap_to_oracle = true;
 
+    // Takes effect if the keeper has not run yet
+    liquidation_config_ = config.liquidation;
+
+    trade_split_parts_ = std::max<size_t>(1, config.trade_split_parts);
+
+    // Route book fills through the settlement pipeline instead of
+    // settling on the matching thread
+    if (config.async_settlement && !settlement_) {
+        settlement_ = std::make_unique<SettlementPipeline>(*vault_, config.settlement);
+        settlement_->set_account_resolver([this](uint64_t account_id) {
+            return book_->get_account(account_id);
+        });
+        book_->set_settlement_callback([this](const std::vector<Trade>& trades) {
+            for (const Trade& trade : trades) {
+                settlement_->publish(trade);
+            }
+            return errors::OK;
+        });
+        if (running_.load(std::memory_order_acquire)) {
+            settlement_->start();
+        }
+    }
+
     start_time_ = static_cast<uint64_t>(
         std::chrono::duration_cast<std::chrono::seconds>(
             std::chrono::system_clock::now().time_since_epoch()
@@ -186,6 +226,11 @@ void LX::start() {
         ).count()
     );
 
+    // Settlement first so it is draining before matching produces fills
+    if (settlement_) {
+        settlement_->start();
+    }
+
     // Start the matching engine
     book_->get_engine()->start();
 }
@@ -196,6 +241,11 @@ void LX::stop() {
     }
 
     book_->get_engine()->stop();
+
+    // Settles every fill matching published before it stopped
+    if (settlement_) {
+        settlement_->stop();
+    }
 }
 
 bool LX::is_running() const {
@@ -235,8 +285,8 @@ int32_t LX::create_perp_market(uint32_t market_id, uint64_t asset_id,
     // Set default funding params
     FundingParams funding;
     funding.funding_interval = 28800;
-    funding.max_funding_rate_x18 = x18::from_double(0.01);
-    funding.interest_rate_x18 = x18::from_double(0.0001);
+    funding.max_funding_rate_x18 = x18::from_bps(100);
+    funding.interest_rate_x18 = x18::from_bps(1);
     funding.premium_fraction_x18 = X18_ONE;
     funding.use_twap_premium = true;
     feed_->set_funding_params(market_id, funding);
@@ -244,9 +294,9 @@ int32_t LX::create_perp_market(uint32_t market_id, uint64_t asset_id,
     // Set default mark price config
     MarkPriceConfig mark_config;
     mark_config.premium_ewma_window = 300;
-    mark_config.impact_notional_x18 = x18::from_double(10000);
-    mark_config.max_premium_x18 = x18::from_double(0.05);
-    mark_config.min_premium_x18 = x18::from_double(-0.05);
+    mark_config.impact_notional_x18 = x18::from_int(10000);
+    mark_config.max_premium_x18 = x18::from_bps(500);
+    mark_config.min_premium_x18 = x18::from_bps(-500);
     mark_config.use_mid_price = true;
     mark_config.cap_to_oracle = true;
     feed_->set_mark_price_config(market_id, mark_config);
@@ -261,43 +311,145 @@ int32_t LX::create_perp_market(uint32_t market_id, uint64_t asset_id,
 BalanceDelta LX::swap_smart(const LXAccount& sender, const Currency& token_in,
                             const Currency& token_out, I128 amount_in_x18,
                             I128 min_amount_out_x18) {
-    // Smart order routing between AMM and CLOB
+    Route route = router_->find_route(token_in, token_out, amount_in_x18);
+    if (route.paths.empty() || route.amount_out_x18 < min_amount_out_x18) {
+        return {0, 0};
+    }
 
-    // First, check AMM price
-    PoolKey key;
+    const I128 amount_out = router_->execute(route);
     if (token_in < token_out) {
-        key.currency0 = token_in;
-        key.currency1 = token_out;
-    } else {
-        key.currency0 = token_out;
-        key.currency1 = token_in;
+        return {route.amount_in_x18, -amount_out};
     }
-    key.fee = fees::FEE_030; // Default 0.3%
-    key.tick_spacing = tick_spacings::TICK_SPACING_030;
+    return {-amount_out, route.amount_in_x18};
+}
 
-    bool zero_for_one = token_in == key.currency0;
+int32_t LX::link_pool(uint32_t market_id, const PoolKey& key, bool base_is_currency0) {
+    PoolHandle pool = pool_->find_pool(key);
+    if (!pool) {
+        return errors::POOL_NOT_INITIALIZED;
+    }
+    std::unique_lock lock(links_mutex_);
+    pool_links_[market_id] = PoolLink{pool, base_is_currency0};
+    return errors::OK;
+}
 
-    // Try AMM swap
+SwapParams LX::amm_params(const PoolLink& link, bool is_buy, I128 size_x18,
+                          I128 limit_price_x18) {
     SwapParams params;
-    params.zero_for_one = zero_for_one;
-    params.amount_specified = amount_in_x18;
-    params.sqrt_price_limit = 0; // No limit
+    params.zero_for_one = is_buy != link.base_is_currency0;
+    params.amount_specified = is_buy ? -size_x18 : size_x18;
+    params.sqrt_price_limit = 0;
+    if (limit_price_x18 > 0) {
+        // Pool price is currency1 per currency0
+        double price = x18::to_double(limit_price_x18);
+        if (!link.base_is_currency0) price = 1.0 / price;
+        const double sqrt_x96 = std::sqrt(price) * 79228162514264337593543950336.0;
+        params.sqrt_price_limit = sqrt_x96 >= static_cast<double>(tick_math::MAX_SQRT_RATIO)
+            ? tick_math::MAX_SQRT_RATIO - 1
+            : std::max(static_cast<I128>(sqrt_x96), tick_math::MIN_SQRT_RATIO + 1);
+    }
+    return params;
+}
 
-    if (pool_->pool_exists(key)) {
-        BalanceDelta amm_result = pool_->swap(key, params);
+LX::VenueSplit LX::plan_split(uint32_t market_id, const PoolLink& link, bool is_buy,
+                              I128 size_x18, I128 limit_price_x18) const {
+    VenueSplit split{0, 0, 0};
+
+    const size_t parts = static_cast<size_t>(
+        std::min<I128>(static_cast<I128>(trade_split_parts_), size_x18));
+    std::vector<I128> sizes(parts);
+    for (size_t k = 0; k < parts; ++k) {
+        const I128 n = static_cast<I128>(k + 1);
+        const I128 d = static_cast<I128>(parts);
+        sizes[k] = size_x18 / d * n + size_x18 % d * n / d;
+    }
 
-        I128 amount_out = zero_for_one ? -amm_result.amount1 : -amm_result.amount0;
+    // Cost (quote) of the first k+1 slices on each venue; a venue's curve
+    // ends where it runs out of depth inside the limit. Costs only rank
+    // the venues, so doubles are enough; sizes stay exact.
+    std::vector<double> book_cost;
+    std::vector<I128> book_px;
+    if (book_->market_exists(market_id)) {
+        // Read a few levels past what the order could need before the
+        // whole side
+        for (size_t levels = 64;; levels *= 4) {
+            book_cost.clear();
+            book_px.clear();
+            L2Snapshot l2 = book_->get_l2_snapshot(market_id, levels);
+            const std::vector<BookLevel>& side = is_buy ? l2.asks : l2.bids;
+
+            I128 taken = 0;
+            double cost = 0;
+            for (const BookLevel& level : side) {
+                const I128 px = static_cast<I128>(level.price) * X18_ONE / 100000000LL;
+                if (limit_price_x18 > 0 && (is_buy ? px > limit_price_x18 : px < limit_price_x18)) {
+                    break;
+                }
+                I128 available = static_cast<I128>(level.quantity) * X18_ONE / 100000000LL;
+                while (available > 0 && book_cost.size() < parts) {
+                    const I128 take = std::min(sizes[book_cost.size()] - taken, available);
+                    cost += x18::to_double(take) * x18::to_double(px);
+                    taken += take;
+                    available -= take;
+                    if (taken == sizes[book_cost.size()]) {
+                        book_cost.push_back(cost);
+                        book_px.push_back(px);
+                    }
+                }
+                if (book_cost.size() == parts) break;
+            }
+            if (book_cost.size() == parts || side.size() < levels) break;
+        }
+    }
+
+    std::vector<double> amm_cost;
+    std::vector<I128> amm_sizes(parts);
+    for (size_t k = 0; k < parts; ++k) {
+        amm_sizes[k] = amm_params(link, is_buy, sizes[k], 0).amount_specified;
+    }
+    const SwapParams limits = amm_params(link, is_buy, 0, limit_price_x18);
+    auto quotes = pool_->quote_swaps(link.pool, limits.zero_for_one, amm_sizes,
+                                     limits.sqrt_price_limit);
+    for (size_t k = 0; k < quotes.size(); ++k) {
+        const BalanceDelta& delta = quotes[k].delta;
+        const I128 base = link.base_is_currency0 ? delta.amount0 : delta.amount1;
+        const I128 quote = link.base_is_currency0 ? delta.amount1 : delta.amount0;
+        if ((base < 0 ? -base : base) != sizes[k]) break;  // Stopped at the limit
+        amm_cost.push_back(x18::to_double(quote < 0 ? -quote : quote));
+    }
 
-        if (amount_out >= min_amount_out_x18) {
-            return amm_result;
+    // Hand out slices by marginal price: cheapest for a buy, richest for a sell
+    size_t clob = 0, amm = 0;
+    auto marginal = [&](const std::vector<double>& cost, size_t n) {
+        const I128 base = sizes[n] - (n > 0 ? sizes[n - 1] : 0);
+        return (cost[n] - (n > 0 ? cost[n - 1] : 0.0)) / x18::to_double(base);
+    };
+    for (size_t slice = 0; slice < parts; ++slice) {
+        const bool clob_ok = clob < book_cost.size();
+        const bool amm_ok = amm < amm_cost.size();
+        if (!clob_ok && !amm_ok) break;
+
+        bool to_clob = clob_ok;
+        if (clob_ok && amm_ok) {
+            const double clob_px = marginal(book_cost, clob);
+            const double amm_px = marginal(amm_cost, amm);
+            to_clob = is_buy ? clob_px <= amm_px : clob_px >= amm_px;
         }
+        ++(to_clob ? clob : amm);
     }
 
-    // Fall back to CLOB if available
-    // Would need to map tokens to market_id
-    // For now, return empty if AMM failed
+    if (clob > 0) {
+        split.clob_size_x18 = sizes[clob - 1];
+        split.clob_limit_x18 = book_px[clob - 1];
+    }
+    if (amm > 0) {
+        split.amm_size_x18 = sizes[amm - 1];
+    }
 
-    return {0, 0};
+    // Equal slices round down; the dust goes to the book when it has the room
+    const I128 dust = (clob + amm == parts) ? size_x18 - split.clob_size_x18 - split.amm_size_x18 : 0;
+    (clob > 0 ? split.clob_size_x18 : split.amm_size_x18) += dust;
+    return split;
 }
 
 LX::TradeResult LX::trade(const LXAccount& sender, uint32_t market_id,
@@ -308,62 +460,65 @@ LX::TradeResult LX::trade(const LXAccount& sender, uint32_t market_id,
 
     // 1. Check CLOB
     bool use_clob = book_->market_exists(market_id);
-    LXL1 l1{};
-    if (use_clob) {
-        l1 = book_->get_l1(market_id);
-    }
 
     // 2. Check AMM
-    // Would need market_id -> PoolKey mapping
-    bool use_amm = false; // Simplified for now
+    std::optional<PoolLink> link;
+    {
+        std::shared_lock lock(links_mutex_);
+        auto it = pool_links_.find(market_id);
+        if (it != pool_links_.end()) link = it->second;
+    }
+    bool use_amm = link.has_value();
+
+    // Determine each venue's share
+    I128 clob_size = 0, clob_limit = limit_price_x18, amm_size = 0;
+    if (use_amm && size_x18 > 0) {
+        VenueSplit split = plan_split(market_id, *link, is_buy, size_x18, limit_price_x18);
+        clob_size = split.clob_size_x18;
+        clob_limit = split.clob_limit_x18;
+        amm_size = split.amm_size_x18;
+    } else if (use_clob) {
+        clob_size = size_x18;
+    }
 
-    // Determine best venue
-    if (use_clob && !use_amm) {
-        // Use CLOB only
+    I128 base_filled = 0;
+    I128 quote_filled = 0;
+
+    if (clob_size > 0) {
         LXOrder order;
         order.market_id = market_id;
         order.is_buy = is_buy;
-        order.kind = (limit_price_x18 == 0) ? OrderKind::MARKET : OrderKind::LIMIT;
-        order.size_x18 = size_x18;
-        order.limit_px_x18 = limit_price_x18;
+        order.kind = (clob_limit == 0) ? OrderKind::MARKET : OrderKind::LIMIT;
+        order.size_x18 = clob_size;
+        order.limit_px_x18 = clob_limit;
         order.tif = TIF::IOC; // Immediate or cancel for market orders
         order.reduce_only = false;
 
         LXPlaceResult place_result = book_->place_order(sender, order);
 
         result.used_clob = true;
-        result.delta.amount0 = place_result.filled_size_x18;
-        result.delta.amount1 = x18::mul(place_result.filled_size_x18, place_result.avg_px_x18);
-        if (!is_buy) {
-            result.delta.amount0 = -result.delta.amount0;
-            result.delta.amount1 = -result.delta.amount1;
-        }
+        result.clob_size_x18 = place_result.filled_size_x18;
         result.effective_price_x18 = place_result.avg_px_x18;
+        base_filled += place_result.filled_size_x18;
+        quote_filled += x18::mul(place_result.filled_size_x18, place_result.avg_px_x18);
+    }
 
-    } else if (use_amm && !use_clob) {
-        // Use AMM only
-        result.used_amm = true;
-        // Would execute AMM swap here
-
-    } else if (use_amm && use_clob) {
-        // Split order based on price comparison
-        // For now, prefer CLOB
-        result.used_clob = true;
-
-        LXOrder order;
-        order.market_id = market_id;
-        order.is_buy = is_buy;
-        order.kind = OrderKind::LIMIT;
-        order.size_x18 = size_x18;
-        order.limit_px_x18 = limit_price_x18;
-        order.tif = TIF::IOC;
-        order.reduce_only = false;
+    if (amm_size > 0) {
+        BalanceDelta delta = pool_->swap(link->pool, amm_params(*link, is_buy, amm_size, limit_price_x18));
+        const I128 base = link->base_is_currency0 ? delta.amount0 : delta.amount1;
+        const I128 quote = link->base_is_currency0 ? delta.amount1 : delta.amount0;
 
-        LXPlaceResult place_result = book_->place_order(sender, order);
+        result.used_amm = true;
+        result.amm_size_x18 = base < 0 ? -base : base;
+        base_filled += result.amm_size_x18;
+        quote_filled += quote < 0 ? -quote : quote;
+    }
 
-        result.delta.amount0 = place_result.filled_size_x18;
-        result.delta.amount1 = x18::mul(place_result.filled_size_x18, place_result.avg_px_x18);
-        result.effective_price_x18 = place_result.avg_px_x18;
+    result.delta.amount0 = is_buy ? base_filled : -base_filled;
+    result.delta.amount1 = is_buy ? quote_filled : -quote_filled;
+    if (result.used_amm && base_filled > 0) {
+        result.effective_price_x18 = x18::from_double(
+            x18::to_double(quote_filled) / x18::to_double(base_filled));
     }
 
     return result;
@@ -391,6 +546,22 @@ int32_t LX::update_funding(uint32_t market_id) {
     return vault_->accrue_funding(market_id);
 }
 
+size_t LX::run_funding() {
+    const std::vector<uint32_t> due = vault_->funding_due();
+    if (due.empty()) {
+        return 0;
+    }
+    std::call_once(funding_pool_once_, [this] { funding_pool_ = std::make_unique<TaskPool>(); });
+    return vault_->accrue_funding(feed_->calculate_funding_rates(due), funding_pool_.get());
+}
+
+LiquidationKeeper& LX::keeper() {
+    std::call_once(keeper_once_, [this] {
+        keeper_ = std::make_unique<LiquidationKeeper>(*vault_, *book_, liquidation_config_);
+    });
+    return *keeper_;
+}
+
 int32_t LX::run_liquidations(uint32_t market_id) {
     // Get mark price for liquidation checks
     auto mark = feed_->mark_price(market_id);
@@ -398,9 +569,11 @@ int32_t LX::run_liquidations(uint32_t market_id) {
         return errors::PRICE_STALE;
     }
 
-    // Note: In production, we'd iterate through accounts and check liquidation
-    // For now, this is a stub that would be called by a keeper
+    // Bring PnL to the current mark; the keeper's latency clock starts here
+    const uint64_t mark_time = LiquidationKeeper::now_ns();
+    vault_->update_mark_prices({{market_id, *mark}});
 
+    keeper().run(market_id, *mark, mark_time);
     return errors::OK;
 }
 
@@ -427,6 +600,15 @@ LX::GlobalStats LX::get_stats() const {
     return stats;
 }
 
+LX::MemoryReport LX::memory_usage() const {
+    MemoryReport report;
+    report.book = book_->memory_usage();
+    report.vault = vault_->memory_usage();
+    report.total += report.book;
+    report.total += report.vault;
+    return report;
+}
+
 // =============================================================================
 // Internal Settlement Callback
 // =============================================================================
@@ -435,37 +617,16 @@ int32_t LX::on_book_trades(const std::vector<Trade>& trades) {
     if (trades.empty()) {
         return errors::OK;
     }
+    TraceSpan span(TracePoint::Settlement, trades.size());
 
-    // Convert trades to settlements
+    // Convert trades to settlements, between the accounts that placed them
+    const AccountResolver resolver = [this](uint64_t account_id) {
+        return book_->get_account(account_id);
+    };
     std::vector<LXSettlement> settlements;
     settlements.reserve(trades.size());
-
     for (const auto& trade : trades) {
-        LXSettlement settlement;
-
-        // Convert account IDs to LXAccount
-        // In production, we'd have proper account mapping
-        settlement.maker.main = {};
-        settlement.maker.subaccount_id = static_cast<uint16_t>(trade.seller_account_id & 0xFFFF);
-        settlement.taker.main = {};
-        settlement.taker.subaccount_id = static_cast<uint16_t>(trade.buyer_account_id & 0xFFFF);
-
-        settlement.market_id = static_cast<uint32_t>(trade.symbol_id);
-        settlement.taker_is_buy = (trade.aggressor_side == Side::Buy);
-
-        // Convert from 1e8 to X18
-        settlement.size_x18 = static_cast<I128>(trade.quantity) * X18_ONE / 100000000LL;
-        settlement.price_x18 = static_cast<I128>(trade.price) * X18_ONE / 100000000LL;
-
-        // Calculate fees (simplified)
-        I128 notional = x18::mul(settlement.size_x18, settlement.price_x18);
-        settlement.maker_fee_x18 = x18::mul(notional, x18::from_double(0.0002)); // 0.02%
-        settlement.taker_fee_x18 = x18::mul(notional, x18::from_double(0.0005)); // 0.05%
-
-        settlement.flags = (trade.aggressor_side == Side::Buy) ?
-            fill_flags::TAKER : fill_flags::MAKER;
-
-        settlements.push_back(settlement);
+        settlements.push_back(settlement_from_trade(trade, resolver));
     }
 
     // Pre-check fills
@@ -478,6 +639,146 @@ int32_t LX::on_book_trades(const std::vector<Trade>& trades) {
     return vault_->apply_fills(settlements);
 }
 
+// =============================================================================
+// Block Access Sets
+// =============================================================================
+
+namespace {
+
+// State a precompile call touches, as a conflict key
+struct TxAccess {
+    uint64_t key;
+    bool write;
+};
+
+enum AccessKind : uint64_t {
+    ACCESS_POOL = 1,
+    ACCESS_MARKET,
+    ACCESS_ACCOUNT,
+    ACCESS_ASSET,
+    ACCESS_ORACLE,          // Every oracle asset, as read by the feed
+    ACCESS_SETTLEMENT,      // Vault accounts reached through book fills
+};
+
+inline uint64_t access_key(AccessKind kind, const uint8_t* data, size_t len) {
+    uint64_t h = 1469598103934665603ULL;
+    for (size_t i = 0; i < len; ++i) {
+        h = (h ^ data[i]) * 1099511628211ULL;
+    }
+    return (static_cast<uint64_t>(kind) << 56) ^ (h >> 8);
+}
+
+inline uint64_t access_key(AccessKind kind, uint64_t id) {
+    uint8_t bytes[8];
+    abi::encode_uint64(bytes, id);
+    return access_key(kind, bytes, sizeof(bytes));
+}
+
+// Fills `access` for one call; false if its footprint cannot be told from
+// the calldata, so it has to run alone. Reads and writes that the handler
+// would reject for short input are still recorded conservatively.
+bool block_access(const BlockTx& tx, const LXFeed& feed, std::vector<TxAccess>& access) {
+    const std::vector<uint8_t>& data = tx.calldata;
+    if (data.size() < 4) {
+        return true;    // Rejected without touching state
+    }
+    const uint32_t selector = abi::decode_uint32(data.data());
+    const uint8_t* args = data.data() + 4;
+    const size_t len = data.size() - 4;
+    auto word = [&](size_t i) -> const uint8_t* {
+        return len >= (i + 1) * 32 ? args + i * 32 : nullptr;
+    };
+    auto account = [&](size_t i, bool write) {
+        if (!word(i)) return;
+        access.push_back({access_key(ACCESS_ACCOUNT, word(i) + 12, 20), write});
+        access.push_back({access_key(ACCESS_SETTLEMENT, 0), write});
+    };
+    auto market = [&](size_t i, bool write) {
+        if (!word(i)) return;
+        access.push_back({access_key(ACCESS_MARKET, abi::decode_uint32(word(i) + 28)), write});
+    };
+
+    switch (addresses::to_lp(tx.precompile)) {
+        case 0x9010: {  // LX_POOL: currencies, fee and spacing name the pool
+            if (!word(4)) return true;
+            for (size_t i = 12; i < 32; ++i) {
+                if (selector != 0x7a44c8ab && word(4)[i] != 0) return false;    // Hooks run arbitrary code
+            }
+            const bool view = selector == 0x9e5e2e15;
+            access.push_back({access_key(ACCESS_POOL, args, 128), !view});
+            return true;
+        }
+
+        case 0x9020:    // LX_BOOK
+            switch (selector) {
+                case 0x4f55d24d:    // getL1
+                case 0x7c8d9e11:    // getOrder
+                    market(0, false);
+                    return true;
+                case 0x9e281a98:    // cancelOrder
+                    market(1, true);
+                    return true;
+                case 0x3e5b3a12:    // placeOrder
+                case 0x0660ee28:    // massQuote
+                    // Fills settle against resting makers' vault accounts
+                    market(1, true);
+                    access.push_back({access_key(ACCESS_SETTLEMENT, 0), true});
+                    return true;
+                default:            // execute(Action) can be any action
+                    return false;
+            }
+
+        case 0x9030:    // LX_VAULT
+            switch (selector) {
+                case 0x47e7ef24:    // deposit
+                case 0xf3fef3a3:    // withdraw
+                    account(0, true);
+                    return true;
+                case 0x4ab42e11:    // getPosition
+                case 0xf8b2cb4f:    // getBalance
+                case 0x6d435421:    // getMarginInfo
+                case 0x8a7c195f:    // isLiquidatable
+                    account(0, false);
+                    return true;
+                default:            // liquidate
+                    return false;
+            }
+
+        case 0x9011: {  // LX_ORACLE
+            const uint8_t* asset = word(0);
+            if (!asset) return true;
+            const uint64_t asset_id = abi::decode_uint64(asset + 24);
+            const bool write = selector == 0x7d3e47c1;
+            access.push_back({access_key(ACCESS_ASSET, asset_id), write});
+            if (!write) {
+                return true;
+            }
+            access.push_back({access_key(ACCESS_ORACLE, 0), true});
+
+            // The new mark reaches the asset's books, firing trigger orders
+            // that trade and settle, and marks their positions in the vault
+            const std::vector<uint32_t> markets = feed.markets_for_asset(asset_id);
+            for (uint32_t market_id : markets) {
+                access.push_back({access_key(ACCESS_MARKET, market_id), true});
+            }
+            if (!markets.empty()) {
+                access.push_back({access_key(ACCESS_SETTLEMENT, 0), true});
+            }
+            return true;
+        }
+
+        case 0x9040:    // LX_FEED: marks combine the oracle and the market's book
+            market(0, false);
+            access.push_back({access_key(ACCESS_ORACLE, 0), false});
+            return true;
+
+        default:
+            return true;
+    }
+}
+
+} // anonymous namespace
+
 // =============================================================================
 // PrecompileRouter Implementation
 // =============================================================================
@@ -488,57 +789,218 @@ PrecompileRouter::PrecompileRouter(LX& dex) : dex_(dex) {
     register_vault_handlers();
     register_oracle_handlers();
     register_feed_handlers();
+    build_dispatch();
 }
 
-std::vector<uint8_t> PrecompileRouter::call(const Address& precompile,
-                                             const std::vector<uint8_t>& calldata) {
-    if (!is_precompile(precompile)) {
-        return {};
+void PrecompileRouter::add(uint64_t lp, uint32_t selector, Handler handler) {
+    const uint32_t index = static_cast<uint32_t>(entries_.size());
+    entries_.push_back({dispatch_key(lp, selector), handler, nullptr, index});
+}
+
+void PrecompileRouter::add_view(uint64_t lp, uint32_t selector, ViewHandler view) {
+    const uint32_t index = static_cast<uint32_t>(entries_.size());
+    entries_.push_back({dispatch_key(lp, selector), nullptr, view, index});
+}
+
+const PrecompileRouter::DispatchEntry* PrecompileRouter::find(const Address& precompile,
+                                                              const uint8_t* calldata,
+                                                              size_t len) const {
+    if (!is_precompile(precompile) || len < 4) {
+        return nullptr;
     }
+    const uint64_t key = dispatch_key(addresses::to_lp(precompile), abi::decode_uint32(calldata));
+    const DispatchEntry& entry = table_[(key * hash_mul_) >> hash_shift_];
+    return entry.key == key ? &entry : nullptr;
+}
 
-    if (calldata.size() < 4) {
-        return {};
+// Find a multiplier that sends every key to its own slot, doubling the
+// table until one does. Keys never change after construction, so lookups
+// are a multiply, a shift and one compare.
+void PrecompileRouter::build_dispatch() {
+    uint64_t seed = 0x9E3779B97F4A7C15ULL;
+    for (unsigned bits = 4; bits < 20; ++bits) {
+        const size_t size = size_t{1} << bits;
+        if (size < entries_.size() * 2) continue;
+        for (int attempt = 0; attempt < 64; ++attempt) {
+            const uint64_t mul = seed | 1;
+            seed = seed * 6364136223846793005ULL + 1442695040888963407ULL;
+
+            std::vector<DispatchEntry> table(size);
+            bool collided = false;
+            for (const DispatchEntry& e : entries_) {
+                DispatchEntry& slot = table[(e.key * mul) >> (64 - bits)];
+                if (slot.key != 0) {
+                    collided = true;
+                    break;
+                }
+                slot = e;
+            }
+            if (!collided) {
+                profiles_ = std::make_unique<SelectorProfile[]>(entries_.size());
+                table_ = std::move(table);
+                hash_mul_ = mul;
+                hash_shift_ = 64 - bits;
+                return;
+            }
+        }
     }
+    throw std::logic_error("PrecompileRouter: no collision-free dispatch table");
+}
 
-    // Extract method selector (first 4 bytes)
-    uint32_t selector = 0;
-    selector |= static_cast<uint32_t>(calldata[0]) << 24;
-    selector |= static_cast<uint32_t>(calldata[1]) << 16;
-    selector |= static_cast<uint32_t>(calldata[2]) << 8;
-    selector |= static_cast<uint32_t>(calldata[3]);
+size_t PrecompileRouter::dispatch(const DispatchEntry& entry, const uint8_t* args, size_t len,
+                                  uint8_t* out) const {
+    if (!profiling_.load(std::memory_order_relaxed)) {
+        return entry.view ? entry.view(dex_, args, len, out) : entry.handler(dex_, args, len, out);
+    }
 
-    // Get precompile address as LP number
-    uint16_t lp_num = addresses::to_lp(precompile);
-    uint64_t precompile_key = lp_num;
+    const auto start = std::chrono::steady_clock::now();
+    const size_t written = entry.view ? entry.view(dex_, args, len, out)
+                                      : entry.handler(dex_, args, len, out);
+    const uint64_t nanos = static_cast<uint64_t>(std::chrono::duration_cast<std::chrono::nanoseconds>(
+        std::chrono::steady_clock::now() - start).count());
+
+    SelectorProfile& profile = profiles_[entry.index];
+    profile.latency.record(nanos);
+    profile.total_nanos.fetch_add(nanos, std::memory_order_relaxed);
+    profile.output_bytes.fetch_add(written, std::memory_order_relaxed);
+    return written;
+}
 
-    auto precompile_it = handlers_.find(precompile_key);
-    if (precompile_it == handlers_.end()) {
-        return {};
+size_t PrecompileRouter::call(const Address& precompile, const uint8_t* calldata,
+                              size_t len, uint8_t* out) {
+    const DispatchEntry* entry = find(precompile, calldata, len);
+    if (!entry) {
+        return 0;
     }
+    return dispatch(*entry, calldata + 4, len - 4, out);
+}
 
-    auto handler_it = precompile_it->second.find(selector);
-    if (handler_it == precompile_it->second.end()) {
-        return {};
+size_t PrecompileRouter::static_call(const Address& precompile, const uint8_t* calldata,
+                                     size_t len, uint8_t* out) const {
+    // Only handlers registered as views; they see LX through const
+    // interfaces, which take shared locks or read snapshots
+    const DispatchEntry* entry = find(precompile, calldata, len);
+    if (!entry || !entry->view) {
+        return 0;
     }
+    return dispatch(*entry, calldata + 4, len - 4, out);
+}
 
-    // Extract calldata without selector
-    std::vector<uint8_t> args(calldata.begin() + 4, calldata.end());
-
-    return handler_it->second(args);
+std::vector<uint8_t> PrecompileRouter::call(const Address& precompile,
+                                             const std::vector<uint8_t>& calldata) {
+    std::vector<uint8_t> result(MAX_OUTPUT);
+    result.resize(call(precompile, calldata.data(), calldata.size(), result.data()));
+    return result;
 }
 
 std::vector<uint8_t> PrecompileRouter::static_call(const Address& precompile,
                                                     const std::vector<uint8_t>& calldata) const {
-    // For static calls, we only allow read operations
-    // The handler registration would mark which are read-only
-    // For now, delegate to call (non-const cast is needed)
-    return const_cast<PrecompileRouter*>(this)->call(precompile, calldata);
+    std::vector<uint8_t> result(MAX_OUTPUT);
+    result.resize(static_call(precompile, calldata.data(), calldata.size(), result.data()));
+    return result;
+}
+
+BlockResult PrecompileRouter::execute_block(const std::vector<BlockTx>& txs) {
+    BlockResult result;
+    result.outputs.resize(txs.size());
+    auto run = [&](size_t i) {
+        std::vector<uint8_t>& out = result.outputs[i];
+        out.resize(MAX_OUTPUT);
+        out.resize(call(txs[i].precompile, txs[i].calldata.data(), txs[i].calldata.size(), out.data()));
+    };
+
+    std::call_once(block_pool_once_, [this] { block_pool_ = std::make_unique<TaskPool>(); });
+
+    // Calls between two barriers: union every pair that shares a key at
+    // least one of them writes, then run each group in block order
+    std::vector<size_t> parent(txs.size());
+    auto find = [&](size_t i) {
+        while (parent[i] != i) {
+            parent[i] = parent[parent[i]];
+            i = parent[i];
+        }
+        return i;
+    };
+    struct KeyUse {
+        size_t first;           // First call to touch the key
+        bool written;
+        std::vector<size_t> readers_before_write;
+    };
+    auto run_segment = [&](size_t begin, size_t end, std::vector<std::vector<TxAccess>>& access) {
+        if (begin == end) return;
+        std::unordered_map<uint64_t, KeyUse> uses;
+        for (size_t i = begin; i < end; ++i) {
+            parent[i] = i;
+        }
+        for (size_t i = begin; i < end; ++i) {
+            for (const TxAccess& a : access[i - begin]) {
+                auto [it, inserted] = uses.try_emplace(a.key, KeyUse{i, a.write, {}});
+                KeyUse& use = it->second;
+                if (inserted) {
+                    if (!a.write) use.readers_before_write.push_back(i);
+                    continue;
+                }
+                if (a.write || use.written) {
+                    if (!use.written) {
+                        // First writer: every earlier reader must stay before it
+                        for (size_t r : use.readers_before_write) parent[find(r)] = find(i);
+                        use.readers_before_write.clear();
+                        use.written = true;
+                        use.first = i;
+                    }
+                    parent[find(i)] = find(use.first);
+                } else {
+                    use.readers_before_write.push_back(i);
+                }
+            }
+        }
+
+        std::unordered_map<size_t, size_t> group_index;
+        std::vector<std::vector<size_t>> groups;
+        for (size_t i = begin; i < end; ++i) {
+            auto [it, inserted] = group_index.try_emplace(find(i), groups.size());
+            if (inserted) groups.emplace_back();
+            groups[it->second].push_back(i);
+        }
+        // Largest groups first so the tail of the block stays balanced
+        std::sort(groups.begin(), groups.end(), [](const auto& a, const auto& b) {
+            return a.size() > b.size();
+        });
+        result.groups += groups.size();
+        block_pool_->parallel_for(groups.size(), [&](size_t g) {
+            for (size_t i : groups[g]) run(i);
+        });
+    };
+
+    std::vector<std::vector<TxAccess>> access;
+    size_t begin = 0;
+    for (size_t i = 0; i < txs.size(); ++i) {
+        std::vector<TxAccess> tx_access;
+        if (block_access(txs[i], dex_.feed(), tx_access)) {
+            access.push_back(std::move(tx_access));
+            continue;
+        }
+        run_segment(begin, i, access);
+        access.clear();
+        run(i);
+        ++result.barriers;
+        begin = i + 1;
+    }
+    run_segment(begin, txs.size(), access);
+    return result;
 }
 
 bool PrecompileRouter::is_precompile(const Address& addr) const {
     return addresses::is_dex_precompile(addr);
 }
 
+bool PrecompileRouter::is_view(const Address& precompile, uint32_t selector) const {
+    uint8_t calldata[4];
+    abi::encode_uint32(calldata, selector);
+    const DispatchEntry* entry = find(precompile, calldata, sizeof(calldata));
+    return entry && entry->view;
+}
+
 uint64_t PrecompileRouter::gas_cost(const Address& precompile,
                                      const std::vector<uint8_t>& calldata) const {
     if (!is_precompile(precompile)) {
@@ -549,16 +1011,16 @@ uint64_t PrecompileRouter::gas_cost(const Address& precompile,
         return gas::POOL_SWAP; // Default
     }
 
-    // Extract method selector
-    uint32_t selector = 0;
-    selector |= static_cast<uint32_t>(calldata[0]) << 24;
-    selector |= static_cast<uint32_t>(calldata[1]) << 16;
-    selector |= static_cast<uint32_t>(calldata[2]) << 8;
-    selector |= static_cast<uint32_t>(calldata[3]);
-
-    // Map precompile address to gas costs based on method
-    uint16_t lp_num = addresses::to_lp(precompile);
+    if (const DispatchEntry* entry = find(precompile, calldata.data(), calldata.size())) {
+        const uint64_t calibrated = profiles_[entry->index].gas.load(std::memory_order_relaxed);
+        if (calibrated != 0) {
+            return calibrated;
+        }
+    }
+    return static_gas_cost(addresses::to_lp(precompile), abi::decode_uint32(calldata.data()));
+}
 
+uint64_t PrecompileRouter::static_gas_cost(uint16_t lp_num, uint32_t selector) const {
     switch (lp_num) {
         case 0x9010: // LX_POOL
             switch (selector) {
@@ -605,6 +1067,61 @@ uint64_t PrecompileRouter::gas_cost(const Address& precompile,
     }
 }
 
+// =============================================================================
+// Profiling
+// =============================================================================
+
+std::vector<SelectorStats> PrecompileRouter::profile() const {
+    std::vector<SelectorStats> stats;
+    stats.reserve(entries_.size());
+    for (const DispatchEntry& entry : entries_) {
+        const SelectorProfile& p = profiles_[entry.index];
+        SelectorStats s;
+        s.lp = static_cast<uint16_t>(entry.key >> 32);
+        s.selector = static_cast<uint32_t>(entry.key);
+        s.view = entry.view != nullptr;
+        s.calls = p.latency.count();
+        s.total_nanos = p.total_nanos.load(std::memory_order_relaxed);
+        s.p50_nanos = p.latency.quantile(0.5);
+        s.p99_nanos = p.latency.quantile(0.99);
+        s.max_nanos = p.latency.max();
+        s.output_bytes = p.output_bytes.load(std::memory_order_relaxed);
+        const uint64_t calibrated = p.gas.load(std::memory_order_relaxed);
+        s.gas = calibrated != 0 ? calibrated : static_gas_cost(s.lp, s.selector);
+        stats.push_back(s);
+    }
+    // Most total time first
+    std::sort(stats.begin(), stats.end(), [](const SelectorStats& a, const SelectorStats& b) {
+        return a.total_nanos > b.total_nanos;
+    });
+    return stats;
+}
+
+void PrecompileRouter::reset_profile() {
+    for (size_t i = 0; i < entries_.size(); ++i) {
+        profiles_[i].latency.reset();
+        profiles_[i].total_nanos.store(0, std::memory_order_relaxed);
+        profiles_[i].output_bytes.store(0, std::memory_order_relaxed);
+    }
+}
+
+size_t PrecompileRouter::calibrate_gas(double gas_per_nano, uint64_t min_gas, uint64_t min_calls) {
+    size_t calibrated = 0;
+    for (size_t i = 0; i < entries_.size(); ++i) {
+        SelectorProfile& p = profiles_[i];
+        const uint64_t calls = p.latency.count();
+        if (calls == 0 || calls < min_calls) {
+            continue;
+        }
+        const double mean = static_cast<double>(p.total_nanos.load(std::memory_order_relaxed)) /
+                            static_cast<double>(calls);
+        const uint64_t gas = static_cast<uint64_t>(std::llround(mean * gas_per_nano));
+        p.gas.store(std::max<uint64_t>({min_gas, gas, 1}), std::memory_order_relaxed);
+        ++calibrated;
+    }
+    return calibrated;
+}
+
 // =============================================================================
 // Handler Registration - LXPool (LP-9010)
 // =============================================================================
@@ -613,95 +1130,95 @@ void PrecompileRouter::register_pool_handlers() {
     uint64_t pool_key = addresses::to_lp(addresses::LX_POOL);
 
     // initialize(PoolKey,uint160) -> 0x7a44c8ab
-    handlers_[pool_key][0x7a44c8ab] = [this](const std::vector<uint8_t>& args) -> std::vector<uint8_t> {
+    add(pool_key, 0x7a44c8ab, [](LX& dex, const uint8_t* args, size_t len, uint8_t* out) -> size_t {
         // PoolKey: currency0 (20), currency1 (20), fee (4), tickSpacing (4), hooks (20)
         // sqrt_price_x96: last 20 bytes of 32-byte slot
-        if (args.size() < 128) return abi::encode_int32(errors::INVALID_CURRENCY);
+        if (len < 160) return abi::encode_int32(out, errors::INVALID_CURRENCY);
 
         PoolKey key;
-        key.currency0 = Currency(abi::decode_address(args.data()));
-        key.currency1 = Currency(abi::decode_address(args.data() + 32));
-        key.fee = abi::decode_uint32(args.data() + 64 + 28);
-        key.tick_spacing = static_cast<int32_t>(abi::decode_uint32(args.data() + 96 + 28));
+        key.currency0 = Currency(abi::decode_address(args));
+        key.currency1 = Currency(abi::decode_address(args + 32));
+        key.fee = abi::decode_uint32(args + 64 + 28);
+        key.tick_spacing = static_cast<int32_t>(abi::decode_uint32(args + 96 + 28));
 
-        I128 sqrt_price_x96 = abi::decode_int128(args.data() + 128);
+        I128 sqrt_price_x96 = abi::decode_int128(args + 128);
 
-        int32_t tick = dex_.pool().initialize(key, sqrt_price_x96);
-        return abi::encode_int32(tick);
-    };
+        int32_t tick = dex.pool().initialize(key, sqrt_price_x96);
+        return abi::encode_int32(out, tick);
+    });
 
     // swap(PoolKey,SwapParams,bytes) -> 0x1a686502
-    handlers_[pool_key][0x1a686502] = [this](const std::vector<uint8_t>& args) -> std::vector<uint8_t> {
-        if (args.size() < 224) return {};
+    add(pool_key, 0x1a686502, [](LX& dex, const uint8_t* args, size_t len, uint8_t* out) -> size_t {
+        if (len < 256) return 0;
 
         PoolKey key;
-        key.currency0 = Currency(abi::decode_address(args.data()));
-        key.currency1 = Currency(abi::decode_address(args.data() + 32));
-        key.fee = abi::decode_uint32(args.data() + 64 + 28);
-        key.tick_spacing = static_cast<int32_t>(abi::decode_uint32(args.data() + 96 + 28));
-        key.hooks = abi::decode_address(args.data() + 128);
+        key.currency0 = Currency(abi::decode_address(args));
+        key.currency1 = Currency(abi::decode_address(args + 32));
+        key.fee = abi::decode_uint32(args + 64 + 28);
+        key.tick_spacing = static_cast<int32_t>(abi::decode_uint32(args + 96 + 28));
+        key.hooks = abi::decode_address(args + 128);
 
         SwapParams params;
         params.zero_for_one = args[160 + 31] != 0;
-        params.amount_specified = abi::decode_int128(args.data() + 192);
-        params.sqrt_price_limit = abi::decode_int128(args.data() + 224);
+        params.amount_specified = abi::decode_int128(args + 192);
+        params.sqrt_price_limit = abi::decode_int128(args + 224);
 
-        BalanceDelta delta = dex_.pool().swap(key, params);
+        BalanceDelta delta = dex.pool().swap(key, params);
 
         // Encode BalanceDelta (2 x int256)
-        std::vector<uint8_t> result(64);
-        abi::encode_int128(result.data(), delta.amount0);
-        abi::encode_int128(result.data() + 32, delta.amount1);
-        return result;
-    };
+        std::memset(out, 0, 64);
+        abi::encode_int128(out, delta.amount0);
+        abi::encode_int128(out + 32, delta.amount1);
+        return 64;
+    });
 
     // modifyLiquidity(PoolKey,ModifyLiquidityParams,bytes) -> 0x3a7a5b04
-    handlers_[pool_key][0x3a7a5b04] = [this](const std::vector<uint8_t>& args) -> std::vector<uint8_t> {
-        if (args.size() < 256) return {};
+    add(pool_key, 0x3a7a5b04, [](LX& dex, const uint8_t* args, size_t len, uint8_t* out) -> size_t {
+        if (len < 288) return 0;
 
         PoolKey key;
-        key.currency0 = Currency(abi::decode_address(args.data()));
-        key.currency1 = Currency(abi::decode_address(args.data() + 32));
-        key.fee = abi::decode_uint32(args.data() + 64 + 28);
-        key.tick_spacing = static_cast<int32_t>(abi::decode_uint32(args.data() + 96 + 28));
-        key.hooks = abi::decode_address(args.data() + 128);
+        key.currency0 = Currency(abi::decode_address(args));
+        key.currency1 = Currency(abi::decode_address(args + 32));
+        key.fee = abi::decode_uint32(args + 64 + 28);
+        key.tick_spacing = static_cast<int32_t>(abi::decode_uint32(args + 96 + 28));
+        key.hooks = abi::decode_address(args + 128);
 
         ModifyLiquidityParams params;
-        params.tick_lower = static_cast<int32_t>(abi::decode_uint32(args.data() + 160 + 28));
-        params.tick_upper = static_cast<int32_t>(abi::decode_uint32(args.data() + 192 + 28));
-        params.liquidity_delta = abi::decode_int128(args.data() + 224);
-        params.salt = abi::decode_uint64(args.data() + 256 + 24);
+        params.tick_lower = static_cast<int32_t>(abi::decode_uint32(args + 160 + 28));
+        params.tick_upper = static_cast<int32_t>(abi::decode_uint32(args + 192 + 28));
+        params.liquidity_delta = abi::decode_int128(args + 224);
+        params.salt = abi::decode_uint64(args + 256 + 24);
 
-        BalanceDelta delta = dex_.pool().modify_liquidity(key, params);
+        BalanceDelta delta = dex.pool().modify_liquidity(key, params);
 
-        std::vector<uint8_t> result(64);
-        abi::encode_int128(result.data(), delta.amount0);
-        abi::encode_int128(result.data() + 32, delta.amount1);
-        return result;
-    };
+        std::memset(out, 0, 64);
+        abi::encode_int128(out, delta.amount0);
+        abi::encode_int128(out + 32, delta.amount1);
+        return 64;
+    });
 
     // getSlot0(PoolKey) -> 0x9e5e2e15
-    handlers_[pool_key][0x9e5e2e15] = [this](const std::vector<uint8_t>& args) -> std::vector<uint8_t> {
-        if (args.size() < 160) return {};
+    add_view(pool_key, 0x9e5e2e15, [](const LX& dex, const uint8_t* args, size_t len, uint8_t* out) -> size_t {
+        if (len < 160) return 0;
 
         PoolKey key;
-        key.currency0 = Currency(abi::decode_address(args.data()));
-        key.currency1 = Currency(abi::decode_address(args.data() + 32));
-        key.fee = abi::decode_uint32(args.data() + 64 + 28);
-        key.tick_spacing = static_cast<int32_t>(abi::decode_uint32(args.data() + 96 + 28));
-        key.hooks = abi::decode_address(args.data() + 128);
-
-        auto slot0 = dex_.pool().get_slot0(key);
-        if (!slot0) return {};
-
-        std::vector<uint8_t> result(160);
-        abi::encode_int128(result.data(), slot0->sqrt_price_x96);
-        abi::encode_int128(result.data() + 32, static_cast<I128>(slot0->tick));
-        abi::encode_int128(result.data() + 64, static_cast<I128>(slot0->protocol_fee));
-        abi::encode_int128(result.data() + 96, static_cast<I128>(slot0->lp_fee));
-        result[128 + 31] = slot0->unlocked ? 1 : 0;
-        return result;
-    };
+        key.currency0 = Currency(abi::decode_address(args));
+        key.currency1 = Currency(abi::decode_address(args + 32));
+        key.fee = abi::decode_uint32(args + 64 + 28);
+        key.tick_spacing = static_cast<int32_t>(abi::decode_uint32(args + 96 + 28));
+        key.hooks = abi::decode_address(args + 128);
+
+        auto slot0 = dex.pool().get_slot0(key);
+        if (!slot0) return 0;
+
+        std::memset(out, 0, 160);
+        abi::encode_int128(out, slot0->sqrt_price_x96);
+        abi::encode_int128(out + 32, static_cast<I128>(slot0->tick));
+        abi::encode_int128(out + 64, static_cast<I128>(slot0->protocol_fee));
+        abi::encode_int128(out + 96, static_cast<I128>(slot0->lp_fee));
+        out[128 + 31] = slot0->unlocked ? 1 : 0;
+        return 160;
+    });
 }
 
 // =============================================================================
@@ -712,106 +1229,140 @@ void PrecompileRouter::register_book_handlers() {
     uint64_t book_key = addresses::to_lp(addresses::LX_BOOK);
 
     // execute(Action) -> 0x1a4d01d2
-    handlers_[book_key][0x1a4d01d2] = [this](const std::vector<uint8_t>& args) -> std::vector<uint8_t> {
-        if (args.size() < 96) return {};
+    add(book_key, 0x1a4d01d2, [](LX& dex, const uint8_t* args, size_t len, uint8_t* out) -> size_t {
+        if (len < 96) return 0;
 
         // Decode LXAction
         LXAction action;
         action.action_type = static_cast<ActionType>(args[31]);
-        action.nonce = abi::decode_uint64(args.data() + 32 + 24);
-        action.expires_after = abi::decode_uint64(args.data() + 64 + 24);
+        action.nonce = abi::decode_uint64(args + 32 + 24);
+        action.expires_after = abi::decode_uint64(args + 64 + 24);
 
         // Decode sender from first 20 bytes
         LXAccount sender;
-        sender.main = abi::decode_address(args.data());
+        sender.main = abi::decode_address(args);
 
         // Execute action
-        ExecuteResult result = dex_.book().execute(sender, action);
+        ExecuteResult result = dex.book().execute(sender, action);
 
         // Encode result
-        return abi::encode_int32(result.error_code);
-    };
+        return abi::encode_int32(out, result.error_code);
+    });
 
     // getL1(uint32) -> 0x4f55d24d
-    handlers_[book_key][0x4f55d24d] = [this](const std::vector<uint8_t>& args) -> std::vector<uint8_t> {
-        if (args.size() < 32) return {};
+    add_view(book_key, 0x4f55d24d, [](const LX& dex, const uint8_t* args, size_t len, uint8_t* out) -> size_t {
+        if (len < 32) return 0;
 
-        uint32_t market_id = abi::decode_uint32(args.data() + 28);
-        LXL1 l1 = dex_.book().get_l1(market_id);
+        uint32_t market_id = abi::decode_uint32(args + 28);
+        LXL1 l1 = dex.book().get_l1(market_id);
 
         // Encode LXL1: 5 x int256
-        std::vector<uint8_t> result(160);
-        abi::encode_int128(result.data(), l1.best_bid_px_x18);
-        abi::encode_int128(result.data() + 32, l1.best_bid_sz_x18);
-        abi::encode_int128(result.data() + 64, l1.best_ask_px_x18);
-        abi::encode_int128(result.data() + 96, l1.best_ask_sz_x18);
-        abi::encode_int128(result.data() + 128, l1.last_trade_px_x18);
-        return result;
-    };
+        std::memset(out, 0, 160);
+        abi::encode_int128(out, l1.best_bid_px_x18);
+        abi::encode_int128(out + 32, l1.best_bid_sz_x18);
+        abi::encode_int128(out + 64, l1.best_ask_px_x18);
+        abi::encode_int128(out + 96, l1.best_ask_sz_x18);
+        abi::encode_int128(out + 128, l1.last_trade_px_x18);
+        return 160;
+    });
 
     // placeOrder(LXOrder) -> 0x3e5b3a12
-    handlers_[book_key][0x3e5b3a12] = [this](const std::vector<uint8_t>& args) -> std::vector<uint8_t> {
-        if (args.size() < 256) return {};
+    add(book_key, 0x3e5b3a12, [](LX& dex, const uint8_t* args, size_t len, uint8_t* out) -> size_t {
+        if (len < 288) return 0;
 
         LXAccount sender;
-        sender.main = abi::decode_address(args.data());
+        sender.main = abi::decode_address(args);
 
         LXOrder order;
-        order.market_id = abi::decode_uint32(args.data() + 32 + 28);
+        order.market_id = abi::decode_uint32(args + 32 + 28);
         order.is_buy = args[64 + 31] != 0;
         order.kind = static_cast<OrderKind>(args[96 + 31]);
-        order.size_x18 = abi::decode_int128(args.data() + 128);
-        order.limit_px_x18 = abi::decode_int128(args.data() + 160);
-        order.trigger_px_x18 = abi::decode_int128(args.data() + 192);
+        order.size_x18 = abi::decode_int128(args + 128);
+        order.limit_px_x18 = abi::decode_int128(args + 160);
+        order.trigger_px_x18 = abi::decode_int128(args + 192);
         order.reduce_only = args[224 + 31] != 0;
         order.tif = static_cast<TIF>(args[256 + 31]);
 
-        LXPlaceResult result = dex_.book().place_order(sender, order);
+        LXPlaceResult result = dex.book().place_order(sender, order);
 
         // Encode result: oid (uint64), status (uint8), filled_size (int128), avg_px (int128)
-        std::vector<uint8_t> encoded(128);
-        abi::encode_uint64(encoded.data() + 24, result.oid);
-        encoded[63] = result.status;
-        abi::encode_int128(encoded.data() + 64, result.filled_size_x18);
-        abi::encode_int128(encoded.data() + 96, result.avg_px_x18);
-        return encoded;
-    };
+        std::memset(out, 0, 128);
+        abi::encode_uint64(out + 24, result.oid);
+        out[63] = result.status;
+        abi::encode_int128(out + 64, result.filled_size_x18);
+        abi::encode_int128(out + 96, result.avg_px_x18);
+        return 128;
+    });
 
     // cancelOrder(uint32,uint64) -> 0x9e281a98
-    handlers_[book_key][0x9e281a98] = [this](const std::vector<uint8_t>& args) -> std::vector<uint8_t> {
-        if (args.size() < 96) return {};
+    add(book_key, 0x9e281a98, [](LX& dex, const uint8_t* args, size_t len, uint8_t* out) -> size_t {
+        if (len < 96) return 0;
 
         LXAccount sender;
-        sender.main = abi::decode_address(args.data());
+        sender.main = abi::decode_address(args);
 
-        uint32_t market_id = abi::decode_uint32(args.data() + 32 + 28);
-        uint64_t oid = abi::decode_uint64(args.data() + 64 + 24);
+        uint32_t market_id = abi::decode_uint32(args + 32 + 28);
+        uint64_t oid = abi::decode_uint64(args + 64 + 24);
 
-        int32_t result = dex_.book().cancel_order(sender, market_id, oid);
-        return abi::encode_int32(result);
-    };
+        int32_t result = dex.book().cancel_order(sender, market_id, oid);
+        return abi::encode_int32(out, result);
+    });
 
     // getOrder(uint32,uint64) -> 0x7c8d9e11
-    handlers_[book_key][0x7c8d9e11] = [this](const std::vector<uint8_t>& args) -> std::vector<uint8_t> {
-        if (args.size() < 64) return {};
+    add_view(book_key, 0x7c8d9e11, [](const LX& dex, const uint8_t* args, size_t len, uint8_t* out) -> size_t {
+        if (len < 64) return 0;
 
-        uint32_t market_id = abi::decode_uint32(args.data() + 28);
-        uint64_t oid = abi::decode_uint64(args.data() + 32 + 24);
+        uint32_t market_id = abi::decode_uint32(args + 28);
+        uint64_t oid = abi::decode_uint64(args + 32 + 24);
 
-        auto order = dex_.book().get_order(market_id, oid);
-        if (!order) return {};
+        auto order = dex.book().get_order(market_id, oid);
+        if (!order) return 0;
 
         // Encode BookOrderState
-        std::vector<uint8_t> result(320);
-        abi::encode_uint64(result.data() + 24, order->oid);
-        abi::encode_int128(result.data() + 64, order->original_size_x18);
-        abi::encode_int128(result.data() + 96, order->remaining_size_x18);
-        abi::encode_int128(result.data() + 128, order->filled_size_x18);
-        abi::encode_int128(result.data() + 160, order->limit_price_x18);
-        abi::encode_int128(result.data() + 192, order->avg_fill_price_x18);
-        result[224 + 31] = static_cast<uint8_t>(order->status);
-        return result;
-    };
+        std::memset(out, 0, 320);
+        abi::encode_uint64(out + 24, order->oid);
+        abi::encode_int128(out + 64, order->original_size_x18);
+        abi::encode_int128(out + 96, order->remaining_size_x18);
+        abi::encode_int128(out + 128, order->filled_size_x18);
+        abi::encode_int128(out + 160, order->limit_price_x18);
+        abi::encode_int128(out + 192, order->avg_fill_price_x18);
+        out[224 + 31] = static_cast<uint8_t>(order->status);
+        return 320;
+    });
+
+    // massQuote(uint32,(bool,int128,int128)[]) -> 0x0660ee28
+    // Levels follow the count inline, three words each
+    add(book_key, 0x0660ee28, [](LX& dex, const uint8_t* args, size_t len, uint8_t* out) -> size_t {
+        if (len < 96) return 0;
+
+        LXAccount sender;
+        sender.main = abi::decode_address(args);
+
+        uint32_t market_id = abi::decode_uint32(args + 32 + 28);
+        uint64_t count = abi::decode_uint64(args + 64 + 24);
+        if (count > (len - 96) / 96) return 0;
+
+        std::vector<LXQuote> quotes(count);
+        for (size_t i = 0; i < count; ++i) {
+            const uint8_t* level = args + 96 + i * 96;
+            quotes[i].is_buy = level[31] != 0;
+            quotes[i].px_x18 = abi::decode_int128(level + 32);
+            quotes[i].sz_x18 = abi::decode_int128(level + 64);
+        }
+
+        LXMassQuoteResult result = dex.book().mass_quote(sender, market_id, quotes.data(), quotes.size());
+
+        // Encode result: error (int32), six counts (uint32), filled_size (int128)
+        std::memset(out, 0, 256);
+        abi::encode_int128(out, result.error_code);
+        const uint32_t counts[] = {result.kept, result.reduced, result.requeued,
+                                   result.placed, result.cancelled, result.rejected};
+        for (size_t i = 0; i < 6; ++i) {
+            abi::encode_uint64(out + 32 + i * 32 + 24, counts[i]);
+        }
+        abi::encode_int128(out + 224, result.filled_size_x18);
+        return 256;
+    });
 }
 
 // =============================================================================
@@ -822,130 +1373,130 @@ void PrecompileRouter::register_vault_handlers() {
     uint64_t vault_key = addresses::to_lp(addresses::LX_VAULT);
 
     // deposit(address,uint256) -> 0x47e7ef24
-    handlers_[vault_key][0x47e7ef24] = [this](const std::vector<uint8_t>& args) -> std::vector<uint8_t> {
-        if (args.size() < 96) return {};
+    add(vault_key, 0x47e7ef24, [](LX& dex, const uint8_t* args, size_t len, uint8_t* out) -> size_t {
+        if (len < 96) return 0;
 
         LXAccount account;
-        account.main = abi::decode_address(args.data());
+        account.main = abi::decode_address(args);
 
         Currency token;
-        token.addr = abi::decode_address(args.data() + 32);
+        token.addr = abi::decode_address(args + 32);
 
-        I128 amount_x18 = abi::decode_int128(args.data() + 64);
+        I128 amount_x18 = abi::decode_int128(args + 64);
 
-        int32_t result = dex_.vault().deposit(account, token, amount_x18);
-        return abi::encode_int32(result);
-    };
+        int32_t result = dex.vault().deposit(account, token, amount_x18);
+        return abi::encode_int32(out, result);
+    });
 
     // withdraw(address,uint256) -> 0xf3fef3a3
-    handlers_[vault_key][0xf3fef3a3] = [this](const std::vector<uint8_t>& args) -> std::vector<uint8_t> {
-        if (args.size() < 96) return {};
+    add(vault_key, 0xf3fef3a3, [](LX& dex, const uint8_t* args, size_t len, uint8_t* out) -> size_t {
+        if (len < 96) return 0;
 
         LXAccount account;
-        account.main = abi::decode_address(args.data());
+        account.main = abi::decode_address(args);
 
         Currency token;
-        token.addr = abi::decode_address(args.data() + 32);
+        token.addr = abi::decode_address(args + 32);
 
-        I128 amount_x18 = abi::decode_int128(args.data() + 64);
+        I128 amount_x18 = abi::decode_int128(args + 64);
 
-        int32_t result = dex_.vault().withdraw(account, token, amount_x18);
-        return abi::encode_int32(result);
-    };
+        int32_t result = dex.vault().withdraw(account, token, amount_x18);
+        return abi::encode_int32(out, result);
+    });
 
     // getPosition(address,uint32) -> 0x4ab42e11
-    handlers_[vault_key][0x4ab42e11] = [this](const std::vector<uint8_t>& args) -> std::vector<uint8_t> {
-        if (args.size() < 64) return {};
+    add_view(vault_key, 0x4ab42e11, [](const LX& dex, const uint8_t* args, size_t len, uint8_t* out) -> size_t {
+        if (len < 64) return 0;
 
         LXAccount account;
-        account.main = abi::decode_address(args.data());
+        account.main = abi::decode_address(args);
 
-        uint32_t market_id = abi::decode_uint32(args.data() + 32 + 28);
+        uint32_t market_id = abi::decode_uint32(args + 32 + 28);
 
-        auto pos = dex_.vault().get_position(account, market_id);
-        if (!pos) return {};
+        auto pos = dex.vault().get_position(account, market_id);
+        if (!pos) return 0;
 
         // Encode LXPosition
-        std::vector<uint8_t> result(224);
-        abi::encode_int128(result.data(), static_cast<I128>(pos->market_id));
-        result[63] = static_cast<uint8_t>(pos->side);
-        abi::encode_int128(result.data() + 64, pos->size_x18);
-        abi::encode_int128(result.data() + 96, pos->entry_px_x18);
-        abi::encode_int128(result.data() + 128, pos->unrealized_pnl_x18);
-        abi::encode_int128(result.data() + 160, pos->accumulated_funding_x18);
-        abi::encode_uint64(result.data() + 192 + 24, pos->last_funding_time);
-        return result;
-    };
+        std::memset(out, 0, 224);
+        abi::encode_int128(out, static_cast<I128>(pos->market_id));
+        out[63] = static_cast<uint8_t>(pos->side);
+        abi::encode_int128(out + 64, pos->size_x18);
+        abi::encode_int128(out + 96, pos->entry_px_x18);
+        abi::encode_int128(out + 128, pos->unrealized_pnl_x18);
+        abi::encode_int128(out + 160, pos->accumulated_funding_x18);
+        abi::encode_uint64(out + 192 + 24, pos->last_funding_time);
+        return 224;
+    });
 
     // getBalance(address,address) -> 0xf8b2cb4f
-    handlers_[vault_key][0xf8b2cb4f] = [this](const std::vector<uint8_t>& args) -> std::vector<uint8_t> {
-        if (args.size() < 64) return {};
+    add_view(vault_key, 0xf8b2cb4f, [](const LX& dex, const uint8_t* args, size_t len, uint8_t* out) -> size_t {
+        if (len < 64) return 0;
 
         LXAccount account;
-        account.main = abi::decode_address(args.data());
+        account.main = abi::decode_address(args);
 
         Currency token;
-        token.addr = abi::decode_address(args.data() + 32);
+        token.addr = abi::decode_address(args + 32);
 
-        I128 balance = dex_.vault().get_balance(account, token);
-        return abi::encode_int128_vec(balance);
-    };
+        I128 balance = dex.vault().get_balance(account, token);
+        return abi::encode_int128_word(out, balance);
+    });
 
     // getMarginInfo(address) -> 0x6d435421
-    handlers_[vault_key][0x6d435421] = [this](const std::vector<uint8_t>& args) -> std::vector<uint8_t> {
-        if (args.size() < 32) return {};
+    add_view(vault_key, 0x6d435421, [](const LX& dex, const uint8_t* args, size_t len, uint8_t* out) -> size_t {
+        if (len < 32) return 0;
 
         LXAccount account;
-        account.main = abi::decode_address(args.data());
+        account.main = abi::decode_address(args);
 
-        LXMarginInfo info = dex_.vault().get_margin_info(account);
+        LXMarginInfo info = dex.vault().get_margin_info(account);
 
         // Encode LXMarginInfo
-        std::vector<uint8_t> result(192);
-        abi::encode_int128(result.data(), info.total_collateral_x18);
-        abi::encode_int128(result.data() + 32, info.used_margin_x18);
-        abi::encode_int128(result.data() + 64, info.free_margin_x18);
-        abi::encode_int128(result.data() + 96, info.margin_ratio_x18);
-        abi::encode_int128(result.data() + 128, info.maintenance_margin_x18);
-        result[160 + 31] = info.liquidatable ? 1 : 0;
-        return result;
-    };
+        std::memset(out, 0, 192);
+        abi::encode_int128(out, info.total_collateral_x18);
+        abi::encode_int128(out + 32, info.used_margin_x18);
+        abi::encode_int128(out + 64, info.free_margin_x18);
+        abi::encode_int128(out + 96, info.margin_ratio_x18);
+        abi::encode_int128(out + 128, info.maintenance_margin_x18);
+        out[160 + 31] = info.liquidatable ? 1 : 0;
+        return 192;
+    });
 
     // isLiquidatable(address) -> 0x8a7c195f
-    handlers_[vault_key][0x8a7c195f] = [this](const std::vector<uint8_t>& args) -> std::vector<uint8_t> {
-        if (args.size() < 32) return {};
+    add_view(vault_key, 0x8a7c195f, [](const LX& dex, const uint8_t* args, size_t len, uint8_t* out) -> size_t {
+        if (len < 32) return 0;
 
         LXAccount account;
-        account.main = abi::decode_address(args.data());
+        account.main = abi::decode_address(args);
 
-        bool liquidatable = dex_.vault().is_liquidatable(account);
-        return abi::encode_bool(liquidatable);
-    };
+        bool liquidatable = dex.vault().is_liquidatable(account);
+        return abi::encode_bool(out, liquidatable);
+    });
 
     // liquidate(address,address,uint32,int128) -> 0x2e1a7d4d
-    handlers_[vault_key][0x2e1a7d4d] = [this](const std::vector<uint8_t>& args) -> std::vector<uint8_t> {
-        if (args.size() < 128) return {};
+    add(vault_key, 0x2e1a7d4d, [](LX& dex, const uint8_t* args, size_t len, uint8_t* out) -> size_t {
+        if (len < 128) return 0;
 
         LXAccount liquidator;
-        liquidator.main = abi::decode_address(args.data());
+        liquidator.main = abi::decode_address(args);
 
         LXAccount account;
-        account.main = abi::decode_address(args.data() + 32);
+        account.main = abi::decode_address(args + 32);
 
-        uint32_t market_id = abi::decode_uint32(args.data() + 64 + 28);
-        I128 size_x18 = abi::decode_int128(args.data() + 96);
+        uint32_t market_id = abi::decode_uint32(args + 64 + 28);
+        I128 size_x18 = abi::decode_int128(args + 96);
 
-        LXLiquidationResult result = dex_.vault().liquidate(liquidator, account, market_id, size_x18);
+        LXLiquidationResult result = dex.vault().liquidate(liquidator, account, market_id, size_x18);
 
         // Encode result
-        std::vector<uint8_t> encoded(192);
-        abi::encode_int128(encoded.data(), static_cast<I128>(result.market_id));
-        abi::encode_int128(encoded.data() + 32, result.size_x18);
-        abi::encode_int128(encoded.data() + 64, result.price_x18);
-        abi::encode_int128(encoded.data() + 96, result.penalty_x18);
-        encoded[128 + 31] = result.adl_triggered ? 1 : 0;
-        return encoded;
-    };
+        std::memset(out, 0, 192);
+        abi::encode_int128(out, static_cast<I128>(result.market_id));
+        abi::encode_int128(out + 32, result.size_x18);
+        abi::encode_int128(out + 64, result.price_x18);
+        abi::encode_int128(out + 96, result.penalty_x18);
+        out[128 + 31] = result.adl_triggered ? 1 : 0;
+        return 192;
+    });
 }
 
 // =============================================================================
@@ -956,84 +1507,84 @@ void PrecompileRouter::register_oracle_handlers() {
     uint64_t oracle_key = addresses::to_lp(addresses::LX_ORACLE);
 
     // getPrice(uint64) -> 0x99cff17c
-    handlers_[oracle_key][0x99cff17c] = [this](const std::vector<uint8_t>& args) -> std::vector<uint8_t> {
-        if (args.size() < 32) return {};
+    add_view(oracle_key, 0x99cff17c, [](const LX& dex, const uint8_t* args, size_t len, uint8_t* out) -> size_t {
+        if (len < 32) return 0;
 
-        uint64_t asset_id = abi::decode_uint64(args.data() + 24);
+        uint64_t asset_id = abi::decode_uint64(args + 24);
 
-        auto price = dex_.oracle().get_price(asset_id);
-        if (!price) return {};
+        auto price = dex.oracle().get_price(asset_id);
+        if (!price) return 0;
 
-        return abi::encode_int128_vec(*price);
-    };
+        return abi::encode_int128_word(out, *price);
+    });
 
     // getPriceData(uint64) -> 0x3d18b912
-    handlers_[oracle_key][0x3d18b912] = [this](const std::vector<uint8_t>& args) -> std::vector<uint8_t> {
-        if (args.size() < 32) return {};
+    add_view(oracle_key, 0x3d18b912, [](const LX& dex, const uint8_t* args, size_t len, uint8_t* out) -> size_t {
+        if (len < 32) return 0;
 
-        uint64_t asset_id = abi::decode_uint64(args.data() + 24);
+        uint64_t asset_id = abi::decode_uint64(args + 24);
 
-        auto data = dex_.oracle().get_price_data(asset_id);
-        if (!data) return {};
+        auto data = dex.oracle().get_price_data(asset_id);
+        if (!data) return 0;
 
         // Encode AggregatedPriceData
-        std::vector<uint8_t> result(192);
-        abi::encode_int128(result.data(), data->price_x18);
-        abi::encode_int128(result.data() + 32, data->confidence_x18);
-        abi::encode_int128(result.data() + 64, data->deviation_x18);
-        result[96 + 31] = data->num_sources;
-        abi::encode_uint64(result.data() + 128 + 24, data->timestamp);
-        result[160 + 31] = static_cast<uint8_t>(data->method);
-        return result;
-    };
+        std::memset(out, 0, 192);
+        abi::encode_int128(out, data->price_x18);
+        abi::encode_int128(out + 32, data->confidence_x18);
+        abi::encode_int128(out + 64, data->deviation_x18);
+        out[96 + 31] = data->num_sources;
+        abi::encode_uint64(out + 128 + 24, data->timestamp);
+        out[160 + 31] = static_cast<uint8_t>(data->method);
+        return 192;
+    });
 
     // updatePrice(uint64,uint8,int128,int128) -> 0x7d3e47c1
-    handlers_[oracle_key][0x7d3e47c1] = [this](const std::vector<uint8_t>& args) -> std::vector<uint8_t> {
-        if (args.size() < 128) return {};
+    add(oracle_key, 0x7d3e47c1, [](LX& dex, const uint8_t* args, size_t len, uint8_t* out) -> size_t {
+        if (len < 128) return 0;
 
-        uint64_t asset_id = abi::decode_uint64(args.data() + 24);
+        uint64_t asset_id = abi::decode_uint64(args + 24);
         PriceSource source = static_cast<PriceSource>(args[32 + 31]);
-        I128 price_x18 = abi::decode_int128(args.data() + 64);
-        I128 confidence_x18 = abi::decode_int128(args.data() + 96);
+        I128 price_x18 = abi::decode_int128(args + 64);
+        I128 confidence_x18 = abi::decode_int128(args + 96);
 
-        int32_t result = dex_.oracle().update_price(asset_id, source, price_x18, confidence_x18);
-        return abi::encode_int32(result);
-    };
+        int32_t result = dex.oracle().update_price(asset_id, source, price_x18, confidence_x18);
+        return abi::encode_int32(out, result);
+    });
 
     // indexPrice(uint64) -> 0xa1b2c3d4
-    handlers_[oracle_key][0xa1b2c3d4] = [this](const std::vector<uint8_t>& args) -> std::vector<uint8_t> {
-        if (args.size() < 32) return {};
+    add_view(oracle_key, 0xa1b2c3d4, [](const LX& dex, const uint8_t* args, size_t len, uint8_t* out) -> size_t {
+        if (len < 32) return 0;
 
-        uint64_t asset_id = abi::decode_uint64(args.data() + 24);
+        uint64_t asset_id = abi::decode_uint64(args + 24);
 
-        auto price = dex_.oracle().index_price(asset_id);
-        if (!price) return {};
+        auto price = dex.oracle().index_price(asset_id);
+        if (!price) return 0;
 
-        return abi::encode_int128_vec(*price);
-    };
+        return abi::encode_int128_word(out, *price);
+    });
 
     // getTwap(uint64,uint64) -> 0xb2c3d4e5
-    handlers_[oracle_key][0xb2c3d4e5] = [this](const std::vector<uint8_t>& args) -> std::vector<uint8_t> {
-        if (args.size() < 64) return {};
+    add_view(oracle_key, 0xb2c3d4e5, [](const LX& dex, const uint8_t* args, size_t len, uint8_t* out) -> size_t {
+        if (len < 64) return 0;
 
-        uint64_t asset_id = abi::decode_uint64(args.data() + 24);
-        uint64_t window = abi::decode_uint64(args.data() + 32 + 24);
+        uint64_t asset_id = abi::decode_uint64(args + 24);
+        uint64_t window = abi::decode_uint64(args + 32 + 24);
 
-        auto twap = dex_.oracle().get_twap(asset_id, window);
-        if (!twap) return {};
+        auto twap = dex.oracle().get_twap(asset_id, window);
+        if (!twap) return 0;
 
-        return abi::encode_int128_vec(*twap);
-    };
+        return abi::encode_int128_word(out, *twap);
+    });
 
     // isPriceFresh(uint64) -> 0xc3d4e5f6
-    handlers_[oracle_key][0xc3d4e5f6] = [this](const std::vector<uint8_t>& args) -> std::vector<uint8_t> {
-        if (args.size() < 32) return {};
+    add_view(oracle_key, 0xc3d4e5f6, [](const LX& dex, const uint8_t* args, size_t len, uint8_t* out) -> size_t {
+        if (len < 32) return 0;
 
-        uint64_t asset_id = abi::decode_uint64(args.data() + 24);
+        uint64_t asset_id = abi::decode_uint64(args + 24);
 
-        bool fresh = dex_.oracle().is_price_fresh(asset_id);
-        return abi::encode_bool(fresh);
-    };
+        bool fresh = dex.oracle().is_price_fresh(asset_id);
+        return abi::encode_bool(out, fresh);
+    });
 }
 
 // =============================================================================
@@ -1044,154 +1595,154 @@ void PrecompileRouter::register_feed_handlers() {
     uint64_t feed_key = addresses::to_lp(addresses::LX_FEED);
 
     // getMarkPrice(uint32) -> 0x82a0548d
-    handlers_[feed_key][0x82a0548d] = [this](const std::vector<uint8_t>& args) -> std::vector<uint8_t> {
-        if (args.size() < 32) return {};
+    add_view(feed_key, 0x82a0548d, [](const LX& dex, const uint8_t* args, size_t len, uint8_t* out) -> size_t {
+        if (len < 32) return 0;
 
-        uint32_t market_id = abi::decode_uint32(args.data() + 28);
+        uint32_t market_id = abi::decode_uint32(args + 28);
 
-        auto mark = dex_.feed().get_mark_price(market_id);
-        if (!mark) return {};
+        auto mark = dex.feed().get_mark_price(market_id);
+        if (!mark) return 0;
 
         // Encode LXMarkPrice: index, mark, premium, timestamp
-        std::vector<uint8_t> result(128);
-        abi::encode_int128(result.data(), mark->index_px_x18);
-        abi::encode_int128(result.data() + 32, mark->mark_px_x18);
-        abi::encode_int128(result.data() + 64, mark->premium_x18);
-        abi::encode_uint64(result.data() + 96 + 24, mark->timestamp);
-        return result;
-    };
+        std::memset(out, 0, 128);
+        abi::encode_int128(out, mark->index_px_x18);
+        abi::encode_int128(out + 32, mark->mark_px_x18);
+        abi::encode_int128(out + 64, mark->premium_x18);
+        abi::encode_uint64(out + 96 + 24, mark->timestamp);
+        return 128;
+    });
 
     // getFundingRate(uint32) -> 0x8c6f037f
-    handlers_[feed_key][0x8c6f037f] = [this](const std::vector<uint8_t>& args) -> std::vector<uint8_t> {
-        if (args.size() < 32) return {};
+    add_view(feed_key, 0x8c6f037f, [](const LX& dex, const uint8_t* args, size_t len, uint8_t* out) -> size_t {
+        if (len < 32) return 0;
 
-        uint32_t market_id = abi::decode_uint32(args.data() + 28);
+        uint32_t market_id = abi::decode_uint32(args + 28);
 
-        auto rate = dex_.feed().get_funding_rate(market_id);
-        if (!rate) return {};
+        auto rate = dex.feed().get_funding_rate(market_id);
+        if (!rate) return 0;
 
         // Encode LXFundingRate: rate, next_funding_time
-        std::vector<uint8_t> result(64);
-        abi::encode_int128(result.data(), rate->rate_x18);
-        abi::encode_uint64(result.data() + 32 + 24, rate->next_funding_time);
-        return result;
-    };
+        std::memset(out, 0, 64);
+        abi::encode_int128(out, rate->rate_x18);
+        abi::encode_uint64(out + 32 + 24, rate->next_funding_time);
+        return 64;
+    });
 
     // indexPrice(uint32) -> 0x9d0e1f2a
-    handlers_[feed_key][0x9d0e1f2a] = [this](const std::vector<uint8_t>& args) -> std::vector<uint8_t> {
-        if (args.size() < 32) return {};
+    add_view(feed_key, 0x9d0e1f2a, [](const LX& dex, const uint8_t* args, size_t len, uint8_t* out) -> size_t {
+        if (len < 32) return 0;
 
-        uint32_t market_id = abi::decode_uint32(args.data() + 28);
+        uint32_t market_id = abi::decode_uint32(args + 28);
 
-        auto price = dex_.feed().index_price(market_id);
-        if (!price) return {};
+        auto price = dex.feed().index_price(market_id);
+        if (!price) return 0;
 
-        return abi::encode_int128_vec(*price);
-    };
+        return abi::encode_int128_word(out, *price);
+    });
 
     // markPrice(uint32) -> 0xae1f2b3c
-    handlers_[feed_key][0xae1f2b3c] = [this](const std::vector<uint8_t>& args) -> std::vector<uint8_t> {
-        if (args.size() < 32) return {};
+    add_view(feed_key, 0xae1f2b3c, [](const LX& dex, const uint8_t* args, size_t len, uint8_t* out) -> size_t {
+        if (len < 32) return 0;
 
-        uint32_t market_id = abi::decode_uint32(args.data() + 28);
+        uint32_t market_id = abi::decode_uint32(args + 28);
 
-        auto price = dex_.feed().mark_price(market_id);
-        if (!price) return {};
+        auto price = dex.feed().mark_price(market_id);
+        if (!price) return 0;
 
-        return abi::encode_int128_vec(*price);
-    };
+        return abi::encode_int128_word(out, *price);
+    });
 
     // lastPrice(uint32) -> 0xbf2a3c4d
-    handlers_[feed_key][0xbf2a3c4d] = [this](const std::vector<uint8_t>& args) -> std::vector<uint8_t> {
-        if (args.size() < 32) return {};
+    add_view(feed_key, 0xbf2a3c4d, [](const LX& dex, const uint8_t* args, size_t len, uint8_t* out) -> size_t {
+        if (len < 32) return 0;
 
-        uint32_t market_id = abi::decode_uint32(args.data() + 28);
+        uint32_t market_id = abi::decode_uint32(args + 28);
 
-        auto price = dex_.feed().last_price(market_id);
-        if (!price) return {};
+        auto price = dex.feed().last_price(market_id);
+        if (!price) return 0;
 
-        return abi::encode_int128_vec(*price);
-    };
+        return abi::encode_int128_word(out, *price);
+    });
 
     // midPrice(uint32) -> 0xc03b4d5e
-    handlers_[feed_key][0xc03b4d5e] = [this](const std::vector<uint8_t>& args) -> std::vector<uint8_t> {
-        if (args.size() < 32) return {};
+    add_view(feed_key, 0xc03b4d5e, [](const LX& dex, const uint8_t* args, size_t len, uint8_t* out) -> size_t {
+        if (len < 32) return 0;
 
-        uint32_t market_id = abi::decode_uint32(args.data() + 28);
+        uint32_t market_id = abi::decode_uint32(args + 28);
 
-        auto price = dex_.feed().mid_price(market_id);
-        if (!price) return {};
+        auto price = dex.feed().mid_price(market_id);
+        if (!price) return 0;
 
-        return abi::encode_int128_vec(*price);
-    };
+        return abi::encode_int128_word(out, *price);
+    });
 
     // getAllPrices(uint32) -> 0xd14c5e6f
-    handlers_[feed_key][0xd14c5e6f] = [this](const std::vector<uint8_t>& args) -> std::vector<uint8_t> {
-        if (args.size() < 32) return {};
+    add_view(feed_key, 0xd14c5e6f, [](const LX& dex, const uint8_t* args, size_t len, uint8_t* out) -> size_t {
+        if (len < 32) return 0;
 
-        uint32_t market_id = abi::decode_uint32(args.data() + 28);
+        uint32_t market_id = abi::decode_uint32(args + 28);
 
-        auto prices = dex_.feed().get_all_prices(market_id);
-        if (!prices) return {};
+        auto prices = dex.feed().get_all_prices(market_id);
+        if (!prices) return 0;
 
         // Encode AllPrices: index, mark, last, mid, timestamp
-        std::vector<uint8_t> result(160);
-        abi::encode_int128(result.data(), prices->index_x18);
-        abi::encode_int128(result.data() + 32, prices->mark_x18);
-        abi::encode_int128(result.data() + 64, prices->last_x18);
-        abi::encode_int128(result.data() + 96, prices->mid_x18);
-        abi::encode_uint64(result.data() + 128 + 24, prices->timestamp);
-        return result;
-    };
+        std::memset(out, 0, 160);
+        abi::encode_int128(out, prices->index_x18);
+        abi::encode_int128(out + 32, prices->mark_x18);
+        abi::encode_int128(out + 64, prices->last_x18);
+        abi::encode_int128(out + 96, prices->mid_x18);
+        abi::encode_uint64(out + 128 + 24, prices->timestamp);
+        return 160;
+    });
 
     // premium(uint32) -> 0xe25d6f70
-    handlers_[feed_key][0xe25d6f70] = [this](const std::vector<uint8_t>& args) -> std::vector<uint8_t> {
-        if (args.size() < 32) return {};
+    add_view(feed_key, 0xe25d6f70, [](const LX& dex, const uint8_t* args, size_t len, uint8_t* out) -> size_t {
+        if (len < 32) return 0;
 
-        uint32_t market_id = abi::decode_uint32(args.data() + 28);
+        uint32_t market_id = abi::decode_uint32(args + 28);
 
-        auto premium = dex_.feed().premium(market_id);
-        if (!premium) return {};
+        auto premium = dex.feed().premium(market_id);
+        if (!premium) return 0;
 
-        return abi::encode_int128_vec(*premium);
-    };
+        return abi::encode_int128_word(out, *premium);
+    });
 
     // basis(uint32) -> 0xf36e7081
-    handlers_[feed_key][0xf36e7081] = [this](const std::vector<uint8_t>& args) -> std::vector<uint8_t> {
-        if (args.size() < 32) return {};
+    add_view(feed_key, 0xf36e7081, [](const LX& dex, const uint8_t* args, size_t len, uint8_t* out) -> size_t {
+        if (len < 32) return 0;
 
-        uint32_t market_id = abi::decode_uint32(args.data() + 28);
+        uint32_t market_id = abi::decode_uint32(args + 28);
 
-        auto basis = dex_.feed().basis(market_id);
-        if (!basis) return {};
+        auto basis = dex.feed().basis(market_id);
+        if (!basis) return 0;
 
-        return abi::encode_int128_vec(*basis);
-    };
+        return abi::encode_int128_word(out, *basis);
+    });
 
     // fundingInterval(uint32) -> 0x047f8192
-    handlers_[feed_key][0x047f8192] = [this](const std::vector<uint8_t>& args) -> std::vector<uint8_t> {
-        if (args.size() < 32) return {};
+    add_view(feed_key, 0x047f8192, [](const LX& dex, const uint8_t* args, size_t len, uint8_t* out) -> size_t {
+        if (len < 32) return 0;
 
-        uint32_t market_id = abi::decode_uint32(args.data() + 28);
+        uint32_t market_id = abi::decode_uint32(args + 28);
 
-        uint64_t interval = dex_.feed().funding_interval(market_id);
+        uint64_t interval = dex.feed().funding_interval(market_id);
 
-        std::vector<uint8_t> result(32, 0);
-        abi::encode_uint64(result.data() + 24, interval);
-        return result;
-    };
+        std::memset(out, 0, 32);
+        abi::encode_uint64(out + 24, interval);
+        return 32;
+    });
 
     // predictedFundingRate(uint32) -> 0x158092a3
-    handlers_[feed_key][0x158092a3] = [this](const std::vector<uint8_t>& args) -> std::vector<uint8_t> {
-        if (args.size() < 32) return {};
+    add_view(feed_key, 0x158092a3, [](const LX& dex, const uint8_t* args, size_t len, uint8_t* out) -> size_t {
+        if (len < 32) return 0;
 
-        uint32_t market_id = abi::decode_uint32(args.data() + 28);
+        uint32_t market_id = abi::decode_uint32(args + 28);
 
-        auto rate = dex_.feed().predicted_funding_rate(market_id);
-        if (!rate) return {};
+        auto rate = dex.feed().predicted_funding_rate(market_id);
+        if (!rate) return 0;
 
-        return abi::encode_int128_vec(*rate);
-    };
+        return abi::encode_int128_word(out, *rate);
+    });
 }
 
 } // namespace lux
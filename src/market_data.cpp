@@ -0,0 +1,355 @@
+// =============================================================================
+// market_data.cpp - Conflated multi-subscriber market data
+// =============================================================================
+
+#include "lux/market_data.hpp"
+#include "lux/clock.hpp"
+#include <algorithm>
+#include <cstring>
+
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+
+namespace lux {
+
+namespace {
+
+constexpr uint64_t MARKET_DATA_MAGIC = 0x4c55584d4b544454ull;  // "LUXMKTDT"
+constexpr uint32_t MARKET_DATA_VERSION = 1;
+
+// First page of the file; slots start at HEADER_BYTES. magic is stored
+// last, so a reader that sees it sees the rest of the header.
+struct MarketDataHeader {
+    std::atomic<uint64_t> magic;
+    uint32_t version;
+    uint32_t snapshot_size;
+    uint64_t capacity;
+    alignas(64) std::atomic<uint64_t> used;     // Slots handed out, in order
+};
+constexpr size_t HEADER_BYTES = 4096;
+static_assert(sizeof(MarketDataHeader) <= HEADER_BYTES, "header must fit its page");
+
+// The slot's version (WRITING while being rewritten, 0 before the first
+// publication), its market, then the snapshot as words
+constexpr size_t SNAPSHOT_WORDS = sizeof(MarketSnapshot) / sizeof(uint64_t);
+constexpr uint64_t WRITING = UINT64_MAX;
+struct alignas(64) Slot {
+    std::atomic<uint64_t> seq;
+    std::atomic<uint64_t> symbol_id;            // Set before the slot is counted in used
+    std::atomic<uint64_t> words[SNAPSHOT_WORDS];
+};
+static_assert(sizeof(MarketSnapshot) % sizeof(uint64_t) == 0, "snapshots are whole words");
+
+MarketDataHeader* header_of(void* mapping) {
+    return static_cast<MarketDataHeader*>(mapping);
+}
+
+Slot* slots_of(void* mapping) {
+    return reinterpret_cast<Slot*>(static_cast<char*>(mapping) + HEADER_BYTES);
+}
+
+} // namespace
+
+// =============================================================================
+// MarketDataPublisher
+// =============================================================================
+
+std::unique_ptr<MarketDataPublisher> MarketDataPublisher::create(const std::string& path,
+                                                                 MarketDataConfig config) {
+    config.max_markets = std::max<size_t>(config.max_markets, 1);
+    config.levels = std::min(config.levels, MARKET_DATA_LEVELS);
+    const size_t bytes = HEADER_BYTES + config.max_markets * sizeof(Slot);
+
+    // A new inode, so readers of a previous table are never truncated under
+    ::unlink(path.c_str());
+    int fd = ::open(path.c_str(), O_RDWR | O_CREAT | O_EXCL, 0644);
+    if (fd < 0) {
+        return nullptr;
+    }
+    if (::ftruncate(fd, static_cast<off_t>(bytes)) != 0) {
+        ::close(fd);
+        return nullptr;
+    }
+    void* mapping = ::mmap(nullptr, bytes, PROT_READ | PROT_WRITE, MAP_SHARED, fd, 0);
+    ::close(fd);
+    if (mapping == MAP_FAILED) {
+        return nullptr;
+    }
+
+    // The file is zero-filled: no slot in use, every version 0
+    MarketDataHeader* header = header_of(mapping);
+    header->version = MARKET_DATA_VERSION;
+    header->snapshot_size = sizeof(MarketSnapshot);
+    header->capacity = config.max_markets;
+    header->magic.store(MARKET_DATA_MAGIC, std::memory_order_release);
+
+    return std::unique_ptr<MarketDataPublisher>(
+        new MarketDataPublisher(path, mapping, bytes, config));
+}
+
+MarketDataPublisher::MarketDataPublisher(std::string path, void* mapping, size_t bytes,
+                                         MarketDataConfig config)
+    : path_(std::move(path)), mapping_(mapping), mapped_bytes_(bytes), config_(config) {
+    if (config_.interval.count() > 0) {
+        thread_ = std::thread([this] { run(); });
+    }
+}
+
+MarketDataPublisher::~MarketDataPublisher() {
+    {
+        std::lock_guard lock(mutex_);
+        running_ = false;
+    }
+    cv_.notify_all();
+    if (thread_.joinable()) {
+        thread_.join();
+    }
+    // The file stays so readers keep the last state
+    ::munmap(mapping_, mapped_bytes_);
+}
+
+void MarketDataPublisher::run() {
+    std::unique_lock lock(mutex_);
+    while (running_) {
+        cv_.wait_for(lock, config_.interval);
+        for (Market* market : dirty_) {
+            publish(*market);
+        }
+        dirty_.clear();
+    }
+}
+
+MarketDataPublisher::Market& MarketDataPublisher::market(uint64_t symbol_id) {
+    auto [it, inserted] = markets_.try_emplace(symbol_id);
+    Market& market = it->second;
+    if (inserted) {
+        market.snapshot.symbol_id = symbol_id;
+        if (slots_used_ < config_.max_markets) {
+            market.slot = slots_used_++;
+            slots_of(mapping_)[market.slot].symbol_id.store(symbol_id, std::memory_order_relaxed);
+            header_of(mapping_)->used.store(slots_used_, std::memory_order_release);
+        } else {
+            ++stats_.unpublished;
+        }
+    }
+    return market;
+}
+
+void MarketDataPublisher::touch(Market& market) {
+    ++stats_.updates;
+    if (config_.interval.count() == 0) {
+        publish(market);
+    } else if (!market.dirty) {
+        market.dirty = true;
+        dirty_.push_back(&market);
+    }
+}
+
+void MarketDataPublisher::publish(Market& market) {
+    market.dirty = false;
+    if (market.slot == SIZE_MAX) {
+        return;
+    }
+
+    MarketSnapshot& snapshot = market.snapshot;
+    ++snapshot.version;
+    snapshot.publish_time_ns = SystemClock::instance().now().count();
+    auto fill = [this](const auto& ladder, MarketDataLevel* out, uint32_t& count) {
+        count = 0;
+        for (const auto& [_, level] : ladder) {
+            if (count == config_.levels) break;
+            out[count++] = level;
+        }
+        std::fill(out + count, out + MARKET_DATA_LEVELS, MarketDataLevel{});
+    };
+    fill(market.bids, snapshot.bids, snapshot.bid_count);
+    fill(market.asks, snapshot.asks, snapshot.ask_count);
+
+    uint64_t words[SNAPSHOT_WORDS];
+    std::memcpy(words, &snapshot, sizeof(MarketSnapshot));
+    Slot& slot = slots_of(mapping_)[market.slot];
+    slot.seq.store(WRITING, std::memory_order_relaxed);
+    std::atomic_thread_fence(std::memory_order_release);
+    for (size_t i = 0; i < SNAPSHOT_WORDS; ++i) {
+        slot.words[i].store(words[i], std::memory_order_relaxed);
+    }
+    slot.seq.store(snapshot.version, std::memory_order_release);
+    ++stats_.publications;
+}
+
+void MarketDataPublisher::on_trade(const Trade& trade) {
+    on_trade_batch(&trade, 1);
+}
+
+void MarketDataPublisher::on_trade_batch(const Trade* trades, size_t count) {
+    {
+        std::lock_guard lock(mutex_);
+        for (size_t i = 0; i < count; ++i) {
+            const Trade& trade = trades[i];
+            Market& m = market(trade.symbol_id);
+            m.snapshot.last_trade_price = trade.price;
+            m.snapshot.last_trade_quantity = trade.quantity;
+            m.snapshot.volume += trade.quantity;
+            ++m.snapshot.trade_count;
+            // One publication for the batch's last trade in on-change mode
+            if (i + 1 == count || trades[i + 1].symbol_id != trade.symbol_id ||
+                config_.interval.count() > 0) {
+                touch(m);
+            } else {
+                ++stats_.updates;
+            }
+        }
+    }
+    if (next_) {
+        next_->on_trade_batch(trades, count);
+    }
+}
+
+void MarketDataPublisher::on_order_filled(const Order& order) {
+    if (next_) {
+        next_->on_order_filled(order);
+    }
+}
+
+void MarketDataPublisher::on_order_partially_filled(const Order& order, Quantity fill_qty) {
+    if (next_) {
+        next_->on_order_partially_filled(order, fill_qty);
+    }
+}
+
+void MarketDataPublisher::on_order_cancelled(const Order& order) {
+    if (next_) {
+        next_->on_order_cancelled(order);
+    }
+}
+
+void MarketDataPublisher::on_book_delta(uint64_t symbol_id, const BookDelta& delta) {
+    std::lock_guard lock(mutex_);
+    Market& m = market(symbol_id);
+    m.snapshot.book_sequence = delta.sequence;
+    const bool removed = delta.quantity == 0 && delta.order_count == 0;
+    const MarketDataLevel level{delta.price, delta.quantity, delta.order_count, 0};
+    if (delta.side == Side::Buy) {
+        if (removed) m.bids.erase(delta.price); else m.bids[delta.price] = level;
+    } else {
+        if (removed) m.asks.erase(delta.price); else m.asks[delta.price] = level;
+    }
+    touch(m);
+}
+
+void MarketDataPublisher::on_price(uint64_t symbol_id, PriceType type, I128 price_x18) {
+    std::lock_guard lock(mutex_);
+    Market& m = market(symbol_id);
+    switch (type) {
+        case PriceType::INDEX:  m.snapshot.index_x18 = price_x18; break;
+        case PriceType::MARK:   m.snapshot.mark_x18 = price_x18; break;
+        case PriceType::LAST:   m.snapshot.last_x18 = price_x18; break;
+        case PriceType::ORACLE: m.snapshot.oracle_x18 = price_x18; break;
+        case PriceType::MID:    return;     // Derived from the book levels
+    }
+    touch(m);
+}
+
+void MarketDataPublisher::flush() {
+    std::lock_guard lock(mutex_);
+    for (Market* market : dirty_) {
+        publish(*market);
+    }
+    dirty_.clear();
+}
+
+MarketDataPublisher::Stats MarketDataPublisher::get_stats() const {
+    std::lock_guard lock(mutex_);
+    return stats_;
+}
+
+// =============================================================================
+// MarketDataReader
+// =============================================================================
+
+std::unique_ptr<MarketDataReader> MarketDataReader::open(const std::string& path) {
+    int fd = ::open(path.c_str(), O_RDONLY);
+    if (fd < 0) {
+        return nullptr;
+    }
+
+    struct stat st{};
+    if (::fstat(fd, &st) != 0 || static_cast<size_t>(st.st_size) < HEADER_BYTES) {
+        ::close(fd);
+        return nullptr;
+    }
+
+    const size_t bytes = static_cast<size_t>(st.st_size);
+    void* mapping = ::mmap(nullptr, bytes, PROT_READ, MAP_SHARED, fd, 0);
+    ::close(fd);
+    if (mapping == MAP_FAILED) {
+        return nullptr;
+    }
+
+    const MarketDataHeader* header = header_of(mapping);
+    const size_t capacity = header->capacity;
+    if (header->magic.load(std::memory_order_acquire) != MARKET_DATA_MAGIC ||
+        header->version != MARKET_DATA_VERSION ||
+        header->snapshot_size != sizeof(MarketSnapshot) ||
+        (bytes - HEADER_BYTES) / sizeof(Slot) < capacity) {
+        ::munmap(mapping, bytes);
+        return nullptr;
+    }
+
+    return std::unique_ptr<MarketDataReader>(new MarketDataReader(mapping, bytes, capacity));
+}
+
+MarketDataReader::~MarketDataReader() {
+    ::munmap(mapping_, mapped_bytes_);
+}
+
+size_t MarketDataReader::markets() const {
+    const uint64_t used = header_of(mapping_)->used.load(std::memory_order_acquire);
+    return static_cast<size_t>(std::min<uint64_t>(used, capacity_));
+}
+
+std::optional<size_t> MarketDataReader::find(uint64_t symbol_id) const {
+    const Slot* slots = slots_of(mapping_);
+    const size_t used = markets();
+    for (size_t i = 0; i < used; ++i) {
+        if (slots[i].symbol_id.load(std::memory_order_relaxed) == symbol_id) {
+            return i;
+        }
+    }
+    return std::nullopt;
+}
+
+bool MarketDataReader::read(size_t slot_index, MarketSnapshot& out) const {
+    if (slot_index >= markets()) {
+        return false;
+    }
+    const Slot& slot = slots_of(mapping_)[slot_index];
+    uint64_t words[SNAPSHOT_WORDS];
+    for (int attempt = 0; attempt < 64; ++attempt) {
+        const uint64_t version = slot.seq.load(std::memory_order_acquire);
+        if (version == 0) {
+            return false;
+        }
+        if (version == WRITING) {
+            continue;
+        }
+        for (size_t i = 0; i < SNAPSHOT_WORDS; ++i) {
+            words[i] = slot.words[i].load(std::memory_order_relaxed);
+        }
+        std::atomic_thread_fence(std::memory_order_acquire);
+        if (slot.seq.load(std::memory_order_relaxed) == version) {
+            std::memcpy(&out, words, sizeof(MarketSnapshot));
+            return true;
+        }
+    }
+    return false;
+}
+
+bool MarketDataReader::read_symbol(uint64_t symbol_id, MarketSnapshot& out) const {
+    const std::optional<size_t> slot = find(symbol_id);
+    return slot && read(*slot, out);
+}
+
+} // namespace lux
@@ -177,6 +177,7 @@ public:
     static std::vector<Trade> match_pro_rata(
         Order& aggressor,
         PriceLevel& level,
+        OrderPool& pool,
         uint64_t symbol_id,
         std::atomic<uint64_t>& trade_id_gen
     ) {
@@ -251,7 +252,8 @@ public:
         }
 
         // Remove filled orders
-        level.orders.remove_if([](const Order& o) { return o.is_filled(); });
+        level.orders.remove_if([](const Order& o) { return o.is_filled(); },
+                               [&pool](OrderNode* node) { pool.release(node); });
 
         // Recalculate total quantity
         level.total_quantity = 0;
@@ -36,6 +36,7 @@ int32_t LXOracle::register_asset(const OracleConfig& config) {
     params.trim_percent_x18 = x18::from_double(0.1);       // 10% trim
     params.use_volume_weighting = false;
     robust_params_[config.asset_id] = params;
+    config_generation_.fetch_add(1, std::memory_order_release);
 
     return errors::OK;
 }
@@ -49,6 +50,7 @@ int32_t LXOracle::update_config(uint64_t asset_id, const OracleConfig& config) {
     }
 
     it->second = config;
+    config_generation_.fetch_add(1, std::memory_order_release);
     return errors::OK;
 }
 
@@ -62,6 +64,7 @@ std::optional<OracleConfig> LXOracle::get_config(uint64_t asset_id) const {
 void LXOracle::set_robust_params(uint64_t asset_id, const RobustParams& params) {
     std::unique_lock lock(config_mutex_);
     robust_params_[asset_id] = params;
+    config_generation_.fetch_add(1, std::memory_order_release);
 }
 
 std::optional<RobustParams> LXOracle::get_robust_params(uint64_t asset_id) const {
@@ -86,8 +89,6 @@ int32_t LXOracle::update_price(uint64_t asset_id, PriceSource source,
         timestamp = current_timestamp();
     }
 
-    std::unique_lock lock(prices_mutex_);
-
     SourcePriceData data;
     data.source = source;
     data.price_x18 = price_x18;
@@ -96,9 +97,21 @@ int32_t LXOracle::update_price(uint64_t asset_id, PriceSource source,
     data.block_number = 0; // Would be set from context
     data.is_valid = true;
 
-    prices_[asset_id][static_cast<uint8_t>(source)] = data;
+    const AggregateInputs inputs = aggregate_inputs(asset_id);   // Config before prices
+    const uint64_t now = current_timestamp();
+
+    AssetPrices& asset = asset_slot(asset_id);
+    std::shared_ptr<const AggregateCache> cache;
+    {
+        std::lock_guard lock(asset.mutex);
+        set_source_price(asset, data);
+        ++asset.version;
+        cache = build_aggregates(asset, inputs, now);
+        std::atomic_store(&asset.cache, cache);
+    }
 
     total_updates_.fetch_add(1, std::memory_order_relaxed);
+    notify(asset_id, *cache);
 
     return errors::OK;
 }
@@ -106,11 +119,9 @@ int32_t LXOracle::update_price(uint64_t asset_id, PriceSource source,
 int32_t LXOracle::update_prices(const std::vector<std::tuple<uint64_t, PriceSource, I128, I128>>& updates) {
     uint64_t timestamp = current_timestamp();
 
-    std::unique_lock lock(prices_mutex_);
-
+    std::vector<std::pair<uint64_t, SourcePriceData>> records;
+    records.reserve(updates.size());
     for (const auto& [asset_id, source, price, confidence] : updates) {
-        if (price <= 0) continue;
-
         SourcePriceData data;
         data.source = source;
         data.price_x18 = price;
@@ -118,15 +129,95 @@ int32_t LXOracle::update_prices(const std::vector<std::tuple<uint64_t, PriceSour
         data.timestamp = timestamp;
         data.block_number = 0;
         data.is_valid = true;
+        records.emplace_back(asset_id, data);
+    }
+    return update_prices(records);
+}
 
-        prices_[asset_id][static_cast<uint8_t>(source)] = data;
+int32_t LXOracle::update_prices(const std::vector<std::pair<uint64_t, SourcePriceData>>& updates) {
+    const uint64_t now = current_timestamp();
+
+    // Group by asset, keeping each asset's updates in order; every asset is
+    // then applied and republished under its own lock only
+    std::vector<uint32_t> order(updates.size());
+    for (uint32_t i = 0; i < order.size(); ++i) {
+        order[i] = i;
+    }
+    std::stable_sort(order.begin(), order.end(), [&](uint32_t a, uint32_t b) {
+        return updates[a].first < updates[b].first;
+    });
+    auto usable = [](const SourcePriceData& data) { return data.is_valid && data.price_x18 > 0; };
+    std::vector<std::pair<uint64_t, std::shared_ptr<const AggregateCache>>> changed;
+
+    for (size_t begin = 0; begin < order.size();) {
+        const uint64_t asset_id = updates[order[begin]].first;
+        size_t end = begin;
+        bool any = false;
+        while (end < order.size() && updates[order[end]].first == asset_id) {
+            any |= usable(updates[order[end]].second);
+            ++end;
+        }
+        if (!any) {
+            begin = end;
+            continue;
+        }
+
+        const AggregateInputs inputs = aggregate_inputs(asset_id);
+        AssetPrices& asset = asset_slot(asset_id);
+        std::lock_guard lock(asset.mutex);
+        for (size_t i = begin; i < end; ++i) {
+            SourcePriceData data = updates[order[i]].second;
+            if (!usable(data)) continue;
+            if (data.timestamp == 0) {
+                data.timestamp = now;
+            }
+            set_source_price(asset, data);
+        }
+        ++asset.version;
+        changed.emplace_back(asset_id, build_aggregates(asset, inputs, now));
+        std::atomic_store(&asset.cache, changed.back().second);
+        begin = end;
     }
 
     total_updates_.fetch_add(updates.size(), std::memory_order_relaxed);
+    for (const auto& [asset_id, cache] : changed) {
+        notify(asset_id, *cache);
+    }
 
     return errors::OK;
 }
 
+LXOracle::AssetPrices* LXOracle::find_asset(uint64_t asset_id) const {
+    std::shared_lock lock(prices_mutex_);
+    auto it = prices_.find(asset_id);
+    return it != prices_.end() ? it->second.get() : nullptr;
+}
+
+LXOracle::AssetPrices& LXOracle::asset_slot(uint64_t asset_id) {
+    if (AssetPrices* asset = find_asset(asset_id)) {
+        return *asset;
+    }
+    std::unique_lock lock(prices_mutex_);
+    auto& slot = prices_[asset_id];
+    if (!slot) {
+        slot = std::make_unique<AssetPrices>();
+    }
+    return *slot;
+}
+
+void LXOracle::set_source_price(AssetPrices& asset, const SourcePriceData& data) {
+    auto& sources = asset.by_price;
+    auto old = std::find_if(sources.begin(), sources.end(), [&](const SourcePriceData& d) {
+        return d.source == data.source;
+    });
+    if (old != sources.end()) {
+        sources.erase(old);
+    }
+    auto pos = std::upper_bound(sources.begin(), sources.end(), data.price_x18,
+        [](I128 price, const SourcePriceData& d) { return price < d.price_x18; });
+    sources.insert(pos, data);
+}
+
 // =============================================================================
 // Price Queries
 // =============================================================================
@@ -138,82 +229,174 @@ std::optional<I128> LXOracle::get_price(uint64_t asset_id) const {
 }
 
 std::optional<AggregatedPriceData> LXOracle::get_price_data(uint64_t asset_id) const {
-    std::shared_lock config_lock(config_mutex_);
+    auto cache = aggregates(asset_id);
+    if (!cache) return std::nullopt;
+    return cache->price;
+}
+
+LXOracle::AggregateInputs LXOracle::aggregate_inputs(uint64_t asset_id) const {
+    AggregateInputs inputs;
+    std::shared_lock lock(config_mutex_);
+    inputs.generation = config_generation_.load(std::memory_order_acquire);
+
     auto config_it = configs_.find(asset_id);
-    if (config_it == configs_.end()) return std::nullopt;
+    if (config_it != configs_.end()) {
+        const OracleConfig& config = config_it->second;
+        inputs.configured = true;
+        inputs.max_staleness = config.max_staleness;
+        inputs.method = config.method;
+        if (config.weights_x18.size() == config.sources.size()) {
+            for (size_t i = 0; i < config.sources.size(); ++i) {
+                inputs.weights.emplace_back(config.sources[i], config.weights_x18[i]);
+            }
+        }
+    }
 
-    const OracleConfig& config = config_it->second;
-    config_lock.unlock();
+    auto robust_it = robust_params_.find(asset_id);
+    if (robust_it != robust_params_.end()) {
+        inputs.params = robust_it->second;
+    } else {
+        inputs.params.min_sources = 1;
+        inputs.params.outlier_threshold_x18 = x18::from_double(3.0);
+        inputs.params.trim_percent_x18 = x18::from_double(0.1);
+        inputs.params.use_volume_weighting = false;
+    }
+    return inputs;
+}
 
-    std::shared_lock price_lock(prices_mutex_);
-    auto asset_it = prices_.find(asset_id);
-    if (asset_it == prices_.end()) return std::nullopt;
+std::shared_ptr<const LXOracle::AggregateCache> LXOracle::aggregates(uint64_t asset_id) const {
+    AssetPrices* asset = find_asset(asset_id);
+    if (!asset) return nullptr;
 
-    // Collect valid prices from all sources
-    std::vector<I128> valid_prices;
-    uint64_t latest_timestamp = 0;
-    uint64_t now = current_timestamp();
+    const uint64_t now = current_timestamp();
+    auto cache = std::atomic_load(&asset->cache);
+    if (cache && now >= cache->computed_at && now < cache->expires_at &&
+        cache->config_generation == config_generation_.load(std::memory_order_acquire)) {
+        return cache;
+    }
+
+    // A source aged out or the configuration changed
+    const AggregateInputs inputs = aggregate_inputs(asset_id);
+    std::lock_guard lock(asset->mutex);
+    cache = build_aggregates(*asset, inputs, now);
+    std::atomic_store(&asset->cache, cache);
+    return cache;
+}
 
-    for (const auto& [source_id, data] : asset_it->second) {
-        // Check staleness
-        if (now - data.timestamp > config.max_staleness) {
+std::shared_ptr<const LXOracle::AggregateCache>
+LXOracle::build_aggregates(const AssetPrices& asset, const AggregateInputs& inputs, uint64_t now) const {
+    auto cache = std::make_shared<AggregateCache>();
+    cache->version = asset.version;
+    cache->config_generation = inputs.generation;
+    cache->computed_at = now;
+    cache->expires_at = UINT64_MAX;
+
+    // Fresh sources, in price order; the cache lasts until one of them
+    // goes stale or a future-dated one becomes current
+    std::vector<I128> prices;
+    std::vector<const SourcePriceData*> fresh;
+    uint64_t latest_timestamp = 0;
+    for (const SourcePriceData& data : asset.by_price) {
+        if (!data.is_valid) continue;
+        if (now - data.timestamp > inputs.max_staleness) {
+            if (data.timestamp > now) {
+                cache->expires_at = std::min(cache->expires_at, data.timestamp);
+            }
             continue;
         }
-        if (!data.is_valid) continue;
+        const uint64_t stale_at = data.timestamp + inputs.max_staleness + 1;
+        cache->expires_at = std::min(cache->expires_at, stale_at < data.timestamp ? UINT64_MAX : stale_at);
+        prices.push_back(data.price_x18);
+        fresh.push_back(&data);
+        latest_timestamp = std::max(latest_timestamp, data.timestamp);
+    }
 
-        valid_prices.push_back(data.price_x18);
-        if (data.timestamp > latest_timestamp) {
-            latest_timestamp = data.timestamp;
+    const I128 mean = aggregate_mean(prices);
+    auto sample_std_dev = [&](const std::vector<I128>& values) {
+        I128 variance = 0;
+        for (I128 p : values) {
+            I128 diff = p - mean;
+            variance += x18::mul(diff, diff);
+        }
+        if (values.size() > 1) {
+            variance /= static_cast<I128>(values.size() - 1);
+        }
+        return x18::sqrt(variance);
+    };
+
+    // Aggregated price, for configured assets
+    if (inputs.configured && !prices.empty()) {
+        I128 aggregated_price;
+        switch (inputs.method) {
+            case AggregationMethod::MEDIAN:
+                aggregated_price = aggregate_median(prices);
+                break;
+            case AggregationMethod::TWAP:
+            case AggregationMethod::VWAP:
+            case AggregationMethod::TRIMMED_MEAN:
+                aggregated_price = aggregate_trimmed_mean(prices, inputs.params.trim_percent_x18);
+                break;
+            case AggregationMethod::WEIGHTED_MEDIAN: {
+                // Weights follow the configured source list
+                std::vector<I128> weights;
+                for (const SourcePriceData* data : fresh) {
+                    for (const auto& [source, weight] : inputs.weights) {
+                        if (source == data->source) {
+                            weights.push_back(weight);
+                            break;
+                        }
+                    }
+                }
+                aggregated_price = aggregate_weighted_median(prices, weights);
+                break;
+            }
+            default:
+                aggregated_price = mean;
         }
-    }
 
-    if (valid_prices.empty()) return std::nullopt;
-
-    // Aggregate based on method
-    I128 aggregated_price;
-    switch (config.method) {
-        case AggregationMethod::MEDIAN:
-            aggregated_price = aggregate_median(valid_prices);
-            break;
-        case AggregationMethod::TWAP:
-        case AggregationMethod::VWAP:
-        case AggregationMethod::TRIMMED_MEAN: {
-            config_lock.lock();
-            auto robust_it = robust_params_.find(asset_id);
-            I128 trim = (robust_it != robust_params_.end()) ?
-                robust_it->second.trim_percent_x18 : x18::from_double(0.1);
-            config_lock.unlock();
-            aggregated_price = aggregate_trimmed_mean(valid_prices, trim);
-            break;
+        const I128 std_dev = sample_std_dev(prices);
+        AggregatedPriceData result;
+        result.price_x18 = aggregated_price;
+        result.confidence_x18 = std_dev; // Use std dev as confidence
+        result.deviation_x18 = std_dev;
+        result.num_sources = static_cast<uint8_t>(prices.size());
+        result.timestamp = latest_timestamp;
+        result.method = inputs.method;
+        cache->price = result;
+    }
+
+    // Index price, outliers removed
+    const RobustParams& params = inputs.params;
+    if (asset.by_price.size() >= params.min_sources && prices.size() >= params.min_sources &&
+        !prices.empty()) {
+        std::vector<bool> is_outlier = detect_outliers(prices, params.outlier_threshold_x18);
+
+        IndexPriceDetail result;
+        std::vector<I128> filtered_prices;
+        uint8_t outliers_count = 0;
+        for (size_t i = 0; i < prices.size(); ++i) {
+            if (is_outlier[i]) {
+                outliers_count++;
+                result.filtered_sources.push_back(fresh[i]->source);
+            } else {
+                filtered_prices.push_back(prices[i]);
+            }
+        }
+        if (filtered_prices.empty()) {
+            // All prices were outliers - fall back to median
+            filtered_prices = prices;
         }
-        case AggregationMethod::WEIGHTED_MEDIAN:
-            aggregated_price = aggregate_weighted_median(valid_prices, config.weights_x18);
-            break;
-        default:
-            aggregated_price = aggregate_mean(valid_prices);
-    }
 
-    // Calculate confidence and deviation
-    I128 mean = aggregate_mean(valid_prices);
-    I128 variance = 0;
-    for (I128 p : valid_prices) {
-        I128 diff = p - mean;
-        variance += x18::mul(diff, diff);
-    }
-    if (valid_prices.size() > 1) {
-        variance /= static_cast<I128>(valid_prices.size() - 1);
+        result.price_x18 = aggregate_trimmed_mean(filtered_prices, params.trim_percent_x18);
+        result.median_x18 = aggregate_median(prices);
+        result.mean_x18 = mean;
+        result.std_dev_x18 = sample_std_dev(filtered_prices);
+        result.sources_used = static_cast<uint8_t>(filtered_prices.size());
+        result.outliers_filtered = outliers_count;
+        cache->index = std::move(result);
     }
-    I128 std_dev = x18::sqrt(variance);
 
-    AggregatedPriceData result;
-    result.price_x18 = aggregated_price;
-    result.confidence_x18 = std_dev; // Use std dev as confidence
-    result.deviation_x18 = std_dev;
-    result.num_sources = static_cast<uint8_t>(valid_prices.size());
-    result.timestamp = latest_timestamp;
-    result.method = config.method;
-
-    return result;
+    return cache;
 }
 
 std::vector<std::pair<uint64_t, I128>> LXOracle::get_prices(const std::vector<uint64_t>& asset_ids) const {
@@ -231,29 +414,75 @@ std::vector<std::pair<uint64_t, I128>> LXOracle::get_prices(const std::vector<ui
 }
 
 std::optional<SourcePriceData> LXOracle::get_source_price(uint64_t asset_id, PriceSource source) const {
-    std::shared_lock lock(prices_mutex_);
+    AssetPrices* asset = find_asset(asset_id);
+    if (!asset) return std::nullopt;
 
-    auto asset_it = prices_.find(asset_id);
-    if (asset_it == prices_.end()) return std::nullopt;
-
-    auto source_it = asset_it->second.find(static_cast<uint8_t>(source));
-    if (source_it == asset_it->second.end()) return std::nullopt;
-
-    return source_it->second;
+    std::lock_guard lock(asset->mutex);
+    for (const SourcePriceData& data : asset->by_price) {
+        if (data.source == source) return data;
+    }
+    return std::nullopt;
 }
 
 std::vector<SourcePriceData> LXOracle::get_all_source_prices(uint64_t asset_id) const {
-    std::vector<SourcePriceData> results;
+    AssetPrices* asset = find_asset(asset_id);
+    if (!asset) return {};
 
-    std::shared_lock lock(prices_mutex_);
-    auto asset_it = prices_.find(asset_id);
-    if (asset_it == prices_.end()) return results;
+    std::lock_guard lock(asset->mutex);
+    return asset->by_price;
+}
+
+// =============================================================================
+// Change Subscriptions
+// =============================================================================
 
-    for (const auto& [source_id, data] : asset_it->second) {
-        results.push_back(data);
+uint64_t LXOracle::subscribe(PriceChangeListener listener) {
+    std::lock_guard lock(subscribe_mutex_);
+    auto current = std::atomic_load(&subscribers_);
+    auto next = current ? std::make_shared<Subscribers>(*current) : std::make_shared<Subscribers>();
+    const uint64_t id = next_subscription_++;
+    next->emplace_back(id, std::move(listener));
+    std::atomic_store(&subscribers_, std::shared_ptr<const Subscribers>(std::move(next)));
+    return id;
+}
+
+void LXOracle::unsubscribe(uint64_t subscription) {
+    std::lock_guard lock(subscribe_mutex_);
+    auto current = std::atomic_load(&subscribers_);
+    if (!current) return;
+    auto next = std::make_shared<Subscribers>();
+    for (const auto& entry : *current) {
+        if (entry.first != subscription) {
+            next->push_back(entry);
+        }
     }
+    std::atomic_store(&subscribers_, std::shared_ptr<const Subscribers>(std::move(next)));
+}
 
-    return results;
+uint64_t LXOracle::price_version(uint64_t asset_id) const {
+    AssetPrices* asset = find_asset(asset_id);
+    if (!asset) return 0;
+    auto cache = std::atomic_load(&asset->cache);
+    return cache ? cache->version : 0;
+}
+
+void LXOracle::notify(uint64_t asset_id, const AggregateCache& cache) const {
+    auto subscribers = std::atomic_load(&subscribers_);
+    if (!subscribers || subscribers->empty()) {
+        return;
+    }
+    PriceChangeEvent event;
+    event.asset_id = asset_id;
+    event.version = cache.version;
+    if (cache.price) {
+        event.price_x18 = cache.price->price_x18;
+    }
+    if (cache.index) {
+        event.index_x18 = cache.index->price_x18;
+    }
+    for (const auto& [id, listener] : *subscribers) {
+        listener(event);
+    }
 }
 
 // =============================================================================
@@ -267,137 +496,87 @@ std::optional<I128> LXOracle::index_price(uint64_t asset_id) const {
 }
 
 std::optional<LXOracle::IndexPriceDetail> LXOracle::index_price_detailed(uint64_t asset_id) const {
-    std::shared_lock config_lock(config_mutex_);
-    auto robust_it = robust_params_.find(asset_id);
-    RobustParams params;
-    if (robust_it != robust_params_.end()) {
-        params = robust_it->second;
-    } else {
-        params.min_sources = 1;
-        params.outlier_threshold_x18 = x18::from_double(3.0);
-        params.trim_percent_x18 = x18::from_double(0.1);
-        params.use_volume_weighting = false;
-    }
-    config_lock.unlock();
-
-    auto sources = get_all_source_prices(asset_id);
-    if (sources.size() < params.min_sources) {
-        return std::nullopt;
-    }
-
-    // Collect valid prices
-    std::vector<I128> prices;
-    std::vector<PriceSource> source_types;
-    uint64_t now = current_timestamp();
-
-    std::shared_lock cfg_lock(config_mutex_);
-    auto config_it = configs_.find(asset_id);
-    uint64_t max_staleness = (config_it != configs_.end()) ?
-        config_it->second.max_staleness : 60;
-    cfg_lock.unlock();
+    auto cache = aggregates(asset_id);
+    if (!cache) return std::nullopt;
+    return cache->index;
+}
 
-    for (const auto& data : sources) {
-        if (!data.is_valid) continue;
-        if (now - data.timestamp > max_staleness) continue;
+// =============================================================================
+// TWAP Interface
+// =============================================================================
 
-        prices.push_back(data.price_x18);
-        source_types.push_back(data.source);
+void LXOracle::TwapRing::push(uint64_t timestamp, I128 price_x18, uint64_t retain_seconds) {
+    U128 cumulative = 0;
+    if (count > 0) {
+        const TwapObservation& last = at(count - 1);
+        timestamp = std::max(timestamp, last.timestamp);
+        cumulative = last.cumulative +
+            static_cast<U128>(last.price_x18) * static_cast<U128>(timestamp - last.timestamp);
+
+        // Retire entries that ended before the retention cutoff; the entry in
+        // effect at the cutoff stays
+        const uint64_t cutoff = timestamp > retain_seconds ? timestamp - retain_seconds : 0;
+        while (count > 1 && at(1).timestamp <= cutoff) {
+            head = (head + 1) & (buffer.size() - 1);
+            --count;
+        }
     }
 
-    if (prices.size() < params.min_sources) {
-        return std::nullopt;
+    if (count == buffer.size()) {
+        std::vector<TwapObservation> grown;
+        grown.reserve(std::max<size_t>(16, buffer.size() * 2));
+        for (size_t i = 0; i < count; ++i) {
+            grown.push_back(at(i));
+        }
+        grown.resize(grown.capacity());
+        buffer = std::move(grown);
+        head = 0;
     }
+    buffer[(head + count) & (buffer.size() - 1)] = {timestamp, price_x18, cumulative};
+    ++count;
+}
 
-    // Calculate median and mean
-    I128 median = aggregate_median(prices);
-    I128 mean = aggregate_mean(prices);
-
-    // Detect outliers
-    std::vector<bool> is_outlier = detect_outliers(prices, params.outlier_threshold_x18);
-
-    // Filter outliers
-    std::vector<I128> filtered_prices;
-    std::vector<PriceSource> filtered_sources;
-    uint8_t outliers_count = 0;
-
-    for (size_t i = 0; i < prices.size(); ++i) {
-        if (is_outlier[i]) {
-            outliers_count++;
-            filtered_sources.push_back(source_types[i]);
+U128 LXOracle::TwapRing::cumulative_at(uint64_t t) const {
+    // Last entry at or before t
+    size_t lo = 0, hi = count;
+    while (hi - lo > 1) {
+        const size_t mid = lo + (hi - lo) / 2;
+        if (at(mid).timestamp <= t) {
+            lo = mid;
         } else {
-            filtered_prices.push_back(prices[i]);
+            hi = mid;
         }
     }
-
-    if (filtered_prices.empty()) {
-        // All prices were outliers - fall back to median
-        filtered_prices = prices;
-    }
-
-    // Calculate final index price
-    I128 index = aggregate_trimmed_mean(filtered_prices, params.trim_percent_x18);
-
-    // Calculate std dev
-    I128 variance = 0;
-    for (I128 p : filtered_prices) {
-        I128 diff = p - mean;
-        variance += x18::mul(diff, diff);
-    }
-    if (filtered_prices.size() > 1) {
-        variance /= static_cast<I128>(filtered_prices.size() - 1);
-    }
-    I128 std_dev = x18::sqrt(variance);
-
-    IndexPriceDetail result;
-    result.price_x18 = index;
-    result.median_x18 = median;
-    result.mean_x18 = mean;
-    result.std_dev_x18 = std_dev;
-    result.sources_used = static_cast<uint8_t>(filtered_prices.size());
-    result.outliers_filtered = outliers_count;
-    result.filtered_sources = filtered_sources;
-
-    return result;
+    const TwapObservation& obs = at(lo);
+    return obs.cumulative + static_cast<U128>(obs.price_x18) * static_cast<U128>(t - obs.timestamp);
 }
 
-// =============================================================================
-// TWAP Interface
-// =============================================================================
-
 std::optional<I128> LXOracle::get_twap(uint64_t asset_id, uint64_t window_seconds) const {
-    std::shared_lock lock(twap_mutex_);
-
-    auto it = twap_data_.find(asset_id);
-    if (it == twap_data_.end() || it->second.empty()) {
-        return std::nullopt;
+    const AssetTwap* twap = nullptr;
+    {
+        std::shared_lock map_lock(twap_mutex_);
+        auto it = twap_data_.find(asset_id);
+        if (it == twap_data_.end()) {
+            return std::nullopt;
+        }
+        twap = it->second.get();
     }
 
-    uint64_t now = current_timestamp();
-    uint64_t cutoff = now - window_seconds;
-
-    I128 sum = 0;
-    I128 total_weight = 0;
-    I128 prev_time = cutoff;
-
-    for (const auto& [timestamp, price] : it->second) {
-        if (timestamp < cutoff) continue;
-
-        I128 weight = static_cast<I128>(timestamp - prev_time);
-        sum += x18::mul(price, weight);
-        total_weight += weight;
-        prev_time = timestamp;
+    std::shared_lock lock(twap->mutex);
+    const TwapRing& ring = twap->ring;
+    if (ring.count == 0) {
+        return std::nullopt;
     }
 
-    // Add weight for time until now
-    if (!it->second.empty() && it->second.back().first >= cutoff) {
-        I128 final_weight = static_cast<I128>(now - prev_time);
-        sum += x18::mul(it->second.back().second, final_weight);
-        total_weight += final_weight;
+    const uint64_t now = current_timestamp();
+    const uint64_t cutoff = now > window_seconds ? now - window_seconds : 0;
+    const uint64_t start = std::max(cutoff, ring.at(0).timestamp);
+    if (now <= start) {
+        return std::nullopt;
     }
 
-    if (total_weight == 0) return std::nullopt;
-
-    return x18::div(sum, total_weight);
+    const I128 sum = static_cast<I128>(ring.cumulative_at(now) - ring.cumulative_at(start));
+    return sum / static_cast<I128>(now - start);
 }
 
 void LXOracle::record_twap_price(uint64_t asset_id, I128 price_x18, uint64_t timestamp) {
@@ -405,21 +584,28 @@ void LXOracle::record_twap_price(uint64_t asset_id, I128 price_x18, uint64_t tim
         timestamp = current_timestamp();
     }
 
-    std::unique_lock lock(twap_mutex_);
-
-    auto& history = twap_data_[asset_id];
-    history.emplace_back(timestamp, price_x18);
-
     // Keep only last 24 hours of data
     constexpr uint64_t MAX_HISTORY = 24 * 3600;
-    uint64_t cutoff = timestamp > MAX_HISTORY ? timestamp - MAX_HISTORY : 0;
 
-    auto new_begin = std::lower_bound(history.begin(), history.end(), cutoff,
-        [](const auto& p, uint64_t t) { return p.first < t; });
-
-    if (new_begin != history.begin()) {
-        history.erase(history.begin(), new_begin);
+    AssetTwap* twap = nullptr;
+    {
+        std::shared_lock map_lock(twap_mutex_);
+        auto it = twap_data_.find(asset_id);
+        if (it != twap_data_.end()) {
+            twap = it->second.get();
+        }
     }
+    if (!twap) {
+        std::unique_lock map_lock(twap_mutex_);
+        auto& slot = twap_data_[asset_id];
+        if (!slot) {
+            slot = std::make_unique<AssetTwap>();
+        }
+        twap = slot.get();
+    }
+
+    std::unique_lock lock(twap->mutex);
+    twap->ring.push(timestamp, price_x18, MAX_HISTORY);
 }
 
 // =============================================================================
@@ -441,13 +627,12 @@ bool LXOracle::is_price_fresh(uint64_t asset_id, uint64_t max_staleness) const {
 }
 
 uint64_t LXOracle::price_age(uint64_t asset_id) const {
-    std::shared_lock lock(prices_mutex_);
-
-    auto asset_it = prices_.find(asset_id);
-    if (asset_it == prices_.end()) return UINT64_MAX;
+    AssetPrices* asset = find_asset(asset_id);
+    if (!asset) return UINT64_MAX;
 
+    std::lock_guard lock(asset->mutex);
     uint64_t latest = 0;
-    for (const auto& [source_id, data] : asset_it->second) {
+    for (const auto& data : asset->by_price) {
         if (data.timestamp > latest) {
             latest = data.timestamp;
         }
@@ -468,13 +653,14 @@ LXOracle::Stats LXOracle::get_stats() const {
     uint64_t stale_count = 0;
     uint64_t now = current_timestamp();
 
-    for (const auto& [asset_id, sources] : prices_) {
+    for (const auto& [asset_id, asset] : prices_) {
         auto config_it = configs_.find(asset_id);
         uint64_t max_staleness = (config_it != configs_.end()) ?
             config_it->second.max_staleness : 60;
 
+        std::lock_guard asset_lock(asset->mutex);
         bool has_fresh = false;
-        for (const auto& [source_id, data] : sources) {
+        for (const auto& data : asset->by_price) {
             if (now - data.timestamp <= max_staleness) {
                 has_fresh = true;
                 break;
@@ -0,0 +1,184 @@
+// =============================================================================
+// oracle_scheduler.cpp - Concurrent IOracleSource Polling
+// =============================================================================
+
+#include "lux/oracle_scheduler.hpp"
+#include <algorithm>
+#include <exception>
+
+namespace lux {
+
+namespace {
+
+using Clock = std::chrono::steady_clock;
+
+} // anonymous namespace
+
+// =============================================================================
+// Lifecycle
+// =============================================================================
+
+OracleScheduler::OracleScheduler(LXOracle& oracle, const OracleSchedulerConfig& config)
+    : oracle_(oracle), config_(config) {
+    config_.tick_ms = std::max<uint64_t>(1, config_.tick_ms);
+}
+
+OracleScheduler::~OracleScheduler() {
+    stop();
+}
+
+size_t OracleScheduler::add_source(IOracleSource& source, const SourceSchedule& schedule) {
+    auto entry = std::make_unique<Source>();
+    entry->source = &source;
+    entry->schedule = schedule;
+    entry->schedule.interval_ms = std::max<uint64_t>(1, schedule.interval_ms);
+    sources_.push_back(std::move(entry));
+    return sources_.size() - 1;
+}
+
+void OracleScheduler::start() {
+    if (running_.exchange(true)) {
+        return;  // Already running
+    }
+    for (auto& source : sources_) {
+        Source& s = *source;
+        s.thread = std::thread([this, &s] { poll_loop(s); });
+    }
+    collector_ = std::thread([this] { collect_loop(); });
+}
+
+void OracleScheduler::stop() {
+    {
+        std::lock_guard lock(wait_mutex_);
+        if (!running_.exchange(false)) {
+            return;  // Already stopped
+        }
+    }
+    wait_cv_.notify_all();
+    for (auto& source : sources_) {
+        if (source->thread.joinable()) {
+            source->thread.join();
+        }
+    }
+    if (collector_.joinable()) {
+        collector_.join();
+    }
+    flush();
+}
+
+bool OracleScheduler::wait_until(Clock::time_point deadline) {
+    std::unique_lock lock(wait_mutex_);
+    wait_cv_.wait_until(lock, deadline, [this] {
+        return !running_.load(std::memory_order_acquire);
+    });
+    return running_.load(std::memory_order_acquire);
+}
+
+// =============================================================================
+// Polling
+// =============================================================================
+
+void OracleScheduler::poll_loop(Source& source) {
+    const auto interval = std::chrono::milliseconds(source.schedule.interval_ms);
+    auto next = Clock::now();
+    while (running_.load(std::memory_order_acquire)) {
+        poll(source);
+
+        // Keep the cadence; after an overrun, start again from now rather
+        // than firing the missed polls back to back
+        next += interval;
+        const auto now = Clock::now();
+        if (next < now) {
+            next = now;
+        }
+        if (!wait_until(next)) {
+            return;
+        }
+    }
+}
+
+void OracleScheduler::poll(Source& source) {
+    IOracleSource& adapter = *source.source;
+    if (!adapter.is_available()) {
+        source.failures.fetch_add(1, std::memory_order_relaxed);
+        return;
+    }
+
+    std::vector<std::pair<uint64_t, SourcePriceData>> results;
+    const auto start = Clock::now();
+    try {
+        results = adapter.fetch_prices(source.schedule.asset_ids);
+    } catch (const std::exception&) {
+        source.failures.fetch_add(1, std::memory_order_relaxed);
+        return;
+    }
+    const uint64_t nanos = static_cast<uint64_t>(
+        std::chrono::duration_cast<std::chrono::nanoseconds>(Clock::now() - start).count());
+    source.polls.fetch_add(1, std::memory_order_relaxed);
+    source.latency.record(nanos);
+
+    if (nanos > source.schedule.timeout_ms * 1000000) {
+        source.timeouts.fetch_add(1, std::memory_order_relaxed);
+        return;
+    }
+
+    const PriceSource type = adapter.source_type();
+    for (auto& result : results) {
+        result.second.source = type;
+    }
+    source.prices.fetch_add(results.size(), std::memory_order_relaxed);
+
+    std::lock_guard lock(pending_mutex_);
+    pending_.insert(pending_.end(), results.begin(), results.end());
+}
+
+// =============================================================================
+// Collection
+// =============================================================================
+
+void OracleScheduler::collect_loop() {
+    const auto tick = std::chrono::milliseconds(config_.tick_ms);
+    auto next = Clock::now() + tick;
+    while (wait_until(next)) {
+        flush();
+        next += tick;
+    }
+}
+
+size_t OracleScheduler::flush() {
+    std::vector<std::pair<uint64_t, SourcePriceData>> batch;
+    {
+        std::lock_guard lock(pending_mutex_);
+        batch.swap(pending_);
+    }
+    if (batch.empty()) {
+        return 0;
+    }
+    oracle_.update_prices(batch);
+    batches_.fetch_add(1, std::memory_order_relaxed);
+    return batch.size();
+}
+
+// =============================================================================
+// Statistics
+// =============================================================================
+
+std::vector<OracleScheduler::SourceStats> OracleScheduler::get_stats() const {
+    std::vector<SourceStats> stats;
+    stats.reserve(sources_.size());
+    for (const auto& source : sources_) {
+        SourceStats s;
+        s.source = source->source->source_type();
+        s.polls = source->polls.load(std::memory_order_relaxed);
+        s.prices = source->prices.load(std::memory_order_relaxed);
+        s.timeouts = source->timeouts.load(std::memory_order_relaxed);
+        s.failures = source->failures.load(std::memory_order_relaxed);
+        s.p50_nanos = source->latency.quantile(0.5);
+        s.p99_nanos = source->latency.quantile(0.99);
+        s.max_nanos = source->latency.max();
+        stats.push_back(s);
+    }
+    return stats;
+}
+
+} // namespace lux
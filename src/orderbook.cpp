@@ -1,506 +1,889 @@
 #include "lux/orderbook.hpp"
+#include "lux/types.hpp"
 #include <algorithm>
-#include <stdexcept>
+#include <mutex>
 
 namespace lux {
 
-OrderBook::OrderBook(uint64_t symbol_id)
-    : symbol_id_(symbol_id) {}
+OrderBook::OrderBook(uint64_t symbol_id, const OrderBookConfig& config,
+                     std::pmr::memory_resource* memory)
+    : symbol_id_(symbol_id), config_(config), backend_(config.backend),
+      bids_(memory ? memory : std::pmr::get_default_resource()),
+      asks_(memory ? memory : std::pmr::get_default_resource()),
+      index_arena_(memory ? memory : std::pmr::new_delete_resource()),
+      order_pool_(OrderPool::DEFAULT_BLOCK_SIZE, memory ? memory : std::pmr::get_default_resource()),
+      thread_safe_(config.thread_safe) {
+    bids_.configure(config);
+    asks_.configure(config);
+    if (config.initial_order_capacity > 0) {
+        order_pool_.reserve(config.initial_order_capacity);
+        order_locations_.reserve(config.initial_order_capacity);
+    }
+}
+
+const char* place_error_message(PlaceError error) {
+    switch (error) {
+        case PlaceError::None: return "";
+        case PlaceError::InvalidQuantity: return "Invalid size";
+        case PlaceError::InvalidPrice: return "Invalid price";
+        case PlaceError::OffTick: return "Price not on tick";
+        case PlaceError::OffLot: return "Size not a lot multiple";
+        case PlaceError::NotAllowed: return "Order type not allowed";
+    }
+    return "Rejected";
+}
 
 std::vector<Trade> OrderBook::place_order(Order order, TradeListener* listener) {
-    std::unique_lock lock(mutex_);
+    std::vector<Trade> trades;
+    place_order(std::move(order), trades, listener);
+    return trades;
+}
 
-    // Validate order
-    if (order.quantity <= 0) {
-        throw std::invalid_argument("Order quantity must be positive");
+PlaceOutcome OrderBook::place_order(Order order, std::vector<Trade>& trades, TradeListener* listener) {
+    // Validate before taking the lock: a refused order changes nothing
+    const PlaceError error = validate_(order);
+    if (error != PlaceError::None) {
+        return {error, 0};
     }
 
-    if (order.type == OrderType::Limit && order.price <= 0) {
-        throw std::invalid_argument("Limit order price must be positive");
-    }
+    auto lock = write_lock();
+    const size_t first_trade = trades.size();
 
-    order.status = OrderStatus::New;
-    order.filled = 0;
-    order.symbol_id = symbol_id_;
+    (this->*place_locked_)(order, trades, listener);
+    publish_updates();
 
-    // Set timestamp if not already set
-    if (order.timestamp.count() == 0) {
-        order.timestamp = std::chrono::duration_cast<Timestamp>(
-            std::chrono::system_clock::now().time_since_epoch()
-        );
-    }
+    return {PlaceError::None, trades.size() - first_trade};
+}
 
-    std::vector<Trade> trades;
+void OrderBook::add_to_book(Order order) {
+    order.status = order.filled > 0 ?
+        OrderStatus::PartiallyFilled : OrderStatus::New;
 
-    // Market orders and limit orders get matched
-    if (order.type == OrderType::Market || order.type == OrderType::Limit) {
-        trades = match_order(order, listener);
-    }
+    link_into_book(order_pool_.acquire(order));
+}
 
-    // Handle remaining quantity based on TimeInForce
-    if (order.remaining() > 0) {
-        switch (order.tif) {
-            case TimeInForce::IOC:
-                // Immediate or Cancel: cancel remaining
-                order.status = order.filled > 0 ?
-                    OrderStatus::PartiallyFilled : OrderStatus::Cancelled;
-                if (listener) {
-                    listener->on_order_cancelled(order);
-                }
-                break;
+void OrderBook::link_into_book(OrderNode* node) {
+    const Order& order = node->order;
+    note_level_change(order.side, order.price);
+    order_locations_[order.id] = OrderLocation{order.id, order.price, order.side, node};
 
-            case TimeInForce::FOK:
-                // Fill or Kill: should have been fully filled or rejected
-                // If we get here with remaining, the order was rejected
-                order.status = OrderStatus::Rejected;
-                break;
+    if (order.is_buy()) {
+        bids_.get_or_create(order.price).add_order(node);
+    } else {
+        asks_.get_or_create(order.price).add_order(node);
+    }
+}
 
-            case TimeInForce::GTC:
-            case TimeInForce::GTD:
-            case TimeInForce::DAY:
-                // Add to book if limit order
-                if (order.type == OrderType::Limit) {
-                    add_to_book(order);
-                } else {
-                    // Market orders that couldn't be fully filled
-                    order.status = order.filled > 0 ?
-                        OrderStatus::PartiallyFilled : OrderStatus::Cancelled;
-                }
-                break;
+void OrderBook::unlink_from_book(const OrderLocation& loc) {
+    note_level_change(loc.side, loc.price);
+    if (loc.side == Side::Buy) {
+        if (PriceLevel* level = bids_.find(loc.price)) {
+            level->remove_order(loc.node);
+            if (level->empty()) {
+                bids_.erase(loc.price);
+            }
         }
     } else {
-        order.status = OrderStatus::Filled;
-        if (listener) {
-            listener->on_order_filled(order);
+        if (PriceLevel* level = asks_.find(loc.price)) {
+            level->remove_order(loc.node);
+            if (level->empty()) {
+                asks_.erase(loc.price);
+            }
         }
     }
+}
 
-    return trades;
+std::optional<Order> OrderBook::cancel_order(uint64_t order_id) {
+    auto lock = write_lock();
+
+    auto loc_it = order_locations_.find(order_id);
+    if (loc_it == order_locations_.end()) {
+        return std::nullopt;
+    }
+
+    OrderLocation loc = loc_it->second;
+    order_locations_.erase(loc_it);
+
+    unlink_from_book(loc);
+
+    Order cancelled = loc.node->order;
+    cancelled.status = OrderStatus::Cancelled;
+    order_pool_.release(loc.node);
+
+    publish_updates();
+    return cancelled;
 }
 
-std::vector<Trade> OrderBook::match_order(Order& order, TradeListener* listener) {
-    std::vector<Trade> trades;
+std::optional<Order> OrderBook::modify_order(uint64_t order_id, Price new_price, Quantity new_quantity) {
+    auto lock = write_lock();
 
-    // FOK check: ensure we can fill the entire order
-    if (order.tif == TimeInForce::FOK) {
-        Quantity available = 0;
-        if (order.is_buy()) {
-            for (const auto& [price, level] : asks_) {
-                if (order.type == OrderType::Market ||
-                    prices_cross(order.price, price)) {
-                    available += level.total_quantity;
-                    if (available >= order.quantity) break;
-                } else {
-                    break;
-                }
-            }
-        } else {
-            for (const auto& [price, level] : bids_) {
-                if (order.type == OrderType::Market ||
-                    prices_cross(price, order.price)) {
-                    available += level.total_quantity;
-                    if (available >= order.quantity) break;
-                } else {
-                    break;
-                }
-            }
-        }
+    auto loc_it = order_locations_.find(order_id);
+    if (loc_it == order_locations_.end()) {
+        return std::nullopt;
+    }
 
-        if (available < order.quantity) {
-            order.status = OrderStatus::Rejected;
-            return trades;
+    // The replacement is held to the book's policy like a new order
+    if (new_quantity > loc_it->second.node->order.filled) {
+        Order replacement = loc_it->second.node->order;
+        replacement.price = new_price;
+        replacement.quantity = new_quantity;
+        if (validate_(replacement) != PlaceError::None) {
+            return std::nullopt;
         }
     }
 
-    // Match against opposite side
-    if (order.is_buy()) {
-        trades = match_against_side(order, asks_, listener);
-    } else {
-        trades = match_against_side(order, bids_, listener);
+    OrderLocation loc = loc_it->second;
+    order_locations_.erase(loc_it);
+
+    // Remove old order; the node is reused for the replacement
+    unlink_from_book(loc);
+
+    // Create modified order
+    OrderNode* node = loc.node;
+    Order& modified = node->order;
+    modified.price = new_price;
+    modified.quantity = new_quantity;
+    modified.timestamp = now();
+
+    // Validate new quantity
+    if (new_quantity <= modified.filled) {
+        Order cancelled = modified;
+        cancelled.status = OrderStatus::Cancelled;
+        order_pool_.release(node);
+        publish_updates();
+        return cancelled;
     }
 
-    return trades;
+    // Add back to book
+    link_into_book(node);
+    publish_updates();
+    return modified;
 }
 
-template<typename BookSide>
-std::vector<Trade> OrderBook::match_against_side(
-    Order& aggressor,
-    BookSide& book_side,
-    TradeListener* listener
-) {
-    std::vector<Trade> trades;
+void OrderBook::shrink_in_place(const OrderLocation& loc, Quantity new_quantity) {
+    Order& order = loc.node->order;
+    PriceLevel* level = loc.side == Side::Buy ? bids_.find(loc.price) : asks_.find(loc.price);
+    level->total_quantity -= order.quantity - new_quantity;
+    order.quantity = new_quantity;
+    note_level_change(loc.side, loc.price);
+}
 
-    auto it = book_side.begin();
-    while (it != book_side.end() && aggressor.remaining() > 0) {
-        PriceLevel& level = it->second;
-        Price level_price = it->first;
-
-        // Check if prices cross
-        bool crosses;
-        if (aggressor.type == OrderType::Market) {
-            crosses = true;
-        } else if (aggressor.is_buy()) {
-            crosses = prices_cross(aggressor.price, level_price);
-        } else {
-            crosses = prices_cross(level_price, aggressor.price);
-        }
+std::optional<Order> OrderBook::reduce_order(uint64_t order_id, Quantity new_quantity) {
+    auto lock = write_lock();
 
-        if (!crosses) {
-            break;
+    auto loc_it = order_locations_.find(order_id);
+    if (loc_it == order_locations_.end() || new_quantity >= loc_it->second.node->order.quantity) {
+        return std::nullopt;
+    }
+
+    OrderLocation loc = loc_it->second;
+    Order result = loc.node->order;
+    if (new_quantity > result.filled) {
+        Order reduced = result;
+        reduced.quantity = new_quantity;
+        if (validate_(reduced) != PlaceError::None) {
+            return std::nullopt;
         }
+    }
 
-        // Match against orders at this price level (FIFO)
-        while (!level.empty() && aggressor.remaining() > 0) {
-            Order* resting = level.front();
+    if (new_quantity <= result.filled) {
+        order_locations_.erase(loc_it);
+        unlink_from_book(loc);
+        order_pool_.release(loc.node);
+        result.status = OrderStatus::Cancelled;
+    } else {
+        shrink_in_place(loc, new_quantity);
+        result = loc.node->order;
+    }
 
-            // Self-trade prevention
-            if (would_self_trade(aggressor, *resting)) {
-                // Cancel the resting order
-                Order cancelled = *resting;
-                cancelled.status = OrderStatus::Cancelled;
-                level.pop_front();
-                order_locations_.erase(cancelled.id);
-                if (listener) {
-                    listener->on_order_cancelled(cancelled);
-                }
-                continue;
+    publish_updates();
+    return result;
+}
+
+MassQuoteSummary OrderBook::mass_quote(const MassQuoteRequest& request, Timestamp now, QuoteOutcome* outcomes,
+                                       std::vector<Order>& cancelled, std::vector<Trade>& trades,
+                                       TradeListener* listener) {
+    auto lock = write_lock();
+    MassQuoteSummary summary{};
+
+    // Live resting quotes, sorted by (side, price) so each level finds its
+    // counterpart by binary search
+    auto& resting = quote_resting_;
+    resting.clear();
+    for (size_t i = 0; i < request.resting_count; ++i) {
+        auto it = order_locations_.find(request.resting[i]);
+        if (it != order_locations_.end()) {
+            resting.push_back({it->second, false});
+        }
+    }
+    auto key_less = [](const RestingQuote& a, Side side, Price price) {
+        return a.loc.side != side ? a.loc.side < side : a.loc.price < price;
+    };
+    std::sort(resting.begin(), resting.end(), [&](const RestingQuote& a, const RestingQuote& b) {
+        return key_less(a, b.loc.side, b.loc.price) ||
+               (!key_less(b, a.loc.side, a.loc.price) && a.loc.order_id < b.loc.order_id);
+    });
+
+    // An id listed twice would be cancelled or adjusted twice
+    resting.erase(std::unique(resting.begin(), resting.end(),
+                              [](const RestingQuote& a, const RestingQuote& b) {
+                                  return a.loc.order_id == b.loc.order_id;
+                              }),
+                  resting.end());
+
+    // Pair each level with an unclaimed quote at the same side and price
+    auto& matches = quote_matches_;
+    matches.assign(request.level_count, RestingQuote::NONE);
+    for (size_t i = 0; i < request.level_count; ++i) {
+        const QuoteLevel& level = request.levels[i];
+        auto it = std::lower_bound(resting.begin(), resting.end(), level,
+            [&](const RestingQuote& quote, const QuoteLevel& l) { return key_less(quote, l.side, l.price); });
+        for (; it != resting.end() && it->loc.side == level.side && it->loc.price == level.price; ++it) {
+            if (!it->claimed) {
+                it->claimed = true;
+                matches[i] = static_cast<size_t>(it - resting.begin());
+                break;
             }
+        }
+    }
 
-            // Calculate fill quantity
-            Quantity fill_qty = std::min(aggressor.remaining(), resting->remaining());
+    // Cancel first so replacements cannot trade against what they replace
+    for (const RestingQuote& quote : resting) {
+        if (quote.claimed) {
+            continue;
+        }
+        order_locations_.erase(quote.loc.order_id);
+        unlink_from_book(quote.loc);
+        Order order = quote.loc.node->order;
+        order.status = OrderStatus::Cancelled;
+        order_pool_.release(quote.loc.node);
+        cancelled.push_back(order);
+        ++summary.cancelled;
+    }
 
-            // Update orders
-            aggressor.filled += fill_qty;
-            resting->filled += fill_qty;
+    // Adjust the quotes that stay, then place the new levels
+    for (size_t i = 0; i < request.level_count; ++i) {
+        const QuoteLevel& level = request.levels[i];
+        QuoteOutcome& outcome = outcomes[i];
+        if (level.price <= 0 || level.quantity <= 0) {
+            outcome = {0, QuoteAction::Rejected, 0, 0};
+            ++summary.rejected;
+            continue;
+        }
+        if (matches[i] == RestingQuote::NONE) {
+            continue;
+        }
 
-            // Create trade
-            Trade trade = aggressor.is_buy() ?
-                create_trade(aggressor, *resting, level_price, fill_qty, aggressor.side) :
-                create_trade(*resting, aggressor, level_price, fill_qty, aggressor.side);
+        const OrderLocation& loc = resting[matches[i]].loc;
+        Order& order = loc.node->order;
+        const Quantity target = order.filled + level.quantity;
+        if (level.quantity != order.remaining()) {
+            // A resized quote is held to the policy; a refused one rests as it was
+            Order resized = order;
+            resized.quantity = target;
+            if (validate_(resized) != PlaceError::None) {
+                outcome = {0, QuoteAction::Rejected, 0, 0};
+                ++summary.rejected;
+                continue;
+            }
+        }
+        QuoteAction action;
+        if (level.quantity == order.remaining()) {
+            action = QuoteAction::Kept;
+            ++summary.kept;
+        } else if (level.quantity < order.remaining()) {
+            shrink_in_place(loc, target);
+            action = QuoteAction::Reduced;
+            ++summary.reduced;
+        } else {
+            unlink_from_book(loc);
+            order.quantity = target;
+            order.timestamp = now;
+            link_into_book(loc.node);
+            action = QuoteAction::Requeued;
+            ++summary.requeued;
+        }
+        outcome = {order.id, action, order.quantity, order.filled};
+    }
 
-            trades.push_back(trade);
+    for (size_t i = 0; i < request.level_count; ++i) {
+        const QuoteLevel& level = request.levels[i];
+        if (matches[i] != RestingQuote::NONE || level.price <= 0 || level.quantity <= 0) {
+            continue;
+        }
+        Order order = make_quote_order(request.prototype, level);
+        if (order.timestamp.count() == 0) {
+            order.timestamp = now;
+        }
+        if (validate_(order) != PlaceError::None) {
+            outcomes[i] = {0, QuoteAction::Rejected, 0, 0};
+            ++summary.rejected;
+            continue;
+        }
+        (this->*place_locked_)(order, trades, listener);
+        outcomes[i] = {order.id, QuoteAction::Placed, order.quantity, order.filled};
+        ++summary.placed;
+    }
 
-            if (listener) {
-                listener->on_trade(trade);
+    publish_updates();
+    return summary;
+}
 
-                if (aggressor.is_filled()) {
-                    listener->on_order_filled(aggressor);
-                } else {
-                    listener->on_order_partially_filled(aggressor, fill_qty);
-                }
+Timestamp OrderBook::expiry_of(const Order& order) {
+    if (order.tif == TimeInForce::DAY && order.expire_time.count() == 0) {
+        constexpr Timestamp DAY = std::chrono::hours(24);
+        return (order.timestamp / DAY + 1) * DAY;
+    }
+    if (order.tif == TimeInForce::GTD || order.tif == TimeInForce::DAY) {
+        return order.expire_time;
+    }
+    return Timestamp{0};
+}
 
-                if (resting->is_filled()) {
-                    listener->on_order_filled(*resting);
-                } else {
-                    listener->on_order_partially_filled(*resting, fill_qty);
-                }
-            }
+void OrderBook::schedule_expiry(const Order& order) {
+    const Timestamp expiry = expiry_of(order);
+    if (expiry.count() <= 0) {
+        return;
+    }
+    // Round up so an order never expires before its time
+    expiries_.schedule(static_cast<uint64_t>((expiry + EXPIRY_TICK - Timestamp{1}) / EXPIRY_TICK),
+                       order.id);
+    pending_expiries_.store(expiries_.size(), std::memory_order_relaxed);
+}
 
-            // Remove filled resting order
-            if (resting->is_filled()) {
-                order_locations_.erase(resting->id);
-                level.pop_front();
-            }
-        }
+size_t OrderBook::expire_orders(Timestamp now, std::vector<Order>& expired) {
+    if (pending_expiries() == 0) {
+        return 0;  // Nothing scheduled: skip the lock
+    }
 
-        // Remove empty price level
-        if (level.empty()) {
-            it = book_side.erase(it);
-        } else {
-            ++it;
+    auto lock = write_lock();
+    const size_t first = expired.size();
+    expiries_.advance(static_cast<uint64_t>(now / EXPIRY_TICK), [&](uint64_t order_id) {
+        auto loc_it = order_locations_.find(order_id);
+        if (loc_it == order_locations_.end()) {
+            return;  // Filled or cancelled since
         }
+        OrderLocation loc = loc_it->second;
+        order_locations_.erase(loc_it);
+        unlink_from_book(loc);
+
+        Order order = loc.node->order;
+        order.status = OrderStatus::Expired;
+        order_pool_.release(loc.node);
+        expired.push_back(order);
+    });
+    pending_expiries_.store(expiries_.size(), std::memory_order_relaxed);
+
+    const size_t count = expired.size() - first;
+    if (count > 0) {
+        publish_updates();
     }
+    return count;
+}
 
-    // Update aggressor status
-    if (aggressor.filled > 0) {
-        aggressor.status = aggressor.is_filled() ?
-            OrderStatus::Filled : OrderStatus::PartiallyFilled;
+size_t OrderBook::uncross(std::vector<Trade>& trades, TradeListener* listener) {
+    auto lock = write_lock();
+    const size_t count = uncross_locked(trades, listener);
+    if (count > 0) {
+        publish_updates();
     }
-
-    return trades;
+    return count;
 }
 
-// Explicit template instantiations
-template std::vector<Trade> OrderBook::match_against_side(
-    Order&, std::map<Price, PriceLevel, std::greater<Price>>&, TradeListener*);
-template std::vector<Trade> OrderBook::match_against_side(
-    Order&, std::map<Price, PriceLevel>&, TradeListener*);
+std::optional<size_t> OrderBook::run_auction(Timestamp now, std::vector<Trade>& trades,
+                                             TradeListener* listener) {
+    if (!auction_due(now)) {
+        return std::nullopt;
+    }
 
-void OrderBook::add_to_book(Order order) {
-    order.status = order.filled > 0 ?
-        OrderStatus::PartiallyFilled : OrderStatus::New;
+    auto lock = write_lock();
+    if (!auction_due(now)) {
+        return std::nullopt;  // Another caller ran this slot
+    }
+    const int64_t interval = std::max<int64_t>(config_.auction_interval.count(), 1);
+    next_auction_.store((now.count() / interval + 1) * interval, std::memory_order_relaxed);
 
-    OrderLocation loc{order.id, order.price, order.side};
-    order_locations_[order.id] = loc;
+    const size_t count = uncross_locked(trades, listener);
+    if (count > 0) {
+        publish_updates();
+    }
+    return count;
+}
 
-    if (order.is_buy()) {
-        auto& level = bids_[order.price];
-        level.price = order.price;
-        level.add_order(std::move(order));
-    } else {
-        auto& level = asks_[order.price];
-        level.price = order.price;
-        level.add_order(std::move(order));
+std::optional<Price> OrderBook::last_auction_price() const {
+    auto lock = read_lock();
+    if (last_auction_price_ == 0) {
+        return std::nullopt;
     }
+    return last_auction_price_;
 }
 
-void OrderBook::remove_from_book(uint64_t order_id, Price price, Side side) {
-    if (side == Side::Buy) {
-        auto it = bids_.find(price);
-        if (it != bids_.end()) {
-            it->second.remove_order(order_id);
-            if (it->second.empty()) {
-                bids_.erase(it);
+template<typename BookSide>
+void OrderBook::allocate_auction(BookSide& side, const std::vector<AuctionLevel>& levels,
+                                 Price clearing, Quantity volume, std::vector<AuctionFill>& fills) {
+    Quantity left = volume;
+    for (const AuctionLevel& crossing : levels) {
+        const bool through = BookSide::ASCENDING ? crossing.price <= clearing : crossing.price >= clearing;
+        if (left == 0 || !through) {
+            break;
+        }
+        PriceLevel& level = *side.find(crossing.price);
+
+        if (level.total_quantity <= left) {
+            for (OrderNode* node = level.front_node(); node; node = node->next) {
+                fills.push_back({node, node->order.remaining()});
             }
+            left -= level.total_quantity;
+            continue;
         }
-    } else {
-        auto it = asks_.find(price);
-        if (it != asks_.end()) {
-            it->second.remove_order(order_id);
-            if (it->second.empty()) {
-                asks_.erase(it);
+
+        // Marginal level: ration what is left
+        const size_t first = fills.size();
+        Quantity given = 0;
+        for (OrderNode* node = level.front_node(); node; node = node->next) {
+            Quantity share = 0;
+            if (config_.allocation == AuctionAllocation::ProRata) {
+                share = static_cast<Quantity>(
+                    static_cast<I128>(node->order.remaining()) * left / level.total_quantity);
             }
+            fills.push_back({node, share});
+            given += share;
+        }
+        // Time priority, or the pro-rata rounding remainder, by FIFO
+        for (size_t i = first; i < fills.size() && given < left; ++i) {
+            const Quantity extra = std::min(fills[i].node->order.remaining() - fills[i].quantity,
+                                            left - given);
+            fills[i].quantity += extra;
+            given += extra;
         }
+        fills.erase(std::remove_if(fills.begin() + static_cast<std::ptrdiff_t>(first), fills.end(),
+                                   [](const AuctionFill& fill) { return fill.quantity == 0; }),
+                    fills.end());
+        left = 0;
     }
-    order_locations_.erase(order_id);
 }
 
-std::optional<Order> OrderBook::cancel_order(uint64_t order_id) {
-    std::unique_lock lock(mutex_);
+size_t OrderBook::uncross_locked(std::vector<Trade>& trades, TradeListener* listener) {
+    const PriceLevel* best_bid = bids_.best();
+    const PriceLevel* best_ask = asks_.best();
+    if (!best_bid || !best_ask || best_bid->price < best_ask->price) {
+        return 0;
+    }
+    const Price bid_price = best_bid->price;
+    const Price ask_price = best_ask->price;
+
+    // Crossing levels of each side, best first
+    auction_bids_.clear();
+    auction_asks_.clear();
+    Quantity demand = 0;
+    bids_.for_each([&](const PriceLevel& level) {
+        if (level.price < ask_price) return false;
+        auction_bids_.push_back({level.price, level.total_quantity});
+        demand += level.total_quantity;
+        return true;
+    });
+    asks_.for_each([&](const PriceLevel& level) {
+        if (level.price > bid_price) return false;
+        auction_asks_.push_back({level.price, level.total_quantity});
+        return true;
+    });
+
+    // Walk candidate prices upwards: demand(p) = bids at or above p,
+    // supply(p) = asks at or below p
+    const Price reference = last_auction_price_ > 0 ? last_auction_price_ :
+                                                      ask_price + (bid_price - ask_price) / 2;
+    Price clearing = 0;
+    Quantity best_volume = -1, best_imbalance = 0;
+    Price best_distance = 0;
+    Quantity supply = 0;
+    size_t bid = auction_bids_.size();  // Bids below the candidate are auction_bids_[bid..]
+    size_t ask = 0;
+    while (bid > 0 || ask < auction_asks_.size()) {
+        Price price;
+        if (ask == auction_asks_.size()) {
+            price = auction_bids_[bid - 1].price;
+        } else if (bid == 0) {
+            price = auction_asks_[ask].price;
+        } else {
+            price = std::min(auction_bids_[bid - 1].price, auction_asks_[ask].price);
+        }
+        for (; ask < auction_asks_.size() && auction_asks_[ask].price == price; ++ask) {
+            supply += auction_asks_[ask].quantity;
+        }
 
-    auto loc_it = order_locations_.find(order_id);
-    if (loc_it == order_locations_.end()) {
-        return std::nullopt;
+        const Quantity volume = std::min(demand, supply);
+        const Quantity imbalance = demand > supply ? demand - supply : supply - demand;
+        const Price distance = price > reference ? price - reference : reference - price;
+        if (volume > best_volume ||
+            (volume == best_volume && (imbalance < best_imbalance ||
+                (imbalance == best_imbalance && distance < best_distance)))) {
+            clearing = price;
+            best_volume = volume;
+            best_imbalance = imbalance;
+            best_distance = distance;
+        }
+
+        // Bids at this price do not reach the next, higher candidate
+        for (; bid > 0 && auction_bids_[bid - 1].price == price; --bid) {
+            demand -= auction_bids_[bid - 1].quantity;
+        }
     }
 
-    OrderLocation loc = loc_it->second;
-    std::optional<Order> cancelled;
+    auction_buys_.clear();
+    auction_sells_.clear();
+    allocate_auction(bids_, auction_bids_, clearing, best_volume, auction_buys_);
+    allocate_auction(asks_, auction_asks_, clearing, best_volume, auction_sells_);
+
+    // Pair the two allocations into trades; the later order of a pair is
+    // the one that made the cross
+    const size_t first = trades.size();
+    size_t buy = 0, sell = 0;
+    Quantity buy_left = auction_buys_.empty() ? 0 : auction_buys_[0].quantity;
+    Quantity sell_left = auction_sells_.empty() ? 0 : auction_sells_[0].quantity;
+    while (buy < auction_buys_.size() && sell < auction_sells_.size()) {
+        const Order& buy_order = auction_buys_[buy].node->order;
+        const Order& sell_order = auction_sells_[sell].node->order;
+        const Quantity quantity = std::min(buy_left, sell_left);
+        const Side aggressor = buy_order.timestamp > sell_order.timestamp ? Side::Buy : Side::Sell;
+        trades.push_back(create_trade(buy_order, sell_order, clearing, quantity, aggressor));
+
+        buy_left -= quantity;
+        sell_left -= quantity;
+        if (buy_left == 0 && ++buy < auction_buys_.size()) {
+            buy_left = auction_buys_[buy].quantity;
+        }
+        if (sell_left == 0 && ++sell < auction_sells_.size()) {
+            sell_left = auction_sells_[sell].quantity;
+        }
+    }
 
-    if (loc.side == Side::Buy) {
-        auto level_it = bids_.find(loc.price);
-        if (level_it != bids_.end()) {
-            for (auto& order : level_it->second.orders) {
-                if (order.id == order_id) {
-                    order.status = OrderStatus::Cancelled;
-                    cancelled = order;
-                    break;
-                }
-            }
-            level_it->second.remove_order(order_id);
-            if (level_it->second.empty()) {
-                bids_.erase(level_it);
-            }
+    // Apply the fills, then notify, then retire filled orders
+    for (auto* fills : {&auction_buys_, &auction_sells_}) {
+        for (const AuctionFill& fill : *fills) {
+            Order& order = fill.node->order;
+            order.filled += fill.quantity;
+            order.status = order.is_filled() ? OrderStatus::Filled : OrderStatus::PartiallyFilled;
+            PriceLevel* level = order.is_buy() ? bids_.find(order.price) : asks_.find(order.price);
+            level->total_quantity -= fill.quantity;
+            note_level_change(order.side, order.price);
         }
-    } else {
-        auto level_it = asks_.find(loc.price);
-        if (level_it != asks_.end()) {
-            for (auto& order : level_it->second.orders) {
-                if (order.id == order_id) {
-                    order.status = OrderStatus::Cancelled;
-                    cancelled = order;
-                    break;
+    }
+
+    const size_t count = trades.size() - first;
+    if (listener) {
+        listener->on_trade_batch(trades.data() + first, count);
+        for (auto* fills : {&auction_buys_, &auction_sells_}) {
+            for (const AuctionFill& fill : *fills) {
+                if (fill.node->order.is_filled()) {
+                    listener->on_order_filled(fill.node->order);
+                } else {
+                    listener->on_order_partially_filled(fill.node->order, fill.quantity);
                 }
             }
-            level_it->second.remove_order(order_id);
-            if (level_it->second.empty()) {
-                asks_.erase(level_it);
+        }
+    }
+
+    for (auto* fills : {&auction_buys_, &auction_sells_}) {
+        for (const AuctionFill& fill : *fills) {
+            const Order& order = fill.node->order;
+            if (order.is_filled()) {
+                auto loc_it = order_locations_.find(order.id);
+                OrderLocation loc = loc_it->second;
+                order_locations_.erase(loc_it);
+                unlink_from_book(loc);
+                order_pool_.release(loc.node);
             }
         }
     }
 
-    order_locations_.erase(loc_it);
-    return cancelled;
+    last_auction_price_ = clearing;
+    return count;
 }
 
-std::optional<Order> OrderBook::modify_order(uint64_t order_id, Price new_price, Quantity new_quantity) {
-    std::unique_lock lock(mutex_);
+std::optional<Order> OrderBook::get_order(uint64_t order_id) const {
+    auto lock = read_lock();
 
     auto loc_it = order_locations_.find(order_id);
     if (loc_it == order_locations_.end()) {
         return std::nullopt;
     }
 
-    OrderLocation loc = loc_it->second;
+    return loc_it->second.node->order;
+}
 
-    // Find and copy the original order
-    Order original;
-    bool found = false;
+bool OrderBook::has_order(uint64_t order_id) const {
+    auto lock = read_lock();
+    return order_locations_.find(order_id) != order_locations_.end();
+}
 
-    if (loc.side == Side::Buy) {
-        auto level_it = bids_.find(loc.price);
-        if (level_it != bids_.end()) {
-            for (const auto& order : level_it->second.orders) {
-                if (order.id == order_id) {
-                    original = order;
-                    found = true;
-                    break;
-                }
-            }
-        }
-    } else {
-        auto level_it = asks_.find(loc.price);
-        if (level_it != asks_.end()) {
-            for (const auto& order : level_it->second.orders) {
-                if (order.id == order_id) {
-                    original = order;
-                    found = true;
-                    break;
-                }
-            }
+std::optional<Price> OrderBook::best_bid() const {
+    L1Snapshot l1 = l1_.load();
+    if (!l1.has_bid()) return std::nullopt;
+    return l1.bid_price;
+}
+
+std::optional<Price> OrderBook::best_ask() const {
+    L1Snapshot l1 = l1_.load();
+    if (!l1.has_ask()) return std::nullopt;
+    return l1.ask_price;
+}
+
+std::optional<Price> OrderBook::spread() const {
+    // Single snapshot so both sides come from the same book state
+    L1Snapshot l1 = l1_.load();
+    if (!l1.has_bid() || !l1.has_ask()) return std::nullopt;
+    return l1.ask_price - l1.bid_price;
+}
+
+void OrderBook::note_level_change(Side side, Price price) {
+    if (update_listeners_.empty()) {
+        return;
+    }
+    for (const auto& touched : touched_levels_) {
+        if (touched.first == side && touched.second == price) {
+            return;
         }
     }
+    touched_levels_.emplace_back(side, price);
+}
 
-    if (!found) {
-        return std::nullopt;
-    }
+void OrderBook::publish_deltas() {
+    for (const auto& [side, price] : touched_levels_) {
+        const PriceLevel* level = side == Side::Buy ? bids_.find(price) : asks_.find(price);
 
-    // Remove old order
-    remove_from_book(order_id, loc.price, loc.side);
+        BookDelta delta;
+        delta.sequence = ++delta_sequence_;
+        delta.side = side;
+        delta.price = price;
+        delta.quantity = level ? level->total_quantity : 0;
+        delta.order_count = level ? static_cast<uint32_t>(level->order_count()) : 0;
 
-    // Create modified order
-    Order modified = original;
-    modified.price = new_price;
-    modified.quantity = new_quantity;
-    modified.timestamp = std::chrono::duration_cast<Timestamp>(
-        std::chrono::system_clock::now().time_since_epoch()
-    );
+        for (BookUpdateListener* listener : update_listeners_) {
+            listener->on_book_delta(symbol_id_, delta);
+        }
+    }
+    touched_levels_.clear();
+}
 
-    // Validate new quantity
-    if (new_quantity <= modified.filled) {
-        modified.status = OrderStatus::Cancelled;
-        return modified;
+void OrderBook::add_update_listener(BookUpdateListener* listener) {
+    auto lock = write_lock();
+    if (std::find(update_listeners_.begin(), update_listeners_.end(), listener) ==
+        update_listeners_.end()) {
+        update_listeners_.push_back(listener);
     }
+}
 
-    // Add back to book
-    add_to_book(modified);
-    return modified;
+void OrderBook::remove_update_listener(BookUpdateListener* listener) {
+    auto lock = write_lock();
+    update_listeners_.erase(
+        std::remove(update_listeners_.begin(), update_listeners_.end(), listener),
+        update_listeners_.end());
 }
 
-std::optional<Order> OrderBook::get_order(uint64_t order_id) const {
-    std::shared_lock lock(mutex_);
+uint64_t OrderBook::delta_sequence() const {
+    auto lock = read_lock();
+    return delta_sequence_;
+}
 
-    auto loc_it = order_locations_.find(order_id);
-    if (loc_it == order_locations_.end()) {
-        return std::nullopt;
-    }
+BookSnapshotHeader OrderBook::capture(std::vector<Order>& orders) const {
+    auto lock = read_lock();
 
-    const OrderLocation& loc = loc_it->second;
+    BookSnapshotHeader header{};
+    header.symbol_id = symbol_id_;
+    header.config = config_;
+    header.next_trade_id = next_trade_id_.load(std::memory_order_relaxed);
+    header.delta_sequence = delta_sequence_;
 
-    if (loc.side == Side::Buy) {
-        auto level_it = bids_.find(loc.price);
-        if (level_it != bids_.end()) {
-            for (const auto& order : level_it->second.orders) {
-                if (order.id == order_id) {
-                    return order;
-                }
-            }
+    orders.reserve(orders.size() + order_locations_.size());
+    auto copy_level = [&orders](const PriceLevel& level) {
+        for (const Order& order : level.orders) {
+            orders.push_back(order);
         }
-    } else {
-        auto level_it = asks_.find(loc.price);
-        if (level_it != asks_.end()) {
-            for (const auto& order : level_it->second.orders) {
-                if (order.id == order_id) {
-                    return order;
-                }
-            }
+        return true;
+    };
+
+    const size_t first = orders.size();
+    bids_.for_each(copy_level);
+    header.bid_orders = orders.size() - first;
+    asks_.for_each(copy_level);
+    header.ask_orders = orders.size() - first - header.bid_orders;
+    return header;
+}
+
+bool OrderBook::valid_image(const BookSnapshotHeader& header, const Order* orders, size_t count,
+                            PlaceError (*validate)(const Order&)) {
+    if (header.bid_orders > count || header.ask_orders != count - header.bid_orders) {
+        return false;
+    }
+    for (size_t i = 0; i < count; ++i) {
+        if (orders[i].side != (i < header.bid_orders ? Side::Buy : Side::Sell) ||
+            validate(orders[i]) != PlaceError::None) {
+            return false;
         }
     }
+    return true;
+}
 
-    return std::nullopt;
+bool OrderBook::accepts_image(const BookSnapshotHeader& header, const Order* orders, size_t count) const {
+    return valid_image(header, orders, count, validate_);
 }
 
-bool OrderBook::has_order(uint64_t order_id) const {
-    std::shared_lock lock(mutex_);
-    return order_locations_.find(order_id) != order_locations_.end();
+bool OrderBook::restore(const BookSnapshotHeader& header, const Order* orders, size_t count) {
+    if (!accepts_image(header, orders, count)) {
+        return false;
+    }
+    auto lock = write_lock();
+    if (!order_locations_.empty()) {
+        return false;
+    }
+
+    const size_t total = header.bid_orders + header.ask_orders;
+    order_pool_.reserve(total);
+    order_locations_.reserve(total);
+
+    // Orders arrive grouped by level, so each level is looked up once
+    PriceLevel* level = nullptr;
+    for (size_t i = 0; i < total; ++i) {
+        const Order& order = orders[i];
+        const bool bid = i < header.bid_orders;
+        if (i == header.bid_orders) {
+            level = nullptr;  // Switching sides
+        }
+        if (!level || level->price != order.price) {
+            level = bid ? &bids_.get_or_create(order.price) : &asks_.get_or_create(order.price);
+        }
+        OrderNode* node = order_pool_.acquire(order);
+        level->add_order(node);
+        order_locations_.emplace(order.id, OrderLocation{order.id, order.price, order.side, node});
+        schedule_expiry(order);
+    }
+
+    next_trade_id_.store(header.next_trade_id, std::memory_order_relaxed);
+    delta_sequence_ = header.delta_sequence;
+    publish_l1();
+    return true;
 }
 
-std::optional<Price> OrderBook::best_bid() const {
-    std::shared_lock lock(mutex_);
-    if (bids_.empty()) return std::nullopt;
-    return bids_.begin()->first;
+L2Snapshot OrderBook::get_l2_snapshot(size_t levels) const {
+    L2Snapshot snapshot;
+    get_l2_snapshot(snapshot, levels);
+    return snapshot;
 }
 
-std::optional<Price> OrderBook::best_ask() const {
-    std::shared_lock lock(mutex_);
-    if (asks_.empty()) return std::nullopt;
-    return asks_.begin()->first;
+void OrderBook::get_l2_snapshot(L2Snapshot& snapshot, size_t levels) const {
+    auto lock = read_lock();
+
+    snapshot.symbol_id = symbol_id_;
+    snapshot.sequence = delta_sequence_;
+    snapshot.bids.clear();
+    snapshot.asks.clear();
+
+    auto collect = [levels](std::vector<BookLevel>& out, const PriceLevel& level) {
+        out.push_back({level.price, level.total_quantity,
+                       static_cast<uint32_t>(level.order_count())});
+        return out.size() < levels;
+    };
+
+    if (levels > 0) {
+        bids_.for_each([&](const PriceLevel& level) { return collect(snapshot.bids, level); });
+        asks_.for_each([&](const PriceLevel& level) { return collect(snapshot.asks, level); });
+    }
 }
 
-std::optional<Price> OrderBook::spread() const {
-    auto bid = best_bid();
-    auto ask = best_ask();
-    if (!bid || !ask) return std::nullopt;
-    return *ask - *bid;
+void OrderBook::publish_l1() {
+    L1Snapshot l1{};
+    if (const PriceLevel* bid = bids_.best()) {
+        l1.bid_price = bid->price;
+        l1.bid_quantity = bid->total_quantity;
+        l1.bid_orders = static_cast<uint32_t>(bid->order_count());
+    }
+    if (const PriceLevel* ask = asks_.best()) {
+        l1.ask_price = ask->price;
+        l1.ask_quantity = ask->total_quantity;
+        l1.ask_orders = static_cast<uint32_t>(ask->order_count());
+    }
+    l1.sequence = ++l1_sequence_;
+    l1_.store(l1);
 }
 
 MarketDepth OrderBook::get_depth(size_t levels) const {
-    std::shared_lock lock(mutex_);
+    auto lock = read_lock();
 
     MarketDepth depth;
-    depth.timestamp = std::chrono::duration_cast<Timestamp>(
-        std::chrono::system_clock::now().time_since_epoch()
-    );
-
-    // Bids (already sorted descending)
-    size_t count = 0;
-    for (const auto& [price, level] : bids_) {
-        if (count >= levels) break;
-        depth.bids.push_back({
-            Order::from_price(price),
-            Order::from_quantity(level.total_quantity),
-            static_cast<int>(level.order_count())
-        });
-        ++count;
-    }
+    depth.timestamp = now();
 
-    // Asks (already sorted ascending)
-    count = 0;
-    for (const auto& [price, level] : asks_) {
-        if (count >= levels) break;
-        depth.asks.push_back({
-            Order::from_price(price),
+    // Both sides iterate best-first
+    auto collect = [levels](std::vector<DepthLevel>& out, const PriceLevel& level) {
+        out.push_back({
+            Order::from_price(level.price),
             Order::from_quantity(level.total_quantity),
             static_cast<int>(level.order_count())
         });
-        ++count;
+        return out.size() < levels;
+    };
+
+    if (levels > 0) {
+        bids_.for_each([&](const PriceLevel& level) { return collect(depth.bids, level); });
+        asks_.for_each([&](const PriceLevel& level) { return collect(depth.asks, level); });
     }
 
     return depth;
 }
 
 size_t OrderBook::bid_levels() const {
-    std::shared_lock lock(mutex_);
+    auto lock = read_lock();
     return bids_.size();
 }
 
 size_t OrderBook::ask_levels() const {
-    std::shared_lock lock(mutex_);
+    auto lock = read_lock();
     return asks_.size();
 }
 
 size_t OrderBook::total_orders() const {
-    std::shared_lock lock(mutex_);
+    auto lock = read_lock();
     return order_locations_.size();
 }
 
 Quantity OrderBook::total_bid_quantity() const {
-    std::shared_lock lock(mutex_);
+    auto lock = read_lock();
     Quantity total = 0;
-    for (const auto& [_, level] : bids_) {
+    bids_.for_each([&total](const PriceLevel& level) {
         total += level.total_quantity;
-    }
+        return true;
+    });
     return total;
 }
 
 Quantity OrderBook::total_ask_quantity() const {
-    std::shared_lock lock(mutex_);
+    auto lock = read_lock();
     Quantity total = 0;
-    for (const auto& [_, level] : asks_) {
+    asks_.for_each([&total](const PriceLevel& level) {
         total += level.total_quantity;
-    }
+        return true;
+    });
     return total;
 }
 
+size_t OrderBook::order_pool_capacity() const {
+    auto lock = read_lock();
+    return order_pool_.capacity();
+}
+
+size_t OrderBook::order_pool_in_use() const {
+    auto lock = read_lock();
+    return order_pool_.in_use();
+}
+
+MemoryStats OrderBook::memory_usage() const {
+    auto lock = read_lock();
+    MemoryStats stats = index_arena_.stats();
+    stats.bytes_in_use += order_pool_.in_use() * sizeof(OrderNode);
+    stats.bytes_reserved += order_pool_.capacity() * sizeof(OrderNode);
+    stats.allocations += order_pool_.blocks();
+    return stats;
+}
+
 Trade OrderBook::create_trade(
     const Order& buy_order,
     const Order& sell_order,
@@ -518,9 +901,7 @@ Trade OrderBook::create_trade(
     trade.price = price;
     trade.quantity = quantity;
     trade.aggressor_side = aggressor;
-    trade.timestamp = std::chrono::duration_cast<Timestamp>(
-        std::chrono::system_clock::now().time_since_epoch()
-    );
+    trade.timestamp = now();
     return trade;
 }
 
@@ -0,0 +1,205 @@
+// =============================================================================
+// placement.cpp - CPU topology, thread pinning and node-bound memory
+// =============================================================================
+
+#include "lux/placement.hpp"
+#include <algorithm>
+#include <new>
+#include <string>
+#include <thread>
+
+#if defined(__linux__)
+#include <dirent.h>
+#include <pthread.h>
+#include <sched.h>
+#include <sys/mman.h>
+#include <sys/syscall.h>
+#include <unistd.h>
+#endif
+
+namespace lux {
+
+namespace {
+
+constexpr size_t PAGE_SIZE = 4096;
+
+size_t round_up(size_t n, size_t to) {
+    return (n + to - 1) / to * to;
+}
+
+#if defined(__linux__)
+
+// From <linux/mempolicy.h>, which libc does not wrap
+constexpr int MPOL_PREFERRED_MODE = 1;
+
+bool bind_to_node(void* addr, size_t len, int node) {
+#if defined(SYS_mbind)
+    unsigned long mask[4] = {};
+    constexpr size_t MASK_BITS = sizeof(mask) * 8;
+    if (node < 0 || static_cast<size_t>(node) >= MASK_BITS) {
+        return false;
+    }
+    mask[node / 64] = 1ul << (node % 64);
+    return syscall(SYS_mbind, addr, len, MPOL_PREFERRED_MODE, mask, MASK_BITS + 1, 0) == 0;
+#else
+    (void)addr; (void)len; (void)node;
+    return false;
+#endif
+}
+
+// Anonymous mapping of len aligned to a multiple of the page size: over-map
+// by one alignment and trim both ends. 2 MB alignment lets transparent huge
+// pages back all of a len that is a multiple of HUGE_PAGE_SIZE; pools ask
+// for chunks aligned to their block size.
+void* map_aligned(size_t len, size_t alignment) {
+    const size_t span = len + alignment;
+    void* raw = mmap(nullptr, span, PROT_READ | PROT_WRITE, MAP_PRIVATE | MAP_ANONYMOUS, -1, 0);
+    if (raw == MAP_FAILED) {
+        return nullptr;
+    }
+    const uintptr_t start = reinterpret_cast<uintptr_t>(raw);
+    const uintptr_t aligned = round_up(start, alignment);
+    if (aligned > start) {
+        munmap(raw, aligned - start);
+    }
+    const uintptr_t end = start + span;
+    if (end > aligned + len) {
+        munmap(reinterpret_cast<void*>(aligned + len), end - (aligned + len));
+    }
+    return reinterpret_cast<void*>(aligned);
+}
+
+#endif
+
+} // namespace
+
+// =============================================================================
+// Topology
+// =============================================================================
+
+size_t cpu_count() {
+    const unsigned n = std::thread::hardware_concurrency();
+    return n > 0 ? n : 1;
+}
+
+int numa_node_of_cpu(int cpu) {
+#if defined(__linux__)
+    // /sys/devices/system/cpu/cpuN holds a nodeK link for its node
+    const std::string path = "/sys/devices/system/cpu/cpu" + std::to_string(cpu);
+    DIR* dir = opendir(path.c_str());
+    if (!dir) {
+        return -1;
+    }
+    int node = -1;
+    while (dirent* entry = readdir(dir)) {
+        const std::string name = entry->d_name;
+        if (name.size() > 4 && name.compare(0, 4, "node") == 0 &&
+            name.find_first_not_of("0123456789", 4) == std::string::npos) {
+            node = std::stoi(name.substr(4));
+            break;
+        }
+    }
+    closedir(dir);
+    return node;
+#else
+    (void)cpu;
+    return -1;
+#endif
+}
+
+bool pin_current_thread(int cpu) {
+#if defined(__linux__)
+    if (cpu < 0) {
+        return false;
+    }
+    cpu_set_t set;
+    CPU_ZERO(&set);
+    CPU_SET(static_cast<size_t>(cpu) % CPU_SETSIZE, &set);
+    return pthread_setaffinity_np(pthread_self(), sizeof(set), &set) == 0;
+#else
+    (void)cpu;
+    return false;
+#endif
+}
+
+// =============================================================================
+// NodeMemory
+// =============================================================================
+
+NodeMemory::NodeMemory(int node, bool huge_pages)
+    : mapper_(node, huge_pages), pool_(pool_options(), &mapper_) {}
+
+size_t NodeMemory::PageMapper::mapping_size(size_t bytes) const {
+    if (huge_pages_ && bytes >= HUGE_PAGE_SIZE / 2) {
+        return round_up(bytes, HUGE_PAGE_SIZE);
+    }
+    return round_up(bytes, PAGE_SIZE);
+}
+
+void* NodeMemory::PageMapper::do_allocate(size_t bytes, size_t alignment) {
+#if defined(__linux__)
+    const size_t len = mapping_size(bytes);
+    const bool huge = len % HUGE_PAGE_SIZE == 0 && huge_pages_;
+    void* p = nullptr;
+    if (huge) {
+        // Reserved hugetlb pages first; transparent huge pages otherwise
+        p = mmap(nullptr, len, PROT_READ | PROT_WRITE,
+                 MAP_PRIVATE | MAP_ANONYMOUS | MAP_HUGETLB, -1, 0);
+        if (p == MAP_FAILED) {
+            p = map_aligned(len, std::max(alignment, HUGE_PAGE_SIZE));
+            if (p) {
+                madvise(p, len, MADV_HUGEPAGE);
+            }
+        }
+    } else if (alignment <= PAGE_SIZE) {
+        p = mmap(nullptr, len, PROT_READ | PROT_WRITE, MAP_PRIVATE | MAP_ANONYMOUS, -1, 0);
+        p = p == MAP_FAILED ? nullptr : p;
+    } else {
+        p = map_aligned(len, round_up(alignment, PAGE_SIZE));
+    }
+    if (!p) {
+        throw std::bad_alloc();
+    }
+    if (node_ >= 0 && !bind_to_node(p, len, node_)) {
+        bind_failures_.fetch_add(1, std::memory_order_relaxed);
+    }
+    bytes_mapped_.fetch_add(len, std::memory_order_relaxed);
+    if (huge) {
+        huge_page_bytes_.fetch_add(len, std::memory_order_relaxed);
+    }
+    mappings_.fetch_add(1, std::memory_order_relaxed);
+    return p;
+#else
+    bytes_mapped_.fetch_add(bytes, std::memory_order_relaxed);
+    mappings_.fetch_add(1, std::memory_order_relaxed);
+    return ::operator new(bytes, std::align_val_t(alignment));
+#endif
+}
+
+void NodeMemory::PageMapper::do_deallocate(void* p, size_t bytes, size_t alignment) {
+#if defined(__linux__)
+    (void)alignment;
+    const size_t len = mapping_size(bytes);
+    munmap(p, len);
+    bytes_mapped_.fetch_sub(len, std::memory_order_relaxed);
+    if (huge_pages_ && len % HUGE_PAGE_SIZE == 0) {
+        huge_page_bytes_.fetch_sub(len, std::memory_order_relaxed);
+    }
+#else
+    ::operator delete(p, std::align_val_t(alignment));
+    bytes_mapped_.fetch_sub(bytes, std::memory_order_relaxed);
+#endif
+    mappings_.fetch_sub(1, std::memory_order_relaxed);
+}
+
+NodeMemoryStats NodeMemory::PageMapper::stats() const {
+    NodeMemoryStats stats;
+    stats.node = node_;
+    stats.bytes_mapped = bytes_mapped_.load(std::memory_order_relaxed);
+    stats.huge_page_bytes = huge_page_bytes_.load(std::memory_order_relaxed);
+    stats.mappings = mappings_.load(std::memory_order_relaxed);
+    stats.bind_failures = bind_failures_.load(std::memory_order_relaxed);
+    return stats;
+}
+
+} // namespace lux
@@ -4,6 +4,7 @@
 // =============================================================================
 
 #include "lux/pool.hpp"
+#include "lux/full_math.hpp"
 #include <cmath>
 #include <algorithm>
 #include <stdexcept>
@@ -52,173 +53,23 @@ inline bool is_zero_address(const Address& a) {
 // Absolute value
 inline I128 abs128(I128 x) { return x < 0 ? -x : x; }
 
-// =============================================================================
-// 256-bit Arithmetic (U256 via two U128 limbs)
-// =============================================================================
-
-struct U256 {
-    U128 lo;  // Low 128 bits
-    U128 hi;  // High 128 bits
+using full_math::mul_div;
+using full_math::mul_div_up;
 
-    U256() : lo(0), hi(0) {}
-    U256(U128 l) : lo(l), hi(0) {}
-    U256(U128 l, U128 h) : lo(l), hi(h) {}
-
-    bool operator==(const U256& other) const {
-        return lo == other.lo && hi == other.hi;
-    }
-    bool operator<(const U256& other) const {
-        return hi < other.hi || (hi == other.hi && lo < other.lo);
+// Add a pool operation's delta to a locked flash context
+inline void record_deltas(FlashContext* ctx, const PoolSlot* slot, I128 amount0, I128 amount1) {
+    if (ctx && ctx->locked) {
+        ctx->currency_deltas[slot->currency0_hash] += amount0;
+        ctx->currency_deltas[slot->currency1_hash] += amount1;
     }
-    bool operator>=(const U256& other) const {
-        return !(*this < other);
-    }
-    bool is_zero() const { return lo == 0 && hi == 0; }
-};
-
-// Multiply two U128 values to produce U256
-inline U256 mul_u128(U128 a, U128 b) {
-    // Split into 64-bit halves to avoid overflow
-    constexpr U128 MASK64 = (U128(1) << 64) - 1;
-    U128 a_lo = a & MASK64;
-    U128 a_hi = a >> 64;
-    U128 b_lo = b & MASK64;
-    U128 b_hi = b >> 64;
-
-    // Cross products
-    U128 p0 = a_lo * b_lo;           // lo * lo
-    U128 p1 = a_lo * b_hi;           // lo * hi
-    U128 p2 = a_hi * b_lo;           // hi * lo
-    U128 p3 = a_hi * b_hi;           // hi * hi
-
-    // Accumulate with carry
-    U128 mid = (p0 >> 64) + (p1 & MASK64) + (p2 & MASK64);
-    U128 carry = mid >> 64;
-
-    U256 result;
-    result.lo = (p0 & MASK64) | (mid << 64);
-    result.hi = p3 + (p1 >> 64) + (p2 >> 64) + carry;
-    return result;
 }
 
-// Divide U256 by U128, return U128 quotient (assumes quotient fits)
-inline U128 div_u256_u128(U256 num, U128 denom) {
-    if (denom == 0) return 0;
-    if (num.hi == 0) return num.lo / denom;
-
-    // Binary long division for 256/128
-    U256 rem = num;
-    U128 quot = 0;
-
-    // Find highest bit position in numerator
-    int shift = 0;
-    if (rem.hi != 0) {
-        // Count leading zeros in hi
-        U128 tmp = rem.hi;
-        while (tmp != 0) { tmp >>= 1; shift++; }
-        shift += 128;
-    } else {
-        U128 tmp = rem.lo;
-        while (tmp != 0) { tmp >>= 1; shift++; }
-    }
-
-    // Long division bit by bit
-    for (int i = shift - 1; i >= 0; --i) {
-        // Shift quotient left
-        quot <<= 1;
-
-        // Get bit i of remainder
-        U128 bit;
-        if (i >= 128) {
-            bit = (rem.hi >> (i - 128)) & 1;
-        } else {
-            bit = (rem.lo >> i) & 1;
-        }
-
-        // Build current dividend portion (accumulate bits)
-        // Check if current portion >= denom
-        U256 test;
-        if (i >= 128) {
-            test.hi = rem.hi >> (i - 128);
-            test.lo = 0;
-        } else if (i >= 0) {
-            test.hi = 0;
-            test.lo = (rem.hi << (128 - i)) | (rem.lo >> i);
-        }
-
-        if (test.hi > 0 || test.lo >= denom) {
-            quot |= 1;
-            // Subtract denom << i from rem
-            U256 sub;
-            if (i >= 128) {
-                sub.hi = denom << (i - 128);
-                sub.lo = 0;
-            } else {
-                sub.lo = denom << i;
-                sub.hi = (i > 0) ? (denom >> (128 - i)) : 0;
-            }
-            // rem -= sub
-            if (rem.lo < sub.lo) {
-                rem.lo = rem.lo - sub.lo;  // Wraps
-                rem.hi -= 1;               // Borrow
-            } else {
-                rem.lo -= sub.lo;
-            }
-            rem.hi -= sub.hi;
-        }
-    }
-    return quot;
-}
-
-// Check if U256 is exactly divisible by U128
-inline bool u256_mod_nonzero(U256 num, U128 denom) {
-    if (denom == 0) return false;
-    if (num.hi == 0) return (num.lo % denom) != 0;
-
-    // Compute remainder using the quotient
-    U128 quot = div_u256_u128(num, denom);
-    U256 prod = mul_u128(quot, denom);
-    return !(prod == num);
-}
-
-// =============================================================================
-// Safe mul_div with 256-bit intermediate
-// =============================================================================
-
-inline I128 mul_div(I128 a, I128 b, I128 denom) {
-    if (denom == 0) return 0;
-
-    bool neg = (a < 0) ^ (b < 0) ^ (denom < 0);
-    U128 ua = static_cast<U128>(abs128(a));
-    U128 ub = static_cast<U128>(abs128(b));
-    U128 ud = static_cast<U128>(abs128(denom));
-
-    // 256-bit product, then divide
-    U256 product = mul_u128(ua, ub);
-    U128 result = div_u256_u128(product, ud);
-
-    return neg ? -static_cast<I128>(result) : static_cast<I128>(result);
-}
-
-// Mul-div rounding up
-inline I128 mul_div_up(I128 a, I128 b, I128 denom) {
-    if (denom == 0) return 0;
-
-    bool neg = (a < 0) ^ (b < 0) ^ (denom < 0);
-    U128 ua = static_cast<U128>(abs128(a));
-    U128 ub = static_cast<U128>(abs128(b));
-    U128 ud = static_cast<U128>(abs128(denom));
-
-    U256 product = mul_u128(ua, ub);
-    U128 result = div_u256_u128(product, ud);
-
-    // Round up if there's a remainder and result is positive
-    if (!neg && u256_mod_nonzero(product, ud)) {
-        result += 1;
-    }
-
-    return neg ? -static_cast<I128>(result) : static_cast<I128>(result);
-}
+// The lock() running on this thread: its pool manager and flash context
+struct ActiveLock {
+    const LXPool* owner;
+    FlashContext* ctx;
+};
+thread_local ActiveLock active_lock{nullptr, nullptr};
 
 } // anonymous namespace
 
@@ -232,21 +83,23 @@ LXPool::LXPool() = default;
 // Internal Helpers
 // =============================================================================
 
-PoolState* LXPool::get_pool(const PoolKey& key) {
-    auto it = pools_.find(key.id());
-    return it != pools_.end() ? &it->second : nullptr;
+PoolSlot* LXPool::get_pool(const PoolKey& key) const {
+    return directory_.find(key.id());
 }
 
-const PoolState* LXPool::get_pool(const PoolKey& key) const {
-    auto it = pools_.find(key.id());
-    return it != pools_.end() ? &it->second : nullptr;
+PoolHandle LXPool::find_pool(const PoolKey& key) const {
+    return PoolHandle(get_pool(key));
 }
 
-IHooks* LXPool::get_hooks(const PoolKey& key) {
-    if (is_zero_address(key.hooks)) return nullptr;
+FlashContext* LXPool::active_context() const {
+    return active_lock.owner == this ? active_lock.ctx : nullptr;
+}
+
+LXPool::RegisteredHooks LXPool::get_hooks(const PoolKey& key) const {
+    if (is_zero_address(key.hooks)) return {nullptr, 0};
     std::shared_lock lock(hooks_mutex_);
     auto it = hooks_.find(address_hash(key.hooks));
-    return it != hooks_.end() ? it->second : nullptr;
+    return it != hooks_.end() ? it->second : RegisteredHooks{nullptr, 0};
 }
 
 int32_t LXPool::get_tick_at_sqrt_ratio(I128 sqrt_price_x96) {
@@ -294,8 +147,9 @@ int32_t LXPool::initialize(const PoolKey& key, I128 sqrt_price_x96) {
     }
 
     // Call before_initialize hook
-    IHooks* hooks = get_hooks(key);
-    if (hooks && !hooks->before_initialize(key, sqrt_price_x96)) {
+    const RegisteredHooks hooks = get_hooks(key);
+    if ((hooks.flags & hook_flags::BEFORE_INITIALIZE) &&
+        !hooks.hooks->before_initialize(key, sqrt_price_x96)) {
         return errors::HOOK_FAILED;
     }
 
@@ -312,7 +166,13 @@ int32_t LXPool::initialize(const PoolKey& key, I128 sqrt_price_x96) {
     int32_t tick = get_tick_at_sqrt_ratio(sqrt_price_x96);
 
     // Initialize pool state
-    PoolState state{};
+    auto slot = std::make_unique<PoolSlot>();
+    slot->key = key;
+    slot->currency0_hash = currency_hash(key.currency0);
+    slot->currency1_hash = currency_hash(key.currency1);
+    slot->hooks = hooks.hooks;
+    slot->hook_flags = hooks.flags;
+    PoolState& state = slot->state;
     state.slot0.sqrt_price_x96 = sqrt_price_x96;
     state.slot0.tick = tick;
     state.slot0.protocol_fee = 0;
@@ -323,14 +183,20 @@ int32_t LXPool::initialize(const PoolKey& key, I128 sqrt_price_x96) {
     state.protocol_fees0 = 0;
     state.protocol_fees1 = 0;
     state.liquidity = 0;
+    state.tick_bitmap = TickBitmap(key.tick_spacing, tick_math::MIN_TICK, tick_math::MAX_TICK);
 
-    pools_[pool_id] = std::move(state);
+    directory_.insert(pool_id, slot.get());
+    pools_[pool_id] = std::move(slot);
 
     lock.unlock();
 
     // Call after_initialize hook
-    if (hooks) {
-        hooks->after_initialize(key, sqrt_price_x96, tick);
+    if (hooks.flags & hook_flags::AFTER_INITIALIZE) {
+        hooks.hooks->after_initialize(key, sqrt_price_x96, tick);
+    }
+
+    if (liquidity_listener_) {
+        liquidity_listener_(key, 0);
     }
 
     return tick;
@@ -478,60 +344,162 @@ LXPool::SwapState LXPool::compute_swap_step(SwapState state, I128 sqrt_price_tar
     return state;
 }
 
+// =============================================================================
+// Swap Loop Helpers
+// =============================================================================
+
+I128 LXPool::resolve_price_limit(const Slot0& slot0, bool zero_for_one, I128 sqrt_price_limit) {
+    if (sqrt_price_limit == 0) {
+        sqrt_price_limit = zero_for_one
+            ? tick_math::MIN_SQRT_RATIO + 1
+            : tick_math::MAX_SQRT_RATIO - 1;
+    }
+
+    if (zero_for_one) {
+        if (sqrt_price_limit >= slot0.sqrt_price_x96 ||
+            sqrt_price_limit <= tick_math::MIN_SQRT_RATIO) {
+            return 0;
+        }
+    } else {
+        if (sqrt_price_limit <= slot0.sqrt_price_x96 ||
+            sqrt_price_limit >= tick_math::MAX_SQRT_RATIO) {
+            return 0;
+        }
+    }
+    return sqrt_price_limit;
+}
+
+LXPool::StepTarget LXPool::next_step_target(const PoolKey& key, const PoolState& pool,
+                                            const SwapState& state, I128 sqrt_price_limit,
+                                            bool zero_for_one) {
+    StepTarget target{};
+
+    if (zero_for_one) {
+        // Moving down: find highest initialized tick below current
+        if (auto below = pool.tick_bitmap.next_below(state.tick)) {
+            target.next_tick = *below;
+            target.initialized = true;
+        } else {
+            // No more initialized ticks below; use price limit tick
+            target.next_tick = get_tick_at_sqrt_ratio(sqrt_price_limit);
+            if (target.next_tick < tick_math::MIN_TICK) target.next_tick = tick_math::MIN_TICK;
+        }
+    } else {
+        // Moving up: find lowest initialized tick above current
+        if (auto above = pool.tick_bitmap.next_above(state.tick)) {
+            target.next_tick = *above;
+            target.initialized = true;
+        } else {
+            target.next_tick = get_tick_at_sqrt_ratio(sqrt_price_limit);
+            if (target.next_tick > tick_math::MAX_TICK) target.next_tick = tick_math::MAX_TICK;
+        }
+    }
+
+    // Snap a limit-derived tick to the spacing (rounding in swap direction);
+    // initialized ticks are already on it
+    if (!target.initialized) {
+        const int32_t spacing = key.tick_spacing;
+        int32_t snapped = target.next_tick / spacing * spacing;
+        if (zero_for_one && snapped > target.next_tick) snapped -= spacing;
+        if (!zero_for_one && snapped < target.next_tick) snapped += spacing;
+        target.next_tick = std::clamp(snapped, tick_math::MIN_TICK, tick_math::MAX_TICK);
+    }
+
+    // Compute sqrt price at next tick
+    target.sqrt_price_next_x96 = get_sqrt_ratio_at_tick(target.next_tick);
+
+    // Clamp to price limit
+    if (zero_for_one) {
+        target.sqrt_price_target_x96 = target.sqrt_price_next_x96 < sqrt_price_limit
+            ? sqrt_price_limit : target.sqrt_price_next_x96;
+    } else {
+        target.sqrt_price_target_x96 = target.sqrt_price_next_x96 > sqrt_price_limit
+            ? sqrt_price_limit : target.sqrt_price_next_x96;
+    }
+
+    // Ensure we're actually moving
+    if ((zero_for_one && target.sqrt_price_target_x96 >= state.sqrt_price_x96) ||
+        (!zero_for_one && target.sqrt_price_target_x96 <= state.sqrt_price_x96)) {
+        // Price target is not in swap direction; use limit
+        target.sqrt_price_target_x96 = sqrt_price_limit;
+    }
+
+    return target;
+}
+
+BalanceDelta LXPool::swap_delta(bool zero_for_one, I128 amount_specified, const SwapState& state) {
+    bool exact_in = amount_specified > 0;
+    BalanceDelta delta{};
+
+    if (zero_for_one) {
+        // Sold token0, bought token1
+        delta.amount0 = exact_in
+            ? amount_specified - state.amount_remaining
+            : state.amount_calculated;
+        delta.amount1 = exact_in
+            ? -state.amount_calculated
+            : amount_specified - state.amount_remaining;
+    } else {
+        // Sold token1, bought token0
+        delta.amount0 = exact_in
+            ? -state.amount_calculated
+            : amount_specified - state.amount_remaining;
+        delta.amount1 = exact_in
+            ? amount_specified - state.amount_remaining
+            : state.amount_calculated;
+    }
+    return delta;
+}
+
 // =============================================================================
 // Swap
 // =============================================================================
 
-// Standalone swap (no flash context)
+// Swap inside the current lock(), if any
 BalanceDelta LXPool::swap(const PoolKey& key, const SwapParams& params,
-                          const std::vector<uint8_t>& hook_data) {
-    FlashContext dummy_ctx;
-    return swap(dummy_ctx, key, params, hook_data);
+                          const std::vector<uint8_t>& /*hook_data*/) {
+    return swap_in_pool(get_pool(key), params, active_context());
+}
+
+BalanceDelta LXPool::swap(PoolHandle pool, const SwapParams& params,
+                          const std::vector<uint8_t>& /*hook_data*/) {
+    return swap_in_pool(pool.slot_, params, active_context());
 }
 
 // Swap with explicit flash context
 BalanceDelta LXPool::swap(FlashContext& ctx, const PoolKey& key, const SwapParams& params,
-                          const std::vector<uint8_t>& hook_data) {
-    // Call before_swap hook
-    IHooks* hooks = get_hooks(key);
-    if (hooks && !hooks->before_swap(key, params)) {
+                          const std::vector<uint8_t>& /*hook_data*/) {
+    return swap_in_pool(get_pool(key), params, &ctx);
+}
+
+BalanceDelta LXPool::swap_in_pool(PoolSlot* slot, const SwapParams& params, FlashContext* ctx) {
+    if (!slot) {
         return {0, 0};
     }
+    const PoolKey& key = slot->key;
 
-    std::unique_lock lock(pools_mutex_);
-
-    PoolState* pool = get_pool(key);
-    if (!pool) {
+    // Call before_swap hook
+    IHooks* hooks = slot->hooks;
+    const uint16_t flags = slot->hook_flags;
+    if ((flags & hook_flags::BEFORE_SWAP) && !hooks->before_swap(key, params)) {
         return {0, 0};
     }
 
+    std::unique_lock lock(slot->mutex);
+    PoolState* pool = &slot->state;
+
     // Reentrancy check
     if (!pool->slot0.unlocked) {
         return {0, 0};
     }
     pool->slot0.unlocked = false;
 
-    // Determine price limit
-    I128 sqrt_price_limit = params.sqrt_price_limit;
+    // Determine and validate price limit
+    const I128 sqrt_price_limit = resolve_price_limit(pool->slot0, params.zero_for_one,
+                                                      params.sqrt_price_limit);
     if (sqrt_price_limit == 0) {
-        sqrt_price_limit = params.zero_for_one
-            ? tick_math::MIN_SQRT_RATIO + 1
-            : tick_math::MAX_SQRT_RATIO - 1;
-    }
-
-    // Validate price limit
-    if (params.zero_for_one) {
-        if (sqrt_price_limit >= pool->slot0.sqrt_price_x96 ||
-            sqrt_price_limit <= tick_math::MIN_SQRT_RATIO) {
-            pool->slot0.unlocked = true;
-            return {0, 0};
-        }
-    } else {
-        if (sqrt_price_limit <= pool->slot0.sqrt_price_x96 ||
-            sqrt_price_limit >= tick_math::MAX_SQRT_RATIO) {
-            pool->slot0.unlocked = true;
-            return {0, 0};
-        }
+        pool->slot0.unlocked = true;
+        return {0, 0};
     }
 
     // Initialize swap state
@@ -545,82 +513,19 @@ BalanceDelta LXPool::swap(FlashContext& ctx, const PoolKey& key, const SwapParam
     // Fee for this swap
     uint32_t swap_fee = pool->slot0.lp_fee;
 
-    // Track total fees for fee_growth_global accumulation
-    I128 total_fee_amount = 0;
-
     // Main swap loop: iterate through tick ranges
     // Limit iterations to prevent infinite loops
     int max_iterations = 1000;
     while (state.amount_remaining != 0 && state.sqrt_price_x96 != sqrt_price_limit && max_iterations-- > 0) {
 
-        // Find next initialized tick
-        int32_t next_tick;
-        bool found_tick = false;
-
-        if (params.zero_for_one) {
-            // Moving down: find highest initialized tick below current
-            auto it = pool->ticks.lower_bound(state.tick);
-            if (it != pool->ticks.begin()) {
-                --it;
-                // Find first initialized tick going backwards
-                while (!it->second.initialized && it != pool->ticks.begin()) --it;
-                if (it->second.initialized && it->first < state.tick) {
-                    next_tick = it->first;
-                    found_tick = true;
-                }
-            }
-            if (!found_tick) {
-                // No more initialized ticks below; use price limit tick
-                next_tick = get_tick_at_sqrt_ratio(sqrt_price_limit);
-                if (next_tick < tick_math::MIN_TICK) next_tick = tick_math::MIN_TICK;
-            }
-        } else {
-            // Moving up: find lowest initialized tick above current
-            auto it = pool->ticks.upper_bound(state.tick);
-            while (it != pool->ticks.end() && !it->second.initialized) ++it;
-            if (it != pool->ticks.end() && it->first > state.tick) {
-                next_tick = it->first;
-                found_tick = true;
-            } else {
-                next_tick = get_tick_at_sqrt_ratio(sqrt_price_limit);
-                if (next_tick > tick_math::MAX_TICK) next_tick = tick_math::MAX_TICK;
-            }
-        }
-
-        // Snap to tick spacing (rounding in swap direction)
-        if (params.zero_for_one) {
-            // Round down for zero_for_one
-            next_tick = (next_tick / key.tick_spacing) * key.tick_spacing;
-        } else {
-            // Round up for one_for_zero
-            next_tick = ((next_tick + key.tick_spacing - 1) / key.tick_spacing) * key.tick_spacing;
-        }
-
-        // Compute sqrt price at next tick
-        I128 sqrt_price_next = get_sqrt_ratio_at_tick(next_tick);
-
-        // Clamp to price limit
-        I128 sqrt_price_target;
-        if (params.zero_for_one) {
-            sqrt_price_target = sqrt_price_next < sqrt_price_limit
-                ? sqrt_price_limit : sqrt_price_next;
-        } else {
-            sqrt_price_target = sqrt_price_next > sqrt_price_limit
-                ? sqrt_price_limit : sqrt_price_next;
-        }
-
-        // Ensure we're actually moving
-        if ((params.zero_for_one && sqrt_price_target >= state.sqrt_price_x96) ||
-            (!params.zero_for_one && sqrt_price_target <= state.sqrt_price_x96)) {
-            // Price target is not in swap direction; use limit
-            sqrt_price_target = sqrt_price_limit;
-        }
+        // Next initialized tick, or the price limit
+        const StepTarget target = next_step_target(key, *pool, state, sqrt_price_limit, params.zero_for_one);
 
         // Store old price for comparison
         I128 sqrt_price_before = state.sqrt_price_x96;
 
         // Compute swap within this step
-        state = compute_swap_step(state, sqrt_price_target, swap_fee, params.zero_for_one);
+        state = compute_swap_step(state, target.sqrt_price_target_x96, swap_fee, params.zero_for_one);
 
         // If price didn't move and we still have amount, we're done
         if (state.sqrt_price_x96 == sqrt_price_before && state.amount_remaining != 0) {
@@ -628,8 +533,8 @@ BalanceDelta LXPool::swap(FlashContext& ctx, const PoolKey& key, const SwapParam
         }
 
         // Cross tick if reached exactly and it was initialized
-        if (state.sqrt_price_x96 == sqrt_price_next && found_tick) {
-            auto tick_it = pool->ticks.find(next_tick);
+        if (state.sqrt_price_x96 == target.sqrt_price_next_x96 && target.initialized) {
+            auto tick_it = pool->ticks.find(target.next_tick);
             if (tick_it != pool->ticks.end() && tick_it->second.initialized) {
                 // Flip fee growth outside when crossing
                 tick_it->second.fee_growth_outside0_x128 =
@@ -646,45 +551,24 @@ BalanceDelta LXPool::swap(FlashContext& ctx, const PoolKey& key, const SwapParam
                 }
             }
             // Update tick (move past the crossed tick)
-            state.tick = params.zero_for_one ? next_tick - 1 : next_tick;
+            state.tick = params.zero_for_one ? target.next_tick - 1 : target.next_tick;
         }
     }
 
     // Persist state changes
+    const bool liquidity_changed = pool->liquidity != state.liquidity;
     pool->slot0.sqrt_price_x96 = state.sqrt_price_x96;
     pool->slot0.tick = state.tick;
     pool->liquidity = state.liquidity;
 
     // Calculate balance delta
-    bool exact_in = params.amount_specified > 0;
-    BalanceDelta delta{};
-
-    if (params.zero_for_one) {
-        // Sold token0, bought token1
-        delta.amount0 = exact_in
-            ? params.amount_specified - state.amount_remaining
-            : state.amount_calculated;
-        delta.amount1 = exact_in
-            ? -state.amount_calculated
-            : params.amount_specified - state.amount_remaining;
-    } else {
-        // Sold token1, bought token0
-        delta.amount0 = exact_in
-            ? -state.amount_calculated
-            : params.amount_specified - state.amount_remaining;
-        delta.amount1 = exact_in
-            ? params.amount_specified - state.amount_remaining
-            : state.amount_calculated;
-    }
+    BalanceDelta delta = swap_delta(params.zero_for_one, params.amount_specified, state);
 
     // Unlock pool
     pool->slot0.unlocked = true;
 
     // Update flash accounting deltas
-    if (locked_) {
-        currency_deltas_[currency_hash(key.currency0)] += delta.amount0;
-        currency_deltas_[currency_hash(key.currency1)] += delta.amount1;
-    }
+    record_deltas(ctx, slot, delta.amount0, delta.amount1);
 
     // Update statistics
     total_swaps_.fetch_add(1, std::memory_order_relaxed);
@@ -692,19 +576,305 @@ BalanceDelta LXPool::swap(FlashContext& ctx, const PoolKey& key, const SwapParam
     lock.unlock();
 
     // Call after_swap hook
-    if (hooks) {
+    if (flags & hook_flags::AFTER_SWAP) {
         hooks->after_swap(key, params, delta);
     }
 
+    if (liquidity_changed && liquidity_listener_) {
+        liquidity_listener_(key, state.liquidity);
+    }
+
     return delta;
 }
 
+// =============================================================================
+// Quoting
+// =============================================================================
+
+std::vector<SwapQuote> LXPool::quote_swaps(const PoolKey& key, bool zero_for_one,
+                                           const std::vector<I128>& amounts_specified,
+                                           I128 sqrt_price_limit) const {
+    return quote_swaps(find_pool(key), zero_for_one, amounts_specified, sqrt_price_limit);
+}
+
+std::vector<SwapQuote> LXPool::quote_swaps(PoolHandle pool, bool zero_for_one,
+                                           const std::vector<I128>& amounts_specified,
+                                           I128 sqrt_price_limit) const {
+    if (!pool) {
+        return {};
+    }
+    std::shared_lock lock(pool.slot_->mutex);
+    return quote_swaps(pool.slot_->key, pool.slot_->state, zero_for_one, amounts_specified,
+                       sqrt_price_limit);
+}
+
+std::optional<SwapQuote> LXPool::quote_to_price(const PoolKey& key, bool zero_for_one,
+                                                I128 sqrt_price_target_x96) const {
+    PoolSlot* slot = get_pool(key);
+    if (!slot) {
+        return std::nullopt;
+    }
+    std::shared_lock lock(slot->mutex);
+    // An input no pool can absorb, stopped by the target as price limit
+    const I128 unbounded = static_cast<I128>(~U128{0} >> 8);
+    return quote_swaps(key, slot->state, zero_for_one, {unbounded}, sqrt_price_target_x96).front();
+}
+
+std::vector<SwapQuote> LXPool::quote_swaps(const PoolKey& key, const PoolState& pool,
+                                           bool zero_for_one,
+                                           const std::vector<I128>& amounts_specified,
+                                           I128 sqrt_price_limit) {
+    std::vector<SwapQuote> quotes(amounts_specified.size(),
+                                  SwapQuote{{0, 0}, pool.slot0.sqrt_price_x96, pool.slot0.tick, 0});
+    const I128 limit = resolve_price_limit(pool.slot0, zero_for_one, sqrt_price_limit);
+    if (limit == 0) {
+        return quotes;
+    }
+
+    // Same loop as swap(), read-only. A step that reaches its target with
+    // input left is the same step for every larger size of the same sign,
+    // so the walk checkpoints after it and each size resumes from the last
+    // checkpoint of the smaller one before it.
+    struct Cursor {
+        SwapState state;
+        uint32_t ticks_crossed;
+        int iterations;
+    };
+
+    std::vector<size_t> order;
+    for (bool exact_in : {true, false}) {
+        order.clear();
+        for (size_t i = 0; i < amounts_specified.size(); ++i) {
+            if (exact_in ? amounts_specified[i] > 0 : amounts_specified[i] < 0) {
+                order.push_back(i);
+            }
+        }
+        std::sort(order.begin(), order.end(), [&](size_t a, size_t b) {
+            return abs128(amounts_specified[a]) < abs128(amounts_specified[b]);
+        });
+
+        Cursor checkpoint{};
+        checkpoint.state.sqrt_price_x96 = pool.slot0.sqrt_price_x96;
+        checkpoint.state.tick = pool.slot0.tick;
+        checkpoint.state.liquidity = pool.liquidity;
+        checkpoint.iterations = 1000;
+        I128 consumed = 0;  // Of amount_specified, up to the checkpoint
+
+        for (size_t index : order) {
+            const I128 amount = amounts_specified[index];
+            Cursor cursor = checkpoint;
+            cursor.state.amount_remaining = amount - consumed;
+            bool shared = true;
+
+            SwapState& state = cursor.state;
+            while (state.amount_remaining != 0 && state.sqrt_price_x96 != limit && cursor.iterations-- > 0) {
+                const StepTarget target = next_step_target(key, pool, state, limit, zero_for_one);
+                const I128 sqrt_price_before = state.sqrt_price_x96;
+                state = compute_swap_step(state, target.sqrt_price_target_x96, pool.slot0.lp_fee, zero_for_one);
+
+                if (state.sqrt_price_x96 == sqrt_price_before && state.amount_remaining != 0) {
+                    break;
+                }
+                const bool full_step = state.sqrt_price_x96 == target.sqrt_price_target_x96 &&
+                                       state.amount_remaining != 0;
+
+                if (state.sqrt_price_x96 == target.sqrt_price_next_x96 && target.initialized) {
+                    auto tick_it = pool.ticks.find(target.next_tick);
+                    if (tick_it != pool.ticks.end() && tick_it->second.initialized) {
+                        state.liquidity += zero_for_one ? -tick_it->second.liquidity_net
+                                                        : tick_it->second.liquidity_net;
+                        ++cursor.ticks_crossed;
+                    }
+                    state.tick = zero_for_one ? target.next_tick - 1 : target.next_tick;
+                }
+
+                shared = shared && full_step;
+                if (shared) {
+                    checkpoint = cursor;
+                    consumed = amount - state.amount_remaining;
+                }
+            }
+
+            quotes[index] = SwapQuote{swap_delta(zero_for_one, amount, state),
+                                      state.sqrt_price_x96, state.tick, cursor.ticks_crossed};
+        }
+    }
+    return quotes;
+}
+
+// =============================================================================
+// Depth
+// =============================================================================
+
+namespace {
+
+inline int64_t floor_div(int64_t a, int64_t b) {
+    return a / b - ((a % b != 0) && ((a < 0) != (b < 0)));
+}
+
+// Segment of a profile holding `tick`
+inline size_t profile_segment(const DepthProfile& profile, int32_t tick) {
+    auto it = std::upper_bound(profile.ticks.begin(), profile.ticks.end() - 1, tick);
+    return it == profile.ticks.begin() ? 0 : static_cast<size_t>(it - profile.ticks.begin()) - 1;
+}
+
+} // anonymous namespace
+
+std::shared_ptr<const DepthProfile> LXPool::build_depth_profile(
+        const PoolState& pool, int32_t step_ticks, size_t levels, uint64_t version) {
+    auto profile = std::make_shared<DepthProfile>();
+    profile->step_ticks = step_ticks;
+    profile->levels = levels;
+    profile->liquidity_version = version;
+    profile->anchor = floor_div(pool.slot0.tick, step_ticks);
+
+    const int64_t span = static_cast<int64_t>(levels);
+    const int32_t lo = static_cast<int32_t>(std::max<int64_t>(
+        tick_math::MIN_TICK, (profile->anchor - span + 1) * step_ticks));
+    const int32_t hi = static_cast<int32_t>(std::min<int64_t>(
+        tick_math::MAX_TICK, (profile->anchor + span) * step_ticks));
+
+    // Boundaries: the window's ends, every step, every initialized tick
+    std::vector<int32_t>& ticks = profile->ticks;
+    ticks.push_back(lo);
+    for (int64_t t = (floor_div(lo, step_ticks) + 1) * step_ticks; t < hi; t += step_ticks) {
+        ticks.push_back(static_cast<int32_t>(t));
+    }
+    ticks.push_back(hi);
+    for (auto t = pool.tick_bitmap.next_above(lo); t && *t < hi;
+         t = pool.tick_bitmap.next_above(*t)) {
+        ticks.push_back(*t);
+    }
+    std::sort(ticks.begin(), ticks.end());
+    ticks.erase(std::unique(ticks.begin(), ticks.end()), ticks.end());
+
+    profile->sqrt_prices.reserve(ticks.size());
+    profile->steps.reserve(ticks.size());
+    for (int32_t t : ticks) {
+        profile->sqrt_prices.push_back(get_sqrt_ratio_at_tick(t));
+        profile->steps.push_back(t % step_ticks == 0 || t == lo || t == hi);
+    }
+
+    // Walk out from the current segment, crossing initialized ticks as a
+    // swap would
+    auto liquidity_net = [&pool](int32_t t) -> I128 {
+        auto it = pool.ticks.find(t);
+        return it != pool.ticks.end() && it->second.initialized ? it->second.liquidity_net : 0;
+    };
+    const size_t current = profile_segment(*profile, pool.slot0.tick);
+    std::vector<I128>& liquidity = profile->liquidity;
+    liquidity.assign(ticks.size() - 1, 0);
+    liquidity[current] = pool.liquidity;
+    for (size_t i = current + 1; i < liquidity.size(); ++i) {
+        liquidity[i] = liquidity[i - 1] + liquidity_net(ticks[i]);
+    }
+    for (size_t i = current; i-- > 0;) {
+        liquidity[i] = liquidity[i + 1] - liquidity_net(ticks[i + 1]);
+    }
+    return profile;
+}
+
+std::optional<PoolDepth> LXPool::get_depth(const PoolKey& key, int32_t step_ticks,
+                                           size_t levels) const {
+    return get_depth(PoolHandle(get_pool(key)), step_ticks, levels);
+}
+
+std::optional<PoolDepth> LXPool::get_depth(PoolHandle handle, int32_t step_ticks,
+                                           size_t levels) const {
+    const PoolSlot* slot = handle.slot_;
+    if (!slot || step_ticks <= 0 || levels == 0) {
+        return std::nullopt;
+    }
+    const size_t max_levels =
+        static_cast<size_t>((tick_math::MAX_TICK - tick_math::MIN_TICK) / step_ticks) + 1;
+    levels = std::min(levels, max_levels);
+
+    std::shared_lock lock(slot->mutex);
+    const PoolState& pool = slot->state;
+
+    std::shared_ptr<const DepthProfile> profile;
+    {
+        std::lock_guard depth_lock(slot->depth_mutex);
+        profile = slot->depth_profile;
+        if (!profile || profile->step_ticks != step_ticks || profile->levels != levels ||
+            profile->liquidity_version != slot->liquidity_version ||
+            profile->anchor != floor_div(pool.slot0.tick, step_ticks)) {
+            profile = build_depth_profile(pool, step_ticks, levels, slot->liquidity_version);
+            slot->depth_profile = profile;
+        }
+    }
+
+    PoolDepth depth;
+    depth.tick = pool.slot0.tick;
+    depth.sqrt_price_x96 = pool.slot0.sqrt_price_x96;
+    depth.liquidity = pool.liquidity;
+    lock.unlock();
+
+    const std::vector<I128>& sqrt_prices = profile->sqrt_prices;
+    const I128 price = depth.sqrt_price_x96;
+    const size_t current = profile_segment(*profile, depth.tick);
+
+    // Price rising: token1 in, token0 out
+    I128 amount_in = 0, amount_out = 0;
+    for (size_t i = current; i + 1 < sqrt_prices.size(); ++i) {
+        const I128 lower = std::max(sqrt_prices[i], price);
+        const I128 upper = sqrt_prices[i + 1];
+        const I128 liquidity = profile->liquidity[i];
+        if (upper > lower && liquidity > 0) {
+            amount_in += mul_div_up(liquidity, upper - lower, Q96);
+            amount_out += mul_div(mul_div(liquidity, upper - lower, upper), Q96, lower);
+        }
+        if (profile->steps[i + 1]) {
+            depth.asks.push_back({profile->ticks[i + 1], upper, amount_in, amount_out});
+        }
+    }
+
+    // Price falling: token0 in, token1 out
+    amount_in = 0;
+    amount_out = 0;
+    for (size_t i = current + 1; i-- > 0;) {
+        const I128 lower = sqrt_prices[i];
+        const I128 upper = std::min(sqrt_prices[i + 1], price);
+        const I128 liquidity = profile->liquidity[i];
+        if (upper > lower && liquidity > 0) {
+            amount_in += mul_div_up(mul_div(liquidity, upper - lower, lower), Q96, upper);
+            amount_out += mul_div(liquidity, upper - lower, Q96);
+        }
+        if (profile->steps[i]) {
+            depth.bids.push_back({profile->ticks[i], lower, amount_in, amount_out});
+        }
+    }
+
+    return depth;
+}
+
 // =============================================================================
 // Modify Liquidity
 // =============================================================================
 
 BalanceDelta LXPool::modify_liquidity(const PoolKey& key, const ModifyLiquidityParams& params,
-                                       const std::vector<uint8_t>& hook_data) {
+                                       const std::vector<uint8_t>& /*hook_data*/) {
+    return modify_liquidity_in_pool(get_pool(key), params, active_context());
+}
+
+BalanceDelta LXPool::modify_liquidity(PoolHandle pool, const ModifyLiquidityParams& params,
+                                       const std::vector<uint8_t>& /*hook_data*/) {
+    return modify_liquidity_in_pool(pool.slot_, params, active_context());
+}
+
+BalanceDelta LXPool::modify_liquidity(FlashContext& ctx, const PoolKey& key,
+                                       const ModifyLiquidityParams& params,
+                                       const std::vector<uint8_t>& /*hook_data*/) {
+    return modify_liquidity_in_pool(get_pool(key), params, &ctx);
+}
+
+BalanceDelta LXPool::modify_liquidity_in_pool(PoolSlot* slot, const ModifyLiquidityParams& params,
+                                               FlashContext* ctx) {
+    if (!slot) {
+        return {0, 0};
+    }
+    const PoolKey& key = slot->key;
+
     // Validate tick range
     if (params.tick_lower >= params.tick_upper) {
         return {0, 0};
@@ -719,17 +889,18 @@ BalanceDelta LXPool::modify_liquidity(const PoolKey& key, const ModifyLiquidityP
     }
 
     // Call before hook
-    IHooks* hooks = get_hooks(key);
-    if (hooks && !hooks->before_modify_liquidity(key, params)) {
+    IHooks* hooks = slot->hooks;
+    const bool adding = params.liquidity_delta > 0;
+    const uint16_t flags = slot->hook_flags &
+        (adding ? hook_flags::BEFORE_ADD_LIQUIDITY | hook_flags::AFTER_ADD_LIQUIDITY
+                : hook_flags::BEFORE_REMOVE_LIQUIDITY | hook_flags::AFTER_REMOVE_LIQUIDITY);
+    if ((flags & (hook_flags::BEFORE_ADD_LIQUIDITY | hook_flags::BEFORE_REMOVE_LIQUIDITY)) &&
+        !hooks->before_modify_liquidity(key, params)) {
         return {0, 0};
     }
 
-    std::unique_lock lock(pools_mutex_);
-
-    PoolState* pool = get_pool(key);
-    if (!pool) {
-        return {0, 0};
-    }
+    std::unique_lock lock(slot->mutex);
+    PoolState* pool = &slot->state;
 
     int32_t tick_current = pool->slot0.tick;
     I128 liquidity_delta = params.liquidity_delta;
@@ -743,12 +914,14 @@ BalanceDelta LXPool::modify_liquidity(const PoolKey& key, const ModifyLiquidityP
     // Initialize tick if first liquidity
     if (lower_gross_before == 0 && lower.liquidity_gross > 0) {
         lower.initialized = true;
+        pool->tick_bitmap.set(params.tick_lower, true);
         if (tick_current >= params.tick_lower) {
             lower.fee_growth_outside0_x128 = pool->fee_growth_global0_x128;
             lower.fee_growth_outside1_x128 = pool->fee_growth_global1_x128;
         }
     } else if (lower.liquidity_gross == 0) {
         lower.initialized = false;
+        pool->tick_bitmap.set(params.tick_lower, false);
     }
 
     // Update upper tick
@@ -759,18 +932,21 @@ BalanceDelta LXPool::modify_liquidity(const PoolKey& key, const ModifyLiquidityP
 
     if (upper_gross_before == 0 && upper.liquidity_gross > 0) {
         upper.initialized = true;
+        pool->tick_bitmap.set(params.tick_upper, true);
         if (tick_current >= params.tick_upper) {
             upper.fee_growth_outside0_x128 = pool->fee_growth_global0_x128;
             upper.fee_growth_outside1_x128 = pool->fee_growth_global1_x128;
         }
     } else if (upper.liquidity_gross == 0) {
         upper.initialized = false;
+        pool->tick_bitmap.set(params.tick_upper, false);
     }
 
     // Update global liquidity if position is in range
     if (tick_current >= params.tick_lower && tick_current < params.tick_upper) {
         pool->liquidity += liquidity_delta;
     }
+    ++slot->liquidity_version;
 
     // Compute fee growth inside range
     I128 fee_below0, fee_below1;
@@ -848,21 +1024,23 @@ BalanceDelta LXPool::modify_liquidity(const PoolKey& key, const ModifyLiquidityP
     BalanceDelta total_delta = principal_delta + fee_delta;
 
     // Update flash accounting
-    if (locked_) {
-        currency_deltas_[currency_hash(key.currency0)] += total_delta.amount0;
-        currency_deltas_[currency_hash(key.currency1)] += total_delta.amount1;
-    }
+    record_deltas(ctx, slot, total_delta.amount0, total_delta.amount1);
 
     // Update statistics
     total_liquidity_ops_.fetch_add(1, std::memory_order_relaxed);
 
+    const I128 active_liquidity = pool->liquidity;
     lock.unlock();
 
     // Call after hook
-    if (hooks) {
+    if (flags & (hook_flags::AFTER_ADD_LIQUIDITY | hook_flags::AFTER_REMOVE_LIQUIDITY)) {
         hooks->after_modify_liquidity(key, params, total_delta);
     }
 
+    if (liquidity_listener_) {
+        liquidity_listener_(key, active_liquidity);
+    }
+
     return total_delta;
 }
 
@@ -871,20 +1049,36 @@ BalanceDelta LXPool::modify_liquidity(const PoolKey& key, const ModifyLiquidityP
 // =============================================================================
 
 BalanceDelta LXPool::donate(const PoolKey& key, I128 amount0, I128 amount1,
-                             const std::vector<uint8_t>& hook_data) {
-    // Call before hook
-    IHooks* hooks = get_hooks(key);
-    if (hooks && !hooks->before_donate(key, amount0, amount1)) {
+                             const std::vector<uint8_t>& /*hook_data*/) {
+    return donate_to_pool(get_pool(key), amount0, amount1, active_context());
+}
+
+BalanceDelta LXPool::donate(PoolHandle pool, I128 amount0, I128 amount1,
+                             const std::vector<uint8_t>& /*hook_data*/) {
+    return donate_to_pool(pool.slot_, amount0, amount1, active_context());
+}
+
+BalanceDelta LXPool::donate(FlashContext& ctx, const PoolKey& key, I128 amount0, I128 amount1,
+                             const std::vector<uint8_t>& /*hook_data*/) {
+    return donate_to_pool(get_pool(key), amount0, amount1, &ctx);
+}
+
+BalanceDelta LXPool::donate_to_pool(PoolSlot* slot, I128 amount0, I128 amount1, FlashContext* ctx) {
+    if (!slot) {
         return {0, 0};
     }
+    const PoolKey& key = slot->key;
 
-    std::unique_lock lock(pools_mutex_);
-
-    PoolState* pool = get_pool(key);
-    if (!pool) {
+    // Call before hook
+    IHooks* hooks = slot->hooks;
+    const uint16_t flags = slot->hook_flags;
+    if ((flags & hook_flags::BEFORE_DONATE) && !hooks->before_donate(key, amount0, amount1)) {
         return {0, 0};
     }
 
+    std::unique_lock lock(slot->mutex);
+    PoolState* pool = &slot->state;
+
     // Cannot donate if no liquidity
     if (pool->liquidity <= 0) {
         return {0, 0};
@@ -901,15 +1095,12 @@ BalanceDelta LXPool::donate(const PoolKey& key, I128 amount0, I128 amount1,
     BalanceDelta delta{amount0, amount1};
 
     // Update flash accounting
-    if (locked_) {
-        currency_deltas_[currency_hash(key.currency0)] += amount0;
-        currency_deltas_[currency_hash(key.currency1)] += amount1;
-    }
+    record_deltas(ctx, slot, amount0, amount1);
 
     lock.unlock();
 
     // Call after hook
-    if (hooks) {
+    if (flags & hook_flags::AFTER_DONATE) {
         hooks->after_donate(key, amount0, amount1);
     }
 
@@ -921,63 +1112,60 @@ BalanceDelta LXPool::donate(const PoolKey& key, I128 amount0, I128 amount1,
 // =============================================================================
 
 void LXPool::lock(LockCallback callback) {
-    if (locked_) {
+    if (active_context()) {
         throw std::runtime_error("LXPool: already locked (reentrancy)");
     }
 
-    locked_ = true;
-    currency_deltas_.clear();
+    FlashContext ctx;
+    ctx.locked = true;
+    const ActiveLock outer = active_lock;
+    active_lock = {this, &ctx};
 
     try {
         callback();
     } catch (...) {
-        locked_ = false;
-        currency_deltas_.clear();
+        active_lock = outer;
         throw;
     }
+    active_lock = outer;
 
     // Verify all deltas settled to zero
-    for (const auto& [hash, delta] : currency_deltas_) {
-        if (delta != 0) {
-            locked_ = false;
-            currency_deltas_.clear();
-            throw std::runtime_error("LXPool: unsettled currency delta");
-        }
+    if (!ctx.currency_deltas.all_zero()) {
+        throw std::runtime_error("LXPool: unsettled currency delta");
     }
-
-    locked_ = false;
-    currency_deltas_.clear();
 }
 
 void LXPool::take(const Currency& currency, const Address& to, I128 amount) {
-    if (!locked_) {
+    FlashContext* ctx = active_context();
+    if (!ctx) {
         throw std::runtime_error("LXPool: not locked");
     }
     // Taking creates debt (positive delta = pool is owed)
-    currency_deltas_[currency_hash(currency)] += amount;
+    ctx->currency_deltas[currency_hash(currency)] += amount;
     // In production: call ERC20.transfer(to, amount)
     (void)to;
 }
 
 I128 LXPool::settle(const Currency& currency) {
-    if (!locked_) {
+    FlashContext* ctx = active_context();
+    if (!ctx) {
         throw std::runtime_error("LXPool: not locked");
     }
     uint64_t h = currency_hash(currency);
-    I128 delta = currency_deltas_[h];
+    I128 delta = ctx->currency_deltas[h];
     // In production: receive tokens and verify balance increased
-    currency_deltas_[h] = 0;
+    ctx->currency_deltas[h] = 0;
     return delta;
 }
 
 void LXPool::sync(const Currency& currency) {
-    if (!locked_) {
+    FlashContext* ctx = active_context();
+    if (!ctx) {
         throw std::runtime_error("LXPool: not locked");
     }
     // Sync: update internal balance tracking after external transfer
     // In production: read actual token balance and reconcile
-    uint64_t h = currency_hash(currency);
-    currency_deltas_[h] = 0;
+    ctx->currency_deltas[currency_hash(currency)] = 0;
 }
 
 // =============================================================================
@@ -985,15 +1173,23 @@ void LXPool::sync(const Currency& currency) {
 // =============================================================================
 
 std::optional<Slot0> LXPool::get_slot0(const PoolKey& key) const {
-    std::shared_lock lock(pools_mutex_);
-    const PoolState* pool = get_pool(key);
-    return pool ? std::optional{pool->slot0} : std::nullopt;
+    return get_slot0(find_pool(key));
+}
+
+std::optional<Slot0> LXPool::get_slot0(PoolHandle pool) const {
+    if (!pool) return std::nullopt;
+    std::shared_lock lock(pool.slot_->mutex);
+    return pool.slot_->state.slot0;
 }
 
 std::optional<I128> LXPool::get_liquidity(const PoolKey& key) const {
-    std::shared_lock lock(pools_mutex_);
-    const PoolState* pool = get_pool(key);
-    return pool ? std::optional{pool->liquidity} : std::nullopt;
+    return get_liquidity(find_pool(key));
+}
+
+std::optional<I128> LXPool::get_liquidity(PoolHandle pool) const {
+    if (!pool) return std::nullopt;
+    std::shared_lock lock(pool.slot_->mutex);
+    return pool.slot_->state.liquidity;
 }
 
 std::optional<PositionInfo> LXPool::get_position(const PoolKey& key,
@@ -1001,18 +1197,17 @@ std::optional<PositionInfo> LXPool::get_position(const PoolKey& key,
                                                    int32_t tick_lower,
                                                    int32_t tick_upper,
                                                    uint64_t salt) const {
-    std::shared_lock lock(pools_mutex_);
-    const PoolState* pool = get_pool(key);
-    if (!pool) return std::nullopt;
+    PoolSlot* slot = get_pool(key);
+    if (!slot) return std::nullopt;
+    std::shared_lock lock(slot->mutex);
 
     uint64_t pos_key = position_key(owner, tick_lower, tick_upper, salt);
-    auto it = pool->positions.find(pos_key);
-    return it != pool->positions.end() ? std::optional{it->second} : std::nullopt;
+    auto it = slot->state.positions.find(pos_key);
+    return it != slot->state.positions.end() ? std::optional{it->second} : std::nullopt;
 }
 
 bool LXPool::pool_exists(const PoolKey& key) const {
-    std::shared_lock lock(pools_mutex_);
-    return pools_.find(key.id()) != pools_.end();
+    return get_pool(key) != nullptr;
 }
 
 // =============================================================================
@@ -1020,25 +1215,25 @@ bool LXPool::pool_exists(const PoolKey& key) const {
 // =============================================================================
 
 void LXPool::set_protocol_fee(const PoolKey& key, uint32_t new_fee) {
-    std::unique_lock lock(pools_mutex_);
-    PoolState* pool = get_pool(key);
-    if (pool) {
-        pool->slot0.protocol_fee = new_fee;
+    PoolSlot* slot = get_pool(key);
+    if (slot) {
+        std::unique_lock lock(slot->mutex);
+        slot->state.slot0.protocol_fee = new_fee;
     }
 }
 
 BalanceDelta LXPool::collect_protocol(const PoolKey& key, const Address& recipient) {
-    std::unique_lock lock(pools_mutex_);
-    PoolState* pool = get_pool(key);
-    if (!pool) {
+    PoolSlot* slot = get_pool(key);
+    if (!slot) {
         return {0, 0};
     }
+    std::unique_lock lock(slot->mutex);
 
-    I128 amount0 = pool->protocol_fees0;
-    I128 amount1 = pool->protocol_fees1;
+    I128 amount0 = slot->state.protocol_fees0;
+    I128 amount1 = slot->state.protocol_fees1;
 
-    pool->protocol_fees0 = 0;
-    pool->protocol_fees1 = 0;
+    slot->state.protocol_fees0 = 0;
+    slot->state.protocol_fees1 = 0;
 
     // In production: transfer tokens to recipient
     (void)recipient;
@@ -1052,9 +1247,13 @@ BalanceDelta LXPool::collect_protocol(const PoolKey& key, const Address& recipie
 // =============================================================================
 
 void LXPool::register_hooks(const Address& hook_addr, IHooks* hooks) {
+    register_hooks(hook_addr, hooks, hook_flags::from_address(hook_addr));
+}
+
+void LXPool::register_hooks(const Address& hook_addr, IHooks* hooks, uint16_t flags) {
     if (!hooks || is_zero_address(hook_addr)) return;
     std::unique_lock lock(hooks_mutex_);
-    hooks_[address_hash(hook_addr)] = hooks;
+    hooks_[address_hash(hook_addr)] = RegisteredHooks{hooks, static_cast<uint16_t>(flags & hook_flags::ALL)};
 }
 
 void LXPool::unregister_hooks(const Address& hook_addr) {
@@ -1062,6 +1261,10 @@ void LXPool::unregister_hooks(const Address& hook_addr) {
     hooks_.erase(address_hash(hook_addr));
 }
 
+void LXPool::set_liquidity_listener(LiquidityListener listener) {
+    liquidity_listener_ = std::move(listener);
+}
+
 // =============================================================================
 // Statistics
 // =============================================================================
@@ -0,0 +1,347 @@
+// =============================================================================
+// replication.cpp - Journal streaming from a primary to read replicas
+// =============================================================================
+
+#include "lux/replication.hpp"
+#include "lux/engine.hpp"
+#include <algorithm>
+#include <cerrno>
+#include <cstring>
+
+#include <arpa/inet.h>
+#include <netdb.h>
+#include <netinet/in.h>
+#include <netinet/tcp.h>
+#include <poll.h>
+#include <sys/socket.h>
+#include <unistd.h>
+
+namespace lux {
+
+namespace {
+
+constexpr uint64_t REPLICATION_MAGIC = 0x4c55585245504c31ull;  // "LUXREPL1"
+constexpr int WAIT_MS = 50;     // Blocking calls wake this often to check for stop
+
+// Replica -> primary, once per connection
+struct Hello {
+    uint64_t magic;
+    uint32_t record_size;
+    uint32_t reserved;
+    uint64_t after_sequence;
+};
+
+// Primary -> replica, followed by count records
+struct FrameHeader {
+    uint64_t committed;
+    uint32_t count;
+    uint32_t reserved;
+};
+
+bool wait_for(int fd, short events, const std::atomic<bool>& running) {
+    pollfd pfd{fd, events, 0};
+    while (running.load(std::memory_order_acquire)) {
+        const int ready = ::poll(&pfd, 1, WAIT_MS);
+        if (ready > 0) {
+            return true;
+        }
+        if (ready < 0 && errno != EINTR) {
+            return false;
+        }
+    }
+    return false;
+}
+
+bool send_all(int fd, const void* data, size_t len, const std::atomic<bool>& running) {
+    const char* p = static_cast<const char*>(data);
+    while (len > 0) {
+        if (!wait_for(fd, POLLOUT, running)) {
+            return false;
+        }
+        const ssize_t n = ::send(fd, p, len, MSG_NOSIGNAL);
+        if (n <= 0) {
+            if (n < 0 && (errno == EINTR || errno == EAGAIN)) continue;
+            return false;
+        }
+        p += n;
+        len -= static_cast<size_t>(n);
+    }
+    return true;
+}
+
+bool recv_all(int fd, void* data, size_t len, const std::atomic<bool>& running) {
+    char* p = static_cast<char*>(data);
+    while (len > 0) {
+        if (!wait_for(fd, POLLIN, running)) {
+            return false;
+        }
+        const ssize_t n = ::recv(fd, p, len, 0);
+        if (n <= 0) {
+            if (n < 0 && (errno == EINTR || errno == EAGAIN)) continue;
+            return false;
+        }
+        p += n;
+        len -= static_cast<size_t>(n);
+    }
+    return true;
+}
+
+void set_nodelay(int fd) {
+    int one = 1;
+    ::setsockopt(fd, IPPROTO_TCP, TCP_NODELAY, &one, sizeof(one));
+}
+
+int connect_to(const std::string& host, uint16_t port) {
+    addrinfo hints{};
+    hints.ai_family = AF_UNSPEC;
+    hints.ai_socktype = SOCK_STREAM;
+    addrinfo* result = nullptr;
+    if (::getaddrinfo(host.c_str(), std::to_string(port).c_str(), &hints, &result) != 0) {
+        return -1;
+    }
+    int fd = -1;
+    for (addrinfo* ai = result; ai; ai = ai->ai_next) {
+        fd = ::socket(ai->ai_family, ai->ai_socktype, ai->ai_protocol);
+        if (fd < 0) continue;
+        if (::connect(fd, ai->ai_addr, ai->ai_addrlen) == 0) break;
+        ::close(fd);
+        fd = -1;
+    }
+    ::freeaddrinfo(result);
+    if (fd >= 0) {
+        set_nodelay(fd);
+    }
+    return fd;
+}
+
+} // namespace
+
+// =============================================================================
+// ReplicationPrimary
+// =============================================================================
+
+std::unique_ptr<ReplicationPrimary> ReplicationPrimary::start(const std::string& journal_path,
+                                                              uint16_t port,
+                                                              ReplicationConfig config) {
+    auto status_reader = JournalReader::open(journal_path);
+    if (!status_reader) {
+        return nullptr;
+    }
+
+    int fd = ::socket(AF_INET, SOCK_STREAM, 0);
+    if (fd < 0) {
+        return nullptr;
+    }
+    int one = 1;
+    ::setsockopt(fd, SOL_SOCKET, SO_REUSEADDR, &one, sizeof(one));
+    sockaddr_in addr{};
+    addr.sin_family = AF_INET;
+    addr.sin_addr.s_addr = htonl(INADDR_ANY);
+    addr.sin_port = htons(port);
+    socklen_t addr_len = sizeof(addr);
+    if (::bind(fd, reinterpret_cast<sockaddr*>(&addr), sizeof(addr)) != 0 ||
+        ::listen(fd, 16) != 0 ||
+        ::getsockname(fd, reinterpret_cast<sockaddr*>(&addr), &addr_len) != 0) {
+        ::close(fd);
+        return nullptr;
+    }
+
+    std::unique_ptr<ReplicationPrimary> primary(
+        new ReplicationPrimary(journal_path, fd, ntohs(addr.sin_port), config));
+    primary->status_reader_ = std::move(status_reader);
+    primary->accept_thread_ = std::thread([p = primary.get()] { p->accept_loop(); });
+    return primary;
+}
+
+ReplicationPrimary::ReplicationPrimary(std::string journal_path, int listen_fd, uint16_t port,
+                                       ReplicationConfig config)
+    : journal_path_(std::move(journal_path)), listen_fd_(listen_fd), port_(port), config_(config) {
+    if (config_.max_batch == 0) {
+        config_.max_batch = 1;
+    }
+}
+
+ReplicationPrimary::~ReplicationPrimary() {
+    stop();
+}
+
+void ReplicationPrimary::stop() {
+    if (!running_.exchange(false)) {
+        return;
+    }
+    if (accept_thread_.joinable()) {
+        accept_thread_.join();
+    }
+    ::close(listen_fd_);
+
+    std::lock_guard lock(sessions_mutex_);
+    for (auto& session : sessions_) {
+        if (session->thread.joinable()) {
+            session->thread.join();
+        }
+    }
+}
+
+void ReplicationPrimary::accept_loop() {
+    while (wait_for(listen_fd_, POLLIN, running_)) {
+        const int fd = ::accept(listen_fd_, nullptr, nullptr);
+        if (fd < 0) {
+            continue;
+        }
+        set_nodelay(fd);
+
+        std::lock_guard lock(sessions_mutex_);
+        sessions_.erase(std::remove_if(sessions_.begin(), sessions_.end(), [](auto& session) {
+            if (session->connected.load(std::memory_order_relaxed)) return false;
+            session->thread.join();
+            return true;
+        }), sessions_.end());
+        auto session = std::make_unique<Session>();
+        session->fd = fd;
+        Session& s = *session;
+        session->thread = std::thread([this, &s] { serve(s); });
+        sessions_.push_back(std::move(session));
+    }
+}
+
+void ReplicationPrimary::serve(Session& session) {
+    const int fd = session.fd;
+    Hello hello{};
+    auto reader = JournalReader::open(journal_path_);
+    if (reader && recv_all(fd, &hello, sizeof(hello), running_) &&
+        hello.magic == REPLICATION_MAGIC && hello.record_size == sizeof(JournalRecord)) {
+        uint64_t sent = hello.after_sequence;
+        session.sent.store(sent, std::memory_order_relaxed);
+        session.acked.store(sent, std::memory_order_relaxed);
+        auto last_frame = std::chrono::steady_clock::now();
+
+        while (running_.load(std::memory_order_acquire)) {
+            const uint64_t committed = reader->refresh();
+            const size_t count = committed > sent
+                ? static_cast<size_t>(std::min<uint64_t>(committed - sent, config_.max_batch))
+                : 0;
+            const auto now = std::chrono::steady_clock::now();
+            if (count > 0 || now - last_frame >= config_.heartbeat_interval) {
+                // Records are read straight out of the mapping
+                FrameHeader header{committed, static_cast<uint32_t>(count), 0};
+                if (!send_all(fd, &header, sizeof(header), running_) ||
+                    !send_all(fd, reader->begin() + sent, count * sizeof(JournalRecord), running_)) {
+                    break;
+                }
+                sent += count;
+                session.sent.store(sent, std::memory_order_relaxed);
+                last_frame = now;
+            }
+
+            // Acknowledgements, without blocking the stream
+            uint64_t acked;
+            ssize_t n;
+            while ((n = ::recv(fd, &acked, sizeof(acked), MSG_DONTWAIT)) == sizeof(acked)) {
+                session.acked.store(acked, std::memory_order_relaxed);
+            }
+            if (n == 0 || (n < 0 && errno != EAGAIN && errno != EWOULDBLOCK && errno != EINTR)) {
+                break;      // Replica gone
+            }
+            if (count < config_.max_batch) {
+                std::this_thread::sleep_for(config_.poll_interval);
+            }
+        }
+    }
+    session.connected.store(false, std::memory_order_relaxed);
+    ::close(fd);
+}
+
+std::vector<ReplicationPrimary::ReplicaStatus> ReplicationPrimary::replicas() const {
+    std::lock_guard lock(sessions_mutex_);
+    std::vector<ReplicaStatus> out;
+    out.reserve(sessions_.size());
+    for (const auto& session : sessions_) {
+        out.push_back({session->sent.load(std::memory_order_relaxed),
+                       session->acked.load(std::memory_order_relaxed),
+                       session->connected.load(std::memory_order_relaxed)});
+    }
+    return out;
+}
+
+uint64_t ReplicationPrimary::committed_sequence() const {
+    std::lock_guard lock(sessions_mutex_);
+    return status_reader_->refresh();
+}
+
+// =============================================================================
+// EngineReplica
+// =============================================================================
+
+EngineReplica::EngineReplica(Engine& engine, std::string host, uint16_t port,
+                             uint64_t after_sequence, ReplicationConfig config)
+    : engine_(engine), host_(std::move(host)), port_(port), config_(config),
+      applied_(after_sequence), primary_(after_sequence) {
+    thread_ = std::thread([this] { run(); });
+}
+
+EngineReplica::~EngineReplica() {
+    running_.store(false, std::memory_order_release);
+    if (thread_.joinable()) {
+        thread_.join();
+    }
+}
+
+void EngineReplica::promote() {
+    running_.store(false, std::memory_order_release);
+    if (thread_.joinable()) {
+        thread_.join();
+    }
+    engine_.flush_journal();
+    engine_.end_replication();
+}
+
+void EngineReplica::run() {
+    while (running_.load(std::memory_order_acquire)) {
+        const int fd = connect_to(host_, port_);
+        if (fd >= 0) {
+            connected_.store(true, std::memory_order_release);
+            follow(fd);
+            connected_.store(false, std::memory_order_release);
+            ::close(fd);
+        }
+        // Sleep in short steps so promote() is not held up
+        const auto until = std::chrono::steady_clock::now() + config_.reconnect_interval;
+        while (running_.load(std::memory_order_acquire) && std::chrono::steady_clock::now() < until) {
+            std::this_thread::sleep_for(std::chrono::milliseconds(1));
+        }
+    }
+}
+
+void EngineReplica::follow(int fd) {
+    Hello hello{REPLICATION_MAGIC, sizeof(JournalRecord), 0, applied_sequence()};
+    if (!send_all(fd, &hello, sizeof(hello), running_)) {
+        return;
+    }
+
+    std::vector<JournalRecord> records;
+    FrameHeader header{};
+    while (recv_all(fd, &header, sizeof(header), running_)) {
+        records.resize(header.count);
+        if (!recv_all(fd, records.data(), records.size() * sizeof(JournalRecord), running_)) {
+            return;
+        }
+        uint64_t applied = applied_sequence();
+        for (const JournalRecord& record : records) {
+            if (record.sequence != applied + 1) {
+                return;       // Gap or repeat: resubscribe from what we have
+            }
+            engine_.apply_replicated(record);
+            applied = record.sequence;
+        }
+        applied_.store(applied, std::memory_order_release);
+        primary_.store(std::max(header.committed, applied), std::memory_order_release);
+        if (!records.empty()) {
+            engine_.flush_journal();
+            if (!send_all(fd, &applied, sizeof(applied), running_)) {
+                return;
+            }
+        }
+    }
+}
+
+} // namespace lux
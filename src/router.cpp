@@ -0,0 +1,267 @@
+// =============================================================================
+// router.cpp - Multi-hop Swap Router
+// =============================================================================
+
+#include "lux/router.hpp"
+#include <algorithm>
+#include <mutex>
+#include <unordered_set>
+
+namespace lux {
+
+namespace {
+
+inline uint64_t currency_hash(const Currency& c) {
+    uint64_t h = 0;
+    for (uint8_t b : c.addr) h = h * 31 + b;
+    return h;
+}
+
+inline bool has_hooks(const PoolKey& key) {
+    for (uint8_t b : key.hooks) if (b != 0) return true;
+    return false;
+}
+
+// Token received from an exact-input swap
+inline I128 amount_out(const BalanceDelta& delta, bool zero_for_one) {
+    return zero_for_one ? -delta.amount1 : -delta.amount0;
+}
+
+// Input of `parts` out of `total` equal parts, without overflowing amount * parts
+inline I128 part_amount(I128 amount, size_t parts, size_t total) {
+    const I128 n = static_cast<I128>(parts);
+    const I128 d = static_cast<I128>(total);
+    return amount / d * n + amount % d * n / d;
+}
+
+} // anonymous namespace
+
+// =============================================================================
+// Lifecycle
+// =============================================================================
+
+LXRouter::LXRouter(LXPool& pool, const RouterConfig& config)
+    : pool_(pool), config_(config) {
+    config_.max_hops = std::max<size_t>(1, config_.max_hops);
+    config_.max_paths = std::max<size_t>(1, config_.max_paths);
+    config_.split_parts = std::max<size_t>(1, config_.split_parts);
+}
+
+// =============================================================================
+// Graph Maintenance
+// =============================================================================
+
+void LXRouter::on_pool_update(const PoolKey& key, I128 liquidity) {
+    if (has_hooks(key)) {
+        return;
+    }
+    const uint64_t pool_id = key.id();
+    const uint64_t token0 = currency_hash(key.currency0);
+    const uint64_t token1 = currency_hash(key.currency1);
+
+    std::unique_lock lock(graph_mutex_);
+
+    auto it = pools_.find(pool_id);
+    if (it != pools_.end()) {
+        it->second = liquidity;
+        for (uint64_t token : {token0, token1}) {
+            for (Edge& edge : graph_[token]) {
+                if (edge.pool_id == pool_id) edge.liquidity = liquidity;
+            }
+        }
+        return;
+    }
+
+    PoolHandle handle = pool_.find_pool(key);
+    if (!handle) {
+        return;
+    }
+    pools_.emplace(pool_id, liquidity);
+    graph_[token0].push_back({handle, pool_id, token1, true, liquidity});
+    graph_[token1].push_back({handle, pool_id, token0, false, liquidity});
+}
+
+size_t LXRouter::pool_count() const {
+    std::shared_lock lock(graph_mutex_);
+    return pools_.size();
+}
+
+size_t LXRouter::token_count() const {
+    std::shared_lock lock(graph_mutex_);
+    return graph_.size();
+}
+
+// =============================================================================
+// Path Search
+// =============================================================================
+
+std::vector<LXRouter::Candidate> LXRouter::find_paths(uint64_t from, uint64_t to) const {
+    struct Found {
+        Candidate candidate;
+        I128 bottleneck;        // Least active liquidity along the path
+    };
+    std::vector<Found> found;
+
+    std::vector<const Edge*> path;
+    std::vector<uint64_t> visited{from};
+
+    // Depth-first over simple paths; no token twice means no pool twice
+    auto search = [&](auto& self, uint64_t token) -> void {
+        auto it = graph_.find(token);
+        if (it == graph_.end()) return;
+        for (const Edge& edge : it->second) {
+            if (edge.liquidity <= 0) continue;
+            if (std::find(visited.begin(), visited.end(), edge.to) != visited.end()) continue;
+
+            path.push_back(&edge);
+            if (edge.to == to) {
+                Found f;
+                f.bottleneck = edge.liquidity;
+                for (const Edge* e : path) {
+                    f.candidate.hops.push_back({e->pool, e->zero_for_one});
+                    f.candidate.pool_ids.push_back(e->pool_id);
+                    f.bottleneck = std::min(f.bottleneck, e->liquidity);
+                }
+                found.push_back(std::move(f));
+            } else if (path.size() < config_.max_hops) {
+                visited.push_back(edge.to);
+                self(self, edge.to);
+                visited.pop_back();
+            }
+            path.pop_back();
+        }
+    };
+    search(search, from);
+
+    // Deepest, then shortest, paths get quoted
+    std::sort(found.begin(), found.end(), [](const Found& a, const Found& b) {
+        if (a.bottleneck != b.bottleneck) return a.bottleneck > b.bottleneck;
+        return a.candidate.hops.size() < b.candidate.hops.size();
+    });
+    if (found.size() > config_.max_paths) {
+        found.resize(config_.max_paths);
+    }
+
+    std::vector<Candidate> candidates;
+    candidates.reserve(found.size());
+    for (Found& f : found) {
+        candidates.push_back(std::move(f.candidate));
+    }
+    return candidates;
+}
+
+// Chain one batched quote per hop; each hop's outputs are the next hop's inputs
+std::vector<I128> LXRouter::quote_path(const std::vector<RouteHop>& hops,
+                                       const std::vector<I128>& amounts_in) const {
+    std::vector<I128> amounts = amounts_in;
+    for (const RouteHop& hop : hops) {
+        auto quotes = pool_.quote_swaps(hop.pool, hop.zero_for_one, amounts);
+        if (quotes.size() != amounts.size()) {
+            return std::vector<I128>(amounts_in.size(), 0);
+        }
+        for (size_t i = 0; i < quotes.size(); ++i) {
+            amounts[i] = std::max<I128>(0, amount_out(quotes[i].delta, hop.zero_for_one));
+        }
+    }
+    return amounts;
+}
+
+// =============================================================================
+// Routing
+// =============================================================================
+
+Route LXRouter::find_route(const Currency& token_in, const Currency& token_out,
+                           I128 amount_in_x18) const {
+    Route route;
+    if (amount_in_x18 <= 0 || token_in == token_out) {
+        return route;
+    }
+
+    std::vector<Candidate> candidates;
+    {
+        std::shared_lock lock(graph_mutex_);
+        candidates = find_paths(currency_hash(token_in), currency_hash(token_out));
+    }
+    if (candidates.empty()) {
+        return route;
+    }
+
+    // Depth curve per path: output after 1..parts parts of the input
+    const size_t parts = static_cast<size_t>(
+        std::min<I128>(static_cast<I128>(config_.split_parts), amount_in_x18));
+    std::vector<I128> sizes(parts);
+    for (size_t k = 0; k < parts; ++k) {
+        sizes[k] = part_amount(amount_in_x18, k + 1, parts);
+    }
+    for (Candidate& c : candidates) {
+        c.curve = quote_path(c.hops, sizes);
+    }
+
+    // Hand out parts one at a time to the best marginal output. A path can
+    // only be opened if it shares no pool with the paths already open,
+    // since the quotes assume each pool is used by one path.
+    std::vector<size_t> alloc(candidates.size(), 0);
+    std::unordered_set<uint64_t> used_pools;
+    for (size_t part = 0; part < parts; ++part) {
+        size_t best = candidates.size();
+        I128 best_gain = -1;
+        for (size_t c = 0; c < candidates.size(); ++c) {
+            const size_t n = alloc[c];
+            if (n == 0) {
+                bool overlaps = false;
+                for (uint64_t id : candidates[c].pool_ids) {
+                    overlaps |= used_pools.count(id) != 0;
+                }
+                if (overlaps) continue;
+            }
+            const I128 gain = candidates[c].curve[n] - (n > 0 ? candidates[c].curve[n - 1] : 0);
+            if (gain > best_gain) {
+                best = c;
+                best_gain = gain;
+            }
+        }
+        if (best == candidates.size()) break;
+        if (alloc[best]++ == 0) {
+            used_pools.insert(candidates[best].pool_ids.begin(), candidates[best].pool_ids.end());
+        }
+    }
+
+    // Split the exact input by allocation; rounding dust goes to the first
+    // path. Each leg is quoted again at its exact size.
+    I128 assigned = 0;
+    for (size_t c = 0; c < candidates.size(); ++c) {
+        if (alloc[c] == 0) continue;
+        RoutePath path;
+        path.hops = std::move(candidates[c].hops);
+        path.amount_in_x18 = part_amount(amount_in_x18, alloc[c], parts);
+        assigned += path.amount_in_x18;
+        route.paths.push_back(std::move(path));
+    }
+    if (route.paths.empty()) {
+        return route;
+    }
+    route.paths.front().amount_in_x18 += amount_in_x18 - assigned;
+
+    for (RoutePath& path : route.paths) {
+        path.amount_out_x18 = quote_path(path.hops, {path.amount_in_x18}).front();
+        route.amount_in_x18 += path.amount_in_x18;
+        route.amount_out_x18 += path.amount_out_x18;
+    }
+    return route;
+}
+
+I128 LXRouter::execute(const Route& route) {
+    I128 total_out = 0;
+    for (const RoutePath& path : route.paths) {
+        I128 amount = path.amount_in_x18;
+        for (const RouteHop& hop : path.hops) {
+            amount = amount > 0
+                ? amount_out(pool_.swap(hop.pool, {hop.zero_for_one, amount, 0}), hop.zero_for_one)
+                : 0;
+        }
+        total_out += std::max<I128>(0, amount);
+    }
+    return total_out;
+}
+
+} // namespace lux
@@ -0,0 +1,246 @@
+// =============================================================================
+// settlement.cpp - Asynchronous LXBook -> LXVault Settlement Pipeline
+// =============================================================================
+
+#include "lux/settlement.hpp"
+#include "lux/fixed_point.hpp"
+#include "lux/tracing.hpp"
+#include <algorithm>
+#include <tuple>
+
+namespace lux {
+
+// =============================================================================
+// Trade Conversion
+// =============================================================================
+
+namespace {
+
+constexpr I128 E8_TO_X18 = X18_ONE / 100000000LL;   // Exact: 1e8 lots to X18
+constexpr I128 MAKER_FEE_X18 = x18::from_bps(2);    // 0.02%
+constexpr I128 TAKER_FEE_X18 = x18::from_bps(5);    // 0.05%
+
+} // namespace
+
+LXSettlement settlement_from_trade(const Trade& trade, const AccountResolver& resolver) {
+    LXSettlement settlement;
+
+    auto account = [&resolver](uint64_t account_id) {
+        if (resolver) {
+            if (std::optional<LXAccount> resolved = resolver(account_id)) {
+                return *resolved;
+            }
+        }
+        return LXAccount{{}, static_cast<uint16_t>(account_id & 0xFFFF)};
+    };
+    const bool taker_is_buy = trade.aggressor_side == Side::Buy;
+    settlement.maker = account(taker_is_buy ? trade.seller_account_id : trade.buyer_account_id);
+    settlement.taker = account(taker_is_buy ? trade.buyer_account_id : trade.seller_account_id);
+
+    settlement.market_id = static_cast<uint32_t>(trade.symbol_id);
+    settlement.taker_is_buy = taker_is_buy;
+
+    // Convert from 1e8 to X18
+    settlement.size_x18 = static_cast<I128>(trade.quantity) * E8_TO_X18;
+    settlement.price_x18 = static_cast<I128>(trade.price) * E8_TO_X18;
+
+    // Calculate fees (simplified)
+    I128 notional = x18::mul(settlement.size_x18, settlement.price_x18);
+    settlement.maker_fee_x18 = x18::mul(notional, MAKER_FEE_X18);
+    settlement.taker_fee_x18 = x18::mul(notional, TAKER_FEE_X18);
+
+    settlement.flags = (trade.aggressor_side == Side::Buy) ?
+        fill_flags::TAKER : fill_flags::MAKER;
+
+    return settlement;
+}
+
+// =============================================================================
+// Lifecycle
+// =============================================================================
+
+SettlementPipeline::SettlementPipeline(LXVault& vault, const SettlementConfig& config)
+    : vault_(vault), config_(config), ring_(config.queue_capacity) {
+    config_.max_batch = std::max<size_t>(1, config_.max_batch);
+    batch_.resize(config_.max_batch);
+    settlements_.reserve(config_.max_batch);
+    single_.resize(1);
+}
+
+SettlementPipeline::~SettlementPipeline() {
+    stop();
+}
+
+void SettlementPipeline::start() {
+    if (running_.exchange(true)) {
+        return;  // Already running
+    }
+    worker_ = std::thread([this] { worker_loop(); });
+}
+
+void SettlementPipeline::stop() {
+    if (!running_.exchange(false)) {
+        return;  // Already stopped
+    }
+    if (worker_.joinable()) {
+        worker_.join();
+    }
+}
+
+void SettlementPipeline::worker_loop() {
+    size_t idle_spins = 0;
+    while (true) {
+        if (settle_batch() == 0) {
+            // Drain everything published before stop() returns
+            if (!running_.load(std::memory_order_acquire) && ring_.empty_approx()) {
+                return;
+            }
+            if (++idle_spins > 64) {
+                std::this_thread::yield();
+            }
+            continue;
+        }
+        idle_spins = 0;
+    }
+}
+
+// =============================================================================
+// Producer Side
+// =============================================================================
+
+uint64_t SettlementPipeline::publish(const Trade& trade) {
+    uint64_t position;
+    if (ring_.try_push(trade, &position)) {
+        return position + 1;
+    }
+
+    // Back-pressure: matching waits for settlement rather than losing fills
+    backpressure_waits_.fetch_add(1, std::memory_order_relaxed);
+    while (!ring_.try_push(trade, &position)) {
+        if (!running_.load(std::memory_order_acquire)) {
+            dropped_.fetch_add(1, std::memory_order_relaxed);
+            return 0;
+        }
+        std::this_thread::yield();
+    }
+    return position + 1;
+}
+
+void SettlementPipeline::wait_settled(uint64_t sequence) const {
+    while (settled_sequence() < sequence && is_running()) {
+        std::this_thread::yield();
+    }
+}
+
+// =============================================================================
+// Consumer Side
+// =============================================================================
+
+size_t SettlementPipeline::drain() {
+    size_t total = 0;
+    while (size_t count = settle_batch()) {
+        total += count;
+    }
+    return total;
+}
+
+size_t SettlementPipeline::settle_batch() {
+    const size_t count = ring_.pop_bulk(batch_.begin(), config_.max_batch);
+    if (count == 0) {
+        return 0;
+    }
+    TraceSpan span(TracePoint::Settlement, count);
+
+    if (config_.net_fills) {
+        net(count);
+    } else {
+        settlements_.clear();
+        for (size_t i = 0; i < count; ++i) {
+            settlements_.push_back(settlement_from_trade(batch_[i], resolver_));
+        }
+    }
+
+    // Whole batch first; if the vault refuses it, nothing was applied, so
+    // retry one settlement at a time to isolate the offending accounts
+    int32_t result = vault_.pre_check_fills(settlements_);
+    if (result == errors::OK) {
+        result = apply(settlements_);
+    }
+    if (result == errors::OK) {
+        settlements_applied_.fetch_add(settlements_.size(), std::memory_order_relaxed);
+    } else {
+        for (const LXSettlement& settlement : settlements_) {
+            single_[0] = settlement;
+            int32_t single_result = vault_.pre_check_fills(single_);
+            if (single_result == errors::OK) {
+                single_result = apply(single_);
+            }
+            if (single_result == errors::OK) {
+                settlements_applied_.fetch_add(1, std::memory_order_relaxed);
+            } else {
+                settlements_rejected_.fetch_add(1, std::memory_order_relaxed);
+                last_error_.store(single_result, std::memory_order_relaxed);
+            }
+        }
+    }
+
+    trades_settled_.fetch_add(count, std::memory_order_relaxed);
+    batches_.fetch_add(1, std::memory_order_relaxed);
+    settled_.store(ring_.consumed(), std::memory_order_release);
+    return count;
+}
+
+int32_t SettlementPipeline::apply(const std::vector<LXSettlement>& settlements) {
+    return config_.net_accounts ? vault_.apply_fills_netted(settlements) : vault_.apply_fills(settlements);
+}
+
+void SettlementPipeline::net(size_t count) {
+    const Trade* trades = batch_.data();
+    auto key = [](const Trade& trade) {
+        return std::make_tuple(trade.symbol_id, trade.seller_account_id,
+                               trade.buyer_account_id, trade.aggressor_side);
+    };
+
+    // Group equal keys in place; sort rather than hash so the batch needs
+    // no extra storage
+    std::sort(batch_.begin(), batch_.begin() + count,
+                     [&key](const Trade& a, const Trade& b) { return key(a) < key(b); });
+
+    settlements_.clear();
+    size_t i = 0;
+    while (i < count) {
+        Trade merged = trades[i];
+        I128 notional = static_cast<I128>(trades[i].quantity) * trades[i].price;
+        size_t j = i + 1;
+        for (; j < count && key(trades[j]) == key(trades[i]); ++j) {
+            merged.quantity += trades[j].quantity;
+            notional += static_cast<I128>(trades[j].quantity) * trades[j].price;
+        }
+
+        // Volume-weighted price in engine units, so the fee and position
+        // math sees the same notional as the individual fills
+        if (merged.quantity > 0) {
+            merged.price = static_cast<Price>(notional / merged.quantity);
+        }
+        settlements_.push_back(settlement_from_trade(merged, resolver_));
+        i = j;
+    }
+}
+
+// =============================================================================
+// Statistics
+// =============================================================================
+
+SettlementPipeline::Stats SettlementPipeline::get_stats() const {
+    return Stats{
+        trades_settled_.load(std::memory_order_relaxed),
+        settlements_applied_.load(std::memory_order_relaxed),
+        settlements_rejected_.load(std::memory_order_relaxed),
+        batches_.load(std::memory_order_relaxed),
+        backpressure_waits_.load(std::memory_order_relaxed),
+        dropped_.load(std::memory_order_relaxed),
+        last_error_.load(std::memory_order_relaxed)
+    };
+}
+
+} // namespace lux
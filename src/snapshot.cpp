@@ -0,0 +1,228 @@
+// =============================================================================
+// snapshot.cpp - Binary snapshot files
+// =============================================================================
+
+#include "lux/snapshot.hpp"
+#include <cstdio>
+#include <cstring>
+
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+
+namespace lux {
+
+namespace {
+
+constexpr uint64_t SNAPSHOT_MAGIC = 0x4c5558534e415031ull;  // "LUXSNAP1"
+constexpr uint32_t SNAPSHOT_VERSION = 2;        // 2: per-section checksums
+constexpr uint32_t SNAPSHOT_VERSION_UNCHECKED = 1;
+constexpr size_t SNAPSHOT_ALIGN = 16;
+
+struct FileHeader {
+    uint64_t magic;
+    uint32_t version;
+    uint32_t reserved;
+    uint64_t section_count;
+    uint64_t total_bytes;
+};
+
+struct SectionHeader {
+    uint32_t kind;
+    uint32_t record_size;
+    uint64_t meta_size;
+    uint64_t count;
+    uint64_t checksum;      // Of the meta block and records (version 2)
+};
+
+constexpr size_t align_up(size_t n) {
+    return (n + SNAPSHOT_ALIGN - 1) & ~(SNAPSHOT_ALIGN - 1);
+}
+
+// 64-bit multiply-xorshift over whole words, then the tail bytes. Not
+// cryptographic: it catches truncation, bit rot and stray writes.
+uint64_t checksum(uint64_t hash, const void* data, size_t size) {
+    constexpr uint64_t PRIME = 0x9E3779B97F4A7C15ull;
+    const auto* bytes = static_cast<const uint8_t*>(data);
+    size_t i = 0;
+    for (; i + sizeof(uint64_t) <= size; i += sizeof(uint64_t)) {
+        uint64_t word;
+        std::memcpy(&word, bytes + i, sizeof(word));
+        hash = (hash ^ word) * PRIME;
+        hash ^= hash >> 29;
+    }
+    for (; i < size; ++i) {
+        hash = (hash ^ bytes[i]) * PRIME;
+    }
+    return hash ^ size;
+}
+
+uint64_t section_checksum(const void* meta, size_t meta_size, const void* records, size_t records_bytes) {
+    return checksum(checksum(SNAPSHOT_MAGIC, meta, meta_size), records, records_bytes);
+}
+
+static_assert(sizeof(FileHeader) % SNAPSHOT_ALIGN == 0, "file header must keep alignment");
+static_assert(sizeof(SectionHeader) % SNAPSHOT_ALIGN == 0, "section header must keep alignment");
+
+} // namespace
+
+// =============================================================================
+// SnapshotWriter
+// =============================================================================
+
+void SnapshotWriter::add_section(SnapshotSectionKind kind, const void* meta, size_t meta_size,
+                                 const void* records, size_t record_size, size_t count) {
+    if (buffer_.empty()) {
+        buffer_.resize(sizeof(FileHeader));
+    }
+
+    SectionHeader header{};
+    header.kind = static_cast<uint32_t>(kind);
+    header.record_size = static_cast<uint32_t>(record_size);
+    header.meta_size = meta_size;
+    header.count = count;
+
+    const size_t start = buffer_.size();
+    const size_t meta_at = start + sizeof(SectionHeader);
+    const size_t records_at = align_up(meta_at + meta_size);
+    const size_t end = align_up(records_at + record_size * count);
+    buffer_.resize(end);
+
+    if (meta_size > 0) {
+        std::memcpy(buffer_.data() + meta_at, meta, meta_size);
+    }
+    if (count > 0) {
+        std::memcpy(buffer_.data() + records_at, records, record_size * count);
+    }
+    header.checksum = section_checksum(buffer_.data() + meta_at, meta_size,
+                                       buffer_.data() + records_at, record_size * count);
+    std::memcpy(buffer_.data() + start, &header, sizeof(header));
+    ++section_count_;
+}
+
+bool SnapshotWriter::finish(const std::string& path) {
+    if (buffer_.empty()) {
+        buffer_.resize(sizeof(FileHeader));
+    }
+    FileHeader header{SNAPSHOT_MAGIC, SNAPSHOT_VERSION, 0, section_count_, buffer_.size()};
+    std::memcpy(buffer_.data(), &header, sizeof(header));
+
+    const std::string tmp = path + ".tmp";
+    int fd = ::open(tmp.c_str(), O_WRONLY | O_CREAT | O_TRUNC, 0644);
+    if (fd < 0) {
+        return false;
+    }
+
+    const uint8_t* data = buffer_.data();
+    size_t remaining = buffer_.size();
+    while (remaining > 0) {
+        ssize_t written = ::write(fd, data, remaining);
+        if (written <= 0) {
+            ::close(fd);
+            std::remove(tmp.c_str());
+            return false;
+        }
+        data += written;
+        remaining -= static_cast<size_t>(written);
+    }
+
+    bool ok = ::fsync(fd) == 0;
+    ok = (::close(fd) == 0) && ok;
+    if (!ok || std::rename(tmp.c_str(), path.c_str()) != 0) {
+        std::remove(tmp.c_str());
+        return false;
+    }
+    return true;
+}
+
+// =============================================================================
+// SnapshotReader
+// =============================================================================
+
+std::unique_ptr<SnapshotReader> SnapshotReader::open(const std::string& path) {
+    int fd = ::open(path.c_str(), O_RDONLY);
+    if (fd < 0) {
+        return nullptr;
+    }
+
+    struct stat st{};
+    if (::fstat(fd, &st) != 0 || static_cast<size_t>(st.st_size) < sizeof(FileHeader)) {
+        ::close(fd);
+        return nullptr;
+    }
+
+    const size_t bytes = static_cast<size_t>(st.st_size);
+    void* mapping = ::mmap(nullptr, bytes, PROT_READ, MAP_PRIVATE, fd, 0);
+    ::close(fd);
+    if (mapping == MAP_FAILED) {
+        return nullptr;
+    }
+
+    std::unique_ptr<SnapshotReader> reader(new SnapshotReader());
+    reader->mapping_ = mapping;
+    reader->mapped_bytes_ = bytes;
+
+    const auto* base = static_cast<const uint8_t*>(mapping);
+    FileHeader header;
+    std::memcpy(&header, base, sizeof(header));
+    if (header.magic != SNAPSHOT_MAGIC || header.total_bytes != bytes ||
+        (header.version != SNAPSHOT_VERSION && header.version != SNAPSHOT_VERSION_UNCHECKED)) {
+        return nullptr;
+    }
+    // Every section needs at least its header, which bounds the count
+    if (header.section_count > (bytes - sizeof(FileHeader)) / sizeof(SectionHeader)) {
+        return nullptr;
+    }
+
+    // Offsets are checked against the file size before each addition, so
+    // no sum or product below can wrap
+    size_t offset = sizeof(FileHeader);
+    reader->sections_.reserve(header.section_count);
+    for (uint64_t i = 0; i < header.section_count; ++i) {
+        SectionHeader section;
+        if (bytes - offset < sizeof(section)) {
+            return nullptr;
+        }
+        std::memcpy(&section, base + offset, sizeof(section));
+
+        const size_t meta_at = offset + sizeof(SectionHeader);
+        if (section.meta_size > bytes - meta_at) {
+            return nullptr;
+        }
+        const size_t records_at = align_up(meta_at + section.meta_size);
+        if (records_at > bytes) {
+            return nullptr;
+        }
+        const size_t room = bytes - records_at;
+        if (section.count > 0 && (section.record_size == 0 || section.count > room / section.record_size)) {
+            return nullptr;
+        }
+        const size_t records_bytes = section.record_size * section.count;
+        const size_t end = align_up(records_at + records_bytes);
+        if (end > bytes) {
+            return nullptr;
+        }
+        if (header.version != SNAPSHOT_VERSION_UNCHECKED &&
+            section.checksum != section_checksum(base + meta_at, section.meta_size,
+                                                 base + records_at, records_bytes)) {
+            return nullptr;
+        }
+
+        reader->sections_.push_back(SnapshotSection{
+            static_cast<SnapshotSectionKind>(section.kind),
+            base + meta_at, section.meta_size,
+            base + records_at, section.record_size, section.count
+        });
+        offset = end;
+    }
+    return reader;
+}
+
+SnapshotReader::~SnapshotReader() {
+    if (mapping_) {
+        ::munmap(mapping_, mapped_bytes_);
+    }
+}
+
+} // namespace lux
@@ -0,0 +1,97 @@
+// =============================================================================
+// task_pool.cpp - Fork-join worker pool
+// =============================================================================
+
+#include "lux/task_pool.hpp"
+#include <algorithm>
+
+namespace lux {
+
+TaskPool::TaskPool(size_t threads) {
+    if (threads == 0) {
+        unsigned hw = std::thread::hardware_concurrency();
+        threads = hw > 1 ? hw - 1 : 0;
+    }
+    threads_.reserve(threads);
+    for (size_t i = 0; i < threads; ++i) {
+        threads_.emplace_back(&TaskPool::worker_loop, this);
+    }
+}
+
+TaskPool::~TaskPool() {
+    {
+        std::lock_guard lock(mutex_);
+        stopping_ = true;
+    }
+    work_cv_.notify_all();
+    for (auto& thread : threads_) {
+        thread.join();
+    }
+}
+
+void TaskPool::parallel_for(size_t count, const std::function<void(size_t)>& fn) {
+    if (count == 0) {
+        return;
+    }
+
+    // Small jobs or no helpers: run inline
+    if (count == 1 || threads_.empty()) {
+        for (size_t i = 0; i < count; ++i) {
+            fn(i);
+        }
+        return;
+    }
+
+    std::lock_guard submit_lock(submit_mutex_);
+    {
+        std::lock_guard lock(mutex_);
+        fn_ = &fn;
+        count_ = count;
+        next_.store(0, std::memory_order_relaxed);
+        active_workers_ = threads_.size();
+        ++generation_;
+    }
+    work_cv_.notify_all();
+
+    run_items();
+
+    // Wait for helpers to finish their claimed items
+    std::unique_lock lock(mutex_);
+    done_cv_.wait(lock, [this] { return active_workers_ == 0; });
+    fn_ = nullptr;
+}
+
+void TaskPool::run_items() {
+    while (true) {
+        size_t i = next_.fetch_add(1, std::memory_order_relaxed);
+        if (i >= count_) {
+            return;
+        }
+        (*fn_)(i);
+    }
+}
+
+void TaskPool::worker_loop() {
+    uint64_t seen_generation = 0;
+    while (true) {
+        {
+            std::unique_lock lock(mutex_);
+            work_cv_.wait(lock, [&] { return stopping_ || generation_ != seen_generation; });
+            if (stopping_) {
+                return;
+            }
+            seen_generation = generation_;
+        }
+
+        run_items();
+
+        {
+            std::lock_guard lock(mutex_);
+            if (--active_workers_ == 0) {
+                done_cv_.notify_one();
+            }
+        }
+    }
+}
+
+} // namespace lux
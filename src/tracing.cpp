@@ -0,0 +1,306 @@
+// =============================================================================
+// tracing.cpp - Per-thread span histograms, event trace and exporters
+// =============================================================================
+
+#include "lux/tracing.hpp"
+#include <algorithm>
+#include <cmath>
+#include <cstdio>
+#include <memory>
+#include <mutex>
+
+namespace lux {
+
+namespace {
+
+// Binary dump, native byte order:
+//   char[4]  "LXTR"
+//   uint32   version
+//   double   nanoseconds per tick
+//   uint32   trace points, uint32 buckets per histogram
+//   per point: uint64 count, sum_ticks, max_ticks, buckets[]
+//   uint64   event count, then TraceEvent records (32 bytes each)
+constexpr char TRACE_MAGIC[4] = {'L', 'X', 'T', 'R'};
+constexpr uint32_t TRACE_VERSION = 1;
+
+static_assert(sizeof(TraceEvent) == 32, "TraceEvent is part of the binary trace format");
+
+struct ThreadTrace {
+    uint32_t thread = 0;
+    std::array<HdrHistogram, TRACE_POINTS> histograms;
+
+    // Event ring, allocated by the owning thread on first use and published
+    // through `ring`; `mask` is written before the pointer is
+    std::unique_ptr<TraceEvent[]> storage;
+    std::atomic<TraceEvent*> ring{nullptr};
+    size_t mask = 0;
+    std::atomic<uint64_t> head{0};
+};
+
+// Thread blocks are never freed: a thread's spans stay exportable after it
+// exits, and a thread_local pointer can't dangle. Leaked for the same reason,
+// so threads that outlive static destruction still record safely.
+struct Registry {
+    std::mutex mutex;
+    std::vector<std::unique_ptr<ThreadTrace>> threads;
+    std::atomic<double> ns_per_tick{1.0};
+    bool calibrated = false;
+};
+
+Registry& registry() {
+    static Registry* instance = new Registry();
+    return *instance;
+}
+
+ThreadTrace& local_trace() {
+    thread_local ThreadTrace* local = nullptr;
+    if (!local) {
+        Registry& reg = registry();
+        std::lock_guard<std::mutex> lock(reg.mutex);
+        reg.threads.push_back(std::make_unique<ThreadTrace>());
+        local = reg.threads.back().get();
+        local->thread = static_cast<uint32_t>(reg.threads.size() - 1);
+    }
+    return *local;
+}
+
+void append_number(std::string& out, double value) {
+    char buffer[32];
+    std::snprintf(buffer, sizeof(buffer), "%.9g", value);
+    out += buffer;
+}
+
+} // namespace
+
+const char* trace_point_name(TracePoint point) {
+    switch (point) {
+        case TracePoint::OrderIngress: return "order_ingress";
+        case TracePoint::Matching: return "matching";
+        case TracePoint::Settlement: return "settlement";
+        case TracePoint::VaultApply: return "vault_apply";
+        case TracePoint::FeedUpdate: return "feed_update";
+        case TracePoint::Count: break;
+    }
+    return "unknown";
+}
+
+// =============================================================================
+// TraceSummary
+// =============================================================================
+
+double TraceSummary::quantile_ns(double q) const {
+    if (count == 0) {
+        return 0;
+    }
+    uint64_t rank = static_cast<uint64_t>(std::ceil(q * static_cast<double>(count)));
+    rank = rank == 0 ? 1 : rank;
+    uint64_t seen = 0;
+    uint64_t limit = max_ticks;
+    for (size_t i = 0; i < buckets.size(); ++i) {
+        seen += buckets[i];
+        if (seen >= rank) {
+            limit = std::min(HdrHistogram::bucket_lower(i + 1), max_ticks);
+            break;
+        }
+    }
+    return static_cast<double>(limit) * Tracer::ns_per_tick();
+}
+
+double TraceSummary::mean_ns() const {
+    if (count == 0) {
+        return 0;
+    }
+    return static_cast<double>(sum_ticks) / static_cast<double>(count) * Tracer::ns_per_tick();
+}
+
+// =============================================================================
+// Control
+// =============================================================================
+
+void Tracer::enable(size_t event_capacity) {
+    Registry& reg = registry();
+    {
+        std::lock_guard<std::mutex> lock(reg.mutex);
+        if (!reg.calibrated) {
+            reg.ns_per_tick.store(cpu_tick_ns(), std::memory_order_relaxed);
+            reg.calibrated = true;
+        }
+    }
+    size_t capacity = 0;
+    if (event_capacity > 0) {
+        capacity = 1;
+        while (capacity < event_capacity) {
+            capacity <<= 1;
+        }
+    }
+    event_capacity_.store(capacity, std::memory_order_relaxed);
+    enabled_.store(true, std::memory_order_relaxed);
+}
+
+void Tracer::disable() {
+    enabled_.store(false, std::memory_order_relaxed);
+}
+
+double Tracer::ns_per_tick() {
+    return registry().ns_per_tick.load(std::memory_order_relaxed);
+}
+
+// =============================================================================
+// Recording
+// =============================================================================
+
+void Tracer::record(TracePoint point, uint64_t start_ticks, uint64_t end_ticks, uint64_t id) {
+    ThreadTrace& local = local_trace();
+    const uint64_t ticks = end_ticks > start_ticks ? end_ticks - start_ticks : 0;
+    local.histograms[static_cast<size_t>(point)].record(ticks);
+
+    const size_t capacity = event_capacity_.load(std::memory_order_relaxed);
+    if (capacity == 0) {
+        return;
+    }
+    TraceEvent* ring = local.ring.load(std::memory_order_relaxed);
+    if (!ring) {
+        local.storage = std::make_unique<TraceEvent[]>(capacity);
+        local.mask = capacity - 1;
+        ring = local.storage.get();
+        local.ring.store(ring, std::memory_order_release);
+    }
+    const uint64_t head = local.head.load(std::memory_order_relaxed);
+    ring[head & local.mask] = TraceEvent{start_ticks, ticks, id, local.thread, point, {}};
+    local.head.store(head + 1, std::memory_order_release);
+}
+
+// =============================================================================
+// Export
+// =============================================================================
+
+TraceSummary Tracer::summary(TracePoint point) {
+    TraceSummary result;
+    result.buckets.assign(HdrHistogram::BUCKETS, 0);
+
+    Registry& reg = registry();
+    std::lock_guard<std::mutex> lock(reg.mutex);
+    for (const auto& thread : reg.threads) {
+        const HdrHistogram& histogram = thread->histograms[static_cast<size_t>(point)];
+        if (histogram.count() == 0) {
+            continue;
+        }
+        result.count += histogram.count();
+        result.sum_ticks += histogram.sum();
+        result.max_ticks = std::max(result.max_ticks, histogram.max());
+        for (size_t i = 0; i < HdrHistogram::BUCKETS; ++i) {
+            result.buckets[i] += histogram.bucket(i);
+        }
+    }
+    return result;
+}
+
+std::vector<TraceEvent> Tracer::events() {
+    std::vector<TraceEvent> result;
+    Registry& reg = registry();
+    {
+        std::lock_guard<std::mutex> lock(reg.mutex);
+        for (const auto& thread : reg.threads) {
+            const TraceEvent* ring = thread->ring.load(std::memory_order_acquire);
+            if (!ring) {
+                continue;
+            }
+            const uint64_t head = thread->head.load(std::memory_order_acquire);
+            const uint64_t kept = std::min<uint64_t>(head, thread->mask + 1);
+            for (uint64_t i = head - kept; i < head; ++i) {
+                result.push_back(ring[i & thread->mask]);
+            }
+        }
+    }
+    std::sort(result.begin(), result.end(), [](const TraceEvent& a, const TraceEvent& b) {
+        return a.start_ticks < b.start_ticks;
+    });
+    return result;
+}
+
+std::string Tracer::prometheus() {
+    const double seconds_per_tick = ns_per_tick() * 1e-9;
+    std::string out;
+    out += "# HELP luxdex_trace_span_seconds Latency of traced hot-path spans\n";
+    out += "# TYPE luxdex_trace_span_seconds histogram\n";
+
+    for (size_t p = 0; p < TRACE_POINTS; ++p) {
+        const TraceSummary summary = Tracer::summary(static_cast<TracePoint>(p));
+        const std::string label = std::string("point=\"") +
+            trace_point_name(static_cast<TracePoint>(p)) + "\"";
+
+        // Bucket 2^k ticks covers every HDR bucket below index (k-4) << 5
+        uint64_t cumulative = 0;
+        size_t next = 0;
+        for (unsigned k = HdrHistogram::SUB_BITS; k <= HdrHistogram::MAX_BITS; ++k) {
+            const uint64_t bound = uint64_t{1} << k;
+            if (summary.count == 0) {
+                break;
+            }
+            const size_t end = size_t{k - HdrHistogram::SUB_BITS + 1} << HdrHistogram::SUB_BITS;
+            for (; next < end; ++next) {
+                cumulative += summary.buckets[next];
+            }
+            out += "luxdex_trace_span_seconds_bucket{" + label + ",le=\"";
+            append_number(out, static_cast<double>(bound) * seconds_per_tick);
+            out += "\"} " + std::to_string(cumulative) + "\n";
+            if (bound > summary.max_ticks) {
+                break;
+            }
+        }
+        out += "luxdex_trace_span_seconds_bucket{" + label + ",le=\"+Inf\"} " +
+               std::to_string(summary.count) + "\n";
+        out += "luxdex_trace_span_seconds_sum{" + label + "} ";
+        append_number(out, static_cast<double>(summary.sum_ticks) * seconds_per_tick);
+        out += "\n";
+        out += "luxdex_trace_span_seconds_count{" + label + "} " +
+               std::to_string(summary.count) + "\n";
+    }
+    return out;
+}
+
+bool Tracer::write_binary(const std::string& path) {
+    std::FILE* file = std::fopen(path.c_str(), "wb");
+    if (!file) {
+        return false;
+    }
+
+    bool ok = std::fwrite(TRACE_MAGIC, sizeof(TRACE_MAGIC), 1, file) == 1;
+    const uint32_t version = TRACE_VERSION;
+    const double tick_ns = ns_per_tick();
+    const uint32_t points = static_cast<uint32_t>(TRACE_POINTS);
+    const uint32_t buckets = static_cast<uint32_t>(HdrHistogram::BUCKETS);
+    ok = ok && std::fwrite(&version, sizeof(version), 1, file) == 1;
+    ok = ok && std::fwrite(&tick_ns, sizeof(tick_ns), 1, file) == 1;
+    ok = ok && std::fwrite(&points, sizeof(points), 1, file) == 1;
+    ok = ok && std::fwrite(&buckets, sizeof(buckets), 1, file) == 1;
+
+    for (size_t p = 0; ok && p < TRACE_POINTS; ++p) {
+        const TraceSummary summary = Tracer::summary(static_cast<TracePoint>(p));
+        const uint64_t totals[3] = {summary.count, summary.sum_ticks, summary.max_ticks};
+        ok = std::fwrite(totals, sizeof(totals), 1, file) == 1 &&
+             std::fwrite(summary.buckets.data(), sizeof(uint64_t),
+                         summary.buckets.size(), file) == summary.buckets.size();
+    }
+
+    const std::vector<TraceEvent> trace = events();
+    const uint64_t event_count = trace.size();
+    ok = ok && std::fwrite(&event_count, sizeof(event_count), 1, file) == 1;
+    ok = ok && (trace.empty() ||
+                std::fwrite(trace.data(), sizeof(TraceEvent), trace.size(), file) == trace.size());
+
+    return std::fclose(file) == 0 && ok;
+}
+
+void Tracer::reset() {
+    Registry& reg = registry();
+    std::lock_guard<std::mutex> lock(reg.mutex);
+    for (const auto& thread : reg.threads) {
+        for (auto& histogram : thread->histograms) {
+            histogram.reset();
+        }
+        thread->head.store(0, std::memory_order_relaxed);
+    }
+}
+
+} // namespace lux
@@ -0,0 +1,132 @@
+// =============================================================================
+// trigger_book.cpp - Price-Indexed Stop / Take-Profit Orders
+// =============================================================================
+
+#include "lux/trigger_book.hpp"
+
+namespace lux {
+
+LXOrder TriggerBook::fired_order(const LXOrder& order) {
+    LXOrder fired = order;
+    switch (order.kind) {
+        case OrderKind::STOP_MARKET:
+        case OrderKind::TAKE_MARKET:
+            // Whatever does not fill at once is cancelled, not rested at 0
+            fired.kind = OrderKind::MARKET;
+            fired.tif = TIF::IOC;
+            break;
+        default:
+            fired.kind = OrderKind::LIMIT;
+            break;
+    }
+    fired.trigger_px_x18 = 0;
+    return fired;
+}
+
+bool TriggerBook::add(const TriggerOrder& order) {
+    const size_t type = static_cast<size_t>(order.price_type);
+    if (type >= PRICE_TYPES) {
+        return false;
+    }
+
+    std::lock_guard lock(mutex_);
+    Reference& ref = references_[type];
+    const I128 trigger = order.order.trigger_px_x18;
+    const bool rising = fires_on_rise(order.order);
+
+    if (ref.last_price) {
+        const bool crossed = rising ? *ref.last_price >= trigger : *ref.last_price <= trigger;
+        if (crossed) {
+            return false;
+        }
+    }
+
+    Location location{static_cast<uint8_t>(type), rising, {}, {}};
+    if (rising) {
+        location.rising_it = ref.rising.emplace(trigger, order);
+    } else {
+        location.falling_it = ref.falling.emplace(trigger, order);
+    }
+    index_[order.oid] = location;
+    return true;
+}
+
+std::optional<TriggerOrder> TriggerBook::cancel(uint64_t oid) {
+    std::lock_guard lock(mutex_);
+    auto it = index_.find(oid);
+    if (it == index_.end()) {
+        return std::nullopt;
+    }
+
+    const Location& location = it->second;
+    Reference& ref = references_[location.price_type];
+    TriggerOrder order;
+    if (location.rising) {
+        order = location.rising_it->second;
+        ref.rising.erase(location.rising_it);
+    } else {
+        order = location.falling_it->second;
+        ref.falling.erase(location.falling_it);
+    }
+    index_.erase(it);
+    return order;
+}
+
+template<typename Map>
+size_t TriggerBook::take_crossed(Map& map, I128 price_x18, std::vector<TriggerOrder>& out,
+                                 std::unordered_map<uint64_t, Location>& index) {
+    // Crossed triggers form the prefix up to the first key past the price
+    auto end = map.upper_bound(price_x18);
+    size_t fired = 0;
+    for (auto it = map.begin(); it != end; ++it) {
+        out.push_back(it->second);
+        index.erase(it->second.oid);
+        ++fired;
+    }
+    map.erase(map.begin(), end);
+    return fired;
+}
+
+size_t TriggerBook::on_price(PriceType type, I128 price_x18, std::vector<TriggerOrder>& out) {
+    const size_t slot = static_cast<size_t>(type);
+    if (slot >= PRICE_TYPES) {
+        return 0;
+    }
+
+    std::lock_guard lock(mutex_);
+    Reference& ref = references_[slot];
+    ref.last_price = price_x18;
+
+    // Lower triggers fire first on a rise, higher ones first on a fall
+    size_t fired = take_crossed(ref.rising, price_x18, out, index_);
+    fired += take_crossed(ref.falling, price_x18, out, index_);
+    return fired;
+}
+
+std::optional<I128> TriggerBook::last_price(PriceType type) const {
+    const size_t slot = static_cast<size_t>(type);
+    if (slot >= PRICE_TYPES) {
+        return std::nullopt;
+    }
+    std::lock_guard lock(mutex_);
+    return references_[slot].last_price;
+}
+
+size_t TriggerBook::size() const {
+    std::lock_guard lock(mutex_);
+    return index_.size();
+}
+
+void TriggerBook::collect(std::vector<TriggerOrder>& out) const {
+    std::lock_guard lock(mutex_);
+    for (const Reference& ref : references_) {
+        for (const auto& [_, order] : ref.rising) {
+            out.push_back(order);
+        }
+        for (const auto& [_, order] : ref.falling) {
+            out.push_back(order);
+        }
+    }
+}
+
+} // namespace lux
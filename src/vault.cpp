@@ -3,8 +3,13 @@
 // =============================================================================
 
 #include "lux/vault.hpp"
+#include "lux/fixed_point.hpp"
+#include "lux/task_pool.hpp"
+#include "lux/tracing.hpp"
 #include <chrono>
 #include <algorithm>
+#include <cmath>
+#include <limits>
 
 namespace lux {
 
@@ -12,7 +17,41 @@ namespace lux {
 // Constructor
 // =============================================================================
 
-LXVault::LXVault() = default;
+template<size_t... I>
+LXVault::Shards LXVault::make_shards(std::pmr::memory_resource* upstream, std::index_sequence<I...>) {
+    // Shards cannot move; each element is initialized in place
+    return {{(static_cast<void>(I), AccountShard(upstream))...}};
+}
+
+LXVault::LXVault()
+    : shards_(make_shards(std::pmr::new_delete_resource(), std::make_index_sequence<ACCOUNT_SHARDS>{})) {}
+
+LXVault::LXVault(std::shared_ptr<NodeMemory> memory)
+    : memory_(std::move(memory))
+    , shards_(make_shards(memory_->resource(), std::make_index_sequence<ACCOUNT_SHARDS>{})) {}
+
+LXVault::ShardLocks::ShardLocks(const LXVault& vault, uint64_t mask, bool exclusive)
+    : vault_(vault), mask_(mask), exclusive_(exclusive) {
+    for (size_t i = 0; i < ACCOUNT_SHARDS; ++i) {
+        if (!(mask_ >> i & 1)) continue;
+        if (exclusive_) {
+            vault_.shards_[i].mutex.lock();
+        } else {
+            vault_.shards_[i].mutex.lock_shared();
+        }
+    }
+}
+
+LXVault::ShardLocks::~ShardLocks() {
+    for (size_t i = ACCOUNT_SHARDS; i-- > 0;) {
+        if (!(mask_ >> i & 1)) continue;
+        if (exclusive_) {
+            vault_.shards_[i].mutex.unlock();
+        } else {
+            vault_.shards_[i].mutex.unlock_shared();
+        }
+    }
+}
 
 // =============================================================================
 // Market Management
@@ -26,6 +65,9 @@ int32_t LXVault::create_market(const MarketConfig& config) {
     }
 
     markets_[config.market_id] = config;
+    SeqLock<MarketLimits>& limits = market_limit_slots_[config.market_id];
+    limits.store(MarketLimits{config.initial_margin_x18, config.max_position_size_x18});
+    market_limits_.insert(config.market_id, &limits);
 
     // Initialize funding state
     std::unique_lock funding_lock(funding_mutex_);
@@ -52,6 +94,22 @@ int32_t LXVault::update_market(const MarketConfig& config) {
     }
 
     it->second = config;
+    market_limit_slots_.at(config.market_id)
+        .store(MarketLimits{config.initial_margin_x18, config.max_position_size_x18});
+    lock.unlock();
+
+    // New margin rates reprice every open position in the market
+    for (AccountShard& shard : shards_) {
+        std::unique_lock accounts_lock(shard.mutex);
+        auto marks_it = shard.marks.find(config.market_id);
+        if (marks_it == shard.marks.end()) continue;
+
+        MarketMarks& marks = marks_it->second;
+        for (size_t slot = 0; slot < marks.positions.size(); ++slot) {
+            set_slot_margins(marks, slot, &config);
+            refresh_risk(shard, *marks.accounts[slot]);
+        }
+    }
     return errors::OK;
 }
 
@@ -79,14 +137,16 @@ int32_t LXVault::deposit(const LXAccount& account, const Currency& token, I128 a
     uint64_t currency_hash = 0;
     for (auto b : token.addr) currency_hash = currency_hash * 31 + b;
 
-    std::unique_lock lock(accounts_mutex_);
+    AccountShard& shard = shard_of(account);
+    std::unique_lock lock(shard.mutex);
     AccountState* state = get_or_create_account(account);
-    state->balances[currency_hash] += amount_x18;
+    adjust_balance(*state, currency_hash, amount_x18);
     state->last_update_time = static_cast<uint64_t>(
         std::chrono::duration_cast<std::chrono::seconds>(
             std::chrono::system_clock::now().time_since_epoch()
         ).count()
     );
+    refresh_risk(shard, *state);
 
     return errors::OK;
 }
@@ -101,10 +161,11 @@ int32_t LXVault::withdraw(const LXAccount& account, const Currency& token, I128
 
     // FIX: Hold lock through entire operation to prevent TOCTOU race.
     // Previously margin check was done without lock, then lock acquired.
-    std::unique_lock accounts_lock(accounts_mutex_);
-    std::shared_lock markets_lock(markets_mutex_);
+    AccountShard& shard = shard_of(account);
+    std::unique_lock accounts_lock(shard.mutex);
 
     AccountState* state = get_or_create_account(account);
+    settle_funding(shard, *state);
 
     // Check balance exists
     auto it = state->balances.find(currency_hash);
@@ -112,30 +173,14 @@ int32_t LXVault::withdraw(const LXAccount& account, const Currency& token, I128
         return errors::INSUFFICIENT_BALANCE;
     }
 
-    // Calculate margin info inline while holding lock
-    I128 total_collateral = 0;
-    for (const auto& [hash, bal] : state->balances) {
-        total_collateral += bal;
-    }
-
-    I128 total_unrealized_pnl = 0;
-    I128 total_initial_margin = 0;
-    for (const auto& [market_id, position] : state->positions) {
-        auto config_it = markets_.find(market_id);
-        if (config_it == markets_.end()) continue;
-        total_unrealized_pnl += position.unrealized_pnl_x18;
-        total_initial_margin += calculate_initial_margin(position, config_it->second);
-    }
-
-    I128 equity = total_collateral + total_unrealized_pnl;
-    I128 free_margin = equity - total_initial_margin;
-
+    I128 free_margin = state->equity_x18() - state->initial_margin_x18;
     if (free_margin < amount_x18) {
         return errors::INSUFFICIENT_MARGIN;
     }
 
     // Perform withdrawal atomically
-    state->balances[currency_hash] -= amount_x18;
+    adjust_balance(*state, currency_hash, -amount_x18);
+    refresh_risk(shard, *state);
     state->last_update_time = static_cast<uint64_t>(
         std::chrono::duration_cast<std::chrono::seconds>(
             std::chrono::system_clock::now().time_since_epoch()
@@ -154,18 +199,21 @@ int32_t LXVault::transfer(const LXAccount& from, const LXAccount& to,
     uint64_t currency_hash = 0;
     for (auto b : token.addr) currency_hash = currency_hash * 31 + b;
 
-    std::unique_lock lock(accounts_mutex_);
+    ShardLocks locks(*this, shard_bit(from) | shard_bit(to), true);
 
     AccountState* from_state = get_or_create_account(from);
+    settle_funding(shard_of(from), *from_state);
     auto it = from_state->balances.find(currency_hash);
     if (it == from_state->balances.end() || it->second < amount_x18) {
         return errors::INSUFFICIENT_BALANCE;
     }
 
-    from_state->balances[currency_hash] -= amount_x18;
+    adjust_balance(*from_state, currency_hash, -amount_x18);
+    refresh_risk(shard_of(from), *from_state);
 
     AccountState* to_state = get_or_create_account(to);
-    to_state->balances[currency_hash] += amount_x18;
+    adjust_balance(*to_state, currency_hash, amount_x18);
+    refresh_risk(shard_of(to), *to_state);
 
     return errors::OK;
 }
@@ -174,26 +222,25 @@ I128 LXVault::get_balance(const LXAccount& account, const Currency& token) const
     uint64_t currency_hash = 0;
     for (auto b : token.addr) currency_hash = currency_hash * 31 + b;
 
-    std::shared_lock lock(accounts_mutex_);
-    const AccountState* state = get_account(account);
-    if (!state) return 0;
+    auto snapshot = account_snapshot(account);
+    if (!snapshot) return 0;
 
-    auto it = state->balances.find(currency_hash);
-    return (it != state->balances.end()) ? it->second : 0;
+    const auto& balances = snapshot->state.balances;
+    auto it = balances.find(currency_hash);
+    I128 balance = (it != balances.end()) ? it->second : 0;
+    if (currency_hash == SETTLEMENT_CURRENCY) {
+        balance -= funding_owed(*snapshot);
+    }
+    return balance;
 }
 
 I128 LXVault::total_collateral_value(const LXAccount& account) const {
-    std::shared_lock lock(accounts_mutex_);
-    const AccountState* state = get_account(account);
-    if (!state) return 0;
+    auto snapshot = account_snapshot(account);
+    if (!snapshot) return 0;
 
-    I128 total = 0;
-    for (const auto& [currency_hash, balance] : state->balances) {
-        // Simplified: assume all tokens at 1:1 USD value
-        // Production would use oracle for token prices
-        total += balance;
-    }
-    return total;
+    // Simplified: assume all tokens at 1:1 USD value
+    // Production would use oracle for token prices
+    return snapshot->state.collateral_x18 - funding_owed(*snapshot);
 }
 
 // =============================================================================
@@ -202,58 +249,48 @@ I128 LXVault::total_collateral_value(const LXAccount& account) const {
 
 int32_t LXVault::set_margin_mode(const LXAccount& account, uint32_t market_id, MarginMode mode) {
     (void)market_id;  // Could be used for per-market margin mode in the future
-    std::unique_lock lock(accounts_mutex_);
+    AccountShard& shard = shard_of(account);
+    std::unique_lock lock(shard.mutex);
     AccountState* state = get_or_create_account(account);
     state->margin_mode = mode;
+    refresh_risk(shard, *state);
     return errors::OK;
 }
 
 std::optional<AccountState> LXVault::get_account_state(const LXAccount& account) const {
-    std::shared_lock lock(accounts_mutex_);
-    const AccountState* state = get_account(account);
-    if (!state) return std::nullopt;
-    return *state;
+    auto snapshot = account_snapshot(account);
+    if (!snapshot) return std::nullopt;
+
+    // Report the copy as if unsettled funding had been paid
+    AccountState copy = snapshot->state;
+    for (auto& [market_id, position] : copy.positions) {
+        const I128 owed = funding_owed(*snapshot, market_id);
+        position.accumulated_funding_x18 -= owed;
+        copy.balances[SETTLEMENT_CURRENCY] -= owed;
+        copy.collateral_x18 -= owed;
+    }
+    return copy;
 }
 
 LXMarginInfo LXVault::get_margin_info(const LXAccount& account) const {
     LXMarginInfo info{};
 
-    // Acquire both locks upfront in consistent order
-    std::shared_lock accounts_lock(accounts_mutex_);
-    std::shared_lock markets_lock(markets_mutex_);
-
-    const AccountState* state = get_account(account);
-    if (!state) return info;
-
-    // Calculate total collateral
-    info.total_collateral_x18 = 0;
-    for (const auto& [currency_hash, balance] : state->balances) {
-        info.total_collateral_x18 += balance;
-    }
-
-    // Calculate used margin and unrealized PnL
-    I128 total_unrealized_pnl = 0;
-    I128 total_initial_margin = 0;
-    I128 total_maintenance_margin = 0;
-
-    for (const auto& [market_id, position] : state->positions) {
-        auto config_it = markets_.find(market_id);
-        if (config_it == markets_.end()) continue;
-
-        const MarketConfig& config = config_it->second;
-        total_unrealized_pnl += position.unrealized_pnl_x18;
-        total_initial_margin += calculate_initial_margin(position, config);
-        total_maintenance_margin += calculate_maintenance_margin(position, config);
-    }
+    // Every figure is an aggregate kept up to date on the account, less
+    // funding its positions owe but have not settled yet
+    auto snapshot = account_snapshot(account);
+    if (!snapshot) return info;
 
-    info.used_margin_x18 = total_initial_margin;
-    info.maintenance_margin_x18 = total_maintenance_margin;
+    const AccountState* state = &snapshot->state;
+    const I128 owed = funding_owed(*snapshot);
+    info.total_collateral_x18 = state->collateral_x18 - owed;
+    info.used_margin_x18 = state->initial_margin_x18;
+    info.maintenance_margin_x18 = state->maintenance_margin_x18;
 
-    I128 equity = info.total_collateral_x18 + total_unrealized_pnl;
-    info.free_margin_x18 = equity - total_initial_margin;
+    I128 equity = state->equity_x18() - owed;
+    info.free_margin_x18 = equity - state->initial_margin_x18;
 
     if (equity > 0) {
-        info.margin_ratio_x18 = x18::div(total_maintenance_margin, equity);
+        info.margin_ratio_x18 = x18::div(state->maintenance_margin_x18, equity);
     } else {
         info.margin_ratio_x18 = X18_ONE * 100; // 10000% if no equity
     }
@@ -264,22 +301,11 @@ LXMarginInfo LXVault::get_margin_info(const LXAccount& account) const {
 }
 
 I128 LXVault::account_equity_x18(const LXAccount& account) const {
-    // Equity = collateral + unrealized PnL
-    std::shared_lock lock(accounts_mutex_);
-    const AccountState* state = get_account(account);
-    if (!state) return 0;
+    // Equity = collateral + unrealized PnL - unsettled funding
+    auto snapshot = account_snapshot(account);
+    if (!snapshot) return 0;
 
-    I128 total_collateral = 0;
-    for (const auto& [currency_hash, balance] : state->balances) {
-        total_collateral += balance;
-    }
-
-    I128 unrealized_pnl = 0;
-    for (const auto& [market_id, position] : state->positions) {
-        unrealized_pnl += position.unrealized_pnl_x18;
-    }
-
-    return total_collateral + unrealized_pnl;
+    return snapshot->state.equity_x18() - funding_owed(*snapshot);
 }
 
 I128 LXVault::margin_ratio_x18(const LXAccount& account) const {
@@ -307,27 +333,35 @@ int32_t LXVault::remove_margin(const LXAccount& account, uint32_t market_id, I12
 // =============================================================================
 
 std::optional<LXPosition> LXVault::get_position(const LXAccount& account, uint32_t market_id) const {
-    std::shared_lock lock(accounts_mutex_);
-    const AccountState* state = get_account(account);
-    if (!state) return std::nullopt;
-
-    auto it = state->positions.find(market_id);
-    if (it == state->positions.end()) return std::nullopt;
-    return it->second;
+    auto snapshot = account_snapshot(account);
+    if (!snapshot) return std::nullopt;
+
+    const auto& held = snapshot->state.positions;
+    auto it = held.find(market_id);
+    if (it == held.end()) return std::nullopt;
+    LXPosition position = it->second;
+    position.accumulated_funding_x18 -= funding_owed(*snapshot, market_id);
+    return position;
 }
 
 std::vector<LXPosition> LXVault::get_all_positions(const LXAccount& account) const {
     std::vector<LXPosition> positions;
+    get_all_positions(account, positions);
+    return positions;
+}
 
-    std::shared_lock lock(accounts_mutex_);
-    const AccountState* state = get_account(account);
-    if (!state) return positions;
+size_t LXVault::get_all_positions(const LXAccount& account, std::vector<LXPosition>& out) const {
+    out.clear();
 
-    for (const auto& [market_id, position] : state->positions) {
-        positions.push_back(position);
+    auto snapshot = account_snapshot(account);
+    if (!snapshot) return 0;
+
+    for (const auto& [market_id, position] : snapshot->state.positions) {
+        out.push_back(position);
+        out.back().accumulated_funding_x18 -= funding_owed(*snapshot, market_id);
     }
 
-    return positions;
+    return out.size();
 }
 
 // =============================================================================
@@ -335,8 +369,12 @@ std::vector<LXPosition> LXVault::get_all_positions(const LXAccount& account) con
 // =============================================================================
 
 int32_t LXVault::pre_check_fills(const std::vector<LXSettlement>& settlements) {
-    // Acquire locks in consistent order: accounts first, then markets
-    std::shared_lock accounts_lock(accounts_mutex_);
+    // Acquire locks in consistent order: the takers' shards, then markets
+    uint64_t mask = 0;
+    for (const auto& settlement : settlements) {
+        mask |= shard_bit(settlement.taker);
+    }
+    ShardLocks accounts_locks(*this, mask, false);
     std::shared_lock markets_lock(markets_mutex_);
 
     for (const auto& settlement : settlements) {
@@ -353,26 +391,11 @@ int32_t LXVault::pre_check_fills(const std::vector<LXSettlement>& settlements) {
         I128 notional = x18::mul(settlement.size_x18, settlement.price_x18);
         I128 required_margin = x18::mul(notional, config_it->second.initial_margin_x18);
 
-        // Calculate taker's free margin inline
+        // Taker's free margin, from its aggregates
         const AccountState* taker_state = get_account(settlement.taker);
         if (taker_state) {
-            I128 equity = 0;
-            for (const auto& [hash, bal] : taker_state->balances) {
-                equity += bal;
-            }
-            for (const auto& [mid, pos] : taker_state->positions) {
-                equity += pos.unrealized_pnl_x18;
-            }
-
-            I128 used_margin = 0;
-            for (const auto& [mid, pos] : taker_state->positions) {
-                auto mit = markets_.find(mid);
-                if (mit != markets_.end()) {
-                    used_margin += calculate_initial_margin(pos, mit->second);
-                }
-            }
-
-            I128 free_margin = equity - used_margin;
+            I128 free_margin = taker_state->equity_x18() - taker_state->initial_margin_x18 -
+                               funding_owed(shard_of(settlement.taker), *taker_state);
             if (free_margin < required_margin) {
                 return errors::INSUFFICIENT_MARGIN;
             }
@@ -383,14 +406,24 @@ int32_t LXVault::pre_check_fills(const std::vector<LXSettlement>& settlements) {
 }
 
 int32_t LXVault::apply_fills(const std::vector<LXSettlement>& settlements) {
-    std::unique_lock lock(accounts_mutex_);
+    TraceSpan span(TracePoint::VaultApply, settlements.size());
+
+    // Only the shards of the accounts in this batch
+    uint64_t mask = 0;
+    for (const auto& settlement : settlements) {
+        mask |= shard_bit(settlement.maker) | shard_bit(settlement.taker);
+    }
+    ShardLocks locks(*this, mask, true);
+    std::shared_lock markets_lock(markets_mutex_);  // Margin rates for the risk aggregates
 
     // FIX: Validate balances before fee deduction to prevent negative balances.
     // First pass: validate all fees can be paid
-    uint64_t quote_hash = 0; // Simplified: use default currency
+    const uint64_t quote_hash = SETTLEMENT_CURRENCY;
     for (const auto& settlement : settlements) {
         AccountState* maker_state = get_or_create_account(settlement.maker);
         AccountState* taker_state = get_or_create_account(settlement.taker);
+        settle_funding(shard_of(settlement.maker), *maker_state);
+        settle_funding(shard_of(settlement.taker), *taker_state);
 
         auto maker_it = maker_state->balances.find(quote_hash);
         I128 maker_bal = (maker_it != maker_state->balances.end()) ? maker_it->second : 0;
@@ -407,22 +440,163 @@ int32_t LXVault::apply_fills(const std::vector<LXSettlement>& settlements) {
 
     // Second pass: apply all fills atomically
     for (const auto& settlement : settlements) {
+        AccountShard& maker_shard = shard_of(settlement.maker);
+        AccountShard& taker_shard = shard_of(settlement.taker);
         AccountState* maker_state = get_or_create_account(settlement.maker);
         AccountState* taker_state = get_or_create_account(settlement.taker);
 
         // Update maker position
-        update_position(*maker_state, settlement.market_id,
+        update_position(maker_shard, *maker_state, settlement.market_id,
                         !settlement.taker_is_buy, // Maker is opposite side
                         settlement.size_x18, settlement.price_x18);
 
         // Update taker position
-        update_position(*taker_state, settlement.market_id,
+        update_position(taker_shard, *taker_state, settlement.market_id,
                         settlement.taker_is_buy,
                         settlement.size_x18, settlement.price_x18);
 
         // Deduct fees (validated above)
-        maker_state->balances[quote_hash] -= settlement.maker_fee_x18;
-        taker_state->balances[quote_hash] -= settlement.taker_fee_x18;
+        adjust_balance(*maker_state, quote_hash, -settlement.maker_fee_x18);
+        adjust_balance(*taker_state, quote_hash, -settlement.taker_fee_x18);
+        refresh_risk(maker_shard, *maker_state);
+        refresh_risk(taker_shard, *taker_state);
+    }
+
+    return errors::OK;
+}
+
+int32_t LXVault::apply_fills_netted(const std::vector<LXSettlement>& settlements) {
+    TraceSpan span(TracePoint::VaultApply, settlements.size());
+
+    // Net the batch without touching the vault: every fill an account takes
+    // part in, and the sum of its fees, under one entry per account
+    struct NetFill {
+        uint32_t market_id;
+        bool is_buy;
+        I128 size_x18;
+        I128 price_x18;
+    };
+    struct NetAccount {
+        const LXAccount* account;
+        I128 fees_x18 = 0;
+        std::vector<NetFill> fills;
+    };
+    std::vector<NetAccount> net;
+    std::unordered_map<uint64_t, size_t> net_index;  // account_hash -> entry in net
+    net.reserve(settlements.size() * 2);
+    net_index.reserve(settlements.size() * 2);
+
+    uint64_t mask = 0;
+    auto add = [&](const LXAccount& account, const LXSettlement& settlement, bool is_buy, I128 fee_x18) {
+        auto [it, added] = net_index.try_emplace(account.hash(), net.size());
+        if (added) {
+            net.push_back(NetAccount{&account, 0, {}});
+            mask |= shard_bit(account);
+        }
+        NetAccount& entry = net[it->second];
+        entry.fees_x18 += fee_x18;
+        entry.fills.push_back({settlement.market_id, is_buy, settlement.size_x18, settlement.price_x18});
+    };
+    for (const auto& settlement : settlements) {
+        add(settlement.maker, settlement, !settlement.taker_is_buy, settlement.maker_fee_x18);
+        add(settlement.taker, settlement, settlement.taker_is_buy, settlement.taker_fee_x18);
+    }
+
+    ShardLocks locks(*this, mask, true);
+    std::shared_lock markets_lock(markets_mutex_);
+
+    // What each settled account looked like before, to roll back to
+    struct Undo {
+        AccountShard* shard;
+        AccountState* state;
+        bool created;
+        I128 balance_x18;
+        I128 total_pnl_x18;
+        std::vector<std::pair<uint32_t, std::optional<LXPosition>>> positions;
+    };
+    std::vector<Undo> undo;
+    undo.reserve(net.size());
+
+    auto rollback = [&] {
+        for (auto it = undo.rbegin(); it != undo.rend(); ++it) {
+            AccountState& state = *it->state;
+            for (const auto& [market_id, before] : it->positions) {
+                if (before) {
+                    LXPosition& position = state.positions[market_id];
+                    position = *before;
+                    index_position(*it->shard, state, position);
+                } else if (state.positions.count(market_id)) {
+                    close_position(*it->shard, state, market_id);
+                }
+            }
+            adjust_balance(state, SETTLEMENT_CURRENCY,
+                           it->balance_x18 - state.balances[SETTLEMENT_CURRENCY]);
+            state.total_pnl_x18 = it->total_pnl_x18;
+            refresh_risk(*it->shard, state);
+            if (it->created) {
+                unpublish(*it->shard, state.account.hash());
+                it->shard->accounts.erase(state.account.hash());
+            }
+        }
+    };
+
+    const uint64_t now = static_cast<uint64_t>(
+        std::chrono::duration_cast<std::chrono::seconds>(
+            std::chrono::system_clock::now().time_since_epoch()
+        ).count()
+    );
+
+    for (NetAccount& entry : net) {
+        AccountShard& shard = shard_of(*entry.account);
+        const bool created = !get_account(*entry.account);
+        AccountState* state = get_or_create_account(*entry.account);
+        settle_funding(shard, *state);
+
+        const I128 balance = state->balances[SETTLEMENT_CURRENCY];
+        if (balance < entry.fees_x18) {
+            rollback();
+            if (created) {
+                shard.accounts.erase(entry.account->hash());
+            }
+            return errors::INSUFFICIENT_BALANCE;
+        }
+        Undo& record = undo.emplace_back(Undo{&shard, state, created, balance, state->total_pnl_x18, {}});
+
+        // Fold each market's fills, in batch order, into one working copy
+        // of the position and write it back once
+        std::stable_sort(entry.fills.begin(), entry.fills.end(),
+                         [](const NetFill& a, const NetFill& b) { return a.market_id < b.market_id; });
+        for (size_t i = 0; i < entry.fills.size();) {
+            const uint32_t market_id = entry.fills[i].market_id;
+            auto pos_it = state->positions.find(market_id);
+            const bool existed = pos_it != state->positions.end();
+            record.positions.emplace_back(market_id, existed ? std::optional<LXPosition>(pos_it->second)
+                                                             : std::nullopt);
+
+            LXPosition position = existed ? pos_it->second : LXPosition{};
+            for (; i < entry.fills.size() && entry.fills[i].market_id == market_id; ++i) {
+                const NetFill& fill = entry.fills[i];
+                state->total_pnl_x18 += apply_fill(position, fill.is_buy, fill.size_x18, fill.price_x18);
+                if (position.size_x18 == 0) {
+                    position = LXPosition{};  // Closed; a later fill opens afresh
+                }
+            }
+
+            if (position.size_x18 == 0) {
+                if (existed) {
+                    close_position(shard, *state, market_id);
+                }
+                continue;
+            }
+            position.market_id = market_id;
+            position.last_funding_time = now;
+            LXPosition& stored = existed ? pos_it->second : state->positions[market_id];
+            stored = position;
+            index_position(shard, *state, stored);
+        }
+
+        adjust_balance(*state, SETTLEMENT_CURRENCY, -entry.fees_x18);
+        refresh_risk(shard, *state);
     }
 
     return errors::OK;
@@ -436,6 +610,34 @@ bool LXVault::is_liquidatable(const LXAccount& account) const {
     return get_margin_info(account).liquidatable;
 }
 
+size_t LXVault::liquidation_candidates(std::vector<LXAccount>& out, size_t max) const {
+    // The heap keys are doubles; take everything near the boundary and
+    // decide exactly on the aggregates
+    std::vector<std::pair<double, LXAccount>> found;
+    for (const AccountShard& shard : shards_) {
+        std::shared_lock lock(shard.mutex);
+        shard.risk.visit_while(
+            [](double ratio) { return ratio >= LIQUIDATABLE_RATIO; },
+            [&](uint64_t account_hash, double ratio) {
+                auto it = shard.accounts.find(account_hash);
+                if (it == shard.accounts.end()) return;
+                const AccountState& state = it->second;
+                const I128 equity = state.equity_x18() - funding_owed(shard, state);
+                if (equity <= 0 || state.maintenance_margin_x18 >= equity) {
+                    found.emplace_back(ratio, state.account);
+                }
+            });
+    }
+
+    std::sort(found.begin(), found.end(),
+              [](const auto& a, const auto& b) { return a.first > b.first; });
+    const size_t count = std::min(found.size(), max);
+    for (size_t i = 0; i < count; ++i) {
+        out.push_back(found[i].second);
+    }
+    return count;
+}
+
 LXLiquidationResult LXVault::liquidate(const LXAccount& liquidator, const LXAccount& account,
                                         uint32_t market_id, I128 size_x18) {
     LXLiquidationResult result{};
@@ -447,8 +649,11 @@ LXLiquidationResult LXVault::liquidate(const LXAccount& liquidator, const LXAcco
         return result;
     }
 
-    std::unique_lock lock(accounts_mutex_);
+    AccountShard& shard = shard_of(account);
+    std::unique_lock lock(shard.mutex);
+    std::shared_lock markets_lock(markets_mutex_);
     AccountState* state = get_or_create_account(account);
+    settle_funding(shard, *state);
 
     auto pos_it = state->positions.find(market_id);
     if (pos_it == state->positions.end()) {
@@ -477,13 +682,14 @@ LXLiquidationResult LXVault::liquidate(const LXAccount& liquidator, const LXAcco
 
     // Calculate penalty (typically 0.5-1%)
     I128 notional = x18::mul(liq_size, mark_price);
-    result.penalty_x18 = x18::mul(notional, x18::from_double(0.005)); // 0.5%
+    result.penalty_x18 = x18::mul(notional, x18::from_bps(50)); // 0.5%
 
-    // Update positions
-    update_position(*state, market_id, position.side == PositionSide::LONG, -liq_size, mark_price);
+    // Close out against the position's side: a long is sold, a short bought
+    update_position(shard, *state, market_id, position.side == PositionSide::SHORT, liq_size, mark_price);
+    refresh_risk(shard, *state);
 
     // Transfer penalty to insurance fund
-    insurance_fund_.fetch_add(result.penalty_x18, std::memory_order_relaxed);
+    add_to_insurance(result.penalty_x18);
 
     total_liquidations_.fetch_add(1, std::memory_order_relaxed);
 
@@ -491,9 +697,77 @@ LXLiquidationResult LXVault::liquidate(const LXAccount& liquidator, const LXAcco
 }
 
 int32_t LXVault::run_adl(uint32_t market_id) {
-    // Stub: Auto-deleverage when insurance fund is depleted
-    // Match profitable positions against underwater positions
-    (void)market_id;
+    // Counterparties can be in any shard
+    ShardLocks locks(*this, ~uint64_t{0}, true);
+    std::shared_lock markets_lock(markets_mutex_);
+
+    I128 mark_price = 0;
+    for (const AccountShard& shard : shards_) {
+        auto it = shard.marks.find(market_id);
+        if (it != shard.marks.end() && it->second.mark_px_x18 > 0) {
+            mark_price = it->second.mark_px_x18;
+            break;
+        }
+    }
+    if (mark_price <= 0 && mark_price_callback_) {
+        mark_price = mark_price_callback_(market_id);
+    }
+    if (mark_price <= 0) {
+        return errors::INVALID_PRICE;
+    }
+
+    // Accounts still under water with a position here, from the risk heaps
+    std::vector<std::pair<AccountShard*, AccountState*>> under;
+    for (AccountShard& shard : shards_) {
+        shard.risk.visit_while(
+            [](double ratio) { return ratio >= LIQUIDATABLE_RATIO; },
+            [&](uint64_t account_hash, double) {
+                AccountState& state = shard.accounts.at(account_hash);
+                if (state.mark_slots.count(market_id)) {
+                    under.emplace_back(&shard, &state);
+                }
+            });
+    }
+
+    for (auto [shard, state] : under) {
+        settle_funding(*shard, *state);
+        const I128 equity = state->equity_x18();
+        if (equity > 0 && state->maintenance_margin_x18 < equity) {
+            continue;  // Only the heap key said so
+        }
+
+        const I128 size = state->positions.at(market_id).size_x18;
+        const bool is_long = size > 0;
+        I128 remaining = is_long ? size : -size;
+        while (remaining > 0) {
+            // Best-ranked opposing position over every shard's ranking
+            AccountShard* best = nullptr;
+            IndexedHeap<uint64_t, double>* best_rank = nullptr;
+            for (AccountShard& candidate : shards_) {
+                auto it = candidate.marks.find(market_id);
+                if (it == candidate.marks.end()) continue;
+                auto& rank = is_long ? it->second.adl_short : it->second.adl_long;
+                if (!rank.empty() && (!best_rank || rank.top_priority() > best_rank->top_priority())) {
+                    best = &candidate;
+                    best_rank = &rank;
+                }
+            }
+            if (!best) break;  // Nobody left to deleverage against
+
+            AccountState& counter = best->accounts.at(best_rank->top_key());
+            const I128 counter_size = counter.positions.at(market_id).size_x18;
+            const I128 take = std::min(remaining, counter_size > 0 ? counter_size : -counter_size);
+
+            // Both sides close at the mark; closing a whole counterparty
+            // drops it from the ranking, a partial close re-ranks it
+            update_position(*best, counter, market_id, is_long, take, mark_price);
+            refresh_risk(*best, counter);
+            update_position(*shard, *state, market_id, !is_long, take, mark_price);
+            remaining -= take;
+        }
+        refresh_risk(*shard, *state);
+    }
+
     return errors::OK;
 }
 
@@ -522,29 +796,88 @@ int32_t LXVault::accrue_funding(uint32_t market_id) {
 
     funding.cumulative_funding_x18 += funding.current_rate_x18;
     funding.last_funding_time = now;
+    const I128 rate = funding.current_rate_x18;
 
     funding_lock.unlock();
 
-    // Apply funding to all positions
-    std::unique_lock accounts_lock(accounts_mutex_);
+    // Only the index moves; positions pay against it when next touched.
+    // Their accounts are re-keyed for risk, nothing is settled or published
+    for (AccountShard& shard : shards_) {
+        std::unique_lock accounts_lock(shard.mutex);
+        MarketMarks& marks = shard.marks[market_id];
+        marks.funding_index_x18 += rate;
+        marks.funding_time = now;
+        rekey_funding(shard, marks);
+    }
+    funding_epoch_.fetch_add(1, std::memory_order_release);
 
-    for (auto& [account_hash, account_state] : accounts_) {
-        auto pos_it = account_state.positions.find(market_id);
-        if (pos_it == account_state.positions.end()) continue;
+    return errors::OK;
+}
 
-        LXPosition& position = pos_it->second;
-        I128 funding_payment = x18::mul(position.size_x18, funding.current_rate_x18);
+size_t LXVault::accrue_funding(const std::vector<std::pair<uint32_t, I128>>& rates, TaskPool* pool) {
+    const uint64_t now = static_cast<uint64_t>(
+        std::chrono::duration_cast<std::chrono::seconds>(
+            std::chrono::system_clock::now().time_since_epoch()
+        ).count()
+    );
 
-        // Long pays funding when rate is positive
-        if (position.side == PositionSide::LONG) {
-            position.accumulated_funding_x18 -= funding_payment;
-        } else {
-            position.accumulated_funding_x18 += funding_payment;
+    std::vector<std::pair<uint32_t, I128>> due;
+    {
+        std::unique_lock funding_lock(funding_mutex_);
+        for (const auto& [market_id, rate] : rates) {
+            auto it = funding_.find(market_id);
+            if (it == funding_.end()) continue;
+            FundingState& funding = it->second;
+            funding.current_rate_x18 = rate;
+            if (now < funding.last_funding_time + funding.funding_interval) continue;
+
+            funding.cumulative_funding_x18 += rate;
+            funding.last_funding_time = now;
+            due.emplace_back(market_id, rate);
         }
-        position.last_funding_time = now;
+    }
+    if (due.empty()) {
+        return 0;
     }
 
-    return errors::OK;
+    // Shards are independent, so they advance their indexes in parallel
+    auto accrue_shard = [&](size_t s) {
+        AccountShard& shard = shards_[s];
+        std::unique_lock accounts_lock(shard.mutex);
+        for (const auto& [market_id, rate] : due) {
+            MarketMarks& marks = shard.marks[market_id];
+            marks.funding_index_x18 += rate;
+            marks.funding_time = now;
+            rekey_funding(shard, marks);
+        }
+    };
+    if (pool) {
+        pool->parallel_for(shards_.size(), accrue_shard);
+    } else {
+        for (size_t s = 0; s < shards_.size(); ++s) {
+            accrue_shard(s);
+        }
+    }
+    funding_epoch_.fetch_add(1, std::memory_order_release);
+
+    return due.size();
+}
+
+std::vector<uint32_t> LXVault::funding_due() const {
+    const uint64_t now = static_cast<uint64_t>(
+        std::chrono::duration_cast<std::chrono::seconds>(
+            std::chrono::system_clock::now().time_since_epoch()
+        ).count()
+    );
+
+    std::vector<uint32_t> due;
+    std::shared_lock lock(funding_mutex_);
+    for (const auto& [market_id, funding] : funding_) {
+        if (now >= funding.last_funding_time + funding.funding_interval) {
+            due.push_back(market_id);
+        }
+    }
+    return due;
 }
 
 I128 LXVault::funding_rate_x18(uint32_t market_id) const {
@@ -569,6 +902,14 @@ void LXVault::set_funding_rate(uint32_t market_id, I128 rate_x18) {
     }
 }
 
+void LXVault::set_funding_interval(uint32_t market_id, uint64_t interval_seconds) {
+    std::unique_lock lock(funding_mutex_);
+    auto it = funding_.find(market_id);
+    if (it != funding_.end()) {
+        it->second.funding_interval = interval_seconds;
+    }
+}
+
 // =============================================================================
 // Insurance Fund
 // =============================================================================
@@ -578,7 +919,14 @@ I128 LXVault::insurance_fund_balance() const {
 }
 
 void LXVault::contribute_to_insurance(I128 amount_x18) {
-    insurance_fund_.fetch_add(amount_x18, std::memory_order_relaxed);
+    add_to_insurance(amount_x18);
+}
+
+void LXVault::add_to_insurance(I128 amount_x18) {
+    // std::atomic<I128> has no fetch_add in strict C++17
+    I128 current = insurance_fund_.load(std::memory_order_relaxed);
+    while (!insurance_fund_.compare_exchange_weak(current, current + amount_x18,
+                                                  std::memory_order_relaxed)) {}
 }
 
 I128 LXVault::withdraw_from_insurance(I128 amount_x18) {
@@ -602,25 +950,30 @@ void LXVault::set_mark_price_callback(MarkPriceCallback callback) {
 }
 
 int32_t LXVault::update_mark_prices(const std::vector<std::pair<uint32_t, I128>>& prices) {
-    // FIX: Add mark-to-market updates for unrealized_pnl_x18.
-    // Without this, unrealized_pnl_x18 is never updated and margin
-    // calculations use stale values.
-    std::unique_lock lock(accounts_mutex_);
-
-    for (auto& [account_hash, account_state] : accounts_) {
-        for (auto& [market_id, position] : account_state.positions) {
-            // Find mark price for this market
-            I128 mark_price = 0;
-            for (const auto& [mid, price] : prices) {
-                if (mid == market_id) {
-                    mark_price = price;
-                    break;
-                }
-            }
+    // One shard at a time, so deposits and fills interleave with a large
+    // update instead of waiting for all of it
+    std::vector<I128> pnl;
+    for (AccountShard& shard : shards_) {
+        std::unique_lock lock(shard.mutex);
+        for (const auto& [market_id, mark_price] : prices) {
             if (mark_price <= 0) continue;
 
-            // Update unrealized PnL
-            position.unrealized_pnl_x18 = calculate_unrealized_pnl(position, mark_price);
+            // Every shard remembers the mark, for positions it opens later
+            MarketMarks& marks = shard.marks[market_id];
+            marks.mark_px_x18 = mark_price;
+            const size_t count = marks.size_x18.size();
+            pnl.resize(count);
+            x18::pnl_batch(marks.size_x18.data(), marks.entry_px_x18.data(), mark_price,
+                           pnl.data(), count);
+            for (size_t slot = 0; slot < count; ++slot) {
+                // Every slot is visited anyway; settle its funding so the
+                // risk heap sees it too
+                settle_slot_funding(marks, slot);
+                marks.accounts[slot]->unrealized_pnl_x18 += pnl[slot] - marks.pnl_x18[slot];
+                marks.pnl_x18[slot] = pnl[slot];
+                marks.positions[slot]->unrealized_pnl_x18 = pnl[slot];
+                refresh_risk(shard, *marks.accounts[slot]);
+            }
         }
     }
 
@@ -632,7 +985,8 @@ int32_t LXVault::update_position_mark(const LXAccount& account, uint32_t market_
         return errors::INVALID_PRICE;
     }
 
-    std::unique_lock lock(accounts_mutex_);
+    AccountShard& shard = shard_of(account);
+    std::unique_lock lock(shard.mutex);
     AccountState* state = get_or_create_account(account);
 
     auto pos_it = state->positions.find(market_id);
@@ -640,24 +994,302 @@ int32_t LXVault::update_position_mark(const LXAccount& account, uint32_t market_
         return errors::POSITION_NOT_FOUND;
     }
 
-    pos_it->second.unrealized_pnl_x18 = calculate_unrealized_pnl(pos_it->second, mark_price_x18);
+    auto slot_it = state->mark_slots.find(market_id);
+    if (slot_it == state->mark_slots.end()) {
+        return errors::POSITION_NOT_FOUND;
+    }
+    settle_funding(shard, *state);
+    set_slot_pnl(shard.marks[market_id], slot_it->second,
+                 calculate_unrealized_pnl(pos_it->second, mark_price_x18));
+    refresh_risk(shard, *state);
     return errors::OK;
 }
 
+void LXVault::set_slot_pnl(MarketMarks& marks, size_t slot, I128 pnl_x18) {
+    marks.accounts[slot]->unrealized_pnl_x18 += pnl_x18 - marks.pnl_x18[slot];
+    marks.pnl_x18[slot] = pnl_x18;
+    marks.positions[slot]->unrealized_pnl_x18 = pnl_x18;
+}
+
+void LXVault::index_position(AccountShard& shard, AccountState& state, LXPosition& position) {
+    MarketMarks& marks = shard.marks[position.market_id];
+    auto [it, added] = state.mark_slots.try_emplace(position.market_id,
+                                                    static_cast<uint32_t>(marks.size_x18.size()));
+    const size_t slot = it->second;
+    if (added) {
+        marks.size_x18.push_back(0);
+        marks.entry_px_x18.push_back(0);
+        marks.funding_entry_x18.push_back(marks.funding_index_x18);  // Owes nothing yet
+        marks.pnl_x18.push_back(0);
+        marks.initial_x18.push_back(0);
+        marks.maintenance_x18.push_back(0);
+        marks.positions.push_back(&position);
+        marks.accounts.push_back(&state);
+    }
+    marks.size_x18[slot] = position.size_x18;
+    marks.entry_px_x18[slot] = position.entry_px_x18;
+
+    auto config_it = markets_.find(position.market_id);
+    set_slot_margins(marks, slot, config_it != markets_.end() ? &config_it->second : nullptr);
+
+    // Without a mark yet the position keeps whatever PnL it had
+    const I128 pnl = marks.mark_px_x18 > 0 ?
+        calculate_unrealized_pnl(position, marks.mark_px_x18) : position.unrealized_pnl_x18;
+    set_slot_pnl(marks, slot, pnl);
+}
+
+void LXVault::unindex_position(AccountShard& shard, AccountState& state, uint32_t market_id) {
+    auto it = state.mark_slots.find(market_id);
+    if (it == state.mark_slots.end()) return;
+
+    MarketMarks& marks = shard.marks[market_id];
+    const size_t slot = it->second;
+    const size_t last = marks.size_x18.size() - 1;
+    marks.adl_long.erase(state.account.hash());
+    marks.adl_short.erase(state.account.hash());
+    state.unrealized_pnl_x18 -= marks.pnl_x18[slot];
+    state.initial_margin_x18 -= marks.initial_x18[slot];
+    state.maintenance_margin_x18 -= marks.maintenance_x18[slot];
+    state.mark_slots.erase(it);
+
+    if (slot != last) {
+        marks.size_x18[slot] = marks.size_x18[last];
+        marks.entry_px_x18[slot] = marks.entry_px_x18[last];
+        marks.funding_entry_x18[slot] = marks.funding_entry_x18[last];
+        marks.pnl_x18[slot] = marks.pnl_x18[last];
+        marks.initial_x18[slot] = marks.initial_x18[last];
+        marks.maintenance_x18[slot] = marks.maintenance_x18[last];
+        marks.positions[slot] = marks.positions[last];
+        marks.accounts[slot] = marks.accounts[last];
+        marks.accounts[slot]->mark_slots[market_id] = static_cast<uint32_t>(slot);
+    }
+    marks.size_x18.pop_back();
+    marks.entry_px_x18.pop_back();
+    marks.funding_entry_x18.pop_back();
+    marks.pnl_x18.pop_back();
+    marks.initial_x18.pop_back();
+    marks.maintenance_x18.pop_back();
+    marks.positions.pop_back();
+    marks.accounts.pop_back();
+}
+
+void LXVault::set_slot_margins(MarketMarks& marks, size_t slot, const MarketConfig* config) const {
+    const LXPosition& position = *marks.positions[slot];
+    const I128 initial = config ? calculate_initial_margin(position, *config) : 0;
+    const I128 maintenance = config ? calculate_maintenance_margin(position, *config) : 0;
+    AccountState& state = *marks.accounts[slot];
+    state.initial_margin_x18 += initial - marks.initial_x18[slot];
+    state.maintenance_margin_x18 += maintenance - marks.maintenance_x18[slot];
+    marks.initial_x18[slot] = initial;
+    marks.maintenance_x18[slot] = maintenance;
+}
+
+I128 LXVault::slot_funding_owed(const MarketMarks& marks, size_t slot) {
+    // Long pays funding when the rate is positive; size is signed, so the
+    // same amount is a receipt for a short
+    return x18::mul(marks.size_x18[slot], marks.funding_index_x18 - marks.funding_entry_x18[slot]);
+}
+
+I128 LXVault::funding_owed(const AccountShard& shard, const AccountState& state) {
+    I128 owed = 0;
+    for (const auto& [market_id, slot] : state.mark_slots) {
+        owed += slot_funding_owed(shard.marks.at(market_id), slot);
+    }
+    return owed;
+}
+
+I128 LXVault::funding_owed(const AccountShard& shard, const AccountState& state, uint32_t market_id) {
+    auto it = state.mark_slots.find(market_id);
+    return it != state.mark_slots.end() ? slot_funding_owed(shard.marks.at(market_id), it->second) : 0;
+}
+
+void LXVault::settle_slot_funding(MarketMarks& marks, size_t slot) {
+    if (marks.funding_entry_x18[slot] == marks.funding_index_x18) {
+        return;
+    }
+    const I128 owed = slot_funding_owed(marks, slot);
+    marks.funding_entry_x18[slot] = marks.funding_index_x18;
+    LXPosition& position = *marks.positions[slot];
+    position.accumulated_funding_x18 -= owed;
+    position.last_funding_time = marks.funding_time;
+    adjust_balance(*marks.accounts[slot], SETTLEMENT_CURRENCY, -owed);
+}
+
+void LXVault::settle_funding(AccountShard& shard, AccountState& state) {
+    for (const auto& [market_id, slot] : state.mark_slots) {
+        settle_slot_funding(shard.marks[market_id], slot);
+    }
+}
+
+void LXVault::adjust_balance(AccountState& state, uint64_t currency_hash, I128 delta_x18) {
+    state.balances[currency_hash] += delta_x18;
+    state.collateral_x18 += delta_x18;
+}
+
+double LXVault::margin_ratio(const AccountShard& shard, const AccountState& state) {
+    if (state.maintenance_margin_x18 <= 0) {
+        return 0.0;
+    }
+    const I128 equity = state.equity_x18() - funding_owed(shard, state);
+    if (equity <= 0) {
+        return std::numeric_limits<double>::infinity();
+    }
+    return x18::to_double(state.maintenance_margin_x18) / x18::to_double(equity);
+}
+
+void LXVault::refresh_risk(AccountShard& shard, const AccountState& state) const {
+    const uint64_t account_hash = state.account.hash();
+    if (state.mark_slots.empty()) {
+        shard.risk.erase(account_hash);
+    } else {
+        shard.risk.set(account_hash, margin_ratio(shard, state));
+    }
+    rank_adl(shard, state);
+    publish(shard, state);
+}
+
+void LXVault::rekey_funding(AccountShard& shard, const MarketMarks& marks) {
+    for (const AccountState* state : marks.accounts) {
+        shard.risk.set(state->account.hash(), margin_ratio(shard, *state));
+    }
+}
+
+void LXVault::rank_adl(AccountShard& shard, const AccountState& state) {
+    const uint64_t account_hash = state.account.hash();
+    const double equity = x18::to_double(state.equity_x18());
+    for (const auto& [market_id, slot] : state.mark_slots) {
+        MarketMarks& marks = shard.marks.at(market_id);
+        const bool is_long = marks.size_x18[slot] > 0;
+        auto& rank = is_long ? marks.adl_long : marks.adl_short;
+        (is_long ? marks.adl_short : marks.adl_long).erase(account_hash);  // Flipped sides
+
+        const I128 pnl = marks.pnl_x18[slot];
+        if (pnl <= 0 || equity <= 0 || marks.mark_px_x18 <= 0) {
+            rank.erase(account_hash);
+            continue;
+        }
+        const double size = std::abs(x18::to_double(marks.size_x18[slot]));
+        const double entry_notional = size * x18::to_double(marks.entry_px_x18[slot]);
+        if (entry_notional <= 0) {
+            rank.erase(account_hash);
+            continue;
+        }
+        const double leverage = size * x18::to_double(marks.mark_px_x18) / equity;
+        rank.set(account_hash, x18::to_double(pnl) / entry_notional * leverage);
+    }
+}
+
+// =============================================================================
+// Read Snapshots
+// =============================================================================
+
+std::shared_ptr<const AccountSnapshot> LXVault::account_snapshot(const LXAccount& account) const {
+    const uint64_t account_hash = account.hash();
+    const SnapshotSlot* slot = shards_[shard_index(account_hash)].snapshots.find(account_hash);
+    return slot ? std::atomic_load(&slot->current) : nullptr;
+}
+
+void LXVault::publish(AccountShard& shard, const AccountState& state) const {
+    const uint64_t account_hash = state.account.hash();
+    SnapshotSlot& slot = shard.snapshot_slots[account_hash];
+    if (!slot.current) {
+        shard.snapshots.insert(account_hash, &slot);  // First publish, or back after unpublish
+    }
+
+    auto snapshot = std::make_shared<AccountSnapshot>();
+    snapshot->version = ++slot.version;
+    snapshot->state = state;
+    snapshot->funding_entry_x18.reserve(state.mark_slots.size());
+    for (const auto& [market_id, index] : state.mark_slots) {
+        snapshot->funding_entry_x18.emplace_back(market_id, shard.marks.at(market_id).funding_entry_x18[index]);
+    }
+    const uint64_t version = snapshot->version;
+    std::atomic_store(&slot.current, std::shared_ptr<const AccountSnapshot>(std::move(snapshot)));
+
+    // Read the epoch first: an accrual that completes after it leaves these
+    // figures stamped stale even if this shard's index already moved
+    const uint64_t epoch = funding_epoch_.load(std::memory_order_acquire);
+    const I128 equity = state.equity_x18() - funding_owed(shard, state);
+    slot.buying_power.store(BuyingPower{version, epoch, !state.mark_slots.empty(),
+                                        equity, equity - state.initial_margin_x18});
+}
+
+std::optional<BuyingPower> LXVault::buying_power(const LXAccount& account) const {
+    const uint64_t account_hash = account.hash();
+    const SnapshotSlot* slot = shards_[shard_index(account_hash)].snapshots.find(account_hash);
+    if (!slot) return std::nullopt;
+
+    BuyingPower power = slot->buying_power.load();
+    if (power.version == 0) return std::nullopt;
+    const uint64_t epoch = funding_epoch_.load(std::memory_order_acquire);
+    if (!power.funding_exposed || power.funding_epoch == epoch) {
+        return power;
+    }
+
+    // Funding accrued since the write; charge it from the snapshot
+    auto snapshot = std::atomic_load(&slot->current);
+    if (!snapshot) return std::nullopt;
+    const I128 equity = snapshot->state.equity_x18() - funding_owed(*snapshot);
+    return BuyingPower{snapshot->version, epoch, true, equity,
+                       equity - snapshot->state.initial_margin_x18};
+}
+
+std::optional<MarketLimits> LXVault::market_limits(uint32_t market_id) const {
+    const SeqLock<MarketLimits>* limits = market_limits_.find(market_id);
+    if (!limits) return std::nullopt;
+    return limits->load();
+}
+
+void LXVault::unpublish(AccountShard& shard, uint64_t account_hash) {
+    auto it = shard.snapshot_slots.find(account_hash);
+    if (it == shard.snapshot_slots.end()) return;
+    shard.snapshots.erase(account_hash);
+    std::atomic_store(&it->second.current, std::shared_ptr<const AccountSnapshot>());
+}
+
+I128 LXVault::funding_owed(const AccountSnapshot& snapshot) const {
+    if (snapshot.funding_entry_x18.empty()) return 0;
+
+    I128 owed = 0;
+    std::shared_lock lock(funding_mutex_);
+    for (const auto& [market_id, entry_x18] : snapshot.funding_entry_x18) {
+        auto it = funding_.find(market_id);
+        if (it == funding_.end()) continue;
+        owed += x18::mul(snapshot.state.positions.at(market_id).size_x18,
+                         it->second.cumulative_funding_x18 - entry_x18);
+    }
+    return owed;
+}
+
+I128 LXVault::funding_owed(const AccountSnapshot& snapshot, uint32_t market_id) const {
+    for (const auto& [entry_market, entry_x18] : snapshot.funding_entry_x18) {
+        if (entry_market != market_id) continue;
+        std::shared_lock lock(funding_mutex_);
+        auto it = funding_.find(market_id);
+        if (it == funding_.end()) return 0;
+        return x18::mul(snapshot.state.positions.at(market_id).size_x18,
+                        it->second.cumulative_funding_x18 - entry_x18);
+    }
+    return 0;
+}
+
 // =============================================================================
 // Statistics
 // =============================================================================
 
 LXVault::Stats LXVault::get_stats() const {
-    std::shared_lock lock(accounts_mutex_);
-
+    uint64_t total_accounts = 0;
     uint64_t total_positions = 0;
-    for (const auto& [account_hash, state] : accounts_) {
-        total_positions += state.positions.size();
+    for (const AccountShard& shard : shards_) {
+        std::shared_lock lock(shard.mutex);
+        total_accounts += shard.accounts.size();
+        for (const auto& [account_hash, state] : shard.accounts) {
+            total_positions += state.positions.size();
+        }
     }
 
     return Stats{
-        accounts_.size(),
+        total_accounts,
         total_positions,
         total_liquidations_.load(std::memory_order_relaxed),
         0, // total_volume_x18 - would need tracking
@@ -665,15 +1297,29 @@ LXVault::Stats LXVault::get_stats() const {
     };
 }
 
+MemoryStats LXVault::memory_usage() const {
+    MemoryStats stats;
+    for (const AccountShard& shard : shards_) {
+        stats += shard.arena.stats();
+    }
+    return stats;
+}
+
+NodeMemoryStats LXVault::placement_stats() const {
+    return memory_ ? memory_->stats() : NodeMemoryStats{};
+}
+
 // =============================================================================
 // Internal Helpers
 // =============================================================================
 
 AccountState* LXVault::get_or_create_account(const LXAccount& account) {
     uint64_t hash = account.hash();
-    auto it = accounts_.find(hash);
-    if (it == accounts_.end()) {
+    auto& accounts = shards_[shard_index(hash)].accounts;
+    auto it = accounts.find(hash);
+    if (it == accounts.end()) {
         AccountState state;
+        state.account = account;
         state.margin_mode = MarginMode::CROSS;
         state.total_pnl_x18 = 0;
         state.last_update_time = static_cast<uint64_t>(
@@ -681,16 +1327,16 @@ AccountState* LXVault::get_or_create_account(const LXAccount& account) {
                 std::chrono::system_clock::now().time_since_epoch()
             ).count()
         );
-        accounts_[hash] = std::move(state);
-        it = accounts_.find(hash);
+        it = accounts.emplace(hash, std::move(state)).first;
     }
     return &it->second;
 }
 
 const AccountState* LXVault::get_account(const LXAccount& account) const {
     uint64_t hash = account.hash();
-    auto it = accounts_.find(hash);
-    return (it != accounts_.end()) ? &it->second : nullptr;
+    const auto& accounts = shards_[shard_index(hash)].accounts;
+    auto it = accounts.find(hash);
+    return (it != accounts.end()) ? &it->second : nullptr;
 }
 
 I128 LXVault::calculate_initial_margin(const LXPosition& pos, const MarketConfig& config) const {
@@ -704,17 +1350,11 @@ I128 LXVault::calculate_maintenance_margin(const LXPosition& pos, const MarketCo
 }
 
 I128 LXVault::calculate_unrealized_pnl(const LXPosition& pos, I128 mark_price_x18) const {
-    I128 price_diff = mark_price_x18 - pos.entry_px_x18;
-    if (pos.side == PositionSide::SHORT) {
-        price_diff = -price_diff;
-    }
-    return x18::mul(pos.size_x18, price_diff);
+    // size_x18 is signed, so a short gains as the price falls
+    return x18::mul(pos.size_x18, mark_price_x18 - pos.entry_px_x18);
 }
 
-void LXVault::update_position(AccountState& state, uint32_t market_id,
-                               bool is_buy, I128 size_x18, I128 price_x18) {
-    auto& position = state.positions[market_id];
-
+I128 LXVault::apply_fill(LXPosition& position, bool is_buy, I128 size_x18, I128 price_x18) const {
     bool increasing = (is_buy && position.size_x18 >= 0) ||
                       (!is_buy && position.size_x18 <= 0);
 
@@ -731,24 +1371,37 @@ void LXVault::update_position(AccountState& state, uint32_t market_id,
         }
         position.size_x18 = total_size;
         position.side = total_size >= 0 ? PositionSide::LONG : PositionSide::SHORT;
-    } else {
-        // Reducing position
-        I128 reduction = is_buy ? size_x18 : -size_x18;
-        I128 old_size = position.size_x18 > 0 ? position.size_x18 : -position.size_x18;
-        I128 reduce_abs = reduction > 0 ? reduction : -reduction;
-        reduce_abs = std::min(reduce_abs, old_size);
-
-        // Realize PnL
-        I128 pnl = calculate_unrealized_pnl(position, price_x18);
-        pnl = x18::mul(pnl, x18::div(reduce_abs, old_size));
-        state.total_pnl_x18 += pnl;
-
-        position.size_x18 += reduction;
-        if (position.size_x18 == 0) {
-            close_position(state, market_id);
-        } else {
-            position.side = position.size_x18 >= 0 ? PositionSide::LONG : PositionSide::SHORT;
-        }
+        return 0;
+    }
+
+    // Reducing position
+    I128 reduction = is_buy ? size_x18 : -size_x18;
+    I128 old_size = position.size_x18 > 0 ? position.size_x18 : -position.size_x18;
+    I128 reduce_abs = reduction > 0 ? reduction : -reduction;
+    reduce_abs = std::min(reduce_abs, old_size);
+
+    // Realize PnL
+    I128 pnl = calculate_unrealized_pnl(position, price_x18);
+    pnl = x18::mul(pnl, x18::div(reduce_abs, old_size));
+
+    position.size_x18 += reduction;
+    position.side = position.size_x18 >= 0 ? PositionSide::LONG : PositionSide::SHORT;
+    return pnl;
+}
+
+void LXVault::update_position(AccountShard& shard, AccountState& state, uint32_t market_id,
+                               bool is_buy, I128 size_x18, I128 price_x18) {
+    // Funding owed so far accrued on the old size
+    auto slot_it = state.mark_slots.find(market_id);
+    if (slot_it != state.mark_slots.end()) {
+        settle_slot_funding(shard.marks[market_id], slot_it->second);
+    }
+
+    auto& position = state.positions[market_id];
+    state.total_pnl_x18 += apply_fill(position, is_buy, size_x18, price_x18);
+    if (position.size_x18 == 0) {
+        close_position(shard, state, market_id);
+        return;  // `position` is gone
     }
 
     position.market_id = market_id;
@@ -757,9 +1410,11 @@ void LXVault::update_position(AccountState& state, uint32_t market_id,
             std::chrono::system_clock::now().time_since_epoch()
         ).count()
     );
+    index_position(shard, state, position);
 }
 
-void LXVault::close_position(AccountState& state, uint32_t market_id) {
+void LXVault::close_position(AccountShard& shard, AccountState& state, uint32_t market_id) {
+    unindex_position(shard, state, market_id);
     state.positions.erase(market_id);
 }
 
@@ -779,16 +1434,27 @@ I128 RiskEngine::calculate_portfolio_margin(const LXAccount& account) const {
 }
 
 bool RiskEngine::pre_trade_check(const LXAccount& account, const LXOrder& order) const {
-    LXMarginInfo margin = vault_.get_margin_info(account);
+    // Cached figures only, so the order-entry path takes no vault lock
+    auto limits = vault_.market_limits(order.market_id);
+    if (!limits) return false;
+    auto power = vault_.buying_power(account);
+    const I128 free_margin = power ? power->free_margin_x18 : 0;
 
     // Estimate margin required for this order
     I128 notional = x18::mul(order.size_x18, order.limit_px_x18);
-
-    auto config = vault_.get_market_config(order.market_id);
-    if (!config) return false;
-
-    I128 required = x18::mul(notional, config->initial_margin_x18);
-    return margin.free_margin_x18 >= required;
+    I128 required = x18::mul(notional, limits->initial_margin_x18);
+    if (free_margin < required) return false;
+
+    if (limits->max_position_size_x18 > 0) {
+        // Orders that shrink the position pass even above the limit
+        auto position = vault_.get_position(account, order.market_id);
+        const I128 size = position ? position->size_x18 : 0;
+        const I128 after = size + (order.is_buy ? order.size_x18 : -order.size_x18);
+        const I128 abs_size = size > 0 ? size : -size;
+        const I128 abs_after = after > 0 ? after : -after;
+        if (abs_after > limits->max_position_size_x18 && abs_after > abs_size) return false;
+    }
+    return true;
 }
 
 bool RiskEngine::is_bankrupt(const LXAccount& account) const {
@@ -796,16 +1462,24 @@ bool RiskEngine::is_bankrupt(const LXAccount& account) const {
 }
 
 I128 RiskEngine::max_order_size(const LXAccount& account, uint32_t market_id, bool is_buy) const {
-    (void)is_buy;  // Could be used for position-aware sizing in the future
-    LXMarginInfo margin = vault_.get_margin_info(account);
-    if (margin.free_margin_x18 <= 0) return 0;
+    auto power = vault_.buying_power(account);
+    if (!power || power->free_margin_x18 <= 0) return 0;
 
-    auto config = vault_.get_market_config(market_id);
-    if (!config) return 0;
+    auto limits = vault_.market_limits(market_id);
+    if (!limits) return 0;
 
     // max_size = free_margin / (price * initial_margin_rate)
     // Simplified: assume price = 1
-    return x18::div(margin.free_margin_x18, config->initial_margin_x18);
+    I128 max_size = x18::div(power->free_margin_x18, limits->initial_margin_x18);
+
+    // No further than the position limit in the order's direction
+    if (limits->max_position_size_x18 > 0) {
+        auto position = vault_.get_position(account, market_id);
+        const I128 size = position ? position->size_x18 : 0;
+        const I128 headroom = limits->max_position_size_x18 - (is_buy ? size : -size);
+        max_size = std::min(max_size, std::max<I128>(headroom, 0));
+    }
+    return max_size;
 }
 
 I128 RiskEngine::liquidation_price(const LXAccount& account, uint32_t market_id) const {
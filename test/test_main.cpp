@@ -4,10 +4,35 @@
 #include <chrono>
 #include <iomanip>
 #include <thread>
+#include <map>
+#include <set>
+#include <unordered_set>
+#include <algorithm>
+#include <atomic>
+#include <cstdio>
+#include <cmath>
+#include <cstring>
+#include <csignal>
+#include <unistd.h>
+#include <sys/resource.h>
+#include <sys/stat.h>
 
 #include "lux/engine.hpp"
 #include "lux/oracle.hpp"
+#include "lux/oracle_scheduler.hpp"
+#include "lux/feed.hpp"
 #include "lux/book.hpp"
+#include "lux/settlement.hpp"
+#include "lux/liquidation.hpp"
+#include "lux/full_math.hpp"
+#include "lux/fixed_point.hpp"
+#include "lux/pool.hpp"
+#include "lux/lx.hpp"
+#include "lux/tracing.hpp"
+#include "lux/replication.hpp"
+#if LUX_COROUTINES
+#include "lux/async_lx.hpp"
+#endif
 
 using namespace lux;
 
@@ -304,6 +329,62 @@ TEST(order_modification) {
     ASSERT_EQ(retrieved->price, Order::to_price(99.0));
 }
 
+// Test: Cancelling from the middle of a level keeps FIFO order intact
+TEST(cancel_preserves_fifo) {
+    OrderBook book(1);
+
+    for (uint64_t id = 1; id <= 3; ++id) {
+        Order sell = OrderBuilder()
+            .id(id).account(200).side(Side::Sell)
+            .type(OrderType::Limit).price(100.0).quantity(1.0)
+            .tif(TimeInForce::GTC).build();
+        book.place_order(sell);
+    }
+
+    ASSERT(book.cancel_order(2).has_value());
+    ASSERT(!book.cancel_order(2).has_value());
+    ASSERT_EQ(book.total_orders(), 2u);
+
+    Order buy = OrderBuilder()
+        .id(10).account(100).side(Side::Buy)
+        .type(OrderType::Limit).price(100.0).quantity(2.0)
+        .tif(TimeInForce::IOC).build();
+
+    auto trades = book.place_order(buy);
+    ASSERT_EQ(trades.size(), 2u);
+    ASSERT_EQ(trades[0].sell_order_id, 1u);
+    ASSERT_EQ(trades[1].sell_order_id, 3u);
+    ASSERT_EQ(book.ask_levels(), 0u);
+}
+
+// Test: Order nodes are recycled through the pool freelist
+TEST(order_pool_reuse) {
+    OrderBookConfig config;
+    config.initial_order_capacity = 64;
+    OrderBook book(1, config);
+    ASSERT_EQ(book.order_pool_capacity(), 64u);
+
+    for (int round = 0; round < 10; ++round) {
+        for (uint64_t i = 0; i < 50; ++i) {
+            Order buy = OrderBuilder()
+                .id(round * 100 + i + 1).account(100).side(Side::Buy)
+                .type(OrderType::Limit).price(90.0 + (i % 5)).quantity(1.0)
+                .tif(TimeInForce::GTC).build();
+            book.place_order(buy);
+        }
+        ASSERT_EQ(book.order_pool_in_use(), 50u);
+
+        for (uint64_t i = 0; i < 50; ++i) {
+            ASSERT(book.cancel_order(round * 100 + i + 1).has_value());
+        }
+        ASSERT_EQ(book.order_pool_in_use(), 0u);
+    }
+
+    // No growth beyond the initial reservation
+    ASSERT_EQ(book.order_pool_capacity(), 64u);
+    ASSERT_EQ(book.total_bid_quantity(), 0);
+}
+
 // Test: Market depth
 TEST(market_depth) {
     OrderBook book(1);
@@ -336,6 +417,395 @@ TEST(market_depth) {
     ASSERT_EQ(depth.asks[0].price, 101.0);
 }
 
+// Test: Tick ladder backend orders and matches like the map backend
+TEST(tick_ladder_book) {
+    OrderBookConfig config;
+    config.backend = BookBackend::TickLadder;
+    config.tick_size = Order::to_price(0.01);
+    config.ladder_ticks = 128;
+    OrderBook book(1, config);
+    ASSERT(book.backend() == BookBackend::TickLadder);
+
+    // In-window, far-away and off-grid bids
+    const double bid_prices[] = {100.00, 99.99, 99.50, 50.00, 100.005, 150.00};
+    uint64_t id = 1;
+    for (double px : bid_prices) {
+        Order buy = OrderBuilder()
+            .id(id++).account(100).side(Side::Buy)
+            .type(OrderType::Limit).price(px).quantity(1.0)
+            .tif(TimeInForce::GTC).build();
+        book.place_order(buy);
+    }
+    ASSERT_EQ(book.bid_levels(), 6u);
+    ASSERT_EQ(*book.best_bid(), Order::to_price(150.00));
+
+    auto depth = book.get_depth(10);
+    ASSERT_EQ(depth.bids.size(), 6u);
+    for (size_t i = 1; i < depth.bids.size(); ++i) {
+        ASSERT(depth.bids[i - 1].price > depth.bids[i].price);
+    }
+
+    // Sweep down to 99.99 across ladder and fallback levels
+    Order sell = OrderBuilder()
+        .id(100).account(200).side(Side::Sell)
+        .type(OrderType::Limit).price(99.99).quantity(3.5)
+        .tif(TimeInForce::GTC).build();
+    auto trades = book.place_order(sell);
+    ASSERT_EQ(trades.size(), 4u);
+    ASSERT_EQ(trades[0].price, Order::to_price(150.00));
+    ASSERT_EQ(trades[1].price, Order::to_price(100.005));
+    ASSERT_EQ(trades[2].price, Order::to_price(100.00));
+    ASSERT_EQ(trades[3].price, Order::to_price(99.99));
+    ASSERT_EQ(*book.best_bid(), Order::to_price(99.99));
+    ASSERT_EQ(book.total_bid_quantity(), Order::to_quantity(2.5));
+
+    // Cancel everything and re-anchor the window far away
+    ASSERT(book.cancel_order(2).has_value());
+    ASSERT(book.cancel_order(3).has_value());
+    ASSERT(book.cancel_order(4).has_value());
+    ASSERT(book.bid_levels() == 0u && !book.best_bid());
+
+    Order far_buy = OrderBuilder()
+        .id(200).account(100).side(Side::Buy)
+        .type(OrderType::Limit).price(2000.0).quantity(1.0)
+        .tif(TimeInForce::GTC).build();
+    book.place_order(far_buy);
+    ASSERT_EQ(*book.best_bid(), Order::to_price(2000.0));
+}
+
+// Test: Engine selects the book backend per symbol
+TEST(engine_book_backend) {
+    Engine engine;
+    OrderBookConfig ladder;
+    ladder.backend = BookBackend::TickLadder;
+    ladder.tick_size = Order::to_price(0.5);
+
+    ASSERT(engine.add_symbol(1));
+    ASSERT(engine.add_symbol(2, ladder));
+    ASSERT(!engine.add_symbol(2, ladder));
+    ASSERT(engine.get_orderbook(1)->backend() == BookBackend::Map);
+    ASSERT(engine.get_orderbook(2)->backend() == BookBackend::TickLadder);
+}
+
+// Test: L1 snapshot tracks the book and stays consistent under concurrent reads
+TEST(top_of_book_snapshot) {
+    OrderBook book(1);
+    ASSERT(!book.best_bid() && !book.best_ask() && !book.spread());
+
+    book.place_order(OrderBuilder().id(1).account(100).side(Side::Buy)
+        .type(OrderType::Limit).price(99.0).quantity(2.0).tif(TimeInForce::GTC).build());
+    book.place_order(OrderBuilder().id(2).account(100).side(Side::Buy)
+        .type(OrderType::Limit).price(99.0).quantity(3.0).tif(TimeInForce::GTC).build());
+    book.place_order(OrderBuilder().id(3).account(200).side(Side::Sell)
+        .type(OrderType::Limit).price(101.0).quantity(1.0).tif(TimeInForce::GTC).build());
+
+    L1Snapshot l1 = book.top_of_book();
+    ASSERT_EQ(l1.bid_price, Order::to_price(99.0));
+    ASSERT_EQ(l1.bid_quantity, Order::to_quantity(5.0));
+    ASSERT_EQ(l1.bid_orders, 2u);
+    ASSERT_EQ(l1.ask_price, Order::to_price(101.0));
+    ASSERT_EQ(l1.ask_orders, 1u);
+    ASSERT_EQ(l1.sequence, 3u);
+    ASSERT_EQ(*book.spread(), Order::to_price(2.0));
+
+    // Partial fill reduces the published size
+    book.place_order(OrderBuilder().id(4).account(200).side(Side::Sell)
+        .type(OrderType::Limit).price(99.0).quantity(1.5).tif(TimeInForce::IOC).build());
+    l1 = book.top_of_book();
+    ASSERT_EQ(l1.bid_quantity, Order::to_quantity(3.5));
+
+    ASSERT(book.cancel_order(3).has_value());
+    l1 = book.top_of_book();
+    ASSERT(!l1.has_ask());
+    ASSERT_EQ(l1.sequence, 5u);
+
+    // Readers must never observe a torn snapshot
+    ASSERT(book.cancel_order(1).has_value());
+    ASSERT(book.cancel_order(2).has_value());
+
+    std::atomic<bool> done{false};
+    std::atomic<bool> torn{false};
+    std::thread reader([&] {
+        while (!done.load()) {
+            L1Snapshot snap = book.top_of_book();
+            if (snap.has_bid() && snap.bid_quantity != Order::to_quantity(1.0) * snap.bid_orders) {
+                torn.store(true);
+            }
+        }
+    });
+    for (uint64_t id = 10; id < 2000; ++id) {
+        book.place_order(OrderBuilder().id(id).account(100).side(Side::Buy)
+            .type(OrderType::Limit).price(98.0).quantity(1.0).tif(TimeInForce::GTC).build());
+    }
+    done.store(true);
+    reader.join();
+    ASSERT(!torn.load());
+}
+
+// Test: L2 deltas applied to a snapshot reproduce the live book
+TEST(l2_delta_stream) {
+    struct Replica : BookUpdateListener {
+        std::map<std::pair<Side, Price>, std::pair<Quantity, uint32_t>> levels;
+        uint64_t last_sequence = 0;
+        bool gap = false;
+
+        void on_book_delta(uint64_t, const BookDelta& delta) override {
+            if (delta.sequence != last_sequence + 1) gap = true;
+            last_sequence = delta.sequence;
+            auto key = std::make_pair(delta.side, delta.price);
+            if (delta.order_count == 0) {
+                levels.erase(key);
+            } else {
+                levels[key] = {delta.quantity, delta.order_count};
+            }
+        }
+    };
+
+    OrderBook book(1);
+    book.place_order(OrderBuilder().id(1).account(100).side(Side::Buy)
+        .type(OrderType::Limit).price(99.0).quantity(1.0).tif(TimeInForce::GTC).build());
+
+    // Seed the replica from a snapshot, then follow deltas
+    Replica replica;
+    book.add_update_listener(&replica);
+    L2Snapshot snap = book.get_l2_snapshot();
+    replica.last_sequence = snap.sequence;
+    for (const auto& level : snap.bids) {
+        replica.levels[{Side::Buy, level.price}] = {level.quantity, level.order_count};
+    }
+
+    book.place_order(OrderBuilder().id(2).account(100).side(Side::Buy)
+        .type(OrderType::Limit).price(99.0).quantity(2.0).tif(TimeInForce::GTC).build());
+    book.place_order(OrderBuilder().id(3).account(100).side(Side::Buy)
+        .type(OrderType::Limit).price(98.0).quantity(1.0).tif(TimeInForce::GTC).build());
+    book.place_order(OrderBuilder().id(4).account(200).side(Side::Sell)
+        .type(OrderType::Limit).price(101.0).quantity(1.0).tif(TimeInForce::GTC).build());
+
+    // Sweep 99.0 fully and part of 98.0
+    uint64_t before = book.delta_sequence();
+    book.place_order(OrderBuilder().id(5).account(200).side(Side::Sell)
+        .type(OrderType::Limit).price(98.0).quantity(3.5).tif(TimeInForce::GTC).build());
+    ASSERT_EQ(book.delta_sequence() - before, 2u);  // One delta per touched level
+
+    book.modify_order(4, Order::to_price(100.0), Order::to_quantity(1.0));
+    book.cancel_order(3);
+
+    ASSERT(!replica.gap);
+    L2Snapshot live = book.get_l2_snapshot();
+    ASSERT_EQ(live.sequence, replica.last_sequence);
+    ASSERT_EQ(replica.levels.size(), live.bids.size() + live.asks.size());
+    for (const auto& level : live.bids) {
+        auto it = replica.levels.find({Side::Buy, level.price});
+        ASSERT(it != replica.levels.end());
+        ASSERT_EQ(it->second.first, level.quantity);
+        ASSERT_EQ(it->second.second, level.order_count);
+    }
+    for (const auto& level : live.asks) {
+        auto it = replica.levels.find({Side::Sell, level.price});
+        ASSERT(it != replica.levels.end());
+        ASSERT_EQ(it->second.first, level.quantity);
+    }
+
+    book.remove_update_listener(&replica);
+    uint64_t last = replica.last_sequence;
+    book.cancel_order(4);
+    ASSERT_EQ(replica.last_sequence, last);
+}
+
+// Test: Fills go into a caller-owned buffer that is reused across orders
+TEST(caller_trade_buffer) {
+    OrderBook book(1);
+    std::vector<Trade> fills;
+    fills.reserve(16);
+    const Trade* storage = fills.data();
+
+    for (uint64_t round = 0; round < 100; ++round) {
+        for (uint64_t i = 0; i < 4; ++i) {
+            book.place_order(OrderBuilder().id(round * 10 + i + 1).account(200).side(Side::Sell)
+                .type(OrderType::Limit).price(100.0 + i).quantity(1.0)
+                .tif(TimeInForce::GTC).build());
+        }
+
+        fills.clear();
+        size_t count = book.place_order(OrderBuilder().id(round * 10 + 9).account(100)
+            .side(Side::Buy).type(OrderType::Market).quantity(4.0)
+            .tif(TimeInForce::IOC).build(), fills).trades;
+        ASSERT_EQ(count, 4u);
+        ASSERT_EQ(fills.size(), 4u);
+        ASSERT_EQ(fills[3].price, Order::to_price(103.0));
+    }
+    ASSERT(fills.data() == storage);  // Never reallocated
+
+    // Engine overload appends and leaves OrderResult::trades empty
+    Engine engine;
+    engine.add_symbol(1);
+    Order sell = OrderBuilder().id(1000).symbol(1).account(200).side(Side::Sell)
+        .type(OrderType::Limit).price(100.0).quantity(2.0).tif(TimeInForce::GTC).build();
+    engine.place_order(sell);
+
+    fills.clear();
+    fills.push_back(Trade{});
+    Order buy = OrderBuilder().id(1001).symbol(1).account(100).side(Side::Buy)
+        .type(OrderType::Limit).price(100.0).quantity(2.0).tif(TimeInForce::GTC).build();
+    OrderResult result = engine.place_order(buy, fills);
+    ASSERT(result.success);
+    ASSERT(result.trades.empty());
+    ASSERT_EQ(fills.size(), 2u);
+    ASSERT_EQ(fills[1].sell_order_id, 1000u);
+    ASSERT_EQ(engine.get_stats().total_trades, 1u);
+}
+
+// Test: GTD / DAY orders expire through the timing wheel
+TEST(order_expiry) {
+    // Wheel: fires in deadline order across levels and the overflow list
+    TimerWheel<int> wheel(0);
+    for (uint64_t deadline : {70000ull, 5ull, 300ull, (1ull << 33) + 7}) {
+        wheel.schedule(deadline, static_cast<int>(deadline % 1000));
+    }
+    std::vector<int> fired;
+    auto collect = [&](int value) { fired.push_back(value); };
+    ASSERT_EQ(wheel.advance(4, collect), 0u);
+    ASSERT_EQ(wheel.advance(5, collect), 1u);
+    ASSERT_EQ(wheel.advance(70000, collect), 2u);
+    ASSERT_EQ(wheel.advance(1ull << 33, collect), 0u);
+    ASSERT_EQ(wheel.advance((1ull << 33) + 7, collect), 1u);
+    ASSERT(fired == std::vector<int>({5, 300, 0, 599}));
+    ASSERT(wheel.empty());
+
+    struct CancelCounter : NullTradeListener {
+        int expired = 0;
+        void on_order_cancelled(const Order& order) override {
+            expired += order.status == OrderStatus::Expired;
+        }
+    } listener;
+
+    Engine engine;
+    engine.add_symbol(1);
+    engine.set_trade_listener(&listener);
+
+    using std::chrono::hours;
+    using std::chrono::seconds;
+    auto order = [](uint64_t id, TimeInForce tif, Timestamp placed, Timestamp expires) {
+        Order o = OrderBuilder().id(id).symbol(1).account(1).side(Side::Buy)
+            .type(OrderType::Limit).price(100.0 - static_cast<double>(id)).quantity(1.0)
+            .tif(tif).build();
+        o.timestamp = placed;
+        o.expire_time = expires;
+        return o;
+    };
+    engine.place_order(order(1, TimeInForce::GTD, hours(1), hours(2)));
+    engine.place_order(order(2, TimeInForce::GTD, hours(1), hours(3)));
+    engine.place_order(order(3, TimeInForce::DAY, hours(10), Timestamp{0}));  // End of day
+    engine.place_order(order(4, TimeInForce::GTC, hours(1), hours(2)));
+    engine.place_order(order(5, TimeInForce::GTD, hours(1), Timestamp{0}));   // Never
+    engine.cancel_order(1, 2);  // Leaves a stale wheel entry
+
+    OrderBook* book = engine.get_orderbook(1);
+    ASSERT_EQ(book->pending_expiries(), 3u);
+    ASSERT_EQ(engine.expire_orders(hours(2) - seconds(1)), 0u);
+    ASSERT_EQ(engine.expire_orders(hours(2)), 1u);
+    ASSERT(!engine.get_order(1, 1).has_value());
+    ASSERT_EQ(engine.expire_orders(hours(23)), 0u);  // Stale entry skipped
+    ASSERT_EQ(engine.expire_orders(hours(24)), 1u);
+    ASSERT_EQ(book->pending_expiries(), 0u);
+    ASSERT_EQ(book->total_orders(), 2u);
+    ASSERT_EQ(listener.expired, 2);
+    ASSERT_EQ(engine.get_stats().total_orders_cancelled, 3u);
+}
+
+// Test: frequent batch auction uncross
+TEST(orderbook_batch_auction) {
+    struct BatchCounter : NullTradeListener {
+        int batches = 0;
+        size_t trades = 0;
+        void on_trade_batch(const Trade*, size_t count) override {
+            ++batches;
+            trades += count;
+        }
+    };
+
+    auto limit = [](uint64_t id, Side side, double price, double quantity) {
+        Order o = OrderBuilder().id(id).symbol(1).account(id).side(side)
+            .type(OrderType::Limit).price(price).quantity(quantity)
+            .tif(TimeInForce::GTC).build();
+        o.timestamp = Timestamp{static_cast<int64_t>(id)};
+        return o;
+    };
+    auto fill_book = [&](OrderBook& book, TradeListener* listener) {
+        book.place_order(limit(1, Side::Buy, 101.0, 2.0), listener);
+        book.place_order(limit(2, Side::Buy, 100.0, 3.0), listener);
+        book.place_order(limit(3, Side::Buy, 100.0, 1.0), listener);
+        book.place_order(limit(4, Side::Buy, 99.0, 1.0), listener);
+        book.place_order(limit(5, Side::Sell, 98.0, 1.0), listener);
+        book.place_order(limit(6, Side::Sell, 100.0, 2.0), listener);
+        book.place_order(limit(7, Side::Sell, 100.0, 2.0), listener);
+        book.place_order(limit(8, Side::Sell, 102.0, 5.0), listener);
+    };
+
+    OrderBookConfig config;
+    config.matching = MatchingMode::BatchAuction;
+
+    // Demand at 100 is 6, supply 5: 100 clears the most volume
+    {
+        OrderBook book(1, config);
+        BatchCounter listener;
+        fill_book(book, &listener);
+        ASSERT_EQ(book.total_orders(), 8u);
+        ASSERT(book.best_bid() == Order::to_price(101.0));
+
+        Order ioc = limit(9, Side::Sell, 90.0, 1.0);
+        ioc.tif = TimeInForce::IOC;
+        ASSERT(book.place_order(ioc, &listener).empty());
+        ASSERT_EQ(book.total_orders(), 8u);
+
+        std::vector<Trade> trades;
+        ASSERT_EQ(book.uncross(trades, &listener), trades.size());
+        Quantity volume = 0;
+        for (const Trade& trade : trades) {
+            ASSERT(trade.price == Order::to_price(100.0));
+            volume += trade.quantity;
+        }
+        ASSERT(volume == Order::to_quantity(5.0));
+        ASSERT_EQ(listener.batches, 1);
+        ASSERT_EQ(listener.trades, trades.size());
+        ASSERT(book.last_auction_price() == Order::to_price(100.0));
+
+        // Time priority: the earlier order at 100 takes the remaining 3
+        ASSERT(!book.get_order(2).has_value());
+        ASSERT(book.get_order(3)->filled == 0);
+        ASSERT(book.best_bid() == Order::to_price(100.0));
+        ASSERT(book.best_ask() == Order::to_price(102.0));
+        ASSERT_EQ(book.uncross(trades, &listener), 0u);
+    }
+
+    // Pro rata: 3 lots shared 3:1 at the marginal level
+    {
+        config.allocation = AuctionAllocation::ProRata;
+        OrderBook book(1, config);
+        fill_book(book, nullptr);
+        std::vector<Trade> trades;
+        book.uncross(trades, nullptr);
+        ASSERT(book.get_order(2)->filled == Order::to_quantity(2.25));
+        ASSERT(book.get_order(3)->filled == Order::to_quantity(0.75));
+    }
+
+    // The engine uncrosses on the interval grid
+    {
+        config.auction_interval = std::chrono::seconds(1);
+        Engine engine;
+        engine.add_symbol(1, config);
+        using std::chrono::milliseconds;
+        engine.place_order(limit(1, Side::Buy, 100.0, 1.0));
+        engine.place_order(limit(2, Side::Sell, 100.0, 1.0));
+        ASSERT_EQ(engine.run_auctions(milliseconds(10200)), 1u);
+        engine.place_order(limit(3, Side::Buy, 100.0, 1.0));
+        engine.place_order(limit(4, Side::Sell, 100.0, 1.0));
+        ASSERT_EQ(engine.run_auctions(milliseconds(10900)), 0u);
+        ASSERT_EQ(engine.run_auctions(milliseconds(11000)), 1u);
+        ASSERT_EQ(engine.get_stats().total_trades, 2u);
+    }
+}
+
 // Test: Engine multi-symbol
 TEST(engine_multi_symbol) {
     Engine engine;
@@ -376,6 +846,1279 @@ TEST(engine_multi_symbol) {
     ASSERT_EQ(order2->symbol_id, 2u);
 }
 
+// Test: Sharded engine routes each symbol to its owning worker
+TEST(engine_sharded_mode) {
+    EngineConfig config;
+    config.sharded_mode = true;
+    config.shard_count = 2;
+    config.pin_shards = false;
+    config.shard_ring_capacity = 256;
+    Engine engine(config);
+
+    for (uint64_t sym = 1; sym <= 4; ++sym) {
+        ASSERT(engine.add_symbol(sym));
+        ASSERT(!engine.get_orderbook(sym)->thread_safe());
+    }
+    ASSERT_EQ(engine.shard_count(), 2u);
+    ASSERT(*engine.shard_of(1) != *engine.shard_of(2));
+
+    std::atomic<uint64_t> completed{0};
+    std::atomic<uint64_t> fills{0};
+    engine.set_completion_handler([&](const OrderResult& result) {
+        ASSERT(result.success);
+        fills.fetch_add(result.trades.size());
+        completed.fetch_add(1);
+    });
+    engine.start();
+
+    // Synchronous mutators are refused while shards own the books
+    ASSERT(!engine.place_order(OrderBuilder().id(1).symbol(1).side(Side::Buy)
+        .type(OrderType::Limit).price(1.0).quantity(1.0).build()).success);
+
+    const uint64_t per_symbol = 500;
+    uint64_t submitted = 0;
+    for (uint64_t i = 0; i < per_symbol; ++i) {
+        for (uint64_t sym = 1; sym <= 4; ++sym) {
+            BatchOrder action{};
+            action.action = BatchOrder::Action::Place;
+            action.order = OrderBuilder().id(OrderIdGenerator::instance().next())
+                .symbol(sym).account(i % 2 ? 100 : 200)
+                .side(i % 2 ? Side::Buy : Side::Sell)
+                .type(OrderType::Limit).price(100.0).quantity(1.0)
+                .tif(TimeInForce::GTC).build();
+            while (!engine.submit(action)) {
+                std::this_thread::yield();
+            }
+            ++submitted;
+        }
+    }
+
+    // Book walks would race the shards; L1 reads come from the seqlock
+    ASSERT(!engine.get_order(1, 1).has_value());
+    ASSERT(engine.get_depth(1).bids.empty() && engine.get_depth(1).asks.empty());
+    L2Snapshot l2;
+    ASSERT(!engine.get_l2_snapshot(1, 10, l2));
+    (void)engine.best_bid(1);
+
+    engine.stop();
+    ASSERT_EQ(completed.load(), submitted);
+    ASSERT_EQ(fills.load(), 4 * per_symbol / 2);
+    ASSERT_EQ(engine.get_stats().total_trades, 4 * per_symbol / 2);
+    for (uint64_t sym = 1; sym <= 4; ++sym) {
+        ASSERT_EQ(engine.get_orderbook(sym)->total_orders(), 0u);
+    }
+}
+
+// Test: Async submissions complete through the pollable completion queue
+TEST(symbol_directory) {
+    SymbolDirectory<int> directory(16);
+    std::vector<int> values(2000);
+    for (int i = 0; i < 2000; ++i) {
+        ASSERT(directory.insert(static_cast<uint64_t>(i) << 20, &values[i]));
+    }
+    ASSERT(!directory.insert(0, &values[0]));
+    ASSERT_EQ(directory.size(), 2000u);
+    for (int i = 0; i < 2000; ++i) {
+        ASSERT_EQ(directory.find(static_cast<uint64_t>(i) << 20), &values[i]);
+    }
+    ASSERT(directory.find(1) == nullptr);
+
+    ASSERT_EQ(directory.erase(5u << 20), &values[5]);
+    ASSERT(directory.find(5u << 20) == nullptr);
+    ASSERT(directory.insert(5u << 20, &values[6]));
+    ASSERT_EQ(directory.find(5u << 20), &values[6]);
+
+    // Lookups stay valid while symbols are added concurrently
+    Engine engine;
+    engine.add_symbol(1);
+    std::atomic<bool> done{false};
+    std::thread reader([&] {
+        while (!done.load()) {
+            ASSERT(engine.has_symbol(1));
+            ASSERT(engine.get_orderbook(1) != nullptr);
+        }
+    });
+    for (uint64_t symbol = 2; symbol < 500; ++symbol) {
+        engine.add_symbol(symbol);
+    }
+    for (uint64_t symbol = 2; symbol < 500; symbol += 2) {
+        ASSERT(engine.remove_symbol(symbol));
+    }
+    done = true;
+    reader.join();
+    ASSERT_EQ(engine.symbols().size(), 250u);
+    ASSERT(!engine.has_symbol(2));
+    ASSERT(engine.has_symbol(3));
+}
+
+TEST(engine_parallel_batch) {
+    std::vector<BatchOrder> batch;
+    uint64_t next_id = 1;
+    for (int round = 0; round < 50; ++round) {
+        for (uint64_t symbol = 1; symbol <= 5; ++symbol) {  // Symbol 5 is unknown
+            BatchOrder action{};
+            action.action = BatchOrder::Action::Place;
+            action.order = OrderBuilder().id(next_id++).symbol(symbol)
+                .account(round % 2 ? 100 : 200)
+                .side(round % 2 ? Side::Buy : Side::Sell)
+                .type(OrderType::Limit).price(50.0 + (round % 3)).quantity(1.0)
+                .tif(TimeInForce::GTC).build();
+            batch.push_back(action);
+        }
+        if (round % 10 == 9) {
+            BatchOrder cancel{};
+            cancel.action = BatchOrder::Action::Cancel;
+            cancel.order.symbol_id = 1;
+            cancel.order_id = next_id - 5;
+            batch.push_back(cancel);
+        }
+    }
+
+    EngineConfig config;
+    config.parallel_batch = true;
+    config.batch_threads = 4;
+    Engine parallel(config);
+    Engine sequential;
+    for (uint64_t symbol = 1; symbol <= 4; ++symbol) {
+        parallel.add_symbol(symbol);
+        sequential.add_symbol(symbol);
+    }
+
+    auto par = parallel.process_batch(batch);
+    auto seq = sequential.process_batch(batch);
+
+    // Results follow batch order, with or without the pool
+    size_t place_index = 0;
+    for (const auto& action : batch) {
+        if (action.action == BatchOrder::Action::Place) {
+            const auto& result = par.order_results[place_index];
+            ASSERT_EQ(result.order_id, action.order.id);
+            ASSERT_EQ(result.success, action.order.symbol_id != 5);
+            ASSERT_EQ(seq.order_results[place_index].order_id, action.order.id);
+            ++place_index;
+        }
+    }
+    ASSERT_EQ(place_index, par.order_results.size());
+    ASSERT_EQ(place_index, seq.order_results.size());
+    ASSERT_EQ(par.cancel_results.size(), seq.cancel_results.size());
+    ASSERT_EQ(par.all_trades.size(), seq.all_trades.size());
+
+    // Per-symbol execution matches the sequential engine
+    for (uint64_t symbol = 1; symbol <= 4; ++symbol) {
+        ASSERT(parallel.best_bid(symbol) == sequential.best_bid(symbol));
+        ASSERT(parallel.best_ask(symbol) == sequential.best_ask(symbol));
+    }
+    ASSERT_EQ(parallel.get_stats().total_trades, sequential.get_stats().total_trades);
+}
+
+TEST(journal_replay) {
+    const std::string path = "/tmp/luxdex_test_journal_" + std::to_string(::getpid());
+    std::remove(path.c_str());
+
+    // Group commit: readers only see committed records
+    {
+        JournalConfig config;
+        config.commit_interval = 0;
+        config.growth_records = 2;  // Force remapping
+        auto journal = Journal::open(path, config);
+        ASSERT(journal != nullptr);
+        JournalRecord record{};
+        record.type = JournalRecordType::Cancel;
+        for (int i = 0; i < 3; ++i) journal->append(record);
+        journal->commit();
+        journal->append(record);
+        ASSERT_EQ(JournalReader::open(path)->size(), 3u);
+        ASSERT_EQ(journal->last_sequence(), 4u);
+    }
+    ASSERT_EQ(JournalReader::open(path)->size(), 4u);  // Closing commits
+    std::remove(path.c_str());
+
+    Engine::Stats live_stats{};
+    std::optional<Price> live_bid, live_ask;
+    {
+        EngineConfig config;
+        config.journal_path = path;
+        Engine engine(config);
+        engine.add_symbol(1);
+        engine.add_symbol(2);
+        for (uint64_t i = 0; i < 40; ++i) {
+            engine.place_order(OrderBuilder().id(100 + i).symbol(1 + i % 2)
+                .account(i % 3 ? 100 : 200).side(i % 3 ? Side::Buy : Side::Sell)
+                .type(OrderType::Limit).price(100.0 + static_cast<double>(i % 5)).quantity(3.0)
+                .tif(TimeInForce::GTC).build());
+        }
+        engine.cancel_order(1, 104);
+        engine.modify_order(2, 107, Order::to_price(101.0), Order::to_quantity(1.0));
+        live_stats = engine.get_stats();
+        live_bid = engine.best_bid(1);
+        live_ask = engine.best_ask(2);
+    }
+
+    Engine replayed;
+    ASSERT_EQ(replayed.replay_journal(path), 44u);
+    ASSERT(replayed.best_bid(1) == live_bid);
+    ASSERT(replayed.best_ask(2) == live_ask);
+    ASSERT_EQ(replayed.get_stats().total_trades, live_stats.total_trades);
+    ASSERT_EQ(replayed.get_stats().total_volume, live_stats.total_volume);
+    ASSERT(!replayed.get_order(1, 104).has_value());
+
+    // Recover in place and keep journaling to the same file
+    {
+        EngineConfig config;
+        config.journal_path = path;
+        Engine engine(config);
+        ASSERT_EQ(engine.replay_journal(path), 44u);
+        engine.cancel_order(2, 107);
+    }
+    ASSERT_EQ(JournalReader::open(path)->size(), 45u);
+
+    // Mark records feed full-stack replays; the engine skips them
+    {
+        auto journal = Journal::open(path);
+        ASSERT(journal != nullptr);
+        JournalRecord mark{};
+        mark.type = JournalRecordType::Mark;
+        mark.symbol_id = 1;
+        mark.new_price = Order::to_price(50.0);
+        journal->append(mark);
+    }
+    Engine marked;
+    ASSERT_EQ(marked.replay_journal(path), 45u);
+    ASSERT(marked.best_bid(1) == live_bid);
+    std::remove(path.c_str());
+
+    // Sharded engines journal per shard
+    {
+        EngineConfig config;
+        config.sharded_mode = true;
+        config.shard_count = 2;
+        config.pin_shards = false;
+        config.journal_path = path;
+        Engine engine(config);
+        engine.add_symbol(1);
+        engine.add_symbol(2);
+        engine.start();
+        for (uint64_t i = 0; i < 20; ++i) {
+            BatchOrder action{};
+            action.action = BatchOrder::Action::Place;
+            action.order = OrderBuilder().id(500 + i).symbol(1 + i % 2).account(100)
+                .side(Side::Buy).type(OrderType::Limit).price(90.0 + static_cast<double>(i))
+                .quantity(1.0).tif(TimeInForce::GTC).build();
+            while (!engine.submit(action)) {}
+        }
+        engine.stop();
+    }
+    Engine sharded_replay;
+    ASSERT_EQ(sharded_replay.replay_journal(path), 22u);
+    ASSERT(sharded_replay.best_bid(1) == Order::to_price(108.0));
+    ASSERT(sharded_replay.best_bid(2) == Order::to_price(109.0));
+    std::remove(path.c_str());
+    std::remove((path + ".0").c_str());
+    std::remove((path + ".1").c_str());
+}
+
+TEST(conflated_market_data) {
+    const std::string path = "/tmp/luxdex_test_mktdata_" + std::to_string(::getpid());
+
+    // On change: every callback republishes the market it touched
+    {
+        EngineConfig config;
+        config.market_data_path = path;
+        Engine engine(config);
+        engine.add_symbol(1);
+        engine.add_symbol(2);
+        auto reader = MarketDataReader::open(path);
+        ASSERT(reader != nullptr);
+
+        for (uint64_t i = 0; i < 12; ++i) {
+            engine.place_order(OrderBuilder().id(1 + i).symbol(1).side(Side::Buy)
+                .type(OrderType::Limit).price(100.0 - static_cast<double>(i)).quantity(1.0).build());
+        }
+        engine.place_order(OrderBuilder().id(50).symbol(1).side(Side::Sell)
+            .type(OrderType::Limit).price(101.0).quantity(2.0).build());
+        engine.place_order(OrderBuilder().id(51).symbol(1).side(Side::Sell)
+            .type(OrderType::Limit).price(100.0).quantity(0.5).build());
+        engine.market_data()->on_price(1, PriceType::MARK, x18::from_int(100));
+
+        MarketSnapshot snapshot{};
+        ASSERT(reader->read_symbol(1, snapshot));
+        ASSERT_EQ(snapshot.symbol_id, 1u);
+        ASSERT_EQ(snapshot.bid_count, static_cast<uint32_t>(MARKET_DATA_LEVELS));
+        ASSERT_EQ(snapshot.bids[0].price, Order::to_price(100.0));
+        ASSERT_EQ(snapshot.bids[0].quantity, Order::to_quantity(0.5));
+        ASSERT_EQ(snapshot.bids[1].price, Order::to_price(99.0));
+        ASSERT_EQ(snapshot.ask_count, 1u);
+        ASSERT_EQ(snapshot.asks[0].price, Order::to_price(101.0));
+        ASSERT_EQ(snapshot.trade_count, 1u);
+        ASSERT_EQ(snapshot.last_trade_price, Order::to_price(100.0));
+        ASSERT_EQ(snapshot.volume, Order::to_quantity(0.5));
+        ASSERT(snapshot.mark_x18 == x18::from_int(100));
+        ASSERT_EQ(snapshot.book_sequence, engine.get_orderbook(1)->delta_sequence());
+        ASSERT(!reader->read_symbol(2, snapshot));     // Nothing published yet
+
+        const MarketDataPublisher::Stats stats = engine.market_data()->get_stats();
+        ASSERT_EQ(stats.publications, snapshot.version);
+        ASSERT_EQ(stats.unpublished, 0u);
+    }
+
+    // On a cadence: bursts conflate into one encode per market
+    {
+        EngineConfig config;
+        config.market_data_path = path;
+        config.market_data.interval = std::chrono::microseconds(std::chrono::hours(1));
+        config.market_data.levels = 3;
+        Engine engine(config);
+        engine.add_symbol(7);
+        for (uint64_t i = 0; i < 100; ++i) {
+            engine.place_order(OrderBuilder().id(1 + i).symbol(7).side(Side::Sell)
+                .type(OrderType::Limit).price(200.0 + static_cast<double>(i % 20)).quantity(1.0).build());
+        }
+        auto reader = MarketDataReader::open(path);
+        MarketSnapshot snapshot{};
+        ASSERT_EQ(reader->markets(), 1u);
+        ASSERT(!reader->read(0, snapshot));
+        engine.market_data()->flush();
+        ASSERT(reader->read(0, snapshot));
+        ASSERT_EQ(snapshot.version, 1u);
+        ASSERT_EQ(snapshot.ask_count, 3u);
+        ASSERT_EQ(snapshot.asks[2].price, Order::to_price(202.0));
+        ASSERT_EQ(snapshot.asks[2].quantity, Order::to_quantity(5.0));
+        const MarketDataPublisher::Stats stats = engine.market_data()->get_stats();
+        ASSERT_EQ(stats.updates, 100u);
+        ASSERT_EQ(stats.publications, 1u);
+    }
+    std::remove(path.c_str());
+}
+
+TEST(event_ring_feed) {
+    const std::string path = "/tmp/luxdex_test_events_" + std::to_string(::getpid());
+
+    // Readers that fall more than a ring behind are told what they lost
+    {
+        auto ring = EventRing::create(path, 4);
+        ASSERT(ring != nullptr);
+        auto reader = EventRingReader::open(path);
+        ASSERT(reader != nullptr);
+        for (uint64_t i = 0; i < 10; ++i) {
+            EventRecord record{};
+            record.type = EventType::Trade;
+            record.trade.trade_id = i + 1;
+            ring->publish(record);
+        }
+        EventRecord out[16];
+        uint64_t cursor = 0, missed = 0;
+        ASSERT_EQ(reader->poll(cursor, out, 16, &missed), 4u);
+        ASSERT_EQ(missed, 6u);
+        ASSERT_EQ(out[0].sequence, 7u);
+        ASSERT_EQ(out[3].trade.trade_id, 10u);
+        ASSERT_EQ(cursor, 10u);
+        ASSERT_EQ(reader->poll(cursor, out, 16, &missed), 0u);
+    }
+
+    struct CountingListener : NullTradeListener {
+        int trades = 0;
+        void on_trade(const Trade&) override { ++trades; }
+    } listener;
+
+    EngineConfig config;
+    config.event_ring_path = path;
+    config.event_ring_capacity = 1024;
+    Engine engine(config);
+    engine.set_trade_listener(&listener);
+    engine.add_symbol(1);
+    auto reader = EventRingReader::open(path);
+    ASSERT(reader != nullptr);
+
+    engine.place_order(OrderBuilder().id(1).symbol(1).account(1).side(Side::Sell)
+        .type(OrderType::Limit).price(100.0).quantity(2.0).tif(TimeInForce::GTC).build());
+    engine.place_order(OrderBuilder().id(2).symbol(1).account(2).side(Side::Buy)
+        .type(OrderType::Limit).price(100.0).quantity(1.0).tif(TimeInForce::GTC).build());
+    engine.cancel_order(1, 1);
+    ASSERT_EQ(listener.trades, 1);
+
+    EventRecord events[64];
+    uint64_t cursor = 0;
+    const size_t count = reader->poll(cursor, events, 64);
+    ASSERT_EQ(cursor, engine.event_ring()->head());
+
+    int trades = 0, cancels = 0;
+    uint64_t last_delta = 0;
+    Quantity last_level = -1;
+    for (size_t i = 0; i < count; ++i) {
+        const EventRecord& event = events[i];
+        ASSERT_EQ(event.sequence, i + 1);
+        ASSERT_EQ(event.symbol_id, 1u);
+        if (event.type == EventType::Trade) {
+            ++trades;
+            ASSERT_EQ(event.trade.price, Order::to_price(100.0));
+            ASSERT_EQ(event.trade.quantity, Order::to_quantity(1.0));
+            ASSERT_EQ(event.side, static_cast<uint8_t>(Side::Buy));
+        } else if (event.type == EventType::OrderCancelled) {
+            ++cancels;
+            ASSERT_EQ(event.order.order_id, 1u);
+            ASSERT_EQ(event.order.filled, Order::to_quantity(1.0));
+        } else if (event.type == EventType::BookDelta) {
+            ASSERT_EQ(event.delta.book_sequence, last_delta + 1);
+            last_delta = event.delta.book_sequence;
+            last_level = event.delta.quantity;
+        }
+    }
+    ASSERT_EQ(trades, 1);
+    ASSERT_EQ(cancels, 1);
+    ASSERT(last_delta >= 2);  // Ask level added, then removed by the cancel
+    ASSERT_EQ(last_level, 0);
+
+    std::remove(path.c_str());
+}
+
+// Test: refused orders return a code, and timestamps come from the engine
+// clock, so a replay reproduces them
+TEST(engine_clock_replay) {
+    OrderBook book(1);
+    std::vector<Trade> fills;
+    Order bad = OrderBuilder().id(1).symbol(1).side(Side::Buy).type(OrderType::Limit)
+        .price(100.0).quantity(1.0).build();
+    bad.quantity = 0;
+    PlaceOutcome outcome = book.place_order(bad, fills);
+    ASSERT(!outcome && outcome.error == PlaceError::InvalidQuantity);
+    bad.quantity = Order::to_quantity(1.0);
+    bad.price = 0;
+    ASSERT(book.place_order(bad).empty());
+    ASSERT_EQ(book.total_orders(), 0u);
+
+    TscClock tsc;
+    const Timestamp first = tsc.now();
+    const Timestamp drift = first - SystemClock::instance().now();
+    ASSERT(drift < std::chrono::milliseconds(50) && drift > -std::chrono::milliseconds(50));
+    ASSERT(tsc.now() >= first);
+
+    auto clock = std::make_shared<ManualClock>(Timestamp(1000));
+    book.set_clock(clock.get());
+    Order bid = OrderBuilder().id(2).symbol(1).side(Side::Buy).type(OrderType::Limit)
+        .price(100.0).quantity(1.0).build();
+    bid.timestamp = Timestamp(0);
+    ASSERT(book.place_order(bid, fills) && fills.empty());
+    ASSERT(book.get_order(2)->timestamp == Timestamp(1000));
+    clock->advance(Timestamp(500));
+    Order ask = bid;
+    ask.id = 3;
+    ask.side = Side::Sell;
+    ASSERT_EQ(book.place_order(ask, fills).trades, 1u);
+    ASSERT(fills[0].timestamp == Timestamp(1500));
+
+    const std::string path = "/tmp/luxdex_test_clock_" + std::to_string(::getpid());
+    std::remove(path.c_str());
+
+    struct TradeTimes : NullTradeListener {
+        std::vector<Timestamp> times;
+        void on_trade(const Trade& trade) override { times.push_back(trade.timestamp); }
+    };
+    TradeTimes live;
+    {
+        EngineConfig config;
+        config.journal_path = path;
+        config.clock = clock;
+        Engine engine(config);
+        engine.set_trade_listener(&live);
+        engine.add_symbol(1);
+
+        bad.id = 10;
+        OrderResult refused = engine.place_order(bad);
+        ASSERT(!refused.success && refused.error == "Invalid price");
+
+        for (uint64_t i = 0; i < 6; ++i) {
+            clock->advance(Timestamp(100));
+            Order order = OrderBuilder().id(20 + i).symbol(1)
+                .side(i % 2 ? Side::Sell : Side::Buy).type(OrderType::Limit)
+                .price(100.0).quantity(1.0).build();
+            order.timestamp = Timestamp(0);
+            ASSERT(engine.place_order(order).success);
+        }
+        ASSERT_EQ(live.times.size(), 3u);
+        ASSERT(live.times[0] == Timestamp(1700));
+    }
+
+    // Replayed on the system clock, the books still see the journaled times
+    TradeTimes replayed;
+    Engine engine;
+    engine.set_trade_listener(&replayed);
+    ASSERT(engine.replay_journal(path) > 0);
+    ASSERT(replayed.times == live.times);
+    std::remove(path.c_str());
+}
+
+// Test: a mass quote journals the time its book used, so replay matches
+TEST(mass_quote_clock_replay) {
+    const std::string path = "/tmp/luxdex_test_quote_clock_" + std::to_string(::getpid());
+    std::remove(path.c_str());
+
+    MassQuoteRequest request{};
+    request.prototype.symbol_id = 1;
+    request.prototype.account_id = 7;
+    request.prototype.type = OrderType::Limit;
+    request.prototype.tif = TimeInForce::GTC;
+    request.prototype.timestamp = Timestamp(0);
+    std::vector<QuoteOutcome> outcomes(2);
+    std::vector<Trade> fills;
+
+    auto clock = std::make_shared<ManualClock>(Timestamp(1000));
+    {
+        EngineConfig config;
+        config.journal_path = path;
+        config.clock = clock;
+        Engine engine(config);
+        engine.add_symbol(1);
+
+        const QuoteLevel first[] = {{Side::Buy, Order::to_price(99.0), Order::to_quantity(1.0), 100},
+                                    {Side::Sell, Order::to_price(101.0), Order::to_quantity(1.0), 101}};
+        request.levels = first;
+        request.level_count = 2;
+        ASSERT_EQ(engine.mass_quote(1, request, outcomes.data(), fills)->placed, 2u);
+
+        // The bid grows and is requeued; the ask is cancelled
+        clock->advance(Timestamp(500));
+        const uint64_t resting[] = {100, 101};
+        const QuoteLevel second[] = {{Side::Buy, Order::to_price(99.0), Order::to_quantity(2.0), 102}};
+        request.resting = resting;
+        request.resting_count = 2;
+        request.levels = second;
+        request.level_count = 1;
+        MassQuoteSummary summary = *engine.mass_quote(1, request, outcomes.data(), fills);
+        ASSERT_EQ(summary.requeued, 1u);
+        ASSERT_EQ(summary.cancelled, 1u);
+        ASSERT(engine.get_order(1, 100)->timestamp == Timestamp(1500));
+    }
+
+    // Replayed on the system clock, the requeue keeps its journaled time
+    Engine replayed;
+    ASSERT_EQ(replayed.replay_journal(path), 5u);
+    ASSERT(replayed.get_order(1, 100)->timestamp == Timestamp(1500));
+    ASSERT(!replayed.get_order(1, 101).has_value());
+    std::remove(path.c_str());
+}
+
+// Test: a resting id listed twice is cancelled or adjusted once
+TEST(mass_quote_repeated_ids) {
+    Engine engine;
+    engine.add_symbol(1);
+
+    MassQuoteRequest request{};
+    request.prototype.symbol_id = 1;
+    request.prototype.account_id = 7;
+    request.prototype.type = OrderType::Limit;
+    request.prototype.tif = TimeInForce::GTC;
+    std::vector<QuoteOutcome> outcomes(2);
+    std::vector<Trade> fills;
+
+    const QuoteLevel first[] = {{Side::Buy, Order::to_price(99.0), Order::to_quantity(1.0), 100},
+                                {Side::Sell, Order::to_price(101.0), Order::to_quantity(1.0), 101}};
+    request.levels = first;
+    request.level_count = 2;
+    ASSERT_EQ(engine.mass_quote(1, request, outcomes.data(), fills)->placed, 2u);
+
+    // The bid is claimed and requeued, the ask is not and goes, each once
+    const uint64_t resting[] = {101, 100, 101, 100};
+    const QuoteLevel second[] = {{Side::Buy, Order::to_price(99.0), Order::to_quantity(2.0), 102}};
+    request.resting = resting;
+    request.resting_count = 4;
+    request.levels = second;
+    request.level_count = 1;
+    MassQuoteSummary summary = *engine.mass_quote(1, request, outcomes.data(), fills);
+    ASSERT_EQ(summary.requeued, 1u);
+    ASSERT_EQ(summary.cancelled, 1u);
+    ASSERT(engine.get_order(1, 100)->quantity == Order::to_quantity(2.0));
+    ASSERT(!engine.get_order(1, 101).has_value());
+
+    // Both nodes are reusable and the levels add up
+    const QuoteLevel third[] = {{Side::Sell, Order::to_price(102.0), Order::to_quantity(1.0), 103},
+                                {Side::Sell, Order::to_price(103.0), Order::to_quantity(1.0), 104}};
+    const uint64_t bid[] = {100, 100};
+    request.resting = bid;
+    request.resting_count = 2;
+    request.levels = third;
+    request.level_count = 2;
+    summary = *engine.mass_quote(1, request, outcomes.data(), fills);
+    ASSERT_EQ(summary.placed, 2u);
+    ASSERT_EQ(summary.cancelled, 1u);
+    ASSERT(!engine.best_bid(1).has_value());
+    ASSERT_EQ(engine.best_ask(1).value(), Order::to_price(102.0));
+    ASSERT_EQ(engine.get_orderbook(1)->total_orders(), 2u);
+}
+
+// Test: threads racing on one book are journaled in execution order
+// Test: an append dropped because the journal cannot grow is latched
+TEST(journal_append_failure) {
+    const std::string path = "/tmp/luxdex_test_journal_full_" + std::to_string(::getpid());
+    std::remove(path.c_str());
+
+    EngineConfig config;
+    config.journal_path = path;
+    config.journal.growth_records = 4;
+    Engine engine(config);
+    engine.add_symbol(1);
+
+    // Cap the file at its first segment so growing it fails with EFBIG
+    struct stat st{};
+    ASSERT_EQ(::stat(path.c_str(), &st), 0);
+    rlimit saved{};
+    ASSERT_EQ(::getrlimit(RLIMIT_FSIZE, &saved), 0);
+    auto old_handler = std::signal(SIGXFSZ, SIG_IGN);
+    rlimit capped = saved;
+    capped.rlim_cur = static_cast<rlim_t>(st.st_size);
+    ASSERT_EQ(::setrlimit(RLIMIT_FSIZE, &capped), 0);
+
+    auto place = [&](uint64_t id) {
+        return engine.place_order(OrderBuilder().id(id).symbol(1).account(100).side(Side::Buy)
+            .type(OrderType::Limit).price(100.0).quantity(1.0).tif(TimeInForce::GTC).build());
+    };
+    for (uint64_t id = 1; id <= 3; ++id) {
+        ASSERT(place(id).success);
+    }
+    ASSERT(!engine.journal_failed());
+    ASSERT_EQ(engine.journal_sequence(), 4u);
+    ASSERT(place(4).success);
+    ASSERT(engine.journal_failed());
+    ASSERT_EQ(engine.journal_sequence(), 4u);
+
+    ::setrlimit(RLIMIT_FSIZE, &saved);
+    std::signal(SIGXFSZ, old_handler);
+    std::remove(path.c_str());
+}
+
+TEST(journal_concurrent_inputs) {
+    const std::string path = "/tmp/luxdex_test_journal_race_" + std::to_string(::getpid());
+    std::remove(path.c_str());
+
+    L2Snapshot live;
+    Engine::Stats live_stats{};
+    {
+        EngineConfig config;
+        config.journal_path = path;
+        Engine engine(config);
+        engine.add_symbol(1);
+
+        std::vector<std::thread> threads;
+        for (uint64_t t = 0; t < 4; ++t) {
+            threads.emplace_back([&engine, t] {
+                for (uint64_t i = 0; i < 300; ++i) {
+                    const uint64_t id = (t + 1) * 100000 + i;
+                    const bool buy = (i + t) % 2 == 0;
+                    engine.place_order(OrderBuilder().id(id).symbol(1).account(t + 1)
+                        .side(buy ? Side::Buy : Side::Sell).type(OrderType::Limit)
+                        .price(buy ? 99.0 + static_cast<double>(i % 3) : 100.0 - static_cast<double>(i % 2))
+                        .quantity(1.0 + static_cast<double>(i % 4)).tif(TimeInForce::GTC).build());
+                    if (i % 5 == 4) {
+                        engine.cancel_order(1, id - 2);
+                    }
+                }
+            });
+        }
+        for (auto& thread : threads) {
+            thread.join();
+        }
+        live = engine.get_orderbook(1)->get_l2_snapshot();
+        live_stats = engine.get_stats();
+    }
+
+    Engine replayed;
+    ASSERT_EQ(replayed.replay_journal(path), 1 + 4 * (300 + 60));
+    L2Snapshot rebuilt = replayed.get_orderbook(1)->get_l2_snapshot();
+    ASSERT_EQ(rebuilt.bids.size(), live.bids.size());
+    ASSERT_EQ(rebuilt.asks.size(), live.asks.size());
+    for (size_t i = 0; i < live.bids.size(); ++i) {
+        ASSERT_EQ(rebuilt.bids[i].price, live.bids[i].price);
+        ASSERT_EQ(rebuilt.bids[i].quantity, live.bids[i].quantity);
+    }
+    for (size_t i = 0; i < live.asks.size(); ++i) {
+        ASSERT_EQ(rebuilt.asks[i].price, live.asks[i].price);
+        ASSERT_EQ(rebuilt.asks[i].quantity, live.asks[i].quantity);
+    }
+    ASSERT_EQ(replayed.get_stats().total_trades, live_stats.total_trades);
+    ASSERT_EQ(replayed.get_stats().total_volume, live_stats.total_volume);
+    std::remove(path.c_str());
+}
+
+TEST(journal_replication) {
+    const std::string path = "/tmp/luxdex_test_repl_" + std::to_string(::getpid());
+    const std::string mirror = path + "_mirror";
+    std::remove(path.c_str());
+    std::remove(mirror.c_str());
+
+    auto wait_until = [](auto done) {
+        for (int i = 0; i < 5000 && !done(); ++i) {
+            std::this_thread::sleep_for(std::chrono::milliseconds(1));
+        }
+        return done();
+    };
+
+    EngineConfig primary_config;
+    primary_config.journal_path = path;
+    primary_config.journal.growth_records = 16;     // Replicas follow remaps
+    Engine primary(primary_config);
+    primary.add_symbol(1);
+    auto server = ReplicationPrimary::start(path, 0);
+    ASSERT(server != nullptr);
+
+    EngineConfig replica_config;
+    replica_config.journal_path = mirror;
+    Engine replica(replica_config);
+    auto follower = std::make_unique<EngineReplica>(replica, "127.0.0.1", server->port());
+
+    for (uint64_t i = 0; i < 50; ++i) {
+        primary.place_order(OrderBuilder().id(100 + i).symbol(1).account(i % 2 ? 100 : 200)
+            .side(i % 2 ? Side::Buy : Side::Sell).type(OrderType::Limit)
+            .price(100.0 + static_cast<double>(i % 7)).quantity(2.0).tif(TimeInForce::GTC).build());
+    }
+    primary.cancel_order(1, 103);
+    primary.flush_journal();
+    const uint64_t sequence = primary.journal_sequence();
+    ASSERT_EQ(sequence, 52u);
+
+    ASSERT(wait_until([&] { return follower->applied_sequence() == sequence; }));
+    ASSERT_EQ(follower->lag(), 0u);
+    ASSERT(wait_until([&] {
+        auto replicas = server->replicas();
+        return replicas.size() == 1 && replicas[0].acked_sequence == sequence;
+    }));
+    ASSERT(replica.best_bid(1) == primary.best_bid(1));
+    ASSERT(replica.best_ask(1) == primary.best_ask(1));
+    ASSERT_EQ(replica.get_stats().total_trades, primary.get_stats().total_trades);
+    ASSERT(replica.get_orderbook(1)->thread_safe());
+    ASSERT(!replica.get_order(1, 103).has_value());
+
+    // Failover: the promoted replica continues the primary's sequence
+    server.reset();
+    follower->promote();
+    ASSERT_EQ(replica.journal_sequence(), sequence);
+    replica.cancel_order(1, 104);
+    ASSERT_EQ(replica.journal_sequence(), sequence + 1);
+    follower.reset();
+
+    std::remove(path.c_str());
+    std::remove(mirror.c_str());
+}
+
+TEST(arena_memory_usage) {
+    OrderBook book(1);
+    const MemoryStats empty = book.memory_usage();
+    ASSERT_EQ(empty.bytes_in_use, 0u);
+    for (uint64_t i = 1; i <= 200; ++i) {
+        book.place_order(OrderBuilder().id(i).symbol(1).side(Side::Buy).type(OrderType::Limit)
+            .price(100.0 - static_cast<double>(i % 10)).quantity(1.0).build());
+    }
+    const MemoryStats full = book.memory_usage();
+    ASSERT(full.bytes_in_use >= 200 * sizeof(OrderNode));
+    ASSERT(full.bytes_reserved >= full.bytes_in_use);
+    for (uint64_t i = 1; i <= 200; ++i) {
+        ASSERT(book.cancel_order(i).has_value());
+    }
+    const MemoryStats drained = book.memory_usage();
+    ASSERT(drained.bytes_in_use < full.bytes_in_use);
+    ASSERT_EQ(drained.bytes_reserved, full.bytes_reserved);   // Pools keep their chunks
+
+    // Grouped batches run their scratch through the batch arena
+    Engine engine;
+    engine.add_symbol(1);
+    engine.add_symbol(2);
+    std::vector<BatchOrder> batch;
+    for (uint64_t i = 0; i < 64; ++i) {
+        Order order = OrderBuilder().id(1000 + i).symbol(1 + i % 2)
+            .side(i % 4 < 2 ? Side::Buy : Side::Sell).type(OrderType::Limit)
+            .price(100.0).quantity(1.0).build();
+        batch.push_back(BatchOrder{BatchOrder::Action::Place, order, 0, 0, 0});
+    }
+    BatchResult result = engine.process_batch(batch);
+    ASSERT_EQ(result.order_results.size(), 64u);
+    ASSERT_EQ(result.order_results[0].order_id, 1000u);
+    ASSERT(!result.all_trades.empty());
+
+    LXVault vault;
+    const MemoryStats before = vault.memory_usage();
+    for (uint16_t i = 0; i < 100; ++i) {
+        ASSERT_EQ(vault.deposit(LXAccount{{}, i}, Currency{}, x18::from_double(1.0)), errors::OK);
+    }
+    ASSERT(vault.memory_usage().bytes_in_use > before.bytes_in_use);
+
+    LX lx;
+    LX::MemoryReport report = lx.memory_usage();
+    ASSERT_EQ(report.total.bytes_in_use, report.book.bytes_in_use + report.vault.bytes_in_use);
+}
+
+TEST(policy_order_book) {
+    // 0.01 tick, 0.001 lot, no STP, limit GTC/IOC only
+    using Policy = BookPolicy<1000000, 100000, false, order_type_bit(OrderType::Limit),
+                              tif_bit(TimeInForce::GTC) | tif_bit(TimeInForce::IOC)>;
+    OrderBook book(1, {}, Policy{});
+    std::vector<Trade> fills;
+    auto order = [](uint64_t id, Side side, double price, double qty) {
+        return OrderBuilder().id(id).symbol(1).side(side).type(OrderType::Limit)
+            .price(price).quantity(qty).tif(TimeInForce::GTC).stp_group(7).build();
+    };
+
+    Order off_tick = order(1, Side::Buy, 100.005, 1.0);
+    ASSERT(book.place_order(off_tick, fills).error == PlaceError::OffTick);
+    Order off_lot = order(2, Side::Buy, 100.0, 1.0005);
+    ASSERT(book.place_order(off_lot, fills).error == PlaceError::OffLot);
+    Order fok = order(3, Side::Buy, 100.0, 1.0);
+    fok.tif = TimeInForce::FOK;
+    ASSERT(book.place_order(fok, fills).error == PlaceError::NotAllowed);
+    Order market = order(4, Side::Buy, 100.0, 1.0);
+    market.type = OrderType::Market;
+    ASSERT(book.place_order(market, fills).error == PlaceError::NotAllowed);
+    ASSERT_EQ(book.total_orders(), 0u);
+
+    // Same STP group, but the policy has no STP: the orders trade
+    ASSERT(book.place_order(order(5, Side::Sell, 100.0, 2.0), fills));
+    PlaceOutcome crossed = book.place_order(order(6, Side::Buy, 100.01, 0.5), fills);
+    ASSERT(crossed && crossed.trades == 1);
+    Order ioc = order(7, Side::Buy, 100.0, 3.0);
+    ioc.tif = TimeInForce::IOC;
+    ASSERT_EQ(book.place_order(ioc, fills).trades, 1u);
+    ASSERT_EQ(book.total_orders(), 0u);
+
+    // The generic book still cancels the resting side of a self-trade
+    OrderBook generic(2);
+    ASSERT(generic.place_order(order(8, Side::Sell, 100.0, 1.0), fills));
+    Order own = order(9, Side::Buy, 100.0, 1.0);
+    own.symbol_id = 2;
+    ASSERT_EQ(generic.place_order(own, fills).trades, 0u);
+    ASSERT(!generic.has_order(8) && generic.has_order(9));
+
+    Engine engine;
+    ASSERT(engine.add_symbol(1, OrderBookConfig{}, Policy{}));
+    OrderResult refused = engine.place_order(off_tick);
+    ASSERT(!refused.success && refused.error == "Price not on tick");
+
+    // Modifies, reductions and quote resizes are held to the policy too
+    ASSERT(book.place_order(order(10, Side::Buy, 99.0, 2.0), fills));
+    ASSERT(!book.modify_order(10, Order::to_price(99.005), Order::to_quantity(2.0)).has_value());
+    ASSERT(!book.modify_order(10, Order::to_price(99.0), Order::to_quantity(2.0005)).has_value());
+    ASSERT(!book.reduce_order(10, Order::to_quantity(1.0005)).has_value());
+    ASSERT(book.modify_order(10, Order::to_price(98.0), Order::to_quantity(3.0)).has_value());
+    MassQuoteRequest request{};
+    request.prototype = order(0, Side::Buy, 98.0, 1.0);
+    const uint64_t resting[] = {10};
+    const QuoteLevel level{Side::Buy, Order::to_price(98.0), Order::to_quantity(3.0005), 11};
+    request.resting = resting;
+    request.resting_count = 1;
+    request.levels = &level;
+    request.level_count = 1;
+    QuoteOutcome outcome{};
+    std::vector<Order> cancelled;
+    ASSERT_EQ(book.mass_quote(request, Timestamp(1), &outcome, cancelled, fills).rejected, 1u);
+    ASSERT(book.get_order(10)->quantity == Order::to_quantity(3.0));
+    ASSERT(book.get_order(10)->price == Order::to_price(98.0));
+
+    // A snapshot restores into the policy book added before loading it,
+    // and an image the policy refuses is not loaded
+    const std::string path = "/tmp/luxdex_test_policy_" + std::to_string(::getpid()) + ".snap";
+    {
+        Engine saved;
+        ASSERT(saved.add_symbol(1, OrderBookConfig{}, Policy{}));
+        ASSERT(saved.place_order(order(20, Side::Buy, 99.0, 1.0)).success);
+        ASSERT(saved.save_snapshot(path));
+    }
+    Engine restored;
+    ASSERT(restored.add_symbol(1, OrderBookConfig{}, Policy{}));
+    ASSERT(restored.load_snapshot(path));
+    ASSERT(restored.get_order(1, 20).has_value());
+    Order late = off_tick;
+    late.id = 21;
+    ASSERT(restored.place_order(late).error == "Price not on tick");
+    ASSERT(!restored.load_snapshot(path));                  // No longer empty
+    {
+        Engine generic_engine;
+        generic_engine.add_symbol(1);
+        ASSERT(generic_engine.place_order(late).success);
+        ASSERT(generic_engine.save_snapshot(path));
+    }
+    Engine strict;
+    ASSERT(strict.add_symbol(1, OrderBookConfig{}, Policy{}));
+    ASSERT(!strict.load_snapshot(path));
+    std::remove(path.c_str());
+
+    LXBook lxbook;
+    BookMarketConfig config{};
+    config.market_id = 1;
+    config.symbol_id = 100;
+    config.tick_size_x18 = x18::from_double(0.01);
+    config.lot_size_x18 = x18::from_double(0.01);
+    config.status = 1;
+    ASSERT_EQ(lxbook.create_market(config, Policy{}), errors::INVALID_TICK_RANGE);
+    config.lot_size_x18 = x18::from_double(0.001);
+    ASSERT_EQ(lxbook.create_market(config, Policy{}), errors::OK);
+}
+
+TEST(numa_placement) {
+    NodeMemory memory(numa_node_of_cpu(0), true);
+    std::pmr::vector<uint64_t> table(HUGE_PAGE_SIZE / sizeof(uint64_t), 0, memory.resource());
+    NodeMemoryStats stats = memory.stats();
+    ASSERT(stats.bytes_mapped >= HUGE_PAGE_SIZE);
+    ASSERT_EQ(stats.huge_page_bytes % HUGE_PAGE_SIZE, 0u);
+    ASSERT(stats.huge_page_bytes >= HUGE_PAGE_SIZE);
+    table.clear();
+    table.shrink_to_fit();
+    ASSERT_EQ(memory.stats().huge_page_bytes, 0u);
+
+    // A book on node memory keeps its ladders and order pool there
+    {
+        OrderBook book(1, {}, memory.resource());
+        for (uint64_t i = 1; i <= 100; ++i) {
+            book.place_order(OrderBuilder().id(i).symbol(1).side(Side::Buy)
+                .type(OrderType::Limit).price(100.0 - static_cast<double>(i % 10))
+                .quantity(1.0).build());
+        }
+        ASSERT(memory.stats().mappings > 0);
+        ASSERT_EQ(book.best_bid().value(), Order::to_price(100.0));
+    }
+
+    EngineConfig config;
+    config.sharded_mode = true;
+    config.shard_count = 2;
+    config.shard_cpus = {0};
+    config.numa_local = true;
+    config.huge_pages = true;
+    Engine engine(config);
+    ASSERT(engine.add_symbol(1));
+    ASSERT(engine.add_symbol(2));
+    engine.start();
+    BatchOrder action{};
+    action.action = BatchOrder::Action::Place;
+    action.order = OrderBuilder().id(1).symbol(1).side(Side::Buy).type(OrderType::Limit)
+        .price(10.0).quantity(1.0).build();
+    while (!engine.submit(action)) {}
+    engine.stop();
+
+    Engine::PlacementStats placement = engine.get_placement_stats();
+    ASSERT_EQ(placement.shards.size(), 2u);
+    for (const Engine::ShardPlacement& shard : placement.shards) {
+        ASSERT_EQ(shard.cpu, 0);
+        ASSERT(shard.pinned);
+        ASSERT_EQ(shard.memory.node, numa_node_of_cpu(0));
+        ASSERT(shard.memory.bytes_mapped > 0);      // Rings, ladders, order pools
+    }
+    ASSERT_EQ(engine.best_bid(1).value(), Order::to_price(10.0));
+
+    auto vault_memory = std::make_shared<NodeMemory>(-1, false);
+    size_t vault_mapped = 0;
+    {
+        LXVault vault(vault_memory);
+        ASSERT_EQ(vault.deposit(LXAccount{{}, 1}, Currency{}, x18::from_double(1.0)), errors::OK);
+        vault_mapped = vault.placement_stats().bytes_mapped;
+        ASSERT(vault_mapped > 0);
+    }
+    // Everything the shards' pools free came from the node's mappings
+    ASSERT(vault_memory->stats().bytes_mapped <= vault_mapped);
+}
+
+TEST(order_id_blocks) {
+    OrderIdGenerator& gen = OrderIdGenerator::instance();
+    gen.reset(1);
+
+    // Each thread draws its own block: unique overall, rising per thread
+    constexpr size_t threads = 4;
+    constexpr size_t per_thread = 3 * OrderIdGenerator::BLOCK_SIZE;
+    std::vector<std::vector<uint64_t>> ids(threads);
+    std::vector<std::thread> workers;
+    for (size_t t = 0; t < threads; ++t) {
+        workers.emplace_back([&ids, t] {
+            for (size_t i = 0; i < per_thread; ++i) {
+                ids[t].push_back(OrderIdGenerator::instance().next());
+            }
+        });
+    }
+    for (auto& worker : workers) {
+        worker.join();
+    }
+    std::unordered_set<uint64_t> seen;
+    for (const auto& thread_ids : ids) {
+        ASSERT(std::is_sorted(thread_ids.begin(), thread_ids.end()));
+        seen.insert(thread_ids.begin(), thread_ids.end());
+    }
+    ASSERT_EQ(seen.size(), threads * per_thread);
+
+    // A block of our own, then a restore that overlaps it
+    OrderIdBlock shard(16);
+    uint64_t first = shard.next();
+    ASSERT_EQ(shard.next(), first + 1);
+    gen.advance_past(first + 100);
+    ASSERT_EQ(shard.next(), first + 101);
+    ASSERT(gen.next() > first + 101);
+    gen.advance_past(1);  // Never moves back
+    ASSERT(shard.next() > first + 101);
+
+    gen.reset(1);
+    ASSERT_EQ(gen.next(), 1u);
+    ASSERT_EQ(gen.next(), 2u);
+
+    // Loading a snapshot moves generation past the restored ids
+    const std::string snapshot = "/tmp/luxdex_test_order_ids_" + std::to_string(::getpid());
+    {
+        Engine engine;
+        engine.add_symbol(1);
+        engine.place_order(OrderBuilder().id(5000).symbol(1).account(1).side(Side::Buy)
+            .type(OrderType::Limit).price(100.0).quantity(1.0).tif(TimeInForce::GTC).build());
+        ASSERT(engine.save_snapshot(snapshot));
+    }
+    gen.reset(1);
+    {
+        Engine engine;
+        ASSERT(engine.load_snapshot(snapshot));
+        ASSERT(gen.next() > 5000u);
+    }
+    std::remove(snapshot.c_str());
+}
+
+// Test: corrupt snapshot files are refused without touching the engine
+TEST(snapshot_rejects_corrupt) {
+    const std::string path = "/tmp/luxdex_test_corrupt_" + std::to_string(::getpid()) + ".snap";
+    {
+        Engine engine;
+        engine.add_symbol(1);
+        for (uint64_t i = 0; i < 4; ++i) {
+            engine.place_order(OrderBuilder().id(10 + i).symbol(1).account(100)
+                .side(i < 2 ? Side::Buy : Side::Sell).type(OrderType::Limit)
+                .price(i < 2 ? 99.0 : 101.0).quantity(1.0).tif(TimeInForce::GTC).build());
+        }
+        ASSERT(engine.save_snapshot(path));
+    }
+
+    std::vector<uint8_t> image;
+    {
+        FILE* file = std::fopen(path.c_str(), "rb");
+        ASSERT(file != nullptr);
+        uint8_t buffer[4096];
+        for (size_t n; (n = std::fread(buffer, 1, sizeof(buffer), file)) > 0;) {
+            image.insert(image.end(), buffer, buffer + n);
+        }
+        std::fclose(file);
+    }
+    auto load_patched = [&](size_t offset, const void* bytes, size_t size) {
+        std::vector<uint8_t> patched = image;
+        std::memcpy(patched.data() + offset, bytes, size);
+        FILE* file = std::fopen(path.c_str(), "wb");
+        std::fwrite(patched.data(), 1, patched.size(), file);
+        std::fclose(file);
+        Engine engine;
+        const bool loaded = engine.load_snapshot(path);
+        ASSERT(loaded || engine.get_orderbook(1) == nullptr);
+        return loaded;
+    };
+
+    // File header: magic, version, reserved, section_count, total_bytes. The
+    // first section is EngineInfo (kind, record_size, meta_size, count, ...)
+    uint64_t word = 0;
+    std::memcpy(&word, image.data() + 16, sizeof(word));
+    ASSERT(load_patched(16, &word, sizeof(word)));                  // Untouched image loads
+
+    const uint64_t huge_sections = ~uint64_t{0} / 2;
+    ASSERT(!load_patched(16, &huge_sections, sizeof(huge_sections)));
+
+    uint32_t record_size = 0;
+    std::memcpy(&record_size, image.data() + 36, sizeof(record_size));
+    ASSERT_EQ(record_size, static_cast<uint32_t>(sizeof(uint64_t)));
+    const uint64_t wrapping_count = ~uint64_t{0} / record_size + 2;  // count * size wraps to 8
+    ASSERT(!load_patched(48, &wrapping_count, sizeof(wrapping_count)));
+
+    const uint64_t huge_meta = ~uint64_t{0} - 8;
+    ASSERT(!load_patched(40, &huge_meta, sizeof(huge_meta)));
+
+    const uint8_t flipped = static_cast<uint8_t>(image[image.size() - 40] ^ 0x01);
+    ASSERT(!load_patched(image.size() - 40, &flipped, 1));           // Checksum
+
+    // Well-formed sections that lie about their contents
+    auto load_written = [&](const void* meta, size_t meta_size, const Order* orders, size_t count) {
+        SnapshotWriter writer;
+        writer.add_section(SnapshotSectionKind::Book, meta, meta_size, orders, sizeof(Order), count);
+        ASSERT(writer.finish(path));
+        Engine engine;
+        const bool loaded = engine.load_snapshot(path);
+        ASSERT(loaded || engine.get_orderbook(1) == nullptr);
+        return loaded;
+    };
+    Order orders[2] = {
+        OrderBuilder().id(1).symbol(1).side(Side::Buy).type(OrderType::Limit).price(99.0).quantity(1.0).build(),
+        OrderBuilder().id(2).symbol(1).side(Side::Sell).type(OrderType::Limit).price(101.0).quantity(1.0).build(),
+    };
+    BookSnapshotHeader header{};
+    header.symbol_id = 1;
+    header.bid_orders = 1;
+    header.ask_orders = 1;
+    ASSERT(load_written(&header, sizeof(header), orders, 2));
+    ASSERT(!load_written(&header, sizeof(header) / 2, orders, 2));     // Short meta
+    header.ask_orders = 5;
+    ASSERT(!load_written(&header, sizeof(header), orders, 2));         // Counts past the records
+    header.bid_orders = 2;
+    header.ask_orders = 0;
+    ASSERT(!load_written(&header, sizeof(header), orders, 2));         // Ask among the bids
+
+    // Two books for one symbol
+    header.bid_orders = 1;
+    header.ask_orders = 1;
+    SnapshotWriter writer;
+    writer.add_section(SnapshotSectionKind::Book, &header, sizeof(header), orders, sizeof(Order), 2);
+    writer.add_section(SnapshotSectionKind::Book, &header, sizeof(header), orders, sizeof(Order), 2);
+    ASSERT(writer.finish(path));
+    Engine engine;
+    ASSERT(!engine.load_snapshot(path));
+    ASSERT(engine.get_orderbook(1) == nullptr);
+    std::remove(path.c_str());
+}
+
+TEST(snapshot_restore) {
+    const std::string prefix = "/tmp/luxdex_test_snapshot_" + std::to_string(::getpid());
+    const std::string journal = prefix + ".journal";
+    const std::string snapshot = prefix + ".snap";
+    std::remove(journal.c_str());
+
+    OrderBookConfig ladder;
+    ladder.backend = BookBackend::TickLadder;
+    ladder.tick_size = Order::to_price(0.5);
+    ladder.ladder_ticks = 64;
+
+    std::optional<Price> live_bid;
+    uint64_t live_trade_id = 0;
+    {
+        EngineConfig config;
+        config.journal_path = journal;
+        Engine engine(config);
+        engine.add_symbol(1);
+        engine.add_symbol(2, ladder);
+        for (uint64_t i = 0; i < 30; ++i) {
+            engine.place_order(OrderBuilder().id(10 + i).symbol(1 + i % 2).account(100 + i)
+                .side(i % 4 == 3 ? Side::Sell : Side::Buy).type(OrderType::Limit)
+                .price(i % 4 == 3 ? 110.0 : 100.0 - static_cast<double>(i % 3)).quantity(2.0)
+                .tif(TimeInForce::GTC).build());
+        }
+        ASSERT(engine.save_snapshot(snapshot));
+
+        // Tail after the snapshot
+        engine.cancel_order(1, 10);
+        auto result = engine.place_order(OrderBuilder().id(99).symbol(2).account(1)
+            .side(Side::Sell).type(OrderType::Limit).price(100.0).quantity(1.0)
+            .tif(TimeInForce::GTC).build());
+        ASSERT_EQ(result.trades.size(), 1u);
+        live_trade_id = result.trades[0].id;
+        live_bid = engine.best_bid(1);
+    }
+
+    // Snapshot alone: books, FIFO and trade ids come back
+    {
+        Engine engine;
+        ASSERT(engine.load_snapshot(snapshot));
+        ASSERT(engine.get_orderbook(2)->config().backend == BookBackend::TickLadder);
+        ASSERT(engine.get_order(1, 10).has_value());
+        ASSERT_EQ(engine.get_orderbook(1)->total_orders(), 15u);
+
+        // Best bid level on symbol 2 is 100.0 holding ids 19 then 31
+        auto result = engine.place_order(OrderBuilder().id(200).symbol(2).account(1)
+            .side(Side::Sell).type(OrderType::Limit).price(100.0).quantity(5.0)
+            .tif(TimeInForce::GTC).build());
+        ASSERT_EQ(result.trades.size(), 2u);
+        ASSERT_EQ(result.trades[0].buy_order_id, 19u);
+        ASSERT_EQ(result.trades[1].buy_order_id, 31u);
+        ASSERT_EQ(result.trades[0].id, live_trade_id);
+        ASSERT(!engine.load_snapshot(snapshot));  // Symbols already present
+    }
+
+    // Snapshot plus journal tail reproduces the live state
+    {
+        Engine engine;
+        ASSERT(engine.load_snapshot(snapshot));
+        ASSERT_EQ(engine.replay_journal(journal), 2u);
+        ASSERT(engine.best_bid(1) == live_bid);
+        ASSERT(!engine.get_order(1, 10).has_value());
+    }
+    std::remove(journal.c_str());
+
+    // LXBook adds markets and the account order index
+    {
+        LXBook book;
+        BookMarketConfig market{};
+        market.market_id = 7;
+        market.symbol_id = 70;
+        market.lot_size_x18 = x18::from_double(0.001);
+        market.max_order_size_x18 = x18::from_double(1000000.0);
+        market.status = 1;
+        book.create_market(market);
+
+        LXAccount trader{};
+        trader.main[19] = 0x07;
+        LXOrder order{};
+        order.market_id = 7;
+        order.is_buy = true;
+        order.kind = OrderKind::LIMIT;
+        order.size_x18 = x18::from_double(3.0);
+        order.limit_px_x18 = x18::from_double(42.0);
+        order.tif = TIF::GTC;
+        auto placed = book.place_order(trader, order);
+        ASSERT(book.save_snapshot(snapshot));
+
+        LXBook restored;
+        ASSERT(restored.load_snapshot(snapshot));
+        ASSERT(restored.get_market_config(7).has_value());
+        auto state = restored.get_order(7, placed.oid);
+        ASSERT(state.has_value());
+        ASSERT(state->limit_price_x18 == order.limit_px_x18);
+        ASSERT(restored.get_l1(7).best_bid_px_x18 == book.get_l1(7).best_bid_px_x18);
+        ASSERT(restored.cancel_order(trader, 7, placed.oid) == errors::OK);
+    }
+    std::remove(snapshot.c_str());
+}
+
+TEST(engine_completion_queue) {
+    for (bool sharded : {false, true}) {
+        EngineConfig config;
+        config.async_mode = !sharded;
+        config.sharded_mode = sharded;
+        config.worker_threads = 1;
+        config.shard_count = 2;
+        config.pin_shards = false;
+        config.completion_queue = true;
+        config.completion_ring_capacity = 64;
+        Engine engine(config);
+        engine.add_symbol(1);
+        engine.add_symbol(2);
+        engine.start();
+
+        const uint64_t total = 400;
+        std::vector<Completion> completions(32);
+        std::vector<bool> seen(total, false);
+        uint64_t submitted = 0, completed = 0, trades = 0;
+        Quantity filled = 0;
+
+        while (completed < total) {
+            if (submitted < total) {
+                BatchOrder action{};
+                action.action = BatchOrder::Action::Place;
+                action.order = OrderBuilder().id(OrderIdGenerator::instance().next())
+                    .symbol(1 + submitted % 2).account(submitted % 4 < 2 ? 100 : 200)
+                    .side(submitted % 4 < 2 ? Side::Buy : Side::Sell)
+                    .type(OrderType::Limit).price(50.0).quantity(1.0)
+                    .tif(TimeInForce::GTC).build();
+                if (engine.submit(action, submitted)) {
+                    ++submitted;
+                }
+            }
+
+            size_t n = engine.poll_completions(completions.data(), completions.size());
+            for (size_t i = 0; i < n; ++i) {
+                ASSERT(completions[i].success);
+                ASSERT(!seen[completions[i].user_data]);
+                seen[completions[i].user_data] = true;
+                trades += completions[i].trade_count;
+                filled += completions[i].filled_quantity;
+            }
+            completed += n;
+        }
+
+        engine.stop();
+        ASSERT_EQ(trades, total / 2);
+        ASSERT_EQ(filled, Order::to_quantity(1.0) * static_cast<Quantity>(total / 2));
+        ASSERT_EQ(engine.completions_dropped(), 0u);
+    }
+}
+
 // Test: Engine statistics
 TEST(engine_statistics) {
     Engine engine;
@@ -406,6 +2149,63 @@ TEST(engine_statistics) {
     ASSERT(stats.total_trades > 0);
 }
 
+TEST(engine_symbol_stats) {
+    Engine engine;
+    engine.add_symbol(1);
+    engine.add_symbol(2);
+    engine.add_symbol(3);
+
+    // One thread per symbol: each crosses 100 pairs
+    std::vector<std::thread> threads;
+    for (uint64_t symbol = 1; symbol <= 2; ++symbol) {
+        threads.emplace_back([&engine, symbol] {
+            for (int i = 0; i < 100; ++i) {
+                uint64_t id = symbol * 1000 + static_cast<uint64_t>(i) * 2;
+                engine.place_order(OrderBuilder().id(id).symbol(symbol).account(100)
+                    .side(Side::Buy).type(OrderType::Limit).price(10.0).quantity(2.0)
+                    .tif(TimeInForce::GTC).build());
+                engine.place_order(OrderBuilder().id(id + 1).symbol(symbol).account(200)
+                    .side(Side::Sell).type(OrderType::Limit).price(10.0).quantity(2.0)
+                    .tif(TimeInForce::GTC).build());
+            }
+        });
+    }
+    for (auto& thread : threads) {
+        thread.join();
+    }
+
+    engine.place_order(OrderBuilder().id(1).symbol(3).account(100).side(Side::Buy)
+        .type(OrderType::Limit).price(10.0).quantity(1.0).tif(TimeInForce::GTC).build());
+    engine.cancel_order(3, 1);
+
+    auto first = engine.get_symbol_stats(1);
+    ASSERT(first.has_value());
+    ASSERT_EQ(first->orders_placed, 200u);
+    ASSERT_EQ(first->trades, 100u);
+    ASSERT_EQ(first->volume, static_cast<uint64_t>(Order::to_quantity(2.0)) * 100);
+    ASSERT_EQ(engine.get_symbol_stats(3)->orders_cancelled, 1u);
+    ASSERT(!engine.get_symbol_stats(4).has_value());
+
+    // Removed symbols still count towards the totals
+    ASSERT(engine.remove_symbol(3));
+    auto stats = engine.get_stats();
+    ASSERT_EQ(stats.total_orders_placed, 401u);
+    ASSERT_EQ(stats.total_orders_cancelled, 1u);
+    ASSERT_EQ(stats.total_trades, 200u);
+
+    StripedCounter<> counter;
+    std::vector<std::thread> adders;
+    for (int t = 0; t < 4; ++t) {
+        adders.emplace_back([&counter] {
+            for (int i = 0; i < 1000; ++i) counter.add();
+        });
+    }
+    for (auto& adder : adders) {
+        adder.join();
+    }
+    ASSERT_EQ(counter.load(), 4000u);
+}
+
 // =============================================================================
 // Oracle Tests
 // =============================================================================
@@ -575,8 +2375,440 @@ TEST(oracle_twap) {
     ASSERT(p >= 100.0 && p <= 200.0);
 }
 
-// Test: Staleness detection
-TEST(oracle_staleness) {
+// Test: TWAP accumulator over a long history
+TEST(oracle_twap_accumulator) {
+    LXOracle oracle;
+    const uint64_t ts = static_cast<uint64_t>(
+        std::chrono::duration_cast<std::chrono::seconds>(
+            std::chrono::system_clock::now().time_since_epoch()).count());
+
+    // 100 for 50s, then 200 until now
+    oracle.record_twap_price(1, x18::from_double(100.0), ts - 100);
+    oracle.record_twap_price(1, x18::from_double(200.0), ts - 50);
+    auto twap = oracle.get_twap(1, 100);
+    ASSERT(twap.has_value());
+    ASSERT(std::abs(x18::to_double(*twap) - 150.0) < 2.0);
+    // The window is clipped to the history
+    twap = oracle.get_twap(1, 10000);
+    ASSERT(std::abs(x18::to_double(*twap) - 150.0) < 2.0);
+    twap = oracle.get_twap(1, 10);
+    ASSERT(std::abs(x18::to_double(*twap) - 200.0) < 1e-9);
+    ASSERT(!oracle.get_twap(2, 100).has_value());
+
+    // Two days at one price a second alternating 100 / 300; only the last
+    // day is kept and any window still averages 200
+    const uint64_t span = 2 * 24 * 3600;
+    for (uint64_t i = 0; i < span; ++i) {
+        oracle.record_twap_price(3, x18::from_double(i % 2 ? 300.0 : 100.0), ts - span + i);
+    }
+    for (uint64_t window : {2u, 600u, 3600u, 20 * 3600u}) {
+        twap = oracle.get_twap(3, window);
+        ASSERT(twap.has_value());
+        ASSERT(std::abs(x18::to_double(*twap) - 200.0) < 200.0 / window + 1e-9);
+    }
+    // Late timestamps count as the latest one
+    oracle.record_twap_price(3, x18::from_double(1000.0), ts - span);
+    ASSERT(oracle.get_twap(3, 600).has_value());
+}
+
+// Test: Aggregates cached per asset and rebuilt on change
+TEST(oracle_cached_aggregates) {
+    LXOracle oracle;
+    const uint64_t ts = static_cast<uint64_t>(
+        std::chrono::duration_cast<std::chrono::seconds>(
+            std::chrono::system_clock::now().time_since_epoch()).count());
+
+    OracleConfig config{};
+    config.asset_id = 1;
+    config.max_staleness = 3600;
+    config.method = AggregationMethod::MEDIAN;
+    config.sources = {PriceSource::BINANCE, PriceSource::COINBASE, PriceSource::OKX};
+    oracle.register_asset(config);
+
+    oracle.update_prices({
+        {1, PriceSource::BINANCE, x18::from_double(103.0), 0},
+        {1, PriceSource::COINBASE, x18::from_double(101.0), 0},
+        {1, PriceSource::OKX, x18::from_double(102.0), 0},
+    });
+    auto data = oracle.get_price_data(1);
+    ASSERT(data.has_value());
+    ASSERT(data->price_x18 == x18::from_double(102.0));
+    ASSERT_EQ(data->num_sources, 3);
+
+    // Sources stay one per feed, in price order
+    oracle.update_price(1, PriceSource::BINANCE, x18::from_double(100.0), 0);
+    auto sources = oracle.get_all_source_prices(1);
+    ASSERT_EQ(sources.size(), 3u);
+    ASSERT(sources.front().source == PriceSource::BINANCE);
+    ASSERT(sources.back().source == PriceSource::OKX);
+    ASSERT(*oracle.get_price(1) == x18::from_double(101.0));
+    ASSERT(oracle.get_price(1) == oracle.get_price(1));
+
+    // A stale source drops out; a shorter staleness limit is seen at once
+    oracle.update_price(1, PriceSource::OKX, x18::from_double(110.0), 0, ts - 120);
+    ASSERT(*oracle.get_price(1) == x18::from_double(101.0));
+    config.max_staleness = 60;
+    oracle.update_config(1, config);
+    ASSERT(*oracle.get_price(1) == x18::from_double(100.5));
+    ASSERT_EQ(oracle.get_price_data(1)->num_sources, 2);
+
+    // Future-dated sources wait until they are current
+    oracle.update_price(1, PriceSource::OKX, x18::from_double(90.0), 0, ts + 3600);
+    ASSERT_EQ(oracle.get_price_data(1)->num_sources, 2);
+
+    // Index detail comes from the same cache and follows robust params
+    RobustParams params{};
+    params.min_sources = 3;
+    params.outlier_threshold_x18 = x18::from_double(2.0);
+    params.trim_percent_x18 = 0;
+    oracle.set_robust_params(1, params);
+    ASSERT(!oracle.index_price_detailed(1).has_value());
+    params.min_sources = 2;
+    oracle.set_robust_params(1, params);
+    auto detail = oracle.index_price_detailed(1);
+    ASSERT(detail.has_value());
+    ASSERT(detail->median_x18 == x18::from_double(100.5));
+    ASSERT_EQ(detail->sources_used, 2);
+
+    // Unconfigured assets still get an index but no aggregated price
+    oracle.update_price(2, PriceSource::BINANCE, x18::from_double(5.0), 0);
+    ASSERT(!oracle.get_price_data(2).has_value());
+    ASSERT(oracle.index_price_detailed(2).has_value());
+    ASSERT(!oracle.get_price_data(3).has_value());
+}
+
+// Test: Batch ingest with concurrent readers of every asset
+TEST(oracle_concurrent_ingest) {
+    LXOracle oracle;
+    for (uint64_t id = 1; id <= 4; ++id) {
+        OracleConfig config{};
+        config.asset_id = id;
+        config.max_staleness = 3600;
+        config.method = AggregationMethod::MEDIAN;
+        config.sources = {PriceSource::BINANCE, PriceSource::COINBASE, PriceSource::OKX};
+        oracle.register_asset(config);
+    }
+
+    // Each batch moves all three sources of an asset together, so a reader
+    // must only ever see an aggregate of one batch
+    std::atomic<bool> done{false};
+    std::atomic<int> torn{0};
+    std::vector<std::thread> readers;
+    for (uint64_t id = 1; id <= 4; ++id) {
+        readers.emplace_back([&, id] {
+            while (!done.load()) {
+                auto data = oracle.get_price_data(id);
+                if (!data) continue;
+                if (data->deviation_x18 != 0 || data->num_sources != 3) torn++;
+                oracle.get_twap(id, 60);
+            }
+        });
+    }
+    for (int round = 1; round <= 500; ++round) {
+        std::vector<std::tuple<uint64_t, PriceSource, I128, I128>> batch;
+        for (uint64_t id = 1; id <= 4; ++id) {
+            const I128 price = x18::from_double(static_cast<double>(round * id));
+            for (PriceSource source : {PriceSource::BINANCE, PriceSource::COINBASE, PriceSource::OKX}) {
+                batch.emplace_back(id, source, price, 0);
+            }
+        }
+        oracle.update_prices(batch);
+        oracle.record_twap_price(1 + round % 4, x18::from_double(round), 0);
+    }
+    done = true;
+    for (auto& t : readers) t.join();
+
+    ASSERT_EQ(torn.load(), 0);
+    for (uint64_t id = 1; id <= 4; ++id) {
+        ASSERT(*oracle.get_price(id) == x18::from_double(500.0 * id));
+        ASSERT_EQ(oracle.get_all_source_prices(id).size(), 3u);
+    }
+    ASSERT_EQ(oracle.get_stats().total_updates, 500u * 12u);
+}
+
+// Test: Scheduled polling of oracle sources
+namespace {
+class ScriptedSource : public IOracleSource {
+public:
+    ScriptedSource(PriceSource type, double price, int delay_ms)
+        : type_(type), price_(price), delay_ms_(delay_ms) {}
+
+    PriceSource source_type() const override { return type_; }
+    bool is_available() const override { return true; }
+    std::optional<SourcePriceData> fetch_price(uint64_t asset_id) override {
+        auto prices = fetch_prices({asset_id});
+        if (prices.empty()) return std::nullopt;
+        return prices.front().second;
+    }
+    std::vector<std::pair<uint64_t, SourcePriceData>>
+    fetch_prices(const std::vector<uint64_t>& asset_ids) override {
+        std::this_thread::sleep_for(std::chrono::milliseconds(delay_ms_));
+        std::vector<std::pair<uint64_t, SourcePriceData>> prices;
+        for (uint64_t id : asset_ids) {
+            SourcePriceData data{};
+            data.price_x18 = x18::from_double(price_ * id);
+            data.is_valid = true;
+            prices.emplace_back(id, data);
+        }
+        return prices;
+    }
+
+private:
+    PriceSource type_;
+    double price_;
+    int delay_ms_;
+};
+} // namespace
+
+TEST(oracle_scheduler_polling) {
+    LXOracle oracle;
+    for (uint64_t id = 1; id <= 2; ++id) {
+        OracleConfig config{};
+        config.asset_id = id;
+        config.max_staleness = 3600;
+        config.sources = {PriceSource::PYTH, PriceSource::CHAINLINK};
+        oracle.register_asset(config);
+    }
+
+    // A hung source must not hold up the fast one
+    ScriptedSource fast(PriceSource::PYTH, 100.0, 0);
+    ScriptedSource slow(PriceSource::CHAINLINK, 200.0, 150);
+    OracleSchedulerConfig config;
+    config.tick_ms = 5;
+    OracleScheduler scheduler(oracle, config);
+    ASSERT_EQ(scheduler.add_source(fast, {{1, 2}, 5, 50}), 0u);
+    ASSERT_EQ(scheduler.add_source(slow, {{1, 2}, 5, 50}), 1u);
+
+    scheduler.start();
+    std::this_thread::sleep_for(std::chrono::milliseconds(100));
+    ASSERT(oracle.get_price(2).has_value());
+    ASSERT(std::abs(x18::to_double(*oracle.get_price(2)) - 200.0) < 1e-9);
+    scheduler.stop();
+
+    auto stats = scheduler.get_stats();
+    ASSERT(stats[0].source == PriceSource::PYTH);
+    ASSERT(stats[0].polls >= 5);
+    ASSERT_EQ(stats[0].prices, stats[0].polls * 2);
+    ASSERT_EQ(stats[0].timeouts, 0u);
+    ASSERT_EQ(stats[1].polls, 1u);
+    ASSERT_EQ(stats[1].timeouts, 1u);
+    ASSERT(stats[1].p50_nanos >= 150000000u);
+    ASSERT(!oracle.get_source_price(1, PriceSource::CHAINLINK).has_value());
+    ASSERT(oracle.get_source_price(1, PriceSource::PYTH).has_value());
+
+    // One batch per tick, not per fetch
+    ASSERT(scheduler.batches() > 0);
+    ASSERT(scheduler.batches() < stats[0].polls + 1);
+    ASSERT_EQ(scheduler.flush(), 0u);
+}
+
+// Test: Oracle change events pushed through the feed
+TEST(oracle_price_subscriptions) {
+    LXOracle oracle;
+    for (uint64_t id = 1; id <= 2; ++id) {
+        OracleConfig config{};
+        config.asset_id = id;
+        config.max_staleness = 3600;
+        config.sources = {PriceSource::BINANCE, PriceSource::COINBASE};
+        oracle.register_asset(config);
+    }
+
+    std::vector<LXOracle::PriceChangeEvent> events;
+    const uint64_t sub = oracle.subscribe([&](const LXOracle::PriceChangeEvent& e) { events.push_back(e); });
+    oracle.update_price(1, PriceSource::BINANCE, x18::from_double(100.0), 0);
+    oracle.update_prices({
+        {1, PriceSource::COINBASE, x18::from_double(102.0), 0},
+        {1, PriceSource::BINANCE, x18::from_double(104.0), 0},
+        {2, PriceSource::BINANCE, x18::from_double(7.0), 0},
+        {3, PriceSource::BINANCE, -1, 0},
+    });
+    // One event per touched asset and batch, with the published aggregate
+    ASSERT_EQ(events.size(), 3u);
+    ASSERT(events[0].asset_id == 1 && events[0].version == 1);
+    ASSERT(events[1].asset_id == 1 && events[1].version == 2);
+    ASSERT(*events[1].price_x18 == x18::from_double(103.0));
+    ASSERT(events[2].asset_id == 2 && events[2].index_x18.has_value());
+    ASSERT_EQ(oracle.price_version(1), 2u);
+    ASSERT_EQ(oracle.price_version(3), 0u);
+
+    // The feed republishes marks only for markets on the updated asset
+    {
+        LXFeed feed(oracle);
+        feed.register_market(10, 1);
+        feed.register_market(11, 1);
+        feed.register_market(20, 2);
+        std::vector<std::pair<uint32_t, PriceType>> pushed;
+        feed.set_price_listener([&](uint32_t market_id, PriceType type, I128) {
+            pushed.emplace_back(market_id, type);
+        });
+        oracle.update_price(2, PriceSource::COINBASE, x18::from_double(7.5), 0);
+        ASSERT_EQ(pushed.size(), 2u);
+        ASSERT(pushed[0].first == 20 && pushed[0].second == PriceType::INDEX);
+        ASSERT(pushed[1].first == 20 && pushed[1].second == PriceType::MARK);
+        pushed.clear();
+        feed.unregister_market(11);
+        oracle.update_price(1, PriceSource::COINBASE, x18::from_double(101.0), 0);
+        ASSERT_EQ(pushed.size(), 2u);
+        ASSERT(pushed[0].first == 10);
+    }
+
+    // Unsubscribed listeners, including the destroyed feed's, hear nothing
+    oracle.unsubscribe(sub);
+    events.clear();
+    oracle.update_price(1, PriceSource::BINANCE, x18::from_double(99.0), 0);
+    ASSERT(events.empty());
+}
+
+// Test: Incremental time-decayed premium EWMA
+TEST(feed_premium_ewma) {
+    LXOracle oracle;
+    LXFeed feed(oracle);
+    MarkPriceConfig config{};
+    config.premium_ewma_window = 200;      // tau = 100s
+    config.max_premium_x18 = x18::from_double(1e6);
+    config.min_premium_x18 = x18::from_double(-1e6);
+    feed.set_mark_price_config(1, config);
+    feed.register_market(1, 1);
+
+    const uint64_t t0 = 1000000;
+    feed.record_premium(1, x18::from_double(1.0), t0);
+    ASSERT(std::abs(x18::to_double(*feed.premium_ewma(1)) - 1.0) < 1e-9);
+
+    // One time constant later the first sample weighs e^-1
+    feed.record_premium(1, x18::from_double(3.0), t0 + 100);
+    const double e = std::exp(-1.0);
+    ASSERT(std::abs(x18::to_double(*feed.premium_ewma(1)) - (e + 3.0) / (e + 1.0)) < 1e-9);
+
+    // A late sample is weighted by its age, without moving the clock
+    feed.record_premium(1, x18::from_double(2.0), t0);
+    ASSERT(std::abs(x18::to_double(*feed.premium_ewma(1)) - (e + 3.0 + 2.0 * e) / (2.0 * e + 1.0)) < 1e-9);
+
+    // Long after, only recent samples matter
+    for (uint64_t i = 0; i < 3000; ++i) {
+        feed.record_premium(1, x18::from_double(-0.5), t0 + 200 + i);
+    }
+    ASSERT(std::abs(x18::to_double(*feed.premium_ewma(1)) + 0.5) < 1e-9);
+
+    // Config changes reach the cached window; unknown markets use the default
+    config.premium_ewma_window = 2;
+    feed.set_mark_price_config(1, config);
+    feed.record_premium(1, x18::from_double(9.5), t0 + 3200 + 100);
+    ASSERT(std::abs(x18::to_double(*feed.premium_ewma(1)) - 9.5) < 1e-9);
+    feed.record_premium(2, x18::from_double(4.0), t0);
+    ASSERT(std::abs(x18::to_double(*feed.premium_ewma(2)) - 4.0) < 1e-9);
+}
+
+// Test: Published all-markets price table
+TEST(feed_price_table) {
+    LXOracle oracle;
+    LXFeed feed(oracle);
+    for (uint32_t m = 1; m <= 100; ++m) {
+        OracleConfig config{};
+        config.asset_id = m;
+        config.max_staleness = 3600;
+        config.sources = {PriceSource::BINANCE};
+        oracle.register_asset(config);
+        feed.register_market(m, m);
+    }
+
+    // Readers copy the table while the oracle and book move prices; every
+    // record they see must be internally consistent
+    std::atomic<bool> done{false};
+    std::atomic<int> torn{0};
+    std::thread reader([&] {
+        std::vector<LXFeed::PriceRecord> table;
+        while (!done.load()) {
+            feed.read_price_table(table);
+            for (const auto& r : table) {
+                if (r.prices.index_x18 != 0 && r.prices.mark_x18 != r.prices.index_x18) torn++;
+            }
+        }
+    });
+    for (int round = 1; round <= 20; ++round) {
+        for (uint32_t m = 1; m <= 100; ++m) {
+            oracle.update_price(m, PriceSource::BINANCE, x18::from_double(m + round), 0);
+        }
+    }
+    feed.update_last_price(7, x18::from_double(99.0));
+    feed.update_bbo(7, x18::from_double(98.0), x18::from_double(100.0));
+    done = true;
+    reader.join();
+    ASSERT_EQ(torn.load(), 0);
+
+    std::vector<LXFeed::PriceRecord> table;
+    ASSERT_EQ(feed.read_price_table(table), 100u);
+    for (const auto& r : table) {
+        ASSERT(r.prices.index_x18 == x18::from_double(r.market_id + 20));
+        ASSERT(r.version >= 21);
+    }
+    const auto& r7 = table[6];
+    ASSERT_EQ(r7.market_id, 7u);
+    ASSERT(r7.prices.last_x18 == x18::from_double(99.0));
+    ASSERT(r7.prices.mid_x18 == x18::from_double(99.0));
+
+    // Unregistered markets drop out and their slot is reused
+    feed.unregister_market(7);
+    ASSERT_EQ(feed.read_price_table(table), 99u);
+    feed.register_market(500, 3);
+    ASSERT_EQ(feed.read_price_table(table), 100u);
+    ASSERT_EQ(table[6].market_id, 500u);
+    ASSERT(table[6].prices.index_x18 == x18::from_double(23.0));
+}
+
+// Test: Batch trigger thresholds in the feed
+TEST(feed_batch_triggers) {
+    LXOracle oracle;
+    OracleConfig config{};
+    config.asset_id = 1;
+    config.max_staleness = 3600;
+    config.sources = {PriceSource::BINANCE};
+    oracle.register_asset(config);
+    LXFeed feed(oracle);
+    feed.register_market(1, 1);
+
+    auto px = [](double p) { return x18::from_double(p); };
+    std::vector<uint64_t> ids;
+    for (int i = 0; i < 10; ++i) {
+        ids.push_back(feed.add_trigger(1, TriggerType::STOP_LOSS, true, px(100 - i)));    // 100..91
+        ids.push_back(feed.add_trigger(1, TriggerType::STOP_LOSS, false, px(110 + i)));   // 110..119
+    }
+    const uint64_t liq = feed.add_trigger(1, TriggerType::LIQUIDATION, true, px(80));
+    ASSERT_EQ(feed.add_trigger(1, TriggerType::FUNDING, true, px(1)), 0u);
+    ASSERT_EQ(feed.trigger_count(), 21u);
+    ASSERT(feed.remove_trigger(ids[2]));    // Buy at 99
+    ASSERT(!feed.remove_trigger(ids[2]));
+
+    // A direct evaluation agrees with check_trigger and consumes what fired
+    std::vector<LXFeed::FiredTrigger> fired;
+    ASSERT_EQ(feed.evaluate_triggers(1, TriggerType::STOP_LOSS, px(96), fired), 4u);
+    for (const auto& f : fired) {
+        ASSERT(f.is_buy && f.trigger_price_x18 >= px(96));
+    }
+    fired.clear();
+    ASSERT_EQ(feed.evaluate_triggers(1, TriggerType::STOP_LOSS, px(96), fired), 0u);
+
+    // Last trades fire through the listener; liquidation watches the mark
+    std::vector<LXFeed::FiredTrigger> heard;
+    feed.set_trigger_listener([&](const std::vector<LXFeed::FiredTrigger>& f) {
+        heard.insert(heard.end(), f.begin(), f.end());
+    });
+    feed.update_last_price(1, px(112));
+    ASSERT_EQ(heard.size(), 3u);
+    ASSERT(!heard[0].is_buy && heard[0].trigger_price_x18 == px(110));
+    ASSERT(heard[2].trigger_price_x18 == px(112));
+    heard.clear();
+    oracle.update_price(1, PriceSource::BINANCE, px(79), 0);
+    ASSERT_EQ(heard.size(), 1u);
+    ASSERT_EQ(heard[0].id, liq);
+    ASSERT(heard[0].type == TriggerType::LIQUIDATION);
+    ASSERT_EQ(feed.trigger_count(), 21u - 1 - 4 - 3 - 1);
+
+    feed.unregister_market(1);
+    ASSERT_EQ(feed.trigger_count(), 0u);
+}
+
+// Test: Staleness detection
+TEST(oracle_staleness) {
     LXOracle oracle;
 
     OracleConfig config{};
@@ -775,6 +3007,409 @@ TEST(lxbook_matching) {
     ASSERT(result.filled_size_x18 > 0);
 }
 
+// Test: LXBook per-market stats
+TEST(lxbook_market_stats) {
+    LXBook book;
+
+    BookMarketConfig config{};
+    config.market_id = 1;
+    config.symbol_id = 100;
+    config.lot_size_x18 = x18::from_double(0.001);
+    config.max_order_size_x18 = x18::from_double(1000000.0);
+    config.status = 1;
+    book.create_market(config);
+
+    LXAccount buyer{};
+    buyer.main[19] = 0x01;
+    LXAccount seller{};
+    seller.main[19] = 0x02;
+
+    LXOrder buy{};
+    buy.market_id = 1;
+    buy.is_buy = true;
+    buy.kind = OrderKind::LIMIT;
+    buy.size_x18 = x18::from_double(10.0);
+    buy.limit_px_x18 = x18::from_double(100.0);
+    buy.tif = TIF::GTC;
+    book.place_order(buyer, buy);
+
+    LXOrder sell = buy;
+    sell.is_buy = false;
+    sell.size_x18 = x18::from_double(5.0);
+    book.place_order(seller, sell);
+
+    auto market_stats = book.get_market_stats(1);
+    ASSERT(market_stats.has_value());
+    ASSERT_EQ(market_stats->orders_placed, 2u);
+    ASSERT_EQ(market_stats->total_trades, 1u);
+    ASSERT(!book.get_market_stats(2).has_value());
+    ASSERT_EQ(book.get_stats().total_orders_filled, 1u);  // The sell
+}
+
+// Test: LXBook resolved market handles
+TEST(lxbook_market_handles) {
+    LXBook book;
+
+    BookMarketConfig config{};
+    config.market_id = 1;
+    config.symbol_id = 100;
+    config.lot_size_x18 = x18::from_double(0.001);
+    config.max_order_size_x18 = x18::from_double(1000000.0);
+    config.status = 1;
+    book.create_market(config);
+    ASSERT(book.resolve_market(2) == nullptr);
+
+    MarketHandle market = book.resolve_market(1);
+    ASSERT(market != nullptr);
+    ASSERT_EQ(market->version, 1u);
+    ASSERT(!book.refresh_market(market));
+
+    LXAccount buyer{};
+    buyer.main[19] = 0x01;
+    LXAccount seller{};
+    seller.main[19] = 0x02;
+
+    LXOrder buy{};
+    buy.market_id = 1;
+    buy.is_buy = true;
+    buy.kind = OrderKind::LIMIT;
+    buy.size_x18 = x18::from_double(10.0);
+    buy.limit_px_x18 = x18::from_double(100.0);
+    buy.tif = TIF::GTC;
+    auto placed = book.place_order(buyer, buy, market);
+    ASSERT(placed.oid > 0);
+    ASSERT(book.get_order(1, placed.oid).has_value());
+
+    // The handle belongs to market 1 only
+    LXOrder other = buy;
+    other.market_id = 2;
+    ASSERT(book.place_order(buyer, other, market).status ==
+           static_cast<uint8_t>(BookOrderStatus::REJECTED));
+
+    // Cancel-only: a stale handle still sees the new config
+    config.status = 2;
+    ASSERT_EQ(book.update_market_config(config), errors::OK);
+    LXOrder sell{};
+    sell.market_id = 1;
+    sell.is_buy = false;
+    sell.kind = OrderKind::MARKET;
+    sell.size_x18 = x18::from_double(5.0);
+    sell.tif = TIF::IOC;
+    ASSERT(book.place_order(seller, sell, market).status ==
+           static_cast<uint8_t>(BookOrderStatus::REJECTED));
+
+    MarketHandle stale = market;
+    ASSERT(book.refresh_market(market));
+    ASSERT_EQ(market->version, 2u);
+    ASSERT_EQ(market->config.status, 2u);
+    ASSERT_EQ(stale->version, 1u);  // Old versions stay readable
+
+    config.status = 1;
+    book.update_market_config(config);
+    auto filled = book.place_order(seller, sell, market);
+    ASSERT(filled.filled_size_x18 == x18::from_double(5.0));
+}
+
+// Test: LXBook recent trades ring
+TEST(lxbook_recent_trades) {
+    TradeRing ring(8);
+    for (uint64_t i = 0; i < 20; ++i) {
+        Trade trade{};
+        trade.id = i;
+        ring.push(trade);
+    }
+    ASSERT_EQ(ring.next_sequence(), 20u);
+    ASSERT_EQ(ring.first_sequence(), 12u);
+
+    std::vector<uint64_t> seen;
+    uint64_t resume = ring.read_since(3, [&](uint64_t sequence, const Trade& trade) {
+        ASSERT_EQ(sequence, trade.id);
+        seen.push_back(trade.id);
+        return true;
+    });
+    ASSERT_EQ(resume, 20u);
+    ASSERT_EQ(seen.size(), 8u);
+    ASSERT_EQ(seen.front(), 12u);
+    ASSERT_EQ(ring.read_since(20, [](uint64_t, const Trade&) { return true; }), 20u);
+    ASSERT_EQ(ring.last()->id, 19u);
+
+    LXBook book;
+    BookMarketConfig config{};
+    config.market_id = 3;
+    config.symbol_id = 300;
+    config.lot_size_x18 = x18::from_double(0.001);
+    config.max_order_size_x18 = x18::from_double(1000000.0);
+    config.status = 1;
+    book.create_market(config);
+
+    LXAccount maker{};
+    maker.main[19] = 0x01;
+    LXAccount taker{};
+    taker.main[19] = 0x02;
+
+    const TradeRing* trades = book.get_trade_ring(3);
+    ASSERT(trades != nullptr);
+    std::atomic<bool> done{false};
+    std::thread reader([&] {
+        uint64_t cursor = 0;
+        while (!done.load()) {
+            cursor = trades->read_since(cursor, [](uint64_t, const Trade& trade) {
+                ASSERT_EQ(trade.symbol_id, 300u);
+                return true;
+            });
+        }
+    });
+
+    for (int i = 0; i < 1100; ++i) {
+        LXOrder order{};
+        order.market_id = 3;
+        order.kind = OrderKind::LIMIT;
+        order.size_x18 = x18::from_double(1.0);
+        order.limit_px_x18 = x18::from_double(50.0 + (i % 7));
+        order.tif = TIF::GTC;
+        order.is_buy = false;
+        book.place_order(maker, order);
+        order.is_buy = true;
+        book.place_order(taker, order);
+    }
+    done = true;
+    reader.join();
+
+    auto recent = book.get_recent_trades(3, 5);
+    ASSERT_EQ(recent.size(), 5u);
+    ASSERT(recent.back().id > recent.front().id);
+    ASSERT_EQ(book.get_recent_trades(3, 5000).size(), trades->capacity());
+    ASSERT(book.get_last_trade(3).has_value());
+    ASSERT(book.get_l1(3).last_trade_px_x18 > 0);
+    ASSERT(book.get_trade_ring(4) == nullptr);
+}
+
+// Test: LXBook account order index across markets and fills
+TEST(lxbook_order_index) {
+    LXBook book;
+    for (uint32_t market_id : {5u, 6u}) {
+        BookMarketConfig config{};
+        config.market_id = market_id;
+        config.symbol_id = market_id * 100;
+        config.lot_size_x18 = x18::from_double(0.001);
+        config.max_order_size_x18 = x18::from_double(1000000.0);
+        config.status = 1;
+        book.create_market(config);
+    }
+
+    LXAccount maker{};
+    maker.main[19] = 0x11;
+    LXAccount taker{};
+    taker.main[19] = 0x12;
+
+    auto limit = [](uint32_t market_id, bool is_buy, double price, uint8_t cloid) {
+        LXOrder order{};
+        order.market_id = market_id;
+        order.is_buy = is_buy;
+        order.kind = OrderKind::LIMIT;
+        order.size_x18 = x18::from_double(1.0);
+        order.limit_px_x18 = x18::from_double(price);
+        order.tif = TIF::GTC;
+        order.cloid[0] = cloid;
+        return order;
+    };
+
+    uint64_t first = book.place_order(maker, limit(5, false, 100.0, 1)).oid;
+    book.place_order(maker, limit(5, false, 101.0, 2));
+    book.place_order(maker, limit(5, false, 102.0, 3));
+    book.place_order(maker, limit(6, false, 100.0, 4));
+
+    // The taker fills the maker's best order; the fill lands on the maker's state
+    book.place_order(taker, limit(5, true, 100.0, 9));
+    auto filled = book.get_order(5, first);
+    ASSERT(filled.has_value());
+    ASSERT(filled->status == BookOrderStatus::FILLED);
+    ASSERT(!book.get_order(6, first).has_value());
+
+    auto market5 = book.get_orders(maker, 5);
+    ASSERT_EQ(market5.size(), 3u);
+    ASSERT_EQ(market5.front().oid, first);
+    ASSERT_EQ(book.get_all_orders(maker).size(), 4u);
+
+    std::array<uint8_t, 16> cloid{};
+    cloid[0] = 3;
+    ASSERT(book.get_order_by_cloid(5, cloid).has_value());
+
+    // Only the two resting orders on market 5 are cancelled
+    ASSERT_EQ(book.cancel_all(maker, 5), errors::OK);
+    ASSERT_EQ(book.get_stats().total_orders_cancelled, 2u);
+    for (const auto& state : book.get_orders(maker, 5)) {
+        ASSERT(state.status == BookOrderStatus::FILLED || state.status == BookOrderStatus::CANCELLED);
+    }
+    ASSERT(book.get_orders(maker, 6).front().status == BookOrderStatus::OPEN);
+}
+
+// Test: LXBook stop / take-profit trigger book
+TEST(lxbook_trigger_orders) {
+    LXBook book;
+    BookMarketConfig config{};
+    config.market_id = 8;
+    config.symbol_id = 800;
+    config.lot_size_x18 = x18::from_double(0.001);
+    config.max_order_size_x18 = x18::from_double(1000000.0);
+    config.status = 1;
+    book.create_market(config);
+
+    LXAccount maker{};
+    maker.main[19] = 0x31;
+    LXAccount trader{};
+    trader.main[19] = 0x32;
+
+    auto order = [](OrderKind kind, bool is_buy, double size, double price, double trigger) {
+        LXOrder o{};
+        o.market_id = 8;
+        o.kind = kind;
+        o.is_buy = is_buy;
+        o.size_x18 = x18::from_double(size);
+        o.limit_px_x18 = x18::from_double(price);
+        o.trigger_px_x18 = x18::from_double(trigger);
+        o.tif = TIF::GTC;
+        return o;
+    };
+    for (double px : {100.0, 101.0, 102.0}) {
+        book.place_order(maker, order(OrderKind::LIMIT, false, 1.0, px, 0));
+    }
+
+    uint64_t stop_buy = book.place_order(trader, order(OrderKind::STOP_MARKET, true, 1.0, 0, 101.0)).oid;
+    uint64_t stop_sell = book.place_order(trader, order(OrderKind::STOP_LIMIT, false, 1.0, 94.0, 90.0)).oid;
+    auto take = book.place_trigger_order(trader, order(OrderKind::TAKE_LIMIT, true, 1.0, 80.0, 80.0),
+                                         PriceType::MARK);
+    ASSERT_EQ(take.status, static_cast<uint8_t>(BookOrderStatus::NEW));
+    for (int i = 0; i < 1000; ++i) {
+        book.place_order(trader, order(OrderKind::STOP_MARKET, true, 0.001, 0, 200.0 + i));
+    }
+    ASSERT_EQ(book.pending_trigger_count(8), 1003u);
+    ASSERT(book.get_order(8, stop_buy)->status == BookOrderStatus::NEW);
+
+    ASSERT_EQ(book.on_price(8, PriceType::LAST, x18::from_double(100.5)), 0u);
+    ASSERT_EQ(book.on_price(8, PriceType::LAST, x18::from_double(101.0)), 1u);
+    auto fired = book.get_order(8, stop_buy);
+    ASSERT(fired->status == BookOrderStatus::FILLED);
+    ASSERT(fired->filled_size_x18 == x18::from_double(1.0));
+
+    // Mark moves do not touch orders watching the last price, and vice versa
+    ASSERT_EQ(book.on_price(8, PriceType::MARK, x18::from_double(85.0)), 0u);
+    ASSERT_EQ(book.on_price(8, PriceType::LAST, x18::from_double(70.0)), 1u);
+    ASSERT(book.get_order(8, stop_sell)->status == BookOrderStatus::OPEN);  // Rests at 94
+    ASSERT_EQ(book.pending_trigger_count(8), 1001u);
+    ASSERT_EQ(book.cancel_order(trader, 8, take.oid), errors::OK);
+    ASSERT(book.get_order(8, take.oid)->status == BookOrderStatus::CANCELLED);
+
+    ASSERT_EQ(book.on_price(8, PriceType::LAST, x18::from_double(250.0)), 51u);
+    ASSERT_EQ(book.pending_trigger_count(8), 949u);
+
+    // Already crossed at placement: executes straight away
+    uint64_t late = book.place_order(trader, order(OrderKind::STOP_MARKET, true, 0.001, 0, 240.0)).oid;
+    ASSERT(book.get_order(8, late)->status == BookOrderStatus::FILLED);
+    ASSERT_EQ(book.pending_trigger_count(8), 949u);
+
+    // Resting triggers survive a snapshot
+    const std::string path = "/tmp/luxdex_test_triggers_" + std::to_string(::getpid());
+    ASSERT(book.save_snapshot(path));
+    LXBook restored;
+    ASSERT(restored.load_snapshot(path));
+    std::remove(path.c_str());
+    ASSERT_EQ(restored.pending_trigger_count(8), 949u);
+    ASSERT_EQ(restored.on_price(8, PriceType::LAST, x18::from_double(1300.0)), 949u);
+}
+
+// Test: LXBook mass quotes diff a ladder against the resting one
+TEST(lxbook_mass_quote) {
+    LXBook book;
+    BookMarketConfig config{};
+    config.market_id = 9;
+    config.symbol_id = 900;
+    config.lot_size_x18 = x18::from_double(0.001);
+    config.max_order_size_x18 = x18::from_double(1000000.0);
+    config.status = 1;
+    book.create_market(config);
+
+    LXAccount maker{};
+    maker.main[19] = 0x41;
+    LXAccount other{};
+    other.main[19] = 0x42;
+    LXAccount taker{};
+    taker.main[19] = 0x43;
+
+    auto quote = [](bool is_buy, double px, double size) {
+        return LXQuote{is_buy, x18::from_double(px), x18::from_double(size)};
+    };
+    auto limit = [](bool is_buy, double size, double px, TIF tif) {
+        LXOrder o{};
+        o.market_id = 9;
+        o.kind = OrderKind::LIMIT;
+        o.is_buy = is_buy;
+        o.size_x18 = x18::from_double(size);
+        o.limit_px_x18 = x18::from_double(px);
+        o.tif = tif;
+        return o;
+    };
+
+    std::vector<LXQuote> ladder = {quote(true, 99, 1), quote(true, 98, 1),
+                                   quote(false, 101, 1), quote(false, 102, 1)};
+    auto first = book.mass_quote(maker, 9, ladder.data(), ladder.size());
+    ASSERT_EQ(first.error_code, errors::OK);
+    ASSERT_EQ(first.placed, 4u);
+
+    // Joins the 99 bid behind the maker
+    uint64_t behind = book.place_order(other, limit(true, 1.0, 99.0, TIF::GTC)).oid;
+
+    ladder = {quote(true, 99, 0.5), quote(false, 101, 2), quote(false, 102, 1),
+              quote(false, 103, 1), quote(true, 97, 0)};
+    auto second = book.mass_quote(maker, 9, ladder.data(), ladder.size());
+    ASSERT_EQ(second.error_code, errors::OK);
+    ASSERT_EQ(second.kept, 1u);       // 102
+    ASSERT_EQ(second.reduced, 1u);    // 99
+    ASSERT_EQ(second.requeued, 1u);   // 101
+    ASSERT_EQ(second.placed, 1u);     // 103
+    ASSERT_EQ(second.cancelled, 1u);  // 98
+    ASSERT_EQ(second.rejected, 1u);   // Zero size
+
+    // The reduced quote is still ahead of the order that joined after it
+    book.place_order(taker, limit(false, 0.5, 99.0, TIF::IOC));
+    ASSERT(book.get_order(9, behind)->filled_size_x18 == 0);
+
+    size_t open = 0, filled = 0, cancelled = 0;
+    for (const auto& state : book.get_orders(maker, 9)) {
+        open += state.status == BookOrderStatus::OPEN;
+        filled += state.status == BookOrderStatus::FILLED;
+        cancelled += state.status == BookOrderStatus::CANCELLED;
+    }
+    ASSERT_EQ(open, 3u);
+    ASSERT_EQ(filled, 1u);
+    ASSERT_EQ(cancelled, 1u);
+
+    LXL1 l1 = book.get_l1(9);
+    ASSERT(l1.best_bid_px_x18 == x18::from_double(99.0));
+    ASSERT(l1.best_ask_px_x18 == x18::from_double(101.0));
+    ASSERT(l1.best_ask_sz_x18 == x18::from_double(2.0));
+
+    // Packed form: a one-level ladder replaces the three remaining quotes
+    std::vector<uint8_t> data{static_cast<uint8_t>(ActionType::MASS_QUOTE)};
+    packed::PackedMassQuoteHeader header{9, 1};
+    packed::PackedQuoteLevel level{0, 105 * 100000000LL, 1 * 100000000LL};
+    data.insert(data.end(), reinterpret_cast<uint8_t*>(&header),
+                reinterpret_cast<uint8_t*>(&header) + sizeof(header));
+    data.insert(data.end(), reinterpret_cast<uint8_t*>(&level),
+                reinterpret_cast<uint8_t*>(&level) + sizeof(level));
+    ASSERT_EQ(LXBook::count_packed_actions(data.data(), data.size()), 1u);
+
+    packed::PackedPlaceResult result{};
+    ASSERT_EQ(book.execute_batch_packed(maker, data.data(), data.size(), &result, 1), 1u);
+    ASSERT_EQ(result.oid, 1u);
+    ASSERT_EQ(result.status, static_cast<uint8_t>(BookOrderStatus::OPEN));
+    ASSERT(book.get_l1(9).best_ask_px_x18 == x18::from_double(105.0));
+
+    // Truncated ladders are not executed
+    data.pop_back();
+    ASSERT_EQ(LXBook::count_packed_actions(data.data(), data.size()), 0u);
+}
+
 // Test: LXBook L1 market data
 TEST(lxbook_l1) {
     LXBook book;
@@ -853,6 +3488,66 @@ TEST(lxbook_packed_interface) {
     }
 }
 
+// Test: LXBook zero-copy packed batch
+TEST(lxbook_packed_batch) {
+    LXBook book;
+
+    BookMarketConfig config{};
+    config.market_id = 1;
+    config.symbol_id = 100;
+    config.lot_size_x18 = x18::from_double(0.001);
+    config.max_order_size_x18 = x18::from_double(1000000.0);
+    config.status = 1;
+    book.create_market(config);
+
+    std::vector<uint8_t> batch;
+    auto append = [&batch](ActionType type, const void* payload, size_t size) {
+        batch.push_back(static_cast<uint8_t>(type));
+        const auto* bytes = static_cast<const uint8_t*>(payload);
+        batch.insert(batch.end(), bytes, bytes + size);
+    };
+
+    // 1000 asks, then a buy sweeping the first two, then a cancel of an
+    // unknown order, a noop and a truncated place
+    packed::PackedPlaceOrder place{};
+    place.market_id = 1;
+    place.size = 10000000LL;  // 0.1
+    for (int i = 0; i < 1000; ++i) {
+        place.limit_price = (100 + i) * 100000000LL;
+        append(ActionType::PLACE, &place, sizeof(place));
+    }
+    place.flags = packed::FLAG_IS_BUY;
+    place.size = 20000000LL;
+    place.limit_price = 101 * 100000000LL;
+    append(ActionType::PLACE, &place, sizeof(place));
+
+    packed::PackedCancelOrder cancel{1, 999999999ull};
+    append(ActionType::CANCEL, &cancel, sizeof(cancel));
+    append(ActionType::NOOP, nullptr, 0);
+    append(ActionType::PLACE, &place, sizeof(place) - 1);
+
+    ASSERT_EQ(LXBook::count_packed_actions(batch.data(), batch.size()), 1003u);
+
+    std::vector<packed::PackedPlaceResult> results(1003);
+    LXAccount sender{};
+    sender.main[19] = 0x21;
+    size_t executed = book.execute_batch_packed(sender, batch.data(), batch.size(),
+                                                results.data(), results.size());
+    ASSERT_EQ(executed, 1003u);
+    ASSERT(results[0].oid > 0);
+    ASSERT_EQ(results[1000].filled_size, 20000000LL);
+    ASSERT_EQ(results[1000].avg_price, 10050000000LL);
+    ASSERT_EQ(results[1001].status, static_cast<uint8_t>(BookOrderStatus::REJECTED));
+    ASSERT_EQ(results[1002].oid, 0u);
+
+    // Output capacity bounds the work done
+    ASSERT_EQ(book.execute_batch_packed(sender, batch.data(), batch.size(), results.data(), 3), 3u);
+
+    // Vector form returns one result per action
+    std::vector<uint8_t> single(batch.begin(), batch.begin() + 1 + sizeof(place));
+    ASSERT_EQ(book.execute_batch_packed(single).size(), sizeof(packed::PackedPlaceResult));
+}
+
 // Test: LXBook settlement callback
 TEST(lxbook_settlement_callback) {
     LXBook book;
@@ -900,6 +3595,1991 @@ TEST(lxbook_settlement_callback) {
     // Just verify no crash
 }
 
+// Test: asynchronous settlement pipeline into the vault
+TEST(settlement_pipeline) {
+    LXVault vault;
+    MarketConfig market{};
+    market.market_id = 7;
+    market.initial_margin_x18 = x18::from_double(0.1);
+    market.maintenance_margin_x18 = x18::from_double(0.05);
+    market.max_leverage_x18 = x18::from_double(10.0);
+    market.active = true;
+    ASSERT_EQ(vault.create_market(market), errors::OK);
+
+    LXAccount seller{{}, 1};
+    LXAccount buyer{{}, 2};
+    ASSERT_EQ(vault.deposit(seller, Currency{}, x18::from_double(1000000.0)), errors::OK);
+    ASSERT_EQ(vault.deposit(buyer, Currency{}, x18::from_double(1000000.0)), errors::OK);
+
+    auto fill = [](uint64_t seller_id, uint64_t buyer_id, Price price) {
+        Trade trade{};
+        trade.symbol_id = 7;
+        trade.seller_account_id = seller_id;
+        trade.buyer_account_id = buyer_id;
+        trade.price = price;
+        trade.quantity = 1000000;  // 0.01
+        trade.aggressor_side = Side::Buy;
+        return trade;
+    };
+
+    SettlementConfig config;
+    config.queue_capacity = 16;
+    config.max_batch = 64;
+    SettlementPipeline pipeline(vault, config);
+
+    // Ten fills between one pair net into a single settlement; the fill
+    // from the unfunded account 3 is rejected on its own
+    for (int i = 0; i < 10; ++i) {
+        ASSERT_EQ(pipeline.publish(fill(1, 2, (i % 2 ? 102 : 100) * 100000000LL)), uint64_t(i + 1));
+    }
+    ASSERT_EQ(pipeline.publish(fill(3, 2, 100 * 100000000LL)), 11u);
+    ASSERT_EQ(pipeline.settled_sequence(), 0u);
+    ASSERT_EQ(pipeline.drain(), 11u);
+    ASSERT_EQ(pipeline.settled_sequence(), 11u);
+
+    auto stats = pipeline.get_stats();
+    ASSERT_EQ(stats.settlements_applied, 1u);
+    ASSERT_EQ(stats.settlements_rejected, 1u);
+    ASSERT(stats.last_error == errors::INSUFFICIENT_BALANCE);
+    auto position = vault.get_position(buyer, 7);
+    ASSERT(position.has_value());
+    ASSERT(position->size_x18 == x18::from_double(0.1));
+    ASSERT(position->entry_px_x18 == x18::from_double(101.0));
+
+    // Concurrent producers against a small ring exercise back-pressure
+    pipeline.start();
+    std::vector<std::thread> producers;
+    for (int t = 0; t < 4; ++t) {
+        producers.emplace_back([&pipeline, &fill] {
+            for (int i = 0; i < 1000; ++i) {
+                ASSERT(pipeline.publish(fill(1, 2, 100 * 100000000LL)) > 0);
+            }
+        });
+    }
+    for (auto& producer : producers) {
+        producer.join();
+    }
+    pipeline.wait_settled(pipeline.published_sequence());
+    ASSERT_EQ(pipeline.settled_sequence(), 4011u);
+    pipeline.stop();
+
+    stats = pipeline.get_stats();
+    ASSERT_EQ(stats.trades_settled, 4011u);
+    ASSERT_EQ(stats.dropped, 0u);
+    ASSERT(vault.get_position(buyer, 7)->size_x18 == x18::from_double(40.1));
+}
+
+// Test: LX settles book fills between the accounts that placed them
+TEST(lx_fill_accounts) {
+    LX lx;
+    lx.initialize();
+
+    MarketConfig vault_config{};
+    vault_config.market_id = 3;
+    vault_config.initial_margin_x18 = x18::from_double(0.1);
+    vault_config.maintenance_margin_x18 = x18::from_double(0.05);
+    vault_config.max_leverage_x18 = x18::from_double(10.0);
+    vault_config.active = true;
+    BookMarketConfig book_config{};
+    book_config.market_id = 3;
+    book_config.symbol_id = 3;      // Trades carry the symbol as the vault market
+    book_config.lot_size_x18 = x18::from_double(0.001);
+    book_config.max_order_size_x18 = x18::from_double(1000000.0);
+    book_config.status = 1;
+    ASSERT_EQ(lx.create_perp_market(3, 3, vault_config, book_config), errors::OK);
+
+    LXAccount maker{};
+    maker.main[0] = 0xAA;
+    LXAccount taker{};
+    taker.main[0] = 0xBB;
+    ASSERT_EQ(lx.vault().deposit(maker, Currency{}, x18::from_double(1000.0)), errors::OK);
+    ASSERT_EQ(lx.vault().deposit(taker, Currency{}, x18::from_double(1000.0)), errors::OK);
+
+    LXOrder bid{};
+    bid.market_id = 3;
+    bid.is_buy = true;
+    bid.kind = OrderKind::LIMIT;
+    bid.size_x18 = X18_ONE;
+    bid.limit_px_x18 = x18::from_double(10.0);
+    bid.tif = TIF::GTC;
+    lx.book().place_order(maker, bid);
+    ASSERT(lx.book().get_account(maker.hash()) == maker);
+
+    // The selling aggressor is the taker: maker long, taker short
+    LXOrder ask = bid;
+    ask.is_buy = false;
+    ask.tif = TIF::IOC;
+    ASSERT(lx.book().place_order(taker, ask).filled_size_x18 == X18_ONE);
+
+    auto maker_position = lx.vault().get_position(maker, 3);
+    auto taker_position = lx.vault().get_position(taker, 3);
+    ASSERT(maker_position.has_value() && taker_position.has_value());
+    ASSERT(maker_position->side == PositionSide::LONG);
+    ASSERT(taker_position->side == PositionSide::SHORT);
+    ASSERT(taker_position->size_x18 == -X18_ONE);
+}
+
+// Test: trace spans across the LX hot path, and their exporters
+TEST(lx_tracing) {
+    for (uint64_t v : {0ull, 31ull, 32ull, 33ull, 63ull, 64ull, 1000ull, 123456789ull}) {
+        const size_t b = HdrHistogram::bucket_of(v);
+        ASSERT(HdrHistogram::bucket_lower(b) <= v && v < HdrHistogram::bucket_lower(b + 1));
+    }
+    ASSERT_EQ(HdrHistogram::bucket_of(uint64_t{1} << 50), HdrHistogram::BUCKETS - 1);
+
+    LX lx;
+    lx.initialize();
+
+    MarketConfig vault_config{};
+    vault_config.market_id = 4;
+    vault_config.initial_margin_x18 = x18::from_double(0.1);
+    vault_config.maintenance_margin_x18 = x18::from_double(0.05);
+    vault_config.max_leverage_x18 = x18::from_double(10.0);
+    vault_config.active = true;
+    BookMarketConfig book_config{};
+    book_config.market_id = 4;
+    book_config.symbol_id = 4;
+    book_config.lot_size_x18 = x18::from_double(0.001);
+    book_config.max_order_size_x18 = x18::from_double(1000000.0);
+    book_config.status = 1;
+    ASSERT_EQ(lx.create_perp_market(4, 4, vault_config, book_config), errors::OK);
+
+    LXAccount maker{};
+    maker.main[0] = 0xAA;
+    LXAccount taker{};
+    taker.main[0] = 0xBB;
+    ASSERT_EQ(lx.vault().deposit(maker, Currency{}, x18::from_double(1000.0)), errors::OK);
+    ASSERT_EQ(lx.vault().deposit(taker, Currency{}, x18::from_double(1000.0)), errors::OK);
+
+    LXOrder bid{};
+    bid.market_id = 4;
+    bid.is_buy = true;
+    bid.kind = OrderKind::LIMIT;
+    bid.size_x18 = X18_ONE;
+    bid.limit_px_x18 = x18::from_double(10.0);
+    bid.tif = TIF::GTC;
+    LXOrder ask = bid;
+    ask.is_buy = false;
+    ask.tif = TIF::IOC;
+
+    // Nothing is recorded while tracing is off
+    Tracer::reset();
+    lx.book().place_order(maker, bid);
+    ASSERT_EQ(Tracer::summary(TracePoint::OrderIngress).count, 0u);
+
+    Tracer::enable(16);
+    const uint64_t oid = lx.book().place_order(maker, bid).oid;
+    ASSERT(lx.book().place_order(taker, ask).filled_size_x18 == X18_ONE);
+    Tracer::disable();
+
+#if LUX_TRACING
+    ASSERT_EQ(Tracer::summary(TracePoint::OrderIngress).count, 2u);
+    ASSERT_EQ(Tracer::summary(TracePoint::Matching).count, 2u);
+    ASSERT_EQ(Tracer::summary(TracePoint::Settlement).count, 1u);
+    ASSERT_EQ(Tracer::summary(TracePoint::VaultApply).count, 1u);
+    const TraceSummary ingress = Tracer::summary(TracePoint::OrderIngress);
+    ASSERT(ingress.quantile_ns(0.5) <= ingress.quantile_ns(1.0));
+    ASSERT(ingress.quantile_ns(1.0) <= static_cast<double>(ingress.max_ticks) * Tracer::ns_per_tick());
+
+    bool saw_order = false;
+    for (const TraceEvent& event : Tracer::events()) {
+        saw_order |= event.point == TracePoint::OrderIngress && event.id == oid;
+    }
+    ASSERT(saw_order);
+
+    const std::string text = Tracer::prometheus();
+    ASSERT(text.find("# TYPE luxdex_trace_span_seconds histogram") != std::string::npos);
+    ASSERT(text.find("luxdex_trace_span_seconds_count{point=\"order_ingress\"} 2") != std::string::npos);
+    ASSERT(text.find("luxdex_trace_span_seconds_bucket{point=\"vault_apply\",le=\"+Inf\"} 1") !=
+           std::string::npos);
+#else
+    (void)oid;
+#endif
+
+    const std::string path = "/tmp/luxdex_test_trace_" + std::to_string(::getpid());
+    ASSERT(Tracer::write_binary(path));
+    std::FILE* file = std::fopen(path.c_str(), "rb");
+    char magic[4] = {};
+    uint32_t version = 0;
+    ASSERT(std::fread(magic, sizeof(magic), 1, file) == 1);
+    ASSERT(std::fread(&version, sizeof(version), 1, file) == 1);
+    std::fclose(file);
+    ::unlink(path.c_str());
+    ASSERT(std::memcmp(magic, "LXTR", 4) == 0);
+    ASSERT_EQ(version, 1u);
+    Tracer::reset();
+}
+
+#if LUX_COROUTINES
+// Test: coroutine flows on an EventLoop, and over an in-process LX
+TEST(async_lx_flows) {
+    using namespace lux::async;
+
+    {
+        // Flows interleave at yield points; timers fire in deadline order
+        EventLoop loop;
+        std::vector<int> order;
+        auto flow = [&order](int id) -> Task<void> {
+            order.push_back(id);
+            co_await yield();
+            order.push_back(id + 10);
+            co_await sleep_for(std::chrono::milliseconds(id));
+            order.push_back(id + 20);
+        };
+        loop.spawn(flow(2));
+        loop.spawn(flow(1));
+        loop.run();
+        ASSERT(order == (std::vector<int>{2, 1, 12, 11, 21, 22}));
+        ASSERT_EQ(loop.active(), 0u);
+
+        // Values and exceptions come back through co_await; an escaping
+        // exception stops the loop and leaves run()
+        auto square = [](int x) -> Task<int> { co_return x * x; };
+        auto fail = []() -> Task<void> {
+            throw std::runtime_error("flow");
+            co_return;
+        };
+        int result = 0;
+        auto outer = [&]() -> Task<void> {
+            result = co_await square(7);
+            co_await fail();
+        };
+        loop.spawn(outer());
+        bool threw = false;
+        try {
+            loop.run();
+        } catch (const std::runtime_error&) {
+            threw = true;
+        }
+        ASSERT(threw && result == 49);
+
+        // Another thread hands work in through post(), waking an idle loop
+        Channel<int> channel(loop);
+        int received = 0;
+        auto reader = [&]() -> Task<void> { received = *co_await channel.next(); };
+        loop.spawn(reader());
+        std::thread poster([&] { loop.post([&] { channel.push(5); }); });
+        loop.run();
+        poster.join();
+        ASSERT_EQ(received, 5);
+    }
+
+    LX lx;
+    lx.initialize();
+
+    MarketConfig vault_config{};
+    vault_config.market_id = 5;
+    vault_config.initial_margin_x18 = x18::from_double(0.1);
+    vault_config.maintenance_margin_x18 = x18::from_double(0.05);
+    vault_config.max_leverage_x18 = x18::from_double(10.0);
+    vault_config.active = true;
+    BookMarketConfig book_config{};
+    book_config.market_id = 5;
+    book_config.symbol_id = 5;
+    book_config.lot_size_x18 = x18::from_double(0.001);
+    book_config.max_order_size_x18 = x18::from_double(1000000.0);
+    book_config.status = 1;
+    ASSERT_EQ(lx.create_perp_market(5, 5, vault_config, book_config), errors::OK);
+
+    LXAccount maker{};
+    maker.main[0] = 0xAA;
+    LXAccount taker{};
+    taker.main[0] = 0xBB;
+    ASSERT_EQ(lx.vault().deposit(maker, Currency{}, x18::from_double(1000.0)), errors::OK);
+    ASSERT_EQ(lx.vault().deposit(taker, Currency{}, x18::from_double(1000.0)), errors::OK);
+
+    LXOrder bid{};
+    bid.market_id = 5;
+    bid.is_buy = true;
+    bid.kind = OrderKind::LIMIT;
+    bid.size_x18 = 2 * X18_ONE;
+    bid.limit_px_x18 = x18::from_double(10.0);
+    bid.tif = TIF::GTC;
+    LXOrder ask = bid;
+    ask.is_buy = false;
+    ask.size_x18 = X18_ONE;
+    ask.tif = TIF::IOC;
+    LXOrder far = bid;
+    far.limit_px_x18 = x18::from_double(1.0);
+
+    EventLoop loop;
+    AsyncLX dex(lx, loop);
+    auto trades = dex.subscribe_trades(5);
+    ASSERT(trades != nullptr);
+    ASSERT(dex.subscribe_trades(99) == nullptr);
+
+    std::optional<BookOrderState> filled, timed_out, cancelled;
+    std::vector<Trade> seen;
+    uint64_t far_oid = 0;
+
+    // Rests a bid and waits for all of it, taken in two pieces
+    auto quoting = [&]() -> Task<void> {
+        const LXPlaceResult placed = co_await dex.place(maker, bid);
+        filled = co_await dex.wait_for_fill(5, placed.oid);
+    };
+    auto taking = [&]() -> Task<void> {
+        co_await yield();
+        co_await dex.place(taker, ask);
+        co_await sleep_for(std::chrono::milliseconds(1));
+        co_await dex.place(taker, ask);
+    };
+    auto watching = [&]() -> Task<void> {
+        while (seen.size() < 2) {
+            seen.push_back(*co_await trades->next());
+        }
+    };
+    // Bids that never fill: one waits out its timeout, one is cancelled
+    auto resting = [&]() -> Task<void> {
+        const LXPlaceResult placed = co_await dex.place(maker, far);
+        timed_out = co_await dex.wait_for_fill(5, placed.oid, 0, std::chrono::milliseconds(2));
+        far_oid = (co_await dex.place(maker, far)).oid;
+        cancelled = co_await dex.wait_for_fill(5, far_oid);
+    };
+    auto cancelling = [&]() -> Task<void> {
+        while (far_oid == 0) {
+            co_await yield();
+        }
+        const int32_t result = co_await dex.cancel(maker, 5, far_oid);
+        ASSERT_EQ(result, errors::OK);
+    };
+    loop.spawn(quoting());
+    loop.spawn(taking());
+    loop.spawn(watching());
+    loop.spawn(resting());
+    loop.spawn(cancelling());
+    loop.run();
+
+    ASSERT(filled.has_value());
+    ASSERT(filled->status == BookOrderStatus::FILLED);
+    ASSERT(filled->filled_size_x18 == 2 * X18_ONE);
+    ASSERT_EQ(seen.size(), 2u);
+    ASSERT(seen[0].quantity == seen[1].quantity);
+    ASSERT(timed_out.has_value() && timed_out->status == BookOrderStatus::OPEN);
+    ASSERT(cancelled.has_value() && cancelled->status == BookOrderStatus::CANCELLED);
+}
+#endif
+
+// Test: mark updates only touch positions in the marked market
+TEST(vault_mark_index) {
+    LXVault vault;
+    for (uint32_t id : {1u, 2u}) {
+        MarketConfig market{};
+        market.market_id = id;
+        market.initial_margin_x18 = x18::from_double(0.1);
+        market.maintenance_margin_x18 = x18::from_double(0.05);
+        market.active = true;
+        ASSERT_EQ(vault.create_market(market), errors::OK);
+    }
+
+    LXAccount a{{}, 1};
+    LXAccount b{{}, 2};
+    LXAccount c{{}, 3};
+    for (const LXAccount& account : {a, b, c}) {
+        ASSERT_EQ(vault.deposit(account, Currency{}, x18::from_double(1000.0)), errors::OK);
+    }
+    auto fill = [](const LXAccount& maker, const LXAccount& taker, uint32_t market,
+                   double size, double price) {
+        LXSettlement settlement{};
+        settlement.maker = maker;
+        settlement.taker = taker;
+        settlement.market_id = market;
+        settlement.taker_is_buy = true;
+        settlement.size_x18 = x18::from_double(size);
+        settlement.price_x18 = x18::from_double(price);
+        return settlement;
+    };
+    // a short 1 @ 10 and c short 1 @ 10 in market 1, b long 2;
+    // a long 1 @ 5 in market 2
+    ASSERT_EQ(vault.apply_fills({fill(a, b, 1, 1.0, 10.0), fill(c, b, 1, 1.0, 10.0),
+                                 fill(b, a, 2, 1.0, 5.0)}), errors::OK);
+
+    ASSERT_EQ(vault.update_mark_prices({{1, x18::from_double(11.0)}}), errors::OK);
+    ASSERT(vault.get_position(b, 1)->unrealized_pnl_x18 == x18::from_double(2.0));
+    ASSERT(vault.get_position(a, 1)->unrealized_pnl_x18 == x18::from_double(-1.0));
+    ASSERT(vault.get_position(a, 2)->unrealized_pnl_x18 == 0);
+    ASSERT(vault.account_equity_x18(a) == x18::from_double(999.0));
+
+    ASSERT_EQ(vault.update_mark_prices({{2, x18::from_double(6.0)}}), errors::OK);
+    ASSERT(vault.account_equity_x18(a) == x18::from_double(1000.0));
+    ASSERT(vault.account_equity_x18(b) == x18::from_double(1001.0));
+
+    // Closing a's market-1 short moves c into its slot; the next mark
+    // still reaches c, and a's aggregate drops the closed position
+    ASSERT_EQ(vault.apply_fills({fill(b, a, 1, 1.0, 11.0)}), errors::OK);
+    ASSERT(!vault.get_position(a, 1).has_value());
+    ASSERT(vault.account_equity_x18(a) == x18::from_double(1001.0));
+    ASSERT_EQ(vault.update_mark_prices({{1, x18::from_double(9.0)}}), errors::OK);
+    ASSERT(vault.get_position(c, 1)->unrealized_pnl_x18 == x18::from_double(1.0));
+    ASSERT(vault.account_equity_x18(a) == x18::from_double(1001.0));
+    LXMarginInfo margin = vault.get_margin_info(c);
+    ASSERT(margin.free_margin_x18 + margin.used_margin_x18 == x18::from_double(1001.0));
+}
+
+// Test: account shards let unrelated settlement run concurrently
+TEST(vault_sharded_accounts) {
+    LXVault vault;
+    MarketConfig market{};
+    market.market_id = 1;
+    market.initial_margin_x18 = x18::from_double(0.1);
+    market.active = true;
+    ASSERT_EQ(vault.create_market(market), errors::OK);
+
+    constexpr int THREADS = 4;
+    constexpr int FILLS = 500;
+    std::vector<LXAccount> accounts;
+    for (uint16_t i = 0; i < 2 * THREADS; ++i) {
+        accounts.push_back(LXAccount{{}, i});
+        ASSERT_EQ(vault.deposit(accounts.back(), Currency{}, x18::from_double(100.0)), errors::OK);
+    }
+
+    // Each thread settles its own pair and moves collateral round a ring
+    // that crosses every other thread's accounts
+    std::vector<std::thread> threads;
+    for (int t = 0; t < THREADS; ++t) {
+        threads.emplace_back([&, t] {
+            LXSettlement settlement{};
+            settlement.maker = accounts[2 * t];
+            settlement.taker = accounts[2 * t + 1];
+            settlement.market_id = 1;
+            settlement.taker_is_buy = true;
+            settlement.size_x18 = x18::from_double(0.01);
+            settlement.price_x18 = x18::from_double(10.0);
+            const std::vector<LXSettlement> batch{settlement};
+            for (int i = 0; i < FILLS; ++i) {
+                ASSERT_EQ(vault.apply_fills(batch), errors::OK);
+                const LXAccount& to = accounts[(2 * t + 2) % accounts.size()];
+                ASSERT_EQ(vault.transfer(accounts[2 * t], to, Currency{}, 1000), errors::OK);
+                vault.deposit(accounts[2 * t + 1], Currency{}, 1);
+            }
+        });
+    }
+    for (auto& thread : threads) {
+        thread.join();
+    }
+
+    I128 total = 0;
+    for (const LXAccount& account : accounts) {
+        total += vault.get_balance(account, Currency{});
+    }
+    ASSERT(total == x18::from_double(100.0) * 2 * THREADS + THREADS * FILLS);
+    for (int t = 0; t < THREADS; ++t) {
+        ASSERT(vault.get_position(accounts[2 * t + 1], 1)->size_x18 == x18::from_double(0.01) * FILLS);
+        ASSERT(vault.get_position(accounts[2 * t], 1)->size_x18 == -x18::from_double(0.01) * FILLS);
+    }
+    auto stats = vault.get_stats();
+    ASSERT_EQ(stats.total_accounts, accounts.size());
+    ASSERT_EQ(stats.total_positions, accounts.size());
+}
+
+// Test: risk heap finds the accounts under water without a scan
+TEST(vault_liquidation_heap) {
+    IndexedHeap<int, double> heap;
+    heap.set(1, 0.5);
+    heap.set(2, 3.0);
+    heap.set(3, 1.5);
+    heap.set(4, 0.1);
+    heap.set(2, 0.2);  // Reprioritise down
+    ASSERT_EQ(heap.top_key(), 3);
+    std::vector<int> above;
+    heap.visit_while([](double p) { return p >= 0.5; }, [&](int key, double) { above.push_back(key); });
+    std::sort(above.begin(), above.end());
+    ASSERT(above == std::vector<int>({1, 3}));
+    ASSERT(heap.erase(3));
+    ASSERT(!heap.erase(3));
+    ASSERT_EQ(heap.top_key(), 1);
+    heap.pop();
+    ASSERT_EQ(heap.top_key(), 2);
+    ASSERT_EQ(heap.size(), 2u);
+
+    LXVault vault;
+    MarketConfig market{};
+    market.market_id = 1;
+    market.initial_margin_x18 = x18::from_double(0.1);
+    market.maintenance_margin_x18 = x18::from_double(0.05);
+    market.active = true;
+    ASSERT_EQ(vault.create_market(market), errors::OK);
+
+    LXAccount maker{{}, 9};
+    ASSERT_EQ(vault.deposit(maker, Currency{}, x18::from_double(1000.0)), errors::OK);
+    std::vector<LXAccount> longs{LXAccount{{}, 1}, LXAccount{{}, 2}, LXAccount{{}, 3}};
+    const double collateral[] = {2.0, 5.0, 100.0};
+    std::vector<LXSettlement> fills;
+    for (size_t i = 0; i < longs.size(); ++i) {
+        ASSERT_EQ(vault.deposit(longs[i], Currency{}, x18::from_double(collateral[i])), errors::OK);
+        LXSettlement settlement{};
+        settlement.maker = maker;
+        settlement.taker = longs[i];
+        settlement.market_id = 1;
+        settlement.taker_is_buy = true;
+        settlement.size_x18 = X18_ONE;
+        settlement.price_x18 = x18::from_double(10.0);
+        fills.push_back(settlement);
+    }
+    ASSERT_EQ(vault.apply_fills(fills), errors::OK);
+
+    std::vector<LXAccount> candidates;
+    ASSERT_EQ(vault.liquidation_candidates(candidates), 0u);
+
+    // At 8 only account 1 has no equity left; at 5.4 account 2 is below
+    // maintenance too, and account 1 stays the worse of the two
+    I128 mark = x18::from_double(8.0);
+    vault.set_mark_price_callback([&mark](uint32_t) { return mark; });
+    vault.update_mark_prices({{1, mark}});
+    ASSERT_EQ(vault.liquidation_candidates(candidates), 1u);
+    ASSERT(candidates[0] == longs[0]);
+
+    mark = x18::from_double(5.4);
+    vault.update_mark_prices({{1, mark}});
+    candidates.clear();
+    ASSERT_EQ(vault.liquidation_candidates(candidates), 2u);
+    ASSERT(candidates[0] == longs[0]);
+    ASSERT(candidates[1] == longs[1]);
+    ASSERT(vault.is_liquidatable(longs[1]));
+    ASSERT(!vault.is_liquidatable(longs[2]));
+    candidates.clear();
+    ASSERT_EQ(vault.liquidation_candidates(candidates, 1), 1u);
+
+    for (const LXAccount& account : {longs[0], longs[1]}) {
+        LXLiquidationResult result = vault.liquidate(maker, account, 1, X18_ONE);
+        ASSERT(result.size_x18 == X18_ONE);
+        ASSERT(!vault.get_position(account, 1).has_value());
+    }
+    candidates.clear();
+    ASSERT_EQ(vault.liquidation_candidates(candidates), 0u);
+    ASSERT(vault.get_margin_info(longs[2]).maintenance_margin_x18 ==
+           x18::mul(x18::from_double(10.0), market.maintenance_margin_x18));
+}
+
+TEST(liquidation_keeper) {
+    LatencyHistogram histogram;
+    histogram.record(0);
+    histogram.record(3);
+    histogram.record(1000);
+    ASSERT_EQ(histogram.count(), 3u);
+    ASSERT_EQ(histogram.max(), 1000u);
+    ASSERT_EQ(histogram.bucket(0), 1u);
+    ASSERT_EQ(histogram.quantile(0.5), 4u);
+    ASSERT_EQ(histogram.quantile(1.0), 1024u);
+
+    LXVault vault;
+    MarketConfig market{};
+    market.market_id = 1;
+    market.initial_margin_x18 = x18::from_double(0.1);
+    market.maintenance_margin_x18 = x18::from_double(0.05);
+    market.active = true;
+    ASSERT_EQ(vault.create_market(market), errors::OK);
+
+    LXAccount maker{{}, 9};
+    ASSERT_EQ(vault.deposit(maker, Currency{}, x18::from_double(1000.0)), errors::OK);
+    std::vector<LXAccount> longs{LXAccount{{}, 1}, LXAccount{{}, 2}, LXAccount{{}, 3}};
+    const double collateral[] = {2.0, 5.0, 100.0};
+    std::vector<LXSettlement> fills;
+    for (size_t i = 0; i < longs.size(); ++i) {
+        ASSERT_EQ(vault.deposit(longs[i], Currency{}, x18::from_double(collateral[i])), errors::OK);
+        LXSettlement settlement{};
+        settlement.maker = maker;
+        settlement.taker = longs[i];
+        settlement.market_id = 1;
+        settlement.taker_is_buy = true;
+        settlement.size_x18 = X18_ONE;
+        settlement.price_x18 = x18::from_double(10.0);
+        fills.push_back(settlement);
+    }
+    ASSERT_EQ(vault.apply_fills(fills), errors::OK);
+
+    LXBook book;
+    BookMarketConfig config{};
+    config.market_id = 1;
+    config.symbol_id = 100;
+    config.lot_size_x18 = x18::from_double(0.001);
+    config.max_order_size_x18 = x18::from_double(1000000.0);
+    config.status = 1;
+    ASSERT_EQ(book.create_market(config), errors::OK);
+
+    // Only 1.5 of the 2.0 to close is bid within the slippage bound
+    LXOrder bid{};
+    bid.market_id = 1;
+    bid.is_buy = true;
+    bid.kind = OrderKind::LIMIT;
+    bid.size_x18 = x18::from_double(1.5);
+    bid.limit_px_x18 = x18::from_double(5.3);
+    bid.tif = TIF::GTC;
+    book.place_order(maker, bid);
+    bid.size_x18 = X18_ONE;
+    bid.limit_px_x18 = x18::from_double(4.0);  // Beyond 5% of the mark
+    book.place_order(maker, bid);
+
+    const I128 mark = x18::from_double(5.4);
+    vault.set_mark_price_callback([&mark](uint32_t) { return mark; });
+    const uint64_t mark_time = LiquidationKeeper::now_ns();
+    vault.update_mark_prices({{1, mark}});
+
+    LiquidationConfig keeper_config;
+    keeper_config.threads = 2;
+    keeper_config.max_batch = 1;
+    LiquidationKeeper keeper(vault, book, keeper_config);
+    LiquidationRun run = keeper.run(1, mark, mark_time);
+    ASSERT_EQ(run.candidates, 2u);
+    ASSERT_EQ(run.orders, 2u);
+    ASSERT_EQ(run.filled, 1u);
+    ASSERT(run.remainder_x18 == x18::from_double(0.5));
+    ASSERT_EQ(keeper.latency().count(), 2u);
+    ASSERT_EQ(keeper.get_stats().adl_runs, 1u);
+
+    // The bid outside the bound is untouched
+    LXL1 top = book.get_l1(1);
+    ASSERT(top.best_bid_px_x18 == x18::from_double(4.0));
+    ASSERT(top.best_bid_sz_x18 == X18_ONE);
+}
+
+TEST(vault_lazy_funding) {
+    LXVault vault;
+    MarketConfig market{};
+    market.market_id = 1;
+    market.initial_margin_x18 = x18::from_double(0.1);
+    market.maintenance_margin_x18 = x18::from_double(0.05);
+    market.active = true;
+    ASSERT_EQ(vault.create_market(market), errors::OK);
+    vault.set_funding_interval(1, 0);
+
+    LXAccount maker{{}, 9};
+    ASSERT_EQ(vault.deposit(maker, Currency{}, x18::from_double(1000.0)), errors::OK);
+    std::vector<LXAccount> longs{LXAccount{{}, 1}, LXAccount{{}, 2}};
+    std::vector<LXSettlement> fills;
+    for (const LXAccount& account : longs) {
+        ASSERT_EQ(vault.deposit(account, Currency{}, x18::from_double(100.0)), errors::OK);
+        LXSettlement settlement{};
+        settlement.maker = maker;
+        settlement.taker = account;
+        settlement.market_id = 1;
+        settlement.taker_is_buy = true;
+        settlement.size_x18 = X18_ONE;
+        settlement.price_x18 = x18::from_double(10.0);
+        fills.push_back(settlement);
+    }
+    ASSERT_EQ(vault.apply_fills(fills), errors::OK);
+
+    // Two accruals at 1%: longs pay 0.02 each, the short maker receives 0.04
+    vault.set_funding_rate(1, x18::from_double(0.01));
+    ASSERT_EQ(vault.accrue_funding(1), errors::OK);
+    ASSERT_EQ(vault.accrue_funding(1), errors::OK);
+    const I128 paid = x18::from_double(0.02);
+    ASSERT(vault.get_balance(longs[0], Currency{}) == x18::from_double(100.0) - paid);
+    ASSERT(vault.get_position(longs[0], 1)->accumulated_funding_x18 == -paid);
+    ASSERT(vault.get_margin_info(longs[0]).total_collateral_x18 == x18::from_double(100.0) - paid);
+    ASSERT(vault.get_balance(maker, Currency{}) == x18::from_double(1000.0) + 2 * paid);
+
+    // Settling on a write changes nothing a reader can see
+    ASSERT_EQ(vault.withdraw(longs[0], Currency{}, X18_ONE), errors::OK);
+    ASSERT(vault.get_balance(longs[0], Currency{}) == x18::from_double(99.0) - paid);
+    auto state = vault.get_account_state(longs[0]);
+    ASSERT(state.has_value());
+    ASSERT(state->collateral_x18 == x18::from_double(99.0) - paid);
+
+    // A mark update settles every slot it walks
+    vault.update_mark_prices({{1, x18::from_double(10.0)}});
+    state = vault.get_account_state(maker);
+    ASSERT(state->positions.at(1).accumulated_funding_x18 == 2 * paid);
+    ASSERT(state->collateral_x18 == x18::from_double(1000.0) + 2 * paid);
+
+    // Closing settles first; later accruals no longer reach the position
+    LXSettlement close{};
+    close.maker = maker;
+    close.taker = longs[1];
+    close.market_id = 1;
+    close.taker_is_buy = false;
+    close.size_x18 = X18_ONE;
+    close.price_x18 = x18::from_double(10.0);
+    ASSERT_EQ(vault.apply_fills({close}), errors::OK);
+    ASSERT(!vault.get_position(longs[1], 1).has_value());
+    ASSERT_EQ(vault.accrue_funding(1), errors::OK);
+    ASSERT(vault.get_balance(longs[1], Currency{}) == x18::from_double(100.0) - paid);
+    ASSERT(vault.get_balance(longs[0], Currency{}) == x18::from_double(99.0) - 3 * paid / 2);
+}
+
+TEST(vault_batch_funding) {
+    LXVault vault;
+    for (uint32_t m = 1; m <= 3; ++m) {
+        MarketConfig market{};
+        market.market_id = m;
+        market.initial_margin_x18 = x18::from_double(0.1);
+        market.maintenance_margin_x18 = x18::from_double(0.05);
+        market.active = true;
+        ASSERT_EQ(vault.create_market(market), errors::OK);
+    }
+    vault.set_funding_interval(1, 0);
+    vault.set_funding_interval(2, 0);     // Market 3 keeps its 8h interval
+
+    LXAccount maker{{}, 9};
+    LXAccount taker{{}, 1};
+    ASSERT_EQ(vault.deposit(maker, Currency{}, x18::from_double(1000.0)), errors::OK);
+    ASSERT_EQ(vault.deposit(taker, Currency{}, x18::from_double(100.0)), errors::OK);
+    std::vector<LXSettlement> fills;
+    for (uint32_t m = 1; m <= 3; ++m) {
+        LXSettlement settlement{};
+        settlement.maker = maker;
+        settlement.taker = taker;
+        settlement.market_id = m;
+        settlement.taker_is_buy = true;
+        settlement.size_x18 = X18_ONE;
+        settlement.price_x18 = x18::from_double(10.0);
+        fills.push_back(settlement);
+    }
+    ASSERT_EQ(vault.apply_fills(fills), errors::OK);
+
+    auto due = vault.funding_due();
+    std::sort(due.begin(), due.end());
+    ASSERT(due == std::vector<uint32_t>({1, 2}));
+
+    // One call sets every rate and accrues the due markets across shards
+    TaskPool pool(4);
+    const std::vector<std::pair<uint32_t, I128>> rates{
+        {1, x18::from_double(0.01)}, {2, x18::from_double(0.03)}, {3, x18::from_double(0.5)}};
+    ASSERT_EQ(vault.accrue_funding(rates, &pool), 2u);
+    ASSERT(vault.funding_rate_x18(3) == x18::from_double(0.5));
+    const I128 paid = x18::from_double(0.04);
+    ASSERT(vault.get_balance(taker, Currency{}) == x18::from_double(100.0) - paid);
+    ASSERT(vault.get_balance(maker, Currency{}) == x18::from_double(1000.0) + paid);
+    ASSERT_EQ(vault.accrue_funding({{3, x18::from_double(0.5)}}), 0u);
+
+    // LX runs the same pass off the feed's rates; nothing is due on a fresh instance
+    LX dex;
+    ASSERT_EQ(dex.run_funding(), 0u);
+}
+
+TEST(vault_funding_liquidation) {
+    LXVault vault;
+    for (uint32_t m = 1; m <= 2; ++m) {
+        MarketConfig market{};
+        market.market_id = m;
+        market.initial_margin_x18 = x18::from_double(0.1);
+        market.maintenance_margin_x18 = x18::from_double(0.05);
+        market.active = true;
+        ASSERT_EQ(vault.create_market(market), errors::OK);
+        vault.set_funding_interval(m, 0);
+    }
+
+    // Each long holds 2 against 0.5 maintenance, and the mark never moves
+    LXAccount maker{{}, 9};
+    ASSERT_EQ(vault.deposit(maker, Currency{}, x18::from_double(1000.0)), errors::OK);
+    std::vector<LXAccount> longs{LXAccount{{}, 1}, LXAccount{{}, 2}};
+    std::vector<LXSettlement> fills;
+    for (uint32_t m = 1; m <= 2; ++m) {
+        ASSERT_EQ(vault.deposit(longs[m - 1], Currency{}, x18::from_double(2.0)), errors::OK);
+        LXSettlement settlement{};
+        settlement.maker = maker;
+        settlement.taker = longs[m - 1];
+        settlement.market_id = m;
+        settlement.taker_is_buy = true;
+        settlement.size_x18 = X18_ONE;
+        settlement.price_x18 = x18::from_double(10.0);
+        fills.push_back(settlement);
+    }
+    ASSERT_EQ(vault.apply_fills(fills), errors::OK);
+    vault.update_mark_prices({{1, x18::from_double(10.0)}, {2, x18::from_double(10.0)}});
+
+    std::vector<LXAccount> candidates;
+    ASSERT_EQ(vault.liquidation_candidates(candidates), 0u);
+
+    // Paying 1.6 leaves 0.4 of equity, under maintenance
+    vault.set_funding_rate(1, x18::from_double(1.6));
+    ASSERT_EQ(vault.accrue_funding(1), errors::OK);
+    ASSERT(vault.is_liquidatable(longs[0]));
+    ASSERT_EQ(vault.liquidation_candidates(candidates), 1u);
+    ASSERT(candidates[0] == longs[0]);
+
+    // The batch pass lists its accounts the same way
+    ASSERT_EQ(vault.accrue_funding({{2, x18::from_double(1.6)}}), 1u);
+    candidates.clear();
+    ASSERT_EQ(vault.liquidation_candidates(candidates), 2u);
+    ASSERT(!vault.is_liquidatable(maker));
+}
+
+TEST(vault_netted_fills) {
+    MarketConfig market{};
+    market.market_id = 1;
+    market.initial_margin_x18 = x18::from_double(0.1);
+    market.maintenance_margin_x18 = x18::from_double(0.05);
+    market.active = true;
+
+    // One taker sweeps eight makers, then partly unwinds against them at
+    // another price and flips short: both paths must end identically
+    LXAccount taker{{}, 100};
+    std::vector<LXSettlement> fills;
+    for (uint16_t i = 1; i <= 8; ++i) {
+        LXSettlement settlement{};
+        settlement.maker = LXAccount{{}, i};
+        settlement.taker = taker;
+        settlement.market_id = 1;
+        settlement.taker_is_buy = true;
+        settlement.size_x18 = X18_ONE;
+        settlement.price_x18 = x18::from_double(10.0 + i);
+        settlement.maker_fee_x18 = x18::from_double(0.01);
+        settlement.taker_fee_x18 = x18::from_double(0.02);
+        fills.push_back(settlement);
+    }
+    for (size_t i = 1; i <= 3; ++i) {
+        LXSettlement settlement = fills[i - 1];
+        settlement.taker_is_buy = false;
+        settlement.size_x18 = 4 * X18_ONE;
+        settlement.price_x18 = x18::from_double(20.0);
+        fills.push_back(settlement);
+    }
+
+    LXVault sequential;
+    LXVault netted;
+    for (LXVault* vault : {&sequential, &netted}) {
+        ASSERT_EQ(vault->create_market(market), errors::OK);
+        ASSERT_EQ(vault->deposit(taker, Currency{}, x18::from_double(1000.0)), errors::OK);
+        for (uint16_t i = 1; i <= 8; ++i) {
+            ASSERT_EQ(vault->deposit(LXAccount{{}, i}, Currency{}, x18::from_double(100.0)), errors::OK);
+        }
+    }
+    ASSERT_EQ(sequential.apply_fills(fills), errors::OK);
+    ASSERT_EQ(netted.apply_fills_netted(fills), errors::OK);
+
+    std::vector<LXAccount> accounts{taker};
+    for (uint16_t i = 1; i <= 8; ++i) accounts.push_back(LXAccount{{}, i});
+    for (const LXAccount& account : accounts) {
+        auto a = sequential.get_account_state(account);
+        auto b = netted.get_account_state(account);
+        ASSERT(a.has_value() && b.has_value());
+        ASSERT(a->collateral_x18 == b->collateral_x18);
+        ASSERT(a->total_pnl_x18 == b->total_pnl_x18);
+        ASSERT(a->initial_margin_x18 == b->initial_margin_x18);
+        ASSERT_EQ(a->positions.size(), b->positions.size());
+        for (const auto& [market_id, position] : a->positions) {
+            ASSERT(position.size_x18 == b->positions.at(market_id).size_x18);
+            ASSERT(position.entry_px_x18 == b->positions.at(market_id).entry_px_x18);
+        }
+    }
+    auto flipped = netted.get_position(taker, 1);
+    ASSERT(flipped.has_value() && flipped->size_x18 == -4 * X18_ONE);
+    ASSERT(netted.get_balance(taker, Currency{}) == x18::from_double(1000.0 - 11 * 0.02));
+
+    // A fee shortfall anywhere leaves every account as it was
+    const auto stats_before = netted.get_stats();
+    LXSettlement broke = fills[0];
+    broke.maker = LXAccount{{}, 99};  // No balance for its fee
+    ASSERT_EQ(netted.apply_fills_netted({fills[1], broke}), errors::INSUFFICIENT_BALANCE);
+    ASSERT_EQ(netted.get_stats().total_accounts, stats_before.total_accounts);
+    ASSERT(netted.get_position(taker, 1)->size_x18 == -4 * X18_ONE);
+    ASSERT(netted.get_position(fills[1].maker, 1)->size_x18 == 3 * X18_ONE);
+    ASSERT(netted.get_balance(taker, Currency{}) == x18::from_double(1000.0 - 11 * 0.02));
+    ASSERT(netted.get_margin_info(taker).used_margin_x18 == sequential.get_margin_info(taker).used_margin_x18);
+}
+
+TEST(vault_read_snapshots) {
+    LXVault vault;
+    MarketConfig market{};
+    market.market_id = 1;
+    market.initial_margin_x18 = x18::from_double(0.1);
+    market.active = true;
+    ASSERT_EQ(vault.create_market(market), errors::OK);
+
+    LXAccount maker{{}, 1};
+    LXAccount taker{{}, 2};
+    ASSERT(vault.account_snapshot(taker) == nullptr);
+    ASSERT_EQ(vault.deposit(maker, Currency{}, x18::from_double(100.0)), errors::OK);
+    ASSERT_EQ(vault.deposit(taker, Currency{}, x18::from_double(100.0)), errors::OK);
+    auto first = vault.account_snapshot(taker);
+    ASSERT(first != nullptr);
+    ASSERT_EQ(first->version, 1u);
+
+    // Every fill adds 0.01 to the taker's position and takes a 0.001 fee:
+    // a reader must never see one without the other
+    constexpr int FILLS = 2000;
+    LXSettlement settlement{};
+    settlement.maker = maker;
+    settlement.taker = taker;
+    settlement.market_id = 1;
+    settlement.taker_is_buy = true;
+    settlement.size_x18 = x18::from_double(0.01);
+    settlement.price_x18 = x18::from_double(10.0);
+    settlement.taker_fee_x18 = x18::from_double(0.001);
+    const std::vector<LXSettlement> batch{settlement};
+
+    std::atomic<bool> done{false};
+    std::atomic<bool> torn{false};
+    std::thread reader([&] {
+        uint64_t last_version = 0;
+        while (!done.load(std::memory_order_acquire)) {
+            auto snapshot = vault.account_snapshot(taker);
+            if (snapshot->version < last_version) torn = true;
+            last_version = snapshot->version;
+            const AccountState& state = snapshot->state;
+            auto it = state.positions.find(1);
+            const I128 size = it != state.positions.end() ? it->second.size_x18 : 0;
+            const I128 fills = size / settlement.size_x18;
+            if (state.balances.at(0) != x18::from_double(100.0) - fills * settlement.taker_fee_x18 ||
+                state.collateral_x18 != state.balances.at(0)) {
+                torn = true;
+            }
+        }
+    });
+    for (int i = 0; i < FILLS; ++i) {
+        ASSERT_EQ(vault.apply_fills(batch), errors::OK);
+    }
+    done.store(true, std::memory_order_release);
+    reader.join();
+    ASSERT(!torn.load());
+
+    // Published snapshots never change underneath a reader
+    ASSERT(first->state.positions.empty());
+    ASSERT(first->state.collateral_x18 == x18::from_double(100.0));
+    auto last = vault.account_snapshot(taker);
+    ASSERT_EQ(last->version, 1u + FILLS);
+    ASSERT(vault.get_position(taker, 1)->size_x18 == FILLS * settlement.size_x18);
+}
+
+TEST(risk_engine_cached_buying_power) {
+    LXVault vault;
+    RiskEngine risk(vault);
+    MarketConfig market{};
+    market.market_id = 1;
+    market.initial_margin_x18 = x18::from_double(0.1);
+    market.max_position_size_x18 = x18::from_double(5.0);
+    market.active = true;
+    ASSERT_EQ(vault.create_market(market), errors::OK);
+    vault.set_funding_interval(1, 0);
+
+    LXAccount maker{{}, 1};
+    LXAccount taker{{}, 2};
+    ASSERT(!vault.buying_power(taker).has_value());
+    ASSERT_EQ(vault.deposit(maker, Currency{}, x18::from_double(100.0)), errors::OK);
+    ASSERT_EQ(vault.deposit(taker, Currency{}, x18::from_double(100.0)), errors::OK);
+
+    LXSettlement settlement{};
+    settlement.maker = maker;
+    settlement.taker = taker;
+    settlement.market_id = 1;
+    settlement.taker_is_buy = true;
+    settlement.size_x18 = x18::from_double(4.0);
+    settlement.price_x18 = x18::from_double(10.0);
+    ASSERT_EQ(vault.apply_fills({settlement}), errors::OK);
+
+    // Published with the fill, and equal to the full margin computation
+    auto power = vault.buying_power(taker);
+    ASSERT(power.has_value());
+    ASSERT_EQ(power->version, vault.account_snapshot(taker)->version);
+    ASSERT(power->free_margin_x18 == vault.get_margin_info(taker).free_margin_x18);
+    ASSERT(power->free_margin_x18 == x18::from_double(96.0));
+
+    // Funding accrued since the fill is charged without a write
+    vault.set_funding_rate(1, x18::from_double(0.01));
+    ASSERT_EQ(vault.accrue_funding(1), errors::OK);
+    power = vault.buying_power(taker);
+    ASSERT(power->free_margin_x18 == x18::from_double(96.0) - x18::from_double(0.04));
+    ASSERT(power->free_margin_x18 == vault.get_margin_info(taker).free_margin_x18);
+
+    // Position limit: 4 held, 5 allowed; shrinking is always allowed
+    LXOrder order{};
+    order.market_id = 1;
+    order.is_buy = true;
+    order.size_x18 = X18_ONE;
+    order.limit_px_x18 = x18::from_double(10.0);
+    ASSERT(risk.pre_trade_check(taker, order));
+    order.size_x18 = 2 * X18_ONE;
+    ASSERT(!risk.pre_trade_check(taker, order));
+    order.is_buy = false;
+    ASSERT(risk.pre_trade_check(taker, order));
+    ASSERT(risk.max_order_size(taker, 1, true) == X18_ONE);
+
+    // New market limits are visible to the next check
+    market.max_position_size_x18 = 0;
+    ASSERT_EQ(vault.update_market(market), errors::OK);
+    order.is_buy = true;
+    ASSERT(risk.pre_trade_check(taker, order));
+    ASSERT(!vault.market_limits(2).has_value());
+}
+
+TEST(vault_adl_ranking) {
+    LXVault vault;
+    MarketConfig market{};
+    market.market_id = 1;
+    market.initial_margin_x18 = x18::from_double(0.1);
+    market.maintenance_margin_x18 = x18::from_double(0.05);
+    market.active = true;
+    ASSERT_EQ(vault.create_market(market), errors::OK);
+
+    // A thin long of 3 and a well funded long of 1 against three shorts;
+    // after the mark falls to 9 the thin long is under water and the
+    // shorts score 0.1 * 9/101, 0.1 * 9/11 and 0.1 * 18/12 (PnL ratio
+    // times leverage)
+    LXAccount long_account{{}, 10};
+    LXAccount funded_long{{}, 11};
+    std::vector<LXAccount> shorts{LXAccount{{}, 1}, LXAccount{{}, 2}, LXAccount{{}, 3}};
+    const double deposits[] = {100.0, 10.0, 10.0};
+    const double sizes[] = {1.0, 1.0, 2.0};
+    ASSERT_EQ(vault.deposit(long_account, Currency{}, x18::from_double(3.0)), errors::OK);
+    ASSERT_EQ(vault.deposit(funded_long, Currency{}, x18::from_double(100.0)), errors::OK);
+    std::vector<LXSettlement> fills;
+    for (size_t i = 0; i < shorts.size(); ++i) {
+        ASSERT_EQ(vault.deposit(shorts[i], Currency{}, x18::from_double(deposits[i])), errors::OK);
+        LXSettlement settlement{};
+        settlement.maker = shorts[i];
+        settlement.taker = i == 0 ? funded_long : long_account;
+        settlement.market_id = 1;
+        settlement.taker_is_buy = true;
+        settlement.size_x18 = x18::from_double(sizes[i]);
+        settlement.price_x18 = x18::from_double(10.0);
+        fills.push_back(settlement);
+    }
+    ASSERT_EQ(vault.apply_fills(fills), errors::OK);
+    ASSERT_EQ(vault.run_adl(1), errors::INVALID_PRICE);  // No mark yet
+
+    ASSERT_EQ(vault.update_mark_prices({{1, x18::from_double(9.0)}}), errors::OK);
+    ASSERT(vault.is_liquidatable(long_account));
+
+    // The two best-ranked shorts absorb the whole thin long; the least
+    // leveraged one keeps its position
+    ASSERT_EQ(vault.run_adl(1), errors::OK);
+    ASSERT(!vault.get_position(long_account, 1).has_value());
+    ASSERT(!vault.get_position(shorts[2], 1).has_value());
+    ASSERT(!vault.get_position(shorts[1], 1).has_value());
+    auto kept = vault.get_position(shorts[0], 1);
+    ASSERT(kept.has_value() && kept->size_x18 == -X18_ONE);
+    ASSERT(vault.get_account_state(shorts[2])->total_pnl_x18 == x18::from_double(2.0));
+
+    // Nothing left under water, so a second run changes nothing
+    ASSERT_EQ(vault.run_adl(1), errors::OK);
+    ASSERT(vault.get_position(shorts[0], 1)->size_x18 == -X18_ONE);
+    ASSERT(vault.get_position(funded_long, 1)->size_x18 == X18_ONE);
+}
+
+// Test: tick bitmap search agrees with an ordered set of ticks
+TEST(pool_tick_bitmap) {
+    for (int32_t spacing : {1, 10, 60}) {
+        TickBitmap bitmap(spacing);
+        ASSERT(!bitmap.next_above(0).has_value());
+        ASSERT(!bitmap.next_below(0).has_value());
+
+        std::set<int32_t> ticks;
+        uint64_t seed = 42;
+        auto next_random = [&seed] { seed = seed * 6364136223846793005ull + 1442695040888963407ull; return seed >> 33; };
+        for (int i = 0; i < 400; ++i) {
+            // Sparse across the whole range, dense near zero
+            const int32_t span = i % 2 ? 887272 : 5000;
+            int32_t tick = static_cast<int32_t>(next_random() % (2 * span + 1)) - span;
+            tick = tick / spacing * spacing;
+            const bool on = next_random() % 4 != 0;
+            bitmap.set(tick, on);
+            if (on) ticks.insert(tick); else ticks.erase(tick);
+        }
+        bitmap.set(887272 / spacing * spacing, true);
+        ticks.insert(887272 / spacing * spacing);
+        bitmap.set(-887272 / spacing * spacing, true);
+        ticks.insert(-887272 / spacing * spacing);
+
+        for (int i = 0; i < 2000; ++i) {
+            const int32_t probe = static_cast<int32_t>(next_random() % 1774545) - 887272;
+            auto above = ticks.upper_bound(probe);
+            auto found_above = bitmap.next_above(probe);
+            ASSERT_EQ(found_above.has_value(), above != ticks.end());
+            if (found_above) ASSERT_EQ(*found_above, *above);
+
+            auto below = ticks.lower_bound(probe);
+            auto found_below = bitmap.next_below(probe);
+            ASSERT_EQ(found_below.has_value(), below != ticks.begin());
+            if (found_below) ASSERT_EQ(*found_below, *std::prev(below));
+            ASSERT_EQ(bitmap.test(probe), ticks.count(probe) == 1);
+        }
+    }
+}
+
+TEST(pool_tick_math_exact) {
+    using namespace lux::tick_math;
+
+    ASSERT(get_sqrt_ratio_at_tick(MIN_TICK) == MIN_SQRT_RATIO);
+    ASSERT(get_sqrt_ratio_at_tick(0) == (I128{1} << 96));
+    // ceil(sqrt(1.0001^100000) * 2^96)
+    ASSERT(get_sqrt_ratio_at_tick(100000) ==
+           ((I128{0x946045a8e3} << 64) | I128{0xd7f998d85d8c4d82ULL}));
+    ASSERT(get_sqrt_ratio_at_tick(MAX_TICK) == MAX_SQRT_RATIO);
+    ASSERT(get_sqrt_ratio_at_tick(MAX_TICK + 1) == 0);
+
+    // Round trip and monotonicity across the representable range
+    I128 prev = 0;
+    for (int32_t tick = MIN_TICK; tick <= 429000; tick += 97) {
+        const I128 ratio = get_sqrt_ratio_at_tick(tick);
+        ASSERT(ratio > prev);
+        ASSERT_EQ(get_tick_at_sqrt_ratio(ratio), tick);
+        if (tick > MIN_TICK) ASSERT_EQ(get_tick_at_sqrt_ratio(ratio - 1), tick - 1);
+        prev = ratio;
+    }
+    ASSERT_EQ(get_tick_at_sqrt_ratio(MIN_SQRT_RATIO), MIN_TICK);
+    // Last tick below the I128 saturation point
+    const int32_t top = get_tick_at_sqrt_ratio(MAX_SQRT_RATIO - 1);
+    ASSERT(get_sqrt_ratio_at_tick(top) < MAX_SQRT_RATIO);
+    ASSERT(get_sqrt_ratio_at_tick(top + 1) == MAX_SQRT_RATIO);
+}
+
+// Test: batched quotes match real swaps and leave the pool untouched
+TEST(pool_quote_swaps) {
+    PoolKey key{};
+    key.currency0 = Currency(Address{1});
+    key.currency1 = Currency(Address{2});
+    key.fee = 3000;
+    key.tick_spacing = 60;
+
+    auto make_pool = [&](LXPool& pool) {
+        pool.initialize(key, I128{1} << 96);
+        pool.modify_liquidity(key, {-600, 600, x18::from_double(1000.0), 0});
+        pool.modify_liquidity(key, {-1800, -120, x18::from_double(500.0), 0});
+        pool.modify_liquidity(key, {120, 2400, x18::from_double(800.0), 0});
+    };
+
+    auto same = [](const BalanceDelta& a, const BalanceDelta& b) {
+        return a.amount0 == b.amount0 && a.amount1 == b.amount1;
+    };
+
+    LXPool pool;
+    make_pool(pool);
+    const Slot0 before = *pool.get_slot0(key);
+
+    // A depth curve of 50 sizes each way, unsorted and both signs
+    for (bool zero_for_one : {true, false}) {
+        std::vector<I128> sizes;
+        for (int i = 50; i >= 1; --i) {
+            sizes.push_back(x18::from_double(i * 2.5) * (i % 3 == 0 ? -1 : 1));
+        }
+        auto quotes = pool.quote_swaps(key, zero_for_one, sizes);
+        ASSERT_EQ(quotes.size(), sizes.size());
+        ASSERT(quotes.front().ticks_crossed > 0);  // Largest size leaves the middle range
+
+        for (size_t i = 0; i < sizes.size(); i += 7) {
+            LXPool fresh;
+            make_pool(fresh);
+            BalanceDelta delta = fresh.swap(key, {zero_for_one, sizes[i], 0});
+            ASSERT(delta.amount0 != 0 && same(delta, quotes[i].delta));
+            ASSERT(fresh.get_slot0(key)->sqrt_price_x96 == quotes[i].sqrt_price_x96);
+            ASSERT_EQ(fresh.get_slot0(key)->tick, quotes[i].tick);
+        }
+    }
+
+    // Quoting to a price agrees with a swap limited at that price
+    const I128 target = tick_math::get_sqrt_ratio_at_tick(-900);
+    auto to_price = pool.quote_to_price(key, true, target);
+    ASSERT(to_price.has_value());
+    ASSERT(to_price->sqrt_price_x96 == target);
+    ASSERT_EQ(to_price->ticks_crossed, 2u);
+    LXPool fresh;
+    make_pool(fresh);
+    ASSERT(same(fresh.swap(key, {true, to_price->delta.amount0, target}), to_price->delta));
+
+    // Nothing moved in the quoted pool
+    ASSERT(pool.get_slot0(key)->sqrt_price_x96 == before.sqrt_price_x96);
+    ASSERT_EQ(pool.get_slot0(key)->tick, before.tick);
+    ASSERT(!pool.quote_to_price(PoolKey{}, true, target).has_value());
+}
+
+// Test: pools lock independently, handles skip the lookup, and concurrent
+// lock() calls keep separate flash books
+TEST(pool_handles_and_flash_contexts) {
+    auto make_key = [](uint8_t base) {
+        PoolKey key{};
+        key.currency0 = Currency(Address{base});
+        key.currency1 = Currency(Address{static_cast<uint8_t>(base + 1)});
+        key.fee = 3000;
+        key.tick_spacing = 60;
+        return key;
+    };
+    const PoolKey eth_usdc = make_key(1);
+    const PoolKey long_tail = make_key(10);
+
+    LXPool pool;
+    for (const PoolKey& key : {eth_usdc, long_tail}) {
+        pool.initialize(key, I128{1} << 96);
+        pool.modify_liquidity(key, {-600, 600, x18::from_double(1000.0), 0});
+    }
+    ASSERT(!pool.find_pool(make_key(20)));
+    ASSERT(pool.swap(pool.find_pool(make_key(20)), {true, X18_ONE, 0}).amount0 == 0);
+
+    // Handle and key paths agree
+    PoolHandle handle = pool.find_pool(eth_usdc);
+    ASSERT(handle && handle.key() == eth_usdc);
+    BalanceDelta by_handle = pool.swap(handle, {true, X18_ONE, 0});
+    BalanceDelta by_key = pool.swap(long_tail, {true, X18_ONE, 0});
+    ASSERT(by_handle.amount0 == by_key.amount0 && by_handle.amount1 == by_key.amount1);
+    ASSERT(pool.get_slot0(handle)->tick == pool.get_slot0(long_tail)->tick);
+
+    // Swaps on the two pools from two threads, each inside its own lock()
+    auto trader = [&](const PoolKey& key, std::atomic<int>& errors_seen) {
+        PoolHandle h = pool.find_pool(key);
+        for (int i = 0; i < 200; ++i) {
+            try {
+                pool.lock([&] {
+                    pool.swap(h, {i % 2 == 0, X18_ONE / 100, 0});
+                    pool.settle(key.currency0);
+                    pool.settle(key.currency1);
+                });
+            } catch (const std::exception&) {
+                errors_seen.fetch_add(1);
+            }
+        }
+    };
+    std::atomic<int> errors_a{0}, errors_b{0};
+    std::thread a(trader, std::cref(eth_usdc), std::ref(errors_a));
+    std::thread b(trader, std::cref(long_tail), std::ref(errors_b));
+    a.join();
+    b.join();
+    ASSERT_EQ(errors_a.load(), 0);
+    ASSERT_EQ(errors_b.load(), 0);
+
+    // A debt held open in one thread's lock() is invisible to another's
+    std::atomic<int> stage{0};
+    bool outer_ok = false;
+    std::thread holder([&] {
+        pool.lock([&] {
+            pool.take(eth_usdc.currency0, Address{}, X18_ONE);
+            stage.store(1);
+            while (stage.load() != 2) std::this_thread::yield();
+            pool.settle(eth_usdc.currency0);
+        });
+        outer_ok = true;
+    });
+    while (stage.load() != 1) std::this_thread::yield();
+    bool inner_ok = true;
+    try {
+        pool.lock([&] { pool.swap(long_tail, {false, X18_ONE / 100, 0}); });
+        inner_ok = false;  // Unsettled swap delta must throw
+    } catch (const std::runtime_error&) {
+    }
+    pool.lock([&] {
+        pool.take(long_tail.currency1, Address{}, 5);
+        pool.settle(long_tail.currency1);
+    });
+    stage.store(2);
+    holder.join();
+    ASSERT(inner_ok && outer_ok);
+
+    // Reentrancy on the same thread is still rejected
+    bool reentry_rejected = false;
+    pool.lock([&] {
+        try {
+            pool.lock([] {});
+        } catch (const std::runtime_error&) {
+            reentry_rejected = true;
+        }
+    });
+    ASSERT(reentry_rejected);
+}
+
+// Test: the router splits across parallel and multi-hop paths, follows
+// liquidity changes, and swap_smart executes what it quoted
+TEST(router_split_routes) {
+    const Currency a(Address{1}), b(Address{2}), c(Address{3});
+    auto make_key = [](const Currency& x, const Currency& y, uint32_t fee, int32_t spacing) {
+        PoolKey key{};
+        key.currency0 = x < y ? x : y;
+        key.currency1 = x < y ? y : x;
+        key.fee = fee;
+        key.tick_spacing = spacing;
+        return key;
+    };
+    const PoolKey ab30 = make_key(a, b, 3000, 60);
+    const PoolKey ab05 = make_key(a, b, 500, 10);
+    const PoolKey ac30 = make_key(a, c, 3000, 60);
+    const PoolKey cb30 = make_key(c, b, 3000, 60);
+
+    LX lx;
+    for (const PoolKey& key : {ab30, ab05, ac30, cb30}) {
+        ASSERT_EQ(lx.create_spot_market(key, I128{1} << 96), 0);
+        const double depth = key.fee == 500 ? 300.0 : 1000.0;
+        lx.pool().modify_liquidity(key, {-600, 600, x18::from_double(depth), 0});
+    }
+    ASSERT_EQ(lx.router().pool_count(), 4u);
+    ASSERT_EQ(lx.router().token_count(), 3u);
+
+    // A large order beats any single pool by spreading over the paths
+    const I128 amount = x18::from_double(40.0);
+    Route route = lx.router().find_route(a, b, amount);
+    ASSERT(route.paths.size() >= 2);
+    ASSERT(route.amount_in_x18 == amount);
+    for (const PoolKey& key : {ab30, ab05}) {
+        const I128 single = -lx.pool().quote_swaps(key, true, {amount}).front().delta.amount1;
+        ASSERT(route.amount_out_x18 > single);
+    }
+    bool multi_hop = false;
+    for (const RoutePath& path : route.paths) {
+        multi_hop |= path.hops.size() == 2;
+    }
+    ASSERT(multi_hop);
+
+    // Below the caller's minimum nothing trades
+    const Slot0 before = *lx.pool().get_slot0(ab30);
+    BalanceDelta refused = lx.swap_smart(LXAccount{}, a, b, amount, route.amount_out_x18 + 1);
+    ASSERT(refused.amount0 == 0 && refused.amount1 == 0);
+    ASSERT(lx.pool().get_slot0(ab30)->sqrt_price_x96 == before.sqrt_price_x96);
+
+    // Otherwise the legs execute exactly as quoted
+    BalanceDelta filled = lx.swap_smart(LXAccount{}, a, b, amount, route.amount_out_x18);
+    ASSERT(filled.amount0 == amount);
+    ASSERT(-filled.amount1 == route.amount_out_x18);
+
+    // Draining a pool takes it out of the graph's candidates
+    lx.pool().modify_liquidity(ab05, {-600, 600, -x18::from_double(300.0), 0});
+    Route after = lx.router().find_route(b, a, X18_ONE);
+    ASSERT(!after.paths.empty());
+    for (const RoutePath& path : after.paths) {
+        for (const RouteHop& hop : path.hops) {
+            ASSERT(!(hop.pool.key() == ab05));
+        }
+    }
+    ASSERT(lx.router().find_route(a, Currency(Address{9}), X18_ONE).paths.empty());
+}
+
+// Test: trade() splits an order between book levels and a linked pool by
+// marginal price, beating a pure book sweep
+TEST(lx_trade_venue_split) {
+    const Currency base(Address{1}), quote(Address{2});
+    PoolKey key{};
+    key.currency0 = base;
+    key.currency1 = quote;
+    key.fee = 3000;
+    key.tick_spacing = 60;
+
+    LX lx;
+    ASSERT_EQ(lx.create_spot_market(key, I128{1} << 96), 0);
+    lx.pool().modify_liquidity(key, {-60, 60, x18::from_double(20000.0), 0});
+
+    BookMarketConfig config{};
+    config.market_id = 7;
+    config.symbol_id = 700;
+    config.lot_size_x18 = x18::from_double(0.001);
+    config.max_order_size_x18 = x18::from_double(1000000.0);
+    config.status = 1;
+    ASSERT_EQ(lx.book().create_market(config), errors::OK);
+
+    LXAccount maker{};
+    maker.main[19] = 0x01;
+    LXAccount taker{};
+    taker.main[19] = 0x02;
+    for (auto [px, size] : {std::pair{1.002, 5.0}, std::pair{1.010, 20.0}}) {
+        LXOrder ask{};
+        ask.market_id = 7;
+        ask.is_buy = false;
+        ask.kind = OrderKind::LIMIT;
+        ask.size_x18 = x18::from_double(size);
+        ask.limit_px_x18 = x18::from_double(px);
+        ask.tif = TIF::GTC;
+        lx.book().place_order(maker, ask);
+    }
+
+    ASSERT_EQ(lx.link_pool(7, PoolKey{}, true), errors::POOL_NOT_INITIALIZED);
+    ASSERT_EQ(lx.link_pool(7, key, true), errors::OK);
+
+    // A sweep of both asks would average 1.008
+    const I128 size = x18::from_double(20.0);
+    LX::TradeResult result = lx.trade(taker, 7, true, size, 0);
+    ASSERT(result.used_clob && result.used_amm);
+    ASSERT(result.clob_size_x18 >= x18::from_double(5.0));
+    ASSERT(result.amm_size_x18 > 0);
+    ASSERT(result.delta.amount0 == size);
+    ASSERT(result.clob_size_x18 + result.amm_size_x18 == size);
+    ASSERT(result.effective_price_x18 < x18::from_double(1.008));
+
+    // A limit bounds both legs
+    const Slot0 before = *lx.pool().get_slot0(key);
+    LX::TradeResult limited = lx.trade(taker, 7, true, size, x18::from_double(1.0));
+    ASSERT(limited.delta.amount0 == 0);
+    ASSERT(lx.pool().get_slot0(key)->sqrt_price_x96 == before.sqrt_price_x96);
+
+    // Selling goes to the pool alone: there are no bids
+    LX::TradeResult sold = lx.trade(taker, 7, false, x18::from_double(2.0), 0);
+    ASSERT(!sold.used_clob && sold.used_amm);
+    ASSERT(sold.delta.amount0 == -x18::from_double(2.0));
+    ASSERT(sold.delta.amount1 < 0);
+}
+
+// Test: pools call only the hooks their capability bits name, bound at initialize
+TEST(pool_hook_flags) {
+    struct CountingHooks : IHooks {
+        int before_swaps = 0, after_swaps = 0, modifies = 0, donates = 0;
+        bool allow_swap = true;
+        bool before_swap(const PoolKey&, const SwapParams&) override { ++before_swaps; return allow_swap; }
+        void after_swap(const PoolKey&, const SwapParams&, const BalanceDelta&) override { ++after_swaps; }
+        bool before_modify_liquidity(const PoolKey&, const ModifyLiquidityParams&) override { ++modifies; return true; }
+        void after_modify_liquidity(const PoolKey&, const ModifyLiquidityParams&, const BalanceDelta&) override { ++modifies; }
+        bool before_donate(const PoolKey&, I128, I128) override { ++donates; return true; }
+    };
+
+    auto make_key = [](const Address& hooks) {
+        PoolKey key{};
+        key.currency0 = Currency(Address{1});
+        key.currency1 = Currency(Address{2});
+        key.fee = 3000;
+        key.tick_spacing = 60;
+        key.hooks = hooks;
+        return key;
+    };
+
+    // Swap bits encoded in the address
+    Address swap_addr{};
+    swap_addr[0] = 0xAA;
+    swap_addr[19] = hook_flags::BEFORE_SWAP | hook_flags::AFTER_SWAP;
+    ASSERT_EQ(hook_flags::from_address(swap_addr), hook_flags::BEFORE_SWAP | hook_flags::AFTER_SWAP);
+
+    // Declared at registration: removes only
+    Address remove_addr{};
+    remove_addr[0] = 0xBB;
+
+    LXPool pool;
+    CountingHooks swap_hooks, remove_hooks;
+    pool.register_hooks(swap_addr, &swap_hooks);
+    pool.register_hooks(remove_addr, &remove_hooks, hook_flags::BEFORE_REMOVE_LIQUIDITY);
+
+    const PoolKey swap_key = make_key(swap_addr);
+    const PoolKey remove_key = make_key(remove_addr);
+    for (const PoolKey& key : {swap_key, remove_key}) {
+        pool.initialize(key, I128{1} << 96);
+        pool.modify_liquidity(key, {-600, 600, x18::from_double(1000.0), 0});
+        pool.swap(key, {true, X18_ONE, 0});
+        pool.donate(key, X18_ONE, 0);
+        pool.modify_liquidity(key, {-600, 600, -x18::from_double(10.0), 0});
+    }
+    ASSERT_EQ(swap_hooks.before_swaps, 1);
+    ASSERT_EQ(swap_hooks.after_swaps, 1);
+    ASSERT_EQ(swap_hooks.modifies, 0);
+    ASSERT_EQ(swap_hooks.donates, 0);
+    ASSERT_EQ(remove_hooks.before_swaps, 0);
+    ASSERT_EQ(remove_hooks.modifies, 1);
+
+    // A called hook can still veto
+    swap_hooks.allow_swap = false;
+    ASSERT(pool.swap(swap_key, {true, X18_ONE, 0}).amount0 == 0);
+    ASSERT_EQ(swap_hooks.after_swaps, 1);
+
+    // Hooks stay bound to pools created before unregistering
+    pool.unregister_hooks(swap_addr);
+    pool.swap(swap_key, {true, X18_ONE, 0});
+    ASSERT_EQ(swap_hooks.before_swaps, 3);
+}
+
+// Test: flash deltas stay inline up to capacity, then spill to the map
+TEST(flash_currency_deltas) {
+    CurrencyDeltas deltas;
+    ASSERT(deltas.all_zero());
+
+    const size_t count = CurrencyDeltas::INLINE_CAPACITY + 4;
+    for (size_t i = 0; i < count; ++i) {
+        deltas[i * 7919] += static_cast<I128>(i + 1);
+    }
+    ASSERT_EQ(deltas.size(), count);
+    ASSERT(!deltas.all_zero());
+    ASSERT(deltas[0] == 1 && deltas[(count - 1) * 7919] == static_cast<I128>(count));
+
+    for (size_t i = 0; i < count; ++i) {
+        deltas[i * 7919] -= static_cast<I128>(i + 1);
+    }
+    ASSERT_EQ(deltas.size(), count);
+    ASSERT(deltas.all_zero());
+
+    deltas[42] = 5;
+    deltas.clear();
+    ASSERT_EQ(deltas.size(), 0u);
+    ASSERT(deltas.all_zero());
+}
+
+// Test: the pool depth curve matches quoted swaps to each step, before and
+// after liquidity changes and price moves
+TEST(pool_depth_curve) {
+    PoolKey key{};
+    key.currency0 = Currency(Address{1});
+    key.currency1 = Currency(Address{2});
+    key.fee = 3000;
+    key.tick_spacing = 60;
+
+    LXPool pool;
+    pool.initialize(key, I128{1} << 96);
+    pool.modify_liquidity(key, {-600, 600, x18::from_double(1000.0), 0});
+    pool.modify_liquidity(key, {120, 2400, x18::from_double(800.0), 0});
+
+    auto check = [&](size_t levels) {
+        auto depth = pool.get_depth(key, 60, levels);
+        ASSERT(depth.has_value());
+        ASSERT_EQ(depth->asks.size(), levels);
+        ASSERT_EQ(depth->bids.size(), levels);
+        for (bool rising : {true, false}) {
+            const auto& side = rising ? depth->asks : depth->bids;
+            I128 last = 0;
+            for (size_t i = 0; i < side.size(); ++i) {
+                ASSERT_EQ(side[i].tick % 60, 0);
+                ASSERT(side[i].amount_out >= last);
+                last = side[i].amount_out;
+                if (side[i].sqrt_price_x96 == depth->sqrt_price_x96) continue;
+                auto quote = pool.quote_to_price(key, !rising, side[i].sqrt_price_x96);
+                ASSERT(quote.has_value());
+                const I128 out = rising ? -quote->delta.amount0 : -quote->delta.amount1;
+                const I128 diff = out - side[i].amount_out;
+                ASSERT(diff <= 16 && diff >= -16);
+            }
+        }
+        return *depth;
+    };
+
+    PoolDepth first = check(12);
+    PoolDepth cached = check(12);
+    ASSERT(first.asks.back().amount_out == cached.asks.back().amount_out);
+
+    // New liquidity shows up
+    pool.modify_liquidity(key, {-1200, -240, x18::from_double(500.0), 0});
+    PoolDepth deeper = check(12);
+    ASSERT(deeper.bids.back().amount_out > first.bids.back().amount_out);
+    ASSERT(deeper.asks.back().amount_out == first.asks.back().amount_out);
+
+    // Price moves within and across steps
+    pool.swap(key, {false, x18::from_double(0.5), 0});
+    check(12);
+    pool.swap(key, {true, x18::from_double(20.0), 0});
+    check(5);
+    ASSERT(!pool.get_depth(key, 0, 5).has_value());
+    ASSERT(!pool.get_depth(PoolKey{}, 60, 5).has_value());
+}
+
+TEST(precompile_dispatch) {
+    LX lx;
+    PrecompileRouter router(lx);
+    ASSERT(router.handler_count() > 30);
+
+    OracleConfig config{};
+    config.asset_id = 7;
+    config.max_staleness = 3600;
+    config.max_deviation_x18 = x18::from_double(0.05);
+    config.method = AggregationMethod::MEDIAN;
+    config.sources = {PriceSource::BINANCE};
+    ASSERT_EQ(lx.oracle().register_asset(config), errors::OK);
+
+    auto selector = [](uint32_t sel, size_t words) {
+        std::vector<uint8_t> data(4 + words * 32, 0);
+        data[0] = sel >> 24; data[1] = sel >> 16; data[2] = sel >> 8; data[3] = sel;
+        return data;
+    };
+    auto put_word = [](std::vector<uint8_t>& data, size_t word, uint64_t value) {
+        for (int i = 0; i < 8; ++i) data[4 + word * 32 + 31 - i] = static_cast<uint8_t>(value >> (8 * i));
+    };
+
+    // updatePrice(uint64,uint8,int128,int128) then getPrice(uint64)
+    auto update = selector(0x7d3e47c1, 4);
+    put_word(update, 0, 7);
+    put_word(update, 1, static_cast<uint64_t>(PriceSource::BINANCE));
+    put_word(update, 2, 50000);
+    put_word(update, 3, 1);
+    auto status = router.call(addresses::LX_ORACLE, update);
+    ASSERT_EQ(status.size(), 32u);
+    ASSERT_EQ(status[31], static_cast<uint8_t>(errors::OK));
+
+    auto get = selector(0x99cff17c, 1);
+    put_word(get, 0, 7);
+    uint8_t out[PrecompileRouter::MAX_OUTPUT];
+    ASSERT_EQ(router.call(addresses::LX_ORACLE, get.data(), get.size(), out), 32u);
+    ASSERT_EQ(out[31], 50000 & 0xFF);
+    ASSERT_EQ(out[30], 50000 >> 8);
+    ASSERT(router.call(addresses::LX_ORACLE, get) == std::vector<uint8_t>(out, out + 32));
+
+    // Unknown selector, wrong precompile, short calldata and short arguments
+    ASSERT(router.call(addresses::LX_ORACLE, selector(0xdeadbeef, 1)).empty());
+    ASSERT(router.call(addresses::LX_POOL, get).empty());
+    ASSERT(router.call(addresses::LX_ORACLE, std::vector<uint8_t>{0x99, 0xcf}).empty());
+    ASSERT(router.call(addresses::LX_ORACLE, selector(0x99cff17c, 0)).empty());
+    Address other{};
+    other[19] = 1;
+    ASSERT(router.call(other, get).empty());
+}
+
+TEST(precompile_static_call) {
+    LX lx;
+    PrecompileRouter router(lx);
+
+    OracleConfig config{};
+    config.asset_id = 9;
+    config.max_staleness = 3600;
+    config.max_deviation_x18 = x18::from_double(0.05);
+    config.method = AggregationMethod::MEDIAN;
+    config.sources = {PriceSource::BINANCE};
+    ASSERT_EQ(lx.oracle().register_asset(config), errors::OK);
+
+    auto calldata = [](uint32_t sel, std::vector<uint64_t> words) {
+        std::vector<uint8_t> data(4 + words.size() * 32, 0);
+        data[0] = sel >> 24; data[1] = sel >> 16; data[2] = sel >> 8; data[3] = sel;
+        for (size_t w = 0; w < words.size(); ++w) {
+            for (int i = 0; i < 8; ++i) data[4 + w * 32 + 31 - i] = static_cast<uint8_t>(words[w] >> (8 * i));
+        }
+        return data;
+    };
+    const auto update = calldata(0x7d3e47c1, {9, static_cast<uint64_t>(PriceSource::BINANCE), 1000, 1});
+    const auto get = calldata(0x99cff17c, {9});
+
+    ASSERT(router.is_view(addresses::LX_ORACLE, 0x99cff17c));
+    ASSERT(!router.is_view(addresses::LX_ORACLE, 0x7d3e47c1));
+    ASSERT(router.is_view(addresses::LX_FEED, 0x82a0548d));
+    ASSERT(!router.is_view(addresses::LX_BOOK, 0x3e5b3a12));
+
+    // State changes are refused; views answer like call does
+    ASSERT(router.static_call(addresses::LX_ORACLE, update).empty());
+    ASSERT(router.call(addresses::LX_ORACLE, update).size() == 32);
+    ASSERT(router.static_call(addresses::LX_ORACLE, get) == router.call(addresses::LX_ORACLE, get));
+
+    // Readers run alongside a writer
+    std::atomic<bool> stop{false};
+    std::atomic<int> bad{0};
+    std::vector<std::thread> readers;
+    const PrecompileRouter& view = router;
+    for (int t = 0; t < 4; ++t) {
+        readers.emplace_back([&] {
+            uint8_t out[PrecompileRouter::MAX_OUTPUT];
+            while (!stop.load(std::memory_order_relaxed)) {
+                if (view.static_call(addresses::LX_ORACLE, get.data(), get.size(), out) != 32) ++bad;
+            }
+        });
+    }
+    for (uint64_t px = 1000; px < 1200; ++px) {
+        router.call(addresses::LX_ORACLE, calldata(0x7d3e47c1, {9, static_cast<uint64_t>(PriceSource::BINANCE), px, 1}));
+    }
+    stop = true;
+    for (auto& r : readers) r.join();
+    ASSERT_EQ(bad.load(), 0);
+}
+
+TEST(precompile_block_execution) {
+    // ABI words: signed values sign-extend, addresses sit in the last 20 bytes
+    struct Calldata {
+        std::vector<uint8_t> data;
+        explicit Calldata(uint32_t sel) : data{uint8_t(sel >> 24), uint8_t(sel >> 16), uint8_t(sel >> 8), uint8_t(sel)} {}
+        Calldata& num(I128 v) {
+            size_t at = data.size();
+            data.resize(at + 32, v < 0 ? 0xFF : 0);
+            for (int i = 31; i >= 16; --i, v >>= 8) data[at + i] = static_cast<uint8_t>(v);
+            return *this;
+        }
+        Calldata& addr(uint8_t last) {
+            data.resize(data.size() + 32, 0);
+            data.back() = last;
+            return *this;
+        }
+    };
+    auto pool_key = [](Calldata c, uint8_t token0, uint8_t token1) {
+        return c.addr(token0).addr(token1).num(3000).num(60);
+    };
+
+    std::vector<BlockTx> block;
+    for (uint8_t p = 0; p < 4; ++p) {
+        const uint8_t t0 = 10 + 2 * p, t1 = 11 + 2 * p;
+        block.push_back({addresses::LX_POOL, pool_key(Calldata(0x7a44c8ab), t0, t1).num(I128{1} << 96).data});
+        block.push_back({addresses::LX_POOL, pool_key(Calldata(0x3a7a5b04), t0, t1).addr(0)
+                                                .num(-600).num(600).num(x18::from_double(1000.0)).num(0).data});
+        for (int k = 0; k < 5; ++k) {
+            block.push_back({addresses::LX_POOL, pool_key(Calldata(0x1a686502), t0, t1).addr(0)
+                                                    .num(k % 2).num(x18::from_double(1.0 + k)).num(0).data});
+            block.push_back({addresses::LX_POOL, pool_key(Calldata(0x9e5e2e15), t0, t1).addr(0).data});
+        }
+    }
+    for (uint8_t a = 1; a <= 3; ++a) {
+        block.push_back({addresses::LX_VAULT, Calldata(0x47e7ef24).addr(a).addr(50).num(x18::from_double(100.0)).data});
+        block.push_back({addresses::LX_VAULT, Calldata(0xf8b2cb4f).addr(a).addr(50).data});
+    }
+    block.push_back({addresses::LX_BOOK, Calldata(0x1a4d01d2).addr(1).num(0).num(0).data});   // Runs alone
+    block.push_back({addresses::LX_VAULT, Calldata(0xf3fef3a3).addr(2).addr(50).num(x18::from_double(40.0)).data});
+    block.push_back({addresses::LX_VAULT, Calldata(0xf8b2cb4f).addr(2).addr(50).data});
+
+    LX sequential_lx;
+    PrecompileRouter sequential(sequential_lx);
+    std::vector<std::vector<uint8_t>> expected;
+    for (const BlockTx& tx : block) {
+        expected.push_back(sequential.call(tx.precompile, tx.calldata));
+    }
+
+    LX parallel_lx;
+    PrecompileRouter parallel(parallel_lx);
+    BlockResult result = parallel.execute_block(block);
+    ASSERT_EQ(result.outputs.size(), block.size());
+    for (size_t i = 0; i < block.size(); ++i) {
+        ASSERT(result.outputs[i] == expected[i]);
+    }
+    ASSERT_EQ(result.barriers, 1u);
+    ASSERT(result.groups >= 5);     // Four pools plus the vault
+    ASSERT(!expected[4].empty());   // Swaps and reads produced output
+}
+
+// Test: an oracle update in a block shares keys with the books it re-marks
+TEST(precompile_block_oracle_triggers) {
+    struct Calldata {
+        std::vector<uint8_t> data;
+        explicit Calldata(uint32_t sel) : data{uint8_t(sel >> 24), uint8_t(sel >> 16), uint8_t(sel >> 8), uint8_t(sel)} {}
+        Calldata& num(I128 v) {
+            size_t at = data.size();
+            data.resize(at + 32, v < 0 ? 0xFF : 0);
+            for (int i = 31; i >= 16; --i, v >>= 8) data[at + i] = static_cast<uint8_t>(v);
+            return *this;
+        }
+        Calldata& addr(uint8_t last) {
+            data.resize(data.size() + 32, 0);
+            data.back() = last;
+            return *this;
+        }
+    };
+
+    // Market 1 on asset 9, marked at 100, with a resting sell stop at 95
+    auto setup = [](LX& lx) {
+        OracleConfig oracle_config{};
+        oracle_config.asset_id = 9;
+        oracle_config.max_staleness = 3600;
+        oracle_config.max_deviation_x18 = x18::from_double(0.5);
+        oracle_config.method = AggregationMethod::MEDIAN;
+        oracle_config.sources = {PriceSource::BINANCE};
+        ASSERT_EQ(lx.oracle().register_asset(oracle_config), errors::OK);
+
+        MarketConfig vault_config{};
+        vault_config.market_id = 1;
+        vault_config.initial_margin_x18 = x18::from_double(0.1);
+        vault_config.maintenance_margin_x18 = x18::from_double(0.05);
+        vault_config.max_leverage_x18 = x18::from_double(10.0);
+        vault_config.active = true;
+        BookMarketConfig book_config{};
+        book_config.market_id = 1;
+        book_config.symbol_id = 1;
+        book_config.lot_size_x18 = x18::from_double(0.001);
+        book_config.max_order_size_x18 = x18::from_double(1000000.0);
+        book_config.status = 1;
+        ASSERT_EQ(lx.create_perp_market(1, 9, vault_config, book_config), errors::OK);
+        lx.oracle().update_price(9, PriceSource::BINANCE, x18::from_double(100.0), x18::from_double(0.1));
+
+        LXAccount trader{};
+        trader.main[19] = 0x42;
+        LXAccount bidder{};
+        bidder.main[19] = 0x43;
+        ASSERT_EQ(lx.vault().deposit(trader, Currency{}, x18::from_double(1000.0)), errors::OK);
+        ASSERT_EQ(lx.vault().deposit(bidder, Currency{}, x18::from_double(1000.0)), errors::OK);
+        LXOrder stop{};
+        stop.market_id = 1;
+        stop.kind = OrderKind::STOP_LIMIT;
+        stop.size_x18 = X18_ONE;
+        stop.limit_px_x18 = x18::from_double(90.0);
+        stop.trigger_px_x18 = x18::from_double(95.0);
+        stop.tif = TIF::GTC;
+        lx.book().place_trigger_order(trader, stop, PriceType::MARK);
+        ASSERT_EQ(lx.book().pending_trigger_count(1), 1u);
+    };
+
+    // The drop to 90 fires the stop, which rests at 90 until the bid takes it
+    std::vector<BlockTx> block;
+    block.push_back({addresses::LX_ORACLE, Calldata(0x7d3e47c1).num(9).num(0)
+                                               .num(x18::from_double(90.0)).num(x18::from_double(0.1)).data});
+    block.push_back({addresses::LX_BOOK, Calldata(0x3e5b3a12).addr(0x43).num(1).num(1).num(0)
+                                             .num(X18_ONE).num(x18::from_double(91.0)).num(0).num(0).num(0).data});
+
+    LX sequential_lx;
+    setup(sequential_lx);
+    PrecompileRouter sequential(sequential_lx);
+    std::vector<std::vector<uint8_t>> expected;
+    for (const BlockTx& tx : block) {
+        expected.push_back(sequential.call(tx.precompile, tx.calldata));
+    }
+    ASSERT_EQ(sequential_lx.book().pending_trigger_count(1), 0u);
+
+    LX parallel_lx;
+    setup(parallel_lx);
+    PrecompileRouter parallel(parallel_lx);
+    BlockResult result = parallel.execute_block(block);
+    ASSERT_EQ(result.outputs.size(), block.size());
+    ASSERT(result.outputs[0] == expected[0]);
+    // Order ids are process-wide; the fill must match
+    ASSERT_EQ(result.outputs[1].size(), 128u);
+    ASSERT(std::equal(result.outputs[1].begin() + 32, result.outputs[1].end(), expected[1].begin() + 32));
+    ASSERT_EQ(result.groups, 1u);   // The update and the order share market 1
+    ASSERT_EQ(parallel_lx.book().pending_trigger_count(1), 0u);
+
+    // The fired stop traded against the bid and was settled short
+    LXAccount trader{};
+    trader.main[19] = 0x42;
+    auto position = parallel_lx.vault().get_position(trader, 1);
+    ASSERT(position.has_value() && position->size_x18 == -X18_ONE);
+}
+
+TEST(precompile_profiling) {
+    LX lx;
+    PrecompileRouter router(lx);
+
+    std::vector<uint8_t> get_l1{0x4f, 0x55, 0xd2, 0x4d};
+    get_l1.resize(4 + 32, 0);
+    get_l1.back() = 1;
+    std::vector<uint8_t> unknown{0x01, 0x02, 0x03, 0x04};
+
+    const uint64_t static_gas = router.gas_cost(addresses::LX_BOOK, get_l1);
+    ASSERT_EQ(static_gas, gas::BOOK_PLACE_ORDER / 3);
+
+    // Nothing is recorded until profiling is on
+    router.call(addresses::LX_BOOK, get_l1);
+    ASSERT(!router.profiling());
+    router.set_profiling(true);
+    for (int i = 0; i < 200; ++i) {
+        router.call(addresses::LX_BOOK, get_l1);
+    }
+    router.static_call(addresses::LX_BOOK, get_l1);
+    router.call(addresses::LX_BOOK, unknown);
+
+    auto stats = router.profile();
+    ASSERT_EQ(stats.size(), router.handler_count());
+    const SelectorStats& top = stats.front();
+    ASSERT_EQ(top.lp, 0x9020);
+    ASSERT_EQ(top.selector, 0x4f55d24du);
+    ASSERT(top.view);
+    ASSERT_EQ(top.calls, 201u);
+    ASSERT_EQ(top.output_bytes, 201u * 160);
+    ASSERT(top.p50_nanos <= top.p99_nanos);
+    ASSERT(top.total_nanos > 0 && top.max_nanos > 0);
+    ASSERT_EQ(top.gas, static_gas);
+    ASSERT_EQ(stats[1].calls, 0u);
+
+    // Calibration only prices selectors with enough samples
+    ASSERT_EQ(router.calibrate_gas(10.0, 50, 100), 1u);
+    const uint64_t calibrated = router.gas_cost(addresses::LX_BOOK, get_l1);
+    ASSERT(calibrated >= 50);
+    ASSERT_EQ(calibrated, std::max<uint64_t>(50, static_cast<uint64_t>(
+        std::llround(static_cast<double>(top.total_nanos) / top.calls * 10.0))));
+    ASSERT_EQ(router.profile().front().gas, calibrated);
+    ASSERT_EQ(router.gas_cost(addresses::LX_VAULT, std::vector<uint8_t>{0x47, 0xe7, 0xef, 0x24}),
+              gas::VAULT_DEPOSIT);
+
+    router.reset_profile();
+    ASSERT_EQ(router.profile().front().calls, 0u);
+    ASSERT_EQ(router.gas_cost(addresses::LX_BOOK, get_l1), calibrated);
+}
+
+// Shift-subtract 256-by-128 division, the reference for full_math
+static U128 reference_div_wide(full_math::U256 num, U128 d, U128& rem) {
+    U128 q = 0;
+    U128 r = num.hi % d;
+    for (int i = 127; i >= 0; --i) {
+        const bool carry = (r >> 127) != 0;
+        r = (r << 1) | ((num.lo >> i) & 1);
+        q <<= 1;
+        if (carry || r >= d) {
+            r -= d;
+            q |= 1;
+        }
+    }
+    rem = r;
+    return q;
+}
+
+TEST(full_math_mul_div) {
+    uint64_t seed = 7;
+    auto next64 = [&]() {
+        seed ^= seed << 13;
+        seed ^= seed >> 7;
+        seed ^= seed << 17;
+        return seed;
+    };
+    // Operands of every width, biased toward the edges
+    auto operand = [&]() -> U128 {
+        const int bits = static_cast<int>(next64() % 129);
+        if (bits == 0) return 1;
+        const U128 x = (static_cast<U128>(next64()) << 64) | next64();
+        switch (next64() % 4) {
+            case 0: return bits == 128 ? ~U128{0} : (U128{1} << bits) - 1;
+            case 1: return U128{1} << (bits - 1);
+            default: return bits == 128 ? x : (x & ((U128{1} << bits) - 1)) | 1;
+        }
+    };
+
+    for (int i = 0; i < 200000; ++i) {
+        const U128 a = operand();
+        const U128 b = operand();
+        const U128 d = operand();
+        const full_math::U256 num = full_math::mul_wide(a, b);
+        if (num.hi >= d) continue;   // Quotient does not fit
+
+        U128 want_rem;
+        const U128 want = reference_div_wide(num, d, want_rem);
+        U128 rem;
+        ASSERT(full_math::div_wide(num, d, rem) == want);
+        ASSERT(rem == want_rem);
+
+        if ((a >> 127) || (b >> 127) || (d >> 127) || (want >> 126)) continue;
+        const I128 sa = static_cast<I128>(a), sb = static_cast<I128>(b), sd = static_cast<I128>(d);
+        const I128 q = static_cast<I128>(want);
+        const I128 up = q + (want_rem != 0 ? 1 : 0);
+        ASSERT(full_math::mul_div(sa, sb, sd) == q);
+        ASSERT(full_math::mul_div(-sa, sb, sd) == -q);
+        ASSERT(full_math::mul_div(sa, -sb, -sd) == q);
+        ASSERT(full_math::mul_div_up(sa, sb, sd) == up);
+        ASSERT(full_math::mul_div_up(-sa, -sb, sd) == up);
+        ASSERT(full_math::mul_div_up(sa, sb, -sd) == -q);
+    }
+
+    // Q64.96 shapes from the swap step
+    const I128 Q96 = I128{1} << 96;
+    ASSERT(full_math::mul_div(Q96, Q96, Q96) == Q96);
+    ASSERT(full_math::mul_div(Q96 * 3, Q96 * 5, Q96 * 7) == Q96 * 15 / 7);
+    ASSERT(full_math::mul_div_up(10, 10, 3) == 34);
+    ASSERT(full_math::mul_div(10, 10, 0) == 0);
+}
+
+TEST(x18_kernels) {
+    uint64_t seed = 11;
+    auto next64 = [&]() {
+        seed ^= seed << 13;
+        seed ^= seed >> 7;
+        seed ^= seed << 17;
+        return seed;
+    };
+    const I128 MIN = static_cast<I128>(U128{1} << 127);
+    const I128 MAX = ~MIN;
+    const I128 edges[] = {0, 1, -1, X18_ONE - 1, X18_ONE, -X18_ONE, X18_ONE + 1, MAX, MIN, MIN + 1};
+    for (I128 v : edges) {
+        ASSERT(x18::div_one(v) == v / X18_ONE);
+    }
+    for (int i = 0; i < 200000; ++i) {
+        const int bits = static_cast<int>(next64() % 128);
+        U128 x = (static_cast<U128>(next64()) << 64) | next64();
+        x = bits == 0 ? 0 : x >> (128 - bits);
+        const I128 v = next64() % 2 ? static_cast<I128>(x) : -static_cast<I128>(x);
+        ASSERT(x18::div_one(v) == v / X18_ONE);
+    }
+
+    const I128 price = x18::from_int(50000) + 123456789;
+    const I128 size = -x18::from_double(2.5);
+    ASSERT(x18::mul(x18::from_int(12), size) == x18::from_int(-30));
+    ASSERT(x18::mul(-7, 3) == 0);
+    ASSERT_EQ(x18::to_int(x18::from_int(-7) - 1), -7);
+    ASSERT(x18::from_bps(5) == x18::from_double(0.0005));
+    ASSERT(x18::from_ratio(1, 3) == X18_ONE / 3);
+
+    // Notional of 2.5 at 50000 overflows the plain product, not the result
+    I128 out = 42;
+    ASSERT(x18::checked_mul(price, size, out));
+    ASSERT(out == full_math::mul_div(price, size, X18_ONE));
+    ASSERT(out / X18_ONE == -125000);
+    ASSERT(x18::checked_mul(x18::from_int(3), -x18::from_double(0.5), out) && out == -x18::from_double(1.5));
+    ASSERT(!x18::checked_mul(MAX, x18::from_int(2), out) && out == -x18::from_double(1.5));
+    ASSERT(x18::checked_mul(MIN, X18_ONE, out) && out == MIN);
+    ASSERT(!x18::checked_mul(MIN, -X18_ONE, out));
+    ASSERT(x18::checked_div(x18::from_int(1), x18::from_int(4), out) && out == X18_ONE / 4);
+    ASSERT(x18::checked_div(x18::from_int(1000000000), x18::from_int(8), out));
+    ASSERT(out == x18::from_int(125000000));
+    ASSERT(!x18::checked_div(1, 0, out));
+    ASSERT(!x18::checked_div(MAX, 1, out));
+    ASSERT(!x18::checked_add(MAX, 1, out) && !x18::checked_sub(MIN, 1, out));
+    ASSERT(x18::checked_sub(MIN + 1, 1, out) && out == MIN);
+
+    std::vector<I128> sizes = {x18::from_int(2), -x18::from_int(3), 0, x18::from_double(0.001)};
+    std::vector<I128> entries = {x18::from_int(100), x18::from_int(90), 7, x18::from_int(120)};
+    std::vector<I128> pnl(sizes.size());
+    const I128 mark = x18::from_int(110);
+    x18::pnl_batch(sizes.data(), entries.data(), mark, pnl.data(), sizes.size());
+    for (size_t i = 0; i < sizes.size(); ++i) {
+        ASSERT(pnl[i] == x18::mul(sizes[i], mark - entries[i]));
+    }
+    ASSERT(pnl[0] == x18::from_int(20) && pnl[1] == x18::from_int(-60));
+    std::vector<I128> rates = {x18::from_bps(5), x18::from_int(4), 0, x18::from_int(-1)};
+    x18::mul_batch(sizes.data(), rates.data(), pnl.data(), sizes.size());
+    ASSERT(pnl[0] == x18::from_bps(10) && pnl[1] == x18::from_int(-12));
+    ASSERT(pnl[3] == -x18::from_double(0.001));
+    x18::mul_batch(pnl.data(), x18::from_int(2), pnl.data(), pnl.size());
+    ASSERT(pnl[1] == x18::from_int(-24));
+}
+
 // Performance test
 void bench_order_throughput() {
     std::cout << "\nRunning performance benchmark...\n";
@@ -936,6 +5616,100 @@ void bench_order_throughput() {
               << duration.count() / (double)NUM_ORDERS << " us/order\n";
 }
 
+// Tick math: exact integer conversions against the previous double version
+namespace legacy_tick_math {
+I128 get_sqrt_ratio_at_tick(int32_t tick) {
+    double sqrt_price = std::pow(1.0001, tick / 2.0);
+    return static_cast<I128>(sqrt_price * static_cast<double>(1ULL << 48) * static_cast<double>(1ULL << 48));
+}
+int32_t get_tick_at_sqrt_ratio(I128 sqrt_price_x96) {
+    double sqrt_price = static_cast<double>(sqrt_price_x96) / static_cast<double>(1ULL << 48);
+    sqrt_price /= static_cast<double>(1ULL << 48);
+    return static_cast<int32_t>(std::floor(std::log(sqrt_price * sqrt_price) / std::log(1.0001)));
+}
+} // namespace legacy_tick_math
+
+void bench_tick_math() {
+    std::cout << "\nRunning tick math benchmark...\n";
+
+    const int NUM_TICKS = 1000000;
+    std::vector<int32_t> ticks(NUM_TICKS);
+    uint64_t seed = 42;
+    for (auto& tick : ticks) {
+        seed = seed * 6364136223846793005ULL + 1442695040888963407ULL;
+        tick = static_cast<int32_t>((seed >> 33) % 800001) - 400000;
+    }
+
+    // The ratio at a tick is paid once per swap step, the tick at a ratio once per swap
+    auto run = [&](const char* name, auto at_tick, auto tick_at) {
+        std::vector<I128> ratios(NUM_TICKS);
+        auto start = std::chrono::high_resolution_clock::now();
+        for (int i = 0; i < NUM_TICKS; ++i) {
+            ratios[i] = at_tick(ticks[i]);
+        }
+        auto mid = std::chrono::high_resolution_clock::now();
+        int64_t sum = 0;
+        for (I128 ratio : ratios) {
+            sum += tick_at(ratio);
+        }
+        auto end = std::chrono::high_resolution_clock::now();
+        volatile int64_t sink = sum;
+        (void)sink;
+        auto ns = [&](auto from, auto to) {
+            return std::chrono::duration_cast<std::chrono::nanoseconds>(to - from).count() / (double)NUM_TICKS;
+        };
+        std::cout << "  " << name << ": " << std::fixed << std::setprecision(1)
+                  << ns(start, mid) << " ns ratio at tick, "
+                  << ns(mid, end) << " ns tick at ratio\n";
+    };
+    run("exact ", tick_math::get_sqrt_ratio_at_tick, tick_math::get_tick_at_sqrt_ratio);
+    run("double", legacy_tick_math::get_sqrt_ratio_at_tick, legacy_tick_math::get_tick_at_sqrt_ratio);
+}
+
+void bench_mul_div() {
+    std::cout << "\nRunning mul_div benchmark...\n";
+
+    const int N = 1000000;
+    uint64_t seed = 42;
+    auto next64 = [&]() {
+        seed = seed * 6364136223846793005ULL + 1442695040888963407ULL;
+        return seed;
+    };
+    struct Args { I128 a, b, d; };
+    std::vector<Args> narrow(N), wide(N);
+    for (int i = 0; i < N; ++i) {
+        // X18 amounts, and sqrt prices times liquidity over sqrt prices
+        narrow[i] = {static_cast<I128>(next64() >> 4), static_cast<I128>(next64() >> 4),
+                     static_cast<I128>(next64() >> 2) + 1};
+        wide[i] = {static_cast<I128>(((static_cast<U128>(next64() >> 9) << 32) | 1) << 40),
+                   static_cast<I128>(next64() >> 1) << 20,
+                   static_cast<I128>((static_cast<U128>(next64()) << 32) | 1) << 30};
+    }
+
+    auto time = [&](const char* name, const std::vector<Args>& args, auto fn) {
+        I128 sum = 0;
+        auto start = std::chrono::high_resolution_clock::now();
+        for (const Args& x : args) {
+            sum += fn(x.a, x.b, x.d);
+        }
+        auto end = std::chrono::high_resolution_clock::now();
+        volatile int64_t sink = static_cast<int64_t>(sum);
+        (void)sink;
+        std::cout << "  " << name << ": " << std::fixed << std::setprecision(1)
+                  << std::chrono::duration_cast<std::chrono::nanoseconds>(end - start).count() / (double)N
+                  << " ns\n";
+    };
+    auto reference = [](I128 a, I128 b, I128 d) {
+        U128 rem;
+        return static_cast<I128>(reference_div_wide(
+            full_math::mul_wide(static_cast<U128>(a), static_cast<U128>(b)), static_cast<U128>(d), rem));
+    };
+    time("mul_div 128-bit product ", narrow, full_math::mul_div);
+    time("mul_div 256-bit product ", wide, full_math::mul_div);
+    time("mul_div_up 256-bit      ", wide, full_math::mul_div_up);
+    time("shift-subtract reference", wide, reference);
+}
+
 int main() {
     std::cout << "=== LuxDEX Matching Engine Tests ===" << std::endl;
 
@@ -948,9 +5722,38 @@ int main() {
     RUN_TEST(market_order);
     RUN_TEST(order_cancellation);
     RUN_TEST(order_modification);
+    RUN_TEST(cancel_preserves_fifo);
+    RUN_TEST(order_pool_reuse);
     RUN_TEST(market_depth);
+    RUN_TEST(tick_ladder_book);
+    RUN_TEST(engine_book_backend);
+    RUN_TEST(top_of_book_snapshot);
+    RUN_TEST(l2_delta_stream);
+    RUN_TEST(caller_trade_buffer);
+    RUN_TEST(order_expiry);
+    RUN_TEST(orderbook_batch_auction);
     RUN_TEST(engine_multi_symbol);
+    RUN_TEST(engine_sharded_mode);
+    RUN_TEST(symbol_directory);
+    RUN_TEST(engine_parallel_batch);
+    RUN_TEST(engine_completion_queue);
+    RUN_TEST(journal_replay);
+    RUN_TEST(journal_append_failure);
+    RUN_TEST(journal_concurrent_inputs);
+    RUN_TEST(engine_clock_replay);
+    RUN_TEST(mass_quote_clock_replay);
+    RUN_TEST(mass_quote_repeated_ids);
+    RUN_TEST(journal_replication);
+    RUN_TEST(arena_memory_usage);
+    RUN_TEST(policy_order_book);
+    RUN_TEST(numa_placement);
+    RUN_TEST(snapshot_restore);
+    RUN_TEST(snapshot_rejects_corrupt);
+    RUN_TEST(order_id_blocks);
+    RUN_TEST(event_ring_feed);
+    RUN_TEST(conflated_market_data);
     RUN_TEST(engine_statistics);
+    RUN_TEST(engine_symbol_stats);
 
     std::cout << "\n=== LXOracle Tests ===" << std::endl;
 
@@ -959,6 +5762,14 @@ int main() {
     RUN_TEST(oracle_trimmed_mean);
     RUN_TEST(oracle_outlier_detection);
     RUN_TEST(oracle_twap);
+    RUN_TEST(oracle_twap_accumulator);
+    RUN_TEST(oracle_cached_aggregates);
+    RUN_TEST(oracle_concurrent_ingest);
+    RUN_TEST(oracle_scheduler_polling);
+    RUN_TEST(oracle_price_subscriptions);
+    RUN_TEST(feed_premium_ewma);
+    RUN_TEST(feed_price_table);
+    RUN_TEST(feed_batch_triggers);
     RUN_TEST(oracle_staleness);
     RUN_TEST(oracle_stats);
     RUN_TEST(oracle_multi_asset);
@@ -968,13 +5779,55 @@ int main() {
     RUN_TEST(lxbook_market_creation);
     RUN_TEST(lxbook_order_lifecycle);
     RUN_TEST(lxbook_matching);
+    RUN_TEST(lxbook_market_stats);
+    RUN_TEST(lxbook_market_handles);
+    RUN_TEST(lxbook_recent_trades);
+    RUN_TEST(lxbook_order_index);
+    RUN_TEST(lxbook_trigger_orders);
+    RUN_TEST(lxbook_mass_quote);
     RUN_TEST(lxbook_l1);
     RUN_TEST(lxbook_packed_interface);
+    RUN_TEST(lxbook_packed_batch);
     RUN_TEST(lxbook_settlement_callback);
+    RUN_TEST(settlement_pipeline);
+    RUN_TEST(lx_fill_accounts);
+    RUN_TEST(lx_tracing);
+#if LUX_COROUTINES
+    RUN_TEST(async_lx_flows);
+#endif
+    RUN_TEST(vault_mark_index);
+    RUN_TEST(vault_sharded_accounts);
+    RUN_TEST(vault_liquidation_heap);
+    RUN_TEST(liquidation_keeper);
+    RUN_TEST(vault_lazy_funding);
+    RUN_TEST(vault_batch_funding);
+    RUN_TEST(vault_funding_liquidation);
+    RUN_TEST(vault_netted_fills);
+    RUN_TEST(vault_read_snapshots);
+    RUN_TEST(risk_engine_cached_buying_power);
+    RUN_TEST(vault_adl_ranking);
+    RUN_TEST(full_math_mul_div);
+    RUN_TEST(x18_kernels);
+    RUN_TEST(pool_tick_bitmap);
+    RUN_TEST(pool_tick_math_exact);
+    RUN_TEST(pool_quote_swaps);
+    RUN_TEST(pool_handles_and_flash_contexts);
+    RUN_TEST(pool_hook_flags);
+    RUN_TEST(flash_currency_deltas);
+    RUN_TEST(pool_depth_curve);
+    RUN_TEST(router_split_routes);
+    RUN_TEST(lx_trade_venue_split);
+    RUN_TEST(precompile_dispatch);
+    RUN_TEST(precompile_static_call);
+    RUN_TEST(precompile_block_execution);
+    RUN_TEST(precompile_block_oracle_triggers);
+    RUN_TEST(precompile_profiling);
 
     std::cout << "\n=== All tests passed ===" << std::endl;
 
     bench_order_throughput();
+    bench_tick_math();
+    bench_mul_div();
 
     return 0;
 }